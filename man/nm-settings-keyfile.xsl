@@ -248,6 +248,38 @@ id=4
             </listitem>
           </itemizedlist>
         </refsect2>
+        <refsect2 id="templates">
+          <title>Templates</title>
+          <para>
+            A file with the suffix <literal>.nmtemplate</literal> expands into many profiles.
+            It is a keyfile with an additional <literal>[.nmtemplate]</literal> section, whose
+            <literal>range</literal> key gives the first and last value, like
+            <literal>range=100-3000</literal>. For each value, NetworkManager creates one
+            profile, with all occurrences of <literal>${i}</literal> in the file replaced by
+            the value. The profiles are read-only, like the ones in
+            <filename>/usr/lib/NetworkManager/system-connections/</filename>. Modifying one
+            of them stores a copy in <filename>/etc/NetworkManager/system-connections/</filename>,
+            which takes precedence. The UUIDs of the profiles are generated from the name
+            of the template and the value. If the template sets a fixed
+            <literal>connection.uuid</literal>, they are generated from that UUID and the value
+            instead.
+          </para>
+          <para>
+            <programlisting>
+[.nmtemplate]
+range=100-3000
+
+[connection]
+id=bond0.${i}
+type=vlan
+interface-name=bond0.${i}
+
+[vlan]
+id=${i}
+parent=bond0
+            </programlisting>
+          </para>
+        </refsect2>
       </refsect1>
 
       <refsect1 id='files'><title>Files</title>
@@ -50,6 +50,14 @@ const char **_nm_setting_vpn_get_secret_keys(NMSettingVpn *setting, guint *out_l
 #define NM_VPN_PLUGIN_IP6_CONFIG_PRESERVE_ROUTES "preserve-routes"
 #endif
 
+#ifndef NM_VPN_PLUGIN_IP4_CONFIG_ROUTES_PACKED
+#define NM_VPN_PLUGIN_IP4_CONFIG_ROUTES_PACKED "routes-packed"
+#endif
+
+#ifndef NM_VPN_PLUGIN_IP6_CONFIG_ROUTES_PACKED
+#define NM_VPN_PLUGIN_IP6_CONFIG_ROUTES_PACKED "routes-packed"
+#endif
+
 /*****************************************************************************/
 
 #endif /* __NM_COMPAT_H__ */
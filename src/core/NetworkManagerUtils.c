@@ -1282,29 +1282,19 @@ nm_utils_file_is_in_path(const char *abs_filename, const char *abs_path)
     return path[0] && !strchr(path, '/') ? path : NULL;
 }
 
-/* The returned qdisc array is valid as long as s_tc is not modified */
-GPtrArray *
-nm_utils_qdiscs_from_tc_setting(NMPlatform *platform, NMSettingTCConfig *s_tc, int ip_ifindex)
+static NMPObject *
+_qdisc_from_tc_setting(NMTCQdisc *s_qdisc, int ip_ifindex, guint32 parent)
 {
-    GPtrArray *qdiscs;
-    guint      nqdiscs;
-    guint      i;
-
-    nqdiscs = nm_setting_tc_config_get_num_qdiscs(s_tc);
-    qdiscs  = g_ptr_array_new_full(nqdiscs, (GDestroyNotify) nmp_object_unref);
+    NMPObject       *q     = nmp_object_new(NMP_OBJECT_TYPE_QDISC, NULL);
+    NMPlatformQdisc *qdisc = NMP_OBJECT_CAST_QDISC(q);
 
-    for (i = 0; i < nqdiscs; i++) {
-        NMTCQdisc       *s_qdisc = nm_setting_tc_config_get_qdisc(s_tc, i);
-        NMPObject       *q       = nmp_object_new(NMP_OBJECT_TYPE_QDISC, NULL);
-        NMPlatformQdisc *qdisc   = NMP_OBJECT_CAST_QDISC(q);
-
-        qdisc->ifindex = ip_ifindex;
-        qdisc->kind    = nm_tc_qdisc_get_kind(s_qdisc);
+    qdisc->ifindex = ip_ifindex;
+    qdisc->kind    = nm_tc_qdisc_get_kind(s_qdisc);
 
-        qdisc->addr_family = AF_UNSPEC;
-        qdisc->handle      = nm_tc_qdisc_get_handle(s_qdisc);
-        qdisc->parent      = nm_tc_qdisc_get_parent(s_qdisc);
-        qdisc->info        = 0;
+    qdisc->addr_family = AF_UNSPEC;
+    qdisc->handle      = nm_tc_qdisc_get_handle(s_qdisc);
+    qdisc->parent      = parent;
+    qdisc->info        = 0;
 
 #define GET_ATTR(name, dst, variant_type, type, dflt)                                  \
     G_STMT_START                                                                       \
@@ -1318,39 +1308,135 @@ nm_utils_qdiscs_from_tc_setting(NMPlatform *platform, NMSettingTCConfig *s_tc, i
     }                                                                                  \
     G_STMT_END
 
-        if (strcmp(qdisc->kind, "fq_codel") == 0) {
-            GET_ATTR("limit", qdisc->fq_codel.limit, UINT32, uint32, 0);
-            GET_ATTR("flows", qdisc->fq_codel.flows, UINT32, uint32, 0);
-            GET_ATTR("target", qdisc->fq_codel.target, UINT32, uint32, 0);
-            GET_ATTR("interval", qdisc->fq_codel.interval, UINT32, uint32, 0);
-            GET_ATTR("quantum", qdisc->fq_codel.quantum, UINT32, uint32, 0);
-            GET_ATTR("ce_threshold",
-                     qdisc->fq_codel.ce_threshold,
-                     UINT32,
-                     uint32,
-                     NM_PLATFORM_FQ_CODEL_CE_THRESHOLD_DISABLED);
-            GET_ATTR("memory_limit",
-                     qdisc->fq_codel.memory_limit,
-                     UINT32,
-                     uint32,
-                     NM_PLATFORM_FQ_CODEL_MEMORY_LIMIT_UNSET);
-            GET_ATTR("ecn", qdisc->fq_codel.ecn, BOOLEAN, boolean, FALSE);
-        } else if (nm_streq(qdisc->kind, "sfq")) {
-            GET_ATTR("limit", qdisc->sfq.limit, UINT32, uint32, 0);
-            GET_ATTR("flows", qdisc->sfq.flows, UINT32, uint32, 0);
-            GET_ATTR("divisor", qdisc->sfq.divisor, UINT32, uint32, 0);
-            GET_ATTR("perturb", qdisc->sfq.perturb_period, INT32, int32, 0);
-            GET_ATTR("quantum", qdisc->sfq.quantum, UINT32, uint32, 0);
-            GET_ATTR("depth", qdisc->sfq.depth, UINT32, uint32, 0);
-        } else if (nm_streq(qdisc->kind, "tbf")) {
-            GET_ATTR("rate", qdisc->tbf.rate, UINT64, uint64, 0);
-            GET_ATTR("burst", qdisc->tbf.burst, UINT32, uint32, 0);
-            GET_ATTR("limit", qdisc->tbf.limit, UINT32, uint32, 0);
-            GET_ATTR("latency", qdisc->tbf.latency, UINT32, uint32, 0);
+    if (strcmp(qdisc->kind, "fq_codel") == 0) {
+        GET_ATTR("limit", qdisc->fq_codel.limit, UINT32, uint32, 0);
+        GET_ATTR("flows", qdisc->fq_codel.flows, UINT32, uint32, 0);
+        GET_ATTR("target", qdisc->fq_codel.target, UINT32, uint32, 0);
+        GET_ATTR("interval", qdisc->fq_codel.interval, UINT32, uint32, 0);
+        GET_ATTR("quantum", qdisc->fq_codel.quantum, UINT32, uint32, 0);
+        GET_ATTR("ce_threshold",
+                 qdisc->fq_codel.ce_threshold,
+                 UINT32,
+                 uint32,
+                 NM_PLATFORM_FQ_CODEL_CE_THRESHOLD_DISABLED);
+        GET_ATTR("memory_limit",
+                 qdisc->fq_codel.memory_limit,
+                 UINT32,
+                 uint32,
+                 NM_PLATFORM_FQ_CODEL_MEMORY_LIMIT_UNSET);
+        GET_ATTR("ecn", qdisc->fq_codel.ecn, BOOLEAN, boolean, FALSE);
+    } else if (nm_streq(qdisc->kind, "sfq")) {
+        GET_ATTR("limit", qdisc->sfq.limit, UINT32, uint32, 0);
+        GET_ATTR("flows", qdisc->sfq.flows, UINT32, uint32, 0);
+        GET_ATTR("divisor", qdisc->sfq.divisor, UINT32, uint32, 0);
+        GET_ATTR("perturb", qdisc->sfq.perturb_period, INT32, int32, 0);
+        GET_ATTR("quantum", qdisc->sfq.quantum, UINT32, uint32, 0);
+        GET_ATTR("depth", qdisc->sfq.depth, UINT32, uint32, 0);
+    } else if (nm_streq(qdisc->kind, "tbf")) {
+        GET_ATTR("rate", qdisc->tbf.rate, UINT64, uint64, 0);
+        GET_ATTR("burst", qdisc->tbf.burst, UINT32, uint32, 0);
+        GET_ATTR("limit", qdisc->tbf.limit, UINT32, uint32, 0);
+        GET_ATTR("latency", qdisc->tbf.latency, UINT32, uint32, 0);
+    } else if (nm_streq(qdisc->kind, "fq")) {
+        GET_ATTR("limit", qdisc->fq.limit, UINT32, uint32, 0);
+        GET_ATTR("flow_limit", qdisc->fq.flow_limit, UINT32, uint32, 0);
+        GET_ATTR("quantum", qdisc->fq.quantum, UINT32, uint32, 0);
+        GET_ATTR("initial_quantum", qdisc->fq.initial_quantum, UINT32, uint32, 0);
+        GET_ATTR("maxrate", qdisc->fq.maxrate, UINT32, uint32, 0);
+        GET_ATTR("nopacing", qdisc->fq.nopacing, BOOLEAN, boolean, FALSE);
+    } else if (nm_streq(qdisc->kind, "mqprio")) {
+        guint32   num_tc;
+        guint32   hw;
+        GVariant *variant;
+
+        GET_ATTR("num_tc", num_tc, UINT32, uint32, 0);
+        GET_ATTR("hw", hw, UINT32, uint32, 0);
+        num_tc               = NM_MIN(num_tc, (guint32) NM_PLATFORM_MQPRIO_MAX_TC);
+        qdisc->mqprio.num_tc = num_tc;
+        qdisc->mqprio.hw     = NM_MIN(hw, (guint32) G_MAXUINT8);
+
+        /* The setting was verified, parsing can't fail. */
+        variant = nm_tc_qdisc_get_attribute(s_qdisc, "map");
+        if (variant && g_variant_is_of_type(variant, G_VARIANT_TYPE_STRING)) {
+            _nm_utils_tc_parse_mqprio_map(g_variant_get_string(variant, NULL),
+                                          num_tc,
+                                          qdisc->mqprio.prio_tc_map,
+                                          NULL);
+        }
+        variant = nm_tc_qdisc_get_attribute(s_qdisc, "queues");
+        if (variant && g_variant_is_of_type(variant, G_VARIANT_TYPE_STRING)) {
+            _nm_utils_tc_parse_mqprio_queues(g_variant_get_string(variant, NULL),
+                                             num_tc,
+                                             qdisc->mqprio.count,
+                                             qdisc->mqprio.offset,
+                                             NULL);
+        }
+        variant = nm_tc_qdisc_get_attribute(s_qdisc, "mode");
+        if (variant && g_variant_is_of_type(variant, G_VARIANT_TYPE_STRING)) {
+            qdisc->mqprio.mode = nm_streq(g_variant_get_string(variant, NULL), "channel")
+                                     ? TC_MQPRIO_MODE_CHANNEL
+                                     : TC_MQPRIO_MODE_DCB;
+            qdisc->mqprio.has_mode = TRUE;
         }
+    }
 #undef GET_ATTR
 
-        g_ptr_array_add(qdiscs, q);
+    return q;
+}
+
+/* Returns whether @s_qdisc is attached to a "mq" or "mqprio" qdisc itself,
+ * instead of one of its classes. Then it is a template for the qdisc of each
+ * hardware TX queue. */
+static gboolean
+_qdisc_is_per_queue(NMSettingTCConfig *s_tc, NMTCQdisc *s_qdisc)
+{
+    const guint32 parent = nm_tc_qdisc_get_parent(s_qdisc);
+    guint         i;
+
+    if (parent == TC_H_ROOT || TC_H_MIN(parent) != 0)
+        return FALSE;
+
+    for (i = 0; i < nm_setting_tc_config_get_num_qdiscs(s_tc); i++) {
+        NMTCQdisc *other = nm_setting_tc_config_get_qdisc(s_tc, i);
+
+        if (nm_tc_qdisc_get_handle(other) == parent
+            && NM_IN_STRSET(nm_tc_qdisc_get_kind(other), "mq", "mqprio"))
+            return TRUE;
+    }
+    return FALSE;
+}
+
+/* The returned qdisc array is valid as long as s_tc is not modified.
+ * A qdisc for each hardware queue is added @n_tx_queues times, with the
+ * classes 1 to @n_tx_queues of the "mq" or "mqprio" parent. */
+GPtrArray *
+nm_utils_qdiscs_from_tc_setting(NMPlatform        *platform,
+                                NMSettingTCConfig *s_tc,
+                                int                ip_ifindex,
+                                guint              n_tx_queues)
+{
+    GPtrArray *qdiscs;
+    guint      nqdiscs;
+    guint      i;
+    guint      j;
+
+    nqdiscs = nm_setting_tc_config_get_num_qdiscs(s_tc);
+    qdiscs  = g_ptr_array_new_full(nqdiscs, (GDestroyNotify) nmp_object_unref);
+
+    for (i = 0; i < nqdiscs; i++) {
+        NMTCQdisc    *s_qdisc = nm_setting_tc_config_get_qdisc(s_tc, i);
+        const guint32 parent  = nm_tc_qdisc_get_parent(s_qdisc);
+
+        if (!_qdisc_is_per_queue(s_tc, s_qdisc)) {
+            g_ptr_array_add(qdiscs, _qdisc_from_tc_setting(s_qdisc, ip_ifindex, parent));
+            continue;
+        }
+
+        for (j = 0; j < n_tx_queues && j < TC_H_MIN_PRIORITY - 1u; j++) {
+            g_ptr_array_add(
+                qdiscs,
+                _qdisc_from_tc_setting(s_qdisc, ip_ifindex, TC_H_MAKE(parent, j + 1u)));
+        }
     }
 
     return qdiscs;
@@ -1559,24 +1645,123 @@ nm_utils_ip_route_attribute_to_platform(int                addr_family,
 
 /*****************************************************************************/
 
+/* @cache maps NMPObject instances (by identity) to their serialized "a{sv}"
+ * variant. The objects in the platform cache are immutable, a modified address
+ * or route is a new instance. So when only few objects changed, only those need
+ * to be serialized again. Entries of objects that are gone get dropped. */
+static GVariant *
+_dbus_cache_get(GHashTable      *cache_old,
+                GHashTable      *cache_new,
+                int              addr_family,
+                const NMPObject *obj,
+                GVariant *(*to_dbus)(int addr_family, const NMPObject *obj))
+{
+    gpointer key;
+    gpointer value;
+
+    if (!cache_new)
+        return to_dbus(addr_family, obj);
+
+    if (!cache_old || !g_hash_table_steal_extended(cache_old, obj, &key, &value)) {
+        key   = (gpointer) nmp_object_ref(obj);
+        value = g_variant_ref_sink(to_dbus(addr_family, obj));
+    }
+    g_hash_table_insert(cache_new, key, value);
+    return value;
+}
+
+static GHashTable *
+_dbus_cache_new(void)
+{
+    return g_hash_table_new_full(nm_direct_hash,
+                                 NULL,
+                                 (GDestroyNotify) nmp_object_unref,
+                                 (GDestroyNotify) g_variant_unref);
+}
+
+static GVariant *
+_ip_address_data_to_dbus(int addr_family, const NMPObject *obj)
+{
+    const int                   IS_IPv4 = NM_IS_IPv4(addr_family);
+    const NMPlatformIPXAddress *address = NMP_OBJECT_CAST_IPX_ADDRESS(obj);
+    GVariantBuilder             addr_builder;
+    char                        addr_str[NM_INET_ADDRSTRLEN];
+    gconstpointer               p;
+
+    g_variant_builder_init(&addr_builder, G_VARIANT_TYPE("a{sv}"));
+
+    g_variant_builder_add(
+        &addr_builder,
+        "{sv}",
+        "address",
+        g_variant_new_string(nm_inet_ntop(addr_family, address->ax.address_ptr, addr_str)));
+
+    g_variant_builder_add(&addr_builder, "{sv}", "prefix", g_variant_new_uint32(address->ax.plen));
+
+    p = NULL;
+    if (IS_IPv4) {
+        if (address->a4.peer_address != address->a4.address)
+            p = &address->a4.peer_address;
+    } else {
+        if (!IN6_IS_ADDR_UNSPECIFIED(&address->a6.peer_address)
+            && !IN6_ARE_ADDR_EQUAL(&address->a6.peer_address, &address->a6.address))
+            p = &address->a6.peer_address;
+    }
+    if (p) {
+        g_variant_builder_add(&addr_builder,
+                              "{sv}",
+                              "peer",
+                              g_variant_new_string(nm_inet_ntop(addr_family, p, addr_str)));
+    }
+
+    if (IS_IPv4) {
+        if (*address->a4.label) {
+            g_variant_builder_add(&addr_builder,
+                                  "{sv}",
+                                  NM_IP_ADDRESS_ATTRIBUTE_LABEL,
+                                  g_variant_new_string(address->a4.label));
+        }
+    }
+
+    return g_variant_builder_end(&addr_builder);
+}
+
+/**
+ * nm_utils_ip_addresses_to_dbus:
+ * @addr_family: the address family
+ * @head_entry: the addresses from the platform cache
+ * @best_default_route: the default route, for the gateway of the legacy
+ *   "Addresses" property
+ * @inout_cache: (inout) (optional): a cache of the serialized address data,
+ *   to pass to the next call. Free it with g_hash_table_unref().
+ * @out_address_data: (out) (optional): the "AddressData" variant
+ * @out_addresses: (out) (optional): the legacy "Addresses" variant
+ */
 void
 nm_utils_ip_addresses_to_dbus(int                          addr_family,
                               const NMDedupMultiHeadEntry *head_entry,
                               const NMPObject             *best_default_route,
+                              GHashTable                 **inout_cache,
                               GVariant                   **out_address_data,
                               GVariant                   **out_addresses)
 {
-    const int        IS_IPv4 = NM_IS_IPv4(addr_family);
-    GVariantBuilder  builder_data;
-    GVariantBuilder  builder_legacy;
-    char             addr_str[NM_INET_ADDRSTRLEN];
-    NMDedupMultiIter iter;
-    const NMPObject *obj;
-    const gsize      MAX_ADDRESSES = 100;
-    gsize            i;
+    const int                      IS_IPv4   = NM_IS_IPv4(addr_family);
+    gs_unref_hashtable GHashTable *cache_old = NULL;
+    GHashTable                    *cache_new = NULL;
+    GVariantBuilder                builder_data;
+    GVariantBuilder                builder_legacy;
+    NMDedupMultiIter               iter;
+    const NMPObject               *obj;
+    const gsize                    MAX_ADDRESSES = 100;
+    gsize                          i;
 
     nm_assert_addr_family(addr_family);
 
+    if (inout_cache && out_address_data) {
+        cache_old = g_steal_pointer(inout_cache);
+        cache_new = _dbus_cache_new();
+    }
+
     if (out_address_data)
         g_variant_builder_init(&builder_data, G_VARIANT_TYPE("aa{sv}"));
     if (out_addresses) {
@@ -1601,48 +1786,9 @@ nm_utils_ip_addresses_to_dbus(int                          addr_family,
         }
 
         if (out_address_data) {
-            GVariantBuilder addr_builder;
-            gconstpointer   p;
-
-            g_variant_builder_init(&addr_builder, G_VARIANT_TYPE("a{sv}"));
-
-            g_variant_builder_add(
-                &addr_builder,
-                "{sv}",
-                "address",
-                g_variant_new_string(nm_inet_ntop(addr_family, address->ax.address_ptr, addr_str)));
-
-            g_variant_builder_add(&addr_builder,
-                                  "{sv}",
-                                  "prefix",
-                                  g_variant_new_uint32(address->ax.plen));
-
-            p = NULL;
-            if (IS_IPv4) {
-                if (address->a4.peer_address != address->a4.address)
-                    p = &address->a4.peer_address;
-            } else {
-                if (!IN6_IS_ADDR_UNSPECIFIED(&address->a6.peer_address)
-                    && !IN6_ARE_ADDR_EQUAL(&address->a6.peer_address, &address->a6.address))
-                    p = &address->a6.peer_address;
-            }
-            if (p) {
-                g_variant_builder_add(&addr_builder,
-                                      "{sv}",
-                                      "peer",
-                                      g_variant_new_string(nm_inet_ntop(addr_family, p, addr_str)));
-            }
-
-            if (IS_IPv4) {
-                if (*address->a4.label) {
-                    g_variant_builder_add(&addr_builder,
-                                          "{sv}",
-                                          NM_IP_ADDRESS_ATTRIBUTE_LABEL,
-                                          g_variant_new_string(address->a4.label));
-                }
-            }
-
-            g_variant_builder_add(&builder_data, "a{sv}", &addr_builder);
+            g_variant_builder_add_value(
+                &builder_data,
+                _dbus_cache_get(cache_old, cache_new, addr_family, obj, _ip_address_data_to_dbus));
         }
 
         if (out_addresses) {
@@ -1673,27 +1819,83 @@ nm_utils_ip_addresses_to_dbus(int                          addr_family,
     }
 
 out:
+    NM_SET_OUT(inout_cache, cache_new);
     NM_SET_OUT(out_address_data, g_variant_builder_end(&builder_data));
     NM_SET_OUT(out_addresses, g_variant_builder_end(&builder_legacy));
 }
 
+static GVariant *
+_ip_route_data_to_dbus(int addr_family, const NMPObject *obj)
+{
+    const NMPlatformIPXRoute *r = NMP_OBJECT_CAST_IPX_ROUTE(obj);
+    GVariantBuilder           route_builder;
+    char                      addr_str[NM_INET_ADDRSTRLEN];
+    gconstpointer             gateway;
+
+    g_variant_builder_init(&route_builder, G_VARIANT_TYPE("a{sv}"));
+
+    g_variant_builder_add(
+        &route_builder,
+        "{sv}",
+        "dest",
+        g_variant_new_string(nm_inet_ntop(addr_family, r->rx.network_ptr, addr_str)));
+
+    g_variant_builder_add(&route_builder, "{sv}", "prefix", g_variant_new_uint32(r->rx.plen));
+
+    gateway = nm_platform_ip_route_get_gateway(addr_family, &r->rx);
+    if (!nm_ip_addr_is_null(addr_family, gateway)) {
+        g_variant_builder_add(&route_builder,
+                              "{sv}",
+                              "next-hop",
+                              g_variant_new_string(nm_inet_ntop(addr_family, gateway, addr_str)));
+    }
+
+    g_variant_builder_add(&route_builder, "{sv}", "metric", g_variant_new_uint32(r->rx.metric));
+
+    if (!nm_platform_route_table_is_main(r->rx.table_coerced)) {
+        g_variant_builder_add(
+            &route_builder,
+            "{sv}",
+            "table",
+            g_variant_new_uint32(nm_platform_route_table_uncoerce(r->rx.table_coerced, TRUE)));
+    }
+
+    return g_variant_builder_end(&route_builder);
+}
+
+/**
+ * nm_utils_ip_routes_to_dbus:
+ * @addr_family: the address family
+ * @head_entry: the routes from the platform cache
+ * @inout_cache: (inout) (optional): a cache of the serialized route data,
+ *   to pass to the next call. Free it with g_hash_table_unref().
+ * @out_route_data: (out) (optional): the "RouteData" variant
+ * @out_routes: (out) (optional): the legacy "Routes" variant
+ */
 void
 nm_utils_ip_routes_to_dbus(int                          addr_family,
                            const NMDedupMultiHeadEntry *head_entry,
+                           GHashTable                 **inout_cache,
                            GVariant                   **out_route_data,
                            GVariant                   **out_routes)
 {
-    const int        IS_IPv4 = NM_IS_IPv4(addr_family);
-    NMDedupMultiIter iter;
-    const NMPObject *obj;
-    GVariantBuilder  builder_data;
-    GVariantBuilder  builder_legacy;
-    char             addr_str[NM_INET_ADDRSTRLEN];
-    const gsize      MAX_ROUTES = 100;
-    gsize            i;
+    const int                      IS_IPv4   = NM_IS_IPv4(addr_family);
+    gs_unref_hashtable GHashTable *cache_old = NULL;
+    GHashTable                    *cache_new = NULL;
+    NMDedupMultiIter               iter;
+    const NMPObject               *obj;
+    GVariantBuilder                builder_data;
+    GVariantBuilder                builder_legacy;
+    const gsize                    MAX_ROUTES = 100;
+    gsize                          i;
 
     nm_assert_addr_family(addr_family);
 
+    if (inout_cache && out_route_data) {
+        cache_old = g_steal_pointer(inout_cache);
+        cache_new = _dbus_cache_new();
+    }
+
     if (out_route_data)
         g_variant_builder_init(&builder_data, G_VARIANT_TYPE("aa{sv}"));
     if (out_routes) {
@@ -1730,46 +1932,9 @@ nm_utils_ip_routes_to_dbus(int                          addr_family,
         i++;
 
         if (out_route_data) {
-            GVariantBuilder route_builder;
-            gconstpointer   gateway;
-
-            g_variant_builder_init(&route_builder, G_VARIANT_TYPE("a{sv}"));
-
-            g_variant_builder_add(
-                &route_builder,
-                "{sv}",
-                "dest",
-                g_variant_new_string(nm_inet_ntop(addr_family, r->rx.network_ptr, addr_str)));
-
-            g_variant_builder_add(&route_builder,
-                                  "{sv}",
-                                  "prefix",
-                                  g_variant_new_uint32(r->rx.plen));
-
-            gateway = nm_platform_ip_route_get_gateway(addr_family, &r->rx);
-            if (!nm_ip_addr_is_null(addr_family, gateway)) {
-                g_variant_builder_add(
-                    &route_builder,
-                    "{sv}",
-                    "next-hop",
-                    g_variant_new_string(nm_inet_ntop(addr_family, gateway, addr_str)));
-            }
-
-            g_variant_builder_add(&route_builder,
-                                  "{sv}",
-                                  "metric",
-                                  g_variant_new_uint32(r->rx.metric));
-
-            if (!nm_platform_route_table_is_main(r->rx.table_coerced)) {
-                g_variant_builder_add(
-                    &route_builder,
-                    "{sv}",
-                    "table",
-                    g_variant_new_uint32(
-                        nm_platform_route_table_uncoerce(r->rx.table_coerced, TRUE)));
-            }
-
-            g_variant_builder_add(&builder_data, "a{sv}", &route_builder);
+            g_variant_builder_add_value(
+                &builder_data,
+                _dbus_cache_get(cache_old, cache_new, addr_family, obj, _ip_route_data_to_dbus));
         }
 
         if (out_routes) {
@@ -1799,6 +1964,7 @@ nm_utils_ip_routes_to_dbus(int                          addr_family,
         }
     }
 
+    NM_SET_OUT(inout_cache, cache_new);
     NM_SET_OUT(out_route_data, g_variant_builder_end(&builder_data));
     NM_SET_OUT(out_routes, g_variant_builder_end(&builder_legacy));
 }
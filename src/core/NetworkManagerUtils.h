@@ -173,8 +173,10 @@ const char *nm_utils_file_is_in_path(const char *abs_filename, const char *abs_p
 
 /*****************************************************************************/
 
-GPtrArray *
-nm_utils_qdiscs_from_tc_setting(NMPlatform *platform, NMSettingTCConfig *s_tc, int ip_ifindex);
+GPtrArray *nm_utils_qdiscs_from_tc_setting(NMPlatform        *platform,
+                                           NMSettingTCConfig *s_tc,
+                                           int                ip_ifindex,
+                                           guint              n_tx_queues);
 GPtrArray *
 nm_utils_tfilters_from_tc_setting(NMPlatform *platform, NMSettingTCConfig *s_tc, int ip_ifindex);
 
@@ -186,11 +188,13 @@ void nm_utils_ip_route_attribute_to_platform(int                addr_family,
 void nm_utils_ip_addresses_to_dbus(int                          addr_family,
                                    const NMDedupMultiHeadEntry *head_entry,
                                    const NMPObject             *best_default_route,
+                                   GHashTable                 **inout_cache,
                                    GVariant                   **out_address_data,
                                    GVariant                   **out_addresses);
 
 void nm_utils_ip_routes_to_dbus(int                          addr_family,
                                 const NMDedupMultiHeadEntry *head_entry,
+                                GHashTable                 **inout_cache,
                                 GVariant                   **out_route_data,
                                 GVariant                   **out_routes);
 
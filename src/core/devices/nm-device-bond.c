@@ -148,6 +148,150 @@ _set_bond_attr(NMDevice *device, const char *attr, const char *value)
 #define _set_bond_attr_printf(device, attr, fmt, ...) \
     _set_bond_attr_take((device), (attr), g_strdup_printf(fmt, __VA_ARGS__))
 
+static const char *
+_bond_enum_to_string(const char *const *names, guint n_names, guint value)
+{
+    if (value < n_names)
+        return names[value];
+    return NULL;
+}
+
+#define _bond_enum_dup(value, ...)                                             \
+    ({                                                                         \
+        static const char *const _names[] = {__VA_ARGS__};                     \
+                                                                               \
+        g_strdup(_bond_enum_to_string(_names, G_N_ELEMENTS(_names), (value))); \
+    })
+
+/* Returns the value of a bond option from the link message in the platform
+ * cache, formatted like the sysfs file of the option. Returns %NULL if the
+ * cache doesn't know the value, then the caller falls back to sysfs. */
+static char *
+_bond_option_get_from_lnk(NMPlatform *platform, const NMPlatformLnkBond *lnk, const char *option)
+{
+    NMStrBuf strbuf;
+    guint    i;
+
+    if (nm_streq(option, NM_SETTING_BOND_OPTION_MODE))
+        return g_strdup(_nm_setting_bond_mode_to_string(lnk->mode));
+    if (nm_streq(option, NM_SETTING_BOND_OPTION_MIIMON))
+        return lnk->miimon_has ? g_strdup_printf("%u", lnk->miimon) : NULL;
+    if (nm_streq(option, NM_SETTING_BOND_OPTION_UPDELAY))
+        return lnk->updelay_has ? g_strdup_printf("%u", lnk->updelay) : NULL;
+    if (nm_streq(option, NM_SETTING_BOND_OPTION_DOWNDELAY))
+        return lnk->downdelay_has ? g_strdup_printf("%u", lnk->downdelay) : NULL;
+    if (nm_streq(option, NM_SETTING_BOND_OPTION_PEER_NOTIF_DELAY))
+        return lnk->peer_notif_delay_has ? g_strdup_printf("%u", lnk->peer_notif_delay) : NULL;
+    if (nm_streq(option, NM_SETTING_BOND_OPTION_RESEND_IGMP))
+        return lnk->resend_igmp_has ? g_strdup_printf("%u", lnk->resend_igmp) : NULL;
+    if (nm_streq(option, NM_SETTING_BOND_OPTION_ARP_INTERVAL))
+        return g_strdup_printf("%u", lnk->arp_interval);
+    if (nm_streq(option, NM_SETTING_BOND_OPTION_MIN_LINKS))
+        return g_strdup_printf("%u", lnk->min_links);
+    if (nm_streq(option, NM_SETTING_BOND_OPTION_LP_INTERVAL))
+        return g_strdup_printf("%u", lnk->lp_interval);
+    if (nm_streq(option, NM_SETTING_BOND_OPTION_PACKETS_PER_SLAVE))
+        return g_strdup_printf("%u", lnk->packets_per_port);
+    if (NM_IN_STRSET(option,
+                     NM_SETTING_BOND_OPTION_NUM_GRAT_ARP,
+                     NM_SETTING_BOND_OPTION_NUM_UNSOL_NA))
+        return g_strdup_printf("%u", lnk->num_grat_arp);
+    if (nm_streq(option, NM_SETTING_BOND_OPTION_ARP_MISSED_MAX))
+        return lnk->arp_missed_max ? g_strdup_printf("%u", lnk->arp_missed_max) : NULL;
+    if (nm_streq(option, NM_SETTING_BOND_OPTION_AD_ACTOR_SYS_PRIO))
+        return g_strdup_printf("%u", lnk->ad_actor_sys_prio);
+    if (nm_streq(option, NM_SETTING_BOND_OPTION_AD_USER_PORT_KEY))
+        return g_strdup_printf("%u", lnk->ad_user_port_key);
+    if (nm_streq(option, NM_SETTING_BOND_OPTION_AD_ACTOR_SYSTEM))
+        return nm_utils_bin2hexstr_full(&lnk->ad_actor_system,
+                                        sizeof(lnk->ad_actor_system),
+                                        ':',
+                                        FALSE,
+                                        g_malloc(sizeof(lnk->ad_actor_system) * 3));
+    if (nm_streq(option, NM_SETTING_BOND_OPTION_USE_CARRIER))
+        return g_strdup(lnk->use_carrier ? "1" : "0");
+    if (nm_streq(option, NM_SETTING_BOND_OPTION_ALL_SLAVES_ACTIVE))
+        return g_strdup_printf("%u", lnk->all_ports_active);
+    if (nm_streq(option, NM_SETTING_BOND_OPTION_TLB_DYNAMIC_LB))
+        return lnk->tlb_dynamic_lb_has ? g_strdup(lnk->tlb_dynamic_lb ? "1" : "0") : NULL;
+    if (nm_streq(option, NM_SETTING_BOND_OPTION_ARP_VALIDATE))
+        return _bond_enum_dup(lnk->arp_validate,
+                              "none",
+                              "active",
+                              "backup",
+                              "all",
+                              "filter",
+                              "filter_active",
+                              "filter_backup");
+    if (nm_streq(option, NM_SETTING_BOND_OPTION_ARP_ALL_TARGETS))
+        return _bond_enum_dup(lnk->arp_all_targets, "any", "all");
+    if (nm_streq(option, NM_SETTING_BOND_OPTION_PRIMARY_RESELECT))
+        return _bond_enum_dup(lnk->primary_reselect, "always", "better", "failure");
+    if (nm_streq(option, NM_SETTING_BOND_OPTION_FAIL_OVER_MAC))
+        return _bond_enum_dup(lnk->fail_over_mac, "none", "active", "follow");
+    if (nm_streq(option, NM_SETTING_BOND_OPTION_XMIT_HASH_POLICY))
+        return _bond_enum_dup(lnk->xmit_hash_policy,
+                              "layer2",
+                              "layer3+4",
+                              "layer2+3",
+                              "encap2+3",
+                              "encap3+4",
+                              "vlan+srcmac");
+    if (nm_streq(option, NM_SETTING_BOND_OPTION_LACP_RATE))
+        return _bond_enum_dup(lnk->lacp_rate, "slow", "fast");
+    if (nm_streq(option, NM_SETTING_BOND_OPTION_AD_SELECT))
+        return _bond_enum_dup(lnk->ad_select, "stable", "bandwidth", "count");
+    if (nm_streq(option, NM_SETTING_BOND_OPTION_LACP_ACTIVE))
+        return lnk->lacp_active_has ? _bond_enum_dup(lnk->lacp_active, "off", "on") : NULL;
+    if (nm_streq(option, NM_SETTING_BOND_OPTION_PRIMARY)) {
+        if (lnk->primary <= 0)
+            return g_strdup("");
+        return g_strdup(nm_platform_link_get_name(platform, lnk->primary));
+    }
+    if (nm_streq(option, NM_SETTING_BOND_OPTION_ARP_IP_TARGET)) {
+        strbuf = NM_STR_BUF_INIT(0, FALSE);
+        for (i = 0; i < lnk->arp_ip_targets_num; i++) {
+            char sbuf[INET_ADDRSTRLEN];
+
+            nm_str_buf_append_required_delimiter(&strbuf, ' ');
+            nm_str_buf_append(&strbuf, nm_inet4_ntop(lnk->arp_ip_target[i], sbuf));
+        }
+        return nm_str_buf_finalize(&strbuf, NULL) ?: g_strdup("");
+    }
+    if (nm_streq(option, NM_SETTING_BOND_OPTION_NS_IP6_TARGET)) {
+        strbuf = NM_STR_BUF_INIT(0, FALSE);
+        for (i = 0; i < lnk->ns_ip6_targets_num; i++) {
+            char sbuf[INET6_ADDRSTRLEN];
+
+            nm_str_buf_append_required_delimiter(&strbuf, ' ');
+            nm_str_buf_append(&strbuf, nm_inet6_ntop(&lnk->ns_ip6_target[i], sbuf));
+        }
+        return nm_str_buf_finalize(&strbuf, NULL) ?: g_strdup("");
+    }
+
+    return NULL;
+}
+
+/* Gets the current value of a bond option, preferably from the platform
+ * cache (which has the IFLA_BOND_* attributes of the last link message)
+ * and otherwise from sysfs. */
+static char *
+_bond_option_get(NMDevice *device, const NMPlatformLnkBond *lnk, const char *option)
+{
+    NMPlatform *platform = nm_device_get_platform(device);
+    char       *value;
+
+    if (lnk) {
+        value = _bond_option_get_from_lnk(platform, lnk, option);
+        if (value)
+            return value;
+    }
+
+    return nm_platform_sysctl_controller_get_option(platform,
+                                                    nm_device_get_ifindex(device),
+                                                    option);
+}
+
 static gboolean
 ignore_option(NMSettingBond *s_bond, const char *option, const char *value)
 {
@@ -169,13 +313,18 @@ ignore_option(NMSettingBond *s_bond, const char *option, const char *value)
 static void
 update_connection(NMDevice *device, NMConnection *connection)
 {
-    NMDeviceBond  *self    = NM_DEVICE_BOND(device);
-    NMSettingBond *s_bond  = _nm_connection_ensure_setting(connection, NM_TYPE_SETTING_BOND);
-    int            ifindex = nm_device_get_ifindex(device);
-    NMBondMode     mode    = NM_BOND_MODE_UNKNOWN;
-    const char   **options;
-
-    /* Read bond options from sysfs and update the Bond setting to match */
+    NMDeviceBond            *self    = NM_DEVICE_BOND(device);
+    int                      ifindex = nm_device_get_ifindex(device);
+    NMBondMode               mode    = NM_BOND_MODE_UNKNOWN;
+    NMSettingBond           *s_bond;
+    const NMPlatformLnkBond *lnk;
+    const char             **options;
+
+    s_bond = _nm_connection_ensure_setting(connection, NM_TYPE_SETTING_BOND);
+    lnk    = nm_platform_link_get_lnk_bond(nm_device_get_platform(device), ifindex, NULL);
+
+    /* Read bond options and update the Bond setting to match. The values come
+     * from the platform cache, only those that it lacks are read from sysfs. */
     options = nm_setting_bond_get_valid_options(NULL);
     for (; options[0]; options++) {
         const char   *option = options[0];
@@ -187,9 +336,7 @@ update_connection(NMDevice *device, NMConnection *connection)
                          NM_SETTING_BOND_OPTION_BALANCE_SLB))
             continue;
 
-        value = nm_platform_sysctl_controller_get_option(nm_device_get_platform(device),
-                                                         ifindex,
-                                                         option);
+        value = _bond_option_get(device, lnk, option);
 
         if (value && _nm_setting_bond_get_option_type(s_bond, option) == NM_BOND_OPTION_TYPE_BOTH) {
             p = strchr(value, ' ');
@@ -332,28 +479,44 @@ set_bond_attr_or_default(NMDevice *device, NMSettingBond *s_bond, const char *op
     _set_bond_attr(device, opt, value);
 }
 
+/* Sets the bond attributes whose value differs from the current one in
+ * @lnk. Options that are already set are not written again. */
 static void
-set_bond_attrs_or_default(NMDevice *device, NMSettingBond *s_bond, const char *const *attr_v)
+set_bond_attrs_or_default(NMDevice                *device,
+                          NMSettingBond           *s_bond,
+                          const NMPlatformLnkBond *lnk,
+                          const char *const       *attr_v)
 {
+    NMDeviceBond *self = NM_DEVICE_BOND(device);
+
     nm_assert(NM_IS_DEVICE(device));
     nm_assert(s_bond);
     nm_assert(attr_v);
 
-    for (; *attr_v; ++attr_v)
+    for (; *attr_v; ++attr_v) {
+        gs_free char *cur_value = NULL;
+        const char   *value;
+
+        if (lnk) {
+            value     = nm_setting_bond_get_option_normalized(s_bond, *attr_v);
+            cur_value = _bond_option_get_from_lnk(nm_device_get_platform(device), lnk, *attr_v);
+            if (value && nm_streq0(cur_value, value)) {
+                _LOGT(LOGD_BOND, "bond option '%s' is already '%s'", *attr_v, value);
+                continue;
+            }
+        }
+
         set_bond_attr_or_default(device, s_bond, *attr_v);
+    }
 }
 
 static void
-set_bond_arp_ip_targets(NMDevice *device, NMSettingBond *s_bond)
+set_bond_arp_ip_targets(NMDevice *device, NMSettingBond *s_bond, const NMPlatformLnkBond *lnk)
 {
-    int           ifindex           = nm_device_get_ifindex(device);
     gs_free char *cur_arp_ip_target = NULL;
 
     /* ARP targets: clear and initialize the list */
-    cur_arp_ip_target =
-        nm_platform_sysctl_controller_get_option(nm_device_get_platform(device),
-                                                 ifindex,
-                                                 NM_SETTING_BOND_OPTION_ARP_IP_TARGET);
+    cur_arp_ip_target = _bond_option_get(device, lnk, NM_SETTING_BOND_OPTION_ARP_IP_TARGET);
     set_arp_targets(
         device,
         cur_arp_ip_target,
@@ -886,10 +1049,11 @@ can_reapply_change(NMDevice   *device,
 static void
 reapply_connection(NMDevice *device, NMConnection *con_old, NMConnection *con_new)
 {
-    NMDeviceBond  *self = NM_DEVICE_BOND(device);
-    NMSettingBond *s_bond;
-    const char    *value;
-    NMBondMode     mode;
+    NMDeviceBond            *self = NM_DEVICE_BOND(device);
+    NMSettingBond           *s_bond;
+    const NMPlatformLnkBond *lnk;
+    const char              *value;
+    NMBondMode               mode;
 
     NM_DEVICE_CLASS(nm_device_bond_parent_class)->reapply_connection(device, con_old, con_new);
 
@@ -904,9 +1068,13 @@ reapply_connection(NMDevice *device, NMConnection *con_old, NMConnection *con_ne
     /* Below we set only the bond options that the kernel allows modifying
      * while keeping the bond interface up */
 
-    set_bond_arp_ip_targets(device, s_bond);
+    lnk = nm_platform_link_get_lnk_bond(nm_device_get_platform(device),
+                                        nm_device_get_ifindex(device),
+                                        NULL);
+
+    set_bond_arp_ip_targets(device, s_bond, lnk);
 
-    set_bond_attrs_or_default(device, s_bond, NM_MAKE_STRV(OPTIONS_REAPPLY_SUBSET));
+    set_bond_attrs_or_default(device, s_bond, lnk, NM_MAKE_STRV(OPTIONS_REAPPLY_SUBSET));
 
     _balance_slb_setup(self, con_new);
 }
@@ -447,6 +447,9 @@ setting_vlans_to_platform(GPtrArray *array, guint *out_len)
     }
 
     *out_len = array->len;
+
+    /* Merge contiguous VLANs so that they are sent to kernel as ranges. */
+    nmp_utils_bridge_vlan_normalize(arr, out_len);
     return arr;
 }
 
@@ -782,11 +785,14 @@ nm_device_reapply_bridge_port_vlans(NMDevice *device)
     gs_unref_ptrarray GPtrArray  *tmp_vlans         = NULL;
     gs_free NMPlatformBridgeVlan *setting_vlans     = NULL;
     gs_free NMPlatformBridgeVlan *plat_vlans        = NULL;
+    gs_free NMPlatformBridgeVlan *del_vlans         = NULL;
+    gs_free NMPlatformBridgeVlan *add_vlans         = NULL;
     guint                         num_setting_vlans = 0;
     guint                         num_plat_vlans    = 0;
+    guint                         num_del_vlans;
+    guint                         num_add_vlans;
     NMPlatform                   *plat;
     int                           ifindex;
-    gboolean                      do_reapply;
 
     s_bridge_port = nm_device_get_applied_setting(device, NM_TYPE_SETTING_BRIDGE_PORT);
     if (!s_bridge_port)
@@ -821,23 +827,6 @@ nm_device_reapply_bridge_port_vlans(NMDevice *device)
 
     if (!nm_platform_link_get_bridge_vlans(plat, ifindex, &plat_vlans, &num_plat_vlans)) {
         _LOGD(LOGD_DEVICE, "reapply-bridge-port-vlans: can't get current VLANs from platform");
-        do_reapply = TRUE;
-    } else {
-        nmp_utils_bridge_vlan_normalize(setting_vlans, &num_setting_vlans);
-        nmp_utils_bridge_vlan_normalize(plat_vlans, &num_plat_vlans);
-        if (!nmp_utils_bridge_normalized_vlans_equal(setting_vlans,
-                                                     num_setting_vlans,
-                                                     plat_vlans,
-                                                     num_plat_vlans)) {
-            _LOGD(LOGD_DEVICE, "reapply-bridge-port-vlans: VLANs in platform need reapply");
-            do_reapply = TRUE;
-        } else {
-            _LOGD(LOGD_DEVICE, "reapply-bridge-port-vlans: VLANs in platform didn't change");
-            do_reapply = FALSE;
-        }
-    }
-
-    if (do_reapply) {
         nm_platform_link_set_bridge_vlans(plat, ifindex, TRUE, NULL, 0);
         if (num_setting_vlans > 0)
             nm_platform_link_set_bridge_vlans(plat,
@@ -845,7 +834,35 @@ nm_device_reapply_bridge_port_vlans(NMDevice *device)
                                               TRUE,
                                               setting_vlans,
                                               num_setting_vlans);
+        return;
+    }
+
+    /* Only touch the VLANs that change. Flushing and re-adding all of them
+     * would briefly drop the traffic of the VLANs that stay. */
+    nmp_utils_bridge_vlan_diff(plat_vlans,
+                               num_plat_vlans,
+                               setting_vlans,
+                               num_setting_vlans,
+                               &del_vlans,
+                               &num_del_vlans,
+                               &add_vlans,
+                               &num_add_vlans);
+
+    if (num_del_vlans == 0 && num_add_vlans == 0) {
+        _LOGD(LOGD_DEVICE, "reapply-bridge-port-vlans: VLANs in platform didn't change");
+        return;
     }
+
+    _LOGD(LOGD_DEVICE,
+          "reapply-bridge-port-vlans: VLANs in platform need reapply (%u ranges to delete, %u "
+          "to add)",
+          num_del_vlans,
+          num_add_vlans);
+
+    if (num_del_vlans > 0)
+        nm_platform_link_delete_bridge_vlans(plat, ifindex, TRUE, del_vlans, num_del_vlans);
+    if (num_add_vlans > 0)
+        nm_platform_link_set_bridge_vlans(plat, ifindex, TRUE, add_vlans, num_add_vlans);
 }
 
 static void
@@ -69,31 +69,16 @@ update_connection(NMDevice *device, NMConnection *connection)
 }
 
 static gboolean
-create_and_realize(NMDevice              *device,
-                   NMConnection          *connection,
-                   NMDevice              *parent,
-                   const NMPlatformLink **out_plink,
-                   GError               **error)
+create_link_op(NMDevice            *device,
+               NMConnection        *connection,
+               NMDevice            *parent,
+               NMPlatformLinkAddOp *op,
+               GError             **error)
 {
-    const char     *iface = nm_device_get_iface(device);
-    NMSettingDummy *s_dummy;
-    int             r;
-
-    s_dummy = nm_connection_get_setting_dummy(connection);
-    g_assert(s_dummy);
-
-    r = nm_platform_link_dummy_add(nm_device_get_platform(device), iface, out_plink);
-    if (r < 0) {
-        g_set_error(error,
-                    NM_DEVICE_ERROR,
-                    NM_DEVICE_ERROR_CREATION_FAILED,
-                    "Failed to create dummy interface '%s' for '%s': %s",
-                    iface,
-                    nm_connection_get_id(connection),
-                    nm_strerror(r));
-        return FALSE;
-    }
+    g_assert(nm_connection_get_setting_dummy(connection));
 
+    op->type = NM_LINK_TYPE_DUMMY;
+    op->name = nm_device_get_iface(device);
     return TRUE;
 }
 
@@ -127,7 +112,7 @@ nm_device_dummy_class_init(NMDeviceDummyClass *klass)
     device_class->link_types = NM_DEVICE_DEFINE_LINK_TYPES(NM_LINK_TYPE_DUMMY);
 
     device_class->complete_connection                    = complete_connection;
-    device_class->create_and_realize                     = create_and_realize;
+    device_class->create_link_op                         = create_link_op;
     device_class->get_generic_capabilities               = get_generic_capabilities;
     device_class->update_connection                      = update_connection;
     device_class->act_stage1_prepare_set_hwaddr_ethernet = TRUE;
@@ -220,15 +220,14 @@ can_reapply_change(NMDevice   *device,
 }
 
 static gboolean
-create_and_realize(NMDevice              *device,
-                   NMConnection          *connection,
-                   NMDevice              *parent,
-                   const NMPlatformLink **out_plink,
-                   GError               **error)
+create_link_op(NMDevice            *device,
+               NMConnection        *connection,
+               NMDevice            *parent,
+               NMPlatformLinkAddOp *op,
+               GError             **error)
 {
     NMDeviceInfinibandPrivate *priv = NM_DEVICE_INFINIBAND_GET_PRIVATE(device);
     NMSettingInfiniband       *s_infiniband;
-    int                        r;
 
     s_infiniband = nm_connection_get_setting_infiniband(connection);
     g_assert(s_infiniband);
@@ -270,21 +269,25 @@ create_and_realize(NMDevice              *device,
         return FALSE;
     }
 
-    r = nm_platform_link_infiniband_add(nm_device_get_platform(device),
-                                        priv->parent_ifindex,
-                                        priv->p_key,
-                                        out_plink);
-    if (r < 0) {
+    if (NM_IN_SET(priv->p_key, 0, 0x8000)) {
         g_set_error(error,
                     NM_DEVICE_ERROR,
-                    NM_DEVICE_ERROR_CREATION_FAILED,
-                    "Failed to create InfiniBand P_Key interface '%s' for '%s': %s",
-                    nm_device_get_iface(device),
-                    nm_connection_get_id(connection),
-                    nm_strerror(r));
+                    NM_DEVICE_ERROR_FAILED,
+                    "invalid InfiniBand P_Key 0x%04x",
+                    (guint) priv->p_key);
         return FALSE;
     }
 
+    /* The partition is created with RTM_NEWLINK, so that many partitions
+     * can be created in one batch. */
+    op->type           = NM_LINK_TYPE_INFINIBAND;
+    op->name           = nm_device_get_iface(device);
+    op->parent         = priv->parent_ifindex;
+    op->lnk.infiniband = (NMPlatformLnkInfiniband) {
+        .p_key = priv->p_key,
+    };
+    op->extra_data = &op->lnk.infiniband;
+
     priv->is_partition = TRUE;
     return TRUE;
 }
@@ -390,7 +393,7 @@ nm_device_infiniband_class_init(NMDeviceInfinibandClass *klass)
     device_class->link_types = NM_DEVICE_DEFINE_LINK_TYPES(NM_LINK_TYPE_INFINIBAND);
 
     device_class->can_reapply_change          = can_reapply_change;
-    device_class->create_and_realize          = create_and_realize;
+    device_class->create_link_op              = create_link_op;
     device_class->unrealize                   = unrealize;
     device_class->get_generic_capabilities    = get_generic_capabilities;
     device_class->check_connection_compatible = check_connection_compatible;
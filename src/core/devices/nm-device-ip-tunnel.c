@@ -667,27 +667,18 @@ tunnel_mode_to_link_type(NMIPTunnelMode tunnel_mode)
 /*****************************************************************************/
 
 static gboolean
-create_and_realize(NMDevice              *device,
-                   NMConnection          *connection,
-                   NMDevice              *parent,
-                   const NMPlatformLink **out_plink,
-                   GError               **error)
+create_link_op(NMDevice            *device,
+               NMConnection        *connection,
+               NMDevice            *parent,
+               NMPlatformLinkAddOp *op,
+               GError             **error)
 {
-    const char         *iface = nm_device_get_iface(device);
-    NMSettingIPTunnel  *s_ip_tunnel;
-    NMPlatformLnkGre    lnk_gre    = {};
-    NMPlatformLnkSit    lnk_sit    = {};
-    NMPlatformLnkIpIp   lnk_ipip   = {};
-    NMPlatformLnkIp6Tnl lnk_ip6tnl = {};
-    NMPlatformLnkVti    lnk_vti    = {};
-    NMPlatformLnkVti6   lnk_vti6   = {};
-    const char         *str;
-    gint64              val;
-    NMIPTunnelMode      mode;
-    int                 r;
-    gs_free char       *hwaddr = NULL;
-    guint8              mac_address[ETH_ALEN];
-    gboolean            mac_address_valid = FALSE;
+    NMSettingIPTunnel *s_ip_tunnel;
+    const char        *str;
+    gint64             val;
+    NMIPTunnelMode     mode;
+    int                parent_ifindex = 0;
+    gs_free char      *hwaddr         = NULL;
 
     s_ip_tunnel = nm_connection_get_setting_ip_tunnel(connection);
     nm_assert(NM_IS_SETTING_IP_TUNNEL(s_ip_tunnel));
@@ -701,7 +692,7 @@ create_and_realize(NMDevice              *device,
          * forgets the parameters for the cloned MAC address, and in stage 1
          * it might create a different MAC address. That should be fixed by
          * better handling device realization. */
-        if (!nm_utils_hwaddr_aton(hwaddr, mac_address, ETH_ALEN)) {
+        if (!nm_utils_hwaddr_aton(hwaddr, op->address.data, ETH_ALEN)) {
             g_set_error(error,
                         NM_DEVICE_ERROR,
                         NM_DEVICE_ERROR_FAILED,
@@ -709,29 +700,32 @@ create_and_realize(NMDevice              *device,
                         hwaddr);
             g_return_val_if_reached(FALSE);
         }
-
-        mac_address_valid = TRUE;
+        op->address.len = ETH_ALEN;
     }
 
+    if (parent)
+        parent_ifindex = nm_device_get_ifindex(parent);
+
+    op->name = nm_device_get_iface(device);
+
     switch (mode) {
-    case NM_IP_TUNNEL_MODE_GRETAP:
-        lnk_gre.is_tap = TRUE;
-        /* fall-through */
     case NM_IP_TUNNEL_MODE_GRE:
-        if (parent)
-            lnk_gre.parent_ifindex = nm_device_get_ifindex(parent);
+    case NM_IP_TUNNEL_MODE_GRETAP:
+        op->lnk.gre = (NMPlatformLnkGre) {
+            .parent_ifindex     = parent_ifindex,
+            .ttl                = nm_setting_ip_tunnel_get_ttl(s_ip_tunnel),
+            .tos                = nm_setting_ip_tunnel_get_tos(s_ip_tunnel),
+            .path_mtu_discovery = nm_setting_ip_tunnel_get_path_mtu_discovery(s_ip_tunnel),
+            .is_tap             = (mode == NM_IP_TUNNEL_MODE_GRETAP),
+        };
 
         str = nm_setting_ip_tunnel_get_local(s_ip_tunnel);
         if (str)
-            inet_pton(AF_INET, str, &lnk_gre.local);
+            inet_pton(AF_INET, str, &op->lnk.gre.local);
 
         str = nm_setting_ip_tunnel_get_remote(s_ip_tunnel);
         g_assert(str);
-        inet_pton(AF_INET, str, &lnk_gre.remote);
-
-        lnk_gre.ttl                = nm_setting_ip_tunnel_get_ttl(s_ip_tunnel);
-        lnk_gre.tos                = nm_setting_ip_tunnel_get_tos(s_ip_tunnel);
-        lnk_gre.path_mtu_discovery = nm_setting_ip_tunnel_get_path_mtu_discovery(s_ip_tunnel);
+        inet_pton(AF_INET, str, &op->lnk.gre.remote);
 
         val = _nm_utils_ascii_str_to_int64(nm_setting_ip_tunnel_get_input_key(s_ip_tunnel),
                                            10,
@@ -739,8 +733,8 @@ create_and_realize(NMDevice              *device,
                                            G_MAXUINT32,
                                            -1);
         if (val != -1) {
-            lnk_gre.input_key   = val;
-            lnk_gre.input_flags = NM_GRE_KEY;
+            op->lnk.gre.input_key   = val;
+            op->lnk.gre.input_flags = NM_GRE_KEY;
         }
 
         val = _nm_utils_ascii_str_to_int64(nm_setting_ip_tunnel_get_output_key(s_ip_tunnel),
@@ -749,104 +743,69 @@ create_and_realize(NMDevice              *device,
                                            G_MAXUINT32,
                                            -1);
         if (val != -1) {
-            lnk_gre.output_key   = val;
-            lnk_gre.output_flags = NM_GRE_KEY;
+            op->lnk.gre.output_key   = val;
+            op->lnk.gre.output_flags = NM_GRE_KEY;
         }
 
-        r = nm_platform_link_gre_add(nm_device_get_platform(device),
-                                     iface,
-                                     mac_address_valid ? mac_address : NULL,
-                                     mac_address_valid ? ETH_ALEN : 0,
-                                     &lnk_gre,
-                                     out_plink);
-        if (r < 0) {
-            g_set_error(error,
-                        NM_DEVICE_ERROR,
-                        NM_DEVICE_ERROR_CREATION_FAILED,
-                        "Failed to create GRE interface '%s' for '%s': %s",
-                        iface,
-                        nm_connection_get_id(connection),
-                        nm_strerror(r));
-            return FALSE;
-        }
+        op->extra_data = &op->lnk.gre;
         break;
     case NM_IP_TUNNEL_MODE_SIT:
-        if (parent)
-            lnk_sit.parent_ifindex = nm_device_get_ifindex(parent);
+        op->lnk.sit = (NMPlatformLnkSit) {
+            .parent_ifindex     = parent_ifindex,
+            .ttl                = nm_setting_ip_tunnel_get_ttl(s_ip_tunnel),
+            .tos                = nm_setting_ip_tunnel_get_tos(s_ip_tunnel),
+            .path_mtu_discovery = nm_setting_ip_tunnel_get_path_mtu_discovery(s_ip_tunnel),
+        };
 
         str = nm_setting_ip_tunnel_get_local(s_ip_tunnel);
         if (str)
-            inet_pton(AF_INET, str, &lnk_sit.local);
+            inet_pton(AF_INET, str, &op->lnk.sit.local);
 
         str = nm_setting_ip_tunnel_get_remote(s_ip_tunnel);
         g_assert(str);
-        inet_pton(AF_INET, str, &lnk_sit.remote);
-
-        lnk_sit.ttl                = nm_setting_ip_tunnel_get_ttl(s_ip_tunnel);
-        lnk_sit.tos                = nm_setting_ip_tunnel_get_tos(s_ip_tunnel);
-        lnk_sit.path_mtu_discovery = nm_setting_ip_tunnel_get_path_mtu_discovery(s_ip_tunnel);
+        inet_pton(AF_INET, str, &op->lnk.sit.remote);
 
-        r = nm_platform_link_sit_add(nm_device_get_platform(device), iface, &lnk_sit, out_plink);
-        if (r < 0) {
-            g_set_error(error,
-                        NM_DEVICE_ERROR,
-                        NM_DEVICE_ERROR_CREATION_FAILED,
-                        "Failed to create SIT interface '%s' for '%s': %s",
-                        iface,
-                        nm_connection_get_id(connection),
-                        nm_strerror(r));
-            return FALSE;
-        }
+        op->extra_data = &op->lnk.sit;
         break;
     case NM_IP_TUNNEL_MODE_IPIP:
-        if (parent)
-            lnk_ipip.parent_ifindex = nm_device_get_ifindex(parent);
+        op->lnk.ipip = (NMPlatformLnkIpIp) {
+            .parent_ifindex     = parent_ifindex,
+            .ttl                = nm_setting_ip_tunnel_get_ttl(s_ip_tunnel),
+            .tos                = nm_setting_ip_tunnel_get_tos(s_ip_tunnel),
+            .path_mtu_discovery = nm_setting_ip_tunnel_get_path_mtu_discovery(s_ip_tunnel),
+        };
 
         str = nm_setting_ip_tunnel_get_local(s_ip_tunnel);
         if (str)
-            inet_pton(AF_INET, str, &lnk_ipip.local);
+            inet_pton(AF_INET, str, &op->lnk.ipip.local);
 
         str = nm_setting_ip_tunnel_get_remote(s_ip_tunnel);
         g_assert(str);
-        inet_pton(AF_INET, str, &lnk_ipip.remote);
-
-        lnk_ipip.ttl                = nm_setting_ip_tunnel_get_ttl(s_ip_tunnel);
-        lnk_ipip.tos                = nm_setting_ip_tunnel_get_tos(s_ip_tunnel);
-        lnk_ipip.path_mtu_discovery = nm_setting_ip_tunnel_get_path_mtu_discovery(s_ip_tunnel);
+        inet_pton(AF_INET, str, &op->lnk.ipip.remote);
 
-        r = nm_platform_link_ipip_add(nm_device_get_platform(device), iface, &lnk_ipip, out_plink);
-        if (r < 0) {
-            g_set_error(error,
-                        NM_DEVICE_ERROR,
-                        NM_DEVICE_ERROR_CREATION_FAILED,
-                        "Failed to create IPIP interface '%s' for '%s': %s",
-                        iface,
-                        nm_connection_get_id(connection),
-                        nm_strerror(r));
-            return FALSE;
-        }
+        op->extra_data = &op->lnk.ipip;
         break;
     case NM_IP_TUNNEL_MODE_IPIP6:
     case NM_IP_TUNNEL_MODE_IP6IP6:
     case NM_IP_TUNNEL_MODE_IP6GRE:
     case NM_IP_TUNNEL_MODE_IP6GRETAP:
-        if (parent)
-            lnk_ip6tnl.parent_ifindex = nm_device_get_ifindex(parent);
+        op->lnk.ip6tnl = (NMPlatformLnkIp6Tnl) {
+            .parent_ifindex = parent_ifindex,
+            .ttl            = nm_setting_ip_tunnel_get_ttl(s_ip_tunnel),
+            .tclass         = nm_setting_ip_tunnel_get_tos(s_ip_tunnel),
+            .encap_limit    = nm_setting_ip_tunnel_get_encapsulation_limit(s_ip_tunnel),
+            .flow_label     = nm_setting_ip_tunnel_get_flow_label(s_ip_tunnel),
+        };
+        op->lnk.ip6tnl.flags =
+            ip6tnl_flags_setting_to_plat(nm_setting_ip_tunnel_get_flags(s_ip_tunnel));
 
         str = nm_setting_ip_tunnel_get_local(s_ip_tunnel);
         if (str)
-            inet_pton(AF_INET6, str, &lnk_ip6tnl.local);
+            inet_pton(AF_INET6, str, &op->lnk.ip6tnl.local);
 
         str = nm_setting_ip_tunnel_get_remote(s_ip_tunnel);
         g_assert(str);
-        inet_pton(AF_INET6, str, &lnk_ip6tnl.remote);
-
-        lnk_ip6tnl.ttl         = nm_setting_ip_tunnel_get_ttl(s_ip_tunnel);
-        lnk_ip6tnl.tclass      = nm_setting_ip_tunnel_get_tos(s_ip_tunnel);
-        lnk_ip6tnl.encap_limit = nm_setting_ip_tunnel_get_encapsulation_limit(s_ip_tunnel);
-        lnk_ip6tnl.flow_label  = nm_setting_ip_tunnel_get_flow_label(s_ip_tunnel);
-        lnk_ip6tnl.flags =
-            ip6tnl_flags_setting_to_plat(nm_setting_ip_tunnel_get_flags(s_ip_tunnel));
+        inet_pton(AF_INET6, str, &op->lnk.ip6tnl.remote);
 
         if (NM_IN_SET(mode, NM_IP_TUNNEL_MODE_IP6GRE, NM_IP_TUNNEL_MODE_IP6GRETAP)) {
             val = _nm_utils_ascii_str_to_int64(nm_setting_ip_tunnel_get_input_key(s_ip_tunnel),
@@ -855,8 +814,8 @@ create_and_realize(NMDevice              *device,
                                                G_MAXUINT32,
                                                -1);
             if (val != -1) {
-                lnk_ip6tnl.input_key   = val;
-                lnk_ip6tnl.input_flags = NM_GRE_KEY;
+                op->lnk.ip6tnl.input_key   = val;
+                op->lnk.ip6tnl.input_flags = NM_GRE_KEY;
             }
 
             val = _nm_utils_ascii_str_to_int64(nm_setting_ip_tunnel_get_output_key(s_ip_tunnel),
@@ -865,125 +824,86 @@ create_and_realize(NMDevice              *device,
                                                G_MAXUINT32,
                                                -1);
             if (val != -1) {
-                lnk_ip6tnl.output_key   = val;
-                lnk_ip6tnl.output_flags = NM_GRE_KEY;
+                op->lnk.ip6tnl.output_key   = val;
+                op->lnk.ip6tnl.output_flags = NM_GRE_KEY;
             }
 
-            lnk_ip6tnl.is_gre = TRUE;
-            lnk_ip6tnl.is_tap = (mode == NM_IP_TUNNEL_MODE_IP6GRETAP);
-
-            r = nm_platform_link_ip6gre_add(nm_device_get_platform(device),
-                                            iface,
-                                            mac_address_valid ? mac_address : NULL,
-                                            mac_address_valid ? ETH_ALEN : 0,
-                                            &lnk_ip6tnl,
-                                            out_plink);
+            op->lnk.ip6tnl.is_gre = TRUE;
+            op->lnk.ip6tnl.is_tap = (mode == NM_IP_TUNNEL_MODE_IP6GRETAP);
         } else {
-            lnk_ip6tnl.proto = nm_setting_ip_tunnel_get_mode(s_ip_tunnel) == NM_IP_TUNNEL_MODE_IPIP6
-                                   ? IPPROTO_IPIP
-                                   : IPPROTO_IPV6;
-            r                = nm_platform_link_ip6tnl_add(nm_device_get_platform(device),
-                                            iface,
-                                            &lnk_ip6tnl,
-                                            out_plink);
-        }
-        if (r < 0) {
-            g_set_error(error,
-                        NM_DEVICE_ERROR,
-                        NM_DEVICE_ERROR_CREATION_FAILED,
-                        "Failed to create IPv6 tunnel interface '%s' for '%s': %s",
-                        iface,
-                        nm_connection_get_id(connection),
-                        nm_strerror(r));
-            return FALSE;
+            op->lnk.ip6tnl.proto = mode == NM_IP_TUNNEL_MODE_IPIP6 ? IPPROTO_IPIP : IPPROTO_IPV6;
         }
+
+        op->extra_data = &op->lnk.ip6tnl;
         break;
     case NM_IP_TUNNEL_MODE_VTI:
-        if (parent)
-            lnk_vti.parent_ifindex = nm_device_get_ifindex(parent);
-
-        str = nm_setting_ip_tunnel_get_local(s_ip_tunnel);
-        if (str)
-            inet_pton(AF_INET, str, &lnk_vti.local);
-
-        str = nm_setting_ip_tunnel_get_remote(s_ip_tunnel);
-        nm_assert(str);
-        inet_pton(AF_INET, str, &lnk_vti.remote);
-
-        lnk_vti.ikey = _nm_utils_ascii_str_to_int64(nm_setting_ip_tunnel_get_input_key(s_ip_tunnel),
-                                                    10,
-                                                    0,
-                                                    G_MAXUINT32,
-                                                    0);
-        lnk_vti.okey =
+        op->lnk.vti = (NMPlatformLnkVti) {
+            .parent_ifindex = parent_ifindex,
+            .fwmark         = nm_setting_ip_tunnel_get_fwmark(s_ip_tunnel),
+        };
+        op->lnk.vti.ikey =
+            _nm_utils_ascii_str_to_int64(nm_setting_ip_tunnel_get_input_key(s_ip_tunnel),
+                                         10,
+                                         0,
+                                         G_MAXUINT32,
+                                         0);
+        op->lnk.vti.okey =
             _nm_utils_ascii_str_to_int64(nm_setting_ip_tunnel_get_output_key(s_ip_tunnel),
                                          10,
                                          0,
                                          G_MAXUINT32,
                                          0);
-        lnk_vti.fwmark = nm_setting_ip_tunnel_get_fwmark(s_ip_tunnel);
-
-        r = nm_platform_link_vti_add(nm_device_get_platform(device), iface, &lnk_vti, out_plink);
-        if (r < 0) {
-            g_set_error(error,
-                        NM_DEVICE_ERROR,
-                        NM_DEVICE_ERROR_CREATION_FAILED,
-                        "Failed to create VTI interface '%s' for '%s': %s",
-                        iface,
-                        nm_connection_get_id(connection),
-                        nm_strerror(r));
-            return FALSE;
-        }
-        break;
-    case NM_IP_TUNNEL_MODE_VTI6:
-        if (parent)
-            lnk_vti6.parent_ifindex = nm_device_get_ifindex(parent);
 
         str = nm_setting_ip_tunnel_get_local(s_ip_tunnel);
         if (str)
-            inet_pton(AF_INET6, str, &lnk_vti6.local);
+            inet_pton(AF_INET, str, &op->lnk.vti.local);
 
         str = nm_setting_ip_tunnel_get_remote(s_ip_tunnel);
         nm_assert(str);
-        inet_pton(AF_INET6, str, &lnk_vti6.remote);
+        inet_pton(AF_INET, str, &op->lnk.vti.remote);
 
-        lnk_vti6.ikey =
+        op->extra_data = &op->lnk.vti;
+        break;
+    case NM_IP_TUNNEL_MODE_VTI6:
+        op->lnk.vti6 = (NMPlatformLnkVti6) {
+            .parent_ifindex = parent_ifindex,
+            .fwmark         = nm_setting_ip_tunnel_get_fwmark(s_ip_tunnel),
+        };
+        op->lnk.vti6.ikey =
             _nm_utils_ascii_str_to_int64(nm_setting_ip_tunnel_get_input_key(s_ip_tunnel),
                                          10,
                                          0,
                                          G_MAXUINT32,
                                          0);
-        lnk_vti6.okey =
+        op->lnk.vti6.okey =
             _nm_utils_ascii_str_to_int64(nm_setting_ip_tunnel_get_output_key(s_ip_tunnel),
                                          10,
                                          0,
                                          G_MAXUINT32,
                                          0);
-        lnk_vti6.fwmark = nm_setting_ip_tunnel_get_fwmark(s_ip_tunnel);
 
-        r = nm_platform_link_vti6_add(nm_device_get_platform(device), iface, &lnk_vti6, out_plink);
-        if (r < 0) {
-            g_set_error(error,
-                        NM_DEVICE_ERROR,
-                        NM_DEVICE_ERROR_CREATION_FAILED,
-                        "Failed to create VTI6 interface '%s' for '%s': %s",
-                        iface,
-                        nm_connection_get_id(connection),
-                        nm_strerror(r));
-            return FALSE;
-        }
+        str = nm_setting_ip_tunnel_get_local(s_ip_tunnel);
+        if (str)
+            inet_pton(AF_INET6, str, &op->lnk.vti6.local);
+
+        str = nm_setting_ip_tunnel_get_remote(s_ip_tunnel);
+        nm_assert(str);
+        inet_pton(AF_INET6, str, &op->lnk.vti6.remote);
+
+        op->extra_data = &op->lnk.vti6;
         break;
     default:
         g_set_error(error,
                     NM_DEVICE_ERROR,
                     NM_DEVICE_ERROR_CREATION_FAILED,
                     "Failed to create IP tunnel interface '%s' for '%s': mode %d not supported",
-                    iface,
+                    nm_device_get_iface(device),
                     nm_connection_get_id(connection),
-                    (int) nm_setting_ip_tunnel_get_mode(s_ip_tunnel));
+                    (int) mode);
         return FALSE;
     }
 
+    op->type = tunnel_mode_to_link_type(mode);
     return TRUE;
 }
 
@@ -1216,7 +1136,7 @@ nm_device_ip_tunnel_class_init(NMDeviceIPTunnelClass *klass)
     device_class->complete_connection         = complete_connection;
     device_class->update_connection           = update_connection;
     device_class->check_connection_compatible = check_connection_compatible;
-    device_class->create_and_realize          = create_and_realize;
+    device_class->create_link_op              = create_link_op;
     device_class->get_generic_capabilities    = get_generic_capabilities;
     device_class->get_configured_mtu          = get_configured_mtu;
     device_class->unrealize_notify            = unrealize_notify;
@@ -182,6 +182,23 @@ update_properties(NMDevice *device)
     g_object_thaw_notify((GObject *) device);
 }
 
+static NMSettingMacsecOffload
+_get_offload(NMDeviceMacsec *self, NMSettingMacsec *s_macsec)
+{
+    NMSettingMacsecOffload offload;
+
+    offload = nm_setting_macsec_get_offload(s_macsec);
+    if (offload == NM_SETTING_MACSEC_OFFLOAD_DEFAULT) {
+        offload = nm_config_data_get_connection_default_int64(NM_CONFIG_GET_DATA,
+                                                              NM_CON_DEFAULT("macsec.offload"),
+                                                              NM_DEVICE(self),
+                                                              NM_SETTING_MACSEC_OFFLOAD_OFF,
+                                                              NM_SETTING_MACSEC_OFFLOAD_MAC,
+                                                              NM_SETTING_MACSEC_OFFLOAD_OFF);
+    }
+    return offload;
+}
+
 static NMSupplicantConfig *
 build_supplicant_config(NMDeviceMacsec *self, GError **error)
 {
@@ -191,7 +208,6 @@ build_supplicant_config(NMDeviceMacsec *self, GError **error)
     NMConnection                       *connection;
     const char                         *con_uuid;
     guint32                             mtu;
-    int                                 offload;
 
     connection = nm_device_get_applied_connection(NM_DEVICE(self));
 
@@ -207,19 +223,9 @@ build_supplicant_config(NMDeviceMacsec *self, GError **error)
 
     g_return_val_if_fail(s_macsec, NULL);
 
-    offload = nm_setting_macsec_get_offload(s_macsec);
-    if (offload == NM_SETTING_MACSEC_OFFLOAD_DEFAULT) {
-        offload = nm_config_data_get_connection_default_int64(NM_CONFIG_GET_DATA,
-                                                              NM_CON_DEFAULT("macsec.offload"),
-                                                              NM_DEVICE(self),
-                                                              NM_SETTING_MACSEC_OFFLOAD_OFF,
-                                                              NM_SETTING_MACSEC_OFFLOAD_MAC,
-                                                              NM_SETTING_MACSEC_OFFLOAD_OFF);
-    }
-
     if (!nm_supplicant_config_add_setting_macsec(config,
                                                  s_macsec,
-                                                 (NMSettingMacsecOffload) offload,
+                                                 _get_offload(self, s_macsec),
                                                  error)) {
         g_prefix_error(error, "macsec-setting: ");
         return NULL;
@@ -742,6 +748,10 @@ create_and_realize(NMDevice              *device,
     lnk.validation  = nm_setting_macsec_get_validation(s_macsec);
     lnk.include_sci = nm_setting_macsec_get_send_sci(s_macsec);
 
+    /* Request the offload already when creating the link. The kernel refuses
+     * to change it later, once wpa_supplicant installed the SAs. */
+    lnk.offload = _get_offload(NM_DEVICE_MACSEC(device), s_macsec);
+
     parent_ifindex = nm_device_get_ifindex(parent);
     g_warn_if_fail(parent_ifindex > 0);
 
@@ -193,17 +193,15 @@ link_changed(NMDevice *device, const NMPlatformLink *pllink)
 }
 
 static gboolean
-create_and_realize(NMDevice              *device,
-                   NMConnection          *connection,
-                   NMDevice              *parent,
-                   const NMPlatformLink **out_plink,
-                   GError               **error)
+create_link_op(NMDevice            *device,
+               NMConnection        *connection,
+               NMDevice            *parent,
+               NMPlatformLinkAddOp *op,
+               GError             **error)
 {
-    const char          *iface = nm_device_get_iface(device);
     NMSettingMacvlan    *s_macvlan;
     NMPlatformLnkMacvlan lnk = {};
     int                  parent_ifindex;
-    int                  r;
 
     s_macvlan = nm_connection_get_setting_macvlan(connection);
     g_return_val_if_fail(s_macvlan, FALSE);
@@ -239,23 +237,11 @@ create_and_realize(NMDevice              *device,
     lnk.no_promisc = !nm_setting_macvlan_get_promiscuous(s_macvlan);
     lnk.tap        = nm_setting_macvlan_get_tap(s_macvlan);
 
-    r = nm_platform_link_macvlan_add(nm_device_get_platform(device),
-                                     iface,
-                                     parent_ifindex,
-                                     &lnk,
-                                     out_plink);
-    if (r < 0) {
-        g_set_error(error,
-                    NM_DEVICE_ERROR,
-                    NM_DEVICE_ERROR_CREATION_FAILED,
-                    "Failed to create %s interface '%s' for '%s': %s",
-                    lnk.tap ? "macvtap" : "macvlan",
-                    iface,
-                    nm_connection_get_id(connection),
-                    nm_strerror(r));
-        return FALSE;
-    }
-
+    op->type        = lnk.tap ? NM_LINK_TYPE_MACVTAP : NM_LINK_TYPE_MACVLAN;
+    op->name        = nm_device_get_iface(device);
+    op->parent      = parent_ifindex;
+    op->lnk.macvlan = lnk;
+    op->extra_data  = &op->lnk.macvlan;
     return TRUE;
 }
 
@@ -495,7 +481,7 @@ nm_device_macvlan_class_init(NMDeviceMacvlanClass *klass)
     device_class->act_stage1_prepare_set_hwaddr_ethernet = TRUE;
     device_class->check_connection_compatible            = check_connection_compatible;
     device_class->complete_connection                    = complete_connection;
-    device_class->create_and_realize                     = create_and_realize;
+    device_class->create_link_op                         = create_link_op;
     device_class->get_generic_capabilities               = get_generic_capabilities;
     device_class->get_configured_mtu    = nm_device_get_configured_mtu_wired_parent;
     device_class->link_changed          = link_changed;
@@ -181,20 +181,16 @@ link_changed(NMDevice *device, const NMPlatformLink *pllink)
 }
 
 static gboolean
-create_and_realize(NMDevice              *device,
-                   NMConnection          *connection,
-                   NMDevice              *parent,
-                   const NMPlatformLink **out_plink,
-                   GError               **error)
+create_link_op(NMDevice            *device,
+               NMConnection        *connection,
+               NMDevice            *parent,
+               NMPlatformLinkAddOp *op,
+               GError             **error)
 {
-    NMDeviceVlanPrivate *priv  = NM_DEVICE_VLAN_GET_PRIVATE(device);
-    const char          *iface = nm_device_get_iface(device);
-    NMSettingVlan       *s_vlan;
-    int                  parent_ifindex;
-    guint                vlan_id;
-    int                  r;
-    const char          *protocol_str;
-    guint16              protocol = ETH_P_8021Q;
+    NMSettingVlan *s_vlan;
+    int            parent_ifindex;
+    const char    *protocol_str;
+    guint16        protocol = ETH_P_8021Q;
 
     s_vlan = nm_connection_get_setting_vlan(connection);
     g_assert(s_vlan);
@@ -228,8 +224,6 @@ create_and_realize(NMDevice              *device,
         return FALSE;
     }
 
-    vlan_id = nm_setting_vlan_get_id(s_vlan);
-
     protocol_str = nm_setting_vlan_get_protocol(s_vlan);
     if (protocol_str) {
         if (nm_streq(protocol_str, "802.1ad"))
@@ -238,32 +232,17 @@ create_and_realize(NMDevice              *device,
             nm_assert(nm_streq(protocol_str, "802.1Q"));
     }
 
-    r = nm_platform_link_vlan_add(nm_device_get_platform(device),
-                                  iface,
-                                  parent_ifindex,
-                                  &((NMPlatformLnkVlan) {
-                                      .id       = vlan_id,
-                                      .flags    = nm_setting_vlan_get_flags(s_vlan),
-                                      .protocol = protocol,
-                                  }),
-                                  out_plink);
-    if (r < 0) {
-        g_set_error(error,
-                    NM_DEVICE_ERROR,
-                    NM_DEVICE_ERROR_CREATION_FAILED,
-                    "Failed to create VLAN interface '%s' for '%s': %s",
-                    iface,
-                    nm_connection_get_id(connection),
-                    nm_strerror(r));
-        return FALSE;
-    }
-
-    nm_device_parent_set_ifindex(device, parent_ifindex);
-    if (vlan_id != priv->vlan_id) {
-        priv->vlan_id = vlan_id;
-        _notify((NMDeviceVlan *) device, PROP_VLAN_ID);
-    }
-
+    /* The parent ifindex and the VLAN ID are set from the platform link by
+     * update_properties(), when the device gets realized. */
+    op->type     = NM_LINK_TYPE_VLAN;
+    op->name     = nm_device_get_iface(device);
+    op->parent   = parent_ifindex;
+    op->lnk.vlan = (NMPlatformLnkVlan) {
+        .id       = nm_setting_vlan_get_id(s_vlan),
+        .flags    = nm_setting_vlan_get_flags(s_vlan),
+        .protocol = protocol,
+    };
+    op->extra_data = &op->lnk.vlan;
     return TRUE;
 }
 
@@ -544,7 +523,7 @@ nm_device_vlan_class_init(NMDeviceVlanClass *klass)
     device_class->link_types                       = NM_DEVICE_DEFINE_LINK_TYPES(NM_LINK_TYPE_VLAN);
     device_class->mtu_parent_delta                 = 0; /* VLANs can have the same MTU of parent */
 
-    device_class->create_and_realize                     = create_and_realize;
+    device_class->create_link_op                         = create_link_op;
     device_class->link_changed                           = link_changed;
     device_class->unrealize_notify                       = unrealize_notify;
     device_class->get_generic_capabilities               = get_generic_capabilities;
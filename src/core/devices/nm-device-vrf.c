@@ -110,34 +110,23 @@ unrealize_notify(NMDevice *device)
 }
 
 static gboolean
-create_and_realize(NMDevice              *device,
-                   NMConnection          *connection,
-                   NMDevice              *parent,
-                   const NMPlatformLink **out_plink,
-                   GError               **error)
+create_link_op(NMDevice            *device,
+               NMConnection        *connection,
+               NMDevice            *parent,
+               NMPlatformLinkAddOp *op,
+               GError             **error)
 {
-    const char      *iface = nm_device_get_iface(device);
-    NMPlatformLnkVrf props = {};
-    NMSettingVrf    *s_vrf;
-    int              r;
+    NMSettingVrf *s_vrf;
 
     s_vrf = _nm_connection_get_setting(connection, NM_TYPE_SETTING_VRF);
     nm_assert(s_vrf);
 
-    props.table = nm_setting_vrf_get_table(s_vrf);
-
-    r = nm_platform_link_vrf_add(nm_device_get_platform(device), iface, &props, out_plink);
-    if (r < 0) {
-        g_set_error(error,
-                    NM_DEVICE_ERROR,
-                    NM_DEVICE_ERROR_CREATION_FAILED,
-                    "Failed to create VRF interface '%s' for '%s': %s",
-                    iface,
-                    nm_connection_get_id(connection),
-                    nm_strerror(r));
-        return FALSE;
-    }
-
+    op->type    = NM_LINK_TYPE_VRF;
+    op->name    = nm_device_get_iface(device);
+    op->lnk.vrf = (NMPlatformLnkVrf) {
+        .table = nm_setting_vrf_get_table(s_vrf),
+    };
+    op->extra_data = &op->lnk.vrf;
     return TRUE;
 }
 
@@ -208,6 +197,96 @@ update_connection(NMDevice *device, NMConnection *connection)
         g_object_set(G_OBJECT(s_vrf), NM_SETTING_VRF_TABLE, priv->props.table, NULL);
 }
 
+typedef struct {
+    NMDevice                  *device;
+    NMDevice                  *port;
+    GCancellable              *cancellable;
+    NMDeviceAttachPortCallback callback;
+    gpointer                   callback_user_data;
+    int                        op_idx;
+} AttachPortData;
+
+/* The ports to attach, of all VRF devices. */
+static GPtrArray *_attach_queue       = NULL;
+static GSource   *_attach_idle_source = NULL;
+
+static void
+_attach_port_data_free(AttachPortData *data)
+{
+    g_object_unref(data->device);
+    g_object_unref(data->port);
+    g_object_unref(data->cancellable);
+    nm_g_slice_free(data);
+}
+
+static gboolean
+_attach_queue_cb(gpointer user_data)
+{
+    gs_unref_ptrarray GPtrArray        *queue = NULL;
+    gs_free NMPlatformLinkAttachPortOp *ops   = NULL;
+    NMPlatform                         *platform;
+    guint                               n_ops = 0;
+    guint                               i;
+
+    nm_clear_g_source_inst(&_attach_idle_source);
+    queue = g_steal_pointer(&_attach_queue);
+
+    /* Attach the ports that got queued in this main loop iteration with one
+     * pipelined batch of netlink requests. That is the case when many VRFs
+     * and their ports get activated together. */
+    platform = nm_device_get_platform(((AttachPortData *) queue->pdata[0])->device);
+    ops      = g_new(NMPlatformLinkAttachPortOp, queue->len);
+    for (i = 0; i < queue->len; i++) {
+        AttachPortData *data         = queue->pdata[i];
+        const int       ifindex      = nm_device_get_ip_ifindex(data->device);
+        const int       ifindex_port = nm_device_get_ip_ifindex(data->port);
+
+        nm_assert(nm_device_get_platform(data->device) == platform);
+
+        data->op_idx = -1;
+        if (g_cancellable_is_cancelled(data->cancellable) || ifindex <= 0 || ifindex_port <= 0)
+            continue;
+
+        nm_device_take_down(data->port, TRUE);
+        data->op_idx = n_ops;
+        ops[n_ops++] = (NMPlatformLinkAttachPortOp) {
+            .controller = ifindex,
+            .port       = ifindex_port,
+        };
+    }
+
+    nm_platform_link_attach_port_batch(platform, ops, n_ops);
+
+    for (i = 0; i < queue->len; i++) {
+        AttachPortData       *data   = queue->pdata[i];
+        NMDeviceVrf          *self   = NM_DEVICE_VRF(data->device);
+        gs_free_error GError *error  = NULL;
+        int                   result = -NME_UNSPEC;
+
+        if (data->op_idx >= 0) {
+            nm_device_bring_up(data->port);
+            result = ops[data->op_idx].result;
+        }
+
+        /* The callbacks might cancel the other ports. */
+        if (g_cancellable_set_error_if_cancelled(data->cancellable, &error)) {
+            /* pass */
+        } else if (result < 0) {
+            g_set_error(&error,
+                        NM_DEVICE_ERROR,
+                        NM_DEVICE_ERROR_FAILED,
+                        "failed to attach VRF port %s: %s",
+                        nm_device_get_ip_iface(data->port),
+                        nm_strerror(result));
+        } else
+            _LOGI(LOGD_DEVICE, "attached VRF port %s", nm_device_get_ip_iface(data->port));
+
+        data->callback(data->device, error, data->callback_user_data);
+    }
+
+    return G_SOURCE_REMOVE;
+}
+
 static NMTernary
 attach_port(NMDevice                  *device,
             NMDevice                  *port,
@@ -217,27 +296,33 @@ attach_port(NMDevice                  *device,
             NMDeviceAttachPortCallback callback,
             gpointer                   user_data)
 {
-    NMDeviceVrf *self       = NM_DEVICE_VRF(device);
-    gboolean     success    = TRUE;
-    const char  *port_iface = nm_device_get_ip_iface(port);
+    NMDeviceVrf    *self = NM_DEVICE_VRF(device);
+    AttachPortData *data;
 
     nm_device_controller_check_port_physical_port(device, port, LOGD_DEVICE);
 
-    if (configure) {
-        nm_device_take_down(port, TRUE);
-        success = nm_platform_link_attach_port(nm_device_get_platform(device),
-                                               nm_device_get_ip_ifindex(device),
-                                               nm_device_get_ip_ifindex(port));
-        nm_device_bring_up(port);
+    if (!configure) {
+        _LOGI(LOGD_DEVICE, "VRF port %s was attached", nm_device_get_ip_iface(port));
+        return TRUE;
+    }
 
-        if (!success)
-            return FALSE;
+    data  = g_slice_new(AttachPortData);
+    *data = (AttachPortData) {
+        .device             = g_object_ref(device),
+        .port               = g_object_ref(port),
+        .cancellable        = g_object_ref(cancellable),
+        .callback           = callback,
+        .callback_user_data = user_data,
+    };
 
-        _LOGI(LOGD_DEVICE, "attached VRF port %s", port_iface);
-    } else
-        _LOGI(LOGD_DEVICE, "VRF port %s was attached", port_iface);
+    if (!_attach_queue)
+        _attach_queue = g_ptr_array_new_with_free_func((GDestroyNotify) _attach_port_data_free);
+    g_ptr_array_add(_attach_queue, data);
 
-    return TRUE;
+    if (!_attach_idle_source)
+        _attach_idle_source = nm_g_idle_add_source(_attach_queue_cb, NULL);
+
+    return NM_TERNARY_DEFAULT;
 }
 
 static NMTernary
@@ -335,7 +420,7 @@ nm_device_vrf_class_init(NMDeviceVrfClass *klass)
     device_class->detach_port                 = detach_port;
     device_class->link_changed                = link_changed;
     device_class->unrealize_notify            = unrealize_notify;
-    device_class->create_and_realize          = create_and_realize;
+    device_class->create_link_op              = create_link_op;
     device_class->check_connection_compatible = check_connection_compatible;
     device_class->complete_connection         = complete_connection;
     device_class->get_generic_capabilities    = get_generic_capabilities;
@@ -152,65 +152,54 @@ unrealize_notify(NMDevice *device)
 }
 
 static gboolean
-create_and_realize(NMDevice              *device,
-                   NMConnection          *connection,
-                   NMDevice              *parent,
-                   const NMPlatformLink **out_plink,
-                   GError               **error)
+create_link_op(NMDevice            *device,
+               NMConnection        *connection,
+               NMDevice            *parent,
+               NMPlatformLinkAddOp *op,
+               GError             **error)
 {
-    const char        *iface = nm_device_get_iface(device);
-    NMPlatformLnkVxlan props = {};
-    NMSettingVxlan    *s_vxlan;
-    const char        *str;
-    int                r;
+    NMPlatformLnkVxlan *props = &op->lnk.vxlan;
+    NMSettingVxlan     *s_vxlan;
+    const char         *str;
 
     s_vxlan = nm_connection_get_setting_vxlan(connection);
     g_return_val_if_fail(s_vxlan, FALSE);
 
     if (parent)
-        props.parent_ifindex = nm_device_get_ifindex(parent);
+        props->parent_ifindex = nm_device_get_ifindex(parent);
 
-    props.id = nm_setting_vxlan_get_id(s_vxlan);
+    props->id = nm_setting_vxlan_get_id(s_vxlan);
 
     str = nm_setting_vxlan_get_local(s_vxlan);
     if (str) {
-        if (!nm_inet_parse_bin(AF_INET, str, NULL, &props.local)
-            && !nm_inet_parse_bin(AF_INET6, str, NULL, &props.local6))
+        if (!nm_inet_parse_bin(AF_INET, str, NULL, &props->local)
+            && !nm_inet_parse_bin(AF_INET6, str, NULL, &props->local6))
             return FALSE;
     }
 
     str = nm_setting_vxlan_get_remote(s_vxlan);
     if (str) {
-        if (!nm_inet_parse_bin(AF_INET, str, NULL, &props.group)
-            && !nm_inet_parse_bin(AF_INET6, str, NULL, &props.group6))
+        if (!nm_inet_parse_bin(AF_INET, str, NULL, &props->group)
+            && !nm_inet_parse_bin(AF_INET6, str, NULL, &props->group6))
             return FALSE;
     }
 
-    props.tos          = nm_setting_vxlan_get_tos(s_vxlan);
-    props.ttl          = nm_setting_vxlan_get_ttl(s_vxlan);
-    props.learning     = nm_setting_vxlan_get_learning(s_vxlan);
-    props.ageing       = nm_setting_vxlan_get_ageing(s_vxlan);
-    props.limit        = nm_setting_vxlan_get_limit(s_vxlan);
-    props.src_port_min = nm_setting_vxlan_get_source_port_min(s_vxlan);
-    props.src_port_max = nm_setting_vxlan_get_source_port_max(s_vxlan);
-    props.dst_port     = nm_setting_vxlan_get_destination_port(s_vxlan);
-    props.proxy        = nm_setting_vxlan_get_proxy(s_vxlan);
-    props.rsc          = nm_setting_vxlan_get_rsc(s_vxlan);
-    props.l2miss       = nm_setting_vxlan_get_l2_miss(s_vxlan);
-    props.l3miss       = nm_setting_vxlan_get_l3_miss(s_vxlan);
-
-    r = nm_platform_link_vxlan_add(nm_device_get_platform(device), iface, &props, out_plink);
-    if (r < 0) {
-        g_set_error(error,
-                    NM_DEVICE_ERROR,
-                    NM_DEVICE_ERROR_CREATION_FAILED,
-                    "Failed to create VXLAN interface '%s' for '%s': %s",
-                    iface,
-                    nm_connection_get_id(connection),
-                    nm_strerror(r));
-        return FALSE;
-    }
-
+    props->tos          = nm_setting_vxlan_get_tos(s_vxlan);
+    props->ttl          = nm_setting_vxlan_get_ttl(s_vxlan);
+    props->learning     = nm_setting_vxlan_get_learning(s_vxlan);
+    props->ageing       = nm_setting_vxlan_get_ageing(s_vxlan);
+    props->limit        = nm_setting_vxlan_get_limit(s_vxlan);
+    props->src_port_min = nm_setting_vxlan_get_source_port_min(s_vxlan);
+    props->src_port_max = nm_setting_vxlan_get_source_port_max(s_vxlan);
+    props->dst_port     = nm_setting_vxlan_get_destination_port(s_vxlan);
+    props->proxy        = nm_setting_vxlan_get_proxy(s_vxlan);
+    props->rsc          = nm_setting_vxlan_get_rsc(s_vxlan);
+    props->l2miss       = nm_setting_vxlan_get_l2_miss(s_vxlan);
+    props->l3miss       = nm_setting_vxlan_get_l3_miss(s_vxlan);
+
+    op->type       = NM_LINK_TYPE_VXLAN;
+    op->name       = nm_device_get_iface(device);
+    op->extra_data = props;
     return TRUE;
 }
 
@@ -624,7 +613,7 @@ nm_device_vxlan_class_init(NMDeviceVxlanClass *klass)
 
     device_class->link_changed                           = link_changed;
     device_class->unrealize_notify                       = unrealize_notify;
-    device_class->create_and_realize                     = create_and_realize;
+    device_class->create_link_op                         = create_link_op;
     device_class->check_connection_compatible            = check_connection_compatible;
     device_class->complete_connection                    = complete_connection;
     device_class->get_generic_capabilities               = get_generic_capabilities;
@@ -71,6 +71,13 @@ G_STATIC_ASSERT(NM_WIREGUARD_SYMMETRIC_KEY_LEN == NMP_WIREGUARD_SYMMETRIC_KEY_LE
 
 #define RETRY_IN_MSEC_MAX ((gint64) (30 * 60 * 1000))
 
+/* for how long the addresses of a host name are reused for other peers
+ * with the same host. */
+#define RESOLVE_CACHE_TTL_NSEC ((gint64) (60 * NM_UTILS_NSEC_PER_SEC))
+
+/* the maximum number of host names that are resolved in parallel. */
+#define RESOLVE_MAX_RUNNING 16u
+
 typedef enum {
     LINK_CONFIG_MODE_FULL,
     LINK_CONFIG_MODE_REAPPLY,
@@ -108,8 +115,31 @@ typedef struct {
 
     /* dirty flag used during _peers_update_all(). */
     bool dirty_update_all : 1;
+
+    /* whether the peer was added or changed since it was last configured
+     * in platform. With LINK_CONFIG_MODE_REAPPLY, only those are sent. */
+    bool dirty_platform : 1;
 } PeerData;
 
+typedef struct {
+    NMDeviceWireGuard *self;
+    char              *host;
+
+    /* set while the lookup is running. */
+    GCancellable *cancellable;
+
+    /* the GInetAddress results of the last successful lookup, and until when
+     * they can be reused. */
+    GList *addresses;
+    gint64 expiry_nsec;
+
+    /* whether the lookup waits for RESOLVE_MAX_RUNNING. */
+    bool pending : 1;
+
+    /* whether the DNS configuration changed during the lookup. */
+    bool invalidated : 1;
+} ResolveCacheEntry;
+
 NM_GOBJECT_PROPERTIES_DEFINE(NMDeviceWireGuard, PROP_PUBLIC_KEY, PROP_LISTEN_PORT, PROP_FWMARK, );
 
 typedef struct {
@@ -124,6 +154,12 @@ typedef struct {
     /* counts the numbers of peers that are currently resolving. */
     guint peers_resolving_cnt;
 
+    /* host name => ResolveCacheEntry. Peers with the same host name share
+     * the lookup. */
+    GHashTable *resolve_cache;
+    GSource    *resolve_cache_deliver_source;
+    guint       resolve_running;
+
     gint64 resolve_next_try_at;
     gint64 link_config_last_at;
 
@@ -724,29 +760,25 @@ _peers_retry_in_msec(PeerData *peer_data, gboolean after_failure)
     return NM_MIN(RETRY_IN_MSEC_MAX, (1l << peer_data->ep_resolv.resolv_fail_count) * 500);
 }
 
+static const char *
+_peers_get_host(PeerData *peer_data)
+{
+    return nm_sock_addr_endpoint_get_host(_nm_wireguard_peer_get_endpoint(peer_data->peer));
+}
+
 static void
-_peers_resolve_cb(GObject *source_object, GAsyncResult *res, gpointer user_data)
+_peers_resolve_complete(NMDeviceWireGuard *self,
+                        PeerData          *peer_data,
+                        GList             *list,
+                        GError            *resolv_error)
 {
-    NMDeviceWireGuard        *self;
-    NMDeviceWireGuardPrivate *priv;
-    PeerData                 *peer_data;
-    gs_free_error GError     *resolv_error = NULL;
-    GList                    *list;
+    NMDeviceWireGuardPrivate *priv = NM_DEVICE_WIREGUARD_GET_PRIVATE(self);
     gboolean                  changed;
     NMSockAddrUnion           sockaddr;
     gint64                    retry_in_msec;
     char                      s_sockaddr[100];
     char                      s_retry[100];
 
-    list = g_resolver_lookup_by_name_finish(G_RESOLVER(source_object), res, &resolv_error);
-
-    if (nm_utils_error_is_cancelled(resolv_error))
-        return;
-
-    peer_data = user_data;
-    self      = peer_data->self;
-    priv      = NM_DEVICE_WIREGUARD_GET_PRIVATE(self);
-
     if (nm_clear_g_object(&peer_data->ep_resolv.cancellable))
         _peers_resolving_cnt_decrement(self);
 
@@ -824,8 +856,6 @@ _peers_resolve_cb(GObject *source_object, GAsyncResult *res, gpointer user_data)
                 break;
             }
         }
-
-        g_list_free_full(list, g_object_unref);
     }
 
     if (sockaddr.sa.sa_family == AF_UNSPEC) {
@@ -874,13 +904,146 @@ _peers_resolve_cb(GObject *source_object, GAsyncResult *res, gpointer user_data)
 }
 
 static void
-_peers_resolve_start(NMDeviceWireGuard *self, PeerData *peer_data)
+_resolve_cache_entry_free(ResolveCacheEntry *entry)
+{
+    nm_clear_g_cancellable(&entry->cancellable);
+    g_list_free_full(entry->addresses, g_object_unref);
+    g_free(entry->host);
+    nm_g_slice_free(entry);
+}
+
+static void
+_resolve_cache_clear(NMDeviceWireGuard *self)
+{
+    NMDeviceWireGuardPrivate *priv = NM_DEVICE_WIREGUARD_GET_PRIVATE(self);
+
+    /* this cancels the running lookups, their callbacks don't touch
+     * the entries anymore. */
+    nm_clear_pointer(&priv->resolve_cache, g_hash_table_destroy);
+    nm_clear_g_source_inst(&priv->resolve_cache_deliver_source);
+    priv->resolve_running = 0;
+}
+
+static void _resolve_cache_lookup(NMDeviceWireGuard *self, ResolveCacheEntry *entry);
+
+static void
+_resolve_cache_start_pending(NMDeviceWireGuard *self)
+{
+    NMDeviceWireGuardPrivate *priv = NM_DEVICE_WIREGUARD_GET_PRIVATE(self);
+    ResolveCacheEntry        *entry;
+    GHashTableIter            iter;
+
+    if (!priv->resolve_cache)
+        return;
+
+    g_hash_table_iter_init(&iter, priv->resolve_cache);
+    while (priv->resolve_running < RESOLVE_MAX_RUNNING
+           && g_hash_table_iter_next(&iter, NULL, (gpointer *) &entry)) {
+        if (entry->pending)
+            _resolve_cache_lookup(self, entry);
+    }
+}
+
+static void
+_resolve_cache_lookup_cb(GObject *source_object, GAsyncResult *res, gpointer user_data)
+{
+    NMDeviceWireGuard        *self;
+    NMDeviceWireGuardPrivate *priv;
+    ResolveCacheEntry        *entry;
+    PeerData                 *peer_data;
+    gs_free_error GError     *resolv_error = NULL;
+    GList                    *list;
+
+    list = g_resolver_lookup_by_name_finish(G_RESOLVER(source_object), res, &resolv_error);
+
+    if (nm_utils_error_is_cancelled(resolv_error))
+        return;
+
+    entry = user_data;
+    self  = entry->self;
+    priv  = NM_DEVICE_WIREGUARD_GET_PRIVATE(self);
+
+    nm_assert(priv->resolve_running > 0);
+
+    g_clear_object(&entry->cancellable);
+    priv->resolve_running--;
+
+    g_list_free_full(entry->addresses, g_object_unref);
+    entry->addresses = list;
+    if (list && !entry->invalidated)
+        entry->expiry_nsec = nm_utils_get_monotonic_timestamp_nsec() + RESOLVE_CACHE_TTL_NSEC;
+    else
+        entry->expiry_nsec = 0;
+
+    nm_assert((!resolv_error) != (!list));
+
+    /* all peers with this host that are currently resolving wait for
+     * this lookup. */
+    c_list_for_each_entry (peer_data, &priv->lst_peers_head, lst_peers) {
+        if (peer_data->ep_resolv.cancellable && nm_streq0(_peers_get_host(peer_data), entry->host))
+            _peers_resolve_complete(self, peer_data, list, resolv_error);
+    }
+
+    _resolve_cache_start_pending(self);
+}
+
+static void
+_resolve_cache_lookup(NMDeviceWireGuard *self, ResolveCacheEntry *entry)
 {
     NMDeviceWireGuardPrivate  *priv     = NM_DEVICE_WIREGUARD_GET_PRIVATE(self);
     gs_unref_object GResolver *resolver = NULL;
-    const char                *host;
+
+    nm_assert(!entry->cancellable);
+
+    if (priv->resolve_running >= RESOLVE_MAX_RUNNING) {
+        entry->pending = TRUE;
+        return;
+    }
+
+    entry->pending     = FALSE;
+    entry->invalidated = FALSE;
+    entry->cancellable = g_cancellable_new();
+    priv->resolve_running++;
 
     resolver = g_resolver_get_default();
+    g_resolver_lookup_by_name_async(resolver,
+                                    entry->host,
+                                    entry->cancellable,
+                                    _resolve_cache_lookup_cb,
+                                    entry);
+}
+
+static gboolean
+_resolve_cache_deliver_cb(gpointer user_data)
+{
+    NMDeviceWireGuard        *self = user_data;
+    NMDeviceWireGuardPrivate *priv = NM_DEVICE_WIREGUARD_GET_PRIVATE(self);
+    PeerData                 *peer_data;
+
+    nm_clear_g_source_inst(&priv->resolve_cache_deliver_source);
+
+    c_list_for_each_entry (peer_data, &priv->lst_peers_head, lst_peers) {
+        ResolveCacheEntry *entry;
+
+        if (!peer_data->ep_resolv.cancellable)
+            continue;
+
+        entry = g_hash_table_lookup(priv->resolve_cache, _peers_get_host(peer_data));
+        if (!entry || entry->cancellable || entry->pending || !entry->addresses)
+            continue;
+
+        _peers_resolve_complete(self, peer_data, entry->addresses, NULL);
+    }
+
+    return G_SOURCE_CONTINUE;
+}
+
+static void
+_peers_resolve_start(NMDeviceWireGuard *self, PeerData *peer_data)
+{
+    NMDeviceWireGuardPrivate *priv = NM_DEVICE_WIREGUARD_GET_PRIVATE(self);
+    ResolveCacheEntry        *entry;
+    const char               *host;
 
     nm_assert(!peer_data->ep_resolv.cancellable);
 
@@ -894,13 +1057,7 @@ _peers_resolve_start(NMDeviceWireGuard *self, PeerData *peer_data)
      * a next-try timestamp once the try completes. */
     peer_data->ep_resolv.next_try_at_nsec = NEXT_TRY_AT_NSEC_PAST;
 
-    host = nm_sock_addr_endpoint_get_host(_nm_wireguard_peer_get_endpoint(peer_data->peer));
-
-    g_resolver_lookup_by_name_async(resolver,
-                                    host,
-                                    peer_data->ep_resolv.cancellable,
-                                    _peers_resolve_cb,
-                                    peer_data);
+    host = _peers_get_host(peer_data);
 
     _LOGT(LOGD_DEVICE,
           "wireguard-peer[%s]: resolving name \"%s\" for endpoint \"%s\"...",
@@ -908,6 +1065,35 @@ _peers_resolve_start(NMDeviceWireGuard *self, PeerData *peer_data)
           host,
           nm_wireguard_peer_get_endpoint(peer_data->peer));
 
+    if (!priv->resolve_cache) {
+        priv->resolve_cache = g_hash_table_new_full(nm_str_hash,
+                                                    g_str_equal,
+                                                    NULL,
+                                                    (GDestroyNotify) _resolve_cache_entry_free);
+    }
+
+    entry = g_hash_table_lookup(priv->resolve_cache, host);
+    if (!entry) {
+        entry  = g_slice_new(ResolveCacheEntry);
+        *entry = (ResolveCacheEntry) {
+            .self = self,
+            .host = g_strdup(host),
+        };
+        g_hash_table_insert(priv->resolve_cache, entry->host, entry);
+    }
+
+    if (entry->cancellable || entry->pending) {
+        /* the peer gets the result of the lookup that is already in progress. */
+    } else if (entry->addresses
+               && nm_utils_get_monotonic_timestamp_nsec() < entry->expiry_nsec) {
+        /* reuse the recent result. Complete on idle, like a lookup would. */
+        if (!priv->resolve_cache_deliver_source) {
+            priv->resolve_cache_deliver_source =
+                nm_g_idle_add_source(_resolve_cache_deliver_cb, self);
+        }
+    } else
+        _resolve_cache_lookup(self, entry);
+
     nm_assert(_peers_resolving_cnt(priv) == priv->peers_resolving_cnt);
 }
 
@@ -916,6 +1102,18 @@ _peers_resolve_reresolve_all(NMDeviceWireGuard *self)
 {
     NMDeviceWireGuardPrivate *priv = NM_DEVICE_WIREGUARD_GET_PRIVATE(self);
     PeerData                 *peer_data;
+    ResolveCacheEntry        *entry;
+    GHashTableIter            iter;
+
+    /* the DNS configuration changed. Don't reuse earlier results. */
+    if (priv->resolve_cache) {
+        g_hash_table_iter_init(&iter, priv->resolve_cache);
+        while (g_hash_table_iter_next(&iter, NULL, (gpointer *) &entry)) {
+            entry->expiry_nsec = 0;
+            if (entry->cancellable)
+                entry->invalidated = TRUE;
+        }
+    }
 
     c_list_for_each_entry (peer_data, &priv->lst_peers_head, lst_peers) {
         if (peer_data->ep_resolv.cancellable) {
@@ -1024,16 +1222,20 @@ _peers_remove_all(NMDeviceWireGuard *self)
 
     while ((peer_data = c_list_first_entry(&priv->lst_peers_head, PeerData, lst_peers)))
         _peers_remove(self, peer_data);
+
+    _resolve_cache_clear(self);
 }
 
 static void
-_peers_update_all(NMDeviceWireGuard *self, NMSettingWireGuard *s_wg, gboolean *out_peers_removed)
+_peers_update_all(NMDeviceWireGuard  *self,
+                  NMSettingWireGuard *s_wg,
+                  GPtrArray         **out_peers_removed)
 {
-    NMDeviceWireGuardPrivate *priv = NM_DEVICE_WIREGUARD_GET_PRIVATE(self);
-    PeerData                 *peer_data_safe;
-    PeerData                 *peer_data;
-    guint                     i, n;
-    gboolean                  peers_removed = FALSE;
+    NMDeviceWireGuardPrivate    *priv = NM_DEVICE_WIREGUARD_GET_PRIVATE(self);
+    PeerData                    *peer_data_safe;
+    PeerData                    *peer_data;
+    guint                        i, n;
+    gs_unref_ptrarray GPtrArray *peers_removed = NULL;
 
     c_list_for_each_entry (peer_data, &priv->lst_peers_head, lst_peers)
         peer_data->dirty_update_all = TRUE;
@@ -1048,23 +1250,28 @@ _peers_update_all(NMDeviceWireGuard *self, NMSettingWireGuard *s_wg, gboolean *o
             peer_data = _peers_add(self, peer);
             added     = TRUE;
         }
-        _peers_update(self, peer_data, peer, added);
+        if (_peers_update(self, peer_data, peer, added) || added)
+            peer_data->dirty_platform = TRUE;
         peer_data->dirty_update_all = FALSE;
     }
 
     c_list_for_each_entry_safe (peer_data, peer_data_safe, &priv->lst_peers_head, lst_peers) {
         if (peer_data->dirty_update_all) {
+            if (!peers_removed)
+                peers_removed = g_ptr_array_new_with_free_func(g_free);
+            g_ptr_array_add(peers_removed,
+                            g_strdup(nm_wireguard_peer_get_public_key(peer_data->peer)));
             _peers_remove(self, peer_data);
-            peers_removed = TRUE;
         }
     }
 
-    NM_SET_OUT(out_peers_removed, peers_removed);
+    NM_SET_OUT(out_peers_removed, g_steal_pointer(&peers_removed));
 }
 
 static void
 _peers_get_platform_list(NMDeviceWireGuardPrivate            *priv,
                          LinkConfigMode                       config_mode,
+                         const GPtrArray                     *peers_removed,
                          NMPWireGuardPeer                   **out_peers,
                          NMPlatformWireGuardChangePeerFlags **out_peer_flags,
                          guint                               *out_len,
@@ -1089,6 +1296,8 @@ _peers_get_platform_list(NMDeviceWireGuardPrivate            *priv,
 
     nm_assert(len == c_list_length(&priv->lst_peers_head));
 
+    len += nm_g_ptr_array_len(peers_removed);
+
     if (len == 0)
         return;
 
@@ -1096,11 +1305,30 @@ _peers_get_platform_list(NMDeviceWireGuardPrivate            *priv,
     plpeer_flags = g_new0(NMPlatformWireGuardChangePeerFlags, len);
 
     i_good = 0;
+
+    /* Peers are only removed individually on reapply. Otherwise, the
+     * caller replaces all peers. */
+    if (config_mode == LINK_CONFIG_MODE_REAPPLY) {
+        for (i = 0; i < nm_g_ptr_array_len(peers_removed); i++) {
+            if (!nm_utils_base64secret_decode(peers_removed->pdata[i],
+                                              sizeof(plpeers[i_good].public_key),
+                                              plpeers[i_good].public_key))
+                continue;
+            plpeer_flags[i_good] = NM_PLATFORM_WIREGUARD_CHANGE_PEER_FLAG_REMOVE_ME;
+            i_good++;
+        }
+    }
+
     c_list_for_each_entry (peer_data, &priv->lst_peers_head, lst_peers) {
         NMPlatformWireGuardChangePeerFlags *plf = &plpeer_flags[i_good];
         NMPWireGuardPeer                   *plp = &plpeers[i_good];
         NMSettingSecretFlags                psk_secret_flags;
 
+        if (config_mode == LINK_CONFIG_MODE_REAPPLY && !peer_data->dirty_platform) {
+            /* the peer is unchanged since we last configured it. */
+            continue;
+        }
+
         if (!nm_utils_base64secret_decode(nm_wireguard_peer_get_public_key(peer_data->peer),
                                           sizeof(plp->public_key),
                                           plp->public_key))
@@ -1479,7 +1707,8 @@ link_config(NMDeviceWireGuard   *self,
     gs_free NMPlatformWireGuardChangePeerFlags *plpeer_flags = NULL;
     guint                                       plpeers_len  = 0;
     const char                                 *setting_name;
-    gboolean                                    peers_removed;
+    gs_unref_ptrarray GPtrArray                *peers_removed = NULL;
+    PeerData                                   *peer_data;
     NMPlatformWireGuardChangeFlags              wg_change_flags;
     int                                         ifindex;
     int                                         r;
@@ -1537,8 +1766,11 @@ link_config(NMDeviceWireGuard   *self,
 
     wg_change_flags = NM_PLATFORM_WIREGUARD_CHANGE_FLAG_NONE;
 
-    if (NM_IN_SET(config_mode, LINK_CONFIG_MODE_FULL)
-        || (NM_IN_SET(config_mode, LINK_CONFIG_MODE_REAPPLY) && peers_removed))
+    /* On reapply, only the changes to the peers are sent: removed peers get
+     * removed individually and unchanged peers are left alone. With many
+     * peers, replacing all of them is expensive and briefly interrupts the
+     * traffic of all peers. */
+    if (NM_IN_SET(config_mode, LINK_CONFIG_MODE_FULL))
         wg_change_flags |= NM_PLATFORM_WIREGUARD_CHANGE_FLAG_REPLACE_PEERS;
 
     if (NM_IN_SET(config_mode, LINK_CONFIG_MODE_FULL, LINK_CONFIG_MODE_REAPPLY)) {
@@ -1564,6 +1796,7 @@ link_config(NMDeviceWireGuard   *self,
 
     _peers_get_platform_list(priv,
                              config_mode,
+                             peers_removed,
                              &plpeers,
                              &plpeer_flags,
                              &plpeers_len,
@@ -1584,6 +1817,11 @@ link_config(NMDeviceWireGuard   *self,
         return NM_ACT_STAGE_RETURN_FAILURE;
     }
 
+    if (NM_IN_SET(config_mode, LINK_CONFIG_MODE_FULL, LINK_CONFIG_MODE_REAPPLY)) {
+        c_list_for_each_entry (peer_data, &priv->lst_peers_head, lst_peers)
+            peer_data->dirty_platform = FALSE;
+    }
+
     return NM_ACT_STAGE_RETURN_SUCCESS;
 }
 
@@ -2139,6 +2377,9 @@ nm_device_wireguard_class_init(NMDeviceWireGuardClass *klass)
     device_class->get_extra_rules                               = get_extra_rules;
     device_class->coerce_route_table                            = coerce_route_table;
 
+    /* update_connection() uses lnk_curr, and the peers carry ever-changing counters. */
+    device_class->update_connection_uses_external_state = TRUE;
+
     obj_properties[PROP_PUBLIC_KEY] =
         g_param_spec_variant(NM_DEVICE_WIREGUARD_PUBLIC_KEY,
                              "",
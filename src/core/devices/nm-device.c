@@ -15,6 +15,7 @@
 #include <sys/wait.h>
 #include <arpa/inet.h>
 #include <fcntl.h>
+#include <dirent.h>
 #include <netinet/in.h>
 #include <netinet/if_ether.h>
 #include <linux/if.h>
@@ -22,6 +23,7 @@
 #include <linux/rtnetlink.h>
 #include <linux/if_ether.h>
 #include <linux/if_infiniband.h>
+#include <linux/if_link.h>
 #include <libudev.h>
 
 #include "libnm-std-aux/unaligned.h"
@@ -47,6 +49,7 @@
 #include "ndisc/nm-lndp-ndisc.h"
 
 #include "dhcp/nm-dhcp-manager.h"
+#include "dhcp/nm-dhcp-server.h"
 #include "dhcp/nm-dhcp-utils.h"
 #include "nm-act-request.h"
 #include "nm-pacrunner-manager.h"
@@ -66,7 +69,9 @@
 #include "nm-keep-alive.h"
 #include "nm-netns.h"
 #include "nm-dispatcher.h"
+#include "nm-perf.h"
 #include "nm-config.h"
+#include "nm-startup-trace.h"
 #include "c-list/src/c-list.h"
 #include "dns/nm-dns-manager.h"
 #include "libnm-core-intern/nm-core-internal.h"
@@ -279,6 +284,7 @@ typedef struct {
     union {
         struct {
             NMDnsMasqManager     *dnsmasq_manager;
+            NMDhcpServer         *dhcp_server;
             NMNetnsIPReservation *ip_reservation;
             NMFirewallConfig     *firewall_config;
             gulong                dnsmasq_state_id;
@@ -329,9 +335,12 @@ typedef struct {
     NMEthtoolPauseState    *pause;
     NMEthtoolChannelsState *channels;
     NMEthtoolEEEState      *eee;
+    NMEthtoolRssState      *rss;
     uint32_t                fec_mode;
 } EthtoolState;
 
+typedef struct _StatsPoller StatsPoller;
+
 typedef enum {
     RESOLVER_WAIT_ADDRESS = 0,
     RESOLVER_STARTED,
@@ -348,6 +357,16 @@ typedef struct {
     int           addr_family;
 } HostnameResolver;
 
+/* Successful reverse lookups are remembered for a while, shared by all devices.
+ * Clearing the lookup data of the devices (for example, when the DNS configuration
+ * changes) then doesn't immediately cause new queries for the same addresses. */
+#define HOSTNAME_LOOKUP_CACHE_TTL_MSEC (60 * NM_UTILS_MSEC_PER_SEC)
+
+typedef struct {
+    char  *hostname;
+    gint64 expiry_msec;
+} HostnameLookupCacheEntry;
+
 /*****************************************************************************/
 
 enum {
@@ -543,7 +562,6 @@ typedef struct _NMDevicePrivate {
     bool               queued_act_request_is_waiting_for_carrier : 1;
     NMDBusTrackObjPath act_request;
 
-    GSource             *activation_idle_source;
     ActivationHandleFunc activation_func;
 
     guint recheck_assume_id;
@@ -728,6 +746,27 @@ typedef struct _NMDevicePrivate {
         NMPlatformLinkChangeFlags flags;
     } link_props_state;
 
+    /* The neighbor and FDB entries from the link setting that we configured
+     * (NMP_OBJECT_TYPE_NEIGH). They get removed on deactivation and reapply. */
+    GPtrArray *link_neighs;
+
+    /* The original values of the files that we changed for the RPS, XPS and
+     * IRQ affinity of the link setting, by path. Paths relative to the
+     * netdir of the interface with "ifindex", or absolute for /proc/irq. */
+    struct {
+        GHashTable *saved;
+        int         ifindex;
+    } link_steering;
+
+    /* The XDP program that we attached to the interface with "ifindex", with
+     * the XDP_FLAGS_* of the mode. "seen" is set once the platform reports
+     * the program, to notice when a driver reset drops it. */
+    struct {
+        int     ifindex;
+        guint32 flags;
+        bool    seen : 1;
+    } xdp;
+
     /* controller interface for bridge/bond/team port */
     NMDevice *controller;
     gulong    controller_ready_id;
@@ -736,6 +775,16 @@ typedef struct _NMDevicePrivate {
     /* port management */
     CList ports; /* list of PortInfo */
 
+    /* the result of the last nm_device_generate_connection(), and the fingerprint
+     * of the state it was generated from. */
+    struct {
+        NMConnection *connection;
+        GError       *error;
+        guint64       fingerprint;
+        bool          maybe_later : 1;
+        bool          valid : 1;
+    } gen_connection_cache;
+
     NMMetered metered;
 
     NMSettings *settings;
@@ -778,10 +827,10 @@ typedef struct _NMDevicePrivate {
     guint sriov_reset_pending;
 
     struct {
-        GSource *timeout_source;
-        guint    refresh_rate_ms;
-        guint64  tx_bytes;
-        guint64  rx_bytes;
+        StatsPoller *poller;
+        guint        refresh_rate_ms;
+        guint64      tx_bytes;
+        guint64      rx_bytes;
     } stats;
 
     bool mtu_force_set_done : 1;
@@ -833,6 +882,9 @@ static GBytes *_prop_get_ipv6_dhcp_duid(NMDevice     *self,
                                         gboolean     *out_enforce);
 
 static const char *_activation_func_to_string(ActivationHandleFunc func);
+static void        activate_stage1_device_prepare(NMDevice *self);
+static void        activate_stage2_device_config(NMDevice *self);
+static void        activate_stage3_ip_config(NMDevice *self);
 
 static void
 _set_state_full(NMDevice *self, NMDeviceState state, NMDeviceStateReason reason, gboolean quitting);
@@ -3132,6 +3184,86 @@ _ethtool_channels_set(NMDevice         *self,
     _LOGD(LOGD_DEVICE, "ethtool: channels settings successfully set");
 }
 
+static void
+_ethtool_rss_reset(NMDevice *self, NMPlatform *platform, EthtoolState *ethtool_state)
+{
+    gs_free NMEthtoolRssState *rss = NULL;
+
+    nm_assert(NM_IS_DEVICE(self));
+    nm_assert(NM_IS_PLATFORM(platform));
+    nm_assert(ethtool_state);
+
+    rss = g_steal_pointer(&ethtool_state->rss);
+    if (!rss)
+        return;
+
+    if (!nm_platform_ethtool_set_rss(platform, ethtool_state->ifindex, rss))
+        _LOGW(LOGD_DEVICE, "ethtool: failure resetting RSS settings");
+    else
+        _LOGD(LOGD_DEVICE, "ethtool: RSS settings successfully reset");
+}
+
+static void
+_ethtool_rss_set(NMDevice         *self,
+                 NMPlatform       *platform,
+                 EthtoolState     *ethtool_state,
+                 NMSettingEthtool *s_ethtool)
+{
+    gs_free NMEthtoolRssState *rss_old = NULL;
+    gs_free NMEthtoolRssState *rss_new = NULL;
+    guint32                    n_queues;
+    guint32                    hfunc;
+    guint32                    i;
+
+    nm_assert(NM_IS_DEVICE(self));
+    nm_assert(NM_IS_PLATFORM(platform));
+    nm_assert(NM_IS_SETTING_ETHTOOL(s_ethtool));
+    nm_assert(ethtool_state);
+    nm_assert(!ethtool_state->rss);
+
+    if (!nm_setting_option_get_uint32(NM_SETTING(s_ethtool),
+                                      NM_ETHTOOL_OPTNAME_RSS_EQUAL,
+                                      &n_queues))
+        n_queues = 0;
+    if (!nm_setting_option_get_uint32(NM_SETTING(s_ethtool), NM_ETHTOOL_OPTNAME_RSS_HFUNC, &hfunc))
+        hfunc = 0;
+
+    if (n_queues == 0 && hfunc == 0)
+        return;
+
+    rss_old = nm_platform_ethtool_get_rss(platform, ethtool_state->ifindex);
+    if (!rss_old) {
+        _LOGW(LOGD_DEVICE, "ethtool: failure setting RSS options (cannot read existing setting)");
+        return;
+    }
+
+    if (n_queues > 0 && rss_old->indir_size == 0) {
+        _LOGW(LOGD_DEVICE, "ethtool: the device has no RSS indirection table");
+        n_queues = 0;
+        if (hfunc == 0)
+            return;
+    }
+
+    rss_new = g_malloc0(sizeof(NMEthtoolRssState)
+                        + (n_queues > 0 ? rss_old->indir_size : 0u) * sizeof(guint32));
+    rss_new->hfunc = hfunc;
+    if (n_queues > 0) {
+        /* Like "ethtool -X equal N": spread the table over the first N queues. */
+        rss_new->indir_size = rss_old->indir_size;
+        for (i = 0; i < rss_new->indir_size; i++)
+            rss_new->indir[i] = i % n_queues;
+    }
+
+    ethtool_state->rss = g_steal_pointer(&rss_old);
+
+    if (!nm_platform_ethtool_set_rss(platform, ethtool_state->ifindex, rss_new)) {
+        _LOGW(LOGD_DEVICE, "ethtool: failure setting RSS settings");
+        return;
+    }
+
+    _LOGD(LOGD_DEVICE, "ethtool: RSS settings successfully set");
+}
+
 static void
 _ethtool_pause_reset(NMDevice *self, NMPlatform *platform, EthtoolState *ethtool_state)
 {
@@ -3339,6 +3471,7 @@ _ethtool_state_reset(NMDevice *self)
     _ethtool_coalesce_reset(self, platform, ethtool_state);
     _ethtool_ring_reset(self, platform, ethtool_state);
     _ethtool_pause_reset(self, platform, ethtool_state);
+    _ethtool_rss_reset(self, platform, ethtool_state);
     _ethtool_channels_reset(self, platform, ethtool_state);
     _ethtool_eee_reset(self, platform, ethtool_state);
     _ethtool_fec_reset(self, platform, ethtool_state);
@@ -3377,15 +3510,132 @@ _ethtool_state_set(NMDevice *self)
     _ethtool_ring_set(self, platform, ethtool_state, s_ethtool);
     _ethtool_pause_set(self, platform, ethtool_state, s_ethtool);
     _ethtool_channels_set(self, platform, ethtool_state, s_ethtool);
+    _ethtool_rss_set(self, platform, ethtool_state, s_ethtool);
     _ethtool_eee_set(self, platform, ethtool_state, s_ethtool);
     _ethtool_fec_set(self, platform, ethtool_state, s_ethtool);
 
     if (ethtool_state->features || ethtool_state->coalesce || ethtool_state->ring
-        || ethtool_state->pause || ethtool_state->channels || ethtool_state->eee
-        || ethtool_state->fec_mode != 0)
+        || ethtool_state->pause || ethtool_state->channels || ethtool_state->rss
+        || ethtool_state->eee || ethtool_state->fec_mode != 0)
         priv->ethtool_state = g_steal_pointer(&ethtool_state);
 }
 
+/* Reapply only the groups of ethtool options that are in @diff (the
+ * changed keys of the "ethtool" setting). The other options stay as they
+ * are and are not written again. */
+static void
+_ethtool_state_reapply(NMDevice *self, GHashTable *diff)
+{
+    NMDevicePrivate  *priv          = NM_DEVICE_GET_PRIVATE(self);
+    NMPlatform       *platform      = nm_device_get_platform(self);
+    EthtoolState     *ethtool_state = priv->ethtool_state;
+    NMSettingEthtool *s_ethtool;
+    GHashTableIter    iter;
+    const char       *name;
+    gboolean          features = FALSE;
+    gboolean          coalesce = FALSE;
+    gboolean          ring     = FALSE;
+    gboolean          pause    = FALSE;
+    gboolean          channels = FALSE;
+    gboolean          rss      = FALSE;
+    gboolean          eee      = FALSE;
+    gboolean          fec      = FALSE;
+    int               ifindex;
+
+    ifindex = nm_device_get_ip_ifindex(self);
+    if (ifindex <= 0)
+        return;
+
+    if (ethtool_state && ethtool_state->ifindex != ifindex) {
+        _ethtool_state_reset(self);
+        _ethtool_state_set(self);
+        return;
+    }
+
+    g_hash_table_iter_init(&iter, diff);
+    while (g_hash_table_iter_next(&iter, (gpointer *) &name, NULL)) {
+        NMEthtoolID ethtool_id = nm_ethtool_id_get_by_name(name);
+
+        if (nm_ethtool_id_is_feature(ethtool_id))
+            features = TRUE;
+        else if (nm_ethtool_id_is_coalesce(ethtool_id))
+            coalesce = TRUE;
+        else if (nm_ethtool_id_is_ring(ethtool_id))
+            ring = TRUE;
+        else if (nm_ethtool_id_is_pause(ethtool_id))
+            pause = TRUE;
+        else if (nm_ethtool_id_is_channels(ethtool_id))
+            channels = TRUE;
+        else if (nm_ethtool_id_is_eee(ethtool_id))
+            eee = TRUE;
+        else if (nm_ethtool_id_is_fec(ethtool_id))
+            fec = TRUE;
+        else if (nm_ethtool_id_is_rss(ethtool_id))
+            rss = TRUE;
+        else {
+            features = coalesce = ring = pause = channels = rss = eee = fec = TRUE;
+            break;
+        }
+    }
+
+    if (!ethtool_state) {
+        ethtool_state          = g_new0(EthtoolState, 1);
+        ethtool_state->ifindex = ifindex;
+        priv->ethtool_state    = ethtool_state;
+    }
+
+    s_ethtool = nm_device_get_applied_setting(self, NM_TYPE_SETTING_ETHTOOL);
+
+    if (features) {
+        _ethtool_features_reset(self, platform, ethtool_state);
+        if (s_ethtool)
+            _ethtool_features_set(self, platform, ethtool_state, s_ethtool);
+    }
+    if (coalesce) {
+        _ethtool_coalesce_reset(self, platform, ethtool_state);
+        if (s_ethtool)
+            _ethtool_coalesce_set(self, platform, ethtool_state, s_ethtool);
+    }
+    if (ring) {
+        _ethtool_ring_reset(self, platform, ethtool_state);
+        if (s_ethtool)
+            _ethtool_ring_set(self, platform, ethtool_state, s_ethtool);
+    }
+    if (pause) {
+        _ethtool_pause_reset(self, platform, ethtool_state);
+        if (s_ethtool)
+            _ethtool_pause_set(self, platform, ethtool_state, s_ethtool);
+    }
+    if (channels || rss) {
+        /* The indirection table refers to the RX queues. Restore it
+         * before the channels change, and set it again afterwards. */
+        _ethtool_rss_reset(self, platform, ethtool_state);
+    }
+    if (channels) {
+        _ethtool_channels_reset(self, platform, ethtool_state);
+        if (s_ethtool)
+            _ethtool_channels_set(self, platform, ethtool_state, s_ethtool);
+    }
+    if ((channels || rss) && s_ethtool)
+        _ethtool_rss_set(self, platform, ethtool_state, s_ethtool);
+    if (eee) {
+        _ethtool_eee_reset(self, platform, ethtool_state);
+        if (s_ethtool)
+            _ethtool_eee_set(self, platform, ethtool_state, s_ethtool);
+    }
+    if (fec) {
+        _ethtool_fec_reset(self, platform, ethtool_state);
+        ethtool_state->fec_mode = 0;
+        if (s_ethtool)
+            _ethtool_fec_set(self, platform, ethtool_state, s_ethtool);
+    }
+
+    if (!ethtool_state->features && !ethtool_state->coalesce && !ethtool_state->ring
+        && !ethtool_state->pause && !ethtool_state->channels && !ethtool_state->rss
+        && !ethtool_state->eee && ethtool_state->fec_mode == 0)
+        nm_clear_g_free(&priv->ethtool_state);
+}
+
 static NMPlatformLinkChangeFlags
 link_properties_fill_from_setting(NMDevice *self, NMPlatformLinkProps *props)
 {
@@ -3423,9 +3673,101 @@ link_properties_fill_from_setting(NMDevice *self, NMPlatformLinkProps *props)
         flags |= NM_PLATFORM_LINK_CHANGE_GRO_MAX_SIZE;
     }
 
+    v = nm_setting_link_get_gso_ipv4_max_size(s_link);
+    if (v != -1) {
+        props->gso_ipv4_max_size = (guint32) v;
+        flags |= NM_PLATFORM_LINK_CHANGE_GSO_IPV4_MAX_SIZE;
+    }
+
+    v = nm_setting_link_get_gro_ipv4_max_size(s_link);
+    if (v != -1) {
+        props->gro_ipv4_max_size = (guint32) v;
+        flags |= NM_PLATFORM_LINK_CHANGE_GRO_IPV4_MAX_SIZE;
+    }
+
     return flags;
 }
 
+static GPtrArray *
+link_neighs_from_setting(NMDevice *self, int ifindex)
+{
+    GPtrArray     *neighs = NULL;
+    NMSettingLink *s_link;
+    guint          i;
+    guint          j;
+
+    s_link = nm_device_get_applied_setting(self, NM_TYPE_SETTING_LINK);
+    if (!s_link)
+        return NULL;
+
+    for (j = 0; j < 2; j++) {
+        const char *const *strv;
+        guint              len;
+
+        strv = j == 0 ? nm_setting_link_get_neighbors(s_link, &len)
+                      : nm_setting_link_get_fdb_entries(s_link, &len);
+
+        for (i = 0; i < len; i++) {
+            gs_free_error GError *error = NULL;
+            NMPlatformNeigh       neigh;
+
+            neigh = (NMPlatformNeigh) {
+                .ifindex = ifindex,
+            };
+
+            if (!_nm_setting_link_parse_neigh(strv[i],
+                                              j == 1,
+                                              &neigh.dst_family,
+                                              &neigh.dst,
+                                              &neigh.lladdr,
+                                              &error)) {
+                /* The setting was verified, this cannot happen. */
+                _LOGW(LOGD_DEVICE, "link: ignore invalid entry: %s", error->message);
+                continue;
+            }
+
+            if (j == 0) {
+                neigh.addr_family = neigh.dst_family;
+                neigh.state       = NUD_PERMANENT;
+            } else {
+                neigh.addr_family = AF_BRIDGE;
+                neigh.state       = NUD_NOARP;
+                neigh.flags       = NTF_SELF;
+            }
+
+            if (!neighs)
+                neighs = g_ptr_array_new_with_free_func((GDestroyNotify) nmp_object_unref);
+            g_ptr_array_add(neighs, nmp_object_new(NMP_OBJECT_TYPE_NEIGH, &neigh));
+        }
+    }
+
+    return neighs;
+}
+
+static void
+link_neighs_set(NMDevice *self, int ifindex)
+{
+    NMDevicePrivate             *priv   = NM_DEVICE_GET_PRIVATE(self);
+    gs_unref_ptrarray GPtrArray *neighs = NULL;
+
+    if (priv->link_neighs
+        && NMP_OBJECT_CAST_NEIGH(priv->link_neighs->pdata[0])->ifindex != ifindex) {
+        /* The interface changed, the old entries are gone. */
+        nm_clear_pointer(&priv->link_neighs, g_ptr_array_unref);
+    }
+
+    neighs = link_neighs_from_setting(self, ifindex);
+
+    if (!neighs && !priv->link_neighs)
+        return;
+
+    if (!nm_platform_neigh_sync(nm_device_get_platform(self), ifindex, neighs, priv->link_neighs))
+        _LOGW(LOGD_DEVICE, "link: failure configuring neighbor and FDB entries");
+
+    nm_clear_pointer(&priv->link_neighs, g_ptr_array_unref);
+    priv->link_neighs = g_steal_pointer(&neighs);
+}
+
 void
 nm_device_link_properties_set(NMDevice *self, gboolean reapply)
 {
@@ -3445,6 +3787,8 @@ nm_device_link_properties_set(NMDevice *self, gboolean reapply)
 
     priv->link_props_set = TRUE;
 
+    link_neighs_set(self, ifindex);
+
     flags = link_properties_fill_from_setting(self, &props);
 
     if (flags == NM_PLATFORM_LINK_CHANGE_NONE
@@ -3492,6 +3836,30 @@ nm_device_link_properties_set(NMDevice *self, gboolean reapply)
     _RESET(NM_PLATFORM_LINK_CHANGE_GSO_MAX_SIZE, gso_max_size);
     _RESET(NM_PLATFORM_LINK_CHANGE_GSO_MAX_SEGMENTS, gso_max_segments);
     _RESET(NM_PLATFORM_LINK_CHANGE_GRO_MAX_SIZE, gro_max_size);
+    _RESET(NM_PLATFORM_LINK_CHANGE_GSO_IPV4_MAX_SIZE, gso_ipv4_max_size);
+    _RESET(NM_PLATFORM_LINK_CHANGE_GRO_IPV4_MAX_SIZE, gro_ipv4_max_size);
+
+#define _UNCHANGED(_f, _field)                                                   \
+    if (NM_FLAGS_HAS(flags, (_f)) && props._field == plink->link_props._field) { \
+        flags &= ~(_f);                                                          \
+    }
+
+    /* Only send the properties that differ from the current ones, so that
+     * a reapply without changes does not touch the link. */
+    plink = nm_platform_link_get(platform, ifindex);
+    if (plink) {
+        _UNCHANGED(NM_PLATFORM_LINK_CHANGE_TX_QUEUE_LENGTH, tx_queue_length);
+        _UNCHANGED(NM_PLATFORM_LINK_CHANGE_GSO_MAX_SIZE, gso_max_size);
+        _UNCHANGED(NM_PLATFORM_LINK_CHANGE_GSO_MAX_SEGMENTS, gso_max_segments);
+        _UNCHANGED(NM_PLATFORM_LINK_CHANGE_GRO_MAX_SIZE, gro_max_size);
+        _UNCHANGED(NM_PLATFORM_LINK_CHANGE_GSO_IPV4_MAX_SIZE, gso_ipv4_max_size);
+        _UNCHANGED(NM_PLATFORM_LINK_CHANGE_GRO_IPV4_MAX_SIZE, gro_ipv4_max_size);
+    }
+
+    if (flags == NM_PLATFORM_LINK_CHANGE_NONE) {
+        _LOGD(LOGD_DEVICE, "link properties already set");
+        return;
+    }
 
     if (nm_platform_link_change(platform, ifindex, &props, NULL, NULL, flags)) {
         _LOGD(LOGD_DEVICE, "link properties successfully set");
@@ -3507,10 +3875,22 @@ link_properties_reset(NMDevice *self)
     NMPlatform      *platform;
     int              ifindex;
 
+    ifindex = nm_device_get_ip_ifindex(self);
+
+    if (priv->link_neighs) {
+        if (ifindex > 0
+            && NMP_OBJECT_CAST_NEIGH(priv->link_neighs->pdata[0])->ifindex == ifindex) {
+            nm_platform_neigh_sync(nm_device_get_platform(self),
+                                   ifindex,
+                                   NULL,
+                                   priv->link_neighs);
+        }
+        nm_clear_pointer(&priv->link_neighs, g_ptr_array_unref);
+    }
+
     if (priv->link_props_state.flags == 0)
         goto out;
 
-    ifindex = nm_device_get_ip_ifindex(self);
     if (ifindex <= 0)
         goto out;
 
@@ -3535,6 +3915,420 @@ out:
 
 /*****************************************************************************/
 
+static char *
+_link_steering_sysctl_get(NMPlatform *platform, int dirfd, const char *ifname, const char *path)
+{
+    if (path[0] == '/')
+        return nm_platform_sysctl_get(platform, NMP_SYSCTL_PATHID_ABSOLUTE(path));
+    return nm_platform_sysctl_get(platform,
+                                  NMP_SYSCTL_PATHID_NETDIR_UNSAFE_A(dirfd, ifname, path));
+}
+
+static gboolean
+_link_steering_sysctl_set(NMPlatform *platform,
+                          int         dirfd,
+                          const char *ifname,
+                          const char *path,
+                          const char *value)
+{
+    if (path[0] == '/')
+        return nm_platform_sysctl_set(platform, NMP_SYSCTL_PATHID_ABSOLUTE(path), value);
+    return nm_platform_sysctl_set(platform,
+                                  NMP_SYSCTL_PATHID_NETDIR_UNSAFE_A(dirfd, ifname, path),
+                                  value);
+}
+
+/* Returns the sorted numbers of the entries "@prefix<N>" in the directory
+ * @path, like the "rx-N" queues in "queues". */
+static GArray *
+_link_steering_list_dir(int dirfd, const char *path, const char *prefix)
+{
+    GArray        *arr;
+    DIR           *dir;
+    struct dirent *ent;
+    int            fd;
+
+    fd = openat(dirfd, path, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (fd < 0)
+        return NULL;
+
+    dir = fdopendir(fd);
+    if (!dir) {
+        nm_close(fd);
+        return NULL;
+    }
+
+    arr = g_array_new(FALSE, FALSE, sizeof(guint32));
+    while ((ent = readdir(dir))) {
+        gint64 n;
+
+        if (!g_str_has_prefix(ent->d_name, prefix))
+            continue;
+        n = _nm_utils_ascii_str_to_int64(&ent->d_name[strlen(prefix)], 10, 0, G_MAXUINT32, -1);
+        if (n >= 0) {
+            const guint32 n32 = n;
+
+            g_array_append_val(arr, n32);
+        }
+    }
+    closedir(dir);
+
+    g_array_sort_with_data(arr, nm_cmp_uint32_p_with_data, NULL);
+    return arr;
+}
+
+static GArray *
+_link_steering_get_cpus(NMDevice   *self,
+                        int         dirfd,
+                        const char *ifname,
+                        const char *prop_name,
+                        const char *str)
+{
+    gs_free char *local_cpus = NULL;
+    GArray       *cpus;
+
+    if (!str)
+        return NULL;
+
+    if (nm_streq(str, "numa-local")) {
+        local_cpus = nm_platform_sysctl_get(
+            nm_device_get_platform(self),
+            NMP_SYSCTL_PATHID_NETDIR_A(dirfd, ifname, "device/local_cpulist"));
+        if (!local_cpus) {
+            _LOGW(LOGD_DEVICE, "link: cannot get the NUMA-local CPUs for %s", prop_name);
+            return NULL;
+        }
+        str = local_cpus;
+    }
+
+    cpus = nm_utils_cpu_list_parse(str);
+    if (!cpus)
+        _LOGW(LOGD_DEVICE, "link: invalid CPU list \"%s\" for %s", str, prop_name);
+    return cpus;
+}
+
+static void
+_link_steering_write(NMDevice   *self,
+                     int         dirfd,
+                     const char *ifname,
+                     const char *path,
+                     const char *value,
+                     GHashTable *written)
+{
+    NMDevicePrivate *priv     = NM_DEVICE_GET_PRIVATE(self);
+    NMPlatform      *platform = nm_device_get_platform(self);
+    gpointer         path_saved;
+
+    if (!g_hash_table_lookup_extended(priv->link_steering.saved, path, &path_saved, NULL)) {
+        char *value_old;
+
+        /* Remember the original value only the first time, a reapply must
+         * not overwrite it. */
+        value_old = _link_steering_sysctl_get(platform, dirfd, ifname, path);
+        if (!value_old) {
+            _LOGD(LOGD_DEVICE, "link: cannot read \"%s\", skip it", path);
+            return;
+        }
+        path_saved = g_strdup(path);
+        g_hash_table_insert(priv->link_steering.saved, path_saved, value_old);
+    }
+
+    g_hash_table_add(written, path_saved);
+
+    if (!_link_steering_sysctl_set(platform, dirfd, ifname, path, value))
+        _LOGW(LOGD_DEVICE, "link: failure setting \"%s\" to \"%s\"", path, value);
+}
+
+/* Configures the NAPI polling, the receive and transmit packet steering and
+ * the IRQ affinity from the link setting. This must happen after the ethtool
+ * channels are configured, because they determine the number of queues and
+ * interrupts. */
+static void
+link_steering_set(NMDevice *self)
+{
+    NMDevicePrivate               *priv           = NM_DEVICE_GET_PRIVATE(self);
+    NMPlatform                    *platform       = nm_device_get_platform(self);
+    gs_unref_hashtable GHashTable *written        = NULL;
+    gs_unref_array GArray         *rps_cpus       = NULL;
+    gs_unref_array GArray         *xps_cpus       = NULL;
+    gs_unref_array GArray         *irq_cpus       = NULL;
+    gs_unref_array GArray         *queues         = NULL;
+    gs_unref_array GArray         *irqs           = NULL;
+    nm_auto_close int              dirfd          = -1;
+    gint64                         rps_flow_count = -1;
+    NMSettingLink                 *s_link;
+    GHashTableIter                 iter;
+    const char                    *path;
+    const char                    *value;
+    char                           ifname[IFNAMSIZ];
+    char                           path_buf[100];
+    char                           sbuf[30];
+    int                            ifindex;
+    guint                          i;
+
+    ifindex = nm_device_get_ip_ifindex(self);
+    if (ifindex <= 0)
+        return;
+
+    if (priv->link_steering.saved && priv->link_steering.ifindex != ifindex) {
+        /* The interface changed, the saved values belong to the old one. */
+        nm_clear_pointer(&priv->link_steering.saved, g_hash_table_unref);
+    }
+
+    s_link = nm_device_get_applied_setting(self, NM_TYPE_SETTING_LINK);
+    if (s_link) {
+        rps_flow_count = nm_setting_link_get_rps_flow_count(s_link);
+        if (!nm_setting_link_get_rps_cpus(s_link) && !nm_setting_link_get_xps_cpus(s_link)
+            && !nm_setting_link_get_irq_affinity(s_link) && rps_flow_count == -1
+            && nm_setting_link_get_napi_threaded(s_link) == -1
+            && nm_setting_link_get_napi_defer_hard_irqs(s_link) == -1
+            && nm_setting_link_get_gro_flush_timeout(s_link) == -1)
+            s_link = NULL;
+    }
+
+    if (!s_link && !priv->link_steering.saved)
+        return;
+
+    dirfd = nm_platform_sysctl_open_netdir(platform, ifindex, ifname);
+    if (dirfd < 0)
+        return;
+
+    if (!priv->link_steering.saved) {
+        priv->link_steering.saved =
+            g_hash_table_new_full(nm_str_hash, g_str_equal, g_free, g_free);
+        priv->link_steering.ifindex = ifindex;
+    }
+    written = g_hash_table_new(nm_str_hash, g_str_equal);
+
+    if (s_link) {
+        const struct {
+            const char *path;
+            gint64      value;
+        } napi[] = {
+            {"threaded", nm_setting_link_get_napi_threaded(s_link)},
+            {"napi_defer_hard_irqs", nm_setting_link_get_napi_defer_hard_irqs(s_link)},
+            {"gro_flush_timeout", nm_setting_link_get_gro_flush_timeout(s_link)},
+        };
+
+        /* These are per device and also apply to the NAPI instances that the
+         * driver creates again after a reset. */
+        for (i = 0; i < G_N_ELEMENTS(napi); i++) {
+            if (napi[i].value == -1)
+                continue;
+            _link_steering_write(self,
+                                 dirfd,
+                                 ifname,
+                                 napi[i].path,
+                                 nm_sprintf_buf(sbuf, "%" G_GINT64_FORMAT, napi[i].value),
+                                 written);
+        }
+
+        rps_cpus = _link_steering_get_cpus(self,
+                                           dirfd,
+                                           ifname,
+                                           NM_SETTING_LINK_RPS_CPUS,
+                                           nm_setting_link_get_rps_cpus(s_link));
+        xps_cpus = _link_steering_get_cpus(self,
+                                           dirfd,
+                                           ifname,
+                                           NM_SETTING_LINK_XPS_CPUS,
+                                           nm_setting_link_get_xps_cpus(s_link));
+        irq_cpus = _link_steering_get_cpus(self,
+                                           dirfd,
+                                           ifname,
+                                           NM_SETTING_LINK_IRQ_AFFINITY,
+                                           nm_setting_link_get_irq_affinity(s_link));
+    }
+
+    if (rps_cpus || rps_flow_count != -1) {
+        gs_free char *mask = NULL;
+
+        if (rps_cpus)
+            mask = nm_utils_cpu_mask_to_string(&nm_g_array_index(rps_cpus, guint, 0),
+                                               rps_cpus->len);
+
+        queues = _link_steering_list_dir(dirfd, "queues", "rx-");
+        for (i = 0; queues && i < queues->len; i++) {
+            const guint32 q = nm_g_array_index(queues, guint32, i);
+
+            if (mask) {
+                nm_sprintf_buf(path_buf, "queues/rx-%u/rps_cpus", q);
+                _link_steering_write(self, dirfd, ifname, path_buf, mask, written);
+            }
+            if (rps_flow_count != -1) {
+                nm_sprintf_buf(path_buf, "queues/rx-%u/rps_flow_cnt", q);
+                _link_steering_write(self,
+                                     dirfd,
+                                     ifname,
+                                     path_buf,
+                                     nm_sprintf_buf(sbuf, "%" G_GINT64_FORMAT, rps_flow_count),
+                                     written);
+            }
+        }
+        nm_clear_pointer(&queues, g_array_unref);
+    }
+
+    if (xps_cpus) {
+        /* Each transmit queue gets one CPU, in a round-robin fashion. */
+        queues = _link_steering_list_dir(dirfd, "queues", "tx-");
+        for (i = 0; queues && i < queues->len; i++) {
+            const guint   cpu  = nm_g_array_index(xps_cpus, guint, i % xps_cpus->len);
+            gs_free char *mask = nm_utils_cpu_mask_to_string(&cpu, 1);
+
+            nm_sprintf_buf(path_buf, "queues/tx-%u/xps_cpus", nm_g_array_index(queues, guint32, i));
+            _link_steering_write(self, dirfd, ifname, path_buf, mask, written);
+        }
+    }
+
+    if (irq_cpus) {
+        /* The same for the MSI interrupts of the device. */
+        irqs = _link_steering_list_dir(dirfd, "device/msi_irqs", "");
+        for (i = 0; irqs && i < irqs->len; i++) {
+            nm_sprintf_buf(path_buf,
+                           "/proc/irq/%u/smp_affinity_list",
+                           nm_g_array_index(irqs, guint32, i));
+            nm_sprintf_buf(sbuf, "%u", nm_g_array_index(irq_cpus, guint, i % irq_cpus->len));
+            _link_steering_write(self, dirfd, ifname, path_buf, sbuf, written);
+        }
+    }
+
+    /* Restore the values that we changed earlier, but no longer configure. */
+    g_hash_table_iter_init(&iter, priv->link_steering.saved);
+    while (g_hash_table_iter_next(&iter, (gpointer *) &path, (gpointer *) &value)) {
+        if (g_hash_table_contains(written, path))
+            continue;
+        if (!_link_steering_sysctl_set(platform, dirfd, ifname, path, value))
+            _LOGD(LOGD_DEVICE, "link: failure restoring \"%s\"", path);
+        g_hash_table_iter_remove(&iter);
+    }
+
+    if (g_hash_table_size(priv->link_steering.saved) == 0)
+        nm_clear_pointer(&priv->link_steering.saved, g_hash_table_unref);
+}
+
+static void
+link_steering_reset(NMDevice *self)
+{
+    NMDevicePrivate  *priv     = NM_DEVICE_GET_PRIVATE(self);
+    NMPlatform       *platform = nm_device_get_platform(self);
+    nm_auto_close int dirfd    = -1;
+    GHashTableIter    iter;
+    const char       *path;
+    const char       *value;
+    char              ifname[IFNAMSIZ];
+    int               ifindex;
+
+    if (!priv->link_steering.saved)
+        return;
+
+    ifindex = nm_device_get_ip_ifindex(self);
+    if (ifindex > 0 && ifindex == priv->link_steering.ifindex)
+        dirfd = nm_platform_sysctl_open_netdir(platform, ifindex, ifname);
+
+    /* The IRQ affinity gets restored even if the interface is gone. */
+    g_hash_table_iter_init(&iter, priv->link_steering.saved);
+    while (g_hash_table_iter_next(&iter, (gpointer *) &path, (gpointer *) &value)) {
+        if (path[0] != '/' && dirfd < 0)
+            continue;
+        if (!_link_steering_sysctl_set(platform, dirfd, ifname, path, value))
+            _LOGD(LOGD_DEVICE, "link: failure restoring \"%s\"", path);
+    }
+
+    nm_clear_pointer(&priv->link_steering.saved, g_hash_table_unref);
+}
+
+static void
+link_xdp_reset(NMDevice *self)
+{
+    NMDevicePrivate *priv = NM_DEVICE_GET_PRIVATE(self);
+    int              r;
+
+    if (priv->xdp.ifindex <= 0)
+        return;
+
+    if (priv->xdp.ifindex == nm_device_get_ip_ifindex(self)) {
+        r = nm_platform_link_set_xdp(nm_device_get_platform(self),
+                                     priv->xdp.ifindex,
+                                     -1,
+                                     priv->xdp.flags);
+        if (r < 0)
+            _LOGD(LOGD_DEVICE, "link: failure detaching XDP program: %s", nm_strerror(r));
+    }
+
+    priv->xdp.ifindex = 0;
+    priv->xdp.flags   = 0;
+    priv->xdp.seen    = FALSE;
+}
+
+/* Attaches the pinned XDP program of the link setting. Like the packet
+ * steering, this must happen after the ethtool channels and rings are
+ * configured, as drivers need to set up their XDP queues for them. */
+static void
+link_xdp_set(NMDevice *self)
+{
+    NMDevicePrivate  *priv    = NM_DEVICE_GET_PRIVATE(self);
+    nm_auto_close int prog_fd = -1;
+    NMSettingLink    *s_link;
+    const char       *path = NULL;
+    const char       *mode = NULL;
+    guint32           flags;
+    int               ifindex;
+    int               r;
+
+    ifindex = nm_device_get_ip_ifindex(self);
+    if (ifindex <= 0)
+        return;
+
+    s_link = nm_device_get_applied_setting(self, NM_TYPE_SETTING_LINK);
+    if (s_link) {
+        path = nm_setting_link_get_xdp_program(s_link);
+        mode = nm_setting_link_get_xdp_mode(s_link);
+    }
+
+    if (!path) {
+        link_xdp_reset(self);
+        return;
+    }
+
+    if (nm_streq0(mode, "native"))
+        flags = XDP_FLAGS_DRV_MODE;
+    else if (nm_streq0(mode, "generic"))
+        flags = XDP_FLAGS_SKB_MODE;
+    else if (nm_streq0(mode, "offload"))
+        flags = XDP_FLAGS_HW_MODE;
+    else
+        flags = 0;
+
+    /* The kernel does not allow programs in the native and generic mode at
+     * the same time. Detach the previous program if the mode changed. */
+    if (priv->xdp.ifindex != ifindex || priv->xdp.flags != flags)
+        link_xdp_reset(self);
+
+    prog_fd = nmp_utils_bpf_obj_get(path);
+    if (prog_fd < 0) {
+        _LOGW(LOGD_DEVICE,
+              "link: cannot open XDP program \"%s\": %s",
+              path,
+              nm_strerror_native(-prog_fd));
+        link_xdp_reset(self);
+        return;
+    }
+
+    r = nm_platform_link_set_xdp(nm_device_get_platform(self), ifindex, prog_fd, flags);
+    if (r < 0) {
+        _LOGW(LOGD_DEVICE, "link: failure attaching XDP program \"%s\": %s", path, nm_strerror(r));
+        link_xdp_reset(self);
+        return;
+    }
+
+    _LOGD(LOGD_DEVICE, "link: attached XDP program \"%s\"", path);
+    priv->xdp.ifindex = ifindex;
+    priv->xdp.flags   = flags;
+    priv->xdp.seen    = FALSE;
+}
+
+/*****************************************************************************/
+
 gboolean
 nm_device_is_vpn(NMDevice *self)
 {
@@ -3972,6 +4766,27 @@ _dev_ip_state_req_timeout_schedule(NMDevice *self, int addr_family)
     }
 }
 
+static void
+_startup_trace_phase(NMDevice *self, const char *track_suffix, const char *phase)
+{
+    char        sbuf[200];
+    const char *track;
+
+    if (!nm_startup_trace_active())
+        return;
+
+    track = nm_device_get_iface(self) ?: "(unknown)";
+    if (track_suffix)
+        track = nm_sprintf_buf(sbuf, "%s/%s", track, track_suffix);
+    nm_startup_trace_phase(track, phase);
+}
+
+static const char *
+_startup_trace_ip_phase(NMDeviceIPState ip_state)
+{
+    return ip_state == NM_DEVICE_IP_STATE_NONE ? NULL : nm_device_ip_state_to_string(ip_state);
+}
+
 static gboolean
 _dev_ip_state_set_state(NMDevice       *self,
                         int             addr_family,
@@ -3990,6 +4805,7 @@ _dev_ip_state_set_state(NMDevice       *self,
                  nm_device_ip_state_to_string(priv->ip_data.state),
                  reason);
         priv->ip_data.state_ = ip_state;
+        _startup_trace_phase(self, "ip", _startup_trace_ip_phase(ip_state));
         return TRUE;
     }
 
@@ -4004,6 +4820,7 @@ _dev_ip_state_set_state(NMDevice       *self,
              nm_device_ip_state_to_string(priv->ip_data_x[IS_IPv4].state),
              reason);
     priv->ip_data_x[IS_IPv4].state_ = ip_state;
+    _startup_trace_phase(self, IS_IPv4 ? "ip4" : "ip6", _startup_trace_ip_phase(ip_state));
     return TRUE;
 }
 
@@ -4927,7 +5744,8 @@ _dev_l3_cfg_notify_cb(NML3Cfg *l3cfg, const NML3ConfigNotifyData *notify_data, N
         }
 
         if (priv->ipshared_data_4.state == NM_DEVICE_IP_STATE_PENDING
-            && !priv->ipshared_data_4.v4.dnsmasq_manager && priv->ipshared_data_4.v4.l3cd) {
+            && !priv->ipshared_data_4.v4.dnsmasq_manager && !priv->ipshared_data_4.v4.dhcp_server
+            && priv->ipshared_data_4.v4.l3cd) {
             _dev_ipshared4_spawn_dnsmasq(self);
         }
         _dev_ip_state_check_async(self, AF_UNSPEC);
@@ -5581,36 +6399,115 @@ _stats_update_counters(NMDevice *self, guint64 tx_bytes, guint64 rx_bytes)
         priv->stats.tx_bytes = tx_bytes;
         tx_changed           = TRUE;
     }
-    if (priv->stats.rx_bytes != rx_bytes) {
-        priv->stats.rx_bytes = rx_bytes;
-        rx_changed           = TRUE;
+    if (priv->stats.rx_bytes != rx_bytes) {
+        priv->stats.rx_bytes = rx_bytes;
+        rx_changed           = TRUE;
+    }
+
+    nm_gobject_notify_together(self,
+                               tx_changed ? PROP_STATISTICS_TX_BYTES : PROP_0,
+                               rx_changed ? PROP_STATISTICS_RX_BYTES : PROP_0);
+}
+
+static void
+_stats_update_counters_from_pllink(NMDevice *self, const NMPlatformLink *pllink)
+{
+    _stats_update_counters(self, pllink->tx_bytes, pllink->rx_bytes);
+}
+
+/* With this many devices polling at the same rate, one dump of all links
+ * is cheaper than a RTM_GETLINK request for each of them. */
+#define STATS_POLLER_DUMP_MIN 3u
+
+struct _StatsPoller {
+    CList       pollers_lst;
+    GPtrArray  *devices;
+    NMPlatform *platform;
+    GSource    *timeout_source;
+    guint       refresh_rate_ms;
+};
+
+static CList _stats_pollers_lst_head = C_LIST_INIT(_stats_pollers_lst_head);
+
+static gboolean
+_stats_poller_timeout_cb(gpointer user_data)
+{
+    StatsPoller *poller = user_data;
+    int          ifindexes[STATS_POLLER_DUMP_MIN];
+    guint        n = 0;
+    guint        i;
+
+    if (poller->devices->len >= STATS_POLLER_DUMP_MIN) {
+        nm_log_trace(LOGD_DEVICE, "stats: refresh all links for %u devices", poller->devices->len);
+        nm_platform_link_refresh_all(poller->platform);
+        return G_SOURCE_CONTINUE;
+    }
+
+    /* Refreshing links emits signals. Collect the ifindexes first. */
+    for (i = 0; i < poller->devices->len; i++) {
+        int ifindex = nm_device_get_ip_ifindex(poller->devices->pdata[i]);
+
+        if (ifindex > 0)
+            ifindexes[n++] = ifindex;
+    }
+
+    for (i = 0; i < n; i++) {
+        nm_log_trace(LOGD_DEVICE, "stats: refresh %d", ifindexes[i]);
+        nm_platform_link_refresh(poller->platform, ifindexes[i]);
     }
 
-    nm_gobject_notify_together(self,
-                               tx_changed ? PROP_STATISTICS_TX_BYTES : PROP_0,
-                               rx_changed ? PROP_STATISTICS_RX_BYTES : PROP_0);
+    return G_SOURCE_CONTINUE;
 }
 
 static void
-_stats_update_counters_from_pllink(NMDevice *self, const NMPlatformLink *pllink)
+_stats_poller_remove(NMDevice *self)
 {
-    _stats_update_counters(self, pllink->tx_bytes, pllink->rx_bytes);
+    NMDevicePrivate *priv   = NM_DEVICE_GET_PRIVATE(self);
+    StatsPoller     *poller = g_steal_pointer(&priv->stats.poller);
+
+    if (!poller)
+        return;
+
+    g_ptr_array_remove_fast(poller->devices, self);
+    if (poller->devices->len > 0)
+        return;
+
+    c_list_unlink_stale(&poller->pollers_lst);
+    nm_clear_g_source_inst(&poller->timeout_source);
+    g_ptr_array_unref(poller->devices);
+    g_object_unref(poller->platform);
+    nm_g_slice_free(poller);
 }
 
-static gboolean
-_stats_timeout_cb(gpointer user_data)
+static void
+_stats_poller_add(NMDevice *self, guint refresh_rate_ms)
 {
-    NMDevice *self = user_data;
-    int       ifindex;
+    NMDevicePrivate *priv     = NM_DEVICE_GET_PRIVATE(self);
+    NMPlatform      *platform = nm_device_get_platform(self);
+    StatsPoller     *poller;
 
-    ifindex = nm_device_get_ip_ifindex(self);
+    nm_assert(!priv->stats.poller);
+    nm_assert(refresh_rate_ms > 0);
 
-    _LOGT(LOGD_DEVICE, "stats: refresh %d", ifindex);
+    /* Devices that poll statistics at the same rate share one timer. */
+    c_list_for_each_entry (poller, &_stats_pollers_lst_head, pollers_lst) {
+        if (poller->platform == platform && poller->refresh_rate_ms == refresh_rate_ms)
+            goto out;
+    }
 
-    if (ifindex > 0)
-        nm_platform_link_refresh(nm_device_get_platform(self), ifindex);
+    poller  = g_slice_new(StatsPoller);
+    *poller = (StatsPoller) {
+        .devices         = g_ptr_array_new(),
+        .platform        = g_object_ref(platform),
+        .refresh_rate_ms = refresh_rate_ms,
+        .timeout_source =
+            nm_utils_timeout_add_lax_source(refresh_rate_ms, _stats_poller_timeout_cb, poller),
+    };
+    c_list_link_tail(&_stats_pollers_lst_head, &poller->pollers_lst);
 
-    return G_SOURCE_CONTINUE;
+out:
+    g_ptr_array_add(poller->devices, self);
+    priv->stats.poller = poller;
 }
 
 static guint
@@ -5655,7 +6552,7 @@ _stats_set_refresh_rate(NMDevice *self, guint refresh_rate_ms)
     if (_stats_refresh_rate_real(old_rate) == refresh_rate_ms)
         return;
 
-    nm_clear_g_source_inst(&priv->stats.timeout_source);
+    _stats_poller_remove(self);
 
     if (!refresh_rate_ms)
         return;
@@ -5667,7 +6564,7 @@ _stats_set_refresh_rate(NMDevice *self, guint refresh_rate_ms)
     if (ifindex > 0)
         nm_platform_link_refresh(nm_device_get_platform(self), ifindex);
 
-    priv->stats.timeout_source = nm_g_timeout_add_source(refresh_rate_ms, _stats_timeout_cb, self);
+    _stats_poller_add(self, refresh_rate_ms);
 }
 
 /*****************************************************************************/
@@ -6373,6 +7270,17 @@ concheck_periodic_schedule_do(NMDevice *self, int addr_family, gint64 now_ns)
 
     expiry = priv->concheck_x[IS_IPv4].p_cur_basetime_ns
              + (priv->concheck_x[IS_IPv4].p_cur_interval * NM_UTILS_NSEC_PER_SEC);
+
+    if (priv->concheck_x[IS_IPv4].p_cur_interval > CONCHECK_P_PROBE_INTERVAL
+        && !nm_utils_low_wakeup_get()) {
+        /* Delay the check by up to 10% of the interval. The offset is stable per
+         * device, but differs between devices, so that the periodic checks of many
+         * devices don't all fire at the same moment. In low-wakeup mode, we prefer
+         * them to share one wakeup instead. */
+        expiry += (gint64) (nm_hash_static(0x2f7a1c3bu ^ (guint) priv->ifindex) % 1000u)
+                  * priv->concheck_x[IS_IPv4].p_cur_interval * (NM_UTILS_NSEC_PER_SEC / 10000);
+    }
+
     tdiff = expiry - now_ns;
 
     _LOGT(LOGD_CONCHECK,
@@ -6383,10 +7291,10 @@ concheck_periodic_schedule_do(NMDevice *self, int addr_family, gint64 now_ns)
           (long long) (tdiff / NM_UTILS_NSEC_PER_MSEC),
           priv->concheck_x[IS_IPv4].p_cur_interval);
 
-    priv->concheck_x[IS_IPv4].p_cur_id =
-        g_timeout_add(NM_MAX((gint64) 0, tdiff) / NM_UTILS_NSEC_PER_MSEC,
-                      IS_IPv4 ? concheck_ip4_periodic_timeout_cb : concheck_ip6_periodic_timeout_cb,
-                      self);
+    priv->concheck_x[IS_IPv4].p_cur_id = nm_utils_timeout_add_lax(
+        NM_MAX((gint64) 0, tdiff) / NM_UTILS_NSEC_PER_MSEC,
+        IS_IPv4 ? concheck_ip4_periodic_timeout_cb : concheck_ip6_periodic_timeout_cb,
+        self);
     return TRUE;
 out:
     if (periodic_check_disabled) {
@@ -7706,6 +8614,18 @@ device_link_changed(gpointer user_data)
     if (ifindex == nm_device_get_ip_ifindex(self))
         _stats_update_counters_from_pllink(self, pllink);
 
+    if (priv->xdp.ifindex == ifindex) {
+        if (pllink->xdp_prog_id != 0)
+            priv->xdp.seen = TRUE;
+        else if (priv->xdp.seen) {
+            /* Some drivers drop the program when they reset, for example
+             * after a change of the ethtool channels. */
+            _LOGI(LOGD_DEVICE, "link: the XDP program got detached, attach it again");
+            priv->xdp.seen = FALSE;
+            link_xdp_set(self);
+        }
+    }
+
     had_hw_addr = (priv->hw_addr != NULL);
     nm_device_update_hw_address(self);
     got_hw_addr = (!had_hw_addr && priv->hw_addr);
@@ -8045,6 +8965,71 @@ nm_device_realize_start(NMDevice             *self,
     return TRUE;
 }
 
+static gboolean
+_create_and_realize_is_nm_owned(NMDevice *self)
+{
+    NMDevicePrivate      *priv = NM_DEVICE_GET_PRIVATE(self);
+    const NMPlatformLink *plink;
+    gboolean              nm_owned;
+
+    plink    = nm_platform_link_get_by_ifname(nm_device_get_platform(self), priv->iface);
+    nm_owned = !plink || !link_type_compatible(self, plink->type, NULL, NULL);
+    _LOGD(LOGD_DEVICE, "create (is %snm-owned)", nm_owned ? "" : "not ");
+    return nm_owned;
+}
+
+static gboolean
+_create_link_op_result(NMDevice                  *self,
+                       NMConnection              *connection,
+                       const NMPlatformLinkAddOp *op,
+                       const NMPlatformLink     **out_plink,
+                       GError                   **error)
+{
+    if (op->result < 0) {
+        g_set_error(error,
+                    NM_DEVICE_ERROR,
+                    NM_DEVICE_ERROR_CREATION_FAILED,
+                    "Failed to create %s interface '%s' for '%s': %s",
+                    nm_link_type_to_string(op->type),
+                    op->name,
+                    nm_connection_get_id(connection),
+                    nm_strerror(op->result));
+        return FALSE;
+    }
+
+    *out_plink = nm_platform_link_get_by_ifname(nm_device_get_platform(self), op->name);
+    return TRUE;
+}
+
+static void
+_create_and_realize_finish(NMDevice *self, gboolean nm_owned, const NMPlatformLink *plink)
+{
+    nm_auto_nmpobj const NMPObject *plink_keep_alive = NULL;
+    NMDevicePrivate                *priv             = NM_DEVICE_GET_PRIVATE(self);
+
+    if (plink) {
+        nm_assert(NMP_OBJECT_GET_TYPE(NMP_OBJECT_UP_CAST(plink)) == NMP_OBJECT_TYPE_LINK);
+        plink_keep_alive = nmp_object_ref(NMP_OBJECT_UP_CAST(plink));
+    }
+
+    priv->nm_owned = nm_owned;
+
+    realize_start_setup(self,
+                        plink,
+                        FALSE, /* assume_state_guess_assume */
+                        NULL,  /* assume_state_connection_uuid */
+                        FALSE,
+                        NM_UNMAN_FLAG_OP_FORGET,
+                        TRUE);
+    nm_device_realize_finish(self, plink);
+
+    if (nm_device_get_managed(self, FALSE)) {
+        nm_device_state_changed(self,
+                                NM_DEVICE_STATE_UNAVAILABLE,
+                                NM_DEVICE_STATE_REASON_NOW_MANAGED);
+    }
+}
+
 /**
  * nm_device_create_and_realize():
  * @self: the #NMDevice
@@ -8063,46 +9048,126 @@ nm_device_create_and_realize(NMDevice     *self,
                              NMDevice     *parent,
                              GError      **error)
 {
-    nm_auto_nmpobj const NMPObject *plink_keep_alive = NULL;
-    NMDevicePrivate                *priv             = NM_DEVICE_GET_PRIVATE(self);
-    const NMPlatformLink           *plink;
-    gboolean                        nm_owned;
+    NMDeviceClass        *klass = NM_DEVICE_GET_CLASS(self);
+    const NMPlatformLink *plink = NULL;
+    gboolean              nm_owned;
 
     /* Must be set before device is realized */
-    plink    = nm_platform_link_get_by_ifname(nm_device_get_platform(self), priv->iface);
-    nm_owned = !plink || !link_type_compatible(self, plink->type, NULL, NULL);
-    _LOGD(LOGD_DEVICE, "create (is %snm-owned)", nm_owned ? "" : "not ");
+    nm_owned = _create_and_realize_is_nm_owned(self);
 
-    plink = NULL;
     /* Create any resources the device needs */
-    if (NM_DEVICE_GET_CLASS(self)->create_and_realize) {
-        if (!NM_DEVICE_GET_CLASS(self)->create_and_realize(self, connection, parent, &plink, error))
+    if (klass->create_and_realize) {
+        if (!klass->create_and_realize(self, connection, parent, &plink, error))
+            return FALSE;
+    } else if (klass->create_link_op) {
+        NMPlatformLinkAddOp op = {};
+
+        if (!klass->create_link_op(self, connection, parent, &op, error))
+            return FALSE;
+        nm_platform_link_add_batch(nm_device_get_platform(self), &op, 1);
+        if (!_create_link_op_result(self, connection, &op, &plink, error))
             return FALSE;
-        if (plink) {
-            nm_assert(NMP_OBJECT_GET_TYPE(NMP_OBJECT_UP_CAST(plink)) == NMP_OBJECT_TYPE_LINK);
-            plink_keep_alive = nmp_object_ref(NMP_OBJECT_UP_CAST(plink));
-        }
     }
 
-    priv->nm_owned = nm_owned;
+    _create_and_realize_finish(self, nm_owned, plink);
+    return TRUE;
+}
 
-    realize_start_setup(self,
-                        plink,
-                        FALSE, /* assume_state_guess_assume */
-                        NULL,  /* assume_state_connection_uuid */
-                        FALSE,
-                        NM_UNMAN_FLAG_OP_FORGET,
-                        TRUE);
-    nm_device_realize_finish(self, plink);
+static gboolean
+_create_and_realize_many_can_batch(NMDeviceCreateAndRealizeData *data, guint i_start, guint i)
+{
+    NMDevice *device = data[i].device;
+    guint     j;
 
-    if (nm_device_get_managed(self, FALSE)) {
-        nm_device_state_changed(self,
-                                NM_DEVICE_STATE_UNAVAILABLE,
-                                NM_DEVICE_STATE_REASON_NOW_MANAGED);
+    if (!NM_DEVICE_GET_CLASS(device)->create_link_op
+        || NM_DEVICE_GET_CLASS(device)->create_and_realize)
+        return FALSE;
+
+    if (nm_device_get_platform(data[i_start].device) != nm_device_get_platform(device))
+        return FALSE;
+
+    if (data[i].parent) {
+        /* The parent must be created first, its ifindex is needed. */
+        for (j = i_start; j < i; j++) {
+            if (data[i].parent == data[j].device)
+                return FALSE;
+        }
     }
     return TRUE;
 }
 
+/**
+ * nm_device_create_and_realize_many():
+ * @data: the devices to create and realize.
+ * @n_data: the number of entries in @data.
+ *
+ * Like nm_device_create_and_realize() for each entry of @data, but the
+ * links of consecutive devices that implement create_link_op() are created
+ * with one nm_platform_link_add_batch() call. Devices that are already
+ * realized are skipped. On return, the @success and @error fields of each
+ * entry are set.
+ */
+void
+nm_device_create_and_realize_many(NMDeviceCreateAndRealizeData *data, guint n_data)
+{
+    gs_free NMPlatformLinkAddOp *ops      = NULL;
+    gs_free int                 *op_idx   = NULL;
+    gs_free gboolean            *nm_owned = NULL;
+    guint                        i_start;
+    guint                        i;
+    guint                        j;
+
+    ops      = g_new(NMPlatformLinkAddOp, n_data);
+    op_idx   = g_new(int, n_data);
+    nm_owned = g_new(gboolean, n_data);
+
+    for (i_start = 0; i_start < n_data; i_start = i) {
+        NMDeviceCreateAndRealizeData *d     = &data[i_start];
+        guint                         n_ops = 0;
+
+        if (!_create_and_realize_many_can_batch(data, i_start, i_start)) {
+            if (!nm_device_is_real(d->device))
+                d->success =
+                    nm_device_create_and_realize(d->device, d->connection, d->parent, &d->error);
+            i = i_start + 1;
+            continue;
+        }
+
+        for (i = i_start; i < n_data && _create_and_realize_many_can_batch(data, i_start, i); i++) {
+            d         = &data[i];
+            op_idx[i] = -1;
+
+            if (nm_device_is_real(d->device))
+                continue;
+
+            nm_owned[i] = _create_and_realize_is_nm_owned(d->device);
+            ops[n_ops]  = (NMPlatformLinkAddOp) {};
+            if (!NM_DEVICE_GET_CLASS(d->device)
+                     ->create_link_op(d->device, d->connection, d->parent, &ops[n_ops], &d->error))
+                continue;
+            op_idx[i] = n_ops++;
+        }
+
+        nm_platform_link_add_batch(nm_device_get_platform(data[i_start].device), ops, n_ops);
+
+        for (j = i_start; j < i; j++) {
+            const NMPlatformLink *plink = NULL;
+
+            d = &data[j];
+            if (op_idx[j] < 0 || nm_device_is_real(d->device))
+                continue;
+            if (!_create_link_op_result(d->device,
+                                        d->connection,
+                                        &ops[op_idx[j]],
+                                        &plink,
+                                        &d->error))
+                continue;
+            _create_and_realize_finish(d->device, nm_owned[j], plink);
+            d->success = TRUE;
+        }
+    }
+}
+
 static gboolean
 can_update_from_platform_link(NMDevice *self, const NMPlatformLink *plink)
 {
@@ -8491,12 +9556,10 @@ realize_start_setup(NMDevice             *self,
 
     nm_device_set_carrier_from_platform(self);
 
-    nm_assert(!priv->stats.timeout_source);
+    nm_assert(!priv->stats.poller);
     refresh_rate_ms = _stats_refresh_rate_real(priv->stats.refresh_rate_ms);
-    if (refresh_rate_ms > 0) {
-        priv->stats.timeout_source =
-            nm_g_timeout_add_source(refresh_rate_ms, _stats_timeout_cb, self);
-    }
+    if (refresh_rate_ms > 0)
+        _stats_poller_add(self, refresh_rate_ms);
 
     klass->realize_start_notify(self, plink);
 
@@ -8671,7 +9734,7 @@ nm_device_unrealize(NMDevice *self, gboolean remove_resources, GError **error)
         _notify(self, PROP_PHYSICAL_PORT_ID);
     }
 
-    nm_clear_g_source_inst(&priv->stats.timeout_source);
+    _stats_poller_remove(self);
     _stats_update_counters(self, 0, 0);
 
     priv->hw_addr_len_ = 0;
@@ -9580,21 +10643,11 @@ _get_maybe_ipv6_disabled(NMDevice *self)
     return (nm_platform_sysctl_get_int32(platform, NMP_SYSCTL_PATHID_ABSOLUTE(path), 1) != 0);
 }
 
-/*
- * nm_device_generate_connection:
- *
- * Generates a connection from an existing interface.
- *
- * If the device doesn't have an IP configuration and it's not a port or a
- * controller, then no connection gets generated and the function returns
- * %NULL. In such case, @maybe_later is set to %TRUE if a connection can be
- * generated later when an IP address is assigned to the interface.
- */
-NMConnection *
-nm_device_generate_connection(NMDevice *self,
-                              NMDevice *controller,
-                              gboolean *out_maybe_later,
-                              GError  **error)
+static NMConnection *
+_generate_connection(NMDevice *self,
+                     NMDevice *controller,
+                     gboolean *out_maybe_later,
+                     GError  **error)
 {
     NMDeviceClass                *klass      = NM_DEVICE_GET_CLASS(self);
     NMDevicePrivate              *priv       = NM_DEVICE_GET_PRIVATE(self);
@@ -9747,6 +10800,148 @@ nm_device_generate_connection(NMDevice *self,
     return g_steal_pointer(&connection);
 }
 
+/* Hashes the state that _generate_connection() reads. The link statistics
+ * are left out, they change all the time and don't matter. */
+static guint64
+_generate_connection_fingerprint(NMDevice *self, NMDevice *controller)
+{
+    static const NMPObjectType obj_types[] = {
+        NMP_OBJECT_TYPE_IP4_ADDRESS,
+        NMP_OBJECT_TYPE_IP6_ADDRESS,
+        NMP_OBJECT_TYPE_IP4_ROUTE,
+        NMP_OBJECT_TYPE_IP6_ROUTE,
+    };
+    NMDevicePrivate      *priv     = NM_DEVICE_GET_PRIVATE(self);
+    NMPlatform           *platform = nm_device_get_platform(self);
+    const NMPlatformLink *pllink;
+    const NMPObject      *obj;
+    NMDedupMultiIter      iter;
+    NMPLookup             lookup;
+    NMHashState           h;
+    int                   ip_ifindex;
+    guint                 i;
+
+    nm_hash_init(&h, 1573402483u);
+    nm_hash_update_vals(&h, controller, NM_CONFIG_GET_DATA, priv->ifindex);
+    nm_hash_update_bool(&h, c_list_is_empty(&priv->ports));
+
+    pllink = nm_platform_link_get(platform, priv->ifindex);
+    if (pllink) {
+        const NMPObject *lnk = NMP_OBJECT_UP_CAST(pllink)->_link.netlink.lnk;
+
+        nm_hash_update_vals(&h,
+                            pllink->controller,
+                            pllink->parent,
+                            pllink->n_ifi_flags,
+                            pllink->mtu,
+                            pllink->type,
+                            pllink->inet6_addr_gen_mode_inv,
+                            pllink->inet6_token.id,
+                            pllink->port_kind);
+        nm_hash_update_strarr(&h, pllink->name);
+        nm_hash_update_mem(&h,
+                           pllink->l_address.data,
+                           NM_MIN(pllink->l_address.len, sizeof(pllink->l_address.data)));
+        switch (pllink->port_kind) {
+        case NM_PORT_KIND_NONE:
+            break;
+        case NM_PORT_KIND_BOND:
+            nm_platform_link_bond_port_hash_update(&pllink->port_data.bond, &h);
+            break;
+        case NM_PORT_KIND_BRIDGE:
+            nm_platform_link_bridge_port_hash_update(&pllink->port_data.bridge, &h);
+            break;
+        }
+        if (lnk)
+            nmp_object_hash_update(lnk, &h);
+    }
+
+    ip_ifindex = nm_device_get_ip_ifindex(self);
+    nm_hash_update_val(&h, ip_ifindex);
+    if (ip_ifindex > 0 && !controller) {
+        for (i = 0; i < G_N_ELEMENTS(obj_types); i++) {
+            nmp_lookup_init_object_by_ifindex(&lookup, obj_types[i], ip_ifindex);
+            nm_platform_iter_obj_for_each (&iter, platform, &lookup, &obj)
+                nmp_object_hash_update(obj, &h);
+        }
+        nm_hash_update_bool(&h, _get_maybe_ipv6_disabled(self));
+    }
+
+    return nm_hash_complete_u64(&h);
+}
+
+static void
+_generate_connection_cache_clear(NMDevice *self)
+{
+    NMDevicePrivate *priv = NM_DEVICE_GET_PRIVATE(self);
+
+    g_clear_object(&priv->gen_connection_cache.connection);
+    g_clear_error(&priv->gen_connection_cache.error);
+    priv->gen_connection_cache.valid = FALSE;
+}
+
+/*
+ * nm_device_generate_connection:
+ *
+ * Generates a connection from an existing interface.
+ *
+ * If the device doesn't have an IP configuration and it's not a port or a
+ * controller, then no connection gets generated and the function returns
+ * %NULL. In such case, @maybe_later is set to %TRUE if a connection can be
+ * generated later when an IP address is assigned to the interface.
+ *
+ * The result is cached. As long as the relevant platform state of the
+ * device doesn't change, the connection is not generated again.
+ */
+NMConnection *
+nm_device_generate_connection(NMDevice *self,
+                              NMDevice *controller,
+                              gboolean *out_maybe_later,
+                              GError  **error)
+{
+    NMDevicePrivate *priv = NM_DEVICE_GET_PRIVATE(self);
+    NMConnection    *connection;
+    gboolean         maybe_later;
+    guint64          fingerprint;
+    char             uuid[37];
+
+    if (NM_DEVICE_GET_CLASS(self)->update_connection_uses_external_state)
+        return _generate_connection(self, controller, out_maybe_later, error);
+
+    fingerprint = _generate_connection_fingerprint(self, controller);
+    if (priv->gen_connection_cache.valid && priv->gen_connection_cache.fingerprint == fingerprint) {
+        _LOGT(LOGD_DEVICE, "generated connection: state unchanged, use the previous result");
+    } else {
+        _generate_connection_cache_clear(self);
+        priv->gen_connection_cache.connection =
+            _generate_connection(self,
+                                 controller,
+                                 &maybe_later,
+                                 &priv->gen_connection_cache.error);
+        priv->gen_connection_cache.maybe_later = maybe_later;
+        priv->gen_connection_cache.fingerprint = fingerprint;
+        priv->gen_connection_cache.valid       = TRUE;
+    }
+
+    NM_SET_OUT(out_maybe_later, priv->gen_connection_cache.maybe_later);
+
+    if (!priv->gen_connection_cache.connection) {
+        if (error)
+            *error = g_error_copy(priv->gen_connection_cache.error);
+        return NULL;
+    }
+
+    /* every generated connection gets a new UUID. */
+    connection = nm_simple_connection_new_clone(priv->gen_connection_cache.connection);
+    g_object_set(nm_connection_get_setting_connection(connection),
+                 NM_SETTING_CONNECTION_UUID,
+                 nm_uuid_generate_random_str_arr(uuid),
+                 NM_SETTING_CONNECTION_TIMESTAMP,
+                 (guint64) time(NULL),
+                 NULL);
+    return connection;
+}
+
 /**
  * nm_device_complete_connection:
  *
@@ -10195,52 +11390,191 @@ nm_device_auth_request(NMDevice                      *self,
 
 /*****************************************************************************/
 
+/* The activation stages of all devices are queued per stage and dispatched
+ * in batches from one idle source. A dispatch runs the queued stage 1 of all
+ * devices, then stage 2 and then stage 3, so that a stage scheduled by the
+ * previous one still runs in the same main loop iteration. Within a batch,
+ * controllers and parents run before their ports and children. */
+
+/* Limits the work per main loop iteration. The rest stays queued. */
+#define ACTIVATION_BATCH_MAX 256u
+
+/* Limits the walk up the controllers and parents, in case of a loop. */
+#define ACTIVATION_DEPTH_MAX 8u
+
+static CList _activation_lst_heads[] = {
+    C_LIST_INIT(_activation_lst_heads[NM_PERF_QUEUE_ACTIVATION_STAGE1]),
+    C_LIST_INIT(_activation_lst_heads[NM_PERF_QUEUE_ACTIVATION_STAGE2]),
+    C_LIST_INIT(_activation_lst_heads[NM_PERF_QUEUE_ACTIVATION_STAGE3]),
+};
+
+G_STATIC_ASSERT(NM_PERF_QUEUE_ACTIVATION_STAGE1 == 0);
+G_STATIC_ASSERT(G_N_ELEMENTS(_activation_lst_heads) == NM_PERF_QUEUE_ACTIVATION_STAGE3 + 1);
+
+static GSource *_activation_idle_source;
+
+typedef struct {
+    NMDevice *device;
+    guint     seq;
+    guint     depth;
+} ActivationBatchItem;
+
+static NMPerfQueue
+_activation_func_to_queue(ActivationHandleFunc func)
+{
+    if (func == activate_stage1_device_prepare)
+        return NM_PERF_QUEUE_ACTIVATION_STAGE1;
+    if (func == activate_stage2_device_config)
+        return NM_PERF_QUEUE_ACTIVATION_STAGE2;
+    nm_assert(func == activate_stage3_ip_config);
+    return NM_PERF_QUEUE_ACTIVATION_STAGE3;
+}
+
+static guint
+_activation_get_depth(NMDevice *self)
+{
+    guint depth;
+
+    for (depth = 0; depth < ACTIVATION_DEPTH_MAX; depth++) {
+        NMDevicePrivate    *priv = NM_DEVICE_GET_PRIVATE(self);
+        NMActiveConnection *ac_controller;
+        NMDevice           *upper;
+
+        if (priv->controller)
+            upper = priv->controller;
+        else if (priv->act_request.obj
+                 && (ac_controller = nm_active_connection_get_controller(
+                         NM_ACTIVE_CONNECTION(priv->act_request.obj))))
+            upper = nm_active_connection_get_device(ac_controller);
+        else
+            upper = nm_device_parent_get_device(self);
+
+        if (!upper || upper == self)
+            break;
+        self = upper;
+    }
+    return depth;
+}
+
+static int
+_activation_batch_item_cmp(gconstpointer a, gconstpointer b, gpointer user_data)
+{
+    const ActivationBatchItem *item_a = a;
+    const ActivationBatchItem *item_b = b;
+
+    NM_CMP_FIELD(item_a, item_b, depth);
+    NM_CMP_FIELD(item_a, item_b, seq);
+    return 0;
+}
+
 static void
-activation_source_clear(NMDevice *self)
+_activation_queue_unlink(NMDevice *self, gboolean dispatched)
 {
     NMDevicePrivate *priv = NM_DEVICE_GET_PRIVATE(self);
 
-    if (nm_clear_g_source_inst(&priv->activation_idle_source)) {
+    nm_assert(c_list_is_linked(&self->activation_lst));
+
+    c_list_unlink(&self->activation_lst);
+    nm_perf_queue_dequeue(_activation_func_to_queue(priv->activation_func),
+                          self->activation_queued_nsec,
+                          dispatched);
+    priv->activation_func = NULL;
+}
+
+static void
+_activation_queue_dispatch(NMPerfQueue queue)
+{
+    gs_unref_array GArray *batch = NULL;
+    NMDevice              *device;
+    guint                  i;
+
+    if (c_list_is_empty(&_activation_lst_heads[queue]))
+        return;
+
+    /* Take a snapshot of the queue. Running a stage can clear or schedule
+     * the stages of other devices, so each device is checked again before
+     * its stage gets invoked. */
+    batch = g_array_new(FALSE, FALSE, sizeof(ActivationBatchItem));
+    c_list_for_each_entry (device, &_activation_lst_heads[queue], activation_lst) {
+        g_array_append_val(batch,
+                           ((ActivationBatchItem) {
+                               .device = g_object_ref(device),
+                               .seq    = batch->len,
+                               .depth  = _activation_get_depth(device),
+                           }));
+    }
+
+    g_array_sort_with_data(batch, _activation_batch_item_cmp, NULL);
+    if (batch->len > ACTIVATION_BATCH_MAX) {
+        for (i = ACTIVATION_BATCH_MAX; i < batch->len; i++)
+            g_object_unref(nm_g_array_index(batch, ActivationBatchItem, i).device);
+        g_array_set_size(batch, ACTIVATION_BATCH_MAX);
+    }
+
+    nm_perf_queue_batch(queue);
+
+    for (i = 0; i < batch->len; i++) {
+        gs_unref_object NMDevice *self = nm_g_array_index(batch, ActivationBatchItem, i).device;
+        NMDevicePrivate          *priv = NM_DEVICE_GET_PRIVATE(self);
+        ActivationHandleFunc      activation_func;
+
+        if (!c_list_is_linked(&self->activation_lst)
+            || _activation_func_to_queue(priv->activation_func) != queue)
+            continue;
+
+        activation_func = priv->activation_func;
+        _activation_queue_unlink(self, TRUE);
+
         _LOGD(LOGD_DEVICE,
-              "activation-stage: clear %s",
-              _activation_func_to_string(priv->activation_func));
-        priv->activation_func = NULL;
+              "activation-stage: invoke %s",
+              _activation_func_to_string(activation_func));
+
+        activation_func(self);
     }
 }
 
 static gboolean
-activation_source_handle_cb(gpointer user_data)
+_activation_idle_cb(gpointer user_data)
 {
-    NMDevice            *self = user_data;
-    NMDevicePrivate     *priv;
-    ActivationHandleFunc activation_func;
-
-    g_return_val_if_fail(NM_IS_DEVICE(self), G_SOURCE_REMOVE);
+    NMPerfQueue queue;
 
-    priv = NM_DEVICE_GET_PRIVATE(self);
-
-    g_return_val_if_fail(priv->activation_idle_source, G_SOURCE_REMOVE);
+    nm_clear_g_source_inst(&_activation_idle_source);
 
-    nm_assert(priv->activation_func);
-
-    activation_func       = priv->activation_func;
-    priv->activation_func = NULL;
+    for (queue = 0; queue < G_N_ELEMENTS(_activation_lst_heads); queue++)
+        _activation_queue_dispatch(queue);
 
-    nm_clear_g_source_inst(&priv->activation_idle_source);
+    if (!_activation_idle_source) {
+        for (queue = 0; queue < G_N_ELEMENTS(_activation_lst_heads); queue++) {
+            if (!c_list_is_empty(&_activation_lst_heads[queue])) {
+                _activation_idle_source = nm_g_idle_add_source(_activation_idle_cb, NULL);
+                break;
+            }
+        }
+    }
 
-    _LOGD(LOGD_DEVICE, "activation-stage: invoke %s", _activation_func_to_string(activation_func));
+    return G_SOURCE_CONTINUE;
+}
 
-    activation_func(self);
+static void
+activation_source_clear(NMDevice *self)
+{
+    NMDevicePrivate *priv = NM_DEVICE_GET_PRIVATE(self);
 
-    return G_SOURCE_CONTINUE;
+    if (c_list_is_linked(&self->activation_lst)) {
+        _LOGD(LOGD_DEVICE,
+              "activation-stage: clear %s",
+              _activation_func_to_string(priv->activation_func));
+        _activation_queue_unlink(self, FALSE);
+    }
 }
 
 static void
 activation_source_schedule(NMDevice *self, ActivationHandleFunc func)
 {
     NMDevicePrivate *priv = NM_DEVICE_GET_PRIVATE(self);
+    NMPerfQueue      queue;
 
-    if (priv->activation_idle_source && priv->activation_func == func) {
+    if (c_list_is_linked(&self->activation_lst) && priv->activation_func == func) {
         /* Scheduling the same stage multiple times is fine. */
         _LOGT(LOGD_DEVICE,
               "activation-stage: already scheduled %s",
@@ -10248,18 +11582,24 @@ activation_source_schedule(NMDevice *self, ActivationHandleFunc func)
         return;
     }
 
-    if (priv->activation_idle_source) {
+    if (c_list_is_linked(&self->activation_lst)) {
         _LOGD(LOGD_DEVICE,
               "activation-stage: schedule %s (which replaces %s)",
               _activation_func_to_string(func),
               _activation_func_to_string(priv->activation_func));
-        nm_clear_g_source_inst(&priv->activation_idle_source);
+        _activation_queue_unlink(self, FALSE);
     } else {
         _LOGD(LOGD_DEVICE, "activation-stage: schedule %s", _activation_func_to_string(func));
     }
 
-    priv->activation_idle_source = nm_g_idle_add_source(activation_source_handle_cb, self);
+    queue                        = _activation_func_to_queue(func);
     priv->activation_func        = func;
+    self->activation_queued_nsec = nm_perf_start();
+    c_list_link_tail(&_activation_lst_heads[queue], &self->activation_lst);
+    nm_perf_queue_enqueue(queue);
+
+    if (!_activation_idle_source)
+        _activation_idle_source = nm_g_idle_add_source(_activation_idle_cb, NULL);
 }
 
 static void
@@ -10267,7 +11607,7 @@ activation_source_invoke_sync(NMDevice *self, ActivationHandleFunc func)
 {
     NMDevicePrivate *priv = NM_DEVICE_GET_PRIVATE(self);
 
-    if (!priv->activation_idle_source) {
+    if (!c_list_is_linked(&self->activation_lst)) {
         _LOGD(LOGD_DEVICE,
               "activation-stage: synchronously invoke %s",
               _activation_func_to_string(func));
@@ -10282,8 +11622,8 @@ activation_source_invoke_sync(NMDevice *self, ActivationHandleFunc func)
               _activation_func_to_string(priv->activation_func));
     }
 
-    nm_clear_g_source_inst(&priv->activation_idle_source);
-    priv->activation_func = NULL;
+    if (c_list_is_linked(&self->activation_lst))
+        _activation_queue_unlink(self, FALSE);
 
     func(self);
 }
@@ -10452,14 +11792,40 @@ sriov_params_cb(GError *error, gpointer user_data)
     nm_device_activate_schedule_stage1_device_prepare(self, FALSE);
 }
 
+static gboolean
+sriov_vf_is_unchanged(NMSettingSriov *s_sriov_old, NMSriovVF *vf)
+{
+    guint index;
+    guint num;
+    guint i;
+
+    if (!s_sriov_old)
+        return FALSE;
+
+    index = nm_sriov_vf_get_index(vf);
+    num   = nm_setting_sriov_get_num_vfs(s_sriov_old);
+    for (i = 0; i < num; i++) {
+        NMSriovVF *vf_old = nm_setting_sriov_get_vf(s_sriov_old, i);
+
+        if (nm_sriov_vf_get_index(vf_old) == index)
+            return nm_sriov_vf_equal(vf_old, vf);
+    }
+
+    return FALSE;
+}
+
+/* If @s_sriov_old is given, VFs that are configured the same way
+ * there are skipped. */
 static gboolean
 sriov_gen_platform_vfs(NMDevice       *self,
                        NMSettingSriov *s_sriov,
+                       NMSettingSriov *s_sriov_old,
                        NMPlatformVF ***plat_vfs_out,
                        GError        **error)
 {
     nm_auto_freev NMPlatformVF **plat_vfs = NULL;
     guint                        num;
+    guint                        j = 0;
 
     nm_assert(s_sriov);
     nm_assert(plat_vfs_out && !*plat_vfs_out);
@@ -10471,9 +11837,12 @@ sriov_gen_platform_vfs(NMDevice       *self,
         NMSriovVF            *vf    = nm_setting_sriov_get_vf(s_sriov, i);
         gs_free_error GError *local = NULL;
 
-        plat_vfs[i] = sriov_vf_config_to_platform(self, vf, &local);
+        if (sriov_vf_is_unchanged(s_sriov_old, vf))
+            continue;
+
+        plat_vfs[j] = sriov_vf_config_to_platform(self, vf, &local);
 
-        if (!plat_vfs[i]) {
+        if (!plat_vfs[j]) {
             g_set_error(error,
                         local->domain,
                         local->code,
@@ -10482,6 +11851,7 @@ sriov_gen_platform_vfs(NMDevice       *self,
                         local->message);
             return FALSE;
         }
+        j++;
     }
 
     *plat_vfs_out = g_steal_pointer(&plat_vfs);
@@ -10548,7 +11918,7 @@ activate_stage1_device_prepare(NMDevice *self)
                     NM_OPTION_BOOL_TRUE);
             }
 
-            if (!sriov_gen_platform_vfs(self, s_sriov, &plat_vfs, &error)) {
+            if (!sriov_gen_platform_vfs(self, s_sriov, NULL, &plat_vfs, &error)) {
                 _LOGE(LOGD_DEVICE, "cannot parse the VF list: %s", error->message);
                 nm_device_state_changed(self,
                                         NM_DEVICE_STATE_FAILED,
@@ -10836,10 +12206,13 @@ nm_routing_rules_sync(NMConnection *applied_connection,
 static gboolean
 tc_commit(NMDevice *self)
 {
-    gs_unref_ptrarray GPtrArray *qdiscs   = NULL;
-    gs_unref_ptrarray GPtrArray *tfilters = NULL;
+    gs_unref_ptrarray GPtrArray *qdiscs      = NULL;
+    gs_unref_ptrarray GPtrArray *tfilters    = NULL;
+    nm_auto_close int            dirfd       = -1;
+    guint                        n_tx_queues = 0;
     NMSettingTCConfig           *s_tc;
     NMPlatform                  *platform;
+    char                         ifname[IFNAMSIZ];
     int                          ip_ifindex;
 
     s_tc = nm_device_get_applied_setting(self, NM_TYPE_SETTING_TC_CONFIG);
@@ -10851,7 +12224,17 @@ tc_commit(NMDevice *self)
         return FALSE;
 
     platform = nm_device_get_platform(self);
-    qdiscs   = nm_utils_qdiscs_from_tc_setting(platform, s_tc, ip_ifindex);
+
+    /* Qdiscs attached to a "mq" or "mqprio" qdisc are added for each TX
+     * queue. The ethtool channels, configured before, determine these. */
+    dirfd = nm_platform_sysctl_open_netdir(platform, ip_ifindex, ifname);
+    if (dirfd >= 0) {
+        gs_unref_array GArray *queues = _link_steering_list_dir(dirfd, "queues", "tx-");
+
+        n_tx_queues = queues ? queues->len : 0u;
+    }
+
+    qdiscs   = nm_utils_qdiscs_from_tc_setting(platform, s_tc, ip_ifindex, n_tx_queues);
     tfilters = nm_utils_tfilters_from_tc_setting(platform, s_tc, ip_ifindex);
 
     if (!nm_platform_tc_sync(platform, ip_ifindex, qdiscs, tfilters))
@@ -10883,6 +12266,8 @@ activate_stage2_device_config(NMDevice *self)
     if (!nm_device_managed_type_is_external(self)) {
         _ethtool_state_set(self);
         nm_device_link_properties_set(self, FALSE);
+        link_steering_set(self);
+        link_xdp_set(self);
     }
 
     if (!nm_device_managed_type_is_external(self)) {
@@ -11328,6 +12713,48 @@ _dev_ipmanual_check_ready(NMDevice *self)
     }
 }
 
+static NML3ConfigData *
+_dev_ipmanual_create_l3cd(NMDevice *self)
+{
+    NML3ConfigData *l3cd;
+
+    if (nm_device_get_ip_ifindex(self) <= 0)
+        return NULL;
+
+    l3cd = nm_device_create_l3_config_data_from_connection(self,
+                                                           nm_device_get_applied_connection(self));
+    if (!l3cd)
+        return NULL;
+
+    if (_prop_get_ipvx_routed_dns(self, AF_INET) == NM_SETTING_IP_CONFIG_ROUTED_DNS_YES) {
+        nm_l3_config_data_set_routed_dns(l3cd, AF_INET, TRUE);
+    }
+    if (_prop_get_ipvx_routed_dns(self, AF_INET6) == NM_SETTING_IP_CONFIG_ROUTED_DNS_YES) {
+        nm_l3_config_data_set_routed_dns(l3cd, AF_INET6, TRUE);
+    }
+    return l3cd;
+}
+
+/* Replaces the manual configuration after a reapply that only changed
+ * routes. Unlike a restart, the IP states (and DHCP) are left alone and the
+ * next commit only syncs the difference to the platform. */
+static gboolean
+_dev_ipmanual_update(NMDevice *self)
+{
+    NMDevicePrivate                        *priv = NM_DEVICE_GET_PRIVATE(self);
+    nm_auto_unref_l3cd_init NML3ConfigData *l3cd = NULL;
+
+    if (!priv->l3cds[L3_CONFIG_DATA_TYPE_MANUALIP].d)
+        return FALSE;
+
+    l3cd = _dev_ipmanual_create_l3cd(self);
+    if (!l3cd)
+        return FALSE;
+
+    _dev_l3_register_l3cds_set_one(self, L3_CONFIG_DATA_TYPE_MANUALIP, l3cd, FALSE);
+    return TRUE;
+}
+
 static void
 _dev_ipmanual_start(NMDevice *self)
 {
@@ -11338,19 +12765,7 @@ _dev_ipmanual_start(NMDevice *self)
         || priv->ipmanual_data.state_6 != NM_DEVICE_IP_STATE_NONE)
         return;
 
-    if (nm_device_get_ip_ifindex(self) > 0) {
-        l3cd =
-            nm_device_create_l3_config_data_from_connection(self,
-                                                            nm_device_get_applied_connection(self));
-
-        if (_prop_get_ipvx_routed_dns(self, AF_INET) == NM_SETTING_IP_CONFIG_ROUTED_DNS_YES) {
-            nm_l3_config_data_set_routed_dns(l3cd, AF_INET, TRUE);
-        }
-        if (_prop_get_ipvx_routed_dns(self, AF_INET6) == NM_SETTING_IP_CONFIG_ROUTED_DNS_YES) {
-            nm_l3_config_data_set_routed_dns(l3cd, AF_INET6, TRUE);
-        }
-    }
-
+    l3cd = _dev_ipmanual_create_l3cd(self);
     if (!l3cd) {
         _dev_ipmanual_cleanup(self);
         return;
@@ -11378,6 +12793,7 @@ _dev_ipdhcpx_set_state(NMDevice *self, int addr_family, NMDeviceIPState state)
                      nm_device_ip_state_to_string(state),
                      nm_device_ip_state_to_string(priv->ipdhcp_data_x[IS_IPv4].state));
         priv->ipdhcp_data_x[IS_IPv4].state = state;
+        _startup_trace_phase(self, IS_IPv4 ? "dhcp4" : "dhcp6", _startup_trace_ip_phase(state));
     }
 }
 
@@ -11543,12 +12959,16 @@ _dev_ipdhcpx_notify(NMDhcpClient *client, const NMDhcpClientNotifyData *notify_d
 
         if (notify_data->lease_update.accepted) {
             nm_manager_write_device_state(priv->manager, self, NULL);
-            nm_dispatcher_call_device(NM_DISPATCHER_ACTION_DHCP_CHANGE_X(IS_IPv4),
-                                      self,
-                                      NULL,
-                                      NULL,
-                                      NULL,
-                                      NULL);
+            /* A renewal that only extended the lifetimes is not interesting
+             * for dispatcher scripts. */
+            if (!notify_data->lease_update.renewed) {
+                nm_dispatcher_call_device(NM_DISPATCHER_ACTION_DHCP_CHANGE_X(IS_IPv4),
+                                          self,
+                                          NULL,
+                                          NULL,
+                                          NULL,
+                                          NULL);
+            }
             if (priv->ipdhcp_data_x[IS_IPv4].state != NM_DEVICE_IP_STATE_READY) {
                 _dev_ipdhcpx_set_state(self, addr_family, NM_DEVICE_IP_STATE_READY);
                 _dev_ip_state_check_async(self, addr_family);
@@ -11565,6 +12985,39 @@ lease_update_out:
 
 /*****************************************************************************/
 
+/* After a restart, the address of the DHCPv4 lease of the previous
+ * NetworkManager instance is still configured. Only resume it, if it
+ * doesn't expire right away. */
+#define DHCP4_RESUME_MIN_REMAINING_SEC 30
+
+static gboolean
+_dev_ipdhcp4_can_resume(NMDevice *self, int ifindex, NMConnection *connection)
+{
+    const NMConfigDeviceStateData *dev_state;
+    const NMPObject               *obj;
+    NMDedupMultiIter               iter;
+    NMPLookup                      lookup;
+
+    if (nm_device_managed_type_get(self) != NM_DEVICE_MANAGED_TYPE_ASSUME)
+        return FALSE;
+
+    dev_state = nm_config_device_state_get(nm_config_get(), ifindex);
+    if (!dev_state || dev_state->dhcp4_address == INADDR_ANY
+        || !nm_streq0(dev_state->connection_uuid, nm_connection_get_uuid(connection)))
+        return FALSE;
+
+    if (dev_state->dhcp4_expiry < ((gint64) time(NULL)) + DHCP4_RESUME_MIN_REMAINING_SEC)
+        return FALSE;
+
+    /* The state file might be outdated. Check that the address is still there. */
+    nmp_lookup_init_object_by_ifindex(&lookup, NMP_OBJECT_TYPE_IP4_ADDRESS, ifindex);
+    nm_platform_iter_obj_for_each (&iter, nm_device_get_platform(self), &lookup, &obj) {
+        if (NMP_OBJECT_CAST_IP4_ADDRESS(obj)->address == dev_state->dhcp4_address)
+            return TRUE;
+    }
+    return FALSE;
+}
+
 static void
 _dev_ipdhcpx_start(NMDevice *self, int addr_family)
 {
@@ -11799,6 +13252,12 @@ _dev_ipdhcpx_start(NMDevice *self, int addr_family)
                                             L3_CONFIG_DATA_TYPE_DHCP_X(IS_IPv4),
                                             previous_lease,
                                             FALSE);
+    } else if (IS_IPv4 && _dev_ipdhcp4_can_resume(self, ifindex, connection)) {
+        /* Don't let the assumed device wait for the DHCP server. The client
+         * requests the same address and the lease gets applied when it arrives. */
+        _LOGI_ipdhcp(addr_family, "resume the lease of the previous NetworkManager instance");
+        _dev_ipdhcpx_set_state(self, addr_family, NM_DEVICE_IP_STATE_READY);
+        _dev_ip_state_check_async(self, addr_family);
     }
 
     return;
@@ -12669,21 +14128,151 @@ _commit_mtu(NMDevice *self)
 #undef _IP6_MTU_SYS
 }
 
+/* MTU changes ripple through stacked devices: a port changes the MTU of its
+ * controller, and a parent the MTU of its VLANs. Instead of committing each of
+ * them right away, and again whenever a lower device settles, the devices get
+ * queued here and committed together on idle, the lower devices first. */
+static GHashTable *_mtu_commit_pending;
+static GSource    *_mtu_commit_idle_source;
+
+static gboolean
+_mtu_commit_state_allowed(NMDevice *self)
+{
+    NMDeviceState state = nm_device_get_state(self);
+
+    return state >= NM_DEVICE_STATE_CONFIG && state < NM_DEVICE_STATE_DEACTIVATING;
+}
+
+/* Returns the height of the device in the stack. Devices without a parent and
+ * without ports are at 0, a device is above its parent and its ports. */
+static guint
+_mtu_commit_get_level(NMDevice *self, guint recursion)
+{
+    NMDevicePrivate *priv  = NM_DEVICE_GET_PRIVATE(self);
+    guint            level = 0;
+    PortInfo        *info;
+
+    /* There are no loops in the stack, but don't trust that blindly. */
+    if (recursion > 16)
+        return 0;
+
+    if (priv->parent_device.obj)
+        level = _mtu_commit_get_level(priv->parent_device.obj, recursion + 1) + 1;
+
+    c_list_for_each_entry (info, &priv->ports, lst_port)
+        level = NM_MAX(level, _mtu_commit_get_level(info->port, recursion + 1) + 1);
+
+    return level;
+}
+
+static gboolean
+_mtu_commit_has_lower_pending(NMDevice *self, GHashTable *pending)
+{
+    NMDevicePrivate *priv = NM_DEVICE_GET_PRIVATE(self);
+    PortInfo        *info;
+
+    if (priv->parent_device.obj && g_hash_table_contains(pending, priv->parent_device.obj))
+        return TRUE;
+
+    c_list_for_each_entry (info, &priv->ports, lst_port) {
+        if (g_hash_table_contains(pending, info->port))
+            return TRUE;
+    }
+    return FALSE;
+}
+
+static int
+_mtu_commit_cmp(gconstpointer a, gconstpointer b, gpointer user_data)
+{
+    GHashTable *levels   = user_data;
+    NMDevice   *device_a = *((NMDevice **) a);
+    NMDevice   *device_b = *((NMDevice **) b);
+
+    NM_CMP_DIRECT(GPOINTER_TO_UINT(g_hash_table_lookup(levels, device_a)),
+                  GPOINTER_TO_UINT(g_hash_table_lookup(levels, device_b)));
+    NM_CMP_DIRECT(nm_device_get_ip_ifindex(device_a), nm_device_get_ip_ifindex(device_b));
+    return 0;
+}
+
+static gboolean
+_mtu_commit_idle_cb(gpointer user_data)
+{
+    gs_unref_hashtable GHashTable *pending = NULL;
+    gs_unref_hashtable GHashTable *levels  = NULL;
+    gs_unref_ptrarray GPtrArray   *devices = NULL;
+    const CList                   *tmp_lst;
+    NMDevice                      *device;
+    GHashTableIter                 iter;
+    gboolean                       added;
+    guint                          i;
+
+    nm_clear_g_source_inst(&_mtu_commit_idle_source);
+
+    /* Devices that get queued while we commit are handled by the next idle
+     * handler. */
+    pending = g_steal_pointer(&_mtu_commit_pending);
+
+    /* The devices on top of a queued device depend on its MTU. Plan them in
+     * the same batch, instead of waiting for the platform to report the new
+     * MTU of the lower device. */
+    do {
+        added = FALSE;
+        nm_manager_for_each_device (NM_MANAGER_GET, device, tmp_lst) {
+            if (g_hash_table_contains(pending, device) || !_mtu_commit_state_allowed(device)
+                || !_mtu_commit_has_lower_pending(device, pending))
+                continue;
+            g_hash_table_add(pending, g_object_ref(device));
+            added = TRUE;
+        }
+    } while (added);
+
+    levels  = g_hash_table_new(nm_direct_hash, NULL);
+    devices = g_ptr_array_new_full(g_hash_table_size(pending), g_object_unref);
+    g_hash_table_iter_init(&iter, pending);
+    while (g_hash_table_iter_next(&iter, (gpointer *) &device, NULL)) {
+        g_hash_table_insert(levels, device, GUINT_TO_POINTER(_mtu_commit_get_level(device, 0)));
+        g_ptr_array_add(devices, g_object_ref(device));
+    }
+
+    g_ptr_array_sort_with_data(devices, _mtu_commit_cmp, levels);
+
+    for (i = 0; i < devices->len; i++) {
+        NMDevice *self = devices->pdata[i];
+
+        if (!_mtu_commit_state_allowed(self))
+            continue;
+        _LOGT(LOGD_DEVICE,
+              "mtu: commit-mtu (level %u)...",
+              GPOINTER_TO_UINT(g_hash_table_lookup(levels, self)));
+        _commit_mtu(self);
+    }
+
+    return G_SOURCE_CONTINUE;
+}
+
 void
 nm_device_commit_mtu(NMDevice *self)
 {
-    NMDeviceState state;
-
     g_return_if_fail(NM_IS_DEVICE(self));
 
-    state = nm_device_get_state(self);
-    if (state >= NM_DEVICE_STATE_CONFIG && state < NM_DEVICE_STATE_DEACTIVATING) {
-        _LOGT(LOGD_DEVICE, "mtu: commit-mtu...");
-        _commit_mtu(self);
-    } else
+    if (!_mtu_commit_state_allowed(self)) {
         _LOGT(LOGD_DEVICE,
               "mtu: commit-mtu... skip due to state %s",
-              nm_device_state_to_string(state));
+              nm_device_state_to_string(nm_device_get_state(self)));
+        return;
+    }
+
+    if (!_mtu_commit_pending)
+        _mtu_commit_pending = g_hash_table_new_full(nm_direct_hash, NULL, g_object_unref, NULL);
+
+    if (!g_hash_table_add(_mtu_commit_pending, g_object_ref(self))) {
+        /* Already queued. */
+        return;
+    }
+
+    _LOGT(LOGD_DEVICE, "mtu: commit-mtu scheduled");
+    if (!_mtu_commit_idle_source)
+        _mtu_commit_idle_source = nm_g_idle_add_source(_mtu_commit_idle_cb, NULL);
 }
 
 /*****************************************************************************/
@@ -12717,6 +14306,7 @@ _dev_ipac6_set_state(NMDevice *self, NMDeviceIPState state)
                     nm_device_ip_state_to_string(state),
                     nm_device_ip_state_to_string(priv->ipac6_data.state));
         priv->ipac6_data.state = state;
+        _startup_trace_phase(self, "ac6", _startup_trace_ip_phase(state));
     }
 }
 
@@ -13577,6 +15167,7 @@ _dev_ipsharedx_cleanup(NMDevice *self, int addr_family)
             nm_dnsmasq_manager_stop(priv->ipshared_data_4.v4.dnsmasq_manager);
             g_clear_object(&priv->ipshared_data_4.v4.dnsmasq_manager);
         }
+        nm_clear_pointer(&priv->ipshared_data_4.v4.dhcp_server, nm_dhcp_server_free);
 
         if (priv->ipshared_data_4.v4.firewall_config) {
             nm_firewall_config_apply_sync(priv->ipshared_data_4.v4.firewall_config, FALSE);
@@ -13691,6 +15282,27 @@ _dev_ipshared4_dnsmasq_state_changed_cb(NMDnsMasqManager *manager, guint status,
     _dev_ip_state_check_async(self, AF_INET);
 }
 
+static void
+_dev_ipshared4_dhcp_server_failed_cb(NMDhcpServer *server, gpointer user_data)
+{
+    NMDevice *self = NM_DEVICE(user_data);
+
+    _dev_ipsharedx_set_state(self, AF_INET, NM_DEVICE_IP_STATE_FAILED);
+    _dev_ip_state_check_async(self, AF_INET);
+}
+
+static gboolean
+_dev_ipshared4_internal_dhcp_enabled(void)
+{
+    gs_free char *value = NULL;
+
+    value = nm_config_data_get_value(NM_CONFIG_GET_DATA,
+                                     NM_CONFIG_KEYFILE_GROUP_MAIN,
+                                     NM_CONFIG_KEYFILE_KEY_MAIN_SHARED_DHCP,
+                                     NM_CONFIG_GET_VALUE_STRIP | NM_CONFIG_GET_VALUE_NO_EMPTY);
+    return nm_streq0(value, "internal");
+}
+
 static void
 _dev_ipshared4_start(NMDevice *self)
 {
@@ -13705,6 +15317,7 @@ _dev_ipshared4_start(NMDevice *self)
 
     nm_assert(!priv->ipshared_data_4.v4.firewall_config);
     nm_assert(!priv->ipshared_data_4.v4.dnsmasq_manager);
+    nm_assert(!priv->ipshared_data_4.v4.dhcp_server);
     nm_assert(priv->ipshared_data_4.v4.dnsmasq_state_id == 0);
 
     ip_iface = nm_device_get_ip_iface(self);
@@ -13756,6 +15369,7 @@ _dev_ipshared4_spawn_dnsmasq(NMDevice *self)
     nm_assert(priv->ipshared_data_4.v4.firewall_config);
     nm_assert(priv->ipshared_data_4.v4.dnsmasq_state_id == 0);
     nm_assert(!priv->ipshared_data_4.v4.dnsmasq_manager);
+    nm_assert(!priv->ipshared_data_4.v4.dhcp_server);
     nm_assert(priv->ipshared_data_4.v4.l3cd);
 
     ready = nm_l3cfg_check_ready(priv->l3cfg,
@@ -13800,6 +15414,27 @@ _dev_ipshared4_spawn_dnsmasq(NMDevice *self)
     s_ip4                  = nm_device_get_applied_setting(self, NM_TYPE_SETTING_IP4_CONFIG);
     shared_dhcp_range      = nm_setting_ip_config_get_shared_dhcp_range(s_ip4);
     shared_dhcp_lease_time = nm_setting_ip_config_get_shared_dhcp_lease_time(s_ip4);
+
+    if (_dev_ipshared4_internal_dhcp_enabled()) {
+        /* Serve DHCP from our own main loop instead of spawning dnsmasq. This
+         * does not provide a DNS proxy, see "shared-dns-forwarder". */
+        priv->ipshared_data_4.v4.dhcp_server =
+            nm_dhcp_server_new(nm_device_get_ip_ifindex(self),
+                               ip_iface,
+                               priv->ipshared_data_4.v4.l3cd,
+                               shared_dhcp_range,
+                               shared_dhcp_lease_time,
+                               announce_android_metered,
+                               _dev_ipshared4_dhcp_server_failed_cb,
+                               self,
+                               &error);
+        if (!priv->ipshared_data_4.v4.dhcp_server) {
+            _LOGW_ipshared(AF_INET, "could not start DHCP server: %s", error->message);
+            goto out_fail;
+        }
+        goto out_ready;
+    }
+
     priv->ipshared_data_4.v4.dnsmasq_manager = nm_dnsmasq_manager_new(ip_iface);
     if (!nm_dnsmasq_manager_start(priv->ipshared_data_4.v4.dnsmasq_manager,
                                   priv->ipshared_data_4.v4.l3cd,
@@ -13817,6 +15452,7 @@ _dev_ipshared4_spawn_dnsmasq(NMDevice *self)
                          G_CALLBACK(_dev_ipshared4_dnsmasq_state_changed_cb),
                          self);
 
+out_ready:
     _dev_ipsharedx_set_state(self, AF_INET, NM_DEVICE_IP_STATE_READY);
     _dev_ip_state_check_async(self, AF_INET);
     nm_clear_l3cd(&priv->ipshared_data_4.v4.l3cd);
@@ -14227,7 +15863,9 @@ can_reapply_change(NMDevice   *self,
                      NM_SETTING_PROXY_SETTING_NAME,
                      NM_SETTING_IP4_CONFIG_SETTING_NAME,
                      NM_SETTING_IP6_CONFIG_SETTING_NAME,
-                     NM_SETTING_LINK_SETTING_NAME))
+                     NM_SETTING_LINK_SETTING_NAME,
+                     NM_SETTING_TC_CONFIG_SETTING_NAME,
+                     NM_SETTING_ETHTOOL_SETTING_NAME))
         return TRUE;
 
     if (nm_streq(setting_name, NM_SETTING_WIRED_SETTING_NAME)) {
@@ -14270,6 +15908,26 @@ static void
 reapply_connection(NMDevice *self, NMConnection *con_old, NMConnection *con_new)
 {}
 
+/* Whether only the static routes or routing rules of an IP setting changed.
+ * Those don't need to restart the IP method, only the manual configuration
+ * is updated. */
+static gboolean
+_reapply_ip_is_routes_only(GHashTable *ip_diff)
+{
+    GHashTableIter iter;
+    const char    *name;
+
+    if (!ip_diff)
+        return FALSE;
+
+    g_hash_table_iter_init(&iter, ip_diff);
+    while (g_hash_table_iter_next(&iter, (gpointer *) &name, NULL)) {
+        if (!NM_IN_STRSET(name, NM_SETTING_IP_CONFIG_ROUTES, NM_SETTING_IP_CONFIG_ROUTING_RULES))
+            return FALSE;
+    }
+    return TRUE;
+}
+
 /* check_and_reapply_connection:
  * @connection: the new connection settings to be applied or %NULL to reapply
  *   the current settings connection
@@ -14434,24 +16092,49 @@ check_and_reapply_connection(NMDevice            *self,
 
     if (priv->state >= NM_DEVICE_STATE_CONFIG) {
         GHashTable *sriov_diff;
+        GHashTable *ethtool_diff;
 
         lldp_setup(self, NM_TERNARY_DEFAULT);
 
+        if (!nm_device_managed_type_is_external(self)) {
+            ethtool_diff = nm_g_hash_table_lookup(diffs, NM_SETTING_ETHTOOL_SETTING_NAME);
+            if (ethtool_diff)
+                _ethtool_state_reapply(self, ethtool_diff);
+
+            /* The ethtool channels determine the queues to configure. */
+            if (ethtool_diff || nm_g_hash_table_lookup(diffs, NM_SETTING_LINK_SETTING_NAME)) {
+                link_steering_set(self);
+                link_xdp_set(self);
+            }
+
+            /* The platform only replaces the qdiscs and filters that differ.
+             * The ethtool channels determine the qdiscs for each TX queue. */
+            if ((ethtool_diff || nm_g_hash_table_lookup(diffs, NM_SETTING_TC_CONFIG_SETTING_NAME))
+                && !tc_commit(self))
+                _LOGW(LOGD_DEVICE, "failed reapplying traffic control rules");
+        }
+
         sriov_diff = nm_g_hash_table_lookup(diffs, NM_SETTING_SRIOV_SETTING_NAME);
 
         if (sriov_diff && nm_g_hash_table_lookup(sriov_diff, NM_SETTING_SRIOV_VFS)) {
             nm_auto_freev NMPlatformVF **plat_vfs = NULL;
             NMSettingSriov              *s_sriov;
+            NMSettingSriov              *s_sriov_old;
 
             s_sriov = (NMSettingSriov *) nm_connection_get_setting(applied, NM_TYPE_SETTING_SRIOV);
+            s_sriov_old =
+                (NMSettingSriov *) nm_connection_get_setting(con_old, NM_TYPE_SETTING_SRIOV);
 
             if (s_sriov) {
                 gs_free_error GError *local = NULL;
 
-                if (!sriov_gen_platform_vfs(self, s_sriov, &plat_vfs, &local)
-                    || !nm_platform_link_set_sriov_vfs(nm_device_get_platform(self),
-                                                       priv->ifindex,
-                                                       (const NMPlatformVF *const *) plat_vfs)) {
+                /* Only send the VFs whose configuration changed. */
+                if (!sriov_gen_platform_vfs(self, s_sriov, s_sriov_old, &plat_vfs, &local)
+                    || (plat_vfs[0]
+                        && !nm_platform_link_set_sriov_vfs(
+                            nm_device_get_platform(self),
+                            priv->ifindex,
+                            (const NMPlatformVF *const *) plat_vfs))) {
                     _LOGE(LOGD_DEVICE,
                           "failed to reapply SRIOV VFs%s%s",
                           local ? ": " : "",
@@ -14462,12 +16145,20 @@ check_and_reapply_connection(NMDevice            *self,
     }
 
     if (priv->state >= NM_DEVICE_STATE_IP_CONFIG) {
+        gboolean routes_only_4;
+        gboolean routes_only_6;
+
         /* Allow reapply of MTU */
         priv->mtu_source = NM_DEVICE_MTU_SOURCE_NONE;
 
-        if (nm_g_hash_table_lookup(diffs, NM_SETTING_IP4_CONFIG_SETTING_NAME))
+        routes_only_4 = _reapply_ip_is_routes_only(
+            nm_g_hash_table_lookup(diffs, NM_SETTING_IP4_CONFIG_SETTING_NAME));
+        routes_only_6 = _reapply_ip_is_routes_only(
+            nm_g_hash_table_lookup(diffs, NM_SETTING_IP6_CONFIG_SETTING_NAME));
+
+        if (nm_g_hash_table_lookup(diffs, NM_SETTING_IP4_CONFIG_SETTING_NAME) && !routes_only_4)
             priv->ip_data_4.do_reapply = TRUE;
-        if (nm_g_hash_table_lookup(diffs, NM_SETTING_IP6_CONFIG_SETTING_NAME))
+        if (nm_g_hash_table_lookup(diffs, NM_SETTING_IP6_CONFIG_SETTING_NAME) && !routes_only_6)
             priv->ip_data_6.do_reapply = TRUE;
 
         if (nm_g_hash_table_contains_any(
@@ -14482,6 +16173,21 @@ check_and_reapply_connection(NMDevice            *self,
             priv->ip_data_6.do_reapply = TRUE;
         }
 
+        if ((routes_only_4 && !priv->ip_data_4.do_reapply)
+            || (routes_only_6 && !priv->ip_data_6.do_reapply)) {
+            /* Only the static routes or routing rules changed. Replace the manual
+             * configuration and let the commit below sync the routes, without
+             * restarting the IP methods (and DHCP). */
+            if (_dev_ipmanual_update(self))
+                _LOGD(LOGD_DEVICE, "reapply: only update routes");
+            else {
+                if (routes_only_4)
+                    priv->ip_data_4.do_reapply = TRUE;
+                if (routes_only_6)
+                    priv->ip_data_6.do_reapply = TRUE;
+            }
+        }
+
         nm_device_activate_schedule_stage3_ip_config(self, FALSE);
 
         nm_routing_rules_sync(nm_device_get_applied_connection(self),
@@ -14699,12 +16405,12 @@ impl_device_get_applied_connection(NMDBusObject                      *obj,
                                    GDBusMethodInvocation             *invocation,
                                    GVariant                          *parameters)
 {
-    NMDevice             *self  = NM_DEVICE(obj);
-    NMDevicePrivate      *priv  = NM_DEVICE_GET_PRIVATE(self);
-    gs_free_error GError *error = NULL;
-    NMConnection         *applied_connection;
-    guint32               flags;
-    GVariant             *var_settings;
+    NMDevice                  *self         = NM_DEVICE(obj);
+    NMDevicePrivate           *priv         = NM_DEVICE_GET_PRIVATE(self);
+    gs_free_error GError      *error        = NULL;
+    gs_unref_variant GVariant *var_settings = NULL;
+    NMConnection              *applied_connection;
+    guint32                    flags;
 
     g_variant_get(parameters, "(u)", &flags);
 
@@ -14737,9 +16443,9 @@ impl_device_get_applied_connection(NMDBusObject                      *obj,
     }
 
     var_settings =
-        nm_connection_to_dbus(applied_connection, NM_CONNECTION_SERIALIZE_WITH_NON_SECRET);
+        _nm_connection_to_dbus_cached(applied_connection, NM_CONNECTION_SERIALIZE_WITH_NON_SECRET);
     if (!var_settings)
-        var_settings = nm_g_variant_singleton_aLsaLsvII();
+        var_settings = g_variant_ref(nm_g_variant_singleton_aLsaLsvII());
 
     g_dbus_method_invocation_return_value(
         invocation,
@@ -15139,8 +16845,7 @@ nm_device_queue_activation(NMDevice *self, NMActRequest *req)
 gboolean
 nm_device_is_activating(NMDevice *self)
 {
-    NMDevicePrivate *priv = NM_DEVICE_GET_PRIVATE(self);
-    NMDeviceState    state;
+    NMDeviceState state;
 
     g_return_val_if_fail(NM_IS_DEVICE(self), FALSE);
 
@@ -15153,7 +16858,7 @@ nm_device_is_activating(NMDevice *self)
      * handler is actually run.  If there's an activation handler scheduled
      * we're activating anyway.
      */
-    return !!priv->activation_idle_source;
+    return c_list_is_linked(&self->activation_lst);
 }
 
 NMDhcpConfig *
@@ -17308,6 +19013,8 @@ nm_device_cleanup(NMDevice *self, NMDeviceStateReason reason, CleanupType cleanu
 
     _ethtool_state_reset(self);
     link_properties_reset(self);
+    link_steering_reset(self);
+    link_xdp_reset(self);
 
     if (priv->promisc_reset != NM_OPTION_BOOL_DEFAULT && ifindex > 0) {
         nm_platform_link_change_flags(nm_device_get_platform(self),
@@ -17519,6 +19226,8 @@ _set_state_full(NMDevice *self, NMDeviceState state, NMDeviceStateReason reason,
           nm_device_state_reason_to_string_a(reason),
           nm_device_managed_type_to_string(priv->managed_type));
 
+    _startup_trace_phase(self, NULL, nm_device_state_to_string(state));
+
     /* in order to prevent triggering any callback caused
      * by the device not having any pending action anymore
      * we add one here that gets removed at the end of the function */
@@ -18885,6 +20594,63 @@ _resolver_state_to_string(ResolverState state)
     return "UNKNOWN";
 }
 
+static GHashTable *_hostname_lookup_cache;
+
+static void
+_hostname_lookup_cache_entry_free(gpointer data)
+{
+    HostnameLookupCacheEntry *entry = data;
+
+    g_free(entry->hostname);
+    nm_g_slice_free(entry);
+}
+
+static const char *
+_hostname_lookup_cache_get(GInetAddress *address)
+{
+    HostnameLookupCacheEntry *entry;
+    gs_free char             *addr_str = NULL;
+
+    if (!_hostname_lookup_cache)
+        return NULL;
+
+    addr_str = g_inet_address_to_string(address);
+    entry    = g_hash_table_lookup(_hostname_lookup_cache, addr_str);
+    if (!entry || entry->expiry_msec <= nm_utils_get_monotonic_timestamp_msec())
+        return NULL;
+    return entry->hostname;
+}
+
+static void
+_hostname_lookup_cache_add(GInetAddress *address, const char *hostname)
+{
+    HostnameLookupCacheEntry *entry;
+    GHashTableIter            iter;
+    gint64                    now_msec;
+
+    now_msec = nm_utils_get_monotonic_timestamp_msec();
+
+    if (!_hostname_lookup_cache) {
+        _hostname_lookup_cache = g_hash_table_new_full(nm_str_hash,
+                                                       g_str_equal,
+                                                       g_free,
+                                                       _hostname_lookup_cache_entry_free);
+    } else {
+        g_hash_table_iter_init(&iter, _hostname_lookup_cache);
+        while (g_hash_table_iter_next(&iter, NULL, (gpointer *) &entry)) {
+            if (entry->expiry_msec <= now_msec)
+                g_hash_table_iter_remove(&iter);
+        }
+    }
+
+    entry  = g_slice_new(HostnameLookupCacheEntry);
+    *entry = (HostnameLookupCacheEntry) {
+        .hostname    = g_strdup(hostname),
+        .expiry_msec = now_msec + HOSTNAME_LOOKUP_CACHE_TTL_MSEC,
+    };
+    g_hash_table_insert(_hostname_lookup_cache, g_inet_address_to_string(address), entry);
+}
+
 static void
 hostname_dns_lookup_callback(GObject *source, GAsyncResult *result, gpointer user_data)
 {
@@ -18925,6 +20691,8 @@ hostname_dns_lookup_callback(GObject *source, GAsyncResult *result, gpointer use
 
         if (!valid)
             nm_clear_g_free(&resolver->hostname);
+        else
+            _hostname_lookup_cache_add(resolver->address, resolver->hostname);
     }
 
     nm_clear_g_cancellable(&resolver->cancellable);
@@ -19127,18 +20895,35 @@ nm_device_get_hostname_from_dns_lookup(NMDevice *self, int addr_family, gboolean
     if (address_changed) {
         nm_clear_g_cancellable(&resolver->cancellable);
         g_clear_object(&resolver->address);
+        nm_clear_g_free(&resolver->hostname);
     }
 
     if (address_changed && new_address) {
-        resolver->cancellable = g_cancellable_new();
-        resolver->address     = g_steal_pointer(&new_address);
-
-        nm_device_resolve_address(addr_family,
-                                  g_inet_address_to_bytes(resolver->address),
-                                  resolver->cancellable,
-                                  hostname_dns_lookup_callback,
-                                  resolver);
+        const char *cached;
+
+        resolver->address = g_steal_pointer(&new_address);
         nm_clear_g_source(&resolver->timeout_id);
+
+        cached = _hostname_lookup_cache_get(resolver->address);
+        if (cached) {
+            gs_free char *addr_str = NULL;
+
+            _LOGT(LOGD_DNS,
+                  "hostname-from-dns: ipv%c resolver %s: cached result for %s: \"%s\"",
+                  nm_utils_addr_family_to_char(resolver->addr_family),
+                  _resolver_state_to_string(RESOLVER_DONE),
+                  (addr_str = g_inet_address_to_string(resolver->address)),
+                  cached);
+            resolver->state    = RESOLVER_DONE;
+            resolver->hostname = g_strdup(cached);
+        } else {
+            resolver->cancellable = g_cancellable_new();
+            nm_device_resolve_address(addr_family,
+                                      g_inet_address_to_bytes(resolver->address),
+                                      resolver->cancellable,
+                                      hostname_dns_lookup_callback,
+                                      resolver);
+        }
     }
 
     switch (resolver->state) {
@@ -19479,6 +21264,7 @@ nm_device_init(NMDevice *self)
     c_list_init(&self->devices_lst);
     c_list_init(&self->devcon_dev_lst_head);
     c_list_init(&self->policy_auto_activate_lst);
+    c_list_init(&self->activation_lst);
     c_list_init(&priv->ports);
 
     priv->ipdhcp_data_6.v6.mode = NM_NDISC_DHCP_LEVEL_NONE;
@@ -19603,9 +21389,9 @@ dispose(GObject *object)
     _LOGD(LOGD_DEVICE, "disposing");
 
     nm_assert(c_list_is_empty(&self->devices_lst));
+    nm_assert(!self->devices_idx_iface);
     nm_assert(c_list_is_empty(&self->devcon_dev_lst_head));
     nm_assert(c_list_is_empty(&self->policy_auto_activate_lst));
-    nm_assert(!self->policy_auto_activate_idle_source);
 
     while ((con_handle = c_list_first_entry(&priv->concheck_lst_head,
                                             NMDeviceConnectivityHandle,
@@ -19617,6 +21403,8 @@ dispose(GObject *object)
 
     nm_clear_g_cancellable(&priv->deactivating_cancellable);
 
+    activation_source_clear(self);
+
     nm_device_assume_state_reset(self);
 
     _parent_set_ifindex(self, 0, FALSE);
@@ -19649,7 +21437,7 @@ dispose(GObject *object)
 
     nm_clear_g_source(&priv->check_delete_unrealized_id);
 
-    nm_clear_g_source_inst(&priv->stats.timeout_source);
+    _stats_poller_remove(self);
 
     carrier_disconnected_action_cancel(self);
 
@@ -19720,8 +21508,12 @@ finalize(GObject *object)
     g_free(priv->type_desc);
     g_free(priv->current_stable_id);
 
+    _generate_connection_cache_clear(self);
+
     g_hash_table_unref(priv->ip6_saved_properties);
     g_hash_table_unref(priv->available_connections);
+    nm_clear_pointer(&priv->link_neighs, g_ptr_array_unref);
+    nm_clear_pointer(&priv->link_steering.saved, g_hash_table_unref);
 
     nm_dbus_track_obj_path_deinit(&priv->parent_device);
     nm_dbus_track_obj_path_deinit(&priv->act_request);
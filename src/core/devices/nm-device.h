@@ -145,8 +145,17 @@ struct _NMDevice {
     CList                    devices_lst;
     CList                    devcon_dev_lst_head;
 
-    CList    policy_auto_activate_lst;
-    GSource *policy_auto_activate_idle_source;
+    /* The keys under which NMManager indexes the device. */
+    int   devices_idx_ifindex;
+    char *devices_idx_iface;
+
+    CList  policy_auto_activate_lst;
+    gint64 policy_auto_activate_queued_msec;
+    int    policy_auto_activate_priority;
+
+    /* Links the device in the queue of its scheduled activation stage. */
+    CList  activation_lst;
+    gint64 activation_queued_nsec;
 };
 
 /* The flags have an relaxing meaning, that means, specifying more flags, can make
@@ -211,6 +220,10 @@ typedef struct _NMDeviceClass {
 
     bool allow_autoconnect_on_external : 1;
 
+    /* update_connection() reads state that is not in the platform cache. Then
+     * the generated connection is not cached. */
+    bool update_connection_uses_external_state : 1;
+
     NMRfkillType rfkill_type : 4;
 
     void (*state_changed)(NMDevice           *device,
@@ -243,6 +256,27 @@ typedef struct _NMDeviceClass {
                                    const NMPlatformLink **out_plink,
                                    GError               **error);
 
+    /**
+     * create_link_op():
+     * @self: the #NMDevice
+     * @connection: the #NMConnection being activated
+     * @parent: the parent #NMDevice, if any
+     * @op: the link to create
+     * @error: location to store error, or %NULL
+     *
+     * An alternative to create_and_realize() for devices that only need to
+     * create one kernel link. Fills in @op, which is then passed to
+     * nm_platform_link_add_batch(), possibly together with the links of
+     * other devices.
+     *
+     * Returns: %TRUE on success, %FALSE on error
+     */
+    gboolean (*create_link_op)(NMDevice            *self,
+                               NMConnection        *connection,
+                               NMDevice            *parent,
+                               NMPlatformLinkAddOp *op,
+                               GError             **error);
+
     /**
      * realize_start_notify():
      * @self: the #NMDevice
@@ -682,6 +716,16 @@ gboolean nm_device_create_and_realize(NMDevice     *self,
                                       NMConnection *connection,
                                       NMDevice     *parent,
                                       GError      **error);
+
+typedef struct {
+    NMDevice     *device;
+    NMConnection *connection;
+    NMDevice     *parent;
+    bool          success;
+    GError       *error;
+} NMDeviceCreateAndRealizeData;
+
+void nm_device_create_and_realize_many(NMDeviceCreateAndRealizeData *data, guint n_data);
 gboolean nm_device_unrealize(NMDevice *device, gboolean remove_resources, GError **error);
 
 void nm_device_update_from_platform_link(NMDevice *self, const NMPlatformLink *plink);
@@ -830,6 +830,14 @@ lldp_event_handler(NMLldpRX *lldp, NMLldpRXEvent event, NMLldpNeighbor *n, void
 {
     NMLldpListener *self = user_data;
 
+    if (event == NM_LLDP_RX_EVENT_REFRESHED) {
+        /* The neighbor sent the identical frame again, which happens every
+         * few seconds per port. We already track this very neighbor instance,
+         * there is nothing to update. */
+        _LOGT("event: %s", nm_lldp_rx_event_to_string(event));
+        return;
+    }
+
     _LOGD("event: %s", nm_lldp_rx_event_to_string(event));
     process_lldp_neighbor(self,
                           n,
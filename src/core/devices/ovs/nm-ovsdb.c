@@ -83,6 +83,9 @@ typedef enum {
 
 #define CALL_ID_UNSPEC G_MAXUINT64
 
+/* The maximum number of calls that share one "transact" request. */
+#define OVSDB_BATCH_MAX 64u
+
 typedef union {
     struct {
     } monitor;
@@ -120,6 +123,7 @@ typedef struct {
     gpointer            user_data;
     OvsdbMethodPayload  payload;
     GObject            *shutdown_wait_obj;
+    bool                no_batch;
 } OvsdbMethodCall;
 
 /*****************************************************************************/
@@ -144,6 +148,13 @@ typedef struct {
     NMStrBuf input_buf;
     NMStrBuf output_buf;
 
+    struct {
+        gsize pos;   /* How far input_buf was scanned for the end of the message */
+        guint depth; /* Nesting of objects and arrays at pos */
+        bool  in_string : 1;
+        bool  escaped : 1;
+    } input_scan;
+
     GSource *input_timeout_source;
 
     guint64 call_id_counter;
@@ -153,6 +164,10 @@ typedef struct {
     GHashTable *interfaces; /* interface uuid => OpenvswitchInterface */
     GHashTable *ports;      /* port uuid => OpenvswitchPort */
     GHashTable *bridges;    /* bridge uuid => OpenvswitchBridge */
+
+    GHashTable *interfaces_by_name; /* interface name => OpenvswitchInterface */
+    GHashTable *port_by_interface;  /* interface uuid => port uuid */
+    GHashTable *bridge_by_port;     /* port uuid => bridge uuid */
     char       *db_uuid;
     guint       num_failures;
     bool        ready : 1;
@@ -163,6 +178,11 @@ typedef struct {
         gulong     link_changed_id; /* Platform link-changed signal handle */
         guint      num_pending_del; /* Number of ovsdb deletions pending */
     } cleanup;
+    struct {
+        json_t *rows;        /* table => row uuid => row, for "monitor_cond_since" */
+        char   *last_txn_id; /* Last transaction seen, to resume monitoring from */
+        bool    cond_since_unsupported : 1;
+    } monitor;
 } NMOvsdbPrivate;
 
 struct _NMOvsdb {
@@ -362,6 +382,33 @@ _free_interface(OpenvswitchInterface *ovs_interface)
     nm_g_slice_free(ovs_interface);
 }
 
+static void
+_interface_by_name_remove(GHashTable *index, const OpenvswitchInterface *ovs_interface)
+{
+    if (g_hash_table_lookup(index, ovs_interface->name) == ovs_interface)
+        g_hash_table_remove(index, ovs_interface->name);
+}
+
+/* Updates the @index from child uuid to parent uuid, after the children of
+ * @parent_uuid changed from @old_children to @new_children. */
+static void
+_parent_index_update(GHashTable      *index,
+                     const char      *parent_uuid,
+                     const GPtrArray *old_children,
+                     const GPtrArray *new_children)
+{
+    guint i;
+
+    for (i = 0; i < nm_g_ptr_array_len(old_children); i++) {
+        const char *child = old_children->pdata[i];
+
+        if (nm_streq0(g_hash_table_lookup(index, child), parent_uuid))
+            g_hash_table_remove(index, child);
+    }
+    for (i = 0; i < nm_g_ptr_array_len(new_children); i++)
+        g_hash_table_insert(index, g_strdup(new_children->pdata[i]), g_strdup(parent_uuid));
+}
+
 /*****************************************************************************/
 
 static void
@@ -1387,11 +1434,20 @@ _delete_interface(NMOvsdb *self, json_t *params, const char *ifname)
     nm_auto_decref_json json_t *bridges     = NULL;
     nm_auto_decref_json json_t *new_bridges = NULL;
     gboolean                    bridges_changed;
+    const char                 *bridge_uuid = NULL;
 
     bridges         = json_array();
     new_bridges     = json_array();
     bridges_changed = FALSE;
 
+    /* Find the bridge of the interface, only that one needs to change. */
+    ovs_interface = g_hash_table_lookup(priv->interfaces_by_name, ifname);
+    if (ovs_interface) {
+        port_uuid = g_hash_table_lookup(priv->port_by_interface, ovs_interface->interface_uuid);
+        if (port_uuid)
+            bridge_uuid = g_hash_table_lookup(priv->bridge_by_port, port_uuid);
+    }
+
     /* Loop over all bridges */
     g_hash_table_iter_init(&iter, priv->bridges);
     while (g_hash_table_iter_next(&iter, (gpointer) &ovs_bridge, NULL)) {
@@ -1407,8 +1463,8 @@ _delete_interface(NMOvsdb *self, json_t *params, const char *ifname)
         /* Add the bridge UUID to the list of known bridges for the "expect" condition */
         json_array_append_new(bridges, json_pack("[s,s]", "uuid", ovs_bridge->bridge_uuid));
 
-        if (!ovs_bridge->connection_uuid) {
-            /* Externally created, don't touch it */
+        if (!ovs_bridge->connection_uuid || !nm_streq0(ovs_bridge->bridge_uuid, bridge_uuid)) {
+            /* Externally created or not containing the interface, don't touch it */
             json_array_append_new(new_bridges, json_pack("[s,s]", "uuid", ovs_bridge->bridge_uuid));
             continue;
         }
@@ -1501,6 +1557,212 @@ _delete_interface(NMOvsdb *self, json_t *params, const char *ifname)
     }
 }
 
+#define OVSDB_TXN_ID_ZERO "00000000-0000-0000-0000-000000000000"
+
+typedef enum {
+    OVSDB_COLUMN_STRING,
+    OVSDB_COLUMN_SET,
+    OVSDB_COLUMN_MAP,
+} OvsdbColumnType;
+
+typedef struct {
+    const char *table;
+    struct {
+        const char     *name;
+        OvsdbColumnType type;
+    } columns[6];
+} OvsdbMonitorTable;
+
+/* The tables and columns we monitor. The column types are needed to fill in
+ * the default values omitted from "update2" rows and to apply diffs. */
+static const OvsdbMonitorTable _monitor_tables[] = {
+    {
+        .table = "Bridge",
+        .columns =
+            {
+                {"name", OVSDB_COLUMN_STRING},
+                {"ports", OVSDB_COLUMN_SET},
+                {"external_ids", OVSDB_COLUMN_MAP},
+                {"other_config", OVSDB_COLUMN_MAP},
+            },
+    },
+    {
+        .table = "Port",
+        .columns =
+            {
+                {"name", OVSDB_COLUMN_STRING},
+                {"interfaces", OVSDB_COLUMN_SET},
+                {"external_ids", OVSDB_COLUMN_MAP},
+                {"other_config", OVSDB_COLUMN_MAP},
+            },
+    },
+    {
+        .table = "Interface",
+        .columns =
+            {
+                {"name", OVSDB_COLUMN_STRING},
+                {"type", OVSDB_COLUMN_STRING},
+                {"external_ids", OVSDB_COLUMN_MAP},
+                {"other_config", OVSDB_COLUMN_MAP},
+                {"error", OVSDB_COLUMN_SET},
+            },
+    },
+    {
+        .table = "Open_vSwitch",
+    },
+};
+
+static const OvsdbMonitorTable *
+_monitor_table_find(const char *table)
+{
+    gsize i;
+
+    for (i = 0; i < G_N_ELEMENTS(_monitor_tables); i++) {
+        if (nm_streq(_monitor_tables[i].table, table))
+            return &_monitor_tables[i];
+    }
+    return NULL;
+}
+
+static json_t *
+_monitor_requests_new(void)
+{
+    json_t *requests;
+    gsize   i;
+    gsize   j;
+
+    requests = json_object();
+    for (i = 0; i < G_N_ELEMENTS(_monitor_tables); i++) {
+        json_t *columns;
+
+        columns = json_array();
+        for (j = 0; _monitor_tables[i].columns[j].name; j++)
+            json_array_append_new(columns, json_string(_monitor_tables[i].columns[j].name));
+
+        json_object_set_new(requests,
+                            _monitor_tables[i].table,
+                            json_pack("[{s:o}]", "columns", columns));
+    }
+    return requests;
+}
+
+/**
+ * _call_append_ops:
+ *
+ * Appends the operations for @call to the "transact" @params.
+ */
+static void
+_call_append_ops(NMOvsdb *self, OvsdbMethodCall *call, json_t *params)
+{
+    switch (call->command) {
+    case OVSDB_ADD_INTERFACE:
+        _add_interface(self,
+                       params,
+                       call->payload.add_interface.bridge,
+                       call->payload.add_interface.port,
+                       call->payload.add_interface.interface,
+                       call->payload.add_interface.bridge_device,
+                       call->payload.add_interface.interface_device);
+        break;
+    case OVSDB_DEL_INTERFACE:
+        _delete_interface(self, params, call->payload.del_interface.ifname);
+        break;
+    case OVSDB_SET_INTERFACE_MTU:
+        json_array_append_new(params,
+                              json_pack("{s:s, s:s, s:{s: I}, s:[[s, s, s]]}",
+                                        "op",
+                                        "update",
+                                        "table",
+                                        "Interface",
+                                        "row",
+                                        "mtu_request",
+                                        (json_int_t) call->payload.set_interface_mtu.mtu,
+                                        "where",
+                                        "name",
+                                        "==",
+                                        call->payload.set_interface_mtu.ifname));
+        break;
+    case OVSDB_SET_REAPPLY:
+    {
+        NMConnection *connection;
+        json_t       *mutations;
+        json_t       *row;
+        const char   *table;
+
+        connection = call->payload.set_reapply.connection;
+        table      = _device_type_to_table(call->payload.set_reapply.device_type);
+
+        /* Reapply device properties */
+        switch (call->payload.set_reapply.device_type) {
+        case NM_DEVICE_TYPE_OVS_BRIDGE:
+            row = create_bridge_row_object(connection, TRUE);
+            break;
+        case NM_DEVICE_TYPE_OVS_PORT:
+            row = create_port_row_object(connection);
+            break;
+        default:
+            row = NULL;
+            break;
+        }
+
+        if (row) {
+            json_array_append_new(params,
+                                  json_pack("{s:s, s:s, s:o, s:[[s, s, s]]}",
+                                            "op",
+                                            "update",
+                                            "table",
+                                            table,
+                                            "row",
+                                            row,
+                                            "where",
+                                            "name",
+                                            "==",
+                                            call->payload.set_reapply.ifname));
+        }
+
+        /* Reapply external-ids and other-config */
+        mutations = json_array();
+        _j_create_strv_array_update(mutations,
+                                    STRDICT_TYPE_EXTERNAL_IDS,
+                                    nm_connection_get_uuid(connection),
+                                    call->payload.set_reapply.external_ids_old,
+                                    call->payload.set_reapply.external_ids_new);
+        _j_create_strv_array_update(mutations,
+                                    STRDICT_TYPE_OTHER_CONFIG,
+                                    NULL,
+                                    call->payload.set_reapply.other_config_old,
+                                    call->payload.set_reapply.other_config_new);
+
+        json_array_append_new(params,
+                              json_pack("{s:s, s:s, s:o, s:[[s, s, s]]}",
+                                        "op",
+                                        "mutate",
+                                        "table",
+                                        table,
+                                        "mutations",
+                                        mutations,
+                                        "where",
+                                        "name",
+                                        "==",
+                                        call->payload.set_reapply.ifname));
+        break;
+    }
+
+    default:
+        nm_assert_not_reached();
+        break;
+    }
+}
+
+/* Whether @call only consists of operations that don't depend on our view
+ * of the database, so that it can share a transaction with other calls. */
+static gboolean
+_call_can_batch(const OvsdbMethodCall *call)
+{
+    return !call->no_batch
+           && NM_IN_SET(call->command, OVSDB_SET_INTERFACE_MTU, OVSDB_SET_REAPPLY);
+}
+
 /**
  * ovsdb_next_command:
  *
@@ -1533,39 +1795,31 @@ ovsdb_next_command(NMOvsdb *self)
 
     switch (call->command) {
     case OVSDB_MONITOR:
-        msg = json_pack("{s:I, s:s, s:[s, n, {"
-                        "  s:[{s:[s, s, s, s]}],"
-                        "  s:[{s:[s, s, s, s]}],"
-                        "  s:[{s:[s, s, s, s, s]}],"
-                        "  s:[{s:[]}]"
-                        "}]}",
+        if (priv->monitor.cond_since_unsupported) {
+            msg = json_pack("{s:I, s:s, s:[s, n, o]}",
+                            "id",
+                            (json_int_t) call->call_id,
+                            "method",
+                            "monitor",
+                            "params",
+                            "Open_vSwitch",
+                            _monitor_requests_new());
+            break;
+        }
+
+        /* Ask the server only for the changes since the last transaction we
+         * have seen, so that a reconnect doesn't require a full dump. If the
+         * server no longer knows the transaction, it replies with a full dump
+         * and we resync our cache of rows from it. */
+        msg = json_pack("{s:I, s:s, s:[s, n, o, s]}",
                         "id",
                         (json_int_t) call->call_id,
                         "method",
-                        "monitor",
+                        "monitor_cond_since",
                         "params",
                         "Open_vSwitch",
-                        "Bridge",
-                        "columns",
-                        "name",
-                        "ports",
-                        "external_ids",
-                        "other_config",
-                        "Port",
-                        "columns",
-                        "name",
-                        "interfaces",
-                        "external_ids",
-                        "other_config",
-                        "Interface",
-                        "columns",
-                        "name",
-                        "type",
-                        "external_ids",
-                        "other_config",
-                        "error",
-                        "Open_vSwitch",
-                        "columns");
+                        _monitor_requests_new(),
+                        priv->monitor.last_txn_id ?: OVSDB_TXN_ID_ZERO);
         break;
     default:
     {
@@ -1575,103 +1829,28 @@ ovsdb_next_command(NMOvsdb *self)
         json_array_append_new(params, json_string("Open_vSwitch"));
         json_array_append_new(params, _inc_next_cfg(priv->db_uuid));
 
-        switch (call->command) {
-        case OVSDB_ADD_INTERFACE:
-            _add_interface(self,
-                           params,
-                           call->payload.add_interface.bridge,
-                           call->payload.add_interface.port,
-                           call->payload.add_interface.interface,
-                           call->payload.add_interface.bridge_device,
-                           call->payload.add_interface.interface_device);
-            break;
-        case OVSDB_DEL_INTERFACE:
-            _delete_interface(self, params, call->payload.del_interface.ifname);
-            break;
-        case OVSDB_SET_INTERFACE_MTU:
-            json_array_append_new(params,
-                                  json_pack("{s:s, s:s, s:{s: I}, s:[[s, s, s]]}",
-                                            "op",
-                                            "update",
-                                            "table",
-                                            "Interface",
-                                            "row",
-                                            "mtu_request",
-                                            (json_int_t) call->payload.set_interface_mtu.mtu,
-                                            "where",
-                                            "name",
-                                            "==",
-                                            call->payload.set_interface_mtu.ifname));
-            break;
-        case OVSDB_SET_REAPPLY:
-        {
-            NMConnection *connection;
-            json_t       *mutations;
-            json_t       *row;
-            const char   *table;
-
-            connection = call->payload.set_reapply.connection;
-            table      = _device_type_to_table(call->payload.set_reapply.device_type);
-
-            /* Reapply device properties */
-            switch (call->payload.set_reapply.device_type) {
-            case NM_DEVICE_TYPE_OVS_BRIDGE:
-                row = create_bridge_row_object(connection, TRUE);
-                break;
-            case NM_DEVICE_TYPE_OVS_PORT:
-                row = create_port_row_object(connection);
-                break;
-            default:
-                row = NULL;
-                break;
-            }
-
-            if (row) {
-                json_array_append_new(params,
-                                      json_pack("{s:s, s:s, s:o, s:[[s, s, s]]}",
-                                                "op",
-                                                "update",
-                                                "table",
-                                                table,
-                                                "row",
-                                                row,
-                                                "where",
-                                                "name",
-                                                "==",
-                                                call->payload.set_reapply.ifname));
+        _call_append_ops(self, call, params);
+
+        /* Coalesce the following queued calls that can be batched into the
+         * same transaction. Only the calls right after the first one are taken,
+         * so that the order of operations is preserved. */
+        if (_call_can_batch(call)) {
+            guint  n_batched = 1;
+            CList *iter;
+
+            for (iter = call->calls_lst.next;
+                 iter != &priv->calls_lst_head && n_batched < OVSDB_BATCH_MAX;
+                 iter = iter->next) {
+                OvsdbMethodCall *c = c_list_entry(iter, OvsdbMethodCall, calls_lst);
+
+                if (!_call_can_batch(c))
+                    break;
+                c->call_id = call->call_id;
+                _call_append_ops(self, c, params);
+                n_batched++;
             }
-
-            /* Reapply external-ids and other-config */
-            mutations = json_array();
-            _j_create_strv_array_update(mutations,
-                                        STRDICT_TYPE_EXTERNAL_IDS,
-                                        nm_connection_get_uuid(connection),
-                                        call->payload.set_reapply.external_ids_old,
-                                        call->payload.set_reapply.external_ids_new);
-            _j_create_strv_array_update(mutations,
-                                        STRDICT_TYPE_OTHER_CONFIG,
-                                        NULL,
-                                        call->payload.set_reapply.other_config_old,
-                                        call->payload.set_reapply.other_config_new);
-
-            json_array_append_new(params,
-                                  json_pack("{s:s, s:s, s:o, s:[[s, s, s]]}",
-                                            "op",
-                                            "mutate",
-                                            "table",
-                                            table,
-                                            "mutations",
-                                            mutations,
-                                            "where",
-                                            "name",
-                                            "==",
-                                            call->payload.set_reapply.ifname));
-            break;
-        }
-
-        default:
-            nm_assert_not_reached();
-            break;
+            if (n_batched > 1)
+                _LOGT_call(call, "batching %u calls into one transaction", n_batched);
         }
 
         msg = json_pack("{s:I, s:s, s:o}",
@@ -1948,6 +2127,7 @@ ovsdb_got_update(NMOvsdb *self, json_t *msg)
                                         ovs_interface->name,
                                         NM_DEVICE_TYPE_OVS_INTERFACE,
                                         ovs_interface->type);
+            _interface_by_name_remove(priv->interfaces_by_name, ovs_interface);
             _free_interface(ovs_interface);
             continue;
         }
@@ -1962,6 +2142,7 @@ ovsdb_got_update(NMOvsdb *self, json_t *msg)
                                         ovs_interface->name,
                                         NM_DEVICE_TYPE_OVS_INTERFACE,
                                         ovs_interface->type);
+            _interface_by_name_remove(priv->interfaces_by_name, ovs_interface);
             nm_clear_pointer(&ovs_interface, _free_interface);
         }
 
@@ -2016,6 +2197,7 @@ ovsdb_got_update(NMOvsdb *self, json_t *msg)
                 .other_config    = g_steal_pointer(&other_config_arr),
             };
             g_hash_table_add(priv->interfaces, ovs_interface);
+            g_hash_table_insert(priv->interfaces_by_name, ovs_interface->name, ovs_interface);
             _LOGT("monitor: %s: interface added: type=%s, obj[iface:%s]%s%s, external-ids=%s, "
                   "other-config=%s",
                   ovs_interface->name,
@@ -2080,6 +2262,7 @@ ovsdb_got_update(NMOvsdb *self, json_t *msg)
                                        ovs_port->connection_uuid,
                                        ""));
             _signal_emit_device_removed(self, ovs_port->name, NM_DEVICE_TYPE_OVS_PORT, NULL);
+            _parent_index_update(priv->port_by_interface, key, ovs_port->interfaces, NULL);
             _free_port(ovs_port);
             continue;
         }
@@ -2090,6 +2273,7 @@ ovsdb_got_update(NMOvsdb *self, json_t *msg)
             if (!g_hash_table_steal(priv->ports, ovs_port))
                 nm_assert_not_reached();
             _signal_emit_device_removed(self, ovs_port->name, NM_DEVICE_TYPE_OVS_PORT, NULL);
+            _parent_index_update(priv->port_by_interface, key, ovs_port->interfaces, NULL);
             nm_clear_pointer(&ovs_port, _free_port);
         }
 
@@ -2109,6 +2293,10 @@ ovsdb_got_update(NMOvsdb *self, json_t *msg)
             changed |= nm_strdup_reset(&ovs_port->connection_uuid, connection_uuid);
             if (nm_strv_ptrarray_cmp(ovs_port->interfaces, interfaces) != 0) {
                 NM_SWAP(&ovs_port->interfaces, &interfaces);
+                _parent_index_update(priv->port_by_interface,
+                                     key,
+                                     interfaces,
+                                     ovs_port->interfaces);
                 changed = TRUE;
             }
             if (!_strdict_equals(ovs_port->external_ids, external_ids_arr)) {
@@ -2148,6 +2336,7 @@ ovsdb_got_update(NMOvsdb *self, json_t *msg)
                 .other_config    = g_steal_pointer(&other_config_arr),
             };
             g_hash_table_add(priv->ports, ovs_port);
+            _parent_index_update(priv->port_by_interface, key, NULL, ovs_port->interfaces);
             _LOGT("monitor: %s: port added: obj[port:%s]%s%s, external-ids=%s, other-config=%s",
                   ovs_port->name,
                   key,
@@ -2202,6 +2391,7 @@ ovsdb_got_update(NMOvsdb *self, json_t *msg)
                                        ovs_bridge->connection_uuid,
                                        ""));
             _signal_emit_device_removed(self, ovs_bridge->name, NM_DEVICE_TYPE_OVS_BRIDGE, NULL);
+            _parent_index_update(priv->bridge_by_port, key, ovs_bridge->ports, NULL);
             _free_bridge(ovs_bridge);
             continue;
         }
@@ -2212,6 +2402,7 @@ ovsdb_got_update(NMOvsdb *self, json_t *msg)
             if (!g_hash_table_steal(priv->bridges, ovs_bridge))
                 nm_assert_not_reached();
             _signal_emit_device_removed(self, ovs_bridge->name, NM_DEVICE_TYPE_OVS_BRIDGE, NULL);
+            _parent_index_update(priv->bridge_by_port, key, ovs_bridge->ports, NULL);
             nm_clear_pointer(&ovs_bridge, _free_bridge);
         }
 
@@ -2231,6 +2422,7 @@ ovsdb_got_update(NMOvsdb *self, json_t *msg)
             changed = nm_strdup_reset(&ovs_bridge->connection_uuid, connection_uuid);
             if (nm_strv_ptrarray_cmp(ovs_bridge->ports, ports) != 0) {
                 NM_SWAP(&ovs_bridge->ports, &ports);
+                _parent_index_update(priv->bridge_by_port, key, ports, ovs_bridge->ports);
                 changed = TRUE;
             }
             if (!_strdict_equals(ovs_bridge->external_ids, external_ids_arr)) {
@@ -2270,6 +2462,7 @@ ovsdb_got_update(NMOvsdb *self, json_t *msg)
                 .other_config    = g_steal_pointer(&other_config_arr),
             };
             g_hash_table_add(priv->bridges, ovs_bridge);
+            _parent_index_update(priv->bridge_by_port, key, NULL, ovs_bridge->ports);
             _LOGT("monitor: %s: bridge added: obj[bridge:%s]%s%s, external-ids=%s, other-config=%s",
                   ovs_bridge->name,
                   key,
@@ -2284,6 +2477,283 @@ ovsdb_got_update(NMOvsdb *self, json_t *msg)
     }
 }
 
+static json_t *
+_json_object_get_or_add(json_t *object, const char *key)
+{
+    json_t *value;
+
+    value = json_object_get(object, key);
+    if (!value) {
+        value = json_object();
+        json_object_set_new(object, key, value);
+    }
+    return value;
+}
+
+static json_t *
+_monitor_set_elements(json_t *value)
+{
+    json_t *elements;
+
+    /* A set is either ["set", [atoms...]] or, with one element, the bare atom. */
+    if (json_is_array(value) && nm_streq0(json_string_value(json_array_get(value, 0)), "set")) {
+        elements = json_deep_copy(json_array_get(value, 1));
+        if (json_is_array(elements))
+            return elements;
+        json_decref(elements);
+        return json_array();
+    }
+
+    return json_pack("[O]", value);
+}
+
+static json_t *
+_monitor_set_apply_diff(json_t *value, json_t *diff)
+{
+    nm_auto_decref_json json_t *diff_elements = NULL;
+    json_t                     *elements;
+    json_t                     *element;
+    json_t                     *d;
+    size_t                      i;
+    size_t                      j;
+
+    /* The diff of a set column is the set of elements to toggle. */
+    elements      = _monitor_set_elements(value);
+    diff_elements = _monitor_set_elements(diff);
+
+    json_array_foreach (diff_elements, i, d) {
+        gboolean found = FALSE;
+
+        json_array_foreach (elements, j, element) {
+            if (json_equal(element, d)) {
+                json_array_remove(elements, j);
+                found = TRUE;
+                break;
+            }
+        }
+        if (!found)
+            json_array_append(elements, d);
+    }
+
+    if (json_array_size(elements) == 1) {
+        element = json_incref(json_array_get(elements, 0));
+        json_decref(elements);
+        return element;
+    }
+
+    return json_pack("[s, o]", "set", elements);
+}
+
+static json_t *
+_monitor_map_apply_diff(json_t *value, json_t *diff)
+{
+    json_t *pairs;
+    json_t *pair;
+    json_t *d;
+    size_t  i;
+    size_t  j;
+
+    pairs = json_deep_copy(json_array_get(value, 1));
+    if (!json_is_array(pairs)) {
+        json_decref(pairs);
+        pairs = json_array();
+    }
+
+    /* The diff of a map column contains the keys to add, the keys to
+     * remove (with their old value) and the keys with a new value. */
+    json_array_foreach (json_array_get(diff, 1), i, d) {
+        json_t  *key   = json_array_get(d, 0);
+        json_t  *val   = json_array_get(d, 1);
+        gboolean found = FALSE;
+
+        if (!key || !val)
+            continue;
+
+        json_array_foreach (pairs, j, pair) {
+            if (!json_equal(json_array_get(pair, 0), key))
+                continue;
+            if (json_equal(json_array_get(pair, 1), val))
+                json_array_remove(pairs, j);
+            else
+                json_array_set(pair, 1, val);
+            found = TRUE;
+            break;
+        }
+        if (!found)
+            json_array_append_new(pairs, json_pack("[O, O]", key, val));
+    }
+
+    return json_pack("[s, o]", "map", pairs);
+}
+
+static json_t *
+_monitor_row_new(const OvsdbMonitorTable *table, json_t *row2)
+{
+    json_t *row;
+    gsize   j;
+
+    row = json_is_object(row2) ? json_deep_copy(row2) : json_object();
+
+    /* "update2" omits the columns that have their default value. */
+    for (j = 0; table->columns[j].name; j++) {
+        json_t *value;
+
+        if (json_object_get(row, table->columns[j].name))
+            continue;
+
+        switch (table->columns[j].type) {
+        case OVSDB_COLUMN_STRING:
+            value = json_string("");
+            break;
+        case OVSDB_COLUMN_SET:
+            value = json_pack("[s, []]", "set");
+            break;
+        case OVSDB_COLUMN_MAP:
+        default:
+            value = json_pack("[s, []]", "map");
+            break;
+        }
+        json_object_set_new(row, table->columns[j].name, value);
+    }
+
+    return row;
+}
+
+static void
+_monitor_row_apply_diff(const OvsdbMonitorTable *table, json_t *row, json_t *diff)
+{
+    gsize j;
+
+    for (j = 0; table->columns[j].name; j++) {
+        const char *name = table->columns[j].name;
+        json_t     *d;
+        json_t     *value;
+
+        d = json_object_get(diff, name);
+        if (!d)
+            continue;
+
+        switch (table->columns[j].type) {
+        case OVSDB_COLUMN_SET:
+            value = _monitor_set_apply_diff(json_object_get(row, name), d);
+            break;
+        case OVSDB_COLUMN_MAP:
+            value = _monitor_map_apply_diff(json_object_get(row, name), d);
+            break;
+        case OVSDB_COLUMN_STRING:
+        default:
+            value = json_incref(d);
+            break;
+        }
+        json_object_set_new(row, name, value);
+    }
+}
+
+/**
+ * ovsdb_got_update2:
+ * @self: the #NMOvsdb
+ * @updates: the "table-updates2" of a "monitor_cond_since" reply or of an
+ *   "update3" notification
+ * @full: whether @updates is a full dump of the database. Rows that we have
+ *   cached but that are not part of it were deleted while we were not
+ *   connected.
+ *
+ * Unlike "update", the "update2" format only contains the changed columns
+ * of modified rows. Apply it to our cache of rows and pass the resulting
+ * rows on to ovsdb_got_update().
+ */
+static void
+ovsdb_got_update2(NMOvsdb *self, json_t *updates, gboolean full)
+{
+    NMOvsdbPrivate             *priv     = NM_OVSDB_GET_PRIVATE(self);
+    nm_auto_decref_json json_t *old_rows = NULL;
+    nm_auto_decref_json json_t *update   = NULL;
+    json_t                     *table_updates;
+    json_t                     *table_rows;
+    json_t                     *row_update;
+    json_t                     *ovs_update;
+    json_t                     *row;
+    const char                 *table_name;
+    const char                 *uuid;
+
+    if (full || !priv->monitor.rows) {
+        old_rows           = g_steal_pointer(&priv->monitor.rows);
+        priv->monitor.rows = json_object();
+    }
+
+    update = json_object();
+
+    json_object_foreach (updates, table_name, table_updates) {
+        const OvsdbMonitorTable *table;
+        json_t                  *table_update;
+
+        table = _monitor_table_find(table_name);
+        if (!table)
+            continue;
+
+        table_rows   = _json_object_get_or_add(priv->monitor.rows, table_name);
+        table_update = _json_object_get_or_add(update, table_name);
+
+        json_object_foreach (table_updates, uuid, row_update) {
+            json_t *value;
+
+            if ((value = json_object_get(row_update, "initial"))
+                || (value = json_object_get(row_update, "insert"))) {
+                row = _monitor_row_new(table, value);
+                json_object_set_new(table_rows, uuid, row);
+            } else if ((value = json_object_get(row_update, "modify"))) {
+                row = json_object_get(table_rows, uuid);
+                if (!row) {
+                    _LOGD("monitor: %s: modify for unknown row %s", table_name, uuid);
+                    continue;
+                }
+                _monitor_row_apply_diff(table, row, value);
+            } else if (json_object_get(row_update, "delete")) {
+                json_object_del(table_rows, uuid);
+                json_object_set_new(table_update, uuid, json_pack("{s:{}}", "old"));
+                continue;
+            } else
+                continue;
+
+            json_object_set_new(table_update, uuid, json_pack("{s:O}", "new", row));
+        }
+    }
+
+    json_object_foreach (old_rows, table_name, table_rows) {
+        json_t *new_table_rows = json_object_get(priv->monitor.rows, table_name);
+
+        json_object_foreach (table_rows, uuid, row) {
+            if (json_object_get(new_table_rows, uuid))
+                continue;
+            json_object_set_new(_json_object_get_or_add(update, table_name),
+                                uuid,
+                                json_pack("{s:{}}", "old"));
+        }
+    }
+
+    /* ovsdb_got_update() takes the database UUID from the Open_vSwitch
+     * table, which is only part of the update when the row changed. */
+    ovs_update = json_object();
+    json_object_foreach (json_object_get(priv->monitor.rows, "Open_vSwitch"), uuid, row)
+        json_object_set_new(ovs_update, uuid, json_pack("{s:O}", "new", row));
+    json_object_set_new(update, "Open_vSwitch", ovs_update);
+
+    ovsdb_got_update(self, update);
+}
+
+static gboolean
+_transact_result_has_error(json_t *result)
+{
+    json_t *value;
+    size_t  index;
+
+    json_array_foreach (result, index, value) {
+        if (json_object_get(value, "error"))
+            return TRUE;
+    }
+    return FALSE;
+}
+
 /**
  * ovsdb_got_echo:
  *
@@ -2361,6 +2831,12 @@ ovsdb_got_msg(NMOvsdb *self, json_t *msg)
         if (nm_streq0(method, "update")) {
             /* This is a update method call. */
             ovsdb_got_update(self, json_array_get(params, 1));
+        } else if (nm_streq0(method, "update3")) {
+            /* An update for "monitor_cond_since", the params are
+             * [json-value, last-txn-id, table-updates2]. */
+            nm_strdup_reset(&priv->monitor.last_txn_id,
+                            json_string_value(json_array_get(params, 1)));
+            ovsdb_got_update2(self, json_array_get(params, 2), FALSE);
         } else if (nm_streq0(method, "echo")) {
             /* This is an echo request. */
             ovsdb_got_echo(self, id, params);
@@ -2372,6 +2848,7 @@ ovsdb_got_msg(NMOvsdb *self, json_t *msg)
 
     if (id >= 0) {
         OvsdbMethodCall      *call;
+        OvsdbMethodCall      *next;
         gs_free_error GError *local      = NULL;
         gs_free char         *msg_as_str = NULL;
 
@@ -2402,7 +2879,28 @@ ovsdb_got_msg(NMOvsdb *self, json_t *msg)
                         json_string_value(error));
         }
 
-        _call_complete(call, result, local);
+        next = c_list_entry(call->calls_lst.next, OvsdbMethodCall, calls_lst);
+        if (&next->calls_lst != &priv->calls_lst_head && next->call_id == call->call_id
+            && (local || _transact_result_has_error(result))) {
+            /* A transaction is atomic, so a failure of one of the batched calls
+             * also aborted the others. Retry them one by one to find out which
+             * call actually failed. */
+            _LOGD("batched transaction failed, retrying the calls individually");
+            c_list_for_each_entry (call, &priv->calls_lst_head, calls_lst) {
+                if (call->call_id != (guint64) id)
+                    break;
+                call->call_id  = CALL_ID_UNSPEC;
+                call->no_batch = TRUE;
+            }
+            ovsdb_next_command(self);
+            return;
+        }
+
+        /* Each of the batched calls gets the entire result. */
+        do {
+            _call_complete(call, result, local);
+            call = c_list_first_entry(&priv->calls_lst_head, OvsdbMethodCall, calls_lst);
+        } while (call && call->call_id == (guint64) id);
 
         priv->num_failures = 0;
 
@@ -2423,60 +2921,100 @@ ovsdb_got_msg(NMOvsdb *self, json_t *msg)
 
 /*****************************************************************************/
 
-typedef struct {
-    gsize     bufp;
-    NMStrBuf *input;
-} JsonReadMsgData;
-
 /* Lower level marshalling and demarshalling of the JSON-RPC traffic on the
  * ovsdb socket. */
 
-static size_t
-_json_read_msg_cb(void *buffer, size_t buflen, void *user_data)
+static void
+_json_scan_reset(NMOvsdbPrivate *priv)
 {
-    JsonReadMsgData *data = user_data;
+    memset(&priv->input_scan, 0, sizeof(priv->input_scan));
+}
 
-    nm_assert(buffer);
-    nm_assert(buflen > 0);
+/**
+ * _json_scan_msg:
+ *
+ * Finds the end of the next JSON message in the input buffer. The scan state
+ * is kept across calls, so that each byte is only looked at once while a
+ * large message arrives in many chunks.
+ *
+ * Returns: the length of the complete message, 0 if the message is not yet
+ *   complete, or -1 if the input is not a JSON object or array.
+ */
+static gssize
+_json_scan_msg(NMOvsdbPrivate *priv)
+{
+    const char *buf;
+    gsize       i;
 
-    if (data->bufp == data->input->len) {
-        /* No more bytes buffered for decoding. */
+    if (priv->input_buf.len == 0)
         return 0;
+
+    buf = nm_str_buf_get_str_at_unsafe(&priv->input_buf, 0);
+
+    for (i = priv->input_scan.pos; i < priv->input_buf.len; i++) {
+        const char ch = buf[i];
+
+        if (priv->input_scan.in_string) {
+            if (priv->input_scan.escaped)
+                priv->input_scan.escaped = FALSE;
+            else if (ch == '\\')
+                priv->input_scan.escaped = TRUE;
+            else if (ch == '"')
+                priv->input_scan.in_string = FALSE;
+            continue;
+        }
+
+        switch (ch) {
+        case '{':
+        case '[':
+            priv->input_scan.depth++;
+            break;
+        case '}':
+        case ']':
+            if (priv->input_scan.depth == 0)
+                return -1;
+            if (--priv->input_scan.depth == 0) {
+                _json_scan_reset(priv);
+                return i + 1;
+            }
+            break;
+        case '"':
+            if (priv->input_scan.depth == 0)
+                return -1;
+            priv->input_scan.in_string = TRUE;
+            break;
+        default:
+            if (priv->input_scan.depth == 0 && !g_ascii_isspace(ch))
+                return -1;
+            break;
+        }
     }
 
-    /* Pass one more byte to the JSON decoder. */
-    *(char *) buffer = nm_str_buf_get_char(data->input, data->bufp);
-    data->bufp++;
-    return 1;
+    priv->input_scan.pos = i;
+    return 0;
 }
 
 static json_t *
-_json_read_msg(NMOvsdb *self, NMStrBuf *input)
+_json_read_msg(NMOvsdb *self, gsize len)
 {
-    gs_free char   *ss   = NULL;
-    JsonReadMsgData data = {
-        .bufp  = 0,
-        .input = input,
-    };
-    json_error_t json_error = {
+    NMOvsdbPrivate *priv       = NM_OVSDB_GET_PRIVATE(self);
+    gs_free char   *ss         = NULL;
+    json_error_t    json_error = {
         0,
     };
     json_t *msg;
 
-    /* The callback always eats up only up to a single byte. This makes it
-     * possible for us to identify complete JSON objects in spite of us not
-     * knowing the length in advance. */
-    msg = json_load_callback(_json_read_msg_cb, &data, JSON_DISABLE_EOF_CHECK, &json_error);
-    if (!msg)
+    msg = json_loadb(nm_str_buf_get_str_at_unsafe(&priv->input_buf, 0), len, 0, &json_error);
+    if (!msg) {
+        _LOGD("json: failure to parse %zu bytes: %s", len, json_error.text);
         return NULL;
-
-    nm_assert(data.bufp > 0);
+    }
 
     _LOGT("json: parse %zu bytes: \"%s\"",
-          data.bufp,
-          (ss = g_strndup(nm_str_buf_get_str_at_unsafe(input, 0), data.bufp)));
+          len,
+          (ss = g_strndup(nm_str_buf_get_str_at_unsafe(&priv->input_buf, 0), len)));
 
-    nm_str_buf_erase(input, 0, data.bufp, FALSE);
+    nm_str_buf_erase(&priv->input_buf, 0, len, FALSE);
     return msg;
 }
 
@@ -2508,7 +3046,7 @@ again:
             else if (!priv->input_timeout_source) {
                 /* We have data in the buffer but nothing further to read. Schedule a timer,
                  * if we don't get the rest within timeout, it means that the buffer
-                 * content is broken (_json_read_msg() cannot extract any data) and
+                 * content is broken (the message never completes) and
                  * we disconnect. */
                 priv->input_timeout_source =
                     nm_g_timeout_add_seconds_source(5, _ovsdb_read_input_timeout_cb, self);
@@ -2527,11 +3065,21 @@ again:
 
     while (TRUE) {
         nm_auto_decref_json json_t *msg = NULL;
+        gssize                      len;
 
-        msg = _json_read_msg(self, &priv->input_buf);
-        if (!msg)
+        len = _json_scan_msg(priv);
+        if (len == 0)
             break;
 
+        if (len > 0)
+            msg = _json_read_msg(self, len);
+        if (!msg) {
+            _LOGW("received invalid JSON from ovsdb");
+            priv->num_failures++;
+            ovsdb_disconnect(self, priv->num_failures <= OVSDB_MAX_FAILURES, FALSE);
+            return;
+        }
+
         nm_clear_g_source_inst(&priv->input_timeout_source);
         ovsdb_got_msg(self, msg);
 
@@ -2645,8 +3193,11 @@ ovsdb_disconnect(NMOvsdb *self, gboolean retry, gboolean is_disposing)
      * shutting down, and cancel the remaining calls after the timeout. */
 
     if (retry) {
-        if (!c_list_is_empty(&priv->calls_lst_head)) {
-            call          = c_list_first_entry(&priv->calls_lst_head, OvsdbMethodCall, calls_lst);
+        /* The calls in flight (possibly several batched into one transaction)
+         * are at the head of the queue. Send them again. */
+        c_list_for_each_entry (call, &priv->calls_lst_head, calls_lst) {
+            if (call->call_id == CALL_ID_UNSPEC)
+                break;
             call->call_id = CALL_ID_UNSPEC;
         }
     } else {
@@ -2662,6 +3213,7 @@ ovsdb_disconnect(NMOvsdb *self, gboolean retry, gboolean is_disposing)
 
     nm_str_buf_reset(&priv->input_buf);
     nm_str_buf_reset(&priv->output_buf);
+    _json_scan_reset(priv);
     nm_clear_fd(&priv->conn_fd);
     nm_clear_g_source_inst(&priv->conn_fd_in_source);
     nm_clear_g_source_inst(&priv->conn_fd_out_source);
@@ -2844,7 +3396,25 @@ ovsdb_cleanup_initial_interfaces(NMOvsdb *self)
 static void
 _monitor_bridges_cb(NMOvsdb *self, json_t *result, GError *error, gpointer user_data)
 {
+    NMOvsdbPrivate *priv = NM_OVSDB_GET_PRIVATE(self);
+
     if (error) {
+        if (!priv->monitor.cond_since_unsupported
+            && g_error_matches(error, G_IO_ERROR, G_IO_ERROR_FAILED)) {
+            /* The server rejected "monitor_cond_since", it was only added in
+             * Open vSwitch 2.12. Fall back to a plain "monitor". */
+            _LOGD("monitor: %s. Falling back to \"monitor\"", error->message);
+            priv->monitor.cond_since_unsupported = TRUE;
+            nm_clear_pointer(&priv->monitor.rows, json_decref);
+            nm_clear_g_free(&priv->monitor.last_txn_id);
+            ovsdb_call_method(self,
+                              _monitor_bridges_cb,
+                              NULL,
+                              TRUE,
+                              OVSDB_MONITOR,
+                              OVSDB_METHOD_PAYLOAD_MONITOR());
+            return;
+        }
         if (!nm_utils_error_is_cancelled_or_disposing(error)) {
             _LOGI("%s", error->message);
             ovsdb_disconnect(self, FALSE, FALSE);
@@ -2852,9 +3422,19 @@ _monitor_bridges_cb(NMOvsdb *self, json_t *result, GError *error, gpointer user_
         return;
     }
 
-    /* Treat the first response the same as the subsequent "update"
-     * messages we eventually get. */
-    ovsdb_got_update(self, result);
+    if (json_is_array(result)) {
+        /* The reply to "monitor_cond_since" is [found, last-txn-id, table-updates2].
+         * Unless the server found our last transaction, it is a full dump. */
+        nm_strdup_reset(&priv->monitor.last_txn_id,
+                        json_string_value(json_array_get(result, 1)));
+        ovsdb_got_update2(self,
+                          json_array_get(result, 2),
+                          !json_is_true(json_array_get(result, 0)));
+    } else {
+        /* Treat the first response the same as the subsequent "update"
+         * messages we eventually get. */
+        ovsdb_got_update(self, result);
+    }
 
     ovsdb_cleanup_initial_interfaces(self);
 }
@@ -3145,6 +3725,9 @@ nm_ovsdb_init(NMOvsdb *self)
         g_hash_table_new_full(nm_pstr_hash, nm_pstr_equal, (GDestroyNotify) _free_port, NULL);
     priv->interfaces =
         g_hash_table_new_full(nm_pstr_hash, nm_pstr_equal, (GDestroyNotify) _free_interface, NULL);
+    priv->interfaces_by_name = g_hash_table_new(nm_str_hash, g_str_equal);
+    priv->port_by_interface  = g_hash_table_new_full(nm_str_hash, g_str_equal, g_free, g_free);
+    priv->bridge_by_port     = g_hash_table_new_full(nm_str_hash, g_str_equal, g_free, g_free);
 
     ovsdb_try_connect(self);
 }
@@ -3163,9 +3746,14 @@ dispose(GObject *object)
     nm_str_buf_destroy(&priv->output_buf);
 
     g_clear_object(&priv->platform);
+    nm_clear_pointer(&priv->interfaces_by_name, g_hash_table_destroy);
+    nm_clear_pointer(&priv->port_by_interface, g_hash_table_destroy);
+    nm_clear_pointer(&priv->bridge_by_port, g_hash_table_destroy);
     nm_clear_pointer(&priv->bridges, g_hash_table_destroy);
     nm_clear_pointer(&priv->ports, g_hash_table_destroy);
     nm_clear_pointer(&priv->interfaces, g_hash_table_destroy);
+    nm_clear_pointer(&priv->monitor.rows, json_decref);
+    nm_clear_g_free(&priv->monitor.last_txn_id);
 
     G_OBJECT_CLASS(nm_ovsdb_parent_class)->dispose(object);
 }
@@ -1134,6 +1134,9 @@ nm_device_team_class_init(NMDeviceTeamClass *klass)
     device_class->update_connection                 = update_connection;
     device_class->controller_update_port_connection = controller_update_port_connection;
 
+    /* the configuration comes from teamd. */
+    device_class->update_connection_uses_external_state = TRUE;
+
     device_class->act_stage1_prepare_also_for_external_or_assume = TRUE;
     device_class->act_stage1_prepare                             = act_stage1_prepare;
     device_class->get_configured_mtu = nm_device_get_configured_mtu_for_wired;
@@ -451,7 +451,7 @@ periodic_update(NMDeviceIwd *self)
         return;
     }
 
-    if (nm_wifi_ap_set_strength(priv->current_ap, (gint8) percent)) {
+    if (nm_wifi_ap_update_strength(priv->current_ap, (gint8) percent)) {
 #if NM_MORE_LOGGING
         ap_changed = TRUE;
 #endif
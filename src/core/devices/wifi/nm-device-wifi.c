@@ -109,6 +109,9 @@ typedef struct {
     guint ap_dump_id;
 
     guint periodic_update_id;
+    guint wifi_event_idle_id;
+
+    gulong platform_wifi_event_id;
 
     guint link_timeout_id;
     guint reacquire_iface_id;
@@ -812,7 +815,7 @@ periodic_update(NMDeviceWifi *self)
                                         NULL,
                                         &percent,
                                         &new_rate)) {
-        if (nm_wifi_ap_set_strength(priv->current_ap, (gint8) percent)) {
+        if (nm_wifi_ap_update_strength(priv->current_ap, (gint8) percent)) {
 #if NM_MORE_LOGGING
             _ap_dump(self, LOGL_TRACE, priv->current_ap, "updated", 0);
 #endif
@@ -832,6 +835,40 @@ periodic_update_cb(gpointer user_data)
     return TRUE;
 }
 
+static gboolean
+wifi_event_idle_cb(gpointer user_data)
+{
+    NMDeviceWifi        *self = user_data;
+    NMDeviceWifiPrivate *priv = NM_DEVICE_WIFI_GET_PRIVATE(self);
+
+    priv->wifi_event_idle_id = 0;
+
+    /* The link quality was just refreshed, postpone the next poll. */
+    if (priv->periodic_update_id) {
+        nm_clear_g_source(&priv->periodic_update_id);
+        priv->periodic_update_id = g_timeout_add_seconds(6, periodic_update_cb, self);
+    }
+
+    periodic_update(self);
+    return G_SOURCE_REMOVE;
+}
+
+static void
+platform_wifi_event_cb(NMPlatform *platform, int ifindex, NMDeviceWifi *self)
+{
+    NMDeviceWifiPrivate *priv = NM_DEVICE_WIFI_GET_PRIVATE(self);
+
+    if (ifindex != nm_device_get_ifindex(NM_DEVICE(self)))
+        return;
+
+    /* nl80211 reported a roam, a connection quality change or new scan
+     * results. Refresh once for a burst of events. */
+    if (!priv->periodic_update_id || priv->wifi_event_idle_id)
+        return;
+
+    priv->wifi_event_idle_id = g_idle_add(wifi_event_idle_cb, self);
+}
+
 static void
 ap_add_remove(NMDeviceWifi *self,
               gboolean      is_adding, /* or else removing */
@@ -970,6 +1007,7 @@ deactivate(NMDevice *device)
     int                  ifindex = nm_device_get_ifindex(device);
 
     nm_clear_g_source(&priv->periodic_update_id);
+    nm_clear_g_source(&priv->wifi_event_idle_id);
     nm_clear_g_source_inst(&priv->roam_supplicant_wait_source);
 
     cleanup_association_attempt(self, TRUE);
@@ -3609,6 +3647,7 @@ device_state_changed(NMDevice           *device,
         supplicant_interface_release(self);
 
         nm_clear_g_source(&priv->periodic_update_id);
+        nm_clear_g_source(&priv->wifi_event_idle_id);
 
         cleanup_association_attempt(self, TRUE);
         cleanup_supplicant_failures(self);
@@ -3854,6 +3893,11 @@ constructed(GObject *object)
 
     /* Connect to the supplicant manager */
     priv->sup_mgr = g_object_ref(nm_supplicant_manager_get());
+
+    priv->platform_wifi_event_id = g_signal_connect(nm_device_get_platform(NM_DEVICE(self)),
+                                                    NM_PLATFORM_SIGNAL_WIFI_EVENT,
+                                                    G_CALLBACK(platform_wifi_event_cb),
+                                                    self);
 }
 
 NMDevice *
@@ -3881,7 +3925,11 @@ dispose(GObject *object)
 
     nm_assert(c_list_is_empty(&priv->scanning_prohibited_lst_head));
 
+    nm_clear_g_signal_handler(nm_device_get_platform(NM_DEVICE(self)),
+                              &priv->platform_wifi_event_id);
+
     nm_clear_g_source(&priv->periodic_update_id);
+    nm_clear_g_source(&priv->wifi_event_idle_id);
     nm_clear_g_source_inst(&priv->roam_supplicant_wait_source);
 
     wifi_secrets_cancel(self);
@@ -25,6 +25,9 @@
 #define PROTO_WPA "wpa"
 #define PROTO_RSN "rsn"
 
+/* Strength changes smaller than this (in percent) are not reported. */
+#define STRENGTH_HYSTERESIS 5
+
 /*****************************************************************************/
 
 NM_GOBJECT_PROPERTIES_DEFINE(NMWifiAP,
@@ -249,6 +252,28 @@ nm_wifi_ap_set_strength(NMWifiAP *ap, gint8 strength)
     return FALSE;
 }
 
+/**
+ * nm_wifi_ap_update_strength:
+ * @ap: the #NMWifiAP
+ * @strength: the newly measured strength
+ *
+ * Like nm_wifi_ap_set_strength(), but ignores small fluctuations of the
+ * measured signal, which would otherwise notify D-Bus clients on every
+ * scan or station poll.
+ *
+ * Returns: whether the strength was changed.
+ */
+gboolean
+nm_wifi_ap_update_strength(NMWifiAP *ap, gint8 strength)
+{
+    NMWifiAPPrivate *priv = NM_WIFI_AP_GET_PRIVATE(ap);
+
+    if (ABS((int) priv->strength - (int) strength) < STRENGTH_HYSTERESIS)
+        return FALSE;
+
+    return nm_wifi_ap_set_strength(ap, strength);
+}
+
 guint32
 nm_wifi_ap_get_freq(NMWifiAP *ap)
 {
@@ -410,7 +435,7 @@ nm_wifi_ap_update_from_properties(NMWifiAP *ap, const NMSupplicantBssInfo *bss_i
 
     changed |= nm_wifi_ap_set_flags(ap, bss_info->ap_flags);
     changed |= nm_wifi_ap_set_mode(ap, bss_info->mode);
-    changed |= nm_wifi_ap_set_strength(ap, bss_info->signal_percent);
+    changed |= nm_wifi_ap_update_strength(ap, bss_info->signal_percent);
     changed |= nm_wifi_ap_set_freq(ap, bss_info->frequency);
     changed |= nm_wifi_ap_set_ssid(ap, bss_info->ssid);
 
@@ -86,6 +86,7 @@ typedef struct _NMDhcpClientPrivate {
 
     GSource *previous_lease_timeout_source;
     GSource *no_lease_timeout_source;
+    GSource *start_delay_source;
     GSource *watch_source;
     GBytes  *effective_client_id;
 
@@ -781,10 +782,11 @@ _nm_dhcp_client_accept_offer(NMDhcpClient *self, gconstpointer p_yiaddr)
     return FALSE;
 }
 
-void
-_nm_dhcp_client_notify(NMDhcpClient         *self,
-                       NMDhcpClientEventType client_event_type,
-                       const NML3ConfigData *l3cd)
+static void
+_dhcp_client_notify(NMDhcpClient         *self,
+                    NMDhcpClientEventType client_event_type,
+                    const NML3ConfigData *l3cd,
+                    gboolean              renewed)
 {
     NMDhcpClientPrivate                     *priv = NM_DHCP_CLIENT_GET_PRIVATE(self);
     GHashTable                              *options;
@@ -931,9 +933,27 @@ _nm_dhcp_client_notify(NMDhcpClient         *self,
                  .lease_update = {
                      .l3cd     = priv->l3cd_curr,
                      .accepted = !priv->l3cfg_notify.wait_dhcp_commit,
+                     .renewed  = renewed,
                  });
 }
 
+void
+_nm_dhcp_client_notify(NMDhcpClient         *self,
+                       NMDhcpClientEventType client_event_type,
+                       const NML3ConfigData *l3cd)
+{
+    _dhcp_client_notify(self, client_event_type, l3cd, FALSE);
+}
+
+/* Like _nm_dhcp_client_notify() with NM_DHCP_CLIENT_EVENT_TYPE_EXTENDED, but
+ * the plugin indicates that the server extended the current lease without
+ * changing anything but the lifetimes. */
+void
+_nm_dhcp_client_notify_renewed(NMDhcpClient *self, const NML3ConfigData *l3cd)
+{
+    _dhcp_client_notify(self, NM_DHCP_CLIENT_EVENT_TYPE_EXTENDED, l3cd, TRUE);
+}
+
 static void
 daemon_watch_cb(GPid pid, int status, gpointer user_data)
 {
@@ -1365,6 +1385,24 @@ _previous_lease_timeout_cb(gpointer user_data)
     return G_SOURCE_CONTINUE;
 }
 
+static gboolean
+_start_delay_timeout_cb(gpointer user_data)
+{
+    NMDhcpClient         *self  = user_data;
+    NMDhcpClientPrivate  *priv  = NM_DHCP_CLIENT_GET_PRIVATE(self);
+    gs_free_error GError *error = NULL;
+
+    nm_clear_g_source_inst(&priv->start_delay_source);
+    if (!nm_dhcp_client_start(self, &error)) {
+        _LOGW("failed to start the DHCP client after delay: %s", error->message);
+        _emit_notify(self,
+                     NM_DHCP_CLIENT_NOTIFY_TYPE_IT_LOOKS_BAD,
+                     .it_looks_bad.reason = error->message);
+    }
+
+    return G_SOURCE_CONTINUE;
+}
+
 gboolean
 nm_dhcp_client_start(NMDhcpClient *self, GError **error)
 {
@@ -1382,6 +1420,17 @@ nm_dhcp_client_start(NMDhcpClient *self, GError **error)
 
     priv->is_stopped = FALSE;
 
+    if (priv->config.start_delay_msec > 0) {
+        /* Only delay the first start. Restarts happen at different times
+         * for each client anyway. */
+        _LOGD("delay start by %u msec", priv->config.start_delay_msec);
+        nm_clear_g_source_inst(&priv->start_delay_source);
+        priv->start_delay_source =
+            nm_g_timeout_add_source(priv->config.start_delay_msec, _start_delay_timeout_cb, self);
+        priv->config.start_delay_msec = 0;
+        return TRUE;
+    }
+
     IS_IPv4 = NM_IS_IPv4(priv->config.addr_family);
 
     if (!IS_IPv4) {
@@ -1542,6 +1591,7 @@ nm_dhcp_client_stop(NMDhcpClient *self, gboolean release)
 
     nm_clear_pointer(&priv->effective_client_id, g_bytes_unref);
     nm_clear_g_source_inst(&priv->previous_lease_timeout_source);
+    nm_clear_g_source_inst(&priv->start_delay_source);
     if (priv->config.addr_family == AF_INET)
         nm_clear_g_source_inst(&priv->v4.ipv6_only_restart_source);
 
@@ -2055,6 +2105,7 @@ dispose(GObject *object)
 
     nm_clear_g_source_inst(&priv->previous_lease_timeout_source);
     nm_clear_g_source_inst(&priv->no_lease_timeout_source);
+    nm_clear_g_source_inst(&priv->start_delay_source);
 
     if (priv->config.addr_family == AF_INET) {
         nm_clear_g_source_inst(&priv->v4.ipv6_only_restart_source);
@@ -75,6 +75,8 @@ typedef struct {
              * previous lease, that was injected. */
             const NML3ConfigData *l3cd;
             bool                  accepted;
+            /* The lease was extended and only the lifetimes changed. */
+            bool                  renewed;
         } lease_update;
         struct {
             const NMPlatformIP6Address *prefix;
@@ -118,6 +120,10 @@ typedef struct {
     /* Timeout in seconds before reporting failure */
     guint32 timeout;
 
+    /* Delay in milliseconds before the client starts. Used by the
+     * DHCP manager to stagger many clients starting at once. */
+    guint32 start_delay_msec;
+
     /* Flags for the hostname and FQDN DHCP options */
     NMDhcpHostnameFlags hostname_flags;
 
@@ -267,6 +273,8 @@ void _nm_dhcp_client_notify(NMDhcpClient         *self,
                             NMDhcpClientEventType client_event_type,
                             const NML3ConfigData *l3cd);
 
+void _nm_dhcp_client_notify_renewed(NMDhcpClient *self, const NML3ConfigData *l3cd);
+
 gboolean _nm_dhcp_client_accept_offer(NMDhcpClient *self, gconstpointer p_yiaddr);
 
 gboolean nm_dhcp_client_handle_event(gpointer               unused,
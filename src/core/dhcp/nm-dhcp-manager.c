@@ -25,6 +25,10 @@
 
 typedef struct {
     const NMDhcpClientFactory *client_factory;
+
+    /* With "dhcp-start-rate", the earliest time at which the next
+     * client may start. */
+    gint64 start_next_msec;
 } NMDhcpManagerPrivate;
 
 struct _NMDhcpManager {
@@ -158,6 +162,35 @@ _client_factory_get_gtype(const NMDhcpClientFactory *client_factory, int addr_fa
 
 /*****************************************************************************/
 
+static guint32
+_start_delay_get(NMDhcpManager *self)
+{
+    NMDhcpManagerPrivate *priv = NM_DHCP_MANAGER_GET_PRIVATE(self);
+    gint64                rate;
+    gint64                now_msec;
+    gint64                start_msec;
+
+    /* When many devices come up at the same time (for example, after the
+     * switch they are connected to restarts), all their DHCP clients start
+     * together. Limit how many clients start per second, and delay the
+     * others to the next free slot. */
+    rate = nm_config_data_get_value_int64(NM_CONFIG_GET_DATA,
+                                          NM_CONFIG_KEYFILE_GROUP_MAIN,
+                                          NM_CONFIG_KEYFILE_KEY_MAIN_DHCP_START_RATE,
+                                          10,
+                                          0,
+                                          1000,
+                                          0);
+    if (rate == 0)
+        return 0;
+
+    now_msec              = nm_utils_get_monotonic_timestamp_msec();
+    start_msec            = NM_MAX(now_msec, priv->start_next_msec);
+    priv->start_next_msec = start_msec + (1000 / rate);
+
+    return start_msec - now_msec;
+}
+
 NMDhcpClient *
 nm_dhcp_manager_start_client(NMDhcpManager *self, NMDhcpClientConfig *config, GError **error)
 {
@@ -203,6 +236,8 @@ nm_dhcp_manager_start_client(NMDhcpManager *self, NMDhcpClientConfig *config, GE
           nm_utils_addr_family_to_char(config->addr_family),
           g_type_name(gtype));
 
+    config->start_delay_msec = _start_delay_get(self);
+
     client = g_object_new(gtype, NM_DHCP_CLIENT_CONFIG, config, NULL);
 
     /* unfortunately, our implementations work differently per address-family regarding client-id/DUID.
@@ -58,10 +58,26 @@ typedef struct {
         const NML3ConfigData *lease_l3cd;
     } granted;
 
+    struct {
+        /* The configuration of the last lease that we reported, and a hash
+         * of the lease it was created from. See lease_hash(). */
+        const NML3ConfigData *l3cd;
+        guint64               options_hash;
+    } bound;
+
     GSource *pop_all_events_on_idle_source;
 
     GSource *event_source;
     char    *lease_file;
+
+    struct {
+        /* The content of the lease file that is currently being written, or that
+         * was written last. */
+        char *content_sent;
+        /* The content to write after the currently running write completes. */
+        char *content_queued;
+        bool  writing : 1;
+    } lease_save;
 } NMDhcpNettoolsPrivate;
 
 struct _NMDhcpNettools {
@@ -189,6 +205,60 @@ lease_get_ipv6_only_wait_time(NDhcp4ClientLease *lease, guint32 *out_val, const
     return FALSE;
 }
 
+static void
+lease_parse_lifetime(NDhcp4ClientLease *lease,
+                     guint32           *out_timestamp,
+                     guint32           *out_lifetime,
+                     guint64           *out_expiry)
+{
+    guint64 nettools_lifetime;
+    guint64 nettools_basetime;
+    guint64 lifetime;
+    gint64  ts;
+
+    n_dhcp4_client_lease_get_lifetime(lease, &nettools_lifetime);
+
+    if (nettools_lifetime == G_MAXUINT64) {
+        *out_timestamp = 0;
+        *out_lifetime  = NM_PLATFORM_LIFETIME_PERMANENT;
+        *out_expiry    = G_MAXUINT64;
+        return;
+    }
+
+    n_dhcp4_client_lease_get_basetime(lease, &nettools_basetime);
+
+    /* usually we shouldn't assert against external libraries like n-dhcp4.
+     * Here we still do it... it seems safe enough. */
+    nm_assert(nettools_basetime > 0);
+    nm_assert(nettools_lifetime >= nettools_basetime);
+    nm_assert(((nettools_lifetime - nettools_basetime) % NM_UTILS_NSEC_PER_SEC) == 0);
+    nm_assert((nettools_lifetime - nettools_basetime) / NM_UTILS_NSEC_PER_SEC <= G_MAXUINT32);
+
+    if (nettools_lifetime <= nettools_basetime) {
+        /* A lease time of 0 is allowed on some dhcp servers, so, let's accept it. */
+        lifetime = 0;
+    } else {
+        lifetime = nettools_lifetime - nettools_basetime;
+
+        /* we "ceil" the value to the next second. In practice, we don't expect any sub-second values
+         * from n-dhcp4 anyway, so this should have no effect. */
+        lifetime += NM_UTILS_NSEC_PER_SEC - 1;
+    }
+
+    ts = nm_utils_monotonic_timestamp_from_boottime(nettools_basetime, 1);
+
+    /* the timestamp must be positive, because we only started nettools DHCP client
+     * after obtaining the first monotonic timestamp. Hence, the lease must have been
+     * received afterwards. */
+    nm_assert(ts >= NM_UTILS_NSEC_PER_SEC);
+
+    *out_timestamp = ts / NM_UTILS_NSEC_PER_SEC;
+    *out_lifetime  = NM_MIN(lifetime / NM_UTILS_NSEC_PER_SEC, NM_PLATFORM_LIFETIME_PERMANENT - 1);
+    *out_expiry    = time(NULL)
+                  + ((lifetime - (nm_utils_clock_gettime_nsec(CLOCK_BOOTTIME) - nettools_basetime))
+                     / NM_UTILS_NSEC_PER_SEC);
+}
+
 static gboolean
 lease_parse_address(NMDhcpNettools    *self /* for logging context only */,
                     NDhcp4ClientLease *lease,
@@ -202,7 +272,6 @@ lease_parse_address(NMDhcpNettools    *self /* for logging context only */,
     in_addr_t      a_netmask;
     struct in_addr a_next_server;
     guint32        a_plen;
-    guint64        nettools_lifetime;
     guint32        a_lifetime;
     guint32        a_timestamp;
     guint64        a_expiry;
@@ -218,50 +287,7 @@ lease_parse_address(NMDhcpNettools    *self /* for logging context only */,
         return FALSE;
     }
 
-    n_dhcp4_client_lease_get_lifetime(lease, &nettools_lifetime);
-
-    if (nettools_lifetime == G_MAXUINT64) {
-        a_timestamp = 0;
-        a_lifetime  = NM_PLATFORM_LIFETIME_PERMANENT;
-        a_expiry    = G_MAXUINT64;
-    } else {
-        guint64 nettools_basetime;
-        guint64 lifetime;
-        gint64  ts;
-
-        n_dhcp4_client_lease_get_basetime(lease, &nettools_basetime);
-
-        /* usually we shouldn't assert against external libraries like n-dhcp4.
-         * Here we still do it... it seems safe enough. */
-        nm_assert(nettools_basetime > 0);
-        nm_assert(nettools_lifetime >= nettools_basetime);
-        nm_assert(((nettools_lifetime - nettools_basetime) % NM_UTILS_NSEC_PER_SEC) == 0);
-        nm_assert((nettools_lifetime - nettools_basetime) / NM_UTILS_NSEC_PER_SEC <= G_MAXUINT32);
-
-        if (nettools_lifetime <= nettools_basetime) {
-            /* A lease time of 0 is allowed on some dhcp servers, so, let's accept it. */
-            lifetime = 0;
-        } else {
-            lifetime = nettools_lifetime - nettools_basetime;
-
-            /* we "ceil" the value to the next second. In practice, we don't expect any sub-second values
-             * from n-dhcp4 anyway, so this should have no effect. */
-            lifetime += NM_UTILS_NSEC_PER_SEC - 1;
-        }
-
-        ts = nm_utils_monotonic_timestamp_from_boottime(nettools_basetime, 1);
-
-        /* the timestamp must be positive, because we only started nettools DHCP client
-         * after obtaining the first monotonic timestamp. Hence, the lease must have been
-         * received afterwards. */
-        nm_assert(ts >= NM_UTILS_NSEC_PER_SEC);
-
-        a_timestamp = ts / NM_UTILS_NSEC_PER_SEC;
-        a_lifetime  = NM_MIN(lifetime / NM_UTILS_NSEC_PER_SEC, NM_PLATFORM_LIFETIME_PERMANENT - 1);
-        a_expiry    = time(NULL)
-                   + ((lifetime - (nm_utils_clock_gettime_nsec(CLOCK_BOOTTIME) - nettools_basetime))
-                      / NM_UTILS_NSEC_PER_SEC);
-    }
+    lease_parse_lifetime(lease, &a_timestamp, &a_lifetime, &a_expiry);
 
     r = _client_lease_query(lease, NM_DHCP_OPTION_DHCP4_SUBNET_MASK, &l_data, &l_data_len);
     if (r == N_DHCP4_E_UNSET) {
@@ -888,15 +914,198 @@ lease_to_ip4_config(NMDhcpNettools *self, NDhcp4ClientLease *lease, GError **err
     return g_steal_pointer(&l3cd);
 }
 
+/* Hash everything in the lease that lease_to_ip4_config() looks at, except
+ * the lifetime. n-dhcp4 refuses to return the lease time, T1 and T2 via
+ * n_dhcp4_client_lease_query(), so they are naturally excluded. */
+static guint64
+lease_hash(NDhcp4ClientLease *lease)
+{
+    NMHashState    h;
+    struct in_addr v_inaddr_s;
+    const char    *v_str;
+    guint          i;
+
+    nm_hash_init(&h, 1559239433u);
+
+    n_dhcp4_client_lease_get_yiaddr(lease, &v_inaddr_s);
+    nm_hash_update_val(&h, v_inaddr_s.s_addr);
+    n_dhcp4_client_lease_get_siaddr(lease, &v_inaddr_s);
+    nm_hash_update_val(&h, v_inaddr_s.s_addr);
+    if (n_dhcp4_client_lease_get_server_identifier(lease, &v_inaddr_s) != 0)
+        v_inaddr_s.s_addr = INADDR_ANY;
+    nm_hash_update_val(&h, v_inaddr_s.s_addr);
+    if (n_dhcp4_client_lease_get_file(lease, &v_str) != 0)
+        v_str = NULL;
+    nm_hash_update_str0(&h, v_str);
+
+    for (i = 1; i < 255; i++) {
+        const guint8 *l_data;
+        gsize         l_data_len;
+
+        if (_client_lease_query(lease, i, &l_data, &l_data_len) != 0)
+            continue;
+        nm_hash_update_vals(&h, i, l_data_len);
+        nm_hash_update_mem(&h, l_data, l_data_len);
+    }
+
+    return nm_hash_complete_u64(&h);
+}
+
+/* Create the configuration for an extended lease whose options are identical
+ * to the ones of @l3cd_prev. Only the lifetime of the address and the
+ * lifetime-related options change. */
+static NML3ConfigData *
+lease_renew_ip4_config(NDhcp4ClientLease *lease, const NML3ConfigData *l3cd_prev)
+{
+    nm_auto_unref_l3cd_init NML3ConfigData *l3cd    = NULL;
+    gs_unref_hashtable GHashTable          *options = NULL;
+    NMDhcpLease                            *lease_prev;
+    const NMPObject                        *obj;
+    NMPlatformIP4Address                    a;
+    GHashTableIter                          iter;
+    const char                             *key;
+    const char                             *value;
+    guint64                                 a_expiry;
+
+    lease_prev = nm_l3_config_data_get_dhcp_lease(l3cd_prev, AF_INET);
+    obj        = nm_l3_config_data_get_first_obj(l3cd_prev, NMP_OBJECT_TYPE_IP4_ADDRESS, NULL);
+    if (!lease_prev || !obj)
+        return NULL;
+
+    a = *NMP_OBJECT_CAST_IP4_ADDRESS(obj);
+    lease_parse_lifetime(lease, &a.timestamp, &a.lifetime, &a_expiry);
+    a.preferred = a.lifetime;
+
+    l3cd = nm_l3_config_data_new_clone(l3cd_prev, -1);
+    nm_l3_config_data_add_address_full(l3cd,
+                                       AF_INET,
+                                       NULL,
+                                       NM_PLATFORM_IP_ADDRESS_CAST(&a),
+                                       NM_L3_CONFIG_ADD_FLAGS_NONE,
+                                       NULL);
+
+    /* lease_to_ip4_config() only uses static keys, so we can share them. */
+    options = nm_dhcp_option_create_options_dict(TRUE);
+    g_hash_table_iter_init(&iter, nm_dhcp_lease_get_options(lease_prev));
+    while (g_hash_table_iter_next(&iter, (gpointer *) &key, (gpointer *) &value))
+        g_hash_table_insert(options, (char *) key, g_strdup(value));
+
+    nm_dhcp_option_add_option_u64(options,
+                                  TRUE,
+                                  AF_INET,
+                                  NM_DHCP_OPTION_DHCP4_IP_ADDRESS_LEASE_TIME,
+                                  (guint64) a.lifetime);
+    if (a_expiry != G_MAXUINT64) {
+        nm_dhcp_option_add_option_u64(options,
+                                      TRUE,
+                                      AF_INET,
+                                      NM_DHCP_OPTION_DHCP4_NM_EXPIRY,
+                                      a_expiry);
+    } else {
+        g_hash_table_remove(options,
+                            nm_dhcp_option_request_string(AF_INET,
+                                                          NM_DHCP_OPTION_DHCP4_NM_EXPIRY));
+    }
+
+    nm_l3_config_data_set_dhcp_lease_from_options(l3cd, AF_INET, g_steal_pointer(&options));
+
+    return g_steal_pointer(&l3cd);
+}
+
 /*****************************************************************************/
 
+typedef struct {
+    char *lease_file;
+    char *content;
+} LeaseSaveData;
+
+static void
+_lease_save_data_free(gpointer user_data)
+{
+    LeaseSaveData *data = user_data;
+
+    g_free(data->lease_file);
+    g_free(data->content);
+    g_slice_free(LeaseSaveData, data);
+}
+
+static void
+_lease_save_thread_cb(GTask        *task,
+                      gpointer      source_object,
+                      gpointer      task_data,
+                      GCancellable *cancellable)
+{
+    LeaseSaveData *data  = task_data;
+    GError        *error = NULL;
+
+    if (!g_file_set_contents(data->lease_file, data->content, -1, &error))
+        g_task_return_error(task, error);
+    else
+        g_task_return_boolean(task, TRUE);
+}
+
+static void _lease_save_start(NMDhcpNettools *self, const char *lease_file, char *content_take);
+
+static void
+_lease_save_done_cb(GObject *source, GAsyncResult *result, gpointer user_data)
+{
+    NMDhcpNettools        *self  = NM_DHCP_NETTOOLS(source);
+    NMDhcpNettoolsPrivate *priv  = NM_DHCP_NETTOOLS_GET_PRIVATE(self);
+    LeaseSaveData         *data  = g_task_get_task_data(G_TASK(result));
+    gs_free_error GError  *error = NULL;
+
+    nm_assert(priv->lease_save.writing);
+
+    priv->lease_save.writing = FALSE;
+
+    if (!g_task_propagate_boolean(G_TASK(result), &error)) {
+        _LOGW("error saving lease to %s: %s", data->lease_file, error->message);
+        /* Forget about the failed write, so that it gets retried the next time. */
+        if (nm_streq0(priv->lease_save.content_sent, data->content))
+            nm_clear_g_free(&priv->lease_save.content_sent);
+    }
+
+    if (priv->lease_save.content_queued && priv->lease_file) {
+        _lease_save_start(self,
+                          priv->lease_file,
+                          g_steal_pointer(&priv->lease_save.content_queued));
+    }
+}
+
+static void
+_lease_save_start(NMDhcpNettools *self, const char *lease_file, char *content_take)
+{
+    NMDhcpNettoolsPrivate *priv = NM_DHCP_NETTOOLS_GET_PRIVATE(self);
+    gs_unref_object GTask *task = NULL;
+    LeaseSaveData         *data;
+
+    nm_assert(!priv->lease_save.writing);
+
+    g_free(priv->lease_save.content_sent);
+    priv->lease_save.content_sent = content_take;
+    priv->lease_save.writing      = TRUE;
+
+    data  = g_slice_new(LeaseSaveData);
+    *data = (LeaseSaveData){
+        .lease_file = g_strdup(lease_file),
+        .content    = g_strdup(content_take),
+    };
+
+    /* Writing the file calls fsync(), which can take a while. Do it on a worker
+     * thread, so that renewals on many interfaces don't block the main loop. */
+    task = g_task_new(self, NULL, _lease_save_done_cb, NULL);
+    g_task_set_task_data(task, data, _lease_save_data_free);
+    g_task_run_in_thread(task, _lease_save_thread_cb);
+}
+
 static void
 lease_save(NMDhcpNettools *self, NDhcp4ClientLease *lease, const char *lease_file)
 {
+    NMDhcpNettoolsPrivate   *priv = NM_DHCP_NETTOOLS_GET_PRIVATE(self);
     struct in_addr           a_address;
     nm_auto_str_buf NMStrBuf sbuf = NM_STR_BUF_INIT(NM_UTILS_GET_NEXT_REALLOC_SIZE_104, FALSE);
     char                     addr_str[NM_INET_ADDRSTRLEN];
-    gs_free_error GError    *error = NULL;
+    const char              *content_last;
 
     nm_assert(lease);
     nm_assert(lease_file);
@@ -908,8 +1117,21 @@ lease_save(NMDhcpNettools *self, NDhcp4ClientLease *lease, const char *lease_fil
     nm_str_buf_append(&sbuf, "# This is private data. Do not parse.\n");
     nm_str_buf_append_printf(&sbuf, "ADDRESS=%s\n", nm_inet4_ntop(a_address.s_addr, addr_str));
 
-    if (!g_file_set_contents(lease_file, nm_str_buf_get_str_unsafe(&sbuf), sbuf.len, &error))
-        _LOGW("error saving lease to %s: %s", lease_file, error->message);
+    /* A renewal usually extends the same lease. Only write the file when its
+     * content changes. */
+    content_last = priv->lease_save.content_queued ?: priv->lease_save.content_sent;
+    if (nm_streq0(content_last, nm_str_buf_get_str(&sbuf))) {
+        _LOGT("lease file %s is unchanged", lease_file);
+        return;
+    }
+
+    if (priv->lease_save.writing) {
+        g_free(priv->lease_save.content_queued);
+        priv->lease_save.content_queued = nm_str_buf_finalize(&sbuf, NULL);
+        return;
+    }
+
+    _lease_save_start(self, lease_file, nm_str_buf_finalize(&sbuf, NULL));
 }
 
 static void
@@ -918,12 +1140,30 @@ bound4_handle(NMDhcpNettools *self, guint event, NDhcp4ClientLease *lease)
     NMDhcpNettoolsPrivate                  *priv  = NM_DHCP_NETTOOLS_GET_PRIVATE(self);
     nm_auto_unref_l3cd_init NML3ConfigData *l3cd  = NULL;
     gs_free_error GError                   *error = NULL;
+    guint64                                 options_hash;
 
     nm_assert(NM_IN_SET(event, N_DHCP4_CLIENT_EVENT_GRANTED, N_DHCP4_CLIENT_EVENT_EXTENDED));
     nm_assert(lease);
 
     _LOGT("lease available (%s)", (event == N_DHCP4_CLIENT_EVENT_GRANTED) ? "granted" : "extended");
 
+    options_hash = lease_hash(lease);
+
+    if (event == N_DHCP4_CLIENT_EVENT_EXTENDED && priv->bound.l3cd
+        && priv->bound.options_hash == options_hash
+        && priv->bound.l3cd == nm_dhcp_client_get_lease(NM_DHCP_CLIENT(self), TRUE)) {
+        /* The server extended the lease we are using without changing it. Skip
+         * parsing it again and only update the lifetimes. */
+        l3cd = lease_renew_ip4_config(lease, priv->bound.l3cd);
+        if (l3cd) {
+            _LOGT("lease extended with unchanged options");
+            lease_save(self, lease, priv->lease_file);
+            nm_l3_config_data_reset(&priv->bound.l3cd, l3cd);
+            _nm_dhcp_client_notify_renewed(NM_DHCP_CLIENT(self), l3cd);
+            return;
+        }
+    }
+
     l3cd = lease_to_ip4_config(self, lease, &error);
     if (!l3cd) {
         _LOGW("failure to parse lease: %s", error->message);
@@ -943,6 +1183,9 @@ bound4_handle(NMDhcpNettools *self, guint event, NDhcp4ClientLease *lease)
     } else
         lease_save(self, lease, priv->lease_file);
 
+    priv->bound.options_hash = options_hash;
+    nm_l3_config_data_reset(&priv->bound.l3cd, l3cd);
+
     _nm_dhcp_client_notify(NM_DHCP_CLIENT(self),
                            event == N_DHCP4_CLIENT_EVENT_GRANTED
                                ? NM_DHCP_CLIENT_EVENT_TYPE_BOUND
@@ -1519,6 +1762,10 @@ ip4_start(NMDhcpClient *client, GError **error)
         }
     }
 
+    if (!nm_streq0(priv->lease_file, lease_file)) {
+        nm_clear_g_free(&priv->lease_save.content_sent);
+        nm_clear_g_free(&priv->lease_save.content_queued);
+    }
     g_free(priv->lease_file);
     priv->lease_file = g_steal_pointer(&lease_file);
 
@@ -1568,10 +1815,13 @@ dispose(GObject *object)
     NMDhcpNettoolsPrivate *priv = NM_DHCP_NETTOOLS_GET_PRIVATE(object);
 
     nm_clear_g_free(&priv->lease_file);
+    nm_clear_g_free(&priv->lease_save.content_sent);
+    nm_clear_g_free(&priv->lease_save.content_queued);
     nm_clear_g_source_inst(&priv->event_source);
     nm_clear_g_source_inst(&priv->pop_all_events_on_idle_source);
     nm_clear_pointer(&priv->granted.lease, n_dhcp4_client_lease_unref);
     nm_clear_l3cd(&priv->granted.lease_l3cd);
+    nm_clear_l3cd(&priv->bound.l3cd);
     nm_clear_pointer(&priv->probe, n_dhcp4_client_probe_free);
     nm_clear_pointer(&priv->client, n_dhcp4_client_unref);
 
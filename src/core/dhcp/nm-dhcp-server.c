@@ -0,0 +1,504 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+#include "src/core/nm-default-daemon.h"
+
+#include "nm-dhcp-server.h"
+
+#include "n-dhcp4/src/n-dhcp4.h"
+
+#include "libnm-core-aux-intern/nm-libnm-core-utils.h"
+#include "libnm-glib-aux/nm-time-utils.h"
+#include "dnsmasq/nm-dnsmasq-utils.h"
+#include "nm-config.h"
+#include "nm-dhcp-options.h"
+
+/*****************************************************************************/
+
+/* A DHCPv4 server for shared connections, as alternative to running one
+ * dnsmasq per interface. There is one n-dhcp4 server per interface, they
+ * are all driven from the main loop. The leases are only kept in memory.
+ * Clients that come back after a restart get their address again, as long
+ * as nobody else took it meanwhile. */
+
+/* How long an offered address is reserved for the client. */
+#define OFFER_TIMEOUT_MSEC (60 * NM_UTILS_MSEC_PER_SEC)
+
+/* How long an address that a client declined is not handed out. */
+#define DECLINE_TIMEOUT_MSEC (10 * 60 * NM_UTILS_MSEC_PER_SEC)
+
+#define ANDROID_METERED "ANDROID_METERED"
+
+/*****************************************************************************/
+
+#define _NMLOG_DOMAIN      LOGD_SHARING
+#define _NMLOG(level, ...) __NMLOG_DEFAULT(level, _NMLOG_DOMAIN, "dhcp-server", __VA_ARGS__)
+
+/*****************************************************************************/
+
+typedef struct {
+    /* NULL for addresses that a client declined. */
+    GBytes   *client_id;
+    in_addr_t address;
+    gint64    expiry_msec;
+} Lease;
+
+struct _NMDhcpServer {
+    char                      *iface;
+    NDhcp4Server              *server;
+    NDhcp4ServerIp            *server_ip;
+    GSource                   *event_source;
+    NMDhcpServerFailedCallback failed_callback;
+    gpointer                   user_data;
+
+    /* Owns the leases. */
+    GHashTable *leases_by_addr;
+    GHashTable *leases_by_client;
+
+    GArray   *dns;
+    in_addr_t address;
+    in_addr_t netmask;
+    guint32   lifetime;
+
+    /* In host byte order, to iterate over the range. */
+    guint32 range_first;
+    guint32 range_last;
+
+    bool announce_router : 1;
+    bool announce_android_metered : 1;
+};
+
+/*****************************************************************************/
+
+static void
+_lease_free(gpointer data)
+{
+    Lease *lease = data;
+
+    nm_clear_pointer(&lease->client_id, g_bytes_unref);
+    nm_g_slice_free(lease);
+}
+
+static void
+_lease_remove(NMDhcpServer *self, Lease *lease)
+{
+    if (lease->client_id)
+        g_hash_table_remove(self->leases_by_client, lease->client_id);
+    g_hash_table_remove(self->leases_by_addr, GUINT_TO_POINTER(lease->address));
+}
+
+static gboolean
+_address_in_range(NMDhcpServer *self, in_addr_t address)
+{
+    guint32 a = ntohl(address);
+
+    return a >= self->range_first && a <= self->range_last && address != self->address;
+}
+
+static gboolean
+_address_is_available(NMDhcpServer *self, in_addr_t address, gint64 now_msec)
+{
+    Lease *lease;
+
+    if (!_address_in_range(self, address))
+        return FALSE;
+
+    lease = g_hash_table_lookup(self->leases_by_addr, GUINT_TO_POINTER(address));
+    return !lease || lease->expiry_msec <= now_msec;
+}
+
+static Lease *
+_lease_allocate(NMDhcpServer *self,
+                GBytes       *client_id,
+                Lease        *lease,
+                in_addr_t     requested,
+                gint64        now_msec)
+{
+    in_addr_t address = 0;
+    Lease    *old;
+    guint32   a;
+
+    if (lease) {
+        if (_address_in_range(self, lease->address))
+            return lease;
+        /* The range changed. */
+        _lease_remove(self, lease);
+    }
+
+    if (requested != 0 && _address_is_available(self, requested, now_msec))
+        address = requested;
+    else {
+        for (a = self->range_first; a <= self->range_last && a != 0; a++) {
+            if (_address_is_available(self, htonl(a), now_msec)) {
+                address = htonl(a);
+                break;
+            }
+        }
+        if (address == 0)
+            return NULL;
+    }
+
+    old = g_hash_table_lookup(self->leases_by_addr, GUINT_TO_POINTER(address));
+    if (old)
+        _lease_remove(self, old);
+
+    lease  = g_slice_new(Lease);
+    *lease = (Lease) {
+        .client_id   = g_bytes_ref(client_id),
+        .address     = address,
+        .expiry_msec = now_msec + OFFER_TIMEOUT_MSEC,
+    };
+    g_hash_table_insert(self->leases_by_addr, GUINT_TO_POINTER(address), lease);
+    g_hash_table_insert(self->leases_by_client, lease->client_id, lease);
+    return lease;
+}
+
+/*****************************************************************************/
+
+static GBytes *
+_get_client_id(NDhcp4ServerLease *nlease)
+{
+    const guint8 *data;
+    guint8       *client_id;
+    size_t        n_data;
+    guint8       *buf;
+    char          kind;
+
+    /* Clients are identified by their client ID, or else by their hardware
+     * address. Prefix the key, so that both don't clash. */
+    if (n_dhcp4_server_lease_query(nlease, NM_DHCP_OPTION_DHCP4_CLIENT_ID, &client_id, &n_data)
+            == 0
+        && n_data > 0) {
+        data = client_id;
+        kind = 'i';
+    } else {
+        n_dhcp4_server_lease_get_chaddr(nlease, &data, &n_data);
+        kind = 'h';
+    }
+
+    buf    = g_malloc(n_data + 1);
+    buf[0] = kind;
+    memcpy(&buf[1], data, n_data);
+    return g_bytes_new_take(buf, n_data + 1);
+}
+
+static void
+_reply(NMDhcpServer *self, NDhcp4ServerLease *nlease, Lease *lease, gboolean ack)
+{
+    char            sbuf[NM_INET_ADDRSTRLEN];
+    struct in_addr  yiaddr  = {.s_addr = lease->address};
+    const in_addr_t netmask = self->netmask;
+    const in_addr_t router  = self->address;
+    int             r;
+
+    r = n_dhcp4_server_lease_append(nlease,
+                                    NM_DHCP_OPTION_DHCP4_SUBNET_MASK,
+                                    (guint8 *) &netmask,
+                                    sizeof(netmask));
+    if (r == 0 && self->announce_router) {
+        r = n_dhcp4_server_lease_append(nlease,
+                                        NM_DHCP_OPTION_DHCP4_ROUTER,
+                                        (guint8 *) &router,
+                                        sizeof(router));
+    }
+    if (r == 0 && self->dns->len > 0) {
+        r = n_dhcp4_server_lease_append(nlease,
+                                        NM_DHCP_OPTION_DHCP4_DOMAIN_NAME_SERVER,
+                                        (guint8 *) self->dns->data,
+                                        self->dns->len * sizeof(in_addr_t));
+    }
+    if (r == 0 && self->announce_android_metered) {
+        /* See https://www.lorier.net/docs/android-metered.html */
+        r = n_dhcp4_server_lease_append(nlease,
+                                        NM_DHCP_OPTION_DHCP4_VENDOR_SPECIFIC,
+                                        (guint8 *) ANDROID_METERED,
+                                        NM_STRLEN(ANDROID_METERED));
+    }
+
+    if (r == 0) {
+        if (ack)
+            r = n_dhcp4_server_lease_ack(nlease, yiaddr, self->lifetime);
+        else
+            r = n_dhcp4_server_lease_offer(nlease, yiaddr, self->lifetime);
+    }
+
+    if (r != 0) {
+        _LOGD("%s: failure to send %s for %s (%d)",
+              self->iface,
+              ack ? "ack" : "offer",
+              nm_inet4_ntop(lease->address, sbuf),
+              r);
+        return;
+    }
+
+    _LOGD("%s: %s %s",
+          self->iface,
+          ack ? "assigned" : "offered",
+          nm_inet4_ntop(lease->address, sbuf));
+}
+
+static void
+_event_handle(NMDhcpServer *self, NDhcp4ServerEvent *event)
+{
+    NDhcp4ServerLease     *nlease    = event->request.lease;
+    gs_unref_bytes GBytes *client_id = NULL;
+    struct in_addr         requested;
+    Lease                 *lease;
+    gint64                 now_msec;
+    char                   sbuf[NM_INET_ADDRSTRLEN];
+
+    if (event->event == N_DHCP4_SERVER_EVENT_DOWN)
+        return;
+
+    now_msec  = nm_utils_get_monotonic_timestamp_msec();
+    client_id = _get_client_id(nlease);
+    lease     = g_hash_table_lookup(self->leases_by_client, client_id);
+    n_dhcp4_server_lease_get_requested_ip(nlease, &requested);
+
+    switch (event->event) {
+    case N_DHCP4_SERVER_EVENT_DISCOVER:
+        lease = _lease_allocate(self, client_id, lease, requested.s_addr, now_msec);
+        if (!lease) {
+            _LOGW("%s: no free address left to offer", self->iface);
+            return;
+        }
+        lease->expiry_msec = NM_MAX(lease->expiry_msec, now_msec + OFFER_TIMEOUT_MSEC);
+        _reply(self, nlease, lease, FALSE);
+        return;
+
+    case N_DHCP4_SERVER_EVENT_REQUEST:
+    case N_DHCP4_SERVER_EVENT_RENEW:
+        if (!lease && _address_is_available(self, requested.s_addr, now_msec))
+            lease = _lease_allocate(self, client_id, NULL, requested.s_addr, now_msec);
+        if (!lease || lease->address != requested.s_addr) {
+            _LOGD("%s: reject request for %s",
+                  self->iface,
+                  nm_inet4_ntop(requested.s_addr, sbuf));
+            n_dhcp4_server_lease_nack(nlease);
+            return;
+        }
+        if (self->lifetime == G_MAXUINT32)
+            lease->expiry_msec = G_MAXINT64;
+        else
+            lease->expiry_msec = now_msec + ((gint64) self->lifetime) * NM_UTILS_MSEC_PER_SEC;
+        _reply(self, nlease, lease, TRUE);
+        return;
+
+    case N_DHCP4_SERVER_EVENT_DECLINE:
+        if (!lease || lease->address != requested.s_addr)
+            return;
+        _LOGD("%s: address %s declined", self->iface, nm_inet4_ntop(lease->address, sbuf));
+        g_hash_table_remove(self->leases_by_client, lease->client_id);
+        nm_clear_pointer(&lease->client_id, g_bytes_unref);
+        lease->expiry_msec = now_msec + DECLINE_TIMEOUT_MSEC;
+        return;
+
+    case N_DHCP4_SERVER_EVENT_RELEASE:
+        if (!lease)
+            return;
+        _LOGD("%s: address %s released", self->iface, nm_inet4_ntop(lease->address, sbuf));
+        _lease_remove(self, lease);
+        return;
+    }
+}
+
+static gboolean
+_event_cb(int fd, GIOCondition condition, gpointer user_data)
+{
+    NMDhcpServer      *self = user_data;
+    NDhcp4ServerEvent *event;
+    int                r;
+
+    r = n_dhcp4_server_dispatch(self->server);
+    if (r < 0) {
+        _LOGW("%s: error %d dispatching events", self->iface, r);
+        nm_clear_g_source_inst(&self->event_source);
+        self->failed_callback(self, self->user_data);
+        return G_SOURCE_REMOVE;
+    }
+
+    while (!n_dhcp4_server_pop_event(self->server, &event) && event)
+        _event_handle(self, event);
+
+    return G_SOURCE_CONTINUE;
+}
+
+/*****************************************************************************/
+
+static gboolean
+_parse_range(NMDhcpServer *self, const char *range, GError **error)
+{
+    gs_free const char **tokens = NULL;
+    in_addr_t            first;
+    in_addr_t            last;
+
+    tokens = nm_strsplit_set(range, ",");
+    if (NM_PTRARRAY_LEN(tokens) != 2 || !nm_inet_parse_bin(AF_INET, tokens[0], NULL, &first)
+        || !nm_inet_parse_bin(AF_INET, tokens[1], NULL, &last) || ntohl(first) > ntohl(last)) {
+        g_set_error(error,
+                    NM_MANAGER_ERROR,
+                    NM_MANAGER_ERROR_FAILED,
+                    "invalid DHCP range \"%s\"",
+                    range);
+        return FALSE;
+    }
+
+    self->range_first = ntohl(first);
+    self->range_last  = ntohl(last);
+    return TRUE;
+}
+
+static void
+_init_dns(NMDhcpServer *self, const NML3ConfigData *l3cd)
+{
+    gs_free char        *value  = NULL;
+    gs_free const char **tokens = NULL;
+    const char *const   *strarr;
+    guint                n;
+    guint                i;
+
+    /* Like dnsmasq, announce the name servers of the profile. Otherwise, there
+     * is no forwarder on the interface, so announce the configured one. */
+    strarr = nm_l3_config_data_get_nameservers(l3cd, AF_INET, &n);
+    for (i = 0; i < n; i++) {
+        NMIPAddr addr;
+
+        if (nm_dns_uri_parse_plain(AF_INET, strarr[i], NULL, &addr))
+            g_array_append_val(self->dns, addr.addr4);
+    }
+
+    if (self->dns->len == 0) {
+        value  = nm_config_data_get_value(NM_CONFIG_GET_DATA,
+                                         NM_CONFIG_KEYFILE_GROUP_MAIN,
+                                         NM_CONFIG_KEYFILE_KEY_MAIN_SHARED_DNS_FORWARDER,
+                                         NM_CONFIG_GET_VALUE_STRIP | NM_CONFIG_GET_VALUE_NO_EMPTY);
+        tokens = nm_strsplit_set(value, ", ");
+        for (i = 0; tokens && tokens[i]; i++) {
+            in_addr_t addr;
+
+            if (nm_inet_parse_bin(AF_INET, tokens[i], NULL, &addr))
+                g_array_append_val(self->dns, addr);
+            else
+                _LOGW("%s: ignore invalid DNS forwarder \"%s\"", self->iface, tokens[i]);
+        }
+    }
+
+    /* The option holds at most 63 addresses. */
+    if (self->dns->len > 63)
+        g_array_set_size(self->dns, 63);
+}
+
+NMDhcpServer *
+nm_dhcp_server_new(int                        ifindex,
+                   const char                *iface,
+                   const NML3ConfigData      *l3cd,
+                   const char                *shared_dhcp_range,
+                   int                        shared_dhcp_lease_time,
+                   gboolean                   announce_android_metered,
+                   NMDhcpServerFailedCallback failed_callback,
+                   gpointer                   user_data,
+                   GError                   **error)
+{
+    nm_auto(n_dhcp4_server_config_freep) NDhcp4ServerConfig *config = NULL;
+    const NMPlatformIP4Address                             *listen_address;
+    NMDhcpServer                                           *self;
+    char                                                    first[INET_ADDRSTRLEN];
+    char                                                    last[INET_ADDRSTRLEN];
+    gs_free char                                           *range      = NULL;
+    gs_free char                                           *error_desc = NULL;
+    struct in_addr                                          server_addr;
+    int                                                     fd;
+    int                                                     r;
+
+    g_return_val_if_fail(ifindex > 0, NULL);
+    g_return_val_if_fail(iface, NULL);
+    g_return_val_if_fail(failed_callback, NULL);
+
+    listen_address = NMP_OBJECT_CAST_IP4_ADDRESS(
+        nm_l3_config_data_get_first_obj(l3cd, NMP_OBJECT_TYPE_IP4_ADDRESS, NULL));
+    g_return_val_if_fail(listen_address, NULL);
+
+    if (!shared_dhcp_range || !*shared_dhcp_range) {
+        if (!nm_dnsmasq_utils_get_range(listen_address, first, last, &error_desc)) {
+            g_set_error_literal(error, NM_MANAGER_ERROR, NM_MANAGER_ERROR_FAILED, error_desc);
+            return NULL;
+        }
+        range             = g_strdup_printf("%s,%s", first, last);
+        shared_dhcp_range = range;
+    }
+
+    self  = g_slice_new(NMDhcpServer);
+    *self = (NMDhcpServer) {
+        .iface            = g_strdup(iface),
+        .failed_callback  = failed_callback,
+        .user_data        = user_data,
+        .leases_by_addr   = g_hash_table_new_full(nm_direct_hash, NULL, NULL, _lease_free),
+        .leases_by_client = g_hash_table_new(g_bytes_hash, g_bytes_equal),
+        .dns              = g_array_new(FALSE, FALSE, sizeof(in_addr_t)),
+        .address          = listen_address->address,
+        .netmask          = nm_ip4_addr_netmask_from_prefix(listen_address->plen),
+        .announce_router  = !!nm_l3_config_data_get_best_default_route(l3cd, AF_INET),
+        .announce_android_metered = announce_android_metered,
+    };
+
+    if (shared_dhcp_lease_time == 0)
+        self->lifetime = 3600;
+    else if (shared_dhcp_lease_time == G_MAXINT32)
+        self->lifetime = G_MAXUINT32;
+    else
+        self->lifetime = shared_dhcp_lease_time;
+
+    if (!_parse_range(self, shared_dhcp_range, error))
+        goto fail;
+
+    _init_dns(self, l3cd);
+
+    r = n_dhcp4_server_config_new(&config);
+    if (r) {
+        nm_utils_error_set_errno(error, r, "failure to create DHCP server config: %s");
+        goto fail;
+    }
+    n_dhcp4_server_config_set_ifindex(config, ifindex);
+
+    r = n_dhcp4_server_new(&self->server, config);
+    if (r) {
+        nm_utils_error_set_errno(error, r, "failure to create DHCP server: %s");
+        goto fail;
+    }
+
+    server_addr.s_addr = self->address;
+    r                  = n_dhcp4_server_add_ip(self->server, &self->server_ip, server_addr);
+    if (r) {
+        nm_utils_error_set_errno(error, r, "failure to add DHCP server address: %s");
+        goto fail;
+    }
+
+    n_dhcp4_server_get_fd(self->server, &fd);
+    self->event_source = nm_g_unix_fd_add_source(fd, G_IO_IN, _event_cb, self);
+
+    _LOGD("%s: serving %s with lease time %u",
+          self->iface,
+          shared_dhcp_range,
+          (guint) self->lifetime);
+    return self;
+
+fail:
+    nm_dhcp_server_free(self);
+    return NULL;
+}
+
+void
+nm_dhcp_server_free(NMDhcpServer *self)
+{
+    if (!self)
+        return;
+
+    nm_clear_g_source_inst(&self->event_source);
+    n_dhcp4_server_ip_free(self->server_ip);
+    n_dhcp4_server_unref(self->server);
+
+    g_hash_table_destroy(self->leases_by_client);
+    g_hash_table_destroy(self->leases_by_addr);
+    g_array_unref(self->dns);
+    g_free(self->iface);
+    nm_g_slice_free(self);
+}
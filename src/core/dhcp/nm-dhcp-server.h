@@ -0,0 +1,27 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+#ifndef __NM_DHCP_SERVER_H__
+#define __NM_DHCP_SERVER_H__
+
+#include "nm-l3-config-data.h"
+
+typedef struct _NMDhcpServer NMDhcpServer;
+
+/* Called when the server fails and no longer serves requests. The
+ * server must still be freed with nm_dhcp_server_free(), but not from
+ * within the callback. */
+typedef void (*NMDhcpServerFailedCallback)(NMDhcpServer *server, gpointer user_data);
+
+NMDhcpServer *nm_dhcp_server_new(int                        ifindex,
+                                 const char                *iface,
+                                 const NML3ConfigData      *l3cd,
+                                 const char                *shared_dhcp_range,
+                                 int                        shared_dhcp_lease_time,
+                                 gboolean                   announce_android_metered,
+                                 NMDhcpServerFailedCallback failed_callback,
+                                 gpointer                   user_data,
+                                 GError                   **error);
+
+void nm_dhcp_server_free(NMDhcpServer *self);
+
+#endif /* __NM_DHCP_SERVER_H__ */
@@ -362,6 +362,8 @@ ip6_start(NMDhcpClient *client, const struct in6_addr *ll_addr, GError **error)
         return FALSE;
     }
 
+    /* All clients share the default sd_event, which is integrated into the
+     * main context with a single GSource (see nm_sd_event_attach_default()). */
     r = sd_dhcp6_client_attach_event(sd_client, NULL, 0);
     if (r < 0) {
         nm_utils_error_set_errno(error, r, "failed to attach event: %s");
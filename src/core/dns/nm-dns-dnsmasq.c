@@ -681,6 +681,9 @@ typedef struct {
 
     GVariant *set_server_ex_args;
 
+    /* The arguments that the running dnsmasq instance accepted last. */
+    GVariant *set_server_ex_args_sent;
+
     GCancellable *update_cancellable;
 
     GCancellable *main_cancellable;
@@ -696,6 +699,9 @@ typedef struct {
 
     guint name_owner_changed_id;
 
+    guint n_updates_sent;
+    guint n_updates_skipped;
+
     guint8 burst_count;
 
     bool is_stopped : 1;
@@ -956,8 +962,12 @@ dnsmasq_update_done(GObject *source_object, GAsyncResult *res, gpointer user_dat
 
     if (!response)
         _LOGW("dnsmasq update failed: %s", error->message);
-    else
+    else {
         _LOGD("dnsmasq update successful");
+        /* every SetServersEx() call cancels the previous one, so this reply is
+         * for the current arguments. */
+        priv->set_server_ex_args_sent = g_variant_ref(priv->set_server_ex_args);
+    }
 
     _update_pending_maybe_changed(self);
 }
@@ -970,11 +980,28 @@ send_dnsmasq_update(NMDnsDnsmasq *self)
     if (!priv->name_owner || !priv->set_server_ex_args)
         return;
 
-    _LOGD("trying to update dnsmasq nameservers");
+    if (priv->set_server_ex_args_sent
+        && g_variant_equal(priv->set_server_ex_args_sent, priv->set_server_ex_args)) {
+        /* SetServersEx() makes dnsmasq clear its cache. Don't do that, if
+         * nothing changed. */
+        priv->set_server_ex_args_dirty = FALSE;
+        priv->n_updates_skipped++;
+        _LOGD("dnsmasq nameservers unchanged (%u updates sent, %u skipped)",
+              priv->n_updates_sent,
+              priv->n_updates_skipped);
+        _update_pending_maybe_changed(self);
+        return;
+    }
+
+    priv->n_updates_sent++;
+    _LOGD("trying to update dnsmasq nameservers (%u updates sent, %u skipped)",
+          priv->n_updates_sent,
+          priv->n_updates_skipped);
 
     nm_clear_g_cancellable(&priv->update_cancellable);
     priv->update_cancellable = g_cancellable_new();
 
+    nm_clear_pointer(&priv->set_server_ex_args_sent, g_variant_unref);
     priv->set_server_ex_args_dirty = FALSE;
 
     g_dbus_connection_call(priv->dbus_connection,
@@ -1005,6 +1032,7 @@ _main_cleanup(NMDnsDnsmasq *self, gboolean emit_failed)
 
     priv->process_pid = 0;
     nm_clear_g_free(&priv->name_owner);
+    nm_clear_pointer(&priv->set_server_ex_args_sent, g_variant_unref);
 
     nm_clear_g_dbus_connection_signal(priv->dbus_connection, &priv->name_owner_changed_id);
 
@@ -1044,6 +1072,7 @@ name_owner_changed(NMDnsDnsmasq *self, const char *name_owner)
 
     _LOGT("D-Bus name for dnsmasq got owner %s", name_owner);
     nm_clear_g_source_inst(&priv->main_timeout_source);
+    nm_clear_pointer(&priv->set_server_ex_args_sent, g_variant_unref);
     send_dnsmasq_update(self);
 
     _update_pending_maybe_changed(self);
@@ -1274,6 +1303,7 @@ dispose(GObject *object)
     _main_cleanup(self, FALSE);
 
     nm_clear_pointer(&priv->set_server_ex_args, g_variant_unref);
+    nm_clear_pointer(&priv->set_server_ex_args_sent, g_variant_unref);
 
     G_OBJECT_CLASS(nm_dns_dnsmasq_parent_class)->dispose(object);
 
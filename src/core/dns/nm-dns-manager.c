@@ -39,6 +39,7 @@
 #include "nm-ip-config.h"
 #include "nm-l3-config-data.h"
 #include "nm-manager.h"
+#include "nm-perf.h"
 #include "nm-utils.h"
 
 #define HASH_LEN NM_UTILS_CHECKSUM_LENGTH_SHA1
@@ -100,6 +101,10 @@ typedef struct {
      * "update_pending_unblock" timer ticking. */
     GSource *update_pending_unblock;
 
+    /* Changes to the IP configurations and the hostname are not committed
+     * right away, but coalesced and committed on idle. */
+    GSource *update_dns_idle_source;
+
     bool ip_data_lst_need_sort : 1;
 
     bool configs_lst_need_sort : 1;
@@ -1806,16 +1811,21 @@ update_dns(NMDnsManager *self, gboolean no_caching, gboolean force_emit, GError
     NMGlobalDnsConfig    *global_config;
     gs_free_error GError *local_error   = NULL;
     GError **const        p_local_error = error ? &local_error : NULL;
+    gint64                perf_start;
 
     nm_assert(!error || !*error);
 
     priv->config_changed = FALSE;
 
+    nm_clear_g_source_inst(&priv->update_dns_idle_source);
+
     if (priv->is_stopped) {
         _LOGD("update-dns: not updating resolv.conf (is stopped)");
         return TRUE;
     }
 
+    perf_start = nm_perf_start();
+
     nm_clear_g_source(&priv->plugin_ratelimit.timer);
 
     if (NM_IN_SET(priv->rc_manager,
@@ -2010,6 +2020,8 @@ plugin_skip:;
     nm_clear_pointer(&priv->config_variant, g_variant_unref);
     _notify(self, PROP_CONFIGURATION);
 
+    nm_perf_record(NM_PERF_PROBE_DNS_UPDATE, perf_start);
+
     if (result != SR_SUCCESS) {
         if (error)
             g_propagate_error(error, g_steal_pointer(&local_error));
@@ -2032,6 +2044,34 @@ nm_dns_manager_is_unmanaged(NMDnsManager *self)
 
 /*****************************************************************************/
 
+static gboolean
+_update_dns_on_idle_cb(gpointer user_data)
+{
+    NMDnsManager         *self  = user_data;
+    gs_free_error GError *error = NULL;
+
+    if (!update_dns(self, FALSE, FALSE, &error))
+        _LOGW("could not commit DNS changes: %s", error->message);
+    return G_SOURCE_CONTINUE;
+}
+
+static void
+_update_dns_schedule(NMDnsManager *self)
+{
+    NMDnsManagerPrivate *priv = NM_DNS_MANAGER_GET_PRIVATE(self);
+
+    /* During bulk activations the IP configurations change many times in a row.
+     * Commit them together, with one resolv.conf write and one plugin update
+     * per burst. When a batch is open, nm_dns_manager_end_updates() commits. */
+    if (priv->updates_queue)
+        return;
+
+    if (!priv->update_dns_idle_source)
+        priv->update_dns_idle_source = nm_g_idle_add_source(_update_dns_on_idle_cb, self);
+}
+
+/*****************************************************************************/
+
 gboolean
 nm_dns_manager_set_ip_config(NMDnsManager         *self,
                              int                   addr_family,
@@ -2203,12 +2243,7 @@ done:
     if (data && c_list_is_empty(&data->data_lst_head))
         g_hash_table_remove(priv->configs_dict, data);
 
-    if (!priv->updates_queue) {
-        gs_free_error GError *error = NULL;
-
-        if (!update_dns(self, FALSE, FALSE, &error))
-            _LOGW("could not commit DNS changes: %s", error->message);
-    }
+    _update_dns_schedule(self);
 
     return TRUE;
 }
@@ -2259,12 +2294,7 @@ nm_dns_manager_set_hostname(NMDnsManager *self, const char *hostname, gboolean s
     if (skip_update)
         return;
 
-    if (!priv->updates_queue) {
-        gs_free_error GError *error = NULL;
-
-        if (!update_dns(self, FALSE, FALSE, &error))
-            _LOGW("could not commit DNS changes: %s", error->message);
-    }
+    _update_dns_schedule(self);
 }
 
 void
@@ -2325,6 +2355,14 @@ nm_dns_manager_stop(NMDnsManager *self)
 
     _LOGT("stopping...");
 
+    if (priv->update_dns_idle_source) {
+        gs_free_error GError *error = NULL;
+
+        /* commit the changes that are still pending. */
+        if (!update_dns(self, FALSE, FALSE, &error))
+            _LOGW("could not commit DNS changes: %s", error->message);
+    }
+
     /* If we're quitting, leave a valid resolv.conf in place, not one
      * pointing to 127.0.0.1 if dnsmasq was active.  But if we haven't
      * done any DNS updates yet, there's no reason to touch resolv.conf
@@ -2907,6 +2945,7 @@ dispose(GObject *object)
     _clear_plugin(self);
 
     nm_clear_g_source_inst(&priv->update_pending_unblock);
+    nm_clear_g_source_inst(&priv->update_dns_idle_source);
 
     priv->best_ip_config_4 = NULL;
     priv->best_ip_config_6 = NULL;
@@ -33,6 +33,10 @@
 #define SYSTEMD_RESOLVED_MANAGER_IFACE "org.freedesktop.resolve1.Manager"
 #define SYSTEMD_RESOLVED_DBUS_PATH     "/org/freedesktop/resolve1"
 
+/* The maximum number of link configuration calls that we have in flight
+ * at the same time. */
+#define SEND_UPDATES_MAX_PENDING 32u
+
 /* define a variable, so that we can compare the operation with pointer equality. */
 static const char *const DBUS_OP_SET_LINK_DEFAULT_ROUTE = "SetLinkDefaultRoute";
 static const char *const DBUS_OP_SET_LINK_DNS_OVER_TLS  = "SetLinkDNSOverTLS";
@@ -55,6 +59,14 @@ typedef struct {
     int                   ref_count;
 } RequestItem;
 
+/* The last argument that systemd-resolved accepted for an operation on
+ * a link. */
+typedef struct {
+    const char *operation;
+    GVariant   *argument;
+    int         ifindex;
+} SentItem;
+
 struct _NMDnsSystemdResolvedResolveHandle {
     CList                 handle_lst;
     NMDnsSystemdResolved *self;
@@ -82,6 +94,8 @@ typedef struct {
     GCancellable    *cancellable;
     GCancellable    *service_start_cancellable;
     CList            request_queue_lst_head;
+    CList           *request_queue_send_next;
+    GHashTable      *sent_idx;
     char            *dbus_owner;
     CList            handle_lst_head;
     guint            name_owner_changed_id;
@@ -151,6 +165,8 @@ static void _resolve_start(NMDnsSystemdResolved *self, NMDnsSystemdResolvedResol
 
 static void send_updates(NMDnsSystemdResolved *self);
 
+static void _send_updates_continue(NMDnsSystemdResolved *self);
+
 /*****************************************************************************/
 
 static gboolean
@@ -261,6 +277,65 @@ _request_item_append(NMDnsSystemdResolved *self,
 
 /*****************************************************************************/
 
+static guint
+_sent_item_hash(gconstpointer ptr)
+{
+    const SentItem *sent_item = ptr;
+    NMHashState     h;
+
+    nm_hash_init(&h, 1289532537u);
+    nm_hash_update_val(&h, sent_item->ifindex);
+    nm_hash_update_str(&h, sent_item->operation);
+    return nm_hash_complete(&h);
+}
+
+static gboolean
+_sent_item_equal(gconstpointer ptr_a, gconstpointer ptr_b)
+{
+    const SentItem *a = ptr_a;
+    const SentItem *b = ptr_b;
+
+    return a->ifindex == b->ifindex && nm_streq(a->operation, b->operation);
+}
+
+static void
+_sent_item_free(gpointer ptr)
+{
+    SentItem *sent_item = ptr;
+
+    g_variant_unref(sent_item->argument);
+    nm_g_slice_free(sent_item);
+}
+
+static void
+_sent_item_set(NMDnsSystemdResolved *self,
+               const char           *operation,
+               int                   ifindex,
+               GVariant             *argument)
+{
+    NMDnsSystemdResolvedPrivate *priv = NM_DNS_SYSTEMD_RESOLVED_GET_PRIVATE(self);
+    SentItem                    *sent_item;
+
+    if (!argument) {
+        g_hash_table_remove(priv->sent_idx,
+                            &((SentItem) {
+                                .operation = operation,
+                                .ifindex   = ifindex,
+                            }));
+        return;
+    }
+
+    sent_item  = g_slice_new(SentItem);
+    *sent_item = (SentItem) {
+        .operation = operation,
+        .argument  = g_variant_ref(argument),
+        .ifindex   = ifindex,
+    };
+    g_hash_table_add(priv->sent_idx, sent_item);
+}
+
+/*****************************************************************************/
+
 static void
 _interface_config_free(InterfaceConfig *config)
 {
@@ -271,8 +346,9 @@ _interface_config_free(InterfaceConfig *config)
 static void
 call_done(GObject *source, GAsyncResult *r, gpointer user_data)
 {
-    gs_unref_variant GVariant   *v     = NULL;
-    gs_free_error GError        *error = NULL;
+    gs_unref_variant GVariant   *v        = NULL;
+    gs_unref_variant GVariant   *argument = NULL;
+    gs_free_error GError        *error    = NULL;
     NMDnsSystemdResolved        *self;
     NMDnsSystemdResolvedPrivate *priv;
     RequestItem                 *request_item;
@@ -285,6 +361,7 @@ call_done(GObject *source, GAsyncResult *r, gpointer user_data)
     self         = request_item->self;
     operation    = request_item->operation;
     ifindex      = request_item->ifindex;
+    argument     = g_variant_ref(request_item->argument);
     _request_item_unref(request_item);
 
     priv = NM_DNS_SYSTEMD_RESOLVED_GET_PRIVATE(self);
@@ -311,9 +388,13 @@ call_done(GObject *source, GAsyncResult *r, gpointer user_data)
             }
         }
         priv->send_updates_warn_ratelimited = FALSE;
+        _sent_item_set(self, operation, ifindex, argument);
         goto out_dec_pending;
     }
 
+    /* we don't know what systemd-resolved has now. Send it again next time. */
+    _sent_item_set(self, operation, ifindex, NULL);
+
     if (nm_g_error_matches(error, G_DBUS_ERROR, G_DBUS_ERROR_UNKNOWN_METHOD)) {
         if (operation == DBUS_OP_SET_LINK_DEFAULT_ROUTE) {
             if (priv->has_set_link_default_route == NM_TERNARY_DEFAULT) {
@@ -352,6 +433,10 @@ call_done(GObject *source, GAsyncResult *r, gpointer user_data)
     _NMLOG(log_level, "send-updates %s@%d failed: %s", operation, ifindex, error->message);
 
 out_dec_pending:
+    /* Our call still counts as pending, which keeps @self alive while
+     * we send the next requests. */
+    _send_updates_continue(self);
+
     nm_assert(priv->n_pending > 0);
     if (--priv->n_pending <= 0) {
         _update_pending_maybe_changed(self);
@@ -473,6 +558,7 @@ free_pending_updates(NMDnsSystemdResolved *self)
         c_list_unlink(&request_item->request_queue_lst);
         _request_item_unref(request_item);
     }
+    priv->request_queue_send_next = NULL;
 }
 
 static gboolean
@@ -723,36 +809,26 @@ ensure_resolved_running(NMDnsSystemdResolved *self)
 }
 
 static void
-send_updates(NMDnsSystemdResolved *self)
+_send_updates_continue(NMDnsSystemdResolved *self)
 {
-    NMDnsSystemdResolvedPrivate       *priv = NM_DNS_SYSTEMD_RESOLVED_GET_PRIVATE(self);
-    RequestItem                       *request_item;
-    NMDnsSystemdResolvedResolveHandle *handle;
-
-    if (!priv->send_updates_waiting) {
-        /* nothing to do. */
-        return;
-    }
+    NMDnsSystemdResolvedPrivate *priv = NM_DNS_SYSTEMD_RESOLVED_GET_PRIVATE(self);
 
-    if (ensure_resolved_running(self) != NM_TERNARY_TRUE)
+    if (!priv->dbus_owner)
         return;
 
-    nm_clear_g_cancellable(&priv->cancellable);
-
-    if (c_list_is_empty(&priv->request_queue_lst_head)) {
-        _LOGT("send-updates: no requests to send");
-        priv->send_updates_waiting = FALSE;
-        goto start_resolve;
-    }
-
-    priv->cancellable = g_cancellable_new();
-
-    priv->send_updates_waiting = FALSE;
+    /* Send the queued requests in order, but don't flood systemd-resolved
+     * with hundreds of calls at once. Each completed call sends the next one. */
+    while (priv->request_queue_send_next && priv->n_pending < SEND_UPDATES_MAX_PENDING) {
+        gs_free char *ss = NULL;
+        RequestItem  *request_item;
+        SentItem     *sent_item;
 
-    _LOGT("send-updates: start %zu requests", c_list_length(&priv->request_queue_lst_head));
+        request_item =
+            c_list_entry(priv->request_queue_send_next, RequestItem, request_queue_lst);
 
-    c_list_for_each_entry (request_item, &priv->request_queue_lst_head, request_queue_lst) {
-        gs_free char *ss = NULL;
+        priv->request_queue_send_next = request_item->request_queue_lst.next;
+        if (priv->request_queue_send_next == &priv->request_queue_lst_head)
+            priv->request_queue_send_next = NULL;
 
         if ((request_item->operation == DBUS_OP_SET_LINK_DEFAULT_ROUTE
              && priv->has_set_link_default_route == NM_TERNARY_FALSE)
@@ -766,12 +842,25 @@ send_updates(NMDnsSystemdResolved *self)
             continue;
         }
 
+        sent_item = g_hash_table_lookup(priv->sent_idx,
+                                        &((SentItem) {
+                                            .operation = request_item->operation,
+                                            .ifindex   = request_item->ifindex,
+                                        }));
+        if (sent_item && g_variant_equal(sent_item->argument, request_item->argument)) {
+            /* systemd-resolved already has this value. */
+            continue;
+        }
+
+        /* Until the call succeeds, we don't know which value systemd-resolved has. */
+        _sent_item_set(self, request_item->operation, request_item->ifindex, NULL);
+
         _LOGT("send-updates: %s ( %s )",
               request_item->operation,
               (ss = g_variant_print(request_item->argument, FALSE)));
 
         if (priv->n_pending++ == 0) {
-            /* We are inside send_updates(). All callers are already calling
+            /* We are inside send_updates() or call_done(). All callers are already calling
              * _update_pending_maybe_changed() afterwards. */
             g_object_ref(self);
         }
@@ -789,6 +878,38 @@ send_updates(NMDnsSystemdResolved *self)
                                call_done,
                                _request_item_ref(request_item));
     }
+}
+
+static void
+send_updates(NMDnsSystemdResolved *self)
+{
+    NMDnsSystemdResolvedPrivate       *priv = NM_DNS_SYSTEMD_RESOLVED_GET_PRIVATE(self);
+    NMDnsSystemdResolvedResolveHandle *handle;
+
+    if (!priv->send_updates_waiting) {
+        /* nothing to do. */
+        return;
+    }
+
+    if (ensure_resolved_running(self) != NM_TERNARY_TRUE)
+        return;
+
+    nm_clear_g_cancellable(&priv->cancellable);
+
+    if (c_list_is_empty(&priv->request_queue_lst_head)) {
+        _LOGT("send-updates: no requests to send");
+        priv->send_updates_waiting = FALSE;
+        goto start_resolve;
+    }
+
+    priv->cancellable = g_cancellable_new();
+
+    priv->send_updates_waiting = FALSE;
+
+    _LOGT("send-updates: start %zu requests", c_list_length(&priv->request_queue_lst_head));
+
+    priv->request_queue_send_next = priv->request_queue_lst_head.next;
+    _send_updates_continue(self);
 
 start_resolve:
     c_list_for_each_entry (handle, &priv->handle_lst_head, handle_lst) {
@@ -925,6 +1046,9 @@ name_owner_changed(NMDnsSystemdResolved *self, const char *owner)
     nm_clear_g_cancellable(&priv->service_start_cancellable);
     nm_strdup_reset(&priv->dbus_owner, owner);
 
+    /* a new instance of systemd-resolved knows nothing about our links. */
+    g_hash_table_remove_all(priv->sent_idx);
+
     if (owner) {
         priv->try_start_blocked    = FALSE;
         priv->send_updates_waiting = TRUE;
@@ -1297,6 +1421,8 @@ nm_dns_systemd_resolved_init(NMDnsSystemdResolved *self)
     c_list_init(&priv->request_queue_lst_head);
     c_list_init(&priv->handle_lst_head);
     priv->dirty_interfaces = g_hash_table_new(nm_direct_hash, NULL);
+    priv->sent_idx =
+        g_hash_table_new_full(_sent_item_hash, _sent_item_equal, _sent_item_free, NULL);
 
     priv->dbus_connection = nm_g_object_ref(NM_MAIN_DBUS_CONNECTION_GET);
     if (!priv->dbus_connection) {
@@ -1337,6 +1463,7 @@ dispose(GObject *object)
 
     g_clear_object(&priv->dbus_connection);
     nm_clear_pointer(&priv->dirty_interfaces, g_hash_table_destroy);
+    nm_clear_pointer(&priv->sent_idx, g_hash_table_destroy);
 
     G_OBJECT_CLASS(nm_dns_systemd_resolved_parent_class)->dispose(object);
 }
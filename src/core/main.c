@@ -36,6 +36,8 @@
 #include "dns/nm-dns-manager.h"
 #include "libnm-systemd-core/nm-sd.h"
 #include "nm-netns.h"
+#include "nm-perf.h"
+#include "nm-startup-trace.h"
 
 #if !defined(NM_DIST_VERSION)
 #define NM_DIST_VERSION VERSION
@@ -78,10 +80,12 @@ _init_nm_debug(NMConfig *config)
     enum {
         D_RLIMIT_CORE    = (1 << 0),
         D_FATAL_WARNINGS = (1 << 1),
+        D_STARTUP_TRACE  = (1 << 2),
     };
     GDebugKey keys[] = {
         {"RLIMIT_CORE", D_RLIMIT_CORE},
         {"fatal-warnings", D_FATAL_WARNINGS},
+        {"startup-trace", D_STARTUP_TRACE},
     };
     guint       flags;
     const char *env = getenv("NM_DEBUG");
@@ -109,6 +113,9 @@ _init_nm_debug(NMConfig *config)
 
     if (NM_FLAGS_HAS(flags, D_FATAL_WARNINGS))
         _set_g_fatal_warnings();
+
+    if (NM_FLAGS_HAS(flags, D_STARTUP_TRACE))
+        nm_startup_trace_start();
 }
 
 void
@@ -295,6 +302,8 @@ main(int argc, char *argv[])
     const char *const      *warnings;
     int                     errsv;
     gboolean                has_logging = FALSE;
+    gint64                  config_start_nsec;
+    gint64                  config_end_nsec;
 
     _nm_utils_is_manager_process = TRUE;
 
@@ -372,6 +381,7 @@ main(int argc, char *argv[])
     }
 
     /* Read the config file and CLI overrides */
+    config_start_nsec = nm_utils_get_monotonic_timestamp_nsec();
     config = nm_config_setup(config_cli, CONFIG_ATOMIC_SECTION_PREFIXES, &error);
     nm_config_cmd_line_options_free(config_cli);
     config_cli = NULL;
@@ -380,8 +390,12 @@ main(int argc, char *argv[])
         exit(1);
     }
 
+    config_end_nsec = nm_utils_get_monotonic_timestamp_nsec();
+
     _init_nm_debug(config);
 
+    nm_startup_trace_span("manager", "read config", config_start_nsec, config_end_nsec);
+
     /* Initialize logging from config file *only* if not explicitly
      * specified by commandline.
      */
@@ -453,6 +467,18 @@ main(int argc, char *argv[])
         nm_clear_g_free(&bad_domains);
     }
 
+    {
+        gs_free_error GError *error_rate_limit = NULL;
+
+        if (!nm_logging_set_rate_limit(
+                nm_config_data_get_logging_rate_limit(nm_config_get_data_orig(config)),
+                &error_rate_limit)) {
+            nm_log_warn(LOGD_CORE,
+                        "config: invalid logging rate limit: %s",
+                        error_rate_limit->message);
+        }
+    }
+
     warnings = nm_config_get_warnings(config);
     for (; warnings && *warnings; warnings++)
         nm_log_warn(LOGD_CORE, "config: %s", *warnings);
@@ -475,12 +501,51 @@ main(int argc, char *argv[])
 
     nm_linux_platform_setup();
 
+    {
+        const guint32 *tables;
+        guint          n_tables;
+
+        tables = nm_config_data_get_tracked_route_tables(nm_config_get_data_orig(config),
+                                                         &n_tables);
+        if (n_tables > 0)
+            nm_platform_ip_route_set_tracked_tables(NM_PLATFORM_GET, tables, n_tables);
+
+        nm_platform_netlink_set_rcvbuf_max(
+            NM_PLATFORM_GET,
+            nm_config_data_get_netlink_rcvbuf_max(nm_config_get_data_orig(config)));
+
+        nm_platform_trace_set_size(
+            NM_PLATFORM_GET,
+            nm_config_data_get_logging_platform_trace_size(nm_config_get_data_orig(config)));
+    }
+
+    nm_utils_low_wakeup_set(nm_config_data_get_value_boolean(nm_config_get_data_orig(config),
+                                                             NM_CONFIG_KEYFILE_GROUP_MAIN,
+                                                             NM_CONFIG_KEYFILE_KEY_MAIN_LOW_WAKEUP,
+                                                             FALSE));
+
     NM_UTILS_KEEP_ALIVE(config, nm_netns_get(), "NMConfig-depends-on-NMNetns");
 
     nm_auth_manager_setup(nm_config_data_get_main_auth_polkit(nm_config_get_data_orig(config)));
 
     manager = nm_manager_setup();
 
+    nm_dbus_manager_set_notify_delay(
+        nm_dbus_manager_get(),
+        nm_config_data_get_value_int64(nm_config_get_data_orig(config),
+                                       NM_CONFIG_KEYFILE_GROUP_MAIN,
+                                       NM_CONFIG_KEYFILE_KEY_MAIN_DBUS_NOTIFY_DELAY,
+                                       10,
+                                       0,
+                                       1000,
+                                       0));
+
+    if (nm_config_data_get_value_boolean(nm_config_get_data_orig(config),
+                                         NM_CONFIG_KEYFILE_GROUP_MAIN,
+                                         NM_CONFIG_KEYFILE_KEY_MAIN_DBUS_LAZY_EXPORT,
+                                         FALSE))
+        nm_dbus_manager_set_lazy_subtree(nm_dbus_manager_get(), NM_DBUS_PATH_SETTINGS);
+
     nm_dbus_manager_start(nm_dbus_manager_get(), nm_manager_dbus_set_property_handle, manager);
 
     g_signal_connect(manager,
@@ -516,6 +581,8 @@ main(int argc, char *argv[])
     if (configure_and_quit == FALSE) {
         sd_id = nm_sd_event_attach_default();
 
+        nm_perf_wakeups_install();
+
         g_main_loop_run(main_loop);
     }
 
@@ -11,6 +11,7 @@
 #include <stdlib.h>
 
 #include "libnm-glib-aux/nm-random-utils.h"
+#include "libnm-glib-aux/nm-timer-queue.h"
 #include "libnm-platform/nm-platform-utils.h"
 #include "libnm-platform/nm-platform.h"
 #include "libnm-platform/nmp-netns.h"
@@ -29,6 +30,10 @@
 #define NM_NDISC_PRE_EXPIRY_TIME_MSEC         60000
 #define NM_NDISC_PRE_EXPIRY_MIN_LIFETIME_MSEC 120000
 
+/* When an RA only extends lifetimes, delay notifying about it by up to this long
+ * (but never longer than half of the shortest lifetime that we last notified). */
+#define NM_NDISC_LIFETIME_UPDATE_MAX_DELAY_MSEC 60000
+
 #define _SIZE_MAX_GATEWAYS    100u
 #define _SIZE_MAX_ADDRESSES   100u
 #define _SIZE_MAX_ROUTES      1000u
@@ -56,7 +61,19 @@ struct _NMNDiscPrivate {
 
     GSource *solicit_timer_source;
 
-    GSource *timeout_expire_source;
+    NMTimerQueueEntry timeout_expire;
+
+    struct {
+        /* The hash of the data without lifetimes, the earliest expiry and
+         * the time of the last CONFIG_RECEIVED signal. */
+        guint64 hash;
+        gint64  expiry_msec;
+        gint64  emit_msec;
+
+        /* Changes that only extended lifetimes and were not yet notified. */
+        NMNDiscConfigMap changed;
+        GSource         *source;
+    } lft_update;
 
     NMUtilsIPv6IfaceId iid;
     gboolean           iid_is_token;
@@ -90,7 +107,7 @@ G_DEFINE_TYPE(NMNDisc, nm_ndisc, G_TYPE_OBJECT)
 /*****************************************************************************/
 
 static void     _config_changed_log(NMNDisc *ndisc, NMNDiscConfigMap changed);
-static gboolean timeout_expire_cb(gpointer user_data);
+static void timeout_expire_cb(NMTimerQueueEntry *entry, gpointer user_data);
 
 /*****************************************************************************/
 
@@ -422,6 +439,77 @@ _data_complete(NMNDiscDataInternal *data)
     return &data->public;
 }
 
+static guint64
+_data_hash_without_lifetimes(const NMNDiscDataInternal *data,
+                             gint64                     now_msec,
+                             gint64                    *out_expiry_msec)
+{
+    NMHashState h;
+    gint64      expiry_msec = NM_NDISC_EXPIRY_INFINITY;
+    guint       i;
+
+    nm_hash_init(&h, 1183372291u);
+    nm_hash_update_vals(&h,
+                        data->public.dhcp_level,
+                        data->public.mtu,
+                        data->public.hop_limit,
+                        data->public.reachable_time_ms,
+                        data->public.retrans_timer_ms);
+
+    for (i = 0; i < data->gateways->len; i++) {
+        const NMNDiscGateway *item = &nm_g_array_index(data->gateways, NMNDiscGateway, i);
+
+        nm_hash_update_valp(&h, &item->address);
+        nm_hash_update_val(&h, item->preference);
+        expiry_msec = NM_MIN(expiry_msec, item->expiry_msec);
+    }
+    nm_hash_update_val(&h, data->gateways->len);
+
+    for (i = 0; i < data->addresses->len; i++) {
+        const NMNDiscAddress *item = &nm_g_array_index(data->addresses, NMNDiscAddress, i);
+
+        nm_hash_update_valp(&h, &item->address);
+        nm_hash_update_val(&h, item->dad_counter);
+        expiry_msec = NM_MIN(expiry_msec, item->expiry_msec);
+        /* Whether the address is deprecated matters right away. */
+        if (item->expiry_preferred_msec <= now_msec)
+            nm_hash_update_val(&h, (guint8) 1);
+        else
+            expiry_msec = NM_MIN(expiry_msec, item->expiry_preferred_msec);
+    }
+    nm_hash_update_val(&h, data->addresses->len);
+
+    for (i = 0; i < data->routes->len; i++) {
+        const NMNDiscRoute *item = &nm_g_array_index(data->routes, NMNDiscRoute, i);
+
+        nm_hash_update_valp(&h, &item->network);
+        nm_hash_update_valp(&h, &item->gateway);
+        nm_hash_update_vals(&h, item->preference, item->plen);
+        nm_hash_update_bool(&h, item->on_link);
+        expiry_msec = NM_MIN(expiry_msec, item->expiry_msec);
+    }
+    nm_hash_update_val(&h, data->routes->len);
+
+    for (i = 0; i < data->dns_servers->len; i++) {
+        const NMNDiscDNSServer *item = &nm_g_array_index(data->dns_servers, NMNDiscDNSServer, i);
+
+        nm_hash_update_valp(&h, &item->address);
+        expiry_msec = NM_MIN(expiry_msec, item->expiry_msec);
+    }
+    nm_hash_update_val(&h, data->dns_servers->len);
+
+    for (i = 0; i < data->dns_domains->len; i++) {
+        const NMNDiscDNSDomain *item = &nm_g_array_index(data->dns_domains, NMNDiscDNSDomain, i);
+
+        nm_hash_update_str(&h, item->domain);
+        expiry_msec = NM_MIN(expiry_msec, item->expiry_msec);
+    }
+    nm_hash_update_val(&h, data->dns_domains->len);
+
+    *out_expiry_msec = expiry_msec;
+    return nm_hash_complete_u64(&h);
+}
+
 static void
 nm_ndisc_emit_config_change(NMNDisc *self, NMNDiscConfigMap changed)
 {
@@ -429,6 +517,15 @@ nm_ndisc_emit_config_change(NMNDisc *self, NMNDiscConfigMap changed)
     nm_auto_unref_l3cd const NML3ConfigData *l3cd = NULL;
     const NMNDiscData                       *rdata;
 
+    changed |= priv->lft_update.changed;
+    priv->lft_update.changed = NM_NDISC_CONFIG_NONE;
+    nm_clear_g_source_inst(&priv->lft_update.source);
+
+    priv->lft_update.emit_msec = nm_utils_get_monotonic_timestamp_msec();
+    priv->lft_update.hash      = _data_hash_without_lifetimes(&priv->rdata,
+                                                         priv->lft_update.emit_msec,
+                                                         &priv->lft_update.expiry_msec);
+
     _config_changed_log(self, changed);
 
     rdata = _data_complete(&NM_NDISC_GET_PRIVATE(self)->rdata),
@@ -446,6 +543,56 @@ nm_ndisc_emit_config_change(NMNDisc *self, NMNDiscConfigMap changed)
     g_signal_emit(self, signals[CONFIG_RECEIVED], 0, rdata, (guint) changed, priv->l3cd);
 }
 
+static gboolean
+_lifetime_update_timeout_cb(gpointer user_data)
+{
+    NMNDisc        *ndisc = user_data;
+    NMNDiscPrivate *priv  = NM_NDISC_GET_PRIVATE(ndisc);
+
+    nm_clear_g_source_inst(&priv->lft_update.source);
+    nm_ndisc_emit_config_change(ndisc, NM_NDISC_CONFIG_NONE);
+    return G_SOURCE_CONTINUE;
+}
+
+/* With frequent RAs, most of them only extend the lifetimes of what we already
+ * have. Each notification makes the device commit a new configuration, so we
+ * delay notifying about such changes. We still notify early enough, so that no
+ * lifetime that we notified before expires. */
+static gboolean
+_lifetime_update_defer(NMNDisc *ndisc, gint64 now_msec, NMNDiscConfigMap changed)
+{
+    NMNDiscPrivate *priv = NM_NDISC_GET_PRIVATE(ndisc);
+    gint64          expiry_msec;
+    gint64          due_msec;
+
+    if (priv->lft_update.emit_msec == 0)
+        return FALSE;
+
+    if (_data_hash_without_lifetimes(&priv->rdata, now_msec, &expiry_msec)
+        != priv->lft_update.hash)
+        return FALSE;
+
+    if (expiry_msec < priv->lft_update.expiry_msec) {
+        /* a lifetime got shorter. */
+        return FALSE;
+    }
+
+    due_msec = priv->lft_update.emit_msec
+               + NM_MIN((gint64) NM_NDISC_LIFETIME_UPDATE_MAX_DELAY_MSEC,
+                        (priv->lft_update.expiry_msec - priv->lft_update.emit_msec) / 2);
+    if (due_msec <= now_msec)
+        return FALSE;
+
+    priv->lft_update.changed |= changed;
+    if (!priv->lft_update.source) {
+        _LOGD("router-data: only lifetimes changed, notify in %.3f seconds",
+              ((double) (due_msec - now_msec)) / 1000);
+        priv->lft_update.source =
+            nm_g_timeout_add_source(due_msec - now_msec, _lifetime_update_timeout_cb, ndisc);
+    }
+    return TRUE;
+}
+
 /*****************************************************************************/
 
 gboolean
@@ -1277,7 +1424,11 @@ nm_ndisc_stop(NMNDisc *ndisc)
     nm_clear_g_source_inst(&priv->ra_timeout_source);
     nm_clear_g_source(&priv->send_ra_id);
     nm_clear_g_free(&priv->last_error);
-    nm_clear_g_source_inst(&priv->timeout_expire_source);
+    nm_timer_queue_cancel(&priv->timeout_expire);
+
+    nm_clear_g_source_inst(&priv->lft_update.source);
+    priv->lft_update.changed   = NM_NDISC_CONFIG_NONE;
+    priv->lft_update.emit_msec = 0;
 
     priv->solicit_retransmit_time_msec = 0;
     nm_clear_g_source_inst(&priv->solicit_timer_source);
@@ -1605,33 +1756,25 @@ check_timestamps(NMNDisc *ndisc, gint64 now_msec, NMNDiscConfigMap changed)
 
     nm_assert(next_msec > now_msec);
 
-    nm_clear_g_source_inst(&priv->timeout_expire_source);
-
-    if (next_msec == NM_NDISC_EXPIRY_INFINITY)
+    if (next_msec == NM_NDISC_EXPIRY_INFINITY) {
+        nm_timer_queue_cancel(&priv->timeout_expire);
         _LOGD("router-data: next lifetime expiration will happen: never");
-    else {
-        const gint64 timeout_msec = NM_MIN(next_msec - now_msec, ((gint64) G_MAXINT32));
-        const guint  TIMEOUT_APPROX_THRESHOLD_SEC = 10000;
-
-        _LOGD("router-data: next lifetime expiration will happen: in %s%.3f seconds",
-              (timeout_msec / 1000) >= TIMEOUT_APPROX_THRESHOLD_SEC ? " about" : "",
-              ((double) timeout_msec) / 1000);
+    } else {
+        /* The expiries of all NDisc instances share one timer. */
+        _LOGD("router-data: next lifetime expiration will happen: in %.3f seconds",
+              ((double) (next_msec - now_msec)) / 1000);
 
-        priv->timeout_expire_source = nm_g_timeout_add_source_approx(timeout_msec,
-                                                                     TIMEOUT_APPROX_THRESHOLD_SEC,
-                                                                     timeout_expire_cb,
-                                                                     ndisc);
+        nm_timer_queue_schedule(&priv->timeout_expire, next_msec, timeout_expire_cb, ndisc);
     }
 
-    if (changed != NM_NDISC_CONFIG_NONE)
+    if (changed != NM_NDISC_CONFIG_NONE && !_lifetime_update_defer(ndisc, now_msec, changed))
         nm_ndisc_emit_config_change(ndisc, changed);
 }
 
-static gboolean
-timeout_expire_cb(gpointer user_data)
+static void
+timeout_expire_cb(NMTimerQueueEntry *entry, gpointer user_data)
 {
     check_timestamps(user_data, nm_utils_get_monotonic_timestamp_msec(), NM_NDISC_CONFIG_NONE);
-    return G_SOURCE_CONTINUE;
 }
 
 /* Calculate the earliest time where some part of the advertised data is about
@@ -1923,6 +2066,8 @@ nm_ndisc_init(NMNDisc *ndisc)
     rdata->dns_domains = g_array_new(FALSE, FALSE, sizeof(NMNDiscDNSDomain));
     g_array_set_clear_func(rdata->dns_domains, dns_domain_free);
     priv->rdata.public.hop_limit = 64;
+
+    nm_timer_queue_entry_init(&priv->timeout_expire);
 }
 
 static void
@@ -1936,7 +2081,8 @@ dispose(GObject *object)
     nm_clear_g_source(&priv->send_ra_id);
     nm_clear_g_free(&priv->last_error);
 
-    nm_clear_g_source_inst(&priv->timeout_expire_source);
+    nm_timer_queue_cancel(&priv->timeout_expire);
+    nm_clear_g_source_inst(&priv->lft_update.source);
 
     G_OBJECT_CLASS(nm_ndisc_parent_class)->dispose(object);
 }
@@ -21,6 +21,10 @@
 #define CANCELLATION_ID_PREFIX  "cancellation-id-"
 #define CANCELLATION_TIMEOUT_MS 5000
 
+/* How long polkit results for non-interactive requests are reused. */
+#define AUTH_CACHE_TIMEOUT_MSEC 5000
+#define AUTH_CACHE_MAX_SIZE     1000
+
 /*****************************************************************************/
 
 NM_GOBJECT_PROPERTIES_DEFINE_BASE(PROP_POLKIT_ENABLED, );
@@ -40,6 +44,10 @@ typedef struct {
     guint64          call_numid_counter;
     guint            changed_id;
     guint            name_owner_changed_id;
+    GHashTable      *auth_cache;
+    guint64          auth_cache_hits;
+    guint64          auth_cache_misses;
+    guint            auth_cache_generation;
     bool             disposing : 1;
     bool             shutting_down : 1;
     bool             got_name_owner : 1;
@@ -125,9 +133,134 @@ nm_auth_manager_get_polkit_enabled(NMAuthManager *self)
 
 /*****************************************************************************/
 
+typedef struct {
+    const char *dbus_sender;
+    const char *action_id;
+    gint64      expiry_msec;
+    gulong      pid;
+    gulong      uid;
+    bool        is_authorized : 1;
+    bool        is_challenge : 1;
+    char        strings[];
+} AuthCacheEntry;
+
+static AuthCacheEntry *
+_auth_cache_entry_new(NMAuthSubject *subject, const char *action_id)
+{
+    AuthCacheEntry *entry;
+    const char     *dbus_sender;
+    gsize           l_dbus_sender;
+    gsize           l_action_id;
+
+    /* The unique D-Bus name of the sender is never reused, so together with
+     * the PID it identifies the subject. */
+    dbus_sender = nm_auth_subject_get_unix_process_dbus_sender(subject);
+    if (!dbus_sender)
+        return NULL;
+
+    l_dbus_sender = strlen(dbus_sender) + 1;
+    l_action_id   = strlen(action_id) + 1;
+
+    entry = g_malloc(sizeof(AuthCacheEntry) + l_dbus_sender + l_action_id);
+
+    entry->pid           = nm_auth_subject_get_unix_process_pid(subject);
+    entry->uid           = nm_auth_subject_get_unix_process_uid(subject);
+    entry->expiry_msec   = 0;
+    entry->is_authorized = FALSE;
+    entry->is_challenge  = FALSE;
+    entry->dbus_sender   = memcpy(&entry->strings[0], dbus_sender, l_dbus_sender);
+    entry->action_id     = memcpy(&entry->strings[l_dbus_sender], action_id, l_action_id);
+    return entry;
+}
+
+static guint
+_auth_cache_entry_hash(gconstpointer ptr)
+{
+    const AuthCacheEntry *entry = ptr;
+    NMHashState           h;
+
+    nm_hash_init(&h, 1702613101u);
+    nm_hash_update_vals(&h, entry->pid, entry->uid);
+    nm_hash_update_str(&h, entry->dbus_sender);
+    nm_hash_update_str(&h, entry->action_id);
+    return nm_hash_complete(&h);
+}
+
+static gboolean
+_auth_cache_entry_equal(gconstpointer a, gconstpointer b)
+{
+    const AuthCacheEntry *entry_a = a;
+    const AuthCacheEntry *entry_b = b;
+
+    return entry_a->pid == entry_b->pid && entry_a->uid == entry_b->uid
+           && nm_streq(entry_a->dbus_sender, entry_b->dbus_sender)
+           && nm_streq(entry_a->action_id, entry_b->action_id);
+}
+
+static const AuthCacheEntry *
+_auth_cache_lookup(NMAuthManager *self, const AuthCacheEntry *needle)
+{
+    NMAuthManagerPrivate *priv = NM_AUTH_MANAGER_GET_PRIVATE(self);
+    AuthCacheEntry       *entry;
+
+    entry = g_hash_table_lookup(priv->auth_cache, needle);
+    if (entry && entry->expiry_msec <= nm_utils_get_monotonic_timestamp_msec()) {
+        g_hash_table_remove(priv->auth_cache, entry);
+        entry = NULL;
+    }
+
+    if (entry)
+        priv->auth_cache_hits++;
+    else
+        priv->auth_cache_misses++;
+    return entry;
+}
+
+static void
+_auth_cache_add(NMAuthManager  *self,
+                AuthCacheEntry *entry,
+                gboolean        is_authorized,
+                gboolean        is_challenge)
+{
+    NMAuthManagerPrivate *priv = NM_AUTH_MANAGER_GET_PRIVATE(self);
+
+    entry->is_authorized = is_authorized;
+    entry->is_challenge  = is_challenge;
+    entry->expiry_msec   = nm_utils_get_monotonic_timestamp_msec() + AUTH_CACHE_TIMEOUT_MSEC;
+
+    /* Entries are short-lived. Instead of tracking their age, just start
+     * over when the cache gets too large. */
+    if (g_hash_table_size(priv->auth_cache) >= AUTH_CACHE_MAX_SIZE)
+        g_hash_table_remove_all(priv->auth_cache);
+
+    g_hash_table_add(priv->auth_cache, entry);
+}
+
+static void
+_auth_cache_flush(NMAuthManager *self)
+{
+    NMAuthManagerPrivate *priv = NM_AUTH_MANAGER_GET_PRIVATE(self);
+
+    /* Also invalidate the results of requests that are still pending. */
+    priv->auth_cache_generation++;
+
+    if (g_hash_table_size(priv->auth_cache) == 0)
+        return;
+
+    _LOGD("auth-cache: flush %u entries (hits %" G_GUINT64_FORMAT ", misses %" G_GUINT64_FORMAT
+          ")",
+          g_hash_table_size(priv->auth_cache),
+          priv->auth_cache_hits,
+          priv->auth_cache_misses);
+    g_hash_table_remove_all(priv->auth_cache);
+}
+
 static void
 _emit_changed_signal(NMAuthManager *self)
 {
+    /* Authorizations might have changed. Don't reuse cached results. */
+    _auth_cache_flush(self);
+
     g_signal_emit(self, signals[CHANGED_SIGNAL], 0);
 }
 
@@ -142,9 +275,12 @@ struct _NMAuthManagerCallId {
     GCancellable                           *dbus_cancellable;
     NMAuthManagerCheckAuthorizationCallback callback;
     gpointer                                user_data;
+    AuthCacheEntry                         *cache_entry;
     guint64                                 call_numid;
     guint                                   idle_id;
+    guint                                   cache_generation;
     bool                                    idle_is_authorized : 1;
+    bool                                    idle_is_challenge : 1;
 };
 
 #define cancellation_id_to_str_a(call_numid)                     \
@@ -165,6 +301,7 @@ _call_id_free(NMAuthManagerCallId *call_id)
         return;
     }
 
+    g_free(call_id->cache_entry);
     g_object_unref(call_id->self);
     g_slice_free(NMAuthManagerCallId, call_id);
 }
@@ -260,6 +397,12 @@ _call_check_authorize_cb(GObject *proxy, GAsyncResult *res, gpointer user_data)
     if (!error) {
         g_variant_get(value, "((bb@a{ss}))", &is_authorized, &is_challenge, NULL);
         _LOG2T(call_id, "completed: authorized=%d, challenge=%d", is_authorized, is_challenge);
+        if (call_id->cache_entry && call_id->cache_generation == priv->auth_cache_generation) {
+            _auth_cache_add(self,
+                            g_steal_pointer(&call_id->cache_entry),
+                            is_authorized,
+                            is_challenge);
+        }
     } else
         _LOG2T(call_id, "completed: failed: %s", error->message);
 
@@ -271,9 +414,10 @@ _call_on_idle(gpointer user_data)
 {
     NMAuthManagerCallId *call_id = user_data;
     gboolean             is_authorized;
-    gboolean             is_challenge = FALSE;
+    gboolean             is_challenge;
 
     is_authorized    = call_id->idle_is_authorized;
+    is_challenge     = call_id->idle_is_challenge;
     call_id->idle_id = 0;
 
     _LOG2T(call_id,
@@ -358,10 +502,36 @@ nm_auth_manager_check_authorization(NMAuthManager                          *self
         call_id->idle_is_authorized = (priv->auth_polkit_mode == NM_AUTH_POLKIT_MODE_ALLOW_ALL);
         call_id->idle_id            = g_idle_add(_call_on_idle, call_id);
     } else {
-        GVariant       *parameters;
-        GVariantBuilder builder;
-        GVariant       *subject_value;
-        GVariant       *details_value;
+        const AuthCacheEntry *cached = NULL;
+        GVariant             *parameters;
+        GVariantBuilder       builder;
+        GVariant             *subject_value;
+        GVariant             *details_value;
+
+        /* Results of interactive requests are not reused. polkit might
+         * require to authenticate anew for each of them. */
+        if (flags == POLKIT_CHECK_AUTHORIZATION_FLAGS_NONE) {
+            call_id->cache_entry = _auth_cache_entry_new(subject, action_id);
+            if (call_id->cache_entry)
+                cached = _auth_cache_lookup(self, call_id->cache_entry);
+        }
+
+        if (cached) {
+            _LOG2T(call_id,
+                   "CheckAuthorization(%s), subject=%s (cached, hits %" G_GUINT64_FORMAT
+                   ", misses %" G_GUINT64_FORMAT ")",
+                   action_id,
+                   nm_auth_subject_to_string(subject, subject_buf, sizeof(subject_buf)),
+                   priv->auth_cache_hits,
+                   priv->auth_cache_misses);
+            call_id->idle_is_authorized = cached->is_authorized;
+            call_id->idle_is_challenge  = cached->is_challenge;
+            call_id->idle_id            = g_idle_add(_call_on_idle, call_id);
+            nm_clear_g_free(&call_id->cache_entry);
+            return call_id;
+        }
+
+        call_id->cache_generation = priv->auth_cache_generation;
 
         subject_value = nm_auth_subject_unix_to_polkit_gvariant(subject);
         nm_assert(g_variant_is_floating(subject_value));
@@ -602,6 +772,8 @@ nm_auth_manager_init(NMAuthManager *self)
 
     c_list_init(&priv->calls_lst_head);
     priv->auth_polkit_mode = NM_AUTH_POLKIT_MODE_ROOT_ONLY;
+    priv->auth_cache =
+        g_hash_table_new_full(_auth_cache_entry_hash, _auth_cache_entry_equal, g_free, NULL);
 }
 
 static void
@@ -717,6 +889,8 @@ dispose(GObject *object)
     g_clear_object(&priv->dbus_connection);
 
     nm_clear_g_free(&priv->name_owner);
+
+    nm_clear_pointer(&priv->auth_cache, g_hash_table_unref);
 }
 
 static void
@@ -38,6 +38,10 @@ struct _NMBondManager {
 
     GSource *reconfigure_on_idle_source;
 
+    /* The timestamp of the last _reconfigure_check(). Used to rate limit
+     * the checks when many ports change at once. */
+    gint64 reconfigure_last_msec;
+
     /* During _reconfigure_check() we remember all ifindexes that are part
      * of the current SLB bond. This is used during _link_changed_cb() to
      * figure out whether a change on the interface might be relevant to
@@ -99,6 +103,12 @@ struct _NMBondManager {
 
 /*****************************************************************************/
 
+/* When a switch reboots, all ports of the bond flap at the same time and we get
+ * a storm of link change events. The first check runs right away, but further
+ * checks within this interval get delayed, so that the changes get combined into
+ * one "nft" call. */
+#define RECONFIGURE_RATELIMIT_MSEC 200
+
 #define IP_ADDR_LEN 4
 
 #define ARP_OP_GARP 0x0001
@@ -123,6 +133,16 @@ typedef struct _nm_packed {
     char    d_ip_addr[IP_ADDR_LEN];
 } ARPPacket;
 
+/* Number of ARP packets that we pass to the kernel with one sendmmsg() call. */
+#define ARP_BATCH_SIZE 64
+
+typedef struct {
+    int                       sockfd;
+    const struct sockaddr_ll *addr;
+    guint                     len;
+    ARPPacket                 packets[ARP_BATCH_SIZE];
+} ARPBatch;
+
 /*****************************************************************************/
 
 static void _nft_call(NMBondManager     *self,
@@ -135,6 +155,8 @@ static void _bond_manager_destroy(NMBondManager *self);
 
 static void _reconfigure_check(NMBondManager *self, gboolean reapply);
 
+static void _reconfigure_check_schedule(NMBondManager *self);
+
 /*****************************************************************************/
 
 #define _NMLOG_DOMAIN      LOGD_DEVICE
@@ -453,7 +475,7 @@ out:
             nm_assert_not_reached();
         else if (!self->nft_in_progress) {
             nm_assert(!self->reconfigure_on_idle_source);
-            _reconfigure_check(self, FALSE);
+            _reconfigure_check_schedule(self);
         }
     }
 
@@ -706,6 +728,7 @@ _reconfigure_check(NMBondManager *self, gboolean reapply)
 
     self->reconfigure_check = FALSE;
     nm_clear_g_source_inst(&self->reconfigure_on_idle_source);
+    self->reconfigure_last_msec = nm_utils_get_monotonic_timestamp_msec();
 
     g_hash_table_remove_all(self->previous_ifindexes);
 
@@ -822,6 +845,33 @@ _reconfigure_check_on_idle_cb(gpointer user_data)
     return G_SOURCE_CONTINUE;
 }
 
+static void
+_reconfigure_check_schedule(NMBondManager *self)
+{
+    gint64 elapsed_msec;
+
+    nm_assert(self->reconfigure_check);
+    nm_assert(!self->nft_in_progress);
+
+    if (self->reconfigure_on_idle_source)
+        return;
+
+    elapsed_msec = nm_utils_get_monotonic_timestamp_msec() - self->reconfigure_last_msec;
+
+    if (self->reconfigure_last_msec == 0 || elapsed_msec >= RECONFIGURE_RATELIMIT_MSEC) {
+        self->reconfigure_on_idle_source =
+            nm_g_idle_add_source(_reconfigure_check_on_idle_cb, self);
+        return;
+    }
+
+    _LOGT("reconfigure: delay check by %" G_GINT64_FORMAT " msec",
+          RECONFIGURE_RATELIMIT_MSEC - elapsed_msec);
+    self->reconfigure_on_idle_source =
+        nm_g_timeout_add_source(RECONFIGURE_RATELIMIT_MSEC - elapsed_msec,
+                                _reconfigure_check_on_idle_cb,
+                                self);
+}
+
 /*****************************************************************************/
 
 static void
@@ -856,10 +906,8 @@ _link_changed_cb(NMPlatform           *platform,
 
 schedule:
     self->reconfigure_check = TRUE;
-    if (!self->nft_in_progress) {
-        self->reconfigure_on_idle_source =
-            nm_g_idle_add_source(_reconfigure_check_on_idle_cb, self);
-    }
+    if (!self->nft_in_progress)
+        _reconfigure_check_schedule(self);
 }
 
 /*****************************************************************************/
@@ -870,6 +918,61 @@ nm_bond_manager_reapply(NMBondManager *self)
     _reconfigure_check(self, TRUE);
 }
 
+static gboolean
+_arp_batch_flush(ARPBatch *batch)
+{
+    struct mmsghdr msgs[ARP_BATCH_SIZE];
+    struct iovec   iovs[ARP_BATCH_SIZE];
+    guint          sent = 0;
+    guint          i;
+
+    for (i = 0; i < batch->len; i++) {
+        iovs[i] = (struct iovec) {
+            .iov_base = &batch->packets[i],
+            .iov_len  = sizeof(batch->packets[i]),
+        };
+        msgs[i] = (struct mmsghdr) {
+            .msg_hdr =
+                {
+                    .msg_name    = (gpointer) batch->addr,
+                    .msg_namelen = sizeof(*batch->addr),
+                    .msg_iov     = &iovs[i],
+                    .msg_iovlen  = 1,
+                },
+        };
+    }
+
+    while (sent < batch->len) {
+        int r;
+
+        r = sendmmsg(batch->sockfd, &msgs[sent], batch->len - sent, 0);
+        if (r < 0) {
+            if (errno == EINTR)
+                continue;
+            return FALSE;
+        }
+        if (r == 0)
+            return FALSE;
+        sent += r;
+    }
+
+    batch->len = 0;
+    return TRUE;
+}
+
+static ARPPacket *
+_arp_batch_next(ARPBatch *batch, const ARPPacket *template)
+{
+    ARPPacket *packet;
+
+    if (batch->len == ARP_BATCH_SIZE && !_arp_batch_flush(batch))
+        return NULL;
+
+    packet  = &batch->packets[batch->len++];
+    *packet = *template;
+    return packet;
+}
+
 gboolean
 nm_bond_manager_send_arp(int                 bond_ifindex,
                          int                 bridge_ifindex,
@@ -882,7 +985,9 @@ nm_bond_manager_send_arp(int                 bond_ifindex,
         .sll_protocol = htons(ETH_P_ARP),
         .sll_ifindex  = bond_ifindex,
     };
-    ARPPacket         data = {0};
+    ARPPacket         data  = {0};
+    gs_free ARPBatch *batch = NULL;
+    ARPPacket        *packet;
     const guint8     *hwaddr;
     gsize             hwaddrlen    = 0;
     nm_auto_close int sockfd       = -1;
@@ -913,6 +1018,13 @@ nm_bond_manager_send_arp(int                 bond_ifindex,
     data.addr_len = ETH_ALEN;
     data.ip_len   = IP_ADDR_LEN;
 
+    /* With many addresses, one sendto() call per packet is slow. Queue the
+     * packets and pass them to the kernel in batches. */
+    batch         = g_new(ARPBatch, 1);
+    batch->sockfd = sockfd;
+    batch->addr   = &addr;
+    batch->len    = 0;
+
     if (announce_fdb) {
         /* if we are announcing the FDB we do a RARP, we don't set the
          * source/dest IPv4 address */
@@ -928,11 +1040,12 @@ nm_bond_manager_send_arp(int                 bond_ifindex,
         while (fdb_addrs[i] != NULL) {
             NMEtherAddr *tmp_hwaddr = fdb_addrs[i];
 
-            memcpy(data.s_hw_addr, tmp_hwaddr, ETH_ALEN);
-            memcpy(data.d_hw_addr, tmp_hwaddr, ETH_ALEN);
-            memcpy(data.s_addr, tmp_hwaddr, ETH_ALEN);
-            if (sendto(sockfd, &data, sizeof(data), 0, (struct sockaddr *) &addr, sizeof(addr)) < 0)
+            packet = _arp_batch_next(batch, &data);
+            if (!packet)
                 return FALSE;
+            memcpy(packet->s_hw_addr, tmp_hwaddr, ETH_ALEN);
+            memcpy(packet->d_hw_addr, tmp_hwaddr, ETH_ALEN);
+            memcpy(packet->s_addr, tmp_hwaddr, ETH_ALEN);
             i++;
         }
     } else {
@@ -944,14 +1057,15 @@ nm_bond_manager_send_arp(int                 bond_ifindex,
         for (int i = 0; i < addrs_len; i++) {
             const in_addr_t tmp_addr = addrs_array[i];
 
-            unaligned_write_ne32(data.s_ip_addr, tmp_addr);
-            unaligned_write_ne32(data.d_ip_addr, tmp_addr);
-            if (sendto(sockfd, &data, sizeof(data), 0, (struct sockaddr *) &addr, sizeof(addr)) < 0)
+            packet = _arp_batch_next(batch, &data);
+            if (!packet)
                 return FALSE;
+            unaligned_write_ne32(packet->s_ip_addr, tmp_addr);
+            unaligned_write_ne32(packet->d_ip_addr, tmp_addr);
         }
     }
 
-    return TRUE;
+    return _arp_batch_flush(batch);
 }
 
 /*****************************************************************************/
@@ -417,9 +417,18 @@ restore_and_activate_connection(NMCheckpoint *self, DeviceCheckpoint *dev_checkp
     }
 
     if (need_activation) {
+        gs_unref_object NMConnection *applied_clone = NULL;
+        NMConnection                 *applied;
+
         _LOGD("rollback: reactivating connection %s", nm_settings_connection_get_uuid(connection));
         subject = nm_auth_subject_new_internal();
 
+        /* The new active connection takes the applied connection and may modify it.
+         * If we share it with the (immutable) profile, hand over a copy. */
+        applied = dev_checkpoint->applied_connection;
+        if (applied == dev_checkpoint->settings_connection)
+            applied = applied_clone = nm_simple_connection_new_clone(applied);
+
         /* Disconnect the device if needed. This necessary because now
          * the manager prevents the reactivation of the same connection by
          * an internal subject. */
@@ -438,7 +447,7 @@ restore_and_activate_connection(NMCheckpoint *self, DeviceCheckpoint *dev_checkp
         if (!nm_manager_activate_connection(
                 priv->manager,
                 connection,
-                dev_checkpoint->applied_connection,
+                applied,
                 NULL,
                 dev_checkpoint->device,
                 subject,
@@ -459,15 +468,45 @@ restore_and_activate_connection(NMCheckpoint *self, DeviceCheckpoint *dev_checkp
     return TRUE;
 }
 
+static int
+_dev_checkpoint_rollback_rank(const DeviceCheckpoint *dev_checkpoint)
+{
+    NMSettingConnection *s_con;
+
+    /* Devices that only get disconnected go first, then controllers and
+     * standalone devices, then ports. */
+    if (!dev_checkpoint->applied_connection)
+        return 0;
+
+    s_con = nm_connection_get_setting_connection(dev_checkpoint->applied_connection);
+    if (s_con && nm_setting_connection_get_controller(s_con))
+        return 2;
+
+    return 1;
+}
+
+static int
+_dev_checkpoint_cmp_rollback_order(gconstpointer a, gconstpointer b, gpointer user_data)
+{
+    const DeviceCheckpoint *dev_checkpoint_a = *((const DeviceCheckpoint *const *) a);
+    const DeviceCheckpoint *dev_checkpoint_b = *((const DeviceCheckpoint *const *) b);
+
+    NM_CMP_DIRECT(_dev_checkpoint_rollback_rank(dev_checkpoint_a),
+                  _dev_checkpoint_rollback_rank(dev_checkpoint_b));
+    NM_CMP_FIELD_STR0(dev_checkpoint_a, dev_checkpoint_b, original_dev_name);
+    return 0;
+}
+
 GVariant *
 nm_checkpoint_rollback(NMCheckpoint *self)
 {
-    NMCheckpointPrivate *priv = NM_CHECKPOINT_GET_PRIVATE(self);
-    DeviceCheckpoint    *dev_checkpoint;
-    GHashTableIter       iter;
-    NMDevice            *device;
-    GVariantBuilder      builder;
-    uint                 i;
+    NMCheckpointPrivate       *priv = NM_CHECKPOINT_GET_PRIVATE(self);
+    DeviceCheckpoint          *dev_checkpoint;
+    gs_free DeviceCheckpoint **dev_checkpoints = NULL;
+    NMDevice                  *device;
+    GVariantBuilder            builder;
+    guint                      n_dev_checkpoints;
+    uint                       i;
 
     _LOGI("rollback of %s", nm_dbus_object_get_path(NM_DBUS_OBJECT(self)));
     g_variant_builder_init(&builder, G_VARIANT_TYPE("a{su}"));
@@ -493,11 +532,20 @@ nm_checkpoint_rollback(NMCheckpoint *self)
         }
     }
 
-    /* Start rolling-back each device */
-    g_hash_table_iter_init(&iter, priv->devices);
-    while (g_hash_table_iter_next(&iter, (gpointer *) &device, (gpointer *) &dev_checkpoint)) {
+    /* Start rolling-back each device. Activations only get queued here and
+     * proceed concurrently afterwards. Still, queue controllers before their
+     * ports so that ports don't have to wait for them to be activated implicitly. */
+    dev_checkpoints = (DeviceCheckpoint **) nm_utils_hash_values_to_array(
+        priv->devices,
+        _dev_checkpoint_cmp_rollback_order,
+        NULL,
+        &n_dev_checkpoints);
+    for (i = 0; i < n_dev_checkpoints; i++) {
         guint32 result = NM_ROLLBACK_RESULT_OK;
 
+        dev_checkpoint = dev_checkpoints[i];
+        device         = dev_checkpoint->device;
+
         _LOGD("rollback: restoring device %s (state %d, realized %d, explicitly unmanaged %d, "
               "connection-unsaved %d, connection-shadowed %d, connection-shadowed-owned %d)",
               dev_checkpoint->original_dev_name,
@@ -700,6 +748,7 @@ device_checkpoint_create(NMCheckpoint *self, NMDevice *device)
 {
     DeviceCheckpoint     *dev_checkpoint;
     NMConnection         *applied_connection;
+    NMConnection         *connection;
     NMSettingsConnection *settings_connection;
     const char           *path;
     NMActRequest         *act_request;
@@ -737,10 +786,19 @@ device_checkpoint_create(NMCheckpoint *self, NMDevice *device)
 
         settings_connection = nm_act_request_get_settings_connection(act_request);
         applied_connection  = nm_act_request_get_applied_connection(act_request);
-
-        dev_checkpoint->applied_connection  = nm_simple_connection_new_clone(applied_connection);
-        dev_checkpoint->settings_connection = nm_simple_connection_new_clone(
-            nm_settings_connection_get_connection(settings_connection));
+        connection          = nm_settings_connection_get_connection(settings_connection);
+
+        /* The connection of a NMSettingsConnection is never modified, it only gets
+         * replaced on update. We can keep a reference instead of a copy.
+         *
+         * The applied connection is modified in place (for example, on reapply or when
+         * receiving secrets), so we need our own copy. Unless it is identical to the
+         * profile, which is commonly the case, then we also share the profile. */
+        dev_checkpoint->settings_connection = g_object_ref(connection);
+        if (nm_connection_compare(applied_connection, connection, NM_SETTING_COMPARE_FLAG_EXACT))
+            dev_checkpoint->applied_connection = g_object_ref(connection);
+        else
+            dev_checkpoint->applied_connection = nm_simple_connection_new_clone(applied_connection);
         dev_checkpoint->ac_version_id =
             nm_active_connection_version_id_get(NM_ACTIVE_CONNECTION(act_request));
         dev_checkpoint->activation_reason =
@@ -8,6 +8,8 @@
 
 #include "nm-config-data.h"
 
+#include <linux/rtnetlink.h>
+
 #include "nm-config.h"
 #include "devices/nm-device.h"
 #include "libnm-core-intern/nm-core-internal.h"
@@ -94,6 +96,12 @@ typedef struct {
 
     int autoconnect_retries_default;
 
+    int netlink_rcvbuf_max;
+
+    guint logging_platform_trace_size;
+
+    char *logging_rate_limit;
+
     struct {
         /* from /var/lib/NetworkManager/no-auto-default.state */
         char  **arr;
@@ -104,6 +112,7 @@ typedef struct {
     } no_auto_default;
 
     GSList *ignore_carrier;
+    GSList *ignore_devices;
     GSList *assume_ipv6ll_only;
 
     char *dns_mode;
@@ -114,6 +123,11 @@ typedef struct {
     bool systemd_resolved : 1;
 
     char *iwd_config_path;
+
+    struct {
+        guint32 *tables;
+        guint    len;
+    } tracked_route_tables;
 } NMConfigDataPrivate;
 
 struct _NMConfigData {
@@ -332,6 +346,30 @@ nm_config_data_get_autoconnect_retries_default(const NMConfigData *self)
     return NM_CONFIG_DATA_GET_PRIVATE(self)->autoconnect_retries_default;
 }
 
+int
+nm_config_data_get_netlink_rcvbuf_max(const NMConfigData *self)
+{
+    g_return_val_if_fail(self, 0);
+
+    return NM_CONFIG_DATA_GET_PRIVATE(self)->netlink_rcvbuf_max;
+}
+
+guint
+nm_config_data_get_logging_platform_trace_size(const NMConfigData *self)
+{
+    g_return_val_if_fail(self, 0);
+
+    return NM_CONFIG_DATA_GET_PRIVATE(self)->logging_platform_trace_size;
+}
+
+const char *
+nm_config_data_get_logging_rate_limit(const NMConfigData *self)
+{
+    g_return_val_if_fail(self, NULL);
+
+    return NM_CONFIG_DATA_GET_PRIVATE(self)->logging_rate_limit;
+}
+
 const char *const *
 nm_config_data_get_no_auto_default(const NMConfigData *self)
 {
@@ -383,6 +421,23 @@ nm_config_data_get_iwd_config_path(const NMConfigData *self)
     return NM_CONFIG_DATA_GET_PRIVATE(self)->iwd_config_path;
 }
 
+const guint32 *
+nm_config_data_get_tracked_route_tables(const NMConfigData *self, guint *out_len)
+{
+    const NMConfigDataPrivate *priv = NM_CONFIG_DATA_GET_PRIVATE(self);
+
+    *out_len = priv->tracked_route_tables.len;
+    return priv->tracked_route_tables.tables;
+}
+
+const GSList *
+nm_config_data_get_ignore_devices(const NMConfigData *self)
+{
+    g_return_val_if_fail(NM_IS_CONFIG_DATA(self), NULL);
+
+    return NM_CONFIG_DATA_GET_PRIVATE(self)->ignore_devices;
+}
+
 gboolean
 nm_config_data_get_ignore_carrier_for_port(const NMConfigData *self,
                                            const char         *controller,
@@ -2311,6 +2366,44 @@ set_property(GObject *object, guint prop_id, const GValue *value, GParamSpec *ps
 
 /*****************************************************************************/
 
+static void
+_load_tracked_route_tables(NMConfigDataPrivate *priv)
+{
+    gs_strfreev char **strv = NULL;
+    gsize              len  = 0;
+    gsize              i;
+
+    strv = g_key_file_get_string_list(priv->keyfile,
+                                      NM_CONFIG_KEYFILE_GROUP_MAIN,
+                                      NM_CONFIG_KEYFILE_KEY_MAIN_TRACKED_ROUTE_TABLES,
+                                      &len,
+                                      NULL);
+    if (!strv || len == 0)
+        return;
+
+    priv->tracked_route_tables.tables = g_new(guint32, len);
+    for (i = 0; i < len; i++) {
+        const char *s = nm_strstrip(strv[i]);
+        gint64      table;
+
+        if (nm_streq(s, "main"))
+            table = RT_TABLE_MAIN;
+        else if (nm_streq(s, "local"))
+            table = RT_TABLE_LOCAL;
+        else if (nm_streq(s, "default"))
+            table = RT_TABLE_DEFAULT;
+        else
+            table = _nm_utils_ascii_str_to_int64(s, 0, 1, G_MAXUINT32, 0);
+
+        if (table == 0)
+            continue;
+        priv->tracked_route_tables.tables[priv->tracked_route_tables.len++] = table;
+    }
+
+    if (priv->tracked_route_tables.len == 0)
+        nm_clear_g_free(&priv->tracked_route_tables.tables);
+}
+
 static void
 nm_config_data_init(NMConfigData *self)
 {}
@@ -2348,6 +2441,26 @@ constructed(GObject *object)
     priv->autoconnect_retries_default = _nm_utils_ascii_str_to_int64(str, 10, 0, G_MAXINT32, 4);
     g_free(str);
 
+    str                      = nm_config_keyfile_get_value(priv->keyfile,
+                                      NM_CONFIG_KEYFILE_GROUP_MAIN,
+                                      NM_CONFIG_KEYFILE_KEY_MAIN_NETLINK_RCVBUF_MAX,
+                                      NM_CONFIG_GET_VALUE_NONE);
+    priv->netlink_rcvbuf_max = _nm_utils_ascii_str_to_int64(str, 10, 0, G_MAXINT32, 0);
+    g_free(str);
+
+    str = nm_config_keyfile_get_value(priv->keyfile,
+                                      NM_CONFIG_KEYFILE_GROUP_LOGGING,
+                                      NM_CONFIG_KEYFILE_KEY_LOGGING_PLATFORM_TRACE_SIZE,
+                                      NM_CONFIG_GET_VALUE_NONE);
+    priv->logging_platform_trace_size = _nm_utils_ascii_str_to_int64(str, 10, 0, 1000000, 0);
+    g_free(str);
+
+    priv->logging_rate_limit =
+        nm_config_keyfile_get_value(priv->keyfile,
+                                    NM_CONFIG_KEYFILE_GROUP_LOGGING,
+                                    NM_CONFIG_KEYFILE_KEY_LOGGING_RATE_LIMIT,
+                                    NM_CONFIG_GET_VALUE_STRIP | NM_CONFIG_GET_VALUE_NO_EMPTY);
+
     /* On missing config value, fallback to 300. On invalid value, disable connectivity checking by setting
      * the interval to zero. */
     str = g_key_file_get_string(priv->keyfile,
@@ -2388,6 +2501,10 @@ constructed(GObject *object)
                                                     NM_CONFIG_KEYFILE_GROUP_MAIN,
                                                     NM_CONFIG_KEYFILE_KEY_MAIN_IGNORE_CARRIER,
                                                     NULL);
+    priv->ignore_devices = nm_config_get_match_spec(priv->keyfile,
+                                                    NM_CONFIG_KEYFILE_GROUP_MAIN,
+                                                    NM_CONFIG_KEYFILE_KEY_MAIN_IGNORE_DEVICES,
+                                                    NULL);
     priv->assume_ipv6ll_only =
         nm_config_get_match_spec(priv->keyfile,
                                  NM_CONFIG_KEYFILE_GROUP_MAIN,
@@ -2409,6 +2526,8 @@ constructed(GObject *object)
                                           NM_CONFIG_KEYFILE_KEY_MAIN_IWD_CONFIG_PATH,
                                           NULL));
 
+    _load_tracked_route_tables(priv);
+
     G_OBJECT_CLASS(nm_config_data_parent_class)->constructed(object);
 }
 
@@ -2491,11 +2610,14 @@ finalize(GObject *gobject)
     g_free(priv->rc_manager);
 
     g_slist_free_full(priv->ignore_carrier, g_free);
+    g_slist_free_full(priv->ignore_devices, g_free);
     g_slist_free_full(priv->assume_ipv6ll_only, g_free);
 
     nm_global_dns_config_free(priv->global_dns);
 
     g_free(priv->iwd_config_path);
+    g_free(priv->logging_rate_limit);
+    g_free(priv->tracked_route_tables.tables);
 
     _match_section_infos_free(priv->connection_infos);
     _match_section_infos_free(priv->device_infos);
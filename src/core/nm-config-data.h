@@ -184,6 +184,11 @@ guint       nm_config_data_get_connectivity_timeout(const NMConfigData *config_d
 const char *nm_config_data_get_connectivity_response(const NMConfigData *config_data);
 
 int nm_config_data_get_autoconnect_retries_default(const NMConfigData *config_data);
+int nm_config_data_get_netlink_rcvbuf_max(const NMConfigData *self);
+
+guint nm_config_data_get_logging_platform_trace_size(const NMConfigData *self);
+
+const char *nm_config_data_get_logging_rate_limit(const NMConfigData *self);
 
 NMAuthPolkitMode nm_config_data_get_main_auth_polkit(const NMConfigData *config_data);
 
@@ -194,6 +199,8 @@ const char *nm_config_data_get_dns_mode(const NMConfigData *self);
 const char *nm_config_data_get_rc_manager(const NMConfigData *self);
 gboolean    nm_config_data_get_systemd_resolved(const NMConfigData *self);
 
+const GSList *nm_config_data_get_ignore_devices(const NMConfigData *self);
+
 gboolean nm_config_data_get_ignore_carrier_for_port(const NMConfigData *self,
                                                     const char         *controller,
                                                     const char         *port_type);
@@ -206,6 +213,8 @@ NMGlobalDnsConfig *nm_config_data_get_global_dns_config(const NMConfigData *self
 
 const char *nm_config_data_get_iwd_config_path(const NMConfigData *self);
 
+const guint32 *nm_config_data_get_tracked_route_tables(const NMConfigData *self, guint *out_len);
+
 extern const char *__start_connection_defaults[];
 extern const char *__stop_connection_defaults[];
 
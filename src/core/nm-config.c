@@ -9,6 +9,7 @@
 #include "nm-config.h"
 
 #include <stdio.h>
+#include <sys/stat.h>
 
 #include "nm-utils.h"
 #include "nm-dhcp-config.h"
@@ -93,6 +94,10 @@ typedef struct {
 
     char **atomic_section_prefixes;
 
+    /* A hash over the metadata of the files that make up the configuration,
+     * from when they were last read. Or zero, if unknown. */
+    guint64 config_files_stamp;
+
     /* The state. This is actually a mutable data member and it makes sense:
      * The regular config is immutable (NMConfigData) and can old be swapped
      * as a whole (via nm_config_set_values() or during reload). Thus, it can
@@ -805,6 +810,7 @@ _setting_is_device_spec(const char *group, const char *key)
 
     return _IS(NM_CONFIG_KEYFILE_GROUP_MAIN, NM_CONFIG_KEYFILE_KEY_MAIN_NO_AUTO_DEFAULT)
            || _IS(NM_CONFIG_KEYFILE_GROUP_MAIN, NM_CONFIG_KEYFILE_KEY_MAIN_IGNORE_CARRIER)
+           || _IS(NM_CONFIG_KEYFILE_GROUP_MAIN, NM_CONFIG_KEYFILE_KEY_MAIN_IGNORE_DEVICES)
            || _IS(NM_CONFIG_KEYFILE_GROUP_MAIN, NM_CONFIG_KEYFILE_KEY_MAIN_ASSUME_IPV6LL_ONLY)
            || _IS(NM_CONFIG_KEYFILE_GROUP_KEYFILE, NM_CONFIG_KEYFILE_KEY_KEYFILE_UNMANAGED_DEVICES)
            || (NM_STR_HAS_PREFIX(group, NM_CONFIG_KEYFILE_GROUPPREFIX_CONNECTION)
@@ -847,26 +853,42 @@ static const ConfigGroup config_groups[] = {
                              NM_CONFIG_KEYFILE_KEY_MAIN_AUTH_POLKIT,
                              NM_CONFIG_KEYFILE_KEY_MAIN_AUTOCONNECT_RETRIES_DEFAULT,
                              NM_CONFIG_KEYFILE_KEY_MAIN_CONFIGURE_AND_QUIT,
+                             NM_CONFIG_KEYFILE_KEY_MAIN_DBUS_LAZY_EXPORT,
+                             NM_CONFIG_KEYFILE_KEY_MAIN_DBUS_NOTIFY_DELAY,
                              NM_CONFIG_KEYFILE_KEY_MAIN_DEBUG,
                              NM_CONFIG_KEYFILE_KEY_MAIN_DHCP,
+                             NM_CONFIG_KEYFILE_KEY_MAIN_DHCP_START_RATE,
                              NM_CONFIG_KEYFILE_KEY_MAIN_DNS,
+                             NM_CONFIG_KEYFILE_KEY_MAIN_FAST_RESUME,
                              NM_CONFIG_KEYFILE_KEY_MAIN_FIREWALL_BACKEND,
                              NM_CONFIG_KEYFILE_KEY_MAIN_HOSTNAME_MODE,
                              NM_CONFIG_KEYFILE_KEY_MAIN_IGNORE_CARRIER,
+                             NM_CONFIG_KEYFILE_KEY_MAIN_IGNORE_DEVICES,
+                             NM_CONFIG_KEYFILE_KEY_MAIN_IGNORE_PORT_REPRESENTORS,
                              NM_CONFIG_KEYFILE_KEY_MAIN_IWD_CONFIG_PATH,
+                             NM_CONFIG_KEYFILE_KEY_MAIN_LOW_WAKEUP,
                              NM_CONFIG_KEYFILE_KEY_MAIN_MIGRATE_IFCFG_RH,
                              NM_CONFIG_KEYFILE_KEY_MAIN_MONITOR_CONNECTION_FILES,
+                             NM_CONFIG_KEYFILE_KEY_MAIN_NETLINK_RCVBUF_MAX,
                              NM_CONFIG_KEYFILE_KEY_MAIN_NO_AUTO_DEFAULT,
                              NM_CONFIG_KEYFILE_KEY_MAIN_PLUGINS,
+                             NM_CONFIG_KEYFILE_KEY_MAIN_PPPOE_DISCOVERY,
                              NM_CONFIG_KEYFILE_KEY_MAIN_RC_MANAGER,
-                             NM_CONFIG_KEYFILE_KEY_MAIN_SYSTEMD_RESOLVED, ),
+                             NM_CONFIG_KEYFILE_KEY_MAIN_SECRET_AGENT_CACHE_TIMEOUT,
+                             NM_CONFIG_KEYFILE_KEY_MAIN_SHARED_DHCP,
+                             NM_CONFIG_KEYFILE_KEY_MAIN_SHARED_DNS_FORWARDER,
+                             NM_CONFIG_KEYFILE_KEY_MAIN_STATE_FILES_SYNC,
+                             NM_CONFIG_KEYFILE_KEY_MAIN_SYSTEMD_RESOLVED,
+                             NM_CONFIG_KEYFILE_KEY_MAIN_TRACKED_ROUTE_TABLES, ),
     },
     {
         .group = NM_CONFIG_KEYFILE_GROUP_LOGGING,
         .keys  = NM_MAKE_STRV(NM_CONFIG_KEYFILE_KEY_LOGGING_AUDIT,
                              NM_CONFIG_KEYFILE_KEY_LOGGING_BACKEND,
                              NM_CONFIG_KEYFILE_KEY_LOGGING_DOMAINS,
-                             NM_CONFIG_KEYFILE_KEY_LOGGING_LEVEL, ),
+                             NM_CONFIG_KEYFILE_KEY_LOGGING_LEVEL,
+                             NM_CONFIG_KEYFILE_KEY_LOGGING_PLATFORM_TRACE_SIZE,
+                             NM_CONFIG_KEYFILE_KEY_LOGGING_RATE_LIMIT, ),
     },
     {
         .group = NM_CONFIG_KEYFILE_GROUP_CONNECTIVITY,
@@ -878,7 +900,8 @@ static const ConfigGroup config_groups[] = {
     },
     {
         .group = NM_CONFIG_KEYFILE_GROUP_KEYFILE,
-        .keys  = NM_MAKE_STRV(NM_CONFIG_KEYFILE_KEY_KEYFILE_HOSTNAME,
+        .keys  = NM_MAKE_STRV(NM_CONFIG_KEYFILE_KEY_KEYFILE_CONNECTION_CACHE,
+                             NM_CONFIG_KEYFILE_KEY_KEYFILE_HOSTNAME,
                              NM_CONFIG_KEYFILE_KEY_KEYFILE_PATH,
                              NM_CONFIG_KEYFILE_KEY_KEYFILE_RENAME,
                              NM_CONFIG_KEYFILE_KEY_KEYFILE_UNMANAGED_DEVICES, ),
@@ -890,7 +913,8 @@ static const ConfigGroup config_groups[] = {
     {
         .group     = NM_CONFIG_KEYFILE_GROUPPREFIX_DEVICE,
         .is_prefix = TRUE,
-        .keys      = NM_MAKE_STRV(NM_CONFIG_KEYFILE_KEY_DEVICE_CARRIER_WAIT_TIMEOUT,
+        .keys      = NM_MAKE_STRV(NM_CONFIG_KEYFILE_KEY_DEVICE_AUTOCONNECT_QUEUE_PRIORITY,
+                             NM_CONFIG_KEYFILE_KEY_DEVICE_CARRIER_WAIT_TIMEOUT,
                              NM_CONFIG_KEYFILE_KEY_DEVICE_IGNORE_CARRIER,
                              NM_CONFIG_KEYFILE_KEY_DEVICE_CHECK_CONNECTIVITY,
                              NM_CONFIG_KEYFILE_KEY_DEVICE_MANAGED,
@@ -1311,6 +1335,107 @@ _confs_to_description(GString *str, const GPtrArray *confs, const char *name)
         g_string_append(str, "}");
 }
 
+static const char *
+_get_run_config_dir(const char *config_dir, const char *system_config_dir)
+{
+    if (("" RUN_CONFIG_DIR)[0] == '/' && !nm_streq(RUN_CONFIG_DIR, system_config_dir)
+        && !nm_streq(RUN_CONFIG_DIR, config_dir))
+        return RUN_CONFIG_DIR;
+    return "";
+}
+
+static gboolean
+_config_files_stamp_add_file(NMHashState *h, const char *dirname, const char *filename, time_t now)
+{
+    gs_free char *path_free = NULL;
+    const char   *path;
+    struct stat   st;
+
+    path = dirname ? (path_free = g_build_filename(dirname, filename, NULL)) : filename;
+
+    nm_hash_update_str(h, path);
+
+    if (stat(path, &st) != 0) {
+        nm_hash_update_val(h, (int) errno);
+        return TRUE;
+    }
+
+    /* Like git's "racy" index entries, a file that was modified just now might
+     * be modified again without changing its timestamp. Don't trust it. */
+    if (st.st_mtim.tv_sec >= now - 1 || st.st_ctim.tv_sec >= now - 1)
+        return FALSE;
+
+    nm_hash_update_vals(h,
+                        (guint64) st.st_dev,
+                        (guint64) st.st_ino,
+                        (guint64) st.st_size,
+                        (guint32) st.st_mode,
+                        (gint64) st.st_mtim.tv_sec,
+                        (gint64) st.st_mtim.tv_nsec,
+                        (gint64) st.st_ctim.tv_sec,
+                        (gint64) st.st_ctim.tv_nsec);
+    return TRUE;
+}
+
+static gboolean
+_config_files_stamp_add_dir(NMHashState *h, const char *config_dir, time_t now)
+{
+    gs_unref_ptrarray GPtrArray *confs = NULL;
+    guint                        i;
+
+    if (!config_dir[0])
+        return TRUE;
+
+    confs = _get_config_dir_files(config_dir);
+
+    nm_hash_update_vals(h, (guint) confs->len);
+    for (i = 0; i < confs->len; i++) {
+        if (!_config_files_stamp_add_file(h, config_dir, confs->pdata[i], now))
+            return FALSE;
+    }
+    return TRUE;
+}
+
+/* Returns a hash over the file names and the stat() metadata of all files
+ * that are read to build the configuration. If the stamp is unchanged,
+ * reading the configuration again gives the same result. Returns zero,
+ * if the files cannot be trusted to be unchanged. */
+static guint64
+_config_files_stamp(NMConfigPrivate *priv)
+{
+    NMHashState h;
+    time_t      now = time(NULL);
+    const char *main_files[3];
+    const char *run_config_dir;
+    guint       i;
+
+    nm_hash_init(&h, 1507328011u);
+
+    if (priv->cli.config_main_file) {
+        main_files[0] = priv->cli.config_main_file;
+        main_files[1] = NULL;
+    } else {
+        main_files[0] = DEFAULT_CONFIG_MAIN_FILE_OLD;
+        main_files[1] = DEFAULT_CONFIG_MAIN_FILE;
+        main_files[2] = NULL;
+    }
+    for (i = 0; main_files[i]; i++) {
+        if (!_config_files_stamp_add_file(&h, NULL, main_files[i], now))
+            return 0;
+    }
+
+    run_config_dir = _get_run_config_dir(priv->config_dir, priv->system_config_dir);
+
+    if (!_config_files_stamp_add_dir(&h, priv->system_config_dir, now)
+        || !_config_files_stamp_add_dir(&h, run_config_dir, now)
+        || !_config_files_stamp_add_dir(&h, priv->config_dir, now)
+        || !_config_files_stamp_add_file(&h, NULL, priv->intern_config_file, now)
+        || !_config_files_stamp_add_file(&h, NULL, priv->no_auto_default_file, now))
+        return 0;
+
+    return nm_hash_complete_u64(&h) ?: 1u;
+}
+
 static GKeyFile *
 read_entire_config(const NMConfigCmdLineOptions *cli,
                    const char                   *config_dir,
@@ -1326,7 +1451,7 @@ read_entire_config(const NMConfigCmdLineOptions *cli,
     gs_unref_ptrarray GPtrArray    *run_confs    = NULL;
     guint                           i;
     gs_free char                   *o_config_main_file = NULL;
-    const char                     *run_config_dir     = "";
+    const char                     *run_config_dir;
 
     nm_assert(config_dir);
     nm_assert(system_config_dir);
@@ -1335,9 +1460,7 @@ read_entire_config(const NMConfigCmdLineOptions *cli,
     nm_assert(!error || !*error);
     nm_assert(warnings);
 
-    if (("" RUN_CONFIG_DIR)[0] == '/' && !nm_streq(RUN_CONFIG_DIR, system_config_dir)
-        && !nm_streq(RUN_CONFIG_DIR, config_dir))
-        run_config_dir = RUN_CONFIG_DIR;
+    run_config_dir = _get_run_config_dir(config_dir, system_config_dir);
 
     /* create a default configuration file. */
     keyfile = nm_config_create_keyfile();
@@ -2379,6 +2502,10 @@ _nm_config_state_set(NMConfig *self, gboolean allow_persist, gboolean force_pers
 #define DEVICE_RUN_STATE_KEYFILE_KEY_DEVICE_DHCP_BOOTFILE    "dhcp-bootfile"
 #define DEVICE_RUN_STATE_KEYFILE_KEY_DEVICE_GENERIC_SOFTWARE "generic-software"
 
+#define DEVICE_RUN_STATE_KEYFILE_GROUP_DHCP4          "dhcp4"
+#define DEVICE_RUN_STATE_KEYFILE_KEY_DHCP4_IP_ADDRESS "dhcp4.ip_address"
+#define DEVICE_RUN_STATE_KEYFILE_KEY_DHCP4_EXPIRY     "dhcp4.expiry"
+
 static NM_UTILS_LOOKUP_STR_DEFINE(
     _device_state_managed_type_to_str,
     NMConfigDeviceStateManagedType,
@@ -2394,12 +2521,14 @@ _config_device_state_data_new(int ifindex, GKeyFile *kf)
     NMConfigDeviceStateManagedType managed_type      = NM_CONFIG_DEVICE_STATE_MANAGED_TYPE_UNKNOWN;
     gs_free char                  *connection_uuid   = NULL;
     gs_free char                  *perm_hw_addr_fake = NULL;
+    gs_free char                  *dhcp4_address_str = NULL;
     gsize                          connection_uuid_len;
     gsize                          perm_hw_addr_fake_len;
     NMTernary                      nm_owned;
     char                          *p;
     guint32                        route_metric_default_effective;
     guint32                        route_metric_default_aspired;
+    in_addr_t                      dhcp4_address = INADDR_ANY;
 
     nm_assert(kf);
     nm_assert(ifindex > 0);
@@ -2464,6 +2593,14 @@ _config_device_state_data_new(int ifindex, GKeyFile *kf)
     } else
         route_metric_default_aspired = 0;
 
+    dhcp4_address_str =
+        nm_config_keyfile_get_value(kf,
+                                    DEVICE_RUN_STATE_KEYFILE_GROUP_DHCP4,
+                                    DEVICE_RUN_STATE_KEYFILE_KEY_DHCP4_IP_ADDRESS,
+                                    NM_CONFIG_GET_VALUE_STRIP | NM_CONFIG_GET_VALUE_NO_EMPTY);
+    if (dhcp4_address_str && !nm_inet_parse_bin(AF_INET, dhcp4_address_str, NULL, &dhcp4_address))
+        dhcp4_address = INADDR_ANY;
+
     connection_uuid_len   = connection_uuid ? strlen(connection_uuid) + 1 : 0;
     perm_hw_addr_fake_len = perm_hw_addr_fake ? strlen(perm_hw_addr_fake) + 1 : 0;
 
@@ -2477,6 +2614,17 @@ _config_device_state_data_new(int ifindex, GKeyFile *kf)
     device_state->nm_owned                       = nm_owned;
     device_state->route_metric_default_aspired   = route_metric_default_aspired;
     device_state->route_metric_default_effective = route_metric_default_effective;
+    device_state->dhcp4_address                  = dhcp4_address;
+    device_state->dhcp4_expiry =
+        dhcp4_address != INADDR_ANY
+            ? nm_config_keyfile_get_int64(kf,
+                                          DEVICE_RUN_STATE_KEYFILE_GROUP_DHCP4,
+                                          DEVICE_RUN_STATE_KEYFILE_KEY_DHCP4_EXPIRY,
+                                          10,
+                                          0,
+                                          G_MAXINT64,
+                                          0)
+            : 0;
 
     device_state->generic_sw =
         nm_config_keyfile_get_boolean(kf,
@@ -2842,6 +2990,7 @@ nm_config_reload(NMConfig *self, NMConfigChangeFlags reload_flags, gboolean emit
     gs_strfreev char           **no_auto_default             = NULL;
     gboolean                     intern_config_needs_rewrite = FALSE;
     gs_unref_ptrarray GPtrArray *warnings                    = NULL;
+    guint64                      stamp;
     guint                        i;
 
     g_return_if_fail(NM_IS_CONFIG(self));
@@ -2858,6 +3007,14 @@ nm_config_reload(NMConfig *self, NMConfigChangeFlags reload_flags, gboolean emit
         return;
     }
 
+    stamp = _config_files_stamp(priv);
+    if (stamp != 0 && stamp == priv->config_files_stamp) {
+        /* Reading the files again would give the same configuration. */
+        _LOGD("reload: configuration files unchanged");
+        _set_config_data(self, NULL, reload_flags);
+        return;
+    }
+
     warnings = g_ptr_array_new_with_free_func(g_free);
 
     /* pass on the original command line options. This means, that
@@ -2874,10 +3031,15 @@ nm_config_reload(NMConfig *self, NMConfigChangeFlags reload_flags, gboolean emit
     if (!keyfile) {
         _LOGE("Failed to reload the configuration: %s", error->message);
         g_clear_error(&error);
+        priv->config_files_stamp = 0;
         _set_config_data(self, NULL, reload_flags);
         return;
     }
 
+    /* The stamp is from before reading the files. If they changed in
+     * the meantime, the next reload reads them again. */
+    priv->config_files_stamp = stamp;
+
     no_auto_default = no_auto_default_from_file(priv->no_auto_default_file);
 
     keyfile_intern = intern_config_read(priv->intern_config_file,
@@ -3103,8 +3265,15 @@ init_sync(GInitable *initable, GCancellable *cancellable, GError **error)
     else
         priv->intern_config_file = g_strdup(DEFAULT_INTERN_CONFIG_FILE);
 
+    if (priv->cli.no_auto_default_file)
+        priv->no_auto_default_file = g_strdup(priv->cli.no_auto_default_file);
+    else
+        priv->no_auto_default_file = g_strdup(DEFAULT_NO_AUTO_DEFAULT_FILE);
+
     warnings = g_ptr_array_new_with_free_func(g_free);
 
+    priv->config_files_stamp = _config_files_stamp(priv);
+
     keyfile = read_entire_config(&priv->cli,
                                  priv->config_dir,
                                  priv->system_config_dir,
@@ -3117,11 +3286,6 @@ init_sync(GInitable *initable, GCancellable *cancellable, GError **error)
 
     /* Initialize read-only private members */
 
-    if (priv->cli.no_auto_default_file)
-        priv->no_auto_default_file = g_strdup(priv->cli.no_auto_default_file);
-    else
-        priv->no_auto_default_file = g_strdup(DEFAULT_NO_AUTO_DEFAULT_FILE);
-
     priv->log_level   = nm_strstrip(g_key_file_get_string(keyfile,
                                                         NM_CONFIG_KEYFILE_GROUP_LOGGING,
                                                         NM_CONFIG_KEYFILE_KEY_LOGGING_LEVEL,
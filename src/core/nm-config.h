@@ -168,6 +168,11 @@ struct _NMConfigDeviceStateData {
     guint32 route_metric_default_aspired;
     guint32 route_metric_default_effective;
 
+    /* the address and the expiry (in seconds since the epoch) of the DHCPv4
+     * lease, as written by the previous NetworkManager instance. Zero if unset. */
+    in_addr_t dhcp4_address;
+    gint64    dhcp4_expiry;
+
     /* the UUID of the last settings-connection active
      * on the device. */
     const char *connection_uuid;
@@ -86,6 +86,12 @@ struct _NMConnectivityCheckHandle {
 
         GSource *curl_timer;
 
+        /* Set while the request waits for a free slot, see CONCHECK_MAX_RUNNING. */
+        CList waiting_lst;
+        char *waiting_hosts;
+
+        gint64 start_msec;
+
         gsize response_good_cnt;
     } concheck;
 #endif
@@ -108,6 +114,14 @@ enum {
 
 static guint signals[LAST_SIGNAL] = {0};
 
+#if WITH_CONCHECK
+/* With many devices, the periodic checks tend to fire together. Limit the number
+ * of HTTP requests that run at the same time. */
+#define CONCHECK_MAX_RUNNING 16u
+
+static const guint _latency_buckets_msec[] = {50, 100, 250, 500, 1000, 2500, 5000};
+#endif
+
 typedef struct {
     CList      handles_lst_head;
     CList      completed_handles_lst_head;
@@ -115,6 +129,15 @@ typedef struct {
     ConConfig *con_config;
     guint      interval;
 
+#if WITH_CONCHECK
+    CList waiting_handles_lst_head;
+    guint n_running;
+
+    /* Number of completed HTTP requests by duration. The last bucket counts
+     * those that took longer than the largest of _latency_buckets_msec. */
+    guint64 latency_histogram[G_N_ELEMENTS(_latency_buckets_msec) + 1];
+#endif
+
     bool enabled : 1;
     bool uri_valid : 1;
 } NMConnectivityPrivate;
@@ -202,6 +225,12 @@ _con_config_get_response(const ConConfig *con_config)
 
 /*****************************************************************************/
 
+#if WITH_CONCHECK
+static void _curl_request_done(NMConnectivity            *self,
+                               NMConnectivityCheckHandle *cb_data,
+                               NMConnectivityState        state);
+#endif
+
 static void
 cb_data_complete(NMConnectivityCheckHandle *cb_data,
                  NMConnectivityState        state,
@@ -224,6 +253,9 @@ cb_data_complete(NMConnectivityCheckHandle *cb_data,
     c_list_unlink_stale(&cb_data->handles_lst);
 
 #if WITH_CONCHECK
+    c_list_unlink(&cb_data->concheck.waiting_lst);
+    nm_clear_g_free(&cb_data->concheck.waiting_hosts);
+
     if (cb_data->concheck.curl_ehandle) {
         /* Contrary to what cURL manual claim it is *not* safe to remove
          * the easy handle "at any moment"; specifically it's not safe to
@@ -245,6 +277,8 @@ cb_data_complete(NMConnectivityCheckHandle *cb_data,
 
         curl_slist_free_all(cb_data->concheck.request_headers);
         curl_slist_free_all(cb_data->concheck.hosts);
+
+        _curl_request_done(self, cb_data, state);
     }
     nm_clear_g_source_inst(&cb_data->concheck.curl_timer);
     nm_clear_g_cancellable(&cb_data->concheck.resolve_cancellable);
@@ -717,7 +751,7 @@ _idle_cb(gpointer user_data)
 
 #if WITH_CONCHECK
 static void
-do_curl_request(NMConnectivityCheckHandle *cb_data, const char *hosts)
+_curl_request_start(NMConnectivityCheckHandle *cb_data, const char *hosts)
 {
     CURLM *mhandle;
     CURL  *ehandle;
@@ -742,7 +776,9 @@ do_curl_request(NMConnectivityCheckHandle *cb_data, const char *hosts)
 
     cb_data->concheck.curl_mhandle    = mhandle;
     cb_data->concheck.curl_ehandle    = ehandle;
+    cb_data->concheck.start_msec      = nm_utils_get_monotonic_timestamp_msec();
     cb_data->concheck.request_headers = curl_slist_append(NULL, "Connection: close");
+    NM_CONNECTIVITY_GET_PRIVATE(cb_data->self)->n_running++;
     cb_data->timeout_source = nm_g_timeout_add_seconds_source(cb_data->concheck.con_config->timeout,
                                                               _timeout_cb,
                                                               cb_data);
@@ -793,6 +829,70 @@ do_curl_request(NMConnectivityCheckHandle *cb_data, const char *hosts)
     curl_multi_add_handle(mhandle, ehandle);
 }
 
+static void
+do_curl_request(NMConnectivityCheckHandle *cb_data, const char *hosts)
+{
+    NMConnectivityPrivate *priv = NM_CONNECTIVITY_GET_PRIVATE(cb_data->self);
+
+    if (priv->n_running >= CONCHECK_MAX_RUNNING) {
+        _LOG2T("wait for one of %u running requests to complete", priv->n_running);
+        cb_data->concheck.waiting_hosts = g_strdup(hosts);
+        c_list_link_tail(&priv->waiting_handles_lst_head, &cb_data->concheck.waiting_lst);
+        return;
+    }
+
+    _curl_request_start(cb_data, hosts);
+}
+
+static void
+_curl_request_done(NMConnectivity            *self,
+                   NMConnectivityCheckHandle *cb_data,
+                   NMConnectivityState        state)
+{
+    NMConnectivityPrivate     *priv = NM_CONNECTIVITY_GET_PRIVATE(self);
+    NMConnectivityCheckHandle *cb_data_next;
+    gint64                     duration_msec;
+    guint                      i;
+
+    nm_assert(priv->n_running > 0);
+    priv->n_running--;
+
+    duration_msec = nm_utils_get_monotonic_timestamp_msec() - cb_data->concheck.start_msec;
+    for (i = 0; i < G_N_ELEMENTS(_latency_buckets_msec); i++) {
+        if (duration_msec < _latency_buckets_msec[i])
+            break;
+    }
+    priv->latency_histogram[i]++;
+
+    if (_LOGT_ENABLED()) {
+        nm_auto_str_buf NMStrBuf strbuf = NM_STR_BUF_INIT(0, FALSE);
+
+        for (i = 0; i < G_N_ELEMENTS(priv->latency_histogram); i++) {
+            if (i < G_N_ELEMENTS(_latency_buckets_msec))
+                nm_str_buf_append_printf(&strbuf, " <%u:", _latency_buckets_msec[i]);
+            else
+                nm_str_buf_append(&strbuf, " more:");
+            nm_str_buf_append_printf(&strbuf, "%" G_GUINT64_FORMAT, priv->latency_histogram[i]);
+        }
+        _LOG2T("request took %" G_GINT64_FORMAT " msec; latency histogram (msec):%s",
+               duration_msec,
+               nm_str_buf_get_str(&strbuf));
+    }
+
+    if (state == NM_CONNECTIVITY_DISPOSING)
+        return;
+
+    cb_data_next = c_list_first_entry(&priv->waiting_handles_lst_head,
+                                      NMConnectivityCheckHandle,
+                                      concheck.waiting_lst);
+    if (cb_data_next) {
+        gs_free char *hosts = g_steal_pointer(&cb_data_next->concheck.waiting_hosts);
+
+        c_list_unlink(&cb_data_next->concheck.waiting_lst);
+        _curl_request_start(cb_data_next, hosts);
+    }
+}
+
 static void
 system_resolver_resolve_cb(GObject *source_object, GAsyncResult *res, gpointer user_data)
 {
@@ -1144,6 +1244,9 @@ nm_connectivity_check_start(NMConnectivity             *self,
 
     cb_data                  = g_slice_new0(NMConnectivityCheckHandle);
     cb_data->self            = self;
+#if WITH_CONCHECK
+    c_list_init(&cb_data->concheck.waiting_lst);
+#endif
     cb_data->request_counter = ++request_counter;
     c_list_link_tail(&priv->handles_lst_head, &cb_data->handles_lst);
     cb_data->callback        = callback;
@@ -1448,6 +1551,9 @@ nm_connectivity_init(NMConnectivity *self)
 
     c_list_init(&priv->handles_lst_head);
     c_list_init(&priv->completed_handles_lst_head);
+#if WITH_CONCHECK
+    c_list_init(&priv->waiting_handles_lst_head);
+#endif
 
     priv->config = g_object_ref(nm_config_get());
     g_signal_connect(G_OBJECT(priv->config),
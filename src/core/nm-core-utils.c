@@ -15,6 +15,7 @@
 #include <resolv.h>
 #include <byteswap.h>
 #include <sys/types.h>
+#include <sys/prctl.h>
 #include <sys/wait.h>
 #include <sys/stat.h>
 #include <linux/if.h>
@@ -5624,3 +5625,86 @@ nm_rate_limit_check(NMRateLimit *rate_limit, gint32 window_sec, gint32 burst)
 
     return FALSE;
 }
+
+/*****************************************************************************/
+
+/* The timer slack in low-wakeup mode. The kernel may delay wakeups from
+ * timeouts (like the one of poll()) by up to this much, to merge them with
+ * other wakeups of the system. */
+#define LOW_WAKEUP_TIMER_SLACK_NSEC (50 * NM_UTILS_NSEC_PER_MSEC)
+
+static gboolean _low_wakeup;
+
+void
+nm_utils_low_wakeup_set(gboolean enabled)
+{
+    enabled = !!enabled;
+    if (_low_wakeup == enabled)
+        return;
+
+    _low_wakeup = enabled;
+
+    /* A timer slack of zero resets it to the default of the process. */
+    if (prctl(PR_SET_TIMERSLACK, enabled ? LOW_WAKEUP_TIMER_SLACK_NSEC : 0UL, 0, 0, 0) != 0) {
+        int errsv = errno;
+
+        nm_log_warn(LOGD_CORE,
+                    "low-wakeup: failure to set timer slack: %s",
+                    nm_strerror_native(errsv));
+    }
+
+    nm_log_dbg(LOGD_CORE, "low-wakeup: %s", enabled ? "enabled" : "disabled");
+}
+
+gboolean
+nm_utils_low_wakeup_get(void)
+{
+    return _low_wakeup;
+}
+
+static guint
+_low_wakeup_timeout_sec(guint timeout_msec)
+{
+    return NM_MAX(1u, (timeout_msec + 999u) / 1000u);
+}
+
+/**
+ * nm_utils_timeout_add_lax:
+ * @timeout_msec: the timeout in milliseconds
+ * @func: the callback
+ * @user_data: the user data for @func
+ *
+ * Like g_timeout_add(), for timers that are not urgent, like periodic
+ * refreshes. In low-wakeup mode, the timeout gets rounded up to full seconds
+ * and added with g_timeout_add_seconds(), which lets GLib coalesce it onto a
+ * common tick with the other second-granularity timers.
+ *
+ * Returns: the source id.
+ */
+guint
+nm_utils_timeout_add_lax(guint timeout_msec, GSourceFunc func, gpointer user_data)
+{
+    if (_low_wakeup)
+        return g_timeout_add_seconds(_low_wakeup_timeout_sec(timeout_msec), func, user_data);
+    return g_timeout_add(timeout_msec, func, user_data);
+}
+
+/**
+ * nm_utils_timeout_add_lax_source:
+ * @timeout_msec: the timeout in milliseconds
+ * @func: the callback
+ * @user_data: the user data for @func
+ *
+ * Like nm_utils_timeout_add_lax(), but returns the attached #GSource.
+ *
+ * Returns: (transfer full): the source.
+ */
+GSource *
+nm_utils_timeout_add_lax_source(guint timeout_msec, GSourceFunc func, gpointer user_data)
+{
+    if (_low_wakeup)
+        return nm_g_timeout_add_seconds_source(_low_wakeup_timeout_sec(timeout_msec),
+                                               func,
+                                               user_data);
+    return nm_g_timeout_add_source(timeout_msec, func, user_data);
+}
@@ -503,4 +503,12 @@ typedef struct {
 
 gboolean nm_rate_limit_check(NMRateLimit *rate_limit, gint32 window_sec, gint32 burst);
 
+/*****************************************************************************/
+
+void     nm_utils_low_wakeup_set(gboolean enabled);
+gboolean nm_utils_low_wakeup_get(void);
+
+guint    nm_utils_timeout_add_lax(guint timeout_msec, GSourceFunc func, gpointer user_data);
+GSource *nm_utils_timeout_add_lax_source(guint timeout_msec, GSourceFunc func, gpointer user_data);
+
 #endif /* __NM_CORE_UTILS_H__ */
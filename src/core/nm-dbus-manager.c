@@ -14,12 +14,14 @@
 
 #include "c-list/src/c-list.h"
 #include "libnm-glib-aux/nm-c-list.h"
+#include "libnm-glib-aux/nm-dbus-aux.h"
 #include "nm-dbus-interface.h"
 #include "libnm-core-intern/nm-core-internal.h"
 #include "libnm-std-aux/nm-dbus-compat.h"
 #include "nm-dbus-object.h"
 #include "NetworkManagerUtils.h"
 #include "libnm-core-aux-intern/nm-auth-subject.h"
+#include "nm-perf.h"
 
 /* The base path for our GDBusObjectManagerServers.  They do not contain
  * "NetworkManager" because GDBusObjectManagerServer requires that all
@@ -31,11 +33,10 @@
 /*****************************************************************************/
 
 typedef struct {
-    CList  caller_info_lst;
     gulong uid;
     gulong pid;
-    gint64 uid_checked_at;
-    gint64 pid_checked_at;
+    gint64 checked_at;
+    bool   checked : 1;
     bool   uid_valid : 1;
     bool   pid_valid : 1;
     char   sender[0];
@@ -51,7 +52,13 @@ typedef struct {
     NMDBusObjectClass *klass;
     guint              info_idx;
     guint              registration_id;
-    PropertyCacheData  property_cache[];
+
+    /* the a{sv} dictionary with all properties of the interface, as needed
+     * for GetManagedObjects() and InterfacesAdded. It is built from
+     * @property_cache and cleared, when one of the properties gets refetched. */
+    GVariant *properties_all;
+
+    PropertyCacheData property_cache[];
 } RegistrationData;
 
 /* we require that @path is the first member of NMDBusManagerData
@@ -78,7 +85,21 @@ typedef struct {
 
     GDBusConnection *main_dbus_connection;
 
-    CList caller_info_lst_head;
+    /* Caller infos by sender name. The credentials of a D-Bus connection don't
+     * change, so entries are kept until NameOwnerChanged tells us that the
+     * sender is gone. */
+    GHashTable *caller_infos;
+    guint       name_owner_changed_id;
+
+    /* objects with pending property changes, see nm_dbus_manager_set_notify_delay(). */
+    CList    notify_lst_head;
+    GSource *notify_timeout_source;
+    guint    notify_delay_msec;
+
+    /* objects below this path are served by a D-Bus subtree and only get
+     * their RegistrationData on first access. See nm_dbus_manager_set_lazy_subtree(). */
+    char *lazy_subtree_path;
+    guint lazy_subtree_registration_id;
 
     guint objmgr_registration_id;
     bool  started : 1;
@@ -112,6 +133,8 @@ static const GDBusSignalInfo    signal_info_objmgr_interfaces_added;
 static const GDBusSignalInfo    signal_info_objmgr_interfaces_removed;
 static GVariantBuilder *_obj_collect_properties_all(NMDBusObject *obj, GVariantBuilder *builder);
 
+static void _obj_notify_flush(NMDBusManager *self, NMDBusObject *obj);
+
 /*****************************************************************************/
 
 static guint
@@ -445,11 +468,38 @@ private_server_get_connection_by_owner(PrivateServer *s, const char *owner)
 
 /*****************************************************************************/
 
-static void
-_caller_info_free(CallerInfo *caller_info)
+static gboolean
+_bus_get_credentials(NMDBusManager *self, const char *sender, CallerInfo *caller_info)
 {
-    c_list_unlink_stale(&caller_info->caller_info_lst);
-    g_free(caller_info);
+    NMDBusManagerPrivate      *priv  = NM_DBUS_MANAGER_GET_PRIVATE(self);
+    gs_unref_variant GVariant *ret   = NULL;
+    gs_unref_variant GVariant *creds = NULL;
+    guint32                    v_u32;
+
+    if (!priv->main_dbus_connection)
+        return FALSE;
+
+    ret = g_dbus_connection_call_sync(priv->main_dbus_connection,
+                                      DBUS_SERVICE_DBUS,
+                                      DBUS_PATH_DBUS,
+                                      DBUS_INTERFACE_DBUS,
+                                      "GetConnectionCredentials",
+                                      g_variant_new("(s)", sender),
+                                      G_VARIANT_TYPE("(a{sv})"),
+                                      G_DBUS_CALL_FLAGS_NONE,
+                                      2000,
+                                      NULL,
+                                      NULL);
+    if (!ret)
+        return FALSE;
+
+    creds = g_variant_get_child_value(ret, 0);
+
+    caller_info->uid_valid = g_variant_lookup(creds, "UnixUserID", "u", &v_u32);
+    caller_info->uid       = caller_info->uid_valid ? (gulong) v_u32 : G_MAXULONG;
+    caller_info->pid_valid = g_variant_lookup(creds, "ProcessID", "u", &v_u32);
+    caller_info->pid       = caller_info->pid_valid ? (gulong) v_u32 : G_MAXULONG;
+    return TRUE;
 }
 
 static gboolean
@@ -520,62 +570,51 @@ _get_caller_info_ensure(NMDBusManager *self,
 {
     NMDBusManagerPrivate *priv = NM_DBUS_MANAGER_GET_PRIVATE(self);
     CallerInfo           *caller_info;
-    CallerInfo           *ci;
     gint64                now_ns;
-    gsize                 num;
 
 #define CALLER_INFO_MAX_AGE (NM_UTILS_NSEC_PER_SEC * 1)
+#define CALLER_INFO_MAX_NUM 2000
 
-    /* Linear search the cache for the sender.
-     *
-     * The number of cached caller-infos is limited. Hence, it's O(1) and
-     * the list is reasonably short.
-     * Also, the entire caching assumes that we repeatedly ask for the
-     * same sender. That means, we expect to find the right caller info
-     * at the front of the list. */
-    num         = 1;
-    caller_info = NULL;
-    c_list_for_each_entry (ci, &priv->caller_info_lst_head, caller_info_lst) {
-        if (nm_streq(sender, ci->sender)) {
-            caller_info = ci;
-            break;
-        }
-        num++;
-    }
-
-    if (caller_info)
-        nm_c_list_move_front(&priv->caller_info_lst_head, &caller_info->caller_info_lst);
-    else {
+    caller_info = g_hash_table_lookup(priv->caller_infos, sender);
+    if (!caller_info) {
         gsize l = strlen(sender) + 1;
 
+        /* Entries get removed on NameOwnerChanged. This only protects against
+         * growing without bound, if we ever miss a signal. */
+        if (g_hash_table_size(priv->caller_infos) >= CALLER_INFO_MAX_NUM)
+            g_hash_table_remove_all(priv->caller_infos);
+
         caller_info  = g_malloc(sizeof(CallerInfo) + l);
         *caller_info = (CallerInfo) {
-            .uid_checked_at = -CALLER_INFO_MAX_AGE,
-            .pid_checked_at = -CALLER_INFO_MAX_AGE,
+            .uid = G_MAXULONG,
+            .pid = G_MAXULONG,
         };
         memcpy(caller_info->sender, sender, l);
-        c_list_link_front(&priv->caller_info_lst_head, &caller_info->caller_info_lst);
-
-        /* only cache the last few entries. */
-        while (TRUE) {
-            nm_assert(num > 0 && num == c_list_length(&priv->caller_info_lst_head));
-            if (num-- <= 5)
-                break;
-            _caller_info_free(
-                c_list_last_entry(&priv->caller_info_lst_head, CallerInfo, caller_info_lst));
-        }
+        g_hash_table_insert(priv->caller_infos, caller_info->sender, caller_info);
     }
 
+    if ((!ensure_uid || caller_info->uid_valid) && (!ensure_pid || caller_info->pid_valid))
+        return caller_info;
+
+    /* Retry failed lookups, but not more than once per CALLER_INFO_MAX_AGE. */
     now_ns = nm_utils_get_monotonic_timestamp_nsec();
+    if (caller_info->checked && (now_ns - caller_info->checked_at) <= CALLER_INFO_MAX_AGE)
+        return caller_info;
+
+    caller_info->checked    = TRUE;
+    caller_info->checked_at = now_ns;
 
-    if (ensure_uid && (now_ns - caller_info->uid_checked_at) > CALLER_INFO_MAX_AGE) {
-        caller_info->uid_checked_at = now_ns;
+    /* Fetch both with one call. Fall back to the individual calls if the
+     * bus doesn't support GetConnectionCredentials. */
+    if (_bus_get_credentials(self, sender, caller_info))
+        return caller_info;
+
+    if (ensure_uid) {
         if (!(caller_info->uid_valid = _bus_get_unix_user(self, sender, &caller_info->uid)))
             caller_info->uid = G_MAXULONG;
     }
 
-    if (ensure_pid && (now_ns - caller_info->pid_checked_at) > CALLER_INFO_MAX_AGE) {
-        caller_info->pid_checked_at = now_ns;
+    if (ensure_pid) {
         if (!(caller_info->pid_valid = _bus_get_unix_pid(self, sender, &caller_info->pid)))
             caller_info->pid = G_MAXULONG;
     }
@@ -583,6 +622,29 @@ _get_caller_info_ensure(NMDBusManager *self,
     return caller_info;
 }
 
+static void
+_name_owner_changed_cb(GDBusConnection *connection,
+                       const char      *sender_name,
+                       const char      *object_path,
+                       const char      *interface_name,
+                       const char      *signal_name,
+                       GVariant        *parameters,
+                       gpointer         user_data)
+{
+    NMDBusManager        *self = user_data;
+    NMDBusManagerPrivate *priv = NM_DBUS_MANAGER_GET_PRIVATE(self);
+    const char           *name;
+
+    if (!g_variant_is_of_type(parameters, G_VARIANT_TYPE("(sss)")))
+        return;
+
+    g_variant_get(parameters, "(&s&s&s)", &name, NULL, NULL);
+
+    /* Either the name is gone, or it has a new owner. In both cases, the
+     * cached credentials are no longer valid. */
+    g_hash_table_remove(priv->caller_infos, name);
+}
+
 static gboolean
 _get_caller_info(NMDBusManager         *self,
                  GDBusMethodInvocation *context,
@@ -869,9 +931,10 @@ _obj_get_property(RegistrationData *reg_data, guint property_idx, gboolean refet
     property_info =
         (const NMDBusPropertyInfoExtended *) (interface_info->parent.properties[property_idx]);
 
-    if (refetch)
+    if (refetch) {
         nm_clear_g_variant(&reg_data->property_cache[property_idx].value);
-    else {
+        nm_clear_g_variant(&reg_data->properties_all);
+    } else {
         value = reg_data->property_cache[property_idx].value;
         if (value)
             goto out;
@@ -915,8 +978,37 @@ static const GDBusInterfaceVTable dbus_vtable = {
     .set_property = NULL,
 };
 
+/* Returns the node name of @path relative to the lazy subtree, "" for the
+ * root of the subtree itself, or %NULL if @path is not in the subtree. */
+static const char *
+_lazy_subtree_get_node(NMDBusManagerPrivate *priv, const char *path)
+{
+    const char *node;
+
+    if (!priv->lazy_subtree_path || !g_str_has_prefix(path, priv->lazy_subtree_path))
+        return NULL;
+
+    node = &path[strlen(priv->lazy_subtree_path)];
+    if (node[0] == '\0')
+        return node;
+    if (node[0] != '/' || node[1] == '\0' || strchr(&node[1], '/'))
+        return NULL;
+    return &node[1];
+}
+
+/* Objects below the lazy subtree (but not the root of the subtree) are
+ * not announced via the ObjectManager and get materialized on first access. */
+static gboolean
+_obj_is_lazy(NMDBusManagerPrivate *priv, NMDBusObject *obj)
+{
+    const char *node;
+
+    node = _lazy_subtree_get_node(priv, obj->internal.path);
+    return node && node[0] != '\0';
+}
+
 static void
-_obj_register(NMDBusManager *self, NMDBusObject *obj)
+_obj_materialize(NMDBusManager *self, NMDBusObject *obj)
 {
     NMDBusManagerPrivate                     *priv = NM_DBUS_MANAGER_GET_PRIVATE(self);
     guint                                     i, k;
@@ -924,13 +1016,17 @@ _obj_register(NMDBusManager *self, NMDBusObject *obj)
     GType                                     gtype;
     NMDBusObjectClass                        *klasses[10];
     const NMDBusInterfaceInfoExtended *const *prev_interface_infos = NULL;
-    GVariantBuilder                           builder;
+    gboolean                                  in_subtree;
 
     nm_assert(c_list_is_empty(&obj->internal.registration_lst_head));
     nm_assert(priv->main_dbus_connection);
     nm_assert(priv->objmgr_registration_id != 0);
     nm_assert(priv->started);
 
+    /* objects in the lazy subtree are dispatched by the subtree handler, they
+     * only need the RegistrationData, no registration of their own. */
+    in_subtree = !!_lazy_subtree_get_node(priv, obj->internal.path);
+
     n_klasses = 0;
     gtype     = G_OBJECT_TYPE(obj);
     while (gtype != NM_TYPE_DBUS_OBJECT) {
@@ -965,18 +1061,24 @@ _obj_register(NMDBusManager *self, NMDBusObject *obj)
 
             reg_data = g_malloc0(sizeof(RegistrationData) + (sizeof(PropertyCacheData) * prop_len));
 
-            registration_id = g_dbus_connection_register_object(
-                priv->main_dbus_connection,
-                obj->internal.path,
-                NM_UNCONST_PTR(GDBusInterfaceInfo, &interface_info->parent),
-                &dbus_vtable,
-                reg_data,
-                NULL,
-                &error);
-            if (!registration_id) {
-                _LOGE("failure to register object %s: %s", obj->internal.path, error->message);
-                g_free(reg_data);
-                continue;
+            if (in_subtree)
+                registration_id = 0;
+            else {
+                registration_id = g_dbus_connection_register_object(
+                    priv->main_dbus_connection,
+                    obj->internal.path,
+                    NM_UNCONST_PTR(GDBusInterfaceInfo, &interface_info->parent),
+                    &dbus_vtable,
+                    reg_data,
+                    NULL,
+                    &error);
+                if (!registration_id) {
+                    _LOGE("failure to register object %s: %s",
+                          obj->internal.path,
+                          error->message);
+                    g_free(reg_data);
+                    continue;
+                }
             }
 
             reg_data->obj             = obj;
@@ -991,6 +1093,20 @@ _obj_register(NMDBusManager *self, NMDBusObject *obj)
         g_type_class_unref(klasses[k]);
 
     nm_assert(!c_list_is_empty(&obj->internal.registration_lst_head));
+}
+
+static void
+_obj_register(NMDBusManager *self, NMDBusObject *obj)
+{
+    NMDBusManagerPrivate *priv = NM_DBUS_MANAGER_GET_PRIVATE(self);
+    GVariantBuilder       builder;
+
+    if (_obj_is_lazy(priv, obj)) {
+        /* materialized by the subtree handler, when a client accesses it. */
+        return;
+    }
+
+    _obj_materialize(self, obj);
 
     /* Currently, the interfaces of an object do not changed and strictly depend on the object glib type.
      * We don't need more flexibility, and it simplifies the code. Hence, now emit interface-added
@@ -1027,7 +1143,8 @@ _obj_unregister(NMDBusManager *self, NMDBusObject *obj)
     nm_assert(priv->main_dbus_connection);
     nm_assert(priv->objmgr_registration_id != 0);
     nm_assert(priv->started);
-    nm_assert(!c_list_is_empty(&obj->internal.registration_lst_head));
+    nm_assert(_obj_is_lazy(priv, obj)
+              || !c_list_is_empty(&obj->internal.registration_lst_head));
 
     g_variant_builder_init(&builder, G_VARIANT_TYPE("as"));
 
@@ -1039,19 +1156,26 @@ _obj_unregister(NMDBusManager *self, NMDBusObject *obj)
 
         g_variant_builder_add(&builder, "s", interface_info->parent.name);
         c_list_unlink_stale(&reg_data->registration_lst);
-        if (!g_dbus_connection_unregister_object(priv->main_dbus_connection,
-                                                 reg_data->registration_id))
+        if (reg_data->registration_id != 0
+            && !g_dbus_connection_unregister_object(priv->main_dbus_connection,
+                                                    reg_data->registration_id))
             nm_assert_not_reached();
 
         if (interface_info->parent.properties) {
             for (i = 0; interface_info->parent.properties[i]; i++)
                 nm_clear_g_variant(&reg_data->property_cache[i].value);
         }
+        nm_clear_g_variant(&reg_data->properties_all);
 
         g_type_class_unref(reg_data->klass);
         g_free(reg_data);
     }
 
+    if (_obj_is_lazy(priv, obj)) {
+        g_variant_builder_clear(&builder);
+        return;
+    }
+
     g_dbus_connection_emit_signal(priv->main_dbus_connection,
                                   NULL,
                                   OBJECT_MANAGER_SERVER_BASE_PATH,
@@ -1137,9 +1261,10 @@ _nm_dbus_manager_obj_unexport(NMDBusObject *obj)
     nm_assert(&obj->internal == g_hash_table_lookup(priv->objects_by_path, &obj->internal));
     nm_assert(c_list_contains(&priv->objects_lst_head, &obj->internal.objects_lst));
 
-    if (priv->started)
+    if (priv->started) {
+        _obj_notify_flush(self, obj);
         _obj_unregister(self, obj);
-    else
+    } else
         nm_assert(c_list_is_empty(&obj->internal.registration_lst_head));
 
     if (!g_hash_table_remove(priv->objects_by_path, &obj->internal))
@@ -1147,28 +1272,25 @@ _nm_dbus_manager_obj_unexport(NMDBusObject *obj)
     c_list_unlink(&obj->internal.objects_lst);
 }
 
-void
-_nm_dbus_manager_obj_notify(NMDBusObject *obj, guint n_pspecs, const GParamSpec *const *pspecs)
+static void
+_obj_emit_properties_changed(NMDBusManager           *self,
+                             NMDBusObject            *obj,
+                             guint                    n_pspecs,
+                             const GParamSpec *const *pspecs)
 {
-    NMDBusManager        *self;
-    NMDBusManagerPrivate *priv;
+    NMDBusManagerPrivate *priv = NM_DBUS_MANAGER_GET_PRIVATE(self);
     RegistrationData     *reg_data;
     guint                 i, p;
+    gint64                perf_start;
 
-    nm_assert(NM_IS_DBUS_OBJECT(obj));
-    nm_assert(obj->internal.path);
-    nm_assert(NM_IS_DBUS_MANAGER(obj->internal.bus_manager));
-    nm_assert(!c_list_is_empty(&obj->internal.objects_lst));
-
-    self = obj->internal.bus_manager;
-    priv = NM_DBUS_MANAGER_GET_PRIVATE(self);
-
-    nm_assert(!priv->started || priv->objmgr_registration_id != 0);
-    nm_assert(priv->objmgr_registration_id == 0 || priv->main_dbus_connection);
-    nm_assert(c_list_is_empty(&obj->internal.registration_lst_head) != priv->started);
+    perf_start = nm_perf_start();
 
-    if (G_UNLIKELY(!priv->started))
-        return;
+    if (c_list_is_empty(&obj->internal.registration_lst_head)) {
+        /* a lazily exported object, that no client accessed so far. Clients
+         * may still watch for the signal, so send it. */
+        nm_assert(_obj_is_lazy(priv, obj));
+        _obj_materialize(self, obj);
+    }
 
     /* do a naive search for the matching NMDBusPropertyInfoExtended infos. Since the number of
      * (interfaces x properties) is static and possibly small, this naive search is effectively
@@ -1223,6 +1345,116 @@ _nm_dbus_manager_obj_notify(NMDBusObject *obj, guint n_pspecs, const GParamSpec
             g_variant_new("(s@a{sv}as)", interface_info->parent.name, args, &invalidated_builder),
             NULL);
     }
+
+    nm_perf_record(NM_PERF_PROBE_DBUS_OBJ_NOTIFY, perf_start);
+}
+
+static void
+_obj_notify_flush(NMDBusManager *self, NMDBusObject *obj)
+{
+    gs_unref_ptrarray GPtrArray *pspecs = NULL;
+
+    if (!obj->internal.notify_pspecs)
+        return;
+
+    pspecs = g_steal_pointer(&obj->internal.notify_pspecs);
+    c_list_unlink(&obj->internal.notify_lst);
+
+    _obj_emit_properties_changed(self,
+                                 obj,
+                                 pspecs->len,
+                                 (const GParamSpec *const *) pspecs->pdata);
+}
+
+static gboolean
+_notify_timeout_cb(gpointer user_data)
+{
+    NMDBusManager        *self = user_data;
+    NMDBusManagerPrivate *priv = NM_DBUS_MANAGER_GET_PRIVATE(self);
+    NMDBusObject         *obj;
+
+    nm_clear_g_source_inst(&priv->notify_timeout_source);
+
+    while ((obj = c_list_first_entry(&priv->notify_lst_head, NMDBusObject, internal.notify_lst)))
+        _obj_notify_flush(self, obj);
+
+    return G_SOURCE_CONTINUE;
+}
+
+/**
+ * nm_dbus_manager_set_notify_delay:
+ * @self: the #NMDBusManager
+ * @delay_msec: the delay in milliseconds, or zero.
+ *
+ * By default, every batch of property changes of an object (as combined
+ * by g_object_freeze_notify()) results in a PropertiesChanged signal right
+ * away. With a @delay_msec, the changes of an object are collected for
+ * that long and then sent in one signal with the current values.
+ *
+ * That changes the order of PropertiesChanged signals relative to the
+ * signals of other objects. Before emitting another signal of the same
+ * object or unexporting it, the pending changes of the object are sent.
+ */
+void
+nm_dbus_manager_set_notify_delay(NMDBusManager *self, guint delay_msec)
+{
+    NMDBusManagerPrivate *priv;
+
+    g_return_if_fail(NM_IS_DBUS_MANAGER(self));
+
+    priv = NM_DBUS_MANAGER_GET_PRIVATE(self);
+
+    priv->notify_delay_msec = delay_msec;
+    if (delay_msec == 0 && priv->notify_timeout_source)
+        _notify_timeout_cb(self);
+}
+
+void
+_nm_dbus_manager_obj_notify(NMDBusObject *obj, guint n_pspecs, const GParamSpec *const *pspecs)
+{
+    NMDBusManager        *self;
+    NMDBusManagerPrivate *priv;
+    guint                 i, p;
+
+    nm_assert(NM_IS_DBUS_OBJECT(obj));
+    nm_assert(obj->internal.path);
+    nm_assert(NM_IS_DBUS_MANAGER(obj->internal.bus_manager));
+    nm_assert(!c_list_is_empty(&obj->internal.objects_lst));
+
+    self = obj->internal.bus_manager;
+    priv = NM_DBUS_MANAGER_GET_PRIVATE(self);
+
+    nm_assert(!priv->started || priv->objmgr_registration_id != 0);
+    nm_assert(priv->objmgr_registration_id == 0 || priv->main_dbus_connection);
+    nm_assert(priv->started || c_list_is_empty(&obj->internal.registration_lst_head));
+
+    if (G_UNLIKELY(!priv->started))
+        return;
+
+    if (priv->notify_delay_msec == 0) {
+        _obj_emit_properties_changed(self, obj, n_pspecs, pspecs);
+        return;
+    }
+
+    if (!obj->internal.notify_pspecs) {
+        obj->internal.notify_pspecs = g_ptr_array_sized_new(n_pspecs);
+        c_list_link_tail(&priv->notify_lst_head, &obj->internal.notify_lst);
+    }
+
+    for (p = 0; p < n_pspecs; p++) {
+        for (i = 0; i < obj->internal.notify_pspecs->len; i++) {
+            if (obj->internal.notify_pspecs->pdata[i] == pspecs[p])
+                break;
+        }
+        if (i == obj->internal.notify_pspecs->len)
+            g_ptr_array_add(obj->internal.notify_pspecs, (gpointer) pspecs[p]);
+    }
+
+    /* the timeout is not restarted by later changes. That bounds the delay. */
+    if (!priv->notify_timeout_source) {
+        priv->notify_timeout_source =
+            nm_g_timeout_add_source(priv->notify_delay_msec, _notify_timeout_cb, self);
+    }
 }
 
 void
@@ -1247,6 +1479,10 @@ _nm_dbus_manager_obj_emit_signal(NMDBusObject                      *obj,
         return;
     }
 
+    /* send the pending property changes first, so that clients see the
+     * state of the object that goes with the signal. */
+    _obj_notify_flush(self, obj);
+
     g_dbus_connection_emit_signal(priv->main_dbus_connection,
                                   NULL,
                                   obj->internal.path,
@@ -1258,15 +1494,21 @@ _nm_dbus_manager_obj_emit_signal(NMDBusObject                      *obj,
 
 /*****************************************************************************/
 
-static GVariantBuilder *
-_obj_collect_properties_per_interface(NMDBusObject     *obj,
-                                      RegistrationData *reg_data,
-                                      GVariantBuilder  *builder)
+static GVariant *
+_obj_get_properties_per_interface(RegistrationData *reg_data)
 {
-    const NMDBusInterfaceInfoExtended *interface_info = _reg_data_get_interface_info(reg_data);
+    const NMDBusInterfaceInfoExtended *interface_info;
+    GVariantBuilder                    builder;
     guint                              i;
 
-    g_variant_builder_init(builder, G_VARIANT_TYPE("a{sv}"));
+    /* Monitoring tools call GetManagedObjects() regularly. Most properties don't
+     * change in between, so cache the dictionary per interface. */
+    if (reg_data->properties_all)
+        return reg_data->properties_all;
+
+    interface_info = _reg_data_get_interface_info(reg_data);
+
+    g_variant_builder_init(&builder, G_VARIANT_TYPE("a{sv}"));
     if (interface_info->parent.properties) {
         for (i = 0; interface_info->parent.properties[i]; i++) {
             const NMDBusPropertyInfoExtended *property_info =
@@ -1274,10 +1516,12 @@ _obj_collect_properties_per_interface(NMDBusObject     *obj,
             gs_unref_variant GVariant *variant = NULL;
 
             variant = _obj_get_property(reg_data, i, FALSE);
-            g_variant_builder_add(builder, "{sv}", property_info->parent.name, variant);
+            g_variant_builder_add(&builder, "{sv}", property_info->parent.name, variant);
         }
     }
-    return builder;
+
+    reg_data->properties_all = g_variant_ref_sink(g_variant_builder_end(&builder));
+    return reg_data->properties_all;
 }
 
 static GVariantBuilder *
@@ -1288,18 +1532,195 @@ _obj_collect_properties_all(NMDBusObject *obj, GVariantBuilder *builder)
     g_variant_builder_init(builder, G_VARIANT_TYPE("a{sa{sv}}"));
 
     c_list_for_each_entry (reg_data, &obj->internal.registration_lst_head, registration_lst) {
-        GVariantBuilder properties_builder;
-
-        g_variant_builder_add(
-            builder,
-            "{sa{sv}}",
-            _reg_data_get_interface_info(reg_data)->parent.name,
-            _obj_collect_properties_per_interface(obj, reg_data, &properties_builder));
+        g_variant_builder_add(builder,
+                              "{s@a{sv}}",
+                              _reg_data_get_interface_info(reg_data)->parent.name,
+                              _obj_get_properties_per_interface(reg_data));
     }
 
     return builder;
 }
 
+/**
+ * nm_dbus_manager_get_managed_objects:
+ * @self: the #NMDBusManager
+ *
+ * Returns: (transfer floating): the exported objects with all their
+ *   interfaces and properties, in the format of the ObjectManager's
+ *   GetManagedObjects() reply ("a{oa{sa{sv}}}"). The objects below the
+ *   lazy subtree are not included.
+ */
+GVariant *
+nm_dbus_manager_get_managed_objects(NMDBusManager *self)
+{
+    NMDBusManagerPrivate *priv = NM_DBUS_MANAGER_GET_PRIVATE(self);
+    GVariantBuilder       array_builder;
+    NMDBusObject         *obj;
+
+    g_variant_builder_init(&array_builder, G_VARIANT_TYPE("a{oa{sa{sv}}}"));
+    c_list_for_each_entry (obj, &priv->objects_lst_head, internal.objects_lst) {
+        GVariantBuilder interfaces_builder;
+
+        if (_obj_is_lazy(priv, obj))
+            continue;
+
+        /* note that we are called on an idle handler. Hence, all properties are
+         * supposed to be in a consistent state. That is true, if you always
+         * g_object_thaw_notify() before returning to the mainloop. Keeping
+         * signals frozen between while returning from the current call stack
+         * is anyway a very fragile thing, easy to get wrong. Don't do that. */
+        g_variant_builder_add(&array_builder,
+                              "{oa{sa{sv}}}",
+                              obj->internal.path,
+                              _obj_collect_properties_all(obj, &interfaces_builder));
+    }
+    return g_variant_builder_end(&array_builder);
+}
+
+static gboolean
+_obj_path_has_prefix(const char *path, const char *path_prefix)
+{
+    gsize l;
+
+    if (nm_streq(path_prefix, "/"))
+        return TRUE;
+
+    l = strlen(path_prefix);
+    return strncmp(path, path_prefix, l) == 0 && NM_IN_SET(path[l], '\0', '/');
+}
+
+static GVariant *
+_obj_get_properties_projected(RegistrationData *reg_data, GVariant *property_names)
+{
+    GDBusPropertyInfo **properties;
+    GVariantBuilder     builder;
+    GVariantIter        iter;
+    const char         *name;
+    guint               i;
+
+    if (!property_names || g_variant_n_children(property_names) == 0)
+        return g_variant_ref(_obj_get_properties_per_interface(reg_data));
+
+    properties = _reg_data_get_interface_info(reg_data)->parent.properties;
+
+    g_variant_builder_init(&builder, G_VARIANT_TYPE("a{sv}"));
+    g_variant_iter_init(&iter, property_names);
+    while (g_variant_iter_next(&iter, "&s", &name)) {
+        for (i = 0; properties && properties[i]; i++) {
+            gs_unref_variant GVariant *variant = NULL;
+
+            if (!nm_streq(properties[i]->name, name))
+                continue;
+
+            variant = _obj_get_property(reg_data, i, FALSE);
+            g_variant_builder_add(&builder, "{sv}", name, variant);
+            break;
+        }
+    }
+    return g_variant_ref_sink(g_variant_builder_end(&builder));
+}
+
+/**
+ * nm_dbus_manager_get_managed_objects_filtered:
+ * @self: the #NMDBusManager
+ * @path_prefix: only include objects with this path, or below it.
+ * @interfaces: a "a{sas}" dictionary of the interfaces to include, with the
+ *   names of the properties to return for each. An empty list of properties
+ *   selects all properties of the interface, an empty dictionary selects
+ *   all interfaces.
+ *
+ * Like nm_dbus_manager_get_managed_objects(), but only with the requested
+ * objects, interfaces and properties. Objects that have none of the
+ * requested interfaces are omitted. Unknown property names are ignored.
+ *
+ * Returns: (transfer floating): the objects in "a{oa{sa{sv}}}" format.
+ */
+GVariant *
+nm_dbus_manager_get_managed_objects_filtered(NMDBusManager *self,
+                                             const char    *path_prefix,
+                                             GVariant      *interfaces)
+{
+    NMDBusManagerPrivate *priv = NM_DBUS_MANAGER_GET_PRIVATE(self);
+    GVariantBuilder       array_builder;
+    NMDBusObject         *obj;
+    gboolean              all_interfaces;
+
+    nm_assert(path_prefix && path_prefix[0] == '/');
+    nm_assert(g_variant_is_of_type(interfaces, G_VARIANT_TYPE("a{sas}")));
+
+    all_interfaces = (g_variant_n_children(interfaces) == 0);
+
+    g_variant_builder_init(&array_builder, G_VARIANT_TYPE("a{oa{sa{sv}}}"));
+    c_list_for_each_entry (obj, &priv->objects_lst_head, internal.objects_lst) {
+        GVariantBuilder   interfaces_builder;
+        RegistrationData *reg_data;
+        gboolean          has_interfaces = FALSE;
+
+        if (_obj_is_lazy(priv, obj))
+            continue;
+
+        if (!_obj_path_has_prefix(obj->internal.path, path_prefix))
+            continue;
+
+        g_variant_builder_init(&interfaces_builder, G_VARIANT_TYPE("a{sa{sv}}"));
+        c_list_for_each_entry (reg_data, &obj->internal.registration_lst_head, registration_lst) {
+            const char                *interface_name;
+            gs_unref_variant GVariant *property_names = NULL;
+            gs_unref_variant GVariant *properties     = NULL;
+
+            interface_name = _reg_data_get_interface_info(reg_data)->parent.name;
+            if (!all_interfaces) {
+                property_names =
+                    g_variant_lookup_value(interfaces, interface_name, G_VARIANT_TYPE("as"));
+                if (!property_names)
+                    continue;
+            }
+
+            properties = _obj_get_properties_projected(reg_data, property_names);
+            g_variant_builder_add(&interfaces_builder, "{s@a{sv}}", interface_name, properties);
+            has_interfaces = TRUE;
+        }
+
+        if (!has_interfaces) {
+            g_variant_builder_clear(&interfaces_builder);
+            continue;
+        }
+
+        g_variant_builder_add(&array_builder,
+                              "{oa{sa{sv}}}",
+                              obj->internal.path,
+                              &interfaces_builder);
+    }
+    return g_variant_builder_end(&array_builder);
+}
+
+/**
+ * nm_dbus_manager_get_stats:
+ * @self: the #NMDBusManager
+ * @out_bytes: (out) (optional): the summed instance sizes of the objects.
+ *
+ * Returns: the number of exported objects.
+ */
+guint
+nm_dbus_manager_get_stats(NMDBusManager *self, gsize *out_bytes)
+{
+    NMDBusManagerPrivate *priv  = NM_DBUS_MANAGER_GET_PRIVATE(self);
+    NMDBusObject         *obj;
+    guint                 n     = 0;
+    gsize                 bytes = 0;
+
+    c_list_for_each_entry (obj, &priv->objects_lst_head, internal.objects_lst) {
+        GTypeQuery query;
+
+        g_type_query(G_OBJECT_TYPE(obj), &query);
+        bytes += query.instance_size;
+        n++;
+    }
+
+    NM_SET_OUT(out_bytes, bytes);
+    return n;
+}
+
 static void
 dbus_vtable_objmgr_method_call(GDBusConnection       *connection,
                                const char            *sender,
@@ -1310,10 +1731,7 @@ dbus_vtable_objmgr_method_call(GDBusConnection       *connection,
                                GDBusMethodInvocation *invocation,
                                gpointer               user_data)
 {
-    NMDBusManager        *self = user_data;
-    NMDBusManagerPrivate *priv = NM_DBUS_MANAGER_GET_PRIVATE(self);
-    GVariantBuilder       array_builder;
-    NMDBusObject         *obj;
+    NMDBusManager *self = user_data;
 
     nm_assert(nm_streq0(object_path, OBJECT_MANAGER_SERVER_BASE_PATH));
 
@@ -1328,22 +1746,9 @@ dbus_vtable_objmgr_method_call(GDBusConnection       *connection,
         return;
     }
 
-    g_variant_builder_init(&array_builder, G_VARIANT_TYPE("a{oa{sa{sv}}}"));
-    c_list_for_each_entry (obj, &priv->objects_lst_head, internal.objects_lst) {
-        GVariantBuilder interfaces_builder;
-
-        /* note that we are called on an idle handler. Hence, all properties are
-         * supposed to be in a consistent state. That is true, if you always
-         * g_object_thaw_notify() before returning to the mainloop. Keeping
-         * signals frozen between while returning from the current call stack
-         * is anyway a very fragile thing, easy to get wrong. Don't do that. */
-        g_variant_builder_add(&array_builder,
-                              "{oa{sa{sv}}}",
-                              obj->internal.path,
-                              _obj_collect_properties_all(obj, &interfaces_builder));
-    }
-    g_dbus_method_invocation_return_value(invocation,
-                                          g_variant_new("(a{oa{sa{sv}}})", &array_builder));
+    g_dbus_method_invocation_return_value(
+        invocation,
+        g_variant_new("(@a{oa{sa{sv}}})", nm_dbus_manager_get_managed_objects(self)));
 }
 
 static const GDBusInterfaceVTable dbus_vtable_objmgr = {.method_call =
@@ -1374,6 +1779,234 @@ static const GDBusInterfaceInfo interface_info_objmgr = NM_DEFINE_GDBUS_INTERFAC
 
 /*****************************************************************************/
 
+static RegistrationData *
+_lazy_subtree_lookup(NMDBusManager *self, const char *object_path, const char *interface_name)
+{
+    NMDBusManagerPrivate *priv = NM_DBUS_MANAGER_GET_PRIVATE(self);
+    RegistrationData     *reg_data;
+    NMDBusObject         *obj;
+
+    if (!_lazy_subtree_get_node(priv, object_path))
+        return NULL;
+
+    obj = nm_dbus_manager_lookup_object(self, object_path);
+    if (!obj || obj->internal.is_unexporting)
+        return NULL;
+
+    if (c_list_is_empty(&obj->internal.registration_lst_head)) {
+        nm_assert(_obj_is_lazy(priv, obj));
+        _LOGT("materialize object %s on first access", object_path);
+        _obj_materialize(self, obj);
+    }
+
+    if (!interface_name)
+        return c_list_first_entry(&obj->internal.registration_lst_head,
+                                  RegistrationData,
+                                  registration_lst);
+
+    c_list_for_each_entry (reg_data, &obj->internal.registration_lst_head, registration_lst) {
+        if (nm_streq(_reg_data_get_interface_info(reg_data)->parent.name, interface_name))
+            return reg_data;
+    }
+    return NULL;
+}
+
+static void
+dbus_vtable_lazy_method_call(GDBusConnection       *connection,
+                             const char            *sender,
+                             const char            *object_path,
+                             const char            *interface_name,
+                             const char            *method_name,
+                             GVariant              *parameters,
+                             GDBusMethodInvocation *invocation,
+                             gpointer               user_data)
+{
+    NMDBusManager    *self         = user_data;
+    const char       *lookup_iface = interface_name;
+    RegistrationData *reg_data;
+
+    /* The subtree vtable is shared by all objects. Look up the object for every
+     * call, because it might be gone since GDBus called the dispatch function. */
+    if (nm_streq(interface_name, DBUS_INTERFACE_PROPERTIES))
+        g_variant_get_child(parameters, 0, "&s", &lookup_iface);
+
+    reg_data = _lazy_subtree_lookup(self, object_path, lookup_iface);
+    if (!reg_data) {
+        g_dbus_method_invocation_return_error(invocation,
+                                              G_DBUS_ERROR,
+                                              G_DBUS_ERROR_UNKNOWN_OBJECT,
+                                              "No such object %s",
+                                              object_path);
+        return;
+    }
+
+    dbus_vtable_method_call(connection,
+                            sender,
+                            object_path,
+                            interface_name,
+                            method_name,
+                            parameters,
+                            invocation,
+                            reg_data);
+}
+
+static GVariant *
+dbus_vtable_lazy_get_property(GDBusConnection *connection,
+                              const char      *sender,
+                              const char      *object_path,
+                              const char      *interface_name,
+                              const char      *property_name,
+                              GError         **error,
+                              gpointer         user_data)
+{
+    NMDBusManager    *self = user_data;
+    RegistrationData *reg_data;
+
+    reg_data = _lazy_subtree_lookup(self, object_path, interface_name);
+    if (!reg_data) {
+        g_set_error(error,
+                    G_DBUS_ERROR,
+                    G_DBUS_ERROR_UNKNOWN_OBJECT,
+                    "No such object %s",
+                    object_path);
+        return NULL;
+    }
+
+    return dbus_vtable_get_property(connection,
+                                    sender,
+                                    object_path,
+                                    interface_name,
+                                    property_name,
+                                    error,
+                                    reg_data);
+}
+
+static const GDBusInterfaceVTable dbus_vtable_lazy = {
+    .method_call  = dbus_vtable_lazy_method_call,
+    .get_property = dbus_vtable_lazy_get_property,
+    .set_property = NULL,
+};
+
+static char **
+dbus_subtree_enumerate(GDBusConnection *connection,
+                       const char      *sender,
+                       const char      *object_path,
+                       gpointer         user_data)
+{
+    NMDBusManager        *self = user_data;
+    NMDBusManagerPrivate *priv = NM_DBUS_MANAGER_GET_PRIVATE(self);
+    GPtrArray            *nodes;
+    NMDBusObject         *obj;
+
+    /* only used for introspecting the root of the subtree. Method calls are
+     * dispatched to unenumerated nodes, so that the lookup is by path. */
+    nodes = g_ptr_array_new();
+    c_list_for_each_entry (obj, &priv->objects_lst_head, internal.objects_lst) {
+        const char *node = _lazy_subtree_get_node(priv, obj->internal.path);
+
+        if (node && node[0] != '\0')
+            g_ptr_array_add(nodes, g_strdup(node));
+    }
+    g_ptr_array_add(nodes, NULL);
+    return (char **) g_ptr_array_free(nodes, FALSE);
+}
+
+static const char *
+_lazy_subtree_path(const char *object_path, const char *node, char **out_free)
+{
+    if (!node)
+        return object_path;
+    return (*out_free = g_strdup_printf("%s/%s", object_path, node));
+}
+
+static GDBusInterfaceInfo **
+dbus_subtree_introspect(GDBusConnection *connection,
+                        const char      *sender,
+                        const char      *object_path,
+                        const char      *node,
+                        gpointer         user_data)
+{
+    NMDBusManager    *self      = user_data;
+    gs_free char     *path_free = NULL;
+    const char       *path;
+    RegistrationData *reg_data;
+    NMDBusObject     *obj;
+    GPtrArray        *infos;
+
+    path     = _lazy_subtree_path(object_path, node, &path_free);
+    reg_data = _lazy_subtree_lookup(self, path, NULL);
+    if (!reg_data)
+        return NULL;
+    obj = reg_data->obj;
+
+    /* the interface infos are static, g_dbus_interface_info_unref() ignores them. */
+    infos = g_ptr_array_new();
+    c_list_for_each_entry (reg_data, &obj->internal.registration_lst_head, registration_lst) {
+        g_ptr_array_add(infos,
+                        NM_UNCONST_PTR(GDBusInterfaceInfo,
+                                       &_reg_data_get_interface_info(reg_data)->parent));
+    }
+    g_ptr_array_add(infos, NULL);
+    return (GDBusInterfaceInfo **) g_ptr_array_free(infos, FALSE);
+}
+
+static const GDBusInterfaceVTable *
+dbus_subtree_dispatch(GDBusConnection *connection,
+                      const char      *sender,
+                      const char      *object_path,
+                      const char      *interface_name,
+                      const char      *node,
+                      gpointer        *out_user_data,
+                      gpointer         user_data)
+{
+    NMDBusManager *self      = user_data;
+    gs_free char  *path_free = NULL;
+    const char    *path;
+
+    path = _lazy_subtree_path(object_path, node, &path_free);
+    if (!_lazy_subtree_lookup(self, path, interface_name))
+        return NULL;
+
+    *out_user_data = self;
+    return &dbus_vtable_lazy;
+}
+
+static const GDBusSubtreeVTable dbus_subtree_vtable = {
+    .enumerate  = dbus_subtree_enumerate,
+    .introspect = dbus_subtree_introspect,
+    .dispatch   = dbus_subtree_dispatch,
+};
+
+/**
+ * nm_dbus_manager_set_lazy_subtree:
+ * @self: the #NMDBusManager
+ * @path: (nullable): the D-Bus path of the subtree.
+ *
+ * Serve the object at @path and its children through one D-Bus subtree
+ * registration, instead of registering each object. The children are not
+ * part of GetManagedObjects() and the InterfacesAdded/InterfacesRemoved
+ * signals, and their property cache is only created when a client first
+ * accesses them or when they emit PropertiesChanged. Their other signals
+ * are sent as usual.
+ *
+ * This must be called before nm_dbus_manager_start().
+ */
+void
+nm_dbus_manager_set_lazy_subtree(NMDBusManager *self, const char *path)
+{
+    NMDBusManagerPrivate *priv;
+
+    g_return_if_fail(NM_IS_DBUS_MANAGER(self));
+
+    priv = NM_DBUS_MANAGER_GET_PRIVATE(self);
+
+    g_return_if_fail(!priv->started);
+
+    nm_strdup_reset(&priv->lazy_subtree_path, path);
+}
+
+/*****************************************************************************/
+
 GDBusConnection *
 nm_dbus_manager_get_dbus_connection(NMDBusManager *self)
 {
@@ -1401,6 +2034,26 @@ nm_dbus_manager_start(NMDBusManager                  *self,
         return;
     }
 
+    if (priv->lazy_subtree_path) {
+        gs_free_error GError *error = NULL;
+
+        priv->lazy_subtree_registration_id = g_dbus_connection_register_subtree(
+            priv->main_dbus_connection,
+            priv->lazy_subtree_path,
+            &dbus_subtree_vtable,
+            G_DBUS_SUBTREE_FLAGS_DISPATCH_TO_UNENUMERATED_NODES,
+            self,
+            NULL,
+            &error);
+        if (priv->lazy_subtree_registration_id == 0) {
+            _LOGW("failure to register subtree %s, export its objects directly: %s",
+                  priv->lazy_subtree_path,
+                  error->message);
+            nm_clear_g_free(&priv->lazy_subtree_path);
+        } else
+            _LOGD("objects below %s are exported lazily", priv->lazy_subtree_path);
+    }
+
     priv->set_property_handler      = set_property_handler;
     priv->set_property_handler_data = set_property_handler_data;
     priv->started                   = TRUE;
@@ -1487,6 +2140,13 @@ nm_dbus_manager_setup(NMDBusManager *self)
 
     g_dbus_connection_set_exit_on_close(priv->main_dbus_connection, FALSE);
 
+    priv->name_owner_changed_id =
+        nm_dbus_connection_signal_subscribe_name_owner_changed(priv->main_dbus_connection,
+                                                               NULL,
+                                                               _name_owner_changed_cb,
+                                                               self,
+                                                               NULL);
+
     registration_id = g_dbus_connection_register_object(
         priv->main_dbus_connection,
         OBJECT_MANAGER_SERVER_BASE_PATH,
@@ -1541,7 +2201,8 @@ nm_dbus_manager_init(NMDBusManager *self)
     priv->objects_by_path =
         g_hash_table_new((GHashFunc) _objects_by_path_hash, (GEqualFunc) _objects_by_path_equal);
 
-    c_list_init(&priv->caller_info_lst_head);
+    priv->caller_infos = g_hash_table_new_full(nm_str_hash, g_str_equal, NULL, g_free);
+    c_list_init(&priv->notify_lst_head);
 }
 
 static void
@@ -1550,7 +2211,6 @@ dispose(GObject *object)
     NMDBusManager        *self = NM_DBUS_MANAGER(object);
     NMDBusManagerPrivate *priv = NM_DBUS_MANAGER_GET_PRIVATE(self);
     PrivateServer        *s, *s_safe;
-    CallerInfo           *caller_info;
 
     /* All exported NMDBusObject instances keep the manager alive, so we don't
      * expect any remaining objects. */
@@ -1559,6 +2219,9 @@ dispose(GObject *object)
 
     nm_clear_pointer(&priv->objects_by_path, g_hash_table_destroy);
 
+    nm_assert(c_list_is_empty(&priv->notify_lst_head));
+    nm_clear_g_source_inst(&priv->notify_timeout_source);
+
     c_list_for_each_entry_safe (s, s_safe, &priv->private_servers_lst_head, private_servers_lst)
         private_server_free(s);
 
@@ -1567,13 +2230,19 @@ dispose(GObject *object)
                                             nm_steal_int(&priv->objmgr_registration_id));
     }
 
+    if (priv->lazy_subtree_registration_id) {
+        g_dbus_connection_unregister_subtree(priv->main_dbus_connection,
+                                             nm_steal_int(&priv->lazy_subtree_registration_id));
+    }
+    nm_clear_g_free(&priv->lazy_subtree_path);
+
+    nm_clear_g_dbus_connection_signal(priv->main_dbus_connection, &priv->name_owner_changed_id);
+
     g_clear_object(&priv->main_dbus_connection);
 
     G_OBJECT_CLASS(nm_dbus_manager_parent_class)->dispose(object);
 
-    while ((caller_info =
-                c_list_first_entry(&priv->caller_info_lst_head, CallerInfo, caller_info_lst)))
-        _caller_info_free(caller_info);
+    nm_clear_pointer(&priv->caller_infos, g_hash_table_destroy);
 }
 
 static void
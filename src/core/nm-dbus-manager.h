@@ -49,6 +49,18 @@ void nm_dbus_manager_start(NMDBusManager                  *self,
                            NMDBusManagerSetPropertyHandler set_property_handler,
                            gpointer                        set_property_handler_data);
 
+void nm_dbus_manager_set_notify_delay(NMDBusManager *self, guint delay_msec);
+
+void nm_dbus_manager_set_lazy_subtree(NMDBusManager *self, const char *path);
+
+GVariant *nm_dbus_manager_get_managed_objects(NMDBusManager *self);
+
+GVariant *nm_dbus_manager_get_managed_objects_filtered(NMDBusManager *self,
+                                                       const char    *path_prefix,
+                                                       GVariant      *interfaces);
+
+guint nm_dbus_manager_get_stats(NMDBusManager *self, gsize *out_bytes);
+
 void nm_dbus_manager_stop(NMDBusManager *self);
 
 gboolean nm_dbus_manager_is_stopping(NMDBusManager *self);
@@ -72,7 +72,13 @@ struct _NMDBusObjectInternal {
      * unexported, or even re-exported afterwards. If that happens, we want
      * to fail the request. For that, we keep track of a version id.  */
     guint64 export_version_id;
-    bool    is_unexporting : 1;
+
+    /* the pending property changes, when PropertiesChanged signals are
+     * delayed. See nm_dbus_manager_set_notify_delay(). */
+    CList      notify_lst;
+    GPtrArray *notify_pspecs;
+
+    bool is_unexporting : 1;
 };
 
 struct _NMDBusObject {
@@ -8,6 +8,8 @@
 
 #include "nm-dispatcher.h"
 
+#include <sys/stat.h>
+
 #include "libnm-glib-aux/nm-dbus-aux.h"
 #include "libnm-core-aux-extern/nm-dispatcher-api.h"
 #include "NetworkManagerUtils.h"
@@ -84,8 +86,43 @@ static struct {
     GDBusConnection *dbus_connection;
     GHashTable      *requests;
     guint            request_id_counter;
+    bool             action2_supported : 1;
 } gl;
 
+typedef struct {
+    const char     *path;
+    struct timespec mtime;
+    bool            mtime_valid : 1;
+    bool            has_scripts : 1;
+} ScriptDir;
+
+typedef enum {
+    SCRIPT_DIR_TYPE_BASE,
+    SCRIPT_DIR_TYPE_PRE_UP,
+    SCRIPT_DIR_TYPE_PRE_DOWN,
+    _SCRIPT_DIR_TYPE_NUM,
+} ScriptDirType;
+
+/* The directories where nm-dispatcher looks for scripts, see find_scripts()
+ * in src/nm-dispatcher/nm-dispatcher.c. */
+static ScriptDir script_dirs[_SCRIPT_DIR_TYPE_NUM][2] = {
+    [SCRIPT_DIR_TYPE_BASE] =
+        {
+            {.path = NMLIBDIR "/dispatcher.d"},
+            {.path = NMCONFDIR "/dispatcher.d"},
+        },
+    [SCRIPT_DIR_TYPE_PRE_UP] =
+        {
+            {.path = NMLIBDIR "/dispatcher.d/pre-up.d"},
+            {.path = NMCONFDIR "/dispatcher.d/pre-up.d"},
+        },
+    [SCRIPT_DIR_TYPE_PRE_DOWN] =
+        {
+            {.path = NMLIBDIR "/dispatcher.d/pre-down.d"},
+            {.path = NMCONFDIR "/dispatcher.d/pre-down.d"},
+        },
+};
+
 /*****************************************************************************/
 
 /* All actions except 'hostname', 'connectivity-change' and 'dns-change' require
@@ -177,6 +214,81 @@ _init_dispatcher(void)
 
 /*****************************************************************************/
 
+static gboolean
+_script_dir_has_scripts(ScriptDir *script_dir)
+{
+    GDir       *dir;
+    const char *filename;
+    struct stat st;
+    gboolean    has_scripts = FALSE;
+
+    if (stat(script_dir->path, &st) != 0) {
+        script_dir->mtime_valid = FALSE;
+        return FALSE;
+    }
+
+    /* Adding, removing or renaming a file changes the modification time of
+     * the directory. Only then we need to read it again. */
+    if (script_dir->mtime_valid && script_dir->mtime.tv_sec == st.st_mtim.tv_sec
+        && script_dir->mtime.tv_nsec == st.st_mtim.tv_nsec)
+        return script_dir->has_scripts;
+
+    script_dir->mtime       = st.st_mtim;
+    script_dir->mtime_valid = TRUE;
+
+    dir = g_dir_open(script_dir->path, 0, NULL);
+    if (dir) {
+        while ((filename = g_dir_read_name(dir))) {
+            gs_free char *full_name = NULL;
+
+            if (filename[0] == '.')
+                continue;
+
+            /* Subdirectories like "no-wait.d" don't count, but anything else
+             * does. nm-dispatcher performs the precise checks. */
+            full_name = g_build_filename(script_dir->path, filename, NULL);
+            if (stat(full_name, &st) != 0 || !S_ISDIR(st.st_mode)) {
+                has_scripts = TRUE;
+                break;
+            }
+        }
+        g_dir_close(dir);
+    }
+
+    script_dir->has_scripts = has_scripts;
+    return has_scripts;
+}
+
+/* Whether nm-dispatcher might find any script for @action. If not, there is no
+ * need to collect the parameters and to call (and possibly D-Bus activate) the
+ * service. */
+static gboolean
+action_has_scripts(NMDispatcherAction action)
+{
+    ScriptDirType type;
+    guint         i;
+
+    /* Device handlers are looked up by name and their result matters. Always
+     * call them. */
+    if (action_is_device_handler(action))
+        return TRUE;
+
+    if (NM_IN_SET(action, NM_DISPATCHER_ACTION_PRE_UP, NM_DISPATCHER_ACTION_VPN_PRE_UP))
+        type = SCRIPT_DIR_TYPE_PRE_UP;
+    else if (NM_IN_SET(action, NM_DISPATCHER_ACTION_PRE_DOWN, NM_DISPATCHER_ACTION_VPN_PRE_DOWN))
+        type = SCRIPT_DIR_TYPE_PRE_DOWN;
+    else
+        type = SCRIPT_DIR_TYPE_BASE;
+
+    for (i = 0; i < G_N_ELEMENTS(script_dirs[type]); i++) {
+        if (_script_dir_has_scripts(&script_dirs[type][i]))
+            return TRUE;
+    }
+    return FALSE;
+}
+
+/*****************************************************************************/
+
 static void
 dump_proxy_to_props(const NML3ConfigData *l3cd, GVariantBuilder *builder)
 {
@@ -568,7 +680,8 @@ dispatcher_done_cb(GObject *source, GAsyncResult *result, gpointer user_data)
 
     ret = g_dbus_connection_call_finish(G_DBUS_CONNECTION(source), result, &error);
 
-    if (!ret && call_id->is_action2 && !action_is_device_handler(call_id->action)
+    if (!ret && call_id->is_action2 && call_id->action_params
+        && !action_is_device_handler(call_id->action)
         && g_error_matches(error, G_DBUS_ERROR, G_DBUS_ERROR_UNKNOWN_METHOD)) {
         _LOG3D(call_id,
                "dispatcher service does not implement Action2() method, falling back to Action()");
@@ -602,6 +715,8 @@ dispatcher_done_cb(GObject *source, GAsyncResult *result, gpointer user_data)
                 (int) ((now_msec - call_id->start_at_msec) % 1000),
                 error->message);
     } else {
+        if (call_id->is_action2)
+            gl.action2_supported = TRUE;
         dispatcher_results_process(call_id->action,
                                    call_id->request_id,
                                    call_id->start_at_msec,
@@ -672,7 +787,7 @@ build_call_parameters(NMDispatcherAction    action,
                       gboolean              is_action2)
 {
     const char                *connectivity_state_string = "UNKNOWN";
-    GVariant                  *connection_dict;
+    gs_unref_variant GVariant *connection_dict           = NULL;
     GVariantBuilder            connection_props;
     GVariantBuilder            device_props;
     GVariantBuilder            device_proxy_props;
@@ -685,10 +800,10 @@ build_call_parameters(NMDispatcherAction    action,
     GVariantBuilder            vpn_ip6_props;
 
     if (applied_connection)
-        connection_dict =
-            nm_connection_to_dbus(applied_connection, NM_CONNECTION_SERIALIZE_WITH_NON_SECRET);
-    else
-        connection_dict = nm_g_variant_singleton_aLsaLsvII();
+        connection_dict = _nm_connection_to_dbus_cached(applied_connection,
+                                                        NM_CONNECTION_SERIALIZE_WITH_NON_SECRET);
+    if (!connection_dict)
+        connection_dict = g_variant_ref(nm_g_variant_singleton_aLsaLsvII());
 
     g_variant_builder_init(&connection_props, G_VARIANT_TYPE_VARDICT);
     if (settings_connection) {
@@ -812,6 +927,11 @@ _dispatcher_call(NMDispatcherAction    action,
     if (!gl.dbus_connection)
         return FALSE;
 
+    if (!action_has_scripts(action)) {
+        _LOGT("skip action '%s': no dispatcher scripts installed", action_to_string(action));
+        return FALSE;
+    }
+
     log_ifname = device ? nm_device_get_iface(device) : NULL;
     log_con_uuid =
         settings_connection ? nm_settings_connection_get_uuid(settings_connection) : NULL;
@@ -933,16 +1053,19 @@ _dispatcher_call(NMDispatcherAction    action,
                                      log_con_uuid);
 
     /* Since we don't want to cache all the input parameters, already build
-     * and cache the argument for the Action() method in case Action2() fails. */
-    call_id->action_params = build_call_parameters(action,
-                                                   device,
-                                                   settings_connection,
-                                                   applied_connection,
-                                                   activation_type_external,
-                                                   connectivity_state,
-                                                   vpn_iface,
-                                                   l3cd,
-                                                   FALSE);
+     * and cache the argument for the Action() method in case Action2() fails.
+     * Once the service replied to Action2(), we know that it is supported. */
+    if (!gl.action2_supported) {
+        call_id->action_params = build_call_parameters(action,
+                                                       device,
+                                                       settings_connection,
+                                                       applied_connection,
+                                                       activation_type_external,
+                                                       connectivity_state,
+                                                       vpn_iface,
+                                                       l3cd,
+                                                       FALSE);
+    }
 
     g_dbus_connection_call(gl.dbus_connection,
                            NM_DISPATCHER_DBUS_SERVICE,
@@ -179,6 +179,10 @@ _iptables_get_name(gboolean is_iptables_chain, const char *prefix, const char *i
 
 /*****************************************************************************/
 
+#define _append(p_strbuf, fmt, ...) nm_str_buf_append_printf((p_strbuf), "" fmt "\n", ##__VA_ARGS__)
+
+/*****************************************************************************/
+
 static gboolean
 _iptables_call_v(const char *const *argv)
 {
@@ -243,6 +247,126 @@ _share_iptables_chain_add(const char *table, const char *chain)
     return _share_iptables_chain_op(table, chain, "--new-chain");
 }
 
+/*****************************************************************************/
+
+static gboolean
+_iptables_restore_arg_valid(const char *str)
+{
+    /* The input of iptables-restore is split at whitespace and honors
+     * quotes. Only pass strings that need no quoting. */
+    return str && str[0]
+           && NM_STRCHAR_ALL(str,
+                             ch,
+                             (ch >= '0' && ch <= '9') || (ch >= 'a' && ch <= 'z')
+                                 || (ch >= 'A' && ch <= 'Z')
+                                 || NM_IN_SET(ch, '.', '_', '-', '+', '/', '='));
+}
+
+static gboolean
+_iptables_restore_call(NMStrBuf *strbuf)
+{
+    gs_free_error GError       *error      = NULL;
+    gs_unref_object GSubprocess *subprocess = NULL;
+    gs_unref_bytes GBytes       *stdin_buf  = NULL;
+
+    /* Apply all rules of one table with a single "iptables-restore --noflush"
+     * invocation instead of spawning iptables for each rule. The table is
+     * committed atomically, so on failure nothing was changed and the caller
+     * can fall back to individual iptables calls. */
+
+    nm_log_dbg(LOGD_FIREWALL, "iptables-restore: %s", nm_str_buf_get_str(strbuf));
+
+    stdin_buf = g_bytes_new(nm_str_buf_get_str_unsafe(strbuf), strbuf->len);
+
+    subprocess =
+        g_subprocess_newv(NM_MAKE_STRV("" IPTABLES_PATH "-restore", "--noflush", "--wait=2"),
+                          G_SUBPROCESS_FLAGS_STDIN_PIPE | G_SUBPROCESS_FLAGS_STDOUT_SILENCE
+                              | G_SUBPROCESS_FLAGS_STDERR_SILENCE,
+                          &error);
+    if (!subprocess) {
+        nm_log_dbg(LOGD_FIREWALL, "iptables-restore: error executing command: %s", error->message);
+        return FALSE;
+    }
+
+    if (!g_subprocess_communicate(subprocess, stdin_buf, NULL, NULL, NULL, &error)) {
+        nm_log_dbg(LOGD_FIREWALL, "iptables-restore: communication failed: %s", error->message);
+        g_subprocess_force_exit(subprocess);
+        return FALSE;
+    }
+
+    if (!g_subprocess_get_successful(subprocess)) {
+        char buf[NM_UTILS_GET_PROCESS_EXIT_STATUS_BUF_LEN];
+
+        nm_utils_get_process_exit_status_desc_buf(g_subprocess_get_status(subprocess),
+                                                  buf,
+                                                  sizeof(buf));
+        nm_log_dbg(LOGD_FIREWALL, "iptables-restore: command %s", buf);
+        return FALSE;
+    }
+
+    return TRUE;
+}
+
+static gboolean
+_share_iptables_masquerade_restore_up(const char *comment_name, const char *str_subnet)
+{
+    nm_auto_str_buf NMStrBuf strbuf = NM_STR_BUF_INIT(NM_UTILS_GET_NEXT_REALLOC_SIZE_488, FALSE);
+
+    _append(&strbuf, "*nat");
+    _append(&strbuf,
+            "-I POSTROUTING -s %s ! -d %s -j MASQUERADE -m comment --comment %s",
+            str_subnet,
+            str_subnet,
+            comment_name);
+    _append(&strbuf, "COMMIT");
+
+    return _iptables_restore_call(&strbuf);
+}
+
+static gboolean
+_share_iptables_shared_restore_up(const char *comment_name,
+                                  const char *chain_input,
+                                  const char *chain_forward,
+                                  const char *ip_iface,
+                                  in_addr_t   addr,
+                                  guint       plen)
+{
+    nm_auto_str_buf NMStrBuf strbuf = NM_STR_BUF_INIT(NM_UTILS_GET_NEXT_REALLOC_SIZE_1000, FALSE);
+    char                     str_subnet[_SHARE_IPTABLES_SUBNET_TO_STR_LEN];
+
+    _share_iptables_subnet_to_str(str_subnet, addr, plen);
+
+    /* With --noflush, declaring an existing chain flushes it. That is the
+     * same as what _share_iptables_chain_add() does. */
+    _append(&strbuf, "*filter");
+    _append(&strbuf, ":%s - [0:0]", chain_input);
+    _append(&strbuf, ":%s - [0:0]", chain_forward);
+    _append(&strbuf, "-A %s -p tcp --dport 67 -j ACCEPT", chain_input);
+    _append(&strbuf, "-A %s -p udp --dport 67 -j ACCEPT", chain_input);
+    _append(&strbuf, "-A %s -p tcp --dport 53 -j ACCEPT", chain_input);
+    _append(&strbuf, "-A %s -p udp --dport 53 -j ACCEPT", chain_input);
+    _append(&strbuf,
+            "-A %s -d %s -o %s -m state --state ESTABLISHED,RELATED -j ACCEPT",
+            chain_forward,
+            str_subnet,
+            ip_iface);
+    _append(&strbuf, "-A %s -s %s -i %s -j ACCEPT", chain_forward, str_subnet, ip_iface);
+    _append(&strbuf, "-A %s -i %s -o %s -j ACCEPT", chain_forward, ip_iface, ip_iface);
+    _append(&strbuf, "-A %s -o %s -j REJECT", chain_forward, ip_iface);
+    _append(&strbuf, "-A %s -i %s -j REJECT", chain_forward, ip_iface);
+    _append(&strbuf,
+            "-I INPUT -i %s -j %s -m comment --comment %s",
+            ip_iface,
+            chain_input,
+            comment_name);
+    _append(&strbuf, "-I FORWARD -j %s -m comment --comment %s", chain_forward, comment_name);
+    _append(&strbuf, "COMMIT");
+
+    return _iptables_restore_call(&strbuf);
+}
+
+/*****************************************************************************/
+
 static void
 _share_iptables_set_masquerade_sync(gboolean up, const char *ip_iface, in_addr_t addr, guint8 plen)
 {
@@ -252,6 +376,11 @@ _share_iptables_set_masquerade_sync(gboolean up, const char *ip_iface, in_addr_t
     comment_name = _iptables_get_name(FALSE, "nm-shared", ip_iface);
 
     _share_iptables_subnet_to_str(str_subnet, addr, plen);
+
+    if (up && _iptables_restore_arg_valid(comment_name)
+        && _share_iptables_masquerade_restore_up(comment_name, str_subnet))
+        return;
+
     _ipxtables_call(AF_INET,
                     "--table",
                     "nat",
@@ -393,6 +522,16 @@ _share_iptables_set_shared_sync(gboolean up, const char *ip_iface, in_addr_t add
     chain_input   = _iptables_get_name(TRUE, "nm-sh-in", ip_iface);
     chain_forward = _iptables_get_name(TRUE, "nm-sh-fw", ip_iface);
 
+    if (up && _iptables_restore_arg_valid(ip_iface) && _iptables_restore_arg_valid(comment_name)
+        && _iptables_restore_arg_valid(chain_input) && _iptables_restore_arg_valid(chain_forward)
+        && _share_iptables_shared_restore_up(comment_name,
+                                             chain_input,
+                                             chain_forward,
+                                             ip_iface,
+                                             addr,
+                                             plen))
+        return;
+
     if (up)
         _share_iptables_set_shared_chains_add(chain_input, chain_forward, ip_iface, addr, plen);
 
@@ -688,8 +827,6 @@ _fw_nft_call_sync(GBytes *stdin_buf, GError **error)
 
 /*****************************************************************************/
 
-#define _append(p_strbuf, fmt, ...) nm_str_buf_append_printf((p_strbuf), "" fmt "\n", ##__VA_ARGS__)
-
 static void
 _fw_nft_append_cmd_table(NMStrBuf *strbuf, const char *family, const char *table_name, gboolean up)
 {
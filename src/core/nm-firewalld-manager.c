@@ -29,6 +29,8 @@ typedef struct {
 
     GCancellable *get_name_owner_cancellable;
 
+    GSource *dispatch_source;
+
     CList pending_calls;
 
     char *name_owner;
@@ -365,6 +367,76 @@ _handle_dbus_start(NMFirewalldManager *self, NMFirewalldManagerCallId *call_id)
                            call_id);
 }
 
+static gboolean
+_call_id_is_queued(NMFirewalldManagerCallId *call_id)
+{
+    /* A request that waits for the next dispatch (or for the initialization)
+     * still owns its D-Bus argument. */
+    return !call_id->is_idle && call_id->dbus.arg;
+}
+
+static gboolean
+_dispatch_cb(gpointer user_data)
+{
+    NMFirewalldManager        *self = user_data;
+    NMFirewalldManagerPrivate *priv = NM_FIREWALLD_MANAGER_GET_PRIVATE(self);
+    NMFirewalldManagerCallId  *call_id_safe;
+    NMFirewalldManagerCallId  *call_id;
+
+    nm_clear_g_source_inst(&priv->dispatch_source);
+
+    /* Send all requests that were queued during the last main loop iteration
+     * back-to-back. firewalld still handles them one by one, but we don't
+     * wait for a reply before sending the next one. */
+    c_list_for_each_entry_safe (call_id, call_id_safe, &priv->pending_calls, lst) {
+        if (!_call_id_is_queued(call_id))
+            continue;
+
+        if (priv->name_owner) {
+            _LOGD(call_id, "dispatch: make D-Bus call");
+            _handle_dbus_start(self, call_id);
+        } else {
+            /* firewalld quit in the meantime. Just like for requests that
+             * are started while it's not running, fake success. */
+            nm_clear_pointer(&call_id->dbus.arg, g_variant_unref);
+            call_id->is_idle = TRUE;
+            _LOGD(call_id, "dispatch: not running, fake success on idle");
+            _handle_idle_start(self, call_id);
+        }
+    }
+
+    return G_SOURCE_CONTINUE;
+}
+
+static void
+_dispatch_queue(NMFirewalldManager *self, NMFirewalldManagerCallId *call_id)
+{
+    NMFirewalldManagerPrivate *priv = NM_FIREWALLD_MANAGER_GET_PRIVATE(self);
+    NMFirewalldManagerCallId  *call_id_safe;
+    NMFirewalldManagerCallId  *c;
+
+    /* The zone of an interface is determined by the last change/remove request.
+     * An earlier request for the same interface, that was not yet sent and that
+     * nobody waits for, is pointless. Drop it. That commonly happens when a
+     * device gets deactivated and activated again right away.
+     *
+     * An "add" doesn't supersede anything, because it fails if the interface is
+     * still in another zone. */
+    if (call_id->ops_type != OPS_TYPE_ADD) {
+        c_list_for_each_entry_safe (c, call_id_safe, &priv->pending_calls, lst) {
+            if (c == call_id)
+                break;
+            if (!_call_id_is_queued(c) || c->callback || !nm_streq(c->iface, call_id->iface))
+                continue;
+            _LOGD(c, "complete: superseded by a later request");
+            _cb_info_complete(c, NULL);
+        }
+    }
+
+    if (!priv->dispatch_source)
+        priv->dispatch_source = nm_g_idle_add_source(_dispatch_cb, self);
+}
+
 static NMFirewalldManagerCallId *
 _start_request(NMFirewalldManager                 *self,
                OpsType                             ops_type,
@@ -393,7 +465,7 @@ _start_request(NMFirewalldManager                 *self,
 
     if (!call_id->is_idle) {
         if (priv->name_owner)
-            _handle_dbus_start(self, call_id);
+            _dispatch_queue(self, call_id);
         if (!call_id->callback) {
             /* if the user did not provide a callback, the call_id is useless.
              * Especially, the user cannot use the call-id to cancel the request,
@@ -644,6 +716,8 @@ dispose(GObject *object)
 
     nm_clear_g_cancellable(&priv->get_name_owner_cancellable);
 
+    nm_clear_g_source_inst(&priv->dispatch_source);
+
     G_OBJECT_CLASS(nm_firewalld_manager_parent_class)->dispose(object);
 
     g_clear_object(&priv->dbus_connection);
@@ -147,7 +147,13 @@ _l3cfg_notify_cb(NML3Cfg *l3cfg, const NML3ConfigNotifyData *notify_data, NMIPCo
             _handle_l3cd_changed(self, notify_data->commit.l3cd_new);
         break;
     case NM_L3_CONFIG_NOTIFY_TYPE_PLATFORM_CHANGE_ON_IDLE:
-        _notify_platform(self, notify_data->platform_change_on_idle.obj_type_flags);
+        /* Temporary addresses are still exposed on D-Bus, so they do require
+         * to update the (rate limited) "AddressData". */
+        _notify_platform(self,
+                         notify_data->platform_change_on_idle.obj_type_flags
+                             | (notify_data->platform_change_on_idle.ip6_temporary_addrs_changed
+                                    ? nmp_object_type_to_flags(NMP_OBJECT_TYPE_IP6_ADDRESS)
+                                    : 0u));
         break;
     default:
         break;
@@ -302,6 +308,8 @@ finalize(GObject *object)
     nm_g_variant_unref(priv->v_addresses);
     nm_g_variant_unref(priv->v_route_data);
     nm_g_variant_unref(priv->v_routes);
+    nm_g_hash_table_unref(priv->v_address_data_cache);
+    nm_g_hash_table_unref(priv->v_route_data_cache);
 
     nmp_object_unref(priv->v_gateway.best_default_route);
 
@@ -914,6 +922,7 @@ _handle_platform_change(NMIPConfig *self, guint32 obj_type_flags, gboolean is_in
                                                                 NMP_OBJECT_TYPE_IP_ADDRESS(IS_IPv4),
                                                                 nm_l3cfg_get_ifindex(priv->l3cfg)),
                                       priv->v_gateway.best_default_route,
+                                      &priv->v_address_data_cache,
                                       &x_address_data,
                                       &x_addresses);
 
@@ -937,7 +946,11 @@ _handle_platform_change(NMIPConfig *self, guint32 obj_type_flags, gboolean is_in
         gs_unref_variant GVariant *x_route_data = NULL;
         gs_unref_variant GVariant *x_routes     = NULL;
 
-        nm_utils_ip_routes_to_dbus(addr_family, head_entry_routes, &x_route_data, &x_routes);
+        nm_utils_ip_routes_to_dbus(addr_family,
+                                   head_entry_routes,
+                                   &priv->v_route_data_cache,
+                                   &x_route_data,
+                                   &x_routes);
 
         if (!nm_g_variant_equal(priv->v_route_data, x_route_data)) {
             changed_params[n_changed_params++] = obj_properties_ip[PROP_IP_ROUTE_DATA];
@@ -29,6 +29,8 @@ struct _NMIPConfigPrivate {
     GVariant             *v_addresses;
     GVariant             *v_route_data;
     GVariant             *v_routes;
+    GHashTable           *v_address_data_cache;
+    GHashTable           *v_route_data_cache;
     struct {
         const NMPObject *best_default_route;
     } v_gateway;
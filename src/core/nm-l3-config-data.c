@@ -169,6 +169,9 @@ struct _NML3ConfigData {
     bool routed_dns_6 : 1;
 };
 
+/* The number of alive instances, for nm_l3_config_data_get_stats(). */
+static guint _n_alive;
+
 /*****************************************************************************/
 
 static GArray *
@@ -729,6 +732,7 @@ nm_l3_config_data_new(NMDedupMultiIndex *multi_idx, int ifindex, NMIPConfigSourc
     _idx_type_init(&self->idx_routes_4, NMP_OBJECT_TYPE_IP4_ROUTE);
     _idx_type_init(&self->idx_routes_6, NMP_OBJECT_TYPE_IP6_ROUTE);
 
+    _n_alive++;
     return self;
 }
 
@@ -824,6 +828,18 @@ nm_l3_config_data_unref(const NML3ConfigData *self)
     nm_ref_string_unref(mutable->proxy_pac_script);
 
     nm_g_slice_free(mutable);
+
+    nm_assert(_n_alive > 0);
+    _n_alive--;
+}
+
+/* Returns the number of alive instances. @out_bytes does not include the
+ * addresses and routes, they are accounted to the NMDedupMultiIndex. */
+guint
+nm_l3_config_data_get_stats(gsize *out_bytes)
+{
+    NM_SET_OUT(out_bytes, ((gsize) _n_alive) * sizeof(NML3ConfigData));
+    return _n_alive;
 }
 
 /*****************************************************************************/
@@ -80,6 +80,8 @@ const NML3ConfigData *nm_l3_config_data_ref_and_seal(const NML3ConfigData *self)
 const NML3ConfigData *nm_l3_config_data_seal(const NML3ConfigData *self);
 void                  nm_l3_config_data_unref(const NML3ConfigData *self);
 
+guint nm_l3_config_data_get_stats(gsize *out_bytes);
+
 #define nm_clear_l3cd(ptr) nm_clear_pointer((ptr), nm_l3_config_data_unref)
 
 NM_AUTO_DEFINE_FCN0(const NML3ConfigData *, _nm_auto_unref_l3cd, nm_l3_config_data_unref);
@@ -15,6 +15,7 @@
 #include "libnm-core-aux-intern/nm-libnm-core-utils.h"
 #include "libnm-glib-aux/nm-prioq.h"
 #include "libnm-glib-aux/nm-time-utils.h"
+#include "libnm-glib-aux/nm-timer-queue.h"
 #include "libnm-platform/nm-platform.h"
 #include "libnm-platform/nmp-object.h"
 #include "libnm-platform/nmp-global-tracker.h"
@@ -22,6 +23,7 @@
 #include "n-acd/src/n-acd.h"
 #include "nm-l3-ipv4ll.h"
 #include "nm-ip-config.h"
+#include "nm-perf.h"
 
 /*****************************************************************************/
 
@@ -253,6 +255,25 @@ typedef struct _NML3CfgPrivate {
 
     const NML3ConfigData *combined_l3cd_commited;
 
+    /* When rebuilding combined_l3cd_merged, most entries of l3_config_datas are
+     * usually unchanged (for example, on a DHCP renewal only the lease changes,
+     * while the static configuration stays the same). We cache the merge result
+     * of the leading entries (in sorted order) that didn't change, and only merge
+     * the remaining entries on top of it. See _l3cfg_update_combined_config(). */
+    struct {
+        /* The sorted entries (L3ConfigData, holding a reference to the l3cd) of
+         * the last rebuild. */
+        GArray *last_datas;
+
+        /* The merge result of the first "prefix_len" entries of "last_datas". */
+        const NML3ConfigData *prefix_l3cd;
+        guint                 prefix_len;
+
+        /* The merge hook depends on the ACD state and on whether we commit. */
+        guint64 prefix_acd_generation;
+        bool    prefix_to_commit : 1;
+    } merge_cache;
+
     CList commit_type_lst_head;
 
     GHashTable *obj_state_hash;
@@ -301,13 +322,27 @@ typedef struct _NML3CfgPrivate {
     /* This is for rate-limiting the creation of nacd instance. */
     GSource *nacd_instance_ensure_retry;
 
-    GSource *commit_on_idle_source;
-
     guint64 pseudo_timestamp_counter;
 
-    NMPrioq  failedobj_prioq;
-    GSource *failedobj_timeout_source;
-    gint64   failedobj_timeout_expiry_msec;
+    /* Incremented whenever an AcdData gets added, removed or changes state. */
+    guint64 acd_generation;
+
+    /* Incremented on every platform change for our ifindex. */
+    guint64 platform_generation;
+
+    /* The number of users that want NM_L3_CONFIG_NOTIFY_TYPE_PLATFORM_CHANGE. See
+     * nm_l3cfg_want_platform_change(). */
+    guint platform_change_want_count;
+
+    /* What the last commit per address family was based on. A commit of type
+     * UPDATE with the same combined_l3cd_commited and without platform changes
+     * in the meantime cannot change anything. See _l3_commit_one(). */
+    const NML3ConfigData *commit_last_l3cd_x[2];
+    guint64               commit_last_platform_generation_x[2];
+    bool                  commit_last_valid_x[2];
+
+    NMPrioq           failedobj_prioq;
+    NMTimerQueueEntry failedobj_timeout;
 
     NML3CfgCommitType commit_on_idle_type;
 
@@ -1571,7 +1606,9 @@ _load_link(NML3Cfg *self, gboolean initial)
 /*****************************************************************************/
 
 void
-_nm_l3cfg_notify_platform_change_on_idle(NML3Cfg *self, guint32 obj_type_flags)
+_nm_l3cfg_notify_platform_change_on_idle(NML3Cfg *self,
+                                         guint32  obj_type_flags,
+                                         gboolean ip6_temporary_addrs_changed)
 {
     NML3ConfigNotifyData notify_data;
 
@@ -1580,7 +1617,8 @@ _nm_l3cfg_notify_platform_change_on_idle(NML3Cfg *self, guint32 obj_type_flags)
 
     notify_data.notify_type             = NM_L3_CONFIG_NOTIFY_TYPE_PLATFORM_CHANGE_ON_IDLE;
     notify_data.platform_change_on_idle = (typeof(notify_data.platform_change_on_idle)) {
-        .obj_type_flags = obj_type_flags,
+        .obj_type_flags              = obj_type_flags,
+        .ip6_temporary_addrs_changed = ip6_temporary_addrs_changed,
     };
     _nm_l3cfg_emit_signal_notify(self, &notify_data);
 
@@ -1597,6 +1635,16 @@ _nm_l3cfg_notify_platform_change(NML3Cfg                   *self,
 
     nm_assert(NMP_OBJECT_IS_VALID(obj));
 
+    if (nmp_object_ip6_address_is_kernel_temporary(obj)) {
+        /* Kernel rotates temporary addresses on its own, and we never configure
+         * them. They don't affect what a commit does (the sync keeps them as long
+         * as their IFA_F_MANAGETEMPADDR address exists), so don't invalidate
+         * the last commit and don't track them. */
+        goto out_notify;
+    }
+
+    self->priv.p->platform_generation++;
+
     obj_type = NMP_OBJECT_GET_TYPE(obj);
 
     switch (obj_type) {
@@ -1622,6 +1670,12 @@ _nm_l3cfg_notify_platform_change(NML3Cfg                   *self,
         break;
     }
 
+out_notify:
+    /* During a large resync, there are many changes per interface. Don't
+     * emit a signal for each of them, unless somebody asked for it. */
+    if (self->priv.p->platform_change_want_count == 0)
+        return;
+
     notify_data.notify_type     = NM_L3_CONFIG_NOTIFY_TYPE_PLATFORM_CHANGE;
     notify_data.platform_change = (typeof(notify_data.platform_change)) {
         .obj         = obj,
@@ -1632,6 +1686,28 @@ _nm_l3cfg_notify_platform_change(NML3Cfg                   *self,
     nm_assert(NMP_OBJECT_IS_VALID(obj));
 }
 
+/**
+ * nm_l3cfg_want_platform_change:
+ * @self: the #NML3Cfg
+ * @want: whether to register or unregister
+ *
+ * NM_L3_CONFIG_NOTIFY_TYPE_PLATFORM_CHANGE is only emitted while there
+ * are registered users. Every call with @want %TRUE must be paired with a
+ * call with %FALSE.
+ */
+void
+nm_l3cfg_want_platform_change(NML3Cfg *self, gboolean want)
+{
+    g_return_if_fail(NM_IS_L3CFG(self));
+
+    if (want)
+        self->priv.p->platform_change_want_count++;
+    else {
+        nm_assert(self->priv.p->platform_change_want_count > 0);
+        self->priv.p->platform_change_want_count--;
+    }
+}
+
 /*****************************************************************************/
 
 gboolean
@@ -2094,6 +2170,7 @@ _l3_acd_data_prune_one(NML3Cfg *self, AcdData *acd_data, gboolean all /* or only
     _LOGT_acd(acd_data, "removed");
     if (!g_hash_table_remove(self->priv.p->acd_lst_hash, acd_data))
         nm_assert_not_reached();
+    self->priv.p->acd_generation++;
     _acd_data_free(acd_data);
 }
 
@@ -2178,6 +2255,7 @@ _l3_acd_data_add(NML3Cfg              *self,
         c_list_link_tail(&self->priv.p->acd_lst_head, &acd_data->acd_lst);
         if (!g_hash_table_add(self->priv.p->acd_lst_hash, acd_data))
             nm_assert_not_reached();
+        self->priv.p->acd_generation++;
         acd_track = NULL;
     } else
         acd_track = _acd_data_find_track(acd_data, l3cd, obj, tag);
@@ -2422,6 +2500,7 @@ _nm_printf(5, 6) static void _l3_acd_data_state_set_full(NML3Cfg         *self,
 
     old_state            = acd_data->info.state;
     acd_data->info.state = state;
+    self->priv.p->acd_generation++;
     _nm_l3cfg_emit_signal_notify_acd_event_queue(self, acd_data);
 
     if (state == NM_L3_ACD_ADDR_STATE_EXTERNAL_REMOVED)
@@ -3360,24 +3439,27 @@ nm_l3cfg_check_ready(NML3Cfg               *self,
 
 /*****************************************************************************/
 
-static gboolean
-_l3_commit_on_idle_cb(gpointer user_data)
+#define _l3_commit_on_idle_is_scheduled(self) \
+    (!c_list_is_empty(&(self)->internal_netns.commit_pending_lst))
+
+/* Called by NMNetns, which commits all scheduled NML3Cfg instances of the
+ * namespace together from one idle handler. NMNetns already unlinked
+ * us from its list, we only need to release the reference that was taken
+ * by nm_l3cfg_commit_on_idle_schedule(). */
+void
+_nm_l3cfg_commit_on_idle(NML3Cfg *self)
 {
-    _nm_unused gs_unref_object NML3Cfg *self_keep_alive = NULL;
-    NML3Cfg                            *self            = user_data;
+    _nm_unused gs_unref_object NML3Cfg *self_keep_alive = self;
     NML3CfgCommitType                   commit_type;
 
-    commit_type = self->priv.p->commit_on_idle_type;
+    nm_assert(NM_IS_L3CFG(self));
+    nm_assert(!_l3_commit_on_idle_is_scheduled(self));
 
-    if (nm_clear_g_source_inst(&self->priv.p->commit_on_idle_source))
-        self_keep_alive = self;
-    else
-        nm_assert_not_reached();
+    commit_type = self->priv.p->commit_on_idle_type;
 
     self->priv.p->commit_on_idle_type = NM_L3_CFG_COMMIT_TYPE_AUTO;
 
     _l3_commit(self, commit_type, TRUE);
-    return G_SOURCE_REMOVE;
 }
 
 /* DOC(l3cfg:commit-type):
@@ -3405,7 +3487,7 @@ nm_l3cfg_commit_on_idle_schedule(NML3Cfg *self, NML3CfgCommitType commit_type)
                         NM_L3_CFG_COMMIT_TYPE_UPDATE,
                         NM_L3_CFG_COMMIT_TYPE_REAPPLY));
 
-    if (self->priv.p->commit_on_idle_source) {
+    if (_l3_commit_on_idle_is_scheduled(self)) {
         if (self->priv.p->commit_on_idle_type < commit_type) {
             /* For multiple calls, we collect the maximum "commit-type". */
             _LOGT("schedule commit on idle (upgrade type to %s)",
@@ -3419,8 +3501,8 @@ nm_l3cfg_commit_on_idle_schedule(NML3Cfg *self, NML3CfgCommitType commit_type)
 
     _LOGT("schedule commit on idle (%s)",
           _l3_cfg_commit_type_to_string(commit_type, sbuf_commit_type, sizeof(sbuf_commit_type)));
-    self->priv.p->commit_on_idle_source = nm_g_idle_add_source(_l3_commit_on_idle_cb, self);
-    self->priv.p->commit_on_idle_type   = commit_type;
+    _nm_netns_l3cfg_commit_on_idle_schedule(self->priv.netns, self);
+    self->priv.p->commit_on_idle_type = commit_type;
 
     /* While we have an idle update scheduled, we need to keep the instance alive. */
     g_object_ref(self);
@@ -3433,7 +3515,7 @@ nm_l3cfg_commit_on_idle_is_scheduled(NML3Cfg *self)
 {
     nm_assert(NM_IS_L3CFG(self));
 
-    return !!(self->priv.p->commit_on_idle_source);
+    return _l3_commit_on_idle_is_scheduled(self);
 }
 
 /*****************************************************************************/
@@ -3498,6 +3580,70 @@ _l3_config_datas_remove_index_fast(GArray *arr, guint idx)
     g_array_remove_index_fast(arr, idx);
 }
 
+static void
+_l3_config_data_clear_l3cd(gpointer data)
+{
+    nm_l3_config_data_unref(((L3ConfigData *) data)->l3cd);
+}
+
+/* Whether @a and @b give the same result when merged by _l3cfg_update_combined_config(). */
+static gboolean
+_l3_config_datas_merge_equal(const L3ConfigData *a, const L3ConfigData *b)
+{
+    return a->l3cd == b->l3cd && a->tag_confdata == b->tag_confdata
+           && a->config_flags == b->config_flags && a->merge_flags == b->merge_flags
+           && a->default_route_table_4 == b->default_route_table_4
+           && a->default_route_table_6 == b->default_route_table_6
+           && a->default_route_metric_4 == b->default_route_metric_4
+           && a->default_route_metric_6 == b->default_route_metric_6
+           && a->default_route_penalty_4 == b->default_route_penalty_4
+           && a->default_route_penalty_6 == b->default_route_penalty_6
+           && a->default_dns_priority_4 == b->default_dns_priority_4
+           && a->default_dns_priority_6 == b->default_dns_priority_6;
+}
+
+static void
+_l3_merge_cache_clear(NML3Cfg *self)
+{
+    nm_clear_pointer(&self->priv.p->merge_cache.last_datas, g_array_unref);
+    nm_clear_l3cd(&self->priv.p->merge_cache.prefix_l3cd);
+    self->priv.p->merge_cache.prefix_len = 0;
+}
+
+/* Returns the number of leading entries of @l3_config_datas_arr, that are unchanged
+ * since the last rebuild. Afterwards, remembers @l3_config_datas_arr for the next time. */
+static guint
+_l3_merge_cache_update_last(NML3Cfg             *self,
+                            const L3ConfigData **l3_config_datas_arr,
+                            guint                l3_config_datas_len)
+{
+    GArray *last_datas = self->priv.p->merge_cache.last_datas;
+    guint   n_common;
+    guint   i;
+
+    if (!last_datas) {
+        last_datas = g_array_sized_new(FALSE, FALSE, sizeof(L3ConfigData), l3_config_datas_len);
+        g_array_set_clear_func(last_datas, _l3_config_data_clear_l3cd);
+        self->priv.p->merge_cache.last_datas = last_datas;
+    }
+
+    for (n_common = 0; n_common < MIN(last_datas->len, l3_config_datas_len); n_common++) {
+        if (!_l3_config_datas_merge_equal(_l3_config_datas_at(last_datas, n_common),
+                                          l3_config_datas_arr[n_common]))
+            break;
+    }
+
+    g_array_set_size(last_datas, n_common);
+    for (i = n_common; i < l3_config_datas_len; i++) {
+        L3ConfigData *l3_config_data = nm_g_array_append_new(last_datas, L3ConfigData);
+
+        *l3_config_data = *l3_config_datas_arr[i];
+        nm_l3_config_data_ref(l3_config_data->l3cd);
+    }
+
+    return n_common;
+}
+
 void
 nm_l3cfg_mark_config_dirty(NML3Cfg *self, gconstpointer tag, gboolean dirty)
 {
@@ -3810,6 +3956,10 @@ out_clear:
         changed = TRUE;
 
     if (changed || commit_type >= NM_L3_CFG_COMMIT_TYPE_REAPPLY) {
+        /* When NMNetns commits several NML3Cfg instances in a batch, it syncs
+         * the global tracker once at the end. */
+        if (_nm_netns_l3cfg_commit_defer_nodev_routes_sync(self->priv.netns, addr_family))
+            return;
         nmp_global_tracker_sync(self->priv.global_tracker,
                                 NMP_OBJECT_TYPE_IP_ROUTE(IS_IPv4),
                                 FALSE);
@@ -4183,19 +4333,50 @@ _l3cfg_update_combined_config(NML3Cfg               *self,
         self->priv.p->changed_configs_acd_state = FALSE;
     }
 
-    if (l3_config_datas_len > 0) {
+    if (l3_config_datas_len == 0) {
+        _l3_merge_cache_clear(self);
+    } else {
         L3ConfigMergeHookAddObjData hook_data = {
             .self      = self,
             .to_commit = to_commit,
         };
+        guint n_unchanged;
+
+        n_unchanged = _l3_merge_cache_update_last(self, l3_config_datas_arr, l3_config_datas_len);
+
+        if (self->priv.p->merge_cache.prefix_l3cd
+            && self->priv.p->merge_cache.prefix_len <= n_unchanged
+            && self->priv.p->merge_cache.prefix_to_commit == to_commit
+            && self->priv.p->merge_cache.prefix_acd_generation == self->priv.p->acd_generation) {
+            /* The first entries are the same as in the last merge. Start with a clone of
+             * their merge result. The clone shares the already merged NMPObjects. */
+            l3cd = nm_l3_config_data_new_clone(self->priv.p->merge_cache.prefix_l3cd, 0);
+            i    = self->priv.p->merge_cache.prefix_len;
+        } else {
+            nm_clear_l3cd(&self->priv.p->merge_cache.prefix_l3cd);
+            self->priv.p->merge_cache.prefix_len = 0;
 
-        l3cd = nm_l3_config_data_new(nm_platform_get_multi_idx(self->priv.platform),
-                                     self->priv.ifindex,
-                                     NM_IP_CONFIG_SOURCE_UNKNOWN);
+            l3cd = nm_l3_config_data_new(nm_platform_get_multi_idx(self->priv.platform),
+                                         self->priv.ifindex,
+                                         NM_IP_CONFIG_SOURCE_UNKNOWN);
+            i    = 0;
+        }
 
-        for (i = 0; i < l3_config_datas_len; i++) {
+        for (; i < l3_config_datas_len; i++) {
             const L3ConfigData *l3cd_data = l3_config_datas_arr[i];
 
+            if (i == n_unchanged && i > self->priv.p->merge_cache.prefix_len) {
+                /* All entries before @i were unchanged. Remember their merge result,
+                 * so that the next rebuild can start from there. */
+                nm_clear_l3cd(&self->priv.p->merge_cache.prefix_l3cd);
+                self->priv.p->merge_cache.prefix_l3cd =
+                    nm_l3_config_data_seal(nm_l3_config_data_new_clone(l3cd, 0));
+
+                self->priv.p->merge_cache.prefix_len            = i;
+                self->priv.p->merge_cache.prefix_to_commit      = to_commit;
+                self->priv.p->merge_cache.prefix_acd_generation = self->priv.p->acd_generation;
+            }
+
             /* more important entries must be sorted *first*. */
             nm_assert(
                 i == 0
@@ -4328,18 +4509,14 @@ out:
 
 /*****************************************************************************/
 
-static gboolean
-_failedobj_timeout_cb(gpointer user_data)
+static void
+_failedobj_timeout_cb(NMTimerQueueEntry *entry, gpointer user_data)
 {
     NML3Cfg *self = NM_L3CFG(user_data);
 
     _LOGT("obj-state: failed-obj: handle timeout");
 
-    nm_clear_g_source_inst(&self->priv.p->failedobj_timeout_source);
-
     nm_l3cfg_commit_on_idle_schedule(self, NM_L3_CFG_COMMIT_TYPE_AUTO);
-
-    return G_SOURCE_CONTINUE;
 }
 
 static void
@@ -4378,16 +4555,18 @@ again:
     }
 
     if (!obj_state) {
-        if (nm_clear_g_source_inst(&self->priv.p->failedobj_timeout_source))
+        if (nm_timer_queue_cancel(&self->priv.p->failedobj_timeout))
             _LOGT("obj-state: failed-obj: cancel timeout");
         return;
     }
 
-    if (nm_g_timeout_reschedule(&self->priv.p->failedobj_timeout_source,
-                                &self->priv.p->failedobj_timeout_expiry_msec,
+    if (!nm_timer_queue_entry_is_scheduled(&self->priv.p->failedobj_timeout)
+        || nm_timer_queue_entry_get_expiry_msec(&self->priv.p->failedobj_timeout)
+               != obj_state->os_failedobj_expiry_msec) {
+        nm_timer_queue_schedule(&self->priv.p->failedobj_timeout,
                                 obj_state->os_failedobj_expiry_msec,
                                 _failedobj_timeout_cb,
-                                self)) {
+                                self);
         _LOGT(
             "obj-state: failed-obj: schedule timeout in %" G_GINT64_FORMAT " msec",
             NM_MAX((gint64) 0,
@@ -4488,6 +4667,34 @@ _failedobj_handle_routes(NML3Cfg *self, int addr_family, GPtrArray *routes_faile
     }
 }
 
+static void
+_failedobj_handle_addresses(NML3Cfg *self, int addr_family, GPtrArray *addresses_failed)
+{
+    char  sbuf[NM_UTILS_TO_STRING_BUFFER_SIZE];
+    guint i;
+
+    if (!addresses_failed)
+        return;
+
+    for (i = 0; i < addresses_failed->len; i++) {
+        const NMPObject    *o = addresses_failed->pdata[i];
+        const ObjStateData *obj_state;
+
+        nm_assert(NMP_OBJECT_GET_TYPE(o) == NMP_OBJECT_TYPE_IP_ADDRESS(NM_IS_IPv4(addr_family)));
+
+        obj_state = g_hash_table_lookup(self->priv.p->obj_state_hash, &o);
+        if (obj_state && obj_state->os_plobj) {
+            /* This object is apparently present in platform. Not sure what this failure report
+             * is about. Probably some harmless glitch. Ignore. */
+            continue;
+        }
+
+        _LOGW("unable to configure IPv%c address: %s",
+              nm_utils_addr_family_to_char(addr_family),
+              nmp_object_to_string(o, NMP_OBJECT_TO_STRING_PUBLIC, sbuf, sizeof(sbuf)));
+    }
+}
+
 static int
 _failedobj_prioq_cmp(gconstpointer a, gconstpointer b)
 {
@@ -5206,6 +5413,39 @@ _l3_commit_mptcp(NML3Cfg *self, NML3CfgCommitType commit_type)
     _rp_filter_update(self, reapply);
 }
 
+static gboolean
+_l3_commit_one_can_skip(NML3Cfg *self, int addr_family, NML3CfgCommitType commit_type)
+{
+    const int IS_IPv4 = NM_IS_IPv4(addr_family);
+
+    if (commit_type != NM_L3_CFG_COMMIT_TYPE_UPDATE)
+        return FALSE;
+
+    if (!self->priv.p->commit_last_valid_x[IS_IPv4])
+        return FALSE;
+
+    /* The merged configuration is only replaced if it changed, so comparing
+     * the pointer is enough. We hold a reference, so it cannot be a new instance
+     * at the same address. */
+    if (self->priv.p->commit_last_l3cd_x[IS_IPv4] != self->priv.p->combined_l3cd_commited)
+        return FALSE;
+
+    if (self->priv.p->commit_last_platform_generation_x[IS_IPv4]
+        != self->priv.p->platform_generation)
+        return FALSE;
+
+    /* Zombies get pruned and failed objects retried during the next commits.
+     * ECMP routes are merged by NMNetns with the routes of other interfaces. */
+    if (!c_list_is_empty(&self->priv.p->obj_state_zombie_lst_head))
+        return FALSE;
+    if (!nm_prioq_isempty(&self->priv.p->failedobj_prioq))
+        return FALSE;
+    if (IS_IPv4 && !c_list_is_empty(&self->internal_netns.ecmp_track_ifindex_lst_head))
+        return FALSE;
+
+    return TRUE;
+}
+
 static void
 _l3_commit_one(NML3Cfg              *self,
                int                   addr_family,
@@ -5213,16 +5453,18 @@ _l3_commit_one(NML3Cfg              *self,
                const NML3ConfigData *l3cd_old)
 {
     const int                    IS_IPv4         = NM_IS_IPv4(addr_family);
-    gs_unref_ptrarray GPtrArray *addresses       = NULL;
-    gs_unref_ptrarray GPtrArray *routes          = NULL;
-    gs_unref_ptrarray GPtrArray *routes_nodev    = NULL;
-    gs_unref_ptrarray GPtrArray *addresses_prune = NULL;
-    gs_unref_ptrarray GPtrArray *routes_prune    = NULL;
-    gs_unref_ptrarray GPtrArray *routes_failed   = NULL;
+    gs_unref_ptrarray GPtrArray *addresses        = NULL;
+    gs_unref_ptrarray GPtrArray *routes           = NULL;
+    gs_unref_ptrarray GPtrArray *routes_nodev     = NULL;
+    gs_unref_ptrarray GPtrArray *addresses_prune  = NULL;
+    gs_unref_ptrarray GPtrArray *routes_prune     = NULL;
+    gs_unref_ptrarray GPtrArray *addresses_failed = NULL;
+    gs_unref_ptrarray GPtrArray *routes_failed    = NULL;
     NMIPRouteTableSyncMode       route_table_sync;
     char                         sbuf_commit_type[50];
     guint                        i;
     gboolean                     any_dirty = FALSE;
+    gint64                       perf_start;
 
     nm_assert(NM_IS_L3CFG(self));
     nm_assert(NM_IN_SET(commit_type,
@@ -5231,10 +5473,26 @@ _l3_commit_one(NML3Cfg              *self,
                         NM_L3_CFG_COMMIT_TYPE_UPDATE));
     nm_assert_addr_family(addr_family);
 
+    if (_l3_commit_one_can_skip(self, addr_family, commit_type)) {
+        _LOGT("committing IPv%c configuration (%s): skip, nothing changed",
+              nm_utils_addr_family_to_char(addr_family),
+              _l3_cfg_commit_type_to_string(commit_type,
+                                            sbuf_commit_type,
+                                            sizeof(sbuf_commit_type)));
+        if (!IS_IPv4) {
+            _l3_commit_ip6_privacy(self, commit_type);
+            _l3_commit_ndisc_params(self, commit_type);
+            _l3_commit_ip6_token(self, commit_type);
+        }
+        return;
+    }
+
     _LOGT("committing IPv%c configuration (%s)",
           nm_utils_addr_family_to_char(addr_family),
           _l3_cfg_commit_type_to_string(commit_type, sbuf_commit_type, sizeof(sbuf_commit_type)));
 
+    self->priv.p->commit_last_valid_x[IS_IPv4] = FALSE;
+
     if (IS_IPv4)
         any_dirty = _obj_states_track_mark_dirty(self, TRUE);
 
@@ -5363,20 +5621,32 @@ _l3_commit_one(NML3Cfg              *self,
                                 addresses_prune,
                                 self->priv.ifindex == NM_LOOPBACK_IFINDEX
                                     ? NMP_IP_ADDRESS_SYNC_FLAGS_NONE
-                                    : NMP_IP_ADDRESS_SYNC_FLAGS_WITH_NOPREFIXROUTE);
+                                    : NMP_IP_ADDRESS_SYNC_FLAGS_WITH_NOPREFIXROUTE,
+                                &addresses_failed);
 
     self->priv.p->commit_reentrant_count_ip_address_sync_x[IS_IPv4]--;
 
+    _failedobj_handle_addresses(self, addr_family, addresses_failed);
+
     _nodev_routes_sync(self, addr_family, commit_type, routes_nodev);
 
+    perf_start = nm_perf_start();
     nm_platform_ip_route_sync(self->priv.platform,
                               addr_family,
                               self->priv.ifindex,
                               routes,
                               routes_prune,
                               &routes_failed);
+    nm_perf_record(NM_PERF_PROBE_PLATFORM_IP_ROUTE_SYNC, perf_start);
 
     _failedobj_handle_routes(self, addr_family, routes_failed);
+
+    /* Remember what we committed. The platform changes caused by this very
+     * commit are already processed, so they don't count. */
+    nm_l3_config_data_reset(&self->priv.p->commit_last_l3cd_x[IS_IPv4],
+                            self->priv.p->combined_l3cd_commited);
+    self->priv.p->commit_last_platform_generation_x[IS_IPv4] = self->priv.p->platform_generation;
+    self->priv.p->commit_last_valid_x[IS_IPv4]               = !addresses_failed && !routes_failed;
 }
 
 static void
@@ -5389,6 +5659,7 @@ _l3_commit(NML3Cfg *self, NML3CfgCommitType commit_type, gboolean is_idle)
     gboolean                                 is_sticky_update      = FALSE;
     char                                     sbuf_ct[30];
     gboolean                                 changed_combined_l3cd;
+    gint64                                   perf_start;
 
     g_return_if_fail(NM_IS_L3CFG(self));
     nm_assert(NM_IN_SET(commit_type,
@@ -5429,13 +5700,17 @@ _l3_commit(NML3Cfg *self, NML3CfgCommitType commit_type, gboolean is_idle)
 
     nm_assert(commit_type > NM_L3_CFG_COMMIT_TYPE_AUTO);
 
-    if (nm_clear_g_source_inst(&self->priv.p->commit_on_idle_source))
+    if (_l3_commit_on_idle_is_scheduled(self)) {
+        c_list_unlink(&self->internal_netns.commit_pending_lst);
         self_keep_alive = self;
+    }
     self->priv.p->commit_on_idle_type = NM_L3_CFG_COMMIT_TYPE_AUTO;
 
     if (commit_type <= NM_L3_CFG_COMMIT_TYPE_NONE)
         return;
 
+    perf_start = nm_perf_start();
+
     self->priv.p->commit_reentrant_count++;
 
     _l3cfg_update_combined_config(self,
@@ -5464,6 +5739,8 @@ _l3_commit(NML3Cfg *self, NML3CfgCommitType commit_type, gboolean is_idle)
     nm_assert(self->priv.p->commit_reentrant_count == 1);
     self->priv.p->commit_reentrant_count--;
 
+    nm_perf_record(NM_PERF_PROBE_L3CFG_COMMIT, perf_start);
+
     _nm_l3cfg_emit_signal_notify_commit(self,
                                         NM_L3_CONFIG_NOTIFY_TYPE_POST_COMMIT,
                                         l3cd_old,
@@ -5805,7 +6082,7 @@ nm_l3cfg_is_ready(NML3Cfg *self)
         return FALSE;
     if (self->priv.p->changed_configs_acd_state)
         return FALSE;
-    if (self->priv.p->commit_on_idle_source)
+    if (_l3_commit_on_idle_is_scheduled(self))
         return FALSE;
 
     return TRUE;
@@ -5851,6 +6128,7 @@ nm_l3cfg_init(NML3Cfg *self)
     c_list_init(&self->priv.p->blocked_lst_head_6);
 
     c_list_init(&self->internal_netns.signal_pending_lst);
+    c_list_init(&self->internal_netns.commit_pending_lst);
     c_list_init(&self->internal_netns.ecmp_track_ifindex_lst_head);
 
     self->priv.p->obj_state_hash = g_hash_table_new_full(nmp_object_indirect_id_hash,
@@ -5859,6 +6137,7 @@ nm_l3cfg_init(NML3Cfg *self)
                                                          NULL);
 
     nm_prioq_init(&self->priv.p->failedobj_prioq, _failedobj_prioq_cmp);
+    nm_timer_queue_entry_init(&self->priv.p->failedobj_timeout);
 }
 
 static void
@@ -5904,7 +6183,7 @@ finalize(GObject *object)
     }
 
     nm_prioq_destroy(&self->priv.p->failedobj_prioq);
-    nm_clear_g_source_inst(&self->priv.p->failedobj_timeout_source);
+    nm_timer_queue_cancel(&self->priv.p->failedobj_timeout);
 
     nm_assert(c_list_is_empty(&self->internal_netns.signal_pending_lst));
     nm_assert(c_list_is_empty(&self->internal_netns.ecmp_track_ifindex_lst_head));
@@ -5919,7 +6198,7 @@ finalize(GObject *object)
     nm_assert(c_list_is_empty(&self->priv.p->blocked_lst_head_4));
     nm_assert(c_list_is_empty(&self->priv.p->blocked_lst_head_6));
 
-    nm_assert(!self->priv.p->commit_on_idle_source);
+    nm_assert(c_list_is_empty(&self->internal_netns.commit_pending_lst));
 
     _l3_acd_data_prune(self, TRUE);
 
@@ -5954,6 +6233,9 @@ finalize(GObject *object)
     g_clear_object(&self->priv.platform);
     nm_clear_pointer(&self->priv.global_tracker, nmp_global_tracker_unref);
 
+    _l3_merge_cache_clear(self);
+    nm_clear_l3cd(&self->priv.p->commit_last_l3cd_x[0]);
+    nm_clear_l3cd(&self->priv.p->commit_last_l3cd_x[1]);
     nm_clear_l3cd(&self->priv.p->combined_l3cd_merged);
     nm_clear_l3cd(&self->priv.p->combined_l3cd_commited);
 
@@ -143,7 +143,8 @@ typedef enum {
      * Contrary to NM_L3_CONFIG_NOTIFY_TYPE_PLATFORM_CHANGE_ON_IDLE, this even
      * is re-emitted synchronously. You probably want to hook to the on-idle signal,
      * unless you need to catch all intermediate changes too. Note that this
-     * event is not re-entrant safe (so beware what you are doing). */
+     * event is not re-entrant safe (so beware what you are doing).
+     * This is only emitted after nm_l3cfg_want_platform_change(). */
     NM_L3_CONFIG_NOTIFY_TYPE_PLATFORM_CHANGE,
 
     /* NML3Cfg hooks to the NMPlatform signals for link, addresses and routes.
@@ -179,6 +180,11 @@ typedef struct {
 
         struct {
             guint32 obj_type_flags;
+
+            /* Kernel created, removed or changed temporary IPv6 addresses.
+             * Those changes are not part of @obj_type_flags, because
+             * they are not relevant for most users. */
+            bool ip6_temporary_addrs_changed;
         } platform_change_on_idle;
 
         struct {
@@ -208,7 +214,9 @@ struct _NML3Cfg {
      * relevant to NMNetns here. */
     struct {
         guint32 signal_pending_obj_type_flags;
+        bool    signal_pending_ip6_temporary_addrs;
         CList   signal_pending_lst;
+        CList   commit_pending_lst;
         CList   ecmp_track_ifindex_lst_head;
     } internal_netns;
 };
@@ -223,12 +231,18 @@ NML3Cfg *nm_l3cfg_new(NMNetns *netns, int ifindex);
 
 gboolean nm_l3cfg_is_ready(NML3Cfg *self);
 
-void _nm_l3cfg_notify_platform_change_on_idle(NML3Cfg *self, guint32 obj_type_flags);
+void _nm_l3cfg_notify_platform_change_on_idle(NML3Cfg *self,
+                                              guint32  obj_type_flags,
+                                              gboolean ip6_temporary_addrs_changed);
+
+void _nm_l3cfg_commit_on_idle(NML3Cfg *self);
 
 void _nm_l3cfg_notify_platform_change(NML3Cfg                   *self,
                                       NMPlatformSignalChangeType change_type,
                                       const NMPObject           *obj);
 
+void nm_l3cfg_want_platform_change(NML3Cfg *self, gboolean want);
+
 /*****************************************************************************/
 
 struct _NMDedupMultiIndex;
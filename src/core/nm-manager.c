@@ -10,10 +10,15 @@
 
 #include <fcntl.h>
 #include <limits.h>
+#if HAVE_MALLOC_TRIM
+#include <malloc.h>
+#endif
 #include <stdlib.h>
 #include <sys/sendfile.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
 #include <sys/types.h>
+#include <gio/gunixfdlist.h>
 #include <unistd.h>
 
 #include "NetworkManagerUtils.h"
@@ -26,6 +31,7 @@
 #include "libnm-core-aux-intern/nm-common-macros.h"
 #include "libnm-core-intern/nm-core-internal.h"
 #include "libnm-glib-aux/nm-c-list.h"
+#include "libnm-glib-aux/nm-ref-string.h"
 #include "libnm-platform/nm-platform.h"
 #include "libnm-platform/nmp-object.h"
 #include "libnm-std-aux/nm-dbus-compat.h"
@@ -42,11 +48,14 @@
 #include "nm-dispatcher.h"
 #include "nm-hostname-manager.h"
 #include "nm-keep-alive.h"
+#include "nm-l3-config-data.h"
 #include "nm-policy.h"
 #include "nm-priv-helper-call.h"
 #include "nm-rfkill-manager.h"
 #include "nm-session-monitor.h"
 #include "nm-power-monitor.h"
+#include "nm-perf.h"
+#include "nm-startup-trace.h"
 #include "settings/nm-settings-connection.h"
 #include "settings/nm-settings.h"
 #include "vpn/nm-vpn-manager.h"
@@ -189,7 +198,13 @@ typedef struct {
     NMActiveConnection *activating_connection;
     NMMetered           metered;
 
-    CList devices_lst_head;
+    CList       devices_lst_head;
+    GHashTable *devices_by_ifindex;
+    GHashTable *devices_by_iface;
+
+    /* While set, system_create_virtual_device() queues the devices to create
+     * here, so that their links are created together. */
+    GArray *create_and_realize_batch;
 
     NMState            state;
     NMConfig          *config;
@@ -225,6 +240,10 @@ typedef struct {
 
     GHashTable *sleep_devices;
 
+    /* Devices kept up during suspend with "fast-resume", mapped to their
+     * resume id. See _fast_resume_id(). */
+    GHashTable *fast_resume_devices;
+
     /* Firmware dir monitor */
     GFileMonitor *fw_monitor;
     guint         fw_changed_id;
@@ -233,6 +252,8 @@ typedef struct {
 
     guint devices_inited_id;
 
+    guint memory_trim_id;
+
     guint radio_flags;
 
     NMConnectivityState connectivity_state;
@@ -392,6 +413,7 @@ static void policy_activating_ac_changed(GObject *object, GParamSpec *pspec, gpo
 
 static void device_has_pending_action_changed(NMDevice *device, GParamSpec *pspec, NMManager *self);
 static void check_if_startup_complete(NMManager *self);
+static void _memory_trim_schedule(NMManager *self, const char *reason);
 
 static gboolean find_controller(NMManager             *self,
                                 NMConnection          *connection,
@@ -1239,6 +1261,42 @@ nm_manager_get_activatable_connections(NMManager *manager,
         NULL);
 }
 
+/**
+ * nm_manager_get_activatable_connections_for_device:
+ * @manager: the #NMManager
+ * @device: the #NMDevice
+ * @out_len: (out) (optional): the number of returned connections
+ *
+ * Like nm_manager_get_activatable_connections() for auto activation and
+ * sorted, but only returns profiles that are candidates for @device. That
+ * is, it skips profiles whose interface-name or connection type rule
+ * out @device, without calling into the device.
+ *
+ * Returns: (transfer container): a %NULL terminated list of profiles.
+ */
+NMSettingsConnection **
+nm_manager_get_activatable_connections_for_device(NMManager *manager,
+                                                  NMDevice  *device,
+                                                  guint     *out_len)
+{
+    NMManagerPrivate                         *priv = NM_MANAGER_GET_PRIVATE(manager);
+    const GetActivatableConnectionsFilterData d    = {
+           .self                = manager,
+           .for_auto_activation = TRUE,
+    };
+
+    /* a profile with "connection.interface-name" only matches the device with that
+     * name, see check_connection_compatible(). Likewise, most device types only
+     * accept profiles of one type. */
+    return nm_settings_get_connections_for_iface(
+        priv->settings,
+        nm_device_get_iface(device),
+        NM_DEVICE_GET_CLASS(device)->connection_type_check_compatible,
+        _get_activatable_connections_filter,
+        (gpointer) &d,
+        out_len);
+}
+
 static NMActiveConnection *
 active_connection_get_by_path(NMManager *self, const char *path)
 {
@@ -1731,6 +1789,25 @@ _config_changed_cb(NMConfig           *config,
                    NMConfigData       *old_data,
                    NMManager          *self)
 {
+    NMManagerPrivate *priv = NM_MANAGER_GET_PRIVATE(self);
+
+    nm_platform_trace_set_size(priv->platform,
+                               nm_config_data_get_logging_platform_trace_size(config_data));
+
+    if (!nm_streq0(nm_config_data_get_logging_rate_limit(config_data),
+                   nm_config_data_get_logging_rate_limit(old_data))) {
+        gs_free_error GError *error = NULL;
+
+        if (!nm_logging_set_rate_limit(nm_config_data_get_logging_rate_limit(config_data), &error))
+            _LOGW(LOGD_CORE, "config: invalid logging rate limit: %s", error->message);
+    }
+
+    if (NM_FLAGS_HAS(changes, NM_CONFIG_CHANGE_CAUSE_SIGUSR2)) {
+        nm_platform_trace_dump(priv->platform);
+        nm_perf_dump();
+        _memory_stats_dump(self);
+    }
+
     g_object_freeze_notify(G_OBJECT(self));
 
     if (NM_FLAGS_HAS(changes, NM_CONFIG_CHANGE_GLOBAL_DNS_CONFIG))
@@ -1858,20 +1935,83 @@ nm_manager_get_device_by_path(NMManager *self, const char *path)
     return device;
 }
 
-NMDevice *
-nm_manager_get_device_by_ifindex(NMManager *self, int ifindex)
+/* Update the indexes by ifindex and by interface name for @device. They are
+ * looked up for every platform link event, which on hosts with many links
+ * must not iterate over all devices. */
+static void
+_devices_idx_update(NMManager *self, NMDevice *device, gboolean remove)
 {
     NMManagerPrivate *priv = NM_MANAGER_GET_PRIVATE(self);
-    NMDevice         *device;
+    NMDevice         *candidate;
+    GPtrArray        *arr;
+    const char       *iface;
+    int               ifindex;
 
-    if (ifindex > 0) {
-        c_list_for_each_entry (device, &priv->devices_lst_head, devices_lst) {
-            if (nm_device_get_ifindex(device) == ifindex)
-                return device;
+    ifindex = remove ? 0 : NM_MAX(nm_device_get_ifindex(device), 0);
+    if (device->devices_idx_ifindex != ifindex) {
+        int ifindex_old = device->devices_idx_ifindex;
+
+        device->devices_idx_ifindex = ifindex;
+
+        if (ifindex_old > 0
+            && g_hash_table_lookup(priv->devices_by_ifindex, GINT_TO_POINTER(ifindex_old))
+                   == device) {
+            g_hash_table_remove(priv->devices_by_ifindex, GINT_TO_POINTER(ifindex_old));
+
+            /* Rarely, another device has the same ifindex. Index that one instead. */
+            c_list_for_each_entry (candidate, &priv->devices_lst_head, devices_lst) {
+                if (candidate != device && candidate->devices_idx_ifindex == ifindex_old) {
+                    g_hash_table_insert(priv->devices_by_ifindex,
+                                        GINT_TO_POINTER(ifindex_old),
+                                        candidate);
+                    break;
+                }
+            }
         }
+
+        if (ifindex > 0
+            && !g_hash_table_contains(priv->devices_by_ifindex, GINT_TO_POINTER(ifindex)))
+            g_hash_table_insert(priv->devices_by_ifindex, GINT_TO_POINTER(ifindex), device);
     }
 
-    return NULL;
+    iface = remove ? NULL : nm_device_get_iface(device);
+    if (!nm_streq0(device->devices_idx_iface, iface)) {
+        if (device->devices_idx_iface) {
+            arr = g_hash_table_lookup(priv->devices_by_iface, device->devices_idx_iface);
+            nm_assert(arr);
+            g_ptr_array_remove(arr, device);
+            if (arr->len == 0)
+                g_hash_table_remove(priv->devices_by_iface, device->devices_idx_iface);
+            nm_clear_g_free(&device->devices_idx_iface);
+        }
+        if (iface) {
+            device->devices_idx_iface = g_strdup(iface);
+            arr = g_hash_table_lookup(priv->devices_by_iface, iface);
+            if (!arr) {
+                arr = g_ptr_array_new();
+                g_hash_table_insert(priv->devices_by_iface, g_strdup(iface), arr);
+            }
+            g_ptr_array_add(arr, device);
+        }
+    }
+}
+
+/* Returns the devices with interface name @iface, or %NULL. */
+static GPtrArray *
+_devices_by_iface(NMManager *self, const char *iface)
+{
+    return g_hash_table_lookup(NM_MANAGER_GET_PRIVATE(self)->devices_by_iface, iface);
+}
+
+NMDevice *
+nm_manager_get_device_by_ifindex(NMManager *self, int ifindex)
+{
+    NMManagerPrivate *priv = NM_MANAGER_GET_PRIVATE(self);
+
+    if (ifindex <= 0)
+        return NULL;
+
+    return g_hash_table_lookup(priv->devices_by_ifindex, GINT_TO_POINTER(ifindex));
 }
 
 static NMDevice *
@@ -1934,15 +2074,19 @@ find_device_by_iface(NMManager    *self,
                      NMConnection *port,
                      NMConnection *child)
 {
-    NMManagerPrivate *priv     = NM_MANAGER_GET_PRIVATE(self);
-    NMDevice         *fallback = NULL;
-    NMDevice         *candidate;
+    NMDevice  *fallback = NULL;
+    GPtrArray *devices;
+    guint      i;
 
     g_return_val_if_fail(iface != NULL, NULL);
 
-    c_list_for_each_entry (candidate, &priv->devices_lst_head, devices_lst) {
-        if (!nm_streq(nm_device_get_iface(candidate), iface))
-            continue;
+    devices = _devices_by_iface(self, iface);
+    if (!devices)
+        return NULL;
+
+    for (i = 0; i < devices->len; i++) {
+        NMDevice *candidate = devices->pdata[i];
+
         if (connection && !nm_device_check_connection_compatible(candidate, connection, TRUE, NULL))
             continue;
         if (port) {
@@ -2178,6 +2322,7 @@ check_if_startup_complete(NMManager *self)
         return;
 
     if (nm_dns_manager_get_update_pending(nm_manager_get_dns_manager(self))) {
+        nm_startup_trace_blocker("dns", "update pending");
         if (priv->dns_mgr_update_pending_signal_id == 0) {
             priv->dns_mgr_update_pending_signal_id =
                 g_signal_connect(nm_manager_get_dns_manager(self),
@@ -2198,6 +2343,7 @@ check_if_startup_complete(NMManager *self)
                   "startup complete is waiting for device '%s' (%s)",
                   nm_device_get_iface(device),
                   reason);
+            nm_startup_trace_blocker(nm_device_get_iface(device), reason);
             return;
         }
     }
@@ -2223,6 +2369,7 @@ check_if_startup_complete(NMManager *self)
     g_signal_handlers_unblock_by_func(priv->settings, settings_startup_complete_changed, self);
     if (reason) {
         _LOGD(LOGD_CORE, "startup complete is waiting for connection (%s)", reason);
+        nm_startup_trace_blocker("settings", reason);
         return;
     }
 
@@ -2231,6 +2378,10 @@ check_if_startup_complete(NMManager *self)
      * Take care before rewording this message. */
     _LOGI(LOGD_CORE, "startup complete");
 
+    nm_startup_trace_finish();
+
+    _memory_trim_schedule(self, "startup");
+
     priv->startup = FALSE;
 
     /* we no longer care about these signals. Startup-complete only
@@ -2335,6 +2486,7 @@ remove_device(NMManager *self, NMDevice *device, gboolean quitting)
 
     _devcon_remove_device_all(self, device);
 
+    _devices_idx_update(self, device, TRUE);
     c_list_unlink(&device->devices_lst);
 
     _parent_notify_changed(self, device, TRUE);
@@ -2563,15 +2715,20 @@ nm_manager_iface_for_uuid(NMManager *self, const char *uuid)
 NMDevice *
 nm_manager_get_device(NMManager *self, const char *ifname, NMDeviceType device_type)
 {
-    NMManagerPrivate *priv = NM_MANAGER_GET_PRIVATE(self);
-    NMDevice         *device;
+    GPtrArray *devices;
+    guint      i;
 
     g_return_val_if_fail(ifname, NULL);
     g_return_val_if_fail(device_type != NM_DEVICE_TYPE_UNKNOWN, NULL);
 
-    c_list_for_each_entry (device, &priv->devices_lst_head, devices_lst) {
-        if (nm_device_get_device_type(device) == device_type
-            && nm_streq0(nm_device_get_iface(device), ifname))
+    devices = _devices_by_iface(self, ifname);
+    if (!devices)
+        return NULL;
+
+    for (i = 0; i < devices->len; i++) {
+        NMDevice *device = devices->pdata[i];
+
+        if (nm_device_get_device_type(device) == device_type)
             return device;
     }
 
@@ -2703,6 +2860,23 @@ system_create_virtual_device(NMManager *self, NMConnection *connection, GError *
             || nm_settings_connection_autoconnect_is_blocked(connections[i]))
             continue;
 
+        if (priv->create_and_realize_batch) {
+            GArray *batch = priv->create_and_realize_batch;
+            guint   j;
+
+            for (j = 0; j < batch->len; j++) {
+                if (nm_g_array_index(batch, NMDeviceCreateAndRealizeData, j).device == device)
+                    return device;
+            }
+            g_array_append_val(batch,
+                               ((NMDeviceCreateAndRealizeData) {
+                                   .device     = g_object_ref(device),
+                                   .connection = g_object_ref(connection),
+                                   .parent     = nm_g_object_ref(parent),
+                               }));
+            return device;
+        }
+
         /* Create any backing resources the device needs */
         if (!nm_device_create_and_realize(device, connection, parent, error))
             return NULL;
@@ -2787,16 +2961,55 @@ connection_updated_cb(NMSettings           *settings,
     connection_changed(self, sett_conn);
 }
 
+static void
+_create_and_realize_data_clear(gpointer data)
+{
+    NMDeviceCreateAndRealizeData *d = data;
+
+    g_object_unref(d->device);
+    g_object_unref(d->connection);
+    nm_g_object_unref(d->parent);
+    g_clear_error(&d->error);
+}
+
 static void
 connections_changed(NMManager *self)
 {
-    NMManagerPrivate            *priv = NM_MANAGER_GET_PRIVATE(self);
+    NMManagerPrivate            *priv  = NM_MANAGER_GET_PRIVATE(self);
+    nm_auto_unref_array GArray  *batch = NULL;
     NMSettingsConnection *const *connections;
     guint                        i;
 
+    /* With many virtual devices (like VLANs), create their links together,
+     * instead of waiting for kernel to acknowledge each one in turn. */
+    nm_assert(!priv->create_and_realize_batch);
+    batch = g_array_new(FALSE, FALSE, sizeof(NMDeviceCreateAndRealizeData));
+    g_array_set_clear_func(batch, _create_and_realize_data_clear);
+    priv->create_and_realize_batch = batch;
+
     connections = nm_settings_get_connections_sorted_by_autoconnect_priority(priv->settings, NULL);
     for (i = 0; connections[i]; i++)
         connection_changed(self, connections[i]);
+
+    priv->create_and_realize_batch = NULL;
+
+    if (batch->len == 0)
+        return;
+
+    nm_device_create_and_realize_many(nm_g_array_first_p(batch, NMDeviceCreateAndRealizeData),
+                                      batch->len);
+
+    for (i = 0; i < batch->len; i++) {
+        NMDeviceCreateAndRealizeData *d = &nm_g_array_index(batch, NMDeviceCreateAndRealizeData, i);
+
+        if (d->error) {
+            _LOG3D(LOGD_DEVICE,
+                   d->connection,
+                   "Can't create a virtual device: %s",
+                   d->error->message);
+        } else if (d->success)
+            retry_connections_for_parent_device(self, d->device);
+    }
 }
 
 /*****************************************************************************/
@@ -3829,6 +4042,8 @@ device_ip_iface_changed(NMDevice *device, GParamSpec *pspec, NMManager *self)
 static void
 device_iface_changed(NMDevice *device, GParamSpec *pspec, NMManager *self)
 {
+    _devices_idx_update(self, device, FALSE);
+
     /* Virtual connections may refer to the new device name as
      * parent device, retry to activate them.
      */
@@ -4023,6 +4238,7 @@ add_device(NMManager *self, NMDevice *device, GError **error)
 
     nm_assert(c_list_is_empty(&device->devices_lst));
     c_list_link_tail(&priv->devices_lst_head, &device->devices_lst);
+    _devices_idx_update(self, device, FALSE);
 
     g_signal_connect(device,
                      NM_DEVICE_STATE_CHANGED,
@@ -4151,6 +4367,53 @@ nm_manager_notify_device_availability_maybe_changed(NMManager *self)
 
 /*****************************************************************************/
 
+static gboolean
+_platform_link_is_port_representor(NMManager *self, const NMPlatformLink *plink)
+{
+    NMManagerPrivate *priv     = NM_MANAGER_GET_PRIVATE(self);
+    nm_auto_close int dirfd    = -1;
+    gs_free char     *name     = NULL;
+    char              ifname[IFNAMSIZ];
+    const char       *s;
+
+    /* Port representors of a NIC in switchdev mode have a phys_port_name
+     * like "pf0vf3" or "c1pf0sf2", while the uplink is "p0". */
+
+    dirfd = nm_platform_sysctl_open_netdir(priv->platform, plink->ifindex, ifname);
+    if (dirfd < 0)
+        return FALSE;
+
+    name = nm_platform_sysctl_get(priv->platform,
+                                  NMP_SYSCTL_PATHID_NETDIR_A(dirfd, ifname, "phys_port_name"));
+    if (!name)
+        return FALSE;
+
+    s = nm_strstrip(name);
+    if (s[0] == 'c') {
+        s++;
+        if (!g_ascii_isdigit(s[0]))
+            return FALSE;
+        while (g_ascii_isdigit(s[0]))
+            s++;
+    }
+    if (!NM_STR_HAS_PREFIX(s, "pf"))
+        return FALSE;
+    s += NM_STRLEN("pf");
+    if (!g_ascii_isdigit(s[0]))
+        return FALSE;
+    while (g_ascii_isdigit(s[0]))
+        s++;
+    if (!NM_STR_HAS_PREFIX(s, "vf") && !NM_STR_HAS_PREFIX(s, "sf"))
+        return FALSE;
+    s += NM_STRLEN("vf");
+    if (!g_ascii_isdigit(s[0]))
+        return FALSE;
+    while (g_ascii_isdigit(s[0]))
+        s++;
+
+    return s[0] == '\0';
+}
+
 static void
 platform_link_added(NMManager                     *self,
                     int                            ifindex,
@@ -4158,10 +4421,10 @@ platform_link_added(NMManager                     *self,
                     gboolean                       guess_assume,
                     const NMConfigDeviceStateData *dev_state)
 {
-    NMManagerPrivate *priv = NM_MANAGER_GET_PRIVATE(self);
-    NMDeviceFactory  *factory;
-    NMDevice         *device = NULL;
-    NMDevice         *candidate;
+    NMDeviceFactory *factory;
+    NMDevice        *device = NULL;
+    GPtrArray       *candidates;
+    guint            i;
 
     g_return_if_fail(ifindex > 0);
 
@@ -4169,7 +4432,9 @@ platform_link_added(NMManager                     *self,
         return;
 
     /* Let unrealized devices try to realize themselves with the link */
-    c_list_for_each_entry (candidate, &priv->devices_lst_head, devices_lst) {
+    candidates = _devices_by_iface(self, plink->name);
+    for (i = 0; candidates && i < candidates->len; i++) {
+        NMDevice             *candidate  = candidates->pdata[i];
         gboolean              compatible = TRUE;
         gs_free_error GError *error      = NULL;
 
@@ -4179,9 +4444,6 @@ platform_link_added(NMManager                     *self,
             continue;
         }
 
-        if (!nm_streq(nm_device_get_iface(candidate), plink->name))
-            continue;
-
         if (nm_device_is_real(candidate)) {
             /* There's already a realized device with the link's name
              * and a different ifindex.
@@ -4221,6 +4483,24 @@ platform_link_added(NMManager                     *self,
     }
 
 add:
+    if (nm_config_data_get_value_boolean(NM_CONFIG_GET_DATA,
+                                         NM_CONFIG_KEYFILE_GROUP_MAIN,
+                                         NM_CONFIG_KEYFILE_KEY_MAIN_IGNORE_PORT_REPRESENTORS,
+                                         FALSE)
+        && _platform_link_is_port_representor(self, plink)) {
+        _LOGD(LOGD_DEVICE, "(%s): ignoring port representor", plink->name);
+        return;
+    }
+
+    if (nm_match_spec_device_by_pllink(plink,
+                                       NULL,
+                                       NULL,
+                                       nm_config_data_get_ignore_devices(NM_CONFIG_GET_DATA),
+                                       FALSE)) {
+        _LOGD(LOGD_DEVICE, "(%s): ignoring device due to main.ignore-devices", plink->name);
+        return;
+    }
+
     if (dev_state && dev_state->generic_sw) {
         factory = nm_device_factory_get_generic_factory();
     } else {
@@ -4434,13 +4714,21 @@ platform_query_devices(NMManager *self)
     gs_unref_ptrarray GPtrArray *links = NULL;
     int                          i;
     gboolean                     guess_assume;
-    gs_free char                *order = NULL;
+    gs_free char                *order     = NULL;
+    gs_free int                 *ifindexes = NULL;
 
     guess_assume = nm_config_get_first_start(nm_config_get());
     links        = nm_platform_link_get_all(priv->platform);
     if (!links)
         return;
 
+    /* Realizing a device probes the link via ethtool and sysfs. With many links,
+     * that adds up. Let platform query them concurrently first. */
+    ifindexes = g_new(int, links->len);
+    for (i = 0; i < links->len; i++)
+        ifindexes[i] = NMP_OBJECT_CAST_LINK(links->pdata[i])->ifindex;
+    nm_platform_link_prefetch_probes(priv->platform, ifindexes, links->len);
+
     for (i = 0; i < links->len; i++) {
         const NMPlatformLink          *elem = NMP_OBJECT_CAST_LINK(links->pdata[i]);
         const NMPlatformLink          *link;
@@ -4466,6 +4754,8 @@ platform_query_devices(NMManager *self)
                             guess_assume && (!dev_state || !dev_state->connection_uuid),
                             dev_state);
     }
+
+    nm_platform_link_prefetch_clear(priv->platform);
 }
 
 static void
@@ -6559,38 +6849,35 @@ find_device_for_activation(NMManager            *self,
 
 /*****************************************************************************/
 
-static void
-_activation_auth_done(NMManager             *self,
-                      NMActiveConnection    *active,
-                      GDBusMethodInvocation *invocation,
-                      gboolean               success,
-                      const char            *error_desc)
+static gboolean
+_activation_auth_done_do(NMManager          *self,
+                         NMActiveConnection *active,
+                         gboolean            success,
+                         const char         *error_desc,
+                         GError            **error)
 {
-    GError               *error = NULL;
     NMAuthSubject        *subject;
     NMSettingsConnection *connection;
+    GError               *local = NULL;
 
     subject    = nm_active_connection_get_subject(active);
     connection = nm_active_connection_get_settings_connection(active);
 
     if (!success) {
-        error =
+        local =
             g_error_new_literal(NM_MANAGER_ERROR, NM_MANAGER_ERROR_PERMISSION_DENIED, error_desc);
         goto fail;
     }
 
-    if (!_internal_activate_generic(self, active, &error))
+    if (!_internal_activate_generic(self, active, &local))
         goto fail;
 
     nm_settings_connection_autoconnect_blocked_reason_set(
         connection,
         NM_SETTINGS_AUTOCONNECT_BLOCKED_REASON_USER_REQUEST,
         FALSE);
-    g_dbus_method_invocation_return_value(
-        invocation,
-        g_variant_new("(o)", nm_dbus_object_get_path(NM_DBUS_OBJECT(active))));
     nm_audit_log_connection_op(NM_AUDIT_OP_CONN_ACTIVATE, connection, TRUE, NULL, subject, NULL);
-    return;
+    return TRUE;
 
 fail:
     _delete_volatile_connection_do(self, connection);
@@ -6600,40 +6887,51 @@ fail:
                                FALSE,
                                NULL,
                                subject,
-                               error->message);
+                               local->message);
     nm_active_connection_set_state_fail(active,
                                         NM_ACTIVE_CONNECTION_STATE_REASON_UNKNOWN,
-                                        error->message);
+                                        local->message);
 
-    g_dbus_method_invocation_take_error(invocation, error);
+    g_propagate_error(error, local);
+    return FALSE;
 }
 
 static void
-impl_manager_activate_connection(NMDBusObject                      *obj,
-                                 const NMDBusInterfaceInfoExtended *interface_info,
-                                 const NMDBusMethodInfoExtended    *method_info,
-                                 GDBusConnection                   *dbus_connection,
-                                 const char                        *sender,
-                                 GDBusMethodInvocation             *invocation,
-                                 GVariant                          *parameters)
+_activation_auth_done(NMManager             *self,
+                      NMActiveConnection    *active,
+                      GDBusMethodInvocation *invocation,
+                      gboolean               success,
+                      const char            *error_desc)
 {
-    NMManager                          *self      = NM_MANAGER(obj);
-    NMManagerPrivate                   *priv      = NM_MANAGER_GET_PRIVATE(self);
-    gs_unref_object NMActiveConnection *active    = NULL;
-    gs_unref_object NMAuthSubject      *subject   = NULL;
-    NMSettingsConnection               *sett_conn = NULL;
-    NMDevice                           *device    = NULL;
-    gboolean                            is_vpn    = FALSE;
-    GError                             *error     = NULL;
-    const char                         *connection_path;
-    const char                         *device_path;
-    const char                         *specific_object_path;
+    GError *error = NULL;
 
-    g_variant_get(parameters, "(&o&o&o)", &connection_path, &device_path, &specific_object_path);
+    if (!_activation_auth_done_do(self, active, success, error_desc, &error)) {
+        g_dbus_method_invocation_take_error(invocation, error);
+        return;
+    }
 
-    connection_path      = nm_dbus_path_not_empty(connection_path);
-    specific_object_path = nm_dbus_path_not_empty(specific_object_path);
-    device_path          = nm_dbus_path_not_empty(device_path);
+    g_dbus_method_invocation_return_value(
+        invocation,
+        g_variant_new("(o)", nm_dbus_object_get_path(NM_DBUS_OBJECT(active))));
+}
+
+/* Creates the active connection for a user request to activate
+ * @connection_path on @device_path, as for ActivateConnection(). */
+static NMActiveConnection *
+_activation_user_request_new(NMManager             *self,
+                             NMAuthSubject         *subject,
+                             const char            *connection_path,
+                             const char            *device_path,
+                             const char            *specific_object_path,
+                             NMSettingsConnection **out_sett_conn,
+                             GError               **error)
+{
+    NMManagerPrivate     *priv      = NM_MANAGER_GET_PRIVATE(self);
+    NMSettingsConnection *sett_conn = NULL;
+    NMDevice             *device    = NULL;
+    gboolean              is_vpn    = FALSE;
+
+    *out_sett_conn = NULL;
 
     /* If the connection path is given and valid, that connection is activated.
      * Otherwise, the "best" connection for the device is chosen and activated,
@@ -6643,73 +6941,119 @@ impl_manager_activate_connection(NMDBusObject                      *obj,
     if (connection_path) {
         sett_conn = nm_settings_get_connection_by_path(priv->settings, connection_path);
         if (!sett_conn) {
-            error = g_error_new_literal(NM_MANAGER_ERROR,
-                                        NM_MANAGER_ERROR_UNKNOWN_CONNECTION,
-                                        "Connection could not be found.");
-            goto error;
+            g_set_error_literal(error,
+                                NM_MANAGER_ERROR,
+                                NM_MANAGER_ERROR_UNKNOWN_CONNECTION,
+                                "Connection could not be found.");
+            return NULL;
         }
     } else {
         /* If no connection is given, find a suitable connection for the given device path */
         if (!device_path) {
-            error = g_error_new_literal(
-                NM_MANAGER_ERROR,
-                NM_MANAGER_ERROR_UNKNOWN_DEVICE,
-                "Only devices may be activated without a specifying a connection");
-            goto error;
+            g_set_error_literal(error,
+                                NM_MANAGER_ERROR,
+                                NM_MANAGER_ERROR_UNKNOWN_DEVICE,
+                                "Only devices may be activated without a specifying a connection");
+            return NULL;
         }
         device = nm_manager_get_device_by_path(self, device_path);
         if (!device) {
-            error = g_error_new(NM_MANAGER_ERROR,
-                                NM_MANAGER_ERROR_UNKNOWN_DEVICE,
-                                "Can not activate an unknown device '%s'",
-                                device_path);
-            goto error;
+            g_set_error(error,
+                        NM_MANAGER_ERROR,
+                        NM_MANAGER_ERROR_UNKNOWN_DEVICE,
+                        "Can not activate an unknown device '%s'",
+                        device_path);
+            return NULL;
         }
 
-        sett_conn = nm_device_get_best_connection(device, specific_object_path, &error);
+        sett_conn = nm_device_get_best_connection(device, specific_object_path, error);
         if (!sett_conn)
-            goto error;
+            return NULL;
     }
 
-    subject = validate_activation_request(self, invocation, sett_conn, NULL, &error);
-    if (!subject)
-        goto error;
+    *out_sett_conn = sett_conn;
 
-    if (!find_device_for_activation(self, sett_conn, NULL, device_path, &device, &is_vpn, &error))
-        goto error;
+    if (!nm_auth_is_subject_in_acl_set_error(nm_settings_connection_get_connection(sett_conn),
+                                             subject,
+                                             NM_MANAGER_ERROR,
+                                             NM_MANAGER_ERROR_PERMISSION_DENIED,
+                                             error))
+        return NULL;
+
+    if (!find_device_for_activation(self, sett_conn, NULL, device_path, &device, &is_vpn, error))
+        return NULL;
 
     if (!device && !is_vpn) {
-        g_set_error_literal(&error,
+        g_set_error_literal(error,
                             NM_MANAGER_ERROR,
                             NM_MANAGER_ERROR_UNKNOWN_DEVICE,
                             "Failed to find a compatible device for this connection");
+        return NULL;
+    }
+
+    return _new_active_connection(self,
+                                  is_vpn,
+                                  sett_conn,
+                                  NULL,
+                                  NULL,
+                                  specific_object_path,
+                                  device,
+                                  subject,
+                                  NM_ACTIVATION_TYPE_MANAGED,
+                                  NM_ACTIVATION_REASON_USER_REQUEST,
+                                  _activation_bind_lifetime_to_profile_visibility(subject),
+                                  error);
+}
+
+static void
+impl_manager_activate_connection(NMDBusObject                      *obj,
+                                 const NMDBusInterfaceInfoExtended *interface_info,
+                                 const NMDBusMethodInfoExtended    *method_info,
+                                 GDBusConnection                   *dbus_connection,
+                                 const char                        *sender,
+                                 GDBusMethodInvocation             *invocation,
+                                 GVariant                          *parameters)
+{
+    NMManager                     *self      = NM_MANAGER(obj);
+    gs_unref_object NMAuthSubject *subject   = NULL;
+    NMSettingsConnection          *sett_conn = NULL;
+    NMActiveConnection            *active;
+    GError                        *error = NULL;
+    const char                    *connection_path;
+    const char                    *device_path;
+    const char                    *specific_object_path;
+
+    g_variant_get(parameters, "(&o&o&o)", &connection_path, &device_path, &specific_object_path);
+
+    connection_path      = nm_dbus_path_not_empty(connection_path);
+    specific_object_path = nm_dbus_path_not_empty(specific_object_path);
+    device_path          = nm_dbus_path_not_empty(device_path);
+
+    /* Validate the caller */
+    subject = nm_dbus_manager_new_auth_subject_from_context(invocation);
+    if (!subject) {
+        error = g_error_new_literal(NM_MANAGER_ERROR,
+                                    NM_MANAGER_ERROR_PERMISSION_DENIED,
+                                    NM_UTILS_ERROR_MSG_REQ_UID_UKNOWN);
         goto error;
     }
 
-    active = _new_active_connection(self,
-                                    is_vpn,
-                                    sett_conn,
-                                    NULL,
-                                    NULL,
-                                    specific_object_path,
-                                    device,
-                                    subject,
-                                    NM_ACTIVATION_TYPE_MANAGED,
-                                    NM_ACTIVATION_REASON_USER_REQUEST,
-                                    _activation_bind_lifetime_to_profile_visibility(subject),
-                                    &error);
+    active = _activation_user_request_new(self,
+                                          subject,
+                                          connection_path,
+                                          device_path,
+                                          specific_object_path,
+                                          &sett_conn,
+                                          &error);
     if (!active)
         goto error;
 
+    /* the async op data takes the reference of @active. */
     nm_active_connection_authorize(
         active,
         NULL,
         _async_op_complete_ac_auth_cb,
         _async_op_data_new_ac_auth_activate_user(self, active, invocation));
-
-    /* we passed the pointer on to _async_op_data_new_ac_auth_activate_user() */
-    g_steal_pointer(&active);
-
     return;
 
 error:
@@ -6726,6 +7070,260 @@ error:
 
 /*****************************************************************************/
 
+typedef struct {
+    NMActiveConnection *active;
+    char               *error_message;
+} ActivateConnectionsItem;
+
+typedef struct {
+    NMAuthSubject          *subject;
+    gsize                   n_items;
+    ActivateConnectionsItem items[];
+} ActivateConnectionsData;
+
+static void
+_activate_connections_data_free(ActivateConnectionsData *data)
+{
+    gsize i;
+
+    for (i = 0; i < data->n_items; i++) {
+        nm_g_object_unref(data->items[i].active);
+        g_free(data->items[i].error_message);
+    }
+    g_object_unref(data->subject);
+    g_free(data);
+}
+
+static void
+_activate_connections_return(GDBusMethodInvocation *context, const ActivateConnectionsData *data)
+{
+    GVariantBuilder builder;
+    gsize           i;
+
+    g_variant_builder_init(&builder, G_VARIANT_TYPE("aa{sv}"));
+    for (i = 0; i < data->n_items; i++) {
+        const ActivateConnectionsItem *item = &data->items[i];
+        GVariantBuilder                item_builder;
+
+        g_variant_builder_init(&item_builder, G_VARIANT_TYPE_VARDICT);
+        if (item->active) {
+            g_variant_builder_add(
+                &item_builder,
+                "{sv}",
+                "active-connection",
+                g_variant_new_object_path(nm_dbus_object_get_path(NM_DBUS_OBJECT(item->active))));
+        } else {
+            g_variant_builder_add(&item_builder,
+                                  "{sv}",
+                                  "error",
+                                  g_variant_new_string(item->error_message));
+        }
+        g_variant_builder_add(&builder, "a{sv}", &item_builder);
+    }
+
+    g_dbus_method_invocation_return_value(context, g_variant_new("(aa{sv})", &builder));
+}
+
+static void
+activate_connections_auth_cb(NMAuthChain           *chain,
+                             GDBusMethodInvocation *context,
+                             gpointer               user_data)
+{
+    NMManager               *self = NM_MANAGER(user_data);
+    ActivateConnectionsData *data;
+    gboolean                 allowed;
+    gsize                    i;
+
+    nm_assert(G_IS_DBUS_METHOD_INVOCATION(context));
+
+    c_list_unlink(nm_auth_chain_parent_lst_list(chain));
+
+    data = nm_auth_chain_get_data(chain, "data");
+
+    allowed = (nm_auth_chain_get_result(chain, NM_AUTH_PERMISSION_NETWORK_CONTROL)
+               == NM_AUTH_CALL_RESULT_YES);
+
+    for (i = 0; i < data->n_items; i++) {
+        ActivateConnectionsItem *item  = &data->items[i];
+        gs_free_error GError    *error = NULL;
+        const char              *error_desc;
+        const char              *wifi_permission;
+
+        if (!item->active)
+            continue;
+
+        error_desc = NULL;
+        if (!allowed)
+            error_desc = "Not authorized to control networking.";
+        else {
+            wifi_permission = nm_utils_get_shared_wifi_permission(
+                nm_active_connection_get_applied_connection(item->active));
+            if (wifi_permission
+                && nm_auth_chain_get_result(chain, wifi_permission) != NM_AUTH_CALL_RESULT_YES)
+                error_desc = "Not authorized to share connections via wifi.";
+        }
+
+        if (!_activation_auth_done_do(self, item->active, !error_desc, error_desc, &error)) {
+            item->error_message = g_strdup(error->message);
+            g_clear_object(&item->active);
+        }
+    }
+
+    if (!allowed) {
+        g_dbus_method_invocation_return_error_literal(context,
+                                                      NM_MANAGER_ERROR,
+                                                      NM_MANAGER_ERROR_PERMISSION_DENIED,
+                                                      "Not authorized to control networking.");
+        return;
+    }
+
+    _activate_connections_return(context, data);
+}
+
+static void
+impl_manager_activate_connections(NMDBusObject                      *obj,
+                                  const NMDBusInterfaceInfoExtended *interface_info,
+                                  const NMDBusMethodInfoExtended    *method_info,
+                                  GDBusConnection                   *dbus_connection,
+                                  const char                        *sender,
+                                  GDBusMethodInvocation             *invocation,
+                                  GVariant                          *parameters)
+{
+    NMManager                     *self          = NM_MANAGER(obj);
+    NMManagerPrivate              *priv          = NM_MANAGER_GET_PRIVATE(self);
+    gs_unref_variant GVariant     *activations   = NULL;
+    gs_unref_variant GVariant     *options       = NULL;
+    gs_unref_object NMAuthSubject *subject       = NULL;
+    gs_unref_hashtable GHashTable *devices       = NULL;
+    const char                    *wifi_perms[2] = {};
+    guint                          n_wifi_perms  = 0;
+    gsize                          n_valid       = 0;
+    ActivateConnectionsData       *data;
+    NMAuthChain                   *chain;
+    GVariantIter                   iter;
+    const char                    *option_name;
+    gsize                          n_items;
+    gsize                          i;
+    guint                          j;
+
+    g_variant_get(parameters, "(@a(ooo)@a{sv})", &activations, &options);
+
+    g_variant_iter_init(&iter, options);
+    if (g_variant_iter_next(&iter, "{&sv}", &option_name, NULL)) {
+        g_dbus_method_invocation_return_error(invocation,
+                                              NM_MANAGER_ERROR,
+                                              NM_MANAGER_ERROR_INVALID_ARGUMENTS,
+                                              "Unknown option '%s'",
+                                              option_name);
+        return;
+    }
+
+    subject = nm_dbus_manager_new_auth_subject_from_context(invocation);
+    if (!subject) {
+        g_dbus_method_invocation_return_error_literal(invocation,
+                                                      NM_MANAGER_ERROR,
+                                                      NM_MANAGER_ERROR_PERMISSION_DENIED,
+                                                      NM_UTILS_ERROR_MSG_REQ_UID_UKNOWN);
+        return;
+    }
+
+    n_items       = g_variant_n_children(activations);
+    data          = g_malloc0(sizeof(ActivateConnectionsData)
+                              + n_items * sizeof(ActivateConnectionsItem));
+    data->subject = g_steal_pointer(&subject);
+    data->n_items = n_items;
+
+    devices = g_hash_table_new(nm_direct_hash, NULL);
+
+    /* Invalid entries are reported in their result. All others are
+     * authorized together and then activated in order. */
+    for (i = 0; i < n_items; i++) {
+        ActivateConnectionsItem *item      = &data->items[i];
+        gs_free_error GError    *local     = NULL;
+        NMSettingsConnection    *sett_conn = NULL;
+        NMDevice                *device;
+        const char              *connection_path;
+        const char              *device_path;
+        const char              *specific_object_path;
+        const char              *wifi_permission;
+
+        g_variant_get_child(activations,
+                            i,
+                            "(&o&o&o)",
+                            &connection_path,
+                            &device_path,
+                            &specific_object_path);
+
+        item->active = _activation_user_request_new(self,
+                                                    data->subject,
+                                                    nm_dbus_path_not_empty(connection_path),
+                                                    nm_dbus_path_not_empty(device_path),
+                                                    nm_dbus_path_not_empty(specific_object_path),
+                                                    &sett_conn,
+                                                    &local);
+        if (item->active) {
+            /* A later activation on the same device would just replace
+             * the earlier one. */
+            device = nm_active_connection_get_device(item->active);
+            if (device && !g_hash_table_add(devices, device)) {
+                g_clear_object(&item->active);
+                g_set_error(&local,
+                            NM_MANAGER_ERROR,
+                            NM_MANAGER_ERROR_INVALID_ARGUMENTS,
+                            "Device '%s' is already activated by an earlier entry",
+                            nm_device_get_iface(device));
+            }
+        }
+
+        if (!item->active) {
+            item->error_message = g_strdup(local->message);
+            if (sett_conn) {
+                nm_audit_log_connection_op(NM_AUDIT_OP_CONN_ACTIVATE,
+                                           sett_conn,
+                                           FALSE,
+                                           NULL,
+                                           data->subject,
+                                           local->message);
+            }
+            continue;
+        }
+
+        wifi_permission = nm_utils_get_shared_wifi_permission(
+            nm_active_connection_get_applied_connection(item->active));
+        if (wifi_permission) {
+            for (j = 0; j < n_wifi_perms; j++) {
+                if (nm_streq(wifi_perms[j], wifi_permission))
+                    break;
+            }
+            if (j == n_wifi_perms) {
+                nm_assert(n_wifi_perms < G_N_ELEMENTS(wifi_perms));
+                wifi_perms[n_wifi_perms++] = wifi_permission;
+            }
+        }
+
+        n_valid++;
+    }
+
+    if (n_valid == 0) {
+        _activate_connections_return(invocation, data);
+        _activate_connections_data_free(data);
+        return;
+    }
+
+    chain = nm_auth_chain_new_subject(data->subject,
+                                      invocation,
+                                      activate_connections_auth_cb,
+                                      self);
+
+    c_list_link_tail(&priv->auth_lst_head, nm_auth_chain_parent_lst_list(chain));
+    nm_auth_chain_set_data(chain, "data", data, (GDestroyNotify) _activate_connections_data_free);
+    nm_auth_chain_add_call(chain, NM_AUTH_PERMISSION_NETWORK_CONTROL, TRUE);
+    for (j = 0; j < n_wifi_perms; j++)
+        nm_auth_chain_add_call_unsafe(chain, wifi_perms[j], TRUE);
+}
+
+/*****************************************************************************/
+
 static void
 activation_add_done(NMSettings            *settings,
                     NMSettingsConnection  *new_connection,
@@ -7321,6 +7919,75 @@ device_sleep_cb(NMDevice *device, GParamSpec *pspec, NMManager *self)
     }
 }
 
+static gboolean
+_fast_resume_enabled(void)
+{
+    return nm_config_data_get_value_boolean(NM_CONFIG_GET_DATA,
+                                            NM_CONFIG_KEYFILE_GROUP_MAIN,
+                                            NM_CONFIG_KEYFILE_KEY_MAIN_FAST_RESUME,
+                                            FALSE);
+}
+
+static char *
+_fast_resume_id(NMDevice *device)
+{
+    gs_free char *ap_path = NULL;
+
+    /* The Wi-Fi devices live in a plugin, this is NM_DEVICE_WIFI_ACTIVE_ACCESS_POINT.
+     * The AP object stays the same as long as the device is associated to
+     * the same BSSID. */
+    if (g_object_class_find_property(G_OBJECT_GET_CLASS(device), "active-access-point"))
+        g_object_get(device, "active-access-point", &ap_path, NULL);
+
+    return g_strdup_printf("%d/%s", nm_device_get_ifindex(device), ap_path ?: "");
+}
+
+static void
+fast_resume_devices_add(NMManager *self, NMDevice *device)
+{
+    NMManagerPrivate *priv = NM_MANAGER_GET_PRIVATE(self);
+
+    if (!priv->fast_resume_devices) {
+        priv->fast_resume_devices =
+            g_hash_table_new_full(nm_direct_hash, NULL, g_object_unref, g_free);
+    }
+
+    g_hash_table_replace(priv->fast_resume_devices,
+                         g_object_ref(device),
+                         _fast_resume_id(device));
+}
+
+static gboolean
+fast_resume_devices_check(NMManager *self, NMDevice *device)
+{
+    NMManagerPrivate *priv = NM_MANAGER_GET_PRIVATE(self);
+    gs_free char     *resume_id = NULL;
+    const char       *suspend_id;
+
+    if (!priv->fast_resume_devices)
+        return FALSE;
+
+    suspend_id = g_hash_table_lookup(priv->fast_resume_devices, device);
+    if (!suspend_id)
+        return FALSE;
+
+    if (nm_device_get_state(device) != NM_DEVICE_STATE_ACTIVATED) {
+        _LOG2D(LOGD_SUSPEND, device, "sleep: no fast resume, device is no longer activated");
+        return FALSE;
+    }
+    if (!nm_device_has_carrier(device)) {
+        _LOG2D(LOGD_SUSPEND, device, "sleep: no fast resume, device has no carrier");
+        return FALSE;
+    }
+    resume_id = _fast_resume_id(device);
+    if (!nm_streq(suspend_id, resume_id)) {
+        _LOG2D(LOGD_SUSPEND, device, "sleep: no fast resume, link or access point changed");
+        return FALSE;
+    }
+
+    return TRUE;
+}
+
 static void
 _handle_device_takedown(NMManager *self,
                         NMDevice  *device,
@@ -7353,18 +8020,26 @@ _handle_device_takedown(NMManager *self,
 static void
 do_sleep_wake(NMManager *self, gboolean sleeping_changed)
 {
-    NMManagerPrivate *priv = NM_MANAGER_GET_PRIVATE(self);
-    gboolean          suspending, waking_from_suspend;
-    NMDevice         *device;
+    NMManagerPrivate              *priv                = NM_MANAGER_GET_PRIVATE(self);
+    gs_unref_hashtable GHashTable *fast_resume         = NULL;
+    gboolean                       fast_resume_enabled = FALSE;
+    gboolean                       suspending, waking_from_suspend;
+    NMDevice                      *device;
 
     suspending          = sleeping_changed && priv->sleeping;
     waking_from_suspend = sleeping_changed && !priv->sleeping;
 
+    if (!suspending)
+        fast_resume = g_steal_pointer(&priv->fast_resume_devices);
+
     if (manager_is_disabled(self)) {
         _LOGD(suspending ? LOGD_SUSPEND : LOGD_CORE,
               "%s...",
               suspending ? "sleep: sleeping" : "networking: disabling");
 
+        if (suspending)
+            fast_resume_enabled = _fast_resume_enabled();
+
         /* FIXME: are there still hardware devices that need to be disabled around
          * suspend/resume?
          */
@@ -7385,6 +8060,15 @@ do_sleep_wake(NMManager *self, gboolean sleeping_changed)
                       nm_device_get_ip_iface(device));
                 continue;
             }
+            /* With fast resume, keep the configuration of activated devices
+             * and check after resume whether it is still valid. */
+            if (fast_resume_enabled && nm_device_get_state(device) == NM_DEVICE_STATE_ACTIVATED) {
+                _LOGD(LOGD_SUSPEND,
+                      "sleep: device %s is kept for fast resume",
+                      nm_device_get_ip_iface(device));
+                fast_resume_devices_add(self, device);
+                continue;
+            }
 
             _handle_device_takedown(self, device, suspending, FALSE);
         }
@@ -7396,10 +8080,31 @@ do_sleep_wake(NMManager *self, gboolean sleeping_changed)
         sleep_devices_clear(self);
 
         if (waking_from_suspend) {
+            priv->fast_resume_devices = g_steal_pointer(&fast_resume);
+
             c_list_for_each_entry (device, &priv->devices_lst_head, devices_lst) {
                 if (nm_device_is_software(device))
                     continue;
 
+                /* The link is unchanged. Keep the L3 configuration and only
+                 * restart DHCP, which asks for the previous lease. */
+                if (fast_resume_devices_check(self, device)) {
+                    _LOGD(LOGD_SUSPEND,
+                          "sleep: fast resume of device %s",
+                          nm_device_get_ip_iface(device));
+                    nm_device_update_dynamic_ip_setup(device, "wake up");
+                    continue;
+                }
+
+                /* Devices kept for fast resume whose link changed are taken
+                 * down now, like Wake-on-LAN devices. */
+                if (priv->fast_resume_devices
+                    && g_hash_table_contains(priv->fast_resume_devices, device))
+                    nm_device_set_unmanaged_by_flags(device,
+                                                     NM_UNMANAGED_MANAGER_DISABLED,
+                                                     NM_UNMAN_FLAG_OP_SET_UNMANAGED,
+                                                     NM_DEVICE_STATE_REASON_SLEEPING);
+
                 /* Belatedly take down Wake-on-LAN devices; ideally we wouldn't have to do this
                  * but for now it's the only way to make sure we re-check their connectivity.
                  */
@@ -7474,6 +8179,8 @@ do_sleep_wake(NMManager *self, gboolean sleeping_changed)
                                              reason);
         }
 
+        nm_clear_pointer(&priv->fast_resume_devices, g_hash_table_unref);
+
         /* Give the connections a chance to recreate the virtual devices.
          * We've torn them down on sleep. */
         connections_changed(self);
@@ -7839,6 +8546,235 @@ impl_manager_get_logging(NMDBusObject                      *obj,
         g_variant_new("(ss)", nm_logging_level_to_string(), nm_logging_domains_to_string()));
 }
 
+/*****************************************************************************/
+
+static void
+_memory_stats_add(GVariantBuilder *builder, const char *name, guint n, gsize bytes)
+{
+    g_variant_builder_add(builder, "(sut)", name, (guint32) n, (guint64) bytes);
+}
+
+/* Collects the number of live objects and their approximate memory, per
+ * subsystem. The sizes only account for the objects themselves (and for
+ * connections, their serialized settings), not for allocator overhead. */
+static GVariant *
+_memory_stats_collect(NMManager *self)
+{
+    static const NMPObjectType obj_types[] = {
+        NMP_OBJECT_TYPE_LINK,
+        NMP_OBJECT_TYPE_IP4_ADDRESS,
+        NMP_OBJECT_TYPE_IP6_ADDRESS,
+        NMP_OBJECT_TYPE_IP4_ROUTE,
+        NMP_OBJECT_TYPE_IP6_ROUTE,
+        NMP_OBJECT_TYPE_ROUTING_RULE,
+        NMP_OBJECT_TYPE_QDISC,
+        NMP_OBJECT_TYPE_TFILTER,
+        NMP_OBJECT_TYPE_MPTCP_ADDR,
+    };
+    NMManagerPrivate            *priv = NM_MANAGER_GET_PRIVATE(self);
+    NMSettingsConnection *const *sett_conns;
+    GVariantBuilder              builder;
+    char                         name[64];
+    gsize                        bytes;
+    guint                        n_objs;
+    guint                        n_heads;
+    guint                        n_entries;
+    guint                        n;
+    guint                        i;
+
+    g_variant_builder_init(&builder, G_VARIANT_TYPE("a(sut)"));
+
+    for (i = 0; i < G_N_ELEMENTS(obj_types); i++) {
+        n = nm_platform_cache_get_stats(priv->platform, obj_types[i], &bytes);
+        nm_sprintf_buf(name, "platform-cache:%s", NMP_OBJECT_TYPE_NAME(obj_types[i]));
+        _memory_stats_add(&builder, name, n, bytes);
+    }
+
+    /* The index holds the objects of the platform cache and of all NML3ConfigData.
+     * All of them are NMPObjects, so sizeof(NMPObject) is an upper bound. */
+    nm_dedup_multi_index_get_stats(nm_platform_get_multi_idx(priv->platform),
+                                   &n_objs,
+                                   &n_heads,
+                                   &n_entries);
+    _memory_stats_add(&builder, "dedup-multi-index:objects", n_objs, n_objs * sizeof(NMPObject));
+    _memory_stats_add(&builder,
+                      "dedup-multi-index:entries",
+                      n_heads + n_entries,
+                      n_heads * sizeof(NMDedupMultiHeadEntry)
+                          + n_entries * sizeof(NMDedupMultiEntry));
+
+    sett_conns = nm_settings_get_connections(priv->settings, &n);
+    bytes      = 0;
+    for (i = 0; i < n; i++) {
+        gs_unref_variant GVariant *v = NULL;
+
+        v = nm_connection_to_dbus(nm_settings_connection_get_connection(sett_conns[i]),
+                                  NM_CONNECTION_SERIALIZE_ALL);
+        bytes += g_variant_get_size(v);
+    }
+    _memory_stats_add(&builder, "connections", n, bytes);
+
+    n = nm_dbus_manager_get_stats(nm_dbus_object_get_manager(NM_DBUS_OBJECT(self)), &bytes);
+    _memory_stats_add(&builder, "dbus-objects", n, bytes);
+
+    n = nm_l3_config_data_get_stats(&bytes);
+    _memory_stats_add(&builder, "l3-config-data", n, bytes);
+
+    nm_ref_string_get_stats(&n, &bytes);
+    _memory_stats_add(&builder, "ref-strings", n, bytes);
+
+    return g_variant_builder_end(&builder);
+}
+
+static void
+_memory_stats_dump(NMManager *self)
+{
+    gs_unref_variant GVariant *stats = g_variant_ref_sink(_memory_stats_collect(self));
+    GVariantIter               iter;
+    const char                *name;
+    guint32                    n;
+    guint64                    bytes;
+
+    g_variant_iter_init(&iter, stats);
+    while (g_variant_iter_next(&iter, "(&sut)", &name, &n, &bytes)) {
+        _LOGI(LOGD_CORE,
+              "memory: %s: %u objects, %" G_GUINT64_FORMAT " KiB",
+              name,
+              (guint) n,
+              bytes / 1024u);
+    }
+}
+
+static gint64
+_memory_get_rss_kib(void)
+{
+    gs_free char *contents = NULL;
+    unsigned long size;
+    unsigned long resident;
+
+    if (!nm_utils_file_get_contents(-1,
+                                    "/proc/self/statm",
+                                    1024,
+                                    NM_UTILS_FILE_GET_CONTENTS_FLAG_NONE,
+                                    &contents,
+                                    NULL,
+                                    NULL,
+                                    NULL))
+        return -1;
+    if (sscanf(contents, "%lu %lu", &size, &resident) != 2)
+        return -1;
+    return ((gint64) resident) * (sysconf(_SC_PAGESIZE) / 1024);
+}
+
+static gboolean
+_memory_trim_cb(gpointer user_data)
+{
+    NMManager        *self = user_data;
+    NMManagerPrivate *priv = NM_MANAGER_GET_PRIVATE(self);
+    gint64            rss_before;
+    gint64            rss_after;
+    gsize             slab_bytes;
+
+    priv->memory_trim_id = 0;
+
+    rss_before = _memory_get_rss_kib();
+
+    slab_bytes = nmp_object_slab_trim();
+#if HAVE_MALLOC_TRIM
+    malloc_trim(0);
+#endif
+
+    rss_after = _memory_get_rss_kib();
+
+    if (rss_before < 0 || rss_after < 0) {
+        _LOGD(LOGD_CORE,
+              "memory: trimmed heap (%zu KiB of spare platform objects)",
+              slab_bytes / 1024u);
+    } else {
+        _LOGI(LOGD_CORE,
+              "memory: trimmed heap, RSS %" G_GINT64_FORMAT " KiB -> %" G_GINT64_FORMAT
+              " KiB (reclaimed %" G_GINT64_FORMAT " KiB, %zu KiB of spare platform objects)",
+              rss_before,
+              rss_after,
+              MAX(rss_before - rss_after, 0),
+              slab_bytes / 1024u);
+    }
+    return G_SOURCE_REMOVE;
+}
+
+/* After startup and after a full resync of the platform cache, the heap is
+ * at its peak because of transient data like netlink messages, parsed profiles
+ * and GVariants. Once things settled, release the spare memory. */
+static void
+_memory_trim_schedule(NMManager *self, const char *reason)
+{
+    NMManagerPrivate *priv = NM_MANAGER_GET_PRIVATE(self);
+
+    if (priv->memory_trim_id != 0)
+        return;
+
+    _LOGD(LOGD_CORE, "memory: schedule trimming the heap after %s", reason);
+    priv->memory_trim_id = g_timeout_add_seconds(5, _memory_trim_cb, self);
+}
+
+static void
+platform_resync_done_cb(NMPlatform *platform, gpointer user_data)
+{
+    _memory_trim_schedule(user_data, "platform resync");
+}
+
+static void
+impl_manager_get_managed_objects_filtered(NMDBusObject                      *obj,
+                                          const NMDBusInterfaceInfoExtended *interface_info,
+                                          const NMDBusMethodInfoExtended    *method_info,
+                                          GDBusConnection                   *connection,
+                                          const char                        *sender,
+                                          GDBusMethodInvocation             *invocation,
+                                          GVariant                          *parameters)
+{
+    gs_unref_variant GVariant *interfaces = NULL;
+    const char                *path_prefix;
+
+    g_variant_get(parameters, "(&o@a{sas})", &path_prefix, &interfaces);
+
+    g_dbus_method_invocation_return_value(
+        invocation,
+        g_variant_new("(@a{oa{sa{sv}}})",
+                      nm_dbus_manager_get_managed_objects_filtered(nm_dbus_manager_get(),
+                                                                   path_prefix,
+                                                                   interfaces)));
+}
+
+static void
+impl_manager_get_memory_stats(NMDBusObject                      *obj,
+                              const NMDBusInterfaceInfoExtended *interface_info,
+                              const NMDBusMethodInfoExtended    *method_info,
+                              GDBusConnection                   *connection,
+                              const char                        *sender,
+                              GDBusMethodInvocation             *invocation,
+                              GVariant                          *parameters)
+{
+    g_dbus_method_invocation_return_value(
+        invocation,
+        g_variant_new("(@a(sut))", _memory_stats_collect(NM_MANAGER(obj))));
+}
+
+static void
+impl_manager_get_log_rate_limit_stats(NMDBusObject                      *obj,
+                                      const NMDBusInterfaceInfoExtended *interface_info,
+                                      const NMDBusMethodInfoExtended    *method_info,
+                                      GDBusConnection                   *connection,
+                                      const char                        *sender,
+                                      GDBusMethodInvocation             *invocation,
+                                      GVariant                          *parameters)
+{
+    g_dbus_method_invocation_return_value(
+        invocation,
+        g_variant_new("(@a(stt))", nm_logging_get_rate_limit_stats()));
+}
+
+/*****************************************************************************/
+
 typedef struct {
     NMManager             *self;
     GDBusMethodInvocation *context;
@@ -8081,6 +9017,7 @@ gboolean
 nm_manager_start(NMManager *self, GError **error)
 {
     NMManagerPrivate *priv = NM_MANAGER_GET_PRIVATE(self);
+    gint64            start_nsec;
     guint             i;
 
     nm_device_factory_manager_load_factories(_register_device_factory, self);
@@ -8111,8 +9048,13 @@ nm_manager_start(NMManager *self, GError **error)
 
     _static_hostname_changed_cb(priv->hostname_manager, NULL, self);
 
+    start_nsec = nm_utils_get_monotonic_timestamp_nsec();
     if (!nm_settings_start(priv->settings, error))
         return FALSE;
+    nm_startup_trace_span("manager",
+                          "load settings",
+                          start_nsec,
+                          nm_utils_get_monotonic_timestamp_nsec());
 
     nm_platform_process_events(priv->platform);
 
@@ -8120,8 +9062,17 @@ nm_manager_start(NMManager *self, GError **error)
                      NM_PLATFORM_SIGNAL_LINK_CHANGED,
                      G_CALLBACK(platform_link_cb),
                      self);
+    g_signal_connect(priv->platform,
+                     NM_PLATFORM_SIGNAL_RESYNC_DONE,
+                     G_CALLBACK(platform_resync_done_cb),
+                     self);
 
+    start_nsec = nm_utils_get_monotonic_timestamp_nsec();
     platform_query_devices(self);
+    nm_startup_trace_span("manager",
+                          "query devices",
+                          start_nsec,
+                          nm_utils_get_monotonic_timestamp_nsec());
 
     /* Load VPN plugins */
     priv->vpn_manager = g_object_ref(nm_vpn_manager_get());
@@ -8750,6 +9701,98 @@ impl_manager_checkpoint_adjust_rollback_timeout(NMDBusObject
     nm_auth_chain_add_call(chain, NM_AUTH_PERMISSION_CHECKPOINT_ROLLBACK, TRUE);
 }
 
+static void
+impl_manager_get_managed_objects_snapshot(NMDBusObject                      *obj,
+                                          const NMDBusInterfaceInfoExtended *interface_info,
+                                          const NMDBusMethodInfoExtended    *method_info,
+                                          GDBusConnection                   *connection,
+                                          const char                        *sender,
+                                          GDBusMethodInvocation             *invocation,
+                                          GVariant                          *parameters)
+{
+#if HAVE_DECL_MEMFD_CREATE
+    gs_unref_variant GVariant   *objects = NULL;
+    gs_unref_object GUnixFDList *fd_list = NULL;
+    gs_free_error GError        *error   = NULL;
+    nm_auto_close int            fd      = -1;
+    const guint8                *data;
+    gsize                        size;
+    gsize                        n;
+    int                          fd_idx;
+
+    /* This is the same as the ObjectManager's GetManagedObjects(), except that
+     * the reply is passed as a sealed memfd in GVariant serialization format.
+     * The client can mmap() it and avoid copying and unmarshalling a potentially
+     * large message. The reply is queued on the connection just like the one
+     * from GetManagedObjects(), so signals emitted afterwards will be ordered
+     * after the snapshot. */
+
+    objects = g_variant_ref_sink(nm_dbus_manager_get_managed_objects(nm_dbus_manager_get()));
+    data    = g_variant_get_data(objects);
+    size    = g_variant_get_size(objects);
+
+    fd = memfd_create("nm-managed-objects", MFD_CLOEXEC | MFD_ALLOW_SEALING);
+    if (fd < 0) {
+        int errsv = errno;
+
+        g_dbus_method_invocation_return_error(invocation,
+                                              NM_MANAGER_ERROR,
+                                              NM_MANAGER_ERROR_FAILED,
+                                              "failure to create memfd: %s",
+                                              nm_strerror_native(errsv));
+        return;
+    }
+
+    for (n = 0; n < size;) {
+        gssize r;
+
+        r = write(fd, &data[n], size - n);
+        if (r < 0) {
+            int errsv = errno;
+
+            if (errsv == EINTR)
+                continue;
+            g_dbus_method_invocation_return_error(invocation,
+                                                  NM_MANAGER_ERROR,
+                                                  NM_MANAGER_ERROR_FAILED,
+                                                  "failure to write memfd: %s",
+                                                  nm_strerror_native(errsv));
+            return;
+        }
+        n += r;
+    }
+
+    if (fcntl(fd, F_ADD_SEALS, F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_WRITE | F_SEAL_SEAL) < 0) {
+        int errsv = errno;
+
+        g_dbus_method_invocation_return_error(invocation,
+                                              NM_MANAGER_ERROR,
+                                              NM_MANAGER_ERROR_FAILED,
+                                              "failure to seal memfd: %s",
+                                              nm_strerror_native(errsv));
+        return;
+    }
+
+    fd_list = g_unix_fd_list_new();
+    fd_idx  = g_unix_fd_list_append(fd_list, fd, &error);
+    if (fd_idx < 0) {
+        g_dbus_method_invocation_return_gerror(invocation, error);
+        return;
+    }
+
+    g_dbus_method_invocation_return_value_with_unix_fd_list(invocation,
+                                                            g_variant_new("(ht)",
+                                                                          fd_idx,
+                                                                          (guint64) size),
+                                                            fd_list);
+#else
+    g_dbus_method_invocation_return_error_literal(invocation,
+                                                  NM_MANAGER_ERROR,
+                                                  NM_MANAGER_ERROR_FAILED,
+                                                  "memfd is not supported");
+#endif
+}
+
 /*****************************************************************************/
 
 NMDnsManager *
@@ -8829,6 +9872,9 @@ nm_manager_set_capability(NMManager *self, NMCapability cap)
 void
 nm_manager_emit_device_ifindex_changed(NMManager *self, NMDevice *device)
 {
+    if (!c_list_is_empty(&device->devices_lst))
+        _devices_idx_update(self, device, FALSE);
+
     g_signal_emit(self, signals[DEVICE_IFINDEX_CHANGED], 0, device);
 }
 
@@ -9012,6 +10058,9 @@ nm_manager_init(NMManager *self)
     c_list_init(&priv->auth_lst_head);
     c_list_init(&priv->link_cb_lst);
     c_list_init(&priv->devices_lst_head);
+    priv->devices_by_ifindex = g_hash_table_new(nm_direct_hash, NULL);
+    priv->devices_by_iface =
+        g_hash_table_new_full(nm_str_hash, g_str_equal, g_free, (GDestroyNotify) g_ptr_array_unref);
     c_list_init(&priv->active_connections_lst_head);
     c_list_init(&priv->async_op_lst_head);
     c_list_init(&priv->delete_volatile_connection_lst_head);
@@ -9260,6 +10309,10 @@ dispose(GObject *object)
     nm_assert(c_list_is_empty(&priv->async_op_lst_head));
 
     g_signal_handlers_disconnect_by_func(priv->platform, G_CALLBACK(platform_link_cb), self);
+    g_signal_handlers_disconnect_by_func(priv->platform,
+                                         G_CALLBACK(platform_resync_done_cb),
+                                         self);
+    nm_clear_g_source(&priv->memory_trim_id);
     while ((iter = c_list_first(&priv->link_cb_lst))) {
         PlatformLinkCbData *data = c_list_entry(iter, PlatformLinkCbData, lst);
 
@@ -9291,6 +10344,8 @@ dispose(GObject *object)
     }
 
     nm_assert(c_list_is_empty(&priv->devices_lst_head));
+    nm_clear_pointer(&priv->devices_by_ifindex, g_hash_table_destroy);
+    nm_clear_pointer(&priv->devices_by_iface, g_hash_table_destroy);
 
     nm_clear_g_source(&priv->ac_cleanup_id);
 
@@ -9340,6 +10395,8 @@ dispose(GObject *object)
         nm_clear_pointer(&priv->sleep_devices, g_hash_table_unref);
     }
 
+    nm_clear_pointer(&priv->fast_resume_devices, g_hash_table_unref);
+
     if (priv->power_monitor) {
         g_signal_handlers_disconnect_by_func(priv->power_monitor, sleeping_cb, self);
         g_clear_object(&priv->power_monitor);
@@ -9442,6 +10499,15 @@ static const NMDBusInterfaceInfoExtended interface_info_manager = {
                     .out_args = NM_DEFINE_GDBUS_ARG_INFOS(
                         NM_DEFINE_GDBUS_ARG_INFO("active_connection", "o"), ), ),
                 .handle = impl_manager_activate_connection, ),
+            NM_DEFINE_DBUS_METHOD_INFO_EXTENDED(
+                NM_DEFINE_GDBUS_METHOD_INFO_INIT(
+                    "ActivateConnections",
+                    .in_args = NM_DEFINE_GDBUS_ARG_INFOS(
+                        NM_DEFINE_GDBUS_ARG_INFO("activations", "a(ooo)"),
+                        NM_DEFINE_GDBUS_ARG_INFO("options", "a{sv}"), ),
+                    .out_args = NM_DEFINE_GDBUS_ARG_INFOS(
+                        NM_DEFINE_GDBUS_ARG_INFO("results", "aa{sv}"), ), ),
+                .handle = impl_manager_activate_connections, ),
             NM_DEFINE_DBUS_METHOD_INFO_EXTENDED(
                 NM_DEFINE_GDBUS_METHOD_INFO_INIT(
                     "AddAndActivateConnection",
@@ -9541,7 +10607,36 @@ static const NMDBusInterfaceInfoExtended interface_info_manager = {
                     .in_args = NM_DEFINE_GDBUS_ARG_INFOS(
                         NM_DEFINE_GDBUS_ARG_INFO("checkpoint", "o"),
                         NM_DEFINE_GDBUS_ARG_INFO("add_timeout", "u"), ), ),
-                .handle = impl_manager_checkpoint_adjust_rollback_timeout, ), ),
+                .handle = impl_manager_checkpoint_adjust_rollback_timeout, ),
+            NM_DEFINE_DBUS_METHOD_INFO_EXTENDED(
+                NM_DEFINE_GDBUS_METHOD_INFO_INIT(
+                    "GetManagedObjectsSnapshot",
+                    .out_args =
+                        NM_DEFINE_GDBUS_ARG_INFOS(NM_DEFINE_GDBUS_ARG_INFO("snapshot", "h"),
+                                                  NM_DEFINE_GDBUS_ARG_INFO("size", "t"), ), ),
+                .handle = impl_manager_get_managed_objects_snapshot, ),
+            NM_DEFINE_DBUS_METHOD_INFO_EXTENDED(
+                NM_DEFINE_GDBUS_METHOD_INFO_INIT(
+                    "GetManagedObjectsFiltered",
+                    .in_args = NM_DEFINE_GDBUS_ARG_INFOS(
+                        NM_DEFINE_GDBUS_ARG_INFO("path_prefix", "o"),
+                        NM_DEFINE_GDBUS_ARG_INFO("interfaces", "a{sas}"), ),
+                    .out_args = NM_DEFINE_GDBUS_ARG_INFOS(
+                        NM_DEFINE_GDBUS_ARG_INFO("object_paths_interfaces_and_properties",
+                                                 "a{oa{sa{sv}}}"), ), ),
+                .handle = impl_manager_get_managed_objects_filtered, ),
+            NM_DEFINE_DBUS_METHOD_INFO_EXTENDED(
+                NM_DEFINE_GDBUS_METHOD_INFO_INIT(
+                    "GetMemoryStats",
+                    .out_args =
+                        NM_DEFINE_GDBUS_ARG_INFOS(NM_DEFINE_GDBUS_ARG_INFO("stats", "a(sut)"), ), ),
+                .handle = impl_manager_get_memory_stats, ),
+            NM_DEFINE_DBUS_METHOD_INFO_EXTENDED(
+                NM_DEFINE_GDBUS_METHOD_INFO_INIT(
+                    "GetLogRateLimitStats",
+                    .out_args =
+                        NM_DEFINE_GDBUS_ARG_INFOS(NM_DEFINE_GDBUS_ARG_INFO("stats", "a(stt)"), ), ),
+                .handle = impl_manager_get_log_rate_limit_stats, ), ),
         .signals    = NM_DEFINE_GDBUS_SIGNAL_INFOS(&signal_info_check_permissions,
                                                 &signal_info_state_changed,
                                                 &signal_info_device_added,
@@ -125,6 +125,10 @@ NMSettingsConnection **nm_manager_get_activatable_connections(NMManager *manager
                                                               gboolean   sort,
                                                               guint     *out_len);
 
+NMSettingsConnection **nm_manager_get_activatable_connections_for_device(NMManager *manager,
+                                                                         NMDevice  *device,
+                                                                         guint     *out_len);
+
 void nm_manager_deactivate_ac(NMManager *self, NMSettingsConnection *connection);
 
 void nm_manager_device_recheck_auto_activate_schedule(NMManager *self, NMDevice *device);
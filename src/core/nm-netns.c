@@ -11,6 +11,7 @@
 
 #include "libnm-glib-aux/nm-dedup-multi.h"
 #include "libnm-glib-aux/nm-c-list.h"
+#include "libnm-glib-aux/nm-lpm-trie.h"
 
 #include "NetworkManagerUtils.h"
 #include "libnm-core-intern/nm-core-internal.h"
@@ -83,8 +84,23 @@ typedef struct {
      * by IP address. */
     GHashTable *watcher_ip_data_idx;
 
+    /* Per address family, a NMLpmTrie for each routing table, that was
+     * looked up with nm_netns_ip_route_lookup(). The values are the number
+     * of routes in the platform cache with that destination. */
+    GHashTable *route_lpm_idx_x[2];
+
     CList    l3cfg_signal_pending_lst_head;
     GSource *signal_pending_idle_source;
+
+    /* NML3Cfg instances that scheduled a commit on idle. They are all committed
+     * together from one idle handler. */
+    CList    l3cfg_commit_pending_lst_head;
+    GSource *commit_pending_idle_source;
+
+    /* While committing the queued NML3Cfg instances, the sync of the nodev routes
+     * in the global tracker is deferred until all of them are done. */
+    bool commit_pending_running;
+    bool commit_pending_nodev_routes_sync_x[2];
 } NMNetnsPrivate;
 
 struct _NMNetns {
@@ -386,6 +402,7 @@ _l3cfg_hashed_free(gpointer ptr)
     NML3Cfg *l3cfg = _l3cfg_hashed_to_l3cfg(ptr);
 
     c_list_unlink(&l3cfg->internal_netns.signal_pending_lst);
+    c_list_unlink(&l3cfg->internal_netns.commit_pending_lst);
 }
 
 static void
@@ -478,12 +495,274 @@ _platform_signal_on_idle_cb(gpointer user_data)
         c_list_unlink(&l3cfg->internal_netns.signal_pending_lst);
         _nm_l3cfg_notify_platform_change_on_idle(
             l3cfg,
-            nm_steal_int(&l3cfg->internal_netns.signal_pending_obj_type_flags));
+            nm_steal_int(&l3cfg->internal_netns.signal_pending_obj_type_flags),
+            nm_steal_int(&l3cfg->internal_netns.signal_pending_ip6_temporary_addrs));
     }
 
     return G_SOURCE_CONTINUE;
 }
 
+static gboolean
+_l3cfg_commit_on_idle_cb(gpointer user_data)
+{
+    gs_unref_object NMNetns *self = g_object_ref(NM_NETNS(user_data));
+    NMNetnsPrivate          *priv = NM_NETNS_GET_PRIVATE(self);
+    NML3Cfg                 *l3cfg;
+    CList                    work_list;
+    int                      IS_IPv4;
+
+    nm_clear_g_source_inst(&priv->commit_pending_idle_source);
+
+    /* Commit all NML3Cfg instances that are queued right now. Commits that get
+     * scheduled while we process the list are handled by a future idle handler. */
+    c_list_init(&work_list);
+    c_list_splice(&work_list, &priv->l3cfg_commit_pending_lst_head);
+
+    nm_assert(!priv->commit_pending_running);
+    priv->commit_pending_running = TRUE;
+
+    while ((l3cfg = c_list_first_entry(&work_list, NML3Cfg, internal_netns.commit_pending_lst))) {
+        nm_assert(NM_IS_L3CFG(l3cfg));
+        c_list_unlink(&l3cfg->internal_netns.commit_pending_lst);
+        _nm_l3cfg_commit_on_idle(l3cfg);
+    }
+
+    priv->commit_pending_running = FALSE;
+
+    /* Every NML3Cfg tracks its nodev routes in the global tracker and used to sync
+     * them right away. Syncing is expensive as it considers the routes of all
+     * interfaces, so do it only once for the entire batch. */
+    for (IS_IPv4 = 1; IS_IPv4 >= 0; IS_IPv4--) {
+        if (nm_steal_int(&priv->commit_pending_nodev_routes_sync_x[IS_IPv4])) {
+            nmp_global_tracker_sync(priv->global_tracker,
+                                    NMP_OBJECT_TYPE_IP_ROUTE(IS_IPv4),
+                                    FALSE);
+        }
+    }
+
+    return G_SOURCE_CONTINUE;
+}
+
+void
+_nm_netns_l3cfg_commit_on_idle_schedule(NMNetns *self, NML3Cfg *l3cfg)
+{
+    NMNetnsPrivate *priv = NM_NETNS_GET_PRIVATE(self);
+
+    nm_assert(NM_IS_L3CFG(l3cfg));
+    nm_assert(l3cfg->priv.netns == self);
+
+    if (!c_list_is_empty(&l3cfg->internal_netns.commit_pending_lst))
+        return;
+
+    c_list_link_tail(&priv->l3cfg_commit_pending_lst_head,
+                     &l3cfg->internal_netns.commit_pending_lst);
+    if (!priv->commit_pending_idle_source)
+        priv->commit_pending_idle_source = nm_g_idle_add_source(_l3cfg_commit_on_idle_cb, self);
+}
+
+/**
+ * _nm_netns_l3cfg_commit_defer_nodev_routes_sync:
+ * @self: the #NMNetns
+ * @addr_family: the address family of the nodev routes
+ *
+ * Returns: %TRUE if we are currently committing the queued #NML3Cfg
+ *   instances. In that case the sync of the nodev routes in the global
+ *   tracker is postponed until all of them are committed, and the caller
+ *   must not sync them itself.
+ */
+gboolean
+_nm_netns_l3cfg_commit_defer_nodev_routes_sync(NMNetns *self, int addr_family)
+{
+    NMNetnsPrivate *priv = NM_NETNS_GET_PRIVATE(self);
+
+    if (!priv->commit_pending_running)
+        return FALSE;
+
+    priv->commit_pending_nodev_routes_sync_x[NM_IS_IPv4(addr_family)] = TRUE;
+    return TRUE;
+}
+
+static void
+_route_lpm_update(NMLpmTrie *trie, const NMPlatformIPRoute *rt, gboolean add)
+{
+    gpointer value;
+    guint    n;
+
+    nm_lpm_trie_lookup_exact(trie, rt->network_ptr, rt->plen, &value);
+    n = GPOINTER_TO_UINT(value);
+
+    if (add)
+        n++;
+    else if (n == 0)
+        return;
+    else
+        n--;
+
+    if (n == 0)
+        nm_lpm_trie_remove(trie, rt->network_ptr, rt->plen);
+    else
+        nm_lpm_trie_insert(trie, rt->network_ptr, rt->plen, GUINT_TO_POINTER(n));
+}
+
+static void
+_route_lpm_handle_platform_change(NMNetns                   *self,
+                                  const NMPlatformIPRoute   *rt,
+                                  NMPObjectType              obj_type,
+                                  NMPlatformSignalChangeType change_type)
+{
+    NMNetnsPrivate *priv    = NM_NETNS_GET_PRIVATE(self);
+    const int       IS_IPv4 = (obj_type == NMP_OBJECT_TYPE_IP4_ROUTE);
+    NMLpmTrie      *trie;
+
+    if (change_type == NM_PLATFORM_SIGNAL_CHANGED) {
+        /* The destination is part of the ID, and did not change. */
+        return;
+    }
+
+    if (!priv->route_lpm_idx_x[IS_IPv4] || rt->ifindex < 0)
+        return;
+
+    trie = g_hash_table_lookup(
+        priv->route_lpm_idx_x[IS_IPv4],
+        GUINT_TO_POINTER(nm_platform_ip_route_get_effective_table(rt)));
+    if (!trie)
+        return;
+
+    _route_lpm_update(trie, rt, change_type == NM_PLATFORM_SIGNAL_ADDED);
+}
+
+static NMLpmTrie *
+_route_lpm_get(NMNetns *self, int addr_family, guint32 table)
+{
+    NMNetnsPrivate  *priv    = NM_NETNS_GET_PRIVATE(self);
+    const int        IS_IPv4 = NM_IS_IPv4(addr_family);
+    NMLpmTrie       *trie;
+    NMDedupMultiIter iter;
+    const NMPObject *obj;
+
+    if (!priv->route_lpm_idx_x[IS_IPv4]) {
+        priv->route_lpm_idx_x[IS_IPv4] =
+            g_hash_table_new_full(nm_direct_hash,
+                                  NULL,
+                                  NULL,
+                                  (GDestroyNotify) nm_lpm_trie_free);
+    }
+
+    trie = g_hash_table_lookup(priv->route_lpm_idx_x[IS_IPv4], GUINT_TO_POINTER(table));
+    if (trie)
+        return trie;
+
+    /* Build the trie from the platform cache once. Afterwards, it gets
+     * updated from the platform signals. */
+    trie = nm_lpm_trie_new(IS_IPv4 ? 32 : 128, NULL);
+    nmp_cache_iter_for_each (&iter,
+                             nm_platform_lookup_route_by_table(priv->platform,
+                                                               NMP_OBJECT_TYPE_IP_ROUTE(IS_IPv4),
+                                                               table),
+                             &obj)
+        _route_lpm_update(trie, NMP_OBJECT_CAST_IP_ROUTE(obj), TRUE);
+
+    g_hash_table_insert(priv->route_lpm_idx_x[IS_IPv4], GUINT_TO_POINTER(table), trie);
+    return trie;
+}
+
+typedef struct {
+    NMPlatform      *platform;
+    const NMPObject *result;
+    guint32          table;
+    int              addr_family;
+    int              ifindex;
+} RouteLpmLookupData;
+
+static gboolean
+_route_lpm_match_cb(gconstpointer key, guint plen, gpointer value, gpointer user_data)
+{
+    RouteLpmLookupData          *data = user_data;
+    const NMDedupMultiHeadEntry *head_entry;
+    NMDedupMultiIter             iter;
+    const NMPObject             *obj;
+    NMIPAddr                     network;
+
+    nm_ip_addr_set(data->addr_family, &network, key);
+
+    if (NM_IS_IPv4(data->addr_family)) {
+        head_entry = nm_platform_lookup_ip4_route_by_destination(data->platform,
+                                                                 data->table,
+                                                                 network.addr4,
+                                                                 plen);
+    } else {
+        head_entry = nm_platform_lookup_ip6_route_by_destination(data->platform,
+                                                                 data->table,
+                                                                 &network.addr6,
+                                                                 plen);
+    }
+
+    nmp_cache_iter_for_each (&iter, head_entry, &obj) {
+        const NMPlatformIPRoute *rt = NMP_OBJECT_CAST_IP_ROUTE(obj);
+
+        if (data->ifindex > 0 && rt->ifindex != data->ifindex)
+            continue;
+        if (data->result && NMP_OBJECT_CAST_IP_ROUTE(data->result)->metric <= rt->metric)
+            continue;
+        data->result = obj;
+    }
+
+    return !!data->result;
+}
+
+/**
+ * nm_netns_ip_route_lookup:
+ * @self: the #NMNetns
+ * @addr_family: the address family of @addr
+ * @table: the routing table
+ * @addr: the destination address
+ * @ifindex: if positive, only consider routes via this interface
+ *
+ * Finds the route in the platform cache, that routes @addr in @table. That
+ * is the route with the longest prefix that contains @addr, and the lowest
+ * metric among those. Unlike nm_platform_ip_route_get(), this does not ask
+ * kernel and does not consider routing rules.
+ *
+ * The first lookup in a table indexes the routes of that table. Afterwards,
+ * the index is updated from the platform signals, and lookups take
+ * O(prefix length).
+ *
+ * Returns: the route or %NULL.
+ */
+const NMPObject *
+nm_netns_ip_route_lookup(NMNetns      *self,
+                         int           addr_family,
+                         guint32       table,
+                         gconstpointer addr,
+                         int           ifindex)
+{
+    NMNetnsPrivate     *priv;
+    RouteLpmLookupData  data;
+
+    g_return_val_if_fail(NM_IS_NETNS(self), NULL);
+    g_return_val_if_fail(addr, NULL);
+    nm_assert_addr_family(addr_family);
+
+    priv = NM_NETNS_GET_PRIVATE(self);
+
+    data = (RouteLpmLookupData) {
+        .platform    = priv->platform,
+        .table       = table,
+        .addr_family = addr_family,
+        .ifindex     = ifindex,
+    };
+
+    nm_lpm_trie_lookup_full(_route_lpm_get(self, addr_family, table),
+                            addr,
+                            _route_lpm_match_cb,
+                            &data,
+                            NULL,
+                            NULL);
+    return data.result;
+}
+
+/*****************************************************************************/
+
 static void
 _platform_signal_cb(NMPlatform   *platform,
                     int           obj_type_i,
@@ -498,6 +777,9 @@ _platform_signal_cb(NMPlatform   *platform,
     const NMPlatformSignalChangeType change_type = change_type_i;
     NML3Cfg                         *l3cfg;
 
+    if (NM_IN_SET(obj_type, NMP_OBJECT_TYPE_IP4_ROUTE, NMP_OBJECT_TYPE_IP6_ROUTE))
+        _route_lpm_handle_platform_change(self, platform_object, obj_type, change_type);
+
     if (ifindex <= 0) {
         /* platform signal callback could be triggered by nodev routes, skip them */
         return;
@@ -507,7 +789,13 @@ _platform_signal_cb(NMPlatform   *platform,
     if (!l3cfg)
         goto notify_watcher;
 
-    l3cfg->internal_netns.signal_pending_obj_type_flags |= nmp_object_type_to_flags(obj_type);
+    if (nmp_object_ip6_address_is_kernel_temporary(NMP_OBJECT_UP_CAST(platform_object))) {
+        /* With IPv6 privacy extensions, kernel regularly adds and removes temporary
+         * addresses. Don't report them as IP6_ADDRESS change, so that the users don't
+         * react on them. */
+        l3cfg->internal_netns.signal_pending_ip6_temporary_addrs = TRUE;
+    } else
+        l3cfg->internal_netns.signal_pending_obj_type_flags |= nmp_object_type_to_flags(obj_type);
 
     if (c_list_is_empty(&l3cfg->internal_netns.signal_pending_lst)) {
         c_list_link_tail(&priv->l3cfg_signal_pending_lst_head,
@@ -1511,6 +1799,7 @@ nm_netns_init(NMNetns *self)
     priv->_self_signal_user_data = self;
 
     c_list_init(&priv->l3cfg_signal_pending_lst_head);
+    c_list_init(&priv->l3cfg_commit_pending_lst_head);
 
     G_STATIC_ASSERT_EXPR(G_STRUCT_OFFSET(EcmpTrackObj, obj) == 0);
     priv->ecmp_track_by_obj =
@@ -1604,6 +1893,7 @@ dispose(GObject *object)
 
     nm_assert(nm_g_hash_table_size(priv->l3cfgs) == 0);
     nm_assert(c_list_is_empty(&priv->l3cfg_signal_pending_lst_head));
+    nm_assert(c_list_is_empty(&priv->l3cfg_commit_pending_lst_head));
     nm_assert(nm_g_hash_table_size(priv->watcher_idx) == 0);
     nm_assert(nm_g_hash_table_size(priv->watcher_by_tag_idx) == 0);
     nm_assert(nm_g_hash_table_size(priv->watcher_ip_data_idx) == 0);
@@ -1619,7 +1909,11 @@ dispose(GObject *object)
     nm_clear_pointer(&priv->watcher_by_tag_idx, g_hash_table_destroy);
     nm_clear_pointer(&priv->watcher_ip_data_idx, g_hash_table_destroy);
 
+    nm_clear_pointer(&priv->route_lpm_idx_x[0], g_hash_table_destroy);
+    nm_clear_pointer(&priv->route_lpm_idx_x[1], g_hash_table_destroy);
+
     nm_clear_g_source_inst(&priv->signal_pending_idle_source);
+    nm_clear_g_source_inst(&priv->commit_pending_idle_source);
 
     if (priv->platform)
         g_signal_handlers_disconnect_by_data(priv->platform, &priv->_self_signal_user_data);
@@ -39,6 +39,10 @@ NML3Cfg *nm_netns_l3cfg_get(NMNetns *self, int ifindex);
 
 NML3Cfg *nm_netns_l3cfg_acquire(NMNetns *netns, int ifindex);
 
+void _nm_netns_l3cfg_commit_on_idle_schedule(NMNetns *self, NML3Cfg *l3cfg);
+
+gboolean _nm_netns_l3cfg_commit_defer_nodev_routes_sync(NMNetns *self, int addr_family);
+
 /*****************************************************************************/
 
 typedef enum {
@@ -68,6 +72,14 @@ void nm_netns_ip_route_ecmp_commit(NMNetns    *self,
 
 /*****************************************************************************/
 
+const NMPObject *nm_netns_ip_route_lookup(NMNetns      *self,
+                                          int           addr_family,
+                                          guint32       table,
+                                          gconstpointer addr,
+                                          int           ifindex);
+
+/*****************************************************************************/
+
 typedef enum {
     NM_NETNS_WATCHER_TYPE_IP_ADDR,
 } NMNetnsWatcherType;
@@ -0,0 +1,349 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+/*
+ * Copyright (C) 2026 Red Hat, Inc.
+ */
+
+#include "src/core/nm-default-daemon.h"
+
+#include "nm-perf.h"
+
+#include "libnm-systemd-core/nm-sd.h"
+
+/*****************************************************************************/
+
+#define _NMLOG_DOMAIN      LOGD_CORE
+#define _NMLOG(level, ...) __NMLOG_DEFAULT(level, _NMLOG_DOMAIN, "perf", __VA_ARGS__)
+
+/*****************************************************************************/
+
+static NMPerfHistogram _histograms[_NM_PERF_PROBE_NUM];
+
+NM_UTILS_LOOKUP_STR_DEFINE(_probe_to_string,
+                           NMPerfProbe,
+                           NM_UTILS_LOOKUP_DEFAULT_NM_ASSERT(NULL),
+                           NM_UTILS_LOOKUP_STR_ITEM(NM_PERF_PROBE_PLATFORM_IP_ROUTE_SYNC,
+                                                    "platform-ip-route-sync"),
+                           NM_UTILS_LOOKUP_STR_ITEM(NM_PERF_PROBE_L3CFG_COMMIT, "l3cfg-commit"),
+                           NM_UTILS_LOOKUP_STR_ITEM(NM_PERF_PROBE_SETTINGS_RELOAD,
+                                                    "settings-reload"),
+                           NM_UTILS_LOOKUP_STR_ITEM(NM_PERF_PROBE_DNS_UPDATE, "dns-update"),
+                           NM_UTILS_LOOKUP_STR_ITEM(NM_PERF_PROBE_DBUS_OBJ_NOTIFY,
+                                                    "dbus-obj-notify"),
+                           NM_UTILS_LOOKUP_ITEM_IGNORE(_NM_PERF_PROBE_NUM), );
+
+static NMPerfQueueStats _queues[_NM_PERF_QUEUE_NUM];
+
+NM_UTILS_LOOKUP_STR_DEFINE(_queue_to_string,
+                           NMPerfQueue,
+                           NM_UTILS_LOOKUP_DEFAULT_NM_ASSERT(NULL),
+                           NM_UTILS_LOOKUP_STR_ITEM(NM_PERF_QUEUE_ACTIVATION_STAGE1,
+                                                    "activation-stage1"),
+                           NM_UTILS_LOOKUP_STR_ITEM(NM_PERF_QUEUE_ACTIVATION_STAGE2,
+                                                    "activation-stage2"),
+                           NM_UTILS_LOOKUP_STR_ITEM(NM_PERF_QUEUE_ACTIVATION_STAGE3,
+                                                    "activation-stage3"),
+                           NM_UTILS_LOOKUP_ITEM_IGNORE(_NM_PERF_QUEUE_NUM), );
+
+/*****************************************************************************/
+
+guint
+nm_perf_histogram_bucket_index(gint64 duration_nsec)
+{
+    guint64 usec;
+    guint   exp;
+    guint   idx;
+
+    if (duration_nsec <= 0)
+        return 0;
+
+    usec = ((guint64) duration_nsec) / 1000u;
+    if (usec < NM_PERF_HISTOGRAM_SUB_BUCKETS)
+        return usec;
+
+    /* usec >= 4, hence exp >= 2. */
+    exp = 63 - __builtin_clzll(usec);
+    idx = NM_PERF_HISTOGRAM_SUB_BUCKETS + (exp - 2u) * NM_PERF_HISTOGRAM_SUB_BUCKETS
+          + ((usec >> (exp - 2u)) & (NM_PERF_HISTOGRAM_SUB_BUCKETS - 1u));
+
+    return NM_MIN(idx, (guint) (NM_PERF_HISTOGRAM_N_BUCKETS - 1));
+}
+
+/**
+ * nm_perf_histogram_bucket_upper_nsec:
+ * @idx: the bucket index
+ *
+ * Returns: the exclusive upper bound in nanoseconds of the durations
+ *   that are accounted in bucket @idx.
+ */
+gint64
+nm_perf_histogram_bucket_upper_nsec(guint idx)
+{
+    guint exp;
+    guint sub;
+
+    nm_assert(idx < NM_PERF_HISTOGRAM_N_BUCKETS);
+
+    if (idx < NM_PERF_HISTOGRAM_SUB_BUCKETS)
+        return ((gint64) idx + 1) * 1000;
+
+    exp = (idx - NM_PERF_HISTOGRAM_SUB_BUCKETS) / NM_PERF_HISTOGRAM_SUB_BUCKETS + 2u;
+    sub = (idx - NM_PERF_HISTOGRAM_SUB_BUCKETS) % NM_PERF_HISTOGRAM_SUB_BUCKETS;
+
+    return ((gint64) (NM_PERF_HISTOGRAM_SUB_BUCKETS + sub + 1u) << (exp - 2u)) * 1000;
+}
+
+void
+nm_perf_histogram_add(NMPerfHistogram *histogram, gint64 duration_nsec)
+{
+    guint64 d = NM_MAX(duration_nsec, 0);
+
+    histogram->count++;
+    histogram->sum_nsec += d;
+    histogram->max_nsec = NM_MAX(histogram->max_nsec, d);
+    histogram->buckets[nm_perf_histogram_bucket_index(d)]++;
+}
+
+/**
+ * nm_perf_histogram_get_percentile:
+ * @histogram: the histogram
+ * @percent: the percentile, between 0 and 100.
+ *
+ * Returns: an upper bound in nanoseconds for the duration, below which
+ *   @percent of the recorded samples are. This is the upper bound of
+ *   the corresponding bucket, but never more than the maximum recorded
+ *   duration. Returns zero, if the histogram is empty.
+ */
+gint64
+nm_perf_histogram_get_percentile(const NMPerfHistogram *histogram, guint percent)
+{
+    guint64 threshold;
+    guint64 n = 0;
+    guint   i;
+
+    nm_assert(percent <= 100);
+
+    if (histogram->count == 0)
+        return 0;
+
+    threshold = NM_MAX((histogram->count * percent + 99u) / 100u, (guint64) 1u);
+
+    for (i = 0; i < NM_PERF_HISTOGRAM_N_BUCKETS - 1u; i++) {
+        n += histogram->buckets[i];
+        if (n >= threshold)
+            break;
+    }
+
+    return NM_MIN(nm_perf_histogram_bucket_upper_nsec(i), (gint64) histogram->max_nsec);
+}
+
+/*****************************************************************************/
+
+/**
+ * nm_perf_record:
+ * @probe: the probe to account the duration to.
+ * @start_nsec: the start time, as returned by nm_perf_start().
+ *
+ * Records the time elapsed since @start_nsec in the histogram of
+ * @probe. This is cheap and meant to be always enabled.
+ */
+void
+nm_perf_record(NMPerfProbe probe, gint64 start_nsec)
+{
+    nm_assert(probe < _NM_PERF_PROBE_NUM);
+
+    nm_perf_histogram_add(&_histograms[probe],
+                          nm_utils_get_monotonic_timestamp_nsec() - start_nsec);
+}
+
+const NMPerfHistogram *
+nm_perf_get_histogram(NMPerfProbe probe)
+{
+    g_return_val_if_fail(probe < _NM_PERF_PROBE_NUM, NULL);
+
+    return &_histograms[probe];
+}
+
+/*****************************************************************************/
+
+void
+nm_perf_queue_enqueue(NMPerfQueue queue)
+{
+    NMPerfQueueStats *q;
+
+    g_return_if_fail(queue < _NM_PERF_QUEUE_NUM);
+
+    q = &_queues[queue];
+    q->n_enqueued++;
+    q->len++;
+    q->len_max = NM_MAX(q->len_max, q->len);
+}
+
+/**
+ * nm_perf_queue_dequeue:
+ * @queue: the queue
+ * @enqueued_nsec: the timestamp from nm_perf_start() when the item was
+ *   enqueued.
+ * @dispatched: whether the item was dispatched or only dropped from the
+ *   queue. Only dispatched items account for the wait time.
+ */
+void
+nm_perf_queue_dequeue(NMPerfQueue queue, gint64 enqueued_nsec, gboolean dispatched)
+{
+    NMPerfQueueStats *q;
+
+    g_return_if_fail(queue < _NM_PERF_QUEUE_NUM);
+
+    q = &_queues[queue];
+    nm_assert(q->len > 0);
+    q->len--;
+    if (dispatched) {
+        q->n_dispatched++;
+        nm_perf_histogram_add(&q->wait, nm_utils_get_monotonic_timestamp_nsec() - enqueued_nsec);
+    }
+}
+
+void
+nm_perf_queue_batch(NMPerfQueue queue)
+{
+    g_return_if_fail(queue < _NM_PERF_QUEUE_NUM);
+
+    _queues[queue].n_batches++;
+}
+
+const NMPerfQueueStats *
+nm_perf_get_queue_stats(NMPerfQueue queue)
+{
+    g_return_val_if_fail(queue < _NM_PERF_QUEUE_NUM, NULL);
+
+    return &_queues[queue];
+}
+
+/*****************************************************************************/
+
+static GPollFunc _poll_func_orig;
+static guint64   _n_main_loop_wakeups;
+
+static int
+_poll_func(GPollFD *ufds, guint nfds, int timeout)
+{
+    int r;
+
+    r = _poll_func_orig(ufds, nfds, timeout);
+
+    /* A poll() that didn't return immediately means the process was asleep
+     * and got woken up. */
+    if (timeout != 0)
+        _n_main_loop_wakeups++;
+    return r;
+}
+
+/**
+ * nm_perf_wakeups_install:
+ *
+ * Starts counting the wakeups of the default main context.
+ */
+void
+nm_perf_wakeups_install(void)
+{
+    GMainContext *context = g_main_context_default();
+
+    if (_poll_func_orig)
+        return;
+
+    _poll_func_orig = g_main_context_get_poll_func(context);
+    g_main_context_set_poll_func(context, _poll_func);
+}
+
+static void
+_dump_wakeups(void)
+{
+    static gint64  last_msec;
+    static guint64 last_n_main_loop_wakeups;
+    static guint64 last_n_sd_wakeups;
+    const gint64   now_msec = nm_utils_get_monotonic_timestamp_msec();
+    guint64        n_sd_wakeups;
+    guint64        n_sd_dispatched;
+
+    nm_sd_event_get_stats(&n_sd_wakeups, &n_sd_dispatched);
+
+    if (last_msec != 0 && now_msec > last_msec) {
+        const double minutes = ((double) (now_msec - last_msec)) / 60000.0;
+
+        _LOGI("wakeups: main loop %" G_GUINT64_FORMAT " (%.1f/min since last dump)",
+              _n_main_loop_wakeups,
+              ((double) (_n_main_loop_wakeups - last_n_main_loop_wakeups)) / minutes);
+        _LOGI("wakeups: sd-event %" G_GUINT64_FORMAT
+              " (%.1f/min since last dump), %" G_GUINT64_FORMAT " sources dispatched",
+              n_sd_wakeups,
+              ((double) (n_sd_wakeups - last_n_sd_wakeups)) / minutes,
+              n_sd_dispatched);
+    } else {
+        _LOGI("wakeups: main loop %" G_GUINT64_FORMAT, _n_main_loop_wakeups);
+        _LOGI("wakeups: sd-event %" G_GUINT64_FORMAT ", %" G_GUINT64_FORMAT " sources dispatched",
+              n_sd_wakeups,
+              n_sd_dispatched);
+    }
+
+    last_msec                = now_msec;
+    last_n_main_loop_wakeups = _n_main_loop_wakeups;
+    last_n_sd_wakeups        = n_sd_wakeups;
+}
+
+static void
+_dump_queues(void)
+{
+    NMPerfQueue queue;
+
+    for (queue = 0; queue < _NM_PERF_QUEUE_NUM; queue++) {
+        const NMPerfQueueStats *q = &_queues[queue];
+
+        _LOGI("queue %s: length %u (max %u), enqueued %" G_GUINT64_FORMAT
+              ", dispatched %" G_GUINT64_FORMAT " in %" G_GUINT64_FORMAT
+              " batches, wait p50 %" G_GINT64_FORMAT " usec, p99 %" G_GINT64_FORMAT
+              " usec, max %" G_GUINT64_FORMAT " usec",
+              _queue_to_string(queue),
+              q->len,
+              q->len_max,
+              q->n_enqueued,
+              q->n_dispatched,
+              q->n_batches,
+              nm_perf_histogram_get_percentile(&q->wait, 50) / 1000,
+              nm_perf_histogram_get_percentile(&q->wait, 99) / 1000,
+              q->wait.max_nsec / 1000u);
+    }
+}
+
+/**
+ * nm_perf_dump:
+ *
+ * Logs a summary of all histograms, queues and the number of wakeups. Dump
+ * twice while idle to measure the idle wakeups per minute.
+ */
+void
+nm_perf_dump(void)
+{
+    NMPerfProbe probe;
+
+    for (probe = 0; probe < _NM_PERF_PROBE_NUM; probe++) {
+        const NMPerfHistogram *h = &_histograms[probe];
+
+        if (h->count == 0) {
+            _LOGI("%s: no samples", _probe_to_string(probe));
+            continue;
+        }
+
+        _LOGI("%s: count %" G_GUINT64_FORMAT ", avg %" G_GUINT64_FORMAT
+              " usec, p50 %" G_GINT64_FORMAT " usec, p90 %" G_GINT64_FORMAT
+              " usec, p99 %" G_GINT64_FORMAT " usec, max %" G_GUINT64_FORMAT " usec",
+              _probe_to_string(probe),
+              h->count,
+              h->sum_nsec / h->count / 1000u,
+              nm_perf_histogram_get_percentile(h, 50) / 1000,
+              nm_perf_histogram_get_percentile(h, 90) / 1000,
+              nm_perf_histogram_get_percentile(h, 99) / 1000,
+              h->max_nsec / 1000u);
+    }
+
+    _dump_queues();
+    _dump_wakeups();
+}
@@ -0,0 +1,82 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+/*
+ * Copyright (C) 2026 Red Hat, Inc.
+ */
+
+#ifndef __NM_PERF_H__
+#define __NM_PERF_H__
+
+/*****************************************************************************/
+
+typedef enum {
+    NM_PERF_PROBE_PLATFORM_IP_ROUTE_SYNC,
+    NM_PERF_PROBE_L3CFG_COMMIT,
+    NM_PERF_PROBE_SETTINGS_RELOAD,
+    NM_PERF_PROBE_DNS_UPDATE,
+    NM_PERF_PROBE_DBUS_OBJ_NOTIFY,
+    _NM_PERF_PROBE_NUM,
+} NMPerfProbe;
+
+/* The histogram has log-linear buckets of microseconds: each power of two
+ * is split into 4 sub-buckets, so that the relative error of a bucket is
+ * at most 25%. Durations beyond the last bucket (about 2 hours) are
+ * accounted in the last bucket. */
+#define NM_PERF_HISTOGRAM_SUB_BUCKETS 4
+#define NM_PERF_HISTOGRAM_N_BUCKETS   128
+
+typedef struct {
+    guint64 count;
+    guint64 sum_nsec;
+    guint64 max_nsec;
+    guint64 buckets[NM_PERF_HISTOGRAM_N_BUCKETS];
+} NMPerfHistogram;
+
+guint  nm_perf_histogram_bucket_index(gint64 duration_nsec);
+gint64 nm_perf_histogram_bucket_upper_nsec(guint idx);
+
+void   nm_perf_histogram_add(NMPerfHistogram *histogram, gint64 duration_nsec);
+gint64 nm_perf_histogram_get_percentile(const NMPerfHistogram *histogram, guint percent);
+
+/*****************************************************************************/
+
+static inline gint64
+nm_perf_start(void)
+{
+    return nm_utils_get_monotonic_timestamp_nsec();
+}
+
+void nm_perf_record(NMPerfProbe probe, gint64 start_nsec);
+
+const NMPerfHistogram *nm_perf_get_histogram(NMPerfProbe probe);
+
+/*****************************************************************************/
+
+typedef enum {
+    NM_PERF_QUEUE_ACTIVATION_STAGE1,
+    NM_PERF_QUEUE_ACTIVATION_STAGE2,
+    NM_PERF_QUEUE_ACTIVATION_STAGE3,
+    _NM_PERF_QUEUE_NUM,
+} NMPerfQueue;
+
+typedef struct {
+    guint64         n_enqueued;
+    guint64         n_dispatched;
+    guint64         n_batches;
+    guint           len;
+    guint           len_max;
+    NMPerfHistogram wait;
+} NMPerfQueueStats;
+
+void nm_perf_queue_enqueue(NMPerfQueue queue);
+void nm_perf_queue_dequeue(NMPerfQueue queue, gint64 enqueued_nsec, gboolean dispatched);
+void nm_perf_queue_batch(NMPerfQueue queue);
+
+const NMPerfQueueStats *nm_perf_get_queue_stats(NMPerfQueue queue);
+
+/*****************************************************************************/
+
+void nm_perf_wakeups_install(void);
+
+void nm_perf_dump(void);
+
+#endif /* __NM_PERF_H__ */
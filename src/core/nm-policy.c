@@ -52,11 +52,17 @@ NM_GOBJECT_PROPERTIES_DEFINE(NMPolicy,
 #define HOSTNAME_RETRY_INTERVAL_MAX        (60U * 60 * 12) /* 12 hours */
 #define HOSTNAME_RETRY_INTERVAL_MULTIPLIER 8U
 
+/* How long one invocation of _auto_activate_idle_cb() may run, before
+ * returning to the mainloop. */
+#define AUTO_ACTIVATE_BUDGET_MSEC 10
+
 typedef struct {
     NMManager          *manager;
     NMNetns            *netns;
     NMFirewalldManager *firewalld_manager;
     CList               policy_auto_activate_lst_head;
+    GSource            *policy_auto_activate_idle_source;
+    guint               policy_auto_activate_len;
 
     NMAgentManager *agent_mgr;
 
@@ -92,6 +98,23 @@ typedef struct {
                               * will restart from the lowest timeout. */
     } hostname_retry;
 
+    /* The devices that were evaluated for the last hostname from a device, up
+     * to the one that provided it. Other devices cannot change it, unless the
+     * active connections or the default routes change. %NULL if the hostname
+     * is not from a device, and any device might provide one. */
+    GHashTable *hostname_devices;
+
+    /* A pending update_routing_and_dns(). Changes of the IP configuration
+     * come in bursts (for example, when many devices activate), so the best
+     * devices are only recomputed once per mainloop iteration. While pending,
+     * the DNS manager holds back its updates. */
+    struct {
+        GSource  *source;
+        NMDevice *changed_device;
+        bool      force_update : 1;
+        bool      update_hostname : 1;
+    } routing_and_dns;
+
     bool changing_hostname : 1; /* hostname set operation in progress */
     bool dhcp_hostname : 1;     /* current hostname was set from dhcp */
     bool updating_dns : 1;
@@ -932,6 +955,24 @@ build_device_hostname_infos(NMPolicy *self)
     return array;
 }
 
+static void
+hostname_devices_set(NMPolicyPrivate *priv, GArray *infos, guint n_infos)
+{
+    guint i;
+
+    nm_clear_pointer(&priv->hostname_devices, g_hash_table_unref);
+    priv->hostname_devices = g_hash_table_new(nm_direct_hash, NULL);
+    for (i = 0; i < n_infos; i++)
+        g_hash_table_add(priv->hostname_devices,
+                         nm_g_array_index(infos, DeviceHostnameInfo, i).device);
+}
+
+static gboolean
+hostname_device_is_relevant(NMPolicyPrivate *priv, NMDevice *device)
+{
+    return !priv->hostname_devices || g_hash_table_contains(priv->hostname_devices, device);
+}
+
 static void
 device_dns_lookup_done(NMDevice *device, gpointer user_data)
 {
@@ -998,6 +1039,8 @@ update_system_hostname(NMPolicy *self, const char *msg, gboolean reset_retry_int
 
     _LOGT(LOGD_DNS, "set-hostname: updating hostname (%s)", msg);
 
+    nm_clear_pointer(&priv->hostname_devices, g_hash_table_unref);
+
     /* Check if the hostname was set externally to NM, so that in that case
      * we can avoid to fallback to the one we got when we started.
      * Consider "not specific" hostnames as equal. */
@@ -1035,6 +1078,7 @@ update_system_hostname(NMPolicy *self, const char *msg, gboolean reset_retry_int
     if (configured_hostname && nm_utils_is_not_empty_hostname(configured_hostname)) {
         _set_hostname(self, configured_hostname, "from system configuration", FALSE);
         priv->dhcp_hostname = FALSE;
+        hostname_devices_set(priv, NULL, 0);
         return;
     }
 
@@ -1075,6 +1119,7 @@ update_system_hostname(NMPolicy *self, const char *msg, gboolean reset_retry_int
                                       info->IS_IPv4 ? "from DHCPv4" : "from DHCPv6",
                                       FALSE);
                         priv->dhcp_hostname = TRUE;
+                        hostname_devices_set(priv, infos, i + 1);
                         return;
                     }
                     _LOGW(LOGD_DNS,
@@ -1102,6 +1147,7 @@ update_system_hostname(NMPolicy *self, const char *msg, gboolean reset_retry_int
                 }
                 if (result) {
                     _set_hostname(self, result, "from address lookup", FALSE);
+                    hostname_devices_set(priv, infos, i + 1);
                     return;
                 }
                 if (wait) {
@@ -1109,6 +1155,7 @@ update_system_hostname(NMPolicy *self, const char *msg, gboolean reset_retry_int
                                      NM_DEVICE_DNS_LOOKUP_DONE,
                                      G_CALLBACK(device_dns_lookup_done),
                                      self);
+                    hostname_devices_set(priv, infos, i + 1);
                     return;
                 }
             }
@@ -1408,7 +1455,10 @@ update_ip_dns(NMPolicy *self, int addr_family, NMDevice *changed_device)
 }
 
 static void
-update_routing_and_dns(NMPolicy *self, gboolean force_update, NMDevice *changed_device)
+_update_routing_and_dns(NMPolicy *self,
+                        gboolean  force_update,
+                        NMDevice *changed_device,
+                        gboolean  update_hostname)
 {
     NMPolicyPrivate *priv = NM_POLICY_GET_PRIVATE(self);
 
@@ -1421,11 +1471,85 @@ update_routing_and_dns(NMPolicy *self, gboolean force_update, NMDevice *changed_
     update_ip6_routing(self, force_update);
 
     /* Update the system hostname */
-    update_system_hostname(self, "routing and dns", FALSE);
+    if (update_hostname)
+        update_system_hostname(self, "routing and dns", FALSE);
 
     nm_dns_manager_end_updates(priv->dns_manager, __func__);
 }
 
+static gboolean
+_routing_and_dns_idle_cb(gpointer user_data)
+{
+    NMPolicy                 *self           = user_data;
+    NMPolicyPrivate          *priv           = NM_POLICY_GET_PRIVATE(self);
+    gs_unref_object NMDevice *changed_device = NULL;
+
+    nm_clear_g_source_inst(&priv->routing_and_dns.source);
+    changed_device = g_steal_pointer(&priv->routing_and_dns.changed_device);
+
+    _update_routing_and_dns(self,
+                            priv->routing_and_dns.force_update,
+                            changed_device,
+                            priv->routing_and_dns.update_hostname);
+
+    nm_dns_manager_end_updates(priv->dns_manager, "routing-and-dns");
+    return G_SOURCE_CONTINUE;
+}
+
+/* Like update_routing_and_dns(), but on idle. Several requests in the same
+ * mainloop iteration are merged into one. */
+static void
+update_routing_and_dns_schedule(NMPolicy *self,
+                                gboolean  force_update,
+                                NMDevice *changed_device,
+                                gboolean  update_hostname)
+{
+    NMPolicyPrivate *priv = NM_POLICY_GET_PRIVATE(self);
+
+    if (!priv->routing_and_dns.source) {
+        nm_dns_manager_begin_updates(priv->dns_manager, "routing-and-dns");
+        priv->routing_and_dns.source = nm_g_idle_add_source(_routing_and_dns_idle_cb, self);
+        priv->routing_and_dns.changed_device  = nm_g_object_ref(changed_device);
+        priv->routing_and_dns.force_update    = force_update;
+        priv->routing_and_dns.update_hostname = update_hostname;
+        return;
+    }
+
+    /* Different devices changed. Then the DNS configuration is copied to all
+     * devices that need it. */
+    if (priv->routing_and_dns.changed_device != changed_device)
+        g_clear_object(&priv->routing_and_dns.changed_device);
+    if (force_update)
+        priv->routing_and_dns.force_update = TRUE;
+    if (update_hostname)
+        priv->routing_and_dns.update_hostname = TRUE;
+}
+
+static void
+update_routing_and_dns(NMPolicy *self, gboolean force_update, NMDevice *changed_device)
+{
+    NMPolicyPrivate          *priv           = NM_POLICY_GET_PRIVATE(self);
+    gs_unref_object NMDevice *pending_device = NULL;
+
+    if (!priv->routing_and_dns.source) {
+        _update_routing_and_dns(self, force_update, changed_device, TRUE);
+        return;
+    }
+
+    /* An update is pending. Do it now, together with this one. */
+    nm_clear_g_source_inst(&priv->routing_and_dns.source);
+    pending_device = g_steal_pointer(&priv->routing_and_dns.changed_device);
+    if (pending_device != changed_device)
+        changed_device = NULL;
+
+    _update_routing_and_dns(self,
+                            force_update || priv->routing_and_dns.force_update,
+                            changed_device,
+                            TRUE);
+
+    nm_dns_manager_end_updates(priv->dns_manager, "routing-and-dns");
+}
+
 static void
 check_activating_active_connections(NMPolicy *self)
 {
@@ -1532,7 +1656,7 @@ _auto_activate_device(NMPolicy *self, NMDevice *device)
     if (!nm_device_autoconnect_allowed(device))
         return;
 
-    connections = nm_manager_get_activatable_connections(priv->manager, TRUE, TRUE, &len);
+    connections = nm_manager_get_activatable_connections_for_device(priv->manager, device, &len);
     if (!connections[0])
         return;
 
@@ -1614,14 +1738,20 @@ _auto_activate_device(NMPolicy *self, NMDevice *device)
 static void
 _auto_activate_device_clear(NMPolicy *self, NMDevice *device, gboolean do_activate)
 {
+    NMPolicyPrivate *priv;
+
     nm_assert(NM_IS_DEVICE(device));
     nm_assert(NM_IS_POLICY(self));
     nm_assert(c_list_is_linked(&device->policy_auto_activate_lst));
     nm_assert(c_list_contains(&NM_POLICY_GET_PRIVATE(self)->policy_auto_activate_lst_head,
                               &device->policy_auto_activate_lst));
 
+    priv = NM_POLICY_GET_PRIVATE(self);
+
     c_list_unlink(&device->policy_auto_activate_lst);
-    nm_clear_g_source_inst(&device->policy_auto_activate_idle_source);
+    nm_assert(priv->policy_auto_activate_len > 0);
+    if (--priv->policy_auto_activate_len == 0)
+        nm_clear_g_source_inst(&priv->policy_auto_activate_idle_source);
 
     if (do_activate)
         _auto_activate_device(self, device);
@@ -1632,11 +1762,43 @@ _auto_activate_device_clear(NMPolicy *self, NMDevice *device, gboolean do_activa
 static gboolean
 _auto_activate_idle_cb(gpointer user_data)
 {
-    NMDevice *device = user_data;
-
-    nm_assert(NM_IS_DEVICE(device));
+    NMPolicy        *self = user_data;
+    NMPolicyPrivate *priv = NM_POLICY_GET_PRIVATE(self);
+    gint64           start_msec;
+    gint64           now_msec;
+    gint64           max_latency_msec = 0;
+    guint            n_devices        = 0;
+
+    /* The queue is sorted by priority. Process devices until the time budget
+     * is used up, and continue in the next idle invocation. That way, a burst
+     * of carrier changes does not block the mainloop (and D-Bus requests). */
+    start_msec = nm_utils_get_monotonic_timestamp_msec();
+    now_msec   = start_msec;
+    do {
+        NMDevice *device;
+
+        device = c_list_first_entry(&priv->policy_auto_activate_lst_head,
+                                    NMDevice,
+                                    policy_auto_activate_lst);
+
+        max_latency_msec =
+            NM_MAX(max_latency_msec, now_msec - device->policy_auto_activate_queued_msec);
+        n_devices++;
+
+        _auto_activate_device_clear(self, device, TRUE);
+
+        now_msec = nm_utils_get_monotonic_timestamp_msec();
+    } while (priv->policy_auto_activate_len > 0
+             && now_msec - start_msec < AUTO_ACTIVATE_BUDGET_MSEC);
+
+    _LOGT(LOGD_DEVICE,
+          "auto-activate: checked %u devices in %" G_GINT64_FORMAT
+          " msec (max queued for %" G_GINT64_FORMAT " msec), %u devices still queued",
+          n_devices,
+          now_msec - start_msec,
+          max_latency_msec,
+          priv->policy_auto_activate_len);
 
-    _auto_activate_device_clear(nm_manager_get_policy(nm_device_get_manager(device)), device, TRUE);
     return G_SOURCE_CONTINUE;
 }
 
@@ -1826,6 +1988,7 @@ nm_policy_device_recheck_auto_activate_schedule(NMPolicy *self, NMDevice *device
     NMPolicyPrivate    *priv;
     NMActiveConnection *ac;
     const CList        *tmp_list;
+    NMDevice           *d;
 
     g_return_if_fail(NM_IS_POLICY(self));
     g_return_if_fail(NM_IS_DEVICE(device));
@@ -1863,8 +2026,28 @@ nm_policy_device_recheck_auto_activate_schedule(NMPolicy *self, NMDevice *device
 
     nm_device_add_pending_action(device, NM_PENDING_ACTION_AUTOACTIVATE, TRUE);
 
-    c_list_link_tail(&priv->policy_auto_activate_lst_head, &device->policy_auto_activate_lst);
-    device->policy_auto_activate_idle_source = nm_g_idle_add_source(_auto_activate_idle_cb, device);
+    device->policy_auto_activate_queued_msec = nm_utils_get_monotonic_timestamp_msec();
+    device->policy_auto_activate_priority =
+        nm_config_data_get_device_config_int64_by_device(
+            NM_CONFIG_GET_DATA,
+            NM_CONFIG_KEYFILE_KEY_DEVICE_AUTOCONNECT_QUEUE_PRIORITY,
+            device,
+            10,
+            G_MININT32,
+            G_MAXINT32,
+            0,
+            0);
+
+    /* insert after all devices with the same or higher priority. */
+    c_list_for_each_entry (d, &priv->policy_auto_activate_lst_head, policy_auto_activate_lst) {
+        if (d->policy_auto_activate_priority < device->policy_auto_activate_priority)
+            break;
+    }
+    c_list_link_before(&d->policy_auto_activate_lst, &device->policy_auto_activate_lst);
+    priv->policy_auto_activate_len++;
+
+    if (!priv->policy_auto_activate_idle_source)
+        priv->policy_auto_activate_idle_source = nm_g_idle_add_source(_auto_activate_idle_cb, self);
 }
 
 static gboolean
@@ -2217,6 +2400,39 @@ activate_secondary_connections(NMPolicy *self, NMConnection *connection, NMDevic
     return success;
 }
 
+static void
+prestart_secondary_vpn_services(NMPolicy *self, NMConnection *connection)
+{
+    NMPolicyPrivate     *priv = NM_POLICY_GET_PRIVATE(self);
+    NMSettingConnection *s_con;
+    guint32              i;
+
+    s_con = nm_connection_get_setting_connection(connection);
+    if (!s_con)
+        return;
+
+    /* Start the VPN services of the secondaries while the base device is still
+     * activating. They are only activated once the device is up, but spawning
+     * the service in parallel takes it off the critical path. */
+    for (i = 0; i < nm_setting_connection_get_num_secondaries(s_con); i++) {
+        NMSettingsConnection *sett_conn;
+        NMSettingVpn         *s_vpn;
+
+        sett_conn =
+            nm_settings_get_connection_by_uuid(priv->settings,
+                                               nm_setting_connection_get_secondary(s_con, i));
+        if (!sett_conn)
+            continue;
+
+        s_vpn = nm_connection_get_setting_vpn(nm_settings_connection_get_connection(sett_conn));
+        if (!s_vpn)
+            continue;
+
+        nm_vpn_manager_prestart_service(nm_vpn_manager_get(),
+                                        nm_setting_vpn_get_service_type(s_vpn));
+    }
+}
+
 static void
 device_state_changed(NMDevice           *device,
                      NMDeviceState       new_state,
@@ -2383,7 +2599,7 @@ device_state_changed(NMDevice           *device,
     case NM_DEVICE_STATE_UNMANAGED:
     case NM_DEVICE_STATE_UNAVAILABLE:
         if (old_state > NM_DEVICE_STATE_DISCONNECTED)
-            update_routing_and_dns(self, FALSE, device);
+            update_routing_and_dns_schedule(self, FALSE, device, TRUE);
         break;
     case NM_DEVICE_STATE_DEACTIVATING:
         if (sett_conn) {
@@ -2431,7 +2647,7 @@ device_state_changed(NMDevice           *device,
             reset_autoconnect_all(self, device, FALSE);
 
         if (old_state > NM_DEVICE_STATE_DISCONNECTED)
-            update_routing_and_dns(self, FALSE, device);
+            update_routing_and_dns_schedule(self, FALSE, device, TRUE);
 
         /* Device is now available for auto-activation */
         nm_policy_device_recheck_auto_activate_schedule(self, device);
@@ -2442,6 +2658,10 @@ device_state_changed(NMDevice           *device,
          * activation. */
         activate_port_or_children_connections(self, device, FALSE);
 
+        if (sett_conn)
+            prestart_secondary_vpn_services(self,
+                                            nm_settings_connection_get_connection(sett_conn));
+
         /* Now that the device state is progressing, we don't care
          * anymore for the AC state. */
         ac = (NMActiveConnection *) nm_device_get_act_request(device);
@@ -2522,13 +2742,12 @@ device_l3cd_changed(NMDevice             *device,
                                      nm_device_is_vpn(device) ? NM_DNS_IP_CONFIG_TYPE_VPN
                                                               : NM_DNS_IP_CONFIG_TYPE_DEFAULT,
                                      TRUE);
-        update_ip_dns(self, AF_INET, device);
-        update_ip_dns(self, AF_INET6, device);
-        update_ip4_routing(self, TRUE);
-        update_ip6_routing(self, TRUE);
         /* FIXME: since we already monitor platform addresses changes,
-         * this is probably no longer necessary? */
-        update_system_hostname(self, "ip conf", FALSE);
+         * updating the hostname is probably no longer necessary? */
+        update_routing_and_dns_schedule(self,
+                                        TRUE,
+                                        device,
+                                        hostname_device_is_relevant(priv, device));
     } else {
         nm_dns_manager_set_ip_config(priv->dns_manager,
                                      AF_UNSPEC,
@@ -2549,7 +2768,8 @@ device_platform_address_changed(NMDevice *device, gpointer user_data)
     NMDeviceState    state;
 
     state = nm_device_get_state(device);
-    if (state > NM_DEVICE_STATE_DISCONNECTED && state < NM_DEVICE_STATE_DEACTIVATING) {
+    if (state > NM_DEVICE_STATE_DISCONNECTED && state < NM_DEVICE_STATE_DEACTIVATING
+        && hostname_device_is_relevant(priv, device)) {
         update_system_hostname(self, "address changed", TRUE);
     }
 }
@@ -2631,6 +2851,9 @@ device_removed(NMManager *manager, NMDevice *device, gpointer user_data)
     if (g_hash_table_remove(priv->devices, device))
         devices_list_unregister(self, device);
 
+    if (priv->hostname_devices)
+        g_hash_table_remove(priv->hostname_devices, device);
+
     /* Don't update routing and DNS here as we've already handled that
      * for devices that need it when the device's state changed to UNMANAGED.
      */
@@ -3184,6 +3407,7 @@ dispose(GObject *object)
     NMPolicyPrivate *priv = NM_POLICY_GET_PRIVATE(self);
 
     nm_assert(c_list_is_empty(&priv->policy_auto_activate_lst_head));
+    nm_assert(!priv->policy_auto_activate_idle_source);
     nm_assert(g_hash_table_size(priv->devices) == 0);
 
     nm_clear_g_object(&priv->default_ac4);
@@ -3205,6 +3429,10 @@ dispose(GObject *object)
         g_clear_object(&priv->agent_mgr);
     }
 
+    nm_clear_g_object(&priv->routing_and_dns.changed_device);
+    if (nm_clear_g_source_inst(&priv->routing_and_dns.source) && priv->dns_manager)
+        nm_dns_manager_end_updates(priv->dns_manager, "routing-and-dns");
+
     if (priv->dns_manager) {
         nm_clear_g_signal_handler(priv->dns_manager, &priv->config_changed_id);
         g_clear_object(&priv->dns_manager);
@@ -3259,6 +3487,7 @@ finalize(GObject *object)
     NMPolicyPrivate *priv = NM_POLICY_GET_PRIVATE(self);
 
     g_hash_table_unref(priv->devices);
+    nm_clear_pointer(&priv->hostname_devices, g_hash_table_unref);
 
     G_OBJECT_CLASS(nm_policy_parent_class)->finalize(object);
 
@@ -0,0 +1,344 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+/*
+ * Copyright (C) 2026 Red Hat, Inc.
+ */
+
+#include "src/core/nm-default-daemon.h"
+
+#include "nm-startup-trace.h"
+
+#include "libnm-glib-aux/nm-io-utils.h"
+#include "libnm-glib-aux/nm-json-aux.h"
+#include "libnm-glib-aux/nm-time-utils.h"
+
+/*****************************************************************************/
+
+#define _NMLOG_DOMAIN      LOGD_CORE
+#define _NMLOG(level, ...) __NMLOG_DEFAULT(level, _NMLOG_DOMAIN, "startup-trace", __VA_ARGS__)
+
+/*****************************************************************************/
+
+/* Give up if the startup doesn't complete. */
+#define MAX_EVENTS 50000u
+
+typedef struct {
+    /* must be the first field, the struct is hashed with nm_pstr_hash(). */
+    char  *name;
+    guint  id;
+    char  *phase;
+    gint64 phase_start_nsec;
+} TraceTrack;
+
+typedef struct {
+    TraceTrack *track;
+    char       *name;
+    gint64      start_nsec;
+    gint64      end_nsec;
+} TraceEvent;
+
+bool _nm_startup_trace_active;
+
+static struct {
+    GArray     *events;
+    GHashTable *tracks;
+    gint64      start_nsec;
+    char       *blocker_track;
+    char       *blocker_reason;
+} _trace;
+
+/*****************************************************************************/
+
+static void
+_track_free(gpointer data)
+{
+    TraceTrack *track = data;
+
+    g_free(track->name);
+    g_free(track->phase);
+    g_free(track);
+}
+
+static void
+_event_clear(gpointer data)
+{
+    TraceEvent *event = data;
+
+    g_free(event->name);
+}
+
+static void
+_trace_clear(void)
+{
+    _nm_startup_trace_active = FALSE;
+    nm_clear_pointer(&_trace.events, g_array_unref);
+    nm_clear_pointer(&_trace.tracks, g_hash_table_destroy);
+    nm_clear_g_free(&_trace.blocker_track);
+    nm_clear_g_free(&_trace.blocker_reason);
+}
+
+static TraceTrack *
+_track_get(const char *name)
+{
+    TraceTrack *track;
+
+    track = g_hash_table_lookup(_trace.tracks, &name);
+    if (!track) {
+        track  = g_new(TraceTrack, 1);
+        *track = (TraceTrack) {
+            .name = g_strdup(name),
+            .id   = g_hash_table_size(_trace.tracks) + 1u,
+        };
+        g_hash_table_add(_trace.tracks, track);
+    }
+    return track;
+}
+
+static void
+_event_add(TraceTrack *track, const char *name, gint64 start_nsec, gint64 end_nsec)
+{
+    if (_trace.events->len >= MAX_EVENTS) {
+        _LOGW("too many events, stop tracing");
+        _trace_clear();
+        return;
+    }
+
+    /* Spans may be recorded after the fact, like reading the configuration
+     * before tracing was enabled. */
+    _trace.start_nsec = NM_MIN(_trace.start_nsec, start_nsec);
+
+    g_array_append_val(_trace.events,
+                       ((TraceEvent) {
+                           .track      = track,
+                           .name       = g_strdup(name),
+                           .start_nsec = start_nsec,
+                           .end_nsec   = NM_MAX(start_nsec, end_nsec),
+                       }));
+}
+
+/*****************************************************************************/
+
+/**
+ * nm_startup_trace_start:
+ *
+ * Starts recording the startup. The recorded spans are written to
+ * %NM_STARTUP_TRACE_FILE by nm_startup_trace_finish(), when the startup
+ * completes.
+ */
+void
+nm_startup_trace_start(void)
+{
+    if (_nm_startup_trace_active)
+        return;
+
+    _trace.events = g_array_new(FALSE, FALSE, sizeof(TraceEvent));
+    g_array_set_clear_func(_trace.events, _event_clear);
+    _trace.tracks     = g_hash_table_new_full(nm_pstr_hash, nm_pstr_equal, _track_free, NULL);
+    _trace.start_nsec = nm_utils_get_monotonic_timestamp_nsec();
+
+    _nm_startup_trace_active = TRUE;
+}
+
+void
+_nm_startup_trace_span(const char *track, const char *name, gint64 start_nsec, gint64 end_nsec)
+{
+    nm_assert(_nm_startup_trace_active);
+
+    _event_add(_track_get(track), name, start_nsec, end_nsec);
+}
+
+/* Ends the current phase of @track and starts @phase (if not %NULL).
+ * A device state or the state of a DHCP client are such phases. */
+void
+_nm_startup_trace_phase(const char *track, const char *phase)
+{
+    TraceTrack *t;
+    gint64      now_nsec;
+
+    nm_assert(_nm_startup_trace_active);
+
+    t = _track_get(track);
+    if (nm_streq0(t->phase, phase))
+        return;
+
+    now_nsec = nm_utils_get_monotonic_timestamp_nsec();
+
+    if (t->phase) {
+        _event_add(t, t->phase, t->phase_start_nsec, now_nsec);
+        if (!_nm_startup_trace_active)
+            return;
+        nm_clear_g_free(&t->phase);
+    }
+
+    if (phase) {
+        t->phase            = g_strdup(phase);
+        t->phase_start_nsec = now_nsec;
+    }
+}
+
+/* Remembers what the startup is currently waiting for. The last blocker
+ * before the startup completes is what gated it. */
+void
+_nm_startup_trace_blocker(const char *track, const char *reason)
+{
+    nm_assert(_nm_startup_trace_active);
+
+    if (!nm_streq0(_trace.blocker_track, track)) {
+        g_free(_trace.blocker_track);
+        _trace.blocker_track = g_strdup(track);
+    }
+    if (!nm_streq0(_trace.blocker_reason, reason)) {
+        g_free(_trace.blocker_reason);
+        _trace.blocker_reason = g_strdup(reason);
+    }
+}
+
+/*****************************************************************************/
+
+static gint64
+_ts_usec(gint64 nsec)
+{
+    return nm_utils_monotonic_timestamp_as_boottime(nsec, 1) / 1000;
+}
+
+static void
+_json_append_thread_name(GString *gstr, guint tid, const char *name)
+{
+    g_string_append_printf(gstr,
+                           "{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": %u, "
+                           "\"args\": {\"name\": ",
+                           tid);
+    nm_json_gstr_append_string(gstr, name);
+    g_string_append(gstr, "}}");
+}
+
+static void
+_json_append_event(GString *gstr, guint tid, const TraceEvent *event)
+{
+    g_string_append(gstr, "{\"name\": ");
+    nm_json_gstr_append_string(gstr, event->name);
+    g_string_append_printf(gstr,
+                           ", \"cat\": \"startup\", \"ph\": \"X\", \"pid\": 1, \"tid\": %u"
+                           ", \"ts\": %" G_GINT64_FORMAT ", \"dur\": %" G_GINT64_FORMAT "}",
+                           tid,
+                           _ts_usec(event->start_nsec),
+                           (event->end_nsec - event->start_nsec) / 1000);
+}
+
+static gboolean
+_track_is_critical(const TraceTrack *track)
+{
+    const char *s;
+
+    if (!_trace.blocker_track)
+        return FALSE;
+
+    /* The blocker is a device, its DHCP and IP tracks are named "$IFACE/...". */
+    if (!g_str_has_prefix(track->name, _trace.blocker_track))
+        return FALSE;
+
+    s = &track->name[strlen(_trace.blocker_track)];
+    return NM_IN_SET(s[0], '\0', '/');
+}
+
+/**
+ * nm_startup_trace_finish:
+ *
+ * Called when the startup completes. Writes the recorded spans as
+ * Chrome trace event JSON (which Perfetto can load too) and stops tracing.
+ * The spans of what the startup was waiting for last are repeated on
+ * an extra "critical path" track.
+ */
+void
+nm_startup_trace_finish(void)
+{
+    nm_auto_free_gstring GString *gstr     = NULL;
+    gs_free_error GError         *error    = NULL;
+    guint                         tid_crit = 0;
+    GHashTableIter                iter;
+    TraceTrack                   *track;
+    gint64                        now_nsec;
+    guint                         i;
+
+    if (!_nm_startup_trace_active)
+        return;
+
+    now_nsec = nm_utils_get_monotonic_timestamp_nsec();
+
+    /* Close the phases that are still going on. */
+    g_hash_table_iter_init(&iter, _trace.tracks);
+    while (g_hash_table_iter_next(&iter, (gpointer *) &track, NULL)) {
+        if (track->phase)
+            g_array_append_val(_trace.events,
+                               ((TraceEvent) {
+                                   .track      = track,
+                                   .name       = g_steal_pointer(&track->phase),
+                                   .start_nsec = track->phase_start_nsec,
+                                   .end_nsec   = now_nsec,
+                               }));
+    }
+
+    _event_add(_track_get("manager"), "startup", _trace.start_nsec, now_nsec);
+    if (!_nm_startup_trace_active)
+        return;
+
+    gstr = g_string_sized_new(64 * _trace.events->len + 1024);
+    g_string_append(gstr, "{\"traceEvents\": [\n");
+
+    g_hash_table_iter_init(&iter, _trace.tracks);
+    while (g_hash_table_iter_next(&iter, (gpointer *) &track, NULL)) {
+        _json_append_thread_name(gstr, track->id, track->name);
+        g_string_append(gstr, ",\n");
+    }
+
+    if (_trace.blocker_track) {
+        gs_free char *name = g_strdup_printf("critical path: %s", _trace.blocker_track);
+
+        tid_crit = g_hash_table_size(_trace.tracks) + 1u;
+        _json_append_thread_name(gstr, tid_crit, name);
+        g_string_append(gstr, ",\n");
+    }
+
+    for (i = 0; i < _trace.events->len; i++) {
+        const TraceEvent *event = &nm_g_array_index(_trace.events, TraceEvent, i);
+
+        if (i > 0)
+            g_string_append(gstr, ",\n");
+        _json_append_event(gstr, event->track->id, event);
+        if (tid_crit > 0 && _track_is_critical(event->track)) {
+            g_string_append(gstr, ",\n");
+            _json_append_event(gstr, tid_crit, event);
+        }
+    }
+
+    g_string_append_printf(gstr,
+                           "\n], \"displayTimeUnit\": \"ms\", \"otherData\": "
+                           "{\"startup-complete-msec\": %" G_GINT64_FORMAT,
+                           (now_nsec - _trace.start_nsec) / NM_UTILS_NSEC_PER_MSEC);
+    if (_trace.blocker_track) {
+        g_string_append(gstr, ", \"blocked-by\": ");
+        nm_json_gstr_append_string(gstr, _trace.blocker_track);
+        g_string_append(gstr, ", \"blocked-reason\": ");
+        nm_json_gstr_append_string(gstr, _trace.blocker_reason ?: "");
+    }
+    g_string_append(gstr, "}}\n");
+
+    if (!nm_utils_file_set_contents(NM_STARTUP_TRACE_FILE,
+                                    gstr->str,
+                                    gstr->len,
+                                    0644,
+                                    NULL,
+                                    NULL,
+                                    NULL,
+                                    &error)) {
+        _LOGW("failure to write %s: %s", NM_STARTUP_TRACE_FILE, error->message);
+    } else {
+        _LOGI("startup took %" G_GINT64_FORMAT " msec, last waiting for %s%s%s%s; trace written "
+              "to %s",
+              (now_nsec - _trace.start_nsec) / NM_UTILS_NSEC_PER_MSEC,
+              _trace.blocker_track ?: "nothing",
+              NM_PRINT_FMT_QUOTED(_trace.blocker_reason, " (", _trace.blocker_reason, ")", ""),
+              NM_STARTUP_TRACE_FILE);
+    }
+
+    _trace_clear();
+}
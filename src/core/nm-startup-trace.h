@@ -0,0 +1,56 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+/*
+ * Copyright (C) 2026 Red Hat, Inc.
+ */
+
+#ifndef __NM_STARTUP_TRACE_H__
+#define __NM_STARTUP_TRACE_H__
+
+/*****************************************************************************/
+
+#define NM_STARTUP_TRACE_FILE NMRUNDIR "/startup-trace.json"
+
+extern bool _nm_startup_trace_active;
+
+/* Whether the startup is being traced. Callers check this before
+ * formatting names for the trace. */
+static inline gboolean
+nm_startup_trace_active(void)
+{
+    return G_UNLIKELY(_nm_startup_trace_active);
+}
+
+void nm_startup_trace_start(void);
+
+void
+_nm_startup_trace_span(const char *track, const char *name, gint64 start_nsec, gint64 end_nsec);
+void _nm_startup_trace_phase(const char *track, const char *phase);
+void _nm_startup_trace_blocker(const char *track, const char *reason);
+
+#define nm_startup_trace_span(track, name, start_nsec, end_nsec)               \
+    G_STMT_START                                                               \
+    {                                                                          \
+        if (nm_startup_trace_active())                                         \
+            _nm_startup_trace_span((track), (name), (start_nsec), (end_nsec)); \
+    }                                                                          \
+    G_STMT_END
+
+#define nm_startup_trace_phase(track, phase)           \
+    G_STMT_START                                       \
+    {                                                  \
+        if (nm_startup_trace_active())                 \
+            _nm_startup_trace_phase((track), (phase)); \
+    }                                                  \
+    G_STMT_END
+
+#define nm_startup_trace_blocker(track, reason)           \
+    G_STMT_START                                          \
+    {                                                     \
+        if (nm_startup_trace_active())                    \
+            _nm_startup_trace_blocker((track), (reason)); \
+    }                                                     \
+    G_STMT_END
+
+void nm_startup_trace_finish(void);
+
+#endif /* __NM_STARTUP_TRACE_H__ */
@@ -15,6 +15,104 @@
 
 /*****************************************************************************/
 
+/* Helpers for scale tests. With "-m perf" (meson benchmark) they run with
+ * the large numbers, otherwise with numbers small enough for the normal
+ * test run. The environment variable @env overrides both. */
+
+static inline guint
+nmtst_scale_get(const char *env, guint quick, guint perf)
+{
+    const char *s = g_getenv(env);
+
+    if (s)
+        return _nm_utils_ascii_str_to_int64(s, 10, 1, 100000, quick);
+    return g_test_perf() ? perf : quick;
+}
+
+static inline gint64
+nmtst_get_rss_kib(void)
+{
+    gs_free char *contents = NULL;
+    unsigned long size;
+    unsigned long resident;
+
+    if (!g_file_get_contents("/proc/self/statm", &contents, NULL, NULL))
+        return 0;
+    if (sscanf(contents, "%lu %lu", &size, &resident) != 2)
+        return 0;
+    return ((gint64) resident) * (sysconf(_SC_PAGESIZE) / 1024);
+}
+
+/* Creates the profile number @idx of a large set of profiles, with a mix of
+ * ethernet, VLAN, bond and 802.1X ethernet profiles. Each has a manual IPv4
+ * configuration with @n_routes routes. The profile is not normalized. */
+static inline NMConnection *
+nmtst_create_scale_connection(guint idx, guint n_routes)
+{
+    NMConnection        *con;
+    NMSettingConnection *s_con;
+    NMSettingIPConfig   *s_ip4;
+    NMSetting8021x      *s_8021x;
+    char                 id[64];
+    char                 ifname[16];
+    char                 dest[INET_ADDRSTRLEN];
+    guint                i;
+
+    nm_sprintf_buf(id, "scale-%u", idx);
+
+    switch (idx % 4) {
+    case 0:
+        con = nmtst_create_minimal_connection(id, NULL, NM_SETTING_WIRED_SETTING_NAME, &s_con);
+        break;
+    case 1:
+        con = nmtst_create_minimal_connection(id, NULL, NM_SETTING_VLAN_SETTING_NAME, &s_con);
+        nm_sprintf_buf(ifname, "vlan%u", idx);
+        g_object_set(s_con, NM_SETTING_CONNECTION_INTERFACE_NAME, ifname, NULL);
+        g_object_set(nm_connection_get_setting_vlan(con),
+                     NM_SETTING_VLAN_PARENT,
+                     "eth0",
+                     NM_SETTING_VLAN_ID,
+                     1 + (idx % 4094),
+                     NULL);
+        break;
+    case 2:
+        con = nmtst_create_minimal_connection(id, NULL, NM_SETTING_BOND_SETTING_NAME, &s_con);
+        nm_sprintf_buf(ifname, "bond%u", idx);
+        g_object_set(s_con, NM_SETTING_CONNECTION_INTERFACE_NAME, ifname, NULL);
+        nm_setting_bond_add_option(nm_connection_get_setting_bond(con),
+                                   NM_SETTING_BOND_OPTION_MODE,
+                                   "active-backup");
+        break;
+    default:
+        con = nmtst_create_minimal_connection(id, NULL, NM_SETTING_WIRED_SETTING_NAME, &s_con);
+        s_8021x = NM_SETTING_802_1X(nm_setting_802_1x_new());
+        nm_setting_802_1x_add_eap_method(s_8021x, "peap");
+        g_object_set(s_8021x,
+                     NM_SETTING_802_1X_IDENTITY,
+                     id,
+                     NM_SETTING_802_1X_PASSWORD,
+                     "secret",
+                     NM_SETTING_802_1X_PHASE2_AUTH,
+                     "mschapv2",
+                     NULL);
+        nm_connection_add_setting(con, NM_SETTING(s_8021x));
+        break;
+    }
+
+    s_ip4 = NM_SETTING_IP_CONFIG(nm_setting_ip4_config_new());
+    g_object_set(s_ip4, NM_SETTING_IP_CONFIG_METHOD, NM_SETTING_IP4_CONFIG_METHOD_MANUAL, NULL);
+    nmtst_setting_ip_config_add_address(s_ip4, "192.0.2.1", 24);
+    for (i = 0; i < n_routes; i++) {
+        nm_sprintf_buf(dest, "10.%u.%u.0", (i >> 8) & 0xFFu, i & 0xFFu);
+        nmtst_setting_ip_config_add_route(s_ip4, dest, 24, "192.0.2.254", 100 + i);
+    }
+    nm_connection_add_setting(con, NM_SETTING(s_ip4));
+
+    return con;
+}
+
+/*****************************************************************************/
+
 #ifdef __NETWORKMANAGER_PLATFORM_H__
 
 static inline NMPlatformIP4Address *
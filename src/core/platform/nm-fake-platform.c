@@ -330,7 +330,7 @@ link_add(NMPlatform            *platform,
     else
         g_assert(parent == 0);
 
-    g_assert((parent != 0) == NM_IN_SET(type, NM_LINK_TYPE_VLAN));
+    g_assert((parent != 0) == NM_IN_SET(type, NM_LINK_TYPE_VLAN, NM_LINK_TYPE_INFINIBAND));
 
     switch (type) {
     case NM_LINK_TYPE_BRIDGE:
@@ -351,6 +351,17 @@ link_add(NMPlatform            *platform,
         dev_lnk = nmp_object_new(NMP_OBJECT_TYPE_LNK_BOND, props);
         break;
     }
+    case NM_LINK_TYPE_INFINIBAND:
+    {
+        const NMPlatformLnkInfiniband *props = extra_data;
+
+        g_assert(props);
+
+        dev_lnk                       = nmp_object_new(NMP_OBJECT_TYPE_LNK_INFINIBAND, NULL);
+        dev_lnk->lnk_infiniband.p_key = props->p_key;
+        dev_lnk->lnk_infiniband.mode  = props->mode ?: "datagram";
+        break;
+    }
     case NM_LINK_TYPE_VETH:
         veth_peer = extra_data;
         g_assert(veth_peer);
@@ -1223,8 +1234,8 @@ ip_route_add(NMPlatform *platform, NMPNlmFlags flags, NMPObject *obj_stack, char
 
     flags = NM_FLAGS_UNSET(flags, NMP_NLM_FLAG_SUPPRESS_NETLINK_FAILURE);
 
-    /* currently, only replace is implemented. */
-    g_assert(flags == NMP_NLM_FLAG_REPLACE);
+    /* currently, only replace and append are implemented. */
+    g_assert(NM_IN_SET(flags, NMP_NLM_FLAG_REPLACE, NMP_NLM_FLAG_APPEND));
 
     if (NMP_OBJECT_GET_TYPE(obj_stack) == NMP_OBJECT_TYPE_IP4_ROUTE
         && obj_stack->ip4_route.n_nexthops == 0 && obj_stack->ip4_route.ifindex > 0)
@@ -1325,6 +1336,9 @@ ip_route_add(NMPlatform *platform, NMPNlmFlags flags, NMPObject *obj_stack, char
         case NMP_NLM_FLAG_REPLACE:
             nlmsgflags = NLM_F_REPLACE;
             break;
+        case NMP_NLM_FLAG_APPEND:
+            nlmsgflags = NLM_F_CREATE | NLM_F_APPEND;
+            break;
         default:
             g_assert_not_reached();
             break;
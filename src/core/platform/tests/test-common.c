@@ -1314,6 +1314,8 @@ nmtstp_check_platform_full(NMPlatform *platform, guint32 obj_type_flags, gboolea
                 gs_unref_ptrarray GPtrArray *arr2b_sorted = NULL;
                 guint                        found_obj1   = 0;
                 guint                        found_obj2   = 0;
+                NMDedupMultiIter             iter;
+                const NMPObject             *obj;
                 guint                        i;
 
                 nmp_lookup_init_route_by_weak_id(&lookup, obj1);
@@ -1394,6 +1396,43 @@ nmtstp_check_platform_full(NMPlatform *platform, guint32 obj_type_flags, gboolea
 
                 g_assert_cmpint(found_obj1, ==, 1u);
                 g_assert_cmpint(found_obj2, ==, 1u);
+
+                /* The route must also be found in the index by destination. */
+                if (obj_type == NMP_OBJECT_TYPE_IP4_ROUTE) {
+                    nmp_lookup_init_ip4_route_by_destination(
+                        &lookup,
+                        nm_platform_ip_route_get_effective_table(&obj1->ip_route),
+                        obj1->ip4_route.network,
+                        obj1->ip4_route.plen);
+                } else {
+                    nmp_lookup_init_ip6_route_by_destination(
+                        &lookup,
+                        nm_platform_ip_route_get_effective_table(&obj1->ip_route),
+                        &obj1->ip6_route.network,
+                        obj1->ip6_route.plen);
+                }
+                found_obj1 = 0;
+                nm_platform_iter_obj_for_each (&iter, platform, &lookup, &obj) {
+                    g_assert_cmpint(obj->ip_route.plen, ==, obj1->ip_route.plen);
+                    if (obj == obj1)
+                        found_obj1++;
+                }
+                g_assert_cmpint(found_obj1, ==, 1u);
+
+                /* ... and in the index by table. */
+                nmp_lookup_init_route_by_table(
+                    &lookup,
+                    obj_type,
+                    nm_platform_ip_route_get_effective_table(&obj1->ip_route));
+                found_obj1 = 0;
+                nm_platform_iter_obj_for_each (&iter, platform, &lookup, &obj) {
+                    g_assert_cmpint(nm_platform_ip_route_get_effective_table(&obj->ip_route),
+                                    ==,
+                                    nm_platform_ip_route_get_effective_table(&obj1->ip_route));
+                    if (obj == obj1)
+                        found_obj1++;
+                }
+                g_assert_cmpint(found_obj1, ==, 1u);
             }
         }
     }
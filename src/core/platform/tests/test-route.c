@@ -659,8 +659,8 @@ test_via(void)
         .network         = net4,
         .plen            = 32,
         .metric          = metric,
-        .via.addr_family = AF_INET6,
-        .via.addr.addr6  = gateway6,
+        .via_addr_family = AF_INET6,
+        .via_addr.addr6  = gateway6,
         .mss             = mss,
     };
     g_assert(NMTST_NM_ERR_SUCCESS(
@@ -680,8 +680,8 @@ test_via(void)
     rts[0].gateway         = INADDR_ANY;
     rts[0].metric          = metric;
     rts[0].mss             = mss;
-    rts[0].via.addr_family = AF_INET6;
-    rts[0].via.addr.addr6  = gateway6;
+    rts[0].via_addr_family = AF_INET6;
+    rts[0].via_addr.addr6  = gateway6;
     rts[0].n_nexthops      = 1;
     nmtst_platform_ip4_routes_equal_aptr((const NMPObject *const *) routes->pdata,
                                          rts,
@@ -2045,6 +2045,138 @@ test_blackhole(gconstpointer test_data)
 
 /*****************************************************************************/
 
+static void
+test_route_sync_batch(gconstpointer test_data)
+{
+    const int                    TEST_IDX     = GPOINTER_TO_INT(test_data);
+    const int                    addr_family  = (TEST_IDX == 1) ? AF_INET : AF_INET6;
+    const int                    IS_IPv4      = NM_IS_IPv4(addr_family);
+    const guint                  N_ROUTES     = nmtst_test_quick() ? 1100 : 5000;
+    gs_unref_ptrarray GPtrArray *routes       = NULL;
+    gs_unref_ptrarray GPtrArray *routes_half  = NULL;
+    gs_unref_ptrarray GPtrArray *routes_plat  = NULL;
+    gs_unref_ptrarray GPtrArray *routes_fail  = NULL;
+    gs_unref_ptrarray GPtrArray *routes_prune = NULL;
+    guint                        i;
+
+    /* Sync more routes than fit into one batch, to exercise pipelining of the
+     * requests in nm_platform_ip_route_sync(). */
+
+    routes      = g_ptr_array_new_with_free_func((GDestroyNotify) nmp_object_unref);
+    routes_half = g_ptr_array_new_with_free_func((GDestroyNotify) nmp_object_unref);
+
+    for (i = 0; i < N_ROUTES; i++) {
+        NMPlatformIPXRoute rr;
+        NMPObject         *obj;
+
+        if (IS_IPv4) {
+            rr.r4 = (const NMPlatformIP4Route) {
+                .ifindex   = DEVICE_IFINDEX,
+                .rt_source = NM_IP_CONFIG_SOURCE_USER,
+                .network   = htonl(0x0a000000u | (i << 8)),
+                .plen      = 24,
+                .metric    = 100,
+            };
+        } else {
+            rr.r6 = (const NMPlatformIP6Route) {
+                .ifindex   = DEVICE_IFINDEX,
+                .rt_source = NM_IP_CONFIG_SOURCE_USER,
+                .network   = nmtst_inet6_from_string("2001:db8::"),
+                .plen      = 64,
+                .metric    = 100,
+            };
+            rr.r6.network.s6_addr[6] = i >> 8;
+            rr.r6.network.s6_addr[7] = i & 0xFF;
+        }
+
+        nm_platform_ip_route_normalize(addr_family, &rr.rx);
+
+        obj = nmp_object_new(NMP_OBJECT_TYPE_IP_ROUTE(IS_IPv4), &rr);
+        g_ptr_array_add(routes, obj);
+        if (i % 2 == 0)
+            g_ptr_array_add(routes_half, nmp_object_ref(obj));
+    }
+
+    g_assert(nm_platform_ip_route_sync(NM_PLATFORM_GET,
+                                       addr_family,
+                                       DEVICE_IFINDEX,
+                                       routes,
+                                       NULL,
+                                       &routes_fail));
+    g_assert(!routes_fail);
+
+    routes_plat = IS_IPv4 ? nmtstp_ip4_route_get_all(NM_PLATFORM_GET, DEVICE_IFINDEX)
+                          : nmtstp_ip6_route_get_all(NM_PLATFORM_GET, DEVICE_IFINDEX);
+    g_assert_cmpint(nm_g_ptr_array_len(routes_plat), ==, N_ROUTES);
+    nm_clear_pointer(&routes_plat, g_ptr_array_unref);
+
+    routes_prune = nm_platform_ip_route_get_prune_list(NM_PLATFORM_GET,
+                                                       addr_family,
+                                                       DEVICE_IFINDEX,
+                                                       NM_IP_ROUTE_TABLE_SYNC_MODE_MAIN,
+                                                       NULL);
+    g_assert(nm_platform_ip_route_sync(NM_PLATFORM_GET,
+                                       addr_family,
+                                       DEVICE_IFINDEX,
+                                       routes_half,
+                                       routes_prune,
+                                       &routes_fail));
+    g_assert(!routes_fail);
+
+    routes_plat = IS_IPv4 ? nmtstp_ip4_route_get_all(NM_PLATFORM_GET, DEVICE_IFINDEX)
+                          : nmtstp_ip6_route_get_all(NM_PLATFORM_GET, DEVICE_IFINDEX);
+    g_assert_cmpint(nm_g_ptr_array_len(routes_plat), ==, routes_half->len);
+
+    g_assert(nm_platform_ip_route_flush(NM_PLATFORM_GET, addr_family, DEVICE_IFINDEX));
+}
+
+static void
+test_route_sync_replace(void)
+{
+    gs_unref_ptrarray GPtrArray *routes      = NULL;
+    gs_unref_ptrarray GPtrArray *routes_plat = NULL;
+    gs_unref_ptrarray GPtrArray *routes_fail = NULL;
+    NMPlatformIP6Route           rr;
+    guint                        mtu;
+
+    /* The MTU is not part of the ID of an IPv6 route. Changing it replaces
+     * the route with NLM_F_REPLACE instead of deleting and adding it. */
+
+    routes = g_ptr_array_new_with_free_func((GDestroyNotify) nmp_object_unref);
+
+    for (mtu = 1400; mtu >= 1300; mtu -= 100) {
+        rr = (const NMPlatformIP6Route) {
+            .ifindex   = DEVICE_IFINDEX,
+            .rt_source = NM_IP_CONFIG_SOURCE_USER,
+            .network   = nmtst_inet6_from_string("2001:db8:1::"),
+            .plen      = 64,
+            .metric    = 100,
+            .mtu       = mtu,
+        };
+        nm_platform_ip_route_normalize(AF_INET6, NM_PLATFORM_IP_ROUTE_CAST(&rr));
+
+        g_ptr_array_set_size(routes, 0);
+        g_ptr_array_add(routes, nmp_object_new(NMP_OBJECT_TYPE_IP6_ROUTE, &rr));
+
+        g_assert(nm_platform_ip_route_sync(NM_PLATFORM_GET,
+                                           AF_INET6,
+                                           DEVICE_IFINDEX,
+                                           routes,
+                                           NULL,
+                                           &routes_fail));
+        g_assert(!routes_fail);
+
+        nm_clear_pointer(&routes_plat, g_ptr_array_unref);
+        routes_plat = nmtstp_ip6_route_get_all(NM_PLATFORM_GET, DEVICE_IFINDEX);
+        g_assert_cmpint(nm_g_ptr_array_len(routes_plat), ==, 1);
+        g_assert_cmpint(NMP_OBJECT_CAST_IP6_ROUTE(routes_plat->pdata[0])->mtu, ==, mtu);
+    }
+
+    g_assert(nm_platform_ip_route_flush(NM_PLATFORM_GET, AF_INET6, DEVICE_IFINDEX));
+}
+
+/*****************************************************************************/
+
 static gboolean
 _mptcp_has_permissions(void)
 {
@@ -2507,6 +2639,11 @@ _nmtstp_setup_tests(void)
         add_test_func_data("/route/blackhole/1", test_blackhole, GINT_TO_POINTER(1));
         add_test_func_data("/route/blackhole/2", test_blackhole, GINT_TO_POINTER(2));
     }
+    if (nmtstp_is_root_test()) {
+        add_test_func_data("/route/sync_batch/1", test_route_sync_batch, GINT_TO_POINTER(1));
+        add_test_func_data("/route/sync_batch/2", test_route_sync_batch, GINT_TO_POINTER(2));
+        add_test_func("/route/sync_replace", test_route_sync_replace);
+    }
     if (nmtstp_is_root_test()) {
         add_test_func_data("/route/mptcp/1", test_mptcp, GINT_TO_POINTER(1));
         add_test_func_data("/route/mptcp/2", test_mptcp, GINT_TO_POINTER(2));
@@ -74,6 +74,40 @@ test_qdisc1(void)
     g_assert_cmpstr(qdisc->kind, ==, "ingress");
 }
 
+static void
+test_qdisc_sync_unchanged(void)
+{
+    int                          ifindex;
+    gs_unref_ptrarray GPtrArray *known = NULL;
+    gs_unref_ptrarray GPtrArray *plat1 = NULL;
+    gs_unref_ptrarray GPtrArray *plat2 = NULL;
+    guint                        i;
+
+    ifindex = nm_platform_link_get_ifindex(NM_PLATFORM_GET, DEVICE_NAME);
+    g_assert_cmpint(ifindex, >, 0);
+
+    nmtstp_run_command("tc qdisc del dev %s root", DEVICE_NAME);
+    nmtstp_run_command("tc qdisc del dev %s ingress", DEVICE_NAME);
+
+    nmtstp_wait_for_signal(NM_PLATFORM_GET, 0);
+
+    known = g_ptr_array_new_with_free_func((GDestroyNotify) nmp_object_unref);
+    g_ptr_array_add(known, qdisc_new(ifindex, "ingress", TC_H_INGRESS));
+
+    g_assert(nm_platform_tc_sync(NM_PLATFORM_GET, ifindex, known, NULL));
+    plat1 = qdiscs_lookup(ifindex);
+    g_assert(plat1);
+
+    /* Syncing the same configuration again leaves the qdiscs alone, so
+     * the cache still has the very same objects. */
+    g_assert(nm_platform_tc_sync(NM_PLATFORM_GET, ifindex, known, NULL));
+    plat2 = qdiscs_lookup(ifindex);
+    g_assert(plat2);
+    g_assert_cmpint(plat1->len, ==, plat2->len);
+    for (i = 0; i < plat1->len; i++)
+        g_assert(plat1->pdata[i] == plat2->pdata[i]);
+}
+
 static void
 test_qdisc_fq_codel(void)
 {
@@ -215,6 +249,7 @@ void
 _nmtstp_setup_tests(void)
 {
     nmtstp_env1_add_test_func("/link/qdisc/1", test_qdisc1, 1, TRUE);
+    nmtstp_env1_add_test_func("/link/qdisc/sync-unchanged", test_qdisc_sync_unchanged, 1, TRUE);
     nmtstp_env1_add_test_func("/link/qdisc/fq_codel", test_qdisc_fq_codel, 1, TRUE);
     nmtstp_env1_add_test_func("/link/qdisc/sfq", test_qdisc_sfq, 1, TRUE);
     nmtstp_env1_add_test_func("/link/qdisc/tbf", test_qdisc_tbf, 1, TRUE);
@@ -34,8 +34,10 @@
 #include "nm-act-request.h"
 #include "nm-l3-config-data.h"
 #include "nm-dbus-object.h"
+#include "nm-config.h"
 
 #include "nm-pppd-plugin.h"
+#include "nm-pppoe-discovery.h"
 #include "nm-ppp-plugin-api.h"
 #include "nm-ppp-status.h"
 
@@ -107,6 +109,11 @@ typedef struct {
     guint ppp_watch_id;
     guint ppp_timeout_handler;
 
+    /* With in-daemon PPPoE discovery, the pppd command line waits here
+     * until the discovery found the session. */
+    NMPppoeDiscoveryHandle *pppoe_discovery;
+    GPtrArray              *pppoe_cmd;
+
     /* Monitoring */
     int   monitor_fd;
     guint monitor_id;
@@ -989,6 +996,85 @@ pppoe_fill_defaults(NMSettingPpp *setting)
 #endif
 }
 
+static gboolean
+_ppp_spawn(NMPPPManager *self, GPtrArray *ppp_cmd, GError **error)
+{
+    NMPPPManagerPrivate *priv    = NM_PPP_MANAGER_GET_PRIVATE(self);
+    gs_free char        *cmd_str = NULL;
+
+    _LOGD("command line: %s", (cmd_str = g_strjoinv(" ", (char **) ppp_cmd->pdata)));
+
+    priv->pid = 0;
+    if (!g_spawn_async(NULL,
+                       (char **) ppp_cmd->pdata,
+                       NULL,
+                       G_SPAWN_DO_NOT_REAP_CHILD,
+                       nm_utils_setpgid,
+                       NULL,
+                       &priv->pid,
+                       error))
+        return FALSE;
+
+    nm_assert(priv->pid > 0);
+
+    _LOGI("pppd started with pid %lld", (long long) priv->pid);
+
+    priv->ppp_watch_id = g_child_watch_add(priv->pid, (GChildWatchFunc) ppp_watch_cb, self);
+    return TRUE;
+}
+
+static void
+_pppoe_discovery_cb(NMPppoeDiscoveryHandle *handle,
+                    guint16                 session_id,
+                    const NMEtherAddr      *ac_mac,
+                    GError                 *error,
+                    gpointer                user_data)
+{
+    NMPPPManager                *self        = user_data;
+    NMPPPManagerPrivate         *priv        = NM_PPP_MANAGER_GET_PRIVATE(self);
+    gs_unref_ptrarray GPtrArray *ppp_cmd     = g_steal_pointer(&priv->pppoe_cmd);
+    gs_free_error GError        *spawn_error = NULL;
+
+    nm_assert(priv->pppoe_discovery == handle);
+    priv->pppoe_discovery = NULL;
+
+    if (!error) {
+        _LOGD("PPPoE session %u with " NM_ETHER_ADDR_FORMAT_STR,
+              session_id,
+              NM_ETHER_ADDR_FORMAT_VAL(ac_mac));
+
+        /* Hand the session to pppd, which then only does LCP and the NCPs.
+         * Replace the trailing NULL of the command line. */
+        g_ptr_array_set_size(ppp_cmd, ppp_cmd->len - 1);
+        nm_strv_ptrarray_add_string_dup(ppp_cmd, "rp_pppoe_sess");
+        nm_strv_ptrarray_add_string_printf(ppp_cmd,
+                                           "%u:" NM_ETHER_ADDR_FORMAT_STR,
+                                           session_id,
+                                           NM_ETHER_ADDR_FORMAT_VAL(ac_mac));
+        g_ptr_array_add(ppp_cmd, NULL);
+
+        if (_ppp_spawn(self, ppp_cmd, &spawn_error))
+            return;
+        error = spawn_error;
+    }
+
+    _LOGW("PPPoE discovery failed: %s", error->message);
+    _ppp_manager_stop(self, NULL, NULL, NULL);
+    g_signal_emit(self, signals[STATE_CHANGED], 0, (guint) NM_PPP_STATUS_INTERN_DEAD);
+}
+
+static gboolean
+_pppoe_discovery_enabled(void)
+{
+    gs_free char *value = NULL;
+
+    value = nm_config_data_get_value(NM_CONFIG_GET_DATA,
+                                     NM_CONFIG_KEYFILE_GROUP_MAIN,
+                                     NM_CONFIG_KEYFILE_KEY_MAIN_PPPOE_DISCOVERY,
+                                     NM_CONFIG_GET_VALUE_STRIP | NM_CONFIG_GET_VALUE_NO_EMPTY);
+    return nm_streq0(value, "internal");
+}
+
 static gboolean
 _ppp_manager_start(NMPPPManager *self,
                    NMActRequest *req,
@@ -1004,7 +1090,6 @@ _ppp_manager_start(NMPPPManager *self,
     NMSettingPppoe               *pppoe_setting;
     NMSettingAdsl                *adsl_setting;
     gs_unref_ptrarray GPtrArray  *ppp_cmd = NULL;
-    gs_free char                 *cmd_str = NULL;
     struct stat                   st;
     gboolean                      ip6_enabled;
     gboolean                      ip4_enabled;
@@ -1068,24 +1153,34 @@ _ppp_manager_start(NMPPPManager *self,
 
     _LOGI("starting PPP connection");
 
-    _LOGD("command line: %s", (cmd_str = g_strjoinv(" ", (char **) ppp_cmd->pdata)));
-
-    priv->pid = 0;
-    if (!g_spawn_async(NULL,
-                       (char **) ppp_cmd->pdata,
-                       NULL,
-                       G_SPAWN_DO_NOT_REAP_CHILD,
-                       nm_utils_setpgid,
-                       NULL,
-                       &priv->pid,
-                       err))
-        goto fail;
+    if (pppoe_setting && _pppoe_discovery_enabled()) {
+        int ifindex;
 
-    nm_assert(priv->pid > 0);
+        /* Do the PPPoE discovery ourselves and spawn pppd only for the
+         * session. The discovery of all PPPoE connections on an interface
+         * shares one socket. */
+        ifindex = nm_platform_link_get_ifindex(NM_PLATFORM_GET, priv->parent_iface);
+        if (ifindex <= 0) {
+            g_set_error(err,
+                        NM_MANAGER_ERROR,
+                        NM_MANAGER_ERROR_FAILED,
+                        "interface %s not found",
+                        priv->parent_iface);
+            goto fail;
+        }
 
-    _LOGI("pppd started with pid %lld", (long long) priv->pid);
+        priv->pppoe_discovery =
+            nm_pppoe_discovery_start(ifindex,
+                                     nm_setting_pppoe_get_service(pppoe_setting),
+                                     _pppoe_discovery_cb,
+                                     self,
+                                     err);
+        if (!priv->pppoe_discovery)
+            goto fail;
+        priv->pppoe_cmd = g_steal_pointer(&ppp_cmd);
+    } else if (!_ppp_spawn(self, ppp_cmd, err))
+        goto fail;
 
-    priv->ppp_watch_id = g_child_watch_add(priv->pid, (GChildWatchFunc) ppp_watch_cb, self);
     if (timeout_secs > 0)
         priv->ppp_timeout_handler = g_timeout_add_seconds(timeout_secs, pppd_timed_out, self);
     priv->act_req = g_object_ref(req);
@@ -1118,6 +1213,9 @@ _ppp_cleanup(NMPPPManager *self)
 
     nm_clear_g_source(&priv->ppp_timeout_handler);
     nm_clear_g_source(&priv->ppp_watch_id);
+
+    nm_clear_pointer(&priv->pppoe_discovery, nm_pppoe_discovery_cancel);
+    nm_clear_pointer(&priv->pppoe_cmd, g_ptr_array_unref);
 }
 
 /*****************************************************************************/
@@ -0,0 +1,558 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+#include "src/core/nm-default-daemon.h"
+
+#include "nm-pppoe-discovery.h"
+
+#include <linux/if_ether.h>
+#include <linux/if_packet.h>
+#include <sys/socket.h>
+
+#include "libnm-glib-aux/nm-c-list.h"
+#include "libnm-glib-aux/nm-random-utils.h"
+
+/*****************************************************************************/
+
+/* The PPPoE discovery stage (RFC 2516, section 5). We only do the client side:
+ * broadcast a PADI, take the first acceptable PADO, send a PADR to that access
+ * concentrator and wait for the PADS with the session ID. pppd then attaches
+ * to the session with "rp_pppoe_sess".
+ *
+ * All discoveries on the same interface share one packet socket. The replies
+ * are dispatched to the discoveries by their Host-Uniq tag. */
+
+#define PPPOE_VER_TYPE 0x11
+
+#define PPPOE_CODE_PADO 0x07
+#define PPPOE_CODE_PADI 0x09
+#define PPPOE_CODE_PADR 0x19
+#define PPPOE_CODE_PADS 0x65
+
+#define PPPOE_TAG_END_OF_LIST        0x0000
+#define PPPOE_TAG_SERVICE_NAME       0x0101
+#define PPPOE_TAG_HOST_UNIQ          0x0103
+#define PPPOE_TAG_AC_COOKIE          0x0104
+#define PPPOE_TAG_RELAY_SESSION_ID   0x0110
+#define PPPOE_TAG_SERVICE_NAME_ERROR 0x0201
+#define PPPOE_TAG_AC_SYSTEM_ERROR    0x0202
+#define PPPOE_TAG_GENERIC_ERROR      0x0203
+
+#define PPPOE_HEADER_LEN     6
+#define PPPOE_TAG_HEADER_LEN 4
+#define PPPOE_SERVICE_MAX    255
+
+/* Like pppd, resend PADI and PADR with exponential backoff. */
+#define RESEND_TIMEOUT_MSEC 1000u
+#define RESEND_TRIES        4u
+
+/*****************************************************************************/
+
+#define _NMLOG_DOMAIN      LOGD_PPP
+#define _NMLOG(level, ...) __NMLOG_DEFAULT(level, _NMLOG_DOMAIN, "pppoe-discovery", __VA_ARGS__)
+
+/*****************************************************************************/
+
+typedef struct {
+    CList    sockets_lst;
+    CList    handles_lst_head;
+    GSource *source;
+    int      ifindex;
+    int      fd;
+    bool     in_dispatch : 1;
+} DiscoverySocket;
+
+struct _NMPppoeDiscoveryHandle {
+    CList                    handles_lst;
+    DiscoverySocket         *dsock;
+    NMPppoeDiscoveryCallback callback;
+    gpointer                 user_data;
+    char                    *service;
+    GBytes                  *ac_cookie;
+    GBytes                  *relay_session_id;
+    GSource                 *resend_source;
+    guint32                  host_uniq;
+    NMEtherAddr              ac_mac;
+    guint                    tries;
+
+    /* The code of the request we sent last and wait a reply for, PADI or PADR. */
+    guint8 code;
+};
+
+static CList sockets_lst_head = C_LIST_INIT(sockets_lst_head);
+
+/*****************************************************************************/
+
+typedef struct {
+    guint8 buf[ETH_DATA_LEN];
+    gsize  len;
+} Packet;
+
+static gboolean
+_packet_add_tag(Packet *packet, guint16 type, gconstpointer data, gsize data_len)
+{
+    guint16 v16;
+
+    if (packet->len + PPPOE_TAG_HEADER_LEN + data_len > sizeof(packet->buf))
+        return FALSE;
+
+    v16 = htons(type);
+    memcpy(&packet->buf[packet->len], &v16, 2);
+    v16 = htons(data_len);
+    memcpy(&packet->buf[packet->len + 2], &v16, 2);
+    if (data_len > 0)
+        memcpy(&packet->buf[packet->len + PPPOE_TAG_HEADER_LEN], data, data_len);
+    packet->len += PPPOE_TAG_HEADER_LEN + data_len;
+    return TRUE;
+}
+
+static gboolean
+_packet_add_tag_bytes(Packet *packet, guint16 type, GBytes *bytes)
+{
+    gconstpointer data;
+    gsize         len;
+
+    if (!bytes)
+        return TRUE;
+
+    data = g_bytes_get_data(bytes, &len);
+    return _packet_add_tag(packet, type, data, len);
+}
+
+static gboolean
+_send_request(NMPppoeDiscoveryHandle *handle)
+{
+    Packet             packet;
+    struct sockaddr_ll sll;
+    const char        *service = handle->service ?: "";
+    guint16            v16;
+
+    packet.buf[0] = PPPOE_VER_TYPE;
+    packet.buf[1] = handle->code;
+    packet.buf[2] = 0;
+    packet.buf[3] = 0;
+    packet.len    = PPPOE_HEADER_LEN;
+
+    if (!_packet_add_tag(&packet, PPPOE_TAG_SERVICE_NAME, service, strlen(service))
+        || !_packet_add_tag(&packet,
+                            PPPOE_TAG_HOST_UNIQ,
+                            &handle->host_uniq,
+                            sizeof(handle->host_uniq)))
+        return FALSE;
+
+    if (handle->code == PPPOE_CODE_PADR) {
+        if (!_packet_add_tag_bytes(&packet, PPPOE_TAG_AC_COOKIE, handle->ac_cookie)
+            || !_packet_add_tag_bytes(&packet,
+                                      PPPOE_TAG_RELAY_SESSION_ID,
+                                      handle->relay_session_id))
+            return FALSE;
+    }
+
+    v16 = htons(packet.len - PPPOE_HEADER_LEN);
+    memcpy(&packet.buf[4], &v16, 2);
+
+    sll = (struct sockaddr_ll) {
+        .sll_family   = AF_PACKET,
+        .sll_protocol = htons(ETH_P_PPP_DISC),
+        .sll_ifindex  = handle->dsock->ifindex,
+        .sll_halen    = ETH_ALEN,
+    };
+    if (handle->code == PPPOE_CODE_PADI)
+        memset(sll.sll_addr, 0xFF, ETH_ALEN);
+    else
+        memcpy(sll.sll_addr, &handle->ac_mac, ETH_ALEN);
+
+    if (sendto(handle->dsock->fd, packet.buf, packet.len, 0, (struct sockaddr *) &sll, sizeof(sll))
+        < 0) {
+        _LOGD("[%08x] failed to send %s: %s",
+              handle->host_uniq,
+              handle->code == PPPOE_CODE_PADI ? "PADI" : "PADR",
+              nm_strerror_native(errno));
+        /* The resend timer tries again. */
+    }
+
+    return TRUE;
+}
+
+/*****************************************************************************/
+
+static void _dsock_unref(DiscoverySocket *dsock);
+
+static void
+_handle_free(NMPppoeDiscoveryHandle *handle)
+{
+    c_list_unlink(&handle->handles_lst);
+    _dsock_unref(handle->dsock);
+    nm_clear_g_source_inst(&handle->resend_source);
+    nm_clear_pointer(&handle->ac_cookie, g_bytes_unref);
+    nm_clear_pointer(&handle->relay_session_id, g_bytes_unref);
+    g_free(handle->service);
+    nm_g_slice_free(handle);
+}
+
+static void
+_handle_complete(NMPppoeDiscoveryHandle *handle, guint16 session_id, GError *error)
+{
+    /* Unlink first, so that the handle no longer receives packets. */
+    c_list_unlink(&handle->handles_lst);
+    nm_clear_g_source_inst(&handle->resend_source);
+
+    handle->callback(handle,
+                     session_id,
+                     error ? NULL : &handle->ac_mac,
+                     error,
+                     handle->user_data);
+    _handle_free(handle);
+}
+
+static gboolean _resend_timeout_cb(gpointer user_data);
+
+static void
+_request_start(NMPppoeDiscoveryHandle *handle, guint8 code)
+{
+    handle->code  = code;
+    handle->tries = 0;
+    nm_clear_g_source_inst(&handle->resend_source);
+    _resend_timeout_cb(handle);
+}
+
+static gboolean
+_resend_timeout_cb(gpointer user_data)
+{
+    NMPppoeDiscoveryHandle *handle = user_data;
+    gs_free_error GError   *error  = NULL;
+
+    nm_clear_g_source_inst(&handle->resend_source);
+
+    if (handle->tries >= RESEND_TRIES) {
+        nm_utils_error_set(&error,
+                           NM_UTILS_ERROR_UNKNOWN,
+                           "timeout waiting for %s",
+                           handle->code == PPPOE_CODE_PADI ? "PADO" : "PADS");
+        _handle_complete(handle, 0, error);
+        return G_SOURCE_CONTINUE;
+    }
+
+    if (!_send_request(handle)) {
+        nm_utils_error_set_literal(&error, NM_UTILS_ERROR_UNKNOWN, "request too large");
+        _handle_complete(handle, 0, error);
+        return G_SOURCE_CONTINUE;
+    }
+
+    handle->resend_source =
+        nm_g_timeout_add_source(RESEND_TIMEOUT_MSEC << handle->tries, _resend_timeout_cb, handle);
+    handle->tries++;
+    return G_SOURCE_CONTINUE;
+}
+
+/*****************************************************************************/
+
+typedef struct {
+    const guint8 *host_uniq;
+    const guint8 *service;
+    const guint8 *ac_cookie;
+    const guint8 *relay_session_id;
+    const char   *error_tag;
+    guint16       host_uniq_len;
+    guint16       service_len;
+    guint16       ac_cookie_len;
+    guint16       relay_session_id_len;
+} ParsedTags;
+
+static gboolean
+_parse_tags(const guint8 *data, gsize len, ParsedTags *tags)
+{
+    *tags = (ParsedTags) {};
+
+    while (len >= PPPOE_TAG_HEADER_LEN) {
+        guint16 type;
+        guint16 tag_len;
+
+        memcpy(&type, &data[0], 2);
+        memcpy(&tag_len, &data[2], 2);
+        type    = ntohs(type);
+        tag_len = ntohs(tag_len);
+
+        if (type == PPPOE_TAG_END_OF_LIST)
+            break;
+        if (PPPOE_TAG_HEADER_LEN + (gsize) tag_len > len)
+            return FALSE;
+
+        switch (type) {
+        case PPPOE_TAG_SERVICE_NAME:
+            tags->service     = &data[PPPOE_TAG_HEADER_LEN];
+            tags->service_len = tag_len;
+            break;
+        case PPPOE_TAG_HOST_UNIQ:
+            tags->host_uniq     = &data[PPPOE_TAG_HEADER_LEN];
+            tags->host_uniq_len = tag_len;
+            break;
+        case PPPOE_TAG_AC_COOKIE:
+            tags->ac_cookie     = &data[PPPOE_TAG_HEADER_LEN];
+            tags->ac_cookie_len = tag_len;
+            break;
+        case PPPOE_TAG_RELAY_SESSION_ID:
+            tags->relay_session_id     = &data[PPPOE_TAG_HEADER_LEN];
+            tags->relay_session_id_len = tag_len;
+            break;
+        case PPPOE_TAG_SERVICE_NAME_ERROR:
+            tags->error_tag = "Service-Name-Error";
+            break;
+        case PPPOE_TAG_AC_SYSTEM_ERROR:
+            tags->error_tag = "AC-System-Error";
+            break;
+        case PPPOE_TAG_GENERIC_ERROR:
+            tags->error_tag = "Generic-Error";
+            break;
+        }
+
+        data += PPPOE_TAG_HEADER_LEN + tag_len;
+        len -= PPPOE_TAG_HEADER_LEN + tag_len;
+    }
+
+    return TRUE;
+}
+
+static void
+_handle_packet(NMPppoeDiscoveryHandle *handle,
+               guint8                  code,
+               guint16                 session_id,
+               const NMEtherAddr      *src,
+               const ParsedTags       *tags)
+{
+    if (code == PPPOE_CODE_PADO && handle->code == PPPOE_CODE_PADI) {
+        if (tags->error_tag) {
+            _LOGD("[%08x] ignore PADO with %s", handle->host_uniq, tags->error_tag);
+            return;
+        }
+        if (handle->service
+            && (!tags->service || tags->service_len != strlen(handle->service)
+                || memcmp(tags->service, handle->service, tags->service_len) != 0)) {
+            _LOGD("[%08x] ignore PADO without the requested service", handle->host_uniq);
+            return;
+        }
+
+        handle->ac_mac = *src;
+        nm_clear_pointer(&handle->ac_cookie, g_bytes_unref);
+        nm_clear_pointer(&handle->relay_session_id, g_bytes_unref);
+        if (tags->ac_cookie)
+            handle->ac_cookie = g_bytes_new(tags->ac_cookie, tags->ac_cookie_len);
+        if (tags->relay_session_id)
+            handle->relay_session_id =
+                g_bytes_new(tags->relay_session_id, tags->relay_session_id_len);
+
+        _LOGD("[%08x] PADO from " NM_ETHER_ADDR_FORMAT_STR,
+              handle->host_uniq,
+              NM_ETHER_ADDR_FORMAT_VAL(src));
+        _request_start(handle, PPPOE_CODE_PADR);
+        return;
+    }
+
+    if (code == PPPOE_CODE_PADS && handle->code == PPPOE_CODE_PADR) {
+        gs_free_error GError *error = NULL;
+
+        if (!nm_ether_addr_equal(src, &handle->ac_mac))
+            return;
+
+        if (tags->error_tag)
+            nm_utils_error_set(&error, NM_UTILS_ERROR_UNKNOWN, "PADS with %s", tags->error_tag);
+        else if (session_id == 0)
+            nm_utils_error_set_literal(&error, NM_UTILS_ERROR_UNKNOWN, "PADS without session ID");
+
+        if (!error)
+            _LOGD("[%08x] PADS with session %u", handle->host_uniq, session_id);
+        _handle_complete(handle, session_id, error);
+    }
+}
+
+static gboolean
+_dsock_receive_cb(int fd, GIOCondition condition, gpointer user_data)
+{
+    DiscoverySocket *dsock = user_data;
+    guint            n_packets;
+
+    /* The callbacks of completed discoveries may drop the last user of the
+     * socket. Keep it alive until we are done. */
+    dsock->in_dispatch = TRUE;
+
+    /* Bound the number of packets per dispatch, so that a flood of discovery
+     * traffic on a busy segment doesn't starve the main loop. */
+    for (n_packets = 0; n_packets < 100; n_packets++) {
+        NMPppoeDiscoveryHandle *handle;
+        guint8                  buf[ETH_DATA_LEN];
+        struct sockaddr_ll      sll;
+        socklen_t               sll_len = sizeof(sll);
+        ParsedTags              tags;
+        ssize_t                 n;
+        guint16                 session_id;
+        guint16                 payload_len;
+        guint32                 host_uniq;
+
+        if (c_list_is_empty(&dsock->handles_lst_head))
+            break;
+
+        n = recvfrom(fd, buf, sizeof(buf), 0, (struct sockaddr *) &sll, &sll_len);
+        if (n < 0) {
+            if (NM_IN_SET(errno, EAGAIN, EINTR))
+                break;
+            _LOGD("failed to receive on ifindex %d: %s",
+                  dsock->ifindex,
+                  nm_strerror_native(errno));
+            break;
+        }
+
+        if (n < PPPOE_HEADER_LEN || buf[0] != PPPOE_VER_TYPE || sll.sll_halen != ETH_ALEN
+            || sll.sll_pkttype != PACKET_HOST)
+            continue;
+
+        memcpy(&session_id, &buf[2], 2);
+        memcpy(&payload_len, &buf[4], 2);
+        session_id  = ntohs(session_id);
+        payload_len = ntohs(payload_len);
+        if (PPPOE_HEADER_LEN + (gsize) payload_len > (gsize) n)
+            continue;
+
+        if (!_parse_tags(&buf[PPPOE_HEADER_LEN], payload_len, &tags))
+            continue;
+        if (!tags.host_uniq || tags.host_uniq_len != sizeof(host_uniq))
+            continue;
+        memcpy(&host_uniq, tags.host_uniq, sizeof(host_uniq));
+
+        c_list_for_each_entry (handle, &dsock->handles_lst_head, handles_lst) {
+            if (handle->host_uniq == host_uniq) {
+                _handle_packet(handle,
+                               buf[1],
+                               session_id,
+                               (const NMEtherAddr *) sll.sll_addr,
+                               &tags);
+                break;
+            }
+        }
+    }
+
+    dsock->in_dispatch = FALSE;
+    _dsock_unref(dsock);
+    return G_SOURCE_CONTINUE;
+}
+
+/*****************************************************************************/
+
+static DiscoverySocket *
+_dsock_get(int ifindex, GError **error)
+{
+    DiscoverySocket   *dsock;
+    struct sockaddr_ll sll;
+    nm_auto_close int  fd = -1;
+
+    c_list_for_each_entry (dsock, &sockets_lst_head, sockets_lst) {
+        if (dsock->ifindex == ifindex)
+            return dsock;
+    }
+
+    fd = socket(AF_PACKET, SOCK_DGRAM | SOCK_CLOEXEC | SOCK_NONBLOCK, htons(ETH_P_PPP_DISC));
+    if (fd < 0) {
+        nm_utils_error_set_errno(error, errno, "failed to create packet socket: %s");
+        return NULL;
+    }
+
+    sll = (struct sockaddr_ll) {
+        .sll_family   = AF_PACKET,
+        .sll_protocol = htons(ETH_P_PPP_DISC),
+        .sll_ifindex  = ifindex,
+    };
+    if (bind(fd, (struct sockaddr *) &sll, sizeof(sll)) < 0) {
+        nm_utils_error_set_errno(error, errno, "failed to bind packet socket: %s");
+        return NULL;
+    }
+
+    dsock  = g_slice_new(DiscoverySocket);
+    *dsock = (DiscoverySocket) {
+        .ifindex          = ifindex,
+        .fd               = nm_steal_fd(&fd),
+        .handles_lst_head = C_LIST_INIT(dsock->handles_lst_head),
+    };
+    dsock->source = nm_g_unix_fd_add_source(dsock->fd, G_IO_IN, _dsock_receive_cb, dsock);
+    c_list_link_tail(&sockets_lst_head, &dsock->sockets_lst);
+    return dsock;
+}
+
+static void
+_dsock_unref(DiscoverySocket *dsock)
+{
+    if (dsock->in_dispatch || !c_list_is_empty(&dsock->handles_lst_head))
+        return;
+
+    c_list_unlink_stale(&dsock->sockets_lst);
+    nm_clear_g_source_inst(&dsock->source);
+    nm_close(dsock->fd);
+    nm_g_slice_free(dsock);
+}
+
+/*****************************************************************************/
+
+/**
+ * nm_pppoe_discovery_start:
+ * @ifindex: the Ethernet interface to discover the access concentrator on
+ * @service: (nullable): the requested service name, or %NULL for any
+ * @callback: called once with the result
+ * @user_data: the user data for @callback
+ * @error: return location for an error
+ *
+ * Starts the PPPoE discovery stage on @ifindex.
+ *
+ * Returns: the handle to cancel the discovery with nm_pppoe_discovery_cancel(),
+ *   or %NULL if the discovery could not be started.
+ */
+NMPppoeDiscoveryHandle *
+nm_pppoe_discovery_start(int                      ifindex,
+                         const char              *service,
+                         NMPppoeDiscoveryCallback callback,
+                         gpointer                 user_data,
+                         GError                 **error)
+{
+    static guint32          host_uniq_counter;
+    NMPppoeDiscoveryHandle *handle;
+    DiscoverySocket        *dsock;
+
+    g_return_val_if_fail(ifindex > 0, NULL);
+    g_return_val_if_fail(callback, NULL);
+
+    if (service && strlen(service) > PPPOE_SERVICE_MAX) {
+        nm_utils_error_set_literal(error, NM_UTILS_ERROR_UNKNOWN, "service name too long");
+        return NULL;
+    }
+
+    dsock = _dsock_get(ifindex, error);
+    if (!dsock)
+        return NULL;
+
+    if (host_uniq_counter == 0)
+        host_uniq_counter = nm_random_u64_range(1, G_MAXUINT32);
+
+    handle  = g_slice_new(NMPppoeDiscoveryHandle);
+    *handle = (NMPppoeDiscoveryHandle) {
+        .dsock     = dsock,
+        .callback  = callback,
+        .user_data = user_data,
+        .service   = g_strdup(nm_str_not_empty(service)),
+        .host_uniq = ++host_uniq_counter,
+    };
+    c_list_link_tail(&dsock->handles_lst_head, &handle->handles_lst);
+
+    _LOGD("[%08x] start discovery on ifindex %d", handle->host_uniq, ifindex);
+    _request_start(handle, PPPOE_CODE_PADI);
+    return handle;
+}
+
+/**
+ * nm_pppoe_discovery_cancel:
+ * @handle: the handle of a discovery that didn't complete yet
+ *
+ * Aborts the discovery without invoking the callback.
+ */
+void
+nm_pppoe_discovery_cancel(NMPppoeDiscoveryHandle *handle)
+{
+    g_return_if_fail(handle);
+
+    _handle_free(handle);
+}
@@ -0,0 +1,25 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+#ifndef __NM_PPPOE_DISCOVERY_H__
+#define __NM_PPPOE_DISCOVERY_H__
+
+typedef struct _NMPppoeDiscoveryHandle NMPppoeDiscoveryHandle;
+
+/* Called once when the discovery completes. On success, @error is %NULL and
+ * @session_id and @ac_mac identify the session. The handle is destroyed
+ * after the callback returns and must not be cancelled anymore. */
+typedef void (*NMPppoeDiscoveryCallback)(NMPppoeDiscoveryHandle *handle,
+                                         guint16                 session_id,
+                                         const NMEtherAddr      *ac_mac,
+                                         GError                 *error,
+                                         gpointer                user_data);
+
+NMPppoeDiscoveryHandle *nm_pppoe_discovery_start(int                      ifindex,
+                                                 const char              *service,
+                                                 NMPppoeDiscoveryCallback callback,
+                                                 gpointer                 user_data,
+                                                 GError                 **error);
+
+void nm_pppoe_discovery_cancel(NMPppoeDiscoveryHandle *handle);
+
+#endif /* __NM_PPPOE_DISCOVERY_H__ */
@@ -135,6 +135,8 @@ static void _con_save_request_start(Request *req);
 static void _con_del_request_start(Request *req);
 
 static gboolean _con_get_try_complete_early(Request *req);
+static gboolean _con_get_try_fan_out(Request *req);
+static void     _con_get_child_new(Request *req, NMSecretAgent *agent);
 
 static void agent_disconnected_cb(NMSecretAgent *agent, gpointer user_data);
 
@@ -216,6 +218,14 @@ struct _NMAgentManagerCallId {
 
                     NMAgentSecretsResultFunc callback;
                     gpointer                 callback_data;
+
+                    /* A request that doesn't allow interaction asks all agents
+                     * at once. It does so via one child request per agent, and
+                     * completes with the first secrets that any of them returns. */
+                    Request *parent;
+                    GSList  *children;
+                    bool     fanned_out : 1;
+                    bool     user_canceled : 1;
                 } get;
             };
         } con;
@@ -580,6 +590,14 @@ request_free(Request *req)
         g_free(req->con.path);
         nm_clear_pointer(&req->con.chain, nm_auth_chain_destroy);
         if (req->request_type == REQUEST_TYPE_CON_GET) {
+            while (req->con.get.children) {
+                Request *child = req->con.get.children->data;
+
+                req->con.get.children =
+                    g_slist_delete_link(req->con.get.children, req->con.get.children);
+                c_list_unlink(&child->request_lst);
+                req_complete_cancel(child, FALSE);
+            }
             g_free(req->con.get.setting_name);
             g_strfreev(req->con.get.hints);
             if (req->con.get.existing_secrets)
@@ -740,6 +758,10 @@ request_add_agent(Request *req, NMSecretAgent *agent)
     if (req->request_type == REQUEST_TYPE_CON_GET) {
         NMAuthSubject *subject = nm_secret_agent_get_subject(agent);
 
+        /* A child request only asks the agent it was created for. */
+        if (req->con.get.parent)
+            return;
+
         /* Ensure the caller's username exists in the connection's permissions,
          * or that the permissions is empty (ie, visible by everyone).
          */
@@ -771,6 +793,12 @@ request_add_agent(Request *req, NMSecretAgent *agent)
 
     _LOGD(agent, "agent allowed for secrets request " LOG_REQ_FMT, LOG_REQ_ARG(req));
 
+    if (req->request_type == REQUEST_TYPE_CON_GET && req->con.get.fanned_out) {
+        /* The other agents are already being asked. Ask this one too. */
+        _con_get_child_new(req, g_object_ref(agent));
+        return;
+    }
+
     /* Add this agent to the list, sorted appropriately */
     req->pending =
         g_slist_insert_sorted_with_data(req->pending, g_object_ref(agent), agent_compare_func, req);
@@ -878,8 +906,12 @@ request_start(gpointer user_data)
 
     switch (req->request_type) {
     case REQUEST_TYPE_CON_GET:
+        if (req->con.get.parent)
+            break;
         if (_con_get_try_complete_early(req))
             goto out;
+        if (_con_get_try_fan_out(req))
+            goto out;
         break;
     default:
         break;
@@ -1208,6 +1240,127 @@ _con_get_try_complete_early(Request *req)
     return FALSE;
 }
 
+static void
+_con_get_child_done(NMAgentManager              *self,
+                    NMAgentManagerCallId         call_id,
+                    const char                  *agent_dbus_owner,
+                    const char                  *agent_username,
+                    gboolean                     agent_has_modify,
+                    const char                  *setting_name,
+                    NMSecretAgentGetSecretsFlags flags,
+                    GVariant                    *secrets,
+                    GError                      *error,
+                    gpointer                     user_data)
+{
+    Request *req   = user_data;
+    Request *child = call_id;
+
+    nm_assert(child->con.get.parent == req);
+
+    req->con.get.children = g_slist_remove(req->con.get.children, child);
+
+    /* Only the parent cancels its children, and it no longer cares. */
+    if (nm_utils_error_is_cancelled(error))
+        return;
+
+    if (error) {
+        gs_free_error GError *local = NULL;
+
+        if (g_error_matches(error, NM_AGENT_MANAGER_ERROR, NM_AGENT_MANAGER_ERROR_USER_CANCELED))
+            req->con.get.user_canceled = TRUE;
+
+        if (req->con.get.children)
+            return;
+
+        /* All agents failed. */
+        if (req->con.get.user_canceled) {
+            local = g_error_new_literal(NM_AGENT_MANAGER_ERROR,
+                                        NM_AGENT_MANAGER_ERROR_USER_CANCELED,
+                                        "User canceled the secrets request.");
+        } else {
+            local = g_error_new_literal(NM_AGENT_MANAGER_ERROR,
+                                        NM_AGENT_MANAGER_ERROR_NO_SECRETS,
+                                        "No agents were available for this request.");
+        }
+        req_complete_error(req, local);
+        return;
+    }
+
+    /* The first agent that returns secrets wins. Completing @req cancels the
+     * requests to the other agents. */
+    req->con.current_has_modify = agent_has_modify;
+    req_complete(req, secrets, agent_dbus_owner, agent_username, NULL);
+}
+
+static void
+_con_get_child_new(Request *req, NMSecretAgent *agent)
+{
+    NMAgentManager *self = req->self;
+    Request        *child;
+
+    nm_assert(req->con.get.fanned_out);
+
+    child = request_new(self, REQUEST_TYPE_CON_GET, req->detail, req->subject);
+
+    child->con.path       = g_strdup(req->con.path);
+    child->con.connection = g_object_ref(req->con.connection);
+    if (req->con.get.existing_secrets)
+        child->con.get.existing_secrets = g_variant_ref(req->con.get.existing_secrets);
+    child->con.get.setting_name  = g_strdup(req->con.get.setting_name);
+    child->con.get.hints         = g_strdupv(req->con.get.hints);
+    child->con.get.flags         = req->con.get.flags;
+    child->con.get.callback      = _con_get_child_done;
+    child->con.get.callback_data = req;
+    child->con.get.parent        = req;
+
+    /* takes ownership of @agent. */
+    child->pending = g_slist_prepend(NULL, agent);
+
+    req->con.get.children = g_slist_prepend(req->con.get.children, child);
+
+    _LOGD(agent,
+          "agent asked for secrets request " LOG_REQ_FMT " via " LOG_REQ_FMT,
+          LOG_REQ_ARG(req),
+          LOG_REQ_ARG(child));
+
+    child->idle_id = g_idle_add(request_start, child);
+}
+
+static gboolean
+_con_get_try_fan_out(Request *req)
+{
+    NMAgentManager *self = req->self;
+    GSList         *pending;
+    GSList         *iter;
+
+    /* Asking the agents one after the other means that a slow or hanging agent
+     * delays the request until it times out. Without interaction, there is no
+     * reason for that order: agents just look up their stored secrets. So ask
+     * all agents at once.
+     *
+     * With interaction, each agent might prompt the user. Then we keep asking
+     * one agent after the other. */
+    if (NM_FLAGS_HAS(req->con.get.flags, NM_SECRET_AGENT_GET_SECRETS_FLAG_ALLOW_INTERACTION))
+        return FALSE;
+
+    if (!req->pending || !req->pending->next)
+        return FALSE;
+
+    _LOGD(NULL,
+          "(" LOG_REQ_FMT ") asking %u agents at once",
+          LOG_REQ_ARG(req),
+          g_slist_length(req->pending));
+
+    req->con.get.fanned_out = TRUE;
+
+    pending = g_steal_pointer(&req->pending);
+    for (iter = pending; iter; iter = iter->next)
+        _con_get_child_new(req, iter->data);
+    g_slist_free(pending);
+
+    return TRUE;
+}
+
 /**
  * nm_agent_manager_get_secrets:
  * @self:
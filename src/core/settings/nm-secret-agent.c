@@ -16,6 +16,7 @@
 #include "libnm-core-intern/nm-core-internal.h"
 #include "libnm-core-aux-intern/nm-auth-subject.h"
 #include "nm-simple-connection.h"
+#include "nm-config.h"
 #include "NetworkManagerUtils.h"
 #include "c-list/src/c-list.h"
 
@@ -44,6 +45,7 @@ typedef struct _NMSecretAgentPrivate {
     char                     *owner_username;
     char                     *dbus_owner;
     GCancellable             *name_owner_cancellable;
+    GHashTable               *secrets_cache;
     guint                     name_owner_changed_id;
     NMSecretAgentCapabilities capabilities;
     bool                      shutdown_wait_obj_registered : 1;
@@ -128,6 +130,9 @@ struct _NMSecretAgentCallId {
     char                 *setting_name;
     NMSecretAgentCallback callback;
     gpointer              callback_data;
+    GSource              *cache_source;
+    GVariant             *cached_secrets;
+    bool                  cacheable : 1;
 };
 
 static NMSecretAgentCallId *
@@ -172,6 +177,8 @@ static void
 _call_id_free(NMSecretAgentCallId *call_id)
 {
     c_list_unlink_stale(&call_id->lst);
+    nm_clear_g_source_inst(&call_id->cache_source);
+    nm_g_variant_unref(call_id->cached_secrets);
     g_free(call_id->path);
     g_free(call_id->setting_name);
     nm_g_object_unref(call_id->cancellable);
@@ -358,6 +365,146 @@ nm_secret_agent_has_permission(NMSecretAgent *agent, const char *permission)
 
 /*****************************************************************************/
 
+typedef struct {
+    char     *path;
+    GVariant *secrets;
+    gint64    expiry_msec;
+} SecretsCacheEntry;
+
+static void
+_secrets_cache_entry_free(gpointer data)
+{
+    SecretsCacheEntry *entry = data;
+
+    g_free(entry->path);
+    g_variant_unref(entry->secrets);
+    nm_g_slice_free(entry);
+}
+
+static gint64
+_secrets_cache_timeout_msec(void)
+{
+    return nm_config_data_get_value_int64(NM_CONFIG_GET_DATA,
+                                          NM_CONFIG_KEYFILE_GROUP_MAIN,
+                                          NM_CONFIG_KEYFILE_KEY_MAIN_SECRET_AGENT_CACHE_TIMEOUT,
+                                          10,
+                                          0,
+                                          3600,
+                                          0)
+           * 1000;
+}
+
+static char *
+_secrets_cache_key(const char *path, const char *setting_name)
+{
+    /* D-Bus paths and setting names don't contain spaces. */
+    return g_strdup_printf("%s %s", path, setting_name);
+}
+
+static GVariant *
+_secrets_cache_lookup(NMSecretAgent *self, const char *path, const char *setting_name)
+{
+    NMSecretAgentPrivate *priv = NM_SECRET_AGENT_GET_PRIVATE(self);
+    gs_free char         *key  = NULL;
+    SecretsCacheEntry    *entry;
+
+    if (!priv->secrets_cache)
+        return NULL;
+
+    key   = _secrets_cache_key(path, setting_name);
+    entry = g_hash_table_lookup(priv->secrets_cache, key);
+    if (!entry)
+        return NULL;
+
+    if (entry->expiry_msec <= nm_utils_get_monotonic_timestamp_msec()) {
+        g_hash_table_remove(priv->secrets_cache, key);
+        return NULL;
+    }
+
+    return entry->secrets;
+}
+
+static void
+_secrets_cache_add(NMSecretAgent *self,
+                   const char    *path,
+                   const char    *setting_name,
+                   GVariant      *secrets)
+{
+    NMSecretAgentPrivate      *priv            = NM_SECRET_AGENT_GET_PRIVATE(self);
+    gs_unref_variant GVariant *setting_secrets = NULL;
+    SecretsCacheEntry         *entry;
+    GHashTableIter             iter;
+    gint64                     timeout_msec;
+    gint64                     now_msec;
+
+    timeout_msec = _secrets_cache_timeout_msec();
+    if (timeout_msec <= 0)
+        return;
+
+    /* The agent manager ignores replies without secrets for the setting. */
+    setting_secrets = g_variant_lookup_value(secrets, setting_name, NM_VARIANT_TYPE_SETTING);
+    if (!setting_secrets || g_variant_n_children(setting_secrets) == 0)
+        return;
+
+    now_msec = nm_utils_get_monotonic_timestamp_msec();
+
+    if (!priv->secrets_cache) {
+        priv->secrets_cache =
+            g_hash_table_new_full(nm_str_hash, g_str_equal, g_free, _secrets_cache_entry_free);
+    } else {
+        g_hash_table_iter_init(&iter, priv->secrets_cache);
+        while (g_hash_table_iter_next(&iter, NULL, (gpointer *) &entry)) {
+            if (entry->expiry_msec <= now_msec)
+                g_hash_table_iter_remove(&iter);
+        }
+    }
+
+    entry  = g_slice_new(SecretsCacheEntry);
+    *entry = (SecretsCacheEntry) {
+        .path        = g_strdup(path),
+        .secrets     = g_variant_ref(secrets),
+        .expiry_msec = now_msec + timeout_msec,
+    };
+    g_hash_table_insert(priv->secrets_cache, _secrets_cache_key(path, setting_name), entry);
+}
+
+static void
+_secrets_cache_remove(NMSecretAgent *self, const char *path, const char *setting_name)
+{
+    NMSecretAgentPrivate *priv = NM_SECRET_AGENT_GET_PRIVATE(self);
+    SecretsCacheEntry    *entry;
+    GHashTableIter        iter;
+
+    if (!priv->secrets_cache)
+        return;
+
+    if (setting_name) {
+        gs_free char *key = _secrets_cache_key(path, setting_name);
+
+        g_hash_table_remove(priv->secrets_cache, key);
+        return;
+    }
+
+    g_hash_table_iter_init(&iter, priv->secrets_cache);
+    while (g_hash_table_iter_next(&iter, NULL, (gpointer *) &entry)) {
+        if (nm_streq(entry->path, path))
+            g_hash_table_iter_remove(&iter);
+    }
+}
+
+static gboolean
+_cache_hit_cb(gpointer user_data)
+{
+    NMSecretAgentCallId       *call_id = user_data;
+    gs_unref_variant GVariant *secrets = g_steal_pointer(&call_id->cached_secrets);
+
+    nm_clear_g_source_inst(&call_id->cache_source);
+    _call_id_invoke_callback(call_id, secrets, NULL, FALSE, TRUE);
+    return G_SOURCE_CONTINUE;
+}
+
+/*****************************************************************************/
+
 static void
 _dbus_call_cb(GObject *source, GAsyncResult *result, gpointer user_data)
 {
@@ -378,6 +525,8 @@ _dbus_call_cb(GObject *source, GAsyncResult *result, gpointer user_data)
     else {
         if (nm_streq(call_id->method_name, METHOD_GET_SECRETS)) {
             g_variant_get(ret, "(@a{sa{sv}})", &secrets);
+            if (call_id->cacheable)
+                _secrets_cache_add(call_id->self, call_id->path, call_id->setting_name, secrets);
         }
     }
 
@@ -398,7 +547,9 @@ nm_secret_agent_get_secrets(NMSecretAgent               *self,
 {
     NMSecretAgentPrivate *priv;
     GVariant             *dict;
+    GVariant             *cached;
     NMSecretAgentCallId  *call_id;
+    gboolean              cacheable;
 
     g_return_val_if_fail(NM_IS_SECRET_AGENT(self), NULL);
     g_return_val_if_fail(NM_IS_CONNECTION(connection), NULL);
@@ -408,6 +559,26 @@ nm_secret_agent_get_secrets(NMSecretAgent               *self,
 
     priv = NM_SECRET_AGENT_GET_PRIVATE(self);
 
+    /* With "secret-agent-cache-timeout", the secrets that the agent returned
+     * are reused for a while. That spares the agent repeated requests, for
+     * example when many 802.1X ports re-authenticate at once. New secrets
+     * must come from the agent, and hints ask for something specific. */
+    if (NM_FLAGS_HAS(flags, NM_SECRET_AGENT_GET_SECRETS_FLAG_REQUEST_NEW))
+        _secrets_cache_remove(self, path, setting_name);
+    cacheable = !NM_FLAGS_ANY(flags,
+                              NM_SECRET_AGENT_GET_SECRETS_FLAG_REQUEST_NEW
+                                  | NM_SECRET_AGENT_GET_SECRETS_FLAG_USER_REQUESTED)
+                && !(hints && hints[0]) && _secrets_cache_timeout_msec() > 0;
+
+    if (cacheable && (cached = _secrets_cache_lookup(self, path, setting_name))) {
+        call_id =
+            _call_id_new(self, METHOD_GET_SECRETS, path, setting_name, callback, callback_data);
+        call_id->cached_secrets = g_variant_ref(cached);
+        call_id->cache_source   = nm_g_idle_add_source(_cache_hit_cb, call_id);
+        _LOG2T(call_id, "reply with cached secrets");
+        return call_id;
+    }
+
     dict = nm_connection_to_dbus(connection, NM_CONNECTION_SERIALIZE_ALL);
 
     /* Mask off the private flags if present */
@@ -415,6 +586,7 @@ nm_secret_agent_get_secrets(NMSecretAgent               *self,
                | NM_SECRET_AGENT_GET_SECRETS_FLAG_NO_ERRORS);
 
     call_id = _call_id_new(self, METHOD_GET_SECRETS, path, setting_name, callback, callback_data);
+    call_id->cacheable = cacheable;
 
     g_dbus_connection_call(priv->dbus_connection,
                            priv->dbus_owner,
@@ -501,7 +673,11 @@ nm_secret_agent_cancel_call(NMSecretAgent *self, NMSecretAgentCallId *call_id)
 
     nm_clear_g_cancellable(&call_id->cancellable);
 
-    if (nm_streq(call_id->method_name, METHOD_GET_SECRETS)) {
+    if (call_id->cache_source) {
+        /* The agent doesn't know about requests that were answered from the cache. */
+        nm_clear_g_source_inst(&call_id->cache_source);
+        nm_clear_pointer(&call_id->cached_secrets, g_variant_unref);
+    } else if (nm_streq(call_id->method_name, METHOD_GET_SECRETS)) {
         g_dbus_connection_call(
             priv->dbus_connection,
             priv->dbus_owner,
@@ -542,6 +718,8 @@ nm_secret_agent_save_secrets(NMSecretAgent        *self,
 
     priv = NM_SECRET_AGENT_GET_PRIVATE(self);
 
+    _secrets_cache_remove(self, path, NULL);
+
     /* Caller should have ensured that only agent-owned secrets exist in 'connection' */
     dict = nm_connection_to_dbus(connection, NM_CONNECTION_SERIALIZE_ALL);
 
@@ -582,6 +760,8 @@ nm_secret_agent_delete_secrets(NMSecretAgent        *self,
 
     priv = NM_SECRET_AGENT_GET_PRIVATE(self);
 
+    _secrets_cache_remove(self, path, NULL);
+
     /* No secrets sent; agents must be smart enough to track secrets using the UUID or something */
     dict = nm_connection_to_dbus(connection, NM_CONNECTION_SERIALIZE_WITH_NON_SECRET);
 
@@ -761,6 +941,8 @@ dispose(GObject *object)
 
     nm_clear_g_cancellable(&priv->name_owner_cancellable);
 
+    nm_clear_pointer(&priv->secrets_cache, g_hash_table_destroy);
+
     G_OBJECT_CLASS(nm_secret_agent_parent_class)->dispose(object);
 }
 
@@ -1397,21 +1397,19 @@ auth_start(NMSettingsConnection  *self,
 
 /**** DBus method handlers ************************************/
 
-static void
-get_settings_auth_cb(NMSettingsConnection  *self,
-                     GDBusMethodInvocation *context,
-                     NMAuthSubject         *subject,
-                     GError                *error,
-                     gpointer               data)
+/**
+ * nm_settings_connection_get_settings_dbus:
+ * @self: the #NMSettingsConnection
+ *
+ * Returns: (transfer none): the reply for the GetSettings() D-Bus method,
+ *   as "(a{sa{sv}})" tuple. The caller must check authorization.
+ */
+GVariant *
+nm_settings_connection_get_settings_dbus(NMSettingsConnection *self)
 {
     const char                      *seen_bssids_strv[SEEN_BSSIDS_MAX + 1];
     NMConnectionSerializationOptions options = {};
 
-    if (error) {
-        g_dbus_method_invocation_return_gerror(context, error);
-        return;
-    }
-
     /* Timestamp is not updated in connection's 'timestamp' property,
      * because it would force updating the connection and in turn
      * writing to /etc periodically, which we want to avoid. Rather real
@@ -1433,7 +1431,23 @@ get_settings_auth_cb(NMSettingsConnection  *self,
      * protected against leakage of secrets to unprivileged callers.
      */
 
-    g_dbus_method_invocation_return_value(context, _getsettings_cached_get(self, &options));
+    return _getsettings_cached_get(self, &options);
+}
+
+static void
+get_settings_auth_cb(NMSettingsConnection  *self,
+                     GDBusMethodInvocation *context,
+                     NMAuthSubject         *subject,
+                     GError                *error,
+                     gpointer               data)
+{
+    if (error) {
+        g_dbus_method_invocation_return_gerror(context, error);
+        return;
+    }
+
+    g_dbus_method_invocation_return_value(context,
+                                          nm_settings_connection_get_settings_dbus(self));
 }
 
 static void
@@ -217,6 +217,8 @@ NMConnection *nm_settings_connection_get_connection(NMSettingsConnection *self);
 gpointer      nm_settings_connection_get_setting(NMSettingsConnection *self,
                                                  NMMetaSettingType     meta_type);
 
+GVariant *nm_settings_connection_get_settings_dbus(NMSettingsConnection *self);
+
 void _nm_settings_connection_set_connection(NMSettingsConnection            *self,
                                             NMConnection                    *new_connection,
                                             NMConnection                   **out_old_connection,
@@ -11,6 +11,7 @@
 
 #include "nm-settings.h"
 
+#include <fcntl.h>
 #include <unistd.h>
 #include <sys/stat.h>
 #include <gmodule.h>
@@ -66,6 +67,7 @@
 #include "NetworkManagerUtils.h"
 #include "nm-dispatcher.h"
 #include "nm-hostname-manager.h"
+#include "nm-perf.h"
 
 /*****************************************************************************/
 
@@ -410,6 +412,12 @@ typedef struct {
     NMSettingsConnection **connections_cached_list;
     NMSettingsConnection **connections_cached_list_sorted_by_autoconnect_priority;
 
+    /* An index of connections_cached_list_sorted_by_autoconnect_priority by
+     * "connection.interface-name". The values are GArray of indexes into the
+     * sorted list. Profiles without interface-name are in connections_index_no_iface. */
+    GHashTable *connections_index_by_iface;
+    GArray     *connections_index_no_iface;
+
     GSList *unmanaged_specs;
     GSList *unrecognized_specs;
 
@@ -471,6 +479,7 @@ static void default_wired_clear_tag(NMSettings           *self,
                                     gboolean              add_to_no_auto_default);
 
 static void _clear_connections_cached_list(NMSettingsPrivate *priv);
+static void _clear_connections_index(NMSettingsPrivate *priv);
 
 static void _startup_complete_check(NMSettings *self, gint64 now_msec);
 
@@ -1511,6 +1520,9 @@ _plugin_connections_reload(NMSettings *self)
     SettConnEntry     *entry;
     gboolean           warned = FALSE;
     gboolean           migrate;
+    gint64             perf_start;
+
+    perf_start = nm_perf_start();
 
     for (iter_plugin = priv->plugins; iter_plugin; iter_plugin = iter_plugin->next) {
         nm_settings_plugin_reload_connections(iter_plugin->data,
@@ -1531,6 +1543,8 @@ _plugin_connections_reload(NMSettings *self)
     for (iter_plugin = priv->plugins; iter_plugin; iter_plugin = iter_plugin->next)
         nm_settings_plugin_load_connections_done(iter_plugin->data);
 
+    nm_perf_record(NM_PERF_PROBE_SETTINGS_RELOAD, perf_start);
+
     migrate = nm_config_data_get_value_boolean(nm_config_get_data(priv->config),
                                                NM_CONFIG_KEYFILE_GROUP_MAIN,
                                                NM_CONFIG_KEYFILE_KEY_MAIN_MIGRATE_IFCFG_RH,
@@ -2667,6 +2681,44 @@ pk_add_cb(NMAuthChain *chain, GDBusMethodInvocation *context, gpointer user_data
         send_agent_owned_secrets(self, added, subject);
 }
 
+static gboolean
+_add_connection_check_dbus(NMConnection *connection, NMAuthSubject *subject, GError **error)
+{
+    gs_free_error GError *local = NULL;
+
+    /* Connection must be valid, of course */
+    if (_nm_connection_verify(connection, &local) != NM_SETTING_VERIFY_SUCCESS) {
+        g_set_error(error,
+                    NM_SETTINGS_ERROR,
+                    NM_SETTINGS_ERROR_INVALID_CONNECTION,
+                    "The connection was invalid: %s",
+                    local->message);
+        return FALSE;
+    }
+
+    return nm_auth_is_subject_in_acl_set_error(connection,
+                                               subject,
+                                               NM_SETTINGS_ERROR,
+                                               NM_SETTINGS_ERROR_PERMISSION_DENIED,
+                                               error);
+}
+
+static const char *
+_add_connection_get_perm(NMConnection *connection)
+{
+    NMSettingConnection *s_con;
+
+    /* If the caller is the only user in the connection's permissions, then
+     * we use the 'modify.own' permission instead of 'modify.system'.  If the
+     * request affects more than just the caller, require 'modify.system'.
+     */
+    s_con = nm_connection_get_setting_connection(connection);
+    nm_assert(s_con);
+    if (nm_setting_connection_get_num_permissions(s_con) == 1)
+        return NM_AUTH_PERMISSION_SETTINGS_MODIFY_OWN;
+    return NM_AUTH_PERMISSION_SETTINGS_MODIFY_SYSTEM;
+}
+
 void
 nm_settings_add_connection_dbus(NMSettings                     *self,
                                 const char                     *plugin,
@@ -2679,11 +2731,10 @@ nm_settings_add_connection_dbus(NMSettings                     *self,
                                 NMSettingsAddCallback           callback,
                                 gpointer                        user_data)
 {
-    NMSettingsPrivate   *priv = NM_SETTINGS_GET_PRIVATE(self);
-    NMSettingConnection *s_con;
-    NMAuthChain         *chain;
-    GError              *error = NULL, *tmp_error = NULL;
-    const char          *perm;
+    NMSettingsPrivate *priv  = NM_SETTINGS_GET_PRIVATE(self);
+    GError            *error = NULL;
+    NMAuthChain       *chain;
+    const char        *perm;
 
     g_return_if_fail(NM_IS_CONNECTION(connection));
     g_return_if_fail(NM_IS_AUTH_SUBJECT(subject));
@@ -2691,33 +2742,10 @@ nm_settings_add_connection_dbus(NMSettings                     *self,
 
     nm_assert(!NM_FLAGS_ANY(sett_flags, ~_NM_SETTINGS_CONNECTION_INT_FLAGS_PERSISTENT_MASK));
 
-    /* Connection must be valid, of course */
-    if (_nm_connection_verify(connection, &tmp_error) != NM_SETTING_VERIFY_SUCCESS) {
-        error = g_error_new(NM_SETTINGS_ERROR,
-                            NM_SETTINGS_ERROR_INVALID_CONNECTION,
-                            "The connection was invalid: %s",
-                            tmp_error->message);
-        g_error_free(tmp_error);
-        goto done;
-    }
-
-    if (!nm_auth_is_subject_in_acl_set_error(connection,
-                                             subject,
-                                             NM_SETTINGS_ERROR,
-                                             NM_SETTINGS_ERROR_PERMISSION_DENIED,
-                                             &error))
+    if (!_add_connection_check_dbus(connection, subject, &error))
         goto done;
 
-    /* If the caller is the only user in the connection's permissions, then
-     * we use the 'modify.own' permission instead of 'modify.system'.  If the
-     * request affects more than just the caller, require 'modify.system'.
-     */
-    s_con = nm_connection_get_setting_connection(connection);
-    nm_assert(s_con);
-    if (nm_setting_connection_get_num_permissions(s_con) == 1)
-        perm = NM_AUTH_PERMISSION_SETTINGS_MODIFY_OWN;
-    else
-        perm = NM_AUTH_PERMISSION_SETTINGS_MODIFY_SYSTEM;
+    perm = _add_connection_get_perm(connection);
 
     chain = nm_auth_chain_new_subject(subject, context, pk_add_cb, self);
 
@@ -2778,6 +2806,40 @@ settings_add_connection_add_cb(NMSettings            *self,
     nm_audit_log_connection_op(NM_AUDIT_OP_CONN_ADD, connection, TRUE, NULL, subject, NULL);
 }
 
+static NMConnection *
+_add_connection_new_from_dbus(GVariant *settings, GError **error)
+{
+    gs_unref_object NMConnection *connection = NULL;
+
+    connection = _nm_simple_connection_new_from_dbus(settings,
+                                                     NM_SETTING_PARSE_FLAGS_STRICT
+                                                         | NM_SETTING_PARSE_FLAGS_NORMALIZE,
+                                                     error);
+
+    if (!connection || !nm_connection_verify_secrets(connection, error))
+        return NULL;
+
+    return g_steal_pointer(&connection);
+}
+
+static NMSettingsConnectionPersistMode
+_add_connection2_flags_get_persist_mode(NMSettingsAddConnection2Flags flags)
+{
+    if (NM_FLAGS_HAS(flags, NM_SETTINGS_ADD_CONNECTION2_FLAG_TO_DISK))
+        return NM_SETTINGS_CONNECTION_PERSIST_MODE_TO_DISK;
+
+    nm_assert(NM_FLAGS_HAS(flags, NM_SETTINGS_ADD_CONNECTION2_FLAG_IN_MEMORY));
+    return NM_SETTINGS_CONNECTION_PERSIST_MODE_IN_MEMORY_ONLY;
+}
+
+static NMSettingsConnectionAddReason
+_add_connection2_flags_get_add_reason(NMSettingsAddConnection2Flags flags)
+{
+    return NM_FLAGS_HAS(flags, NM_SETTINGS_ADD_CONNECTION2_FLAG_BLOCK_AUTOCONNECT)
+               ? NM_SETTINGS_CONNECTION_ADD_REASON_BLOCK_AUTOCONNECT
+               : NM_SETTINGS_CONNECTION_ADD_REASON_NONE;
+}
+
 static void
 settings_add_connection_helper(NMSettings                   *self,
                                GDBusMethodInvocation        *context,
@@ -2786,17 +2848,12 @@ settings_add_connection_helper(NMSettings                   *self,
                                const char                   *plugin,
                                NMSettingsAddConnection2Flags flags)
 {
-    gs_unref_object NMConnection   *connection = NULL;
-    GError                         *error      = NULL;
-    gs_unref_object NMAuthSubject  *subject    = NULL;
-    NMSettingsConnectionPersistMode persist_mode;
+    gs_unref_object NMConnection  *connection = NULL;
+    GError                        *error      = NULL;
+    gs_unref_object NMAuthSubject *subject    = NULL;
 
-    connection = _nm_simple_connection_new_from_dbus(settings,
-                                                     NM_SETTING_PARSE_FLAGS_STRICT
-                                                         | NM_SETTING_PARSE_FLAGS_NORMALIZE,
-                                                     &error);
-
-    if (!connection || !nm_connection_verify_secrets(connection, &error)) {
+    connection = _add_connection_new_from_dbus(settings, &error);
+    if (!connection) {
         g_dbus_method_invocation_take_error(context, error);
         return;
     }
@@ -2810,21 +2867,12 @@ settings_add_connection_helper(NMSettings                   *self,
         return;
     }
 
-    if (NM_FLAGS_HAS(flags, NM_SETTINGS_ADD_CONNECTION2_FLAG_TO_DISK))
-        persist_mode = NM_SETTINGS_CONNECTION_PERSIST_MODE_TO_DISK;
-    else {
-        nm_assert(NM_FLAGS_HAS(flags, NM_SETTINGS_ADD_CONNECTION2_FLAG_IN_MEMORY));
-        persist_mode = NM_SETTINGS_CONNECTION_PERSIST_MODE_IN_MEMORY_ONLY;
-    }
-
     nm_settings_add_connection_dbus(
         self,
         plugin,
         connection,
-        persist_mode,
-        NM_FLAGS_HAS(flags, NM_SETTINGS_ADD_CONNECTION2_FLAG_BLOCK_AUTOCONNECT)
-            ? NM_SETTINGS_CONNECTION_ADD_REASON_BLOCK_AUTOCONNECT
-            : NM_SETTINGS_CONNECTION_ADD_REASON_NONE,
+        _add_connection2_flags_get_persist_mode(flags),
+        _add_connection2_flags_get_add_reason(flags),
         NM_SETTINGS_CONNECTION_INT_FLAGS_NONE,
         subject,
         context,
@@ -2832,6 +2880,75 @@ settings_add_connection_helper(NMSettings                   *self,
         GINT_TO_POINTER(!!is_add_connection_2));
 }
 
+static gboolean
+_add_connection2_parse_args(guint32                        flags_u,
+                            GVariant                      *args,
+                            NMSettingsAddConnection2Flags *out_flags,
+                            char                         **out_plugin,
+                            GError                       **error)
+{
+    gs_free char                 *plugin = NULL;
+    NMSettingsAddConnection2Flags flags;
+    const char                   *args_name;
+    GVariant                     *args_value;
+    GVariantIter                  iter;
+
+    if (NM_FLAGS_ANY(flags_u,
+                     ~((guint32) (NM_SETTINGS_ADD_CONNECTION2_FLAG_TO_DISK
+                                  | NM_SETTINGS_ADD_CONNECTION2_FLAG_IN_MEMORY
+                                  | NM_SETTINGS_ADD_CONNECTION2_FLAG_BLOCK_AUTOCONNECT)))) {
+        g_set_error_literal(error,
+                            NM_SETTINGS_ERROR,
+                            NM_SETTINGS_ERROR_INVALID_ARGUMENTS,
+                            "Unknown flags");
+        return FALSE;
+    }
+
+    flags = flags_u;
+
+    if (!NM_FLAGS_ANY(flags,
+                      NM_SETTINGS_ADD_CONNECTION2_FLAG_TO_DISK
+                          | NM_SETTINGS_ADD_CONNECTION2_FLAG_IN_MEMORY)) {
+        g_set_error_literal(error,
+                            NM_SETTINGS_ERROR,
+                            NM_SETTINGS_ERROR_INVALID_ARGUMENTS,
+                            "Requires either to-disk (0x1) or in-memory (0x2) flags");
+        return FALSE;
+    }
+
+    if (NM_FLAGS_ALL(flags,
+                     NM_SETTINGS_ADD_CONNECTION2_FLAG_TO_DISK
+                         | NM_SETTINGS_ADD_CONNECTION2_FLAG_IN_MEMORY)) {
+        g_set_error_literal(error,
+                            NM_SETTINGS_ERROR,
+                            NM_SETTINGS_ERROR_INVALID_ARGUMENTS,
+                            "Cannot set to-disk (0x1) and in-memory (0x2) flags together");
+        return FALSE;
+    }
+
+    nm_assert(g_variant_is_of_type(args, G_VARIANT_TYPE("a{sv}")));
+
+    g_variant_iter_init(&iter, args);
+    while (g_variant_iter_next(&iter, "{&sv}", &args_name, &args_value)) {
+        if (plugin == NULL && nm_streq(args_name, "plugin")
+            && g_variant_is_of_type(args_value, G_VARIANT_TYPE_STRING)) {
+            plugin = g_variant_dup_string(args_value, NULL);
+            continue;
+        }
+
+        g_set_error(error,
+                    NM_SETTINGS_ERROR,
+                    NM_SETTINGS_ERROR_INVALID_ARGUMENTS,
+                    "Unsupported argument '%s'",
+                    args_name);
+        return FALSE;
+    }
+
+    *out_flags  = flags;
+    *out_plugin = g_steal_pointer(&plugin);
+    return TRUE;
+}
+
 static void
 impl_settings_add_connection(NMDBusObject                      *obj,
                              const NMDBusInterfaceInfoExtended *interface_info,
@@ -2888,67 +3005,274 @@ impl_settings_add_connection2(NMDBusObject                      *obj,
     gs_unref_variant GVariant    *args     = NULL;
     gs_free char                 *plugin   = NULL;
     NMSettingsAddConnection2Flags flags;
-    const char                   *args_name;
-    GVariant                     *args_value;
-    GVariantIter                  iter;
+    GError                       *error = NULL;
     guint32                       flags_u;
 
     g_variant_get(parameters, "(@a{sa{sv}}u@a{sv})", &settings, &flags_u, &args);
 
-    if (NM_FLAGS_ANY(flags_u,
-                     ~((guint32) (NM_SETTINGS_ADD_CONNECTION2_FLAG_TO_DISK
-                                  | NM_SETTINGS_ADD_CONNECTION2_FLAG_IN_MEMORY
-                                  | NM_SETTINGS_ADD_CONNECTION2_FLAG_BLOCK_AUTOCONNECT)))) {
-        g_dbus_method_invocation_take_error(invocation,
-                                            g_error_new_literal(NM_SETTINGS_ERROR,
-                                                                NM_SETTINGS_ERROR_INVALID_ARGUMENTS,
-                                                                "Unknown flags"));
+    if (!_add_connection2_parse_args(flags_u, args, &flags, &plugin, &error)) {
+        g_dbus_method_invocation_take_error(invocation, error);
         return;
     }
 
-    flags = flags_u;
+    settings_add_connection_helper(self, invocation, TRUE, settings, plugin, flags);
+}
 
-    if (!NM_FLAGS_ANY(flags,
-                      NM_SETTINGS_ADD_CONNECTION2_FLAG_TO_DISK
-                          | NM_SETTINGS_ADD_CONNECTION2_FLAG_IN_MEMORY)) {
-        g_dbus_method_invocation_take_error(
-            invocation,
-            g_error_new_literal(NM_SETTINGS_ERROR,
-                                NM_SETTINGS_ERROR_INVALID_ARGUMENTS,
-                                "Requires either to-disk (0x1) or in-memory (0x2) flags"));
+/*****************************************************************************/
+
+typedef struct {
+    NMConnection *connection;
+    char         *path;
+    char         *error_message;
+} AddConnectionsItem;
+
+typedef struct {
+    NMAuthSubject                *subject;
+    char                         *plugin;
+    NMSettingsAddConnection2Flags flags;
+    gsize                         n_items;
+    AddConnectionsItem            items[];
+} AddConnectionsData;
+
+static void
+_add_connections_data_free(AddConnectionsData *data)
+{
+    gsize i;
+
+    for (i = 0; i < data->n_items; i++) {
+        nm_g_object_unref(data->items[i].connection);
+        g_free(data->items[i].path);
+        g_free(data->items[i].error_message);
+    }
+    g_object_unref(data->subject);
+    g_free(data->plugin);
+    g_free(data);
+}
+
+static void
+_add_connections_return(GDBusMethodInvocation *context, const AddConnectionsData *data)
+{
+    GVariantBuilder builder;
+    gsize           i;
+
+    g_variant_builder_init(&builder, G_VARIANT_TYPE("aa{sv}"));
+    for (i = 0; i < data->n_items; i++) {
+        const AddConnectionsItem *item = &data->items[i];
+        GVariantBuilder           item_builder;
+
+        g_variant_builder_init(&item_builder, G_VARIANT_TYPE_VARDICT);
+        if (item->path) {
+            g_variant_builder_add(&item_builder,
+                                  "{sv}",
+                                  "path",
+                                  g_variant_new_object_path(item->path));
+        } else {
+            g_variant_builder_add(&item_builder,
+                                  "{sv}",
+                                  "error",
+                                  g_variant_new_string(item->error_message));
+        }
+        g_variant_builder_add(&builder, "a{sv}", &item_builder);
+    }
+
+    g_dbus_method_invocation_return_value(context, g_variant_new("(aa{sv})", &builder));
+}
+
+static void
+_add_connections_sync_dirs(NMSettings *self, GHashTable *dirnames)
+{
+    GHashTableIter iter;
+    const char    *dirname;
+
+    /* the profiles were written by renaming temporary files. Make the
+     * new directory entries durable once, instead of once per profile. */
+    g_hash_table_iter_init(&iter, dirnames);
+    while (g_hash_table_iter_next(&iter, (gpointer *) &dirname, NULL)) {
+        nm_auto_close int fd = -1;
+
+        fd = open(dirname, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+        if (fd < 0 || fsync(fd) != 0) {
+            _LOGD("add-connections: failed to sync directory \"%s\": %s",
+                  dirname,
+                  nm_strerror_native(errno));
+        }
+    }
+}
+
+static void
+pk_add_connections_cb(NMAuthChain *chain, GDBusMethodInvocation *context, gpointer user_data)
+{
+    NMSettings                     *self     = NM_SETTINGS(user_data);
+    gs_unref_hashtable GHashTable  *dirnames = NULL;
+    NMSettingsConnectionPersistMode persist_mode;
+    AddConnectionsData             *data;
+    const char                     *perm;
+    gsize                           i;
+
+    nm_assert(G_IS_DBUS_METHOD_INVOCATION(context));
+
+    c_list_unlink(nm_auth_chain_parent_lst_list(chain));
+
+    perm = nm_auth_chain_get_data(chain, "perm");
+    data = nm_auth_chain_get_data(chain, "data");
+
+    if (nm_auth_chain_get_result(chain, perm) != NM_AUTH_CALL_RESULT_YES) {
+        g_dbus_method_invocation_return_error_literal(context,
+                                                      NM_SETTINGS_ERROR,
+                                                      NM_SETTINGS_ERROR_PERMISSION_DENIED,
+                                                      NM_UTILS_ERROR_MSG_INSUFF_PRIV);
+        nm_audit_log_connection_op(NM_AUDIT_OP_CONN_ADD,
+                                   NULL,
+                                   FALSE,
+                                   NULL,
+                                   data->subject,
+                                   NM_UTILS_ERROR_MSG_INSUFF_PRIV);
         return;
     }
 
-    if (NM_FLAGS_ALL(flags,
-                     NM_SETTINGS_ADD_CONNECTION2_FLAG_TO_DISK
-                         | NM_SETTINGS_ADD_CONNECTION2_FLAG_IN_MEMORY)) {
-        g_dbus_method_invocation_take_error(
-            invocation,
-            g_error_new_literal(NM_SETTINGS_ERROR,
-                                NM_SETTINGS_ERROR_INVALID_ARGUMENTS,
-                                "Cannot set to-disk (0x1) and in-memory (0x2) flags together"));
+    persist_mode = _add_connection2_flags_get_persist_mode(data->flags);
+    if (persist_mode == NM_SETTINGS_CONNECTION_PERSIST_MODE_TO_DISK)
+        dirnames = g_hash_table_new_full(nm_str_hash, g_str_equal, g_free, NULL);
+
+    /* emit a single change notification for the "Connections" property. */
+    g_object_freeze_notify(G_OBJECT(self));
+
+    for (i = 0; i < data->n_items; i++) {
+        AddConnectionsItem                   *item  = &data->items[i];
+        gs_free_error GError                 *error = NULL;
+        gs_unref_object NMSettingsConnection *added = NULL;
+        const char                           *filename;
+
+        if (!item->connection)
+            continue;
+
+        if (!nm_settings_add_connection(self,
+                                        data->plugin,
+                                        item->connection,
+                                        persist_mode,
+                                        _add_connection2_flags_get_add_reason(data->flags),
+                                        NM_SETTINGS_CONNECTION_INT_FLAGS_NONE,
+                                        &added,
+                                        &error)) {
+            item->error_message = g_strdup(error->message);
+            nm_audit_log_connection_op(NM_AUDIT_OP_CONN_ADD,
+                                       NULL,
+                                       FALSE,
+                                       NULL,
+                                       data->subject,
+                                       error->message);
+            continue;
+        }
+
+        nm_g_object_ref(added);
+
+        item->path = g_strdup(nm_dbus_object_get_path(NM_DBUS_OBJECT(added)));
+        nm_audit_log_connection_op(NM_AUDIT_OP_CONN_ADD, added, TRUE, NULL, data->subject, NULL);
+
+        if (!nm_settings_has_connection(self, added))
+            continue;
+
+        if (dirnames) {
+            filename =
+                nm_settings_storage_get_filename(nm_settings_connection_get_storage(added));
+            if (filename)
+                g_hash_table_add(dirnames, g_path_get_dirname(filename));
+        }
+
+        /* Send agent-owned secrets to the agents */
+        send_agent_owned_secrets(self, added, data->subject);
+    }
+
+    g_object_thaw_notify(G_OBJECT(self));
+
+    if (dirnames)
+        _add_connections_sync_dirs(self, dirnames);
+
+    _add_connections_return(context, data);
+}
+
+static void
+impl_settings_add_connections(NMDBusObject                      *obj,
+                              const NMDBusInterfaceInfoExtended *interface_info,
+                              const NMDBusMethodInfoExtended    *method_info,
+                              GDBusConnection                   *connection,
+                              const char                        *sender,
+                              GDBusMethodInvocation             *invocation,
+                              GVariant                          *parameters)
+{
+    NMSettings                    *self        = NM_SETTINGS(obj);
+    NMSettingsPrivate             *priv        = NM_SETTINGS_GET_PRIVATE(self);
+    gs_unref_variant GVariant     *settings_av = NULL;
+    gs_unref_variant GVariant     *args        = NULL;
+    gs_free char                  *plugin      = NULL;
+    gs_unref_object NMAuthSubject *subject     = NULL;
+    const char                    *perm        = NM_AUTH_PERMISSION_SETTINGS_MODIFY_OWN;
+    NMSettingsAddConnection2Flags  flags;
+    AddConnectionsData            *data;
+    NMAuthChain                   *chain;
+    GError                        *error   = NULL;
+    gsize                          n_valid = 0;
+    gsize                          n_items;
+    gsize                          i;
+    guint32                        flags_u;
+
+    g_variant_get(parameters, "(@aa{sa{sv}}u@a{sv})", &settings_av, &flags_u, &args);
+
+    if (!_add_connection2_parse_args(flags_u, args, &flags, &plugin, &error)) {
+        g_dbus_method_invocation_take_error(invocation, error);
         return;
     }
 
-    nm_assert(g_variant_is_of_type(args, G_VARIANT_TYPE("a{sv}")));
+    subject = nm_dbus_manager_new_auth_subject_from_context(invocation);
+    if (!subject) {
+        g_dbus_method_invocation_return_error_literal(invocation,
+                                                      NM_SETTINGS_ERROR,
+                                                      NM_SETTINGS_ERROR_PERMISSION_DENIED,
+                                                      NM_UTILS_ERROR_MSG_REQ_UID_UKNOWN);
+        return;
+    }
 
-    g_variant_iter_init(&iter, args);
-    while (g_variant_iter_next(&iter, "{&sv}", &args_name, &args_value)) {
-        if (plugin == NULL && nm_streq(args_name, "plugin")
-            && g_variant_is_of_type(args_value, G_VARIANT_TYPE_STRING)) {
-            plugin = g_variant_dup_string(args_value, NULL);
+    n_items       = g_variant_n_children(settings_av);
+    data          = g_malloc0(sizeof(AddConnectionsData) + n_items * sizeof(AddConnectionsItem));
+    data->subject = g_steal_pointer(&subject);
+    data->plugin  = g_steal_pointer(&plugin);
+    data->flags   = flags;
+    data->n_items = n_items;
+
+    /* Invalid profiles are reported in their result, the others are added
+     * after a single authorization. */
+    for (i = 0; i < n_items; i++) {
+        gs_unref_variant GVariant    *settings   = NULL;
+        gs_unref_object NMConnection *connection = NULL;
+        gs_free_error GError         *local      = NULL;
+
+        settings   = g_variant_get_child_value(settings_av, i);
+        connection = _add_connection_new_from_dbus(settings, &local);
+        if (!connection || !_add_connection_check_dbus(connection, data->subject, &local)) {
+            data->items[i].error_message = g_strdup(local->message);
             continue;
         }
 
-        g_dbus_method_invocation_take_error(invocation,
-                                            g_error_new(NM_SETTINGS_ERROR,
-                                                        NM_SETTINGS_ERROR_INVALID_ARGUMENTS,
-                                                        "Unsupported argument '%s'",
-                                                        args_name));
+        if (nm_streq(_add_connection_get_perm(connection),
+                     NM_AUTH_PERMISSION_SETTINGS_MODIFY_SYSTEM))
+            perm = NM_AUTH_PERMISSION_SETTINGS_MODIFY_SYSTEM;
+
+        data->items[i].connection = g_steal_pointer(&connection);
+        n_valid++;
+    }
+
+    if (n_valid == 0) {
+        _add_connections_return(invocation, data);
+        _add_connections_data_free(data);
         return;
     }
 
-    settings_add_connection_helper(self, invocation, TRUE, settings, plugin, flags);
+    chain = nm_auth_chain_new_subject(data->subject, invocation, pk_add_connections_cb, self);
+
+    c_list_link_tail(&priv->auth_lst_head, nm_auth_chain_parent_lst_list(chain));
+    nm_auth_chain_set_data(chain, "perm", (gpointer) perm, NULL);
+    nm_auth_chain_set_data(chain, "data", data, (GDestroyNotify) _add_connections_data_free);
+    nm_auth_chain_add_call_unsafe(chain, perm, TRUE);
 }
 
 /*****************************************************************************/
@@ -3088,11 +3412,23 @@ _nm_settings_notify_sorted_by_autoconnect_priority_maybe_changed(NMSettings *sel
     NMSettingsPrivate *priv = NM_SETTINGS_GET_PRIVATE(self);
 
     priv->sorted_by_autoconnect_priority_maybe_changed = TRUE;
+
+    /* the sort order or the interface-name might have changed. */
+    _clear_connections_index(priv);
+}
+
+static void
+_clear_connections_index(NMSettingsPrivate *priv)
+{
+    nm_clear_pointer(&priv->connections_index_by_iface, g_hash_table_unref);
+    nm_clear_pointer(&priv->connections_index_no_iface, g_array_unref);
 }
 
 static void
 _clear_connections_cached_list(NMSettingsPrivate *priv)
 {
+    _clear_connections_index(priv);
+
     if (priv->connections_cached_list) {
         nm_assert(priv->connections_len == NM_PTRARRAY_LEN(priv->connections_cached_list));
 
@@ -3147,6 +3483,89 @@ impl_settings_list_connections(NMDBusObject                      *obj,
     g_dbus_method_invocation_return_value(invocation, g_variant_new("(^ao)", strv));
 }
 
+static void
+impl_settings_get_connections_settings(NMDBusObject                      *obj,
+                                       const NMDBusInterfaceInfoExtended *interface_info,
+                                       const NMDBusMethodInfoExtended    *method_info,
+                                       GDBusConnection                   *dbus_connection,
+                                       const char                        *sender,
+                                       GDBusMethodInvocation             *invocation,
+                                       GVariant                          *parameters)
+{
+    NMSettings                    *self    = NM_SETTINGS(obj);
+    gs_unref_object NMAuthSubject *subject = NULL;
+    gs_free const char           **paths   = NULL;
+    gs_free NMSettingsConnection **list    = NULL;
+    NMSettingsConnection *const   *conns;
+    GVariantBuilder                builder;
+    GError                        *error = NULL;
+    gboolean                       all;
+    guint                          len;
+    guint                          i;
+
+    g_variant_get(parameters, "(^a&o)", &paths);
+
+    subject = nm_dbus_manager_new_auth_subject_from_context(invocation);
+    if (!subject) {
+        error = g_error_new_literal(NM_SETTINGS_ERROR,
+                                    NM_SETTINGS_ERROR_PERMISSION_DENIED,
+                                    NM_UTILS_ERROR_MSG_REQ_UID_UKNOWN);
+        goto error;
+    }
+
+    /* An empty list requests all profiles. Then we silently skip the ones that are
+     * not visible to the caller, like ListConnections() would. For explicitly
+     * requested profiles, fail the same way as GetSettings() would. */
+    all = !paths[0];
+    if (all)
+        conns = nm_settings_get_connections(self, &len);
+    else {
+        len  = NM_PTRARRAY_LEN(paths);
+        list = g_new(NMSettingsConnection *, len);
+        for (i = 0; i < len; i++) {
+            list[i] = nm_settings_get_connection_by_path(self, paths[i]);
+            if (!list[i]) {
+                error = g_error_new(NM_SETTINGS_ERROR,
+                                    NM_SETTINGS_ERROR_INVALID_CONNECTION,
+                                    "Connection '%s' does not exist",
+                                    paths[i]);
+                goto error;
+            }
+        }
+        conns = list;
+    }
+
+    g_variant_builder_init(&builder, G_VARIANT_TYPE("a{oa{sa{sv}}}"));
+    for (i = 0; i < len; i++) {
+        NMSettingsConnection      *sett_conn = conns[i];
+        gs_unref_variant GVariant *settings  = NULL;
+
+        if (!nm_auth_is_subject_in_acl_set_error(nm_settings_connection_get_connection(sett_conn),
+                                                 subject,
+                                                 NM_SETTINGS_ERROR,
+                                                 NM_SETTINGS_ERROR_PERMISSION_DENIED,
+                                                 all ? NULL : &error)) {
+            if (all)
+                continue;
+            g_variant_builder_clear(&builder);
+            goto error;
+        }
+
+        settings =
+            g_variant_get_child_value(nm_settings_connection_get_settings_dbus(sett_conn), 0);
+        g_variant_builder_add(&builder,
+                              "{o@a{sa{sv}}}",
+                              nm_dbus_object_get_path(NM_DBUS_OBJECT(sett_conn)),
+                              settings);
+    }
+
+    g_dbus_method_invocation_return_value(invocation, g_variant_new("(a{oa{sa{sv}}})", &builder));
+    return;
+
+error:
+    g_dbus_method_invocation_take_error(invocation, error);
+}
+
 NMSettingsConnection *
 nm_settings_get_connection_by_uuid(NMSettings *self, const char *uuid)
 {
@@ -3321,6 +3740,127 @@ nm_settings_get_connections_sorted_by_autoconnect_priority(NMSettings *self, gui
     return priv->connections_cached_list_sorted_by_autoconnect_priority;
 }
 
+static NMSettingsConnection *const *
+_connections_index_ensure(NMSettings *self)
+{
+    NMSettingsPrivate           *priv = NM_SETTINGS_GET_PRIVATE(self);
+    NMSettingsConnection *const *list;
+    guint                        len;
+    guint                        i;
+
+    /* this may re-sort the list, but any change that affects the sort order
+     * already cleared the index. */
+    list = nm_settings_get_connections_sorted_by_autoconnect_priority(self, &len);
+
+    if (priv->connections_index_no_iface)
+        return list;
+
+    priv->connections_index_by_iface =
+        g_hash_table_new_full(nm_str_hash, g_str_equal, g_free, (GDestroyNotify) g_array_unref);
+    priv->connections_index_no_iface = g_array_new(FALSE, FALSE, sizeof(guint));
+
+    for (i = 0; i < len; i++) {
+        const char *iface;
+        GArray     *arr;
+
+        iface = nm_connection_get_interface_name(nm_settings_connection_get_connection(list[i]));
+        if (!iface)
+            arr = priv->connections_index_no_iface;
+        else {
+            arr = g_hash_table_lookup(priv->connections_index_by_iface, iface);
+            if (!arr) {
+                arr = g_array_new(FALSE, FALSE, sizeof(guint));
+                g_hash_table_insert(priv->connections_index_by_iface, g_strdup(iface), arr);
+            }
+        }
+        g_array_append_val(arr, i);
+    }
+
+    return list;
+}
+
+/**
+ * nm_settings_get_connections_for_iface:
+ * @self: the #NMSettings
+ * @iface: (nullable): the interface name of the device
+ * @connection_type: (nullable): if set, only return profiles of this
+ *   "connection.type".
+ * @func: (nullable): an optional filter function
+ * @func_data: user data for @func
+ * @out_len: (out) (optional): returns the number of returned
+ *   connections.
+ *
+ * Returns the profiles that are candidates for activating on a device
+ * with interface name @iface. Those are the profiles that either have no
+ * "connection.interface-name" or have it set to @iface. Like
+ * nm_settings_get_connections_clone() with
+ * nm_settings_connection_cmp_autoconnect_priority_p_with_data(), but it
+ * uses an index by interface name instead of iterating over all profiles.
+ *
+ * Returns: (transfer container): a %NULL terminated list of
+ *   NMSettingsConnections, sorted by autoconnect priority.
+ */
+NMSettingsConnection **
+nm_settings_get_connections_for_iface(NMSettings                    *self,
+                                      const char                    *iface,
+                                      const char                    *connection_type,
+                                      NMSettingsConnectionFilterFunc func,
+                                      gpointer                       func_data,
+                                      guint                         *out_len)
+{
+    NMSettingsPrivate           *priv;
+    NMSettingsConnection *const *list_cached;
+    NMSettingsConnection       **list;
+    GArray                      *arr_a;
+    GArray                      *arr_b = NULL;
+    guint                        i_a   = 0;
+    guint                        i_b   = 0;
+    guint                        len_b;
+    guint                        j = 0;
+
+    g_return_val_if_fail(NM_IS_SETTINGS(self), NULL);
+
+    priv = NM_SETTINGS_GET_PRIVATE(self);
+
+    list_cached = _connections_index_ensure(self);
+
+    arr_a = priv->connections_index_no_iface;
+    if (iface)
+        arr_b = g_hash_table_lookup(priv->connections_index_by_iface, iface);
+    len_b = arr_b ? arr_b->len : 0u;
+
+    list = g_new(NMSettingsConnection *, (gsize) arr_a->len + len_b + 1u);
+
+    /* both lists are indexes into the sorted list. Merge them, to preserve
+     * the order. */
+    while (i_a < arr_a->len || i_b < len_b) {
+        NMSettingsConnection *sett_conn;
+        guint                 idx;
+
+        if (i_b >= len_b
+            || (i_a < arr_a->len
+                && nm_g_array_index(arr_a, guint, i_a) < nm_g_array_index(arr_b, guint, i_b)))
+            idx = nm_g_array_index(arr_a, guint, i_a++);
+        else
+            idx = nm_g_array_index(arr_b, guint, i_b++);
+
+        sett_conn = list_cached[idx];
+
+        if (connection_type
+            && !nm_streq0(nm_settings_connection_get_connection_type(sett_conn), connection_type))
+            continue;
+
+        if (func && !func(self, sett_conn, func_data))
+            continue;
+
+        list[j++] = sett_conn;
+    }
+    list[j] = NULL;
+
+    NM_SET_OUT(out_len, j);
+    return list;
+}
+
 /**
  * nm_settings_get_connections_clone:
  * @self: the #NMSetting
@@ -3977,7 +4517,20 @@ _kf_db_to_file(NMSettings *self, gboolean is_timestamps, gboolean force_write)
         nm_key_file_db_prune_tmp_files(kf_db);
     }
 
-    nm_key_file_db_to_file(kf_db, force_write);
+    nm_key_file_db_set_sync(kf_db,
+                            nm_config_data_get_value_boolean(
+                                nm_config_get_data(priv->config),
+                                NM_CONFIG_KEYFILE_GROUP_MAIN,
+                                NM_CONFIG_KEYFILE_KEY_MAIN_STATE_FILES_SYNC,
+                                FALSE));
+
+    /* regular flushes are written on a worker thread, so that slow storage
+     * does not block the main loop. Only the final write before exiting
+     * is done synchronously. */
+    if (force_write)
+        nm_key_file_db_to_file(kf_db, TRUE);
+    else
+        nm_key_file_db_to_file_async(kf_db);
 }
 
 G_GNUC_PRINTF(4, 5)
@@ -4381,6 +4934,14 @@ static const NMDBusInterfaceInfoExtended interface_info_settings = {
                     .out_args =
                         NM_DEFINE_GDBUS_ARG_INFOS(NM_DEFINE_GDBUS_ARG_INFO("connection", "o"), ), ),
                 .handle = impl_settings_get_connection_by_uuid, ),
+            NM_DEFINE_DBUS_METHOD_INFO_EXTENDED(
+                NM_DEFINE_GDBUS_METHOD_INFO_INIT(
+                    "GetConnectionsSettings",
+                    .in_args =
+                        NM_DEFINE_GDBUS_ARG_INFOS(NM_DEFINE_GDBUS_ARG_INFO("connections", "ao"), ),
+                    .out_args = NM_DEFINE_GDBUS_ARG_INFOS(
+                        NM_DEFINE_GDBUS_ARG_INFO("settings", "a{oa{sa{sv}}}"), ), ),
+                .handle = impl_settings_get_connections_settings, ),
             NM_DEFINE_DBUS_METHOD_INFO_EXTENDED(
                 NM_DEFINE_GDBUS_METHOD_INFO_INIT(
                     "AddConnection",
@@ -4408,6 +4969,16 @@ static const NMDBusInterfaceInfoExtended interface_info_settings = {
                         NM_DEFINE_GDBUS_ARG_INFOS(NM_DEFINE_GDBUS_ARG_INFO("path", "o"),
                                                   NM_DEFINE_GDBUS_ARG_INFO("result", "a{sv}"), ), ),
                 .handle = impl_settings_add_connection2, ),
+            NM_DEFINE_DBUS_METHOD_INFO_EXTENDED(
+                NM_DEFINE_GDBUS_METHOD_INFO_INIT(
+                    "AddConnections",
+                    .in_args = NM_DEFINE_GDBUS_ARG_INFOS(
+                        NM_DEFINE_GDBUS_ARG_INFO("settings", "aa{sa{sv}}"),
+                        NM_DEFINE_GDBUS_ARG_INFO("flags", "u"),
+                        NM_DEFINE_GDBUS_ARG_INFO("args", "a{sv}"), ),
+                    .out_args = NM_DEFINE_GDBUS_ARG_INFOS(
+                        NM_DEFINE_GDBUS_ARG_INFO("results", "aa{sv}"), ), ),
+                .handle = impl_settings_add_connections, ),
             NM_DEFINE_DBUS_METHOD_INFO_EXTENDED(
                 NM_DEFINE_GDBUS_METHOD_INFO_INIT(
                     "LoadConnections",
@@ -85,6 +85,14 @@ NMSettingsConnection *const *nm_settings_get_connections(NMSettings *settings, g
 NMSettingsConnection *const *
 nm_settings_get_connections_sorted_by_autoconnect_priority(NMSettings *self, guint *out_len);
 
+NMSettingsConnection **
+nm_settings_get_connections_for_iface(NMSettings                    *self,
+                                      const char                    *iface,
+                                      const char                    *connection_type,
+                                      NMSettingsConnectionFilterFunc func,
+                                      gpointer                       func_data,
+                                      guint                         *out_len);
+
 NMSettingsConnection **nm_settings_get_connections_clone(NMSettings                    *self,
                                                          guint                         *out_len,
                                                          NMSettingsConnectionFilterFunc func,
@@ -23,6 +23,8 @@
 
 #define IFCFG_DIR SYSCONFDIR "/sysconfig/network-scripts"
 
+#define IFCFG_NETWORK_FILE SYSCONFDIR "/sysconfig/network"
+
 #define TYPE_ETHERNET   "Ethernet"
 #define TYPE_WIRELESS   "Wireless"
 #define TYPE_INFINIBAND "InfiniBand"
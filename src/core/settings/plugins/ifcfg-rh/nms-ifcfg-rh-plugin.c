@@ -174,7 +174,7 @@ nm_assert_self(NMSIfcfgRHPlugin *self, gboolean unhandled_specs_consistent)
 /*****************************************************************************/
 
 static NMSIfcfgRHStorage *
-_load_file(NMSIfcfgRHPlugin *self, const char *filename, GError **error)
+_load_file(NMSIfcfgRHPlugin *self, const char *filename, shvarFile *network_ifcfg, GError **error)
 {
     NMSIfcfgRHStorage            *ret            = NULL;
     gs_unref_object NMConnection *connection     = NULL;
@@ -193,7 +193,11 @@ _load_file(NMSIfcfgRHPlugin *self, const char *filename, GError **error)
         return NULL;
     }
 
-    connection = connection_from_file(filename, &unhandled_spec, &load_error, &load_error_ignore);
+    connection = connection_from_file(filename,
+                                      network_ifcfg,
+                                      &unhandled_spec,
+                                      &load_error,
+                                      &load_error_ignore);
     if (load_error) {
         if (error) {
             nm_utils_error_set(error,
@@ -239,10 +243,11 @@ _load_file(NMSIfcfgRHPlugin *self, const char *filename, GError **error)
 static void
 _load_dir(NMSIfcfgRHPlugin *self, NMSettUtilStorages *storages)
 {
-    gs_unref_hashtable GHashTable *dupl_filenames = NULL;
-    gs_free_error GError          *local          = NULL;
-    const char                    *f_filename;
-    GDir                          *dir;
+    gs_unref_hashtable GHashTable      *dupl_filenames = NULL;
+    gs_free_error GError               *local          = NULL;
+    nm_auto_shvar_file_close shvarFile *network_ifcfg  = NULL;
+    const char                         *f_filename;
+    GDir                               *dir;
 
     dir = g_dir_open(IFCFG_DIR, 0, &local);
     if (!dir) {
@@ -252,6 +257,10 @@ _load_dir(NMSIfcfgRHPlugin *self, NMSettUtilStorages *storages)
 
     dupl_filenames = g_hash_table_new_full(nm_str_hash, g_str_equal, NULL, g_free);
 
+    /* every profile consults the global settings. Parse the file once and
+     * share it for all files of the directory. */
+    network_ifcfg = svOpenFile(IFCFG_NETWORK_FILE, NULL);
+
     while ((f_filename = g_dir_read_name(dir))) {
         gs_free char      *full_path = NULL;
         NMSIfcfgRHStorage *storage;
@@ -267,7 +276,7 @@ _load_dir(NMSIfcfgRHPlugin *self, NMSettUtilStorages *storages)
 
         nm_assert(!nm_sett_util_storages_lookup_by_filename(storages, full_filename));
 
-        storage = _load_file(self, full_filename, NULL);
+        storage = _load_file(self, full_filename, network_ifcfg, NULL);
         if (storage)
             nm_sett_util_storages_add_take(storages, storage);
     }
@@ -473,7 +482,7 @@ load_connections(NMSettingsPlugin                      *plugin,
         if (!g_hash_table_insert(dupl_filenames, g_steal_pointer(&full_filename_keep), entry))
             nm_assert_not_reached();
 
-        storage = _load_file(self, full_filename, &local);
+        storage = _load_file(self, full_filename, NULL, &local);
         if (!storage) {
             if (nm_utils_file_stat(full_filename, NULL) == -ENOENT) {
                 NMSIfcfgRHStorage *storage2;
@@ -522,7 +531,7 @@ load_connections(NMSettingsPlugin                      *plugin,
              * Reload that file too despite not being told to do so. The reason is to get
              * the latest file timestamp so that we get the priorities right. */
 
-            storage_new = _load_file(self, full_filename, &local);
+            storage_new = _load_file(self, full_filename, NULL, &local);
             if (storage_new
                 && !nm_streq0(loaded_uuid, nms_ifcfg_rh_storage_get_uuid_opt(storage_new))) {
                 /* the file now references a different UUID. We are not told to reload
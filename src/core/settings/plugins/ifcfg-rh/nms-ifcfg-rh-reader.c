@@ -6466,15 +6466,17 @@ check_dns_search_domains(shvarFile *ifcfg, NMSetting *s_ip4, NMSetting *s_ip6)
 
 static NMConnection *
 connection_from_file_full(const char *filename,
+                          shvarFile  *network_ifcfg_shared,
                           const char *network_file, /* for unit tests only */
                           const char *test_type,    /* for unit tests only */
                           char      **out_unhandled,
                           GError    **error,
                           gboolean   *out_ignore_error)
 {
-    nm_auto_shvar_file_close shvarFile *main_ifcfg    = NULL;
-    nm_auto_shvar_file_close shvarFile *network_ifcfg = NULL;
-    gs_unref_object NMConnection       *connection    = NULL;
+    nm_auto_shvar_file_close shvarFile *main_ifcfg         = NULL;
+    nm_auto_shvar_file_close shvarFile *network_ifcfg_free = NULL;
+    shvarFile                          *network_ifcfg;
+    gs_unref_object NMConnection       *connection         = NULL;
     gs_free char                       *type          = NULL;
     char                               *devtype, *bootproto;
     NMSetting                          *setting;
@@ -6493,7 +6495,7 @@ connection_from_file_full(const char *filename,
 
     /* Non-NULL only for unit tests; normally use /etc/sysconfig/network */
     if (!network_file)
-        network_file = SYSCONFDIR "/sysconfig/network";
+        network_file = IFCFG_NETWORK_FILE;
 
     ifcfg_name = utils_get_ifcfg_name(filename, TRUE);
     if (!ifcfg_name) {
@@ -6528,7 +6530,10 @@ connection_from_file_full(const char *filename,
         svWarnInvalid(main_ifcfg, "ifcfg", _NMLOG_DOMAIN);
     nm_clear_g_free(&s_tmp);
 
-    network_ifcfg = svOpenFile(network_file, NULL);
+    if (network_ifcfg_shared)
+        network_ifcfg = network_ifcfg_shared;
+    else
+        network_ifcfg = network_ifcfg_free = svOpenFile(network_file, NULL);
     /* we don't call svWarnInvalid(network_ifcfg), because we will load this file for
      * every profile. So we would get a large number of duplicate warnings. */
 
@@ -6831,11 +6836,18 @@ connection_from_file_full(const char *filename,
 
 NMConnection *
 connection_from_file(const char *filename,
+                     shvarFile  *network_ifcfg,
                      char      **out_unhandled,
                      GError    **error,
                      gboolean   *out_ignore_error)
 {
-    return connection_from_file_full(filename, NULL, NULL, out_unhandled, error, out_ignore_error);
+    return connection_from_file_full(filename,
+                                     network_ifcfg,
+                                     NULL,
+                                     NULL,
+                                     out_unhandled,
+                                     error,
+                                     out_ignore_error);
 }
 
 NMConnection *
@@ -6845,5 +6857,11 @@ nmtst_connection_from_file(const char *filename,
                            char      **out_unhandled,
                            GError    **error)
 {
-    return connection_from_file_full(filename, network_file, test_type, out_unhandled, error, NULL);
+    return connection_from_file_full(filename,
+                                     NULL,
+                                     network_file,
+                                     test_type,
+                                     out_unhandled,
+                                     error,
+                                     NULL);
 }
@@ -7,8 +7,10 @@
 #define __NMS_IFCFG_RH_READER_H__
 
 #include "nm-connection.h"
+#include "shvar.h"
 
 NMConnection *connection_from_file(const char *filename,
+                                   shvarFile  *network_ifcfg,
                                    char      **out_unhandled,
                                    GError    **error,
                                    gboolean   *out_ignore_error);
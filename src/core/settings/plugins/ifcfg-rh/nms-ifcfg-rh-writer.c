@@ -1465,6 +1465,17 @@ write_ethtool_setting(NMConnection *connection, shvarFile *ifcfg, GError **error
             }
         }
 
+        for (ethtool_id = _NM_ETHTOOL_ID_RSS_FIRST; ethtool_id <= _NM_ETHTOOL_ID_RSS_LAST;
+             ethtool_id++) {
+            if (nm_setting_option_get_uint32(NM_SETTING(s_ethtool),
+                                             nm_ethtool_data[ethtool_id]->optname,
+                                             &u32)) {
+                nm_sprintf_buf(prop_name, "ethtool.%s", nm_ethtool_data[ethtool_id]->optname);
+                set_error_unsupported(error, connection, prop_name, FALSE);
+                return FALSE;
+            }
+        }
+
         if (!any_option) {
             /* Write an empty dummy "-A" option without arguments. This is to
              * ensure that the reader will create an (all default) NMSettingEthtool.
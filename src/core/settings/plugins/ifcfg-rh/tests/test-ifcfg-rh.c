@@ -3624,7 +3624,7 @@ test_roundtrip_ethtool(void)
             vtype   = nm_ethtool_id_get_variant_type(ethtool_id);
 
             if (nm_ethtool_optname_is_channels(optname) || nm_ethtool_optname_is_eee(optname)
-                || nm_ethtool_optname_is_fec(optname)) {
+                || nm_ethtool_optname_is_fec(optname) || nm_ethtool_optname_is_rss(optname)) {
                 /* Not supported */
                 continue;
             }
@@ -10472,6 +10472,90 @@ test_ethtool_names(void)
 
 /*****************************************************************************/
 
+static void
+test_perf_read_write(void)
+{
+    const guint                  N_PROFILES  = nmtst_scale_get("NMTST_SCALE_PROFILES", 40, 10000);
+    const guint                  N_ROUTES    = nmtst_scale_get("NMTST_SCALE_ROUTES", 5, 50);
+    gs_unref_ptrarray GPtrArray *connections = NULL;
+    gs_unref_ptrarray GPtrArray *rereads     = NULL;
+    gs_unref_ptrarray GPtrArray *paths       = NULL;
+    gint64                       rss_start;
+    gint64                       rss_read;
+    gint64                       t_start;
+    gint64                       t_normalize;
+    gint64                       t_write;
+    gint64                       t_read;
+    guint                        i;
+
+    connections = g_ptr_array_new_with_free_func(g_object_unref);
+    rereads     = g_ptr_array_new_with_free_func(g_object_unref);
+    paths       = g_ptr_array_new_with_free_func(g_free);
+
+    for (i = 0; i < N_PROFILES; i++)
+        g_ptr_array_add(connections, nmtst_create_scale_connection(i, N_ROUTES));
+
+    t_start = nm_utils_get_monotonic_timestamp_nsec();
+    for (i = 0; i < N_PROFILES; i++) {
+        GError  *error = NULL;
+        gboolean success;
+
+        success = nm_connection_normalize(connections->pdata[i], NULL, NULL, &error);
+        nmtst_assert_success(success, error);
+    }
+    t_normalize = nm_utils_get_monotonic_timestamp_nsec() - t_start;
+
+    t_start = nm_utils_get_monotonic_timestamp_nsec();
+    for (i = 0; i < N_PROFILES; i++) {
+        GError  *error    = NULL;
+        char    *filename = NULL;
+        gboolean success;
+
+        success = nms_ifcfg_rh_writer_write_connection(connections->pdata[i],
+                                                       TEST_SCRATCH_DIR,
+                                                       NULL,
+                                                       NULL,
+                                                       NULL,
+                                                       &filename,
+                                                       NULL,
+                                                       NULL,
+                                                       &error);
+        nmtst_assert_success(success, error);
+        g_ptr_array_add(paths, filename);
+    }
+    t_write = nm_utils_get_monotonic_timestamp_nsec() - t_start;
+
+    rss_start = nmtst_get_rss_kib();
+    t_start   = nm_utils_get_monotonic_timestamp_nsec();
+    for (i = 0; i < N_PROFILES; i++)
+        g_ptr_array_add(rereads, _connection_from_file(paths->pdata[i], NULL, NULL, NULL));
+    t_read   = nm_utils_get_monotonic_timestamp_nsec() - t_start;
+    rss_read = nmtst_get_rss_kib();
+
+    g_test_message("ifcfg-rh: %u profiles with %u routes: normalize %" G_GINT64_FORMAT
+                   " msec, write %" G_GINT64_FORMAT " msec, read %" G_GINT64_FORMAT
+                   " msec, RSS +%" G_GINT64_FORMAT " KiB after read",
+                   N_PROFILES,
+                   N_ROUTES,
+                   t_normalize / NM_UTILS_NSEC_PER_MSEC,
+                   t_write / NM_UTILS_NSEC_PER_MSEC,
+                   t_read / NM_UTILS_NSEC_PER_MSEC,
+                   rss_read - rss_start);
+
+    for (i = 0; i < N_PROFILES; i++) {
+        const char   *filename   = paths->pdata[i];
+        gs_free char *route_path = utils_get_route_path(filename);
+        gs_free char *keys_path  = utils_get_keys_path(filename);
+
+        nmtst_assert_connection_equals(connections->pdata[i], TRUE, rereads->pdata[i], FALSE);
+        nmtst_file_unlink(filename);
+        nmtst_file_unlink_if_exists(route_path);
+        nmtst_file_unlink_if_exists(keys_path);
+    }
+}
+
+/*****************************************************************************/
+
 #define TPATH "/settings/plugins/ifcfg-rh/"
 
 #define TEST_IFCFG_WIFI_OPEN_SSID_LONG_QUOTED \
@@ -10969,5 +11053,7 @@ main(int argc, char **argv)
 
     g_test_add_func(TPATH "utils/test_ethtool_names", test_ethtool_names);
 
+    g_test_add_func(TPATH "perf/read-write", test_perf_read_write);
+
     return g_test_run();
 }
@@ -0,0 +1,266 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+/*
+ * Copyright (C) 2026 Red Hat, Inc.
+ */
+
+#include "src/core/nm-default-daemon.h"
+
+#include "nms-keyfile-cache.h"
+
+#include "libnm-glib-aux/nm-io-utils.h"
+#include "libnm-glib-aux/nm-uuid.h"
+#include "libnm-core-intern/nm-core-internal.h"
+
+#if !defined(NM_DIST_VERSION)
+#define NM_DIST_VERSION VERSION
+#endif
+
+/*****************************************************************************/
+
+/* The cache is a serialized GVariant, so that it can be used directly from
+ * the mmap'ed file. For each keyfile, it contains the path, the device,
+ * inode, size and modification time of the file, the values from the
+ * [.nmmeta] group and the normalized connection (serialized like for D-Bus,
+ * including secrets). The cache is only valid for the NetworkManager version
+ * that wrote it. */
+#define ENTRY_TYPE     "(sttttiiiisa{sa{sv}})"
+#define ENTRY_TYPE_GET "(&sttttiiii&s@a{sa{sv}})"
+#define CACHE_TYPE     "(sa" ENTRY_TYPE ")"
+
+struct _NMSKeyfileCache {
+    /* full filename -> GVariant entry */
+    GHashTable *idx;
+};
+
+/*****************************************************************************/
+
+static guint64
+_stat_mtime_nsec(const struct stat *st)
+{
+    return (((guint64) st->st_mtim.tv_sec) * NM_UTILS_NSEC_PER_SEC) + st->st_mtim.tv_nsec;
+}
+
+static NMTernary
+_ternary_from_int(gint32 v)
+{
+    return v < 0 ? NM_TERNARY_DEFAULT : (v > 0 ? NM_TERNARY_TRUE : NM_TERNARY_FALSE);
+}
+
+/*****************************************************************************/
+
+/**
+ * nms_keyfile_cache_load:
+ * @filename: the cache file
+ *
+ * Returns: the cache, or %NULL if the file does not exist or was written
+ *   by another version.
+ */
+NMSKeyfileCache *
+nms_keyfile_cache_load(const char *filename)
+{
+    gs_unref_bytes GBytes     *bytes   = NULL;
+    gs_unref_variant GVariant *variant = NULL;
+    gs_unref_variant GVariant *entries = NULL;
+    NMSKeyfileCache           *cache;
+    GMappedFile               *mapped;
+    const char                *version;
+    gsize                      n;
+    gsize                      i;
+
+    mapped = g_mapped_file_new(filename, FALSE, NULL);
+    if (!mapped)
+        return NULL;
+
+    bytes = g_mapped_file_get_bytes(mapped);
+    g_mapped_file_unref(mapped);
+
+    variant =
+        g_variant_ref_sink(g_variant_new_from_bytes(G_VARIANT_TYPE(CACHE_TYPE), bytes, FALSE));
+
+    g_variant_get(variant, "(&s@a" ENTRY_TYPE ")", &version, &entries);
+    if (!nm_streq(version, NM_DIST_VERSION))
+        return NULL;
+
+    cache = g_slice_new(NMSKeyfileCache);
+
+    cache->idx =
+        g_hash_table_new_full(nm_str_hash, g_str_equal, NULL, (GDestroyNotify) g_variant_unref);
+
+    n = g_variant_n_children(entries);
+    for (i = 0; i < n; i++) {
+        GVariant   *entry = g_variant_get_child_value(entries, i);
+        const char *path;
+
+        g_variant_get_child(entry, 0, "&s", &path);
+
+        /* the key is owned by the entry. Replace it together with the value. */
+        g_hash_table_replace(cache->idx, (char *) path, entry);
+    }
+
+    return cache;
+}
+
+void
+nms_keyfile_cache_free(NMSKeyfileCache *cache)
+{
+    if (!cache)
+        return;
+
+    g_hash_table_unref(cache->idx);
+    nm_g_slice_free(cache);
+}
+
+guint
+nms_keyfile_cache_get_n_entries(const NMSKeyfileCache *cache)
+{
+    return cache ? g_hash_table_size(cache->idx) : 0u;
+}
+
+GVariant *
+nms_keyfile_cache_lookup(const NMSKeyfileCache *cache, const char *full_filename)
+{
+    if (!cache)
+        return NULL;
+
+    return g_hash_table_lookup(cache->idx, full_filename);
+}
+
+/**
+ * nms_keyfile_cache_entry_get_connection:
+ * @entry: the cache entry from nms_keyfile_cache_lookup()
+ * @st: the current stat information of the keyfile
+ * @out_is_nm_generated: (out) (optional):
+ * @out_is_volatile: (out) (optional):
+ * @out_is_external: (out) (optional):
+ * @out_shadowed_storage: (out) (optional) (transfer full):
+ * @out_shadowed_owned: (out) (optional):
+ *
+ * This is the counterpart of nms_keyfile_reader_from_file(). It is thread-safe.
+ *
+ * Returns: (transfer full): the cached connection, or %NULL if the file was
+ *   modified or the cached connection is invalid.
+ */
+NMConnection *
+nms_keyfile_cache_entry_get_connection(GVariant          *entry,
+                                       const struct stat *st,
+                                       NMTernary         *out_is_nm_generated,
+                                       NMTernary         *out_is_volatile,
+                                       NMTernary         *out_is_external,
+                                       char             **out_shadowed_storage,
+                                       NMTernary         *out_shadowed_owned)
+{
+    gs_unref_variant GVariant *settings = NULL;
+    NMConnection              *connection;
+    const char                *path;
+    const char                *shadowed_storage;
+    guint64                    dev;
+    guint64                    ino;
+    guint64                    size;
+    guint64                    mtime_nsec;
+    gint32                     is_nm_generated;
+    gint32                     is_volatile;
+    gint32                     is_external;
+    gint32                     shadowed_owned;
+
+    g_variant_get(entry,
+                  ENTRY_TYPE_GET,
+                  &path,
+                  &dev,
+                  &ino,
+                  &size,
+                  &mtime_nsec,
+                  &is_nm_generated,
+                  &is_volatile,
+                  &is_external,
+                  &shadowed_owned,
+                  &shadowed_storage,
+                  &settings);
+
+    if (dev != (guint64) st->st_dev || ino != (guint64) st->st_ino
+        || size != (guint64) st->st_size || mtime_nsec != _stat_mtime_nsec(st))
+        return NULL;
+
+    connection = _nm_simple_connection_new_from_dbus(settings,
+                                                     NM_SETTING_PARSE_FLAGS_STRICT
+                                                         | NM_SETTING_PARSE_FLAGS_NORMALIZE,
+                                                     NULL);
+    if (!connection)
+        return NULL;
+
+    if (!nm_uuid_is_normalized(nm_connection_get_uuid(connection))) {
+        g_object_unref(connection);
+        return NULL;
+    }
+
+    NM_SET_OUT(out_is_nm_generated, _ternary_from_int(is_nm_generated));
+    NM_SET_OUT(out_is_volatile, _ternary_from_int(is_volatile));
+    NM_SET_OUT(out_is_external, _ternary_from_int(is_external));
+    NM_SET_OUT(out_shadowed_storage, shadowed_storage[0] ? g_strdup(shadowed_storage) : NULL);
+    NM_SET_OUT(out_shadowed_owned, _ternary_from_int(shadowed_owned));
+    return connection;
+}
+
+/**
+ * nms_keyfile_cache_entry_new:
+ *
+ * Returns: (transfer full): a new cache entry for the keyfile @full_filename
+ *   with the normalized @connection, as read by nms_keyfile_reader_from_file().
+ */
+GVariant *
+nms_keyfile_cache_entry_new(const char        *full_filename,
+                            const struct stat *st,
+                            NMConnection      *connection,
+                            NMTernary          is_nm_generated,
+                            NMTernary          is_volatile,
+                            NMTernary          is_external,
+                            const char        *shadowed_storage,
+                            NMTernary          shadowed_owned)
+{
+    return g_variant_ref_sink(
+        g_variant_new("(sttttiiiis@a{sa{sv}})",
+                      full_filename,
+                      (guint64) st->st_dev,
+                      (guint64) st->st_ino,
+                      (guint64) st->st_size,
+                      _stat_mtime_nsec(st),
+                      (gint32) is_nm_generated,
+                      (gint32) is_volatile,
+                      (gint32) is_external,
+                      (gint32) shadowed_owned,
+                      shadowed_storage ?: "",
+                      nm_connection_to_dbus(connection, NM_CONNECTION_SERIALIZE_ALL)));
+}
+
+/**
+ * nms_keyfile_cache_write:
+ * @filename: the cache file
+ * @entries: the cache entries from nms_keyfile_cache_entry_new()
+ *   or nms_keyfile_cache_lookup().
+ * @error: the error location
+ *
+ * Writes the cache. As it contains secrets, the file is only
+ * readable by the owner.
+ *
+ * Returns: %TRUE on success.
+ */
+gboolean
+nms_keyfile_cache_write(const char *filename, GPtrArray *entries, GError **error)
+{
+    gs_unref_variant GVariant *variant = NULL;
+
+    variant = g_variant_ref_sink(
+        g_variant_new("(s@a" ENTRY_TYPE ")",
+                      NM_DIST_VERSION,
+                      g_variant_new_array(G_VARIANT_TYPE(ENTRY_TYPE),
+                                          (GVariant *const *) entries->pdata,
+                                          entries->len)));
+
+    return nm_utils_file_set_contents(filename,
+                                      g_variant_get_data(variant),
+                                      g_variant_get_size(variant),
+                                      0600,
+                                      NULL,
+                                      NULL,
+                                      NULL,
+                                      error);
+}
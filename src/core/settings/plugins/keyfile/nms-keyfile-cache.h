@@ -0,0 +1,49 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+/*
+ * Copyright (C) 2026 Red Hat, Inc.
+ */
+
+#ifndef __NMS_KEYFILE_CACHE_H__
+#define __NMS_KEYFILE_CACHE_H__
+
+#include <sys/stat.h>
+
+#define NMS_KEYFILE_CACHE_FILENAME NMSTATEDIR "/keyfile-cache"
+
+/* Written by nm-initrd-generator for the profiles it creates in /run. It is
+ * only read, never updated by NetworkManager. */
+#define NMS_KEYFILE_CACHE_FILENAME_INITRD NMRUNDIR "/initrd/keyfile-cache"
+
+typedef struct _NMSKeyfileCache NMSKeyfileCache;
+
+NMSKeyfileCache *nms_keyfile_cache_load(const char *filename);
+
+void nms_keyfile_cache_free(NMSKeyfileCache *cache);
+
+NM_AUTO_DEFINE_FCN0(NMSKeyfileCache *, _nm_auto_free_keyfile_cache, nms_keyfile_cache_free);
+#define nm_auto_free_keyfile_cache nm_auto(_nm_auto_free_keyfile_cache)
+
+guint nms_keyfile_cache_get_n_entries(const NMSKeyfileCache *cache);
+
+GVariant *nms_keyfile_cache_lookup(const NMSKeyfileCache *cache, const char *full_filename);
+
+NMConnection *nms_keyfile_cache_entry_get_connection(GVariant          *entry,
+                                                     const struct stat *st,
+                                                     NMTernary         *out_is_nm_generated,
+                                                     NMTernary         *out_is_volatile,
+                                                     NMTernary         *out_is_external,
+                                                     char             **out_shadowed_storage,
+                                                     NMTernary         *out_shadowed_owned);
+
+GVariant *nms_keyfile_cache_entry_new(const char        *full_filename,
+                                      const struct stat *st,
+                                      NMConnection      *connection,
+                                      NMTernary          is_nm_generated,
+                                      NMTernary          is_volatile,
+                                      NMTernary          is_external,
+                                      const char        *shadowed_storage,
+                                      NMTernary          shadowed_owned);
+
+gboolean nms_keyfile_cache_write(const char *filename, GPtrArray *entries, GError **error);
+
+#endif /* __NMS_KEYFILE_CACHE_H__ */
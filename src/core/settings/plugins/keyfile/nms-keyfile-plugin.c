@@ -30,6 +30,7 @@
 #include "settings/nm-settings-storage.h"
 #include "settings/nm-settings-utils.h"
 
+#include "nms-keyfile-cache.h"
 #include "nms-keyfile-storage.h"
 #include "nms-keyfile-writer.h"
 #include "nms-keyfile-reader.h"
@@ -125,9 +126,20 @@ _extra_flags_to_string(char    *str,
     return str0;
 }
 
+static gboolean
+_is_template_filename(const char *filename)
+{
+    return filename[0] != '.'
+           && NM_STR_HAS_SUFFIX_WITH_MORE(filename, NMS_KEYFILE_PATH_SUFFIX_NMTEMPLATE);
+}
+
 static gboolean
 _ignore_filename(NMSKeyfileStorageType storage_type, const char *filename)
 {
+    /* templates are not keyfiles. They get expanded by _load_dir(). */
+    if (_is_template_filename(filename))
+        return TRUE;
+
     /* for backward-compatibility, we don't require an extension for
      * files under "/etc/...". */
     return nm_keyfile_utils_ignore_filename(filename,
@@ -237,6 +249,100 @@ _read_from_file(const char  *full_filename,
     return connection;
 }
 
+/* Reading and parsing a keyfile is independent from the plugin state, and
+ * only _read_from_file() is called from the worker threads. The storages
+ * are created afterwards on the main thread, in the order of the directory
+ * listing. Only use threads for directories with many files. */
+#define LOAD_DIR_THREADED_MIN_FILES 32
+#define LOAD_DIR_MAX_THREADS        8
+
+typedef struct {
+    const char   *plugin_dir;
+    char         *full_filename;
+    GVariant     *cache_entry;
+    NMConnection *connection;
+    char         *shadowed_storage;
+    GError       *error;
+    struct stat   st;
+    NMTernary     is_nm_generated_opt;
+    NMTernary     is_volatile_opt;
+    NMTernary     is_external_opt;
+    NMTernary     shadowed_owned_opt;
+    bool          from_cache : 1;
+    bool          unchanged : 1;
+} LoadFileData;
+
+typedef struct {
+    NMSKeyfileCache *cache;
+
+    /* the entries for the new cache file, or %NULL if the cache
+     * is only read. */
+    GPtrArray *entries;
+
+    guint n_hits;
+} LoadCacheData;
+
+static void
+_load_file_data_read(LoadFileData *data)
+{
+    if (data->cache_entry
+        && nms_keyfile_utils_check_file_permissions(NMS_KEYFILE_FILETYPE_KEYFILE,
+                                                    data->full_filename,
+                                                    &data->st,
+                                                    NULL)) {
+        data->connection = nms_keyfile_cache_entry_get_connection(data->cache_entry,
+                                                                  &data->st,
+                                                                  &data->is_nm_generated_opt,
+                                                                  &data->is_volatile_opt,
+                                                                  &data->is_external_opt,
+                                                                  &data->shadowed_storage,
+                                                                  &data->shadowed_owned_opt);
+        if (data->connection) {
+            data->from_cache = TRUE;
+            return;
+        }
+    }
+
+    data->connection = _read_from_file(data->full_filename,
+                                       data->plugin_dir,
+                                       &data->st,
+                                       &data->is_nm_generated_opt,
+                                       &data->is_volatile_opt,
+                                       &data->is_external_opt,
+                                       &data->shadowed_storage,
+                                       &data->shadowed_owned_opt,
+                                       &data->error);
+}
+
+static void
+_load_file_data_add_cache_entry(LoadFileData *data, LoadCacheData *cache_data)
+{
+    if (data->from_cache) {
+        g_ptr_array_add(cache_data->entries, g_variant_ref(data->cache_entry));
+        cache_data->n_hits++;
+        return;
+    }
+
+    g_ptr_array_add(cache_data->entries,
+                    nms_keyfile_cache_entry_new(data->full_filename,
+                                                &data->st,
+                                                data->connection,
+                                                data->is_nm_generated_opt,
+                                                data->is_volatile_opt,
+                                                data->is_external_opt,
+                                                data->shadowed_storage,
+                                                data->shadowed_owned_opt));
+}
+
+static void
+_load_file_data_clear(LoadFileData *data)
+{
+    nm_clear_g_free(&data->full_filename);
+    g_clear_object(&data->connection);
+    nm_clear_g_free(&data->shadowed_storage);
+    g_clear_error(&data->error);
+}
+
 /*****************************************************************************/
 
 static void
@@ -291,6 +397,38 @@ _nm_assert_storage(gpointer plugin /* NMSKeyfilePlugin  */,
 
 /*****************************************************************************/
 
+static NMSKeyfileStorage *
+_load_file_data_to_storage(NMSKeyfilePlugin     *self,
+                           LoadFileData         *data,
+                           NMSKeyfileStorageType storage_type,
+                           GError              **error)
+{
+    NMSKeyfileStorage *storage;
+
+    if (!data->connection) {
+        if (error)
+            g_propagate_error(error, g_steal_pointer(&data->error));
+        else
+            _LOGW("load: \"%s\": failed to load connection: %s",
+                  data->full_filename,
+                  data->error->message);
+        return NULL;
+    }
+
+    storage = nms_keyfile_storage_new_connection(self,
+                                                 g_steal_pointer(&data->connection),
+                                                 data->full_filename,
+                                                 storage_type,
+                                                 data->is_nm_generated_opt,
+                                                 data->is_volatile_opt,
+                                                 data->is_external_opt,
+                                                 data->shadowed_storage,
+                                                 data->shadowed_owned_opt,
+                                                 &data->st.st_mtim);
+    nms_keyfile_storage_set_stat_id(storage, &data->st);
+    return storage;
+}
+
 static NMSKeyfileStorage *
 _load_file(NMSKeyfilePlugin     *self,
            const char           *dirname,
@@ -298,16 +436,8 @@ _load_file(NMSKeyfilePlugin     *self,
            NMSKeyfileStorageType storage_type,
            GError              **error)
 {
-    NMSKeyfilePluginPrivate      *priv;
-    gs_unref_object NMConnection *connection = NULL;
-    NMTernary                     is_nm_generated_opt;
-    NMTernary                     is_volatile_opt;
-    NMTernary                     is_external_opt;
-    NMTernary                     shadowed_owned_opt;
-    gs_free char                 *shadowed_storage = NULL;
-    gs_free_error GError         *local            = NULL;
-    gs_free char                 *full_filename    = NULL;
-    struct stat                   st;
+    nm_auto(_load_file_data_clear) LoadFileData data          = {};
+    gs_free char                               *full_filename = NULL;
 
     if (_ignore_filename(storage_type, filename)) {
         gs_free char *nmmeta                    = NULL;
@@ -367,37 +497,13 @@ _load_file(NMSKeyfilePlugin     *self,
                                                  shadowed_storage_filename);
     }
 
-    full_filename = g_build_filename(dirname, filename, NULL);
+    data = (LoadFileData){
+        .plugin_dir    = _get_plugin_dir(NMS_KEYFILE_PLUGIN_GET_PRIVATE(self)),
+        .full_filename = g_build_filename(dirname, filename, NULL),
+    };
 
-    priv = NMS_KEYFILE_PLUGIN_GET_PRIVATE(self);
-
-    connection = _read_from_file(full_filename,
-                                 _get_plugin_dir(priv),
-                                 &st,
-                                 &is_nm_generated_opt,
-                                 &is_volatile_opt,
-                                 &is_external_opt,
-                                 &shadowed_storage,
-                                 &shadowed_owned_opt,
-                                 &local);
-    if (!connection) {
-        if (error)
-            g_propagate_error(error, g_steal_pointer(&local));
-        else
-            _LOGW("load: \"%s\": failed to load connection: %s", full_filename, local->message);
-        return NULL;
-    }
-
-    return nms_keyfile_storage_new_connection(self,
-                                              g_steal_pointer(&connection),
-                                              full_filename,
-                                              storage_type,
-                                              is_nm_generated_opt,
-                                              is_volatile_opt,
-                                              is_external_opt,
-                                              shadowed_storage,
-                                              shadowed_owned_opt,
-                                              &st.st_mtim);
+    _load_file_data_read(&data);
+    return _load_file_data_to_storage(self, &data, storage_type, error);
 }
 
 static NMSKeyfileStorage *
@@ -418,38 +524,204 @@ _load_file_from_path(NMSKeyfilePlugin     *self,
     return _load_file(self, f_dirname, f_filename, storage_type, error);
 }
 
+/* The profiles of a template are read-only, like the ones from /usr/lib. To
+ * modify one, NMSettings writes it to /etc, where it shadows the generated
+ * profile. Likewise, deleting one creates a tombstone. */
+static void
+_load_template(NMSKeyfilePlugin     *self,
+               const char           *dirname,
+               const char           *filename,
+               NMSKeyfileStorageType storage_type,
+               NMSettUtilStorages   *storages)
+{
+    gs_free_error GError        *error         = NULL;
+    gs_free char                *full_filename = NULL;
+    gs_unref_ptrarray GPtrArray *connections   = NULL;
+    gs_unref_ptrarray GPtrArray *filenames     = NULL;
+    struct stat                  st;
+    guint                        i;
+
+    if (storage_type < NMS_KEYFILE_STORAGE_TYPE_LIB_BASE)
+        storage_type = NMS_KEYFILE_STORAGE_TYPE_LIB(0);
+
+    full_filename = g_build_filename(dirname, filename, NULL);
+    connections   =
+        nms_keyfile_reader_from_template(full_filename,
+                                         _get_plugin_dir(NMS_KEYFILE_PLUGIN_GET_PRIVATE(self)),
+                                         &st,
+                                         &filenames,
+                                         &error);
+    if (!connections) {
+        _LOGW("load: \"%s\": failed to load template: %s", full_filename, error->message);
+        return;
+    }
+
+    _LOGT("load: \"%s\": template with %u profiles", full_filename, connections->len);
+
+    for (i = 0; i < connections->len; i++) {
+        NMSKeyfileStorage *storage;
+
+        storage = nms_keyfile_storage_new_connection(self,
+                                                     g_object_ref(connections->pdata[i]),
+                                                     filenames->pdata[i],
+                                                     storage_type,
+                                                     NM_TERNARY_DEFAULT,
+                                                     NM_TERNARY_DEFAULT,
+                                                     NM_TERNARY_DEFAULT,
+                                                     NULL,
+                                                     NM_TERNARY_DEFAULT,
+                                                     &st.st_mtim);
+        nm_sett_util_storages_add_take(storages, storage);
+    }
+}
+
+static void
+_load_dir_read_cb(gpointer data, gpointer user_data)
+{
+    _load_file_data_read(data);
+}
+
+static void
+_load_dir_read_all(LoadFileData *datas, guint n_datas, guint n_read)
+{
+    GThreadPool *pool = NULL;
+    guint        n_threads;
+    guint        i;
+
+    n_threads = NM_MIN(g_get_num_processors(), (guint) LOAD_DIR_MAX_THREADS);
+    if (n_read >= LOAD_DIR_THREADED_MIN_FILES && n_threads > 1)
+        pool = g_thread_pool_new(_load_dir_read_cb, NULL, n_threads, TRUE, NULL);
+
+    for (i = 0; i < n_datas; i++) {
+        if (!datas[i].full_filename || datas[i].unchanged)
+            continue;
+        if (pool)
+            g_thread_pool_push(pool, &datas[i], NULL);
+        else
+            _load_file_data_read(&datas[i]);
+    }
+
+    if (pool) {
+        /* wait for all files to be read. */
+        g_thread_pool_free(pool, FALSE, TRUE);
+    }
+}
+
+static NMSKeyfileStorage *
+_load_dir_lookup_unchanged(NMSKeyfilePlugin *self, LoadFileData *data, LoadCacheData *cache_data)
+{
+    NMSKeyfilePluginPrivate *priv = NMS_KEYFILE_PLUGIN_GET_PRIVATE(self);
+    NMSKeyfileStorage       *storage_old;
+    struct stat              st;
+
+    storage_old = nm_sett_util_storages_lookup_by_filename(&priv->storages, data->full_filename);
+    if (!storage_old || storage_old->is_meta_data || !storage_old->u.conn_data.has_stat_id)
+        return NULL;
+
+    /* the cache file is rewritten from the files we read. Without an entry
+     * for this file, we need to read it again. */
+    if (cache_data && cache_data->entries && !data->cache_entry)
+        return NULL;
+
+    if (stat(data->full_filename, &st) != 0)
+        return NULL;
+
+    if (!nms_keyfile_storage_stat_id_equal(storage_old, &st))
+        return NULL;
+
+    if (cache_data && cache_data->entries) {
+        g_ptr_array_add(cache_data->entries, g_variant_ref(data->cache_entry));
+        cache_data->n_hits++;
+    }
+
+    _LOGT("load: \"%s\": file unchanged", data->full_filename);
+    return storage_old;
+}
+
 static void
 _load_dir(NMSKeyfilePlugin     *self,
           NMSKeyfileStorageType storage_type,
           const char           *dirname,
-          NMSettUtilStorages   *storages)
+          NMSettUtilStorages   *storages,
+          GHashTable           *storages_unchanged,
+          LoadCacheData        *cache_data)
 {
     const char                    *filename;
     GDir                          *dir;
     gs_unref_hashtable GHashTable *dupl_filenames = NULL;
+    gs_unref_ptrarray GPtrArray   *filenames      = NULL;
+    gs_free LoadFileData          *datas          = NULL;
+    NMSKeyfileStorage             *storage_old;
+    const char                    *plugin_dir;
+    guint                          n_read = 0;
+    guint                          i;
 
     dir = g_dir_open(dirname, 0, NULL);
     if (!dir)
         return;
 
     dupl_filenames = g_hash_table_new_full(nm_str_hash, g_str_equal, NULL, g_free);
+    filenames      = g_ptr_array_new();
 
     while ((filename = g_dir_read_name(dir))) {
-        gs_unref_object NMSKeyfileStorage *storage = NULL;
-
         filename = g_strdup(filename);
         if (!g_hash_table_add(dupl_filenames, (char *) filename))
             continue;
+        g_ptr_array_add(filenames, (char *) filename);
+    }
+
+    g_dir_close(dir);
+
+    plugin_dir = _get_plugin_dir(NMS_KEYFILE_PLUGIN_GET_PRIVATE(self));
+    datas      = g_new0(LoadFileData, filenames->len);
+
+    /* nmmeta files and templates get handled below. For the keyfiles, read
+     * and parse them first, possibly in parallel. */
+    for (i = 0; i < filenames->len; i++) {
+        if (_ignore_filename(storage_type, filenames->pdata[i]))
+            continue;
+        datas[i].plugin_dir    = plugin_dir;
+        datas[i].full_filename = g_build_filename(dirname, filenames->pdata[i], NULL);
+        if (cache_data)
+            datas[i].cache_entry =
+                nms_keyfile_cache_lookup(cache_data->cache, datas[i].full_filename);
+        storage_old = _load_dir_lookup_unchanged(self, &datas[i], cache_data);
+        if (storage_old) {
+            datas[i].unchanged = TRUE;
+            g_hash_table_add(storages_unchanged, storage_old);
+            continue;
+        }
+        n_read++;
+    }
+
+    _load_dir_read_all(datas, filenames->len, n_read);
+
+    for (i = 0; i < filenames->len; i++) {
+        gs_unref_object NMSKeyfileStorage *storage = NULL;
+
+        if (datas[i].unchanged) {
+            /* keep the tracked storage. */
+        } else if (datas[i].full_filename) {
+            if (!cache_data || !datas[i].connection) {
+                /* nothing to do. */
+            } else if (cache_data->entries)
+                _load_file_data_add_cache_entry(&datas[i], cache_data);
+            else if (datas[i].from_cache)
+                cache_data->n_hits++;
+            storage = _load_file_data_to_storage(self, &datas[i], storage_type, NULL);
+        } else if (_is_template_filename(filenames->pdata[i]))
+            _load_template(self, dirname, filenames->pdata[i], storage_type, storages);
+        else
+            storage = _load_file(self, dirname, filenames->pdata[i], storage_type, NULL);
+
+        _load_file_data_clear(&datas[i]);
 
-        storage = _load_file(self, dirname, filename, storage_type, NULL);
         if (!storage)
             continue;
 
         nm_sett_util_storages_add_take(storages, g_steal_pointer(&storage));
     }
 
-    g_dir_close(dir);
-
 #if NM_MORE_ASSERTS
     {
         NMSKeyfileStorage *storage;
@@ -467,6 +739,7 @@ _storages_consolidate(NMSKeyfilePlugin                      *self,
                       NMSettUtilStorages                    *storages_new,
                       gboolean                               replace_all,
                       GHashTable                            *storages_replaced,
+                      GHashTable                            *storages_unchanged,
                       NMSettingsPluginConnectionLoadCallback callback,
                       gpointer                               user_data)
 {
@@ -484,7 +757,8 @@ _storages_consolidate(NMSKeyfilePlugin                      *self,
     c_list_init(&storages_deleted);
 
     c_list_for_each_entry (storage_old, &priv->storages._storage_lst_head, parent._storage_lst)
-        storage_old->is_dirty = TRUE;
+        storage_old->is_dirty = !storages_unchanged
+                                || !g_hash_table_contains(storages_unchanged, storage_old);
 
     c_list_for_each_entry_safe (storage_new,
                                 storage_safe,
@@ -582,15 +856,91 @@ reload_connections(NMSettingsPlugin                      *plugin,
     NMSKeyfilePluginPrivate                            *priv = NMS_KEYFILE_PLUGIN_GET_PRIVATE(self);
     nm_auto_clear_sett_util_storages NMSettUtilStorages storages_new =
         NM_SETT_UTIL_STORAGES_INIT(storages_new, nms_keyfile_storage_destroy);
-    int i;
+    nm_auto_free_keyfile_cache NMSKeyfileCache         *cache              = NULL;
+    nm_auto_free_keyfile_cache NMSKeyfileCache         *cache_initrd       = NULL;
+    gs_unref_ptrarray GPtrArray                        *cache_entries      = NULL;
+    gs_unref_hashtable GHashTable                      *storages_unchanged = NULL;
+    LoadCacheData                                       cache_data_stack;
+    LoadCacheData                                      *cache_data = NULL;
+    LoadCacheData                                       cache_data_initrd;
+    int                                                 i;
+
+    if (nm_config_data_get_value_boolean(NM_CONFIG_GET_DATA,
+                                         NM_CONFIG_KEYFILE_GROUP_KEYFILE,
+                                         NM_CONFIG_KEYFILE_KEY_KEYFILE_CONNECTION_CACHE,
+                                         FALSE)) {
+        cache            = nms_keyfile_cache_load(NMS_KEYFILE_CACHE_FILENAME);
+        cache_entries    = g_ptr_array_new_with_free_func((GDestroyNotify) g_variant_unref);
+        cache_data_stack = (LoadCacheData){
+            .cache   = cache,
+            .entries = cache_entries,
+        };
+        cache_data = &cache_data_stack;
+    } else {
+        /* don't leave stale profiles (and secrets) around. */
+        (void) unlink(NMS_KEYFILE_CACHE_FILENAME);
+    }
 
-    _load_dir(self, NMS_KEYFILE_STORAGE_TYPE_RUN, priv->dirname_run, &storages_new);
+    /* files that did not change since we last read them are not read again,
+     * and no events are raised for them. */
+    storages_unchanged = g_hash_table_new(nm_direct_hash, NULL);
+
+    /* Profiles in /run don't survive a reboot, so they are not cached. But
+     * nm-initrd-generator writes the profiles it creates there together with
+     * a cache, so that we don't need to parse them again during early boot. */
+    cache_initrd      = nms_keyfile_cache_load(NMS_KEYFILE_CACHE_FILENAME_INITRD);
+    cache_data_initrd = (LoadCacheData){
+        .cache = cache_initrd,
+    };
+    _load_dir(self,
+              NMS_KEYFILE_STORAGE_TYPE_RUN,
+              priv->dirname_run,
+              &storages_new,
+              storages_unchanged,
+              cache_initrd ? &cache_data_initrd : NULL);
+    if (cache_data_initrd.n_hits > 0)
+        _LOGD("cache: loaded %u profiles from \"%s\"",
+              cache_data_initrd.n_hits,
+              NMS_KEYFILE_CACHE_FILENAME_INITRD);
     if (priv->dirname_etc)
-        _load_dir(self, NMS_KEYFILE_STORAGE_TYPE_ETC, priv->dirname_etc, &storages_new);
+        _load_dir(self,
+                  NMS_KEYFILE_STORAGE_TYPE_ETC,
+                  priv->dirname_etc,
+                  &storages_new,
+                  storages_unchanged,
+                  cache_data);
     for (i = 0; priv->dirname_libs[i]; i++)
-        _load_dir(self, NMS_KEYFILE_STORAGE_TYPE_LIB(i), priv->dirname_libs[i], &storages_new);
+        _load_dir(self,
+                  NMS_KEYFILE_STORAGE_TYPE_LIB(i),
+                  priv->dirname_libs[i],
+                  &storages_new,
+                  storages_unchanged,
+                  cache_data);
+
+    if (g_hash_table_size(storages_unchanged) > 0)
+        _LOGD("load: %u profiles unchanged on disk", g_hash_table_size(storages_unchanged));
+
+    if (cache_data
+        && (cache_data->n_hits != cache_entries->len
+            || cache_data->n_hits != nms_keyfile_cache_get_n_entries(cache))) {
+        gs_free_error GError *error = NULL;
+
+        if (!nms_keyfile_cache_write(NMS_KEYFILE_CACHE_FILENAME, cache_entries, &error))
+            _LOGW("cache: failed to write \"%s\": %s", NMS_KEYFILE_CACHE_FILENAME, error->message);
+        else
+            _LOGD("cache: wrote %u profiles (%u unchanged) to \"%s\"",
+                  cache_entries->len,
+                  cache_data->n_hits,
+                  NMS_KEYFILE_CACHE_FILENAME);
+    }
 
-    _storages_consolidate(self, &storages_new, TRUE, NULL, callback, user_data);
+    _storages_consolidate(self,
+                          &storages_new,
+                          TRUE,
+                          NULL,
+                          storages_unchanged,
+                          callback,
+                          user_data);
 }
 
 static void
@@ -607,13 +957,42 @@ load_connections(NMSettingsPlugin                      *plugin,
     gs_unref_hashtable GHashTable *dupl_filenames    = NULL;
     gs_unref_hashtable GHashTable *storages_replaced = NULL;
     gs_unref_hashtable GHashTable *loaded_uuids      = NULL;
+    gs_free LoadFileData          *datas             = NULL;
     const char                    *loaded_uuid;
     GHashTableIter                 h_iter;
+    guint                          n_read = 0;
     gsize                          i;
 
     if (n_entries == 0)
         return;
 
+    /* Like _load_dir(), read and parse the keyfiles first, possibly in parallel.
+     * nmmeta files are handled by _load_file() below. */
+    datas = g_new0(LoadFileData, n_entries);
+    for (i = 0; i < n_entries; i++) {
+        const char *f_filename;
+        const char *f_dirname;
+        gboolean    is_nmmeta_file;
+
+        if (entries[i].handled)
+            continue;
+        if (!_path_detect_storage_type(entries[i].filename,
+                                       (const char *const *) priv->dirname_libs,
+                                       priv->dirname_etc,
+                                       priv->dirname_run,
+                                       NULL,
+                                       &f_dirname,
+                                       &f_filename,
+                                       &is_nmmeta_file,
+                                       NULL)
+            || is_nmmeta_file)
+            continue;
+        datas[i].plugin_dir    = _get_plugin_dir(priv);
+        datas[i].full_filename = g_build_filename(f_dirname, f_filename, NULL);
+        n_read++;
+    }
+    _load_dir_read_all(datas, n_entries, n_read);
+
     dupl_filenames = g_hash_table_new_full(nm_str_hash, g_str_equal, g_free, NULL);
 
     loaded_uuids = g_hash_table_new(nm_str_hash, g_str_equal);
@@ -674,7 +1053,10 @@ load_connections(NMSettingsPlugin                      *plugin,
         if (!g_hash_table_insert(dupl_filenames, g_steal_pointer(&full_filename_keep), entry))
             nm_assert_not_reached();
 
-        storage = _load_file(self, f_dirname, f_filename, storage_type, &local);
+        if (datas[i].full_filename)
+            storage = _load_file_data_to_storage(self, &datas[i], storage_type, &local);
+        else
+            storage = _load_file(self, f_dirname, f_filename, storage_type, &local);
         if (!storage) {
             if (nm_utils_file_stat(full_filename, NULL) == -ENOENT) {
                 NMSKeyfileStorage *storage2;
@@ -735,10 +1117,19 @@ load_connections(NMSettingsPlugin                      *plugin,
         }
     }
 
+    for (i = 0; i < n_entries; i++)
+        _load_file_data_clear(&datas[i]);
+
     nm_clear_pointer(&loaded_uuids, g_hash_table_destroy);
     nm_clear_pointer(&dupl_filenames, g_hash_table_destroy);
 
-    _storages_consolidate(self, &storages_new, FALSE, storages_replaced, callback, user_data);
+    _storages_consolidate(self,
+                          &storages_new,
+                          FALSE,
+                          storages_replaced,
+                          NULL,
+                          callback,
+                          user_data);
 }
 
 gboolean
@@ -980,6 +1371,7 @@ nms_keyfile_plugin_update_connection(NMSKeyfilePlugin   *self,
         storage->u.conn_data.is_external     = is_external;
         storage->u.conn_data.stat_mtime      = mtime;
         storage->u.conn_data.shadowed_owned  = shadowed_owned;
+        nms_keyfile_storage_set_stat_id(storage, NULL);
     } else {
         NMSKeyfileStorage *storage_new;
 
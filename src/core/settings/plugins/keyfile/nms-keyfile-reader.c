@@ -10,12 +10,21 @@
 #include <sys/stat.h>
 
 #include "libnm-core-intern/nm-keyfile-internal.h"
+#include "libnm-glib-aux/nm-uuid.h"
 
 #include "NetworkManagerUtils.h"
 #include "nms-keyfile-utils.h"
 
 /*****************************************************************************/
 
+/* nms_keyfile_reader_from_file() is also called from worker threads, while
+ * loading many profiles at once. Hence, we require locking from nm-logging.
+ * Indicate that by setting NM_THREAD_SAFE_ON_MAIN_THREAD to zero. */
+#undef NM_THREAD_SAFE_ON_MAIN_THREAD
+#define NM_THREAD_SAFE_ON_MAIN_THREAD 0
+
+/*****************************************************************************/
+
 static const char *
 _fmt_warn(const NMKeyfileHandlerData *handler_data, char **out_message)
 {
@@ -235,3 +244,208 @@ nms_keyfile_reader_from_file(const char  *full_filename,
 
     return connection;
 }
+
+/*****************************************************************************/
+
+static gboolean
+_template_parse_range(const char *str, gint64 *out_first, gint64 *out_last)
+{
+    gs_free char *str_free = NULL;
+    const char   *s;
+    gint64        first;
+    gint64        last;
+
+    s = strchr(str, '-');
+    if (s) {
+        first = _nm_utils_ascii_str_to_int64(nm_strndup_a(100, str, s - str, &str_free),
+                                             10,
+                                             0,
+                                             G_MAXINT32,
+                                             -1);
+        last  = _nm_utils_ascii_str_to_int64(&s[1], 10, 0, G_MAXINT32, -1);
+    } else {
+        first = _nm_utils_ascii_str_to_int64(str, 10, 0, G_MAXINT32, -1);
+        last  = first;
+    }
+
+    if (first < 0 || last < first)
+        return FALSE;
+
+    *out_first = first;
+    *out_last  = last;
+    return TRUE;
+}
+
+static NMConnection *
+_template_read_profile(const char        *profile_dir,
+                       const char *const *parts,
+                       const char        *uuid_ns,
+                       const char        *value,
+                       const char        *profile_filename,
+                       gboolean           verbose,
+                       GError           **error)
+{
+    nm_auto_unref_keyfile GKeyFile *key_file   = NULL;
+    gs_unref_object NMConnection   *connection = NULL;
+    gs_free char                   *data       = NULL;
+
+    key_file = g_key_file_new();
+    data     = g_strjoinv(value, (char **) parts);
+    if (!g_key_file_load_from_data(key_file, data, -1, G_KEY_FILE_NONE, error))
+        return NULL;
+
+    if (uuid_ns) {
+        gs_free char *uuid = nm_uuid_generate_from_strings_old(uuid_ns, value);
+
+        g_key_file_set_string(key_file,
+                              NM_SETTING_CONNECTION_SETTING_NAME,
+                              NM_SETTING_CONNECTION_UUID,
+                              uuid);
+    }
+
+    connection = nms_keyfile_reader_from_keyfile(key_file,
+                                                 profile_filename,
+                                                 NULL,
+                                                 profile_dir,
+                                                 verbose,
+                                                 error);
+    if (!connection)
+        return NULL;
+
+    if (!nm_connection_normalize(connection, NULL, NULL, error))
+        return NULL;
+
+    return g_steal_pointer(&connection);
+}
+
+/**
+ * nms_keyfile_reader_from_template:
+ * @full_filename: the absolute path of the ".nmtemplate" file.
+ * @profile_dir: the directory of the profiles, or %NULL.
+ * @out_stat: (out) (optional): the stat of the template file.
+ * @out_filenames: (out) (optional) (transfer full): the filenames of the
+ *   profiles.
+ * @error: the error reason.
+ *
+ * Reads a template and expands it into one profile for each value in
+ * the range. The profiles get the filename "$full_filename@$value", and
+ * their UUID is generated from that filename. If the template has a fixed
+ * "connection.uuid", the UUIDs are instead generated from that UUID and
+ * the value, so that they don't change when the template gets renamed.
+ *
+ * Returns: (transfer full): the normalized profiles, in the order of the
+ *   range, or %NULL on error. The template fails as a whole if one of the
+ *   profiles is invalid.
+ */
+GPtrArray *
+nms_keyfile_reader_from_template(const char  *full_filename,
+                                 const char  *profile_dir,
+                                 struct stat *out_stat,
+                                 GPtrArray  **out_filenames,
+                                 GError     **error)
+{
+    nm_auto_unref_keyfile GKeyFile *key_file    = NULL;
+    gs_unref_ptrarray GPtrArray    *connections = NULL;
+    gs_unref_ptrarray GPtrArray    *filenames   = NULL;
+    gs_strfreev char              **parts       = NULL;
+    gs_free char                   *range       = NULL;
+    gs_free char                   *uuid_ns     = NULL;
+    gs_free char                   *data        = NULL;
+    gint64                          first;
+    gint64                          last;
+    gint64                          v;
+
+    nm_assert(full_filename && full_filename[0] == '/');
+    nm_assert(!profile_dir || profile_dir[0] == '/');
+
+    if (!nms_keyfile_utils_check_file_permissions(NMS_KEYFILE_FILETYPE_KEYFILE,
+                                                  full_filename,
+                                                  out_stat,
+                                                  error))
+        return NULL;
+
+    key_file = g_key_file_new();
+    if (!g_key_file_load_from_file(key_file, full_filename, G_KEY_FILE_NONE, error))
+        return NULL;
+
+    range = g_key_file_get_string(key_file,
+                                  NMS_KEYFILE_GROUP_NMTEMPLATE,
+                                  NMS_KEYFILE_KEY_NMTEMPLATE_RANGE,
+                                  NULL);
+    if (!range || !_template_parse_range(range, &first, &last)) {
+        g_set_error(error,
+                    NM_SETTINGS_ERROR,
+                    NM_SETTINGS_ERROR_INVALID_CONNECTION,
+                    "invalid template: missing or invalid \"%s.%s\"",
+                    NMS_KEYFILE_GROUP_NMTEMPLATE,
+                    NMS_KEYFILE_KEY_NMTEMPLATE_RANGE);
+        return NULL;
+    }
+    if (last - first >= NMS_KEYFILE_NMTEMPLATE_MAX_PROFILES) {
+        g_set_error(error,
+                    NM_SETTINGS_ERROR,
+                    NM_SETTINGS_ERROR_INVALID_CONNECTION,
+                    "invalid template: range \"%s\" has more than %d values",
+                    range,
+                    NMS_KEYFILE_NMTEMPLATE_MAX_PROFILES);
+        return NULL;
+    }
+
+    g_key_file_remove_group(key_file, NMS_KEYFILE_GROUP_NMTEMPLATE, NULL);
+
+    uuid_ns = g_key_file_get_string(key_file,
+                                    NM_SETTING_CONNECTION_SETTING_NAME,
+                                    NM_SETTING_CONNECTION_UUID,
+                                    NULL);
+    if (uuid_ns && !strstr(uuid_ns, NMS_KEYFILE_NMTEMPLATE_PLACEHOLDER)) {
+        g_key_file_remove_key(key_file,
+                              NM_SETTING_CONNECTION_SETTING_NAME,
+                              NM_SETTING_CONNECTION_UUID,
+                              NULL);
+    } else
+        nm_clear_g_free(&uuid_ns);
+
+    /* The placeholder is replaced in the text of the keyfile. That way it
+     * works for all properties, regardless of their type. */
+    data  = g_key_file_to_data(key_file, NULL, NULL);
+    parts = g_strsplit(data, NMS_KEYFILE_NMTEMPLATE_PLACEHOLDER, -1);
+
+    connections = g_ptr_array_new_full(last - first + 1, g_object_unref);
+    filenames   = g_ptr_array_new_full(last - first + 1, g_free);
+
+    for (v = first; v <= last; v++) {
+        gs_free_error GError *local = NULL;
+        NMConnection         *connection;
+        char                 *profile_filename;
+        char                  value[30];
+
+        nm_sprintf_buf(value, "%" G_GINT64_FORMAT, v);
+
+        profile_filename = g_strdup_printf("%s@%s", full_filename, value);
+        g_ptr_array_add(filenames, profile_filename);
+
+        /* Only warn about unknown settings for the first profile, and not for
+         * each of them. */
+        connection = _template_read_profile(profile_dir,
+                                            (const char *const *) parts,
+                                            uuid_ns,
+                                            value,
+                                            profile_filename,
+                                            v == first,
+                                            &local);
+        if (!connection) {
+            g_set_error(error,
+                        NM_SETTINGS_ERROR,
+                        NM_SETTINGS_ERROR_INVALID_CONNECTION,
+                        "invalid profile for %s=%s: %s",
+                        NMS_KEYFILE_KEY_NMTEMPLATE_RANGE,
+                        value,
+                        local->message);
+            return NULL;
+        }
+        g_ptr_array_add(connections, connection);
+    }
+
+    NM_SET_OUT(out_filenames, g_steal_pointer(&filenames));
+    return g_steal_pointer(&connections);
+}
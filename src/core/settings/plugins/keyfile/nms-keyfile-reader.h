@@ -28,4 +28,10 @@ NMConnection *nms_keyfile_reader_from_file(const char  *full_filename,
                                            NMTernary   *out_shadowed_owned,
                                            GError     **error);
 
+GPtrArray *nms_keyfile_reader_from_template(const char  *full_filename,
+                                            const char  *profile_dir,
+                                            struct stat *out_stat,
+                                            GPtrArray  **out_filenames,
+                                            GError     **error);
+
 #endif /* __NMS_KEYFILE_READER_H__ */
@@ -60,6 +60,43 @@ nms_keyfile_storage_steal_connection(NMSKeyfileStorage *self)
     return self->is_meta_data ? NULL : g_steal_pointer(&self->u.conn_data.connection);
 }
 
+void
+nms_keyfile_storage_set_stat_id(NMSKeyfileStorage *self, const struct stat *st)
+{
+    nm_assert(NMS_IS_KEYFILE_STORAGE(self));
+    nm_assert(!self->is_meta_data);
+
+    if (!st) {
+        self->u.conn_data.has_stat_id = FALSE;
+        return;
+    }
+
+    self->u.conn_data.has_stat_id   = TRUE;
+    self->u.conn_data.stat_id.dev   = st->st_dev;
+    self->u.conn_data.stat_id.ino   = st->st_ino;
+    self->u.conn_data.stat_id.size  = st->st_size;
+    self->u.conn_data.stat_id.ctime = st->st_ctim;
+}
+
+gboolean
+nms_keyfile_storage_stat_id_equal(const NMSKeyfileStorage *self, const struct stat *st)
+{
+    nm_assert(NMS_IS_KEYFILE_STORAGE(self));
+    nm_assert(st);
+
+    /* a change of content, ownership or permissions updates the ctime. The mtime
+     * is compared as well, because it is the only timestamp that can be set
+     * by the user. */
+    return !self->is_meta_data && self->u.conn_data.has_stat_id
+           && self->u.conn_data.stat_id.dev == st->st_dev
+           && self->u.conn_data.stat_id.ino == st->st_ino
+           && self->u.conn_data.stat_id.size == st->st_size
+           && self->u.conn_data.stat_id.ctime.tv_sec == st->st_ctim.tv_sec
+           && self->u.conn_data.stat_id.ctime.tv_nsec == st->st_ctim.tv_nsec
+           && self->u.conn_data.stat_mtime.tv_sec == st->st_mtim.tv_sec
+           && self->u.conn_data.stat_mtime.tv_nsec == st->st_mtim.tv_nsec;
+}
+
 /*****************************************************************************/
 
 static int
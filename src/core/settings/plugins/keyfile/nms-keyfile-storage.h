@@ -6,6 +6,8 @@
 #ifndef __NMS_KEYFILE_STORAGE_H__
 #define __NMS_KEYFILE_STORAGE_H__
 
+#include <sys/stat.h>
+
 #include "c-list/src/c-list.h"
 #include "settings/nm-settings-storage.h"
 #include "nms-keyfile-utils.h"
@@ -60,6 +62,17 @@ typedef struct {
              * multiple files with the same UUID, then the newer file gets preferred. */
             struct timespec stat_mtime;
 
+            /* the identity of the keyfile on disk when it was last read. On reload,
+             * files whose identity did not change are not read again. This is only
+             * valid if has_stat_id is set, which it is not for files that we wrote
+             * ourselves. */
+            struct {
+                dev_t           dev;
+                ino_t           ino;
+                off_t           size;
+                struct timespec ctime;
+            } stat_id;
+
             /* these flags are only relevant for storages with %NMS_KEYFILE_STORAGE_TYPE_RUN
              * (and non-metadata). This is to persist and reload these settings flags to
              * /run.
@@ -76,6 +89,8 @@ typedef struct {
              * shadowing profile: a owned profile will also be deleted. */
             bool shadowed_owned : 1;
 
+            bool has_stat_id : 1;
+
         } conn_data;
 
         /* the content from the .nmmeta file. Note that the nmmeta file has the UUID
@@ -131,6 +146,9 @@ void nms_keyfile_storage_copy_content(NMSKeyfileStorage *dst, const NMSKeyfileSt
 
 NMConnection *nms_keyfile_storage_steal_connection(NMSKeyfileStorage *storage);
 
+void     nms_keyfile_storage_set_stat_id(NMSKeyfileStorage *self, const struct stat *st);
+gboolean nms_keyfile_storage_stat_id_equal(const NMSKeyfileStorage *self, const struct stat *st);
+
 /*****************************************************************************/
 
 static inline const char *
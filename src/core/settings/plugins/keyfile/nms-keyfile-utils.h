@@ -30,6 +30,17 @@ NMS_KEYFILE_STORAGE_TYPE_LIB(guint run_idx)
 
 /*****************************************************************************/
 
+/* A template is a keyfile with a ".nmtemplate" suffix and an additional
+ * [.nmtemplate] group. It expands into one profile for each value in "range",
+ * with all occurrences of "${i}" replaced by the value. */
+#define NMS_KEYFILE_PATH_SUFFIX_NMTEMPLATE  ".nmtemplate"
+#define NMS_KEYFILE_GROUP_NMTEMPLATE        ".nmtemplate"
+#define NMS_KEYFILE_KEY_NMTEMPLATE_RANGE    "range"
+#define NMS_KEYFILE_NMTEMPLATE_PLACEHOLDER  "${i}"
+#define NMS_KEYFILE_NMTEMPLATE_MAX_PROFILES 65536
+
+/*****************************************************************************/
+
 const char *nms_keyfile_nmmeta_check_filename(const char *filename, guint *out_uuid_len);
 
 char *nms_keyfile_nmmeta_filename(const char *dirname, const char *uuid, gboolean temporary);
@@ -25,6 +25,45 @@ typedef struct {
     const char *keyfile_dir;
 } WriteInfo;
 
+/* Whether @path already has @contents, with the mode 0600 and the owner
+ * (unless -1) that writing it would set. Many saves don't change what ends
+ * up on disk, and rewriting the file anyway wears the storage and wakes up
+ * everybody who watches the directory. */
+static gboolean
+_file_is_unchanged(const char *path,
+                   const char *contents,
+                   gsize       len,
+                   uid_t       owner_uid,
+                   gid_t       owner_grp)
+{
+    struct stat st;
+    char       *buf = NULL;
+    gsize       buf_len;
+    gboolean    same;
+
+    if (stat(path, &st) != 0)
+        return FALSE;
+    if (!S_ISREG(st.st_mode) || (st.st_mode & 07777) != 0600 || (gsize) st.st_size != len)
+        return FALSE;
+    if (owner_uid != (uid_t) -1 && (st.st_uid != owner_uid || st.st_gid != owner_grp))
+        return FALSE;
+
+    if (!nm_utils_file_get_contents(-1,
+                                    path,
+                                    len + 1,
+                                    NM_UTILS_FILE_GET_CONTENTS_FLAG_SECRET,
+                                    &buf,
+                                    &buf_len,
+                                    NULL,
+                                    NULL))
+        return FALSE;
+
+    same = (buf_len == len && memcmp(buf, contents, len) == 0);
+    nm_explicit_bzero(buf, buf_len);
+    g_free(buf);
+    return same;
+}
+
 static void
 cert_writer(NMConnection                     *connection,
             GKeyFile                         *file,
@@ -127,14 +166,16 @@ cert_writer(NMConnection                     *connection,
          * being sure that the entire profile can be written and all circumstances are good to
          * proceed. That means, while writing we must only collect the blobs in-memory, and write
          * them all in the end together (or not at all). */
-        success = nm_utils_file_set_contents(new_path,
-                                             (const char *) blob_data,
-                                             blob_len,
-                                             0600,
-                                             NULL,
-                                             NULL,
-                                             NULL,
-                                             &local);
+        success =
+            _file_is_unchanged(new_path, (const char *) blob_data, blob_len, (uid_t) -1, 0)
+            || nm_utils_file_set_contents(new_path,
+                                          (const char *) blob_data,
+                                          blob_len,
+                                          0600,
+                                          NULL,
+                                          NULL,
+                                          NULL,
+                                          &local);
         if (success) {
             /* Write the path value to the keyfile.
              * We know, that basename(new_path) starts with a UUID, hence no conflict with "data:;base64,"  */
@@ -385,6 +426,11 @@ _internal_write_connection(NMConnection                   *connection,
         }
     }
 
+    if (_file_is_unchanged(path, kf_content_buf, kf_content_len, owner_uid, owner_grp)) {
+        nm_log_trace(LOGD_SETTINGS, "keyfile: %s is unchanged, skip writing it", path);
+        goto out;
+    }
+
     nm_utils_file_set_contents(path,
                                kf_content_buf,
                                kf_content_len,
@@ -416,6 +462,7 @@ _internal_write_connection(NMConnection                   *connection,
         return FALSE;
     }
 
+out:
     /* In case of updating the connection and changing the file path,
      * we need to remove the old one, not to end up with two connections.
      */
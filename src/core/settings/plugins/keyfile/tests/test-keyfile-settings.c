@@ -18,6 +18,7 @@
 #include "libnm-glib-aux/nm-uuid.h"
 #include "libnm-core-intern/nm-core-internal.h"
 
+#include "settings/plugins/keyfile/nms-keyfile-cache.h"
 #include "settings/plugins/keyfile/nms-keyfile-reader.h"
 #include "settings/plugins/keyfile/nms-keyfile-writer.h"
 #include "settings/plugins/keyfile/nms-keyfile-utils.h"
@@ -2382,6 +2383,56 @@ test_read_missing_id_uuid(void)
     g_assert_cmpstr(nm_connection_get_uuid(connection), ==, expected_uuid);
 }
 
+static void
+test_read_template(void)
+{
+    const char *const              FILENAME    = TEST_KEYFILES_DIR "/Test_VLAN.nmtemplate";
+    gs_free_error GError          *error       = NULL;
+    gs_unref_ptrarray GPtrArray   *connections = NULL;
+    gs_unref_ptrarray GPtrArray   *filenames   = NULL;
+    gs_unref_hashtable GHashTable *uuids       = NULL;
+    guint                          i;
+
+    connections = nms_keyfile_reader_from_template(FILENAME, NULL, NULL, &filenames, &error);
+    nmtst_assert_success(connections, error);
+    g_assert_cmpint(connections->len, ==, 10);
+    g_assert_cmpint(filenames->len, ==, 10);
+
+    uuids = g_hash_table_new(nm_str_hash, g_str_equal);
+
+    for (i = 0; i < connections->len; i++) {
+        NMConnection      *connection = connections->pdata[i];
+        NMSettingVlan     *s_vlan;
+        NMSettingIPConfig *s_ip4;
+        gs_free char      *expected_id       = g_strdup_printf("bond0.%u", 100 + i);
+        gs_free char      *expected_filename = g_strdup_printf("%s@%u", FILENAME, 100 + i);
+        gs_free char      *expected_address  = g_strdup_printf("10.%u.0.1", 100 + i);
+        gs_free char      *expected_uuid     = NULL;
+        char               value[20];
+
+        nm_sprintf_buf(value, "%u", 100 + i);
+        expected_uuid =
+            nm_uuid_generate_from_strings_old("7d6c3b5e-2a44-4b1f-9d0e-3e8a5c2f1b90", value);
+
+        nmtst_assert_connection_verifies_without_normalization(connection);
+        g_assert_cmpstr(filenames->pdata[i], ==, expected_filename);
+        g_assert_cmpstr(nm_connection_get_id(connection), ==, expected_id);
+        g_assert_cmpstr(nm_connection_get_interface_name(connection), ==, expected_id);
+        g_assert_cmpstr(nm_connection_get_uuid(connection), ==, expected_uuid);
+        g_assert(g_hash_table_add(uuids, (gpointer) nm_connection_get_uuid(connection)));
+
+        s_vlan = nm_connection_get_setting_vlan(connection);
+        g_assert(s_vlan);
+        g_assert_cmpint(nm_setting_vlan_get_id(s_vlan), ==, 100 + i);
+        g_assert_cmpstr(nm_setting_vlan_get_parent(s_vlan), ==, "bond0");
+
+        s_ip4 = nm_connection_get_setting_ip4_config(connection);
+        g_assert(s_ip4);
+        g_assert_cmpint(nm_setting_ip_config_get_num_addresses(s_ip4), ==, 1);
+        check_ip_address(s_ip4, 0, expected_address, 24);
+    }
+}
+
 static void
 test_read_minimal(void)
 {
@@ -2907,6 +2958,304 @@ test_nmmeta(void)
 
 /*****************************************************************************/
 
+static const char *const _read_threaded_files[] = {
+    TEST_KEYFILES_DIR "/Test_Wired_Connection_IP6",
+    TEST_KEYFILES_DIR "/Test_Wireless_Connection",
+    TEST_KEYFILES_DIR "/Test_String_SSID",
+    TEST_KEYFILES_DIR "/Test_Intlist_SSID",
+    TEST_KEYFILES_DIR "/ATT_Data_Connect_Plain",
+};
+
+typedef struct {
+    const char   *full_filename;
+    NMConnection *connection;
+} ReadThreadedData;
+
+static void
+_read_threaded_cb(gpointer data, gpointer user_data)
+{
+    ReadThreadedData *d = data;
+
+    d->connection = nms_keyfile_reader_from_file(d->full_filename,
+                                                 NULL,
+                                                 NULL,
+                                                 NULL,
+                                                 NULL,
+                                                 NULL,
+                                                 NULL,
+                                                 NULL,
+                                                 NULL);
+}
+
+static void
+test_read_threaded(void)
+{
+    NMConnection    *connections[G_N_ELEMENTS(_read_threaded_files)];
+    ReadThreadedData datas[200];
+    GThreadPool     *pool;
+    guint            i;
+
+    /* nms_keyfile_reader_from_file() gets called from worker threads while
+     * loading many profiles. Check that this gives the same result as reading
+     * the files on the main thread. */
+
+    for (i = 0; i < G_N_ELEMENTS(_read_threaded_files); i++)
+        connections[i] = keyfile_read_connection_from_file(_read_threaded_files[i]);
+
+    pool = g_thread_pool_new(_read_threaded_cb, NULL, 4, TRUE, NULL);
+    g_assert(pool);
+
+    for (i = 0; i < G_N_ELEMENTS(datas); i++) {
+        datas[i] = (ReadThreadedData){
+            .full_filename = _read_threaded_files[i % G_N_ELEMENTS(_read_threaded_files)],
+        };
+        g_thread_pool_push(pool, &datas[i], NULL);
+    }
+
+    g_thread_pool_free(pool, FALSE, TRUE);
+
+    for (i = 0; i < G_N_ELEMENTS(datas); i++) {
+        g_assert(datas[i].connection);
+        nmtst_assert_connection_equals(connections[i % G_N_ELEMENTS(_read_threaded_files)],
+                                       FALSE,
+                                       datas[i].connection,
+                                       FALSE);
+        g_object_unref(datas[i].connection);
+    }
+
+    for (i = 0; i < G_N_ELEMENTS(_read_threaded_files); i++)
+        g_object_unref(connections[i]);
+}
+
+/*****************************************************************************/
+
+static void
+_write_existing(NMConnection *connection, const char *existing_path, struct stat *out_st)
+{
+    gs_free_error GError *error = NULL;
+    gs_free char         *path  = NULL;
+    gboolean              success;
+
+    success = nms_keyfile_writer_connection(connection,
+                                            FALSE,
+                                            FALSE,
+                                            FALSE,
+                                            NULL,
+                                            FALSE,
+                                            TEST_SCRATCH_DIR,
+                                            TEST_SCRATCH_DIR,
+                                            existing_path,
+                                            FALSE,
+                                            NM_TERNARY_FALSE,
+                                            NULL,
+                                            NULL,
+                                            &path,
+                                            NULL,
+                                            NULL,
+                                            &error);
+    nmtst_assert_success(success, error);
+    g_assert_cmpstr(path, ==, existing_path);
+    g_assert_cmpint(stat(path, out_st), ==, 0);
+}
+
+static void
+test_write_unchanged(void)
+{
+    gs_unref_object NMConnection *connection = NULL;
+    gs_free char                 *testfile   = NULL;
+    struct stat                   st1;
+    struct stat                   st2;
+
+    connection = nmtst_create_minimal_connection("Test Write Unchanged",
+                                                 NULL,
+                                                 NM_SETTING_WIRED_SETTING_NAME,
+                                                 NULL);
+    nmtst_connection_normalize(connection);
+
+    write_test_connection(connection, &testfile);
+
+    /* Writing the same content again doesn't replace the file. */
+    _write_existing(connection, testfile, &st1);
+    _write_existing(connection, testfile, &st2);
+    g_assert_cmpint(st1.st_ino, ==, st2.st_ino);
+
+    g_object_set(nm_connection_get_setting_connection(connection),
+                 NM_SETTING_CONNECTION_AUTOCONNECT,
+                 FALSE,
+                 NULL);
+    _write_existing(connection, testfile, &st2);
+    g_assert_cmpint(st1.st_ino, !=, st2.st_ino);
+    assert_reread_and_unlink(connection, TRUE, testfile);
+}
+
+static void
+test_keyfile_cache(void)
+{
+    nm_auto_free_keyfile_cache NMSKeyfileCache *cache   = NULL;
+    gs_unref_ptrarray GPtrArray                *entries = NULL;
+    gs_free_error GError                       *error   = NULL;
+    struct stat                                 st;
+    gboolean                                    success;
+    guint                                       i;
+
+    entries = g_ptr_array_new_with_free_func((GDestroyNotify) g_variant_unref);
+
+    for (i = 0; i < G_N_ELEMENTS(_read_threaded_files); i++) {
+        gs_unref_object NMConnection *connection = NULL;
+
+        connection = keyfile_read_connection_from_file(_read_threaded_files[i]);
+        g_assert_cmpint(stat(_read_threaded_files[i], &st), ==, 0);
+        g_ptr_array_add(entries,
+                        nms_keyfile_cache_entry_new(_read_threaded_files[i],
+                                                    &st,
+                                                    connection,
+                                                    NM_TERNARY_DEFAULT,
+                                                    NM_TERNARY_TRUE,
+                                                    NM_TERNARY_FALSE,
+                                                    i == 0 ? "/etc/foo" : NULL,
+                                                    NM_TERNARY_DEFAULT));
+    }
+
+    success = nms_keyfile_cache_write(TEST_SCRATCH_DIR "/keyfile-cache", entries, &error);
+    nmtst_assert_success(success, error);
+
+    cache = nms_keyfile_cache_load(TEST_SCRATCH_DIR "/keyfile-cache");
+    g_assert(cache);
+    g_assert_cmpint(nms_keyfile_cache_get_n_entries(cache), ==, G_N_ELEMENTS(_read_threaded_files));
+    g_assert(!nms_keyfile_cache_lookup(cache, TEST_KEYFILES_DIR "/Test_Wired_Connection"));
+
+    for (i = 0; i < G_N_ELEMENTS(_read_threaded_files); i++) {
+        gs_unref_object NMConnection *connection       = NULL;
+        gs_unref_object NMConnection *connection2      = NULL;
+        gs_free char                 *shadowed_storage = NULL;
+        NMTernary                     is_nm_generated;
+        NMTernary                     is_volatile;
+        NMTernary                     is_external;
+        NMTernary                     shadowed_owned;
+        GVariant                     *entry;
+
+        entry = nms_keyfile_cache_lookup(cache, _read_threaded_files[i]);
+        g_assert(entry);
+
+        g_assert_cmpint(stat(_read_threaded_files[i], &st), ==, 0);
+        connection = nms_keyfile_cache_entry_get_connection(entry,
+                                                            &st,
+                                                            &is_nm_generated,
+                                                            &is_volatile,
+                                                            &is_external,
+                                                            &shadowed_storage,
+                                                            &shadowed_owned);
+        g_assert(connection);
+        g_assert_cmpint(is_nm_generated, ==, NM_TERNARY_DEFAULT);
+        g_assert_cmpint(is_volatile, ==, NM_TERNARY_TRUE);
+        g_assert_cmpint(is_external, ==, NM_TERNARY_FALSE);
+        g_assert_cmpint(shadowed_owned, ==, NM_TERNARY_DEFAULT);
+        g_assert_cmpstr(shadowed_storage, ==, i == 0 ? "/etc/foo" : NULL);
+
+        connection2 = keyfile_read_connection_from_file(_read_threaded_files[i]);
+        nmtst_assert_connection_equals(connection, FALSE, connection2, FALSE);
+
+        /* a modified file invalidates the entry. */
+        st.st_size++;
+        g_assert(!nms_keyfile_cache_entry_get_connection(entry, &st, NULL, NULL, NULL, NULL, NULL));
+    }
+
+    (void) unlink(TEST_SCRATCH_DIR "/keyfile-cache");
+}
+
+/*****************************************************************************/
+
+static void
+test_perf_read_write(void)
+{
+    const guint                  N_PROFILES  = nmtst_scale_get("NMTST_SCALE_PROFILES", 40, 10000);
+    const guint                  N_ROUTES    = nmtst_scale_get("NMTST_SCALE_ROUTES", 5, 50);
+    gs_unref_ptrarray GPtrArray *connections = NULL;
+    gs_unref_ptrarray GPtrArray *rereads     = NULL;
+    gs_unref_ptrarray GPtrArray *paths       = NULL;
+    gint64                       rss_start;
+    gint64                       rss_read;
+    gint64                       t_start;
+    gint64                       t_normalize;
+    gint64                       t_write;
+    gint64                       t_read;
+    guint                        i;
+
+    connections = g_ptr_array_new_with_free_func(g_object_unref);
+    rereads     = g_ptr_array_new_with_free_func(g_object_unref);
+    paths       = g_ptr_array_new_with_free_func(g_free);
+
+    for (i = 0; i < N_PROFILES; i++)
+        g_ptr_array_add(connections, nmtst_create_scale_connection(i, N_ROUTES));
+
+    t_start = nm_utils_get_monotonic_timestamp_nsec();
+    for (i = 0; i < N_PROFILES; i++) {
+        gs_free_error GError *error = NULL;
+        gboolean              success;
+
+        success = nm_connection_normalize(connections->pdata[i], NULL, NULL, &error);
+        nmtst_assert_success(success, error);
+    }
+    t_normalize = nm_utils_get_monotonic_timestamp_nsec() - t_start;
+
+    t_start = nm_utils_get_monotonic_timestamp_nsec();
+    for (i = 0; i < N_PROFILES; i++) {
+        gs_free_error GError *error = NULL;
+        char                 *path  = NULL;
+        gboolean              success;
+
+        success = nmtst_keyfile_writer_test_connection(connections->pdata[i],
+                                                       TEST_SCRATCH_DIR,
+                                                       geteuid(),
+                                                       getegid(),
+                                                       &path,
+                                                       NULL,
+                                                       NULL,
+                                                       &error);
+        nmtst_assert_success(success, error);
+        g_ptr_array_add(paths, path);
+    }
+    t_write = nm_utils_get_monotonic_timestamp_nsec() - t_start;
+
+    rss_start = nmtst_get_rss_kib();
+    t_start   = nm_utils_get_monotonic_timestamp_nsec();
+    for (i = 0; i < N_PROFILES; i++) {
+        gs_free_error GError *error = NULL;
+        NMConnection         *reread;
+
+        reread = nms_keyfile_reader_from_file(paths->pdata[i],
+                                              NULL,
+                                              NULL,
+                                              NULL,
+                                              NULL,
+                                              NULL,
+                                              NULL,
+                                              NULL,
+                                              &error);
+        nmtst_assert_success(reread, error);
+        g_ptr_array_add(rereads, reread);
+    }
+    t_read   = nm_utils_get_monotonic_timestamp_nsec() - t_start;
+    rss_read = nmtst_get_rss_kib();
+
+    g_test_message("keyfile: %u profiles with %u routes: normalize %" G_GINT64_FORMAT
+                   " msec, write %" G_GINT64_FORMAT " msec, read %" G_GINT64_FORMAT
+                   " msec, RSS +%" G_GINT64_FORMAT " KiB after read",
+                   N_PROFILES,
+                   N_ROUTES,
+                   t_normalize / NM_UTILS_NSEC_PER_MSEC,
+                   t_write / NM_UTILS_NSEC_PER_MSEC,
+                   t_read / NM_UTILS_NSEC_PER_MSEC,
+                   rss_read - rss_start);
+
+    for (i = 0; i < N_PROFILES; i++) {
+        nmtst_assert_connection_equals(connections->pdata[i], TRUE, rereads->pdata[i], FALSE);
+        nmtst_file_unlink(paths->pdata[i]);
+    }
+}
+
+/*****************************************************************************/
+
 NMTST_DEFINE();
 
 int
@@ -2995,6 +3344,7 @@ main(int argc, char **argv)
     g_test_add_func("/keyfile/test_read_missing_vlan_flags", test_read_missing_vlan_flags);
     g_test_add_func("/keyfile/test_read_missing_id_uuid", test_read_missing_id_uuid);
 
+    g_test_add_func("/keyfile/test_read_template", test_read_template);
     g_test_add_func("/keyfile/test_read_minimal", test_read_minimal);
     g_test_add_func("/keyfile/test_read_minimal_port", test_read_minimal_port);
 
@@ -3011,5 +3361,11 @@ main(int argc, char **argv)
 
     g_test_add_func("/keyfile/test_nmmeta", test_nmmeta);
 
+    g_test_add_func("/keyfile/test_read_threaded", test_read_threaded);
+    g_test_add_func("/keyfile/test_write_unchanged", test_write_unchanged);
+    g_test_add_func("/keyfile/test_keyfile_cache", test_keyfile_cache);
+
+    g_test_add_func("/keyfile/perf/read-write", test_perf_read_write);
+
     return g_test_run();
 }
@@ -17,6 +17,7 @@
 #include "libnm-glib-aux/nm-ref-string.h"
 #include "libnm-glib-aux/nm-dbus-aux.h"
 #include "libnm-std-aux/nm-dbus-compat.h"
+#include "libnm-platform/nm-platform.h"
 #include "nm-supplicant-config.h"
 #include "nm-supplicant-manager.h"
 
@@ -824,7 +825,7 @@ _bss_info_get_all_cb(GVariant *result, GError *error, gpointer user_data)
 }
 
 static void
-_bss_info_add(NMSupplicantInterface *self, const char *object_path)
+_bss_info_add(NMSupplicantInterface *self, const char *object_path, GVariant *properties)
 {
     NMSupplicantInterfacePrivate   *priv     = NM_SUPPLICANT_INTERFACE_GET_PRIVATE(self);
     nm_auto_ref_string NMRefString *bss_path = NULL;
@@ -842,10 +843,21 @@ _bss_info_add(NMSupplicantInterface *self, const char *object_path)
 
     bss_info  = g_slice_new(NMSupplicantBssInfo);
     *bss_info = (NMSupplicantBssInfo) {
-        ._self             = self,
-        .bss_path          = g_steal_pointer(&bss_path),
-        ._init_cancellable = g_cancellable_new(),
+        ._self    = self,
+        .bss_path = g_steal_pointer(&bss_path),
     };
+
+    if (properties && g_variant_n_children(properties) > 0) {
+        /* The "BSSAdded" signal already carries all properties of the BSS. Use
+         * them instead of fetching them again with a "GetAll" call, which would
+         * cost a D-Bus round trip for every BSS found by a scan. */
+        c_list_link_tail(&priv->bss_lst_head, &bss_info->_bss_lst);
+        g_hash_table_add(priv->bss_idx, bss_info);
+        _bss_info_properties_changed(self, bss_info, properties, TRUE);
+        return;
+    }
+
+    bss_info->_init_cancellable = g_cancellable_new();
     c_list_link_tail(&priv->bss_initializing_lst_head, &bss_info->_bss_lst);
     g_hash_table_add(priv->bss_idx, bss_info);
 
@@ -2030,7 +2042,7 @@ _properties_changed_main(NMSupplicantInterface *self, GVariant *properties)
             bss_info->_bss_dirty = TRUE;
 
         for (iter = v_strv; *iter; iter++)
-            _bss_info_add(self, *iter);
+            _bss_info_add(self, *iter, NULL);
 
         g_free(v_strv);
 
@@ -3023,6 +3035,25 @@ _get_all_main_cb(GVariant *result, GError *error, gpointer user_data)
     _properties_changed(user_data, NM_WPAS_DBUS_IFACE_INTERFACE, properties, TRUE);
 }
 
+static void
+_get_state_main_cb(GVariant *result, GError *error, gpointer user_data)
+{
+    gs_unref_variant GVariant *properties = NULL;
+    gs_unref_variant GVariant *v_state    = NULL;
+    GVariantBuilder            builder;
+
+    if (nm_utils_error_is_cancelled(error))
+        return;
+
+    if (result) {
+        g_variant_get(result, "(v)", &v_state);
+        g_variant_builder_init(&builder, G_VARIANT_TYPE_VARDICT);
+        g_variant_builder_add(&builder, "{sv}", "State", v_state);
+        properties = g_variant_ref_sink(g_variant_builder_end(&builder));
+    }
+    _properties_changed(user_data, NM_WPAS_DBUS_IFACE_INTERFACE, properties, TRUE);
+}
+
 static void
 _get_all_p2p_device_cb(GVariant *result, GError *error, gpointer user_data)
 {
@@ -3059,11 +3090,13 @@ _signal_handle(NMSupplicantInterface *self,
             return;
 
         if (nm_streq(signal_name, "BSSAdded")) {
+            gs_unref_variant GVariant *properties = NULL;
+
             if (!g_variant_is_of_type(parameters, G_VARIANT_TYPE("(oa{sv})")))
                 return;
 
-            g_variant_get(parameters, "(&oa{sv})", &path, NULL);
-            _bss_info_add(self, path);
+            g_variant_get(parameters, "(&o@a{sv})", &path, &properties);
+            _bss_info_add(self, path, properties);
             return;
         }
 
@@ -3416,11 +3449,19 @@ constructed(GObject *object)
 {
     NMSupplicantInterface        *self = NM_SUPPLICANT_INTERFACE(object);
     NMSupplicantInterfacePrivate *priv = NM_SUPPLICANT_INTERFACE_GET_PRIVATE(self);
+    gboolean                      is_wired;
 
     G_OBJECT_CLASS(nm_supplicant_interface_parent_class)->constructed(object);
 
     _LOGD("new supplicant interface %s on %s", priv->object_path->str, priv->name_owner->str);
 
+    /* Wired and MACsec interfaces only authenticate. They have no BSSs, peers
+     * or AP mode, and the only property we care about is the state. Skip the
+     * setup for Wi-Fi, which matters when there are many such interfaces. */
+    is_wired = NM_IN_SET(priv->requested_driver,
+                         NM_SUPPLICANT_DRIVER_WIRED,
+                         NM_SUPPLICANT_DRIVER_MACSEC);
+
     priv->properties_changed_id =
         nm_dbus_connection_signal_subscribe_properties_changed(priv->dbus_connection,
                                                                priv->name_owner->str,
@@ -3430,15 +3471,6 @@ constructed(GObject *object)
                                                                self,
                                                                NULL);
 
-    priv->bss_properties_changed_id =
-        nm_dbus_connection_signal_subscribe_properties_changed(priv->dbus_connection,
-                                                               priv->name_owner->str,
-                                                               NULL,
-                                                               NM_WPAS_DBUS_IFACE_BSS,
-                                                               _bss_properties_changed_cb,
-                                                               self,
-                                                               NULL);
-
     priv->signal_id = g_dbus_connection_signal_subscribe(priv->dbus_connection,
                                                          priv->name_owner->str,
                                                          NULL,
@@ -3450,6 +3482,35 @@ constructed(GObject *object)
                                                          self,
                                                          NULL);
 
+    if (is_wired) {
+        char ifname[NM_IFNAMSIZ];
+
+        /* Without fetching "Ifname", take the name for logging from platform. */
+        if (nm_platform_if_indextoname(NM_PLATFORM_GET, priv->ifindex, ifname))
+            nm_strdup_reset(&priv->ifname, ifname);
+
+        priv->starting_pending_count++;
+        nm_dbus_connection_call_get(priv->dbus_connection,
+                                    priv->name_owner->str,
+                                    priv->object_path->str,
+                                    NM_WPAS_DBUS_IFACE_INTERFACE,
+                                    "State",
+                                    5000,
+                                    priv->main_cancellable,
+                                    _get_state_main_cb,
+                                    self);
+        return;
+    }
+
+    priv->bss_properties_changed_id =
+        nm_dbus_connection_signal_subscribe_properties_changed(priv->dbus_connection,
+                                                               priv->name_owner->str,
+                                                               NULL,
+                                                               NM_WPAS_DBUS_IFACE_BSS,
+                                                               _bss_properties_changed_cb,
+                                                               self,
+                                                               NULL);
+
     /* Scan result aging parameters */
     nm_dbus_connection_call_set(priv->dbus_connection,
                                 priv->name_owner->str,
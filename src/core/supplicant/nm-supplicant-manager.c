@@ -20,6 +20,13 @@
 
 #define CREATE_IFACE_TRY_COUNT_MAX 7u
 
+/* How many interfaces we create in wpa_supplicant in parallel. Further
+ * requests wait until one of them completes. Creating an interface is
+ * expensive for wpa_supplicant, and when many ports start at once (like
+ * wired 802.1X on a host with many ports), it would otherwise be busy
+ * with them for longer than the D-Bus timeout. */
+#define CREATE_IFACE_PARALLEL_MAX 8u
+
 struct _NMSupplMgrCreateIfaceHandle {
     NMSupplicantManager                 *self;
     CList                                create_iface_lst;
@@ -33,6 +40,7 @@ struct _NMSupplMgrCreateIfaceHandle {
     int                                  ifindex;
     guint                                fail_on_idle_id;
     guint                                create_iface_try_count : 5;
+    bool                                 started : 1;
 };
 
 enum {
@@ -55,6 +63,7 @@ typedef struct {
     CList       supp_lst_head;
 
     CList create_iface_lst_head;
+    guint create_iface_n_started;
 
     NMSupplCapMask capabilities;
 
@@ -98,6 +107,7 @@ NM_CACHED_QUARK_FCN("nm-supplicant-error-quark", nm_supplicant_error_quark);
 /*****************************************************************************/
 
 static void     _create_iface_proceed_all(NMSupplicantManager *self, GError *error);
+static void     _create_iface_start_pending(NMSupplicantManager *self);
 static void     _supp_iface_add(NMSupplicantManager   *self,
                                 NMRefString           *iface_path,
                                 NMSupplicantInterface *supp_iface);
@@ -350,6 +360,8 @@ _create_iface_complete(NMSupplMgrCreateIfaceHandle *handle,
                        NMSupplicantInterface       *supp_iface,
                        GError                      *error)
 {
+    gboolean start_pending = FALSE;
+
     nm_assert(!supp_iface || NM_IS_SUPPLICANT_INTERFACE(supp_iface));
     nm_assert((!!supp_iface) != (!!error));
 
@@ -357,6 +369,15 @@ _create_iface_complete(NMSupplMgrCreateIfaceHandle *handle,
 
     nm_clear_g_source(&handle->fail_on_idle_id);
 
+    if (handle->started) {
+        NMSupplicantManagerPrivate *priv = NM_SUPPLICANT_MANAGER_GET_PRIVATE(handle->self);
+
+        nm_assert(priv->create_iface_n_started > 0);
+        priv->create_iface_n_started--;
+        handle->started = FALSE;
+        start_pending   = TRUE;
+    }
+
     if (handle->callback) {
         NMSupplicantManagerCreateInterfaceCb callback;
 
@@ -369,6 +390,9 @@ _create_iface_complete(NMSupplMgrCreateIfaceHandle *handle,
 
     g_clear_error(&handle->fail_on_idle_error);
 
+    if (start_pending)
+        _create_iface_start_pending(handle->self);
+
     g_clear_object(&handle->self);
 
     if (handle->shutdown_handle) {
@@ -623,6 +647,10 @@ _create_iface_dbus_start(NMSupplicantManager *self, NMSupplMgrCreateIfaceHandle
 
     nm_assert(priv->name_owner);
     nm_assert(!handle->cancellable);
+    nm_assert(!handle->started);
+
+    handle->started = TRUE;
+    priv->create_iface_n_started++;
 
     if (!nm_platform_if_indextoname(NM_PLATFORM_GET, handle->ifindex, ifname)) {
         nm_utils_error_set(&handle->fail_on_idle_error,
@@ -737,6 +765,16 @@ nm_supplicant_manager_create_interface(NMSupplicantManager                 *self
         return handle;
     }
 
+    if (priv->create_iface_n_started >= CREATE_IFACE_PARALLEL_MAX) {
+        _LOGT("create-iface[" NM_HASH_OBFUSCATE_PTR_FMT
+              "]: new request interface %d (driver %s). Waiting for %u other requests...",
+              NM_HASH_OBFUSCATE_PTR(handle),
+              ifindex,
+              nm_supplicant_driver_to_string(driver),
+              priv->create_iface_n_started);
+        return handle;
+    }
+
     _LOGT("create-iface[" NM_HASH_OBFUSCATE_PTR_FMT
           "]: new request interface %d (driver %s). create interface on %s...",
           NM_HASH_OBFUSCATE_PTR(handle),
@@ -781,9 +819,26 @@ _create_iface_proceed_all(NMSupplicantManager *self, GError *error)
         return;
     }
 
-    /* start all the handles. This does not invoke callbacks, so the list of handles
-     * cannot be modified while we iterate it. */
+    _create_iface_start_pending(self);
+}
+
+static void
+_create_iface_start_pending(NMSupplicantManager *self)
+{
+    NMSupplicantManagerPrivate  *priv = NM_SUPPLICANT_MANAGER_GET_PRIVATE(self);
+    NMSupplMgrCreateIfaceHandle *handle;
+
+    if (!priv->name_owner || priv->get_capabilities_cancellable)
+        return;
+
+    /* start the handles that are not yet started, up to the limit. This does not
+     * invoke callbacks, so the list of handles cannot be modified while we iterate
+     * it. */
     c_list_for_each_entry (handle, &priv->create_iface_lst_head, create_iface_lst) {
+        if (priv->create_iface_n_started >= CREATE_IFACE_PARALLEL_MAX)
+            return;
+        if (handle->started || handle->fail_on_idle_id != 0)
+            continue;
         _LOGT("create-iface[" NM_HASH_OBFUSCATE_PTR_FMT "]: create interface on %s...",
               NM_HASH_OBFUSCATE_PTR(handle),
               priv->name_owner->str);
@@ -1312,6 +1367,7 @@ dispose(GObject *object)
     _supp_iface_remove_all(self, TRUE, "NMSupplicantManager is disposing");
 
     nm_assert(c_list_is_empty(&priv->create_iface_lst_head));
+    nm_assert(priv->create_iface_n_started == 0);
 
     nm_clear_g_source(&priv->available_reset_id);
 
@@ -19,6 +19,7 @@
 #include "dns/nm-dns-manager.h"
 #include "nm-connectivity.h"
 #include "nm-firewall-utils.h"
+#include "nm-perf.h"
 
 #include "nm-test-utils-core.h"
 
@@ -2772,6 +2773,81 @@ test_nm_firewall_nft_stdio_mlag(void)
 
 /*****************************************************************************/
 
+static void
+test_nm_perf_histogram(void)
+{
+    NMPerfHistogram histogram = {};
+    guint           idx;
+    guint           i;
+
+    g_assert_cmpint(nm_perf_histogram_get_percentile(&histogram, 50), ==, 0);
+
+    g_assert_cmpint(nm_perf_histogram_bucket_index(-1), ==, 0);
+    g_assert_cmpint(nm_perf_histogram_bucket_index(999), ==, 0);
+    g_assert_cmpint(nm_perf_histogram_bucket_index(3999), ==, 3);
+    g_assert_cmpint(nm_perf_histogram_bucket_index(4000), ==, 4);
+    g_assert_cmpint(nm_perf_histogram_bucket_index(7999), ==, 7);
+    g_assert_cmpint(nm_perf_histogram_bucket_index(8000), ==, 8);
+    g_assert_cmpint(nm_perf_histogram_bucket_index(G_MAXINT64),
+                    ==,
+                    NM_PERF_HISTOGRAM_N_BUCKETS - 1);
+
+    /* every duration is below the upper bound of its bucket, and not below
+     * the upper bound of the previous bucket. */
+    for (i = 0; i < 5000; i++) {
+        gint64 d;
+
+        d = nmtst_get_rand_uint64() % (G_GINT64_CONSTANT(1) << (nmtst_get_rand_uint32() % 42));
+
+        idx = nm_perf_histogram_bucket_index(d);
+        g_assert_cmpint(d, <, nm_perf_histogram_bucket_upper_nsec(idx));
+        if (idx > 0)
+            g_assert_cmpint(d, >=, nm_perf_histogram_bucket_upper_nsec(idx - 1));
+    }
+
+    for (i = 1; i <= 100; i++)
+        nm_perf_histogram_add(&histogram, i * 1000000);
+
+    g_assert_cmpint(histogram.count, ==, 100);
+    g_assert_cmpint(histogram.max_nsec, ==, 100000000);
+    g_assert_cmpint(nm_perf_histogram_get_percentile(&histogram, 100), ==, 100000000);
+    g_assert_cmpint(nm_perf_histogram_get_percentile(&histogram, 50), >=, 50000000);
+    g_assert_cmpint(nm_perf_histogram_get_percentile(&histogram, 50), <=, 50000000 * 5 / 4);
+    g_assert_cmpint(nm_perf_histogram_get_percentile(&histogram, 0), <=, 1000000 * 5 / 4);
+}
+
+static void
+test_nm_perf_queue(void)
+{
+    const NMPerfQueueStats *q            = nm_perf_get_queue_stats(NM_PERF_QUEUE_ACTIVATION_STAGE2);
+    const guint64           n_enqueued   = q->n_enqueued;
+    const guint64           n_dispatched = q->n_dispatched;
+    const guint64           n_wait       = q->wait.count;
+    const gint64            start_nsec   = nm_perf_start();
+    guint                   i;
+
+    g_assert_cmpint(q->len, ==, 0);
+
+    for (i = 0; i < 3; i++)
+        nm_perf_queue_enqueue(NM_PERF_QUEUE_ACTIVATION_STAGE2);
+    g_assert_cmpint(q->len, ==, 3);
+    g_assert_cmpint(q->len_max, >=, 3);
+
+    nm_perf_queue_batch(NM_PERF_QUEUE_ACTIVATION_STAGE2);
+    nm_perf_queue_dequeue(NM_PERF_QUEUE_ACTIVATION_STAGE2, start_nsec, TRUE);
+    nm_perf_queue_dequeue(NM_PERF_QUEUE_ACTIVATION_STAGE2, start_nsec, TRUE);
+    nm_perf_queue_dequeue(NM_PERF_QUEUE_ACTIVATION_STAGE2, start_nsec, FALSE);
+
+    /* Dropped items don't account for the wait time. */
+    g_assert_cmpint(q->len, ==, 0);
+    g_assert_cmpint(q->n_enqueued, ==, n_enqueued + 3);
+    g_assert_cmpint(q->n_dispatched, ==, n_dispatched + 2);
+    g_assert_cmpint(q->wait.count, ==, n_wait + 2);
+    g_assert_cmpint(q->n_batches, >=, 1);
+}
+
+/*****************************************************************************/
+
 NMTST_DEFINE();
 
 int
@@ -2848,5 +2924,8 @@ main(int argc, char **argv)
 
     g_test_add_func("/core/test_nm_firewall_nft_stdio_mlag", test_nm_firewall_nft_stdio_mlag);
 
+    g_test_add_func("/core/perf/histogram", test_nm_perf_histogram);
+    g_test_add_func("/core/perf/queue", test_nm_perf_queue);
+
     return g_test_run();
 }
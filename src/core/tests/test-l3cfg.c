@@ -383,6 +383,7 @@ test_l3cfg(gconstpointer test_data)
     l3cfg0 = _netns_access_l3cfg(f->netns, f->ifindex0);
 
     g_signal_connect(l3cfg0, NM_L3CFG_SIGNAL_NOTIFY, G_CALLBACK(_test_l3cfg_signal_notify), tdata);
+    nm_l3cfg_want_platform_change(l3cfg0, TRUE);
 
     commit_type_1 =
         nm_l3cfg_commit_type_register(l3cfg0, NM_L3_CFG_COMMIT_TYPE_UPDATE, NULL, "test1");
@@ -502,6 +503,7 @@ test_l3cfg(gconstpointer test_data)
         _test_l3cfg_data_set_notify_type(tdata, TEST_L3CFG_NOTIFY_TYPE_NONE);
     }
 
+    nm_l3cfg_want_platform_change(l3cfg0, FALSE);
     g_signal_handlers_disconnect_by_func(l3cfg0, G_CALLBACK(_test_l3cfg_signal_notify), tdata);
 
     nm_l3cfg_commit_type_unregister(l3cfg0, commit_type_1);
@@ -520,6 +522,115 @@ test_l3cfg(gconstpointer test_data)
 
 /*****************************************************************************/
 
+static void
+_test_l3cfg_merge_add_config(NML3Cfg *l3cfg, char tag, const NML3ConfigData *l3cd, int priority)
+{
+    nm_l3cfg_add_config(l3cfg,
+                        GINT_TO_POINTER(tag),
+                        TRUE,
+                        l3cd,
+                        priority,
+                        0,
+                        0,
+                        NM_PLATFORM_ROUTE_METRIC_DEFAULT_IP4,
+                        NM_PLATFORM_ROUTE_METRIC_DEFAULT_IP6,
+                        0,
+                        0,
+                        NM_DNS_PRIORITY_DEFAULT_NORMAL,
+                        NM_DNS_PRIORITY_DEFAULT_NORMAL,
+                        NM_L3_ACD_DEFEND_TYPE_NEVER,
+                        0,
+                        NM_L3CFG_CONFIG_FLAGS_NONE,
+                        NM_L3_CONFIG_MERGE_FLAGS_NONE);
+}
+
+static void
+test_l3cfg_merge_renewal(void)
+{
+    const guint                                    N_ROUTES     = g_test_perf() ? 10000 : 1000;
+    const guint                                    N_RENEWALS   = g_test_perf() ? 1000 : 50;
+    nm_auto(_test_fixture_1_teardown) TestFixture1 test_fixture = {};
+    const TestFixture1                            *f;
+    gs_unref_object NML3Cfg                       *l3cfg0        = NULL;
+    nm_auto_unref_l3cd const NML3ConfigData       *l3cd_static   = NULL;
+    gint64                                         time_first    = 0;
+    gint64                                         time_renewals = 0;
+    const NML3ConfigData                          *l3cd;
+    const NMPlatformIP6Address                    *a6;
+    struct in6_addr                                addr6;
+    gint64                                         start_time;
+    guint                                          i;
+
+    f = _test_fixture_1_setup(&test_fixture, 5);
+
+    addr6 = *nmtst_inet6_from_string("1:2:3:4::45");
+
+    l3cfg0 = _netns_access_l3cfg(f->netns, f->ifindex0);
+
+    {
+        nm_auto_unref_l3cd_init NML3ConfigData *l3cd_init = NULL;
+
+        l3cd_init = nm_l3_config_data_new(f->multiidx, f->ifindex0, NM_IP_CONFIG_SOURCE_USER);
+        for (i = 0; i < N_ROUTES; i++) {
+            /* Let the routes use the default metric, so that the merge needs to
+             * create a new object for each of them. */
+            nm_l3_config_data_add_route_4(
+                l3cd_init,
+                NM_PLATFORM_IP4_ROUTE_INIT(.network    = htonl(0x0a000000u | (i << 8)),
+                                           .plen       = 24,
+                                           .gateway    = nmtst_inet4_from_string("192.168.133.1"),
+                                           .metric_any = TRUE,
+                                           .table_any  = TRUE, ));
+        }
+        l3cd_static = nm_l3_config_data_seal(g_steal_pointer(&l3cd_init));
+    }
+
+    /* The static configuration is more important than the lease, and thus
+     * merged first. */
+    _test_l3cfg_merge_add_config(l3cfg0, 's', l3cd_static, 's');
+
+    for (i = 0; i <= N_RENEWALS; i++) {
+        nm_auto_unref_l3cd_init NML3ConfigData *l3cd_dhcp = NULL;
+
+        l3cd_dhcp = nm_l3_config_data_new(f->multiidx, f->ifindex0, NM_IP_CONFIG_SOURCE_DHCP);
+        nm_l3_config_data_add_address_6(l3cd_dhcp,
+                                        NM_PLATFORM_IP6_ADDRESS_INIT(.address   = addr6,
+                                                                     .plen      = 64,
+                                                                     .timestamp = 1,
+                                                                     .lifetime  = 3600 + i,
+                                                                     .preferred = 1800 + i, ));
+
+        start_time = nm_utils_get_monotonic_timestamp_nsec();
+
+        _test_l3cfg_merge_add_config(l3cfg0, 'd', l3cd_dhcp, 'd');
+        l3cd = nm_l3cfg_get_combined_l3cd(l3cfg0, FALSE);
+
+        if (i == 0)
+            time_first = nm_utils_get_monotonic_timestamp_nsec() - start_time;
+        else
+            time_renewals += nm_utils_get_monotonic_timestamp_nsec() - start_time;
+
+        g_assert(l3cd);
+        g_assert_cmpint(nm_l3_config_data_get_num_routes(l3cd, AF_INET), >=, N_ROUTES);
+        a6 = nm_l3_config_data_lookup_address_6(l3cd, &addr6);
+        g_assert(a6);
+        g_assert_cmpint(a6->lifetime, ==, 3600 + i);
+    }
+
+    _LOGI(">>> merge with %u static routes: first %" G_GINT64_FORMAT
+          " usec, renewal (average of %u) %" G_GINT64_FORMAT " usec",
+          N_ROUTES,
+          time_first / 1000,
+          N_RENEWALS,
+          time_renewals / N_RENEWALS / 1000);
+
+    nm_l3cfg_remove_config_all(l3cfg0, GINT_TO_POINTER('d'));
+    nm_l3cfg_remove_config_all(l3cfg0, GINT_TO_POINTER('s'));
+    nm_l3cfg_commit(l3cfg0, NM_L3_CFG_COMMIT_TYPE_NONE);
+}
+
+/*****************************************************************************/
+
 #define L3IPV4LL_ACD_TIMEOUT_MSEC 1500u
 
 typedef struct {
@@ -1089,6 +1200,7 @@ _nmtstp_setup_tests(void)
     g_test_add_data_func("/l3cfg/2", GINT_TO_POINTER(2), test_l3cfg);
     g_test_add_data_func("/l3cfg/3", GINT_TO_POINTER(3), test_l3cfg);
     g_test_add_data_func("/l3cfg/4", GINT_TO_POINTER(4), test_l3cfg);
+    g_test_add_func("/l3cfg/merge-renewal", test_l3cfg_merge_renewal);
     g_test_add_data_func("/l3-ipv4ll/1", GINT_TO_POINTER(1), test_l3_ipv4ll);
     g_test_add_data_func("/l3-ipv4ll/2", GINT_TO_POINTER(2), test_l3_ipv4ll);
     g_test_add_data_func("/l3-ipv6ll/1", GINT_TO_POINTER(1), test_l3_ipv6ll);
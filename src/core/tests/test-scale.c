@@ -0,0 +1,191 @@
+/* SPDX-License-Identifier: LGPL-2.1-or-later */
+
+#include "src/core/nm-default-daemon.h"
+
+#include <linux/if.h>
+
+#include "nm-l3cfg.h"
+#include "nm-netns.h"
+#include "libnm-platform/nm-platform.h"
+
+#include "platform/tests/test-common.h"
+
+/*****************************************************************************/
+
+/* Scale tests run the layers below NMManager and NMPolicy (NMNetns, NML3Cfg
+ * and the platform cache) against the fake platform, with many links and
+ * routes. Run with "-m perf" (meson benchmark) for the large numbers. The
+ * sizes can be overridden with $NMTST_SCALE_LINKS and $NMTST_SCALE_ROUTES. */
+
+static void
+_add_config(NML3Cfg *l3cfg, const NML3ConfigData *l3cd)
+{
+    nm_l3cfg_add_config(l3cfg,
+                        GINT_TO_POINTER('s'),
+                        TRUE,
+                        l3cd,
+                        's',
+                        0,
+                        0,
+                        NM_PLATFORM_ROUTE_METRIC_DEFAULT_IP4,
+                        NM_PLATFORM_ROUTE_METRIC_DEFAULT_IP6,
+                        0,
+                        0,
+                        NM_DNS_PRIORITY_DEFAULT_NORMAL,
+                        NM_DNS_PRIORITY_DEFAULT_NORMAL,
+                        NM_L3_ACD_DEFEND_TYPE_NEVER,
+                        0,
+                        NM_L3CFG_CONFIG_FLAGS_NONE,
+                        NM_L3_CONFIG_MERGE_FLAGS_NONE);
+}
+
+static void
+test_scale_links_routes(void)
+{
+    const guint                  N_LINKS  = nmtst_scale_get("NMTST_SCALE_LINKS", 30, 1000);
+    const guint                  N_ROUTES = nmtst_scale_get("NMTST_SCALE_ROUTES", 10, 100);
+    NMPlatform                  *platform = NM_PLATFORM_GET;
+    NMDedupMultiIndex           *multiidx = nm_platform_get_multi_idx(platform);
+    gs_unref_object NMNetns     *netns    = NULL;
+    gs_unref_ptrarray GPtrArray *l3cfgs   = NULL;
+    gint64                       rss_start;
+    gint64                       rss_commit;
+    gint64                       t_start;
+    gint64                       t_links;
+    gint64                       t_commit;
+    gint64                       t_recommit;
+    gint64                       t_remove;
+    guint                        i;
+    guint                        j;
+
+    g_assert_cmpint(N_LINKS, <, 1024);
+    g_assert_cmpint(N_ROUTES, <, 128);
+
+    rss_start = nmtst_get_rss_kib();
+    netns     = nm_netns_new(platform);
+    l3cfgs    = g_ptr_array_new_with_free_func(g_object_unref);
+
+    t_start = nm_utils_get_monotonic_timestamp_nsec();
+    for (i = 0; i < N_LINKS; i++) {
+        const NMPlatformLink *plink;
+        char                  ifname[IFNAMSIZ];
+
+        nm_sprintf_buf(ifname, "nm-scale-%u", i);
+        plink = nmtstp_link_dummy_add(platform, FALSE, ifname);
+        g_assert(nm_platform_link_change_flags(platform, plink->ifindex, IFF_UP, TRUE) >= 0);
+        g_ptr_array_add(l3cfgs, nm_netns_l3cfg_acquire(netns, plink->ifindex));
+    }
+    t_links = nm_utils_get_monotonic_timestamp_nsec() - t_start;
+
+    t_start = nm_utils_get_monotonic_timestamp_nsec();
+    for (i = 0; i < N_LINKS; i++) {
+        NML3Cfg                                *l3cfg   = l3cfgs->pdata[i];
+        int                                     ifindex = nm_l3cfg_get_ifindex(l3cfg);
+        nm_auto_unref_l3cd_init NML3ConfigData *l3cd    = NULL;
+        const in_addr_t                         addr    = htonl(0x0a000001u | (i << 8));
+
+        l3cd = nm_l3_config_data_new(multiidx, ifindex, NM_IP_CONFIG_SOURCE_USER);
+        nm_l3_config_data_add_address_4(l3cd,
+                                        NM_PLATFORM_IP4_ADDRESS_INIT(.address      = addr,
+                                                                     .peer_address = addr,
+                                                                     .plen         = 24, ));
+        for (j = 0; j < N_ROUTES; j++) {
+            nm_l3_config_data_add_route_4(
+                l3cd,
+                NM_PLATFORM_IP4_ROUTE_INIT(.network    = htonl(0x64000000u | (i << 14) | (j << 7)),
+                                           .plen       = 25,
+                                           .metric_any = TRUE,
+                                           .table_any  = TRUE, ));
+        }
+        nm_l3_config_data_seal(l3cd);
+
+        _add_config(l3cfg, l3cd);
+        nm_l3cfg_commit(l3cfg, NM_L3_CFG_COMMIT_TYPE_UPDATE);
+    }
+    t_commit   = nm_utils_get_monotonic_timestamp_nsec() - t_start;
+    rss_commit = nmtst_get_rss_kib();
+
+    for (i = 0; i < N_LINKS; i++) {
+        gs_unref_ptrarray GPtrArray *routes =
+            nmtstp_ip4_route_get_all(platform, nm_l3cfg_get_ifindex(l3cfgs->pdata[i]));
+
+        g_assert(routes);
+        g_assert_cmpint(routes->len, >=, N_ROUTES);
+    }
+
+    for (i = 0; i < N_LINKS; i++) {
+        const in_addr_t  addr = htonl(0x64000000u | (i << 14) | ((N_ROUTES - 1) << 7) | 5u);
+        const NMPObject *obj;
+
+        obj = nm_netns_ip_route_lookup(netns, AF_INET, RT_TABLE_MAIN, &addr, 0);
+        g_assert(obj);
+        g_assert_cmpint(NMP_OBJECT_CAST_IP4_ROUTE(obj)->plen, ==, 25);
+        g_assert_cmpint(NMP_OBJECT_CAST_IP4_ROUTE(obj)->ifindex,
+                        ==,
+                        nm_l3cfg_get_ifindex(l3cfgs->pdata[i]));
+    }
+
+    /* A commit without changes, like on a reapply or a platform change. */
+    t_start = nm_utils_get_monotonic_timestamp_nsec();
+    for (i = 0; i < N_LINKS; i++)
+        nm_l3cfg_commit(l3cfgs->pdata[i], NM_L3_CFG_COMMIT_TYPE_UPDATE);
+    t_recommit = nm_utils_get_monotonic_timestamp_nsec() - t_start;
+
+    t_start = nm_utils_get_monotonic_timestamp_nsec();
+    for (i = 0; i < N_LINKS; i++) {
+        NML3Cfg *l3cfg = l3cfgs->pdata[i];
+
+        nm_l3cfg_remove_config_all(l3cfg, GINT_TO_POINTER('s'));
+        nm_l3cfg_commit(l3cfg, NM_L3_CFG_COMMIT_TYPE_REAPPLY);
+    }
+    t_remove = nm_utils_get_monotonic_timestamp_nsec() - t_start;
+
+    _LOGI(">>> scale: %u links with %u routes each: add links %" G_GINT64_FORMAT
+          " msec, commit %" G_GINT64_FORMAT " msec, commit again %" G_GINT64_FORMAT
+          " msec, remove %" G_GINT64_FORMAT " msec, RSS +%" G_GINT64_FORMAT " KiB",
+          N_LINKS,
+          N_ROUTES,
+          t_links / NM_UTILS_NSEC_PER_MSEC,
+          t_commit / NM_UTILS_NSEC_PER_MSEC,
+          t_recommit / NM_UTILS_NSEC_PER_MSEC,
+          t_remove / NM_UTILS_NSEC_PER_MSEC,
+          rss_commit - rss_start);
+
+    for (i = 0; i < N_LINKS; i++) {
+        gs_unref_ptrarray GPtrArray *routes =
+            nmtstp_ip4_route_get_all(platform, nm_l3cfg_get_ifindex(l3cfgs->pdata[i]));
+
+        g_assert(!routes || routes->len == 0);
+    }
+
+    /* The index was updated when the routes got removed. */
+    for (i = 0; i < N_LINKS; i++) {
+        const in_addr_t addr = htonl(0x64000000u | (i << 14) | 5u);
+
+        g_assert(!nm_netns_ip_route_lookup(netns, AF_INET, RT_TABLE_MAIN, &addr, 0));
+    }
+
+    g_ptr_array_set_size(l3cfgs, 0);
+    for (i = 0; i < N_LINKS; i++) {
+        char ifname[IFNAMSIZ];
+
+        nm_sprintf_buf(ifname, "nm-scale-%u", i);
+        nmtstp_link_delete(platform, FALSE, -1, ifname, TRUE);
+    }
+}
+
+/*****************************************************************************/
+
+NMTstpSetupFunc const _nmtstp_setup_platform_func = nm_fake_platform_setup;
+
+void
+_nmtstp_init_tests(int *argc, char ***argv)
+{
+    nmtst_init_with_logging(argc, argv, "ERR", "ALL");
+}
+
+void
+_nmtstp_setup_tests(void)
+{
+    g_test_add_func("/scale/links-routes", test_scale_links_routes);
+}
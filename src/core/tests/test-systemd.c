@@ -83,6 +83,86 @@ test_sd_event(void)
 
 /*****************************************************************************/
 
+#define N_COALESCE_TIMERS 50
+
+typedef struct {
+    GMainLoop       *mainloop;
+    sd_event_source *event_sources[N_COALESCE_TIMERS];
+    guint            n_fired;
+} TestSdEventCoalesceData;
+
+static int
+_test_sd_event_coalesce_cb(sd_event_source *s, uint64_t usec, void *userdata)
+{
+    TestSdEventCoalesceData *user_data = userdata;
+
+    if (++user_data->n_fired == N_COALESCE_TIMERS)
+        g_main_loop_quit(user_data->mainloop);
+    return 0;
+}
+
+static void
+test_sd_event_coalesce(void)
+{
+    TestSdEventCoalesceData user_data = {0};
+    sd_event               *event     = NULL;
+    guint                   sd_id;
+    guint64                 n_wakeups_before;
+    guint64                 n_wakeups_after;
+    guint64                 n_dispatched_before;
+    guint64                 n_dispatched_after;
+    uint64_t                now_usec;
+    int                     r;
+    int                     i;
+
+    sd_id = nm_sd_event_attach_default();
+
+    r = sd_event_default(&event);
+    g_assert(r >= 0 && event);
+
+    r = sd_event_now(event, CLOCK_MONOTONIC, &now_usec);
+    g_assert_cmpint(r, >=, 0);
+
+    /* Like the timers of many DHCP clients, that expire within their accuracy. */
+    for (i = 0; i < N_COALESCE_TIMERS; i++) {
+        r = sd_event_add_time(event,
+                              &user_data.event_sources[i],
+                              CLOCK_MONOTONIC,
+                              now_usec + 20000 + (i * 100),
+                              100000,
+                              _test_sd_event_coalesce_cb,
+                              &user_data);
+        g_assert(r >= 0 && user_data.event_sources[i]);
+    }
+
+    nm_sd_event_get_stats(&n_wakeups_before, &n_dispatched_before);
+
+    user_data.mainloop = g_main_loop_new(NULL, FALSE);
+    g_main_loop_run(user_data.mainloop);
+    g_main_loop_unref(user_data.mainloop);
+
+    nm_sd_event_get_stats(&n_wakeups_after, &n_dispatched_after);
+
+    g_test_message("%d timers: %" G_GUINT64_FORMAT " wakeups, %" G_GUINT64_FORMAT
+                   " sources dispatched",
+                   N_COALESCE_TIMERS,
+                   n_wakeups_after - n_wakeups_before,
+                   n_dispatched_after - n_dispatched_before);
+
+    g_assert_cmpint(user_data.n_fired, ==, N_COALESCE_TIMERS);
+    g_assert_cmpint(n_dispatched_after - n_dispatched_before, >=, N_COALESCE_TIMERS);
+    g_assert_cmpint(n_wakeups_after - n_wakeups_before, <, N_COALESCE_TIMERS);
+
+    for (i = 0; i < N_COALESCE_TIMERS; i++)
+        user_data.event_sources[i] = sd_event_source_unref(user_data.event_sources[i]);
+    event = sd_event_unref(event);
+    nm_clear_g_source(&sd_id);
+
+    g_assert_cmpint(sd_event_default(NULL), ==, 0);
+}
+
+/*****************************************************************************/
+
 NMTST_DEFINE();
 
 int
@@ -91,6 +171,7 @@ main(int argc, char **argv)
     nmtst_init(&argc, &argv, TRUE);
 
     g_test_add_func("/systemd/sd-event", test_sd_event);
+    g_test_add_func("/systemd/sd-event/coalesce", test_sd_event_coalesce);
 
     return g_test_run();
 }
@@ -1347,6 +1347,14 @@ nm_vpn_connection_get_service(NMVpnConnection *self)
     return nm_setting_vpn_get_service_type(s_vpn);
 }
 
+const char *
+nm_vpn_connection_get_bus_name(NMVpnConnection *self)
+{
+    g_return_val_if_fail(NM_IS_VPN_CONNECTION(self), NULL);
+
+    return NM_VPN_CONNECTION_GET_PRIVATE(self)->dbus.bus_name;
+}
+
 static void
 _apply_config(NMVpnConnection *self)
 {
@@ -1935,6 +1943,86 @@ _dbus_signal_config_cb(NMVpnConnection *self, GVariant *dict)
     _check_complete(self, TRUE);
 }
 
+static gboolean
+_config_add_routes_packed(NMVpnConnection *self,
+                          int              addr_family,
+                          GVariant        *dict,
+                          NML3ConfigData  *l3cd)
+{
+    NMVpnConnectionPrivate    *priv     = NM_VPN_CONNECTION_GET_PRIVATE(self);
+    const int                  IS_IPv4  = NM_IS_IPv4(addr_family);
+    const gsize                addr_len = nm_utils_addr_family_to_size(addr_family);
+    const gsize                rec_len  = 3 * addr_len + 1;
+    gs_unref_variant GVariant *v        = NULL;
+    const guint8              *data;
+    gsize                      len;
+    gsize                      i;
+
+    v = g_variant_lookup_value(dict,
+                               IS_IPv4 ? NM_VPN_PLUGIN_IP4_CONFIG_ROUTES_PACKED
+                                       : NM_VPN_PLUGIN_IP6_CONFIG_ROUTES_PACKED,
+                               G_VARIANT_TYPE_BYTESTRING);
+    if (!v)
+        return FALSE;
+
+    data = g_variant_get_fixed_array(v, &len, 1);
+    if (len % rec_len != 0) {
+        _LOGW("invalid IP%c config received: packed routes of invalid length %zu",
+              nm_utils_addr_family_to_char(addr_family),
+              len);
+        return TRUE;
+    }
+
+    for (i = 0; i < len; i += rec_len) {
+        const guint8      *rec  = &data[i];
+        const guint8       plen = rec[3 * addr_len];
+        NMPlatformIPXRoute route;
+
+        if (plen > (IS_IPv4 ? 32 : 128))
+            continue;
+
+        if (IS_IPv4) {
+            route.r4 = (NMPlatformIP4Route) {
+                .plen       = plen,
+                .table_any  = TRUE,
+                .metric_any = TRUE,
+                .rt_source  = NM_IP_CONFIG_SOURCE_VPN,
+            };
+            memcpy(&route.r4.network, &rec[0], sizeof(in_addr_t));
+            memcpy(&route.r4.gateway, &rec[addr_len], sizeof(in_addr_t));
+            memcpy(&route.r4.pref_src, &rec[2 * addr_len], sizeof(in_addr_t));
+            route.r4.network = nm_ip4_addr_clear_host_address(route.r4.network, plen);
+
+            /* Ignore host routes to the VPN gateway, like for the legacy format. */
+            if (priv->ip_data_4.gw_external.addr4
+                && route.r4.network == priv->ip_data_4.gw_external.addr4 && plen == 32)
+                continue;
+
+            nm_l3_config_data_add_route_4(l3cd, &route.r4);
+        } else {
+            route.r6 = (NMPlatformIP6Route) {
+                .plen       = plen,
+                .table_any  = TRUE,
+                .metric_any = TRUE,
+                .rt_source  = NM_IP_CONFIG_SOURCE_VPN,
+            };
+            memcpy(&route.r6.network, &rec[0], sizeof(struct in6_addr));
+            memcpy(&route.r6.gateway, &rec[addr_len], sizeof(struct in6_addr));
+            memcpy(&route.r6.pref_src, &rec[2 * addr_len], sizeof(struct in6_addr));
+            nm_ip6_addr_clear_host_address(&route.r6.network, &route.r6.network, plen);
+
+            if (!IN6_IS_ADDR_UNSPECIFIED(&priv->ip_data_6.gw_external.addr6)
+                && IN6_ARE_ADDR_EQUAL(&route.r6.network, &priv->ip_data_6.gw_external.addr6)
+                && plen == 128)
+                continue;
+
+            nm_l3_config_data_add_route_6(l3cd, &route.r6);
+        }
+    }
+
+    return TRUE;
+}
+
 static void
 _dbus_signal_ip_config_cb(NMVpnConnection *self, int addr_family, GVariant *dict)
 {
@@ -2138,32 +2226,40 @@ _dbus_signal_ip_config_cb(NMVpnConnection *self, int addr_family, GVariant *dict
                                                  NMP_OBJECT_TYPE_IP_ROUTE(IS_IPv4))
                 nm_l3_config_data_add_route(l3cd, addr_family, route, NULL);
         }
+    } else if (_config_add_routes_packed(self, addr_family, dict, l3cd)) {
+        /* The compact "routes-packed" list takes precedence over "routes". */
     } else if (IS_IPv4) {
         if (g_variant_lookup(dict, NM_VPN_PLUGIN_IP4_CONFIG_ROUTES, "aau", &var_iter)) {
             _nm_unused nm_auto_free_variant_iter GVariantIter *var_iter_ref_owner = var_iter;
-            NMPlatformIPXRoute                                 route              = {};
+            NMPlatformIPXRoute                                 route;
             guint32                                            plen;
 
             while (g_variant_iter_next(var_iter, "@au", &v)) {
                 _nm_unused gs_unref_variant GVariant *v_ref_owner = v;
+                const guint32                        *v_arr;
+                gsize                                 v_len;
 
-                switch (g_variant_n_children(v)) {
+                /* Some VPNs push many thousand routes. Read the route fields directly
+                 * from the serialized data, instead of creating a GVariant for each. */
+                v_arr = g_variant_get_fixed_array(v, &v_len, sizeof(guint32));
+
+                switch (v_len) {
                 case 5:
-                    g_variant_get_child(v, 4, "u", &route.r4.pref_src);
-                    /* fall-through */
                 case 4:
-                    g_variant_get_child(v, 0, "u", &route.r4.network);
-                    g_variant_get_child(v, 1, "u", &plen);
-                    g_variant_get_child(v, 2, "u", &route.r4.gateway);
                     /* 4th item is unused route metric */
-                    route.r4.table_any  = TRUE;
-                    route.r4.metric_any = TRUE;
-                    route.r4.rt_source  = NM_IP_CONFIG_SOURCE_VPN;
-
+                    plen = v_arr[1];
                     if (plen > 32)
                         break;
-                    route.r4.plen    = plen;
-                    route.r4.network = nm_ip4_addr_clear_host_address(route.r4.network, plen);
+
+                    route.r4 = (NMPlatformIP4Route) {
+                        .network    = nm_ip4_addr_clear_host_address(v_arr[0], plen),
+                        .plen       = plen,
+                        .gateway    = v_arr[2],
+                        .pref_src   = v_len == 5 ? v_arr[4] : 0u,
+                        .table_any  = TRUE,
+                        .metric_any = TRUE,
+                        .rt_source  = NM_IP_CONFIG_SOURCE_VPN,
+                    };
 
                     if (priv->ip_data_4.gw_external.addr4
                         && route.r4.network == priv->ip_data_4.gw_external.addr4
@@ -2579,31 +2675,29 @@ _get_log_level(void)
     return LOG_EMERG;
 }
 
-static gboolean
-nm_vpn_service_daemon_exec(NMVpnConnection *self, GError **error)
-{
-    NMVpnConnectionPrivate *priv;
-    GPid                    pid;
-    char                   *vpn_argv[4];
-    gs_free char          **envp = NULL;
-    char                    env_log_level[NM_STRLEN("NM_VPN_LOG_LEVEL=") + 100];
-    char                    env_log_syslog[NM_STRLEN("NM_VPN_LOG_SYSLOG=") + 10];
-    const gsize             N_ENVIRON_EXTRA = 3;
-    char                  **p_environ;
-    gsize                   n_environ;
-    gsize                   i;
-    gsize                   j;
-
-    g_return_val_if_fail(NM_IS_VPN_CONNECTION(self), FALSE);
-
-    priv = NM_VPN_CONNECTION_GET_PRIVATE(self);
+gboolean
+nm_vpn_service_daemon_exec(NMVpnPluginInfo *plugin_info, const char *bus_name, GError **error)
+{
+    GPid           pid;
+    char          *vpn_argv[4];
+    gs_free char **envp = NULL;
+    char           env_log_level[NM_STRLEN("NM_VPN_LOG_LEVEL=") + 100];
+    char           env_log_syslog[NM_STRLEN("NM_VPN_LOG_SYSLOG=") + 10];
+    const gsize    N_ENVIRON_EXTRA = 3;
+    char         **p_environ;
+    gsize          n_environ;
+    gsize          i;
+    gsize          j;
+
+    g_return_val_if_fail(NM_IS_VPN_PLUGIN_INFO(plugin_info), FALSE);
+    g_return_val_if_fail(bus_name, FALSE);
 
     i             = 0;
-    vpn_argv[i++] = (char *) nm_vpn_plugin_info_get_program(priv->plugin_info);
+    vpn_argv[i++] = (char *) nm_vpn_plugin_info_get_program(plugin_info);
     g_return_val_if_fail(vpn_argv[0], FALSE);
-    if (nm_vpn_plugin_info_supports_multiple(priv->plugin_info)) {
+    if (nm_vpn_plugin_info_supports_multiple(plugin_info)) {
         vpn_argv[i++] = "--bus-name";
-        vpn_argv[i++] = priv->dbus.bus_name;
+        vpn_argv[i++] = (char *) bus_name;
     }
     vpn_argv[i++] = NULL;
 
@@ -2635,7 +2729,7 @@ nm_vpn_service_daemon_exec(NMVpnConnection *self, GError **error)
     if (!g_spawn_async(NULL, vpn_argv, envp, 0, nm_utils_setpgid, NULL, &pid, error))
         return FALSE;
 
-    _LOGD("starting: VPN service has PID %lld", (long long) pid);
+    nm_log_dbg(LOGD_VPN, "vpn: started service %s with PID %lld", bus_name, (long long) pid);
     return TRUE;
 }
 
@@ -2724,7 +2818,7 @@ _name_owner_changed(NMVpnConnection *self, const char *owner, gboolean initializ
         nm_assert(!priv->dbus.owner);
         _LOGT("dbus: no name owner for %s (start VPN service)", priv->dbus.bus_name);
 
-        if (!nm_vpn_service_daemon_exec(self, &error)) {
+        if (!nm_vpn_service_daemon_exec(priv->plugin_info, priv->dbus.bus_name, &error)) {
             _LOGW("starting: failure to start VPN service: %s", error->message);
             nm_vpn_connection_disconnect(self,
                                          NM_ACTIVE_CONNECTION_STATE_REASON_SERVICE_START_FAILED,
@@ -2825,12 +2919,13 @@ _init_fail_on_idle_cb(gpointer user_data)
 /*****************************************************************************/
 
 void
-nm_vpn_connection_activate(NMVpnConnection *self, NMVpnPluginInfo *plugin_info)
+nm_vpn_connection_activate(NMVpnConnection *self,
+                           NMVpnPluginInfo *plugin_info,
+                           const char      *bus_name)
 {
     NMVpnConnectionPrivate *priv;
     NMConnection           *connection;
     NMSettingVpn           *s_vpn;
-    const char             *service;
 
     g_return_if_fail(NM_IS_VPN_CONNECTION(self));
     g_return_if_fail(NM_IS_VPN_PLUGIN_INFO(plugin_info));
@@ -2843,20 +2938,11 @@ nm_vpn_connection_activate(NMVpnConnection *self, NMVpnPluginInfo *plugin_info)
     s_vpn = nm_connection_get_setting_vpn(connection);
     g_return_if_fail(s_vpn);
 
-    service = nm_vpn_plugin_info_get_service(plugin_info);
-    nm_assert(service);
-
-    if (nm_vpn_plugin_info_supports_multiple(plugin_info)) {
-        const char *path;
-
-        path = nm_dbus_object_get_path(NM_DBUS_OBJECT(self));
-        if (path)
-            path = strrchr(path, '/');
-        g_return_if_fail(path);
-
-        priv->dbus.bus_name = g_strdup_printf("%s.Connection_%s", service, &path[1]);
-    } else
-        priv->dbus.bus_name = g_strdup(service);
+    /* The bus name is picked by NMVpnManager. For plugins that support multiple
+     * connections, it is a slot that gets reused after the previous connection
+     * in that slot is gone. That way we can reuse a plugin process that is still
+     * around, instead of spawning a new one. */
+    priv->dbus.bus_name = g_strdup(bus_name);
 
     _LOGI("starting %s", nm_vpn_plugin_info_get_name(plugin_info));
 
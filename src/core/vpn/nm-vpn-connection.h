@@ -42,10 +42,17 @@ NMVpnConnection *nm_vpn_connection_new(NMSettingsConnection  *settings_connectio
                                        NMActivationStateFlags initial_state_flags,
                                        NMAuthSubject         *subject);
 
-void nm_vpn_connection_activate(NMVpnConnection *self, NMVpnPluginInfo *plugin_info);
+void nm_vpn_connection_activate(NMVpnConnection *self,
+                                NMVpnPluginInfo *plugin_info,
+                                const char      *bus_name);
 NMVpnConnectionState nm_vpn_connection_get_vpn_state(NMVpnConnection *self);
 const char          *nm_vpn_connection_get_banner(NMVpnConnection *self);
 const char          *nm_vpn_connection_get_service(NMVpnConnection *self);
+const char          *nm_vpn_connection_get_bus_name(NMVpnConnection *self);
+
+gboolean nm_vpn_service_daemon_exec(NMVpnPluginInfo *plugin_info,
+                                    const char      *bus_name,
+                                    GError         **error);
 
 gboolean nm_vpn_connection_deactivate(NMVpnConnection              *self,
                                       NMActiveConnectionStateReason reason,
@@ -13,6 +13,8 @@
 #include "nm-setting-vpn.h"
 #include "nm-vpn-dbus-interface.h"
 #include "libnm-core-intern/nm-core-internal.h"
+#include "libnm-glib-aux/nm-dbus-aux.h"
+#include "nm-dbus-manager.h"
 
 typedef struct {
     GSList       *plugins;
@@ -21,9 +23,10 @@ typedef struct {
     gulong        monitor_id_etc;
     gulong        monitor_id_lib;
 
-    /* This is only used for services that don't support multiple
-     * connections, to guard access to them. */
-    GHashTable *active_services;
+    /* The D-Bus names of the VPN services in use by active connections.
+     * For services that don't support multiple connections, this is the
+     * service name itself and guards access to them. */
+    GHashTable *active_bus_names;
 } NMVpnManagerPrivate;
 
 struct _NMVpnManager {
@@ -46,15 +49,36 @@ vpn_state_changed(NMVpnConnection *vpn, GParamSpec *pspec, NMVpnManager *manager
 {
     NMVpnManagerPrivate    *priv  = NM_VPN_MANAGER_GET_PRIVATE(manager);
     NMActiveConnectionState state = nm_active_connection_get_state(NM_ACTIVE_CONNECTION(vpn));
-    const char             *service_name = nm_vpn_connection_get_service(vpn);
 
     if (state == NM_ACTIVE_CONNECTION_STATE_DEACTIVATED) {
-        g_hash_table_remove(priv->active_services, service_name);
+        g_hash_table_remove(priv->active_bus_names, nm_vpn_connection_get_bus_name(vpn));
         g_signal_handlers_disconnect_by_func(vpn, vpn_state_changed, manager);
         g_object_unref(manager);
     }
 }
 
+static char *
+_bus_name_next(NMVpnManager *self, NMVpnPluginInfo *plugin_info)
+{
+    NMVpnManagerPrivate *priv    = NM_VPN_MANAGER_GET_PRIVATE(self);
+    const char          *service = nm_vpn_plugin_info_get_service(plugin_info);
+    guint                i;
+
+    if (!nm_vpn_plugin_info_supports_multiple(plugin_info))
+        return g_strdup(service);
+
+    /* Use the lowest free slot. A reconnecting VPN thus gets the bus name of the
+     * previous activation and can reuse the plugin process, if it is still running. */
+    for (i = 1;; i++) {
+        char *bus_name;
+
+        bus_name = g_strdup_printf("%s.Connection_%u", service, i);
+        if (!g_hash_table_contains(priv->active_bus_names, bus_name))
+            return bus_name;
+        g_free(bus_name);
+    }
+}
+
 gboolean
 nm_vpn_manager_activate_connection(NMVpnManager *manager, NMVpnConnection *vpn, GError **error)
 {
@@ -62,6 +86,7 @@ nm_vpn_manager_activate_connection(NMVpnManager *manager, NMVpnConnection *vpn,
     NMVpnPluginInfo     *plugin_info;
     const char          *service_name;
     NMDevice            *device;
+    gs_free char        *bus_name = NULL;
 
     g_return_val_if_fail(NM_IS_VPN_MANAGER(manager), FALSE);
     g_return_val_if_fail(NM_IS_VPN_CONNECTION(vpn), FALSE);
@@ -92,7 +117,8 @@ nm_vpn_manager_activate_connection(NMVpnManager *manager, NMVpnConnection *vpn,
     }
 
     if (!nm_vpn_plugin_info_supports_multiple(plugin_info)
-        && g_hash_table_contains(priv->active_services, service_name)) {
+        && g_hash_table_contains(priv->active_bus_names,
+                                 nm_vpn_plugin_info_get_service(plugin_info))) {
         g_set_error(error,
                     NM_MANAGER_ERROR,
                     NM_MANAGER_ERROR_CONNECTION_NOT_AVAILABLE,
@@ -101,20 +127,94 @@ nm_vpn_manager_activate_connection(NMVpnManager *manager, NMVpnConnection *vpn,
         return FALSE;
     }
 
-    nm_vpn_connection_activate(vpn, plugin_info);
+    bus_name = _bus_name_next(manager, plugin_info);
 
-    if (!nm_vpn_plugin_info_supports_multiple(plugin_info)) {
-        /* Block activations of the connections of the same service type. */
-        g_hash_table_add(priv->active_services, g_strdup(service_name));
-        g_signal_connect(vpn,
-                         "notify::" NM_ACTIVE_CONNECTION_STATE,
-                         G_CALLBACK(vpn_state_changed),
-                         g_object_ref(manager));
-    }
+    nm_vpn_connection_activate(vpn, plugin_info, bus_name);
+
+    /* Block activations on the same bus name until the connection is gone. */
+    g_hash_table_add(priv->active_bus_names, g_steal_pointer(&bus_name));
+    g_signal_connect(vpn,
+                     "notify::" NM_ACTIVE_CONNECTION_STATE,
+                     G_CALLBACK(vpn_state_changed),
+                     g_object_ref(manager));
 
     return TRUE;
 }
 
+static void
+_prestart_name_owner_cb(const char *name_owner, GError *error, gpointer user_data)
+{
+    gs_unref_object NMVpnPluginInfo *plugin_info = NULL;
+    gs_free char                    *bus_name    = NULL;
+    gs_free_error GError            *exec_error  = NULL;
+
+    nm_utils_user_data_unpack(user_data, &plugin_info, &bus_name);
+
+    if (nm_str_not_empty(name_owner)) {
+        /* Already running. Nothing to do. */
+        return;
+    }
+
+    if (!nm_vpn_service_daemon_exec(plugin_info, bus_name, &exec_error)) {
+        nm_log_dbg(LOGD_VPN,
+                   "vpn: failed to prestart service %s: %s",
+                   bus_name,
+                   exec_error->message);
+    }
+}
+
+/**
+ * nm_vpn_manager_prestart_service:
+ * @manager: the #NMVpnManager
+ * @service_name: the VPN service type of a connection that is about
+ *   to be activated
+ *
+ * Spawns the VPN service for @service_name, if it is not yet running.
+ * This is done while the base device is still activating, so that the
+ * VPN activation later doesn't have to wait for the service to start.
+ * The process gets the bus name that the next activation of
+ * @service_name will use, and that activation picks it up.
+ */
+void
+nm_vpn_manager_prestart_service(NMVpnManager *manager, const char *service_name)
+{
+    NMVpnManagerPrivate *priv;
+    NMVpnPluginInfo     *plugin_info;
+    GDBusConnection     *dbus_connection;
+    char                *bus_name;
+
+    g_return_if_fail(NM_IS_VPN_MANAGER(manager));
+
+    priv = NM_VPN_MANAGER_GET_PRIVATE(manager);
+
+    if (!service_name)
+        return;
+
+    plugin_info = nm_vpn_plugin_info_list_find_by_service(priv->plugins, service_name);
+    if (!plugin_info)
+        return;
+
+    dbus_connection = NM_MAIN_DBUS_CONNECTION_GET;
+    if (!dbus_connection)
+        return;
+
+    bus_name = _bus_name_next(manager, plugin_info);
+    if (g_hash_table_contains(priv->active_bus_names, bus_name)) {
+        /* A single-instance service that is busy with another connection. */
+        g_free(bus_name);
+        return;
+    }
+
+    nm_log_dbg(LOGD_VPN, "vpn: prestart service %s", bus_name);
+    nm_dbus_connection_call_get_name_owner(
+        dbus_connection,
+        bus_name,
+        3000,
+        NULL,
+        _prestart_name_owner_cb,
+        nm_utils_user_data_pack(g_object_ref(plugin_info), bus_name));
+}
+
 /*****************************************************************************/
 
 static void
@@ -243,7 +343,7 @@ nm_vpn_manager_init(NMVpnManager *self)
         try_add_plugin(self, info->data);
     g_slist_free_full(infos, g_object_unref);
 
-    priv->active_services = g_hash_table_new_full(nm_str_hash, g_str_equal, g_free, NULL);
+    priv->active_bus_names = g_hash_table_new_full(nm_str_hash, g_str_equal, g_free, NULL);
 }
 
 static void
@@ -268,7 +368,7 @@ dispose(GObject *object)
     while (priv->plugins)
         nm_vpn_plugin_info_list_remove(&priv->plugins, priv->plugins->data);
 
-    g_hash_table_unref(priv->active_services);
+    g_hash_table_unref(priv->active_bus_names);
 
     G_OBJECT_CLASS(nm_vpn_manager_parent_class)->dispose(object);
 }
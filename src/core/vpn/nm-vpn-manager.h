@@ -29,4 +29,6 @@ NMVpnManager *nm_vpn_manager_get(void);
 gboolean
 nm_vpn_manager_activate_connection(NMVpnManager *manager, NMVpnConnection *vpn, GError **error);
 
+void nm_vpn_manager_prestart_service(NMVpnManager *manager, const char *service_name);
+
 #endif /* __NM_VPN_MANAGER_H__ */
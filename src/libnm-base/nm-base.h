@@ -139,7 +139,12 @@ typedef enum {
     NM_ETHTOOL_ID_FEC_MODE   = _NM_ETHTOOL_ID_FEC_FIRST,
     _NM_ETHTOOL_ID_FEC_LAST  = NM_ETHTOOL_ID_FEC_MODE,
 
-    _NM_ETHTOOL_ID_LAST = _NM_ETHTOOL_ID_FEC_LAST,
+    _NM_ETHTOOL_ID_RSS_FIRST = _NM_ETHTOOL_ID_FEC_LAST + 1,
+    NM_ETHTOOL_ID_RSS_EQUAL  = _NM_ETHTOOL_ID_RSS_FIRST,
+    NM_ETHTOOL_ID_RSS_HFUNC,
+    _NM_ETHTOOL_ID_RSS_LAST = NM_ETHTOOL_ID_RSS_HFUNC,
+
+    _NM_ETHTOOL_ID_LAST = _NM_ETHTOOL_ID_RSS_LAST,
 
     _NM_ETHTOOL_ID_COALESCE_NUM =
         (_NM_ETHTOOL_ID_COALESCE_LAST - _NM_ETHTOOL_ID_COALESCE_FIRST + 1),
@@ -163,6 +168,7 @@ typedef enum {
     NM_ETHTOOL_TYPE_CHANNELS,
     NM_ETHTOOL_TYPE_EEE,
     NM_ETHTOOL_TYPE_FEC,
+    NM_ETHTOOL_TYPE_RSS,
 } NMEthtoolType;
 
 /****************************************************************************/
@@ -209,6 +215,12 @@ nm_ethtool_id_is_fec(NMEthtoolID id)
     return id >= _NM_ETHTOOL_ID_FEC_FIRST && id <= _NM_ETHTOOL_ID_FEC_LAST;
 }
 
+static inline gboolean
+nm_ethtool_id_is_rss(NMEthtoolID id)
+{
+    return id >= _NM_ETHTOOL_ID_RSS_FIRST && id <= _NM_ETHTOOL_ID_RSS_LAST;
+}
+
 /*****************************************************************************/
 
 typedef enum {
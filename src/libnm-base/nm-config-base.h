@@ -23,24 +23,40 @@
 #define NM_CONFIG_KEYFILE_KEY_MAIN_AUTH_POLKIT                 "auth-polkit"
 #define NM_CONFIG_KEYFILE_KEY_MAIN_AUTOCONNECT_RETRIES_DEFAULT "autoconnect-retries-default"
 #define NM_CONFIG_KEYFILE_KEY_MAIN_CONFIGURE_AND_QUIT          "configure-and-quit"
+#define NM_CONFIG_KEYFILE_KEY_MAIN_DBUS_LAZY_EXPORT            "dbus-lazy-export"
+#define NM_CONFIG_KEYFILE_KEY_MAIN_DBUS_NOTIFY_DELAY           "dbus-notify-delay"
 #define NM_CONFIG_KEYFILE_KEY_MAIN_DEBUG                       "debug"
 #define NM_CONFIG_KEYFILE_KEY_MAIN_DHCP                        "dhcp"
+#define NM_CONFIG_KEYFILE_KEY_MAIN_DHCP_START_RATE             "dhcp-start-rate"
 #define NM_CONFIG_KEYFILE_KEY_MAIN_DNS                         "dns"
+#define NM_CONFIG_KEYFILE_KEY_MAIN_FAST_RESUME                 "fast-resume"
 #define NM_CONFIG_KEYFILE_KEY_MAIN_FIREWALL_BACKEND            "firewall-backend"
 #define NM_CONFIG_KEYFILE_KEY_MAIN_HOSTNAME_MODE               "hostname-mode"
 #define NM_CONFIG_KEYFILE_KEY_MAIN_IGNORE_CARRIER              "ignore-carrier"
+#define NM_CONFIG_KEYFILE_KEY_MAIN_IGNORE_DEVICES              "ignore-devices"
+#define NM_CONFIG_KEYFILE_KEY_MAIN_IGNORE_PORT_REPRESENTORS    "ignore-port-representors"
 #define NM_CONFIG_KEYFILE_KEY_MAIN_IWD_CONFIG_PATH             "iwd-config-path"
+#define NM_CONFIG_KEYFILE_KEY_MAIN_LOW_WAKEUP                  "low-wakeup"
 #define NM_CONFIG_KEYFILE_KEY_MAIN_MIGRATE_IFCFG_RH            "migrate-ifcfg-rh"
 #define NM_CONFIG_KEYFILE_KEY_MAIN_MONITOR_CONNECTION_FILES    "monitor-connection-files"
+#define NM_CONFIG_KEYFILE_KEY_MAIN_NETLINK_RCVBUF_MAX          "netlink-rcvbuf-max"
 #define NM_CONFIG_KEYFILE_KEY_MAIN_NO_AUTO_DEFAULT             "no-auto-default"
 #define NM_CONFIG_KEYFILE_KEY_MAIN_PLUGINS                     "plugins"
+#define NM_CONFIG_KEYFILE_KEY_MAIN_PPPOE_DISCOVERY             "pppoe-discovery"
 #define NM_CONFIG_KEYFILE_KEY_MAIN_RC_MANAGER                  "rc-manager"
+#define NM_CONFIG_KEYFILE_KEY_MAIN_SECRET_AGENT_CACHE_TIMEOUT  "secret-agent-cache-timeout"
+#define NM_CONFIG_KEYFILE_KEY_MAIN_SHARED_DHCP                 "shared-dhcp"
+#define NM_CONFIG_KEYFILE_KEY_MAIN_SHARED_DNS_FORWARDER        "shared-dns-forwarder"
+#define NM_CONFIG_KEYFILE_KEY_MAIN_STATE_FILES_SYNC            "state-files-sync"
 #define NM_CONFIG_KEYFILE_KEY_MAIN_SYSTEMD_RESOLVED            "systemd-resolved"
+#define NM_CONFIG_KEYFILE_KEY_MAIN_TRACKED_ROUTE_TABLES        "tracked-route-tables"
 
-#define NM_CONFIG_KEYFILE_KEY_LOGGING_AUDIT   "audit"
-#define NM_CONFIG_KEYFILE_KEY_LOGGING_BACKEND "backend"
-#define NM_CONFIG_KEYFILE_KEY_LOGGING_DOMAINS "domains"
-#define NM_CONFIG_KEYFILE_KEY_LOGGING_LEVEL   "level"
+#define NM_CONFIG_KEYFILE_KEY_LOGGING_AUDIT               "audit"
+#define NM_CONFIG_KEYFILE_KEY_LOGGING_BACKEND             "backend"
+#define NM_CONFIG_KEYFILE_KEY_LOGGING_DOMAINS             "domains"
+#define NM_CONFIG_KEYFILE_KEY_LOGGING_LEVEL               "level"
+#define NM_CONFIG_KEYFILE_KEY_LOGGING_PLATFORM_TRACE_SIZE "platform-trace-size"
+#define NM_CONFIG_KEYFILE_KEY_LOGGING_RATE_LIMIT          "rate-limit"
 
 #define NM_CONFIG_KEYFILE_KEY_CONNECTIVITY_ENABLED  "enabled"
 #define NM_CONFIG_KEYFILE_KEY_CONNECTIVITY_INTERVAL "interval"
@@ -52,6 +68,7 @@
 #define NM_CONFIG_KEYFILE_KEY_KEYFILE_UNMANAGED_DEVICES "unmanaged-devices"
 #define NM_CONFIG_KEYFILE_KEY_KEYFILE_HOSTNAME          "hostname"
 #define NM_CONFIG_KEYFILE_KEY_KEYFILE_RENAME            "rename"
+#define NM_CONFIG_KEYFILE_KEY_KEYFILE_CONNECTION_CACHE  "connection-cache"
 
 #define NM_CONFIG_KEYFILE_KEY_IFUPDOWN_MANAGED "managed"
 
@@ -73,8 +90,9 @@
 #define NM_CONFIG_KEYFILE_KEY_DEVICE_WIFI_SCAN_RAND_MAC_ADDRESS "wifi.scan-rand-mac-address"
 #define NM_CONFIG_KEYFILE_KEY_DEVICE_WIFI_SCAN_GENERATE_MAC_ADDRESS_MASK \
     "wifi.scan-generate-mac-address-mask"
-#define NM_CONFIG_KEYFILE_KEY_DEVICE_CARRIER_WAIT_TIMEOUT "carrier-wait-timeout"
-#define NM_CONFIG_KEYFILE_KEY_DEVICE_WIFI_IWD_AUTOCONNECT "wifi.iwd.autoconnect"
+#define NM_CONFIG_KEYFILE_KEY_DEVICE_CARRIER_WAIT_TIMEOUT       "carrier-wait-timeout"
+#define NM_CONFIG_KEYFILE_KEY_DEVICE_WIFI_IWD_AUTOCONNECT       "wifi.iwd.autoconnect"
+#define NM_CONFIG_KEYFILE_KEY_DEVICE_AUTOCONNECT_QUEUE_PRIORITY "autoconnect-queue-priority"
 
 #define NM_CONFIG_KEYFILE_KEY_MATCH_DEVICE "match-device"
 #define NM_CONFIG_KEYFILE_KEY_STOP_MATCH   "stop-match"
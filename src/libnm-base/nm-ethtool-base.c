@@ -112,6 +112,8 @@ const NMEthtoolData *const nm_ethtool_data[_NM_ETHTOOL_ID_NUM + 1] = {
     ETHT_DATA(CHANNELS_OTHER),
     ETHT_DATA(CHANNELS_COMBINED),
     ETHT_DATA(FEC_MODE),
+    ETHT_DATA(RSS_EQUAL),
+    ETHT_DATA(RSS_HFUNC),
     [_NM_ETHTOOL_ID_NUM] = NULL,
 };
 
@@ -210,6 +212,8 @@ static const guint8 _by_name[_NM_ETHTOOL_ID_NUM] = {
     NM_ETHTOOL_ID_RING_RX_JUMBO,
     NM_ETHTOOL_ID_RING_RX_MINI,
     NM_ETHTOOL_ID_RING_TX,
+    NM_ETHTOOL_ID_RSS_EQUAL,
+    NM_ETHTOOL_ID_RSS_HFUNC,
 };
 
 /*****************************************************************************/
@@ -309,6 +313,8 @@ nm_ethtool_id_to_type(NMEthtoolID id)
         return NM_ETHTOOL_TYPE_EEE;
     if (nm_ethtool_id_is_fec(id))
         return NM_ETHTOOL_TYPE_FEC;
+    if (nm_ethtool_id_is_rss(id))
+        return NM_ETHTOOL_TYPE_RSS;
 
     return NM_ETHTOOL_TYPE_UNKNOWN;
 }
@@ -325,6 +331,7 @@ nm_ethtool_id_get_variant_type(NMEthtoolID ethtool_id)
     case NM_ETHTOOL_TYPE_COALESCE:
     case NM_ETHTOOL_TYPE_FEC:
     case NM_ETHTOOL_TYPE_RING:
+    case NM_ETHTOOL_TYPE_RSS:
         return G_VARIANT_TYPE_UINT32;
     case NM_ETHTOOL_TYPE_UNKNOWN:
         nm_assert(ethtool_id == NM_ETHTOOL_ID_UNKNOWN);
@@ -111,6 +111,9 @@ G_BEGIN_DECLS
 
 #define NM_ETHTOOL_OPTNAME_FEC_MODE "fec-mode"
 
+#define NM_ETHTOOL_OPTNAME_RSS_EQUAL "rss-equal"
+#define NM_ETHTOOL_OPTNAME_RSS_HFUNC "rss-hfunc"
+
 #define NM_ETHTOOL_OPTNAME_EEE_ENABLED "eee-enabled"
 
 /*****************************************************************************/
@@ -67,7 +67,7 @@ typedef struct _NMActiveConnectionPrivate {
     NMRefString      *specific_object_path;
     char             *id;
     char             *uuid;
-    char             *type;
+    NMRefString      *type;
 
     guint32 state;
     guint32 state_flags;
@@ -153,7 +153,8 @@ nm_active_connection_get_connection_type(NMActiveConnection *connection)
 {
     g_return_val_if_fail(NM_IS_ACTIVE_CONNECTION(connection), NULL);
 
-    return _nml_coerce_property_str_not_empty(NM_ACTIVE_CONNECTION_GET_PRIVATE(connection)->type);
+    return _nml_coerce_property_str_not_empty(
+        nm_ref_string_get_str(NM_ACTIVE_CONNECTION_GET_PRIVATE(connection)->type));
 }
 
 /**
@@ -542,7 +543,7 @@ finalize(GObject *object)
 
     g_free(priv->id);
     g_free(priv->uuid);
-    g_free(priv->type);
+    nm_ref_string_unref(priv->type);
     nm_ref_string_unref(priv->specific_object_path);
 
     G_OBJECT_CLASS(nm_active_connection_parent_class)->finalize(object);
@@ -675,7 +676,7 @@ const NMLDBusMetaIface _nml_dbus_meta_iface_nm_connection_active = NML_DBUS_META
                                       PROP_STATE_FLAGS,
                                       NMActiveConnectionPrivate,
                                       state_flags),
-        NML_DBUS_META_PROPERTY_INIT_S("Type", PROP_TYPE, NMActiveConnectionPrivate, type),
+        NML_DBUS_META_PROPERTY_INIT_S_REF("Type", PROP_TYPE, NMActiveConnectionPrivate, type),
         NML_DBUS_META_PROPERTY_INIT_S("Uuid", PROP_UUID, NMActiveConnectionPrivate, uuid),
         NML_DBUS_META_PROPERTY_INIT_B("Vpn", PROP_VPN, NMActiveConnectionPrivate, is_vpn), ),
     .base_struct_offset = G_STRUCT_OFFSET(NMActiveConnection, _priv), );
@@ -9,6 +9,9 @@
 #include "nm-client.h"
 
 #include <libudev.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <gio/gunixfdlist.h>
 
 #include "libnm-std-aux/c-list-util.h"
 #include "libnm-glib-aux/nm-c-list.h"
@@ -265,6 +268,7 @@ typedef struct {
     CList            obj_changed_lst_head;
     GCancellable    *name_owner_get_cancellable;
     GCancellable    *get_managed_objects_cancellable;
+    GSource         *dbus_changes_idle_source;
 
     CList queue_notify_lst_head;
     CList notify_event_lst_head;
@@ -1792,6 +1796,30 @@ nml_dbus_property_o_notify_watch_cb(NMClient *self, gpointer obj_watcher)
     }
 }
 
+static gboolean
+_dbus_iface_is_ignored(NMClient *self, const char *interface_name)
+{
+    NMClientPrivate *priv = NM_CLIENT_GET_PRIVATE(self);
+
+    return NM_FLAGS_HAS((NMClientInstanceFlags) priv->instance_flags,
+                        NM_CLIENT_INSTANCE_FLAGS_NO_IP_CONFIGS)
+           && NM_IN_STRSET(interface_name,
+                           NM_DBUS_INTERFACE_IP4_CONFIG,
+                           NM_DBUS_INTERFACE_IP6_CONFIG,
+                           NM_DBUS_INTERFACE_DHCP4_CONFIG,
+                           NM_DBUS_INTERFACE_DHCP6_CONFIG);
+}
+
+static gboolean
+_dbus_type_is_ignored(NMClient *self, GType gtype)
+{
+    NMClientPrivate *priv = NM_CLIENT_GET_PRIVATE(self);
+
+    return NM_FLAGS_HAS((NMClientInstanceFlags) priv->instance_flags,
+                        NM_CLIENT_INSTANCE_FLAGS_NO_IP_CONFIGS)
+           && (g_type_is_a(gtype, NM_TYPE_IP_CONFIG) || g_type_is_a(gtype, NM_TYPE_DHCP_CONFIG));
+}
+
 NMLDBusNotifyUpdatePropFlags
 nml_dbus_property_o_notify(NMClient               *self,
                            NMLDBusPropertyO       *pr_o,
@@ -1819,6 +1847,16 @@ nml_dbus_property_o_notify(NMClient               *self,
     if (value)
         dbus_path = nm_dbus_path_not_empty(g_variant_get_string(value, NULL));
 
+    if (dbus_path) {
+        const NMLDBusPropertVTableO *vtable;
+
+        vtable = meta_iface->dbus_properties[dbus_property_idx].extra.property_vtable_o;
+        if (_dbus_type_is_ignored(self, vtable->get_o_type_fcn())) {
+            /* we don't track objects of this type. Treat the reference as unset. */
+            dbus_path = NULL;
+        }
+    }
+
     if (pr_o->obj_watcher
         && (!dbus_path || !nm_streq(dbus_path, pr_o->obj_watcher->dbobj->dbus_path->str))) {
         _dbobjs_obj_watcher_unregister(self, g_steal_pointer(&pr_o->obj_watcher));
@@ -2401,6 +2439,32 @@ _nml_dbus_notify_update_prop_o(NMClient               *self,
     return NML_DBUS_NOTIFY_UPDATE_PROP_FLAGS_NOTIFY;
 }
 
+NMLDBusNotifyUpdatePropFlags
+_nml_dbus_notify_update_prop_s_ref(NMClient               *self,
+                                   NMLDBusObject          *dbobj,
+                                   const NMLDBusMetaIface *meta_iface,
+                                   guint                   dbus_property_idx,
+                                   GVariant               *value)
+{
+    const char   *str = NULL;
+    gsize         len = 0;
+    NMRefString **p_property;
+
+    if (value)
+        str = g_variant_get_string(value, &len);
+
+    p_property =
+        nml_dbus_object_get_property_location(dbobj,
+                                              meta_iface,
+                                              &meta_iface->dbus_properties[dbus_property_idx]);
+
+    if (!nm_ref_string_equal_str(*p_property, str)) {
+        nm_ref_string_unref(*p_property);
+        *p_property = str ? nm_ref_string_new_len(str, len) : NULL;
+    }
+    return NML_DBUS_NOTIFY_UPDATE_PROP_FLAGS_NOTIFY;
+}
+
 /*****************************************************************************/
 
 static void
@@ -2935,6 +2999,11 @@ _dbus_handle_changes_commit(NMClient *self, gboolean allow_init_start_check_comp
     NMClientPrivate                       *priv         = NM_CLIENT_GET_PRIVATE(self);
     nm_auto_pop_gmaincontext GMainContext *dbus_context = NULL;
 
+    /* With NM_CLIENT_INSTANCE_FLAGS_COALESCE_CHANGES, there may be D-Bus changes
+     * pending. Process them first, we must not commit them halfway. */
+    if (nm_clear_g_source_inst(&priv->dbus_changes_idle_source))
+        _dbus_handle_obj_changed_dbus(self, "coalesced");
+
     _dbus_handle_obj_changed_nmobj(self);
 
     dbus_context = nm_g_main_context_push_thread_default_if_necessary(priv->main_context);
@@ -2952,10 +3021,56 @@ _dbus_handle_changes(NMClient   *self,
                      const char *log_context,
                      gboolean    allow_init_start_check_complete)
 {
+    nm_clear_g_source_inst(&NM_CLIENT_GET_PRIVATE(self)->dbus_changes_idle_source);
+
     _dbus_handle_obj_changed_dbus(self, log_context);
     _dbus_handle_changes_commit(self, allow_init_start_check_complete);
 }
 
+static gboolean
+_dbus_handle_changes_idle_cb(gpointer user_data)
+{
+    NMClient *self = user_data;
+
+    _dbus_handle_changes(self, "coalesced", TRUE);
+    return G_SOURCE_CONTINUE;
+}
+
+/* Like _dbus_handle_changes(), for changes from D-Bus signals. With
+ * NM_CLIENT_INSTANCE_FLAGS_COALESCE_CHANGES, the changes are only processed
+ * once all D-Bus messages that are already queued got parsed. The properties
+ * of an object that changed several times are then notified once. */
+static void
+_dbus_handle_changes_queue(NMClient *self, const char *log_context)
+{
+    NMClientPrivate *priv = NM_CLIENT_GET_PRIVATE(self);
+
+    if (!NM_FLAGS_HAS((NMClientInstanceFlags) priv->instance_flags,
+                      NM_CLIENT_INSTANCE_FLAGS_COALESCE_CHANGES)) {
+        _dbus_handle_changes(self, log_context, TRUE);
+        return;
+    }
+
+    if (priv->dbus_changes_idle_source)
+        return;
+
+    NML_NMCLIENT_LOG_T(self, "%s: queue processing of changes", log_context);
+    priv->dbus_changes_idle_source = nm_g_source_attach(
+        nm_g_idle_source_new(G_PRIORITY_DEFAULT_IDLE, _dbus_handle_changes_idle_cb, self, NULL),
+        priv->dbus_context);
+}
+
+/* Process pending changes right away, for example before handling a signal
+ * that refers to an object that might have just been added. */
+static void
+_dbus_handle_changes_flush(NMClient *self, gboolean allow_init_start_check_complete)
+{
+    NMClientPrivate *priv = NM_CLIENT_GET_PRIVATE(self);
+
+    if (priv->dbus_changes_idle_source)
+        _dbus_handle_changes(self, "coalesced", allow_init_start_check_complete);
+}
+
 static gboolean
 _dbus_handle_properties_changed(NMClient       *self,
                                 const char     *log_context,
@@ -2972,6 +3087,9 @@ _dbus_handle_properties_changed(NMClient       *self,
     nm_assert(!changed_properties
               || g_variant_is_of_type(changed_properties, G_VARIANT_TYPE("a{sv}")));
 
+    if (_dbus_iface_is_ignored(self, interface_name))
+        return FALSE;
+
     {
         gs_free char *ss = NULL;
 
@@ -3125,6 +3243,8 @@ _dbus_handle_interface_removed(NMClient          *self,
     } else {
         dbobj = _dbobjs_dbobj_get_s(self, object_path);
         if (!dbobj) {
+            if (removed_interfaces[0] && _dbus_iface_is_ignored(self, removed_interfaces[0]))
+                return FALSE;
             NML_NMCLIENT_LOG_E(self,
                                "%s: [%s]: receive interface removed event for non existing object",
                                log_context,
@@ -3138,6 +3258,9 @@ _dbus_handle_interface_removed(NMClient          *self,
         NMLDBusObjIfaceData *db_iface_data;
         const char          *interface_name = removed_interfaces[i];
 
+        if (_dbus_iface_is_ignored(self, interface_name))
+            continue;
+
         db_iface_data = nml_dbus_object_iface_data_get(dbobj, interface_name, FALSE);
         if (!db_iface_data) {
             NML_NMCLIENT_LOG_E(
@@ -3218,7 +3341,7 @@ _dbus_managed_objects_changed_cb(GDBusConnection *connection,
 
 out:
     if (changed)
-        _dbus_handle_changes(self, log_context, TRUE);
+        _dbus_handle_changes_queue(self, log_context);
 }
 
 static void
@@ -3266,7 +3389,28 @@ _dbus_properties_changed_cb(GDBusConnection *connection,
                                         FALSE,
                                         changed_properties,
                                         NULL))
-        _dbus_handle_changes(self, log_context, TRUE);
+        _dbus_handle_changes_queue(self, log_context);
+}
+
+static void
+_dbus_get_managed_objects_done(NMClient *self, GVariant *managed_objects)
+{
+    if (managed_objects) {
+        GVariantIter iter;
+        const char  *object_path;
+        GVariant    *ifaces_tmp;
+
+        g_variant_iter_init(&iter, managed_objects);
+        while (g_variant_iter_next(&iter, "{&o@a{sa{sv}}}", &object_path, &ifaces_tmp)) {
+            gs_unref_variant GVariant *ifaces = ifaces_tmp;
+
+            _dbus_handle_interface_added(self, "get-managed-objects", object_path, ifaces);
+        }
+    }
+
+    /* always call _dbus_handle_changes(), even if nothing changed. We need this to complete
+     * initialization. */
+    _dbus_handle_changes(self, "get-managed-objects", TRUE);
 }
 
 static void
@@ -3304,22 +3448,156 @@ _dbus_get_managed_objects_cb(GObject *source, GAsyncResult *result, gpointer use
     } else
         NML_NMCLIENT_LOG_D(self, "GetManagedObjects() completed");
 
-    if (managed_objects) {
-        GVariantIter iter;
-        const char  *object_path;
-        GVariant    *ifaces_tmp;
+    _dbus_get_managed_objects_done(self, managed_objects);
+}
 
-        g_variant_iter_init(&iter, managed_objects);
-        while (g_variant_iter_next(&iter, "{&o@a{sa{sv}}}", &object_path, &ifaces_tmp)) {
-            gs_unref_variant GVariant *ifaces = ifaces_tmp;
+static void
+_dbus_get_managed_objects_start(NMClient *self)
+{
+    NMClientPrivate *priv = NM_CLIENT_GET_PRIVATE(self);
 
-            _dbus_handle_interface_added(self, "get-managed-objects", object_path, ifaces);
+    g_dbus_connection_call(priv->dbus_connection,
+                           priv->name_owner,
+                           "/org/freedesktop",
+                           DBUS_INTERFACE_OBJECT_MANAGER,
+                           "GetManagedObjects",
+                           NULL,
+                           G_VARIANT_TYPE("(a{oa{sa{sv}}})"),
+                           G_DBUS_CALL_FLAGS_NO_AUTO_START,
+                           NM_DBUS_DEFAULT_TIMEOUT_MSEC,
+                           priv->get_managed_objects_cancellable,
+                           _dbus_get_managed_objects_cb,
+                           nm_utils_user_data_pack(self, g_object_ref(priv->context_busy_watcher)));
+}
+
+typedef struct {
+    void *data;
+    gsize size;
+} SnapshotMapping;
+
+static void
+_dbus_unmap_snapshot(gpointer user_data)
+{
+    SnapshotMapping *mapping = user_data;
+
+    munmap(mapping->data, mapping->size);
+    nm_g_slice_free(mapping);
+}
+
+static GVariant *
+_dbus_map_snapshot(int fd, guint64 size, GError **error)
+{
+    gs_unref_bytes GBytes *bytes = NULL;
+    struct stat            st;
+    void                  *data;
+
+    if (fstat(fd, &st) != 0) {
+        int errsv = errno;
+
+        g_set_error(error,
+                    NM_CLIENT_ERROR,
+                    NM_CLIENT_ERROR_FAILED,
+                    "cannot stat snapshot: %s",
+                    nm_strerror_native(errsv));
+        return NULL;
+    }
+
+    if (!S_ISREG(st.st_mode) || st.st_size < 0 || (guint64) st.st_size != size
+        || size > G_MAXSIZE) {
+        g_set_error_literal(error,
+                            NM_CLIENT_ERROR,
+                            NM_CLIENT_ERROR_FAILED,
+                            "snapshot has unexpected size");
+        return NULL;
+    }
+
+    if (size == 0)
+        bytes = g_bytes_new_static("", 0);
+    else {
+        SnapshotMapping *mapping;
+
+        data = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (data == MAP_FAILED) {
+            int errsv = errno;
+
+            g_set_error(error,
+                        NM_CLIENT_ERROR,
+                        NM_CLIENT_ERROR_FAILED,
+                        "cannot map snapshot: %s",
+                        nm_strerror_native(errsv));
+            return NULL;
         }
+        mapping  = g_slice_new(SnapshotMapping);
+        *mapping = (SnapshotMapping) {
+            .data = data,
+            .size = size,
+        };
+        bytes = g_bytes_new_with_free_func(data, size, _dbus_unmap_snapshot, mapping);
     }
 
-    /* always call _dbus_handle_changes(), even if nothing changed. We need this to complete
-     * initialization. */
-    _dbus_handle_changes(self, "get-managed-objects", TRUE);
+    /* The data comes from the daemon and is not trusted. GVariant validates
+     * it as we access it. */
+    return g_variant_ref_sink(
+        g_variant_new_from_bytes(G_VARIANT_TYPE("a{oa{sa{sv}}}"), bytes, FALSE));
+}
+
+static void
+_dbus_get_managed_objects_snapshot_cb(GObject *source, GAsyncResult *result, gpointer user_data)
+{
+    NMClient                    *self;
+    NMClientPrivate             *priv;
+    gs_unref_variant GVariant   *ret                  = NULL;
+    gs_unref_variant GVariant   *managed_objects      = NULL;
+    gs_unref_object GUnixFDList *fd_list              = NULL;
+    gs_free_error GError        *error                = NULL;
+    gs_unref_object GObject     *context_busy_watcher = NULL;
+    nm_auto_close int            fd                   = -1;
+    gint32                       fd_idx;
+    guint64                      size;
+
+    nm_utils_user_data_unpack(user_data, &self, &context_busy_watcher);
+
+    ret = g_dbus_connection_call_with_unix_fd_list_finish(G_DBUS_CONNECTION(source),
+                                                          &fd_list,
+                                                          result,
+                                                          &error);
+    if (!ret && nm_utils_error_is_cancelled(error))
+        return;
+
+    priv = NM_CLIENT_GET_PRIVATE(self);
+
+    if (ret) {
+        g_variant_get(ret, "(ht)", &fd_idx, &size);
+        fd = fd_list ? g_unix_fd_list_get(fd_list, fd_idx, &error) : -1;
+        if (fd < 0 && !error) {
+            g_set_error_literal(&error,
+                                NM_CLIENT_ERROR,
+                                NM_CLIENT_ERROR_FAILED,
+                                "missing file descriptor");
+        }
+        if (fd >= 0)
+            managed_objects = _dbus_map_snapshot(fd, size, &error);
+    }
+
+    if (!managed_objects) {
+        /* Possibly the daemon is too old to support the method. Fall back to
+         * the ObjectManager. Signals received in the meantime are ignored, and
+         * GetManagedObjects() returns the complete state. */
+        NML_NMCLIENT_LOG_D(self,
+                           "GetManagedObjectsSnapshot() call failed: %s. Fall back to "
+                           "GetManagedObjects()",
+                           error->message);
+        _dbus_get_managed_objects_start(self);
+        return;
+    }
+
+    g_clear_object(&priv->get_managed_objects_cancellable);
+
+    NML_NMCLIENT_LOG_D(self,
+                       "GetManagedObjectsSnapshot() completed (%" G_GUINT64_FORMAT " bytes)",
+                       size);
+
+    _dbus_get_managed_objects_done(self, managed_objects);
 }
 
 /*****************************************************************************/
@@ -3405,6 +3683,8 @@ _dbus_settings_updated_cb(GDBusConnection *connection,
     if (!g_variant_is_of_type(parameters, G_VARIANT_TYPE("()")))
         return;
 
+    _dbus_handle_changes_flush(self, TRUE);
+
     dbobj = _dbobjs_dbobj_get_s(self, object_path);
 
     if (!dbobj || !NM_IS_REMOTE_CONNECTION(dbobj->nmobj)) {
@@ -3451,6 +3731,8 @@ _dbus_nm_connection_active_state_changed_cb(GDBusConnection *connection,
         return;
     }
 
+    _dbus_handle_changes_flush(self, TRUE);
+
     dbobj = _dbobjs_dbobj_get_s(self, object_path);
 
     if (!dbobj || !NM_IS_ACTIVE_CONNECTION(dbobj->nmobj)) {
@@ -3501,6 +3783,8 @@ _dbus_nm_vpn_connection_state_changed_cb(GDBusConnection *connection,
         return;
     }
 
+    _dbus_handle_changes_flush(self, TRUE);
+
     dbobj = _dbobjs_dbobj_get_s(self, object_path);
 
     if (!dbobj || !NM_IS_VPN_CONNECTION(dbobj->nmobj)) {
@@ -5129,6 +5413,137 @@ nm_client_activate_connection_finish(NMClient *client, GAsyncResult *result, GEr
 
 /*****************************************************************************/
 
+/**
+ * nm_client_activate_connections_async:
+ * @client: a #NMClient
+ * @connections: (element-type NMConnection): the #NMRemoteConnection
+ *   objects to activate. An entry may be %NULL for a device-based
+ *   activation, in which case NetworkManager picks the best available
+ *   connection for the device.
+ * @devices: (element-type NMDevice) (nullable): the devices to activate
+ *   the connections on. If given, it must have one (possibly %NULL)
+ *   entry per connection.
+ * @specific_objects: (element-type utf8) (nullable): the object paths of
+ *   the connection-type-specific objects, like for
+ *   nm_client_activate_connection_async(). If given, it must have one
+ *   (possibly %NULL) entry per connection.
+ * @cancellable: a #GCancellable, or %NULL
+ * @callback: callback to be called when the activations have started
+ * @user_data: caller-specific data passed to @callback
+ *
+ * Call the ActivateConnections() D-Bus API asynchronously, to start
+ * activating several connections with a single request. Each entry is
+ * handled like nm_client_activate_connection_async(), but the caller is
+ * only authorized once.
+ *
+ * Unlike with nm_client_activate_connection_async(), the operation does
+ * not wait for the #NMActiveConnection objects to show up in the
+ * @client's cache.
+ *
+ * Since: 1.58
+ **/
+void
+nm_client_activate_connections_async(NMClient           *client,
+                                     const GPtrArray    *connections,
+                                     const GPtrArray    *devices,
+                                     const GPtrArray    *specific_objects,
+                                     GCancellable       *cancellable,
+                                     GAsyncReadyCallback callback,
+                                     gpointer            user_data)
+{
+    GVariantBuilder builder;
+    guint           i;
+
+    g_return_if_fail(NM_IS_CLIENT(client));
+    g_return_if_fail(connections);
+    g_return_if_fail(!devices || devices->len == connections->len);
+    g_return_if_fail(!specific_objects || specific_objects->len == connections->len);
+    g_return_if_fail(!cancellable || G_IS_CANCELLABLE(cancellable));
+
+    g_variant_builder_init(&builder, G_VARIANT_TYPE("a(ooo)"));
+    for (i = 0; i < connections->len; i++) {
+        NMConnection *connection      = connections->pdata[i];
+        NMDevice     *device          = devices ? devices->pdata[i] : NULL;
+        const char   *specific_object = specific_objects ? specific_objects->pdata[i] : NULL;
+        const char   *arg_connection  = NULL;
+        const char   *arg_device      = NULL;
+
+        if (connection) {
+            g_return_if_fail(NM_IS_CONNECTION(connection));
+            arg_connection = nm_connection_get_path(connection);
+            g_return_if_fail(arg_connection);
+        }
+
+        if (device) {
+            g_return_if_fail(NM_IS_DEVICE(device));
+            arg_device = nm_object_get_path(NM_OBJECT(device));
+            g_return_if_fail(arg_device);
+        }
+
+        g_variant_builder_add(&builder,
+                              "(ooo)",
+                              arg_connection ?: "/",
+                              arg_device ?: "/",
+                              specific_object ?: "/");
+    }
+
+    NML_NMCLIENT_LOG_D(client,
+                       "ActivateConnections() started for %u connections...",
+                       connections->len);
+
+    _nm_client_dbus_call(client,
+                         client,
+                         nm_client_activate_connections_async,
+                         cancellable,
+                         callback,
+                         user_data,
+                         NM_DBUS_PATH,
+                         NM_DBUS_INTERFACE,
+                         "ActivateConnections",
+                         g_variant_new("(a(ooo)@a{sv})", &builder, nm_g_variant_singleton_aLsvI()),
+                         G_VARIANT_TYPE("(aa{sv})"),
+                         G_DBUS_CALL_FLAGS_NONE,
+                         NM_DBUS_DEFAULT_TIMEOUT_MSEC,
+                         nm_dbus_connection_call_finish_variant_strip_dbus_error_cb);
+}
+
+/**
+ * nm_client_activate_connections_finish:
+ * @client: an #NMClient
+ * @result: the result passed to the #GAsyncReadyCallback
+ * @error: location for a #GError, or %NULL
+ *
+ * Gets the result of an nm_client_activate_connections_async() call.
+ *
+ * Returns: (transfer full): on success, the "aa{sv}" #GVariant with
+ *   one result per requested activation, in the same order. A result
+ *   contains either the key "active-connection" with the D-Bus path of
+ *   the new active connection, or the key "error" with an error message.
+ *   On failure, %NULL and @error is set. In that case, no connection
+ *   was activated.
+ *
+ * Since: 1.58
+ **/
+GVariant *
+nm_client_activate_connections_finish(NMClient *client, GAsyncResult *result, GError **error)
+{
+    gs_unref_variant GVariant *ret = NULL;
+    GVariant                  *results;
+
+    g_return_val_if_fail(NM_IS_CLIENT(client), NULL);
+    g_return_val_if_fail(nm_g_task_is_valid(result, client, nm_client_activate_connections_async),
+                         NULL);
+
+    ret = g_task_propagate_pointer(G_TASK(result), error);
+    if (!ret)
+        return NULL;
+
+    g_variant_get(ret, "(@aa{sv})", &results);
+    return results;
+}
+
+/*****************************************************************************/
+
 static void
 _add_and_activate_connection_done(GObject      *object,
                                   GAsyncResult *result,
@@ -5899,6 +6314,184 @@ nm_client_add_connection2_finish(NMClient     *client,
         _request_wait_finish(client, result, nm_client_add_connection2, out_result, error));
 }
 
+/**
+ * nm_client_add_connections_async:
+ * @client: the %NMClient
+ * @connections: (element-type NMConnection): the connections to add. Note
+ *   that the objects' settings will be added, not the objects themselves.
+ * @flags: the %NMSettingsAddConnection2Flags argument, applied to
+ *   all connections.
+ * @cancellable: a #GCancellable, or %NULL
+ * @callback: (scope async) (closure user_data): callback to be called when the add operation completes
+ * @user_data: caller-specific data passed to @callback
+ *
+ * Call AddConnections() D-Bus API asynchronously, to add several new
+ * connection profiles with a single request.
+ *
+ * Unlike with nm_client_add_connection2(), the operation does not wait
+ * for the new #NMRemoteConnection objects to show up in the @client's
+ * cache.
+ *
+ * Since: 1.58
+ **/
+void
+nm_client_add_connections_async(NMClient                     *client,
+                                const GPtrArray              *connections,
+                                NMSettingsAddConnection2Flags flags,
+                                GCancellable                 *cancellable,
+                                GAsyncReadyCallback           callback,
+                                gpointer                      user_data)
+{
+    GVariantBuilder builder;
+    guint           i;
+
+    g_return_if_fail(NM_IS_CLIENT(client));
+    g_return_if_fail(connections);
+    g_return_if_fail(!cancellable || G_IS_CANCELLABLE(cancellable));
+
+    for (i = 0; i < connections->len; i++)
+        g_return_if_fail(NM_IS_CONNECTION(connections->pdata[i]));
+
+    g_variant_builder_init(&builder, G_VARIANT_TYPE("aa{sa{sv}}"));
+    for (i = 0; i < connections->len; i++) {
+        g_variant_builder_add_value(
+            &builder,
+            nm_connection_to_dbus(connections->pdata[i], NM_CONNECTION_SERIALIZE_ALL)
+                ?: nm_g_variant_singleton_aLsaLsvII());
+    }
+
+    NML_NMCLIENT_LOG_D(client, "AddConnections() started for %u profiles...", connections->len);
+
+    _nm_client_dbus_call(client,
+                         client,
+                         nm_client_add_connections_async,
+                         cancellable,
+                         callback,
+                         user_data,
+                         NM_DBUS_PATH_SETTINGS,
+                         NM_DBUS_INTERFACE_SETTINGS,
+                         "AddConnections",
+                         g_variant_new("(aa{sa{sv}}u@a{sv})",
+                                       &builder,
+                                       (guint32) flags,
+                                       nm_g_variant_singleton_aLsvI()),
+                         G_VARIANT_TYPE("(aa{sv})"),
+                         G_DBUS_CALL_FLAGS_NONE,
+                         NM_DBUS_DEFAULT_TIMEOUT_MSEC,
+                         nm_dbus_connection_call_finish_variant_strip_dbus_error_cb);
+}
+
+/**
+ * nm_client_add_connections_finish:
+ * @client: the %NMClient
+ * @result: the result passed to the #GAsyncReadyCallback
+ * @error: location for a #GError, or %NULL
+ *
+ * Gets the result of an nm_client_add_connections_async() call.
+ *
+ * Returns: (transfer full): on success, the "aa{sv}" #GVariant with
+ *   one result per requested connection, in the same order. A result
+ *   contains either the key "path" with the D-Bus path of the added
+ *   connection, or the key "error" with an error message.
+ *   On failure, %NULL and @error is set. In that case, no connection
+ *   was added.
+ *
+ * Since: 1.58
+ **/
+GVariant *
+nm_client_add_connections_finish(NMClient *client, GAsyncResult *result, GError **error)
+{
+    gs_unref_variant GVariant *ret = NULL;
+    GVariant                  *results;
+
+    g_return_val_if_fail(NM_IS_CLIENT(client), NULL);
+    g_return_val_if_fail(nm_g_task_is_valid(result, client, nm_client_add_connections_async),
+                         NULL);
+
+    ret = g_task_propagate_pointer(G_TASK(result), error);
+    if (!ret)
+        return NULL;
+
+    g_variant_get(ret, "(@aa{sv})", &results);
+    return results;
+}
+
+/**
+ * nm_client_get_connections_settings_async:
+ * @client: the %NMClient
+ * @paths: (array zero-terminated=1) (nullable): the D-Bus paths of the
+ *   connection profiles. %NULL or an empty list requests all profiles
+ *   that are visible to the caller.
+ * @cancellable: a #GCancellable, or %NULL
+ * @callback: (scope async) (closure user_data): callback to be called when the operation completes
+ * @user_data: caller-specific data passed to @callback
+ *
+ * Call GetConnectionsSettings() D-Bus API asynchronously, to get the
+ * settings of many connection profiles with a single request. Secrets
+ * are not included.
+ *
+ * Since: 1.58
+ **/
+void
+nm_client_get_connections_settings_async(NMClient           *client,
+                                         const char *const  *paths,
+                                         GCancellable       *cancellable,
+                                         GAsyncReadyCallback callback,
+                                         gpointer            user_data)
+{
+    g_return_if_fail(NM_IS_CLIENT(client));
+    g_return_if_fail(!cancellable || G_IS_CANCELLABLE(cancellable));
+
+    _nm_client_dbus_call(client,
+                         client,
+                         nm_client_get_connections_settings_async,
+                         cancellable,
+                         callback,
+                         user_data,
+                         NM_DBUS_PATH_SETTINGS,
+                         NM_DBUS_INTERFACE_SETTINGS,
+                         "GetConnectionsSettings",
+                         g_variant_new("(^ao)", paths ?: NM_PTRARRAY_EMPTY(const char *)),
+                         G_VARIANT_TYPE("(a{oa{sa{sv}}})"),
+                         G_DBUS_CALL_FLAGS_NONE,
+                         NM_DBUS_DEFAULT_TIMEOUT_MSEC,
+                         nm_dbus_connection_call_finish_variant_strip_dbus_error_cb);
+}
+
+/**
+ * nm_client_get_connections_settings_finish:
+ * @client: the %NMClient
+ * @result: the result passed to the #GAsyncReadyCallback
+ * @error: location for a #GError, or %NULL
+ *
+ * Gets the result of an nm_client_get_connections_settings_async() call.
+ *
+ * Returns: (transfer full): on success, the "a{oa{sa{sv}}}" #GVariant
+ *   with the settings of each profile, indexed by D-Bus path. Use
+ *   nm_simple_connection_new_from_dbus() to create a connection from
+ *   the settings. On failure, %NULL and @error is set.
+ *
+ * Since: 1.58
+ **/
+GVariant *
+nm_client_get_connections_settings_finish(NMClient *client, GAsyncResult *result, GError **error)
+{
+    gs_unref_variant GVariant *ret = NULL;
+    GVariant                  *settings;
+
+    g_return_val_if_fail(NM_IS_CLIENT(client), NULL);
+    g_return_val_if_fail(
+        nm_g_task_is_valid(result, client, nm_client_get_connections_settings_async),
+        NULL);
+
+    ret = g_task_propagate_pointer(G_TASK(result), error);
+    if (!ret)
+        return NULL;
+
+    g_variant_get(ret, "(@a{oa{sa{sv}}})", &settings);
+    return settings;
+}
+
 /*****************************************************************************/
 
 /**
@@ -7021,18 +7614,20 @@ _init_fetch_all(NMClient *self)
                                            self,
                                            NULL);
 
-    g_dbus_connection_call(priv->dbus_connection,
-                           priv->name_owner,
-                           "/org/freedesktop",
-                           DBUS_INTERFACE_OBJECT_MANAGER,
-                           "GetManagedObjects",
-                           NULL,
-                           G_VARIANT_TYPE("(a{oa{sa{sv}}})"),
-                           G_DBUS_CALL_FLAGS_NO_AUTO_START,
-                           NM_DBUS_DEFAULT_TIMEOUT_MSEC,
-                           priv->get_managed_objects_cancellable,
-                           _dbus_get_managed_objects_cb,
-                           nm_utils_user_data_pack(self, g_object_ref(priv->context_busy_watcher)));
+    g_dbus_connection_call_with_unix_fd_list(
+        priv->dbus_connection,
+        priv->name_owner,
+        NM_DBUS_PATH,
+        NM_DBUS_INTERFACE,
+        "GetManagedObjectsSnapshot",
+        NULL,
+        G_VARIANT_TYPE("(ht)"),
+        G_DBUS_CALL_FLAGS_NO_AUTO_START,
+        NM_DBUS_DEFAULT_TIMEOUT_MSEC,
+        NULL,
+        priv->get_managed_objects_cancellable,
+        _dbus_get_managed_objects_snapshot_cb,
+        nm_utils_user_data_pack(self, g_object_ref(priv->context_busy_watcher)));
 
     _dbus_check_permissions_start(self);
 }
@@ -7062,6 +7657,8 @@ _init_release_all(NMClient *self)
                                       &priv->dbsid_nm_vpn_connection_state_changed);
     nm_clear_g_dbus_connection_signal(priv->dbus_connection, &priv->dbsid_nm_check_permissions);
 
+    _dbus_handle_changes_flush(self, FALSE);
+
     if (priv->permissions_state != NM_TERNARY_DEFAULT) {
         priv->permissions_state   = NM_TERNARY_DEFAULT;
         permissions_state_changed = TRUE;
@@ -91,12 +91,12 @@ typedef struct _NMDevicePrivate {
     NMLDBusPropertyO  property_o[_PROPERTY_O_IDX_NUM];
     NMLDBusPropertyAO property_ao[_PROPERTY_AO_IDX_NUM];
     GPtrArray        *lldp_neighbors;
-    char             *driver;
-    char             *driver_version;
+    NMRefString      *driver;
+    NMRefString      *driver_version;
     char             *hw_address;
     char             *interface;
     char             *ip_interface;
-    char             *firmware_version;
+    NMRefString      *firmware_version;
     char             *physical_port_id;
     char             *udi;
     char             *path;
@@ -347,9 +347,9 @@ finalize(GObject *object)
     g_free(priv->ip_interface);
     g_free(priv->udi);
     g_free(priv->path);
-    g_free(priv->driver);
-    g_free(priv->driver_version);
-    g_free(priv->firmware_version);
+    nm_ref_string_unref(priv->driver);
+    nm_ref_string_unref(priv->driver_version);
+    nm_ref_string_unref(priv->firmware_version);
     g_free(priv->product);
     g_free(priv->vendor);
     g_free(priv->short_vendor);
@@ -541,19 +541,19 @@ const NMLDBusMetaIface _nml_dbus_meta_iface_nm_device = NML_DBUS_META_IFACE_INIT
                                            NMDevicePrivate,
                                            property_o[PROPERTY_O_IDX_DHCP6_CONFIG],
                                            nm_dhcp6_config_get_type),
-        NML_DBUS_META_PROPERTY_INIT_S("Driver", PROP_DRIVER, NMDevicePrivate, driver),
-        NML_DBUS_META_PROPERTY_INIT_S("DriverVersion",
-                                      PROP_DRIVER_VERSION,
-                                      NMDevicePrivate,
-                                      driver_version),
+        NML_DBUS_META_PROPERTY_INIT_S_REF("Driver", PROP_DRIVER, NMDevicePrivate, driver),
+        NML_DBUS_META_PROPERTY_INIT_S_REF("DriverVersion",
+                                          PROP_DRIVER_VERSION,
+                                          NMDevicePrivate,
+                                          driver_version),
         NML_DBUS_META_PROPERTY_INIT_B("FirmwareMissing",
                                       PROP_FIRMWARE_MISSING,
                                       NMDevicePrivate,
                                       firmware_missing),
-        NML_DBUS_META_PROPERTY_INIT_S("FirmwareVersion",
-                                      PROP_FIRMWARE_VERSION,
-                                      NMDevicePrivate,
-                                      firmware_version),
+        NML_DBUS_META_PROPERTY_INIT_S_REF("FirmwareVersion",
+                                          PROP_FIRMWARE_VERSION,
+                                          NMDevicePrivate,
+                                          firmware_version),
         NML_DBUS_META_PROPERTY_INIT_FCN("HwAddress",
                                         0,
                                         "s",
@@ -1199,7 +1199,8 @@ nm_device_get_driver(NMDevice *device)
 {
     g_return_val_if_fail(NM_IS_DEVICE(device), NULL);
 
-    return _nml_coerce_property_str_not_empty(NM_DEVICE_GET_PRIVATE(device)->driver);
+    return _nml_coerce_property_str_not_empty(
+        nm_ref_string_get_str(NM_DEVICE_GET_PRIVATE(device)->driver));
 }
 
 /**
@@ -1216,7 +1217,8 @@ nm_device_get_driver_version(NMDevice *device)
 {
     g_return_val_if_fail(NM_IS_DEVICE(device), NULL);
 
-    return _nml_coerce_property_str_not_empty(NM_DEVICE_GET_PRIVATE(device)->driver_version);
+    return _nml_coerce_property_str_not_empty(
+        nm_ref_string_get_str(NM_DEVICE_GET_PRIVATE(device)->driver_version));
 }
 
 /**
@@ -1233,7 +1235,8 @@ nm_device_get_firmware_version(NMDevice *device)
 {
     g_return_val_if_fail(NM_IS_DEVICE(device), NULL);
 
-    return _nml_coerce_property_str_not_empty(NM_DEVICE_GET_PRIVATE(device)->firmware_version);
+    return _nml_coerce_property_str_not_empty(
+        nm_ref_string_get_str(NM_DEVICE_GET_PRIVATE(device)->firmware_version));
 }
 
 /**
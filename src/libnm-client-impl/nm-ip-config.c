@@ -31,6 +31,8 @@ NM_GOBJECT_PROPERTIES_DEFINE(NMIPConfig,
 typedef struct _NMIPConfigPrivate {
     GPtrArray *addresses;
     GPtrArray *routes;
+    GVariant  *addresses_variant;
+    GVariant  *routes_variant;
     char     **nameservers;
     char     **domains;
     char     **searches;
@@ -50,6 +52,27 @@ G_DEFINE_ABSTRACT_TYPE(NMIPConfig, nm_ip_config, NM_TYPE_OBJECT)
 
 /*****************************************************************************/
 
+/* The addresses and routes can be large and many clients never look at them.
+ * Only keep the variant and decode it on first access. The variant is copied,
+ * because @value is part of the D-Bus message and a reference would keep the
+ * entire message alive. It is kept after decoding, so that an update with
+ * the same value keeps the decoded array. */
+static GVariant *
+_variant_copy_compact(GVariant *value)
+{
+    gsize    size = g_variant_get_size(value);
+    gpointer data = nm_memdup(g_variant_get_data(value), size);
+
+    return g_variant_ref_sink(
+        g_variant_new_from_data(g_variant_get_type(value), data, size, FALSE, g_free, data));
+}
+
+static gboolean
+_variant_is_new_style(GVariant *value)
+{
+    return g_variant_is_of_type(value, G_VARIANT_TYPE("aa{sv}"));
+}
+
 static NMLDBusNotifyUpdatePropFlags
 _notify_update_prop_addresses(NMClient               *client,
                               NMLDBusObject          *dbobj,
@@ -57,12 +80,9 @@ _notify_update_prop_addresses(NMClient               *client,
                               guint                   dbus_property_idx,
                               GVariant               *value)
 {
-    NMIPConfig                  *self          = NM_IP_CONFIG(dbobj->nmobj);
-    NMIPConfigPrivate           *priv          = NM_IP_CONFIG_GET_PRIVATE(self);
-    gs_unref_ptrarray GPtrArray *addresses_old = NULL;
-    gs_unref_ptrarray GPtrArray *addresses_new = NULL;
-    int      addr_family = meta_iface == &_nml_dbus_meta_iface_nm_ip4config ? AF_INET : AF_INET6;
-    gboolean new_style;
+    NMIPConfig        *self = NM_IP_CONFIG(dbobj->nmobj);
+    NMIPConfigPrivate *priv = NM_IP_CONFIG_GET_PRIVATE(self);
+    gboolean           new_style;
 
     new_style =
         (((const char *) meta_iface->dbus_properties[dbus_property_idx].dbus_type)[2] == '{');
@@ -73,20 +93,14 @@ _notify_update_prop_addresses(NMClient               *client,
     } else
         priv->addresses_new_style = new_style;
 
-    if (value) {
-        if (new_style)
-            addresses_new = nm_utils_ip_addresses_from_variant(value, addr_family);
-        else if (addr_family == AF_INET)
-            addresses_new = nm_utils_ip4_addresses_from_variant(value, NULL);
-        else
-            addresses_new = nm_utils_ip6_addresses_from_variant(value, NULL);
-        nm_assert(addresses_new);
-    }
-    if (!addresses_new)
-        addresses_new = g_ptr_array_new_with_free_func((GDestroyNotify) nm_ip_address_unref);
+    if (value && priv->addresses_variant && g_variant_equal(value, priv->addresses_variant))
+        return NML_DBUS_NOTIFY_UPDATE_PROP_FLAGS_NONE;
 
-    addresses_old   = priv->addresses;
-    priv->addresses = g_steal_pointer(&addresses_new);
+    /* Callers may keep a reference to the old array, it is never modified. */
+    nm_clear_pointer(&priv->addresses, g_ptr_array_unref);
+    nm_clear_pointer(&priv->addresses_variant, g_variant_unref);
+    if (value)
+        priv->addresses_variant = _variant_copy_compact(value);
     return NML_DBUS_NOTIFY_UPDATE_PROP_FLAGS_NOTIFY;
 }
 
@@ -97,12 +111,9 @@ _notify_update_prop_routes(NMClient               *client,
                            guint                   dbus_property_idx,
                            GVariant               *value)
 {
-    NMIPConfig                  *self       = NM_IP_CONFIG(dbobj->nmobj);
-    NMIPConfigPrivate           *priv       = NM_IP_CONFIG_GET_PRIVATE(self);
-    gs_unref_ptrarray GPtrArray *routes_old = NULL;
-    gs_unref_ptrarray GPtrArray *routes_new = NULL;
-    int      addr_family = meta_iface == &_nml_dbus_meta_iface_nm_ip4config ? AF_INET : AF_INET6;
-    gboolean new_style;
+    NMIPConfig        *self = NM_IP_CONFIG(dbobj->nmobj);
+    NMIPConfigPrivate *priv = NM_IP_CONFIG_GET_PRIVATE(self);
+    gboolean           new_style;
 
     new_style =
         (((const char *) meta_iface->dbus_properties[dbus_property_idx].dbus_type)[2] == '{');
@@ -113,21 +124,70 @@ _notify_update_prop_routes(NMClient               *client,
     } else
         priv->routes_new_style = new_style;
 
-    if (value) {
-        if (new_style)
-            routes_new = nm_utils_ip_routes_from_variant(value, addr_family);
+    if (value && priv->routes_variant && g_variant_equal(value, priv->routes_variant))
+        return NML_DBUS_NOTIFY_UPDATE_PROP_FLAGS_NONE;
+
+    nm_clear_pointer(&priv->routes, g_ptr_array_unref);
+    nm_clear_pointer(&priv->routes_variant, g_variant_unref);
+    if (value)
+        priv->routes_variant = _variant_copy_compact(value);
+    return NML_DBUS_NOTIFY_UPDATE_PROP_FLAGS_NOTIFY;
+}
+
+static GPtrArray *
+_get_addresses(NMIPConfig *self)
+{
+    NMIPConfigPrivate *priv = NM_IP_CONFIG_GET_PRIVATE(self);
+    GPtrArray         *addresses;
+    int                addr_family;
+
+    if (priv->addresses)
+        return priv->addresses;
+
+    addr_family = NM_IS_IP4_CONFIG(self) ? AF_INET : AF_INET6;
+    addresses   = NULL;
+    if (priv->addresses_variant) {
+        if (_variant_is_new_style(priv->addresses_variant))
+            addresses = nm_utils_ip_addresses_from_variant(priv->addresses_variant, addr_family);
         else if (addr_family == AF_INET)
-            routes_new = nm_utils_ip4_routes_from_variant(value);
+            addresses = nm_utils_ip4_addresses_from_variant(priv->addresses_variant, NULL);
         else
-            routes_new = nm_utils_ip6_routes_from_variant(value);
-        nm_assert(routes_new);
+            addresses = nm_utils_ip6_addresses_from_variant(priv->addresses_variant, NULL);
+        nm_assert(addresses);
     }
-    if (!routes_new)
-        routes_new = g_ptr_array_new_with_free_func((GDestroyNotify) nm_ip_route_unref);
+    if (!addresses)
+        addresses = g_ptr_array_new_with_free_func((GDestroyNotify) nm_ip_address_unref);
 
-    routes_old   = priv->routes;
-    priv->routes = g_steal_pointer(&routes_new);
-    return NML_DBUS_NOTIFY_UPDATE_PROP_FLAGS_NOTIFY;
+    priv->addresses = addresses;
+    return addresses;
+}
+
+static GPtrArray *
+_get_routes(NMIPConfig *self)
+{
+    NMIPConfigPrivate *priv = NM_IP_CONFIG_GET_PRIVATE(self);
+    GPtrArray         *routes;
+    int                addr_family;
+
+    if (priv->routes)
+        return priv->routes;
+
+    addr_family = NM_IS_IP4_CONFIG(self) ? AF_INET : AF_INET6;
+    routes      = NULL;
+    if (priv->routes_variant) {
+        if (_variant_is_new_style(priv->routes_variant))
+            routes = nm_utils_ip_routes_from_variant(priv->routes_variant, addr_family);
+        else if (addr_family == AF_INET)
+            routes = nm_utils_ip4_routes_from_variant(priv->routes_variant);
+        else
+            routes = nm_utils_ip6_routes_from_variant(priv->routes_variant);
+        nm_assert(routes);
+    }
+    if (!routes)
+        routes = g_ptr_array_new_with_free_func((GDestroyNotify) nm_ip_route_unref);
+
+    priv->routes = routes;
+    return routes;
 }
 
 static NMLDBusNotifyUpdatePropFlags
@@ -296,9 +356,6 @@ nm_ip_config_init(NMIPConfig *self)
     priv = G_TYPE_INSTANCE_GET_PRIVATE(self, NM_TYPE_IP_CONFIG, NMIPConfigPrivate);
 
     self->_priv = priv;
-
-    priv->addresses = g_ptr_array_new_with_free_func((GDestroyNotify) nm_ip_address_unref);
-    priv->routes    = g_ptr_array_new_with_free_func((GDestroyNotify) nm_ip_route_unref);
 }
 
 static void
@@ -308,8 +365,10 @@ finalize(GObject *object)
 
     g_free(priv->gateway);
 
-    g_ptr_array_unref(priv->routes);
-    g_ptr_array_unref(priv->addresses);
+    nm_clear_pointer(&priv->routes, g_ptr_array_unref);
+    nm_clear_pointer(&priv->addresses, g_ptr_array_unref);
+    nm_clear_pointer(&priv->routes_variant, g_variant_unref);
+    nm_clear_pointer(&priv->addresses_variant, g_variant_unref);
 
     g_strfreev(priv->nameservers);
     g_strfreev(priv->domains);
@@ -559,7 +618,7 @@ nm_ip_config_get_addresses(NMIPConfig *config)
 {
     g_return_val_if_fail(NM_IS_IP_CONFIG(config), NULL);
 
-    return NM_IP_CONFIG_GET_PRIVATE(config)->addresses;
+    return _get_addresses(config);
 }
 
 /**
@@ -646,5 +705,5 @@ nm_ip_config_get_routes(NMIPConfig *config)
 {
     g_return_val_if_fail(NM_IS_IP_CONFIG(config), NULL);
 
-    return NM_IP_CONFIG_GET_PRIVATE(config)->routes;
+    return _get_routes(config);
 }
@@ -238,7 +238,9 @@ typedef enum {
 #define NM_CLIENT_INSTANCE_FLAGS_ALL                                             \
     ((NMClientInstanceFlags) (NM_CLIENT_INSTANCE_FLAGS_NO_AUTO_FETCH_PERMISSIONS \
                               | NM_CLIENT_INSTANCE_FLAGS_INITIALIZED_GOOD        \
-                              | NM_CLIENT_INSTANCE_FLAGS_INITIALIZED_BAD))
+                              | NM_CLIENT_INSTANCE_FLAGS_INITIALIZED_BAD         \
+                              | NM_CLIENT_INSTANCE_FLAGS_NO_IP_CONFIGS           \
+                              | NM_CLIENT_INSTANCE_FLAGS_COALESCE_CHANGES))
 
 #define NM_CLIENT_INSTANCE_FLAGS_ALL_WRITABLE                                                       \
     ((NMClientInstanceFlags) (NM_CLIENT_INSTANCE_FLAGS_ALL                                          \
@@ -341,6 +343,12 @@ NMLDBusNotifyUpdatePropFlags _nml_dbus_notify_update_prop_o(NMClient
                                                             guint     dbus_property_idx,
                                                             GVariant *value);
 
+NMLDBusNotifyUpdatePropFlags _nml_dbus_notify_update_prop_s_ref(NMClient               *client,
+                                                                NMLDBusObject          *dbobj,
+                                                                const NMLDBusMetaIface *meta_iface,
+                                                                guint     dbus_property_idx,
+                                                                GVariant *value);
+
 NMLDBusNotifyUpdatePropFlags nml_dbus_property_ao_notify(NMClient               *self,
                                                          NMLDBusPropertyAO      *pr_ao,
                                                          NMLDBusObject          *dbobj,
@@ -417,6 +425,20 @@ typedef struct {
 #define NML_DBUS_META_PROPERTY_INIT_AY(...) \
     _NML_DBUS_META_PROPERTY_INIT_DEFAULT("ay", GBytes *, __VA_ARGS__)
 
+/* Like NML_DBUS_META_PROPERTY_INIT_S(), but the string is stored as NMRefString.
+ * Use it for properties that have the same value on many objects (like the
+ * driver of a device), so that all objects share one copy. */
+#define NML_DBUS_META_PROPERTY_INIT_S_REF(v_dbus_property_name,                                  \
+                                          v_obj_properties_idx,                                  \
+                                          v_container,                                           \
+                                          v_field)                                               \
+    NML_DBUS_META_PROPERTY_INIT(                                                                 \
+        v_dbus_property_name,                                                                    \
+        "s",                                                                                     \
+        v_obj_properties_idx,                                                                    \
+        .prop_struct_offset = NM_STRUCT_OFFSET_ENSURE_TYPE(NMRefString *, v_container, v_field), \
+        .notify_update_prop = _nml_dbus_notify_update_prop_s_ref)
+
 #define NML_DBUS_META_PROPERTY_INIT_O(v_dbus_property_name,                                      \
                                       v_obj_properties_idx,                                      \
                                       v_container,                                               \
@@ -453,6 +453,11 @@ test_devices_array(void)
     g_assert(NM_IS_DEVICE_ETHERNET(device));
     g_assert(device == eth1);
 
+    /* The driver name is the same for all devices and is shared. */
+    g_assert_cmpstr(nm_device_get_driver(wlan0), ==, "virtual");
+    g_assert(nm_device_get_driver(wlan0) == nm_device_get_driver(eth0));
+    g_assert(nm_device_get_driver(wlan0) == nm_device_get_driver(eth1));
+
     /********************************/
     /* Now remove the device in the middle */
     ret = g_dbus_proxy_call_sync(sinfo->proxy,
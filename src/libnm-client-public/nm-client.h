@@ -29,6 +29,21 @@ G_BEGIN_DECLS
  * @NM_CLIENT_INSTANCE_FLAGS_INITIALIZED_BAD: like @NM_CLIENT_INSTANCE_FLAGS_INITIALIZED_GOOD
  *   indicates that the instance completed initialization with failure. In that
  *   case the instance is unusable. Since: 1.42.
+ * @NM_CLIENT_INSTANCE_FLAGS_NO_IP_CONFIGS: don't track the IP4Config, IP6Config,
+ *   DHCP4Config and DHCP6Config objects. With many devices, these make up most
+ *   of the objects on D-Bus. If the application doesn't need them, this saves
+ *   processing and memory and makes initialization faster. Properties that
+ *   reference such objects, like #NMDevice:ip4-config, are then always %NULL.
+ *   This flag can only be set during construction. Since: 1.58.
+ * @NM_CLIENT_INSTANCE_FLAGS_COALESCE_CHANGES: don't update the objects for
+ *   each D-Bus signal. Instead, parse all signals that are queued and then
+ *   update the objects once, from an idle handler. When the daemon sends
+ *   many changes at once, the properties of an object are then notified once,
+ *   with the last values. Property changes are seen a bit later, but the
+ *   cache is always consistent. Combined with creating the #NMClient on a
+ *   worker thread with its own #GMainContext, this keeps the D-Bus
+ *   processing away from the application's main thread.
+ *   This flag can only be set during construction. Since: 1.58.
  *
  * Since: 1.24
  */
@@ -37,6 +52,8 @@ typedef enum /*< flags >*/ {
     NM_CLIENT_INSTANCE_FLAGS_NO_AUTO_FETCH_PERMISSIONS = 0x1,
     NM_CLIENT_INSTANCE_FLAGS_INITIALIZED_GOOD          = 0x2,
     NM_CLIENT_INSTANCE_FLAGS_INITIALIZED_BAD           = 0x4,
+    NM_CLIENT_INSTANCE_FLAGS_NO_IP_CONFIGS             = 0x8,
+    NM_CLIENT_INSTANCE_FLAGS_COALESCE_CHANGES          = 0x10,
 } NMClientInstanceFlags;
 
 #define NM_TYPE_CLIENT            (nm_client_get_type())
@@ -314,6 +331,19 @@ void nm_client_activate_connection_async(NMClient           *client,
 NMActiveConnection *
 nm_client_activate_connection_finish(NMClient *client, GAsyncResult *result, GError **error);
 
+NM_AVAILABLE_IN_1_58
+void nm_client_activate_connections_async(NMClient           *client,
+                                          const GPtrArray    *connections,
+                                          const GPtrArray    *devices,
+                                          const GPtrArray    *specific_objects,
+                                          GCancellable       *cancellable,
+                                          GAsyncReadyCallback callback,
+                                          gpointer            user_data);
+
+NM_AVAILABLE_IN_1_58
+GVariant *
+nm_client_activate_connections_finish(NMClient *client, GAsyncResult *result, GError **error);
+
 void                nm_client_add_and_activate_connection_async(NMClient           *client,
                                                                 NMConnection       *partial,
                                                                 NMDevice           *device,
@@ -387,6 +417,29 @@ NMRemoteConnection *nm_client_add_connection2_finish(NMClient     *client,
                                                      GVariant    **out_result,
                                                      GError      **error);
 
+NM_AVAILABLE_IN_1_58
+void nm_client_add_connections_async(NMClient                     *client,
+                                     const GPtrArray              *connections,
+                                     NMSettingsAddConnection2Flags flags,
+                                     GCancellable                 *cancellable,
+                                     GAsyncReadyCallback           callback,
+                                     gpointer                      user_data);
+
+NM_AVAILABLE_IN_1_58
+GVariant *
+nm_client_add_connections_finish(NMClient *client, GAsyncResult *result, GError **error);
+
+NM_AVAILABLE_IN_1_58
+void nm_client_get_connections_settings_async(NMClient           *client,
+                                              const char *const  *paths,
+                                              GCancellable       *cancellable,
+                                              GAsyncReadyCallback callback,
+                                              gpointer            user_data);
+
+NM_AVAILABLE_IN_1_58
+GVariant *
+nm_client_get_connections_settings_finish(NMClient *client, GAsyncResult *result, GError **error);
+
 _NM_DEPRECATED_SYNC_METHOD
 gboolean nm_client_load_connections(NMClient     *client,
                                     char        **filenames,
@@ -55,11 +55,34 @@ static gboolean _nm_connection_clear_settings(NMConnection *connection, NMConnec
 
 /*****************************************************************************/
 
+static void
+_dbus_cache_clear(NMConnectionPrivate *priv)
+{
+    int i;
+
+    for (i = 0; i < _NM_CONNECTION_DBUS_CACHE_SIZE; i++) {
+        if (!priv->dbus_cache[i].variant)
+            break;
+        nm_clear_pointer(&priv->dbus_cache[i].variant, g_variant_unref);
+    }
+}
+
+/* The settings were (or are about to be) modified. */
+static void
+_invalidate(NMConnectionPrivate *priv)
+{
+    priv->verify_success = FALSE;
+    _dbus_cache_clear(priv);
+}
+
+/*****************************************************************************/
+
 void
 _nm_connection_private_clear(NMConnectionPrivate *priv)
 {
     if (priv->self) {
         _nm_connection_clear_settings(priv->self, priv);
+        _dbus_cache_clear(priv);
         nm_clear_pointer(&priv->path, nm_ref_string_unref);
         priv->self = NULL;
     }
@@ -118,6 +141,7 @@ _nm_connection_get_private_from_qdata(NMConnection *connection)
 static void
 _signal_emit_changed(NMConnection *self)
 {
+    _invalidate(NM_CONNECTION_GET_PRIVATE(self));
     g_signal_emit(self, signals[CHANGED], 0);
 }
 
@@ -158,6 +182,8 @@ _setting_notify_disconnect(NMConnection *connection, NMSetting *setting)
 static void
 _setting_notify_block(NMConnection *connection, NMSetting *setting)
 {
+    /* The setting is about to be modified without notification. */
+    _invalidate(NM_CONNECTION_GET_PRIVATE(connection));
     g_signal_handlers_block_by_func(setting, G_CALLBACK(_setting_notify_changed_cb), connection);
 }
 
@@ -175,6 +201,8 @@ _nm_connection_clear_settings(NMConnection *connection, NMConnectionPrivate *pri
     gboolean changed = FALSE;
     int      i;
 
+    _invalidate(priv);
+
     for (i = 0; i < (int) _NM_META_SETTING_TYPE_NUM; i++) {
         if (priv->settings[i]) {
             _setting_notify_disconnect(connection, priv->settings[i]);
@@ -208,6 +236,7 @@ _nm_connection_add_setting(NMConnection *connection, NMSetting *setting)
     }
 
     priv->settings[setting_info->meta_type] = setting;
+    _invalidate(priv);
 
     _setting_notify_connect(connection, setting);
 
@@ -255,6 +284,8 @@ _nm_connection_remove_setting(NMConnection *connection, GType setting_type)
     if (!setting)
         return FALSE;
 
+    _invalidate(priv);
+
     _setting_notify_disconnect(connection, setting);
     _signal_emit_changed(connection);
     g_object_unref(setting);
@@ -657,8 +688,14 @@ nm_connection_replace_settings_from_connection(NMConnection *connection,
         }
     }
 
-    if (changed)
-        _signal_emit_changed(connection);
+    if (changed) {
+        /* The settings are now identical to those of @new_connection. If that one
+         * is known to verify, so is @connection. Don't use _signal_emit_changed()
+         * here, but a handler that modifies the connection still resets the flag. */
+        _dbus_cache_clear(priv);
+        priv->verify_success = new_priv->verify_success;
+        g_signal_emit(connection, signals[CHANGED], 0);
+    }
 }
 
 /**
@@ -703,13 +740,17 @@ nm_connection_compare(NMConnection *a, NMConnection *b, NMSettingCompareFlags fl
     a_priv = NM_CONNECTION_GET_PRIVATE(a);
     b_priv = NM_CONNECTION_GET_PRIVATE(b);
 
+    /* Before comparing the content, check that both have the same settings. That
+     * is cheap and lets us fail fast. */
+    for (i = 0; i < (int) _NM_META_SETTING_TYPE_NUM; i++) {
+        if ((!a_priv->settings[i]) != (!b_priv->settings[i]))
+            return FALSE;
+    }
+
     for (i = 0; i < (int) _NM_META_SETTING_TYPE_NUM; i++) {
         if (a_priv->settings[i] == b_priv->settings[i])
             continue;
 
-        if (!a_priv->settings[i] || !b_priv->settings[i])
-            return FALSE;
-
         if (!_nm_setting_compare(a, a_priv->settings[i], b, b_priv->settings[i], flags))
             return FALSE;
     }
@@ -1929,6 +1970,16 @@ _nm_connection_verify(NMConnection *connection, GError **error)
 
     priv = NM_CONNECTION_GET_PRIVATE(connection);
 
+    if (priv->verify_success) {
+        /* Profiles get verified over and over (on load, on add, before normalize,
+         * when cloned). The flag gets cleared whenever a setting changes, so there
+         * is no need to run all the verify() functions again.
+         *
+         * The result of one setting's verify() depends on the other settings of
+         * the connection, so the flag tracks the connection as a whole. */
+        return NM_SETTING_VERIFY_SUCCESS;
+    }
+
     if (!_get_setting_by_metatype(priv, NM_META_SETTING_TYPE_CONNECTION)) {
         g_set_error_literal(error,
                             NM_CONNECTION_ERROR,
@@ -2064,6 +2115,7 @@ _nm_connection_verify(NMConnection *connection, GError **error)
         return normalizable_error_type;
     }
 
+    priv->verify_success = TRUE;
     return NM_SETTING_VERIFY_SUCCESS;
 }
 
@@ -2856,6 +2908,56 @@ nm_connection_to_dbus_full(NMConnection                           *connection,
     return g_variant_builder_end(&builder);
 }
 
+/**
+ * _nm_connection_to_dbus_cached:
+ * @connection: the #NMConnection
+ * @flags: serialization flags, e.g. %NM_CONNECTION_SERIALIZE_ALL
+ *
+ * Like nm_connection_to_dbus(), but the result is remembered per @flags
+ * until the connection changes. Serializing an unchanged connection again
+ * only takes a reference.
+ *
+ * Note that only modifications that emit #NMConnection::changed (or that go
+ * through the connection, like updating secrets) invalidate the cache.
+ *
+ * Returns: (transfer full): a new reference to a non-floating #GVariant,
+ *   or %NULL if the connection has no settings to serialize.
+ */
+GVariant *
+_nm_connection_to_dbus_cached(NMConnection *connection, NMConnectionSerializationFlags flags)
+{
+    NMConnectionPrivate *priv;
+    GVariant            *variant;
+    int                  i;
+
+    g_return_val_if_fail(NM_IS_CONNECTION(connection), NULL);
+
+    priv = NM_CONNECTION_GET_PRIVATE(connection);
+
+    for (i = 0; i < _NM_CONNECTION_DBUS_CACHE_SIZE; i++) {
+        if (!priv->dbus_cache[i].variant)
+            break;
+        if (priv->dbus_cache[i].flags == flags)
+            return g_variant_ref(priv->dbus_cache[i].variant);
+    }
+
+    variant = nm_connection_to_dbus_full(connection, flags, NULL);
+    if (!variant)
+        return NULL;
+
+    g_variant_ref_sink(variant);
+
+    if (i == _NM_CONNECTION_DBUS_CACHE_SIZE) {
+        /* All slots are taken. Callers use few different flags, so just
+         * replace the last one. */
+        i--;
+        g_variant_unref(priv->dbus_cache[i].variant);
+    }
+    priv->dbus_cache[i].variant = g_variant_ref(variant);
+    priv->dbus_cache[i].flags   = flags;
+    return variant;
+}
+
 /**
  * nm_connection_is_type:
  * @connection: the #NMConnection
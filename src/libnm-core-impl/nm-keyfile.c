@@ -2396,15 +2396,21 @@ write_ip_values(GKeyFile *file, const char *setting_name, GPtrArray *array, gboo
                                             nm_str_buf_get_str(&output));
 
             if (is_route) {
-                gs_free char *attributes = NULL;
-
-                attributes =
-                    nm_utils_format_variant_attributes(_nm_ip_route_get_attributes(array->pdata[i]),
-                                                       ',',
-                                                       '=');
-                if (attributes) {
+                const NMUtilsNamedValue *attrs;
+                guint                    attrs_len;
+
+                attrs = _nm_ip_route_get_attributes(array->pdata[i], &attrs_len);
+                if (attrs_len > 0) {
+                    nm_auto_free_gstring GString *attributes = g_string_new(NULL);
+
+                    _nm_utils_format_variant_attributes_full(attributes,
+                                                             attrs,
+                                                             attrs_len,
+                                                             NULL,
+                                                             ',',
+                                                             '=');
                     g_strlcat(key_name, "_options", sizeof(key_name));
-                    nm_keyfile_plugin_kf_set_string(file, setting_name, key_name, attributes);
+                    nm_keyfile_plugin_kf_set_string(file, setting_name, key_name, attributes->str);
                 }
             }
         }
@@ -714,10 +714,40 @@ const NMMetaSettingType nm_meta_setting_types_by_priority[] = {
     NM_META_SETTING_TYPE_USER,
 };
 
+/* An open addressing hash table for nm_meta_setting_infos_by_name(). The
+ * entries are the NMMetaSettingType plus one, zero marks an empty slot. */
+#define _META_SETTING_LOOKUP_N_SLOTS 256u
+
+static const guint8 *
+_meta_setting_lookup_table(void)
+{
+    static const guint8 *table_static = NULL;
+    static guint8        table[_META_SETTING_LOOKUP_N_SLOTS];
+    guint                i;
+
+    G_STATIC_ASSERT_EXPR(2u * _NM_META_SETTING_TYPE_NUM <= _META_SETTING_LOOKUP_N_SLOTS);
+    G_STATIC_ASSERT_EXPR(_NM_META_SETTING_TYPE_NUM < G_MAXUINT8);
+
+    if (g_once_init_enter(&table_static)) {
+        for (i = 0; i < _NM_META_SETTING_TYPE_NUM; i++) {
+            guint h = nm_str_hash(nm_meta_setting_infos[i].setting_name)
+                      & (_META_SETTING_LOOKUP_N_SLOTS - 1u);
+
+            while (table[h] != 0)
+                h = (h + 1u) & (_META_SETTING_LOOKUP_N_SLOTS - 1u);
+            table[h] = i + 1u;
+        }
+        g_once_init_leave(&table_static, table);
+    }
+    return table_static;
+}
+
 const NMMetaSettingInfo *
 nm_meta_setting_infos_by_name(const char *name)
 {
-    gssize idx;
+    const guint8 *table;
+    guint         h;
+    guint8        idx;
 
     if (NM_MORE_ASSERTS > 10) {
         guint i, j;
@@ -748,15 +778,14 @@ nm_meta_setting_infos_by_name(const char *name)
         }
     }
 
-    G_STATIC_ASSERT_EXPR(G_STRUCT_OFFSET(NMMetaSettingInfo, setting_name) == 0);
-    idx = nm_array_find_bsearch(nm_meta_setting_infos,
-                                _NM_META_SETTING_TYPE_NUM,
-                                sizeof(NMMetaSettingInfo),
-                                &name,
-                                nm_strcmp_p_with_data,
-                                NULL);
-
-    return idx >= 0 ? &nm_meta_setting_infos[idx] : NULL;
+    table = _meta_setting_lookup_table();
+    h     = nm_str_hash(name) & (_META_SETTING_LOOKUP_N_SLOTS - 1u);
+    while ((idx = table[h]) != 0) {
+        if (nm_streq(nm_meta_setting_infos[idx - 1u].setting_name, name))
+            return &nm_meta_setting_infos[idx - 1u];
+        h = (h + 1u) & (_META_SETTING_LOOKUP_N_SLOTS - 1u);
+    }
+    return NULL;
 }
 
 /*****************************************************************************/
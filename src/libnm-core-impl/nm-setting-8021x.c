@@ -3493,6 +3493,7 @@ nm_setting_802_1x_class_init(NMSetting8021xClass *klass)
                                               NM_SETTING_PARAM_NONE,
                                               NMSetting8021xPrivate,
                                               domain_suffix_match,
+                                              .direct_string_is_refstr   = TRUE,
                                               .direct_string_allow_empty = TRUE);
 
     /**
@@ -3616,6 +3617,7 @@ nm_setting_802_1x_class_init(NMSetting8021xClass *klass)
                                               NM_SETTING_PARAM_NONE,
                                               NMSetting8021xPrivate,
                                               phase1_peapver,
+                                              .direct_string_is_refstr   = TRUE,
                                               .direct_string_allow_empty = TRUE);
 
     /**
@@ -3668,6 +3670,7 @@ nm_setting_802_1x_class_init(NMSetting8021xClass *klass)
                                               NM_SETTING_PARAM_NONE,
                                               NMSetting8021xPrivate,
                                               phase1_fast_provisioning,
+                                              .direct_string_is_refstr   = TRUE,
                                               .direct_string_allow_empty = TRUE);
 
     /**
@@ -3733,6 +3736,7 @@ nm_setting_802_1x_class_init(NMSetting8021xClass *klass)
                                               NM_SETTING_PARAM_NONE,
                                               NMSetting8021xPrivate,
                                               phase2_auth,
+                                              .direct_string_is_refstr   = TRUE,
                                               .direct_string_allow_empty = TRUE);
 
     /**
@@ -3761,6 +3765,7 @@ nm_setting_802_1x_class_init(NMSetting8021xClass *klass)
                                               NM_SETTING_PARAM_NONE,
                                               NMSetting8021xPrivate,
                                               phase2_autheap,
+                                              .direct_string_is_refstr   = TRUE,
                                               .direct_string_allow_empty = TRUE);
 
     /**
@@ -666,8 +666,8 @@ nm_setting_connection_get_timestamp(NMSettingConnection *setting)
     return NM_SETTING_CONNECTION_GET_PRIVATE(setting)->timestamp;
 }
 
-static GVariant *
-_to_dbus_fcn_timestamp(_NM_SETT_INFO_PROP_TO_DBUS_FCN_ARGS _nm_nil)
+GVariant *
+_nm_setting_connection_timestamp_to_dbus(_NM_SETT_INFO_PROP_TO_DBUS_FCN_ARGS _nm_nil)
 {
     guint64 v;
 
@@ -2171,13 +2171,13 @@ compare_fcn_timestamp(_NM_SETT_INFO_PROP_COMPARE_FCN_ARGS _nm_nil)
     if (NM_FLAGS_HAS(flags, NM_SETTING_COMPARE_FLAG_IGNORE_TIMESTAMP))
         return NM_TERNARY_DEFAULT;
 
-    return _nm_setting_property_compare_fcn_default(sett_info,
-                                                    property_info,
-                                                    con_a,
-                                                    set_a,
-                                                    con_b,
-                                                    set_b,
-                                                    flags);
+    return _nm_setting_property_compare_fcn_direct(sett_info,
+                                                   property_info,
+                                                   con_a,
+                                                   set_a,
+                                                   con_b,
+                                                   set_b,
+                                                   flags);
 }
 
 /*****************************************************************************/
@@ -2204,9 +2204,6 @@ get_property(GObject *object, guint prop_id, GValue *value, GParamSpec *pspec)
         g_value_take_boxed(value, strv);
         break;
     }
-    case PROP_TIMESTAMP:
-        g_value_set_uint64(value, nm_setting_connection_get_timestamp(setting));
-        break;
     default:
         _nm_setting_property_get_property_direct(object, prop_id, value, pspec);
         break;
@@ -2239,9 +2236,6 @@ set_property(GObject *object, guint prop_id, const GValue *value, GParamSpec *ps
         }
         break;
     }
-    case PROP_TIMESTAMP:
-        priv->timestamp = g_value_get_uint64(value);
-        break;
     default:
         _nm_setting_property_set_property_direct(object, prop_id, value, pspec);
         break;
@@ -2846,22 +2840,27 @@ nm_setting_connection_class_init(NMSettingConnectionClass *klass)
      * timestamp. The property is only meant for reading (changes to this
      * property will not be preserved).
      **/
-    obj_properties[PROP_TIMESTAMP] = g_param_spec_uint64(
-        NM_SETTING_CONNECTION_TIMESTAMP,
-        "",
-        "",
-        0,
-        G_MAXUINT64,
-        0,
-        G_PARAM_READWRITE | NM_SETTING_PARAM_FUZZY_IGNORE | G_PARAM_STATIC_STRINGS);
+    obj_properties[PROP_TIMESTAMP] =
+        g_param_spec_uint64(NM_SETTING_CONNECTION_TIMESTAMP,
+                            "",
+                            "",
+                            0,
+                            G_MAXUINT64,
+                            0,
+                            G_PARAM_READWRITE | G_PARAM_EXPLICIT_NOTIFY
+                                | NM_SETTING_PARAM_FUZZY_IGNORE | G_PARAM_STATIC_STRINGS);
     _nm_properties_override_gobj(
         properties_override,
         obj_properties[PROP_TIMESTAMP],
         NM_SETT_INFO_PROPERT_TYPE_DBUS(G_VARIANT_TYPE_UINT64,
+                                       .direct_type   = NM_VALUE_TYPE_UINT64,
                                        .compare_fcn   = compare_fcn_timestamp,
-                                       .to_dbus_fcn   = _to_dbus_fcn_timestamp,
-                                       .from_dbus_fcn = _nm_setting_property_from_dbus_fcn_gprop,
-                                       .from_dbus_is_full = TRUE));
+                                       .to_dbus_fcn   = _nm_setting_connection_timestamp_to_dbus,
+                                       .from_dbus_fcn = _nm_setting_property_from_dbus_fcn_direct,
+                                       .from_dbus_is_full                = TRUE,
+                                       .from_dbus_direct_allow_transform = TRUE),
+        .direct_offset =
+            NM_STRUCT_OFFSET_ENSURE_TYPE(guint64, NMSettingConnectionPrivate, timestamp));
 
     /**
      * NMSettingConnection:read-only:
@@ -2907,6 +2906,7 @@ nm_setting_connection_class_init(NMSettingConnectionClass *klass)
                                                   | NM_SETTING_PARAM_REAPPLY_IMMEDIATELY,
                                               NMSettingConnectionPrivate,
                                               zone,
+                                              .direct_string_is_refstr   = TRUE,
                                               .direct_string_allow_empty = TRUE);
 
     /**
@@ -2938,6 +2938,7 @@ nm_setting_connection_class_init(NMSettingConnectionClass *klass)
                                        .from_dbus_fcn = _nm_setting_connection_master_from_dbus, ),
         NMSettingConnectionPrivate,
         controller,
+        .direct_string_is_refstr   = TRUE,
         .direct_string_allow_empty = TRUE,
         .is_deprecated             = TRUE,
         .direct_is_aliased_field   = TRUE, );
@@ -2961,6 +2962,7 @@ nm_setting_connection_class_init(NMSettingConnectionClass *klass)
                                            _nm_setting_connection_controller_from_dbus),
         NMSettingConnectionPrivate,
         controller,
+        .direct_string_is_refstr   = TRUE,
         .direct_string_allow_empty = TRUE,
         .direct_also_notify        = obj_properties[PROP_MASTER]);
 
@@ -3001,6 +3003,7 @@ nm_setting_connection_class_init(NMSettingConnectionClass *klass)
         NMSettingConnectionPrivate,
         port_type,
         .is_deprecated             = TRUE,
+        .direct_string_is_refstr   = TRUE,
         .direct_string_allow_empty = TRUE,
         .direct_is_aliased_field   = TRUE, );
 
@@ -3027,6 +3030,7 @@ nm_setting_connection_class_init(NMSettingConnectionClass *klass)
                                            _nm_setting_connection_port_type_from_dbus, ),
         NMSettingConnectionPrivate,
         port_type,
+        .direct_string_is_refstr   = TRUE,
         .direct_string_allow_empty = TRUE,
         .direct_also_notify        = obj_properties[PROP_SLAVE_TYPE]);
 
@@ -138,6 +138,23 @@ nm_ethtool_optname_is_fec(const char *optname)
     return optname && nm_ethtool_id_is_fec(nm_ethtool_id_get_by_name(optname));
 }
 
+/**
+ * nm_ethtool_optname_is_rss:
+ * @optname: (nullable): the option name to check
+ *
+ * Checks whether @optname is a valid option name for a RSS (receive side
+ * scaling) setting.
+ *
+ * Returns: %TRUE, if @optname is valid
+ *
+ * Since: 1.58
+ */
+gboolean
+nm_ethtool_optname_is_rss(const char *optname)
+{
+    return optname && nm_ethtool_id_is_rss(nm_ethtool_id_get_by_name(optname));
+}
+
 /*****************************************************************************/
 
 /**
@@ -375,6 +392,27 @@ verify(NMSetting *setting, NMConnection *connection, GError **error)
             pause_tx = g_variant_get_boolean(variant);
         else if (NM_IN_SET(ethtool_id, NM_ETHTOOL_ID_FEC_MODE))
             fec_mode = g_variant_get_uint32(variant);
+        else if (NM_IN_SET(ethtool_id, NM_ETHTOOL_ID_RSS_EQUAL)) {
+            if (g_variant_get_uint32(variant) == 0) {
+                g_set_error_literal(error,
+                                    NM_CONNECTION_ERROR,
+                                    NM_CONNECTION_ERROR_INVALID_PROPERTY,
+                                    _("the RSS indirection table needs at least one queue"));
+                g_prefix_error(error, "%s.%s: ", NM_SETTING_ETHTOOL_SETTING_NAME, optname);
+                return FALSE;
+            }
+        } else if (NM_IN_SET(ethtool_id, NM_ETHTOOL_ID_RSS_HFUNC)) {
+            /* The ETH_RSS_HASH_* bits from linux/ethtool.h. */
+            if (!NM_IN_SET(g_variant_get_uint32(variant), 1u, 2u, 4u)) {
+                g_set_error_literal(
+                    error,
+                    NM_CONNECTION_ERROR,
+                    NM_CONNECTION_ERROR_INVALID_PROPERTY,
+                    _("RSS hash function must be 1 (toeplitz), 2 (xor) or 4 (crc32)"));
+                g_prefix_error(error, "%s.%s: ", NM_SETTING_ETHTOOL_SETTING_NAME, optname);
+                return FALSE;
+            }
+        }
     }
 
     if (pause_rx != NM_TERNARY_DEFAULT || pause_tx != NM_TERNARY_DEFAULT) {
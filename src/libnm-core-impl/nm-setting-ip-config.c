@@ -132,6 +132,147 @@ valid_metric(gint64 metric, GError **error)
     return TRUE;
 }
 
+/*****************************************************************************/
+
+/* The attributes of a NMIPAddress or NMIPRoute. Profiles can have many
+ * thousands of routes, so instead of a GHashTable per route, there is a
+ * single allocation with the attributes sorted by name. The names are
+ * interned, and boolean values are shared singletons. */
+typedef struct {
+    guint             len;
+    NMUtilsNamedValue arr[];
+} IPAttrs;
+
+static void
+_ip_attrs_free(IPAttrs *attrs)
+{
+    guint i;
+
+    if (!attrs)
+        return;
+
+    for (i = 0; i < attrs->len; i++)
+        g_variant_unref(attrs->arr[i].value_ptr);
+    g_free(attrs);
+}
+
+static IPAttrs *
+_ip_attrs_dup(const IPAttrs *attrs)
+{
+    IPAttrs *copy;
+    guint    i;
+
+    if (!attrs)
+        return NULL;
+
+    copy = nm_memdup(attrs, sizeof(IPAttrs) + attrs->len * sizeof(NMUtilsNamedValue));
+    for (i = 0; i < copy->len; i++)
+        g_variant_ref(copy->arr[i].value_ptr);
+    return copy;
+}
+
+static GVariant *
+_ip_attrs_get(const IPAttrs *attrs, const char *name)
+{
+    gssize idx;
+
+    if (!attrs)
+        return NULL;
+
+    idx = nm_utils_named_value_list_find(attrs->arr, attrs->len, name, TRUE);
+    return idx >= 0 ? attrs->arr[idx].value_ptr : NULL;
+}
+
+static void
+_ip_attrs_set(IPAttrs **p_attrs, const char *name, GVariant *value)
+{
+    IPAttrs  *attrs = *p_attrs;
+    guint     len   = attrs ? attrs->len : 0u;
+    gssize    idx;
+    GVariant *old;
+
+    if (value) {
+        g_variant_ref_sink(value);
+        if (g_variant_is_of_type(value, G_VARIANT_TYPE_BOOLEAN)) {
+            old   = value;
+            value = g_variant_ref(nm_g_variant_singleton_b(g_variant_get_boolean(old)));
+            g_variant_unref(old);
+        }
+    }
+
+    idx = attrs ? nm_utils_named_value_list_find(attrs->arr, len, name, TRUE) : ~((gssize) 0);
+
+    if (idx >= 0) {
+        old = attrs->arr[idx].value_ptr;
+        if (value) {
+            attrs->arr[idx].value_ptr = value;
+            g_variant_unref(old);
+            return;
+        }
+        g_variant_unref(old);
+        len--;
+        if (len == 0) {
+            nm_clear_g_free(p_attrs);
+            return;
+        }
+        memmove(&attrs->arr[idx], &attrs->arr[idx + 1], (len - idx) * sizeof(NMUtilsNamedValue));
+        attrs->len = len;
+        *p_attrs   = g_realloc(attrs, sizeof(IPAttrs) + len * sizeof(NMUtilsNamedValue));
+        return;
+    }
+
+    if (!value)
+        return;
+
+    idx   = ~idx;
+    attrs = g_realloc(attrs, sizeof(IPAttrs) + (len + 1u) * sizeof(NMUtilsNamedValue));
+    memmove(&attrs->arr[idx + 1], &attrs->arr[idx], (len - idx) * sizeof(NMUtilsNamedValue));
+    attrs->arr[idx] = (NMUtilsNamedValue) {
+        .name      = g_intern_string(name),
+        .value_ptr = value,
+    };
+    attrs->len = len + 1u;
+    *p_attrs   = attrs;
+}
+
+static gboolean
+_ip_attrs_equal(const IPAttrs *a, const IPAttrs *b)
+{
+    guint len = a ? a->len : 0u;
+    guint i;
+
+    if (len != (b ? b->len : 0u))
+        return FALSE;
+
+    /* Both are sorted by the interned names. */
+    for (i = 0; i < len; i++) {
+        if (a->arr[i].name != b->arr[i].name)
+            return FALSE;
+        if (!g_variant_equal(a->arr[i].value_ptr, b->arr[i].value_ptr))
+            return FALSE;
+    }
+    return TRUE;
+}
+
+static const char **
+_ip_attrs_get_names(const IPAttrs *attrs, guint *out_length)
+{
+    const char **names;
+    guint        i;
+
+    if (!attrs) {
+        NM_SET_OUT(out_length, 0);
+        return NULL;
+    }
+
+    names = g_new(const char *, attrs->len + 1u);
+    for (i = 0; i < attrs->len; i++)
+        names[i] = attrs->arr[i].name;
+    names[i] = NULL;
+    NM_SET_OUT(out_length, attrs->len);
+    return names;
+}
+
 /*****************************************************************************
  * NMIPAddress
  *****************************************************************************/
@@ -144,8 +285,8 @@ struct NMIPAddress {
     gint8  family;
     guint8 prefix;
 
-    char       *address;
-    GHashTable *attributes;
+    char    *address;
+    IPAttrs *attributes;
 };
 
 /**
@@ -251,7 +392,7 @@ nm_ip_address_unref(NMIPAddress *address)
     address->refcount--;
     if (address->refcount == 0) {
         g_free(address->address);
-        nm_g_hash_table_unref(address->attributes);
+        _ip_attrs_free(address->attributes);
         nm_g_slice_free(address);
     }
 }
@@ -286,32 +427,14 @@ nm_ip_address_cmp_full(const NMIPAddress *a, const NMIPAddress *b, NMIPAddressCm
     NM_CMP_FIELD_STR(a, b, address);
 
     if (NM_FLAGS_HAS(cmp_flags, NM_IP_ADDRESS_CMP_FLAGS_WITH_ATTRS)) {
-        GHashTableIter iter;
-        const char    *key;
-        GVariant      *value, *value2;
-        guint          n;
-
-        n = a->attributes ? g_hash_table_size(a->attributes) : 0u;
-        NM_CMP_DIRECT(n, (b->attributes ? g_hash_table_size(b->attributes) : 0u));
-
-        if (n > 0) {
-            g_hash_table_iter_init(&iter, a->attributes);
-            while (g_hash_table_iter_next(&iter, (gpointer *) &key, (gpointer *) &value)) {
-                value2 = g_hash_table_lookup(b->attributes, key);
-                /* We cannot really compare GVariants, because g_variant_compare() does
-                 * not work in general. So, don't bother. NM_IP_ADDRESS_CMP_FLAGS_WITH_ATTRS is
-                 * documented to not provide a total order for the attribute contents.
-                 *
-                 * Theoretically, we can implement also a total order. However we should
-                 * not do that by default because it would require us to sort the keys
-                 * first. Most callers don't care about total order, so they shouldn't
-                 * pay the overhead. */
-                if (!value2)
-                    return -2;
-                if (!g_variant_equal(value, value2))
-                    return -2;
-            }
-        }
+        NM_CMP_DIRECT(a->attributes ? a->attributes->len : 0u,
+                      b->attributes ? b->attributes->len : 0u);
+
+        /* We cannot really compare GVariants, because g_variant_compare() does
+         * not work in general. So, don't bother. NM_IP_ADDRESS_CMP_FLAGS_WITH_ATTRS is
+         * documented to not provide a total order for the attribute contents. */
+        if (!_ip_attrs_equal(a->attributes, b->attributes))
+            return -2;
     }
 
     return 0;
@@ -355,17 +478,8 @@ nm_ip_address_dup(NMIPAddress *address)
     g_return_val_if_fail(address != NULL, NULL);
     g_return_val_if_fail(address->refcount > 0, NULL);
 
-    copy = nm_ip_address_new(address->family, address->address, address->prefix, NULL);
-    if (address->attributes) {
-        GHashTableIter iter;
-        const char    *key;
-        GVariant      *value;
-
-        g_hash_table_iter_init(&iter, address->attributes);
-        while (g_hash_table_iter_next(&iter, (gpointer *) &key, (gpointer *) &value))
-            nm_ip_address_set_attribute(copy, key, value);
-    }
-
+    copy             = nm_ip_address_new(address->family, address->address, address->prefix, NULL);
+    copy->attributes = _ip_attrs_dup(address->attributes);
     return copy;
 }
 
@@ -507,7 +621,8 @@ _nm_ip_address_get_attribute_names(const NMIPAddress *address, gboolean sorted,
 {
     nm_assert(address);
 
-    return nm_strdict_get_keys(address->attributes, sorted, out_length);
+    /* The names are always sorted. */
+    return _ip_attrs_get_names(address->attributes, out_length);
 }
 
 /**
@@ -545,10 +660,7 @@ nm_ip_address_get_attribute(NMIPAddress *address, const char *name)
     g_return_val_if_fail(address != NULL, NULL);
     g_return_val_if_fail(name != NULL && *name != '\0', NULL);
 
-    if (address->attributes)
-        return g_hash_table_lookup(address->attributes, name);
-    else
-        return NULL;
+    return _ip_attrs_get(address->attributes, name);
 }
 
 /**
@@ -566,17 +678,7 @@ nm_ip_address_set_attribute(NMIPAddress *address, const char *name, GVariant *va
     g_return_if_fail(name != NULL && *name != '\0');
     g_return_if_fail(strcmp(name, "address") != 0 && strcmp(name, "prefix") != 0);
 
-    if (!address->attributes) {
-        address->attributes = g_hash_table_new_full(nm_str_hash,
-                                                    g_str_equal,
-                                                    g_free,
-                                                    (GDestroyNotify) g_variant_unref);
-    }
-
-    if (value)
-        g_hash_table_insert(address->attributes, g_strdup(name), g_variant_ref_sink(value));
-    else
-        g_hash_table_remove(address->attributes, name);
+    _ip_attrs_set(&address->attributes, name, value);
 }
 
 /*****************************************************************************
@@ -591,9 +693,9 @@ struct NMIPRoute {
     gint8  family;
     guint8 prefix;
 
-    char       *dest;
-    char       *next_hop;
-    GHashTable *attributes;
+    char    *dest;
+    char    *next_hop;
+    IPAttrs *attributes;
 
     gint64 metric;
 };
@@ -727,7 +829,7 @@ nm_ip_route_unref(NMIPRoute *route)
     if (route->refcount == 0) {
         g_free(route->dest);
         g_free(route->next_hop);
-        nm_g_hash_table_unref(route->attributes);
+        _ip_attrs_free(route->attributes);
         nm_g_slice_free(route);
     }
 }
@@ -765,26 +867,9 @@ nm_ip_route_equal_full(NMIPRoute *route, NMIPRoute *other, guint cmp_flags)
         || strcmp(route->dest, other->dest) != 0
         || g_strcmp0(route->next_hop, other->next_hop) != 0)
         return FALSE;
-    if (cmp_flags == NM_IP_ROUTE_EQUAL_CMP_FLAGS_WITH_ATTRS) {
-        GHashTableIter iter;
-        const char    *key;
-        GVariant      *value, *value2;
-        guint          n;
-
-        n = route->attributes ? g_hash_table_size(route->attributes) : 0u;
-        if (n != (other->attributes ? g_hash_table_size(other->attributes) : 0u))
-            return FALSE;
-        if (n) {
-            g_hash_table_iter_init(&iter, route->attributes);
-            while (g_hash_table_iter_next(&iter, (gpointer *) &key, (gpointer *) &value)) {
-                value2 = g_hash_table_lookup(other->attributes, key);
-                if (!value2)
-                    return FALSE;
-                if (!g_variant_equal(value, value2))
-                    return FALSE;
-            }
-        }
-    }
+    if (cmp_flags == NM_IP_ROUTE_EQUAL_CMP_FLAGS_WITH_ATTRS
+        && !_ip_attrs_equal(route->attributes, other->attributes))
+        return FALSE;
     return TRUE;
 }
 
@@ -832,16 +917,7 @@ nm_ip_route_dup(NMIPRoute *route)
                            route->next_hop,
                            route->metric,
                            NULL);
-    if (route->attributes) {
-        GHashTableIter iter;
-        const char    *key;
-        GVariant      *value;
-
-        g_hash_table_iter_init(&iter, route->attributes);
-        while (g_hash_table_iter_next(&iter, (gpointer *) &key, (gpointer *) &value))
-            nm_ip_route_set_attribute(copy, key, value);
-    }
-
+    copy->attributes = _ip_attrs_dup(route->attributes);
     return copy;
 }
 
@@ -1102,12 +1178,20 @@ nm_ip_route_set_metric(NMIPRoute *route, gint64 metric)
     route->metric = metric;
 }
 
-GHashTable *
-_nm_ip_route_get_attributes(NMIPRoute *route)
+const NMUtilsNamedValue *
+_nm_ip_route_get_attributes(NMIPRoute *route, guint *out_length)
 {
     nm_assert(route);
+    nm_assert(out_length);
+
+    if (!route->attributes) {
+        *out_length = 0;
+        return NULL;
+    }
 
-    return route->attributes;
+    /* sorted by name. */
+    *out_length = route->attributes->len;
+    return route->attributes->arr;
 }
 
 /**
@@ -1128,7 +1212,8 @@ _nm_ip_route_get_attribute_names(const NMIPRoute *route, gboolean sorted, guint
 {
     nm_assert(route);
 
-    return nm_strdict_get_keys(route->attributes, sorted, out_length);
+    /* The names are always sorted. */
+    return _ip_attrs_get_names(route->attributes, out_length);
 }
 
 /**
@@ -1166,10 +1251,7 @@ nm_ip_route_get_attribute(NMIPRoute *route, const char *name)
     g_return_val_if_fail(route != NULL, NULL);
     g_return_val_if_fail(name != NULL && *name != '\0', NULL);
 
-    if (route->attributes)
-        return g_hash_table_lookup(route->attributes, name);
-    else
-        return NULL;
+    return _ip_attrs_get(route->attributes, name);
 }
 
 /**
@@ -1188,17 +1270,7 @@ nm_ip_route_set_attribute(NMIPRoute *route, const char *name, GVariant *value)
     g_return_if_fail(strcmp(name, "dest") != 0 && strcmp(name, "prefix") != 0
                      && strcmp(name, "next-hop") != 0 && strcmp(name, "metric") != 0);
 
-    if (!route->attributes) {
-        route->attributes = g_hash_table_new_full(nm_str_hash,
-                                                  g_str_equal,
-                                                  g_free,
-                                                  (GDestroyNotify) g_variant_unref);
-    }
-
-    if (value)
-        g_hash_table_insert(route->attributes, g_strdup(name), g_variant_ref_sink(value));
-    else
-        g_hash_table_remove(route->attributes, name);
+    _ip_attrs_set(&route->attributes, name, value);
 }
 
 static const NMVariantAttributeSpec *const ip_route_attribute_spec[] = {
@@ -1490,30 +1562,24 @@ nm_ip_route_attribute_validate(const char *name,
 gboolean
 _nm_ip_route_attribute_validate_all(const NMIPRoute *route, GError **error)
 {
-    NMUtilsNamedValue          attrs_static[G_N_ELEMENTS(ip_route_attribute_spec)];
-    gs_free NMUtilsNamedValue *attrs_free = NULL;
-    const NMUtilsNamedValue   *attrs;
-    guint                      attrs_len;
-    guint                      i;
-    IPRouteAttrParseData       parse_data = {
-              .type   = RTN_UNICAST,
-              .scope  = -1,
-              .weight = 0,
+    const IPAttrs       *attrs;
+    guint                i;
+    IPRouteAttrParseData parse_data = {
+        .type   = RTN_UNICAST,
+        .scope  = -1,
+        .weight = 0,
     };
 
     g_return_val_if_fail(route, FALSE);
     g_return_val_if_fail(!error || !*error, FALSE);
 
-    if (!route->attributes)
+    attrs = route->attributes;
+    if (!attrs)
         return TRUE;
 
-    attrs = nm_utils_named_values_from_strdict(route->attributes,
-                                               &attrs_len,
-                                               attrs_static,
-                                               &attrs_free);
-    for (i = 0; i < attrs_len; i++) {
-        if (!_ip_route_attribute_validate(attrs[i].name,
-                                          attrs[i].value_ptr,
+    for (i = 0; i < attrs->len; i++) {
+        if (!_ip_route_attribute_validate(attrs->arr[i].name,
+                                          attrs->arr[i].value_ptr,
                                           route->family,
                                           &parse_data,
                                           NULL,
@@ -22,7 +22,20 @@ NM_GOBJECT_PROPERTIES_DEFINE(NMSettingLink,
                              PROP_TX_QUEUE_LENGTH,
                              PROP_GSO_MAX_SIZE,
                              PROP_GSO_MAX_SEGMENTS,
-                             PROP_GRO_MAX_SIZE, );
+                             PROP_GRO_MAX_SIZE,
+                             PROP_NEIGHBORS,
+                             PROP_FDB_ENTRIES,
+                             PROP_RPS_CPUS,
+                             PROP_RPS_FLOW_COUNT,
+                             PROP_XPS_CPUS,
+                             PROP_IRQ_AFFINITY,
+                             PROP_GSO_IPV4_MAX_SIZE,
+                             PROP_GRO_IPV4_MAX_SIZE,
+                             PROP_NAPI_THREADED,
+                             PROP_NAPI_DEFER_HARD_IRQS,
+                             PROP_GRO_FLUSH_TIMEOUT,
+                             PROP_XDP_PROGRAM,
+                             PROP_XDP_MODE, );
 
 /**
  * NMSettingLink:
@@ -32,11 +45,24 @@ NM_GOBJECT_PROPERTIES_DEFINE(NMSettingLink,
  * Since: 1.44
  */
 struct _NMSettingLink {
-    NMSetting parent;
-    gint64    tx_queue_length;
-    gint64    gso_max_size;
-    gint64    gso_max_segments;
-    gint64    gro_max_size;
+    NMSetting   parent;
+    NMValueStrv neighbors;
+    NMValueStrv fdb_entries;
+    char       *rps_cpus;
+    char       *xps_cpus;
+    char       *irq_affinity;
+    char       *xdp_program;
+    char       *xdp_mode;
+    gint64      tx_queue_length;
+    gint64      gso_max_size;
+    gint64      gso_max_segments;
+    gint64      gro_max_size;
+    gint64      rps_flow_count;
+    gint64      gso_ipv4_max_size;
+    gint64      gro_ipv4_max_size;
+    gint64      napi_threaded;
+    gint64      napi_defer_hard_irqs;
+    gint64      gro_flush_timeout;
 };
 
 struct _NMSettingLinkClass {
@@ -121,6 +147,472 @@ nm_setting_link_get_gro_max_size(NMSettingLink *setting)
     return setting->gro_max_size;
 }
 
+/**
+ * nm_setting_link_get_neighbors:
+ * @setting: the #NMSettingLink
+ * @length: (out) (optional): the length of the returned array.
+ *
+ * Returns: (transfer none) (array length=length): the %NULL terminated list
+ *   of static neighbor entries, as in the #NMSettingLink:neighbors property.
+ *
+ * Since: 1.58
+ **/
+const char *const *
+nm_setting_link_get_neighbors(NMSettingLink *setting, guint *length)
+{
+    g_return_val_if_fail(NM_IS_SETTING_LINK(setting), NULL);
+
+    return nm_strvarray_get_strv_notnull(setting->neighbors.arr, length);
+}
+
+/**
+ * nm_setting_link_add_neighbor:
+ * @setting: the #NMSettingLink
+ * @neighbor: the neighbor entry to add
+ *
+ * Adds a new neighbor entry to the #NMSettingLink:neighbors property.
+ *
+ * Since: 1.58
+ **/
+void
+nm_setting_link_add_neighbor(NMSettingLink *setting, const char *neighbor)
+{
+    g_return_if_fail(NM_IS_SETTING_LINK(setting));
+    g_return_if_fail(neighbor);
+
+    nm_strvarray_ensure_and_add(&setting->neighbors.arr, neighbor);
+    _notify(setting, PROP_NEIGHBORS);
+}
+
+/**
+ * nm_setting_link_remove_neighbor_by_value:
+ * @setting: the #NMSettingLink
+ * @neighbor: the neighbor entry to remove
+ *
+ * Removes @neighbor.
+ *
+ * Returns: %TRUE if the neighbor entry was found and removed; %FALSE if it was not.
+ *
+ * Since: 1.58
+ **/
+gboolean
+nm_setting_link_remove_neighbor_by_value(NMSettingLink *setting, const char *neighbor)
+{
+    g_return_val_if_fail(NM_IS_SETTING_LINK(setting), FALSE);
+    g_return_val_if_fail(neighbor, FALSE);
+
+    if (!nm_strvarray_remove_first(setting->neighbors.arr, neighbor))
+        return FALSE;
+
+    _notify(setting, PROP_NEIGHBORS);
+    return TRUE;
+}
+
+/**
+ * nm_setting_link_get_fdb_entries:
+ * @setting: the #NMSettingLink
+ * @length: (out) (optional): the length of the returned array.
+ *
+ * Returns: (transfer none) (array length=length): the %NULL terminated list
+ *   of static FDB entries, as in the #NMSettingLink:fdb-entries property.
+ *
+ * Since: 1.58
+ **/
+const char *const *
+nm_setting_link_get_fdb_entries(NMSettingLink *setting, guint *length)
+{
+    g_return_val_if_fail(NM_IS_SETTING_LINK(setting), NULL);
+
+    return nm_strvarray_get_strv_notnull(setting->fdb_entries.arr, length);
+}
+
+
+/**
+ * nm_setting_link_add_fdb_entry:
+ * @setting: the #NMSettingLink
+ * @fdb_entry: the FDB entry to add
+ *
+ * Adds a new FDB entry to the #NMSettingLink:fdb-entries property.
+ *
+ * Since: 1.58
+ **/
+void
+nm_setting_link_add_fdb_entry(NMSettingLink *setting, const char *fdb_entry)
+{
+    g_return_if_fail(NM_IS_SETTING_LINK(setting));
+    g_return_if_fail(fdb_entry);
+
+    nm_strvarray_ensure_and_add(&setting->fdb_entries.arr, fdb_entry);
+    _notify(setting, PROP_FDB_ENTRIES);
+}
+
+/**
+ * nm_setting_link_remove_fdb_entry_by_value:
+ * @setting: the #NMSettingLink
+ * @fdb_entry: the FDB entry to remove
+ *
+ * Removes @fdb_entry.
+ *
+ * Returns: %TRUE if the FDB entry was found and removed; %FALSE if it was not.
+ *
+ * Since: 1.58
+ **/
+gboolean
+nm_setting_link_remove_fdb_entry_by_value(NMSettingLink *setting, const char *fdb_entry)
+{
+    g_return_val_if_fail(NM_IS_SETTING_LINK(setting), FALSE);
+    g_return_val_if_fail(fdb_entry, FALSE);
+
+    if (!nm_strvarray_remove_first(setting->fdb_entries.arr, fdb_entry))
+        return FALSE;
+
+    _notify(setting, PROP_FDB_ENTRIES);
+    return TRUE;
+}
+
+/**
+ * nm_setting_link_get_rps_cpus:
+ * @setting: the #NMSettingLink
+ *
+ * Returns: the #NMSettingLink:rps-cpus property.
+ *
+ * Since: 1.58
+ **/
+const char *
+nm_setting_link_get_rps_cpus(NMSettingLink *setting)
+{
+    g_return_val_if_fail(NM_IS_SETTING_LINK(setting), NULL);
+
+    return setting->rps_cpus;
+}
+
+/**
+ * nm_setting_link_get_rps_flow_count:
+ * @setting: the #NMSettingLink
+ *
+ * Returns: the #NMSettingLink:rps-flow-count property.
+ *
+ * Since: 1.58
+ **/
+gint64
+nm_setting_link_get_rps_flow_count(NMSettingLink *setting)
+{
+    g_return_val_if_fail(NM_IS_SETTING_LINK(setting), -1);
+
+    return setting->rps_flow_count;
+}
+
+/**
+ * nm_setting_link_get_xps_cpus:
+ * @setting: the #NMSettingLink
+ *
+ * Returns: the #NMSettingLink:xps-cpus property.
+ *
+ * Since: 1.58
+ **/
+const char *
+nm_setting_link_get_xps_cpus(NMSettingLink *setting)
+{
+    g_return_val_if_fail(NM_IS_SETTING_LINK(setting), NULL);
+
+    return setting->xps_cpus;
+}
+
+/**
+ * nm_setting_link_get_irq_affinity:
+ * @setting: the #NMSettingLink
+ *
+ * Returns: the #NMSettingLink:irq-affinity property.
+ *
+ * Since: 1.58
+ **/
+const char *
+nm_setting_link_get_irq_affinity(NMSettingLink *setting)
+{
+    g_return_val_if_fail(NM_IS_SETTING_LINK(setting), NULL);
+
+    return setting->irq_affinity;
+}
+
+/**
+ * nm_setting_link_get_gso_ipv4_max_size:
+ * @setting: the #NMSettingLink
+ *
+ * Returns: the #NMSettingLink:gso-ipv4-max-size property.
+ *
+ * Since: 1.58
+ **/
+gint64
+nm_setting_link_get_gso_ipv4_max_size(NMSettingLink *setting)
+{
+    g_return_val_if_fail(NM_IS_SETTING_LINK(setting), -1);
+
+    return setting->gso_ipv4_max_size;
+}
+
+/**
+ * nm_setting_link_get_gro_ipv4_max_size:
+ * @setting: the #NMSettingLink
+ *
+ * Returns: the #NMSettingLink:gro-ipv4-max-size property.
+ *
+ * Since: 1.58
+ **/
+gint64
+nm_setting_link_get_gro_ipv4_max_size(NMSettingLink *setting)
+{
+    g_return_val_if_fail(NM_IS_SETTING_LINK(setting), -1);
+
+    return setting->gro_ipv4_max_size;
+}
+
+/**
+ * nm_setting_link_get_napi_threaded:
+ * @setting: the #NMSettingLink
+ *
+ * Returns: the #NMSettingLink:napi-threaded property.
+ *
+ * Since: 1.58
+ **/
+gint64
+nm_setting_link_get_napi_threaded(NMSettingLink *setting)
+{
+    g_return_val_if_fail(NM_IS_SETTING_LINK(setting), -1);
+
+    return setting->napi_threaded;
+}
+
+/**
+ * nm_setting_link_get_napi_defer_hard_irqs:
+ * @setting: the #NMSettingLink
+ *
+ * Returns: the #NMSettingLink:napi-defer-hard-irqs property.
+ *
+ * Since: 1.58
+ **/
+gint64
+nm_setting_link_get_napi_defer_hard_irqs(NMSettingLink *setting)
+{
+    g_return_val_if_fail(NM_IS_SETTING_LINK(setting), -1);
+
+    return setting->napi_defer_hard_irqs;
+}
+
+/**
+ * nm_setting_link_get_gro_flush_timeout:
+ * @setting: the #NMSettingLink
+ *
+ * Returns: the #NMSettingLink:gro-flush-timeout property.
+ *
+ * Since: 1.58
+ **/
+gint64
+nm_setting_link_get_gro_flush_timeout(NMSettingLink *setting)
+{
+    g_return_val_if_fail(NM_IS_SETTING_LINK(setting), -1);
+
+    return setting->gro_flush_timeout;
+}
+
+/**
+ * nm_setting_link_get_xdp_program:
+ * @setting: the #NMSettingLink
+ *
+ * Returns: the #NMSettingLink:xdp-program property.
+ *
+ * Since: 1.58
+ **/
+const char *
+nm_setting_link_get_xdp_program(NMSettingLink *setting)
+{
+    g_return_val_if_fail(NM_IS_SETTING_LINK(setting), NULL);
+
+    return setting->xdp_program;
+}
+
+/**
+ * nm_setting_link_get_xdp_mode:
+ * @setting: the #NMSettingLink
+ *
+ * Returns: the #NMSettingLink:xdp-mode property.
+ *
+ * Since: 1.58
+ **/
+const char *
+nm_setting_link_get_xdp_mode(NMSettingLink *setting)
+{
+    g_return_val_if_fail(NM_IS_SETTING_LINK(setting), NULL);
+
+    return setting->xdp_mode;
+}
+
+/*****************************************************************************/
+
+/**
+ * _nm_setting_link_parse_neigh:
+ * @str: the entry from #NMSettingLink:neighbors or #NMSettingLink:fdb-entries.
+ * @is_fdb: whether @str is a FDB entry.
+ * @out_dst_family: (out): the address family of @out_dst. AF_UNSPEC for FDB
+ *   entries without a destination.
+ * @out_dst: (out): the IP address.
+ * @out_lladdr: (out): the link layer address.
+ * @error: the error location.
+ *
+ * A neighbor entry has the form "IP LLADDR", a FDB entry the form
+ * "LLADDR [DST]".
+ */
+gboolean
+_nm_setting_link_parse_neigh(const char  *str,
+                             gboolean     is_fdb,
+                             int         *out_dst_family,
+                             NMIPAddr    *out_dst,
+                             NMEtherAddr *out_lladdr,
+                             GError     **error)
+{
+    gs_free const char **tokens = NULL;
+    const char          *s_dst;
+    const char          *s_lladdr;
+    guint                n;
+
+    tokens = nm_strsplit_set(str, " \t");
+    n      = NM_PTRARRAY_LEN(tokens);
+
+    if (is_fdb ? (n < 1 || n > 2) : n != 2) {
+        g_set_error(error,
+                    NM_CONNECTION_ERROR,
+                    NM_CONNECTION_ERROR_INVALID_PROPERTY,
+                    is_fdb ? _("'%s' is not of the form \"LLADDR [DST]\"")
+                           : _("'%s' is not of the form \"IP LLADDR\""),
+                    str ?: "");
+        return FALSE;
+    }
+
+    s_dst    = is_fdb ? tokens[1] : tokens[0];
+    s_lladdr = is_fdb ? tokens[0] : tokens[1];
+
+    if (!_nm_utils_hwaddr_aton_exact(s_lladdr, out_lladdr, sizeof(*out_lladdr))) {
+        g_set_error(error,
+                    NM_CONNECTION_ERROR,
+                    NM_CONNECTION_ERROR_INVALID_PROPERTY,
+                    _("invalid link layer address '%s'"),
+                    s_lladdr);
+        return FALSE;
+    }
+
+    *out_dst_family = AF_UNSPEC;
+    *out_dst        = nm_ip_addr_zero;
+    if (s_dst && !nm_inet_parse_bin(AF_UNSPEC, s_dst, out_dst_family, out_dst)) {
+        g_set_error(error,
+                    NM_CONNECTION_ERROR,
+                    NM_CONNECTION_ERROR_INVALID_PROPERTY,
+                    _("invalid IP address '%s'"),
+                    s_dst);
+        return FALSE;
+    }
+
+    return TRUE;
+}
+
+static gboolean
+verify(NMSetting *setting, NMConnection *connection, GError **error)
+{
+    NMSettingLink *self = NM_SETTING_LINK(setting);
+    guint          i;
+    guint          j;
+
+    for (j = 0; j < 2; j++) {
+        const GArray *arr = j == 0 ? self->neighbors.arr : self->fdb_entries.arr;
+
+        for (i = 0; arr && i < arr->len; i++) {
+            NMEtherAddr lladdr;
+            NMIPAddr    dst;
+            int         dst_family;
+
+            if (!_nm_setting_link_parse_neigh(nm_strvarray_get_idx(arr, i),
+                                              j == 1,
+                                              &dst_family,
+                                              &dst,
+                                              &lladdr,
+                                              error)) {
+                g_prefix_error(error,
+                               "%s.%s: ",
+                               NM_SETTING_LINK_SETTING_NAME,
+                               j == 0 ? NM_SETTING_LINK_NEIGHBORS : NM_SETTING_LINK_FDB_ENTRIES);
+                return FALSE;
+            }
+        }
+    }
+
+    for (j = 0; j < 3; j++) {
+        const char *prop_name;
+        const char *cpus;
+
+        if (j == 0) {
+            prop_name = NM_SETTING_LINK_RPS_CPUS;
+            cpus      = self->rps_cpus;
+        } else if (j == 1) {
+            prop_name = NM_SETTING_LINK_XPS_CPUS;
+            cpus      = self->xps_cpus;
+        } else {
+            prop_name = NM_SETTING_LINK_IRQ_AFFINITY;
+            cpus      = self->irq_affinity;
+        }
+
+        if (cpus && !nm_streq(cpus, "numa-local")) {
+            gs_unref_array GArray *arr = NULL;
+
+            arr = nm_utils_cpu_list_parse(cpus);
+            if (!arr) {
+                g_set_error(error,
+                            NM_CONNECTION_ERROR,
+                            NM_CONNECTION_ERROR_INVALID_PROPERTY,
+                            _("'%s' is neither a list of CPUs nor \"numa-local\""),
+                            cpus);
+                g_prefix_error(error, "%s.%s: ", NM_SETTING_LINK_SETTING_NAME, prop_name);
+                return FALSE;
+            }
+        }
+    }
+
+    if (self->xdp_program && self->xdp_program[0] != '/') {
+        g_set_error(error,
+                    NM_CONNECTION_ERROR,
+                    NM_CONNECTION_ERROR_INVALID_PROPERTY,
+                    _("'%s' is not an absolute path"),
+                    self->xdp_program);
+        g_prefix_error(error, "%s.%s: ", NM_SETTING_LINK_SETTING_NAME, NM_SETTING_LINK_XDP_PROGRAM);
+        return FALSE;
+    }
+
+    if (self->xdp_mode) {
+        if (!NM_IN_STRSET(self->xdp_mode, "native", "generic", "offload")) {
+            g_set_error(error,
+                        NM_CONNECTION_ERROR,
+                        NM_CONNECTION_ERROR_INVALID_PROPERTY,
+                        _("'%s' is not a valid XDP mode"),
+                        self->xdp_mode);
+            g_prefix_error(error,
+                           "%s.%s: ",
+                           NM_SETTING_LINK_SETTING_NAME,
+                           NM_SETTING_LINK_XDP_MODE);
+            return FALSE;
+        }
+        if (!self->xdp_program) {
+            g_set_error_literal(error,
+                                NM_CONNECTION_ERROR,
+                                NM_CONNECTION_ERROR_MISSING_PROPERTY,
+                                _("the XDP mode requires an XDP program"));
+            g_prefix_error(error,
+                           "%s.%s: ",
+                           NM_SETTING_LINK_SETTING_NAME,
+                           NM_SETTING_LINK_XDP_MODE);
+            return FALSE;
+        }
+    }
+
+    return TRUE;
+}
+
 /*****************************************************************************/
 
 static void
@@ -152,6 +644,8 @@ nm_setting_link_class_init(NMSettingLinkClass *klass)
     object_class->get_property = _nm_setting_property_get_property_direct;
     object_class->set_property = _nm_setting_property_set_property_direct;
 
+    setting_class->verify = verify;
+
     /**
      * NMSettingLink:tx-queue-length
      *
@@ -231,6 +725,257 @@ nm_setting_link_class_init(NMSettingLinkClass *klass)
                                              NMSettingLink,
                                              gro_max_size);
 
+    /**
+     * NMSettingLink:neighbors
+     *
+     * A list of static neighbor (ARP or NDP) entries for the interface. Each entry
+     * has the form "IP LLADDR", for example "192.0.2.5 00:11:22:33:44:55". The entries
+     * are permanent and get removed again when the connection goes down.
+     *
+     * Since: 1.58
+     **/
+    _nm_setting_property_define_direct_strv(properties_override,
+                                            obj_properties,
+                                            NM_SETTING_LINK_NEIGHBORS,
+                                            PROP_NEIGHBORS,
+                                            NM_SETTING_PARAM_NONE,
+                                            NULL,
+                                            NMSettingLink,
+                                            neighbors);
+
+    /**
+     * NMSettingLink:fdb-entries
+     *
+     * A list of static forwarding database entries, like "bridge fdb append ... self"
+     * configures them on a VXLAN device or a bridge port. Each entry has the form
+     * "LLADDR [DST]". The optional DST is the IP address of the remote VXLAN tunnel
+     * endpoint, for example "00:00:00:00:00:00 198.51.100.1" for flooding to a
+     * remote endpoint. The entries get removed again when the connection goes down.
+     *
+     * Since: 1.58
+     **/
+    _nm_setting_property_define_direct_strv(properties_override,
+                                            obj_properties,
+                                            NM_SETTING_LINK_FDB_ENTRIES,
+                                            PROP_FDB_ENTRIES,
+                                            NM_SETTING_PARAM_NONE,
+                                            NULL,
+                                            NMSettingLink,
+                                            fdb_entries);
+
+    /**
+     * NMSettingLink:rps-cpus
+     *
+     * The CPUs for Receive Packet Steering (RPS) on all receive queues of the device,
+     * as a list like "0-3,8". With "numa-local", the CPUs of the NUMA node of the
+     * device are used. When unset, the existing configuration is preserved.
+     *
+     * Since: 1.58
+     **/
+    _nm_setting_property_define_direct_string(properties_override,
+                                              obj_properties,
+                                              NM_SETTING_LINK_RPS_CPUS,
+                                              PROP_RPS_CPUS,
+                                              NM_SETTING_PARAM_NONE,
+                                              NMSettingLink,
+                                              rps_cpus);
+
+    /**
+     * NMSettingLink:rps-flow-count
+     *
+     * The number of entries of the Receive Flow Steering (RFS) flow table of each
+     * receive queue ("rps_flow_cnt"). The value must be between 0 and 4294967295.
+     * When set to -1, the existing value is preserved.
+     *
+     * Since: 1.58
+     **/
+    _nm_setting_property_define_direct_int64(properties_override,
+                                             obj_properties,
+                                             NM_SETTING_LINK_RPS_FLOW_COUNT,
+                                             PROP_RPS_FLOW_COUNT,
+                                             -1,
+                                             G_MAXUINT32,
+                                             -1,
+                                             NM_SETTING_PARAM_NONE,
+                                             NMSettingLink,
+                                             rps_flow_count);
+
+    /**
+     * NMSettingLink:xps-cpus
+     *
+     * The CPUs for Transmit Packet Steering (XPS), as a list like "0-3,8" or
+     * "numa-local". The transmit queues get one CPU each, in a round-robin
+     * fashion. When unset, the existing configuration is preserved.
+     *
+     * Since: 1.58
+     **/
+    _nm_setting_property_define_direct_string(properties_override,
+                                              obj_properties,
+                                              NM_SETTING_LINK_XPS_CPUS,
+                                              PROP_XPS_CPUS,
+                                              NM_SETTING_PARAM_NONE,
+                                              NMSettingLink,
+                                              xps_cpus);
+
+    /**
+     * NMSettingLink:irq-affinity
+     *
+     * The CPUs for the MSI interrupts of the device, as a list like "0-3,8" or
+     * "numa-local". The interrupts get one CPU each, in a round-robin fashion.
+     * When unset, the existing configuration is preserved.
+     *
+     * Since: 1.58
+     **/
+    _nm_setting_property_define_direct_string(properties_override,
+                                              obj_properties,
+                                              NM_SETTING_LINK_IRQ_AFFINITY,
+                                              PROP_IRQ_AFFINITY,
+                                              NM_SETTING_PARAM_NONE,
+                                              NMSettingLink,
+                                              irq_affinity);
+
+    /**
+     * NMSettingLink:gso-ipv4-max-size
+     *
+     * The maximum size of a Generic Segment Offload packet for IPv4 the device
+     * should accept. Values above 65536 enable BIG TCP for IPv4, which also
+     * needs a "gso-max-size" of the same size. The value must be between 0 and
+     * 4294967295. When set to -1, the existing value is preserved.
+     *
+     * Since: 1.58
+     **/
+    _nm_setting_property_define_direct_int64(properties_override,
+                                             obj_properties,
+                                             NM_SETTING_LINK_GSO_IPV4_MAX_SIZE,
+                                             PROP_GSO_IPV4_MAX_SIZE,
+                                             -1,
+                                             G_MAXUINT32,
+                                             -1,
+                                             NM_SETTING_PARAM_NONE,
+                                             NMSettingLink,
+                                             gso_ipv4_max_size);
+
+    /**
+     * NMSettingLink:gro-ipv4-max-size
+     *
+     * The maximum size of an IPv4 packet built by the Generic Receive Offload
+     * stack for this device. Values above 65536 enable BIG TCP for IPv4. The value
+     * must be between 0 and 4294967295. When set to -1, the existing value is
+     * preserved.
+     *
+     * Since: 1.58
+     **/
+    _nm_setting_property_define_direct_int64(properties_override,
+                                             obj_properties,
+                                             NM_SETTING_LINK_GRO_IPV4_MAX_SIZE,
+                                             PROP_GRO_IPV4_MAX_SIZE,
+                                             -1,
+                                             G_MAXUINT32,
+                                             -1,
+                                             NM_SETTING_PARAM_NONE,
+                                             NMSettingLink,
+                                             gro_ipv4_max_size);
+
+    /**
+     * NMSettingLink:napi-threaded
+     *
+     * Whether the NAPI polling of the device runs in its own kernel threads instead of
+     * the softirq context ("threaded" in sysfs). Set to 0 to disable and to 1 to
+     * enable it. When set to -1, the existing value is preserved.
+     *
+     * Since: 1.58
+     **/
+    _nm_setting_property_define_direct_int64(properties_override,
+                                             obj_properties,
+                                             NM_SETTING_LINK_NAPI_THREADED,
+                                             PROP_NAPI_THREADED,
+                                             -1,
+                                             1,
+                                             -1,
+                                             NM_SETTING_PARAM_NONE,
+                                             NMSettingLink,
+                                             napi_threaded);
+
+    /**
+     * NMSettingLink:napi-defer-hard-irqs
+     *
+     * How many times the NAPI polling may find no packets before the device interrupts
+     * get enabled again ("napi_defer_hard_irqs" in sysfs). Together with
+     * "gro-flush-timeout", this keeps the interrupts masked for busy polling
+     * applications. The value must be between 0 and 2147483647. When set to -1, the
+     * existing value is preserved.
+     *
+     * Since: 1.58
+     **/
+    _nm_setting_property_define_direct_int64(properties_override,
+                                             obj_properties,
+                                             NM_SETTING_LINK_NAPI_DEFER_HARD_IRQS,
+                                             PROP_NAPI_DEFER_HARD_IRQS,
+                                             -1,
+                                             G_MAXINT32,
+                                             -1,
+                                             NM_SETTING_PARAM_NONE,
+                                             NMSettingLink,
+                                             napi_defer_hard_irqs);
+
+    /**
+     * NMSettingLink:gro-flush-timeout
+     *
+     * The timeout in nanoseconds after which the Generic Receive Offload packets get
+     * flushed and deferred interrupts get enabled again ("gro_flush_timeout" in
+     * sysfs). The value must be between 0 and 4294967295. When set to -1, the existing
+     * value is preserved.
+     *
+     * Since: 1.58
+     **/
+    _nm_setting_property_define_direct_int64(properties_override,
+                                             obj_properties,
+                                             NM_SETTING_LINK_GRO_FLUSH_TIMEOUT,
+                                             PROP_GRO_FLUSH_TIMEOUT,
+                                             -1,
+                                             G_MAXUINT32,
+                                             -1,
+                                             NM_SETTING_PARAM_NONE,
+                                             NMSettingLink,
+                                             gro_flush_timeout);
+
+    /**
+     * NMSettingLink:xdp-program
+     *
+     * The absolute path of an XDP program pinned in the BPF filesystem, for example
+     * "/sys/fs/bpf/xdp_filter". The program gets attached to the device after the
+     * ethtool channels and rings are configured, attached again when the driver
+     * loses it, for example after a reset, and detached when the connection goes
+     * down. When unset, the XDP configuration of the device is preserved.
+     *
+     * Since: 1.58
+     **/
+    _nm_setting_property_define_direct_string(properties_override,
+                                              obj_properties,
+                                              NM_SETTING_LINK_XDP_PROGRAM,
+                                              PROP_XDP_PROGRAM,
+                                              NM_SETTING_PARAM_NONE,
+                                              NMSettingLink,
+                                              xdp_program);
+
+    /**
+     * NMSettingLink:xdp-mode
+     *
+     * The mode for attaching the "xdp-program": "native" in the driver, "generic"
+     * in the network stack or "offload" to the hardware. When unset, the kernel
+     * uses the native mode if the driver supports it and the generic mode
+     * otherwise.
+     *
+     * Since: 1.58
+     **/
+    _nm_setting_property_define_direct_string(properties_override,
+                                              obj_properties,
+                                              NM_SETTING_LINK_XDP_MODE,
+                                              PROP_XDP_MODE,
+                                              NM_SETTING_PARAM_NONE,
+                                              NMSettingLink,
+                                              xdp_mode);
+
     g_object_class_install_properties(object_class, _PROPERTY_ENUMS_LAST, obj_properties);
 
     _nm_setting_class_commit(setting_class,
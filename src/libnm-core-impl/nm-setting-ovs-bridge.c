@@ -243,6 +243,7 @@ nm_setting_ovs_bridge_class_init(NMSettingOvsBridgeClass *klass)
                                               NM_SETTING_PARAM_INFERRABLE,
                                               NMSettingOvsBridge,
                                               fail_mode,
+                                              .direct_string_is_refstr   = TRUE,
                                               .direct_string_allow_empty = TRUE);
 
     /**
@@ -307,6 +308,7 @@ nm_setting_ovs_bridge_class_init(NMSettingOvsBridgeClass *klass)
                                               NM_SETTING_PARAM_INFERRABLE,
                                               NMSettingOvsBridge,
                                               datapath_type,
+                                              .direct_string_is_refstr   = TRUE,
                                               .direct_string_allow_empty = TRUE);
 
     g_object_class_install_properties(object_class, _PROPERTY_ENUMS_LAST, obj_properties);
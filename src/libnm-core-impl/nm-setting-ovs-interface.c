@@ -395,6 +395,7 @@ nm_setting_ovs_interface_class_init(NMSettingOvsInterfaceClass *klass)
                                               NM_SETTING_PARAM_INFERRABLE,
                                               NMSettingOvsInterface,
                                               type,
+                                              .direct_string_is_refstr   = TRUE,
                                               .direct_string_allow_empty = TRUE);
     /**
      * NMSettingOvsInterface:ofport-request:
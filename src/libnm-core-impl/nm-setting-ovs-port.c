@@ -615,6 +615,7 @@ nm_setting_ovs_port_class_init(NMSettingOvsPortClass *klass)
                                               NM_SETTING_PARAM_INFERRABLE,
                                               NMSettingOvsPort,
                                               vlan_mode,
+                                              .direct_string_is_refstr   = TRUE,
                                               .direct_string_allow_empty = TRUE);
 
     /**
@@ -674,6 +675,7 @@ nm_setting_ovs_port_class_init(NMSettingOvsPortClass *klass)
                                               NM_SETTING_PARAM_INFERRABLE,
                                               NMSettingOvsPort,
                                               lacp,
+                                              .direct_string_is_refstr   = TRUE,
                                               .direct_string_allow_empty = TRUE);
 
     /**
@@ -30,6 +30,8 @@ typedef struct {
 
 struct _NMRefString;
 
+#define _NM_CONNECTION_DBUS_CACHE_SIZE 4
+
 typedef struct {
     NMConnection *self;
 
@@ -37,6 +39,18 @@ typedef struct {
 
     /* D-Bus path of the connection, if any */
     struct _NMRefString *path;
+
+    /* Whether the last _nm_connection_verify() returned NM_SETTING_VERIFY_SUCCESS
+     * and the connection was not modified since. Any change to the settings
+     * clears the flag again. */
+    bool verify_success : 1;
+
+    /* The results of _nm_connection_to_dbus_cached(), one per serialization
+     * flags. Like @verify_success, they are dropped on any change. */
+    struct {
+        GVariant                      *variant;
+        NMConnectionSerializationFlags flags;
+    } dbus_cache[_NM_CONNECTION_DBUS_CACHE_SIZE];
 } NMConnectionPrivate;
 
 extern GTypeClass *_nm_simple_connection_class_instance;
@@ -427,6 +441,8 @@ _nm_setting_connection_autoconnect_ports_to_dbus(_NM_SETT_INFO_PROP_TO_DBUS_FCN_
 gboolean
 _nm_setting_connection_autoconnect_ports_from_dbus(_NM_SETT_INFO_PROP_FROM_DBUS_FCN_ARGS _nm_nil);
 
+GVariant *_nm_setting_connection_timestamp_to_dbus(_NM_SETT_INFO_PROP_TO_DBUS_FCN_ARGS _nm_nil);
+
 gboolean _nm_setting_wireless_mac_denylist_from_dbus(_NM_SETT_INFO_PROP_FROM_DBUS_FCN_ARGS _nm_nil);
 
 GVariant *_nm_setting_wireless_mac_denylist_to_dbus(_NM_SETT_INFO_PROP_TO_DBUS_FCN_ARGS _nm_nil);
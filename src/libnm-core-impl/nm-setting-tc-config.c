@@ -1266,6 +1266,65 @@ nm_setting_tc_config_clear_tfilters(NMSettingTCConfig *self)
 
 /*****************************************************************************/
 
+static gboolean
+_verify_mqprio(NMTCQdisc *qdisc, GError **error)
+{
+    gs_free_error GError *local  = NULL;
+    guint                 num_tc = 0;
+    GVariant             *variant;
+    guint8                map[TC_QOPT_BITMASK + 1];
+    guint16               count[TC_QOPT_MAX_QUEUE];
+    guint16               offset[TC_QOPT_MAX_QUEUE];
+
+    variant = nm_tc_qdisc_get_attribute(qdisc, "num_tc");
+    if (variant && g_variant_is_of_type(variant, G_VARIANT_TYPE_UINT32))
+        num_tc = g_variant_get_uint32(variant);
+    if (num_tc == 0 || num_tc > TC_QOPT_MAX_QUEUE) {
+        g_set_error(error,
+                    NM_CONNECTION_ERROR,
+                    NM_CONNECTION_ERROR_INVALID_PROPERTY,
+                    _("mqprio requires num_tc between 1 and %u"),
+                    TC_QOPT_MAX_QUEUE);
+        return FALSE;
+    }
+
+    variant = nm_tc_qdisc_get_attribute(qdisc, "map");
+    if (variant && g_variant_is_of_type(variant, G_VARIANT_TYPE_STRING)
+        && !_nm_utils_tc_parse_mqprio_map(g_variant_get_string(variant, NULL),
+                                          num_tc,
+                                          map,
+                                          &local))
+        goto fail;
+
+    variant = nm_tc_qdisc_get_attribute(qdisc, "queues");
+    if (variant && g_variant_is_of_type(variant, G_VARIANT_TYPE_STRING)
+        && !_nm_utils_tc_parse_mqprio_queues(g_variant_get_string(variant, NULL),
+                                             num_tc,
+                                             count,
+                                             offset,
+                                             &local))
+        goto fail;
+
+    variant = nm_tc_qdisc_get_attribute(qdisc, "mode");
+    if (variant && g_variant_is_of_type(variant, G_VARIANT_TYPE_STRING)
+        && !NM_IN_STRSET(g_variant_get_string(variant, NULL), "dcb", "channel")) {
+        g_set_error_literal(error,
+                            NM_CONNECTION_ERROR,
+                            NM_CONNECTION_ERROR_INVALID_PROPERTY,
+                            _("mqprio mode must be 'dcb' or 'channel'"));
+        return FALSE;
+    }
+
+    return TRUE;
+
+fail:
+    g_set_error_literal(error,
+                        NM_CONNECTION_ERROR,
+                        NM_CONNECTION_ERROR_INVALID_PROPERTY,
+                        local->message);
+    return FALSE;
+}
+
 static gboolean
 verify(NMSetting *setting, NMConnection *connection, GError **error)
 {
@@ -1291,6 +1350,33 @@ verify(NMSetting *setting, NMConnection *connection, GError **error)
         }
     }
 
+    for (i = 0; i < self->qdiscs->len; i++) {
+        NMTCQdisc *qdisc = self->qdiscs->pdata[i];
+        guint      j;
+
+        if (nm_streq(nm_tc_qdisc_get_kind(qdisc), "mqprio") && !_verify_mqprio(qdisc, error))
+            goto fail_qdisc;
+
+        /* A qdisc attached to a "mq" or "mqprio" qdisc (and not to one of
+         * its classes) is a template for the qdisc of each hardware queue.
+         * The kernel picks the handles of these. */
+        if (nm_tc_qdisc_get_handle(qdisc) == TC_H_UNSPEC
+            || TC_H_MIN(nm_tc_qdisc_get_parent(qdisc)) != 0)
+            continue;
+        for (j = 0; j < self->qdiscs->len; j++) {
+            NMTCQdisc *other = self->qdiscs->pdata[j];
+
+            if (nm_tc_qdisc_get_handle(other) == nm_tc_qdisc_get_parent(qdisc)
+                && NM_IN_STRSET(nm_tc_qdisc_get_kind(other), "mq", "mqprio")) {
+                g_set_error_literal(error,
+                                    NM_CONNECTION_ERROR,
+                                    NM_CONNECTION_ERROR_INVALID_PROPERTY,
+                                    _("a qdisc for each hardware queue can't have a handle"));
+                goto fail_qdisc;
+            }
+        }
+    }
+
     if (self->tfilters->len != 0) {
         gs_unref_hashtable GHashTable *ht = NULL;
 
@@ -1311,6 +1397,13 @@ verify(NMSetting *setting, NMConnection *connection, GError **error)
     }
 
     return TRUE;
+
+fail_qdisc:
+    g_prefix_error(error,
+                   "%s.%s: ",
+                   NM_SETTING_TC_CONFIG_SETTING_NAME,
+                   NM_SETTING_TC_CONFIG_QDISCS);
+    return FALSE;
 }
 
 static NMTernary
@@ -1790,6 +1883,10 @@ nm_setting_tc_config_class_init(NMSettingTCConfigClass *klass)
      *
      * If the #NMSettingTCConfig setting is not present, NetworkManager
      * doesn't touch the qdiscs present on the interface.
+     *
+     * Since 1.58, a qdisc whose parent is the handle of a "mq" or "mqprio"
+     * qdisc (and not one of its classes) is added once for each hardware
+     * transmit queue of the device. Such a qdisc can't have a handle.
      **/
     /* ---nmcli---
      * property: qdiscs
@@ -1800,6 +1897,9 @@ nm_setting_tc_config_class_init(NMSettingTCConfigClass *klass)
      *   the default qdisc assigned by kernel according to the
      *   "net.core.default_qdisc" sysctl. If the "tc" setting is not present,
      *   NetworkManager doesn't touch the qdiscs present on the interface.
+     *   A qdisc whose parent is the handle of a "mq" or "mqprio" qdisc (and not
+     *   one of its classes) is added once for each hardware transmit queue of
+     *   the device. Such a qdisc can't have a handle.
      * description-docbook:
      *  <para>
      *  Array of TC queueing disciplines. qdisc is a basic block in the
@@ -1825,7 +1925,10 @@ nm_setting_tc_config_class_init(NMSettingTCConfigClass *klass)
      *      <listitem>
      *        <para>
      *          specifies the handle of the parent qdisc the current qdisc must be
-     *          attached to.
+     *          attached to. If the parent is a 'mq' or 'mqprio' qdisc, like
+     *          'parent 1:', the qdisc is added once for each hardware transmit
+     *          queue of the device, and the kernel chooses their handles. The
+     *          number of queues follows the ethtool channels.
      *        </para>
      *      </listitem>
      *    </varlistentry>
@@ -1842,9 +1945,9 @@ nm_setting_tc_config_class_init(NMSettingTCConfigClass *klass)
      *      <listitem>
      *        <para>
      *          this is the qdisc kind. NetworkManager currently supports the
-     *          following kinds: fq_codel, sfq, tbf. Each qdisc kind has a
-     *          different set of parameters, described below. There are also some
-     *          kinds like pfifo, pfifo_fast, prio supported by NetworkManager
+     *          following kinds: fq, fq_codel, mqprio, sfq, tbf. Each qdisc kind
+     *          has a different set of parameters, described below. There are also
+     *          some kinds like mq, pfifo, pfifo_fast, prio supported by NetworkManager
      *          but their parameters are not supported by NetworkManager.
      *        </para>
      *      </listitem>
@@ -1941,6 +2044,106 @@ nm_setting_tc_config_class_init(NMSettingTCConfigClass *klass)
      *    </varlistentry>
      *  </variablelist>
      *  <para>
+     *   Parameters for 'fq':
+     *  </para>
+     *  <variablelist>
+     *    <varlistentry>
+     *      <term><varname>limit U32</varname></term>
+     *      <listitem>
+     *        <para>
+     *     the hard limit on the queue size, in packets.
+     *        </para>
+     *      </listitem>
+     *    </varlistentry>
+     *    <varlistentry>
+     *      <term><varname>flow_limit U32</varname></term>
+     *      <listitem>
+     *        <para>
+     *     the hard limit on the number of queued packets of a flow.
+     *        </para>
+     *      </listitem>
+     *    </varlistentry>
+     *    <varlistentry>
+     *      <term><varname>quantum U32</varname></term>
+     *      <listitem>
+     *        <para>
+     *     the credit per dequeue round of a flow, in bytes.
+     *        </para>
+     *      </listitem>
+     *    </varlistentry>
+     *    <varlistentry>
+     *      <term><varname>initial_quantum U32</varname></term>
+     *      <listitem>
+     *        <para>
+     *     the credit of a new flow, in bytes.
+     *        </para>
+     *      </listitem>
+     *    </varlistentry>
+     *    <varlistentry>
+     *      <term><varname>maxrate U32</varname></term>
+     *      <listitem>
+     *        <para>
+     *     the maximum pacing rate of a flow, in bytes per second.
+     *        </para>
+     *      </listitem>
+     *    </varlistentry>
+     *    <varlistentry>
+     *      <term><varname>nopacing</varname></term>
+     *      <listitem>
+     *        <para>
+     *     disables the pacing of flows.
+     *        </para>
+     *      </listitem>
+     *    </varlistentry>
+     *  </variablelist>
+     *  <para>
+     *   Parameters for 'mqprio':
+     *  </para>
+     *  <variablelist>
+     *    <varlistentry>
+     *      <term><varname>num_tc U32</varname></term>
+     *      <listitem>
+     *        <para>
+     *     the number of traffic classes, between 1 and 16. Required.
+     *        </para>
+     *      </listitem>
+     *    </varlistentry>
+     *    <varlistentry>
+     *      <term><varname>map STRING</varname></term>
+     *      <listitem>
+     *        <para>
+     *     the comma separated traffic classes of the priorities 0 to 15,
+     *     like '0,0,0,1'. Missing priorities use traffic class 0.
+     *        </para>
+     *      </listitem>
+     *    </varlistentry>
+     *    <varlistentry>
+     *      <term><varname>queues STRING</varname></term>
+     *      <listitem>
+     *        <para>
+     *     the comma separated queue ranges of the traffic classes, as
+     *     count@offset, like '2@0,2@2'.
+     *        </para>
+     *      </listitem>
+     *    </varlistentry>
+     *    <varlistentry>
+     *      <term><varname>hw U32</varname></term>
+     *      <listitem>
+     *        <para>
+     *     1 to offload the configuration to the hardware, 0 to not.
+     *        </para>
+     *      </listitem>
+     *    </varlistentry>
+     *    <varlistentry>
+     *      <term><varname>mode STRING</varname></term>
+     *      <listitem>
+     *        <para>
+     *     the offload mode, 'dcb' or 'channel'.
+     *        </para>
+     *      </listitem>
+     *    </varlistentry>
+     *  </variablelist>
+     *  <para>
      *   Parameters for 'sfq':
      *  </para>
      *  <variablelist>
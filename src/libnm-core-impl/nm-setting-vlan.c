@@ -703,18 +703,17 @@ verify(NMSetting *setting, NMConnection *connection, GError **error)
     return TRUE;
 }
 
-static GVariant *
-vlan_flags_to_dbus(_NM_SETT_INFO_PROP_TO_DBUS_FCN_ARGS _nm_nil)
-{
-    return g_variant_new_uint32(nm_setting_vlan_get_flags((NMSettingVlan *) setting));
-}
-
 static gboolean
 vlan_flags_missing_from_dbus(_NM_SETT_INFO_PROP_MISSING_FROM_DBUS_FCN_ARGS _nm_nil)
 {
+    NMSettingVlanPrivate *priv = NM_SETTING_VLAN_GET_PRIVATE(setting);
+
     /* we changed the default value for FLAGS. When an older client
      * doesn't serialize the property, we assume it is the old default. */
-    g_object_set(G_OBJECT(setting), NM_SETTING_VLAN_FLAGS, (NMVlanFlags) 0, NULL);
+    if (priv->flags != 0) {
+        priv->flags = 0;
+        _notify((NMSettingVlan *) setting, PROP_FLAGS);
+    }
     return TRUE;
 }
 
@@ -763,9 +762,6 @@ get_property(GObject *object, guint prop_id, GValue *value, GParamSpec *pspec)
     NMSettingVlanPrivate *priv    = NM_SETTING_VLAN_GET_PRIVATE(setting);
 
     switch (prop_id) {
-    case PROP_FLAGS:
-        g_value_set_flags(value, priv->flags);
-        break;
     case PROP_INGRESS_PRIORITY_MAP:
         g_value_take_boxed(value, priority_maplist_to_strv(priv->ingress_priority_map));
         break;
@@ -785,9 +781,6 @@ set_property(GObject *object, guint prop_id, const GValue *value, GParamSpec *ps
     NMSettingVlanPrivate *priv    = NM_SETTING_VLAN_GET_PRIVATE(setting);
 
     switch (prop_id) {
-    case PROP_FLAGS:
-        priv->flags = g_value_get_flags(value);
-        break;
     case PROP_INGRESS_PRIORITY_MAP:
         g_slist_free_full(priv->ingress_priority_map, g_free);
         priv->ingress_priority_map =
@@ -808,11 +801,7 @@ set_property(GObject *object, guint prop_id, const GValue *value, GParamSpec *ps
 
 static void
 nm_setting_vlan_init(NMSettingVlan *self)
-{
-    NMSettingVlanPrivate *priv = NM_SETTING_VLAN_GET_PRIVATE(self);
-
-    priv->flags = NM_VLAN_FLAG_REORDER_HEADERS;
-}
+{}
 
 /**
  * nm_setting_vlan_new:
@@ -928,17 +917,22 @@ nm_setting_vlan_class_init(NMSettingVlanClass *klass)
                                                     "",
                                                     NM_TYPE_VLAN_FLAGS,
                                                     NM_VLAN_FLAG_REORDER_HEADERS,
-                                                    G_PARAM_READWRITE | NM_SETTING_PARAM_INFERRABLE
+                                                    G_PARAM_READWRITE | G_PARAM_EXPLICIT_NOTIFY
+                                                        | NM_SETTING_PARAM_INFERRABLE
                                                         | G_PARAM_STATIC_STRINGS);
     _nm_properties_override_gobj(
         properties_override,
         obj_properties[PROP_FLAGS],
         NM_SETT_INFO_PROPERT_TYPE_DBUS(G_VARIANT_TYPE_UINT32,
-                                       .to_dbus_fcn = vlan_flags_to_dbus,
-                                       .compare_fcn = _nm_setting_property_compare_fcn_default,
+                                       .direct_type = NM_VALUE_TYPE_FLAGS,
+                                       .compare_fcn = _nm_setting_property_compare_fcn_direct,
+                                       .to_dbus_fcn = _nm_setting_property_to_dbus_fcn_direct,
                                        .missing_from_dbus_fcn = vlan_flags_missing_from_dbus,
-                                       .from_dbus_fcn = _nm_setting_property_from_dbus_fcn_gprop,
-                                       .from_dbus_is_full = TRUE));
+                                       .from_dbus_fcn = _nm_setting_property_from_dbus_fcn_direct,
+                                       .from_dbus_is_full                = TRUE,
+                                       .from_dbus_direct_allow_transform = TRUE),
+        .direct_offset = NM_STRUCT_OFFSET_ENSURE_TYPE(guint, NMSettingVlanPrivate, flags),
+        .to_dbus_including_default = TRUE);
 
     /**
      * NMSettingVlan:protocol:
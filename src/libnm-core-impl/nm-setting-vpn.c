@@ -1140,6 +1140,7 @@ nm_setting_vpn_class_init(NMSettingVpnClass *klass)
                                               NM_SETTING_PARAM_NONE,
                                               NMSettingVpnPrivate,
                                               service_type,
+                                              .direct_string_is_refstr   = TRUE,
                                               .direct_string_allow_empty = TRUE);
 
     /**
@@ -1359,6 +1359,7 @@ nm_setting_wired_class_init(NMSettingWiredClass *klass)
                                               NM_SETTING_PARAM_NONE,
                                               NMSettingWiredPrivate,
                                               port,
+                                              .direct_string_is_refstr   = TRUE,
                                               .direct_string_allow_empty = TRUE);
 
     /**
@@ -1426,6 +1427,7 @@ nm_setting_wired_class_init(NMSettingWiredClass *klass)
                                               NM_SETTING_PARAM_NONE,
                                               NMSettingWiredPrivate,
                                               duplex,
+                                              .direct_string_is_refstr   = TRUE,
                                               .direct_string_allow_empty = TRUE);
 
     /**
@@ -62,26 +62,26 @@ NM_GOBJECT_PROPERTIES_DEFINE(NMSettingWirelessSecurity,
                              PROP_FILS, );
 
 typedef struct {
-    GSList      *proto;    /* GSList of strings */
-    GSList      *pairwise; /* GSList of strings */
-    GSList      *group;    /* GSList of strings */
-    char        *key_mgmt;
-    char        *auth_alg;
-    char        *leap_username;
-    char        *leap_password;
-    char        *wep_key0;
-    char        *wep_key1;
-    char        *wep_key2;
-    char        *wep_key3;
-    char        *psk;
-    guint        leap_password_flags;
-    guint        wep_key_flags;
-    guint        psk_flags;
-    NMWepKeyType wep_key_type;
-    gint32       pmf;
-    gint32       fils;
-    guint32      wep_tx_keyidx;
-    guint32      wps_method;
+    GSList *proto;    /* GSList of strings */
+    GSList *pairwise; /* GSList of strings */
+    GSList *group;    /* GSList of strings */
+    char   *key_mgmt;
+    char   *auth_alg;
+    char   *leap_username;
+    char   *leap_password;
+    char   *wep_key0;
+    char   *wep_key1;
+    char   *wep_key2;
+    char   *wep_key3;
+    char   *psk;
+    guint   leap_password_flags;
+    guint   wep_key_flags;
+    guint   psk_flags;
+    int     wep_key_type;
+    gint32  pmf;
+    gint32  fils;
+    guint32 wep_tx_keyidx;
+    guint32 wps_method;
 } NMSettingWirelessSecurityPrivate;
 
 /**
@@ -1273,23 +1273,6 @@ set_secret_flags(NMSetting           *setting,
         ->set_secret_flags(setting, secret_name, flags, error);
 }
 
-static GVariant *
-wep_key_type_to_dbus(_NM_SETT_INFO_PROP_TO_DBUS_FCN_ARGS _nm_nil)
-{
-    NMWepKeyType t;
-
-    t = nm_setting_wireless_security_get_wep_key_type(NM_SETTING_WIRELESS_SECURITY(setting));
-    if (t == NM_WEP_KEY_TYPE_UNKNOWN)
-        return NULL;
-
-    /* NMSettingWirelessSecurity:wep-key-type is an enum, but needs to be marshalled
-     * as 'u', not 'i', for backward-compatibility.
-     */
-    return g_variant_new_uint32(t);
-}
-
-/*****************************************************************************/
-
 static void
 get_property(GObject *object, guint prop_id, GValue *value, GParamSpec *pspec)
 {
@@ -1306,9 +1289,6 @@ get_property(GObject *object, guint prop_id, GValue *value, GParamSpec *pspec)
     case PROP_GROUP:
         g_value_take_boxed(value, _nm_utils_slist_to_strv(priv->group, TRUE));
         break;
-    case PROP_WEP_KEY_TYPE:
-        g_value_set_enum(value, priv->wep_key_type);
-        break;
     default:
         _nm_setting_property_get_property_direct(object, prop_id, value, pspec);
         break;
@@ -1334,9 +1314,6 @@ set_property(GObject *object, guint prop_id, const GValue *value, GParamSpec *ps
         g_slist_free_full(priv->group, g_free);
         priv->group = nm_strv_to_gslist(g_value_get_boxed(value), TRUE);
         break;
-    case PROP_WEP_KEY_TYPE:
-        priv->wep_key_type = g_value_get_enum(value);
-        break;
     default:
         _nm_setting_property_set_property_direct(object, prop_id, value, pspec);
         break;
@@ -1809,21 +1786,25 @@ nm_setting_wireless_security_class_init(NMSettingWirelessSecurityClass *klass)
      * example: KEY1=s:ahoj, KEY1=0a1c45bc02, KEY_PASSPHRASE1=mysupersecretkey
      * ---end---
      */
-    obj_properties[PROP_WEP_KEY_TYPE] =
-        g_param_spec_enum(NM_SETTING_WIRELESS_SECURITY_WEP_KEY_TYPE,
-                          "",
-                          "",
-                          NM_TYPE_WEP_KEY_TYPE,
-                          NM_WEP_KEY_TYPE_UNKNOWN,
-                          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS);
-    _nm_properties_override_gobj(
+    /* NMSettingWirelessSecurity:wep-key-type is an enum, but needs to be marshalled
+     * as 'u', not 'i', for backward-compatibility. */
+    _nm_setting_property_define_direct_real_enum(
         properties_override,
-        obj_properties[PROP_WEP_KEY_TYPE],
+        obj_properties,
+        NM_SETTING_WIRELESS_SECURITY_WEP_KEY_TYPE,
+        PROP_WEP_KEY_TYPE,
+        NM_TYPE_WEP_KEY_TYPE,
+        NM_WEP_KEY_TYPE_UNKNOWN,
+        NM_SETTING_PARAM_NONE,
         NM_SETT_INFO_PROPERT_TYPE_DBUS(G_VARIANT_TYPE_UINT32,
-                                       .to_dbus_fcn   = wep_key_type_to_dbus,
-                                       .compare_fcn   = _nm_setting_property_compare_fcn_default,
-                                       .from_dbus_fcn = _nm_setting_property_from_dbus_fcn_gprop,
-                                       .from_dbus_is_full = TRUE));
+                                       .direct_type   = NM_VALUE_TYPE_ENUM,
+                                       .compare_fcn   = _nm_setting_property_compare_fcn_direct,
+                                       .to_dbus_fcn   = _nm_setting_property_to_dbus_fcn_direct,
+                                       .from_dbus_fcn = _nm_setting_property_from_dbus_fcn_direct,
+                                       .from_dbus_is_full                = TRUE,
+                                       .from_dbus_direct_allow_transform = TRUE),
+        NMSettingWirelessSecurityPrivate,
+        wep_key_type);
 
     /**
      * NMSettingWirelessSecurity:wps-method:
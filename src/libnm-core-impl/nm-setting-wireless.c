@@ -1631,6 +1631,7 @@ nm_setting_wireless_class_init(NMSettingWirelessClass *klass)
                                               NM_SETTING_PARAM_NONE,
                                               NMSettingWirelessPrivate,
                                               mode,
+                                              .direct_string_is_refstr   = TRUE,
                                               .direct_string_allow_empty = TRUE);
 
     /**
@@ -1659,6 +1660,7 @@ nm_setting_wireless_class_init(NMSettingWirelessClass *klass)
                                               NM_SETTING_PARAM_NONE,
                                               NMSettingWirelessPrivate,
                                               band,
+                                              .direct_string_is_refstr   = TRUE,
                                               .direct_string_allow_empty = TRUE);
 
     /**
@@ -325,6 +325,33 @@ _property_lookup_by_param_spec_sort(gconstpointer p_a, gconstpointer p_b, gpoint
     return 0;
 }
 
+static void
+_property_lookup_by_name_init(NMSettInfoSetting *sett_info)
+{
+    guint16 *table;
+    guint    n_slots;
+    guint16  j;
+
+    /* Keep the load factor at or below 50%, so that the probe sequences
+     * stay short. */
+    n_slots = 4;
+    while (n_slots < 2u * sett_info->property_infos_len)
+        n_slots *= 2;
+    nm_assert(n_slots - 1u <= G_MAXUINT16);
+
+    table = g_new0(guint16, n_slots);
+    for (j = 0; j < sett_info->property_infos_len; j++) {
+        guint h = nm_str_hash(sett_info->property_infos[j].name) & (n_slots - 1u);
+
+        while (table[h] != 0)
+            h = (h + 1u) & (n_slots - 1u);
+        table[h] = j + 1u;
+    }
+
+    sett_info->property_lookup_by_name      = table;
+    sett_info->property_lookup_by_name_mask = n_slots - 1u;
+}
+
 void
 _nm_setting_class_commit(NMSettingClass             *setting_class,
                          NMMetaSettingType           meta_type,
@@ -458,6 +485,8 @@ _nm_setting_class_commit(NMSettingClass             *setting_class,
                       _property_lookup_by_param_spec_sort,
                       NULL);
 
+    _property_lookup_by_name_init(sett_info);
+
     g_array_free(properties_override, TRUE);
 }
 
@@ -466,31 +495,28 @@ _nm_sett_info_setting_get_property_info(const NMSettInfoSetting *sett_info,
                                         const char              *property_name)
 {
     const NMSettInfoProperty *property_info;
-    gssize                    idx;
+    guint                     h;
+    guint16                   idx;
 
     nm_assert(property_name);
 
     if (!sett_info)
         return NULL;
 
-    G_STATIC_ASSERT_EXPR(G_STRUCT_OFFSET(NMSettInfoProperty, name) == 0);
-    idx = nm_array_find_bsearch(sett_info->property_infos,
-                                sett_info->property_infos_len,
-                                sizeof(NMSettInfoProperty),
-                                &property_name,
-                                nm_strcmp_p_with_data,
-                                NULL);
-
-    if (idx < 0)
-        return NULL;
-
-    property_info = &sett_info->property_infos[idx];
+    nm_assert(sett_info->property_lookup_by_name);
 
-    nm_assert(idx == 0 || strcmp(property_info[-1].name, property_info[0].name) < 0);
-    nm_assert(idx == sett_info->property_infos_len - 1
-              || strcmp(property_info[0].name, property_info[1].name) < 0);
+    h = nm_str_hash(property_name) & sett_info->property_lookup_by_name_mask;
+    while ((idx = sett_info->property_lookup_by_name[h]) != 0) {
+        property_info = &sett_info->property_infos[idx - 1u];
+        if (nm_streq(property_info->name, property_name))
+            return property_info;
+        h = (h + 1u) & sett_info->property_lookup_by_name_mask;
+    }
 
-    return property_info;
+    nm_assert(!_nm_sett_info_property_find_in_array(sett_info->property_infos,
+                                                    sett_info->property_infos_len,
+                                                    property_name));
+    return NULL;
 }
 
 const NMSettInfoSetting *
@@ -1291,6 +1317,10 @@ _nm_setting_property_to_dbus_fcn_direct(_NM_SETT_INFO_PROP_TO_DBUS_FCN_ARGS _nm_
                 return NULL;
         }
 
+        /* Some enums are marshalled as 'u', for backward compatibility. */
+        if (g_variant_type_equal(property_info->property_type->dbus_type, G_VARIANT_TYPE_UINT32))
+            return g_variant_new_uint32(val);
+
         return nm_g_variant_maybe_singleton_i(val);
     }
     case NM_VALUE_TYPE_FLAGS:
@@ -1628,6 +1658,9 @@ _nm_setting_property_from_dbus_fcn_direct(_NM_SETT_INFO_PROP_FROM_DBUS_FCN_ARGS
         if (g_variant_is_of_type(value, G_VARIANT_TYPE_INT32)) {
             G_STATIC_ASSERT(sizeof(int) >= sizeof(gint32));
             v = g_variant_get_int32(value);
+        } else if (g_variant_is_of_type(value, G_VARIANT_TYPE_UINT32)
+                   && g_variant_get_uint32(value) <= G_MAXINT32) {
+            v = g_variant_get_uint32(value);
         } else {
             GType gtype = G_TYPE_IS_ENUM(property_info->param_spec->value_type)
                               ? property_info->param_spec->value_type
@@ -2735,6 +2768,7 @@ _nm_setting_property_compare_fcn_direct(_NM_SETT_INFO_PROP_COMPARE_FCN_ARGS _nm_
                         _nm_setting_connection_controller_to_dbus,
                         _nm_setting_connection_port_type_to_dbus,
                         _nm_setting_connection_autoconnect_ports_to_dbus,
+                        _nm_setting_connection_timestamp_to_dbus,
                         _nm_setting_wireless_mac_denylist_to_dbus,
                         _nm_setting_wired_mac_denylist_to_dbus));
 
@@ -2899,6 +2933,9 @@ _nm_setting_compare(NMConnection         *con_a,
     nm_assert(!con_a || NM_IS_CONNECTION(con_a));
     nm_assert(!con_b || NM_IS_CONNECTION(con_b));
 
+    if (a == b)
+        return TRUE;
+
     /* First check that both have the same type */
     if (G_OBJECT_TYPE(a) != G_OBJECT_TYPE(b))
         return FALSE;
@@ -2915,8 +2952,25 @@ _nm_setting_compare(NMConnection         *con_a,
                                         g_variant_equal);
     }
 
+    /* Compare the direct properties first. They are cheap to compare, while the
+     * other properties may need to be converted to GVariant. That way we fail
+     * fast when the settings differ in a direct property. */
+    for (i = 0; i < sett_info->property_infos_len; i++) {
+        const NMSettInfoProperty *property_info = &sett_info->property_infos[i];
+
+        if (property_info->property_type->compare_fcn != _nm_setting_property_compare_fcn_direct)
+            continue;
+        if (_compare_property(sett_info, property_info, con_a, a, con_b, b, flags)
+            == NM_TERNARY_FALSE)
+            return FALSE;
+    }
+
     for (i = 0; i < sett_info->property_infos_len; i++) {
-        if (_compare_property(sett_info, &sett_info->property_infos[i], con_a, a, con_b, b, flags)
+        const NMSettInfoProperty *property_info = &sett_info->property_infos[i];
+
+        if (property_info->property_type->compare_fcn == _nm_setting_property_compare_fcn_direct)
+            continue;
+        if (_compare_property(sett_info, property_info, con_a, a, con_b, b, flags)
             == NM_TERNARY_FALSE)
             return FALSE;
     }
@@ -2663,6 +2663,106 @@ fail:
     return TC_H_UNSPEC;
 }
 
+/**
+ * _nm_utils_tc_parse_mqprio_map:
+ * @str: the "map" attribute of a mqprio qdisc, like "0,0,1,1"
+ * @num_tc: the number of traffic classes
+ * @map: (out): the traffic class for each of the 16 priorities. Priorities
+ *   that are not listed map to traffic class 0.
+ * @error: location of the error
+ *
+ * Returns: %TRUE if @str is valid.
+ */
+gboolean
+_nm_utils_tc_parse_mqprio_map(const char *str, guint num_tc, guint8 *map, GError **error)
+{
+    gs_free const char **strv = NULL;
+    gsize                i;
+
+    memset(map, 0, TC_QOPT_BITMASK + 1);
+
+    strv = nm_strsplit_set(str, ",");
+    if (NM_PTRARRAY_LEN(strv) > TC_QOPT_BITMASK + 1) {
+        nm_utils_error_set(error,
+                           NM_UTILS_ERROR_UNKNOWN,
+                           _("mqprio map has more than %u entries"),
+                           TC_QOPT_BITMASK + 1);
+        return FALSE;
+    }
+
+    for (i = 0; strv && strv[i]; i++) {
+        gint64 tc;
+
+        tc = _nm_utils_ascii_str_to_int64(strv[i], 10, 0, NM_MAX(num_tc, 1u) - 1u, -1);
+        if (tc < 0) {
+            nm_utils_error_set(error,
+                               NM_UTILS_ERROR_UNKNOWN,
+                               _("'%s' is not a valid traffic class in the mqprio map"),
+                               strv[i]);
+            return FALSE;
+        }
+        map[i] = tc;
+    }
+    return TRUE;
+}
+
+/**
+ * _nm_utils_tc_parse_mqprio_queues:
+ * @str: the "queues" attribute of a mqprio qdisc, like "2@0,2@2"
+ * @num_tc: the number of traffic classes. @str must have one
+ *   "count@offset" entry for each.
+ * @count: (out): the number of queues of each traffic class
+ * @offset: (out): the first queue of each traffic class
+ * @error: location of the error
+ *
+ * Returns: %TRUE if @str is valid.
+ */
+gboolean
+_nm_utils_tc_parse_mqprio_queues(const char *str,
+                                 guint       num_tc,
+                                 guint16    *count,
+                                 guint16    *offset,
+                                 GError    **error)
+{
+    gs_free const char **strv = NULL;
+    gsize                i;
+
+    memset(count, 0, sizeof(guint16) * TC_QOPT_MAX_QUEUE);
+    memset(offset, 0, sizeof(guint16) * TC_QOPT_MAX_QUEUE);
+
+    strv = nm_strsplit_set(str, ",");
+    if (NM_PTRARRAY_LEN(strv) != num_tc) {
+        nm_utils_error_set(error,
+                           NM_UTILS_ERROR_UNKNOWN,
+                           _("mqprio queues must have one entry per traffic class"));
+        return FALSE;
+    }
+
+    for (i = 0; i < num_tc; i++) {
+        gs_free char *s = g_strdup(strv[i]);
+        char         *sep;
+        gint64        c;
+        gint64        o = -1;
+
+        sep = strchr(s, '@');
+        if (sep) {
+            *sep = '\0';
+            o    = _nm_utils_ascii_str_to_int64(&sep[1], 10, 0, G_MAXUINT16, -1);
+        }
+        c = _nm_utils_ascii_str_to_int64(s, 10, 1, G_MAXUINT16, -1);
+        if (c < 0 || o < 0) {
+            nm_utils_error_set(error,
+                               NM_UTILS_ERROR_UNKNOWN,
+                               _("'%s' is not a valid count@offset entry in the mqprio queues"),
+                               strv[i]);
+            return FALSE;
+        }
+        count[i]  = c;
+        offset[i] = o;
+    }
+    return TRUE;
+}
+
 static const NMVariantAttributeSpec *const tc_object_attribute_spec[] = {
     NM_VARIANT_ATTRIBUTE_SPEC_DEFINE("root", G_VARIANT_TYPE_BOOLEAN, .no_value = TRUE, ),
     NM_VARIANT_ATTRIBUTE_SPEC_DEFINE("parent", G_VARIANT_TYPE_STRING, ),
@@ -2713,13 +2813,34 @@ static const NMVariantAttributeSpec *const tc_qdisc_fq_codel_spec[] = {
     NULL,
 };
 
+static const NMVariantAttributeSpec *const tc_qdisc_fq_spec[] = {
+    NM_VARIANT_ATTRIBUTE_SPEC_DEFINE("limit", G_VARIANT_TYPE_UINT32, ),
+    NM_VARIANT_ATTRIBUTE_SPEC_DEFINE("flow_limit", G_VARIANT_TYPE_UINT32, ),
+    NM_VARIANT_ATTRIBUTE_SPEC_DEFINE("quantum", G_VARIANT_TYPE_UINT32, ),
+    NM_VARIANT_ATTRIBUTE_SPEC_DEFINE("initial_quantum", G_VARIANT_TYPE_UINT32, ),
+    NM_VARIANT_ATTRIBUTE_SPEC_DEFINE("maxrate", G_VARIANT_TYPE_UINT32, ),
+    NM_VARIANT_ATTRIBUTE_SPEC_DEFINE("nopacing", G_VARIANT_TYPE_BOOLEAN, .no_value = TRUE, ),
+    NULL,
+};
+
+static const NMVariantAttributeSpec *const tc_qdisc_mqprio_spec[] = {
+    NM_VARIANT_ATTRIBUTE_SPEC_DEFINE("num_tc", G_VARIANT_TYPE_UINT32, ),
+    NM_VARIANT_ATTRIBUTE_SPEC_DEFINE("map", G_VARIANT_TYPE_STRING, ),
+    NM_VARIANT_ATTRIBUTE_SPEC_DEFINE("queues", G_VARIANT_TYPE_STRING, ),
+    NM_VARIANT_ATTRIBUTE_SPEC_DEFINE("hw", G_VARIANT_TYPE_UINT32, ),
+    NM_VARIANT_ATTRIBUTE_SPEC_DEFINE("mode", G_VARIANT_TYPE_STRING, ),
+    NULL,
+};
+
 typedef struct {
     const char                          *kind;
     const NMVariantAttributeSpec *const *attrs;
 } NMQdiscAttributeSpec;
 
 static const NMQdiscAttributeSpec *const tc_qdisc_attribute_spec[] = {
+    &(const NMQdiscAttributeSpec) {"fq", tc_qdisc_fq_spec},
     &(const NMQdiscAttributeSpec) {"fq_codel", tc_qdisc_fq_codel_spec},
+    &(const NMQdiscAttributeSpec) {"mqprio", tc_qdisc_mqprio_spec},
     &(const NMQdiscAttributeSpec) {"sfq", tc_qdisc_sfq_spec},
     &(const NMQdiscAttributeSpec) {"tbf", tc_qdisc_tbf_spec},
     NULL,
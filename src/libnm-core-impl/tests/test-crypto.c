@@ -401,6 +401,62 @@ test_md5(void)
 
 /*****************************************************************************/
 
+static void
+_assert_cert_format(const char *path, NMCryptoFileFormat expected_format)
+{
+    gs_unref_bytes GBytes *cert   = NULL;
+    NMCryptoFileFormat     format = NM_CRYPTO_FILE_FORMAT_UNKNOWN;
+    GError                *error  = NULL;
+    gboolean               success;
+
+    success = nm_crypto_load_and_verify_certificate(path, &format, &cert, &error);
+    nmtst_assert_success(success, error);
+    g_assert_cmpint(format, ==, expected_format);
+    g_assert(cert);
+}
+
+static void
+test_file_cache(void)
+{
+    gs_free char *p12_path = g_build_filename(TEST_CERT_DIR, "test-cert.p12", NULL);
+    gs_free char *pem_path = g_build_filename(TEST_CERT_DIR, "test_ca_cert.pem", NULL);
+    gs_free char *p12_data = NULL;
+    gs_free char *pem_data = NULL;
+    gs_free char *path     = NULL;
+    GError       *error    = NULL;
+    gsize         p12_len;
+    gsize         pem_len;
+    int           fd;
+    int           i;
+
+    g_assert(g_file_get_contents(p12_path, &p12_data, &p12_len, NULL));
+    g_assert(g_file_get_contents(pem_path, &pem_data, &pem_len, NULL));
+
+    fd = g_file_open_tmp("test-crypto-XXXXXX", &path, &error);
+    g_assert_no_error(error);
+    nm_close(fd);
+
+    /* The second check of each file is answered from the cache. Replacing
+     * the file must invalidate the cached results. */
+    for (i = 0; i < 2; i++) {
+        g_assert(g_file_set_contents(path, p12_data, p12_len, NULL));
+        test_is_pkcs12(path, FALSE);
+        test_is_pkcs12(path, FALSE);
+        _assert_cert_format(path, NM_CRYPTO_FILE_FORMAT_PKCS12);
+        _assert_cert_format(path, NM_CRYPTO_FILE_FORMAT_PKCS12);
+
+        g_assert(g_file_set_contents(path, pem_data, pem_len, NULL));
+        test_is_pkcs12(path, TRUE);
+        test_is_pkcs12(path, TRUE);
+        _assert_cert_format(path, NM_CRYPTO_FILE_FORMAT_X509);
+        _assert_cert_format(path, NM_CRYPTO_FILE_FORMAT_X509);
+    }
+
+    (void) unlink(path);
+}
+
+/*****************************************************************************/
+
 static void
 test_crypto_error(void)
 {
@@ -473,6 +529,7 @@ main(int argc, char **argv)
 
     g_test_add_data_func("/libnm/crypto/PKCS#8", "pkcs8-enc-key.pem, 1234567890", test_pkcs8);
 
+    g_test_add_func("/libnm/crypto/file-cache", test_file_cache);
     g_test_add_func("/libnm/crypto/md5", test_md5);
     g_test_add_func("/libnm/crypto/error", test_crypto_error);
 
@@ -2613,6 +2613,59 @@ test_setting_ip_route_attributes(void)
 #undef TEST_ATTR
 }
 
+static void
+test_setting_ip_route_attributes_storage(void)
+{
+    gs_strfreev char **names = NULL;
+    NMIPRoute         *route;
+    NMIPRoute         *copy;
+
+    route = nm_ip_route_new(AF_INET, "1.2.3.0", 24, NULL, -1, NULL);
+    g_assert(route);
+
+    nm_ip_route_set_attribute(route, "table", g_variant_new_uint32(100));
+    nm_ip_route_set_attribute(route, "onlink", g_variant_new_boolean(TRUE));
+    nm_ip_route_set_attribute(route, "src", g_variant_new_string("1.2.3.4"));
+    nm_ip_route_set_attribute(route, "lock-mtu", g_variant_new_boolean(TRUE));
+    nm_ip_route_set_attribute(route, "table", g_variant_new_uint32(200));
+
+    names = nm_ip_route_get_attribute_names(route);
+    g_assert_cmpint(g_strv_length(names), ==, 4);
+    g_assert_cmpstr(names[0], ==, "lock-mtu");
+    g_assert_cmpstr(names[1], ==, "onlink");
+    g_assert_cmpstr(names[2], ==, "src");
+    g_assert_cmpstr(names[3], ==, "table");
+
+    g_assert_cmpint(g_variant_get_uint32(nm_ip_route_get_attribute(route, "table")), ==, 200);
+    g_assert(g_variant_get_boolean(nm_ip_route_get_attribute(route, "onlink")));
+    g_assert(!nm_ip_route_get_attribute(route, "tos"));
+
+    /* Equal boolean values share one variant. */
+    g_assert(nm_ip_route_get_attribute(route, "onlink")
+             == nm_ip_route_get_attribute(route, "lock-mtu"));
+
+    copy = nm_ip_route_dup(route);
+    g_assert(nm_ip_route_equal_full(route, copy, NM_IP_ROUTE_EQUAL_CMP_FLAGS_WITH_ATTRS));
+
+    nm_ip_route_set_attribute(copy, "src", NULL);
+    nm_ip_route_set_attribute(copy, "tos", NULL);
+    g_assert(!nm_ip_route_get_attribute(copy, "src"));
+    g_assert(nm_ip_route_get_attribute(route, "src"));
+    g_assert(!nm_ip_route_equal_full(route, copy, NM_IP_ROUTE_EQUAL_CMP_FLAGS_WITH_ATTRS));
+
+    nm_ip_route_set_attribute(copy, "src", g_variant_new_string("1.2.3.4"));
+    g_assert(nm_ip_route_equal_full(route, copy, NM_IP_ROUTE_EQUAL_CMP_FLAGS_WITH_ATTRS));
+
+    nm_ip_route_set_attribute(copy, "lock-mtu", NULL);
+    nm_ip_route_set_attribute(copy, "onlink", NULL);
+    nm_ip_route_set_attribute(copy, "src", NULL);
+    nm_ip_route_set_attribute(copy, "table", NULL);
+    g_assert(!_nm_ip_route_get_attribute_names(copy, TRUE, NULL));
+
+    nm_ip_route_unref(copy);
+    nm_ip_route_unref(route);
+}
+
 static void
 test_setting_gsm_apn_spaces(void)
 {
@@ -3040,6 +3093,69 @@ test_connection_to_dbus_deprecated_props(void)
     g_object_unref(connection);
 }
 
+static gboolean
+_setting_dict_contains(GVariant *dict, const char *setting_name, const char *key)
+{
+    gs_unref_variant GVariant *setting_dict = NULL;
+
+    setting_dict = g_variant_lookup_value(dict, setting_name, NM_VARIANT_TYPE_SETTING);
+    g_assert(setting_dict);
+    return _variant_contains(setting_dict, key);
+}
+
+static void
+test_connection_to_dbus_cached(void)
+{
+    gs_unref_object NMConnection *connection = NULL;
+    gs_unref_variant GVariant    *dict_all   = NULL;
+    gs_unref_variant GVariant    *dict_all2  = NULL;
+    gs_unref_variant GVariant    *dict_ns    = NULL;
+    gs_unref_variant GVariant    *dict       = NULL;
+    NMSettingWirelessSecurity    *s_wsec;
+
+    connection = nm_simple_connection_new();
+    g_assert(!_nm_connection_to_dbus_cached(connection, NM_CONNECTION_SERIALIZE_ALL));
+
+    s_wsec = make_test_wsec_setting("connection-to-dbus-cached");
+    nm_connection_add_setting(connection, NM_SETTING(s_wsec));
+
+    dict_all  = _nm_connection_to_dbus_cached(connection, NM_CONNECTION_SERIALIZE_ALL);
+    dict_all2 = _nm_connection_to_dbus_cached(connection, NM_CONNECTION_SERIALIZE_ALL);
+    g_assert(dict_all);
+    g_assert(!g_variant_is_floating(dict_all));
+    g_assert(dict_all == dict_all2);
+    g_assert(_setting_dict_contains(dict_all,
+                                    NM_SETTING_WIRELESS_SECURITY_SETTING_NAME,
+                                    NM_SETTING_WIRELESS_SECURITY_WEP_KEY0));
+
+    /* Each serialization flag has its own entry. */
+    dict_ns = _nm_connection_to_dbus_cached(connection, NM_CONNECTION_SERIALIZE_WITH_NON_SECRET);
+    g_assert(dict_ns != dict_all);
+    g_assert(!_setting_dict_contains(dict_ns,
+                                     NM_SETTING_WIRELESS_SECURITY_SETTING_NAME,
+                                     NM_SETTING_WIRELESS_SECURITY_WEP_KEY0));
+    nm_clear_pointer(&dict_all2, g_variant_unref);
+    dict_all2 = _nm_connection_to_dbus_cached(connection, NM_CONNECTION_SERIALIZE_ALL);
+    g_assert(dict_all2 == dict_all);
+
+    /* Clearing the secrets modifies the setting without notification. */
+    nm_connection_clear_secrets(connection);
+    dict = _nm_connection_to_dbus_cached(connection, NM_CONNECTION_SERIALIZE_ALL);
+    g_assert(dict != dict_all);
+    g_assert(!_setting_dict_contains(dict,
+                                     NM_SETTING_WIRELESS_SECURITY_SETTING_NAME,
+                                     NM_SETTING_WIRELESS_SECURITY_WEP_KEY0));
+    nm_clear_pointer(&dict, g_variant_unref);
+
+    g_object_set(s_wsec, NM_SETTING_WIRELESS_SECURITY_LEAP_USERNAME, "other", NULL);
+    dict = _nm_connection_to_dbus_cached(connection, NM_CONNECTION_SERIALIZE_WITH_NON_SECRET);
+    g_assert(dict != dict_ns);
+    nm_clear_pointer(&dict_ns, g_variant_unref);
+    dict_ns = g_variant_ref_sink(
+        nm_connection_to_dbus(connection, NM_CONNECTION_SERIALIZE_WITH_NON_SECRET));
+    g_assert(g_variant_equal(dict, dict_ns));
+}
+
 static void
 test_setting_new_from_dbus(void)
 {
@@ -6569,6 +6685,68 @@ test_connection_normalize_shared_addresses(void)
     g_assert_cmpstr(nm_ip_address_get_address(addr), ==, "1.1.1.1");
 }
 
+static void
+test_connection_normalize_bulk(void)
+{
+    const guint                  N           = g_test_perf() ? 10000u : 200u;
+    gs_unref_ptrarray GPtrArray *connections = g_ptr_array_new_with_free_func(g_object_unref);
+    gint64                       start;
+    guint                        i;
+
+    for (i = 0; i < N; i++) {
+        NMConnection        *con;
+        NMSettingConnection *s_con;
+        char                 name[64];
+
+        if (i % 2 == 0) {
+            nm_sprintf_buf(name, "bond%u", i / 2);
+            con = nmtst_create_minimal_connection(name, NULL, NM_SETTING_BOND_SETTING_NAME, &s_con);
+            g_object_set(s_con, NM_SETTING_CONNECTION_INTERFACE_NAME, name, NULL);
+        } else {
+            nm_sprintf_buf(name, "bond%u", i / 2);
+            con = nmtst_create_minimal_connection(name, NULL, NM_SETTING_VLAN_SETTING_NAME, &s_con);
+            g_object_set(nm_connection_get_setting_vlan(con),
+                         NM_SETTING_VLAN_PARENT,
+                         name,
+                         NM_SETTING_VLAN_ID,
+                         (guint) (1 + (i / 2) % 4094),
+                         NULL);
+            nm_sprintf_buf(name, "bond%u.%u", i / 2, 1 + (i / 2) % 4094);
+            g_object_set(s_con,
+                         NM_SETTING_CONNECTION_ID,
+                         name,
+                         NM_SETTING_CONNECTION_INTERFACE_NAME,
+                         name,
+                         NULL);
+        }
+        g_ptr_array_add(connections, con);
+    }
+
+    start = g_get_monotonic_time();
+    for (i = 0; i < N; i++) {
+        NMConnection *con = connections->pdata[i];
+
+        nmtst_assert_connection_verifies_and_normalizable(con);
+        nmtst_connection_normalize(con);
+
+        /* the connection is unchanged since the last verify and the check is
+         * answered from the cached result. */
+        nmtst_assert_connection_verifies_without_normalization(con);
+    }
+    g_test_message("normalized %u profiles in %" G_GINT64_FORMAT " msec",
+                   N,
+                   (g_get_monotonic_time() - start) / 1000);
+
+    /* any modification invalidates the cached result. */
+    g_object_set(nm_connection_get_setting_vlan(connections->pdata[1]),
+                 NM_SETTING_VLAN_ID,
+                 (guint) 4095,
+                 NULL);
+    nmtst_assert_connection_unnormalizable(connections->pdata[1],
+                                           NM_CONNECTION_ERROR,
+                                           NM_CONNECTION_ERROR_INVALID_PROPERTY);
+}
+
 static void
 test_connection_normalize_ovs_interface_type_system(gconstpointer test_data)
 {
@@ -11359,6 +11537,45 @@ test_direct_string_is_refstr(void)
     g_assert(!nmtst_ref_string_find(TEST_STR));
 }
 
+static void
+test_direct_string_is_refstr_shared(void)
+{
+    gs_unref_object NMSetting *s1       = NULL;
+    gs_unref_object NMSetting *s2       = NULL;
+    const char                *TEST_STR = "zone-kjsdf";
+    NMSettingConnection       *s_con1;
+    NMSettingConnection       *s_con2;
+    const char                *zone;
+
+    g_assert(!nmtst_ref_string_find(TEST_STR));
+
+    /* Repeated values in different settings share the same interned string. */
+    s1 = nm_setting_connection_new();
+    s2 = nm_setting_connection_new();
+    g_object_set(s1,
+                 NM_SETTING_CONNECTION_ZONE,
+                 TEST_STR,
+                 NM_SETTING_CONNECTION_CONTROLLER,
+                 TEST_STR,
+                 NULL);
+    g_object_set(s2, NM_SETTING_CONNECTION_ZONE, TEST_STR, NULL);
+
+    s_con1 = NM_SETTING_CONNECTION(s1);
+    s_con2 = NM_SETTING_CONNECTION(s2);
+    zone   = nm_setting_connection_get_zone(s_con2);
+    g_assert(zone == nmtst_ref_string_find(TEST_STR)->str);
+    g_assert(nm_setting_connection_get_zone(s_con1) == zone);
+    g_assert(nm_setting_connection_get_controller(s_con1) == zone);
+
+    g_object_set(s1, NM_SETTING_CONNECTION_MASTER, NULL, NULL);
+    g_assert(!nm_setting_connection_get_controller(s_con1));
+
+    g_clear_object(&s1);
+    g_assert(nmtst_ref_string_find(TEST_STR));
+    g_clear_object(&s2);
+    g_assert(!nmtst_ref_string_find(TEST_STR));
+}
+
 /*****************************************************************************/
 
 static void
@@ -11645,6 +11862,8 @@ main(int argc, char **argv)
                     test_setting_ip4_config_address_data);
     g_test_add_func("/core/general/test_setting_ip_route_attributes",
                     test_setting_ip_route_attributes);
+    g_test_add_func("/core/general/test_setting_ip_route_attributes_storage",
+                    test_setting_ip_route_attributes_storage);
     g_test_add_func("/core/general/test_setting_gsm_apn_spaces", test_setting_gsm_apn_spaces);
     g_test_add_func("/core/general/test_setting_gsm_apn_bad_chars", test_setting_gsm_apn_bad_chars);
     g_test_add_func("/core/general/test_setting_gsm_apn_underscore",
@@ -11720,6 +11939,8 @@ main(int argc, char **argv)
                     test_connection_to_dbus_setting_name);
     g_test_add_func("/core/general/test_connection_to_dbus_deprecated_props",
                     test_connection_to_dbus_deprecated_props);
+    g_test_add_func("/core/general/test_connection_to_dbus_cached",
+                    test_connection_to_dbus_cached);
     g_test_add_func("/core/general/test_setting_new_from_dbus", test_setting_new_from_dbus);
     g_test_add_func("/core/general/test_setting_new_from_dbus_transform",
                     test_setting_new_from_dbus_transform);
@@ -11749,6 +11970,7 @@ main(int argc, char **argv)
                     test_connection_normalize_may_fail);
     g_test_add_func("/core/general/test_connection_normalize_shared_addresses",
                     test_connection_normalize_shared_addresses);
+    g_test_add_func("/core/general/test_connection_normalize_bulk", test_connection_normalize_bulk);
     g_test_add_data_func("/core/general/test_connection_normalize_ovs_interface_type_system/1",
                          GUINT_TO_POINTER(1),
                          test_connection_normalize_ovs_interface_type_system);
@@ -11956,6 +12178,8 @@ main(int argc, char **argv)
 
     g_test_add_func("/core/general/test_system_encodings", test_system_encodings);
     g_test_add_func("/core/general/test_direct_string_is_refstr", test_direct_string_is_refstr);
+    g_test_add_func("/core/general/test_direct_string_is_refstr_shared",
+                    test_direct_string_is_refstr_shared);
     g_test_add_func("/core/general/test_connection_path", test_connection_path);
     g_test_add_func("/core/general/test_dns_uri_parse", test_dns_uri_parse);
     g_test_add_func("/core/general/test_dns_uri_get_legacy", test_dns_uri_parse_plain);
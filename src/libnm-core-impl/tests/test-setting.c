@@ -2460,6 +2460,49 @@ test_ethtool_fec(void)
                                                &out_value));
     g_assert_true(out_value == expected_fec_mode);
 }
+
+static void
+test_ethtool_rss(void)
+{
+    gs_unref_object NMConnection *con   = NULL;
+    gs_free_error GError         *error = NULL;
+    NMSettingConnection          *s_con;
+    NMSettingEthtool             *s_ethtool;
+    guint32                       out_value;
+
+    con =
+        nmtst_create_minimal_connection("ethtool-rss", NULL, NM_SETTING_WIRED_SETTING_NAME, &s_con);
+    s_ethtool = NM_SETTING_ETHTOOL(nm_setting_ethtool_new());
+    nm_connection_add_setting(con, NM_SETTING(s_ethtool));
+
+    g_assert_true(nm_ethtool_optname_is_rss(NM_ETHTOOL_OPTNAME_RSS_EQUAL));
+    g_assert_true(nm_ethtool_optname_is_rss(NM_ETHTOOL_OPTNAME_RSS_HFUNC));
+    g_assert_false(nm_ethtool_optname_is_rss(NM_ETHTOOL_OPTNAME_CHANNELS_RX));
+
+    nm_setting_option_set_uint32(NM_SETTING(s_ethtool), NM_ETHTOOL_OPTNAME_RSS_EQUAL, 4);
+    nm_setting_option_set_uint32(NM_SETTING(s_ethtool), NM_ETHTOOL_OPTNAME_RSS_HFUNC, 1);
+    nmtst_assert_connection_verifies_without_normalization(con);
+
+    g_assert_true(nm_setting_option_get_uint32(NM_SETTING(s_ethtool),
+                                               NM_ETHTOOL_OPTNAME_RSS_EQUAL,
+                                               &out_value));
+    g_assert_cmpint(out_value, ==, 4);
+
+    nm_setting_option_set_uint32(NM_SETTING(s_ethtool), NM_ETHTOOL_OPTNAME_RSS_EQUAL, 0);
+    g_assert_false(nm_setting_verify(NM_SETTING(s_ethtool), con, &error));
+    g_assert_error(error, NM_CONNECTION_ERROR, NM_CONNECTION_ERROR_INVALID_PROPERTY);
+    g_clear_error(&error);
+
+    nm_setting_option_set_uint32(NM_SETTING(s_ethtool), NM_ETHTOOL_OPTNAME_RSS_EQUAL, 2);
+    nm_setting_option_set_uint32(NM_SETTING(s_ethtool), NM_ETHTOOL_OPTNAME_RSS_HFUNC, 3);
+    g_assert_false(nm_setting_verify(NM_SETTING(s_ethtool), con, &error));
+    g_assert_error(error, NM_CONNECTION_ERROR, NM_CONNECTION_ERROR_INVALID_PROPERTY);
+    g_clear_error(&error);
+
+    nm_setting_option_set_uint32(NM_SETTING(s_ethtool), NM_ETHTOOL_OPTNAME_RSS_HFUNC, 2);
+    nmtst_assert_connection_verifies_without_normalization(con);
+}
+
 /*****************************************************************************/
 
 static void
@@ -3239,6 +3282,79 @@ test_tc_config_setting_duplicates(void)
     nmtst_assert_connection_verifies_and_normalizable(con);
 }
 
+static void
+test_tc_config_setting_per_queue(void)
+{
+    gs_unref_ptrarray GPtrArray *qdiscs = NULL;
+    NMSettingConnection         *s_con;
+    NMConnection                *con;
+    NMSetting                   *s_tc;
+    NMTCQdisc                   *qdisc;
+    GError                      *error = NULL;
+
+    con = nmtst_create_minimal_connection("dummy", NULL, NM_SETTING_DUMMY_SETTING_NAME, &s_con);
+    g_object_set(s_con, NM_SETTING_CONNECTION_INTERFACE_NAME, "dummy1", NULL);
+
+    s_tc = nm_setting_tc_config_new();
+    nm_connection_add_setting(con, s_tc);
+    qdiscs = g_ptr_array_new_with_free_func((GDestroyNotify) nm_tc_qdisc_unref);
+
+    /* 1. a "fq" for each queue of the "mq" */
+    qdisc = nm_utils_tc_qdisc_from_str("root handle 1: mq", &error);
+    nmtst_assert_success(qdisc, error);
+    g_ptr_array_add(qdiscs, qdisc);
+
+    qdisc = nm_utils_tc_qdisc_from_str("parent 1: fq flow_limit 200 maxrate 125000000", &error);
+    nmtst_assert_success(qdisc, error);
+    g_assert_cmpint(g_variant_get_uint32(nm_tc_qdisc_get_attribute(qdisc, "maxrate")),
+                    ==,
+                    125000000);
+    g_ptr_array_add(qdiscs, qdisc);
+
+    g_object_set(s_tc, NM_SETTING_TC_CONFIG_QDISCS, qdiscs, NULL);
+    nmtst_assert_connection_verifies_and_normalizable(con);
+
+    /* 2. the kernel picks the handles of the per queue qdiscs */
+    g_ptr_array_remove_index(qdiscs, 1);
+    qdisc = nm_utils_tc_qdisc_from_str("handle 2: parent 1: fq", &error);
+    nmtst_assert_success(qdisc, error);
+    g_ptr_array_add(qdiscs, qdisc);
+
+    g_object_set(s_tc, NM_SETTING_TC_CONFIG_QDISCS, qdiscs, NULL);
+    nmtst_assert_connection_unnormalizable(con,
+                                           NM_CONNECTION_ERROR,
+                                           NM_CONNECTION_ERROR_INVALID_PROPERTY);
+
+    /* 3. mqprio with hardware offload */
+    g_ptr_array_set_size(qdiscs, 0);
+    qdisc = nm_utils_tc_qdisc_from_str(
+        "root handle 1: mqprio num_tc 2 map 0,0,0,1 queues 2@0,2@2 hw 1 mode channel",
+        &error);
+    nmtst_assert_success(qdisc, error);
+    g_ptr_array_add(qdiscs, qdisc);
+
+    qdisc = nm_utils_tc_qdisc_from_str("parent 1: fq", &error);
+    nmtst_assert_success(qdisc, error);
+    g_ptr_array_add(qdiscs, qdisc);
+
+    g_object_set(s_tc, NM_SETTING_TC_CONFIG_QDISCS, qdiscs, NULL);
+    nmtst_assert_connection_verifies_and_normalizable(con);
+
+    /* 4. the queues don't match the traffic classes */
+    g_ptr_array_remove_index(qdiscs, 0);
+    qdisc = nm_utils_tc_qdisc_from_str("root handle 1: mqprio num_tc 2 map 0,1 queues 2@0",
+                                       &error);
+    nmtst_assert_success(qdisc, error);
+    g_ptr_array_insert(qdiscs, 0, qdisc);
+
+    g_object_set(s_tc, NM_SETTING_TC_CONFIG_QDISCS, qdiscs, NULL);
+    nmtst_assert_connection_unnormalizable(con,
+                                           NM_CONNECTION_ERROR,
+                                           NM_CONNECTION_ERROR_INVALID_PROPERTY);
+
+    g_object_unref(con);
+}
+
 static void
 test_tc_config_dbus(void)
 {
@@ -4320,6 +4436,161 @@ test_routing_rule(gconstpointer test_data)
 
 /*****************************************************************************/
 
+static void
+test_link_neigh_parse(void)
+{
+    static const struct {
+        const char *str;
+        gboolean    is_fdb;
+        int         dst_family;
+    } good[] = {
+        {"192.0.2.5 00:11:22:33:44:55", FALSE, AF_INET},
+        {"2001:db8::5  00:11:22:33:44:55", FALSE, AF_INET6},
+        {"00:11:22:33:44:55", TRUE, AF_UNSPEC},
+        {"00:00:00:00:00:00 198.51.100.1", TRUE, AF_INET},
+    };
+    static const struct {
+        const char *str;
+        gboolean    is_fdb;
+    } bad[] = {
+        {"", FALSE},
+        {"192.0.2.5", FALSE},
+        {"00:11:22:33:44:55 192.0.2.5", FALSE},
+        {"192.0.2.5 00:11:22:33:44:55 x", FALSE},
+        {"", TRUE},
+        {"192.0.2.5", TRUE},
+        {"00:11:22:33:44:55 foo", TRUE},
+        {"00:11:22:33:44 192.0.2.5", TRUE},
+    };
+    gs_unref_object NMSettingLink *s_link = NULL;
+    GError                        *error  = NULL;
+    guint                          i;
+
+    for (i = 0; i < G_N_ELEMENTS(good); i++) {
+        NMEtherAddr lladdr;
+        NMIPAddr    dst;
+        int         dst_family;
+
+        if (!_nm_setting_link_parse_neigh(good[i].str,
+                                          good[i].is_fdb,
+                                          &dst_family,
+                                          &dst,
+                                          &lladdr,
+                                          &error))
+            g_error("failure to parse \"%s\": %s", good[i].str, error->message);
+        g_assert_no_error(error);
+        g_assert_cmpint(dst_family, ==, good[i].dst_family);
+    }
+
+    for (i = 0; i < G_N_ELEMENTS(bad); i++) {
+        NMEtherAddr lladdr;
+        NMIPAddr    dst;
+        int         dst_family;
+
+        g_assert(!_nm_setting_link_parse_neigh(bad[i].str,
+                                               bad[i].is_fdb,
+                                               &dst_family,
+                                               &dst,
+                                               &lladdr,
+                                               &error));
+        g_assert_error(error, NM_CONNECTION_ERROR, NM_CONNECTION_ERROR_INVALID_PROPERTY);
+        g_clear_error(&error);
+    }
+
+    s_link = NM_SETTING_LINK(nm_setting_link_new());
+    nm_setting_link_add_neighbor(s_link, "192.0.2.5 00:11:22:33:44:55");
+    nm_setting_link_add_fdb_entry(s_link, "00:00:00:00:00:00 198.51.100.1");
+    g_assert(nm_setting_verify(NM_SETTING(s_link), NULL, NULL));
+
+    nm_setting_link_add_fdb_entry(s_link, "198.51.100.1");
+    g_assert(!nm_setting_verify(NM_SETTING(s_link), NULL, &error));
+    g_assert_error(error, NM_CONNECTION_ERROR, NM_CONNECTION_ERROR_INVALID_PROPERTY);
+    g_clear_error(&error);
+
+    g_assert(nm_setting_link_remove_fdb_entry_by_value(s_link, "198.51.100.1"));
+    g_assert(nm_setting_verify(NM_SETTING(s_link), NULL, NULL));
+}
+
+static void
+test_link_steering(void)
+{
+    gs_unref_object NMSettingLink *s_link = NULL;
+    GError                        *error  = NULL;
+
+    s_link = NM_SETTING_LINK(nm_setting_link_new());
+    g_assert_cmpint(nm_setting_link_get_rps_flow_count(s_link), ==, -1);
+
+    g_object_set(s_link,
+                 NM_SETTING_LINK_RPS_CPUS,
+                 "0-3,8",
+                 NM_SETTING_LINK_RPS_FLOW_COUNT,
+                 (gint64) 4096,
+                 NM_SETTING_LINK_XPS_CPUS,
+                 "numa-local",
+                 NM_SETTING_LINK_IRQ_AFFINITY,
+                 "2",
+                 NULL);
+    g_assert(nm_setting_verify(NM_SETTING(s_link), NULL, NULL));
+    g_assert_cmpstr(nm_setting_link_get_xps_cpus(s_link), ==, "numa-local");
+    g_assert_cmpint(nm_setting_link_get_rps_flow_count(s_link), ==, 4096);
+
+    g_assert_cmpint(nm_setting_link_get_napi_threaded(s_link), ==, -1);
+    g_object_set(s_link,
+                 NM_SETTING_LINK_NAPI_THREADED,
+                 (gint64) 1,
+                 NM_SETTING_LINK_NAPI_DEFER_HARD_IRQS,
+                 (gint64) 2,
+                 NM_SETTING_LINK_GRO_FLUSH_TIMEOUT,
+                 (gint64) 200000,
+                 NULL);
+    g_assert(nm_setting_verify(NM_SETTING(s_link), NULL, NULL));
+    g_assert_cmpint(nm_setting_link_get_napi_threaded(s_link), ==, 1);
+    g_assert_cmpint(nm_setting_link_get_napi_defer_hard_irqs(s_link), ==, 2);
+    g_assert_cmpint(nm_setting_link_get_gro_flush_timeout(s_link), ==, 200000);
+
+    g_object_set(s_link, NM_SETTING_LINK_IRQ_AFFINITY, "3-1", NULL);
+    g_assert(!nm_setting_verify(NM_SETTING(s_link), NULL, &error));
+    g_assert_error(error, NM_CONNECTION_ERROR, NM_CONNECTION_ERROR_INVALID_PROPERTY);
+    g_clear_error(&error);
+}
+
+static void
+test_link_xdp(void)
+{
+    gs_unref_object NMSettingLink *s_link = NULL;
+    GError                        *error  = NULL;
+
+    s_link = NM_SETTING_LINK(nm_setting_link_new());
+    g_assert_cmpstr(nm_setting_link_get_xdp_program(s_link), ==, NULL);
+
+    g_object_set(s_link, NM_SETTING_LINK_XDP_MODE, "native", NULL);
+    g_assert(!nm_setting_verify(NM_SETTING(s_link), NULL, &error));
+    g_assert_error(error, NM_CONNECTION_ERROR, NM_CONNECTION_ERROR_MISSING_PROPERTY);
+    g_clear_error(&error);
+
+    g_object_set(s_link, NM_SETTING_LINK_XDP_PROGRAM, "/sys/fs/bpf/xdp_filter", NULL);
+    g_assert(nm_setting_verify(NM_SETTING(s_link), NULL, NULL));
+    g_assert_cmpstr(nm_setting_link_get_xdp_program(s_link), ==, "/sys/fs/bpf/xdp_filter");
+    g_assert_cmpstr(nm_setting_link_get_xdp_mode(s_link), ==, "native");
+
+    g_object_set(s_link, NM_SETTING_LINK_XDP_MODE, "driver", NULL);
+    g_assert(!nm_setting_verify(NM_SETTING(s_link), NULL, &error));
+    g_assert_error(error, NM_CONNECTION_ERROR, NM_CONNECTION_ERROR_INVALID_PROPERTY);
+    g_clear_error(&error);
+
+    g_object_set(s_link,
+                 NM_SETTING_LINK_XDP_MODE,
+                 NULL,
+                 NM_SETTING_LINK_XDP_PROGRAM,
+                 "xdp_filter.o",
+                 NULL);
+    g_assert(!nm_setting_verify(NM_SETTING(s_link), NULL, &error));
+    g_assert_error(error, NM_CONNECTION_ERROR, NM_CONNECTION_ERROR_INVALID_PROPERTY);
+    g_clear_error(&error);
+}
+
+/*****************************************************************************/
+
 static void
 test_ranges(void)
 {
@@ -4621,6 +4892,10 @@ test_setting_metadata(void)
 
         g_assert(G_TYPE_FROM_CLASS(sis->setting_class) == gtype);
 
+        g_assert(nm_meta_setting_infos_by_name(msi->setting_name) == msi);
+        g_assert(!nm_meta_setting_infos_by_name("no-such-setting"));
+        g_assert(!_nm_sett_info_setting_get_property_info(sis, "no-such-property"));
+
         setting = g_object_new(gtype, NULL);
 
         g_assert(NM_IS_SETTING(setting));
@@ -4660,6 +4935,8 @@ test_setting_metadata(void)
             if (prop_idx > 0)
                 g_assert_cmpint(strcmp(sis->property_infos[prop_idx - 1].name, sip->name), <, 0);
 
+            g_assert(_nm_sett_info_setting_get_property_info(sis, sip->name) == sip);
+
             g_assert(sip->property_type);
             g_assert(sip->property_type->dbus_type);
             g_assert(g_variant_type_string_is_valid((const char *) sip->property_type->dbus_type));
@@ -4730,10 +5007,15 @@ test_setting_metadata(void)
             } else if (sip->property_type->direct_type == NM_VALUE_TYPE_UINT64) {
                 const GParamSpecUInt64 *pspec;
 
-                g_assert(sip->property_type == &nm_sett_info_propert_type_direct_uint64);
+                if (nm_streq(sip->name, NM_SETTING_CONNECTION_TIMESTAMP)) {
+                    g_assert(sip->property_type->to_dbus_fcn
+                             == _nm_setting_connection_timestamp_to_dbus);
+                } else {
+                    g_assert(sip->property_type == &nm_sett_info_propert_type_direct_uint64);
+                    g_assert(sip->property_type->to_dbus_fcn
+                             == _nm_setting_property_to_dbus_fcn_direct);
+                }
                 g_assert(g_variant_type_equal(sip->property_type->dbus_type, "t"));
-                g_assert(sip->property_type->to_dbus_fcn
-                         == _nm_setting_property_to_dbus_fcn_direct);
                 g_assert(sip->param_spec);
                 g_assert(sip->param_spec->value_type == G_TYPE_UINT64);
 
@@ -4751,7 +5033,10 @@ test_setting_metadata(void)
 
                 g_assert(_nm_setting_property_is_valid_direct_enum(sip));
                 g_assert(G_TYPE_IS_ENUM(sip->direct_data.enum_gtype));
-                g_assert(g_variant_type_equal(sip->property_type->dbus_type, "i"));
+                if (nm_streq(sip->name, NM_SETTING_WIRELESS_SECURITY_WEP_KEY_TYPE))
+                    g_assert(g_variant_type_equal(sip->property_type->dbus_type, "u"));
+                else
+                    g_assert(g_variant_type_equal(sip->property_type->dbus_type, "i"));
                 g_assert(sip->param_spec);
 
                 if (G_TYPE_IS_ENUM(sip->param_spec->value_type)) {
@@ -4778,7 +5063,10 @@ test_setting_metadata(void)
             } else if (sip->property_type->direct_type == NM_VALUE_TYPE_FLAGS) {
                 const GParamSpecFlags *pspec;
 
-                g_assert(sip->property_type == &nm_sett_info_propert_type_direct_flags);
+                if (nm_streq(sip->name, NM_SETTING_VLAN_FLAGS))
+                    g_assert(sip->property_type->missing_from_dbus_fcn);
+                else
+                    g_assert(sip->property_type == &nm_sett_info_propert_type_direct_flags);
                 g_assert(g_variant_type_equal(sip->property_type->dbus_type, "u"));
                 g_assert(sip->property_type->to_dbus_fcn
                          == _nm_setting_property_to_dbus_fcn_direct);
@@ -5821,6 +6109,7 @@ main(int argc, char **argv)
     g_test_add_func("/libnm/settings/ethtool/pause", test_ethtool_pause);
     g_test_add_func("/libnm/settings/ethtool/eee", test_ethtool_eee);
     g_test_add_func("/libnm/settings/ethtool/fec", test_ethtool_fec);
+    g_test_add_func("/libnm/settings/ethtool/rss", test_ethtool_rss);
 
     g_test_add_func("/libnm/settings/6lowpan/1", test_6lowpan_1);
 
@@ -5842,6 +6131,8 @@ main(int argc, char **argv)
     g_test_add_func("/libnm/settings/tc_config/setting/valid", test_tc_config_setting_valid);
     g_test_add_func("/libnm/settings/tc_config/setting/duplicates",
                     test_tc_config_setting_duplicates);
+    g_test_add_func("/libnm/settings/tc_config/setting/per_queue",
+                    test_tc_config_setting_per_queue);
     g_test_add_func("/libnm/settings/tc_config/dbus", test_tc_config_dbus);
 
     g_test_add_func("/libnm/settings/bridge/vlans", test_bridge_vlans);
@@ -5895,6 +6186,10 @@ main(int argc, char **argv)
 
     g_test_add_func("/libnm/settings/ranges", test_ranges);
 
+    g_test_add_func("/libnm/settings/link/neigh-parse", test_link_neigh_parse);
+    g_test_add_func("/libnm/settings/link/steering", test_link_steering);
+    g_test_add_func("/libnm/settings/link/xdp", test_link_xdp);
+
     g_test_add_func("/libnm/parse-tc-handle", test_parse_tc_handle);
 
     g_test_add_func("/libnm/test_team_setting", test_team_setting);
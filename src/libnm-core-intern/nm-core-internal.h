@@ -245,6 +245,9 @@ GVariant *nm_connection_to_dbus_full(NMConnection                           *con
                                      NMConnectionSerializationFlags          flags,
                                      const NMConnectionSerializationOptions *options);
 
+GVariant *_nm_connection_to_dbus_cached(NMConnection                  *connection,
+                                        NMConnectionSerializationFlags flags);
+
 typedef enum {
     /* whether the connection has any secrets.
      *
@@ -347,10 +350,17 @@ void     _nm_setting_wired_clear_s390_options(NMSettingWired *setting);
 gboolean _nm_setting_wired_is_valid_s390_option(const char *option);
 gboolean _nm_setting_wired_is_valid_s390_option_value(const char *name, const char *option);
 
+gboolean _nm_setting_link_parse_neigh(const char  *str,
+                                      gboolean     is_fdb,
+                                      int         *out_dst_family,
+                                      NMIPAddr    *out_dst,
+                                      NMEtherAddr *out_lladdr,
+                                      GError     **error);
+
 gboolean _nm_ip_route_attribute_validate_all(const NMIPRoute *route, GError **error);
 const char **
 _nm_ip_route_get_attribute_names(const NMIPRoute *route, gboolean sorted, guint *out_length);
-GHashTable *_nm_ip_route_get_attributes(NMIPRoute *route);
+const NMUtilsNamedValue *_nm_ip_route_get_attributes(NMIPRoute *route, guint *out_length);
 
 NMSriovVF *_nm_utils_sriov_vf_from_strparts(const char *index,
                                             const char *detail,
@@ -574,6 +584,13 @@ gboolean nm_team_link_watchers_equal(const GPtrArray *a, const GPtrArray *b, gbo
 /*****************************************************************************/
 
 guint32 _nm_utils_parse_tc_handle(const char *str, GError **error);
+gboolean
+_nm_utils_tc_parse_mqprio_map(const char *str, guint num_tc, guint8 *map, GError **error);
+gboolean _nm_utils_tc_parse_mqprio_queues(const char *str,
+                                          guint       num_tc,
+                                          guint16    *count,
+                                          guint16    *offset,
+                                          GError    **error);
 void    _nm_utils_string_append_tc_parent(GString *string, const char *prefix, guint32 parent);
 void    _nm_utils_string_append_tc_qdisc_rest(GString *string, NMTCQdisc *qdisc);
 gboolean
@@ -985,10 +1002,17 @@ struct _NMSettInfoSetting {
 
     const NMSettInfoPropertLookupByParamSpec *property_lookup_by_param_spec;
 
+    /* An open addressing hash table to look up a property by name. The entries
+     * are indexes into @property_infos plus one, zero marks an empty slot. The
+     * number of slots is a power of two, @property_lookup_by_name_mask plus one. */
+    const guint16 *property_lookup_by_name;
+
     guint16 property_infos_len;
 
     guint16 property_lookup_by_param_spec_len;
 
+    guint16 property_lookup_by_name_mask;
+
     /* the offset in bytes to get the private data from the @self pointer. */
     gint16 private_offset;
 
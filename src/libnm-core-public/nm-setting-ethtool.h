@@ -35,6 +35,9 @@ gboolean nm_ethtool_optname_is_eee(const char *optname);
 NM_AVAILABLE_IN_1_52
 gboolean nm_ethtool_optname_is_fec(const char *optname);
 
+NM_AVAILABLE_IN_1_58
+gboolean nm_ethtool_optname_is_rss(const char *optname);
+
 /*****************************************************************************/
 
 #define NM_TYPE_SETTING_ETHTOOL (nm_setting_ethtool_get_type())
@@ -26,10 +26,23 @@ G_BEGIN_DECLS
 
 #define NM_SETTING_LINK_SETTING_NAME "link"
 
-#define NM_SETTING_LINK_TX_QUEUE_LENGTH  "tx-queue-length"
-#define NM_SETTING_LINK_GSO_MAX_SIZE     "gso-max-size"
-#define NM_SETTING_LINK_GSO_MAX_SEGMENTS "gso-max-segments"
-#define NM_SETTING_LINK_GRO_MAX_SIZE     "gro-max-size"
+#define NM_SETTING_LINK_TX_QUEUE_LENGTH      "tx-queue-length"
+#define NM_SETTING_LINK_GSO_MAX_SIZE         "gso-max-size"
+#define NM_SETTING_LINK_GSO_MAX_SEGMENTS     "gso-max-segments"
+#define NM_SETTING_LINK_GRO_MAX_SIZE         "gro-max-size"
+#define NM_SETTING_LINK_NEIGHBORS            "neighbors"
+#define NM_SETTING_LINK_FDB_ENTRIES          "fdb-entries"
+#define NM_SETTING_LINK_RPS_CPUS             "rps-cpus"
+#define NM_SETTING_LINK_RPS_FLOW_COUNT       "rps-flow-count"
+#define NM_SETTING_LINK_XPS_CPUS             "xps-cpus"
+#define NM_SETTING_LINK_IRQ_AFFINITY         "irq-affinity"
+#define NM_SETTING_LINK_GSO_IPV4_MAX_SIZE    "gso-ipv4-max-size"
+#define NM_SETTING_LINK_GRO_IPV4_MAX_SIZE    "gro-ipv4-max-size"
+#define NM_SETTING_LINK_NAPI_THREADED        "napi-threaded"
+#define NM_SETTING_LINK_NAPI_DEFER_HARD_IRQS "napi-defer-hard-irqs"
+#define NM_SETTING_LINK_GRO_FLUSH_TIMEOUT    "gro-flush-timeout"
+#define NM_SETTING_LINK_XDP_PROGRAM          "xdp-program"
+#define NM_SETTING_LINK_XDP_MODE             "xdp-mode"
 
 typedef struct _NMSettingLinkClass NMSettingLinkClass;
 
@@ -47,6 +60,45 @@ gint64 nm_setting_link_get_gso_max_segments(NMSettingLink *setting);
 NM_AVAILABLE_IN_1_44
 gint64 nm_setting_link_get_gro_max_size(NMSettingLink *setting);
 
+NM_AVAILABLE_IN_1_58
+const char *const *nm_setting_link_get_neighbors(NMSettingLink *setting, guint *length);
+NM_AVAILABLE_IN_1_58
+void nm_setting_link_add_neighbor(NMSettingLink *setting, const char *neighbor);
+NM_AVAILABLE_IN_1_58
+gboolean nm_setting_link_remove_neighbor_by_value(NMSettingLink *setting, const char *neighbor);
+
+NM_AVAILABLE_IN_1_58
+const char *const *nm_setting_link_get_fdb_entries(NMSettingLink *setting, guint *length);
+NM_AVAILABLE_IN_1_58
+void nm_setting_link_add_fdb_entry(NMSettingLink *setting, const char *fdb_entry);
+NM_AVAILABLE_IN_1_58
+gboolean nm_setting_link_remove_fdb_entry_by_value(NMSettingLink *setting, const char *fdb_entry);
+
+NM_AVAILABLE_IN_1_58
+const char *nm_setting_link_get_rps_cpus(NMSettingLink *setting);
+NM_AVAILABLE_IN_1_58
+gint64 nm_setting_link_get_rps_flow_count(NMSettingLink *setting);
+NM_AVAILABLE_IN_1_58
+const char *nm_setting_link_get_xps_cpus(NMSettingLink *setting);
+NM_AVAILABLE_IN_1_58
+const char *nm_setting_link_get_irq_affinity(NMSettingLink *setting);
+
+NM_AVAILABLE_IN_1_58
+gint64 nm_setting_link_get_gso_ipv4_max_size(NMSettingLink *setting);
+NM_AVAILABLE_IN_1_58
+gint64 nm_setting_link_get_gro_ipv4_max_size(NMSettingLink *setting);
+NM_AVAILABLE_IN_1_58
+gint64 nm_setting_link_get_napi_threaded(NMSettingLink *setting);
+NM_AVAILABLE_IN_1_58
+gint64 nm_setting_link_get_napi_defer_hard_irqs(NMSettingLink *setting);
+NM_AVAILABLE_IN_1_58
+gint64 nm_setting_link_get_gro_flush_timeout(NMSettingLink *setting);
+
+NM_AVAILABLE_IN_1_58
+const char *nm_setting_link_get_xdp_program(NMSettingLink *setting);
+NM_AVAILABLE_IN_1_58
+const char *nm_setting_link_get_xdp_mode(NMSettingLink *setting);
+
 G_END_DECLS
 
 #endif /* __NM_SETTING_LINK_H__ */
@@ -240,6 +240,14 @@ typedef enum {
  */
 #define NM_VPN_PLUGIN_IP4_CONFIG_ROUTES "routes"
 
+/* array of uint8: custom routes in a compact form, for VPNs that push many
+ *         routes. Each route is a record of 4 bytes destination, 4 bytes
+ *         next hop and 4 bytes preferred source address (network byte order,
+ *         all-zero if unset) followed by one byte prefix length. If present,
+ *         NM_VPN_PLUGIN_IP4_CONFIG_ROUTES is ignored.
+ */
+#define NM_VPN_PLUGIN_IP4_CONFIG_ROUTES_PACKED "routes-packed"
+
 /* whether the previous IP4 routing configuration should be preserved. */
 #define NM_VPN_PLUGIN_IP4_CONFIG_PRESERVE_ROUTES "preserve-routes"
 
@@ -293,6 +301,14 @@ typedef enum {
  */
 #define NM_VPN_PLUGIN_IP6_CONFIG_ROUTES "routes"
 
+/* array of uint8: custom routes in a compact form, for VPNs that push many
+ *         routes. Each route is a record of 16 bytes destination, 16 bytes
+ *         next hop and 16 bytes preferred source address (network byte order,
+ *         all-zero if unset) followed by one byte prefix length. If present,
+ *         NM_VPN_PLUGIN_IP6_CONFIG_ROUTES is ignored.
+ */
+#define NM_VPN_PLUGIN_IP6_CONFIG_ROUTES_PACKED "routes-packed"
+
 /* whether the previous IP6 routing configuration should be preserved. */
 #define NM_VPN_PLUGIN_IP6_CONFIG_PRESERVE_ROUTES "preserve-routes"
 
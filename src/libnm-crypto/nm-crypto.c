@@ -11,6 +11,7 @@
 #include <strings.h>
 #include <unistd.h>
 #include <stdlib.h>
+#include <sys/stat.h>
 
 #include "libnm-glib-aux/nm-secret-utils.h"
 #include "libnm-glib-aux/nm-io-utils.h"
@@ -699,54 +700,189 @@ extract_pem_cert_data(const guint8 *contents,
     return TRUE;
 }
 
-gboolean
-nm_crypto_load_and_verify_certificate(const char         *file,
-                                      NMCryptoFileFormat *out_file_format,
-                                      GBytes            **out_certificate,
-                                      GError            **error)
+/*****************************************************************************/
+
+/* Parsing certificates and keys is expensive, and the same files get checked
+ * over and over again, for every profile that references them and on every
+ * activation. Remember the results per path, for as long as the file is
+ * unchanged. Results that depend on a password are not cached. */
+
+#define FILE_CACHE_MAX 256u
+
+typedef enum {
+    FILE_CACHE_TYPE_CERT,
+    FILE_CACHE_TYPE_PKCS12,
+    FILE_CACHE_TYPE_KEY,
+    _FILE_CACHE_TYPE_NUM,
+} FileCacheType;
+
+typedef struct {
+    dev_t           st_dev;
+    ino_t           st_ino;
+    off_t           st_size;
+    struct timespec st_mtim;
+    struct timespec st_ctim;
+} FileCacheId;
+
+typedef struct {
+    char              *error_msg;
+    NMCryptoFileFormat format;
+    int                error_code;
+    bool               is_encrypted : 1;
+    bool               valid : 1;
+} FileCacheResult;
+
+typedef struct {
+    FileCacheId     id;
+    FileCacheResult results[_FILE_CACHE_TYPE_NUM];
+    char            path[];
+} FileCacheEntry;
+
+G_LOCK_DEFINE_STATIC(gl_file_cache_lock);
+static GHashTable *gl_file_cache;
+
+static void
+_file_cache_entry_free(gpointer data)
 {
-    nm_auto_clear_secret_ptr NMSecretPtr contents = {0};
+    FileCacheEntry *entry = data;
+    int             i;
 
-    g_return_val_if_fail(file, FALSE);
-    nm_assert(!error || !*error);
+    for (i = 0; i < _FILE_CACHE_TYPE_NUM; i++)
+        g_free(entry->results[i].error_msg);
+    g_free(entry);
+}
 
-    if (!_nm_crypto_init(error))
-        goto out;
+static gboolean
+_file_cache_id_get(const char *path, FileCacheId *out_id)
+{
+    struct stat st;
 
-    if (!nm_utils_read_crypto_file(file, &contents, error))
-        goto out;
+    if (stat(path, &st) != 0 || !S_ISREG(st.st_mode))
+        return FALSE;
+
+    *out_id = (FileCacheId) {
+        .st_dev  = st.st_dev,
+        .st_ino  = st.st_ino,
+        .st_size = st.st_size,
+        .st_mtim = st.st_mtim,
+        .st_ctim = st.st_ctim,
+    };
+    return TRUE;
+}
+
+static gboolean
+_file_cache_id_equal(const FileCacheId *a, const FileCacheId *b)
+{
+    return a->st_dev == b->st_dev && a->st_ino == b->st_ino && a->st_size == b->st_size
+           && a->st_mtim.tv_sec == b->st_mtim.tv_sec && a->st_mtim.tv_nsec == b->st_mtim.tv_nsec
+           && a->st_ctim.tv_sec == b->st_ctim.tv_sec && a->st_ctim.tv_nsec == b->st_ctim.tv_nsec;
+}
+
+static gboolean
+_file_cache_get(const char         *path,
+                const FileCacheId  *id,
+                FileCacheType       type,
+                NMCryptoFileFormat *out_format,
+                gboolean           *out_is_encrypted,
+                GError            **error)
+{
+    const FileCacheEntry  *entry;
+    const FileCacheResult *result;
+
+    G_LOCK(gl_file_cache_lock);
 
-    if (contents.len == 0) {
+    entry = gl_file_cache ? g_hash_table_lookup(gl_file_cache, path) : NULL;
+    if (!entry || !_file_cache_id_equal(&entry->id, id) || !entry->results[type].valid) {
+        G_UNLOCK(gl_file_cache_lock);
+        return FALSE;
+    }
+
+    result = &entry->results[type];
+    NM_SET_OUT(out_format, result->format);
+    NM_SET_OUT(out_is_encrypted, result->is_encrypted);
+    if (result->error_msg)
+        g_set_error_literal(error, _NM_CRYPTO_ERROR, result->error_code, result->error_msg);
+
+    G_UNLOCK(gl_file_cache_lock);
+    return TRUE;
+}
+
+static void
+_file_cache_set(const char        *path,
+                const FileCacheId *id,
+                FileCacheType      type,
+                NMCryptoFileFormat format,
+                gboolean           is_encrypted,
+                const GError      *error)
+{
+    FileCacheEntry  *entry;
+    FileCacheResult *result;
+    gsize            l;
+
+    /* Only failures about the content are cached. Other errors, for example
+     * of the crypto library, might be temporary. */
+    if (error && error->domain != _NM_CRYPTO_ERROR)
+        return;
+
+    G_LOCK(gl_file_cache_lock);
+
+    if (!gl_file_cache) {
+        gl_file_cache =
+            g_hash_table_new_full(nm_str_hash, g_str_equal, NULL, _file_cache_entry_free);
+    }
+
+    entry = g_hash_table_lookup(gl_file_cache, path);
+    if (!entry || !_file_cache_id_equal(&entry->id, id)) {
+        if (!entry && g_hash_table_size(gl_file_cache) >= FILE_CACHE_MAX)
+            g_hash_table_remove_all(gl_file_cache);
+
+        l         = strlen(path) + 1;
+        entry     = g_malloc0(sizeof(FileCacheEntry) + l);
+        entry->id = *id;
+        memcpy(entry->path, path, l);
+        g_hash_table_replace(gl_file_cache, entry->path, entry);
+    }
+
+    result = &entry->results[type];
+    g_free(result->error_msg);
+    *result = (FileCacheResult) {
+        .format       = format,
+        .is_encrypted = is_encrypted,
+        .error_code   = error ? error->code : 0,
+        .error_msg    = error ? g_strdup(error->message) : NULL,
+        .valid        = TRUE,
+    };
+
+    G_UNLOCK(gl_file_cache_lock);
+}
+
+/*****************************************************************************/
+
+static NMCryptoFileFormat
+_certificate_get_format(const guint8 *data, gsize data_len, GError **error)
+{
+    if (data_len == 0) {
         g_set_error(error,
                     _NM_CRYPTO_ERROR,
                     _NM_CRYPTO_ERROR_INVALID_DATA,
                     _("Certificate file is empty"));
-        goto out;
+        return NM_CRYPTO_FILE_FORMAT_UNKNOWN;
     }
 
     /* Check for PKCS#12 */
-    if (nm_crypto_is_pkcs12_data(contents.bin, contents.len, NULL)) {
-        NM_SET_OUT(out_file_format, NM_CRYPTO_FILE_FORMAT_PKCS12);
-        NM_SET_OUT(out_certificate, nm_secret_copy_to_gbytes(contents.bin, contents.len));
-        return TRUE;
-    }
+    if (nm_crypto_is_pkcs12_data(data, data_len, NULL))
+        return NM_CRYPTO_FILE_FORMAT_PKCS12;
 
     /* Check for plain DER format */
-    if (contents.len > 2 && contents.bin[0] == 0x30 && contents.bin[1] == 0x82) {
-        if (_nm_crypto_verify_x509(contents.bin, contents.len, NULL)) {
-            NM_SET_OUT(out_file_format, NM_CRYPTO_FILE_FORMAT_X509);
-            NM_SET_OUT(out_certificate, nm_secret_copy_to_gbytes(contents.bin, contents.len));
-            return TRUE;
-        }
+    if (data_len > 2 && data[0] == 0x30 && data[1] == 0x82) {
+        if (_nm_crypto_verify_x509(data, data_len, NULL))
+            return NM_CRYPTO_FILE_FORMAT_X509;
     } else {
         nm_auto_clear_secret_ptr NMSecretPtr pem_cert = {0};
 
-        if (extract_pem_cert_data(contents.bin, contents.len, &pem_cert, NULL)) {
-            if (_nm_crypto_verify_x509(pem_cert.bin, pem_cert.len, NULL)) {
-                NM_SET_OUT(out_file_format, NM_CRYPTO_FILE_FORMAT_X509);
-                NM_SET_OUT(out_certificate, nm_secret_copy_to_gbytes(contents.bin, contents.len));
-                return TRUE;
-            }
+        if (extract_pem_cert_data(data, data_len, &pem_cert, NULL)) {
+            if (_nm_crypto_verify_x509(pem_cert.bin, pem_cert.len, NULL))
+                return NM_CRYPTO_FILE_FORMAT_X509;
         }
     }
 
@@ -754,6 +890,52 @@ nm_crypto_load_and_verify_certificate(const char         *file,
                 _NM_CRYPTO_ERROR,
                 _NM_CRYPTO_ERROR_INVALID_DATA,
                 _("Failed to recognize certificate"));
+    return NM_CRYPTO_FILE_FORMAT_UNKNOWN;
+}
+
+gboolean
+nm_crypto_load_and_verify_certificate(const char         *file,
+                                      NMCryptoFileFormat *out_file_format,
+                                      GBytes            **out_certificate,
+                                      GError            **error)
+{
+    nm_auto_clear_secret_ptr NMSecretPtr contents = {0};
+    gs_free_error GError                *local    = NULL;
+    NMCryptoFileFormat                   format;
+    FileCacheId                          id;
+    gboolean                             has_id;
+
+    g_return_val_if_fail(file, FALSE);
+    nm_assert(!error || !*error);
+
+    if (!_nm_crypto_init(error))
+        goto out;
+
+    /* Stat the file before reading it. If it changes in between, the next
+     * call sees a different ID. */
+    has_id = _file_cache_id_get(file, &id);
+
+    if (has_id && _file_cache_get(file, &id, FILE_CACHE_TYPE_CERT, &format, NULL, error)) {
+        if (format == NM_CRYPTO_FILE_FORMAT_UNKNOWN)
+            goto out;
+        if (out_certificate && !nm_utils_read_crypto_file(file, &contents, error))
+            goto out;
+    } else {
+        if (!nm_utils_read_crypto_file(file, &contents, error))
+            goto out;
+
+        format = _certificate_get_format(contents.bin, contents.len, &local);
+        if (has_id)
+            _file_cache_set(file, &id, FILE_CACHE_TYPE_CERT, format, FALSE, local);
+        if (format == NM_CRYPTO_FILE_FORMAT_UNKNOWN) {
+            g_propagate_error(error, g_steal_pointer(&local));
+            goto out;
+        }
+    }
+
+    NM_SET_OUT(out_file_format, format);
+    NM_SET_OUT(out_certificate, nm_secret_copy_to_gbytes(contents.bin, contents.len));
+    return TRUE;
 
 out:
     NM_SET_OUT(out_file_format, NM_CRYPTO_FILE_FORMAT_UNKNOWN);
@@ -795,16 +977,38 @@ gboolean
 nm_crypto_is_pkcs12_file(const char *file, GError **error)
 {
     nm_auto_clear_secret_ptr NMSecretPtr contents = {0};
+    gs_free_error GError                *local    = NULL;
+    NMCryptoFileFormat                   format;
+    FileCacheId                          id;
+    gboolean                             has_id;
+    gboolean                             success;
 
     g_return_val_if_fail(file != NULL, FALSE);
 
     if (!_nm_crypto_init(error))
         return FALSE;
 
+    has_id = _file_cache_id_get(file, &id);
+    if (has_id && _file_cache_get(file, &id, FILE_CACHE_TYPE_PKCS12, &format, NULL, error))
+        return format == NM_CRYPTO_FILE_FORMAT_PKCS12;
+
     if (!nm_utils_read_crypto_file(file, &contents, error))
         return FALSE;
 
-    return nm_crypto_is_pkcs12_data(contents.bin, contents.len, error);
+    success = nm_crypto_is_pkcs12_data(contents.bin, contents.len, &local);
+    if (has_id) {
+        _file_cache_set(file,
+                        &id,
+                        FILE_CACHE_TYPE_PKCS12,
+                        success ? NM_CRYPTO_FILE_FORMAT_PKCS12 : NM_CRYPTO_FILE_FORMAT_UNKNOWN,
+                        FALSE,
+                        local);
+    }
+    if (!success) {
+        g_propagate_error(error, g_steal_pointer(&local));
+        return FALSE;
+    }
+    return TRUE;
 }
 
 /* Verifies that a private key can be read, and if a password is given, that
@@ -873,20 +1077,49 @@ nm_crypto_verify_private_key(const char *filename,
                              GError    **error)
 {
     nm_auto_clear_secret_ptr NMSecretPtr contents = {0};
+    gs_free_error GError                *local    = NULL;
+    NMCryptoFileFormat                   format;
+    gboolean                             is_encrypted = FALSE;
+    FileCacheId                          id;
+    gboolean                             has_id;
 
     g_return_val_if_fail(filename != NULL, NM_CRYPTO_FILE_FORMAT_UNKNOWN);
 
     if (!_nm_crypto_init(error))
         return NM_CRYPTO_FILE_FORMAT_UNKNOWN;
 
+    if (password) {
+        if (!nm_utils_read_crypto_file(filename, &contents, error))
+            return NM_CRYPTO_FILE_FORMAT_UNKNOWN;
+
+        return nm_crypto_verify_private_key_data(contents.bin,
+                                                 contents.len,
+                                                 password,
+                                                 out_is_encrypted,
+                                                 error);
+    }
+
+    has_id = _file_cache_id_get(filename, &id);
+    if (has_id
+        && _file_cache_get(filename, &id, FILE_CACHE_TYPE_KEY, &format, &is_encrypted, error)) {
+        NM_SET_OUT(out_is_encrypted, is_encrypted);
+        return format;
+    }
+
     if (!nm_utils_read_crypto_file(filename, &contents, error))
         return NM_CRYPTO_FILE_FORMAT_UNKNOWN;
 
-    return nm_crypto_verify_private_key_data(contents.bin,
-                                             contents.len,
-                                             password,
-                                             out_is_encrypted,
-                                             error);
+    format = nm_crypto_verify_private_key_data(contents.bin,
+                                               contents.len,
+                                               NULL,
+                                               &is_encrypted,
+                                               &local);
+    if (has_id)
+        _file_cache_set(filename, &id, FILE_CACHE_TYPE_KEY, format, is_encrypted, local);
+    if (local)
+        g_propagate_error(error, g_steal_pointer(&local));
+    NM_SET_OUT(out_is_encrypted, is_encrypted);
+    return format;
 }
 
 gboolean
@@ -114,7 +114,7 @@ nm_dbus_connection_call_get(GDBusConnection              *dbus_connection,
                            object_path,
                            DBUS_INTERFACE_PROPERTIES,
                            "Get",
-                           g_variant_new("(s)", interface_name, property_name),
+                           g_variant_new("(ss)", interface_name, property_name),
                            G_VARIANT_TYPE("(v)"),
                            G_DBUS_CALL_FLAGS_NONE,
                            timeout_msec,
@@ -12,28 +12,185 @@
 
 /*****************************************************************************/
 
+/* The index keeps its entries and its interned objects in open addressing
+ * hash tables with linear probing. The hash of each member is stored in
+ * the member itself (NMDedupMultiEntry, NMDedupMultiHeadEntry and
+ * NMDedupMultiObj have padding for it) and next to the pointer in the table.
+ * That way, probing rarely needs to dereference other members and removing a
+ * member does not need to call the (costly) hash functions of the idx-type
+ * or of the object again, like a GHashTable would. */
+
+typedef gboolean (*DedupTableEqualFunc)(gconstpointer member, gconstpointer key);
+
+typedef struct {
+    gpointer *members;
+    guint    *hashes;
+    guint     size;
+    guint     len;
+} DedupTable;
+
+#define DEDUP_TABLE_SIZE_MIN 16u
+
 typedef struct {
-    /* the stack-allocated lookup entry. It has a compatible
-     * memory layout with NMDedupMultiEntry and NMDedupMultiHeadEntry.
-     *
-     * It is recognizable by having lst_entries_sentinel.next set to NULL.
-     * Contrary to the other entries, which have lst_entries.next
-     * always non-NULL.
-     * */
-    CList                      lst_entries_sentinel;
     const NMDedupMultiObj     *obj;
     const NMDedupMultiIdxType *idx_type;
     bool                       lookup_head;
-} LookupEntry;
+} EntryKey;
 
 struct _NMDedupMultiIndex {
-    int         ref_count;
-    GHashTable *idx_entries;
-    GHashTable *idx_objs;
+    int        ref_count;
+    DedupTable idx_entries;
+    DedupTable idx_objs;
 };
 
 /*****************************************************************************/
 
+static void
+_table_resize(DedupTable *table, guint size)
+{
+    gpointer *members  = table->members;
+    guint    *hashes   = table->hashes;
+    guint     size_old = table->size;
+    guint     mask;
+    guint     i;
+
+    nm_assert(size >= DEDUP_TABLE_SIZE_MIN);
+    nm_assert(nm_utils_is_power_of_two(size));
+    nm_assert(table->len < size);
+
+    table->members = g_malloc0(size * (sizeof(gpointer) + sizeof(guint)));
+    table->hashes  = (guint *) &table->members[size];
+    table->size    = size;
+
+    mask = size - 1u;
+    for (i = 0; i < size_old; i++) {
+        guint j;
+
+        if (!members[i])
+            continue;
+        j = hashes[i] & mask;
+        while (table->members[j])
+            j = (j + 1u) & mask;
+        table->members[j] = members[i];
+        table->hashes[j]  = hashes[i];
+    }
+
+    g_free(members);
+}
+
+static void
+_table_clear(DedupTable *table)
+{
+    nm_clear_g_free(&table->members);
+    table->hashes = NULL;
+    table->size   = 0;
+    table->len    = 0;
+}
+
+static gpointer
+_table_lookup(const DedupTable *table, guint hash, DedupTableEqualFunc equal, gconstpointer key)
+{
+    guint mask;
+    guint i;
+
+    if (table->len == 0)
+        return NULL;
+
+    mask = table->size - 1u;
+    for (i = hash & mask; table->members[i]; i = (i + 1u) & mask) {
+        if (table->hashes[i] == hash && equal(table->members[i], key))
+            return table->members[i];
+    }
+    return NULL;
+}
+
+static gboolean
+_table_contains(const DedupTable *table, guint hash, gconstpointer member)
+{
+    guint mask;
+    guint i;
+
+    if (table->len == 0)
+        return FALSE;
+
+    mask = table->size - 1u;
+    for (i = hash & mask; table->members[i]; i = (i + 1u) & mask) {
+        if (table->members[i] == member)
+            return TRUE;
+    }
+    return FALSE;
+}
+
+static void
+_table_add(DedupTable *table, guint hash, gpointer member)
+{
+    guint mask;
+    guint i;
+
+    nm_assert(member);
+    nm_assert(!_table_contains(table, hash, member));
+
+    /* keep the load factor below 3/4. */
+    if (4u * (table->len + 1u) > 3u * table->size)
+        _table_resize(table, NM_MAX(2u * table->size, DEDUP_TABLE_SIZE_MIN));
+
+    mask = table->size - 1u;
+    i    = hash & mask;
+    while (table->members[i])
+        i = (i + 1u) & mask;
+    table->members[i] = member;
+    table->hashes[i]  = hash;
+    table->len++;
+}
+
+static void
+_table_remove(DedupTable *table, guint hash, gconstpointer member)
+{
+    guint mask;
+    guint i;
+    guint j;
+
+    nm_assert(_table_contains(table, hash, member));
+
+    mask = table->size - 1u;
+    i    = hash & mask;
+    while (table->members[i] != member)
+        i = (i + 1u) & mask;
+
+    /* Backward shift deletion. Move up the following members of the cluster
+     * that are not at their home slot, so that no tombstones are needed. */
+    for (j = (i + 1u) & mask; table->members[j]; j = (j + 1u) & mask) {
+        const guint home = table->hashes[j] & mask;
+
+        if (i <= j ? (i < home && home <= j) : (i < home || home <= j))
+            continue;
+        table->members[i] = table->members[j];
+        table->hashes[i]  = table->hashes[j];
+        i                 = j;
+    }
+    table->members[i] = NULL;
+    table->len--;
+
+    if (table->len == 0)
+        _table_clear(table);
+    else if (table->size > DEDUP_TABLE_SIZE_MIN && 8u * table->len < table->size)
+        _table_resize(table, table->size / 2u);
+}
+
+static gpointer
+_table_get_any(const DedupTable *table)
+{
+    guint i;
+
+    for (i = 0; i < table->size; i++) {
+        if (table->members[i])
+            return table->members[i];
+    }
+    return NULL;
+}
+
+/*****************************************************************************/
+
 static void
 ASSERT_idx_type(const NMDedupMultiIdxType *idx_type)
 {
@@ -64,49 +221,6 @@ nm_dedup_multi_idx_type_init(NMDedupMultiIdxType *idx_type, const NMDedupMultiId
 
 /*****************************************************************************/
 
-static NMDedupMultiEntry *
-_entry_lookup_obj(const NMDedupMultiIndex   *self,
-                  const NMDedupMultiIdxType *idx_type,
-                  const NMDedupMultiObj     *obj)
-{
-    const LookupEntry stack_entry = {
-        .obj         = obj,
-        .idx_type    = idx_type,
-        .lookup_head = FALSE,
-    };
-
-    ASSERT_idx_type(idx_type);
-    return g_hash_table_lookup(self->idx_entries, &stack_entry);
-}
-
-static NMDedupMultiHeadEntry *
-_entry_lookup_head(const NMDedupMultiIndex   *self,
-                   const NMDedupMultiIdxType *idx_type,
-                   const NMDedupMultiObj     *obj)
-{
-    NMDedupMultiHeadEntry *head_entry;
-    const LookupEntry      stack_entry = {
-             .obj         = obj,
-             .idx_type    = idx_type,
-             .lookup_head = TRUE,
-    };
-
-    ASSERT_idx_type(idx_type);
-
-    if (!idx_type->klass->idx_obj_partition_equal) {
-        if (c_list_is_empty(&idx_type->lst_idx_head))
-            head_entry = NULL;
-        else {
-            nm_assert(c_list_length_is(&idx_type->lst_idx_head, 1));
-            head_entry = c_list_entry(idx_type->lst_idx_head.next, NMDedupMultiHeadEntry, lst_idx);
-        }
-        nm_assert(head_entry == g_hash_table_lookup(self->idx_entries, &stack_entry));
-        return head_entry;
-    }
-
-    return g_hash_table_lookup(self->idx_entries, &stack_entry);
-}
-
 static void
 _entry_unpack(const NMDedupMultiEntry    *entry,
               const NMDedupMultiIdxType **out_idx_type,
@@ -114,26 +228,19 @@ _entry_unpack(const NMDedupMultiEntry    *entry,
               gboolean                   *out_lookup_head)
 {
     const NMDedupMultiHeadEntry *head_entry;
-    const LookupEntry           *lookup_entry;
 
     nm_assert(entry);
 
-    G_STATIC_ASSERT_EXPR(G_STRUCT_OFFSET(LookupEntry, lst_entries_sentinel)
-                         == G_STRUCT_OFFSET(NMDedupMultiEntry, lst_entries));
     G_STATIC_ASSERT_EXPR(G_STRUCT_OFFSET(NMDedupMultiEntry, lst_entries)
                          == G_STRUCT_OFFSET(NMDedupMultiHeadEntry, lst_entries_head));
     G_STATIC_ASSERT_EXPR(G_STRUCT_OFFSET(NMDedupMultiEntry, obj)
                          == G_STRUCT_OFFSET(NMDedupMultiHeadEntry, idx_type));
     G_STATIC_ASSERT_EXPR(G_STRUCT_OFFSET(NMDedupMultiEntry, is_head)
                          == G_STRUCT_OFFSET(NMDedupMultiHeadEntry, is_head));
+    G_STATIC_ASSERT_EXPR(G_STRUCT_OFFSET(NMDedupMultiEntry, hash)
+                         == G_STRUCT_OFFSET(NMDedupMultiHeadEntry, hash));
 
-    if (!entry->lst_entries.next) {
-        /* the entry is stack-allocated by _entry_lookup(). */
-        lookup_entry     = (LookupEntry *) entry;
-        *out_obj         = lookup_entry->obj;
-        *out_idx_type    = lookup_entry->idx_type;
-        *out_lookup_head = lookup_entry->lookup_head;
-    } else if (entry->is_head) {
+    if (entry->is_head) {
         head_entry = (NMDedupMultiHeadEntry *) entry;
         nm_assert(!c_list_is_empty(&head_entry->lst_entries_head));
         *out_obj =
@@ -146,27 +253,22 @@ _entry_unpack(const NMDedupMultiEntry    *entry,
         *out_lookup_head = FALSE;
     }
 
-    nm_assert(NM_IN_SET(*out_lookup_head, FALSE, TRUE));
     ASSERT_idx_type(*out_idx_type);
+    nm_assert(*out_obj);
+}
+
+static guint
+_entry_hash(const NMDedupMultiIdxType *idx_type, const NMDedupMultiObj *obj, gboolean lookup_head)
+{
+    NMHashState h;
 
     /* for lookup of the head, we allow one to omit object, but only
      * if the idx_type does not partition the objects. Otherwise, we
      * require a obj to compare. */
-    nm_assert(!*out_lookup_head || (*out_obj || !(*out_idx_type)->klass->idx_obj_partition_equal));
+    nm_assert(!lookup_head || (obj || !idx_type->klass->idx_obj_partition_equal));
 
     /* lookup of the object requires always an object. */
-    nm_assert(*out_lookup_head || *out_obj);
-}
-
-static guint
-_dict_idx_entries_hash(const NMDedupMultiEntry *entry)
-{
-    const NMDedupMultiIdxType *idx_type;
-    const NMDedupMultiObj     *obj;
-    gboolean                   lookup_head;
-    NMHashState                h;
-
-    _entry_unpack(entry, &idx_type, &obj, &lookup_head);
+    nm_assert(lookup_head || obj);
 
     nm_hash_init(&h, 1914869417u);
     if (idx_type->klass->idx_obj_partition_hash_update) {
@@ -182,24 +284,85 @@ _dict_idx_entries_hash(const NMDedupMultiEntry *entry)
 }
 
 static gboolean
-_dict_idx_entries_equal(const NMDedupMultiEntry *entry_a, const NMDedupMultiEntry *entry_b)
+_entry_equal(gconstpointer member, gconstpointer key)
 {
-    const NMDedupMultiIdxType *idx_type_a, *idx_type_b;
-    const NMDedupMultiObj     *obj_a, *obj_b;
-    gboolean                   lookup_head_a, lookup_head_b;
+    const EntryKey            *k = key;
+    const NMDedupMultiIdxType *idx_type;
+    const NMDedupMultiObj     *obj;
+    gboolean                   lookup_head;
 
-    _entry_unpack(entry_a, &idx_type_a, &obj_a, &lookup_head_a);
-    _entry_unpack(entry_b, &idx_type_b, &obj_b, &lookup_head_b);
+    _entry_unpack(member, &idx_type, &obj, &lookup_head);
 
-    if (idx_type_a != idx_type_b || lookup_head_a != lookup_head_b)
+    if (idx_type != k->idx_type || lookup_head != k->lookup_head)
         return FALSE;
-    if (!nm_dedup_multi_idx_type_partition_equal(idx_type_a, obj_a, obj_b))
+    if (!nm_dedup_multi_idx_type_partition_equal(idx_type, obj, k->obj))
         return FALSE;
-    if (!lookup_head_a && !nm_dedup_multi_idx_type_id_equal(idx_type_a, obj_a, obj_b))
+    if (!lookup_head && !nm_dedup_multi_idx_type_id_equal(idx_type, obj, k->obj))
         return FALSE;
     return TRUE;
 }
 
+/* @out_hash: (optional): returns the hash of the entry, so that the caller
+ *   can add the entry without hashing again. */
+static NMDedupMultiEntry *
+_entry_lookup_obj(const NMDedupMultiIndex   *self,
+                  const NMDedupMultiIdxType *idx_type,
+                  const NMDedupMultiObj     *obj,
+                  guint                     *out_hash)
+{
+    const EntryKey key = {
+        .obj         = obj,
+        .idx_type    = idx_type,
+        .lookup_head = FALSE,
+    };
+    guint hash;
+
+    ASSERT_idx_type(idx_type);
+
+    hash = _entry_hash(idx_type, obj, FALSE);
+    NM_SET_OUT(out_hash, hash);
+    return _table_lookup(&self->idx_entries, hash, _entry_equal, &key);
+}
+
+/* @out_hash: (optional): returns the hash of the head entry or zero, if it
+ *   was not calculated. */
+static NMDedupMultiHeadEntry *
+_entry_lookup_head(const NMDedupMultiIndex   *self,
+                   const NMDedupMultiIdxType *idx_type,
+                   const NMDedupMultiObj     *obj,
+                   guint                     *out_hash)
+{
+    guint hash;
+    const EntryKey key = {
+        .obj         = obj,
+        .idx_type    = idx_type,
+        .lookup_head = TRUE,
+    };
+
+    ASSERT_idx_type(idx_type);
+
+    NM_SET_OUT(out_hash, 0);
+
+    if (!idx_type->klass->idx_obj_partition_equal) {
+        NMDedupMultiHeadEntry *head_entry = NULL;
+
+        if (!c_list_is_empty(&idx_type->lst_idx_head)) {
+            nm_assert(c_list_length_is(&idx_type->lst_idx_head, 1));
+            head_entry = c_list_entry(idx_type->lst_idx_head.next, NMDedupMultiHeadEntry, lst_idx);
+        }
+        nm_assert(head_entry
+                  == _table_lookup(&self->idx_entries,
+                                   _entry_hash(idx_type, obj, TRUE),
+                                   _entry_equal,
+                                   &key));
+        return head_entry;
+    }
+
+    hash = _entry_hash(idx_type, obj, TRUE);
+    NM_SET_OUT(out_hash, hash);
+    return _table_lookup(&self->idx_entries, hash, _entry_equal, &key);
+}
+
 /*****************************************************************************/
 
 static gboolean
@@ -207,6 +370,7 @@ _add(NMDedupMultiIndex        *self,
      NMDedupMultiIdxType      *idx_type,
      const NMDedupMultiObj    *obj,
      NMDedupMultiEntry        *entry,
+     guint                     entry_hash,
      NMDedupMultiIdxMode       mode,
      const NMDedupMultiEntry  *entry_order,
      NMDedupMultiHeadEntry    *head_existing,
@@ -216,6 +380,7 @@ _add(NMDedupMultiIndex        *self,
     NMDedupMultiHeadEntry *head_entry;
     const NMDedupMultiObj *obj_new, *obj_old;
     gboolean               add_head_entry = FALSE;
+    guint                  head_hash      = 0;
 
     nm_assert(self);
     ASSERT_idx_type(idx_type);
@@ -307,7 +472,7 @@ _add(NMDedupMultiIndex        *self,
     obj_new = nm_dedup_multi_index_obj_intern(self, obj);
 
     if (!head_existing)
-        head_entry = _entry_lookup_head(self, idx_type, obj_new);
+        head_entry = _entry_lookup_head(self, idx_type, obj_new, &head_hash);
     else if (head_existing == NM_DEDUP_MULTI_HEAD_ENTRY_MISSING)
         head_entry = NULL;
     else
@@ -317,6 +482,7 @@ _add(NMDedupMultiIndex        *self,
         head_entry           = g_slice_new0(NMDedupMultiHeadEntry);
         head_entry->is_head  = TRUE;
         head_entry->idx_type = idx_type;
+        head_entry->hash     = head_hash ?: _entry_hash(idx_type, obj_new, TRUE);
         c_list_init(&head_entry->lst_entries_head);
         c_list_link_tail(&idx_type->lst_idx_head, &head_entry->lst_idx);
         add_head_entry = TRUE;
@@ -333,6 +499,7 @@ _add(NMDedupMultiIndex        *self,
     entry       = g_slice_new0(NMDedupMultiEntry);
     entry->obj  = obj_new;
     entry->head = head_entry;
+    entry->hash = entry_hash ?: _entry_hash(idx_type, obj_new, FALSE);
 
     switch (mode) {
     case NM_DEDUP_MULTI_IDX_MODE_PREPEND:
@@ -353,11 +520,10 @@ _add(NMDedupMultiIndex        *self,
     idx_type->len++;
     head_entry->len++;
 
-    if (add_head_entry && !g_hash_table_add(self->idx_entries, head_entry))
-        nm_assert_not_reached();
+    if (add_head_entry)
+        _table_add(&self->idx_entries, head_entry->hash, head_entry);
 
-    if (!g_hash_table_add(self->idx_entries, entry))
-        nm_assert_not_reached();
+    _table_add(&self->idx_entries, entry->hash, entry);
 
     NM_SET_OUT(out_entry, entry);
     NM_SET_OUT(out_obj_old, NULL);
@@ -373,6 +539,7 @@ nm_dedup_multi_index_add(NMDedupMultiIndex                         *self,
                          /* const NMDedupMultiObj ** */ gpointer    out_obj_old)
 {
     NMDedupMultiEntry *entry;
+    guint              entry_hash;
 
     g_return_val_if_fail(self, FALSE);
     g_return_val_if_fail(idx_type, FALSE);
@@ -384,8 +551,8 @@ nm_dedup_multi_index_add(NMDedupMultiIndex                         *self,
                                    NM_DEDUP_MULTI_IDX_MODE_APPEND_FORCE),
                          FALSE);
 
-    entry = _entry_lookup_obj(self, idx_type, obj);
-    return _add(self, idx_type, obj, entry, mode, NULL, NULL, out_entry, out_obj_old);
+    entry = _entry_lookup_obj(self, idx_type, obj, &entry_hash);
+    return _add(self, idx_type, obj, entry, entry_hash, mode, NULL, NULL, out_entry, out_obj_old);
 }
 
 /* nm_dedup_multi_index_add_full:
@@ -434,6 +601,7 @@ nm_dedup_multi_index_add_full(NMDedupMultiIndex                         *self,
                               /* const NMDedupMultiObj ** */ gpointer    out_obj_old)
 {
     NMDedupMultiEntry *entry;
+    guint              entry_hash = 0;
 
     g_return_val_if_fail(self, FALSE);
     g_return_val_if_fail(idx_type, FALSE);
@@ -446,18 +614,19 @@ nm_dedup_multi_index_add_full(NMDedupMultiIndex                         *self,
                          FALSE);
 
     if (entry_existing == NULL)
-        entry = _entry_lookup_obj(self, idx_type, obj);
+        entry = _entry_lookup_obj(self, idx_type, obj, &entry_hash);
     else if (entry_existing == NM_DEDUP_MULTI_ENTRY_MISSING) {
-        nm_assert(!_entry_lookup_obj(self, idx_type, obj));
+        nm_assert(!_entry_lookup_obj(self, idx_type, obj, NULL));
         entry = NULL;
     } else {
-        nm_assert(entry_existing == _entry_lookup_obj(self, idx_type, obj));
+        nm_assert(entry_existing == _entry_lookup_obj(self, idx_type, obj, NULL));
         entry = (NMDedupMultiEntry *) entry_existing;
     }
     return _add(self,
                 idx_type,
                 obj,
                 entry,
+                entry_hash,
                 mode,
                 entry_order,
                 (NMDedupMultiHeadEntry *) head_existing,
@@ -479,14 +648,14 @@ _remove_entry(NMDedupMultiIndex *self, NMDedupMultiEntry *entry, gboolean *out_h
     nm_assert(entry->obj);
     nm_assert(entry->head);
     nm_assert(!c_list_is_empty(&entry->lst_entries));
-    nm_assert(g_hash_table_lookup(self->idx_entries, entry) == entry);
+    nm_assert(_table_contains(&self->idx_entries, entry->hash, entry));
 
     head_entry = (NMDedupMultiHeadEntry *) entry->head;
     obj        = entry->obj;
 
     nm_assert(head_entry);
     nm_assert(head_entry->len > 0);
-    nm_assert(g_hash_table_lookup(self->idx_entries, head_entry) == head_entry);
+    nm_assert(_table_contains(&self->idx_entries, head_entry->hash, head_entry));
 
     idx_type = (NMDedupMultiIdxType *) head_entry->idx_type;
     ASSERT_idx_type(idx_type);
@@ -500,11 +669,10 @@ _remove_entry(NMDedupMultiIndex *self, NMDedupMultiEntry *entry, gboolean *out_h
 
     NM_SET_OUT(out_head_entry_removed, head_entry != NULL);
 
-    if (!g_hash_table_remove(self->idx_entries, entry))
-        nm_assert_not_reached();
+    _table_remove(&self->idx_entries, entry->hash, entry);
 
-    if (head_entry && !g_hash_table_remove(self->idx_entries, head_entry))
-        nm_assert_not_reached();
+    if (head_entry)
+        _table_remove(&self->idx_entries, head_entry->hash, head_entry);
 
     c_list_unlink_stale(&entry->lst_entries);
     g_slice_free(NMDedupMultiEntry, entry);
@@ -532,7 +700,7 @@ _remove_head(NMDedupMultiIndex     *self,
     nm_assert(head_entry);
     nm_assert(head_entry->len > 0);
     nm_assert(head_entry->len == c_list_length(&head_entry->lst_entries_head));
-    nm_assert(g_hash_table_lookup(self->idx_entries, head_entry) == head_entry);
+    nm_assert(_table_contains(&self->idx_entries, head_entry->hash, head_entry));
 
     n = 0;
     c_list_for_each_safe (iter_entry, iter_entry_safe, &head_entry->lst_entries_head) {
@@ -652,7 +820,7 @@ nm_dedup_multi_index_lookup_obj(const NMDedupMultiIndex                   *self,
     g_return_val_if_fail(obj, FALSE);
 
     nm_assert(idx_type && idx_type->klass);
-    return _entry_lookup_obj(self, idx_type, obj);
+    return _entry_lookup_obj(self, idx_type, obj, NULL);
 }
 
 /**
@@ -676,7 +844,7 @@ nm_dedup_multi_index_lookup_head(const NMDedupMultiIndex                   *self
     g_return_val_if_fail(self, FALSE);
     g_return_val_if_fail(idx_type, FALSE);
 
-    return _entry_lookup_head(self, idx_type, obj);
+    return _entry_lookup_head(self, idx_type, obj, NULL);
 }
 
 /*****************************************************************************/
@@ -692,7 +860,7 @@ nm_dedup_multi_index_dirty_set_head(NMDedupMultiIndex                         *s
     g_return_if_fail(self);
     g_return_if_fail(idx_type);
 
-    head_entry = _entry_lookup_head(self, idx_type, obj);
+    head_entry = _entry_lookup_head(self, idx_type, obj, NULL);
     if (!head_entry)
         return;
 
@@ -763,8 +931,11 @@ _dict_idx_objs_hash(const NMDedupMultiObj *obj)
 }
 
 static gboolean
-_dict_idx_objs_equal(const NMDedupMultiObj *obj_a, const NMDedupMultiObj *obj_b)
+_dict_idx_objs_equal(gconstpointer member, gconstpointer key)
 {
+    const NMDedupMultiObj *obj_a = member;
+    const NMDedupMultiObj *obj_b = key;
+
     return obj_a == obj_b
            || (obj_a->klass == obj_b->klass && obj_a->klass->obj_full_equal(obj_a, obj_b));
 }
@@ -773,24 +944,30 @@ void
 nm_dedup_multi_index_obj_release(NMDedupMultiIndex                          *self,
                                  /* const NMDedupMultiObj * */ gconstpointer obj)
 {
+    const NMDedupMultiObj *o = obj;
+
     nm_assert(self);
-    nm_assert(obj);
-    nm_assert(g_hash_table_lookup(self->idx_objs, obj) == obj);
-    nm_assert(((const NMDedupMultiObj *) obj)->_multi_idx == self);
+    nm_assert(o);
+    nm_assert(o->_multi_idx == self);
+    nm_assert(o->_hash == _dict_idx_objs_hash(o));
 
-    ((NMDedupMultiObj *) obj)->_multi_idx = NULL;
-    if (!g_hash_table_remove(self->idx_objs, obj))
-        nm_assert_not_reached();
+    ((NMDedupMultiObj *) o)->_multi_idx = NULL;
+    _table_remove(&self->idx_objs, o->_hash, o);
 }
 
 gconstpointer
 nm_dedup_multi_index_obj_find(NMDedupMultiIndex                          *self,
                               /* const NMDedupMultiObj * */ gconstpointer obj)
 {
+    const NMDedupMultiObj *o = obj;
+
     g_return_val_if_fail(self, NULL);
-    g_return_val_if_fail(obj, NULL);
+    g_return_val_if_fail(o, NULL);
+
+    if (o->_multi_idx == self)
+        return o;
 
-    return g_hash_table_lookup(self->idx_objs, obj);
+    return _table_lookup(&self->idx_objs, _dict_idx_objs_hash(o), _dict_idx_objs_equal, o);
 }
 
 gconstpointer
@@ -799,17 +976,19 @@ nm_dedup_multi_index_obj_intern(NMDedupMultiIndex                          *self
 {
     const NMDedupMultiObj *obj_new = obj;
     const NMDedupMultiObj *obj_old;
+    guint                  hash;
 
     nm_assert(self);
     nm_assert(obj_new);
 
     if (obj_new->_multi_idx == self) {
-        nm_assert(g_hash_table_lookup(self->idx_objs, obj_new) == obj_new);
+        nm_assert(_table_contains(&self->idx_objs, obj_new->_hash, obj_new));
         nm_dedup_multi_obj_ref(obj_new);
         return obj_new;
     }
 
-    obj_old = g_hash_table_lookup(self->idx_objs, obj_new);
+    hash    = _dict_idx_objs_hash(obj_new);
+    obj_old = _table_lookup(&self->idx_objs, hash, _dict_idx_objs_equal, obj_new);
     nm_assert(obj_old != obj_new);
 
     if (obj_old) {
@@ -826,8 +1005,8 @@ nm_dedup_multi_index_obj_intern(NMDedupMultiIndex                          *self
     nm_assert(obj_new);
     nm_assert(!obj_new->_multi_idx);
 
-    if (!g_hash_table_add(self->idx_objs, (gpointer) obj_new))
-        nm_assert_not_reached();
+    ((NMDedupMultiObj *) obj_new)->_hash = hash;
+    _table_add(&self->idx_objs, hash, (gpointer) obj_new);
 
     ((NMDedupMultiObj *) obj_new)->_multi_idx = self;
     return obj_new;
@@ -1006,11 +1185,7 @@ nm_dedup_multi_index_new(void)
 
     self  = g_slice_new(NMDedupMultiIndex);
     *self = (NMDedupMultiIndex) {
-        .ref_count   = 1,
-        .idx_entries = g_hash_table_new((GHashFunc) _dict_idx_entries_hash,
-                                        (GEqualFunc) _dict_idx_entries_equal),
-        .idx_objs =
-            g_hash_table_new((GHashFunc) _dict_idx_objs_hash, (GEqualFunc) _dict_idx_objs_equal),
+        .ref_count = 1,
     };
     return self;
 }
@@ -1029,10 +1204,10 @@ nm_dedup_multi_index_ref(NMDedupMultiIndex *self)
 NMDedupMultiIndex *
 nm_dedup_multi_index_unref(NMDedupMultiIndex *self)
 {
-    GHashTableIter             iter;
     const NMDedupMultiIdxType *idx_type;
     NMDedupMultiEntry         *entry;
-    const NMDedupMultiObj     *obj;
+    NMDedupMultiObj           *obj;
+    guint                      i;
 
     g_return_val_if_fail(self, NULL);
     g_return_val_if_fail(self->ref_count > 0, NULL);
@@ -1040,29 +1215,61 @@ nm_dedup_multi_index_unref(NMDedupMultiIndex *self)
     if (--self->ref_count > 0)
         return NULL;
 
-more:
-    g_hash_table_iter_init(&iter, self->idx_entries);
-    while (g_hash_table_iter_next(&iter, (gpointer *) &entry, NULL)) {
+    while ((entry = _table_get_any(&self->idx_entries))) {
         if (entry->is_head)
             idx_type = ((NMDedupMultiHeadEntry *) entry)->idx_type;
         else
             idx_type = entry->head->idx_type;
         _remove_idx_entry(self, (NMDedupMultiIdxType *) idx_type, TRUE, FALSE);
-        goto more;
     }
 
-    nm_assert(g_hash_table_size(self->idx_entries) == 0);
+    nm_assert(self->idx_entries.len == 0);
 
-    g_hash_table_iter_init(&iter, self->idx_objs);
-    while (g_hash_table_iter_next(&iter, (gpointer *) &obj, NULL)) {
-        nm_assert(obj->_multi_idx == self);
-        ((NMDedupMultiObj *) obj)->_multi_idx = NULL;
+    for (i = 0; i < self->idx_objs.size; i++) {
+        obj = self->idx_objs.members[i];
+        if (obj) {
+            nm_assert(obj->_multi_idx == self);
+            obj->_multi_idx = NULL;
+        }
     }
-    g_hash_table_remove_all(self->idx_objs);
 
-    g_hash_table_unref(self->idx_entries);
-    g_hash_table_unref(self->idx_objs);
+    _table_clear(&self->idx_entries);
+    _table_clear(&self->idx_objs);
 
     g_slice_free(NMDedupMultiIndex, self);
     return NULL;
 }
+
+/*****************************************************************************/
+
+/**
+ * nm_dedup_multi_index_get_stats:
+ * @self: the #NMDedupMultiIndex
+ * @out_n_objs: (out) (optional): the number of interned objects.
+ * @out_n_heads: (out) (optional): the number of head entries.
+ * @out_n_entries: (out) (optional): the number of entries (not counting heads).
+ *
+ * This iterates over all entries, so it is only for diagnostics.
+ */
+void
+nm_dedup_multi_index_get_stats(const NMDedupMultiIndex *self,
+                               guint                   *out_n_objs,
+                               guint                   *out_n_heads,
+                               guint                   *out_n_entries)
+{
+    const NMDedupMultiEntry *entry;
+    guint                    n_heads = 0;
+    guint                    i;
+
+    g_return_if_fail(self);
+
+    for (i = 0; i < self->idx_entries.size; i++) {
+        entry = self->idx_entries.members[i];
+        if (entry && entry->is_head)
+            n_heads++;
+    }
+
+    NM_SET_OUT(out_n_objs, self->idx_objs.len);
+    NM_SET_OUT(out_n_heads, n_heads);
+    NM_SET_OUT(out_n_entries, self->idx_entries.len - n_heads);
+}
@@ -46,6 +46,10 @@ struct _NMDedupMultiObj {
     };
     NMDedupMultiIndex *_multi_idx;
     guint              _ref_count;
+
+    /* the hash of obj_full_hash_update(). It is only valid while the object
+     * is interned in _multi_idx. It fits into the padding of the struct. */
+    guint _hash;
 } _nm_align(_NMDedupMultiObj_Align);
 
 struct _NMDedupMultiObjClass {
@@ -199,6 +203,9 @@ struct _NMDedupMultiEntry {
     bool is_head;
     bool dirty;
 
+    /* the hash of the entry in the NMDedupMultiIndex. Internal. */
+    guint hash;
+
     const NMDedupMultiHeadEntry *head;
 };
 
@@ -211,6 +218,9 @@ struct _NMDedupMultiHeadEntry {
 
     bool is_head;
 
+    /* the hash of the head entry in the NMDedupMultiIndex. Internal. */
+    guint hash;
+
     guint len;
 
     CList lst_idx;
@@ -246,6 +256,11 @@ NMDedupMultiIndex *nm_dedup_multi_index_new(void);
 NMDedupMultiIndex *nm_dedup_multi_index_ref(NMDedupMultiIndex *self);
 NMDedupMultiIndex *nm_dedup_multi_index_unref(NMDedupMultiIndex *self);
 
+void nm_dedup_multi_index_get_stats(const NMDedupMultiIndex *self,
+                                    guint                   *out_n_objs,
+                                    guint                   *out_n_heads,
+                                    guint                   *out_n_entries);
+
 static inline void
 _nm_auto_unref_dedup_multi_index(NMDedupMultiIndex **v)
 {
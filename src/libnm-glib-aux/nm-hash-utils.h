@@ -46,8 +46,8 @@ void nm_hash_siphash42_init(CSipHash *h, guint static_seed);
  * Note, that this is guaranteed to use siphash42 under the hood (contrary to
  * all other NMHash API, which leave this undefined). That matters at the point,
  * where the caller needs to be sure that a reasonably strong hashing algorithm
- * is used.  (Yes, NMHash is all about siphash42, but otherwise that is not promised
- * anywhere).
+ * is used. (By default, the other NMHash API uses the faster siphash13, see
+ * NM_HASH_SIPHASH13).
  *
  * Another difference is, that this returns guint64 (not guint like other NMHash functions).
  *
@@ -72,6 +72,18 @@ nm_hash_siphash42(guint static_seed, const void *ptr, gsize n)
 
 /*****************************************************************************/
 
+/* The nm_hash*() API does not promise a particular algorithm. It is only
+ * used for hash tables with a randomized seed, so by default the cheaper
+ * SipHash-1-3 is used (which is also what other hash table implementations
+ * settled on). Configure with "-Dhash_siphash13=false" to use SipHash-2-4. */
+#if defined(NM_HASH_SIPHASH13) && !NM_HASH_SIPHASH13
+#define _nm_hash_siphash_append   c_siphash_append
+#define _nm_hash_siphash_finalize c_siphash_finalize
+#else
+#define _nm_hash_siphash_append   c_siphash_append_13
+#define _nm_hash_siphash_finalize c_siphash_finalize_13
+#endif
+
 struct _NMHashState {
     CSipHash _state;
 };
@@ -99,10 +111,10 @@ nm_hash_complete_u64(NMHashState *state)
      * - the type, guint64 vs. guint.
      * - nm_hash_complete() never returns zero.
      *
-     * In practice, nm_hash*() API is implemented via siphash24, so this returns
-     * the siphash24 value. But that is not guaranteed by the API, and if you need
-     * siphash24 directly, use c_siphash_*() and nm_hash_siphash42*() API. */
-    return c_siphash_finalize(&state->_state);
+     * In practice, nm_hash*() API is implemented via siphash13 (or siphash24),
+     * so this returns the siphash value. But that is not guaranteed by the API, and
+     * if you need siphash24 directly, use c_siphash_*() and nm_hash_siphash42*() API. */
+    return _nm_hash_siphash_finalize(&state->_state);
 }
 
 static inline guint
@@ -126,10 +138,10 @@ nm_hash_update(NMHashState *state, const void *ptr, gsize n)
 
     /* Note: the data passed in here might be sensitive data (secrets),
      * that we should nm_explicit_bzero() afterwards. However, since
-     * we are using siphash24 with a random key, that is not really
+     * we are using siphash with a random key, that is not really
      * necessary. Something to keep in mind, if we ever move away from
      * this hash implementation. */
-    c_siphash_append(&state->_state, ptr, n);
+    _nm_hash_siphash_append(&state->_state, ptr, n);
 }
 
 #define _NM_HASH_COMBINE_VALS_TYPE_OP(x, idx, op_arg) typeof(x) _v##idx;
@@ -23,12 +23,35 @@ struct _NMKeyFileDB {
     GKeyFile              *kf;
     guint                  ref_count;
 
+    /* the generation of the content last passed to a writer. Only
+     * accessed from the main thread. */
+    guint64 write_gen;
+
+    /* serializes the writing of the file, and protects written_gen. The
+     * asynchronous writer skips writing content that is older than what
+     * is already on disk. */
+    GMutex  write_lock;
+    guint64 written_gen;
+
+    /* the keys that changed since the last write, or %NULL if the file
+     * needs to be rewritten. */
+    GHashTable *dirty_keys;
+
+    /* the expected size of the file on disk, or -1 if unknown. And the
+     * size after the last rewrite. */
+    gint64 file_size;
+    gint64 file_size_compact;
+
     bool is_started : 1;
     bool dirty : 1;
     bool destroyed : 1;
 
     bool groups_pruned : 1;
 
+    bool write_in_progress : 1;
+    bool write_pending : 1;
+    bool do_sync : 1;
+
     char filename[];
 };
 
@@ -99,6 +122,8 @@ nm_key_file_db_new(const char            *filename,
     self->got_dirty_fcn = got_dirty_fcn;
     self->user_data     = user_data;
     self->kf            = _key_file_new();
+    self->file_size     = -1;
+    g_mutex_init(&self->write_lock);
     memcpy(self->filename, filename, l_filename + 1);
     self->group_name = &self->filename[l_filename + 1];
     memcpy((char *) self->group_name, group_name, l_group + 1);
@@ -131,6 +156,8 @@ nm_key_file_db_unref(NMKeyFileDB *self)
         return;
 
     g_key_file_unref(self->kf);
+    nm_clear_pointer(&self->dirty_keys, g_hash_table_unref);
+    g_mutex_clear(&self->write_lock);
 
     g_free(self);
 }
@@ -166,6 +193,35 @@ nm_key_file_db_destroy(NMKeyFileDB *self)
 
 /*****************************************************************************/
 
+static void
+_drop_appended_duplicates(NMKeyFileDB *self)
+{
+    gs_strfreev char **keys = NULL;
+    GKeyFile          *kf;
+    gsize              n_keys;
+    gsize              i;
+
+    /* A key that was appended to the file is listed multiple times, and only
+     * the last value counts. Copy the keys to a new instance, so that the old
+     * values don't show up again when a key gets removed. Empty values mark
+     * removed keys. */
+    keys = g_key_file_get_keys(self->kf, self->group_name, &n_keys, NULL);
+    if (!keys)
+        return;
+
+    kf = _key_file_new();
+    for (i = 0; i < n_keys; i++) {
+        gs_free char *value = NULL;
+
+        value = g_key_file_get_value(self->kf, self->group_name, keys[i], NULL);
+        if (value && value[0])
+            g_key_file_set_value(kf, self->group_name, keys[i], value);
+    }
+
+    g_key_file_unref(self->kf);
+    self->kf = kf;
+}
+
 /* nm_key_file_db_start() is supposed to be called right away, after creating the
  * instance.
  *
@@ -196,6 +252,11 @@ nm_key_file_db_start(NMKeyFileDB *self)
         return;
     }
 
+    /* lines are appended to the file. After a crash, the last line might be
+     * incomplete. Drop it. */
+    while (contents_len > 0 && contents[contents_len - 1] != '\n')
+        contents_len--;
+
     if (!g_key_file_load_from_data(self->kf,
                                    contents,
                                    contents_len,
@@ -205,6 +266,8 @@ nm_key_file_db_start(NMKeyFileDB *self)
         return;
     }
 
+    _drop_appended_duplicates(self);
+
     _LOGD("loaded keyfile-db for \"%s\"", self->filename);
 }
 
@@ -246,12 +309,26 @@ nm_key_file_db_get_string_list(NMKeyFileDB *self, const char *key, gsize *out_le
 
 /*****************************************************************************/
 
+static void
+_track_dirty_key(NMKeyFileDB *self, const char *key)
+{
+    if (self->file_size < 0)
+        return;
+
+    if (!self->dirty_keys)
+        self->dirty_keys = g_hash_table_new_full(nm_str_hash, g_str_equal, g_free, NULL);
+    if (!g_hash_table_contains(self->dirty_keys, key))
+        g_hash_table_add(self->dirty_keys, g_strdup(key));
+}
+
 static void
 _got_dirty(NMKeyFileDB *self, const char *key)
 {
     nm_assert(_IS_KEY_FILE_DB(self, TRUE, FALSE));
     nm_assert(!self->dirty);
 
+    _track_dirty_key(self, key);
+
     _LOGD("updated entry for %s.%s", self->group_name, key);
 
     self->dirty = TRUE;
@@ -281,6 +358,8 @@ nm_key_file_db_remove_key(NMKeyFileDB *self, const char *key)
 
     if (got_dirty)
         _got_dirty(self, key);
+    else if (self->dirty)
+        _track_dirty_key(self, key);
 }
 
 void
@@ -318,6 +397,8 @@ nm_key_file_db_set_value(NMKeyFileDB *self, const char *key, const char *value)
 
     if (got_dirty)
         _got_dirty(self, key);
+    else if (self->dirty)
+        _track_dirty_key(self, key);
 }
 
 void
@@ -361,14 +442,177 @@ nm_key_file_db_set_string_list(NMKeyFileDB       *self,
 
     if (got_dirty)
         _got_dirty(self, key);
+    else if (self->dirty)
+        _track_dirty_key(self, key);
 }
 
 /*****************************************************************************/
 
+/* nm_key_file_db_set_sync:
+ * @self: the #NMKeyFileDB
+ * @do_sync: whether each update should be synced to disk.
+ *
+ * When the file is rewritten, it is written to a temporary file and renamed.
+ * When replacing an existing file, the new content is always synced before
+ * the rename. With @do_sync, also the directory is synced after the rename,
+ * and appended records are synced right away, so that the update survives
+ * a crash.
+ */
+void
+nm_key_file_db_set_sync(NMKeyFileDB *self, gboolean do_sync)
+{
+    g_return_if_fail(_IS_KEY_FILE_DB(self, FALSE, FALSE));
+
+    self->do_sync = do_sync;
+}
+
+static gboolean
+_write_file(const char *filename,
+            const char *contents,
+            gsize       len,
+            gboolean    do_sync,
+            GError    **error)
+{
+    gs_free char     *dirname = NULL;
+    nm_auto_close int fd      = -1;
+    int               errsv;
+
+    if (!nm_utils_file_set_contents(filename, contents, len, 0666, NULL, NULL, NULL, error))
+        return FALSE;
+
+    if (!do_sync)
+        return TRUE;
+
+    dirname = g_path_get_dirname(filename);
+    fd      = open(dirname, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (fd < 0 || fsync(fd) != 0) {
+        errsv = errno;
+        g_set_error(error,
+                    G_FILE_ERROR,
+                    g_file_error_from_errno(errsv),
+                    "failed to sync directory %s: %s",
+                    dirname,
+                    nm_strerror_native(errsv));
+        return FALSE;
+    }
+    return TRUE;
+}
+
+static gboolean
+_append_file(const char *filename,
+             const char *contents,
+             gsize       len,
+             gint64      expected_size,
+             gboolean    do_sync,
+             GError    **error)
+{
+    nm_auto_close int fd = -1;
+    struct stat       st;
+    gssize            n;
+    int               errsv;
+
+    fd = open(filename, O_WRONLY | O_APPEND | O_CLOEXEC);
+    if (fd < 0)
+        goto fail_errno;
+
+    if (fstat(fd, &st) != 0)
+        goto fail_errno;
+
+    if (st.st_size != expected_size) {
+        /* somebody else modified the file. It needs to be rewritten. */
+        g_set_error(error,
+                    G_FILE_ERROR,
+                    G_FILE_ERROR_FAILED,
+                    "file %s was modified unexpectedly",
+                    filename);
+        return FALSE;
+    }
+
+    while (len > 0) {
+        n = write(fd, contents, len);
+        if (n < 0) {
+            if (errno == EINTR)
+                continue;
+            goto fail_errno;
+        }
+        contents += n;
+        len -= n;
+    }
+
+    if (do_sync && fdatasync(fd) != 0)
+        goto fail_errno;
+
+    return TRUE;
+
+fail_errno:
+    errsv = errno;
+    g_set_error(error,
+                G_FILE_ERROR,
+                g_file_error_from_errno(errsv),
+                "failed to append to file %s: %s",
+                filename,
+                nm_strerror_native(errsv));
+    return FALSE;
+}
+
+/* Instead of rewriting the whole file on each change, the changed keys are
+ * appended to the file as new lines. GKeyFile uses the last line of a key,
+ * and nm_key_file_db_start() drops the duplicates and a truncated last line.
+ * Once the appended lines are larger than the compacted content, the file
+ * is rewritten. */
+#define APPEND_MIN_SIZE 4096
+
+static char *
+_to_data(NMKeyFileDB *self, gboolean *out_append, gsize *out_len)
+{
+    nm_auto_free_gstring GString  *str  = NULL;
+    gs_unref_hashtable GHashTable *keys = NULL;
+    GHashTableIter                 iter;
+    const char                    *key;
+    char                          *contents;
+
+    keys = g_steal_pointer(&self->dirty_keys);
+
+    if (keys && self->file_size >= 0
+        && self->file_size - self->file_size_compact
+               < NM_MAX(self->file_size_compact, (gint64) APPEND_MIN_SIZE)) {
+        str = g_string_new(NULL);
+        g_hash_table_iter_init(&iter, keys);
+        while (g_hash_table_iter_next(&iter, (gpointer *) &key, NULL)) {
+            gs_free char *value = NULL;
+
+            /* an empty value marks a removed key. */
+            value = g_key_file_get_value(self->kf, self->group_name, key, NULL);
+            g_string_append_printf(str, "%s=%s\n", key, value ?: "");
+        }
+        *out_append = TRUE;
+        *out_len    = str->len;
+        self->file_size += str->len;
+        return g_string_free(g_steal_pointer(&str), FALSE);
+    }
+
+    contents    = g_key_file_to_data(self->kf, out_len, NULL);
+    *out_append = FALSE;
+
+    /* without the group header, lines cannot be appended. */
+    if (g_key_file_has_group(self->kf, self->group_name)) {
+        self->file_size         = *out_len;
+        self->file_size_compact = *out_len;
+    } else
+        self->file_size = -1;
+
+    return contents;
+}
+
 void
 nm_key_file_db_to_file(NMKeyFileDB *self, gboolean force)
 {
-    gs_free_error GError *error = NULL;
+    gs_free_error GError *error    = NULL;
+    gs_free char         *contents = NULL;
+    gint64                expected_size;
+    gboolean              append;
+    gsize                 len;
+    gboolean              success;
 
     g_return_if_fail(_IS_KEY_FILE_DB(self, TRUE, FALSE));
 
@@ -377,10 +621,166 @@ nm_key_file_db_to_file(NMKeyFileDB *self, gboolean force)
 
     self->dirty = FALSE;
 
-    if (!g_key_file_save_to_file(self->kf, self->filename, &error)) {
+    expected_size = self->file_size;
+    contents      = _to_data(self, &append, &len);
+
+    g_mutex_lock(&self->write_lock);
+    if (append)
+        success = _append_file(self->filename, contents, len, expected_size, self->do_sync, &error);
+    else
+        success = _write_file(self->filename, contents, len, self->do_sync, &error);
+    self->written_gen = ++self->write_gen;
+    g_mutex_unlock(&self->write_lock);
+
+    if (!success) {
+        self->file_size = -1;
         _LOGD("failure to write keyfile \"%s\": %s", self->filename, error->message);
     } else
-        _LOGD("write keyfile: \"%s\"", self->filename);
+        _LOGD("%s keyfile: \"%s\"", append ? "append to" : "write", self->filename);
+}
+
+typedef struct {
+    NMKeyFileDB *self;
+    char        *contents;
+    gsize        len;
+    gint64       expected_size;
+    guint64      gen;
+    bool         do_sync : 1;
+    bool         append : 1;
+} WriteData;
+
+static void
+_write_data_free(gpointer user_data)
+{
+    WriteData *write_data = user_data;
+
+    g_free(write_data->contents);
+    nm_g_slice_free(write_data);
+}
+
+static void
+_write_thread_fcn(GTask        *task,
+                  gpointer      source_object,
+                  gpointer      task_data,
+                  GCancellable *cancellable)
+{
+    WriteData   *write_data = task_data;
+    NMKeyFileDB *self       = write_data->self;
+    GError      *error      = NULL;
+    gboolean     success    = TRUE;
+
+    /* this runs on a worker thread. @self is kept alive by the callback's
+     * reference, but only the write lock and written_gen may be accessed. */
+    g_mutex_lock(&self->write_lock);
+    if (self->written_gen < write_data->gen) {
+        if (write_data->append) {
+            success = _append_file(self->filename,
+                                   write_data->contents,
+                                   write_data->len,
+                                   write_data->expected_size,
+                                   write_data->do_sync,
+                                   &error);
+        } else {
+            success = _write_file(self->filename,
+                                  write_data->contents,
+                                  write_data->len,
+                                  write_data->do_sync,
+                                  &error);
+        }
+        self->written_gen = write_data->gen;
+    }
+    g_mutex_unlock(&self->write_lock);
+
+    if (!success)
+        g_task_return_error(task, error);
+    else
+        g_task_return_boolean(task, TRUE);
+}
+
+static void
+_write_done_cb(GObject *source, GAsyncResult *result, gpointer user_data)
+{
+    NMKeyFileDB          *self       = user_data;
+    WriteData            *write_data = g_task_get_task_data(G_TASK(result));
+    gs_free_error GError *error      = NULL;
+
+    self->write_in_progress = FALSE;
+
+    if (self->destroyed) {
+        /* the owner wrote the final content synchronously and is gone. */
+        g_task_propagate_boolean(G_TASK(result), NULL);
+        nm_key_file_db_unref(self);
+        return;
+    }
+
+    if (!g_task_propagate_boolean(G_TASK(result), &error)) {
+        _LOGD("failure to write keyfile \"%s\": %s", self->filename, error->message);
+
+        /* the content on disk is unknown. Rewrite the file. */
+        self->file_size = -1;
+        if (!self->dirty) {
+            self->dirty         = TRUE;
+            self->write_pending = TRUE;
+        }
+    } else {
+        _LOGD("%s keyfile: \"%s\"",
+              write_data->append ? "append to" : "write",
+              self->filename);
+    }
+
+    if (self->write_pending) {
+        self->write_pending = FALSE;
+        nm_key_file_db_to_file_async(self);
+    }
+
+    nm_key_file_db_unref(self);
+}
+
+/* nm_key_file_db_to_file_async:
+ * @self: the #NMKeyFileDB
+ *
+ * Like nm_key_file_db_to_file() without force, but the file gets written
+ * on a worker thread. While a write is in progress, further requests are
+ * coalesced into one write after it completes.
+ *
+ * A later nm_key_file_db_to_file() takes precedence over writes that are
+ * still in progress, so that the owner can always flush the latest content
+ * synchronously before exiting.
+ */
+void
+nm_key_file_db_to_file_async(NMKeyFileDB *self)
+{
+    GTask     *task;
+    WriteData *write_data;
+    gboolean   append;
+
+    g_return_if_fail(_IS_KEY_FILE_DB(self, TRUE, FALSE));
+
+    if (!self->dirty)
+        return;
+
+    if (self->write_in_progress) {
+        self->write_pending = TRUE;
+        return;
+    }
+
+    self->dirty             = FALSE;
+    self->write_in_progress = TRUE;
+
+    write_data  = g_slice_new(WriteData);
+    *write_data = (WriteData){
+        .self          = self,
+        .expected_size = self->file_size,
+        .gen           = ++self->write_gen,
+        .do_sync       = self->do_sync,
+    };
+    write_data->contents = _to_data(self, &append, &write_data->len);
+    write_data->append   = append;
+
+    task = g_task_new(NULL, NULL, _write_done_cb, nm_key_file_db_ref(self));
+    g_task_set_task_data(task, write_data, _write_data_free);
+    g_task_run_in_thread(task, _write_thread_fcn);
+    g_object_unref(task);
 }
 
 /*****************************************************************************/
@@ -441,6 +841,9 @@ nm_key_file_db_prune(NMKeyFileDB *self,
 
     _LOGD("prune keyfile of old entries: \"%s\"", self->filename);
 
+    /* removed keys are not tracked. Rewrite the file next time. */
+    self->file_size = -1;
+
     if (!self->groups_pruned) {
         /* When we prune the first time, we swap the GKeyFile instance.
          * The instance loaded from disk might have unrelated groups and
@@ -48,8 +48,12 @@ void nm_key_file_db_set_string_list(NMKeyFileDB       *self,
                                     const char *const *value,
                                     gssize             len);
 
+void nm_key_file_db_set_sync(NMKeyFileDB *self, gboolean do_sync);
+
 void nm_key_file_db_to_file(NMKeyFileDB *self, gboolean force);
 
+void nm_key_file_db_to_file_async(NMKeyFileDB *self);
+
 void nm_key_file_db_prune_tmp_files(NMKeyFileDB *self);
 
 void nm_key_file_db_prune(NMKeyFileDB *self,
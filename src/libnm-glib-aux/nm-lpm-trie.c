@@ -0,0 +1,346 @@
+/* SPDX-License-Identifier: LGPL-2.1-or-later */
+
+#include "libnm-glib-aux/nm-default-glib-i18n-lib.h"
+
+#include "nm-lpm-trie.h"
+
+/*****************************************************************************/
+
+#define KEY_BITS_MAX 128u
+
+typedef struct _NMLpmTrieNode NMLpmTrieNode;
+
+struct _NMLpmTrieNode {
+    NMLpmTrieNode *child[2];
+    gpointer       value;
+    /* The prefix of the node. The bits after @plen are always zero. */
+    guint8 key[KEY_BITS_MAX / 8];
+    guint8 plen;
+    bool   has_value : 1;
+};
+
+struct _NMLpmTrie {
+    NMLpmTrieNode *root;
+    GDestroyNotify value_destroy;
+    guint          size;
+    guint8         key_bits;
+};
+
+/*****************************************************************************/
+
+static inline guint
+_key_bit(const guint8 *key, guint idx)
+{
+    return (key[idx / 8u] >> (7u - (idx % 8u))) & 1u;
+}
+
+/* Returns the number of leading bits that @a and @b have in common, up to
+ * @max_bits. */
+static guint
+_key_common_bits(const guint8 *a, const guint8 *b, guint max_bits)
+{
+    guint i;
+
+    for (i = 0; i * 8u < max_bits; i++) {
+        const guint x = a[i] ^ b[i];
+
+        /* @x only has the lowest 8 bits of the 32 bit integer set. */
+        if (x != 0)
+            return NM_MIN(i * 8u + ((guint) __builtin_clz(x) - 24u), max_bits);
+    }
+    return max_bits;
+}
+
+static NMLpmTrieNode *
+_node_new(const guint8 *key, guint plen)
+{
+    NMLpmTrieNode *node;
+    guint          n;
+
+    node       = g_slice_new0(NMLpmTrieNode);
+    node->plen = plen;
+
+    n = plen / 8u;
+    memcpy(node->key, key, n);
+    if (plen % 8u != 0)
+        node->key[n] = key[n] & (0xFFu << (8u - (plen % 8u)));
+
+    return node;
+}
+
+static void
+_node_clear_value(NMLpmTrie *trie, NMLpmTrieNode *node)
+{
+    gpointer value;
+
+    nm_assert(node->has_value);
+
+    value           = g_steal_pointer(&node->value);
+    node->has_value = FALSE;
+    trie->size--;
+    if (trie->value_destroy)
+        trie->value_destroy(value);
+}
+
+static void
+_node_free_all(NMLpmTrie *trie, NMLpmTrieNode *node)
+{
+    if (!node)
+        return;
+
+    _node_free_all(trie, node->child[0]);
+    _node_free_all(trie, node->child[1]);
+    if (node->has_value)
+        _node_clear_value(trie, node);
+    g_slice_free(NMLpmTrieNode, node);
+}
+
+/*****************************************************************************/
+
+/**
+ * nm_lpm_trie_new:
+ * @key_bits: the length of the keys in bits, for example 32 for IPv4
+ *   addresses. At most 128.
+ * @value_destroy: (nullable): called for values that get removed
+ *   or replaced.
+ *
+ * Returns: (transfer full): a new, empty trie.
+ */
+NMLpmTrie *
+nm_lpm_trie_new(guint key_bits, GDestroyNotify value_destroy)
+{
+    NMLpmTrie *trie;
+
+    g_return_val_if_fail(key_bits > 0 && key_bits <= KEY_BITS_MAX && key_bits % 8u == 0, NULL);
+
+    trie  = g_slice_new(NMLpmTrie);
+    *trie = (NMLpmTrie) {
+        .value_destroy = value_destroy,
+        .key_bits      = key_bits,
+    };
+    return trie;
+}
+
+void
+nm_lpm_trie_free(NMLpmTrie *trie)
+{
+    if (!trie)
+        return;
+
+    _node_free_all(trie, g_steal_pointer(&trie->root));
+    nm_assert(trie->size == 0);
+    g_slice_free(NMLpmTrie, trie);
+}
+
+guint
+nm_lpm_trie_get_size(const NMLpmTrie *trie)
+{
+    return trie ? trie->size : 0u;
+}
+
+/**
+ * nm_lpm_trie_insert:
+ * @trie: the #NMLpmTrie
+ * @key: the key. Bits after @plen are ignored.
+ * @plen: the prefix length.
+ * @value: the value for the prefix.
+ *
+ * Sets @value for the prefix. If the prefix already had a value,
+ * it gets replaced.
+ *
+ * Returns: %TRUE if the prefix had no value before.
+ */
+gboolean
+nm_lpm_trie_insert(NMLpmTrie *trie, gconstpointer key, guint plen, gpointer value)
+{
+    NMLpmTrieNode **slot;
+    NMLpmTrieNode  *node;
+    NMLpmTrieNode  *node_new;
+
+    g_return_val_if_fail(trie, FALSE);
+    g_return_val_if_fail(key, FALSE);
+    g_return_val_if_fail(plen <= trie->key_bits, FALSE);
+
+    slot = &trie->root;
+    while ((node = *slot)) {
+        const guint n_common = _key_common_bits(node->key, key, NM_MIN(node->plen, plen));
+
+        if (n_common == node->plen) {
+            if (node->plen == plen) {
+                if (node->has_value) {
+                    if (trie->value_destroy)
+                        trie->value_destroy(node->value);
+                    node->value = value;
+                    return FALSE;
+                }
+                node->value     = value;
+                node->has_value = TRUE;
+                trie->size++;
+                return TRUE;
+            }
+
+            /* @node is a prefix of @key. Go deeper. */
+            slot = &node->child[_key_bit(key, node->plen)];
+            continue;
+        }
+
+        /* The paths diverge, or @key is a prefix of @node. Split. */
+        node_new = _node_new(key, plen);
+        if (n_common == plen) {
+            node_new->child[_key_bit(node->key, plen)] = node;
+            *slot                                      = node_new;
+        } else {
+            NMLpmTrieNode *node_join;
+
+            node_join                                       = _node_new(key, n_common);
+            node_join->child[_key_bit(node->key, n_common)] = node;
+            node_join->child[_key_bit(key, n_common)]       = node_new;
+            *slot                                           = node_join;
+        }
+        goto out;
+    }
+
+    node_new = _node_new(key, plen);
+    *slot    = node_new;
+
+out:
+    node_new->value     = value;
+    node_new->has_value = TRUE;
+    trie->size++;
+    return TRUE;
+}
+
+/**
+ * nm_lpm_trie_remove:
+ * @trie: the #NMLpmTrie
+ * @key: the key. Bits after @plen are ignored.
+ * @plen: the prefix length.
+ *
+ * Returns: %TRUE if the prefix had a value, which is now removed.
+ */
+gboolean
+nm_lpm_trie_remove(NMLpmTrie *trie, gconstpointer key, guint plen)
+{
+    NMLpmTrieNode **slot;
+    NMLpmTrieNode **slot_parent = NULL;
+    NMLpmTrieNode  *node;
+    NMLpmTrieNode  *node_parent;
+
+    g_return_val_if_fail(trie, FALSE);
+    g_return_val_if_fail(key, FALSE);
+    g_return_val_if_fail(plen <= trie->key_bits, FALSE);
+
+    slot = &trie->root;
+    while (TRUE) {
+        node = *slot;
+        if (!node || node->plen > plen || _key_common_bits(node->key, key, node->plen) < node->plen)
+            return FALSE;
+        if (node->plen == plen)
+            break;
+        slot_parent = slot;
+        slot        = &node->child[_key_bit(key, node->plen)];
+    }
+
+    if (!node->has_value)
+        return FALSE;
+
+    _node_clear_value(trie, node);
+
+    if (node->child[0] && node->child[1]) {
+        /* The node is still needed to join the two children. */
+        return TRUE;
+    }
+
+    *slot = node->child[0] ?: node->child[1];
+    g_slice_free(NMLpmTrieNode, node);
+
+    if (*slot || !slot_parent)
+        return TRUE;
+
+    /* The parent lost a child. If it has no value, it is no longer
+     * needed either. */
+    node_parent = *slot_parent;
+    if (!node_parent->has_value) {
+        *slot_parent = node_parent->child[0] ?: node_parent->child[1];
+        g_slice_free(NMLpmTrieNode, node_parent);
+    }
+    return TRUE;
+}
+
+gboolean
+nm_lpm_trie_lookup_exact(const NMLpmTrie *trie, gconstpointer key, guint plen, gpointer *out_value)
+{
+    const NMLpmTrieNode *node;
+
+    g_return_val_if_fail(trie, FALSE);
+    g_return_val_if_fail(key, FALSE);
+
+    node = trie->root;
+    while (node) {
+        if (node->plen > plen || _key_common_bits(node->key, key, node->plen) < node->plen)
+            break;
+        if (node->plen == plen) {
+            if (!node->has_value)
+                break;
+            NM_SET_OUT(out_value, node->value);
+            return TRUE;
+        }
+        node = node->child[_key_bit(key, node->plen)];
+    }
+
+    NM_SET_OUT(out_value, NULL);
+    return FALSE;
+}
+
+/**
+ * nm_lpm_trie_lookup_full:
+ * @trie: the #NMLpmTrie
+ * @addr: the address to look up. It has the full key length.
+ * @match_func: (nullable): if set, called for the prefixes that
+ *   contain @addr, starting with the longest. The first prefix for
+ *   which it returns %TRUE is the result.
+ * @user_data: user data for @match_func.
+ * @out_plen: (out) (optional): the prefix length of the result.
+ * @out_value: (out) (optional): the value of the result.
+ *
+ * Returns: %TRUE if a (matching) prefix that contains @addr was found.
+ */
+gboolean
+nm_lpm_trie_lookup_full(const NMLpmTrie   *trie,
+                        gconstpointer      addr,
+                        NMLpmTrieMatchFunc match_func,
+                        gpointer           user_data,
+                        guint             *out_plen,
+                        gpointer          *out_value)
+{
+    const NMLpmTrieNode *matches[KEY_BITS_MAX + 1];
+    const NMLpmTrieNode *node;
+    guint                n_matches = 0;
+
+    g_return_val_if_fail(trie, FALSE);
+    g_return_val_if_fail(addr, FALSE);
+
+    node = trie->root;
+    while (node) {
+        if (_key_common_bits(node->key, addr, node->plen) < node->plen)
+            break;
+        if (node->has_value)
+            matches[n_matches++] = node;
+        if (node->plen >= trie->key_bits)
+            break;
+        node = node->child[_key_bit(addr, node->plen)];
+    }
+
+    while (n_matches > 0) {
+        node = matches[--n_matches];
+        if (!match_func || match_func(node->key, node->plen, node->value, user_data)) {
+            NM_SET_OUT(out_plen, node->plen);
+            NM_SET_OUT(out_value, node->value);
+            return TRUE;
+        }
+    }
+
+    NM_SET_OUT(out_plen, 0);
+    NM_SET_OUT(out_value, NULL);
+    return FALSE;
+}
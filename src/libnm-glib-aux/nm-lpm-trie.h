@@ -0,0 +1,54 @@
+/* SPDX-License-Identifier: LGPL-2.1-or-later */
+
+#ifndef __NM_LPM_TRIE_H__
+#define __NM_LPM_TRIE_H__
+
+/*****************************************************************************/
+
+/* A path-compressed binary trie for longest prefix matches, for example
+ * of IPv4 or IPv6 route destinations. Keys are in network byte order and
+ * up to 128 bits long. Each prefix (key and prefix length) can hold one
+ * value.
+ *
+ * Insert, remove and lookup are O(key length), independent of the number
+ * of entries. */
+
+typedef struct _NMLpmTrie NMLpmTrie;
+
+/* Called by nm_lpm_trie_lookup_full() for the matching prefixes, starting
+ * with the longest one. Return %TRUE to accept the match. */
+typedef gboolean (*NMLpmTrieMatchFunc)(gconstpointer key,
+                                       guint         plen,
+                                       gpointer      value,
+                                       gpointer      user_data);
+
+NMLpmTrie *nm_lpm_trie_new(guint key_bits, GDestroyNotify value_destroy);
+
+void nm_lpm_trie_free(NMLpmTrie *trie);
+
+NM_AUTO_DEFINE_FCN0(NMLpmTrie *, _nm_auto_free_lpm_trie, nm_lpm_trie_free);
+#define nm_auto_free_lpm_trie nm_auto(_nm_auto_free_lpm_trie)
+
+guint nm_lpm_trie_get_size(const NMLpmTrie *trie);
+
+gboolean nm_lpm_trie_insert(NMLpmTrie *trie, gconstpointer key, guint plen, gpointer value);
+
+gboolean nm_lpm_trie_remove(NMLpmTrie *trie, gconstpointer key, guint plen);
+
+gboolean
+nm_lpm_trie_lookup_exact(const NMLpmTrie *trie, gconstpointer key, guint plen, gpointer *out_value);
+
+gboolean nm_lpm_trie_lookup_full(const NMLpmTrie   *trie,
+                                 gconstpointer      addr,
+                                 NMLpmTrieMatchFunc match_func,
+                                 gpointer           user_data,
+                                 guint             *out_plen,
+                                 gpointer          *out_value);
+
+static inline gboolean
+nm_lpm_trie_lookup(const NMLpmTrie *trie, gconstpointer addr, guint *out_plen, gpointer *out_value)
+{
+    return nm_lpm_trie_lookup_full(trie, addr, NULL, NULL, out_plen, out_value);
+}
+
+#endif /* __NM_LPM_TRIE_H__ */
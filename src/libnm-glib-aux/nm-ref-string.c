@@ -213,6 +213,39 @@ nmtst_ref_string_find_len(const char *cstr, gsize len)
     return rstr;
 }
 
+/**
+ * nm_ref_string_get_stats:
+ * @out_n: (out) (optional): the number of interned strings.
+ * @out_bytes: (out) (optional): the approximate memory used by them,
+ *   not counting the overhead of the hash table.
+ *
+ * This iterates over all strings, so it is only for diagnostics.
+ */
+void
+nm_ref_string_get_stats(guint *out_n, gsize *out_bytes)
+{
+    GHashTableIter     iter;
+    const NMRefString *rstr;
+    guint              n     = 0;
+    gsize              bytes = 0;
+
+    G_LOCK(gl_lock);
+
+    if (gl_hash) {
+        n = g_hash_table_size(gl_hash);
+        if (out_bytes) {
+            g_hash_table_iter_init(&iter, gl_hash);
+            while (g_hash_table_iter_next(&iter, (gpointer *) &rstr, NULL))
+                bytes += (G_STRUCT_OFFSET(NMRefString, str) + 1u) + rstr->len;
+        }
+    }
+
+    G_UNLOCK(gl_lock);
+
+    NM_SET_OUT(out_n, n);
+    NM_SET_OUT(out_bytes, bytes);
+}
+
 void
 _nm_ref_string_unref_slow_path(NMRefString *rstr)
 {
@@ -44,6 +44,8 @@ nm_ref_string_new(const char *cstr)
     return cstr ? nm_ref_string_new_len(cstr, strlen(cstr)) : NULL;
 }
 
+void nm_ref_string_get_stats(guint *out_n, gsize *out_bytes);
+
 /*****************************************************************************/
 
 NMRefString *nmtst_ref_string_find_len(const char *cstr, gsize len);
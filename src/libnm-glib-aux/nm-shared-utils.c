@@ -7518,3 +7518,103 @@ nm_utils_env_var_decode_name(const char *name, GString *str_buffer)
 
     return TRUE;
 }
+
+/*****************************************************************************/
+
+/**
+ * nm_utils_cpu_list_parse:
+ * @str: a list of CPUs, in the format of "/sys/devices/system/cpu/online"
+ *   and "taskset --cpu-list". For example "0-3,8,10-11".
+ *
+ * Returns: (transfer full): a sorted #GArray of the guint CPU numbers,
+ *   without duplicates. %NULL if @str is not a valid, non-empty list.
+ */
+GArray *
+nm_utils_cpu_list_parse(const char *str)
+{
+    gs_free const char **tokens = NULL;
+    GArray              *cpus;
+    gsize                i;
+    guint                j;
+
+    tokens = nm_strsplit_set(str, ",");
+    if (!tokens)
+        return NULL;
+
+    G_STATIC_ASSERT_EXPR(sizeof(guint) == sizeof(guint32));
+
+    cpus = g_array_new(FALSE, FALSE, sizeof(guint));
+    for (i = 0; tokens[i]; i++) {
+        const char *s = tokens[i];
+        const char *s_end;
+        gint64      first;
+        gint64      last;
+
+        s_end = strchr(s, '-');
+        if (s_end) {
+            gs_free char *s_first = g_strndup(s, s_end - s);
+
+            first = _nm_utils_ascii_str_to_int64(s_first, 10, 0, NM_UTILS_CPU_MAX, -1);
+            last  = _nm_utils_ascii_str_to_int64(s_end + 1, 10, 0, NM_UTILS_CPU_MAX, -1);
+        } else {
+            first = _nm_utils_ascii_str_to_int64(s, 10, 0, NM_UTILS_CPU_MAX, -1);
+            last  = first;
+        }
+
+        if (first < 0 || last < first) {
+            g_array_unref(cpus);
+            return NULL;
+        }
+
+        for (; first <= last; first++) {
+            const guint cpu = first;
+
+            g_array_append_val(cpus, cpu);
+        }
+    }
+
+    g_array_sort_with_data(cpus, nm_cmp_uint32_p_with_data, NULL);
+    for (i = 1, j = 1; i < cpus->len; i++) {
+        if (nm_g_array_index(cpus, guint, i) != nm_g_array_index(cpus, guint, j - 1))
+            nm_g_array_index(cpus, guint, j++) = nm_g_array_index(cpus, guint, i);
+    }
+    g_array_set_size(cpus, j);
+
+    return cpus;
+}
+
+/**
+ * nm_utils_cpu_mask_to_string:
+ * @cpus: the CPU numbers, at most %NM_UTILS_CPU_MAX.
+ * @n_cpus: the number of CPUs in @cpus.
+ *
+ * Returns: (transfer full): the CPU mask in the hexadecimal format of
+ *   sysfs, like "rps_cpus" and "/proc/irq/N/smp_affinity". That is
+ *   32-bit words separated by commas, for example "1,00000003" for the
+ *   CPUs 0, 1 and 32.
+ */
+char *
+nm_utils_cpu_mask_to_string(const guint *cpus, guint n_cpus)
+{
+    gs_free guint32 *words = NULL;
+    GString         *str;
+    guint            n_words;
+    guint            i;
+
+    n_words = 1;
+    for (i = 0; i < n_cpus; i++) {
+        nm_assert(cpus[i] <= NM_UTILS_CPU_MAX);
+        n_words = NM_MAX(n_words, cpus[i] / 32u + 1u);
+    }
+
+    words = g_new0(guint32, n_words);
+    for (i = 0; i < n_cpus; i++)
+        words[cpus[i] / 32u] |= (((guint32) 1u) << (cpus[i] % 32u));
+
+    str = g_string_sized_new(n_words * 9u);
+    g_string_append_printf(str, "%x", words[n_words - 1]);
+    for (i = n_words - 1; i > 0; i--)
+        g_string_append_printf(str, ",%08x", words[i - 1]);
+
+    return g_string_free(str, FALSE);
+}
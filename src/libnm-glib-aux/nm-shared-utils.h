@@ -3553,4 +3553,13 @@ gboolean nm_utils_poll_finish(GAsyncResult *result, gpointer *probe_user_data, G
 void     nm_utils_env_var_encode_name(const char *key, GString *str_buffer);
 gboolean nm_utils_env_var_decode_name(const char *name, GString *str_buffer);
 
+/*****************************************************************************/
+
+/* The largest CPU number that nm_utils_cpu_list_parse() accepts. */
+#define NM_UTILS_CPU_MAX 8191u
+
+GArray *nm_utils_cpu_list_parse(const char *str);
+
+char *nm_utils_cpu_mask_to_string(const guint *cpus, guint n_cpus);
+
 #endif /* __NM_SHARED_UTILS_H__ */
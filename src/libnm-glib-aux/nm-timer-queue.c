@@ -0,0 +1,126 @@
+/* SPDX-License-Identifier: LGPL-2.1-or-later */
+
+#include "libnm-glib-aux/nm-default-glib-i18n-lib.h"
+
+#include "nm-timer-queue.h"
+
+#include "nm-time-utils.h"
+
+/*****************************************************************************/
+
+static struct {
+    NMPrioq  prioq;
+    GSource *source;
+    gint64   source_expiry_msec;
+} _tq = {
+    .prioq = NM_PRIOQ_ZERO,
+};
+
+/*****************************************************************************/
+
+static int
+_entry_cmp(gconstpointer a, gconstpointer b)
+{
+    const NMTimerQueueEntry *entry_a = a;
+    const NMTimerQueueEntry *entry_b = b;
+
+    NM_CMP_FIELD(entry_a, entry_b, _priv.expiry_msec);
+    NM_CMP_DIRECT_PTR(entry_a, entry_b);
+    return 0;
+}
+
+static gboolean _timeout_cb(gpointer user_data);
+
+static void
+_reschedule(void)
+{
+    NMTimerQueueEntry *entry;
+
+    entry = nm_prioq_peek(&_tq.prioq);
+    if (!entry) {
+        nm_clear_g_source_inst(&_tq.source);
+        return;
+    }
+
+    nm_g_timeout_reschedule(&_tq.source,
+                            &_tq.source_expiry_msec,
+                            entry->_priv.expiry_msec,
+                            _timeout_cb,
+                            NULL);
+}
+
+static gboolean
+_timeout_cb(gpointer user_data)
+{
+    NMTimerQueueEntry *entry;
+    gint64             now_msec;
+
+    nm_clear_g_source_inst(&_tq.source);
+
+    now_msec = nm_utils_get_monotonic_timestamp_msec();
+
+    /* The callbacks may schedule and cancel entries (including other
+     * expired ones). Always look at the head of the queue again. */
+    while ((entry = nm_prioq_peek(&_tq.prioq)) && entry->_priv.expiry_msec <= now_msec) {
+        nm_prioq_remove(&_tq.prioq, entry, &entry->_priv.idx);
+        entry->_priv.func(entry, entry->_priv.user_data);
+    }
+
+    _reschedule();
+    return G_SOURCE_CONTINUE;
+}
+
+/*****************************************************************************/
+
+/**
+ * nm_timer_queue_schedule:
+ * @entry: the entry, initialized with nm_timer_queue_entry_init().
+ * @expiry_msec: the time when @func should be called.
+ * @func: the callback.
+ * @user_data: the user data for @func.
+ *
+ * Schedules @entry, or reschedules it if it is already scheduled. When the
+ * expiry is reached, the entry is no longer scheduled and @func is called.
+ * The entry must not be freed while it is scheduled.
+ */
+void
+nm_timer_queue_schedule(NMTimerQueueEntry *entry,
+                        gint64             expiry_msec,
+                        NMTimerQueueFunc   func,
+                        gpointer           user_data)
+{
+    nm_assert(entry);
+    nm_assert(func);
+
+    if (G_UNLIKELY(!_tq.prioq._priv.compare_func))
+        nm_prioq_init(&_tq.prioq, _entry_cmp);
+
+    entry->_priv.func      = func;
+    entry->_priv.user_data = user_data;
+
+    if (nm_timer_queue_entry_is_scheduled(entry) && entry->_priv.expiry_msec == expiry_msec)
+        return;
+
+    entry->_priv.expiry_msec = expiry_msec;
+    nm_prioq_update(&_tq.prioq, entry, &entry->_priv.idx, TRUE);
+    _reschedule();
+}
+
+/**
+ * nm_timer_queue_cancel:
+ * @entry: the entry.
+ *
+ * Returns: %TRUE, if @entry was scheduled.
+ */
+gboolean
+nm_timer_queue_cancel(NMTimerQueueEntry *entry)
+{
+    nm_assert(entry);
+
+    if (!nm_timer_queue_entry_is_scheduled(entry))
+        return FALSE;
+
+    nm_prioq_remove(&_tq.prioq, entry, &entry->_priv.idx);
+    _reschedule();
+    return TRUE;
+}
@@ -0,0 +1,66 @@
+/* SPDX-License-Identifier: LGPL-2.1-or-later */
+
+#ifndef __NM_TIMER_QUEUE_H__
+#define __NM_TIMER_QUEUE_H__
+
+#include "nm-prioq.h"
+
+/*****************************************************************************/
+
+/* A shared timer for many timeouts, for example the lifetimes of addresses
+ * and routes of all devices. The entries are kept in a priority queue, and
+ * only one GSource on the default main context is armed for the earliest
+ * expiry. Scheduling and cancelling an entry is O(log n).
+ *
+ * The expiry is in nm_utils_get_monotonic_timestamp_msec() scale. This is
+ * not thread-safe, use it only from the main thread. */
+
+typedef struct _NMTimerQueueEntry NMTimerQueueEntry;
+
+typedef void (*NMTimerQueueFunc)(NMTimerQueueEntry *entry, gpointer user_data);
+
+struct _NMTimerQueueEntry {
+    struct {
+        gint64           expiry_msec;
+        NMTimerQueueFunc func;
+        gpointer         user_data;
+        unsigned         idx;
+    } _priv;
+};
+
+#define NM_TIMER_QUEUE_ENTRY_INIT          \
+    {                                      \
+        ._priv =                           \
+            {                              \
+                .idx = NM_PRIOQ_IDX_NULL,  \
+            },                             \
+    }
+
+static inline void
+nm_timer_queue_entry_init(NMTimerQueueEntry *entry)
+{
+    *entry = (NMTimerQueueEntry) NM_TIMER_QUEUE_ENTRY_INIT;
+}
+
+static inline gboolean
+nm_timer_queue_entry_is_scheduled(const NMTimerQueueEntry *entry)
+{
+    return entry->_priv.idx != NM_PRIOQ_IDX_NULL;
+}
+
+static inline gint64
+nm_timer_queue_entry_get_expiry_msec(const NMTimerQueueEntry *entry)
+{
+    nm_assert(nm_timer_queue_entry_is_scheduled(entry));
+
+    return entry->_priv.expiry_msec;
+}
+
+void nm_timer_queue_schedule(NMTimerQueueEntry *entry,
+                             gint64             expiry_msec,
+                             NMTimerQueueFunc   func,
+                             gpointer           user_data);
+
+gboolean nm_timer_queue_cancel(NMTimerQueueEntry *entry);
+
+#endif /* __NM_TIMER_QUEUE_H__ */
@@ -14,6 +14,8 @@
 #include "libnm-glib-aux/nm-ref-string.h"
 #include "libnm-glib-aux/nm-io-utils.h"
 #include "libnm-glib-aux/nm-prioq.h"
+#include "libnm-glib-aux/nm-timer-queue.h"
+#include "libnm-glib-aux/nm-lpm-trie.h"
 
 #include "libnm-glib-aux/nm-test-utils.h"
 
@@ -802,6 +804,9 @@ test_nm_ref_string(void)
 {
     nm_auto_ref_string NMRefString *s1 = NULL;
     NMRefString                    *s2;
+    guint                           n;
+    guint                           n2;
+    gsize                           bytes;
 
     g_assert(NULL == NM_REF_STRING_UPCAST(NULL));
     g_assert(nm_ref_string_equal_str(NULL, NULL));
@@ -835,7 +840,13 @@ test_nm_ref_string(void)
     g_assert_cmpmem(s2->str, s2->len, STR_WITH_NUL, NM_STRLEN(STR_WITH_NUL));
     g_assert(!nm_ref_string_equal_str(s2, "hallo"));
     g_assert(s2->str[s2->len] == '\0');
+
+    nm_ref_string_get_stats(&n, &bytes);
+    g_assert_cmpint(n, >=, 2);
+    g_assert_cmpint(bytes, >=, sizeof("hallo") + sizeof(STR_WITH_NUL));
     nm_ref_string_unref(s2);
+    nm_ref_string_get_stats(&n2, NULL);
+    g_assert_cmpint(n2, ==, n - 1);
 }
 
 /*****************************************************************************/
@@ -2640,6 +2651,234 @@ test_nm_prioq(void)
 
 /*****************************************************************************/
 
+typedef struct {
+    NMTimerQueueEntry entries[5];
+    guint             fired[5];
+    guint             n_fired;
+} TimerQueueData;
+
+static void
+_timer_queue_cb(NMTimerQueueEntry *entry, gpointer user_data)
+{
+    TimerQueueData *d = user_data;
+    guint           idx;
+
+    g_assert(!nm_timer_queue_entry_is_scheduled(entry));
+
+    idx = entry - d->entries;
+    g_assert_cmpint(idx, <, G_N_ELEMENTS(d->entries));
+    g_assert_cmpint(d->n_fired, <, G_N_ELEMENTS(d->fired));
+    d->fired[d->n_fired++] = idx;
+
+    /* cancelling another expired entry from the callback prevents it from firing. */
+    if (idx == 0)
+        g_assert(nm_timer_queue_cancel(&d->entries[3]));
+}
+
+static void
+test_nm_timer_queue(void)
+{
+    TimerQueueData d = {};
+    gint64         now_msec;
+    guint          i;
+
+    for (i = 0; i < G_N_ELEMENTS(d.entries); i++)
+        nm_timer_queue_entry_init(&d.entries[i]);
+
+    now_msec = nm_utils_get_monotonic_timestamp_msec();
+
+    nm_timer_queue_schedule(&d.entries[2], now_msec - 1, _timer_queue_cb, &d);
+    nm_timer_queue_schedule(&d.entries[0], now_msec - 3, _timer_queue_cb, &d);
+    nm_timer_queue_schedule(&d.entries[1], now_msec - 2, _timer_queue_cb, &d);
+    nm_timer_queue_schedule(&d.entries[3], now_msec, _timer_queue_cb, &d);
+    nm_timer_queue_schedule(&d.entries[4], now_msec + 100000, _timer_queue_cb, &d);
+
+    /* rescheduling moves the entry. */
+    nm_timer_queue_schedule(&d.entries[1], now_msec - 4, _timer_queue_cb, &d);
+
+    g_assert(nm_timer_queue_entry_is_scheduled(&d.entries[4]));
+    g_assert_cmpint(nm_timer_queue_entry_get_expiry_msec(&d.entries[4]), ==, now_msec + 100000);
+
+    while (d.n_fired < 3)
+        g_main_context_iteration(NULL, TRUE);
+
+    g_assert_cmpint(d.fired[0], ==, 1);
+    g_assert_cmpint(d.fired[1], ==, 0);
+    g_assert_cmpint(d.fired[2], ==, 2);
+
+    g_assert(!nm_timer_queue_entry_is_scheduled(&d.entries[3]));
+    g_assert(nm_timer_queue_entry_is_scheduled(&d.entries[4]));
+
+    g_assert(nm_timer_queue_cancel(&d.entries[4]));
+    g_assert(!nm_timer_queue_cancel(&d.entries[4]));
+
+    while (g_main_context_iteration(NULL, FALSE)) {}
+    g_assert_cmpint(d.n_fired, ==, 3);
+}
+
+/*****************************************************************************/
+
+static gboolean
+_lpm_trie_match_plen_max_24(gconstpointer key, guint plen, gpointer value, gpointer user_data)
+{
+    return plen <= 24;
+}
+
+static gboolean
+_lpm_trie_insert4(NMLpmTrie *trie, const char *str, guint plen, int value)
+{
+    const in_addr_t addr = nmtst_inet4_from_string(str);
+
+    return nm_lpm_trie_insert(trie, &addr, plen, GINT_TO_POINTER(value));
+}
+
+static gboolean
+_lpm_trie_remove4(NMLpmTrie *trie, const char *str, guint plen)
+{
+    const in_addr_t addr = nmtst_inet4_from_string(str);
+
+    return nm_lpm_trie_remove(trie, &addr, plen);
+}
+
+static int
+_lpm_trie_lookup4(NMLpmTrie *trie, const char *str, NMLpmTrieMatchFunc match_func)
+{
+    const in_addr_t addr = nmtst_inet4_from_string(str);
+    guint           plen;
+    gpointer        value;
+
+    if (!nm_lpm_trie_lookup_full(trie, &addr, match_func, NULL, &plen, &value))
+        return -1;
+
+    /* The tests use the prefix length as value. */
+    g_assert_cmpint(GPOINTER_TO_INT(value), ==, plen);
+    return plen;
+}
+
+static void
+test_nm_lpm_trie(void)
+{
+    nm_auto_free_lpm_trie NMLpmTrie *trie = NULL;
+    in_addr_t                        keys[200];
+    guint                            plens[200];
+    guint                            i;
+    guint                            j;
+    guint                            plen;
+
+    trie = nm_lpm_trie_new(32, NULL);
+
+    g_assert_cmpint(_lpm_trie_lookup4(trie, "127.0.0.1", NULL), ==, -1);
+
+    g_assert(_lpm_trie_insert4(trie, "0.0.0.0", 0, 0));
+    g_assert(_lpm_trie_insert4(trie, "10.0.0.0", 8, 8));
+    g_assert(_lpm_trie_insert4(trie, "10.1.2.0", 24, 24));
+    g_assert(_lpm_trie_insert4(trie, "10.1.2.3", 32, 32));
+    g_assert(!_lpm_trie_insert4(trie, "10.1.2.7", 24, 24));
+    g_assert_cmpint(nm_lpm_trie_get_size(trie), ==, 4);
+
+    g_assert_cmpint(_lpm_trie_lookup4(trie, "10.1.2.3", NULL), ==, 32);
+    g_assert_cmpint(_lpm_trie_lookup4(trie, "10.1.2.4", NULL), ==, 24);
+    g_assert_cmpint(_lpm_trie_lookup4(trie, "10.1.3.4", NULL), ==, 8);
+    g_assert_cmpint(_lpm_trie_lookup4(trie, "192.168.1.1", NULL), ==, 0);
+    g_assert_cmpint(_lpm_trie_lookup4(trie, "10.1.2.3", _lpm_trie_match_plen_max_24), ==, 24);
+
+    g_assert(_lpm_trie_remove4(trie, "10.1.2.0", 24));
+    g_assert(!_lpm_trie_remove4(trie, "10.1.2.0", 24));
+    g_assert_cmpint(_lpm_trie_lookup4(trie, "10.1.2.4", NULL), ==, 8);
+    g_assert(_lpm_trie_remove4(trie, "0.0.0.0", 0));
+    g_assert_cmpint(_lpm_trie_lookup4(trie, "192.168.1.1", NULL), ==, -1);
+    g_assert_cmpint(nm_lpm_trie_get_size(trie), ==, 2);
+
+    nm_clear_pointer(&trie, nm_lpm_trie_free);
+
+    /* Compare random operations with a linear search. */
+    trie = nm_lpm_trie_new(32, NULL);
+    for (i = 0; i < G_N_ELEMENTS(keys); i++) {
+        keys[i]  = htonl(0x0a000000u | (nmtst_get_rand_uint32() & 0x0003FF00u));
+        plens[i] = 8 + nmtst_get_rand_uint32() % 25;
+        keys[i]  = nm_ip4_addr_clear_host_address(keys[i], plens[i]);
+    }
+    for (i = 0; i < 2000; i++) {
+        const guint     idx  = nmtst_get_rand_uint32() % G_N_ELEMENTS(keys);
+        const in_addr_t addr = htonl(0x0a000000u | (nmtst_get_rand_uint32() & 0x0003FFFFu));
+        gboolean        has  = nm_lpm_trie_lookup_exact(trie, &keys[idx], plens[idx], NULL);
+        guint           plen_expected;
+        gboolean        found_expected;
+
+        if (nmtst_get_rand_bool()) {
+            g_assert(nm_lpm_trie_insert(trie, &keys[idx], plens[idx], GUINT_TO_POINTER(plens[idx]))
+                     == !has);
+        } else
+            g_assert(nm_lpm_trie_remove(trie, &keys[idx], plens[idx]) == has);
+
+        found_expected = FALSE;
+        plen_expected  = 0;
+        for (j = 0; j < G_N_ELEMENTS(keys); j++) {
+            if (!nm_lpm_trie_lookup_exact(trie, &keys[j], plens[j], NULL))
+                continue;
+            if (nm_ip4_addr_clear_host_address(addr, plens[j]) != keys[j])
+                continue;
+            if (!found_expected || plens[j] > plen_expected) {
+                found_expected = TRUE;
+                plen_expected  = plens[j];
+            }
+        }
+
+        g_assert(nm_lpm_trie_lookup(trie, &addr, &plen, NULL) == found_expected);
+        if (found_expected)
+            g_assert_cmpint(plen, ==, plen_expected);
+    }
+}
+
+/*****************************************************************************/
+
+static void
+_assert_cpu_list(const char *str, const char *expected_mask)
+{
+    gs_unref_array GArray *cpus = NULL;
+    gs_free char          *mask = NULL;
+
+    cpus = nm_utils_cpu_list_parse(str);
+    if (!expected_mask) {
+        g_assert(!cpus);
+        return;
+    }
+
+    g_assert(cpus);
+    mask = nm_utils_cpu_mask_to_string(&nm_g_array_index(cpus, guint, 0), cpus->len);
+    g_assert_cmpstr(mask, ==, expected_mask);
+}
+
+static void
+test_nm_utils_cpu_list(void)
+{
+    _assert_cpu_list("0", "1");
+    _assert_cpu_list("0-3", "f");
+    _assert_cpu_list(" 0-3 , 8", "10f");
+    _assert_cpu_list("3,2,1,0,2-3", "f");
+    _assert_cpu_list("0,32", "1,00000001");
+    _assert_cpu_list("4,64", "1,00000000,00000010");
+    _assert_cpu_list(NULL, NULL);
+    _assert_cpu_list("", NULL);
+    _assert_cpu_list(",", NULL);
+    _assert_cpu_list("3-1", NULL);
+    _assert_cpu_list("a", NULL);
+    _assert_cpu_list("0-", NULL);
+    _assert_cpu_list("-1", NULL);
+    _assert_cpu_list("8192", NULL);
+
+    {
+        const guint   cpu  = NM_UTILS_CPU_MAX;
+        gs_free char *mask = nm_utils_cpu_mask_to_string(&cpu, 1);
+
+        g_assert_cmpint(strlen(mask), ==, 8 + 9 * (NM_UTILS_CPU_MAX / 32));
+        g_assert(g_str_has_prefix(mask, "80000000,00000000,"));
+        g_assert(g_str_has_suffix(mask, ",00000000"));
+    }
+}
+
+/*****************************************************************************/
+
 static const char *
 _getpwuid_name(uid_t uid)
 {
@@ -2943,6 +3182,9 @@ main(int argc, char **argv)
     g_test_add_func("/general/test_inet_parse_ip4_legacy", test_inet_parse_ip4_legacy);
     g_test_add_func("/general/test_garray", test_garray);
     g_test_add_func("/general/test_nm_prioq", test_nm_prioq);
+    g_test_add_func("/general/test_nm_timer_queue", test_nm_timer_queue);
+    g_test_add_func("/general/test_nm_lpm_trie", test_nm_lpm_trie);
+    g_test_add_func("/general/test_nm_utils_cpu_list", test_nm_utils_cpu_list);
     g_test_add_func("/general/test_nm_random", test_nm_random);
     g_test_add_func("/general/test_uid_to_name", test_uid_to_name);
 
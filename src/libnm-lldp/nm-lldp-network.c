@@ -46,7 +46,9 @@ nm_lldp_network_bind_raw_socket(int ifindex)
 
     assert(ifindex > 0);
 
-    fd = socket(AF_PACKET, SOCK_RAW | SOCK_CLOEXEC | SOCK_NONBLOCK, htobe16(ETH_P_ALL));
+    /* Only ask for LLDP frames. An ETH_P_ALL socket would see (and run the filter on)
+     * every received and every transmitted frame on the interface. */
+    fd = socket(AF_PACKET, SOCK_RAW | SOCK_CLOEXEC | SOCK_NONBLOCK, htobe16(NM_ETHERTYPE_LLDP));
     if (fd < 0)
         return -errno;
 
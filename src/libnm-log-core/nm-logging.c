@@ -78,6 +78,10 @@ typedef enum {
     LOG_BACKEND_GLIB,
     LOG_BACKEND_SYSLOG,
     LOG_BACKEND_JOURNAL,
+
+    /* Like LOG_BACKEND_JOURNAL, but the messages are queued and sent
+     * to the journal by a separate thread. */
+    LOG_BACKEND_JOURNAL_ASYNC,
 } LogBackend;
 
 typedef struct {
@@ -85,6 +89,11 @@ typedef struct {
     const char *name;
 } LogDesc;
 
+typedef struct {
+    guint32 burst;
+    guint32 interval_msec;
+} LogRateLimit;
+
 typedef struct {
     char *logging_domains_to_string;
 } GlobalMain;
@@ -97,6 +106,9 @@ typedef struct {
     const char *prefix;
     const char *syslog_identifier;
 
+    /* the domains for which a rate limit is configured in gl_rate_limit. */
+    NMLogDomain rate_limit_domains;
+
     /* before we setup syslog (during start), the backend defaults to GLIB, meaning:
      * we use g_log() for all logging. At that point, the application is not yet supposed
      * to do any logging and doing so indicates a bug.
@@ -141,6 +153,10 @@ NMLogDomain _nm_logging_enabled_state[_LOGL_N_REAL] = {
     [LOGL_ERR]  = LOGD_DEFAULT,
 };
 
+/* The rate limit per domain, indexed by the bit number of the domain.
+ * Protected by G_LOCK(log). */
+static LogRateLimit gl_rate_limit[64];
+
 /*****************************************************************************/
 
 static const LogDesc domain_desc[] = {
@@ -414,6 +430,116 @@ nm_logging_setup(const char *level, const char *domains, char **bad_domains, GEr
     return TRUE;
 }
 
+static NMLogDomain
+_rate_limit_parse_domain(const char *s)
+{
+    const LogDesc *diter;
+
+    if (!g_ascii_strcasecmp(s, LOGD_ALL_STRING))
+        return LOGD_ALL;
+    if (!g_ascii_strcasecmp(s, LOGD_DEFAULT_STRING))
+        return LOGD_DEFAULT;
+    if (!g_ascii_strcasecmp(s, LOGD_DHCP_STRING))
+        return LOGD_DHCP;
+    if (!g_ascii_strcasecmp(s, LOGD_IP_STRING))
+        return LOGD_IP;
+
+    for (diter = &domain_desc[0]; diter->name; diter++) {
+        if (!g_ascii_strcasecmp(diter->name, s))
+            return diter->num;
+    }
+    return LOGD_NONE;
+}
+
+/**
+ * nm_logging_set_rate_limit:
+ * @rate_limit: (nullable): a comma separated list of "[DOMAIN:]BURST/INTERVAL"
+ *   and "[DOMAIN:]off" entries. INTERVAL is in seconds. An entry without
+ *   domain applies to all domains, later entries override earlier ones.
+ * @error: the failure reason.
+ *
+ * Configures how many messages of level INFO and above a call site may log.
+ * %NULL or an empty string disables rate limiting.
+ *
+ * Returns: %TRUE on success. On failure, the configuration is unchanged.
+ */
+gboolean
+nm_logging_set_rate_limit(const char *rate_limit, GError **error)
+{
+    gs_free const char **entries            = NULL;
+    LogRateLimit         new_rate_limit[64] = {};
+    NMLogDomain          new_domains        = LOGD_NONE;
+    gsize                i;
+    guint                b;
+
+    G_STATIC_ASSERT_EXPR(sizeof(new_rate_limit) == sizeof(gl_rate_limit));
+
+    NM_ASSERT_ON_MAIN_THREAD();
+
+    g_return_val_if_fail(!error || !*error, FALSE);
+
+    entries = nm_strsplit_set(rate_limit, ", ");
+    for (i = 0; entries && entries[i]; i++) {
+        const char  *s    = entries[i];
+        NMLogDomain  bits = LOGD_ALL;
+        LogRateLimit rl   = {};
+        const char  *p;
+
+        p = strchr(s, ':');
+        if (p) {
+            *((char *) p) = '\0';
+            bits          = _rate_limit_parse_domain(s);
+            if (bits == LOGD_NONE) {
+                g_set_error(error,
+                            _NM_MANAGER_ERROR,
+                            _NM_MANAGER_ERROR_UNKNOWN_LOG_DOMAIN,
+                            _("Unknown log domain '%s'"),
+                            s);
+                return FALSE;
+            }
+            s = p + 1;
+        }
+
+        if (g_ascii_strcasecmp(s, "off") != 0) {
+            gint64 burst    = -1;
+            gint64 interval = -1;
+
+            p = strchr(s, '/');
+            if (p) {
+                *((char *) p) = '\0';
+                burst         = _nm_utils_ascii_str_to_int64(s, 10, 1, G_MAXUINT16, -1);
+                interval      = _nm_utils_ascii_str_to_int64(p + 1, 10, 1, 3600, -1);
+            }
+            if (burst < 0 || interval < 0) {
+                g_set_error(error,
+                            NM_UTILS_ERROR,
+                            NM_UTILS_ERROR_INVALID_ARGUMENT,
+                            _("Invalid rate limit '%s', expected BURST/INTERVAL or 'off'"),
+                            entries[i]);
+                return FALSE;
+            }
+            rl.burst         = burst;
+            rl.interval_msec = interval * 1000;
+        }
+
+        for (b = 0; b < G_N_ELEMENTS(new_rate_limit); b++) {
+            if (NM_FLAGS_ANY(bits, ((NMLogDomain) 1) << b))
+                new_rate_limit[b] = rl;
+        }
+        if (rl.burst > 0)
+            new_domains |= bits;
+        else
+            new_domains &= ~bits;
+    }
+
+    G_LOCK(log);
+    memcpy(gl_rate_limit, new_rate_limit, sizeof(gl_rate_limit));
+    gl.mut.rate_limit_domains = new_domains;
+    G_UNLOCK(log);
+
+    return TRUE;
+}
+
 const char *
 nm_logging_level_to_string(void)
 {
@@ -646,8 +772,319 @@ _nm_printf(3, 4) static void _iovec_set_format(struct iovec *iov,
     }                                                               \
     G_STMT_END
 
+/*****************************************************************************/
+
+/* With the "journal-async" backend, _nm_log_impl() still formats the message on
+ * the calling thread, but then only copies the fields into a queue. A writer
+ * thread sends them to the journal. If the writer cannot keep up and the queue
+ * is full, messages get dropped and the writer logs how many. */
+
+#define LOG_ASYNC_QUEUE_SIZE 4096u
+
+typedef struct {
+    guint        n_iov;
+    struct iovec iov[];
+} LogAsyncRecord;
+
+static struct {
+    GMutex          lock;
+    GCond           cond;
+    GThread        *thread;
+    LogAsyncRecord *queue[LOG_ASYNC_QUEUE_SIZE];
+    guint           queue_head;
+    guint           queue_len;
+    guint           dropped;
+    guint64         dropped_total;
+    bool            writer_waiting : 1;
+    bool            stop : 1;
+} gl_async;
+
+static void
+_log_async_push(const struct iovec *iov, guint n_iov)
+{
+    LogAsyncRecord *rec;
+    gsize           size;
+    char           *data;
+    gboolean        wake;
+    guint           i;
+
+    size = sizeof(LogAsyncRecord) + (n_iov * sizeof(struct iovec));
+    for (i = 0; i < n_iov; i++)
+        size += iov[i].iov_len;
+
+    rec        = g_malloc(size);
+    rec->n_iov = n_iov;
+    data       = (char *) &rec->iov[n_iov];
+    for (i = 0; i < n_iov; i++) {
+        rec->iov[i].iov_base = memcpy(data, iov[i].iov_base, iov[i].iov_len);
+        rec->iov[i].iov_len  = iov[i].iov_len;
+
+        data += iov[i].iov_len;
+    }
+
+    g_mutex_lock(&gl_async.lock);
+    if (gl_async.queue_len >= LOG_ASYNC_QUEUE_SIZE) {
+        gl_async.dropped++;
+        g_mutex_unlock(&gl_async.lock);
+        g_free(rec);
+        return;
+    }
+    gl_async.queue[(gl_async.queue_head + gl_async.queue_len) % LOG_ASYNC_QUEUE_SIZE] = rec;
+    gl_async.queue_len++;
+    wake = gl_async.writer_waiting;
+    g_mutex_unlock(&gl_async.lock);
+
+    /* Only wake up the writer if it sleeps. While it is busy, it will
+     * pick up the new message without us paying for the syscall. */
+    if (wake)
+        g_cond_signal(&gl_async.cond);
+}
+
+static gpointer
+_log_async_thread(gpointer user_data)
+{
+    LogAsyncRecord *batch[64];
+
+    g_mutex_lock(&gl_async.lock);
+    while (TRUE) {
+        guint64 dropped_total = 0;
+        guint   dropped;
+        guint   n;
+        guint   i;
+
+        while (gl_async.queue_len == 0 && gl_async.dropped == 0 && !gl_async.stop) {
+            gl_async.writer_waiting = TRUE;
+            g_cond_wait(&gl_async.cond, &gl_async.lock);
+            gl_async.writer_waiting = FALSE;
+        }
+
+        if (gl_async.queue_len == 0 && gl_async.dropped == 0)
+            break;
+
+        n = NM_MIN(gl_async.queue_len, (guint) G_N_ELEMENTS(batch));
+        for (i = 0; i < n; i++) {
+            batch[i]            = gl_async.queue[gl_async.queue_head];
+            gl_async.queue_head = (gl_async.queue_head + 1u) % LOG_ASYNC_QUEUE_SIZE;
+        }
+        gl_async.queue_len -= n;
+
+        dropped = nm_steal_int(&gl_async.dropped);
+        if (dropped > 0) {
+            gl_async.dropped_total += dropped;
+            dropped_total = gl_async.dropped_total;
+        }
+
+        g_mutex_unlock(&gl_async.lock);
+
+        for (i = 0; i < n; i++) {
+            sd_journal_sendv(batch[i]->iov, batch[i]->n_iov);
+            g_free(batch[i]);
+        }
+
+        if (dropped > 0) {
+            sd_journal_send("PRIORITY=%d",
+                            LOG_WARNING,
+                            "MESSAGE=%slogging: dropped %u messages because the queue was full "
+                            "(%" G_GUINT64_FORMAT " in total)",
+                            gl.imm.prefix,
+                            dropped,
+                            dropped_total,
+                            syslog_identifier_full(gl.imm.syslog_identifier),
+                            "SYSLOG_PID=%ld",
+                            (long) getpid(),
+                            "SYSLOG_FACILITY=3",
+                            NULL);
+        }
+
+        g_mutex_lock(&gl_async.lock);
+    }
+    g_mutex_unlock(&gl_async.lock);
+
+    return NULL;
+}
+
+static void
+_log_async_stop(void)
+{
+    /* Called at exit. Let the writer send all queued messages and wait for it. */
+    g_mutex_lock(&gl_async.lock);
+    gl_async.stop = TRUE;
+    g_cond_signal(&gl_async.cond);
+    g_mutex_unlock(&gl_async.lock);
+
+    g_thread_join(g_steal_pointer(&gl_async.thread));
+}
+
 #endif
 
+/*****************************************************************************/
+
+/* Rate limiting of messages per call site (file and line). Each call site has
+ * a token bucket that holds up to "burst" tokens and gets "burst" tokens refilled
+ * per "interval". A message that finds the bucket empty is not logged. The next
+ * message from the call site that gets logged reports how many were suppressed.
+ *
+ * The limit is configured per domain (nm_logging_set_rate_limit()). It only
+ * applies to levels INFO and above, debug logging is never limited. */
+
+typedef struct {
+    const char *file;
+    guint       line;
+    guint       tokens;
+    guint       n_suppressed;
+    gint64      refill_msec;
+    guint64     n_logged_total;
+    guint64     n_suppressed_total;
+} LogCallsite;
+
+/* Protected by G_LOCK(log). The LogCallsite entries are never freed. */
+static GHashTable *gl_callsites;
+
+static guint
+_callsite_hash(gconstpointer ptr)
+{
+    const LogCallsite *cs = ptr;
+
+    /* The file names are string literals, comparing the pointers is enough. */
+    return nm_hash_vals(1406437091u, cs->file, cs->line);
+}
+
+static gboolean
+_callsite_equal(gconstpointer a, gconstpointer b)
+{
+    const LogCallsite *cs_a = a;
+    const LogCallsite *cs_b = b;
+
+    return cs_a->file == cs_b->file && cs_a->line == cs_b->line;
+}
+
+static gboolean
+_rate_limit_check(const char *file,
+                  guint       line,
+                  NMLogDomain domain,
+                  gint64      now_msec,
+                  guint      *out_n_suppressed)
+{
+    const LogRateLimit *rl;
+    LogCallsite         needle = {.file = file, .line = line};
+    LogCallsite        *cs;
+    NMLogDomain         rl_domain;
+    gint64              n_refill;
+    gboolean            pass;
+
+    *out_n_suppressed = 0;
+
+    G_LOCK(log);
+
+    rl_domain = domain & gl.imm.rate_limit_domains;
+    if (rl_domain == 0) {
+        /* the configuration changed in the meantime. */
+        G_UNLOCK(log);
+        return TRUE;
+    }
+
+    /* If the message has several domains, the limit of the lowest one applies. */
+    rl = &gl_rate_limit[__builtin_ctzll(rl_domain)];
+
+    if (G_UNLIKELY(!gl_callsites))
+        gl_callsites = g_hash_table_new(_callsite_hash, _callsite_equal);
+
+    cs = g_hash_table_lookup(gl_callsites, &needle);
+    if (!cs) {
+        cs  = g_new(LogCallsite, 1);
+        *cs = (LogCallsite) {
+            .file        = file,
+            .line        = line,
+            .tokens      = rl->burst,
+            .refill_msec = now_msec,
+        };
+        g_hash_table_add(gl_callsites, cs);
+    } else if (now_msec - cs->refill_msec >= rl->interval_msec) {
+        cs->tokens      = rl->burst;
+        cs->refill_msec = now_msec;
+    } else {
+        n_refill = (now_msec - cs->refill_msec) * rl->burst / rl->interval_msec;
+        if (n_refill > 0) {
+            cs->tokens = NM_MIN(cs->tokens + (guint) n_refill, rl->burst);
+            cs->refill_msec += n_refill * rl->interval_msec / rl->burst;
+        }
+    }
+
+    if (cs->tokens > 0) {
+        cs->tokens--;
+        cs->n_logged_total++;
+        *out_n_suppressed = nm_steal_int(&cs->n_suppressed);
+        pass              = TRUE;
+    } else {
+        cs->n_suppressed++;
+        cs->n_suppressed_total++;
+        pass = FALSE;
+    }
+
+    G_UNLOCK(log);
+
+    return pass;
+}
+
+static int
+_callsite_cmp(gconstpointer a, gconstpointer b, gpointer user_data)
+{
+    const LogCallsite *cs_a = a;
+    const LogCallsite *cs_b = b;
+
+    NM_CMP_DIRECT(cs_b->n_suppressed_total, cs_a->n_suppressed_total);
+    NM_CMP_DIRECT_STRCMP0(cs_a->file, cs_b->file);
+    NM_CMP_DIRECT(cs_a->line, cs_b->line);
+    return 0;
+}
+
+/**
+ * nm_logging_get_rate_limit_stats:
+ *
+ * Returns: (transfer floating): for each call site that was subject to
+ *   rate limiting, a tuple with the location ("file:line"), the number
+ *   of logged and the number of suppressed messages. The call sites with
+ *   the most suppressed messages come first.
+ */
+GVariant *
+nm_logging_get_rate_limit_stats(void)
+{
+    gs_free LogCallsite *callsites = NULL;
+    GVariantBuilder      builder;
+    GHashTableIter       iter;
+    LogCallsite         *cs;
+    guint                n = 0;
+    guint                i;
+
+    NM_ASSERT_ON_MAIN_THREAD();
+
+    G_LOCK(log);
+    if (gl_callsites) {
+        callsites = g_new(LogCallsite, g_hash_table_size(gl_callsites));
+        g_hash_table_iter_init(&iter, gl_callsites);
+        while (g_hash_table_iter_next(&iter, (gpointer *) &cs, NULL))
+            callsites[n++] = *cs;
+    }
+    G_UNLOCK(log);
+
+    if (n > 1)
+        g_qsort_with_data(callsites, n, sizeof(LogCallsite), _callsite_cmp, NULL);
+
+    g_variant_builder_init(&builder, G_VARIANT_TYPE("a(stt)"));
+    for (i = 0; i < n; i++) {
+        gs_free char *location = NULL;
+
+        location = g_strdup_printf("%s:%u", callsites[i].file ?: "", callsites[i].line);
+
+        g_variant_builder_add(&builder,
+                              "(stt)",
+                              location,
+                              (guint64) callsites[i].n_logged_total,
+                              (guint64) callsites[i].n_suppressed_total);
+    }
+    return g_variant_builder_end(&builder);
+}
+
 void
 _nm_log_impl(const char *file,
              guint       line,
@@ -662,10 +1099,12 @@ _nm_log_impl(const char *file,
              ...)
 {
     char               msg_stack[400];
-    gs_free char      *msg_heap = NULL;
+    gs_free char      *msg_heap       = NULL;
+    gs_free char      *msg_suppressed = NULL;
     const char        *msg;
     gint64             tv;
     int                errsv;
+    guint              n_suppressed = 0;
     const NMLogDomain *cur_log_state;
     NMLogDomain        cur_log_state_copy[_LOGL_N_REAL];
     Global             g_copy;
@@ -695,6 +1134,15 @@ _nm_log_impl(const char *file,
 
     (void) cur_log_state;
 
+    if (level >= LOGL_INFO && G_UNLIKELY(domain & g->rate_limit_domains)) {
+        if (!_rate_limit_check(file,
+                               line,
+                               domain,
+                               nm_utils_get_monotonic_timestamp_msec(),
+                               &n_suppressed))
+            return;
+    }
+
     errsv = errno;
 
     /* Make sure that %m maps to the specified error */
@@ -706,6 +1154,12 @@ _nm_log_impl(const char *file,
 
     msg = nm_vsprintf_buf_or_alloc(fmt, fmt, msg_stack, &msg_heap, NULL);
 
+    if (n_suppressed > 0) {
+        msg_suppressed =
+            g_strdup_printf("%s (%u similar messages suppressed)", msg, n_suppressed);
+        msg = msg_suppressed;
+    }
+
     /* We always print the level and the timestamp.
      *
      * Timestamps are very useful for understanding logfiles. While journalctl
@@ -733,6 +1187,7 @@ _nm_log_impl(const char *file,
     switch (g->log_backend) {
 #if SYSTEMD_JOURNAL
     case LOG_BACKEND_JOURNAL:
+    case LOG_BACKEND_JOURNAL_ASYNC:
     {
         gint64         now, boottime;
         struct iovec   iov_data[15];
@@ -799,7 +1254,10 @@ _nm_log_impl(const char *file,
         nm_assert(iov <= &iov_data[G_N_ELEMENTS(iov_data)]);
         nm_assert(iov_free <= &iov_free_data[G_N_ELEMENTS(iov_free_data)]);
 
-        sd_journal_sendv(iov_data, iov - iov_data);
+        if (g->log_backend == LOG_BACKEND_JOURNAL_ASYNC)
+            _log_async_push(iov_data, iov - iov_data);
+        else
+            sd_journal_sendv(iov_data, iov - iov_data);
 
         for (; --iov_free >= iov_free_data;)
             g_free(*iov_free);
@@ -883,6 +1341,7 @@ nm_log_handler(const char *log_domain, GLogLevelFlags level, const char *message
     switch (gl.imm.log_backend) {
 #if SYSTEMD_JOURNAL
     case LOG_BACKEND_JOURNAL:
+    case LOG_BACKEND_JOURNAL_ASYNC:
     {
         gint64 now, boottime;
 
@@ -962,7 +1421,10 @@ nm_logging_init(const char *logging_backend, gboolean debug)
 
 #if SYSTEMD_JOURNAL
     if (!nm_streq(logging_backend, NM_LOG_CONFIG_BACKEND_SYSLOG)) {
-        x_log_backend = LOG_BACKEND_JOURNAL;
+        if (nm_streq(logging_backend, NM_LOG_CONFIG_BACKEND_JOURNAL_ASYNC))
+            x_log_backend = LOG_BACKEND_JOURNAL_ASYNC;
+        else
+            x_log_backend = LOG_BACKEND_JOURNAL;
 
         /* We only log the monotonic-timestamp with structured logging (journal).
          * Only in this case, fetch the timestamp. */
@@ -986,6 +1448,13 @@ nm_logging_init(const char *logging_backend, gboolean debug)
 
     G_UNLOCK(log);
 
+#if SYSTEMD_JOURNAL
+    if (x_log_backend == LOG_BACKEND_JOURNAL_ASYNC) {
+        gl_async.thread = g_thread_new("nm-logging", _log_async_thread, NULL);
+        atexit(_log_async_stop);
+    }
+#endif
+
     if (fetch_monotonic_timestamp) {
         /* ensure we read a monotonic timestamp. Reading the timestamp the first
          * time causes a logging message. We don't want to do that during _nm_log_impl. */
@@ -1003,6 +1472,12 @@ nm_logging_init(const char *logging_backend, gboolean debug)
 #if !SYSTEMD_JOURNAL
         nm_log_warn(LOGD_CORE,
                     "config: logging backend 'journal' is not available, fallback to 'syslog'");
+#endif
+    } else if (nm_streq(logging_backend, NM_LOG_CONFIG_BACKEND_JOURNAL_ASYNC)) {
+#if !SYSTEMD_JOURNAL
+        nm_log_warn(LOGD_CORE,
+                    "config: logging backend 'journal-async' is not available, fallback to "
+                    "'syslog'");
 #endif
     } else {
         nm_log_warn(LOGD_CORE,
@@ -13,9 +13,10 @@
 
 #include "libnm-glib-aux/nm-logging-fwd.h"
 
-#define NM_LOG_CONFIG_BACKEND_DEBUG   "debug"
-#define NM_LOG_CONFIG_BACKEND_SYSLOG  "syslog"
-#define NM_LOG_CONFIG_BACKEND_JOURNAL "journal"
+#define NM_LOG_CONFIG_BACKEND_DEBUG         "debug"
+#define NM_LOG_CONFIG_BACKEND_SYSLOG        "syslog"
+#define NM_LOG_CONFIG_BACKEND_JOURNAL       "journal"
+#define NM_LOG_CONFIG_BACKEND_JOURNAL_ASYNC "journal-async"
 
 #define nm_log_err(domain, ...)   nm_log(LOGL_ERR, (domain), NULL, NULL, __VA_ARGS__)
 #define nm_log_warn(domain, ...)  nm_log(LOGL_WARN, (domain), NULL, NULL, __VA_ARGS__)
@@ -147,6 +148,10 @@ nm_logging_setup(const char *level, const char *domains, char **bad_domains, GEr
 
 void nm_logging_init(const char *logging_backend, gboolean debug);
 
+gboolean nm_logging_set_rate_limit(const char *rate_limit, GError **error);
+
+GVariant *nm_logging_get_rate_limit_stats(void);
+
 gboolean nm_logging_syslog_enabled(void);
 
 /*****************************************************************************/
@@ -15,6 +15,7 @@
 #include <fcntl.h>
 #include <libudev.h>
 #include <linux/fib_rules.h>
+#include <linux/filter.h>
 #include <linux/ip.h>
 #include <linux/if.h>
 #include <linux/if_bridge.h>
@@ -23,6 +24,8 @@
 #include <linux/if_tunnel.h>
 #include <linux/if_vlan.h>
 #include <linux/ip6_tunnel.h>
+#include <linux/nexthop.h>
+#include <linux/nl80211.h>
 #include <linux/tc_act/tc_mirred.h>
 #include <netinet/icmp6.h>
 #include <netinet/in.h>
@@ -68,6 +71,9 @@ G_STATIC_ASSERT(NM_MPTCP_PM_ADDR_FLAG_LAMINAR == MPTCP_PM_ADDR_FLAG_LAMINAR);
 
 #include <linux/pkt_cls.h>
 
+G_STATIC_ASSERT(NM_PLATFORM_MQPRIO_MAX_TC == TC_QOPT_MAX_QUEUE);
+G_STATIC_ASSERT(NM_PLATFORM_MQPRIO_MAX_TC == TC_QOPT_BITMASK + 1);
+
 struct tc_defact {
     tc_gen;
 };
@@ -117,14 +123,21 @@ typedef enum _nm_packed {
 #ifndef IFLA_PROMISCUITY
 #define IFLA_PROMISCUITY 30
 #endif
-#define IFLA_NUM_TX_QUEUES 31
-#define IFLA_NUM_RX_QUEUES 32
-#define IFLA_CARRIER       33
-#define IFLA_PHYS_PORT_ID  34
-#define IFLA_LINK_NETNSID  37
-#define IFLA_GSO_MAX_SEGS  40
-#define IFLA_GSO_MAX_SIZE  41
-#define IFLA_GRO_MAX_SIZE  58
+#define IFLA_NUM_TX_QUEUES     31
+#define IFLA_NUM_RX_QUEUES     32
+#define IFLA_CARRIER           33
+#define IFLA_PHYS_PORT_ID      34
+#define IFLA_LINK_NETNSID      37
+#define IFLA_GSO_MAX_SEGS      40
+#define IFLA_GSO_MAX_SIZE      41
+#define IFLA_XDP               43
+#define IFLA_GRO_MAX_SIZE      58
+#define IFLA_GSO_IPV4_MAX_SIZE 63
+#define IFLA_GRO_IPV4_MAX_SIZE 64
+
+#define IFLA_XDP_FD      1
+#define IFLA_XDP_FLAGS   3
+#define IFLA_XDP_PROG_ID 4
 
 #define IFLA_INET6_TOKEN         7
 #define IFLA_INET6_ADDR_GEN_MODE 8
@@ -242,7 +255,8 @@ G_STATIC_ASSERT(RTA_MAX == (__RTA_MAX - 1));
 #define IFLA_MACSEC_REPLAY_PROTECT 12
 #define IFLA_MACSEC_VALIDATION     13
 #define IFLA_MACSEC_PAD            14
-#define __IFLA_MACSEC_MAX          15
+#define IFLA_MACSEC_OFFLOAD        15
+#define __IFLA_MACSEC_MAX          16
 
 /*****************************************************************************/
 
@@ -372,6 +386,21 @@ struct _ifla_vf_vlan_info {
 #define RESYNC_RETRIES         50
 #define RESYNC_BACKOFF_SECONDS 1
 
+/* The maximum number of received datagrams per dispatch of the netlink
+ * event source. */
+#define READ_NETLINK_MAX_READS 64u
+
+/* The number of datagrams that we receive with one recvmmsg() call, and
+ * the initial buffer size for each of them. The kernel sizes the skbs for
+ * dumps based on the receive buffer size (up to 32KiB). */
+#define NETLINK_RECV_BATCH_SLOTS    4u
+#define NETLINK_RECV_BATCH_SLOT_LEN (32u * 1024u)
+
+/* The initial receive buffer size of the rtnl socket. After the socket
+ * buffer overflows (ENOBUFS), it gets doubled up to the maximum. */
+#define RTNL_RCVBUF_INITIAL     (8 * 1024 * 1024)
+#define RTNL_RCVBUF_MAX_DEFAULT (128 * 1024 * 1024)
+
 /*****************************************************************************/
 
 typedef struct {
@@ -594,19 +623,48 @@ typedef struct {
         int is_handling;
     } delayed_action;
 
-    /* This is the receive buffer for netlink messages. This buffer should be large
-     * enough for any rtnetlink message. When too small, nl_recv() would notice the
-     * truncation and lose the message. In that case, we reallocate a larger buffer.
+    /* These are the receive buffers for netlink messages, one per socket. They
+     * receive up to NETLINK_RECV_BATCH_SLOTS datagrams with one recvmmsg() call.
+     * Each slot should be large enough for any netlink message. When too small,
+     * nl_recv_batch() would notice the truncation and lose the message. In that
+     * case, we reallocate larger buffers.
      *
-     * We keep the receive buffer around for the entire lifetime of the platform instance.
+     * We keep the receive buffers around for the entire lifetime of the platform instance.
      * Usually we only have one platform instance per netns, so we don't waste too much. */
-    struct {
-        unsigned char *buf;
-        gsize          len;
-    } netlink_recv_buf;
+    NLRecvBatch netlink_recv_batch[_NMP_NETLINK_NUM];
 
     GenlFamilyData genl_family_data[_NMP_GENL_FAMILY_TYPE_NUM];
 
+    /* If set, only routes in these tables are dumped and kept in the cache.
+     * The array is sorted and contains no duplicates. If empty, routes
+     * from all tables are tracked. */
+    struct {
+        guint32 *tables;
+        guint    len;
+    } route_tables_tracked;
+
+    struct {
+        int     rcvbuf;
+        int     rcvbuf_max;
+        guint   n_overruns;
+        guint64 n_messages;
+        guint64 n_messages_at_overrun;
+        gint64  overrun_msec;
+        gint64  resync_start_msec;
+        gint64  refresh_all_start_msec;
+    } rtnl_stats;
+
+    /* While do_change_link() waits for the response to its request, this
+     * tracks whether an RTM_NEWLINK for the link was received. */
+    struct {
+        int  ifindex;
+        bool seen;
+    } link_expect;
+
+    /* Results of link_prefetch_probes(), indexed by ifindex. They are only valid
+     * until link_prefetch_clear(). */
+    GHashTable *link_probes;
+
 } NMLinuxPlatformPrivate;
 
 struct _NMLinuxPlatform {
@@ -719,9 +777,18 @@ static void cache_on_change(NMPlatform      *platform,
                             const NMPObject *obj_old,
                             const NMPObject *obj_new);
 static void cache_prune_all(NMPlatform *platform);
-static gboolean event_handler_read_netlink(NMPlatform        *platform,
-                                           NMPNetlinkProtocol netlink_protocol,
-                                           gboolean           wait_for_acks);
+static gboolean event_handler_read_netlink_full(NMPlatform        *platform,
+                                                NMPNetlinkProtocol netlink_protocol,
+                                                gboolean           wait_for_acks,
+                                                guint              max_reads);
+
+static gboolean
+event_handler_read_netlink(NMPlatform        *platform,
+                           NMPNetlinkProtocol netlink_protocol,
+                           gboolean           wait_for_acks)
+{
+    return event_handler_read_netlink_full(platform, netlink_protocol, wait_for_acks, 0);
+}
 
 /*****************************************************************************/
 
@@ -852,7 +919,7 @@ static const LinkDesc link_descs[] = {
     [NM_LINK_TYPE_ANY]     = {"any", NULL, NULL},
 
     [NM_LINK_TYPE_ETHERNET]   = {"ethernet", NULL, NULL},
-    [NM_LINK_TYPE_INFINIBAND] = {"infiniband", NULL, NULL},
+    [NM_LINK_TYPE_INFINIBAND] = {"infiniband", "ipoib", NULL},
     [NM_LINK_TYPE_OLPC_MESH]  = {"olpc-mesh", NULL, NULL},
     [NM_LINK_TYPE_WIFI]       = {"wifi", NULL, "wlan"},
     [NM_LINK_TYPE_WWAN_NET]   = {"wwan", NULL, "wwan"},
@@ -917,6 +984,7 @@ _link_type_from_rtnl_type(const char *name)
         NM_LINK_TYPE_IP6GRETAP,   /* "ip6gretap"   */
         NM_LINK_TYPE_IP6TNL,      /* "ip6tnl"      */
         NM_LINK_TYPE_IPIP,        /* "ipip"        */
+        NM_LINK_TYPE_INFINIBAND,  /* "ipoib"       */
         NM_LINK_TYPE_IPVLAN,      /* "ipvlan"      */
         NM_LINK_TYPE_MACSEC,      /* "macsec"      */
         NM_LINK_TYPE_MACVLAN,     /* "macvlan"     */
@@ -2208,6 +2276,7 @@ _parse_lnk_macsec(const char *kind, struct nlattr *info_data)
         [IFLA_MACSEC_SCB]            = {.type = NLA_U8},
         [IFLA_MACSEC_REPLAY_PROTECT] = {.type = NLA_U8},
         [IFLA_MACSEC_VALIDATION]     = {.type = NLA_U8},
+        [IFLA_MACSEC_OFFLOAD]        = {.type = NLA_U8},
     };
     struct nlattr       *tb[G_N_ELEMENTS(policy)];
     NMPObject           *obj;
@@ -2258,6 +2327,9 @@ _parse_lnk_macsec(const char *kind, struct nlattr *info_data)
     if (tb[IFLA_MACSEC_VALIDATION]) {
         props->validation = nla_get_u8(tb[IFLA_MACSEC_VALIDATION]);
     }
+    if (tb[IFLA_MACSEC_OFFLOAD]) {
+        props->offload = nla_get_u8(tb[IFLA_MACSEC_OFFLOAD]);
+    }
 
     return obj;
 }
@@ -3456,6 +3528,11 @@ _new_from_nl_link(NMPlatform            *platform,
         [IFLA_NET_NS_FD]     = {.type = NLA_U32},
         [IFLA_LINK_NETNSID]  = {},
         [IFLA_PERM_ADDRESS]  = {.type = NLA_UNSPEC},
+        [IFLA_XDP]           = {.type = NLA_NESTED},
+
+        /* BIG TCP, since kernel 6.3 */
+        [IFLA_GSO_IPV4_MAX_SIZE] = {.type = NLA_U32},
+        [IFLA_GRO_IPV4_MAX_SIZE] = {.type = NLA_U32},
     };
     const struct ifinfomsg   *ifi;
     struct nlattr            *tb[G_N_ELEMENTS(policy)];
@@ -3606,6 +3683,21 @@ _new_from_nl_link(NMPlatform            *platform,
         obj->link.link_props.gso_max_segments = nla_get_u32(tb[IFLA_GSO_MAX_SEGS]);
     if (tb[IFLA_GRO_MAX_SIZE])
         obj->link.link_props.gro_max_size = nla_get_u32(tb[IFLA_GRO_MAX_SIZE]);
+    if (tb[IFLA_GSO_IPV4_MAX_SIZE])
+        obj->link.link_props.gso_ipv4_max_size = nla_get_u32(tb[IFLA_GSO_IPV4_MAX_SIZE]);
+    if (tb[IFLA_GRO_IPV4_MAX_SIZE])
+        obj->link.link_props.gro_ipv4_max_size = nla_get_u32(tb[IFLA_GRO_IPV4_MAX_SIZE]);
+
+    if (tb[IFLA_XDP]) {
+        static const struct nla_policy policy_xdp[] = {
+            [IFLA_XDP_PROG_ID] = {.type = NLA_U32},
+        };
+        struct nlattr *xdp_attrs[G_N_ELEMENTS(policy_xdp)];
+
+        if (nla_parse_nested_arr(xdp_attrs, tb[IFLA_XDP], policy_xdp) >= 0
+            && xdp_attrs[IFLA_XDP_PROG_ID])
+            obj->link.xdp_prog_id = nla_get_u32(xdp_attrs[IFLA_XDP_PROG_ID]);
+    }
 
     if (tb[IFLA_STATS64]) {
         const char *stats = nla_data(tb[IFLA_STATS64]);
@@ -4126,6 +4218,11 @@ _new_from_nl_route(const struct nlmsghdr *nlh, gboolean id_only, ParseNlmsgIter
                  * v4_nh_extra_nexthops (note that in the end we will only add (v4_n_nexthops-1)
                  * hops in this list). */
                 nm_assert(v4_n_nexthops > 0u);
+                if (v4_n_nexthops >= G_MAXUINT16) {
+                    /* NMPlatformIP4Route.n_nexthops is only 16 bit. Kernel
+                     * would not send that many hops anyway. */
+                    return NULL;
+                }
                 if (v4_n_nexthops - 1u >= v4_nh_extra_alloc) {
                     v4_nh_extra_alloc = NM_MAX(4u, v4_nh_extra_alloc * 2u);
                     if (!v4_nh_extra_nexthops_heap) {
@@ -4359,8 +4456,8 @@ rta_multipath_done:
 
     if (IS_IPv4) {
         if (nh.is_via) {
-            obj->ip4_route.via.addr_family = AF_INET6;
-            obj->ip4_route.via.addr        = nh.gateway;
+            obj->ip4_route.via_addr_family = AF_INET6;
+            obj->ip4_route.via_addr        = nh.gateway;
         } else {
             obj->ip4_route.gateway = nh.gateway.addr4;
         }
@@ -4769,6 +4866,35 @@ _new_from_nl_qdisc(NMPlatform *platform, const struct nlmsghdr *nlh, gboolean id
                 ((double) obj->qdisc.tbf.rate * psched_tick_to_time(platform, opt.buffer))
                 / PSCHED_TIME_UNITS_PER_SEC;
             obj->qdisc.tbf.limit = opt.limit;
+        } else if (nm_streq0(obj->qdisc.kind, "mqprio")) {
+            static const struct nla_policy mqprio_policy[] = {
+                [TCA_MQPRIO_MODE] = {.type = NLA_U16},
+            };
+            struct nlattr        *mqprio_tb[G_N_ELEMENTS(mqprio_policy)];
+            struct tc_mqprio_qopt opt;
+            const int             opt_len = NLA_ALIGN(sizeof(opt));
+
+            if (nla_len(tb[TCA_OPTIONS]) < (int) sizeof(opt))
+                return NULL;
+
+            memcpy(&opt, nla_data(tb[TCA_OPTIONS]), sizeof(opt));
+            obj->qdisc.mqprio.num_tc = opt.num_tc;
+            obj->qdisc.mqprio.hw     = opt.hw;
+            memcpy(obj->qdisc.mqprio.prio_tc_map, opt.prio_tc_map, sizeof(opt.prio_tc_map));
+            memcpy(obj->qdisc.mqprio.count, opt.count, sizeof(opt.count));
+            memcpy(obj->qdisc.mqprio.offset, opt.offset, sizeof(opt.offset));
+
+            /* The attributes follow the struct. */
+            if (nla_len(tb[TCA_OPTIONS]) > opt_len
+                && nla_parse_arr(mqprio_tb,
+                                 (struct nlattr *) &((char *) nla_data(tb[TCA_OPTIONS]))[opt_len],
+                                 nla_len(tb[TCA_OPTIONS]) - opt_len,
+                                 mqprio_policy)
+                       >= 0
+                && mqprio_tb[TCA_MQPRIO_MODE]) {
+                obj->qdisc.mqprio.mode     = nla_get_u16(mqprio_tb[TCA_MQPRIO_MODE]);
+                obj->qdisc.mqprio.has_mode = TRUE;
+            }
         } else {
             nla_for_each_nested (options_attr, tb[TCA_OPTIONS], remaining) {
                 if (nla_len(options_attr) < sizeof(uint32_t))
@@ -4801,6 +4927,30 @@ _new_from_nl_qdisc(NMPlatform *platform, const struct nlmsghdr *nlh, gboolean id
                         obj->qdisc.fq_codel.ecn = !!nla_get_u32(options_attr);
                         break;
                     }
+                } else if (nm_streq0(obj->qdisc.kind, "fq")) {
+                    switch (nla_type(options_attr)) {
+                    case TCA_FQ_PLIMIT:
+                        obj->qdisc.fq.limit = nla_get_u32(options_attr);
+                        break;
+                    case TCA_FQ_FLOW_PLIMIT:
+                        obj->qdisc.fq.flow_limit = nla_get_u32(options_attr);
+                        break;
+                    case TCA_FQ_QUANTUM:
+                        obj->qdisc.fq.quantum = nla_get_u32(options_attr);
+                        break;
+                    case TCA_FQ_INITIAL_QUANTUM:
+                        obj->qdisc.fq.initial_quantum = nla_get_u32(options_attr);
+                        break;
+                    case TCA_FQ_FLOW_MAX_RATE:
+                        /* ~0U means unlimited. */
+                        obj->qdisc.fq.maxrate = nla_get_u32(options_attr);
+                        if (obj->qdisc.fq.maxrate == ~0U)
+                            obj->qdisc.fq.maxrate = 0;
+                        break;
+                    case TCA_FQ_RATE_ENABLE:
+                        obj->qdisc.fq.nopacing = !nla_get_u32(options_attr);
+                        break;
+                    }
                 }
             }
         }
@@ -5084,6 +5234,23 @@ _nl_msg_new_link_set_linkinfo(struct nl_msg *msg, NMLinkType link_type, gconstpo
 
         break;
     }
+    case NM_LINK_TYPE_INFINIBAND:
+    {
+        const NMPlatformLnkInfiniband *props = extra_data;
+
+        nm_assert(extra_data);
+        nm_assert(props->p_key > 0 && props->p_key <= 0xffff && props->p_key != 0x8000);
+
+        if (!(data = nla_nest_start(msg, IFLA_INFO_DATA)))
+            goto nla_put_failure;
+
+        NLA_PUT_U16(msg, IFLA_IPOIB_PKEY, props->p_key);
+        if (nm_streq0(props->mode, "datagram"))
+            NLA_PUT_U16(msg, IFLA_IPOIB_MODE, IPOIB_MODE_DATAGRAM);
+        else if (nm_streq0(props->mode, "connected"))
+            NLA_PUT_U16(msg, IFLA_IPOIB_MODE, IPOIB_MODE_CONNECTED);
+        break;
+    }
     case NM_LINK_TYPE_VLAN:
     {
         const NMPlatformLnkVlan *props = extra_data;
@@ -5377,6 +5544,12 @@ _nl_msg_new_link_set_linkinfo(struct nl_msg *msg, NMLinkType link_type, gconstpo
         NLA_PUT_U8(msg, IFLA_MACSEC_SCB, props->scb);
         NLA_PUT_U8(msg, IFLA_MACSEC_REPLAY_PROTECT, props->replay_protect);
         NLA_PUT_U8(msg, IFLA_MACSEC_VALIDATION, props->validation);
+
+        /* Only kernels since 5.7 know the attribute. Don't send the default,
+         * so that creating a link without offload keeps working on older
+         * kernels. */
+        if (props->offload)
+            NLA_PUT_U8(msg, IFLA_MACSEC_OFFLOAD, props->offload);
         break;
     };
     case NM_LINK_TYPE_MACVTAP:
@@ -5691,7 +5864,25 @@ ip_route_get_lock_flag(const NMPlatformIPRoute *route)
 }
 
 static gboolean
-ip_route_is_alive(const NMPlatformIPRoute *route)
+ip_route_table_is_tracked(NMPlatform *platform, guint32 table)
+{
+    NMLinuxPlatformPrivate *priv = NM_LINUX_PLATFORM_GET_PRIVATE(platform);
+    gssize                  idx;
+
+    if (priv->route_tables_tracked.len == 0)
+        return TRUE;
+
+    idx = nm_array_find_bsearch(priv->route_tables_tracked.tables,
+                                priv->route_tables_tracked.len,
+                                sizeof(guint32),
+                                &table,
+                                nm_cmp_uint32_p_with_data,
+                                NULL);
+    return idx >= 0;
+}
+
+static gboolean
+ip_route_is_alive(NMPlatform *platform, const NMPlatformIPRoute *route)
 {
     guint8 proto, type;
 
@@ -5704,7 +5895,11 @@ ip_route_is_alive(const NMPlatformIPRoute *route)
 
     nm_assert(nmp_utils_ip_config_source_from_rtprot(proto) == route->rt_source);
 
-    return ip_route_is_tracked(proto, type);
+    if (!ip_route_is_tracked(proto, type))
+        return FALSE;
+
+    return ip_route_table_is_tracked(platform,
+                                     nm_platform_route_table_uncoerce(route->table_coerced, TRUE));
 }
 
 /* Copied and modified from libnl3's build_route_msg() and rtnl_route_build_msg(). */
@@ -5863,21 +6058,21 @@ _nl_msg_new_route(uint16_t nlmsg_type, uint16_t nlmsg_flags, const NMPObject *ob
 
     /* We currently don't have need for multi-hop routes... */
     if (IS_IPv4) {
-        if (obj->ip4_route.gateway == INADDR_ANY && obj->ip4_route.via.addr_family != AF_UNSPEC) {
+        if (obj->ip4_route.gateway == INADDR_ANY && obj->ip4_route.via_addr_family != AF_UNSPEC) {
             struct rtvia *rtvia;
 
-            nm_assert(obj->ip4_route.via.addr_family == AF_INET6);
+            nm_assert(obj->ip4_route.via_addr_family == AF_INET6);
 
             rtvia = nla_data(nla_reserve(
                 msg,
                 RTA_VIA,
-                sizeof(*rtvia) + nm_utils_addr_family_to_size(obj->ip4_route.via.addr_family)));
+                sizeof(*rtvia) + nm_utils_addr_family_to_size(obj->ip4_route.via_addr_family)));
             if (!rtvia)
                 goto nla_put_failure;
-            rtvia->rtvia_family = obj->ip4_route.via.addr_family;
+            rtvia->rtvia_family = obj->ip4_route.via_addr_family;
             memcpy(rtvia->rtvia_addr,
-                   obj->ip4_route.via.addr.addr_ptr,
-                   nm_utils_addr_family_to_size(obj->ip4_route.via.addr_family));
+                   obj->ip4_route.via_addr.addr_ptr,
+                   nm_utils_addr_family_to_size(obj->ip4_route.via_addr_family));
         } else {
             NLA_PUT(msg, RTA_GATEWAY, addr_len, &obj->ip4_route.gateway);
         }
@@ -6011,6 +6206,52 @@ nla_put_failure:
     g_return_val_if_reached(NULL);
 }
 
+static struct nl_msg *
+_nl_msg_new_nexthop(uint16_t nlmsg_type, uint16_t nlmsg_flags, const NMPlatformNexthop *nexthop)
+{
+    nm_auto_nlmsg struct nl_msg *msg = NULL;
+    const struct nhmsg           nhm = {
+                  .nh_family = nexthop->n_group > 0 ? AF_UNSPEC : nexthop->addr_family,
+    };
+
+    msg = nlmsg_alloc_new(0, nlmsg_type, nlmsg_flags);
+
+    if (nlmsg_append_struct(msg, &nhm) < 0)
+        goto nla_put_failure;
+
+    NLA_PUT_U32(msg, NHA_ID, nexthop->id);
+
+    if (nlmsg_type != RTM_NEWNEXTHOP)
+        goto out;
+
+    if (nexthop->n_group > 0) {
+        gs_free struct nexthop_grp *grp = g_new0(struct nexthop_grp, nexthop->n_group);
+        guint                       i;
+
+        for (i = 0; i < nexthop->n_group; i++) {
+            grp[i].id     = nexthop->group[i].id;
+            grp[i].weight = NM_CLAMP(nexthop->group[i].weight, 1u, 256u) - 1u;
+        }
+        NLA_PUT(msg, NHA_GROUP, sizeof(struct nexthop_grp) * nexthop->n_group, grp);
+    } else if (nexthop->blackhole)
+        NLA_PUT_FLAG(msg, NHA_BLACKHOLE);
+    else {
+        NLA_PUT_U32(msg, NHA_OIF, nexthop->ifindex);
+        if (!nm_ip_addr_is_null(nexthop->addr_family, &nexthop->gateway)) {
+            NLA_PUT(msg,
+                    NHA_GATEWAY,
+                    nm_utils_addr_family_to_size(nexthop->addr_family),
+                    &nexthop->gateway);
+        }
+    }
+
+out:
+    return g_steal_pointer(&msg);
+
+nla_put_failure:
+    g_return_val_if_reached(NULL);
+}
+
 static struct nl_msg *
 _nl_msg_new_qdisc(uint16_t nlmsg_type, uint16_t nlmsg_flags, const NMPlatformQdisc *qdisc)
 {
@@ -6066,6 +6307,24 @@ _nl_msg_new_qdisc(uint16_t nlmsg_type, uint16_t nlmsg_flags, const NMPlatformQdi
         struct tc_prio_qopt opt = {3, {1, 2, 2, 2, 1, 2, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1}};
 
         NLA_PUT(msg, TCA_OPTIONS, sizeof(opt), &opt);
+    } else if (nm_streq(qdisc->kind, "mqprio")) {
+        struct tc_mqprio_qopt opt = {
+            .num_tc = qdisc->mqprio.num_tc,
+            .hw     = qdisc->mqprio.hw,
+        };
+
+        memcpy(opt.prio_tc_map, qdisc->mqprio.prio_tc_map, sizeof(opt.prio_tc_map));
+        memcpy(opt.count, qdisc->mqprio.count, sizeof(opt.count));
+        memcpy(opt.offset, qdisc->mqprio.offset, sizeof(opt.offset));
+
+        /* Like tc, the struct comes first and the attributes follow it. */
+        if (!(tc_options = nla_nest_start(msg, TCA_OPTIONS)))
+            goto nla_put_failure;
+        if (nlmsg_append(msg, &opt, sizeof(opt), NLA_ALIGNTO) < 0)
+            goto nla_put_failure;
+        if (qdisc->mqprio.has_mode)
+            NLA_PUT_U16(msg, TCA_MQPRIO_MODE, qdisc->mqprio.mode);
+        nla_nest_end(msg, tc_options);
     } else {
         if (!(tc_options = nla_nest_start(msg, TCA_OPTIONS)))
             goto nla_put_failure;
@@ -6087,6 +6346,19 @@ _nl_msg_new_qdisc(uint16_t nlmsg_type, uint16_t nlmsg_flags, const NMPlatformQdi
                 NLA_PUT_U32(msg, TCA_FQ_CODEL_MEMORY_LIMIT, qdisc->fq_codel.memory_limit);
             if (qdisc->fq_codel.ecn)
                 NLA_PUT_U32(msg, TCA_FQ_CODEL_ECN, qdisc->fq_codel.ecn);
+        } else if (nm_streq(qdisc->kind, "fq")) {
+            if (qdisc->fq.limit)
+                NLA_PUT_U32(msg, TCA_FQ_PLIMIT, qdisc->fq.limit);
+            if (qdisc->fq.flow_limit)
+                NLA_PUT_U32(msg, TCA_FQ_FLOW_PLIMIT, qdisc->fq.flow_limit);
+            if (qdisc->fq.quantum)
+                NLA_PUT_U32(msg, TCA_FQ_QUANTUM, qdisc->fq.quantum);
+            if (qdisc->fq.initial_quantum)
+                NLA_PUT_U32(msg, TCA_FQ_INITIAL_QUANTUM, qdisc->fq.initial_quantum);
+            if (qdisc->fq.maxrate)
+                NLA_PUT_U32(msg, TCA_FQ_FLOW_MAX_RATE, qdisc->fq.maxrate);
+            if (qdisc->fq.nopacing)
+                NLA_PUT_U32(msg, TCA_FQ_RATE_ENABLE, 0);
         }
 
         nla_nest_end(msg, tc_options);
@@ -6186,6 +6458,36 @@ nla_put_failure:
     g_return_val_if_reached(NULL);
 }
 
+static struct nl_msg *
+_nl_msg_new_neigh(uint16_t nlmsg_type, uint16_t nlmsg_flags, const NMPlatformNeigh *neigh)
+{
+    nm_auto_nlmsg struct nl_msg *msg = NULL;
+    const struct ndmsg           ndm = {
+                  .ndm_family  = neigh->addr_family,
+                  .ndm_ifindex = neigh->ifindex,
+                  .ndm_state   = neigh->state,
+                  .ndm_flags   = neigh->flags,
+    };
+
+    nm_assert(NM_IN_SET(nlmsg_type, RTM_NEWNEIGH, RTM_DELNEIGH));
+
+    msg = nlmsg_alloc_new(0, nlmsg_type, nlmsg_flags);
+
+    if (nlmsg_append_struct(msg, &ndm) < 0)
+        goto nla_put_failure;
+
+    if (NM_IN_SET(neigh->dst_family, AF_INET, AF_INET6))
+        NLA_PUT(msg, NDA_DST, nm_utils_addr_family_to_size(neigh->dst_family), &neigh->dst);
+
+    if (nlmsg_type == RTM_NEWNEIGH || neigh->addr_family == AF_BRIDGE)
+        NLA_PUT(msg, NDA_LLADDR, sizeof(neigh->lladdr), &neigh->lladdr);
+
+    return g_steal_pointer(&msg);
+
+nla_put_failure:
+    g_return_val_if_reached(NULL);
+}
+
 /*****************************************************************************/
 
 #define ASSERT_SYSCTL_ARGS(pathid, dirfd, path)                                                   \
@@ -6201,7 +6503,8 @@ nla_put_failure:
             nm_assert(!_pathid);                                                                  \
             nm_assert(_path[0] == '/');                                                           \
             nm_assert(NM_STR_HAS_PREFIX(_path, "/proc/sys/") || NM_STR_HAS_PREFIX(_path, "/sys/") \
-                      || NM_STR_HAS_PREFIX(_path, "/proc/net"));                                  \
+                      || NM_STR_HAS_PREFIX(_path, "/proc/net")                                    \
+                      || NM_STR_HAS_PREFIX(_path, "/proc/irq/"));                                 \
         } else {                                                                                  \
             nm_assert(_pathid && _pathid[0] && _pathid[0] != '/');                                \
             nm_assert(_path[0] != '/');                                                           \
@@ -7164,7 +7467,11 @@ delayed_action_handle_REFRESH_ALL(NMPlatform *platform, DelayedActionType flags)
 static void
 delayed_action_handle_READ_NETLINK(NMPlatform *platform, NMPNetlinkProtocol netlink_protocol)
 {
-    event_handler_read_netlink(platform, netlink_protocol, FALSE);
+    /* We might have many platform instances (one per network namespace), all
+     * dispatched on the same main context. When handling events, don't drain
+     * the socket at once, so that a busy instance does not starve the others.
+     * The remaining messages trigger the event source again. */
+    event_handler_read_netlink_full(platform, netlink_protocol, FALSE, READ_NETLINK_MAX_READS);
 }
 
 static void
@@ -7285,8 +7592,93 @@ delayed_action_handle_one(NMPlatform *platform)
     return FALSE;
 }
 
-static gboolean
-delayed_action_handle_all(NMPlatform *platform)
+/*****************************************************************************/
+
+static void
+_rtnl_handle_overrun(NMPlatform *platform)
+{
+    NMLinuxPlatformPrivate *priv     = NM_LINUX_PLATFORM_GET_PRIVATE(platform);
+    const gint64            now_msec = nm_utils_get_monotonic_timestamp_msec();
+    guint64                 n_messages;
+    gint64                  elapsed_msec;
+    int                     rcvbuf;
+    int                     r;
+
+    n_messages   = priv->rtnl_stats.n_messages - priv->rtnl_stats.n_messages_at_overrun;
+    elapsed_msec = now_msec - priv->rtnl_stats.overrun_msec;
+
+    priv->rtnl_stats.n_overruns++;
+    priv->rtnl_stats.n_messages_at_overrun = priv->rtnl_stats.n_messages;
+    priv->rtnl_stats.overrun_msec          = now_msec;
+    if (priv->rtnl_stats.resync_start_msec == 0)
+        priv->rtnl_stats.resync_start_msec = now_msec;
+
+    _LOGI("netlink[rtnl]: overrun #%u after %" G_GUINT64_FORMAT " messages (%" G_GUINT64_FORMAT
+          " messages/sec)",
+          priv->rtnl_stats.n_overruns,
+          n_messages,
+          elapsed_msec > 0 ? (n_messages * 1000u) / ((guint64) elapsed_msec) : n_messages);
+
+    if (priv->rtnl_stats.rcvbuf >= priv->rtnl_stats.rcvbuf_max)
+        return;
+
+    rcvbuf = priv->rtnl_stats.rcvbuf > priv->rtnl_stats.rcvbuf_max / 2
+                 ? priv->rtnl_stats.rcvbuf_max
+                 : priv->rtnl_stats.rcvbuf * 2;
+
+    r = nl_socket_set_rx_buffer_size(priv->sk_rtnl, rcvbuf, TRUE);
+    if (r < 0) {
+        _LOGW("netlink[rtnl]: failure to increase receive buffer size to %d: %s",
+              rcvbuf,
+              nm_strerror(r));
+        return;
+    }
+
+    priv->rtnl_stats.rcvbuf = rcvbuf;
+    _LOGI("netlink[rtnl]: increased receive buffer size to %d (actual %d, maximum %d)",
+          rcvbuf,
+          nl_socket_get_rx_buffer_size(priv->sk_rtnl),
+          priv->rtnl_stats.rcvbuf_max);
+}
+
+static void
+_rtnl_check_resync_done(NMPlatform *platform)
+{
+    NMLinuxPlatformPrivate *priv = NM_LINUX_PLATFORM_GET_PRIVATE(platform);
+    RefreshAllType          refresh_all_type;
+    gint64                  now_msec;
+
+    if (priv->rtnl_stats.refresh_all_start_msec == 0)
+        return;
+
+    if (NM_FLAGS_ANY(priv->delayed_action.flags, DELAYED_ACTION_TYPE_REFRESH_RTNL_ALL))
+        return;
+
+    for (refresh_all_type = _REFRESH_ALL_TYPE_FIRST; refresh_all_type < _REFRESH_ALL_TYPE_NUM;
+         refresh_all_type++) {
+        if (refresh_all_type == REFRESH_ALL_TYPE_GENL_FAMILIES)
+            continue;
+        if (priv->delayed_action.refresh_all_in_progress[refresh_all_type] > 0)
+            return;
+    }
+
+    now_msec = nm_utils_get_monotonic_timestamp_msec();
+
+    if (priv->rtnl_stats.resync_start_msec != 0) {
+        _LOGI("netlink[rtnl]: resynchronized platform cache in %" G_GINT64_FORMAT
+              " msec (%u overruns so far)",
+              now_msec - priv->rtnl_stats.resync_start_msec,
+              priv->rtnl_stats.n_overruns);
+        priv->rtnl_stats.resync_start_msec = 0;
+    } else {
+        _LOGD("netlink[rtnl]: dumped all objects in %" G_GINT64_FORMAT " msec",
+              now_msec - priv->rtnl_stats.refresh_all_start_msec);
+    }
+    priv->rtnl_stats.refresh_all_start_msec = 0;
+
+    nm_platform_emit_resync_done(platform);
+}
+
 {
     NMLinuxPlatformPrivate *priv = NM_LINUX_PLATFORM_GET_PRIVATE(platform);
     gboolean                any  = FALSE;
@@ -7300,6 +7692,8 @@ delayed_action_handle_all(NMPlatform *platform)
 
     cache_prune_all(platform);
 
+    _rtnl_check_resync_done(platform);
+
     return any;
 }
 
@@ -7357,7 +7751,8 @@ delayed_action_schedule(NMPlatform *platform, DelayedActionType action_type, gpo
 static void
 delayed_action_schedule_refresh_all(NMPlatform *platform, NMPNetlinkProtocol netlink_protocol)
 {
-    DelayedActionType action_type;
+    NMLinuxPlatformPrivate *priv = NM_LINUX_PLATFORM_GET_PRIVATE(platform);
+    DelayedActionType       action_type;
 
     if (netlink_protocol == NMP_NETLINK_ROUTE) {
         action_type = DELAYED_ACTION_TYPE_REFRESH_ALL_RTNL_LINKS
@@ -7370,6 +7765,8 @@ delayed_action_schedule_refresh_all(NMPlatform *platform, NMPNetlinkProtocol net
             action_type |= (DELAYED_ACTION_TYPE_REFRESH_ALL_RTNL_QDISCS
                             | DELAYED_ACTION_TYPE_REFRESH_ALL_RTNL_TFILTERS);
         }
+        if (priv->rtnl_stats.refresh_all_start_msec == 0)
+            priv->rtnl_stats.refresh_all_start_msec = nm_utils_get_monotonic_timestamp_msec();
     } else {
         nm_assert(netlink_protocol == NMP_NETLINK_GENERIC);
         action_type = DELAYED_ACTION_TYPE_REFRESH_ALL_GENL_FAMILIES;
@@ -7450,6 +7847,27 @@ cache_prune_one_type(NMPlatform *platform, const NMPLookup *lookup)
     }
 }
 
+static void
+cache_prune_tc_for_ifindex(NMPlatform *platform, int ifindex)
+{
+    static const NMPObjectType obj_types[] = {
+        NMP_OBJECT_TYPE_TFILTER,
+        NMP_OBJECT_TYPE_QDISC,
+    };
+    NMPCache *cache = nm_platform_get_cache(platform);
+    int       i;
+
+    /* When a link goes away, so do its qdiscs and tfilters. Drop them
+     * from the cache, instead of re-dumping the tc objects of all links. */
+    for (i = 0; i < (int) G_N_ELEMENTS(obj_types); i++) {
+        NMPLookup lookup;
+
+        nmp_lookup_init_object_by_ifindex(&lookup, obj_types[i], ifindex);
+        nmp_cache_dirty_set_all_main(cache, &lookup);
+        cache_prune_one_type(platform, &lookup);
+    }
+}
+
 static void
 cache_prune_all(NMPlatform *platform)
 {
@@ -7504,6 +7922,12 @@ cache_on_change(NMPlatform      *platform,
              ? nmp_object_to_string(obj_new, NMP_OBJECT_TO_STRING_ALL, str_buf, sizeof(str_buf))
              : ""));
 
+    nm_platform_trace_record(platform,
+                             "update-cache",
+                             (NMPlatformSignalChangeType) cache_op,
+                             cache_op != NMP_CACHE_OPS_ADDED ? obj_old : NULL,
+                             cache_op != NMP_CACHE_OPS_REMOVED ? obj_new : NULL);
+
     switch (klass->obj_type) {
     case NMP_OBJECT_TYPE_LINK:
     {
@@ -7536,7 +7960,8 @@ cache_on_change(NMPlatform      *platform,
         {
             int ifindex = 0;
 
-            /* if we remove a link (from netlink), we must refresh the addresses, routes, qdiscs and tfilters */
+            /* if we remove a link (from netlink), we must refresh the addresses and routes,
+             * and drop its qdiscs and tfilters */
             if (cache_op == NMP_CACHE_OPS_REMOVED
                 && obj_old /* <-- nonsensical, make coverity happy */)
                 ifindex = obj_old->link.ifindex;
@@ -7554,12 +7979,10 @@ cache_on_change(NMPlatform      *platform,
                         | DELAYED_ACTION_TYPE_REFRESH_ALL_RTNL_IP6_ADDRESSES
                         | DELAYED_ACTION_TYPE_REFRESH_ALL_RTNL_IP4_ROUTES
                         | DELAYED_ACTION_TYPE_REFRESH_ALL_RTNL_IP6_ROUTES
-                        | DELAYED_ACTION_TYPE_REFRESH_ALL_RTNL_ROUTING_RULES_ALL
-                        | (nm_platform_get_cache_tc(platform)
-                               ? (DELAYED_ACTION_TYPE_REFRESH_ALL_RTNL_QDISCS
-                                  | DELAYED_ACTION_TYPE_REFRESH_ALL_RTNL_TFILTERS)
-                               : DELAYED_ACTION_TYPE_NONE),
+                        | DELAYED_ACTION_TYPE_REFRESH_ALL_RTNL_ROUTING_RULES_ALL,
                     NULL);
+                if (nm_platform_get_cache_tc(platform))
+                    cache_prune_tc_for_ifindex(platform, ifindex);
             }
         }
         {
@@ -7739,6 +8162,49 @@ _nlh_seq_next_get(NMLinuxPlatformPrivate *priv, NMPNetlinkProtocol netlink_proto
     return (++(*p)) ?: (++(*p));
 }
 
+/**
+ * _nl_sendmsg_rtnl_buf:
+ * @platform: the #NMPlatform
+ * @buf: the buffer with one or several netlink messages.
+ * @len: the length of @buf.
+ *
+ * Sends the raw buffer as one datagram on the rtnl socket. Kernel
+ * processes all the netlink messages therein in order.
+ *
+ * Returns: 0 on success or a negative errno.
+ */
+static int
+_nl_sendmsg_rtnl_buf(NMPlatform *platform, gconstpointer buf, gsize len)
+{
+    NMLinuxPlatformPrivate *priv   = NM_LINUX_PLATFORM_GET_PRIVATE(platform);
+    struct sockaddr_nl      nladdr = {
+        .nl_family = AF_NETLINK,
+    };
+    struct iovec  iov = {.iov_base = (gpointer) buf, .iov_len = len};
+    struct msghdr msg = {
+        .msg_name    = &nladdr,
+        .msg_namelen = sizeof(nladdr),
+        .msg_iov     = &iov,
+        .msg_iovlen  = 1,
+    };
+    int try_count = 0;
+    int errsv;
+
+again:
+    errsv = sendmsg(nl_socket_get_fd(priv->sk_rtnl), &msg, 0);
+    if (errsv < 0) {
+        errsv = errno;
+        if (errsv == EINTR && try_count++ < 100)
+            goto again;
+        _LOGI("netlink: nl-send-nlmsghdr: failed sending message: %s (%d)",
+              nm_strerror_native(errsv),
+              errsv);
+        return -nm_errno_from_native(errsv);
+    }
+
+    return 0;
+}
+
 /**
  * _nl_send_nlmsghdr:
  * @platform:
@@ -7768,36 +8234,13 @@ _nl_send_nlmsghdr(NMPlatform                        *platform,
     seq              = _nlh_seq_next_get(priv, NMP_NETLINK_ROUTE);
     nlhdr->nlmsg_seq = seq;
 
-    {
-        struct sockaddr_nl nladdr = {
-            .nl_family = AF_NETLINK,
-        };
-        struct iovec  iov = {.iov_base = nlhdr, .iov_len = nlhdr->nlmsg_len};
-        struct msghdr msg = {
-            .msg_name    = &nladdr,
-            .msg_namelen = sizeof(nladdr),
-            .msg_iov     = &iov,
-            .msg_iovlen  = 1,
-        };
-        int try_count;
-
-        if (!nlhdr->nlmsg_pid)
-            nlhdr->nlmsg_pid = nl_socket_get_local_port(priv->sk_rtnl);
-        nlhdr->nlmsg_flags |= (NLM_F_REQUEST | NLM_F_ACK);
+    if (!nlhdr->nlmsg_pid)
+        nlhdr->nlmsg_pid = nl_socket_get_local_port(priv->sk_rtnl);
+    nlhdr->nlmsg_flags |= (NLM_F_REQUEST | NLM_F_ACK);
 
-        try_count = 0;
-again:
-        errsv = sendmsg(nl_socket_get_fd(priv->sk_rtnl), &msg, 0);
-        if (errsv < 0) {
-            errsv = errno;
-            if (errsv == EINTR && try_count++ < 100)
-                goto again;
-            _LOGI("netlink: nl-send-nlmsghdr: failed sending message: %s (%d)",
-                  nm_strerror_native(errsv),
-                  errsv);
-            return -nm_errno_from_native(errsv);
-        }
-    }
+    errsv = _nl_sendmsg_rtnl_buf(platform, nlhdr, nlhdr->nlmsg_len);
+    if (errsv < 0)
+        return errsv;
 
     delayed_action_schedule_WAIT_FOR_RESPONSE(platform,
                                               NMP_NETLINK_ROUTE,
@@ -8075,21 +8518,25 @@ do_request_all_no_delayed_actions(NMPlatform *platform, DelayedActionType action
          * for protocols we track. The reason is that there might be millions of
          * BGP routes we don't track and it would be very inefficient to dump them
          * all. Therefore, perform separate dumps, each for a specific protocol we
-         * track. */
+         * track. If the set of tracked tables is restricted, additionally filter
+         * each dump by table (RTA_TABLE), so that routes of other tables don't
+         * even get sent to us. */
         if (NM_IN_SET(refresh_all_type,
                       REFRESH_ALL_TYPE_RTNL_IP4_ROUTES,
                       REFRESH_ALL_TYPE_RTNL_IP6_ROUTES)) {
             struct rtmsg rtm = {
                 .rtm_family = refresh_all_info->addr_family_for_dump,
             };
-            guint retry_count = 0;
-            guint i;
+            const guint n_tables    = NM_MAX(priv->route_tables_tracked.len, 1u);
+            guint       retry_count = 0;
+            guint       i;
 
-            for (i = 0; i < G_N_ELEMENTS(ip_route_tracked_protocols); i++) {
+            for (i = 0; i < G_N_ELEMENTS(ip_route_tracked_protocols) * n_tables; i++) {
                 nm_auto_nlmsg struct nl_msg *nlmsg = NULL;
+                guint32                      table = 0;
 
                 if (retry_count > 0) {
-                    /* Try again previous protocol */
+                    /* Try again previous protocol/table */
                     i--;
                 }
 
@@ -8102,11 +8549,19 @@ do_request_all_no_delayed_actions(NMPlatform *platform, DelayedActionType action
                 if (!nlmsg)
                     goto next_after_fail;
 
-                rtm.rtm_protocol = ip_route_tracked_protocols[i];
+                rtm.rtm_protocol = ip_route_tracked_protocols[i / n_tables];
 
                 if (nlmsg_append_struct(nlmsg, &rtm) < 0)
                     g_return_if_fail(FALSE);
 
+                if (priv->route_tables_tracked.len > 0) {
+                    /* With strict checking enabled, kernel uses RTA_TABLE
+                     * as filter for the dump. */
+                    table = priv->route_tables_tracked.tables[i % n_tables];
+                    if (nla_put_uint32(nlmsg, RTA_TABLE, table) < 0)
+                        g_return_if_fail(FALSE);
+                }
+
                 *out_refresh_all_in_progress += 1;
 
                 if (_netlink_send_nlmsg(platform,
@@ -8120,12 +8575,13 @@ do_request_all_no_delayed_actions(NMPlatform *platform, DelayedActionType action
                     *out_refresh_all_in_progress -= 1;
                     retry_count++;
                     if (retry_count > 4) {
-                        _LOGE("failed dumping IPv%c routes with protocol %u, cache might be "
-                              "inconsistent",
+                        _LOGE("failed dumping IPv%c routes with protocol %u and table %u, cache "
+                              "might be inconsistent",
                               nm_utils_addr_family_to_char(rtm.rtm_family),
-                              rtm.rtm_protocol);
+                              rtm.rtm_protocol,
+                              table);
                         retry_count = 0;
-                        /* Give up and try the next protocol */
+                        /* Give up and try the next protocol/table */
                     }
                 } else {
                     retry_count = 0;
@@ -8304,6 +8760,12 @@ _rtnl_handle_msg(NMPlatform *platform, const struct nl_msg_lite *msg)
                                                    delayed_action_refresh_from_needle_object(obj));
     }
 
+    if (msghdr->nlmsg_type == RTM_NEWLINK) {
+        priv = NM_LINUX_PLATFORM_GET_PRIVATE(platform);
+        if (priv->link_expect.ifindex > 0 && priv->link_expect.ifindex == obj->link.ifindex)
+            priv->link_expect.seen = TRUE;
+    }
+
     _LOGT("event-notification: %s%s: %s",
           nl_nlmsghdr_to_str(NETLINK_ROUTE, 0, msghdr, buf_nlmsghdr, sizeof(buf_nlmsghdr)),
           is_dump ? ", in-dump" : "",
@@ -8366,7 +8828,7 @@ _rtnl_handle_msg(NMPlatform *platform, const struct nl_msg_lite *msg)
                 }
             }
 
-            route_is_alive = ip_route_is_alive(NMP_OBJECT_CAST_IP_ROUTE(obj));
+            route_is_alive = ip_route_is_alive(platform, NMP_OBJECT_CAST_IP_ROUTE(obj));
 
             cache_op = nmp_cache_update_netlink_route(cache,
                                                       obj,
@@ -8597,6 +9059,36 @@ do_add_addrroute(NMPlatform      *platform,
     return wait_for_nl_response_to_nmerr(seq_result);
 }
 
+static gboolean
+_delete_object_seq_result_is_success(const NMPObject        *obj_id,
+                                     WaitForNlResponseResult seq_result,
+                                     const char            **out_log_detail)
+{
+    const char *log_detail = "";
+    gboolean    success    = TRUE;
+
+    if (seq_result == WAIT_FOR_NL_RESPONSE_RESULT_RESPONSE_OK) {
+        /* ok */
+    } else if (NM_IN_SET(-((int) seq_result), ESRCH, ENOENT))
+        log_detail = ", meaning the object was already removed";
+    else if (NM_IN_SET(-((int) seq_result), ENXIO)
+             && NM_IN_SET(NMP_OBJECT_GET_TYPE(obj_id), NMP_OBJECT_TYPE_IP6_ADDRESS)) {
+        /* On RHEL7 kernel, deleting a non existing address fails with ENXIO */
+        log_detail = ", meaning the address was already removed";
+    } else if (NM_IN_SET(-((int) seq_result), ENODEV)) {
+        log_detail = ", meaning the device was already removed";
+    } else if (NM_IN_SET(-((int) seq_result), EADDRNOTAVAIL)
+               && NM_IN_SET(NMP_OBJECT_GET_TYPE(obj_id),
+                            NMP_OBJECT_TYPE_IP4_ADDRESS,
+                            NMP_OBJECT_TYPE_IP6_ADDRESS))
+        log_detail = ", meaning the address was already removed";
+    else
+        success = FALSE;
+
+    NM_SET_OUT(out_log_detail, log_detail);
+    return success;
+}
+
 static gboolean
 do_delete_object(NMPlatform *platform, const NMPObject *obj_id, struct nl_msg *nlmsg)
 {
@@ -8627,24 +9119,7 @@ do_delete_object(NMPlatform *platform, const NMPObject *obj_id, struct nl_msg *n
 
         nm_assert(seq_result != WAIT_FOR_NL_RESPONSE_RESULT_UNKNOWN);
 
-        success = TRUE;
-        if (seq_result == WAIT_FOR_NL_RESPONSE_RESULT_RESPONSE_OK) {
-            /* ok */
-        } else if (NM_IN_SET(-((int) seq_result), ESRCH, ENOENT))
-            log_detail = ", meaning the object was already removed";
-        else if (NM_IN_SET(-((int) seq_result), ENXIO)
-                 && NM_IN_SET(NMP_OBJECT_GET_TYPE(obj_id), NMP_OBJECT_TYPE_IP6_ADDRESS)) {
-            /* On RHEL7 kernel, deleting a non existing address fails with ENXIO */
-            log_detail = ", meaning the address was already removed";
-        } else if (NM_IN_SET(-((int) seq_result), ENODEV)) {
-            log_detail = ", meaning the device was already removed";
-        } else if (NM_IN_SET(-((int) seq_result), EADDRNOTAVAIL)
-                   && NM_IN_SET(NMP_OBJECT_GET_TYPE(obj_id),
-                                NMP_OBJECT_TYPE_IP4_ADDRESS,
-                                NMP_OBJECT_TYPE_IP6_ADDRESS))
-            log_detail = ", meaning the address was already removed";
-        else
-            success = FALSE;
+        success = _delete_object_seq_result_is_success(obj_id, seq_result, &log_detail);
 
         _NMLOG(success ? LOGL_DEBUG : LOGL_WARN,
                "do-delete-%s[%s]: %s%s",
@@ -8681,6 +9156,7 @@ do_change_link(NMPlatform           *platform,
                struct nl_msg        *nlmsg,
                const ChangeLinkData *data)
 {
+    NMLinuxPlatformPrivate     *priv  = NM_LINUX_PLATFORM_GET_PRIVATE(platform);
     nm_auto_pop_netns NMPNetns *netns = NULL;
     int                         nle;
     WaitForNlResponseResult     seq_result;
@@ -8716,12 +9192,25 @@ retry:
         goto out;
     }
 
-    /* always refetch the link after changing it. There seems to be issues
-     * and we sometimes lack events. Nuke it from the orbit... */
-    delayed_action_schedule(platform, DELAYED_ACTION_TYPE_REFRESH_LINK, GINT_TO_POINTER(ifindex));
+    /* Kernel sends the RTM_NEWLINK notification about the change before the
+     * response on the same socket. So while waiting for the response, we also
+     * receive the notification and don't need to refetch the link. Only if the
+     * notification did not come (because nothing changed, the request failed
+     * or we lack events for other reasons), refetch it. */
+    priv->link_expect.ifindex = ifindex;
+    priv->link_expect.seen    = FALSE;
 
     delayed_action_handle_all(platform);
 
+    if (!priv->link_expect.seen) {
+        _LOGt("do-change-link[%d]: no notification received, refetch link", ifindex);
+        delayed_action_schedule(platform,
+                                DELAYED_ACTION_TYPE_REFRESH_LINK,
+                                GINT_TO_POINTER(ifindex));
+        delayed_action_handle_all(platform);
+    }
+    priv->link_expect.ifindex = 0;
+
     nm_assert(seq_result != WAIT_FOR_NL_RESPONSE_RESULT_UNKNOWN);
 
     if (NM_IN_SET(seq_result, WAIT_FOR_NL_RESPONSE_RESULT_RESPONSE_OK, -EEXIST, -EADDRINUSE)) {
@@ -8791,6 +9280,46 @@ link_change_extra(NMPlatform *platform, NMLinkType type, int ifindex, gconstpoin
     return do_change_link(platform, CHANGE_LINK_TYPE_UNSPEC, ifindex, nlmsg, NULL);
 }
 
+/* The maximum size of one datagram with batched requests. Kernel rejects
+ * datagrams that exceed the send buffer of the socket. */
+#define OBJECT_BATCH_SEND_BUF_MAX (32u * 1024u)
+
+/* The maximum number of requests in flight before collecting the responses.
+ * Each pending response occupies space in the receive buffer of the socket. */
+#define OBJECT_BATCH_WINDOW_MAX 1024u
+
+static struct nl_msg *
+_nl_msg_new_link_add(NMLinkType    type,
+                     const char   *name,
+                     int           parent,
+                     const void   *address,
+                     size_t        address_len,
+                     guint32       mtu,
+                     gconstpointer extra_data)
+{
+    nm_auto_nlmsg struct nl_msg *nlmsg = NULL;
+
+    nlmsg = _nl_msg_new_link(RTM_NEWLINK, NLM_F_CREATE | NLM_F_EXCL, 0, name);
+    if (!nlmsg)
+        return NULL;
+
+    if (parent > 0)
+        NLA_PUT_U32(nlmsg, IFLA_LINK, parent);
+
+    if (address && address_len)
+        NLA_PUT(nlmsg, IFLA_ADDRESS, address_len, address);
+
+    if (mtu)
+        NLA_PUT_U32(nlmsg, IFLA_MTU, mtu);
+
+    if (!_nl_msg_new_link_set_linkinfo(nlmsg, type, extra_data))
+        return NULL;
+
+    return g_steal_pointer(&nlmsg);
+nla_put_failure:
+    g_return_val_if_reached(NULL);
+}
+
 static int
 link_add(NMPlatform            *platform,
          NMLinkType             type,
@@ -8816,39 +9345,97 @@ link_add(NMPlatform            *platform,
             (void) nmp_utils_modprobe(NULL, TRUE, "bonding", "max_bonds=0", NULL);
     }
 
-    nlmsg = _nl_msg_new_link(RTM_NEWLINK, NLM_F_CREATE | NLM_F_EXCL, 0, name);
+    nlmsg = _nl_msg_new_link_add(type, name, parent, address, address_len, mtu, extra_data);
     if (!nlmsg)
         return -NME_UNSPEC;
 
-    if (parent > 0)
-        NLA_PUT_U32(nlmsg, IFLA_LINK, parent);
-
-    if (address && address_len)
-        NLA_PUT(nlmsg, IFLA_ADDRESS, address_len, address);
-
-    if (mtu)
-        NLA_PUT_U32(nlmsg, IFLA_MTU, mtu);
-
-    if (!_nl_msg_new_link_set_linkinfo(nlmsg, type, extra_data))
-        return -NME_UNSPEC;
-
     return do_add_link_with_lookup(platform, type, name, nlmsg, out_link);
-nla_put_failure:
-    g_return_val_if_reached(-NME_BUG);
 }
 
-static gboolean
-link_delete(NMPlatform *platform, int ifindex)
+static void
+link_add_batch(NMPlatform *platform, NMPlatformLinkAddOp *ops, guint n_ops)
 {
-    nm_auto_nlmsg struct nl_msg *nlmsg = NULL;
-    NMPObject                    obj_id;
-    const NMPObject             *obj;
+    gs_free WaitForNlResponseResult *seq_results = NULL;
+    gs_free char                   **extack_msgs = NULL;
+    char                             s_buf[256];
+    guint                            i;
+    guint                            i_window;
 
-    obj = nmp_cache_lookup_link(nm_platform_get_cache(platform), ifindex);
-    if (!obj || !obj->_link.netlink.is_in_netlink)
-        return FALSE;
+    seq_results = g_new0(WaitForNlResponseResult, n_ops);
+    extack_msgs = g_new0(char *, n_ops);
 
-    nlmsg = _nl_msg_new_link(RTM_DELLINK, 0, ifindex, NULL);
+    event_handler_read_netlink(platform, NMP_NETLINK_ROUTE, FALSE);
+
+    /* Send a window of RTM_NEWLINK requests before collecting the responses. The
+     * new links are added to the cache from the RTM_NEWLINK notifications, that
+     * are read while waiting for the responses. */
+    for (i_window = 0; i_window < n_ops; i_window = i) {
+        for (i = i_window; i < n_ops && i - i_window < OBJECT_BATCH_WINDOW_MAX; i++) {
+            nm_auto_nlmsg struct nl_msg *nlmsg = NULL;
+            NMPlatformLinkAddOp         *op    = &ops[i];
+            int                          nle;
+
+            if (op->result != 0)
+                continue;
+
+            nlmsg = _nl_msg_new_link_add(op->type,
+                                         op->name,
+                                         op->parent,
+                                         op->address.len > 0 ? op->address.data : NULL,
+                                         op->address.len,
+                                         0,
+                                         op->extra_data);
+            if (!nlmsg) {
+                op->result = -NME_UNSPEC;
+                continue;
+            }
+
+            nle = _netlink_send_nlmsg_rtnl(platform, nlmsg, &seq_results[i], &extack_msgs[i]);
+            if (nle < 0) {
+                _LOGE("do-add-link[%s/%s]: failed sending netlink request \"%s\" (%d)",
+                      op->name,
+                      nm_link_type_to_string(op->type),
+                      nm_strerror(nle),
+                      -nle);
+                op->result = nle;
+            }
+        }
+
+        delayed_action_handle_all(platform);
+
+        for (i = i_window; i < n_ops && i - i_window < OBJECT_BATCH_WINDOW_MAX; i++) {
+            NMPlatformLinkAddOp *op = &ops[i];
+
+            if (seq_results[i] == WAIT_FOR_NL_RESPONSE_RESULT_UNKNOWN)
+                continue;
+
+            _NMLOG(seq_results[i] == WAIT_FOR_NL_RESPONSE_RESULT_RESPONSE_OK ? LOGL_DEBUG
+                                                                              : LOGL_WARN,
+                   "do-add-link[%s/%s]: %s",
+                   op->name,
+                   nm_link_type_to_string(op->type),
+                   wait_for_nl_response_to_string(seq_results[i],
+                                                  extack_msgs[i],
+                                                  s_buf,
+                                                  sizeof(s_buf)));
+            op->result = wait_for_nl_response_to_nmerr(seq_results[i]);
+            nm_clear_g_free(&extack_msgs[i]);
+        }
+    }
+}
+
+static gboolean
+link_delete(NMPlatform *platform, int ifindex)
+{
+    nm_auto_nlmsg struct nl_msg *nlmsg = NULL;
+    NMPObject                    obj_id;
+    const NMPObject             *obj;
+
+    obj = nmp_cache_lookup_link(nm_platform_get_cache(platform), ifindex);
+    if (!obj || !obj->_link.netlink.is_in_netlink)
+        return FALSE;
+
+    nlmsg = _nl_msg_new_link(RTM_DELLINK, 0, ifindex, NULL);
 
     nmp_object_stackinit_id_link(&obj_id, ifindex);
     return do_delete_object(platform, &obj_id, nlmsg);
@@ -8878,6 +9465,10 @@ link_change(NMPlatform                   *platform,
         NLA_PUT_U32(nlmsg, IFLA_GSO_MAX_SEGS, props->gso_max_segments);
     if (flags & NM_PLATFORM_LINK_CHANGE_GRO_MAX_SIZE)
         NLA_PUT_U32(nlmsg, IFLA_GRO_MAX_SIZE, props->gro_max_size);
+    if (flags & NM_PLATFORM_LINK_CHANGE_GSO_IPV4_MAX_SIZE)
+        NLA_PUT_U32(nlmsg, IFLA_GSO_IPV4_MAX_SIZE, props->gso_ipv4_max_size);
+    if (flags & NM_PLATFORM_LINK_CHANGE_GRO_IPV4_MAX_SIZE)
+        NLA_PUT_U32(nlmsg, IFLA_GRO_IPV4_MAX_SIZE, props->gro_ipv4_max_size);
 
     switch (port_kind) {
     case NM_PORT_KIND_BOND:
@@ -8937,6 +9528,13 @@ link_refresh(NMPlatform *platform, int ifindex)
     return !!nm_platform_link_get_obj(platform, ifindex, TRUE);
 }
 
+static void
+link_refresh_all(NMPlatform *platform)
+{
+    do_request_all_no_delayed_actions(platform, DELAYED_ACTION_TYPE_REFRESH_ALL_RTNL_LINKS);
+    delayed_action_handle_all(platform);
+}
+
 static gboolean
 link_set_netns(NMPlatform *platform, int ifindex, int netns_fd)
 {
@@ -9008,10 +9606,165 @@ link_set_token(NMPlatform *platform, int ifindex, const NMUtilsIPv6IfaceId *iid)
     return (do_change_link(platform, CHANGE_LINK_TYPE_UNSPEC, ifindex, nlmsg, NULL) >= 0);
 }
 
+/*****************************************************************************/
+
+#define LINK_PROBE_THREADED_MIN_LINKS 32
+#define LINK_PROBE_MAX_THREADS        8
+
+typedef struct {
+    /* must be the first field, the struct is hashed with nm_pint_hash(). */
+    int                       ifindex;
+    char                      ifname[IFNAMSIZ];
+    NMPUtilsEthtoolDriverInfo driver_info;
+    NMPLinkAddress            perm_address;
+    bool                      want_perm_address : 1;
+    bool                      has_driver_info : 1;
+    bool                      has_perm_address : 1;
+    bool                      supports_carrier_detect : 1;
+    bool                      supports_sriov : 1;
+} LinkProbeData;
+
+static void
+_link_probe_thread_cb(gpointer data, gpointer user_data)
+{
+    LinkProbeData *probe    = data;
+    gs_free char  *contents = NULL;
+    char           path[100];
+    size_t         len;
+
+    /* Runs on a worker thread. Only use the ioctl helpers and plain file
+     * access here, not the platform instance. */
+
+    probe->has_driver_info =
+        nmp_ethtool_ioctl_get_driver_info(probe->ifindex, &probe->driver_info);
+
+    if (probe->want_perm_address
+        && nmp_ethtool_ioctl_get_permanent_address(probe->ifindex,
+                                                   probe->perm_address.data,
+                                                   &len)) {
+        nm_assert(len <= _NM_UTILS_HWADDR_LEN_MAX);
+        probe->perm_address.len = len;
+        probe->has_perm_address = TRUE;
+    }
+
+    probe->supports_carrier_detect = nmp_ethtool_ioctl_supports_carrier_detect(probe->ifindex)
+                                     || nmp_mii_ioctl_supports_carrier_detect(probe->ifindex);
+
+    nm_sprintf_buf(path, "/sys/class/net/%s/device/sriov_numvfs", probe->ifname);
+    if (nm_utils_file_get_contents(-1,
+                                   path,
+                                   64,
+                                   NM_UTILS_FILE_GET_CONTENTS_FLAG_NONE,
+                                   &contents,
+                                   NULL,
+                                   NULL,
+                                   NULL)) {
+        probe->supports_sriov =
+            (_nm_utils_ascii_str_to_int64(contents, 10, 0, G_MAXINT32, -1) != -1);
+    }
+}
+
+static void
+link_prefetch_probes(NMPlatform *platform, const int *ifindexes, guint len)
+{
+    NMLinuxPlatformPrivate *priv   = NM_LINUX_PLATFORM_GET_PRIVATE(platform);
+    gs_free LinkProbeData **probes = NULL;
+    GThreadPool            *pool;
+    gboolean                want_perm_address;
+    guint                   n_threads;
+    guint                   n_probes = 0;
+    guint                   n_cached = 0;
+    guint                   i;
+
+    /* The worker threads run in the namespace of the process, so we only
+     * prefetch for the platform instance of the main namespace. */
+    if (nm_platform_netns_get(platform))
+        return;
+
+    n_threads = NM_MIN(g_get_num_processors(), (guint) LINK_PROBE_MAX_THREADS);
+    if (len < LINK_PROBE_THREADED_MIN_LINKS || n_threads <= 1)
+        return;
+
+    want_perm_address =
+        (nm_platform_kernel_support_get_full(NM_PLATFORM_KERNEL_SUPPORT_TYPE_IFLA_PERM_ADDRESS,
+                                             FALSE)
+         != NM_OPTION_BOOL_TRUE);
+
+    probes = g_new(LinkProbeData *, len);
+    pool   = g_thread_pool_new(_link_probe_thread_cb, NULL, n_threads, TRUE, NULL);
+
+    for (i = 0; i < len; i++) {
+        const NMPlatformLink *plink;
+        LinkProbeData        *probe;
+
+        plink = nm_platform_link_get(platform, ifindexes[i]);
+        if (!plink)
+            continue;
+
+        probe  = g_new(LinkProbeData, 1);
+        *probe = (LinkProbeData) {
+            .ifindex           = plink->ifindex,
+            .want_perm_address = want_perm_address && plink->l_perm_address.len == 0,
+        };
+        nm_utils_ifname_cpy(probe->ifname, plink->name);
+
+        probes[n_probes++] = probe;
+        g_thread_pool_push(pool, probe, NULL);
+    }
+
+    /* wait for all links to be probed. */
+    g_thread_pool_free(pool, FALSE, TRUE);
+
+    if (!priv->link_probes)
+        priv->link_probes = g_hash_table_new_full(nm_pint_hash, nm_pint_equal, g_free, NULL);
+
+    for (i = 0; i < n_probes; i++) {
+        LinkProbeData        *probe = probes[i];
+        const NMPlatformLink *plink;
+
+        /* The sysfs path depends on the name. Drop the result if the link
+         * was renamed in the meantime, the callers then probe directly. */
+        plink = nm_platform_link_get(platform, probe->ifindex);
+        if (!plink || !nm_streq(plink->name, probe->ifname)) {
+            g_free(probe);
+            continue;
+        }
+
+        g_hash_table_add(priv->link_probes, probe);
+        n_cached++;
+    }
+
+    _LOGD("link: prefetched probe data of %u links using %u threads", n_cached, n_threads);
+}
+
+static void
+link_prefetch_clear(NMPlatform *platform)
+{
+    NMLinuxPlatformPrivate *priv = NM_LINUX_PLATFORM_GET_PRIVATE(platform);
+
+    nm_clear_pointer(&priv->link_probes, g_hash_table_destroy);
+}
+
+static const LinkProbeData *
+_link_probe_lookup(NMPlatform *platform, int ifindex)
+{
+    NMLinuxPlatformPrivate *priv = NM_LINUX_PLATFORM_GET_PRIVATE(platform);
+
+    if (!priv->link_probes)
+        return NULL;
+
+    return g_hash_table_lookup(priv->link_probes, &ifindex);
+}
+
 static gboolean
 link_supports_carrier_detect(NMPlatform *platform, int ifindex)
 {
     nm_auto_pop_netns NMPNetns *netns = NULL;
+    const LinkProbeData        *probe;
+
+    probe = _link_probe_lookup(platform, ifindex);
+    if (probe)
+        return probe->supports_carrier_detect;
 
     if (!nm_platform_netns_push(platform, &netns))
         return FALSE;
@@ -9049,6 +9802,11 @@ link_supports_sriov(NMPlatform *platform, int ifindex)
     nm_auto_close int           dirfd = -1;
     char                        ifname[IFNAMSIZ];
     int                         num = -1;
+    const LinkProbeData        *probe;
+
+    probe = _link_probe_lookup(platform, ifindex);
+    if (probe)
+        return probe->supports_sriov;
 
     if (!nm_platform_netns_push(platform, &netns))
         return FALSE;
@@ -9113,6 +9871,15 @@ link_get_permanent_address_ethtool(NMPlatform *platform, int ifindex, NMPLinkAdd
     nm_auto_pop_netns NMPNetns *netns = NULL;
     guint8                      buffer[_NM_UTILS_HWADDR_LEN_MAX];
     gsize                       len;
+    const LinkProbeData        *probe;
+
+    probe = _link_probe_lookup(platform, ifindex);
+    if (probe && probe->want_perm_address) {
+        if (!probe->has_perm_address)
+            return FALSE;
+        *out_address = probe->perm_address;
+        return TRUE;
+    }
 
     if (!nm_platform_netns_push(platform, &netns))
         return FALSE;
@@ -9141,6 +9908,28 @@ nla_put_failure:
     g_return_val_if_reached(FALSE);
 }
 
+static int
+link_set_xdp(NMPlatform *platform, int ifindex, int prog_fd, guint32 xdp_flags)
+{
+    nm_auto_nlmsg struct nl_msg *nlmsg = NULL;
+    struct nlattr               *nest;
+
+    nlmsg = _nl_msg_new_link(RTM_NEWLINK, 0, ifindex, NULL);
+    if (!nlmsg)
+        return -NME_UNSPEC;
+
+    if (!(nest = nla_nest_start(nlmsg, IFLA_XDP)))
+        goto nla_put_failure;
+    NLA_PUT_S32(nlmsg, IFLA_XDP_FD, prog_fd);
+    if (xdp_flags != 0)
+        NLA_PUT_U32(nlmsg, IFLA_XDP_FLAGS, xdp_flags);
+    nla_nest_end(nlmsg, nest);
+
+    return do_change_link(platform, CHANGE_LINK_TYPE_UNSPEC, ifindex, nlmsg, NULL);
+nla_put_failure:
+    g_return_val_if_reached(-NME_BUG);
+}
+
 static gint64
 sriov_read_sysctl_uint(NMPlatform *platform,
                        int         dirfd,
@@ -9634,11 +10423,12 @@ nla_put_failure:
 }
 
 static gboolean
-link_set_bridge_vlans(NMPlatform                 *platform,
-                      int                         ifindex,
-                      gboolean                    on_controller,
-                      const NMPlatformBridgeVlan *vlans,
-                      guint                       num_vlans)
+_link_change_bridge_vlans(NMPlatform                 *platform,
+                          int                         ifindex,
+                          gboolean                    on_controller,
+                          gboolean                    is_delete,
+                          const NMPlatformBridgeVlan *vlans,
+                          guint                       num_vlans)
 {
     nm_auto_nlmsg struct nl_msg *nlmsg = NULL;
     struct nlattr               *list;
@@ -9646,8 +10436,9 @@ link_set_bridge_vlans(NMPlatform                 *platform,
     guint                        i;
 
     nm_assert(num_vlans == 0 || vlans);
+    nm_assert(is_delete || num_vlans > 0);
 
-    nlmsg = _nl_msg_new_link_full(num_vlans > 0 ? RTM_SETLINK : RTM_DELLINK,
+    nlmsg = _nl_msg_new_link_full(is_delete ? RTM_DELLINK : RTM_SETLINK,
                                   0,
                                   ifindex,
                                   NULL,
@@ -9666,7 +10457,7 @@ link_set_bridge_vlans(NMPlatform                 *platform,
                 on_controller ? BRIDGE_FLAGS_CONTROLLER : BRIDGE_FLAGS_SELF);
 
     if (num_vlans > 0) {
-        /* Add VLANs */
+        /* Add or delete VLANs. Contiguous VLANs are sent as one range. */
         for (i = 0; i < num_vlans; i++) {
             const NMPlatformBridgeVlan *vlan     = &vlans[i];
             gboolean                    is_range = vlan->vid_start != vlan->vid_end;
@@ -9674,10 +10465,12 @@ link_set_bridge_vlans(NMPlatform                 *platform,
             vinfo.vid   = vlan->vid_start;
             vinfo.flags = is_range ? BRIDGE_VLAN_INFO_RANGE_BEGIN : 0;
 
-            if (vlan->untagged)
-                vinfo.flags |= BRIDGE_VLAN_INFO_UNTAGGED;
-            if (vlan->pvid)
-                vinfo.flags |= BRIDGE_VLAN_INFO_PVID;
+            if (!is_delete) {
+                if (vlan->untagged)
+                    vinfo.flags |= BRIDGE_VLAN_INFO_UNTAGGED;
+                if (vlan->pvid)
+                    vinfo.flags |= BRIDGE_VLAN_INFO_PVID;
+            }
 
             NLA_PUT(nlmsg, IFLA_BRIDGE_VLAN_INFO, sizeof(vinfo), &vinfo);
 
@@ -9705,6 +10498,31 @@ nla_put_failure:
     g_return_val_if_reached(FALSE);
 }
 
+static gboolean
+link_set_bridge_vlans(NMPlatform                 *platform,
+                      int                         ifindex,
+                      gboolean                    on_controller,
+                      const NMPlatformBridgeVlan *vlans,
+                      guint                       num_vlans)
+{
+    return _link_change_bridge_vlans(platform,
+                                     ifindex,
+                                     on_controller,
+                                     num_vlans == 0,
+                                     vlans,
+                                     num_vlans);
+}
+
+static gboolean
+link_delete_bridge_vlans(NMPlatform                 *platform,
+                         int                         ifindex,
+                         gboolean                    on_controller,
+                         const NMPlatformBridgeVlan *vlans,
+                         guint                       num_vlans)
+{
+    return _link_change_bridge_vlans(platform, ifindex, on_controller, TRUE, vlans, num_vlans);
+}
+
 typedef struct {
     int     ifindex;
     GArray *vlans;
@@ -10099,21 +10917,111 @@ link_vlan_change(NMPlatform             *platform,
     return (do_change_link(platform, CHANGE_LINK_TYPE_UNSPEC, ifindex, nlmsg, NULL) >= 0);
 }
 
+static struct nl_msg *
+_nl_msg_new_link_attach_port(int controller, int port)
+{
+    nm_auto_nlmsg struct nl_msg *nlmsg = NULL;
+
+    nlmsg = _nl_msg_new_link(RTM_NEWLINK, 0, port, NULL);
+    if (!nlmsg)
+        return NULL;
+
+    NLA_PUT_U32(nlmsg, IFLA_CONTROLLER, controller);
+    return g_steal_pointer(&nlmsg);
+nla_put_failure:
+    g_return_val_if_reached(NULL);
+}
+
 static gboolean
 link_attach_port(NMPlatform *platform, int controller, int port)
 {
-    nm_auto_nlmsg struct nl_msg *nlmsg   = NULL;
-    int                          ifindex = port;
+    nm_auto_nlmsg struct nl_msg *nlmsg = NULL;
 
-    nlmsg = _nl_msg_new_link(RTM_NEWLINK, 0, ifindex, NULL);
+    nlmsg = _nl_msg_new_link_attach_port(controller, port);
     if (!nlmsg)
         return FALSE;
 
-    NLA_PUT_U32(nlmsg, IFLA_CONTROLLER, controller);
+    return (do_change_link(platform, CHANGE_LINK_TYPE_UNSPEC, port, nlmsg, NULL) >= 0);
+}
 
-    return (do_change_link(platform, CHANGE_LINK_TYPE_UNSPEC, ifindex, nlmsg, NULL) >= 0);
-nla_put_failure:
-    g_return_val_if_reached(FALSE);
+static void
+link_attach_port_batch(NMPlatform *platform, NMPlatformLinkAttachPortOp *ops, guint n_ops)
+{
+    gs_free WaitForNlResponseResult *seq_results = NULL;
+    gs_free char                   **extack_msgs = NULL;
+    char                             s_buf[256];
+    guint                            i;
+    guint                            i_window;
+
+    seq_results = g_new0(WaitForNlResponseResult, n_ops);
+    extack_msgs = g_new0(char *, n_ops);
+
+    event_handler_read_netlink(platform, NMP_NETLINK_ROUTE, FALSE);
+
+    /* Like link_add_batch(), send a window of requests before collecting the
+     * responses. The cache gets updated from the RTM_NEWLINK notifications. */
+    for (i_window = 0; i_window < n_ops; i_window = i) {
+        for (i = i_window; i < n_ops && i - i_window < OBJECT_BATCH_WINDOW_MAX; i++) {
+            nm_auto_nlmsg struct nl_msg *nlmsg = NULL;
+            NMPlatformLinkAttachPortOp  *op    = &ops[i];
+            int                          nle;
+
+            if (op->result != 0)
+                continue;
+
+            nlmsg = _nl_msg_new_link_attach_port(op->controller, op->port);
+            if (!nlmsg) {
+                op->result = -NME_UNSPEC;
+                continue;
+            }
+
+            nle = _netlink_send_nlmsg_rtnl(platform, nlmsg, &seq_results[i], &extack_msgs[i]);
+            if (nle < 0) {
+                _LOGE("do-attach-port[%d/%d]: failed sending netlink request \"%s\" (%d)",
+                      op->port,
+                      op->controller,
+                      nm_strerror(nle),
+                      -nle);
+                op->result = nle;
+            }
+        }
+
+        delayed_action_handle_all(platform);
+
+        for (i = i_window; i < n_ops && i - i_window < OBJECT_BATCH_WINDOW_MAX; i++) {
+            NMPlatformLinkAttachPortOp *op = &ops[i];
+            const NMPObject            *obj;
+
+            if (seq_results[i] == WAIT_FOR_NL_RESPONSE_RESULT_UNKNOWN)
+                continue;
+
+            _NMLOG(seq_results[i] == WAIT_FOR_NL_RESPONSE_RESULT_RESPONSE_OK ? LOGL_DEBUG
+                                                                              : LOGL_WARN,
+                   "do-attach-port[%d/%d]: %s",
+                   op->port,
+                   op->controller,
+                   wait_for_nl_response_to_string(seq_results[i],
+                                                  extack_msgs[i],
+                                                  s_buf,
+                                                  sizeof(s_buf)));
+            op->result = wait_for_nl_response_to_nmerr(seq_results[i]);
+            nm_clear_g_free(&extack_msgs[i]);
+
+            if (op->result < 0)
+                continue;
+
+            /* Without a notification (for example, because the port was
+             * already attached), refetch the link. */
+            obj = nmp_cache_lookup_link(nm_platform_get_cache(platform), op->port);
+            if (!obj || obj->link.controller != op->controller) {
+                delayed_action_schedule(platform,
+                                        DELAYED_ACTION_TYPE_REFRESH_LINK,
+                                        GINT_TO_POINTER(op->port));
+            }
+        }
+
+        delayed_action_handle_all(platform);
+    }
 }
 
 static gboolean
@@ -10189,6 +11097,30 @@ infiniband_partition_add(NMPlatform            *platform,
                          int                    p_key,
                          const NMPlatformLink **out_link)
 {
+    nm_auto_nlmsg struct nl_msg  *nlmsg = NULL;
+    const NMPlatformLnkInfiniband lnk   = {.p_key = p_key};
+    const char                   *ifname_parent;
+    char                          name[IFNAMSIZ];
+    int                           r;
+
+    ifname_parent = nm_platform_link_get_name(platform, parent);
+    if (!ifname_parent) {
+        errno = ENOENT;
+        return FALSE;
+    }
+
+    /* Create the child with RTM_NEWLINK. Unlike writing to the "create_child"
+     * sysfs file of the parent, that reports the result of the request
+     * and the new link is in the cache afterwards. */
+    nm_net_devname_infiniband(name, ifname_parent, p_key);
+    nlmsg = _nl_msg_new_link_add(NM_LINK_TYPE_INFINIBAND, name, parent, NULL, 0, 0, &lnk);
+    if (!nlmsg)
+        return FALSE;
+
+    r = do_add_link_with_lookup(platform, NM_LINK_TYPE_INFINIBAND, name, nlmsg, out_link);
+    if (r != -EOPNOTSUPP)
+        return r >= 0;
+
     return _infiniband_partition_action(platform,
                                         INFINIBAND_ACTION_CREATE_CHILD,
                                         parent,
@@ -10199,6 +11131,24 @@ infiniband_partition_add(NMPlatform            *platform,
 static gboolean
 infiniband_partition_delete(NMPlatform *platform, int parent, int p_key)
 {
+    const char      *ifname_parent;
+    const NMPObject *obj;
+    char             name[IFNAMSIZ];
+
+    ifname_parent = nm_platform_link_get_name(platform, parent);
+    if (ifname_parent) {
+        nm_net_devname_infiniband(name, ifname_parent, p_key);
+        obj = nmp_cache_lookup_link_full(nm_platform_get_cache(platform),
+                                         0,
+                                         name,
+                                         TRUE,
+                                         NM_LINK_TYPE_INFINIBAND,
+                                         NULL,
+                                         NULL);
+        if (obj && link_delete(platform, obj->link.ifindex))
+            return TRUE;
+    }
+
     return _infiniband_partition_action(platform,
                                         INFINIBAND_ACTION_DELETE_CHILD,
                                         parent,
@@ -10466,12 +11416,20 @@ link_get_driver_info(NMPlatform *platform,
 {
     nm_auto_pop_netns NMPNetns *netns = NULL;
     NMPUtilsEthtoolDriverInfo   driver_info;
+    const LinkProbeData        *probe;
 
-    if (!nm_platform_netns_push(platform, &netns))
-        return FALSE;
+    probe = _link_probe_lookup(platform, ifindex);
+    if (probe) {
+        if (!probe->has_driver_info)
+            return FALSE;
+        driver_info = probe->driver_info;
+    } else {
+        if (!nm_platform_netns_push(platform, &netns))
+            return FALSE;
 
-    if (!nmp_ethtool_ioctl_get_driver_info(ifindex, &driver_info))
-        return FALSE;
+        if (!nmp_ethtool_ioctl_get_driver_info(ifindex, &driver_info))
+            return FALSE;
+    }
     NM_SET_OUT(out_driver_name, g_strdup(driver_info.driver));
     NM_SET_OUT(out_driver_version, g_strdup(driver_info.version));
     NM_SET_OUT(out_fw_version, g_strdup(driver_info.fw_version));
@@ -10775,41 +11733,572 @@ object_delete(NMPlatform *platform, const NMPObject *obj)
 
 /*****************************************************************************/
 
-static int
-ip_route_get(NMPlatform   *platform,
-             int           addr_family,
-             gconstpointer address,
-             guint32       fwmark,
-             int           oif_ifindex,
-             NMPObject   **out_route)
+static struct nl_msg *
+_nl_msg_new_object_batch_op(const NMPlatformObjectBatchOp *op)
 {
-    const gboolean            IS_IPv4   = NM_IS_IPv4(addr_family);
-    const int                 addr_len  = IS_IPv4 ? 4 : 16;
-    int                       try_count = 0;
-    WaitForNlResponseResult   seq_result;
-    int                       nle;
-    nm_auto_nmpobj NMPObject *route = NULL;
+    const NMPObject *obj = op->obj_stack;
 
-    nm_assert(NM_IS_LINUX_PLATFORM(platform));
-    nm_assert(NM_IN_SET(addr_family, AF_INET, AF_INET6));
-    nm_assert(address);
+    switch (NMP_OBJECT_GET_TYPE(obj)) {
+    case NMP_OBJECT_TYPE_IP4_ADDRESS:
+        if (op->is_delete) {
+            return _nl_msg_new_address(RTM_DELADDR,
+                                       0,
+                                       AF_INET,
+                                       obj->ip4_address.ifindex,
+                                       &obj->ip4_address.address,
+                                       obj->ip4_address.plen,
+                                       &obj->ip4_address.peer_address,
+                                       0,
+                                       RT_SCOPE_NOWHERE,
+                                       NM_PLATFORM_LIFETIME_PERMANENT,
+                                       NM_PLATFORM_LIFETIME_PERMANENT,
+                                       0,
+                                       NULL);
+        }
+        return _nl_msg_new_address(RTM_NEWADDR,
+                                   NLM_F_CREATE | NLM_F_REPLACE,
+                                   AF_INET,
+                                   obj->ip4_address.ifindex,
+                                   &obj->ip4_address.address,
+                                   obj->ip4_address.plen,
+                                   &obj->ip4_address.peer_address,
+                                   obj->ip4_address.n_ifa_flags,
+                                   nm_platform_ip4_address_get_scope(obj->ip4_address.address),
+                                   obj->ip4_address.lifetime,
+                                   obj->ip4_address.preferred,
+                                   nm_platform_ip4_broadcast_address_from_addr(&obj->ip4_address),
+                                   obj->ip4_address.label);
+    case NMP_OBJECT_TYPE_IP6_ADDRESS:
+        if (op->is_delete) {
+            return _nl_msg_new_address(RTM_DELADDR,
+                                       0,
+                                       AF_INET6,
+                                       obj->ip6_address.ifindex,
+                                       &obj->ip6_address.address,
+                                       obj->ip6_address.plen,
+                                       NULL,
+                                       0,
+                                       RT_SCOPE_NOWHERE,
+                                       NM_PLATFORM_LIFETIME_PERMANENT,
+                                       NM_PLATFORM_LIFETIME_PERMANENT,
+                                       0,
+                                       NULL);
+        }
+        return _nl_msg_new_address(RTM_NEWADDR,
+                                   NLM_F_CREATE | NLM_F_REPLACE,
+                                   AF_INET6,
+                                   obj->ip6_address.ifindex,
+                                   &obj->ip6_address.address,
+                                   obj->ip6_address.plen,
+                                   IN6_IS_ADDR_UNSPECIFIED(&obj->ip6_address.peer_address)
+                                       ? NULL
+                                       : &obj->ip6_address.peer_address,
+                                   obj->ip6_address.n_ifa_flags,
+                                   RT_SCOPE_UNIVERSE,
+                                   obj->ip6_address.lifetime,
+                                   obj->ip6_address.preferred,
+                                   0,
+                                   NULL);
+    case NMP_OBJECT_TYPE_IP4_ROUTE:
+    case NMP_OBJECT_TYPE_IP6_ROUTE:
+        if (op->is_delete)
+            return _nl_msg_new_route(RTM_DELROUTE, 0, op->obj_stack);
+        return _nl_msg_new_route(RTM_NEWROUTE, op->nlm_flags & NMP_NLM_FLAG_FMASK, op->obj_stack);
+    case NMP_OBJECT_TYPE_ROUTING_RULE:
+        if (op->is_delete)
+            return _nl_msg_new_routing_rule(RTM_DELRULE, 0, NMP_OBJECT_CAST_ROUTING_RULE(obj));
+        return _nl_msg_new_routing_rule(RTM_NEWRULE,
+                                        op->nlm_flags & NMP_NLM_FLAG_FMASK,
+                                        NMP_OBJECT_CAST_ROUTING_RULE(obj));
+    case NMP_OBJECT_TYPE_NEIGH:
+        if (op->is_delete)
+            return _nl_msg_new_neigh(RTM_DELNEIGH, 0, NMP_OBJECT_CAST_NEIGH(obj));
+        return _nl_msg_new_neigh(RTM_NEWNEIGH,
+                                 op->nlm_flags & NMP_NLM_FLAG_FMASK,
+                                 NMP_OBJECT_CAST_NEIGH(obj));
+    default:
+        nm_assert_not_reached();
+        return NULL;
+    }
+}
 
-    do {
-        struct {
-            struct nlmsghdr n;
-            struct rtmsg    r;
-            char            buf[64];
-        } req = {
-            .n.nlmsg_len   = NLMSG_LENGTH(sizeof(struct rtmsg)),
-            .n.nlmsg_flags = NLM_F_REQUEST,
-            .n.nlmsg_type  = RTM_GETROUTE,
-            .r.rtm_family  = addr_family,
-            .r.rtm_tos     = 0,
-            .r.rtm_dst_len = IS_IPv4 ? 32 : 128,
-            .r.rtm_flags   = IS_IPv4 ? RTM_F_LOOKUP_TABLE : 0,
-        };
+static int routing_rule_add(NMPlatform                  *platform,
+                            NMPNlmFlags                  flags,
+                            const NMPlatformRoutingRule *routing_rule);
 
-        nm_clear_pointer(&route, nmp_object_unref);
+static int
+_object_batch_op_do_sync(NMPlatform *platform, NMPlatformObjectBatchOp *op)
+{
+    NMPObject *obj = op->obj_stack;
+    gboolean   ok;
+
+    switch (NMP_OBJECT_GET_TYPE(obj)) {
+    case NMP_OBJECT_TYPE_IP4_ADDRESS:
+        if (op->is_delete) {
+            ok = ip4_address_delete(platform,
+                                    obj->ip4_address.ifindex,
+                                    obj->ip4_address.address,
+                                    obj->ip4_address.plen,
+                                    obj->ip4_address.peer_address);
+        } else {
+            ok = ip4_address_add(platform,
+                                 obj->ip4_address.ifindex,
+                                 obj->ip4_address.address,
+                                 obj->ip4_address.plen,
+                                 obj->ip4_address.peer_address,
+                                 nm_platform_ip4_broadcast_address_from_addr(&obj->ip4_address),
+                                 obj->ip4_address.lifetime,
+                                 obj->ip4_address.preferred,
+                                 obj->ip4_address.n_ifa_flags,
+                                 obj->ip4_address.label,
+                                 &op->extack_msg);
+        }
+        return ok ? 0 : -NME_UNSPEC;
+    case NMP_OBJECT_TYPE_IP6_ADDRESS:
+        if (op->is_delete) {
+            ok = ip6_address_delete(platform,
+                                    obj->ip6_address.ifindex,
+                                    obj->ip6_address.address,
+                                    obj->ip6_address.plen);
+        } else {
+            ok = ip6_address_add(platform,
+                                 obj->ip6_address.ifindex,
+                                 obj->ip6_address.address,
+                                 obj->ip6_address.plen,
+                                 obj->ip6_address.peer_address,
+                                 obj->ip6_address.lifetime,
+                                 obj->ip6_address.preferred,
+                                 obj->ip6_address.n_ifa_flags,
+                                 &op->extack_msg);
+        }
+        return ok ? 0 : -NME_UNSPEC;
+    case NMP_OBJECT_TYPE_ROUTING_RULE:
+        if (op->is_delete)
+            return object_delete(platform, obj) ? 0 : -NME_UNSPEC;
+        return routing_rule_add(platform, op->nlm_flags, NMP_OBJECT_CAST_ROUTING_RULE(obj));
+    case NMP_OBJECT_TYPE_NEIGH:
+    {
+        nm_auto_nlmsg struct nl_msg *nlmsg      = NULL;
+        WaitForNlResponseResult      seq_result = WAIT_FOR_NL_RESPONSE_RESULT_UNKNOWN;
+
+        /* Neighbor entries are not cached, there is no synchronous API
+         * to fall back to. Just send the request again. */
+        nlmsg = _nl_msg_new_object_batch_op(op);
+        if (!nlmsg)
+            return -NME_BUG;
+        if (_netlink_send_nlmsg_rtnl(platform, nlmsg, &seq_result, &op->extack_msg) < 0)
+            return -NME_PL_NETLINK;
+        delayed_action_handle_all(platform);
+        if (op->is_delete && _delete_object_seq_result_is_success(obj, seq_result, NULL))
+            return 0;
+        return wait_for_nl_response_to_nmerr(seq_result);
+    }
+    default:
+        if (op->is_delete)
+            return object_delete(platform, obj) ? 0 : -NME_UNSPEC;
+        return ip_route_add(platform, op->nlm_flags, obj, &op->extack_msg);
+    }
+}
+
+static void
+_object_batch_op_complete(NMPlatform              *platform,
+                          NMPlatformObjectBatchOp *op,
+                          WaitForNlResponseResult  seq_result)
+{
+    char        sbuf1[NM_UTILS_TO_STRING_BUFFER_SIZE];
+    char        s_buf[256];
+    const char *log_detail = "";
+    NMLogLevel  log_level;
+
+    if (seq_result == WAIT_FOR_NL_RESPONSE_RESULT_FAILED_RESYNC) {
+        /* We lost the response due to a resync. Retry the request synchronously,
+         * which also takes care of retrying further. */
+        nm_clear_g_free(&op->extack_msg);
+        op->result = _object_batch_op_do_sync(platform, op);
+        return;
+    }
+
+    if (op->is_delete) {
+        if (_delete_object_seq_result_is_success(op->obj_stack, seq_result, &log_detail)) {
+            op->result = 0;
+            log_level  = LOGL_DEBUG;
+        } else {
+            op->result = wait_for_nl_response_to_nmerr(seq_result);
+            log_level  = LOGL_WARN;
+        }
+    } else {
+        op->result = wait_for_nl_response_to_nmerr(seq_result);
+        log_level  = (seq_result == WAIT_FOR_NL_RESPONSE_RESULT_RESPONSE_OK
+                     || (NM_FLAGS_HAS(op->nlm_flags, NMP_NLM_FLAG_SUPPRESS_NETLINK_FAILURE)
+                         && seq_result < 0))
+                         ? LOGL_DEBUG
+                         : LOGL_WARN;
+    }
+
+    _NMLOG(log_level,
+           "do-%s-%s[%s]: %s%s",
+           op->is_delete ? "delete" : "add",
+           NMP_OBJECT_GET_CLASS(op->obj_stack)->obj_type_name,
+           nmp_object_to_string(op->obj_stack, NMP_OBJECT_TO_STRING_ID, sbuf1, sizeof(sbuf1)),
+           wait_for_nl_response_to_string(seq_result, op->extack_msg, s_buf, sizeof(s_buf)),
+           log_detail);
+
+    if (NMP_OBJECT_GET_TYPE(op->obj_stack) == NMP_OBJECT_TYPE_IP6_ADDRESS) {
+        gboolean in_cache;
+
+        /* In rare cases, the object is not yet ready (or still there) as we
+         * received the ACK from kernel. Need to refetch. See do_add_addrroute()
+         * and do_delete_object().
+         *
+         * rh#1484434 */
+        in_cache = !!nmp_cache_lookup_obj(nm_platform_get_cache(platform), op->obj_stack);
+        if (op->is_delete ? in_cache : !in_cache)
+            do_request_one_type_by_needle_object(platform, op->obj_stack);
+    }
+}
+
+static void
+object_batch(NMPlatform *platform, NMPlatformObjectBatchOp *ops, guint n_ops)
+{
+    NMLinuxPlatformPrivate          *priv        = NM_LINUX_PLATFORM_GET_PRIVATE(platform);
+    gs_free WaitForNlResponseResult *seq_results = NULL;
+    gs_free guint32                 *seqs        = NULL;
+    gs_free guint8                  *buf         = NULL;
+    guint                            n_sendmsg   = 0;
+    guint                            i;
+    guint                            j;
+
+    seq_results = g_new0(WaitForNlResponseResult, n_ops);
+    seqs        = g_new0(guint32, n_ops);
+    buf         = g_malloc(OBJECT_BATCH_SEND_BUF_MAX);
+
+    event_handler_read_netlink(platform, NMP_NETLINK_ROUTE, FALSE);
+
+    i = 0;
+    while (i < n_ops) {
+        const guint i_window = i;
+
+        /* Send a window of requests, packed into as few datagrams as possible. */
+        while (i < n_ops && i - i_window < OBJECT_BATCH_WINDOW_MAX) {
+            const guint i_datagram = i;
+            gsize       buf_len    = 0;
+            int         r;
+
+            for (; i < n_ops && i - i_window < OBJECT_BATCH_WINDOW_MAX; i++) {
+                nm_auto_nlmsg struct nl_msg *nlmsg = NULL;
+                struct nlmsghdr             *nlhdr;
+                gsize                        msg_len;
+
+                nlmsg = _nl_msg_new_object_batch_op(&ops[i]);
+                if (!nlmsg) {
+                    ops[i].result = -NME_BUG;
+                    continue;
+                }
+
+                nlhdr   = nlmsg_hdr(nlmsg);
+                msg_len = NLMSG_ALIGN(nlhdr->nlmsg_len);
+
+                nm_assert(msg_len <= OBJECT_BATCH_SEND_BUF_MAX);
+
+                if (buf_len + msg_len > OBJECT_BATCH_SEND_BUF_MAX)
+                    break;
+
+                seqs[i]            = _nlh_seq_next_get(priv, NMP_NETLINK_ROUTE);
+                nlhdr->nlmsg_seq   = seqs[i];
+                nlhdr->nlmsg_pid   = nl_socket_get_local_port(priv->sk_rtnl);
+                nlhdr->nlmsg_flags |= (NLM_F_REQUEST | NLM_F_ACK);
+
+                memcpy(&buf[buf_len], nlhdr, nlhdr->nlmsg_len);
+                memset(&buf[buf_len + nlhdr->nlmsg_len], 0, msg_len - nlhdr->nlmsg_len);
+                buf_len += msg_len;
+            }
+
+            if (buf_len == 0)
+                continue;
+
+            n_sendmsg++;
+            r = _nl_sendmsg_rtnl_buf(platform, buf, buf_len);
+
+            for (j = i_datagram; j < i; j++) {
+                if (seqs[j] == 0)
+                    continue;
+                if (r < 0) {
+                    ops[j].result = -NME_PL_NETLINK;
+                    seqs[j]       = 0;
+                    continue;
+                }
+                delayed_action_schedule_WAIT_FOR_RESPONSE(platform,
+                                                          NMP_NETLINK_ROUTE,
+                                                          seqs[j],
+                                                          &seq_results[j],
+                                                          &ops[j].extack_msg,
+                                                          DELAYED_ACTION_RESPONSE_TYPE_VOID,
+                                                          NULL);
+            }
+        }
+
+        /* Collect the responses for the entire window. */
+        delayed_action_handle_all(platform);
+
+        for (j = i_window; j < i; j++) {
+            if (seqs[j] == 0) {
+                /* The request was never sent. */
+                nm_assert(ops[j].result < 0);
+                continue;
+            }
+            nm_assert(seq_results[j] != WAIT_FOR_NL_RESPONSE_RESULT_UNKNOWN);
+            _object_batch_op_complete(platform, &ops[j], seq_results[j]);
+        }
+    }
+
+    _LOGD("object-batch: processed %u requests with %u sendmsg() calls", n_ops, n_sendmsg);
+}
+
+/*****************************************************************************/
+
+/* The socket filter can only express relative jumps of up to 255 instructions.
+ * With more tracked tables we don't filter by table in kernel. */
+#define RTNL_SOCKET_FILTER_TABLES_MAX 200u
+
+static void
+_rtnl_socket_filter_update(NMPlatform *platform)
+{
+    NMLinuxPlatformPrivate *priv = NM_LINUX_PLATFORM_GET_PRIVATE(platform);
+    struct sock_filter      insns[16 + RTNL_SOCKET_FILTER_TABLES_MAX
+                             + 2u * G_N_ELEMENTS(ip_route_tracked_protocols)];
+    struct sock_fprog       fprog;
+    guint                   n_tables = 0;
+    guint                   idx_accept;
+    guint                   idx_proto;
+    guint                   n = 0;
+    guint                   i;
+
+    /* Drop route notifications that we would ignore anyway (see ip_route_is_tracked()
+     * and ip_route_table_is_tracked()) already in kernel. That saves us from waking up
+     * and parsing them, and they don't fill up the socket receive buffer. On hosts
+     * with a routing daemon that handles full routing tables, this is most of the
+     * netlink traffic.
+     *
+     * The filter only sees the first message of a netlink packet. Multipart messages
+     * (dumps) and messages that are addressed to our port (responses to our requests,
+     * like RTM_GETROUTE) are always accepted. Netlink data is in host byte order, while
+     * BPF loads convert from network byte order, hence the htons()/htonl(). */
+
+    for (i = 0; i < priv->route_tables_tracked.len; i++) {
+        if (priv->route_tables_tracked.tables[i] < RT_TABLE_COMPAT)
+            n_tables++;
+    }
+    if (n_tables > RTNL_SOCKET_FILTER_TABLES_MAX)
+        n_tables = 0;
+
+    idx_proto  = 9 + (n_tables > 0 ? 3 + n_tables : 0);
+    idx_accept = idx_proto + 4 + G_N_ELEMENTS(ip_route_tracked_protocols);
+
+#define _J(idx_target) ((guint8) ((idx_target) - (n + 1u)))
+
+    /* Only filter RTM_NEWROUTE and RTM_DELROUTE. */
+    insns[n] = (struct sock_filter) BPF_STMT(BPF_LD | BPF_H | BPF_ABS,
+                                             G_STRUCT_OFFSET(struct nlmsghdr, nlmsg_type));
+    n++;
+    insns[n] = (struct sock_filter) BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, htons(RTM_NEWROUTE), 1, 0);
+    n++;
+    insns[n] = (struct sock_filter)
+        BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, htons(RTM_DELROUTE), 0, _J(idx_accept));
+    n++;
+
+    /* Accept multipart messages and too short messages. */
+    insns[n] = (struct sock_filter) BPF_STMT(BPF_LD | BPF_H | BPF_ABS,
+                                             G_STRUCT_OFFSET(struct nlmsghdr, nlmsg_flags));
+    n++;
+    insns[n] = (struct sock_filter)
+        BPF_JUMP(BPF_JMP | BPF_JSET | BPF_K, htons(NLM_F_MULTI), _J(idx_accept), 0);
+    n++;
+    insns[n] = (struct sock_filter) BPF_STMT(BPF_LD | BPF_W | BPF_LEN, 0);
+    n++;
+    insns[n] = (struct sock_filter)
+        BPF_JUMP(BPF_JMP | BPF_JGE | BPF_K, NLMSG_LENGTH(sizeof(struct rtmsg)), 0, _J(idx_accept));
+    n++;
+
+    /* Accept messages addressed to our port. */
+    insns[n] = (struct sock_filter) BPF_STMT(BPF_LD | BPF_W | BPF_ABS,
+                                             G_STRUCT_OFFSET(struct nlmsghdr, nlmsg_pid));
+    n++;
+    insns[n] = (struct sock_filter) BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K,
+                                             htonl(nl_socket_get_local_port(priv->sk_rtnl)),
+                                             _J(idx_accept),
+                                             0);
+    n++;
+
+    if (n_tables > 0) {
+        guint idx_drop = n + 2 + n_tables;
+
+        /* Drop routes from tables that we don't track. Tables that don't fit
+         * into rtm_table are reported as RT_TABLE_COMPAT and we cannot tell. */
+        insns[n] = (struct sock_filter)
+            BPF_STMT(BPF_LD | BPF_B | BPF_ABS,
+                     NLMSG_HDRLEN + G_STRUCT_OFFSET(struct rtmsg, rtm_table));
+        n++;
+        insns[n] = (struct sock_filter)
+            BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, RT_TABLE_COMPAT, _J(idx_proto), 0);
+        n++;
+        for (i = 0; i < priv->route_tables_tracked.len; i++) {
+            if (priv->route_tables_tracked.tables[i] >= RT_TABLE_COMPAT)
+                continue;
+            insns[n] = (struct sock_filter) BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K,
+                                                     priv->route_tables_tracked.tables[i],
+                                                     _J(idx_proto),
+                                                     0);
+            n++;
+        }
+        nm_assert(n == idx_drop);
+        insns[n] = (struct sock_filter) BPF_STMT(BPF_RET | BPF_K, 0);
+        n++;
+    }
+
+    /* Drop routes with protocols that we don't track, unless they replace
+     * another route (which we might track). */
+    nm_assert(n == idx_proto);
+    insns[n] = (struct sock_filter) BPF_STMT(BPF_LD | BPF_H | BPF_ABS,
+                                             G_STRUCT_OFFSET(struct nlmsghdr, nlmsg_flags));
+    n++;
+    insns[n] = (struct sock_filter)
+        BPF_JUMP(BPF_JMP | BPF_JSET | BPF_K, htons(NLM_F_REPLACE), _J(idx_accept), 0);
+    n++;
+    insns[n] = (struct sock_filter)
+        BPF_STMT(BPF_LD | BPF_B | BPF_ABS,
+                 NLMSG_HDRLEN + G_STRUCT_OFFSET(struct rtmsg, rtm_protocol));
+    n++;
+    for (i = 0; i < G_N_ELEMENTS(ip_route_tracked_protocols); i++) {
+        insns[n] = (struct sock_filter) BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K,
+                                                 ip_route_tracked_protocols[i],
+                                                 _J(idx_accept),
+                                                 0);
+        n++;
+    }
+    insns[n] = (struct sock_filter) BPF_STMT(BPF_RET | BPF_K, 0);
+    n++;
+
+    nm_assert(n == idx_accept);
+    insns[n] = (struct sock_filter) BPF_STMT(BPF_RET | BPF_K, 0xFFFFFFFFu);
+    n++;
+
+#undef _J
+
+    nm_assert(n <= G_N_ELEMENTS(insns));
+
+    fprog = (struct sock_fprog) {
+        .len    = n,
+        .filter = insns,
+    };
+
+    if (setsockopt(nl_socket_get_fd(priv->sk_rtnl),
+                   SOL_SOCKET,
+                   SO_ATTACH_FILTER,
+                   &fprog,
+                   sizeof(fprog))
+        < 0) {
+        _LOGD("rtnl: failure to attach socket filter: %s", nm_strerror_native(errno));
+        return;
+    }
+
+    _LOGD("rtnl: attached socket filter for routes (%u tables)", n_tables);
+}
+
+static void
+netlink_set_rcvbuf_max(NMPlatform *platform, int rcvbuf_max)
+{
+    NMLinuxPlatformPrivate *priv = NM_LINUX_PLATFORM_GET_PRIVATE(platform);
+
+    priv->rtnl_stats.rcvbuf_max = rcvbuf_max > 0 ? rcvbuf_max : RTNL_RCVBUF_MAX_DEFAULT;
+    _LOGD("netlink[rtnl]: maximum receive buffer size set to %d", priv->rtnl_stats.rcvbuf_max);
+}
+
+static void
+ip_route_set_tracked_tables(NMPlatform *platform, const guint32 *tables, guint n_tables)
+{
+    NMLinuxPlatformPrivate *priv = NM_LINUX_PLATFORM_GET_PRIVATE(platform);
+    gs_free guint32        *arr  = NULL;
+    guint                   len  = 0;
+    guint                   i;
+    guint                   j;
+
+    if (n_tables > 0) {
+        arr        = g_new(guint32, n_tables + 2u);
+        arr[len++] = RT_TABLE_MAIN;
+        arr[len++] = RT_TABLE_LOCAL;
+        for (i = 0; i < n_tables; i++) {
+            if (tables[i] != RT_TABLE_UNSPEC)
+                arr[len++] = tables[i];
+        }
+        g_qsort_with_data(arr, len, sizeof(guint32), nm_cmp_uint32_p_with_data, NULL);
+        for (i = 1, j = 1; i < len; i++) {
+            if (arr[i] != arr[j - 1])
+                arr[j++] = arr[i];
+        }
+        len = j;
+    }
+
+    if (priv->route_tables_tracked.len == len
+        && (len == 0
+            || memcmp(priv->route_tables_tracked.tables, arr, len * sizeof(guint32)) == 0))
+        return;
+
+    if (len == 0)
+        _LOGD("route: track routes from all tables");
+    else
+        _LOGD("route: track routes from %u tables", len);
+
+    g_free(priv->route_tables_tracked.tables);
+    priv->route_tables_tracked.tables = g_steal_pointer(&arr);
+    priv->route_tables_tracked.len    = len;
+
+    _rtnl_socket_filter_update(platform);
+
+    /* Re-dump the routes. Routes from tables that are no longer tracked
+     * get pruned from the cache. */
+    delayed_action_schedule(platform,
+                            DELAYED_ACTION_TYPE_REFRESH_ALL_RTNL_IP4_ROUTES
+                                | DELAYED_ACTION_TYPE_REFRESH_ALL_RTNL_IP6_ROUTES,
+                            NULL);
+}
+
+/*****************************************************************************/
+
+static int
+ip_route_get(NMPlatform   *platform,
+             int           addr_family,
+             gconstpointer address,
+             guint32       fwmark,
+             int           oif_ifindex,
+             NMPObject   **out_route)
+{
+    const gboolean            IS_IPv4   = NM_IS_IPv4(addr_family);
+    const int                 addr_len  = IS_IPv4 ? 4 : 16;
+    int                       try_count = 0;
+    WaitForNlResponseResult   seq_result;
+    int                       nle;
+    nm_auto_nmpobj NMPObject *route = NULL;
+
+    nm_assert(NM_IS_LINUX_PLATFORM(platform));
+    nm_assert(NM_IN_SET(addr_family, AF_INET, AF_INET6));
+    nm_assert(address);
+
+    do {
+        struct {
+            struct nlmsghdr n;
+            struct rtmsg    r;
+            char            buf[64];
+        } req = {
+            .n.nlmsg_len   = NLMSG_LENGTH(sizeof(struct rtmsg)),
+            .n.nlmsg_flags = NLM_F_REQUEST,
+            .n.nlmsg_type  = RTM_GETROUTE,
+            .r.rtm_family  = addr_family,
+            .r.rtm_tos     = 0,
+            .r.rtm_dst_len = IS_IPv4 ? 32 : 128,
+            .r.rtm_flags   = IS_IPv4 ? RTM_F_LOOKUP_TABLE : 0,
+        };
+
+        nm_clear_pointer(&route, nmp_object_unref);
 
         if (!_nl_addattr_l(&req.n, sizeof(req), RTA_DST, address, addr_len))
             nm_assert_not_reached();
@@ -10910,6 +12399,76 @@ routing_rule_add(NMPlatform *platform, NMPNlmFlags flags, const NMPlatformRoutin
 
 /*****************************************************************************/
 
+static int
+_ip_nexthop_send(NMPlatform *platform, struct nl_msg *msg, const char *log_tag)
+{
+    WaitForNlResponseResult seq_result;
+    gs_free char           *extack_msg = NULL;
+    int                     nle;
+    char                    s_buf[256];
+    int                     try_count = 0;
+
+    event_handler_read_netlink(platform, NMP_NETLINK_ROUTE, FALSE);
+
+    do {
+        seq_result = WAIT_FOR_NL_RESPONSE_RESULT_UNKNOWN;
+        nm_clear_g_free(&extack_msg);
+        nle = _netlink_send_nlmsg_rtnl(platform, msg, &seq_result, &extack_msg);
+        if (nle < 0) {
+            _LOGE("%s: failed sending netlink request \"%s\" (%d)",
+                  log_tag,
+                  nm_strerror(nle),
+                  -nle);
+            return -NME_PL_NETLINK;
+        }
+
+        delayed_action_handle_all(platform);
+
+        nm_assert(seq_result != WAIT_FOR_NL_RESPONSE_RESULT_UNKNOWN);
+
+    } while (seq_result == WAIT_FOR_NL_RESPONSE_RESULT_FAILED_RESYNC
+             && ++try_count < RESYNC_RETRIES);
+
+    _NMLOG(seq_result == WAIT_FOR_NL_RESPONSE_RESULT_RESPONSE_OK ? LOGL_DEBUG : LOGL_WARN,
+           "%s: %s",
+           log_tag,
+           wait_for_nl_response_to_string(seq_result, extack_msg, s_buf, sizeof(s_buf)));
+
+    if (seq_result == WAIT_FOR_NL_RESPONSE_RESULT_RESPONSE_OK)
+        return 0;
+    if (seq_result < 0)
+        return seq_result;
+    return -NME_UNSPEC;
+}
+
+static int
+ip_nexthop_add(NMPlatform *platform, NMPNlmFlags flags, const NMPlatformNexthop *nexthop)
+{
+    nm_auto_nlmsg struct nl_msg *msg = NULL;
+
+    msg = _nl_msg_new_nexthop(RTM_NEWNEXTHOP, flags & NMP_NLM_FLAG_FMASK, nexthop);
+    if (!msg)
+        return -NME_UNSPEC;
+
+    return _ip_nexthop_send(platform, msg, "do-add-nexthop");
+}
+
+static int
+ip_nexthop_delete(NMPlatform *platform, guint32 id)
+{
+    nm_auto_nlmsg struct nl_msg *msg = NULL;
+
+    msg = _nl_msg_new_nexthop(RTM_DELNEXTHOP,
+                              0,
+                              &((const NMPlatformNexthop) {
+                                  .id = id,
+                              }));
+    if (!msg)
+        return -NME_UNSPEC;
+
+    return _ip_nexthop_send(platform, msg, "do-delete-nexthop");
+}
+
 static int
 qdisc_add(NMPlatform *platform, NMPNlmFlags flags, const NMPlatformQdisc *qdisc)
 {
@@ -11086,8 +12645,57 @@ tfilter_delete(NMPlatform *platform, int ifindex, guint32 parent, gboolean log_e
 
 /*****************************************************************************/
 
+/* The multicast groups that we join, once the family is known. */
+static const char *const *const _genl_mcast_groups[_NMP_GENL_FAMILY_TYPE_NUM] = {
+    /* Link quality of Wi-Fi devices is refreshed on these events. */
+    [NMP_GENL_FAMILY_TYPE_NL80211] = NM_MAKE_STRV("mlme", "scan"),
+};
+
+static void
+_genl_join_mcast_groups(NMPlatform          *platform,
+                        NMPGenlFamilyType    family_type,
+                        const struct nlattr *mcast_groups)
+{
+    static const struct nla_policy policy[] = {
+        [CTRL_ATTR_MCAST_GRP_NAME] = {.type = NLA_STRING},
+        [CTRL_ATTR_MCAST_GRP_ID]   = {.type = NLA_U32},
+    };
+    NMLinuxPlatformPrivate *priv = NM_LINUX_PLATFORM_GET_PRIVATE(platform);
+    struct nlattr          *nla;
+    int                     rem;
+
+    if (!_genl_mcast_groups[family_type] || !mcast_groups)
+        return;
+
+    nla_for_each_nested (nla, mcast_groups, rem) {
+        struct nlattr *tb[G_N_ELEMENTS(policy)];
+        const char    *grp_name;
+        int            nle;
+
+        if (nla_parse_nested_arr(tb, nla, policy) < 0)
+            continue;
+        if (!tb[CTRL_ATTR_MCAST_GRP_NAME] || !tb[CTRL_ATTR_MCAST_GRP_ID])
+            continue;
+
+        grp_name = nla_get_string(tb[CTRL_ATTR_MCAST_GRP_NAME]);
+        if (nm_strv_find_first(_genl_mcast_groups[family_type], -1, grp_name) < 0)
+            continue;
+
+        nle = nl_socket_add_memberships(priv->sk_genl, nla_get_u32(tb[CTRL_ATTR_MCAST_GRP_ID]), 0);
+        if (nle < 0) {
+            _LOGD("genl:ctrl: cannot join multicast group %s of %s: %s",
+                  grp_name,
+                  nmp_genl_family_infos[family_type].name,
+                  nm_strerror(nle));
+        }
+    }
+}
+
 static gboolean
-_genl_family_id_update(NMPlatform *platform, NMPGenlFamilyType family_type, guint16 family_id)
+_genl_family_id_update(NMPlatform          *platform,
+                       NMPGenlFamilyType    family_type,
+                       guint16              family_id,
+                       const struct nlattr *mcast_groups)
 {
     NMLinuxPlatformPrivate *priv = NM_LINUX_PLATFORM_GET_PRIVATE(platform);
 
@@ -11101,6 +12709,12 @@ _genl_family_id_update(NMPlatform *platform, NMPGenlFamilyType family_type, guin
     } else
         _LOGD("genl:ctrl: del family-id for %s", nmp_genl_family_infos[family_type].name);
     priv->genl_family_data[family_type].family_id = family_id;
+
+    /* The multicast groups get new IDs when the family is registered
+     * again, join them each time the family ID changes. */
+    if (family_id != 0)
+        _genl_join_mcast_groups(platform, family_type, mcast_groups);
+
     return TRUE;
 }
 
@@ -11130,70 +12744,105 @@ _genl_handle_msg_ctrl(NMPlatform *platform, const struct nlmsghdr *hdr)
         if (ghdr->cmd == CTRL_CMD_NEWFAMILY)
             family_id = nla_get_u16(tb[CTRL_ATTR_FAMILY_ID]);
 
-        _genl_family_id_update(platform, family_type, family_id);
+        _genl_family_id_update(platform, family_type, family_id, tb[CTRL_ATTR_MCAST_GROUPS]);
     }
     }
 }
 
+static void
+_genl_handle_msg_nl80211(NMPlatform *platform, const struct nlmsghdr *hdr)
+{
+    static const struct nla_policy policy[] = {
+        [NL80211_ATTR_IFINDEX] = {.type = NLA_U32},
+    };
+    const struct genlmsghdr *ghdr = nlmsg_data(hdr);
+    struct nlattr           *tb[G_N_ELEMENTS(policy)];
+    int                      ifindex;
+
+    switch (ghdr->cmd) {
+    case NL80211_CMD_NEW_SCAN_RESULTS:
+    case NL80211_CMD_CONNECT:
+    case NL80211_CMD_ROAM:
+    case NL80211_CMD_DISCONNECT:
+    case NL80211_CMD_NOTIFY_CQM:
+    case NL80211_CMD_CH_SWITCH_NOTIFY:
+        break;
+    default:
+        return;
+    }
+
+    if (genlmsg_parse_arr(hdr, 0, tb, policy) < 0)
+        return;
+    if (!tb[NL80211_ATTR_IFINDEX])
+        return;
+
+    ifindex = nla_get_u32(tb[NL80211_ATTR_IFINDEX]);
+    if (ifindex <= 0)
+        return;
+
+    nm_platform_emit_wifi_event(platform, ifindex);
+}
+
 static void
 _genl_handle_msg(NMPlatform *platform, guint32 pktinfo_group, const struct nl_msg_lite *msg)
 {
-    const struct nlmsghdr *hdr = msg->nm_nlh;
+    NMLinuxPlatformPrivate *priv = NM_LINUX_PLATFORM_GET_PRIVATE(platform);
+    const struct nlmsghdr  *hdr  = msg->nm_nlh;
 
     if (!genlmsg_valid_hdr(hdr, 0))
         return;
 
     if (hdr->nlmsg_type == GENL_ID_CTRL)
         _genl_handle_msg_ctrl(platform, hdr);
+    else if (hdr->nlmsg_type != 0
+             && hdr->nlmsg_type
+                    == priv->genl_family_data[NMP_GENL_FAMILY_TYPE_NL80211].family_id)
+        _genl_handle_msg_nl80211(platform, hdr);
 }
 
 /*****************************************************************************/
 
 static int
 _netlink_recv(NMPlatform         *platform,
-              struct nl_sock     *sk,
+              NMPNetlinkProtocol  netlink_protocol,
               struct sockaddr_nl *nla,
+              unsigned char     **out_buf,
               struct ucred       *out_creds,
               gboolean           *out_creds_has,
               guint32            *out_pktinfo_group,
               gboolean           *out_pktinfo_has)
 {
-    NMLinuxPlatformPrivate *priv = NM_LINUX_PLATFORM_GET_PRIVATE(platform);
-    unsigned char          *buf  = NULL;
+    NMLinuxPlatformPrivate *priv  = NM_LINUX_PLATFORM_GET_PRIVATE(platform);
+    NLRecvBatch            *batch = &priv->netlink_recv_batch[netlink_protocol];
+    unsigned char          *buf   = NULL;
     int                     n;
 
     nm_assert(nla);
+    nm_assert(out_buf);
     nm_assert(out_creds);
     nm_assert(out_creds_has);
 
-    /* We use a pre-allocated receive buffer. We use it both for sk_rtnl
-     * and sk_genl. We can do that, because we are deep inside the netlink
-     * handling, and we never will need to use it for both sockets at the
-     * same time. */
+    n = nl_recv_batch(priv->sk_x[netlink_protocol],
+                      batch,
+                      nla,
+                      &buf,
+                      out_creds,
+                      out_creds_has,
+                      out_pktinfo_group,
+                      out_pktinfo_has);
 
-    n = nl_recv(sk,
-                priv->netlink_recv_buf.buf,
-                priv->netlink_recv_buf.len,
-                nla,
-                &buf,
-                out_creds,
-                out_creds_has,
-                out_pktinfo_group,
-                out_pktinfo_has);
-
-    nm_assert((n <= 0 && !buf)
-              || (n > 0 && n <= priv->netlink_recv_buf.len && buf == priv->netlink_recv_buf.buf));
+    nm_assert((n <= 0 && !buf) || (n > 0 && n <= batch->slot_len && buf));
 
-    if (n == -NME_NL_MSG_TRUNC) {
+    if (n == -NME_NL_MSG_TRUNC && batch->slot_len_next == batch->slot_len) {
         /* the message receive buffer was too small. We lost one message, which
          * is unfortunate. Try to double the buffer size for the next time. */
-        priv->netlink_recv_buf.len *= 2;
-        priv->netlink_recv_buf.buf =
-            g_realloc(priv->netlink_recv_buf.buf, priv->netlink_recv_buf.len);
-        _LOGT("netlink: recvmsg: increase message buffer size for recvmsg() to %zu bytes",
-              priv->netlink_recv_buf.len);
+        nl_recv_batch_set_slot_len(batch, batch->slot_len * 2u);
+        _LOGT("netlink[%s]: recvmsg: increase message buffer size for recvmsg() to %zu bytes",
+              nmp_netlink_protocol_info(netlink_protocol)->name,
+              batch->slot_len_next);
     }
 
+    *out_buf = buf;
     return n;
 }
 
@@ -11231,6 +12880,7 @@ _netlink_recv_handle(NMPlatform        *platform,
     int                     retval      = 0;
     gboolean                multipart   = 0;
     gboolean                interrupted = FALSE;
+    unsigned char          *buf;
     struct nlmsghdr        *hdr;
     struct sockaddr_nl      nla;
     struct ucred            creds;
@@ -11242,8 +12892,9 @@ _netlink_recv_handle(NMPlatform        *platform,
 continue_reading:
 
     n = _netlink_recv(platform,
-                      priv->sk_x[netlink_protocol],
+                      netlink_protocol,
                       &nla,
+                      &buf,
                       &creds,
                       &creds_has,
                       &pktinfo_group,
@@ -11262,7 +12913,7 @@ continue_reading:
         goto stop;
     }
 
-    hdr = NM_CAST_ALIGN(struct nlmsghdr, priv->netlink_recv_buf.buf);
+    hdr = NM_CAST_ALIGN(struct nlmsghdr, buf);
     while (nlmsg_ok(hdr, n)) {
         WaitForNlResponseResult  seq_result;
         gboolean                 process_valid_msg = FALSE;
@@ -11279,6 +12930,9 @@ continue_reading:
 
         nm_assert((((uintptr_t) (const void *) msg.nm_nlh) % NLMSG_ALIGNTO) == 0);
 
+        if (netlink_protocol == NMP_NETLINK_ROUTE)
+            priv->rtnl_stats.n_messages++;
+
         _LOGt("%s: recvmsg: new message %s",
               log_prefix,
               nl_nlmsghdr_to_str(nmp_netlink_protocol_info(netlink_protocol)->netlink_protocol,
@@ -11398,16 +13052,29 @@ stop:
 
 /*****************************************************************************/
 
+/**
+ * event_handler_read_netlink_full:
+ * @platform: the platform instance
+ * @netlink_protocol: the netlink protocol of the socket to read
+ * @wait_for_acks: whether to wait for pending responses
+ * @max_reads: if positive, stop reading after that many receive
+ *   calls, unless we need to wait for responses. Unread messages
+ *   stay in the socket and wake up the main loop again.
+ *
+ * Returns: whether any messages were received.
+ */
 static gboolean
-event_handler_read_netlink(NMPlatform        *platform,
-                           NMPNetlinkProtocol netlink_protocol,
-                           gboolean           wait_for_acks)
+event_handler_read_netlink_full(NMPlatform        *platform,
+                                NMPNetlinkProtocol netlink_protocol,
+                                gboolean           wait_for_acks,
+                                guint              max_reads)
 {
     nm_auto_pop_netns NMPNetns *netns = NULL;
     NMLinuxPlatformPrivate     *priv  = NM_LINUX_PLATFORM_GET_PRIVATE(platform);
     int                         r;
     struct pollfd               pfd;
-    gboolean                    any = FALSE;
+    gboolean                    any     = FALSE;
+    guint                       n_reads = 0;
     int                         timeout_msec;
     struct {
         guint32 seq_number;
@@ -11458,6 +13125,9 @@ event_handler_read_netlink(NMPlatform        *platform,
                               _reason;
                           }));
 
+                    if (nle == -ENOBUFS && netlink_protocol == NMP_NETLINK_ROUTE)
+                        _rtnl_handle_overrun(platform);
+
                     if (nle == -ENOBUFS) {
                         /* Netlink notifications are coming faster than what
                          * we can process them. Backoff a bit so we give some
@@ -11487,6 +13157,17 @@ event_handler_read_netlink(NMPlatform        *platform,
                 }
             }
             any = TRUE;
+
+            if (max_reads > 0 && ++n_reads >= max_reads
+                && !nl_recv_batch_has_pending(&priv->netlink_recv_batch[netlink_protocol])
+                && !NM_FLAGS_ANY(priv->delayed_action.flags,
+                                 nmp_netlink_protocol_info(netlink_protocol)
+                                     ->delayed_action_type_wait_for_response)) {
+                _LOGT("netlink[%s]: read: yield to main loop after %u reads",
+                      nmp_netlink_protocol_info(netlink_protocol)->name,
+                      n_reads);
+                return any;
+            }
         }
 
 after_read:
@@ -11553,11 +13234,20 @@ after_read:
 
 /*****************************************************************************/
 
+static int
+_genl_request_family_cb(const struct nl_msg *msg, void *arg)
+{
+    const struct nlmsghdr *hdr = nlmsg_hdr(msg);
+
+    if (genlmsg_valid_hdr(hdr, 0))
+        _genl_handle_msg_ctrl(arg, hdr);
+    return NL_STOP;
+}
+
 static guint16
 genl_get_family_id(NMPlatform *platform, NMPGenlFamilyType family_type)
 {
     NMLinuxPlatformPrivate *priv = NM_LINUX_PLATFORM_GET_PRIVATE(platform);
-    int                     family_id;
 
     nm_assert(_NM_INT_NOT_NEGATIVE(family_type));
     nm_assert(family_type < G_N_ELEMENTS(priv->genl_family_data));
@@ -11565,6 +13255,16 @@ genl_get_family_id(NMPlatform *platform, NMPGenlFamilyType family_type)
     if (priv->genl_family_data[family_type].family_id != 0)
         goto out;
 
+    /* All families get dumped initially and are then tracked via genl
+     * notifications. Once the dump completed, a family that cannot appear
+     * by loading a module is really missing. Don't ask the kernel again on
+     * every call, like for every ethtool operation on kernels without
+     * ethtool netlink. */
+    if (!nmp_genl_family_infos[family_type].autoload
+        && !NM_FLAGS_HAS(priv->delayed_action.flags, DELAYED_ACTION_TYPE_REFRESH_ALL_GENL_FAMILIES)
+        && priv->delayed_action.refresh_all_in_progress[REFRESH_ALL_TYPE_GENL_FAMILIES] == 0)
+        goto out;
+
     /* Unknown family ID... usually we expect to start using the protocol.
      * Let's try harder and fetch the ID synchronously.
      *
@@ -11572,16 +13272,14 @@ genl_get_family_id(NMPlatform *platform, NMPGenlFamilyType family_type)
      * when we add a WireGuard link, the module gets autoloaded, and we didn't
      * yet process the genl notification about the new family. Let's not call
      * delayed_action_handle_all() again, because that might emit various
-     * signals. */
-
-    family_id = genl_ctrl_resolve(priv->sk_genl_sync, nmp_genl_family_infos[family_type].name);
-    if (family_id < 0)
-        family_id = 0;
-
-    /* We cache the family ID and update it via genl notifications.
-     * Here we bypass the order of that, and update the cached value
-     * directly. */
-    _genl_family_id_update(platform, family_type, family_id);
+     * signals.
+     *
+     * We cache the family ID and update it via genl notifications. Here we
+     * bypass the order of that, and handle the reply like a notification. */
+    genl_ctrl_request_family(priv->sk_genl_sync,
+                             nmp_genl_family_infos[family_type].name,
+                             _genl_request_family_cb,
+                             platform);
 
 out:
     return priv->genl_family_data[family_type].family_id;
@@ -11885,6 +13583,135 @@ mptcp_addrs_dump(NMPlatform *platform)
 
 /*****************************************************************************/
 
+typedef struct {
+    GPtrArray *neighs;
+    int        addr_family;
+    int        ifindex;
+} NeighDumpParseData;
+
+static int
+_neigh_dump_parse_cb(const struct nl_msg *msg, void *arg)
+{
+    static const struct nla_policy policy[] = {
+        [NDA_DST]    = {.minlen = sizeof(in_addr_t)},
+        [NDA_LLADDR] = {.minlen = ETH_ALEN, .maxlen = ETH_ALEN},
+    };
+    struct nlattr            *tb[G_N_ELEMENTS(policy)];
+    struct nlmsghdr          *nlh        = nlmsg_hdr(msg);
+    NeighDumpParseData       *parse_data = arg;
+    nm_auto_nmpobj NMPObject *obj        = NULL;
+    const struct ndmsg       *ndm;
+    NMPlatformNeigh          *neigh;
+
+    if (nlh->nlmsg_type != RTM_NEWNEIGH)
+        return NL_SKIP;
+
+    if (nlmsg_parse_arr(nlh, sizeof(*ndm), tb, policy) < 0)
+        return NL_SKIP;
+
+    ndm = nlmsg_data(nlh);
+    if (ndm->ndm_family != parse_data->addr_family)
+        return NL_SKIP;
+    if (parse_data->ifindex > 0 && ndm->ndm_ifindex != parse_data->ifindex)
+        return NL_SKIP;
+
+    /* Incomplete and failed entries have no link layer address. They are
+     * nothing that we could have configured. */
+    if (!tb[NDA_LLADDR])
+        return NL_SKIP;
+
+    obj   = nmp_object_new(NMP_OBJECT_TYPE_NEIGH, NULL);
+    neigh = &obj->neigh;
+
+    neigh->ifindex     = ndm->ndm_ifindex;
+    neigh->addr_family = ndm->ndm_family;
+    neigh->state       = ndm->ndm_state;
+    neigh->flags       = ndm->ndm_flags & (NTF_SELF | NTF_MASTER | NTF_ROUTER);
+    memcpy(&neigh->lladdr, nla_data(tb[NDA_LLADDR]), ETH_ALEN);
+
+    if (tb[NDA_DST]) {
+        switch (nla_len(tb[NDA_DST])) {
+        case sizeof(in_addr_t):
+            neigh->dst_family = AF_INET;
+            break;
+        case sizeof(struct in6_addr):
+            neigh->dst_family = AF_INET6;
+            break;
+        default:
+            return NL_SKIP;
+        }
+        memcpy(&neigh->dst, nla_data(tb[NDA_DST]), nla_len(tb[NDA_DST]));
+    }
+
+    if (neigh->addr_family != AF_BRIDGE && neigh->dst_family != neigh->addr_family)
+        return NL_SKIP;
+
+    g_ptr_array_add(parse_data->neighs, g_steal_pointer(&obj));
+    return NL_OK;
+}
+
+static GPtrArray *
+neigh_dump(NMPlatform *platform, int addr_family, int ifindex)
+{
+    gs_unref_ptrarray GPtrArray   *neighs = NULL;
+    nm_auto_nlmsg struct nl_msg   *nlmsg  = NULL;
+    nm_auto_nlsock struct nl_sock *sk     = NULL;
+    NeighDumpParseData             parse_data;
+    const struct ndmsg             ndm = {
+                    .ndm_family = addr_family,
+    };
+    int nle;
+
+    /* Neighbor entries are not cached. Dump them on a separate socket,
+     * so that the replies don't interfere with the events on the main
+     * socket. */
+    nle = nl_socket_new(&sk, NETLINK_ROUTE, NL_SOCKET_FLAGS_DISABLE_MSG_PEEK, 0, 0);
+    if (nle < 0) {
+        _LOGD("neigh: dump failed to open socket: %s", nm_strerror(nle));
+        return NULL;
+    }
+
+    nlmsg = nlmsg_alloc_new(0, RTM_GETNEIGH, NLM_F_REQUEST | NLM_F_DUMP);
+    if (nlmsg_append_struct(nlmsg, &ndm) < 0)
+        g_return_val_if_reached(NULL);
+
+    nle = nl_send_auto(sk, nlmsg);
+    if (nle < 0) {
+        _LOGD("neigh: dump failed to send request: %s", nm_strerror(nle));
+        return NULL;
+    }
+
+    neighs = g_ptr_array_new_with_free_func((GDestroyNotify) nmp_object_unref);
+
+    parse_data = (NeighDumpParseData) {
+        .neighs      = neighs,
+        .addr_family = addr_family,
+        .ifindex     = ifindex,
+    };
+
+    do {
+        nle = nl_recvmsgs(sk,
+                          &((const struct nl_cb) {
+                              .valid_cb  = _neigh_dump_parse_cb,
+                              .valid_arg = &parse_data,
+                          }));
+    } while (nle == -EAGAIN);
+
+    if (nle < 0) {
+        _LOGD("neigh: dump failed: %s", nm_strerror(nle));
+        return NULL;
+    }
+
+    _LOGT("neigh: %u %s entries dumped for ifindex %d",
+          neighs->len,
+          addr_family == AF_BRIDGE ? "fdb" : "neighbor",
+          ifindex);
+
+    return g_steal_pointer(&neighs);
+}
+
+/*****************************************************************************/
+
 static gboolean
 ethtool_get_pause(NMPlatform *platform, int ifindex, NMEthtoolPauseState *pause)
 {
@@ -11951,6 +13778,65 @@ ethtool_set_ring(NMPlatform *platform, int ifindex, const NMEthtoolRingState *ri
                                 ring);
 }
 
+static gboolean
+ethtool_get_channels(NMPlatform *platform, int ifindex, NMEthtoolChannelsState *channels)
+{
+    NMLinuxPlatformPrivate *priv = NM_LINUX_PLATFORM_GET_PRIVATE(platform);
+    guint16                 family_id;
+
+    /* Kernels before 5.6 don't have the ethtool netlink API. */
+    family_id = genl_get_family_id(platform, NMP_GENL_FAMILY_TYPE_ETHTOOL);
+    if (family_id == 0)
+        return nmp_ethtool_ioctl_get_channels(ifindex, channels);
+
+    return nmp_ethtool_get_channels(priv->sk_genl_sync, family_id, ifindex, channels);
+}
+
+static gboolean
+ethtool_set_channels(NMPlatform *platform, int ifindex, const NMEthtoolChannelsState *channels)
+{
+    NMLinuxPlatformPrivate *priv = NM_LINUX_PLATFORM_GET_PRIVATE(platform);
+    guint16                 family_id;
+
+    family_id = genl_get_family_id(platform, NMP_GENL_FAMILY_TYPE_ETHTOOL);
+    if (family_id == 0)
+        return nmp_ethtool_ioctl_set_channels(ifindex, channels);
+
+    return nmp_ethtool_set_channels(priv->sk_genl_sync, family_id, ifindex, channels);
+}
+
+static NMEthtoolRssState *
+ethtool_get_rss(NMPlatform *platform, int ifindex)
+{
+    NMLinuxPlatformPrivate *priv = NM_LINUX_PLATFORM_GET_PRIVATE(platform);
+    NMEthtoolRssState      *rss;
+    guint16                 family_id;
+
+    /* ETHTOOL_MSG_RSS_GET was added in kernel 6.3. */
+    family_id = genl_get_family_id(platform, NMP_GENL_FAMILY_TYPE_ETHTOOL);
+    if (family_id != 0) {
+        rss = nmp_ethtool_get_rss(priv->sk_genl_sync, family_id, ifindex);
+        if (rss)
+            return rss;
+    }
+
+    return nmp_ethtool_ioctl_get_rss(ifindex);
+}
+
+static gboolean
+ethtool_set_rss(NMPlatform *platform, int ifindex, const NMEthtoolRssState *rss)
+{
+    NMLinuxPlatformPrivate *priv = NM_LINUX_PLATFORM_GET_PRIVATE(platform);
+    guint16                 family_id;
+
+    /* ETHTOOL_MSG_RSS_SET was only added in kernel 6.16. */
+    family_id = genl_get_family_id(platform, NMP_GENL_FAMILY_TYPE_ETHTOOL);
+    if (family_id != 0 && nmp_ethtool_set_rss(priv->sk_genl_sync, family_id, ifindex, rss))
+        return TRUE;
+
+    return nmp_ethtool_ioctl_set_rss(ifindex, rss);
+}
+
 /*****************************************************************************/
 
 static void
@@ -12084,9 +13970,16 @@ static void
 nm_linux_platform_init(NMLinuxPlatform *self)
 {
     NMLinuxPlatformPrivate *priv = NM_LINUX_PLATFORM_GET_PRIVATE(self);
+    NMPNetlinkProtocol      i;
+
+    for (i = _NMP_NETLINK_FIRST; i < _NMP_NETLINK_NUM; i++) {
+        nl_recv_batch_init(&priv->netlink_recv_batch[i],
+                           NETLINK_RECV_BATCH_SLOTS,
+                           NETLINK_RECV_BATCH_SLOT_LEN);
+    }
 
-    priv->netlink_recv_buf.len = 32 * 1024;
-    priv->netlink_recv_buf.buf = g_malloc(priv->netlink_recv_buf.len);
+    priv->rtnl_stats.rcvbuf     = RTNL_RCVBUF_INITIAL;
+    priv->rtnl_stats.rcvbuf_max = RTNL_RCVBUF_MAX_DEFAULT;
 
     c_list_init(&priv->sysctl_clear_cache_lst);
     c_list_init(&priv->sysctl_list);
@@ -12169,7 +14062,7 @@ constructed(GObject *_object)
                         NETLINK_ROUTE,
                         NL_SOCKET_FLAGS_NONBLOCK | NL_SOCKET_FLAGS_PASSCRED
                             | NL_SOCKET_FLAGS_DISABLE_MSG_PEEK,
-                        8 * 1024 * 1024,
+                        RTNL_RCVBUF_INITIAL,
                         0);
     g_assert(!nle);
 
@@ -12195,6 +14088,8 @@ constructed(GObject *_object)
           nl_socket_get_local_port(priv->sk_rtnl),
           fd);
 
+    _rtnl_socket_filter_update(platform);
+
     priv->event_source_rtnl =
         nm_g_unix_fd_add_source(fd,
                                 G_IO_IN | G_IO_NVAL | G_IO_PRI | G_IO_ERR | G_IO_HUP,
@@ -12315,10 +14210,12 @@ static void
 finalize(GObject *object)
 {
     NMLinuxPlatformPrivate *priv = NM_LINUX_PLATFORM_GET_PRIVATE(object);
+    NMPNetlinkProtocol      i;
 
     g_ptr_array_unref(priv->delayed_action.list_controller_connected);
     g_ptr_array_unref(priv->delayed_action.list_refresh_link);
     g_array_unref(priv->delayed_action.list_wait_for_response_rtnl);
+    g_free(priv->route_tables_tracked.tables);
     g_array_unref(priv->delayed_action.list_wait_for_response_genl);
 
     nm_clear_g_source_inst(&priv->event_source_genl);
@@ -12328,6 +14225,9 @@ finalize(GObject *object)
     nl_socket_free(priv->sk_genl);
     nl_socket_free(priv->sk_rtnl);
 
+    for (i = _NMP_NETLINK_FIRST; i < _NMP_NETLINK_NUM; i++)
+        nl_recv_batch_clear(&priv->netlink_recv_batch[i]);
+
     {
         NM_G_MUTEX_LOCKED(&sysctl_clear_cache_lock);
 
@@ -12342,9 +14242,9 @@ finalize(GObject *object)
 
     priv->udev_client = nm_udev_client_destroy(priv->udev_client);
 
-    G_OBJECT_CLASS(nm_linux_platform_parent_class)->finalize(object);
+    nm_clear_pointer(&priv->link_probes, g_hash_table_destroy);
 
-    g_free(priv->netlink_recv_buf.buf);
+    G_OBJECT_CLASS(nm_linux_platform_parent_class)->finalize(object);
 }
 
 static void
@@ -12362,12 +14262,14 @@ nm_linux_platform_class_init(NMLinuxPlatformClass *klass)
     platform_class->sysctl_get       = sysctl_get;
 
     platform_class->link_add          = link_add;
+    platform_class->link_add_batch    = link_add_batch;
     platform_class->link_change_extra = link_change_extra;
     platform_class->link_delete       = link_delete;
 
     platform_class->link_change = link_change;
 
-    platform_class->link_refresh = link_refresh;
+    platform_class->link_refresh     = link_refresh;
+    platform_class->link_refresh_all = link_refresh_all;
 
     platform_class->link_set_netns = link_set_netns;
 
@@ -12379,10 +14281,12 @@ nm_linux_platform_class_init(NMLinuxPlatformClass *klass)
     platform_class->link_set_address                   = link_set_address;
     platform_class->link_get_permanent_address_ethtool = link_get_permanent_address_ethtool;
     platform_class->link_set_mtu                       = link_set_mtu;
+    platform_class->link_set_xdp                       = link_set_xdp;
     platform_class->link_set_name                      = link_set_name;
     platform_class->link_set_sriov_params_async        = link_set_sriov_params_async;
     platform_class->link_set_sriov_vfs                 = link_set_sriov_vfs;
     platform_class->link_set_bridge_vlans              = link_set_bridge_vlans;
+    platform_class->link_delete_bridge_vlans           = link_delete_bridge_vlans;
     platform_class->link_get_bridge_vlans              = link_get_bridge_vlans;
     platform_class->link_set_bridge_info               = link_set_bridge_info;
 
@@ -12394,9 +14298,12 @@ nm_linux_platform_class_init(NMLinuxPlatformClass *klass)
     platform_class->link_supports_carrier_detect = link_supports_carrier_detect;
     platform_class->link_supports_vlans          = link_supports_vlans;
     platform_class->link_supports_sriov          = link_supports_sriov;
+    platform_class->link_prefetch_probes         = link_prefetch_probes;
+    platform_class->link_prefetch_clear          = link_prefetch_clear;
 
-    platform_class->link_attach_port  = link_attach_port;
-    platform_class->link_release_port = link_release_port;
+    platform_class->link_attach_port       = link_attach_port;
+    platform_class->link_attach_port_batch = link_attach_port_batch;
+    platform_class->link_release_port      = link_release_port;
 
     platform_class->link_can_assume = link_can_assume;
 
@@ -12435,11 +14342,18 @@ nm_linux_platform_class_init(NMLinuxPlatformClass *klass)
     platform_class->ip4_address_delete = ip4_address_delete;
     platform_class->ip6_address_delete = ip6_address_delete;
 
-    platform_class->ip_route_add = ip_route_add;
-    platform_class->ip_route_get = ip_route_get;
+    platform_class->ip_route_add                = ip_route_add;
+    platform_class->object_batch                = object_batch;
+    platform_class->ip_route_set_tracked_tables = ip_route_set_tracked_tables;
+    platform_class->ip_route_get                = ip_route_get;
+
+    platform_class->netlink_set_rcvbuf_max = netlink_set_rcvbuf_max;
 
     platform_class->routing_rule_add = routing_rule_add;
 
+    platform_class->ip_nexthop_add    = ip_nexthop_add;
+    platform_class->ip_nexthop_delete = ip_nexthop_delete;
+
     platform_class->qdisc_add      = qdisc_add;
     platform_class->qdisc_delete   = qdisc_delete;
     platform_class->tfilter_add    = tfilter_add;
@@ -12451,10 +14365,16 @@ nm_linux_platform_class_init(NMLinuxPlatformClass *klass)
     platform_class->mptcp_addr_update  = mptcp_addr_update;
     platform_class->mptcp_addrs_dump   = mptcp_addrs_dump;
 
-    platform_class->ethtool_set_pause = ethtool_set_pause;
-    platform_class->ethtool_get_pause = ethtool_get_pause;
-    platform_class->ethtool_set_eee   = ethtool_set_eee;
-    platform_class->ethtool_get_eee   = ethtool_get_eee;
-    platform_class->ethtool_set_ring  = ethtool_set_ring;
-    platform_class->ethtool_get_ring  = ethtool_get_ring;
+    platform_class->neigh_dump = neigh_dump;
+
+    platform_class->ethtool_set_pause    = ethtool_set_pause;
+    platform_class->ethtool_get_pause    = ethtool_get_pause;
+    platform_class->ethtool_set_eee      = ethtool_set_eee;
+    platform_class->ethtool_get_eee      = ethtool_get_eee;
+    platform_class->ethtool_set_ring     = ethtool_set_ring;
+    platform_class->ethtool_get_ring     = ethtool_get_ring;
+    platform_class->ethtool_set_channels = ethtool_set_channels;
+    platform_class->ethtool_get_channels = ethtool_get_channels;
+    platform_class->ethtool_set_rss      = ethtool_set_rss;
+    platform_class->ethtool_get_rss      = ethtool_get_rss;
 }
@@ -928,15 +928,30 @@ _genl_parse_getfamily(const struct nl_msg *msg, void *arg)
     return NL_STOP;
 }
 
+/**
+ * genl_ctrl_request_family:
+ * @sk: the generic netlink socket.
+ * @name: the name of the generic netlink family.
+ * @valid_cb: called with the CTRL_CMD_NEWFAMILY reply.
+ * @valid_arg: the argument for @valid_cb.
+ *
+ * Sends CTRL_CMD_GETFAMILY for @name and waits for the reply. The reply
+ * carries the family ID and the multicast groups of the family.
+ *
+ * Returns: a negative error code on failure, for example when the family
+ *   does not exist.
+ */
 int
-genl_ctrl_resolve(struct nl_sock *sk, const char *name)
+genl_ctrl_request_family(struct nl_sock *sk,
+                         const char     *name,
+                         int (*valid_cb)(const struct nl_msg *, void *),
+                         void *valid_arg)
 {
     nm_auto_nlmsg struct nl_msg *msg = NULL;
     int                          nmerr;
-    gint32                       response_data = -1;
-    const struct nl_cb           cb            = {
-                             .valid_cb  = _genl_parse_getfamily,
-                             .valid_arg = &response_data,
+    const struct nl_cb           cb   = {
+        .valid_cb  = valid_cb,
+        .valid_arg = valid_arg,
     };
 
     msg = nlmsg_alloc(0);
@@ -957,7 +972,16 @@ genl_ctrl_resolve(struct nl_sock *sk, const char *name)
         return nmerr;
 
     /* If search was successful, request may be ACKed after data */
-    nmerr = nl_wait_for_ack(sk, NULL);
+    return nl_wait_for_ack(sk, NULL);
+}
+
+int
+genl_ctrl_resolve(struct nl_sock *sk, const char *name)
+{
+    gint32 response_data = -1;
+    int    nmerr;
+
+    nmerr = genl_ctrl_request_family(sk, name, _genl_parse_getfamily, &response_data);
     if (nmerr < 0)
         return nmerr;
 
@@ -1063,6 +1087,51 @@ nl_socket_set_buffer_size(struct nl_sock *sk, int rxbuf, int txbuf)
     return 0;
 }
 
+/**
+ * nl_socket_set_rx_buffer_size:
+ * @sk: the netlink socket
+ * @rxbuf: the requested receive buffer size
+ * @force: if %TRUE, first try SO_RCVBUFFORCE, which is not limited
+ *   by net.core.rmem_max but requires CAP_NET_ADMIN.
+ *
+ * Returns: 0 on success or a negative error code.
+ */
+int
+nl_socket_set_rx_buffer_size(struct nl_sock *sk, int rxbuf, gboolean force)
+{
+    nm_assert_sk(sk);
+    nm_assert(rxbuf > 0);
+
+    if (force && setsockopt(sk->s_fd, SOL_SOCKET, SO_RCVBUFFORCE, &rxbuf, sizeof(rxbuf)) == 0)
+        return 0;
+
+    if (setsockopt(sk->s_fd, SOL_SOCKET, SO_RCVBUF, &rxbuf, sizeof(rxbuf)) < 0)
+        return -nm_errno_from_native(errno);
+
+    return 0;
+}
+
+/**
+ * nl_socket_get_rx_buffer_size:
+ * @sk: the netlink socket
+ *
+ * Returns: the actual receive buffer size (as reported by kernel, which
+ *   accounts for its bookkeeping overhead) or a negative error code.
+ */
+int
+nl_socket_get_rx_buffer_size(const struct nl_sock *sk)
+{
+    int       val;
+    socklen_t len = sizeof(val);
+
+    nm_assert_sk(sk);
+
+    if (getsockopt(sk->s_fd, SOL_SOCKET, SO_RCVBUF, &val, &len) < 0)
+        return -nm_errno_from_native(errno);
+
+    return val;
+}
+
 int
 nl_socket_add_memberships(struct nl_sock *sk, int group, ...)
 {
@@ -1260,13 +1329,22 @@ continue_reading:
 
     hdr = NM_CAST_ALIGN(struct nlmsghdr, buf);
     while (nlmsg_ok(hdr, n)) {
-        nm_auto_nlmsg struct nl_msg *msg = NULL;
-
-        msg = nlmsg_alloc_convert(hdr);
-
-        nlmsg_set_proto(msg, sk->s_proto);
-        nlmsg_set_src(msg, &nla);
-        nlmsg_set_creds(msg, creds_has ? &creds : NULL);
+        /* The message is not copied. It points into the receive buffer, which
+         * is valid while we invoke the callbacks. The callbacks must not keep
+         * a reference to the message (which they can't, as struct nl_msg
+         * is not ref-counted). */
+        struct nl_msg  msg_stack;
+        struct nl_msg *msg = &msg_stack;
+
+        msg_stack = (struct nl_msg) {
+            .nm_protocol  = sk->s_proto,
+            .nm_src       = nla,
+            .nm_nlh       = hdr,
+            .nm_size      = NLMSG_ALIGN(hdr->nlmsg_len),
+            .nm_creds_has = creds_has,
+        };
+        if (creds_has)
+            msg_stack.nm_creds = creds;
 
         nrecv++;
 
@@ -1479,6 +1557,41 @@ nl_send_auto(struct nl_sock *sk, struct nl_msg *msg)
     return nl_send(sk, msg);
 }
 
+static void
+_nl_recv_parse_cmsg(struct msghdr *msg,
+                    struct ucred  *out_creds,
+                    gboolean      *out_creds_has,
+                    uint32_t      *out_pktinfo_group,
+                    gboolean      *out_pktinfo_has)
+{
+    struct cmsghdr *cmsg;
+
+    if (!out_creds_has && !out_pktinfo_has)
+        return;
+
+    NM_SET_OUT(out_creds_has, FALSE);
+    NM_SET_OUT(out_pktinfo_has, FALSE);
+    for (cmsg = CMSG_FIRSTHDR(msg); cmsg; cmsg = CMSG_NXTHDR(msg, cmsg)) {
+        switch (cmsg->cmsg_level) {
+        case SOL_SOCKET:
+            if (cmsg->cmsg_type == SCM_CREDENTIALS && out_creds_has) {
+                memcpy(out_creds, CMSG_DATA(cmsg), sizeof(*out_creds));
+                *out_creds_has = TRUE;
+            }
+            break;
+        case SOL_NETLINK:
+            if (cmsg->cmsg_type == NETLINK_PKTINFO && out_pktinfo_has) {
+                struct nl_pktinfo p;
+
+                memcpy(&p, CMSG_DATA(cmsg), sizeof(p));
+                *out_pktinfo_group = p.group;
+                *out_pktinfo_has   = TRUE;
+            }
+            break;
+        }
+    }
+}
+
 /**
  * nl_recv():
  * @sk: the netlink socket
@@ -1543,9 +1656,8 @@ nl_recv(struct nl_sock     *sk,
         .msg_controllen = 0,
         .msg_control    = NULL,
     };
-    struct cmsghdr *cmsg;
-    int             retval;
-    int             errsv;
+    int retval;
+    int errsv;
 
     nm_assert(nla);
     nm_assert(buf && !*buf);
@@ -1619,29 +1731,7 @@ retry:
         goto abort;
     }
 
-    if (out_creds_has || out_pktinfo_has) {
-        NM_SET_OUT(out_creds_has, FALSE);
-        NM_SET_OUT(out_pktinfo_has, FALSE);
-        for (cmsg = CMSG_FIRSTHDR(&msg); cmsg; cmsg = CMSG_NXTHDR(&msg, cmsg)) {
-            switch (cmsg->cmsg_level) {
-            case SOL_SOCKET:
-                if (cmsg->cmsg_type == SCM_CREDENTIALS && out_creds_has) {
-                    memcpy(out_creds, CMSG_DATA(cmsg), sizeof(*out_creds));
-                    *out_creds_has = TRUE;
-                }
-                break;
-            case SOL_NETLINK:
-                if (cmsg->cmsg_type == NETLINK_PKTINFO && out_pktinfo_has) {
-                    struct nl_pktinfo p;
-
-                    memcpy(&p, CMSG_DATA(cmsg), sizeof(p));
-                    *out_pktinfo_group = p.group;
-                    *out_pktinfo_has   = TRUE;
-                }
-                break;
-            }
-        }
-    }
+    _nl_recv_parse_cmsg(&msg, out_creds, out_creds_has, out_pktinfo_group, out_pktinfo_has);
 
     *buf = iov.iov_base;
     return (int) n;
@@ -1651,3 +1741,179 @@ abort:
         g_free(iov.iov_base);
     return retval;
 }
+
+/*****************************************************************************/
+
+typedef union {
+    struct cmsghdr _dummy_for_alignment;
+    char           buf[CMSG_SPACE(sizeof(struct ucred)) + CMSG_SPACE(sizeof(struct nl_pktinfo))];
+} NLRecvBatchCmsgBuf;
+
+/**
+ * nl_recv_batch_init:
+ * @batch: the batch to initialize
+ * @n_slots: the number of datagrams to receive with one syscall
+ * @slot_len: the size of the receive buffer for each datagram
+ */
+void
+nl_recv_batch_init(NLRecvBatch *batch, guint n_slots, size_t slot_len)
+{
+    nm_assert(batch);
+    nm_assert(n_slots > 0);
+    nm_assert(slot_len > 0);
+
+    *batch = (NLRecvBatch) {
+        .n_slots       = n_slots,
+        .slot_len      = slot_len,
+        .slot_len_next = slot_len,
+        .buf           = g_malloc(n_slots * slot_len),
+        .msgs          = g_new0(struct mmsghdr, n_slots),
+        .iovs          = g_new0(struct iovec, n_slots),
+        .addrs         = g_new0(struct sockaddr_nl, n_slots),
+        .cmsgs         = g_new0(NLRecvBatchCmsgBuf, n_slots),
+    };
+}
+
+void
+nl_recv_batch_clear(NLRecvBatch *batch)
+{
+    nm_assert(batch);
+
+    g_free(batch->buf);
+    g_free(batch->msgs);
+    g_free(batch->iovs);
+    g_free(batch->addrs);
+    g_free(batch->cmsgs);
+    *batch = (NLRecvBatch) {};
+}
+
+/**
+ * nl_recv_batch_set_slot_len:
+ * @batch: the batch
+ * @slot_len: the new receive buffer size for each datagram
+ *
+ * The receive buffers are only resized the next time that datagrams
+ * are received from the socket, so that pending datagrams stay valid.
+ */
+void
+nl_recv_batch_set_slot_len(NLRecvBatch *batch, size_t slot_len)
+{
+    nm_assert(batch);
+    nm_assert(slot_len > 0);
+
+    batch->slot_len_next = slot_len;
+}
+
+/**
+ * nl_recv_batch:
+ * @sk: the netlink socket
+ * @batch: the receive batch for @sk
+ * @nla: (out): the source address on success.
+ * @buf: (out): pointer to the received datagram on success. This points
+ *   inside @batch and is valid until the next call.
+ * @out_creds: (out) (optional): optional out buffer for the credentials
+ *   on success.
+ * @out_creds_has: (out) (optional): result indicating whether
+ *   @out_creds was filled.
+ * @out_pktinfo_group: (out) (optional): optional out buffer for NETLINK_PKTINFO
+ *    group on success.
+ * @out_pktinfo_has: (out) (optional): result indicating whether
+ *   @out_pktinfo_group was filled.
+ *
+ * Like nl_recv() without NL_MSG_PEEK, but returns the datagrams one by one
+ * from @batch. Only when all pending datagrams were returned, it receives
+ * up to "n_slots" datagrams with a single recvmmsg() call.
+ *
+ * If a datagram was larger than the buffer, it is lost and
+ * -NME_NL_MSG_TRUNC gets returned for it.
+ *
+ * Returns: a negative error code or the length of the received message in
+ *   @buf.
+ */
+int
+nl_recv_batch(struct nl_sock     *sk,
+              NLRecvBatch        *batch,
+              struct sockaddr_nl *nla,
+              unsigned char     **buf,
+              struct ucred       *out_creds,
+              gboolean           *out_creds_has,
+              uint32_t           *out_pktinfo_group,
+              gboolean           *out_pktinfo_has)
+{
+    struct mmsghdr *m;
+    guint           i;
+    int             r;
+
+    nm_assert_sk(sk);
+    nm_assert(batch);
+    nm_assert(batch->n_slots > 0);
+    nm_assert(nla);
+    nm_assert(buf && !*buf);
+    nm_assert(!out_creds_has || out_creds);
+    nm_assert(!out_pktinfo_has || out_pktinfo_group);
+
+    if (!nl_recv_batch_has_pending(batch)) {
+        batch->n_filled = 0;
+        batch->next     = 0;
+
+        if (batch->slot_len != batch->slot_len_next) {
+            batch->slot_len = batch->slot_len_next;
+            batch->buf      = g_realloc(batch->buf, batch->n_slots * batch->slot_len);
+        }
+
+        for (i = 0; i < batch->n_slots; i++) {
+            batch->iovs[i] = (struct iovec) {
+                .iov_base = &batch->buf[i * batch->slot_len],
+                .iov_len  = batch->slot_len,
+            };
+            batch->msgs[i] = (struct mmsghdr) {
+                .msg_hdr =
+                    {
+                        .msg_name       = &batch->addrs[i],
+                        .msg_namelen    = sizeof(struct sockaddr_nl),
+                        .msg_iov        = &batch->iovs[i],
+                        .msg_iovlen     = 1,
+                        .msg_control    = &((NLRecvBatchCmsgBuf *) batch->cmsgs)[i],
+                        .msg_controllen = sizeof(NLRecvBatchCmsgBuf),
+                    },
+            };
+        }
+
+        do {
+            r = recvmmsg(sk->s_fd, batch->msgs, batch->n_slots, 0, NULL);
+        } while (r < 0 && errno == EINTR);
+
+        if (r < 0)
+            return -nm_errno_from_native(errno);
+        if (r == 0)
+            return 0;
+
+        nm_assert((guint) r <= batch->n_slots);
+        batch->n_filled = r;
+    }
+
+    m = &batch->msgs[batch->next++];
+
+    if (m->msg_len == 0)
+        return 0;
+
+    nm_assert(m->msg_len <= G_MAXINT);
+    nm_assert(!(m->msg_hdr.msg_flags & MSG_CTRUNC));
+
+    if (m->msg_len > batch->slot_len || (m->msg_hdr.msg_flags & MSG_TRUNC))
+        return -NME_NL_MSG_TRUNC;
+
+    if (m->msg_hdr.msg_namelen != sizeof(struct sockaddr_nl))
+        return -NME_UNSPEC;
+
+    *nla = *((struct sockaddr_nl *) m->msg_hdr.msg_name);
+
+    _nl_recv_parse_cmsg(&m->msg_hdr,
+                        out_creds,
+                        out_creds_has,
+                        out_pktinfo_group,
+                        out_pktinfo_has);
+
+    *buf = m->msg_hdr.msg_iov->iov_base;
+    return (int) m->msg_len;
+}
@@ -602,6 +602,9 @@ int    nl_socket_set_msg_buf_size(struct nl_sock *sk, size_t bufsize);
 
 int nl_socket_set_buffer_size(struct nl_sock *sk, int rxbuf, int txbuf);
 
+int nl_socket_set_rx_buffer_size(struct nl_sock *sk, int rxbuf, gboolean force);
+int nl_socket_get_rx_buffer_size(const struct nl_sock *sk);
+
 int nl_socket_set_passcred(struct nl_sock *sk, int state);
 
 int nl_socket_set_pktinfo(struct nl_sock *sk, int state);
@@ -622,6 +625,39 @@ int nl_recv(struct nl_sock     *sk,
             uint32_t           *out_pktinfo_group,
             gboolean           *out_pktinfo_has);
 
+/* State for receiving several datagrams with one recvmmsg() call. */
+typedef struct {
+    unsigned char      *buf;
+    struct mmsghdr     *msgs;
+    struct iovec       *iovs;
+    struct sockaddr_nl *addrs;
+    void               *cmsgs;
+    size_t              slot_len;
+    size_t              slot_len_next;
+    guint               n_slots;
+    guint               n_filled;
+    guint               next;
+} NLRecvBatch;
+
+void nl_recv_batch_init(NLRecvBatch *batch, guint n_slots, size_t slot_len);
+void nl_recv_batch_clear(NLRecvBatch *batch);
+void nl_recv_batch_set_slot_len(NLRecvBatch *batch, size_t slot_len);
+
+static inline gboolean
+nl_recv_batch_has_pending(const NLRecvBatch *batch)
+{
+    return batch->next < batch->n_filled;
+}
+
+int nl_recv_batch(struct nl_sock     *sk,
+                  NLRecvBatch        *batch,
+                  struct sockaddr_nl *nla,
+                  unsigned char     **buf,
+                  struct ucred       *out_creds,
+                  gboolean           *out_creds_has,
+                  uint32_t           *out_pktinfo_group,
+                  gboolean           *out_pktinfo_has);
+
 int nl_send(struct nl_sock *sk, struct nl_msg *msg);
 
 int nl_send_auto(struct nl_sock *sk, struct nl_msg *msg);
@@ -702,6 +738,11 @@ int genlmsg_parse(const struct nlmsghdr   *nlh,
         genlmsg_parse((nlh), (hdrlen), (tb), G_N_ELEMENTS(tb) - 1, (policy)); \
     })
 
+int genl_ctrl_request_family(struct nl_sock *sk,
+                             const char     *name,
+                             int (*valid_cb)(const struct nl_msg *, void *),
+                             void *valid_arg);
+
 int genl_ctrl_resolve(struct nl_sock *sk, const char *name);
 
 /*****************************************************************************/
@@ -21,6 +21,9 @@ NMPCache *nm_platform_get_cache(NMPlatform *self);
     }                                                                                          \
     G_STMT_END
 
+void nm_platform_emit_wifi_event(NMPlatform *platform, int ifindex);
+void nm_platform_emit_resync_done(NMPlatform *platform);
+
 void nm_platform_cache_update_emit_signal(NMPlatform      *platform,
                                           NMPCacheOpsType  cache_op,
                                           const NMPObject *obj_old,
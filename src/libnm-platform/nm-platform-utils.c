@@ -11,6 +11,8 @@
 
 #include <unistd.h>
 #include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/bpf.h>
 #include <linux/sockios.h>
 #include <linux/if.h>
 #include <linux/version.h>
@@ -431,6 +433,32 @@ nmp_utils_sysctl_open_netdir(int ifindex, const char *ifname_guess, char *out_if
 
 /*****************************************************************************/
 
+/**
+ * nmp_utils_bpf_obj_get:
+ * @path: the path of a BPF object pinned in the BPF filesystem.
+ *
+ * Returns: a file descriptor for the pinned BPF object (like an XDP
+ *   program), or a negative errno.
+ */
+int
+nmp_utils_bpf_obj_get(const char *path)
+{
+    union bpf_attr attr;
+    int            fd;
+
+    g_return_val_if_fail(path, -EINVAL);
+
+    memset(&attr, 0, sizeof(attr));
+    attr.pathname = (guint64) (uintptr_t) path;
+
+    fd = (int) syscall(__NR_bpf, BPF_OBJ_GET, &attr, sizeof(attr));
+    if (fd < 0)
+        return -NM_ERRNO_NATIVE(errno);
+    return fd;
+}
+
+/*****************************************************************************/
+
 char *
 nmp_utils_new_vlan_name(const char *parent_iface, guint32 vlan_id)
 {
@@ -631,6 +659,112 @@ nmp_utils_bridge_normalized_vlans_equal(const NMPlatformBridgeVlan *vlans_a,
     return TRUE;
 }
 
+#define _BRIDGE_VLAN_PRESENT  ((guint8) 0x1)
+#define _BRIDGE_VLAN_UNTAGGED ((guint8) 0x2)
+#define _BRIDGE_VLAN_PVID     ((guint8) 0x4)
+
+static void
+_bridge_vlans_to_table(guint8                      table[static 4096],
+                       const NMPlatformBridgeVlan *vlans,
+                       guint                       num_vlans)
+{
+    guint i;
+    guint vid;
+
+    memset(table, 0, 4096);
+    for (i = 0; i < num_vlans; i++) {
+        guint8 flags = _BRIDGE_VLAN_PRESENT;
+
+        if (vlans[i].untagged)
+            flags |= _BRIDGE_VLAN_UNTAGGED;
+        if (vlans[i].pvid)
+            flags |= _BRIDGE_VLAN_PVID;
+        for (vid = vlans[i].vid_start; vid <= NM_MIN(vlans[i].vid_end, 4095u); vid++)
+            table[vid] = flags;
+    }
+}
+
+static NMPlatformBridgeVlan *
+_bridge_vlans_from_table(const guint8 table[static 4096], guint *out_num_vlans)
+{
+    GArray *arr = NULL;
+    guint   vid;
+
+    /* Consecutive VLANs with the same flags are compressed into one range. */
+    for (vid = 1; vid < 4095u; vid++) {
+        if (!table[vid])
+            continue;
+
+        if (vid > 1 && table[vid] == table[vid - 1]) {
+            nm_g_array_last(arr, NMPlatformBridgeVlan).vid_end = vid;
+            continue;
+        }
+
+        if (!arr)
+            arr = g_array_new(FALSE, FALSE, sizeof(NMPlatformBridgeVlan));
+        g_array_append_val(arr,
+                           ((NMPlatformBridgeVlan) {
+                               .vid_start = vid,
+                               .vid_end   = vid,
+                               .untagged  = NM_FLAGS_HAS(table[vid], _BRIDGE_VLAN_UNTAGGED),
+                               .pvid      = NM_FLAGS_HAS(table[vid], _BRIDGE_VLAN_PVID),
+                           }));
+    }
+
+    if (!arr) {
+        *out_num_vlans = 0;
+        return NULL;
+    }
+
+    *out_num_vlans = arr->len;
+    return (NMPlatformBridgeVlan *) g_array_free(arr, FALSE);
+}
+
+/**
+ * nmp_utils_bridge_vlan_diff:
+ * @old_vlans: the VLAN ranges currently configured
+ * @num_old_vlans: the number of elements of @old_vlans
+ * @new_vlans: the VLAN ranges that should be configured
+ * @num_new_vlans: the number of elements of @new_vlans
+ * @out_del_vlans: (out) (transfer full): the VLAN ranges to delete
+ * @out_num_del_vlans: (out): the number of elements of @out_del_vlans
+ * @out_add_vlans: (out) (transfer full): the VLAN ranges to add
+ * @out_num_add_vlans: (out): the number of elements of @out_add_vlans
+ *
+ * Computes the changes to get from @old_vlans to @new_vlans: the VLANs
+ * that are no longer wanted, and the VLANs that are new or whose flags
+ * change. Adding an existing VLAN again updates its flags, so it doesn't
+ * need to be deleted first. The results are compressed into ranges and
+ * are %NULL if there is nothing to do. The inputs need not be normalized,
+ * but must not contain overlapping ranges with different flags.
+ */
+void
+nmp_utils_bridge_vlan_diff(const NMPlatformBridgeVlan *old_vlans,
+                           guint                       num_old_vlans,
+                           const NMPlatformBridgeVlan *new_vlans,
+                           guint                       num_new_vlans,
+                           NMPlatformBridgeVlan      **out_del_vlans,
+                           guint                      *out_num_del_vlans,
+                           NMPlatformBridgeVlan      **out_add_vlans,
+                           guint                      *out_num_add_vlans)
+{
+    guint8 table_old[4096];
+    guint8 table_new[4096];
+    guint8 table_diff[4096];
+    guint  vid;
+
+    _bridge_vlans_to_table(table_old, old_vlans, num_old_vlans);
+    _bridge_vlans_to_table(table_new, new_vlans, num_new_vlans);
+
+    for (vid = 0; vid < 4096u; vid++)
+        table_diff[vid] = (table_old[vid] && !table_new[vid]) ? _BRIDGE_VLAN_PRESENT : 0;
+    *out_del_vlans = _bridge_vlans_from_table(table_diff, out_num_del_vlans);
+
+    for (vid = 0; vid < 4096u; vid++)
+        table_diff[vid] = (table_new[vid] != table_old[vid]) ? table_new[vid] : 0;
+    *out_add_vlans = _bridge_vlans_from_table(table_diff, out_num_add_vlans);
+}
+
 /*****************************************************************************/
 
 static const char *
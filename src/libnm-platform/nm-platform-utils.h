@@ -34,6 +34,8 @@ int         nmp_utils_if_nametoindex(const char *ifname);
 
 int nmp_utils_sysctl_open_netdir(int ifindex, const char *ifname_guess, char *out_ifname);
 
+int nmp_utils_bpf_obj_get(const char *path);
+
 char *nmp_utils_new_vlan_name(const char *parent_iface, guint32 vlan_id);
 
 guint32
@@ -55,4 +57,13 @@ gboolean nmp_utils_bridge_normalized_vlans_equal(const NMPlatformBridgeVlan *vla
                                                  const NMPlatformBridgeVlan *vlans_b,
                                                  guint                       num_vlans_b);
 
+void nmp_utils_bridge_vlan_diff(const NMPlatformBridgeVlan *old_vlans,
+                                guint                       num_old_vlans,
+                                const NMPlatformBridgeVlan *new_vlans,
+                                guint                       num_new_vlans,
+                                NMPlatformBridgeVlan      **out_del_vlans,
+                                guint                      *out_num_del_vlans,
+                                NMPlatformBridgeVlan      **out_add_vlans,
+                                guint                      *out_num_add_vlans);
+
 #endif /* __NM_PLATFORM_UTILS_H__ */
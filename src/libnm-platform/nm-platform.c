@@ -228,6 +228,9 @@ nmp_link_address_get_as_bytes(const NMPLinkAddress *addr)
 
 static guint signals[_NM_PLATFORM_SIGNAL_ID_LAST] = {0};
 
+static guint signal_wifi_event  = 0;
+static guint signal_resync_done = 0;
+
 enum {
     PROP_0,
     PROP_MULTI_IDX,
@@ -249,12 +252,31 @@ typedef struct _NMPlatformPrivate {
     CList              ip6_dadfailed_lst_head;
     NMDedupMultiIndex *multi_idx;
     NMPCache          *cache;
+
+    /* The values that nm_platform_sysctl_ip_conf_set() last wrote, by
+     * interface name. Each element is a hash of sysctl path to value. */
+    GHashTable *sysctl_ip_conf_cache;
+
+    struct {
+        struct _NMPlatformTraceEntry *buf;
+        guint                         size;
+        guint                         next;
+        guint64                       total;
+    } trace;
 } NMPlatformPrivate;
 
 G_DEFINE_TYPE(NMPlatform, nm_platform, G_TYPE_OBJECT)
 
 #define NM_PLATFORM_GET_PRIVATE(self) _NM_GET_PRIVATE_PTR(self, NMPlatform, NM_IS_PLATFORM)
 
+typedef struct _NMPlatformTraceEntry {
+    gint64                     timestamp_nsec;
+    const char                *what;
+    const NMPObject           *obj_old;
+    const NMPObject           *obj_new;
+    NMPlatformSignalChangeType change_type;
+} NMPlatformTraceEntry;
+
 /*****************************************************************************/
 
 static void _ip4_dev_route_blacklist_schedule(NMPlatform *self);
@@ -333,6 +355,14 @@ nm_platform_get_multi_idx(NMPlatform *self)
     return NM_PLATFORM_GET_PRIVATE(self)->multi_idx;
 }
 
+guint
+nm_platform_cache_get_stats(NMPlatform *self, NMPObjectType obj_type, gsize *out_bytes)
+{
+    g_return_val_if_fail(NM_IS_PLATFORM(self), 0);
+
+    return nmp_cache_get_stats(NM_PLATFORM_GET_PRIVATE(self)->cache, obj_type, out_bytes);
+}
+
 /*****************************************************************************/
 
 static NM_UTILS_LOOKUP_STR_DEFINE(
@@ -469,15 +499,18 @@ const NMPGenlFamilyInfo nmp_genl_family_infos[_NMP_GENL_FAMILY_TYPE_NUM] = {
         },
     [NMP_GENL_FAMILY_TYPE_NL80211] =
         {
-            .name = "nl80211",
+            .name     = "nl80211",
+            .autoload = TRUE,
         },
     [NMP_GENL_FAMILY_TYPE_NL802154] =
         {
-            .name = "nl802154",
+            .name     = "nl802154",
+            .autoload = TRUE,
         },
     [NMP_GENL_FAMILY_TYPE_WIREGUARD] =
         {
-            .name = "wireguard",
+            .name     = "wireguard",
+            .autoload = TRUE,
         },
 };
 
@@ -629,6 +662,41 @@ nm_platform_sysctl_open_netdir(NMPlatform *self, int ifindex, char *out_ifname)
  *
  * Returns: %TRUE on success.
  */
+static void
+_sysctl_ip_conf_cache_invalidate_path(NMPlatform *self, const char *path)
+{
+    NMPlatformPrivate *priv = NM_PLATFORM_GET_PRIVATE(self);
+    const char        *ifname;
+    const char        *slash;
+    char               ifname_buf[IFNAMSIZ];
+    gsize              l;
+
+    if (!priv->sysctl_ip_conf_cache || g_hash_table_size(priv->sysctl_ip_conf_cache) == 0)
+        return;
+
+    if (NM_STR_HAS_PREFIX(path, "/proc/sys/net/ipv4/conf/"))
+        ifname = &path[NM_STRLEN("/proc/sys/net/ipv4/conf/")];
+    else if (NM_STR_HAS_PREFIX(path, "/proc/sys/net/ipv6/conf/"))
+        ifname = &path[NM_STRLEN("/proc/sys/net/ipv6/conf/")];
+    else
+        return;
+
+    slash = strchr(ifname, '/');
+    l     = slash ? (gsize) (slash - ifname) : strlen(ifname);
+    if (l == 0 || l >= sizeof(ifname_buf)) {
+        g_hash_table_remove_all(priv->sysctl_ip_conf_cache);
+        return;
+    }
+    memcpy(ifname_buf, ifname, l);
+    ifname_buf[l] = '\0';
+
+    /* "all" and "default" also affect the values of other interfaces. */
+    if (NM_IN_STRSET(ifname_buf, "all", "default"))
+        g_hash_table_remove_all(priv->sysctl_ip_conf_cache);
+    else
+        g_hash_table_remove(priv->sysctl_ip_conf_cache, ifname_buf);
+}
+
 gboolean
 nm_platform_sysctl_set(NMPlatform *self,
                        const char *pathid,
@@ -641,6 +709,9 @@ nm_platform_sysctl_set(NMPlatform *self,
     g_return_val_if_fail(path, FALSE);
     g_return_val_if_fail(value, FALSE);
 
+    if (dirfd < 0)
+        _sysctl_ip_conf_cache_invalidate_path(self, path);
+
     return klass->sysctl_set(self, pathid, dirfd, path, value);
 }
 
@@ -924,13 +995,50 @@ nm_platform_sysctl_ip_conf_set(NMPlatform *self,
                                const char *property,
                                const char *value)
 {
-    char buf[NM_UTILS_SYSCTL_IP_CONF_PATH_BUFSIZE];
+    NMPlatformPrivate *priv;
+    char               buf[NM_UTILS_SYSCTL_IP_CONF_PATH_BUFSIZE];
+    const char        *path;
+    GHashTable        *values;
+    const char        *cached;
 
-    return nm_platform_sysctl_set(
-        self,
-        NMP_SYSCTL_PATHID_ABSOLUTE(
-            nm_utils_sysctl_ip_conf_path(addr_family, buf, ifname, property)),
-        value);
+    _CHECK_SELF(self, klass, FALSE);
+
+    g_return_val_if_fail(value, FALSE);
+
+    priv = NM_PLATFORM_GET_PRIVATE(self);
+    path = nm_utils_sysctl_ip_conf_path(addr_family, buf, ifname, property);
+
+    /* Skip writing the value that we wrote last time. The cache of an interface
+     * is dropped on every change of its link, which also covers changes of
+     * sysctls that the kernel does on its own (like adjusting the IPv6 MTU).
+     * Values written by others behind our back are not detected. */
+    values = priv->sysctl_ip_conf_cache
+                 ? g_hash_table_lookup(priv->sysctl_ip_conf_cache, ifname)
+                 : NULL;
+    if (values && (cached = g_hash_table_lookup(values, path)) && nm_streq(cached, value)) {
+        _LOGT("sysctl: skip setting '%s' to '%s' (unchanged)", path, value);
+        return TRUE;
+    }
+
+    if (!nm_platform_sysctl_set(self, NMP_SYSCTL_PATHID_ABSOLUTE(path), value))
+        return FALSE;
+
+    if (NM_IN_STRSET(ifname, "all", "default"))
+        return TRUE;
+
+    if (!priv->sysctl_ip_conf_cache) {
+        priv->sysctl_ip_conf_cache = g_hash_table_new_full(nm_str_hash,
+                                                           g_str_equal,
+                                                           g_free,
+                                                           (GDestroyNotify) g_hash_table_unref);
+    }
+    values = g_hash_table_lookup(priv->sysctl_ip_conf_cache, ifname);
+    if (!values) {
+        values = g_hash_table_new_full(nm_str_hash, g_str_equal, g_free, g_free);
+        g_hash_table_insert(priv->sysctl_ip_conf_cache, g_strdup(ifname), values);
+    }
+    g_hash_table_insert(values, g_strdup(path), g_strdup(value));
+    return TRUE;
 }
 
 gboolean
@@ -940,14 +1048,13 @@ nm_platform_sysctl_ip_conf_set_int64(NMPlatform *self,
                                      const char *property,
                                      gint64      value)
 {
-    char buf[NM_UTILS_SYSCTL_IP_CONF_PATH_BUFSIZE];
     char s[64];
 
-    return nm_platform_sysctl_set(
-        self,
-        NMP_SYSCTL_PATHID_ABSOLUTE(
-            nm_utils_sysctl_ip_conf_path(addr_family, buf, ifname, property)),
-        nm_sprintf_buf(s, "%" G_GINT64_FORMAT, value));
+    return nm_platform_sysctl_ip_conf_set(self,
+                                          addr_family,
+                                          ifname,
+                                          property,
+                                          nm_sprintf_buf(s, "%" G_GINT64_FORMAT, value));
 }
 
 int
@@ -1470,6 +1577,73 @@ nm_platform_link_add(NMPlatform            *self,
         ->link_add(self, type, name, parent, address, address_len, mtu, extra_data, out_link);
 }
 
+/**
+ * nm_platform_link_add_batch:
+ * @self: platform instance
+ * @ops: the links to create.
+ * @n_ops: the number of links in @ops.
+ *
+ * Like nm_platform_link_add() for each link in @ops, but the platform
+ * implementation may pipeline the requests instead of waiting for each
+ * response in turn. The result of each operation is returned in its
+ * @result field; look up the created links by name afterwards.
+ *
+ * Bonds are not supported.
+ */
+void
+nm_platform_link_add_batch(NMPlatform *self, NMPlatformLinkAddOp *ops, guint n_ops)
+{
+    char  parent_buf[64];
+    guint n_pending = 0;
+    guint i;
+
+    _CHECK_SELF_VOID(self, klass);
+
+    for (i = 0; i < n_ops; i++) {
+        NMPlatformLinkAddOp *op   = &ops[i];
+        const char          *name = op->name;
+
+        nm_assert(name);
+        nm_assert(op->parent >= 0);
+        nm_assert(op->type != NM_LINK_TYPE_BOND);
+
+        op->result = _link_add_check_existing(self, op->name, op->type, NULL);
+        if (op->result < 0)
+            continue;
+
+        _LOG2D("link: adding link: %s \"%s\"%s%s (batched)",
+               nm_link_type_to_string(op->type),
+               name,
+               op->parent > 0 ? ", parent " : "",
+               op->parent > 0 ? nm_sprintf_buf(parent_buf, "%d", op->parent) : "");
+        n_pending++;
+    }
+
+    if (n_pending == 0)
+        return;
+
+    if (klass->link_add_batch) {
+        klass->link_add_batch(self, ops, n_ops);
+        return;
+    }
+
+    for (i = 0; i < n_ops; i++) {
+        NMPlatformLinkAddOp *op = &ops[i];
+
+        if (op->result != 0)
+            continue;
+        op->result = klass->link_add(self,
+                                     op->type,
+                                     op->name,
+                                     op->parent,
+                                     op->address.len > 0 ? op->address.data : NULL,
+                                     op->address.len,
+                                     0,
+                                     op->extra_data,
+                                     NULL);
+    }
+}
+
 int
 nm_platform_link_change_extra(NMPlatform   *self,
                               NMLinkType    type,
@@ -1755,6 +1929,22 @@ nm_platform_link_refresh(NMPlatform *self, int ifindex)
     return TRUE;
 }
 
+/**
+ * nm_platform_link_refresh_all:
+ * @self: platform instance
+ *
+ * Reload all links in the cache synchronously, with a single
+ * dump request.
+ */
+void
+nm_platform_link_refresh_all(NMPlatform *self)
+{
+    _CHECK_SELF_VOID(self, klass);
+
+    if (klass->link_refresh_all)
+        klass->link_refresh_all(self);
+}
+
 int
 nm_platform_link_get_ifi_flags(NMPlatform *self, int ifindex, guint requested_flags)
 {
@@ -2014,6 +2204,38 @@ nm_platform_link_supports_sriov(NMPlatform *self, int ifindex)
     return klass->link_supports_sriov(self, ifindex);
 }
 
+/**
+ * nm_platform_link_prefetch_probes:
+ * @self: platform instance
+ * @ifindexes: the interfaces to probe
+ * @len: number of entries in @ifindexes
+ *
+ * Query the driver information, permanent address and the carrier detection
+ * and SR-IOV support of many links concurrently. Until nm_platform_link_prefetch_clear()
+ * is called, the corresponding getters return the prefetched results instead
+ * of probing each link on their own. The platform may decide to not prefetch
+ * anything, for example when there are only few links.
+ */
+void
+nm_platform_link_prefetch_probes(NMPlatform *self, const int *ifindexes, guint len)
+{
+    _CHECK_SELF_VOID(self, klass);
+
+    g_return_if_fail(ifindexes || len == 0);
+
+    if (klass->link_prefetch_probes)
+        klass->link_prefetch_probes(self, ifindexes, len);
+}
+
+void
+nm_platform_link_prefetch_clear(NMPlatform *self)
+{
+    _CHECK_SELF_VOID(self, klass);
+
+    if (klass->link_prefetch_clear)
+        klass->link_prefetch_clear(self);
+}
+
 /**
  * nm_platform_link_set_sriov_params:
  * @self: platform instance
@@ -2108,6 +2330,44 @@ nm_platform_link_set_bridge_vlans(NMPlatform                 *self,
     return klass->link_set_bridge_vlans(self, ifindex, on_controller, vlans, num_vlans);
 }
 
+/**
+ * nm_platform_link_delete_bridge_vlans:
+ * @self: the platform instance
+ * @ifindex: the ifindex of the link
+ * @on_controller: whether to delete the VLANs on the bridge controller
+ *   instead of the link itself
+ * @vlans: the VLAN ranges to delete. The flags are ignored.
+ * @num_vlans: the number of VLAN ranges, must be positive
+ *
+ * Unlike nm_platform_link_set_bridge_vlans() with no VLANs, this only
+ * deletes the given VLANs and leaves the others alone.
+ */
+gboolean
+nm_platform_link_delete_bridge_vlans(NMPlatform                 *self,
+                                     int                         ifindex,
+                                     gboolean                    on_controller,
+                                     const NMPlatformBridgeVlan *vlans,
+                                     guint                       num_vlans)
+{
+    guint i;
+    _CHECK_SELF(self, klass, FALSE);
+
+    g_return_val_if_fail(ifindex > 0, FALSE);
+    g_return_val_if_fail(vlans && num_vlans > 0, FALSE);
+
+    if (_LOGD_ENABLED()) {
+        _LOG3D("link: deleting bridge VLANs on %s", on_controller ? "controller" : "self");
+        for (i = 0; i < num_vlans; i++) {
+            char sbuf[NM_UTILS_TO_STRING_BUFFER_SIZE];
+
+            _LOG3D("link:   bridge VLAN %s",
+                   nm_platform_bridge_vlan_to_string(&vlans[i], sbuf, sizeof(sbuf)));
+        }
+    }
+
+    return klass->link_delete_bridge_vlans(self, ifindex, on_controller, vlans, num_vlans);
+}
+
 gboolean
 nm_platform_link_get_bridge_vlans(NMPlatform            *self,
                                   int                    ifindex,
@@ -2210,6 +2470,35 @@ nm_platform_link_set_mtu(NMPlatform *self, int ifindex, guint32 mtu)
     return klass->link_set_mtu(self, ifindex, mtu);
 }
 
+/**
+ * nm_platform_link_set_xdp:
+ * @self: platform instance
+ * @ifindex: Interface index
+ * @prog_fd: the file descriptor of the XDP program, or -1 to detach
+ *   the attached program.
+ * @xdp_flags: the XDP_FLAGS_* for the attach mode.
+ *
+ * Attach or detach an XDP program.
+ *
+ * Returns: 0 on success or a negative error code.
+ */
+int
+nm_platform_link_set_xdp(NMPlatform *self, int ifindex, int prog_fd, guint32 xdp_flags)
+{
+    _CHECK_SELF(self, klass, -NME_BUG);
+
+    g_return_val_if_fail(ifindex > 0, -NME_BUG);
+
+    if (!klass->link_set_xdp)
+        return -NME_PL_OPNOTSUPP;
+
+    if (prog_fd >= 0)
+        _LOG3D("link: attaching XDP program (flags 0x%x)", xdp_flags);
+    else
+        _LOG3D("link: detaching XDP program (flags 0x%x)", xdp_flags);
+    return klass->link_set_xdp(self, ifindex, prog_fd, xdp_flags);
+}
+
 /**
  * nm_platform_link_get_mtu:
  * @self: platform instance
@@ -2270,7 +2559,9 @@ nm_platform_link_change(NMPlatform               *self,
                             NM_PLATFORM_LINK_CHANGE_TX_QUEUE_LENGTH
                                 | NM_PLATFORM_LINK_CHANGE_GSO_MAX_SIZE
                                 | NM_PLATFORM_LINK_CHANGE_GSO_MAX_SEGMENTS
-                                | NM_PLATFORM_LINK_CHANGE_GRO_MAX_SIZE)
+                                | NM_PLATFORM_LINK_CHANGE_GRO_MAX_SIZE
+                                | NM_PLATFORM_LINK_CHANGE_GSO_IPV4_MAX_SIZE
+                                | NM_PLATFORM_LINK_CHANGE_GRO_IPV4_MAX_SIZE)
               || props);
     nm_assert((!!bond_port + !!bridge_port) <= 1);
 
@@ -2285,6 +2576,10 @@ nm_platform_link_change(NMPlatform               *self,
             g_string_append_printf(str, "gso_max_segments %u ", props->gso_max_segments);
         if (flags & NM_PLATFORM_LINK_CHANGE_GRO_MAX_SIZE)
             g_string_append_printf(str, "gro_max_size %u ", props->gro_max_size);
+        if (flags & NM_PLATFORM_LINK_CHANGE_GSO_IPV4_MAX_SIZE)
+            g_string_append_printf(str, "gso_ipv4_max_size %u ", props->gso_ipv4_max_size);
+        if (flags & NM_PLATFORM_LINK_CHANGE_GRO_IPV4_MAX_SIZE)
+            g_string_append_printf(str, "gro_ipv4_max_size %u ", props->gro_ipv4_max_size);
         if (bond_port) {
             nm_assert(bond_port->prio_has || bond_port->prio == 0);
             g_string_append_printf(str,
@@ -2440,6 +2735,51 @@ nm_platform_link_attach_port(NMPlatform *self, int controller, int ifindex)
     return klass->link_attach_port(self, controller, ifindex);
 }
 
+/**
+ * nm_platform_link_attach_port_batch:
+ * @self: platform instance
+ * @ops: the ports to attach
+ * @n_ops: the number of entries in @ops
+ *
+ * Like nm_platform_link_attach_port() for each entry of @ops, but the
+ * requests are pipelined if the platform supports it. Afterwards, the
+ * @result field of each entry is set.
+ */
+void
+nm_platform_link_attach_port_batch(NMPlatform *self, NMPlatformLinkAttachPortOp *ops, guint n_ops)
+{
+    guint i;
+
+    _CHECK_SELF_VOID(self, klass);
+
+    for (i = 0; i < n_ops; i++) {
+        NMPlatformLinkAttachPortOp *op      = &ops[i];
+        const int                   ifindex = op->port;
+
+        nm_assert(op->controller > 0);
+        nm_assert(op->port > 0);
+
+        op->result = 0;
+        _LOG3D("link: enslaving to controller '%s' (batched)",
+               nm_platform_link_get_name(self, op->controller));
+    }
+
+    if (n_ops == 0)
+        return;
+
+    if (klass->link_attach_port_batch) {
+        klass->link_attach_port_batch(self, ops, n_ops);
+        return;
+    }
+
+    for (i = 0; i < n_ops; i++) {
+        NMPlatformLinkAttachPortOp *op = &ops[i];
+
+        if (!klass->link_attach_port(self, op->controller, op->port))
+            op->result = -NME_UNSPEC;
+    }
+}
+
 /**
  * nm_platform_link_release_port:
  * @self: platform instance
@@ -3693,7 +4033,7 @@ nm_platform_ethtool_get_channels(NMPlatform *self, int ifindex, NMEthtoolChannel
     g_return_val_if_fail(ifindex > 0, FALSE);
     g_return_val_if_fail(channels, FALSE);
 
-    return nmp_ethtool_ioctl_get_channels(ifindex, channels);
+    return klass->ethtool_get_channels(self, ifindex, channels);
 }
 
 gboolean
@@ -3704,8 +4044,30 @@ nm_platform_ethtool_set_channels(NMPlatform                   *self,
     _CHECK_SELF_NETNS(self, klass, netns, FALSE);
 
     g_return_val_if_fail(ifindex > 0, FALSE);
+    g_return_val_if_fail(channels, FALSE);
+
+    return klass->ethtool_set_channels(self, ifindex, channels);
+}
+
+NMEthtoolRssState *
+nm_platform_ethtool_get_rss(NMPlatform *self, int ifindex)
+{
+    _CHECK_SELF_NETNS(self, klass, netns, NULL);
+
+    g_return_val_if_fail(ifindex > 0, NULL);
+
+    return klass->ethtool_get_rss(self, ifindex);
+}
+
+gboolean
+nm_platform_ethtool_set_rss(NMPlatform *self, int ifindex, const NMEthtoolRssState *rss)
+{
+    _CHECK_SELF_NETNS(self, klass, netns, FALSE);
+
+    g_return_val_if_fail(ifindex > 0, FALSE);
+    g_return_val_if_fail(rss, FALSE);
 
-    return nmp_ethtool_ioctl_set_channels(ifindex, channels);
+    return klass->ethtool_set_rss(self, ifindex, rss);
 }
 
 gboolean
@@ -4301,6 +4663,145 @@ ip6_address_scope_cmp_descending(gconstpointer p_a, gconstpointer p_b, gpointer
     return ip6_address_scope_cmp_ascending(p_b, p_a, NULL);
 }
 
+/* The number of operations that nm_platform_ip_address_sync() and
+ * nm_platform_ip_route_sync() collect, before passing them on to
+ * nm_platform_object_batch(). */
+#define OBJECT_BATCH_MAX 512u
+
+typedef struct {
+    guint                   len;
+    NMPlatformObjectBatchOp ops[OBJECT_BATCH_MAX];
+
+    /* We keep a reference to the original objects. The stack-initialized
+     * copies in @obj_stacks may alias their extra_nexthops. */
+    const NMPObject *objs[OBJECT_BATCH_MAX];
+    NMPObject        obj_stacks[OBJECT_BATCH_MAX];
+} ObjectBatch;
+
+static NMPObject *
+_object_batch_append(ObjectBatch *batch, const NMPObject *obj, gboolean is_delete, NMPNlmFlags flags)
+{
+    NMPObject *obj_stack;
+    guint      idx;
+
+    nm_assert(batch->len < OBJECT_BATCH_MAX);
+
+    idx = batch->len++;
+
+    batch->objs[idx] = nmp_object_ref(obj);
+
+    obj_stack = &batch->obj_stacks[idx];
+    nmp_object_stackinit(obj_stack, NMP_OBJECT_GET_TYPE(obj), &obj->object);
+    if (NMP_OBJECT_GET_TYPE(obj) == NMP_OBJECT_TYPE_IP4_ROUTE && obj->ip4_route.n_nexthops > 1u) {
+        nm_assert(obj->_ip4_route.extra_nexthops);
+        obj_stack->_ip4_route.extra_nexthops = obj->_ip4_route.extra_nexthops;
+    }
+
+    batch->ops[idx] = (NMPlatformObjectBatchOp) {
+        .obj_stack = obj_stack,
+        .nlm_flags = flags,
+        .is_delete = is_delete,
+    };
+    return obj_stack;
+}
+
+static void
+_address_sync_batch_append_delete(NMPlatform *self, ObjectBatch *batch, const NMPObject *obj)
+{
+    const int ifindex = NMP_OBJECT_CAST_IP_ADDRESS(obj)->ifindex;
+    char      sbuf[NM_UTILS_TO_STRING_BUFFER_SIZE];
+
+    nm_assert(NM_IN_SET(NMP_OBJECT_GET_TYPE(obj),
+                        NMP_OBJECT_TYPE_IP4_ADDRESS,
+                        NMP_OBJECT_TYPE_IP6_ADDRESS));
+
+    _LOG3D("address: deleting IPv%c address %s",
+           nm_utils_addr_family_to_char(NMP_OBJECT_GET_ADDR_FAMILY(obj)),
+           nmp_object_to_string(obj, NMP_OBJECT_TO_STRING_ID, sbuf, sizeof(sbuf)));
+
+    _object_batch_append(batch, obj, TRUE, 0);
+}
+
+static void
+_address_sync_batch_append_add(NMPlatform      *self,
+                               ObjectBatch     *batch,
+                               const NMPObject *obj,
+                               guint32          lifetime,
+                               guint32          preferred,
+                               guint32          ifa_flags)
+{
+    const int  ifindex = NMP_OBJECT_CAST_IP_ADDRESS(obj)->ifindex;
+    char       sbuf[NM_UTILS_TO_STRING_BUFFER_SIZE];
+    NMPObject *obj_stack;
+
+    nm_assert(NM_IN_SET(NMP_OBJECT_GET_TYPE(obj),
+                        NMP_OBJECT_TYPE_IP4_ADDRESS,
+                        NMP_OBJECT_TYPE_IP6_ADDRESS));
+    nm_assert(lifetime > 0);
+    nm_assert(preferred <= lifetime);
+
+    obj_stack = _object_batch_append(batch, obj, FALSE, 0);
+
+    /* For additions, the lifetimes are relative to now. Setting the timestamp
+     * to zero also lets to_string() treat them as such. */
+    obj_stack->ip_address.timestamp   = 0;
+    obj_stack->ip_address.lifetime    = lifetime;
+    obj_stack->ip_address.preferred   = preferred;
+    obj_stack->ip_address.n_ifa_flags = ifa_flags;
+
+    _LOG3D("address: adding or updating IPv%c address: %s",
+           nm_utils_addr_family_to_char(NMP_OBJECT_GET_ADDR_FAMILY(obj)),
+           nmp_object_to_string(obj_stack, NMP_OBJECT_TO_STRING_PUBLIC, sbuf, sizeof(sbuf)));
+
+    if (NMP_OBJECT_GET_TYPE(obj) == NMP_OBJECT_TYPE_IP6_ADDRESS)
+        nm_platform_ip6_dadfailed_set(self, ifindex, &obj_stack->ip6_address.address, FALSE);
+}
+
+static gboolean
+_address_sync_batch_flush(NMPlatform *self, ObjectBatch *batch, GPtrArray **out_addresses_failed)
+{
+    gboolean success = TRUE;
+    guint    i;
+    char     sbuf[NM_UTILS_TO_STRING_BUFFER_SIZE];
+
+    if (batch->len == 0)
+        return TRUE;
+
+    nm_platform_object_batch(self, batch->ops, batch->len);
+
+    for (i = 0; i < batch->len; i++) {
+        NMPlatformObjectBatchOp        *op         = &batch->ops[i];
+        nm_auto_nmpobj const NMPObject *known_obj  = g_steal_pointer(&batch->objs[i]);
+        gs_free char                   *extack_msg = g_steal_pointer(&op->extack_msg);
+        const int                       ifindex    = NMP_OBJECT_CAST_IP_ADDRESS(known_obj)->ifindex;
+
+        if (op->is_delete || op->result == 0) {
+            /* deletions may fail, for example because the address is already removed.
+             * Ignore that. */
+            continue;
+        }
+
+        _LOG3D("address: failure to add IPv%c address: %s: %s%s%s%s",
+               nm_utils_addr_family_to_char(NMP_OBJECT_GET_ADDR_FAMILY(known_obj)),
+               nmp_object_to_string(known_obj, NMP_OBJECT_TO_STRING_PUBLIC, sbuf, sizeof(sbuf)),
+               nm_strerror(op->result),
+               NM_PRINT_FMT_QUOTED(extack_msg, " (", extack_msg, ")", ""));
+
+        success = FALSE;
+
+        if (out_addresses_failed) {
+            if (!*out_addresses_failed) {
+                *out_addresses_failed =
+                    g_ptr_array_new_with_free_func((GDestroyNotify) nmp_object_unref);
+            }
+            g_ptr_array_add(*out_addresses_failed, (gpointer) nmp_object_ref(known_obj));
+        }
+    }
+
+    batch->len = 0;
+    return success;
+}
+
 /**
  * nm_platform_ip_address_sync:
  * @self: platform instance
@@ -4318,11 +4819,16 @@ ip6_address_scope_cmp_descending(gconstpointer p_a, gconstpointer p_b, gpointer
  * @flags: #NMPIPAddressSyncFlags to affect the sync. If "with-noprefixroute"
  *   flag is set, the method will automatically set IFA_F_NOPREFIXROUTE for
  *   all addresses.
+ * @out_addresses_failed: (out) (optional) (nullable): addresses that could
+ *   not be added.
  *
  * A convenience function to synchronize addresses for a specific interface
  * with the least possible disturbance. It simply removes addresses that are
  * not listed and adds addresses that are.
  *
+ * The requests are passed in batches to nm_platform_object_batch(), so
+ * that large address sets don't require one round trip per address.
+ *
  * Returns: %TRUE on success.
  */
 gboolean
@@ -4331,7 +4837,8 @@ nm_platform_ip_address_sync(NMPlatform           *self,
                             int                   ifindex,
                             GPtrArray            *known_addresses,
                             GPtrArray            *addresses_prune,
-                            NMPIPAddressSyncFlags flags)
+                            NMPIPAddressSyncFlags flags,
+                            GPtrArray           **out_addresses_failed)
 {
     gint32                         now     = 0;
     const int                      IS_IPv4 = NM_IS_IPv4(addr_family);
@@ -4340,6 +4847,7 @@ nm_platform_ip_address_sync(NMPlatform           *self,
     gs_unref_hashtable GHashTable *known_addresses_idx  = NULL;
     gs_unref_hashtable GHashTable *plat_addrs_to_delete = NULL;
     gs_unref_ptrarray GPtrArray   *plat_addresses       = NULL;
+    gs_free ObjectBatch           *batch                = NULL;
     gboolean                       success;
     guint                          i_plat;
     guint                          i_know;
@@ -4412,6 +4920,11 @@ nm_platform_ip_address_sync(NMPlatform           *self,
                                    &known_addresses_idx))
         known_addresses = NULL;
 
+    if (nm_g_ptr_array_len(known_addresses) > 0 || nm_g_ptr_array_len(addresses_prune) > 0) {
+        batch      = g_new(ObjectBatch, 1);
+        batch->len = 0;
+    }
+
     if (nm_g_ptr_array_len(addresses_prune) > 0) {
         /* First delete addresses that we should prune (and which are no longer tracked
          * as @known_addresses. */
@@ -4425,11 +4938,12 @@ nm_platform_ip_address_sync(NMPlatform           *self,
             if (nm_g_hash_table_contains(known_addresses_idx, prune_obj))
                 continue;
 
-            nm_platform_ip_address_delete(self,
-                                          addr_family,
-                                          ifindex,
-                                          NMP_OBJECT_CAST_IP_ADDRESS(prune_obj));
+            if (batch->len >= OBJECT_BATCH_MAX)
+                _address_sync_batch_flush(self, batch, NULL);
+
+            _address_sync_batch_append_delete(self, batch, prune_obj);
         }
+        _address_sync_batch_flush(self, batch, NULL);
     }
 
     /* ensure we have the platform cache up to date. */
@@ -4707,13 +5221,17 @@ next_plat:;
 
         plat_obj = nm_platform_ip_address_get(self, addr_family, ifindex, known_address);
 
+        /* Ensure there is room for a delete and an add operation. */
+        if (batch->len + 2u > OBJECT_BATCH_MAX) {
+            if (!_address_sync_batch_flush(self, batch, out_addresses_failed))
+                success = FALSE;
+        }
+
         if (plat_obj && nm_g_hash_table_contains(plat_addrs_to_delete, plat_obj)) {
             /* This address exists, but it had the wrong priority earlier. We
-             * cannot just update it, we need to remove it first. */
-            nm_platform_ip_address_delete(self,
-                                          addr_family,
-                                          ifindex,
-                                          NMP_OBJECT_CAST_IP_ADDRESS(plat_obj));
+             * cannot just update it, we need to remove it first. Kernel
+             * processes the batched requests in order. */
+            _address_sync_batch_append_delete(self, batch, plat_obj);
             plat_obj = NULL;
         }
 
@@ -4733,40 +5251,20 @@ next_plat:;
             continue;
         }
 
-        if (IS_IPv4) {
-            if (!nm_platform_ip4_address_add(
-                    self,
-                    ifindex,
-                    known_address->a4.address,
-                    known_address->a4.plen,
-                    known_address->a4.peer_address,
-                    nm_platform_ip4_broadcast_address_from_addr(&known_address->a4),
-                    lifetime,
-                    preferred,
-                    NM_FLAGS_HAS(flags, NMP_IP_ADDRESS_SYNC_FLAGS_WITH_NOPREFIXROUTE)
-                        ? IFA_F_NOPREFIXROUTE
-                        : 0,
-                    known_address->a4.label,
-                    NULL))
-                success = FALSE;
-        } else {
-            if (!nm_platform_ip6_address_add(
-                    self,
-                    ifindex,
-                    known_address->a6.address,
-                    known_address->a6.plen,
-                    known_address->a6.peer_address,
-                    lifetime,
-                    preferred,
-                    (NM_FLAGS_HAS(flags, NMP_IP_ADDRESS_SYNC_FLAGS_WITH_NOPREFIXROUTE)
-                         ? IFA_F_NOPREFIXROUTE
-                         : 0)
-                        | known_address->a6.n_ifa_flags,
-                    NULL))
-                success = FALSE;
-        }
+        _address_sync_batch_append_add(
+            self,
+            batch,
+            known_obj,
+            lifetime,
+            preferred,
+            (NM_FLAGS_HAS(flags, NMP_IP_ADDRESS_SYNC_FLAGS_WITH_NOPREFIXROUTE) ? IFA_F_NOPREFIXROUTE
+                                                                               : 0)
+                | (IS_IPv4 ? 0u : known_address->a6.n_ifa_flags));
     }
 
+    if (batch && !_address_sync_batch_flush(self, batch, out_addresses_failed))
+        success = FALSE;
+
     return success;
 }
 
@@ -4795,7 +5293,8 @@ nm_platform_ip_address_flush(NMPlatform *self, int addr_family, int ifindex)
                                          ifindex,
                                          NULL,
                                          addresses_prune,
-                                         NMP_IP_ADDRESS_SYNC_FLAGS_NONE))
+                                         NMP_IP_ADDRESS_SYNC_FLAGS_NONE,
+                                         NULL))
             success = FALSE;
     }
     return success;
@@ -5148,13 +5647,154 @@ nm_platform_ip_route_get_prune_list(NMPlatform            *self,
     return routes_prune;
 }
 
-/**
- * nm_platform_ip_route_sync:
- * @self: the #NMPlatform instance.
- * @addr_family: AF_INET or AF_INET6.
- * @ifindex: the @ifindex for which the routes are to be added.
- * @routes: (nullable): a list of routes to configure. Must contain
- *   NMPObject instances of routes, according to @addr_family.
+static void _ip_route_add_prepare(NMPlatform *self, NMPNlmFlags flags, NMPObject *obj_stack);
+
+static void
+_route_sync_batch_append(NMPlatform      *self,
+                         ObjectBatch     *batch,
+                         const NMPObject *obj,
+                         gboolean         is_delete,
+                         NMPNlmFlags      flags)
+{
+    NMPObject *obj_stack;
+
+    nm_assert(
+        NM_IN_SET(NMP_OBJECT_GET_TYPE(obj), NMP_OBJECT_TYPE_IP4_ROUTE, NMP_OBJECT_TYPE_IP6_ROUTE));
+
+    obj_stack = _object_batch_append(batch, obj, is_delete, flags);
+
+    if (is_delete) {
+        const int ifindex = obj->ip_route.ifindex;
+        char      sbuf[NM_UTILS_TO_STRING_BUFFER_SIZE];
+
+        _LOG3D("%s: delete %s",
+               NMP_OBJECT_GET_CLASS(obj)->obj_type_name,
+               nmp_object_to_string(obj, NMP_OBJECT_TO_STRING_PUBLIC, sbuf, sizeof(sbuf)));
+    } else
+        _ip_route_add_prepare(self, flags, obj_stack);
+}
+
+static gboolean
+_route_sync_can_replace(NMPlatform *self, const NMPObject *plat_o)
+{
+    const NMDedupMultiHeadEntry *head_entry;
+
+    /* With NLM_F_REPLACE, kernel replaces the first route with the same
+     * WEAK_ID. That is only @plat_o, if there is no other route with the
+     * same WEAK_ID. This also excludes IPv6 routes that kernel merged into
+     * one multipath route, where the replace would affect all next hops. */
+    head_entry = nm_platform_lookup_all(self, NMP_CACHE_ID_TYPE_ROUTES_BY_WEAK_ID, plat_o);
+    return head_entry && head_entry->len == 1;
+}
+
+static gboolean
+_route_sync_batch_flush(NMPlatform                  *self,
+                        const NMPlatformVTableRoute *vt,
+                        ObjectBatch                 *batch,
+                        GPtrArray                  **out_routes_failed)
+{
+    const NMDedupMultiEntry *plat_entry;
+    gboolean                 success = TRUE;
+    guint                    i;
+    char                     sbuf1[NM_UTILS_TO_STRING_BUFFER_SIZE];
+    char                     sbuf2[NM_UTILS_TO_STRING_BUFFER_SIZE];
+
+    if (batch->len == 0)
+        return TRUE;
+
+    nm_platform_object_batch(self, batch->ops, batch->len);
+
+    for (i = 0; i < batch->len; i++) {
+        NMPlatformObjectBatchOp        *op         = &batch->ops[i];
+        nm_auto_nmpobj const NMPObject *conf_o     = g_steal_pointer(&batch->objs[i]);
+        gs_free char                   *extack_msg = g_steal_pointer(&op->extack_msg);
+        int                             r          = op->result;
+        const int                       ifindex    = conf_o->ip_route.ifindex;
+
+        if (op->is_delete) {
+            /* ignore error. */
+            continue;
+        }
+
+        if (r != 0 && NM_FLAGS_HAS(op->nlm_flags, NMP_NLM_FLAG_F_REPLACE)) {
+            /* Replacing the route failed, and kernel left the existing one
+             * alone. Fall back to deleting and adding it again, like we would
+             * have done without NLM_F_REPLACE. */
+            _LOG3D("route-sync: replacing route %s failed (%s), delete and add it instead",
+                   nmp_object_to_string(conf_o, NMP_OBJECT_TO_STRING_PUBLIC, sbuf1, sizeof(sbuf1)),
+                   nm_strerror(r));
+            plat_entry = nm_platform_lookup_entry(self, NMP_CACHE_ID_TYPE_OBJECT_TYPE, conf_o);
+            if (plat_entry)
+                nm_platform_object_delete(self, plat_entry->obj);
+            nm_clear_g_free(&extack_msg);
+            r = nm_platform_ip_route_add(self,
+                                         NMP_NLM_FLAG_APPEND
+                                             | NMP_NLM_FLAG_SUPPRESS_NETLINK_FAILURE,
+                                         conf_o,
+                                         &extack_msg);
+        }
+
+        if (r == 0) {
+            /* success */
+        } else if (r == -EEXIST) {
+            /* Don't fail for EEXIST. It's not clear that the existing route
+             * is identical to the one that we were about to add. However,
+             * above we should have deleted conflicting (non-identical) routes. */
+            if (_LOGD_ENABLED()) {
+                plat_entry = nm_platform_lookup_entry(self, NMP_CACHE_ID_TYPE_OBJECT_TYPE, conf_o);
+                if (!plat_entry) {
+                    _LOG3D("route-sync: adding route %s failed with EEXIST, however we "
+                           "cannot find such a route",
+                           nmp_object_to_string(conf_o,
+                                                NMP_OBJECT_TO_STRING_PUBLIC,
+                                                sbuf1,
+                                                sizeof(sbuf1)));
+                } else if (vt->route_cmp(NMP_OBJECT_CAST_IPX_ROUTE(conf_o),
+                                         NMP_OBJECT_CAST_IPX_ROUTE(plat_entry->obj),
+                                         NM_PLATFORM_IP_ROUTE_CMP_TYPE_SEMANTICALLY)
+                           != 0) {
+                    _LOG3D("route-sync: adding route %s failed due to existing "
+                           "(different!) route %s",
+                           nmp_object_to_string(conf_o,
+                                                NMP_OBJECT_TO_STRING_PUBLIC,
+                                                sbuf1,
+                                                sizeof(sbuf1)),
+                           nmp_object_to_string(plat_entry->obj,
+                                                NMP_OBJECT_TO_STRING_PUBLIC,
+                                                sbuf2,
+                                                sizeof(sbuf2)));
+                }
+            }
+        } else {
+            _LOG3D("route-sync: failure to add IPv%c route: %s: %s%s%s%s",
+                   vt->is_ip4 ? '4' : '6',
+                   nmp_object_to_string(conf_o, NMP_OBJECT_TO_STRING_PUBLIC, sbuf1, sizeof(sbuf1)),
+                   nm_strerror(r),
+                   NM_PRINT_FMT_QUOTED(extack_msg, " (", extack_msg, ")", ""));
+
+            success = FALSE;
+
+            if (out_routes_failed) {
+                if (!*out_routes_failed) {
+                    *out_routes_failed =
+                        g_ptr_array_new_with_free_func((GDestroyNotify) nmp_object_unref);
+                }
+                g_ptr_array_add(*out_routes_failed, (gpointer) nmp_object_ref(conf_o));
+            }
+        }
+    }
+
+    batch->len = 0;
+    return success;
+}
+
+/**
+ * nm_platform_ip_route_sync:
+ * @self: the #NMPlatform instance.
+ * @addr_family: AF_INET or AF_INET6.
+ * @ifindex: the @ifindex for which the routes are to be added.
+ * @routes: (nullable): a list of routes to configure. Must contain
+ *   NMPObject instances of routes, according to @addr_family.
  * @routes_prune: (nullable): the list of routes to delete.
  *   If platform has such a route configured, it will be deleted
  *   at the end of the operation. Note that if @routes contains
@@ -5163,6 +5803,14 @@ nm_platform_ip_route_get_prune_list(NMPlatform            *self,
  * @out_routes_failed: (out) (optional) (nullable): routes that could
  *   not be synced/added.
  *
+ * The necessary changes are collected and passed in batches to
+ * nm_platform_object_batch(), which allows the platform to pipeline
+ * the netlink requests. A configured route with the same
+ * %NM_PLATFORM_IP_ROUTE_CMP_TYPE_ID but different attributes (like the
+ * MTU of an IPv6 route) is replaced with NLM_F_REPLACE, if kernel
+ * would replace exactly that route. Otherwise, it is deleted and added
+ * again.
+ *
  * Returns: %TRUE on success.
  */
 gboolean
@@ -5176,24 +5824,26 @@ nm_platform_ip_route_sync(NMPlatform *self,
     const int                      IS_IPv4 = NM_IS_IPv4(addr_family);
     const NMPlatformVTableRoute   *vt;
     gs_unref_hashtable GHashTable *routes_idx = NULL;
+    gs_free ObjectBatch           *batch      = NULL;
     const NMPObject               *conf_o;
     const NMDedupMultiEntry       *plat_entry;
     guint                          i;
     int                            i_type;
     gboolean                       success = TRUE;
     char                           sbuf1[NM_UTILS_TO_STRING_BUFFER_SIZE];
-    char                           sbuf2[NM_UTILS_TO_STRING_BUFFER_SIZE];
 
     nm_assert(NM_IS_PLATFORM(self));
     nm_assert(ifindex > 0);
 
     vt = &nm_platform_vtable_route.vx[IS_IPv4];
 
+    if ((routes && routes->len > 0) || (routes_prune && routes_prune->len > 0)) {
+        batch      = g_new(ObjectBatch, 1);
+        batch->len = 0;
+    }
+
     for (i_type = 0; routes && i_type < 2; i_type++) {
         for (i = 0; i < routes->len; i++) {
-            gs_free char *extack_msg = NULL;
-            int           r;
-
             conf_o = routes->pdata[i];
 
             /* User space cannot add IPv6 routes with metric 0. However, kernel can, and we might track such
@@ -5212,7 +5862,9 @@ nm_platform_ip_route_sync(NMPlatform *self,
                 || (i_type == 1 && VTABLE_IS_DEVICE_ROUTE(vt, conf_o))) {
                 /* we add routes in two runs over @i_type.
                  *
-                 * First device routes, then gateway routes. */
+                 * First device routes, then gateway routes. Kernel processes
+                 * the batched requests in order, so the device routes are
+                 * configured before the gateway routes that need them. */
                 continue;
             }
 
@@ -5229,6 +5881,12 @@ nm_platform_ip_route_sync(NMPlatform *self,
                 continue;
             }
 
+            /* Ensure there is room for a delete and an add operation. */
+            if (batch->len + 2u > OBJECT_BATCH_MAX) {
+                if (!_route_sync_batch_flush(self, vt, batch, out_routes_failed))
+                    success = FALSE;
+            }
+
             plat_entry = nm_platform_lookup_entry(self, NMP_CACHE_ID_TYPE_OBJECT_TYPE, conf_o);
             if (plat_entry) {
                 const NMPObject *plat_o;
@@ -5241,68 +5899,28 @@ nm_platform_ip_route_sync(NMPlatform *self,
                     == 0)
                     continue;
 
-                /* we need to replace the existing route with a (slightly) different
-                 * one. Delete it first. */
-                if (!nm_platform_object_delete(self, plat_o)) {
-                    /* ignore error. */
-                }
-            }
-
-            r = nm_platform_ip_route_add(self,
-                                         NMP_NLM_FLAG_APPEND
-                                             | NMP_NLM_FLAG_SUPPRESS_NETLINK_FAILURE,
-                                         conf_o,
-                                         &extack_msg);
-            if (r == 0) {
-                /* success */
-            } else if (r == -EEXIST) {
-                /* Don't fail for EEXIST. It's not clear that the existing route
-                 * is identical to the one that we were about to add. However,
-                 * above we should have deleted conflicting (non-identical) routes. */
-                if (_LOGD_ENABLED()) {
-                    plat_entry =
-                        nm_platform_lookup_entry(self, NMP_CACHE_ID_TYPE_OBJECT_TYPE, conf_o);
-                    if (!plat_entry) {
-                        _LOG3D("route-sync: adding route %s failed with EEXIST, however we "
-                               "cannot find such a route",
-                               nmp_object_to_string(conf_o,
-                                                    NMP_OBJECT_TO_STRING_PUBLIC,
-                                                    sbuf1,
-                                                    sizeof(sbuf1)));
-                    } else if (vt->route_cmp(NMP_OBJECT_CAST_IPX_ROUTE(conf_o),
-                                             NMP_OBJECT_CAST_IPX_ROUTE(plat_entry->obj),
-                                             NM_PLATFORM_IP_ROUTE_CMP_TYPE_SEMANTICALLY)
-                               != 0) {
-                        _LOG3D("route-sync: adding route %s failed due to existing "
-                               "(different!) route %s",
-                               nmp_object_to_string(conf_o,
-                                                    NMP_OBJECT_TO_STRING_PUBLIC,
-                                                    sbuf1,
-                                                    sizeof(sbuf1)),
-                               nmp_object_to_string(plat_entry->obj,
-                                                    NMP_OBJECT_TO_STRING_PUBLIC,
-                                                    sbuf2,
-                                                    sizeof(sbuf2)));
-                    }
+                if (_route_sync_can_replace(self, plat_o)) {
+                    /* we need to replace the existing route with a (slightly) different
+                     * one. Do that atomically, so that there is no moment without
+                     * the route. */
+                    _route_sync_batch_append(self,
+                                             batch,
+                                             conf_o,
+                                             FALSE,
+                                             NMP_NLM_FLAG_REPLACE
+                                                 | NMP_NLM_FLAG_SUPPRESS_NETLINK_FAILURE);
+                    continue;
                 }
-            } else {
-                _LOG3D(
-                    "route-sync: failure to add IPv%c route: %s: %s%s%s%s",
-                    vt->is_ip4 ? '4' : '6',
-                    nmp_object_to_string(conf_o, NMP_OBJECT_TO_STRING_PUBLIC, sbuf1, sizeof(sbuf1)),
-                    nm_strerror(r),
-                    NM_PRINT_FMT_QUOTED(extack_msg, " (", extack_msg, ")", ""));
 
-                success = FALSE;
-
-                if (out_routes_failed) {
-                    if (!*out_routes_failed) {
-                        *out_routes_failed =
-                            g_ptr_array_new_with_free_func((GDestroyNotify) nmp_object_unref);
-                    }
-                    g_ptr_array_add(*out_routes_failed, (gpointer) nmp_object_ref(conf_o));
-                }
+                /* kernel would not replace the right route. Delete it first. */
+                _route_sync_batch_append(self, batch, plat_o, TRUE, 0);
             }
+
+            _route_sync_batch_append(self,
+                                     batch,
+                                     conf_o,
+                                     FALSE,
+                                     NMP_NLM_FLAG_APPEND | NMP_NLM_FLAG_SUPPRESS_NETLINK_FAILURE);
         }
     }
 
@@ -5323,12 +5941,20 @@ nm_platform_ip_route_sync(NMPlatform *self,
             if (!nm_platform_lookup_entry(self, NMP_CACHE_ID_TYPE_OBJECT_TYPE, prune_o))
                 continue;
 
-            if (!nm_platform_object_delete(self, prune_o)) {
-                /* ignore error... */
+            if (batch->len >= OBJECT_BATCH_MAX) {
+                if (!_route_sync_batch_flush(self, vt, batch, out_routes_failed))
+                    success = FALSE;
             }
+
+            _route_sync_batch_append(self, batch, prune_o, TRUE, 0);
         }
     }
 
+    if (batch) {
+        if (!_route_sync_batch_flush(self, vt, batch, out_routes_failed))
+            success = FALSE;
+    }
+
     return success;
 }
 
@@ -5509,14 +6135,12 @@ nm_platform_ip_route_normalize(int addr_family, NMPlatformIPRoute *route)
     }
 }
 
-static int
-_ip_route_add(NMPlatform *self, NMPNlmFlags flags, NMPObject *obj_stack, char **out_extack_msg)
+static void
+_ip_route_add_prepare(NMPlatform *self, NMPNlmFlags flags, NMPObject *obj_stack)
 {
     char sbuf[NM_UTILS_TO_STRING_BUFFER_SIZE];
     int  ifindex;
 
-    _CHECK_SELF(self, klass, -NME_BUG);
-
     /* The caller already ensures that this is a stack allocated copy, that
      * - stays alive for the duration of the call.
      * - that the ip_route_add() implementation is allowed to modify.
@@ -5526,7 +6150,6 @@ _ip_route_add(NMPlatform *self, NMPNlmFlags flags, NMPObject *obj_stack, char **
     nm_assert(NM_IN_SET(NMP_OBJECT_GET_TYPE(obj_stack),
                         NMP_OBJECT_TYPE_IP4_ROUTE,
                         NMP_OBJECT_TYPE_IP6_ROUTE));
-    nm_assert(!out_extack_msg || !*out_extack_msg);
 
     nm_assert(NMP_OBJECT_GET_TYPE(obj_stack) != NMP_OBJECT_TYPE_IP4_ROUTE
               || obj_stack->ip4_route.n_nexthops <= 1u || obj_stack->_ip4_route.extra_nexthops);
@@ -5540,6 +6163,16 @@ _ip_route_add(NMPlatform *self, NMPNlmFlags flags, NMPObject *obj_stack, char **
            _nmp_nlm_flag_to_string(flags & NMP_NLM_FLAG_FMASK),
            nm_utils_addr_family_to_char(NMP_OBJECT_GET_ADDR_FAMILY(obj_stack)),
            nmp_object_to_string(obj_stack, NMP_OBJECT_TO_STRING_PUBLIC, sbuf, sizeof(sbuf)));
+}
+
+static int
+_ip_route_add(NMPlatform *self, NMPNlmFlags flags, NMPObject *obj_stack, char **out_extack_msg)
+{
+    _CHECK_SELF(self, klass, -NME_BUG);
+
+    nm_assert(!out_extack_msg || !*out_extack_msg);
+
+    _ip_route_add_prepare(self, flags, obj_stack);
 
     /* At this point, we pass "obj_stack" to the klass->ip_route_add() implementation.
      * The callee can rely on:
@@ -5650,6 +6283,315 @@ nm_platform_object_delete(NMPlatform *self, const NMPObject *obj)
     return klass->object_delete(self, obj);
 }
 
+/**
+ * nm_platform_object_batch:
+ * @self: the #NMPlatform instance.
+ * @ops: the operations to perform, in order.
+ * @n_ops: the number of operations in @ops.
+ *
+ * Adds or deletes the objects from @ops. Unlike calling nm_platform_ip_route_add()
+ * and nm_platform_object_delete() for each object, the platform implementation
+ * may pipeline the requests, so that many operations only cost a few round trips
+ * to kernel. The operations are still processed by kernel in order.
+ *
+ * Currently only IPv4 and IPv6 addresses, routes, routing rules and neighbor
+ * entries are supported. Neighbor entries are only supported by implementations
+ * of the object_batch() virtual function.
+ * Routes that are to be added must already be normalized with
+ * nm_platform_ip_route_normalize().
+ * The outcome of each operation is returned in its @result and @extack_msg
+ * fields.
+ */
+void
+nm_platform_object_batch(NMPlatform *self, NMPlatformObjectBatchOp *ops, guint n_ops)
+{
+    guint i;
+
+    _CHECK_SELF_VOID(self, klass);
+
+    if (n_ops == 0)
+        return;
+
+    for (i = 0; i < n_ops; i++) {
+        nm_assert(NM_IN_SET(NMP_OBJECT_GET_TYPE(ops[i].obj_stack),
+                            NMP_OBJECT_TYPE_IP4_ADDRESS,
+                            NMP_OBJECT_TYPE_IP6_ADDRESS,
+                            NMP_OBJECT_TYPE_IP4_ROUTE,
+                            NMP_OBJECT_TYPE_IP6_ROUTE,
+                            NMP_OBJECT_TYPE_ROUTING_RULE,
+                            NMP_OBJECT_TYPE_NEIGH));
+        nm_assert(NMP_OBJECT_IS_STACKINIT(ops[i].obj_stack));
+        nm_assert(ops[i].result == 0);
+        nm_assert(!ops[i].extack_msg);
+    }
+
+    if (klass->object_batch) {
+        klass->object_batch(self, ops, n_ops);
+        return;
+    }
+
+    for (i = 0; i < n_ops; i++) {
+        NMPlatformObjectBatchOp *op  = &ops[i];
+        NMPObject               *obj = op->obj_stack;
+        gboolean                 ok;
+
+        switch (NMP_OBJECT_GET_TYPE(obj)) {
+        case NMP_OBJECT_TYPE_IP4_ADDRESS:
+            if (op->is_delete) {
+                ok = klass->ip4_address_delete(self,
+                                               obj->ip4_address.ifindex,
+                                               obj->ip4_address.address,
+                                               obj->ip4_address.plen,
+                                               obj->ip4_address.peer_address);
+            } else {
+                ok = klass->ip4_address_add(
+                    self,
+                    obj->ip4_address.ifindex,
+                    obj->ip4_address.address,
+                    obj->ip4_address.plen,
+                    obj->ip4_address.peer_address,
+                    nm_platform_ip4_broadcast_address_from_addr(&obj->ip4_address),
+                    obj->ip4_address.lifetime,
+                    obj->ip4_address.preferred,
+                    obj->ip4_address.n_ifa_flags,
+                    obj->ip4_address.label,
+                    &op->extack_msg);
+            }
+            op->result = ok ? 0 : -NME_UNSPEC;
+            break;
+        case NMP_OBJECT_TYPE_IP6_ADDRESS:
+            if (op->is_delete) {
+                ok = klass->ip6_address_delete(self,
+                                               obj->ip6_address.ifindex,
+                                               obj->ip6_address.address,
+                                               obj->ip6_address.plen);
+            } else {
+                ok = klass->ip6_address_add(self,
+                                            obj->ip6_address.ifindex,
+                                            obj->ip6_address.address,
+                                            obj->ip6_address.plen,
+                                            obj->ip6_address.peer_address,
+                                            obj->ip6_address.lifetime,
+                                            obj->ip6_address.preferred,
+                                            obj->ip6_address.n_ifa_flags,
+                                            &op->extack_msg);
+            }
+            op->result = ok ? 0 : -NME_UNSPEC;
+            break;
+        case NMP_OBJECT_TYPE_ROUTING_RULE:
+            if (op->is_delete)
+                op->result = klass->object_delete(self, obj) ? 0 : -NME_UNSPEC;
+            else {
+                op->result = klass->routing_rule_add(self,
+                                                     op->nlm_flags,
+                                                     NMP_OBJECT_CAST_ROUTING_RULE(obj));
+            }
+            break;
+        case NMP_OBJECT_TYPE_NEIGH:
+            op->result = -NME_PL_OPNOTSUPP;
+            break;
+        default:
+            if (op->is_delete)
+                op->result = klass->object_delete(self, obj) ? 0 : -NME_UNSPEC;
+            else
+                op->result = klass->ip_route_add(self, op->nlm_flags, obj, &op->extack_msg);
+            break;
+        }
+    }
+}
+
+/*****************************************************************************/
+
+/**
+ * nm_platform_ip_route_set_tracked_tables:
+ * @self: the #NMPlatform instance.
+ * @tables: (nullable): the routing tables to track.
+ * @n_tables: the number of tables in @tables.
+ *
+ * By default, the platform cache tracks routes from all routing tables. With
+ * full routing tables of routing daemons (e.g. BGP) in the kernel, that is
+ * expensive. Limit the routes that are dumped and cached to the
+ * tables in @tables. The main and local tables are always tracked.
+ * Pass zero @n_tables to track all tables again.
+ *
+ * Routes that NetworkManager configures in other tables are no longer
+ * visible in the cache.
+ */
+void
+nm_platform_ip_route_set_tracked_tables(NMPlatform    *self,
+                                        const guint32 *tables,
+                                        guint          n_tables)
+{
+    _CHECK_SELF_VOID(self, klass);
+
+    nm_assert(tables || n_tables == 0);
+
+    if (!klass->ip_route_set_tracked_tables)
+        return;
+
+    klass->ip_route_set_tracked_tables(self, tables, n_tables);
+}
+
+/**
+ * nm_platform_netlink_set_rcvbuf_max:
+ * @self: the #NMPlatform instance.
+ * @rcvbuf_max: the maximum receive buffer size in bytes, or zero
+ *   for the default.
+ *
+ * When the netlink socket overflows, the platform cache needs to be
+ * resynchronized. To avoid that from happening over and over, the receive
+ * buffer is doubled after each overrun, up to @rcvbuf_max.
+ */
+void
+nm_platform_netlink_set_rcvbuf_max(NMPlatform *self, int rcvbuf_max)
+{
+    _CHECK_SELF_VOID(self, klass);
+
+    if (!klass->netlink_set_rcvbuf_max)
+        return;
+
+    klass->netlink_set_rcvbuf_max(self, rcvbuf_max);
+}
+
+/*****************************************************************************/
+
+static void
+_trace_entry_clear(NMPlatformTraceEntry *entry)
+{
+    nm_clear_nmp_object(&entry->obj_old);
+    nm_clear_nmp_object(&entry->obj_new);
+}
+
+/**
+ * nm_platform_trace_set_size:
+ * @self: the #NMPlatform instance.
+ * @size: the number of entries in the trace buffer, or zero to
+ *   disable tracing.
+ *
+ * The trace buffer is a flight recorder for changes to the platform cache.
+ * Contrary to trace logging, recording an entry only takes a reference on the
+ * affected objects. They only get formatted when the buffer gets dumped with
+ * nm_platform_trace_dump(). Once the buffer is full, the oldest entries get
+ * overwritten.
+ *
+ * Changing the size drops all recorded entries.
+ */
+void
+nm_platform_trace_set_size(NMPlatform *self, guint size)
+{
+    NMPlatformPrivate *priv;
+    guint              i;
+
+    g_return_if_fail(NM_IS_PLATFORM(self));
+
+    priv = NM_PLATFORM_GET_PRIVATE(self);
+
+    if (size == priv->trace.size)
+        return;
+
+    for (i = 0; i < priv->trace.size; i++)
+        _trace_entry_clear(&priv->trace.buf[i]);
+    nm_clear_g_free(&priv->trace.buf);
+
+    priv->trace.size  = size;
+    priv->trace.next  = 0;
+    priv->trace.total = 0;
+    if (size > 0)
+        priv->trace.buf = g_new0(NMPlatformTraceEntry, size);
+}
+
+/**
+ * nm_platform_trace_record:
+ * @self: the #NMPlatform instance.
+ * @what: a static string describing the event.
+ * @change_type: the kind of the change.
+ * @obj_old: (nullable): the object before the change.
+ * @obj_new: (nullable): the object after the change.
+ *
+ * Records an entry in the trace buffer. This does nothing, unless
+ * the trace buffer was enabled with nm_platform_trace_set_size().
+ */
+void
+nm_platform_trace_record(NMPlatform                *self,
+                         const char                *what,
+                         NMPlatformSignalChangeType change_type,
+                         const NMPObject           *obj_old,
+                         const NMPObject           *obj_new)
+{
+    NMPlatformPrivate    *priv = NM_PLATFORM_GET_PRIVATE(self);
+    NMPlatformTraceEntry *entry;
+
+    if (G_LIKELY(priv->trace.size == 0))
+        return;
+
+    entry = &priv->trace.buf[priv->trace.next];
+    _trace_entry_clear(entry);
+    *entry = (NMPlatformTraceEntry){
+        .timestamp_nsec = nm_utils_get_monotonic_timestamp_nsec(),
+        .what           = what,
+        .obj_old        = nmp_object_ref(obj_old),
+        .obj_new        = nmp_object_ref(obj_new),
+        .change_type    = change_type,
+    };
+
+    priv->trace.next = (priv->trace.next + 1u) % priv->trace.size;
+    priv->trace.total++;
+}
+
+/**
+ * nm_platform_trace_dump:
+ * @self: the #NMPlatform instance.
+ *
+ * Logs all entries of the trace buffer, from the oldest to the newest.
+ * The entries are kept, so that a later dump shows them again.
+ */
+void
+nm_platform_trace_dump(NMPlatform *self)
+{
+    NMPlatformPrivate *priv;
+    guint              n;
+    guint              i;
+
+    g_return_if_fail(NM_IS_PLATFORM(self));
+
+    priv = NM_PLATFORM_GET_PRIVATE(self);
+
+    if (priv->trace.size == 0) {
+        _LOGI("trace: tracing is disabled");
+        return;
+    }
+
+    n = NM_MIN(priv->trace.total, (guint64) priv->trace.size);
+
+    _LOGI("trace: dump %u of %" G_GUINT64_FORMAT " recorded entries", n, priv->trace.total);
+
+    for (i = 0; i < n; i++) {
+        const NMPlatformTraceEntry *entry;
+        char                        sbuf_old[NM_UTILS_TO_STRING_BUFFER_SIZE];
+        char                        sbuf_new[NM_UTILS_TO_STRING_BUFFER_SIZE];
+
+        entry = &priv->trace.buf[(priv->trace.next + priv->trace.size - n + i) % priv->trace.size];
+
+        _LOGI("trace[%u]: %" G_GINT64_FORMAT ".%09" G_GINT64_FORMAT " %s-%s: %s%s%s",
+              i,
+              entry->timestamp_nsec / NM_UTILS_NSEC_PER_SEC,
+              entry->timestamp_nsec % NM_UTILS_NSEC_PER_SEC,
+              entry->what,
+              nm_platform_signal_change_type_to_string(entry->change_type),
+              entry->obj_old ? nmp_object_to_string(entry->obj_old,
+                                                    NMP_OBJECT_TO_STRING_ALL,
+                                                    sbuf_old,
+                                                    sizeof(sbuf_old))
+                             : "",
+              entry->obj_old && entry->obj_new ? " -> " : "",
+              entry->obj_new ? nmp_object_to_string(entry->obj_new,
+                                                    NMP_OBJECT_TO_STRING_ALL,
+                                                    sbuf_new,
+                                                    sizeof(sbuf_new))
+                             : "");
+    }
+}
+
 /*****************************************************************************/
 
 int
@@ -5996,6 +6938,57 @@ nm_platform_routing_rule_add(NMPlatform                  *self,
 
 /*****************************************************************************/
 
+/**
+ * nm_platform_ip_nexthop_add:
+ * @self: platform instance
+ * @flags: flags for the netlink request, for example %NMP_NLM_FLAG_REPLACE
+ *   to update an existing nexthop object.
+ * @nexthop: the nexthop object or nexthop group to add.
+ *
+ * Nexthop objects are not tracked in the platform cache. Replacing a nexthop
+ * object affects all routes that refer to it via their nexthop ID.
+ *
+ * Returns: 0 on success or a negative error code.
+ */
+int
+nm_platform_ip_nexthop_add(NMPlatform *self, NMPNlmFlags flags, const NMPlatformNexthop *nexthop)
+{
+    _CHECK_SELF(self, klass, -NME_BUG);
+
+    g_return_val_if_fail(nexthop, -NME_BUG);
+    g_return_val_if_fail(nexthop->id > 0, -NME_BUG);
+    g_return_val_if_fail(nexthop->n_group > 0 || NM_IN_SET(nexthop->addr_family, AF_INET, AF_INET6),
+                         -NME_BUG);
+
+    if (!klass->ip_nexthop_add)
+        return -NME_PL_OPNOTSUPP;
+
+    if (nexthop->n_group > 0) {
+        _LOGD("nexthop: adding or updating group %u with %u members",
+              nexthop->id,
+              nexthop->n_group);
+    } else {
+        _LOGD("nexthop: adding or updating nexthop %u (ifindex %d)",
+              nexthop->id,
+              nexthop->ifindex);
+    }
+    return klass->ip_nexthop_add(self, flags, nexthop);
+}
+
+int
+nm_platform_ip_nexthop_delete(NMPlatform *self, guint32 id)
+{
+    _CHECK_SELF(self, klass, -NME_BUG);
+
+    g_return_val_if_fail(id > 0, -NME_BUG);
+
+    if (!klass->ip_nexthop_delete)
+        return -NME_PL_OPNOTSUPP;
+
+    _LOGD("nexthop: deleting nexthop %u", id);
+    return klass->ip_nexthop_delete(self, id);
+}
+
 int
 nm_platform_qdisc_add(NMPlatform *self, NMPNlmFlags flags, const NMPlatformQdisc *qdisc)
 {
@@ -6046,6 +7039,60 @@ nm_platform_tfilter_delete(NMPlatform *self, int ifindex, guint32 parent, gboole
     return klass->tfilter_delete(self, ifindex, parent, log_error);
 }
 
+static gboolean
+_tc_sync_is_unchanged(NMPlatform *self, int ifindex, NMPObjectType obj_type, GPtrArray *known)
+{
+    const NMDedupMultiHeadEntry *head_entry;
+    NMDedupMultiIter             iter;
+    const NMPObject             *o;
+    guint                        n_known  = known ? known->len : 0u;
+    guint                        n_cached = 0;
+    guint                        i;
+
+    /* Check whether the objects in the cache are exactly those that we
+     * are about to configure. This requires the tc cache.
+     *
+     * Qdiscs without handle are the default qdiscs of the kernel. They
+     * are what remains after deleting all other qdiscs. */
+
+    head_entry = nm_platform_lookup_object(self, obj_type, ifindex);
+    nmp_cache_iter_for_each (&iter, head_entry, &o) {
+        if (obj_type == NMP_OBJECT_TYPE_QDISC && NMP_OBJECT_CAST_QDISC(o)->handle == TC_H_UNSPEC)
+            continue;
+        n_cached++;
+    }
+    if (n_cached != n_known)
+        return FALSE;
+
+    for (i = 0; i < n_known; i++) {
+        const NMPObject *o_known = known->pdata[i];
+        gboolean         found   = FALSE;
+
+        nmp_cache_iter_for_each (&iter, head_entry, &o) {
+            if (obj_type == NMP_OBJECT_TYPE_QDISC) {
+                const NMPlatformQdisc *q = NMP_OBJECT_CAST_QDISC(o_known);
+
+                if (NMP_OBJECT_CAST_QDISC(o)->handle == TC_H_UNSPEC)
+                    continue;
+                found = (nm_platform_qdisc_cmp(q,
+                                               NMP_OBJECT_CAST_QDISC(o),
+                                               q->handle != TC_H_UNSPEC)
+                         == 0);
+            } else {
+                found = (nm_platform_tfilter_cmp(NMP_OBJECT_CAST_TFILTER(o_known),
+                                                 NMP_OBJECT_CAST_TFILTER(o))
+                         == 0);
+            }
+            if (found)
+                break;
+        }
+        if (!found)
+            return FALSE;
+    }
+
+    return TRUE;
+}
+
 /**
  * nm_platform_tc_sync:
  * @self: the #NMPlatform instance
@@ -6060,6 +7107,11 @@ nm_platform_tfilter_delete(NMPlatform *self, int ifindex, guint32 parent, gboole
  * NMPlatformTfilter instances which "kind" string have a limited
  * lifetime.
  *
+ * If the platform caches qdiscs and tfilters, objects that are
+ * already configured as requested are left alone. Otherwise, all
+ * existing qdiscs and tfilters are removed and the requested ones
+ * are added.
+ *
  * Returns: %TRUE on success.
  */
 gboolean
@@ -6074,6 +7126,40 @@ nm_platform_tc_sync(NMPlatform *self,
     nm_assert(NM_IS_PLATFORM(self));
     nm_assert(ifindex > 0);
 
+    if (nm_platform_get_cache_tc(self)
+        && _tc_sync_is_unchanged(self, ifindex, NMP_OBJECT_TYPE_QDISC, known_qdiscs)) {
+        gs_unref_array GArray *parents = NULL;
+        NMDedupMultiIter       iter;
+        const NMPObject       *o;
+
+        if (_tc_sync_is_unchanged(self, ifindex, NMP_OBJECT_TYPE_TFILTER, known_tfilters)) {
+            _LOG3D("tc: qdiscs and tfilters are already configured");
+            return TRUE;
+        }
+
+        /* The qdiscs are fine. Don't replace them (which would drop the
+         * queued packets), only reconfigure the tfilters. */
+        _LOG3D("tc: qdiscs are already configured, replace tfilters");
+
+        parents = g_array_new(FALSE, FALSE, sizeof(guint32));
+        nmp_cache_iter_for_each (&iter,
+                                 nm_platform_lookup_object(self, NMP_OBJECT_TYPE_TFILTER, ifindex),
+                                 &o) {
+            const guint32 parent = NMP_OBJECT_CAST_TFILTER(o)->parent;
+
+            for (i = 0; i < parents->len; i++) {
+                if (nm_g_array_index(parents, guint32, i) == parent)
+                    break;
+            }
+            if (i == parents->len)
+                g_array_append_val(parents, parent);
+        }
+        for (i = 0; i < parents->len; i++)
+            nm_platform_tfilter_delete(self, ifindex, nm_g_array_index(parents, guint32, i), FALSE);
+
+        goto add_tfilters;
+    }
+
     nm_platform_qdisc_delete(self, ifindex, TC_H_ROOT, FALSE);
     nm_platform_qdisc_delete(self, ifindex, TC_H_INGRESS, FALSE);
 
@@ -6092,6 +7178,7 @@ nm_platform_tc_sync(NMPlatform *self,
         }
     }
 
+add_tfilters:
     if (known_tfilters) {
         for (i = 0; i < known_tfilters->len; i++) {
             const NMPObject *q = g_ptr_array_index(known_tfilters, i);
@@ -6165,6 +7252,7 @@ nm_platform_link_to_string(const NMPlatformLink *link, char *buf, gsize len)
     char        str_perm_address[_NM_UTILS_HWADDR_LEN_MAX * 3];
     char        str_broadcast[_NM_UTILS_HWADDR_LEN_MAX * 3];
     char        str_inet6_token[NM_INET_ADDRSTRLEN];
+    char        str_xdp[30];
     const char *str_link_type;
 
     if (!nm_utils_to_string_buffer_init_null(link, &buf, &len))
@@ -6209,6 +7297,11 @@ nm_platform_link_to_string(const NMPlatformLink *link, char *buf, gsize len)
                                   str_port_data,
                                   sizeof(str_port_data));
 
+    if (link->xdp_prog_id != 0)
+        g_snprintf(str_xdp, sizeof(str_xdp), " xdp-prog-id %u", link->xdp_prog_id);
+    else
+        str_xdp[0] = '\0';
+
     str_link_type = nm_link_type_to_string(link->type);
 
     g_snprintf(
@@ -6231,10 +7324,13 @@ nm_platform_link_to_string(const NMPlatformLink *link, char *buf, gsize len)
         "%s%s"    /* inet6_token */
         "%s%s"    /* driver */
         "%s%s"    /* port_data */
+        "%s"      /* xdp_prog_id */
         " tx-queue-len %u"
         " gso-max-size %u"
         " gso-max-segs %u"
         " gro-max-size %u"
+        " gso-ipv4-max-size %u"
+        " gro-ipv4-max-size %u"
         " rx:%" G_GUINT64_FORMAT ",%" G_GUINT64_FORMAT " tx:%" G_GUINT64_FORMAT
         ",%" G_GUINT64_FORMAT,
         link->ifindex,
@@ -6268,10 +7364,13 @@ nm_platform_link_to_string(const NMPlatformLink *link, char *buf, gsize len)
         link->driver ? " driver " : "",
         link->driver ?: "",
         NM_PRINT_FMT_QUOTED2(str_port_data[0] != '\0', " ", str_port_data, ""),
+        str_xdp,
         link->link_props.tx_queue_length,
         link->link_props.gso_max_size,
         link->link_props.gso_max_segments,
         link->link_props.gro_max_size,
+        link->link_props.gso_ipv4_max_size,
+        link->link_props.gro_ipv4_max_size,
         link->rx_packets,
         link->rx_bytes,
         link->tx_packets,
@@ -6715,7 +7814,8 @@ nm_platform_lnk_macsec_to_string(const NMPlatformLnkMacsec *lnk, char *buf, gsiz
                "send_sci %s "
                "end_station %s "
                "scb %s "
-               "replay %s",
+               "replay %s "
+               "offload %u",
                (unsigned long long) lnk->sci,
                lnk->protect ? "on" : "off",
                (unsigned long long) lnk->cipher_suite,
@@ -6726,7 +7826,8 @@ nm_platform_lnk_macsec_to_string(const NMPlatformLnkMacsec *lnk, char *buf, gsiz
                lnk->include_sci ? "on" : "off",
                lnk->es ? "on" : "off",
                lnk->scb ? "on" : "off",
-               lnk->replay_protect ? "on" : "off");
+               lnk->replay_protect ? "on" : "off",
+               lnk->offload);
     return buf;
 }
 
@@ -7237,8 +8338,8 @@ nm_platform_ip4_route_to_string_full(const NMPlatformIP4Route     *route,
 
     if (route->gateway != INADDR_ANY) {
         inet_ntop(AF_INET, &route->gateway, s_gateway, sizeof(s_gateway));
-    } else if (route->via.addr_family == AF_INET6) {
-        inet_ntop(AF_INET6, route->via.addr.addr_ptr, s_gateway, sizeof(s_gateway));
+    } else if (route->via_addr_family == AF_INET6) {
+        inet_ntop(AF_INET6, route->via_addr.addr_ptr, s_gateway, sizeof(s_gateway));
     } else {
         s_gateway[0] = '\0';
     }
@@ -7804,6 +8905,37 @@ nm_platform_qdisc_to_string(const NMPlatformQdisc *qdisc, char *buf, gsize len)
             nm_strbuf_append(&buf, &len, " limit %u", qdisc->tbf.limit);
         if (qdisc->tbf.latency)
             nm_strbuf_append(&buf, &len, " latency %uns", qdisc->tbf.latency);
+    } else if (nm_streq0(qdisc->kind, "fq")) {
+        if (qdisc->fq.limit)
+            nm_strbuf_append(&buf, &len, " limit %u", qdisc->fq.limit);
+        if (qdisc->fq.flow_limit)
+            nm_strbuf_append(&buf, &len, " flow_limit %u", qdisc->fq.flow_limit);
+        if (qdisc->fq.quantum)
+            nm_strbuf_append(&buf, &len, " quantum %u", qdisc->fq.quantum);
+        if (qdisc->fq.initial_quantum)
+            nm_strbuf_append(&buf, &len, " initial_quantum %u", qdisc->fq.initial_quantum);
+        if (qdisc->fq.maxrate)
+            nm_strbuf_append(&buf, &len, " maxrate %u", qdisc->fq.maxrate);
+        if (qdisc->fq.nopacing)
+            nm_strbuf_append(&buf, &len, " nopacing");
+    } else if (nm_streq0(qdisc->kind, "mqprio")) {
+        guint i;
+
+        nm_strbuf_append(&buf, &len, " num_tc %u map", qdisc->mqprio.num_tc);
+        for (i = 0; i < NM_PLATFORM_MQPRIO_MAX_TC; i++)
+            nm_strbuf_append(&buf, &len, "%c%u", i ? ',' : ' ', qdisc->mqprio.prio_tc_map[i]);
+        nm_strbuf_append(&buf, &len, " queues");
+        for (i = 0; i < qdisc->mqprio.num_tc && i < NM_PLATFORM_MQPRIO_MAX_TC; i++) {
+            nm_strbuf_append(&buf,
+                             &len,
+                             "%c%u@%u",
+                             i ? ',' : ' ',
+                             qdisc->mqprio.count[i],
+                             qdisc->mqprio.offset[i]);
+        }
+        nm_strbuf_append(&buf, &len, " hw %u", qdisc->mqprio.hw);
+        if (qdisc->mqprio.has_mode)
+            nm_strbuf_append(&buf, &len, " mode %u", qdisc->mqprio.mode);
     }
 
     return buf0;
@@ -7834,6 +8966,23 @@ nm_platform_qdisc_hash_update(const NMPlatformQdisc *obj, NMHashState *h)
                             obj->sfq.depth);
     } else if (nm_streq0(obj->kind, "tbf")) {
         nm_hash_update_vals(h, obj->tbf.rate, obj->tbf.burst, obj->tbf.limit, obj->tbf.latency);
+    } else if (nm_streq0(obj->kind, "fq")) {
+        nm_hash_update_vals(h,
+                            obj->fq.limit,
+                            obj->fq.flow_limit,
+                            obj->fq.quantum,
+                            obj->fq.initial_quantum,
+                            obj->fq.maxrate,
+                            NM_HASH_COMBINE_BOOLS(guint8, obj->fq.nopacing));
+    } else if (nm_streq0(obj->kind, "mqprio")) {
+        nm_hash_update(h, obj->mqprio.count, sizeof(obj->mqprio.count));
+        nm_hash_update(h, obj->mqprio.offset, sizeof(obj->mqprio.offset));
+        nm_hash_update(h, obj->mqprio.prio_tc_map, sizeof(obj->mqprio.prio_tc_map));
+        nm_hash_update_vals(h,
+                            obj->mqprio.num_tc,
+                            obj->mqprio.hw,
+                            obj->mqprio.mode,
+                            NM_HASH_COMBINE_BOOLS(guint8, obj->mqprio.has_mode));
     }
 }
 
@@ -7870,6 +9019,22 @@ nm_platform_qdisc_cmp(const NMPlatformQdisc *a, const NMPlatformQdisc *b, gboole
         NM_CMP_FIELD(a, b, tbf.burst);
         NM_CMP_FIELD(a, b, tbf.limit);
         NM_CMP_FIELD(a, b, tbf.latency);
+    } else if (nm_streq0(a->kind, "fq")) {
+        NM_CMP_FIELD(a, b, fq.limit);
+        NM_CMP_FIELD(a, b, fq.flow_limit);
+        NM_CMP_FIELD(a, b, fq.quantum);
+        NM_CMP_FIELD(a, b, fq.initial_quantum);
+        NM_CMP_FIELD(a, b, fq.maxrate);
+        NM_CMP_FIELD_UNSAFE(a, b, fq.nopacing);
+    } else if (nm_streq0(a->kind, "mqprio")) {
+        NM_CMP_FIELD(a, b, mqprio.num_tc);
+        NM_CMP_FIELD_MEMCMP(a, b, mqprio.prio_tc_map);
+        NM_CMP_FIELD_MEMCMP(a, b, mqprio.count);
+        NM_CMP_FIELD_MEMCMP(a, b, mqprio.offset);
+        NM_CMP_FIELD(a, b, mqprio.hw);
+        NM_CMP_FIELD_UNSAFE(a, b, mqprio.has_mode);
+        if (a->mqprio.has_mode)
+            NM_CMP_FIELD(a, b, mqprio.mode);
     }
 
     return 0;
@@ -8079,6 +9244,94 @@ nm_platform_mptcp_addr_index_addr_equal(gconstpointer data_a, gconstpointer data
            && nm_ip_addr_equal(mptcp_addr_a->addr_family, &mptcp_addr_a->addr, &mptcp_addr_b->addr);
 }
 
+static NM_UTILS_FLAGS2STR_DEFINE(_neigh_state_to_string,
+                                 guint16,
+                                 NM_UTILS_FLAGS2STR(NUD_INCOMPLETE, "incomplete"),
+                                 NM_UTILS_FLAGS2STR(NUD_REACHABLE, "reachable"),
+                                 NM_UTILS_FLAGS2STR(NUD_STALE, "stale"),
+                                 NM_UTILS_FLAGS2STR(NUD_DELAY, "delay"),
+                                 NM_UTILS_FLAGS2STR(NUD_PROBE, "probe"),
+                                 NM_UTILS_FLAGS2STR(NUD_FAILED, "failed"),
+                                 NM_UTILS_FLAGS2STR(NUD_NOARP, "noarp"),
+                                 NM_UTILS_FLAGS2STR(NUD_PERMANENT, "permanent"));
+
+static NM_UTILS_FLAGS2STR_DEFINE(_neigh_flags_to_string,
+                                 guint8,
+                                 NM_UTILS_FLAGS2STR(NTF_USE, "use"),
+                                 NM_UTILS_FLAGS2STR(NTF_SELF, "self"),
+                                 NM_UTILS_FLAGS2STR(NTF_MASTER, "master"),
+                                 NM_UTILS_FLAGS2STR(NTF_PROXY, "proxy"),
+                                 NM_UTILS_FLAGS2STR(NTF_EXT_LEARNED, "extern_learn"),
+                                 NM_UTILS_FLAGS2STR(NTF_OFFLOADED, "offload"),
+                                 NM_UTILS_FLAGS2STR(NTF_STICKY, "sticky"),
+                                 NM_UTILS_FLAGS2STR(NTF_ROUTER, "router"));
+
+const char *
+nm_platform_neigh_to_string(const NMPlatformNeigh *neigh, char *buf, gsize len)
+{
+    char str_dst[30 + NM_INET_ADDRSTRLEN];
+    char str_lladdr[sizeof(NMEtherAddr) * 3];
+    char str_state[100];
+    char str_flags[100];
+
+    if (!nm_utils_to_string_buffer_init_null(neigh, &buf, &len))
+        return buf;
+
+    if (NM_IN_SET(neigh->dst_family, AF_INET, AF_INET6)) {
+        char s[NM_INET_ADDRSTRLEN];
+
+        nm_sprintf_buf(str_dst, " dst %s", nm_inet_ntop(neigh->dst_family, &neigh->dst, s));
+    } else
+        str_dst[0] = '\0';
+
+    _neigh_state_to_string(neigh->state, str_state, sizeof(str_state));
+    _neigh_flags_to_string(neigh->flags, str_flags, sizeof(str_flags));
+
+    g_snprintf(buf,
+               len,
+               "%s" /* family */
+               "%s" /* dst */
+               " lladdr %s"
+               " ifindex %d"
+               " state %s"
+               " flags %s"
+               "",
+               neigh->addr_family == AF_BRIDGE ? "fdb" : "neigh",
+               str_dst,
+               nm_ether_addr_to_string(&neigh->lladdr, str_lladdr),
+               neigh->ifindex,
+               str_state,
+               str_flags);
+    return buf;
+}
+
+void
+nm_platform_neigh_hash_update(const NMPlatformNeigh *obj, NMHashState *h)
+{
+    nm_hash_update_vals(h,
+                        obj->ifindex,
+                        obj->state,
+                        obj->flags,
+                        obj->addr_family,
+                        obj->dst_family);
+    nm_hash_update(h, &obj->lladdr, sizeof(obj->lladdr));
+    nm_hash_update(h, &obj->dst, nm_utils_addr_family_to_size_untrusted(obj->dst_family));
+}
+
+int
+nm_platform_neigh_cmp(const NMPlatformNeigh *a, const NMPlatformNeigh *b)
+{
+    NM_CMP_SELF(a, b);
+    NM_CMP_FIELD(a, b, ifindex);
+    NM_CMP_FIELD(a, b, addr_family);
+    NM_CMP_FIELD(a, b, dst_family);
+    NM_CMP_FIELD_MEMCMP_LEN(a, b, dst, nm_utils_addr_family_to_size_untrusted(a->dst_family));
+    NM_CMP_FIELD_MEMCMP(a, b, lladdr);
+    NM_CMP_FIELD(a, b, state);
+    NM_CMP_FIELD(a, b, flags);
+    return 0;
+}
+
 const char *
 nm_platform_vf_to_string(const NMPlatformVF *vf, char *buf, gsize len)
 {
@@ -8175,7 +9428,10 @@ nm_platform_link_hash_update(const NMPlatformLink *obj, NMHashState *h)
                         obj->link_props.gso_max_size,
                         obj->link_props.gso_max_segments,
                         obj->link_props.gro_max_size,
+                        obj->link_props.gso_ipv4_max_size,
+                        obj->link_props.gro_ipv4_max_size,
                         obj->port_kind,
+                        obj->xdp_prog_id,
                         obj->rx_packets,
                         obj->rx_bytes,
                         obj->tx_packets,
@@ -8250,6 +9506,9 @@ nm_platform_link_cmp(const NMPlatformLink *a, const NMPlatformLink *b)
     NM_CMP_FIELD(a, b, link_props.gso_max_size);
     NM_CMP_FIELD(a, b, link_props.gso_max_segments);
     NM_CMP_FIELD(a, b, link_props.gro_max_size);
+    NM_CMP_FIELD(a, b, link_props.gso_ipv4_max_size);
+    NM_CMP_FIELD(a, b, link_props.gro_ipv4_max_size);
+    NM_CMP_FIELD(a, b, xdp_prog_id);
     NM_CMP_FIELD(a, b, port_kind);
     switch (a->port_kind) {
     case NM_PORT_KIND_NONE:
@@ -8612,6 +9871,7 @@ nm_platform_lnk_macsec_hash_update(const NMPlatformLnkMacsec *obj, NMHashState *
                         obj->icv_length,
                         obj->encoding_sa,
                         obj->validation,
+                        obj->offload,
                         NM_HASH_COMBINE_BOOLS(guint8,
                                               obj->encrypt,
                                               obj->protect,
@@ -8631,6 +9891,7 @@ nm_platform_lnk_macsec_cmp(const NMPlatformLnkMacsec *a, const NMPlatformLnkMacs
     NM_CMP_FIELD(a, b, window);
     NM_CMP_FIELD(a, b, encoding_sa);
     NM_CMP_FIELD(a, b, validation);
+    NM_CMP_FIELD(a, b, offload);
     NM_CMP_FIELD_UNSAFE(a, b, encrypt);
     NM_CMP_FIELD_UNSAFE(a, b, protect);
     NM_CMP_FIELD_UNSAFE(a, b, include_sci);
@@ -8982,8 +10243,8 @@ nm_platform_ip4_route_hash_update(const NMPlatformIP4Route *obj,
                 nm_hash_update_vals(h,
                                     obj->ifindex,
                                     n_nexthops,
-                                    obj->via.addr_family,
-                                    obj->via.addr_family == AF_INET6 ? obj->via.addr.addr6
+                                    obj->via_addr_family,
+                                    obj->via_addr_family == AF_INET6 ? obj->via_addr.addr6
                                                                      : in6addr_any,
                                     obj->gateway,
                                     _ip4_route_weight_normalize(n_nexthops, obj->weight, FALSE));
@@ -9135,9 +10396,9 @@ nm_platform_ip4_route_cmp(const NMPlatformIP4Route *a,
             if (cmp_type == NM_PLATFORM_IP_ROUTE_CMP_TYPE_ID) {
                 NM_CMP_FIELD(a, b, ifindex);
                 NM_CMP_FIELD(a, b, gateway);
-                NM_CMP_FIELD(a, b, via.addr_family);
-                if (a->via.addr_family == AF_INET6) {
-                    NM_CMP_FIELD_IN6ADDR(a, b, via.addr.addr6);
+                NM_CMP_FIELD(a, b, via_addr_family);
+                if (a->via_addr_family == AF_INET6) {
+                    NM_CMP_FIELD_IN6ADDR(a, b, via_addr.addr6);
                 }
                 n_nexthops = nm_platform_ip4_route_get_n_nexthops(a);
                 NM_CMP_DIRECT(n_nexthops, nm_platform_ip4_route_get_n_nexthops(b));
@@ -9164,9 +10425,9 @@ nm_platform_ip4_route_cmp(const NMPlatformIP4Route *a,
         NM_CMP_FIELD_UNSAFE(a, b, metric_any);
         NM_CMP_FIELD(a, b, metric);
         NM_CMP_FIELD(a, b, gateway);
-        NM_CMP_FIELD(a, b, via.addr_family);
-        if (a->via.addr_family == AF_INET6) {
-            NM_CMP_FIELD_IN6ADDR(a, b, via.addr.addr6);
+        NM_CMP_FIELD(a, b, via_addr_family);
+        if (a->via_addr_family == AF_INET6) {
+            NM_CMP_FIELD_IN6ADDR(a, b, via_addr.addr6);
         }
         if (cmp_type == NM_PLATFORM_IP_ROUTE_CMP_TYPE_SEMANTICALLY) {
             n_nexthops = nm_platform_ip4_route_get_n_nexthops(a);
@@ -9680,6 +10941,214 @@ nm_platform_mptcp_addrs_dump(NMPlatform *self)
 
 /*****************************************************************************/
 
+/**
+ * nm_platform_neigh_dump:
+ * @self: the #NMPlatform instance.
+ * @addr_family: AF_INET, AF_INET6 or AF_BRIDGE.
+ * @ifindex: the interface, or zero for all interfaces.
+ *
+ * Neighbor and FDB entries are not kept in the platform cache. This
+ * requests them from kernel.
+ *
+ * Returns: (transfer container): the #NMPObject instances of type
+ *   %NMP_OBJECT_TYPE_NEIGH, or %NULL on failure or if the platform
+ *   does not support it.
+ */
+GPtrArray *
+nm_platform_neigh_dump(NMPlatform *self, int addr_family, int ifindex)
+{
+    _CHECK_SELF(self, klass, NULL);
+
+    nm_assert(NM_IN_SET(addr_family, AF_INET, AF_INET6, AF_BRIDGE));
+    nm_assert(ifindex >= 0);
+
+    if (!klass->neigh_dump)
+        return NULL;
+
+    return klass->neigh_dump(self, addr_family, ifindex);
+}
+
+static void
+_neigh_sync_batch_append(NMPlatform      *self,
+                         ObjectBatch     *batch,
+                         const NMPObject *obj,
+                         gboolean         is_delete)
+{
+    const NMPlatformNeigh *neigh   = NMP_OBJECT_CAST_NEIGH(obj);
+    const int              ifindex = neigh->ifindex;
+    NMPNlmFlags            flags   = 0;
+    char                   sbuf[NM_UTILS_TO_STRING_BUFFER_SIZE];
+
+    if (!is_delete) {
+        /* The additional remote endpoints of a VXLAN device are appended.
+         * Other entries only have one destination, which gets replaced. */
+        flags = (nm_platform_neigh_is_fdb_multi_dst(neigh) && neigh->dst_family != AF_UNSPEC)
+                    ? NMP_NLM_FLAG_APPEND
+                    : NMP_NLM_FLAG_REPLACE;
+    }
+
+    _LOG3D("neigh-sync: %s %s",
+           is_delete ? "deleting" : "adding or updating",
+           nmp_object_to_string(obj, NMP_OBJECT_TO_STRING_PUBLIC, sbuf, sizeof(sbuf)));
+
+    _object_batch_append(batch, obj, is_delete, flags);
+}
+
+static gboolean
+_neigh_sync_batch_flush(NMPlatform *self, ObjectBatch *batch)
+{
+    gboolean success = TRUE;
+    guint    i;
+    char     sbuf[NM_UTILS_TO_STRING_BUFFER_SIZE];
+
+    if (batch->len == 0)
+        return TRUE;
+
+    nm_platform_object_batch(self, batch->ops, batch->len);
+
+    for (i = 0; i < batch->len; i++) {
+        NMPlatformObjectBatchOp        *op         = &batch->ops[i];
+        nm_auto_nmpobj const NMPObject *obj        = g_steal_pointer(&batch->objs[i]);
+        gs_free char                   *extack_msg = g_steal_pointer(&op->extack_msg);
+        const int                       ifindex    = NMP_OBJECT_CAST_NEIGH(obj)->ifindex;
+
+        if (op->result == 0 || (op->is_delete && op->result == -ENOENT))
+            continue;
+
+        _LOG3D("neigh-sync: failure to %s %s: %s%s%s%s",
+               op->is_delete ? "delete" : "add",
+               nmp_object_to_string(obj, NMP_OBJECT_TO_STRING_PUBLIC, sbuf, sizeof(sbuf)),
+               nm_strerror(op->result),
+               NM_PRINT_FMT_QUOTED(extack_msg, " (", extack_msg, ")", ""));
+        success = FALSE;
+    }
+
+    batch->len = 0;
+    return success;
+}
+
+/**
+ * nm_platform_neigh_sync:
+ * @self: the #NMPlatform instance.
+ * @ifindex: the interface.
+ * @known_neighs: (nullable): the #NMPObject instances of type
+ *   %NMP_OBJECT_TYPE_NEIGH that should be configured on @ifindex.
+ * @neighs_prune: (nullable): the entries to delete. Usually, these are
+ *   the entries that were configured previously. Entries that are also
+ *   in @known_neighs are kept.
+ *
+ * Like nm_platform_ip_route_sync(), this compares the wanted entries with
+ * the ones in kernel and only sends the difference. Since neighbor and FDB
+ * entries are not cached, the entries of the affected address families get
+ * dumped first. The changes are then sent with nm_platform_object_batch().
+ *
+ * Entries that kernel learned, or that were configured by somebody else,
+ * are left alone.
+ *
+ * Returns: %TRUE if all entries could be configured.
+ */
+gboolean
+nm_platform_neigh_sync(NMPlatform *self,
+                       int         ifindex,
+                       GPtrArray  *known_neighs,
+                       GPtrArray  *neighs_prune)
+{
+    static const int               families[] = {AF_INET, AF_INET6, AF_BRIDGE};
+    gs_unref_hashtable GHashTable *plat_idx   = NULL;
+    gs_unref_hashtable GHashTable *known_idx  = NULL;
+    gs_free ObjectBatch           *batch      = NULL;
+    gboolean                       success    = TRUE;
+    guint                          families_needed;
+    guint                          i;
+    guint                          j;
+
+    _CHECK_SELF(self, klass, FALSE);
+
+    nm_assert(ifindex > 0);
+
+    families_needed = 0;
+    for (j = 0; j < 2; j++) {
+        GPtrArray *arr = j == 0 ? known_neighs : neighs_prune;
+
+        for (i = 0; arr && i < arr->len; i++) {
+            const NMPlatformNeigh *neigh = NMP_OBJECT_CAST_NEIGH(arr->pdata[i]);
+
+            nm_assert(neigh->ifindex == ifindex);
+            families_needed |= (neigh->addr_family == AF_INET    ? 0x1u
+                                : neigh->addr_family == AF_INET6 ? 0x2u
+                                                                 : 0x4u);
+        }
+    }
+
+    if (families_needed == 0)
+        return TRUE;
+
+    plat_idx = g_hash_table_new_full((GHashFunc) nmp_object_id_hash,
+                                     (GEqualFunc) nmp_object_id_equal,
+                                     (GDestroyNotify) nmp_object_unref,
+                                     NULL);
+    for (j = 0; j < G_N_ELEMENTS(families); j++) {
+        gs_unref_ptrarray GPtrArray *plat_neighs = NULL;
+
+        if (!NM_FLAGS_ANY(families_needed, 1u << j))
+            continue;
+
+        plat_neighs = nm_platform_neigh_dump(self, families[j], ifindex);
+        for (i = 0; plat_neighs && i < plat_neighs->len; i++)
+            g_hash_table_add(plat_idx, (gpointer) nmp_object_ref(plat_neighs->pdata[i]));
+    }
+
+    if (known_neighs && known_neighs->len > 0) {
+        known_idx = g_hash_table_new((GHashFunc) nmp_object_id_hash,
+                                     (GEqualFunc) nmp_object_id_equal);
+        for (i = 0; i < known_neighs->len; i++)
+            g_hash_table_add(known_idx, known_neighs->pdata[i]);
+    }
+
+    batch      = g_new(ObjectBatch, 1);
+    batch->len = 0;
+
+    for (i = 0; neighs_prune && i < neighs_prune->len; i++) {
+        const NMPObject *obj = neighs_prune->pdata[i];
+        const NMPObject *plat_obj;
+
+        if (known_idx && g_hash_table_contains(known_idx, obj))
+            continue;
+
+        plat_obj = g_hash_table_lookup(plat_idx, obj);
+        if (!plat_obj)
+            continue;
+
+        if (batch->len >= OBJECT_BATCH_MAX) {
+            if (!_neigh_sync_batch_flush(self, batch))
+                success = FALSE;
+        }
+        _neigh_sync_batch_append(self, batch, plat_obj, TRUE);
+    }
+
+    for (i = 0; known_neighs && i < known_neighs->len; i++) {
+        const NMPObject *obj = known_neighs->pdata[i];
+        const NMPObject *plat_obj;
+
+        plat_obj = g_hash_table_lookup(plat_idx, obj);
+        if (plat_obj && nmp_object_equal(plat_obj, obj))
+            continue;
+
+        if (batch->len >= OBJECT_BATCH_MAX) {
+            if (!_neigh_sync_batch_flush(self, batch))
+                success = FALSE;
+        }
+        _neigh_sync_batch_append(self, batch, obj, FALSE);
+    }
+
+    if (!_neigh_sync_batch_flush(self, batch))
+        success = FALSE;
+
+    return success;
+}
+
+/*****************************************************************************/
+
 GHashTable *
 nm_platform_ip4_address_addr_to_hash(NMPlatform *self, int ifindex)
 {
@@ -9909,6 +11378,24 @@ log_tfilter(NMPlatform                *self,
 
 /*****************************************************************************/
 
+void
+nm_platform_emit_wifi_event(NMPlatform *self, int ifindex)
+{
+    _CHECK_SELF_VOID(self, klass);
+
+    g_signal_emit(self, signal_wifi_event, 0, ifindex);
+}
+
+void
+nm_platform_emit_resync_done(NMPlatform *self)
+{
+    _CHECK_SELF_VOID(self, klass);
+
+    g_signal_emit(self, signal_resync_done, 0);
+}
+
+/*****************************************************************************/
+
 void
 nm_platform_cache_update_emit_signal(NMPlatform      *self,
                                      NMPCacheOpsType  cache_op,
@@ -9932,6 +11419,18 @@ nm_platform_cache_update_emit_signal(NMPlatform      *self,
 
     NMTST_ASSERT_PLATFORM_NETNS_CURRENT(self);
 
+    if (NM_PLATFORM_GET_PRIVATE(self)->sysctl_ip_conf_cache
+        && NMP_OBJECT_GET_TYPE(obj_old ?: obj_new) == NMP_OBJECT_TYPE_LINK) {
+        GHashTable *sysctl_ip_conf_cache = NM_PLATFORM_GET_PRIVATE(self)->sysctl_ip_conf_cache;
+
+        /* Any change of the link (or its removal, or a rename) might mean that
+         * the sysctl values we wrote are no longer in effect. */
+        if (obj_old)
+            g_hash_table_remove(sysctl_ip_conf_cache, obj_old->link.name);
+        if (obj_new)
+            g_hash_table_remove(sysctl_ip_conf_cache, obj_new->link.name);
+    }
+
     switch (cache_op) {
     case NMP_CACHE_OPS_ADDED:
         if (!nmp_object_is_visible(obj_new))
@@ -10225,6 +11724,8 @@ finalize(GObject *object)
     nm_clear_g_source(&priv->ip4_dev_route_blacklist_check_id);
     nm_clear_g_source(&priv->ip4_dev_route_blacklist_gc_timeout_id);
     nm_clear_pointer(&priv->ip4_dev_route_blacklist_hash, g_hash_table_unref);
+    nm_clear_pointer(&priv->sysctl_ip_conf_cache, g_hash_table_unref);
+    nm_platform_trace_set_size(self, 0);
     g_clear_object(&self->_netns);
     nm_dedup_multi_index_unref(priv->multi_idx);
     nmp_cache_free(priv->cache);
@@ -10329,4 +11830,25 @@ nm_platform_class_init(NMPlatformClass *platform_class)
            log_routing_rule);
     SIGNAL(NM_PLATFORM_SIGNAL_ID_QDISC, NM_PLATFORM_SIGNAL_QDISC_CHANGED, log_qdisc);
     SIGNAL(NM_PLATFORM_SIGNAL_ID_TFILTER, NM_PLATFORM_SIGNAL_TFILTER_CHANGED, log_tfilter);
+
+    signal_wifi_event = g_signal_new(NM_PLATFORM_SIGNAL_WIFI_EVENT,
+                                     G_OBJECT_CLASS_TYPE(object_class),
+                                     G_SIGNAL_RUN_FIRST,
+                                     0,
+                                     NULL,
+                                     NULL,
+                                     NULL,
+                                     G_TYPE_NONE,
+                                     1,
+                                     G_TYPE_INT /* ifindex */);
+
+    signal_resync_done = g_signal_new(NM_PLATFORM_SIGNAL_RESYNC_DONE,
+                                      G_OBJECT_CLASS_TYPE(object_class),
+                                      G_SIGNAL_RUN_FIRST,
+                                      0,
+                                      NULL,
+                                      NULL,
+                                      NULL,
+                                      G_TYPE_NONE,
+                                      0);
 }
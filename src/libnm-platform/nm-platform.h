@@ -156,14 +156,18 @@ typedef struct {
     guint32 gso_max_size;
     guint32 gso_max_segments;
     guint32 gro_max_size;
+    guint32 gso_ipv4_max_size;
+    guint32 gro_ipv4_max_size;
 } NMPlatformLinkProps;
 
 typedef enum {
-    NM_PLATFORM_LINK_CHANGE_NONE             = 0,
-    NM_PLATFORM_LINK_CHANGE_TX_QUEUE_LENGTH  = (1 << 0),
-    NM_PLATFORM_LINK_CHANGE_GSO_MAX_SIZE     = (1 << 1),
-    NM_PLATFORM_LINK_CHANGE_GSO_MAX_SEGMENTS = (1 << 2),
-    NM_PLATFORM_LINK_CHANGE_GRO_MAX_SIZE     = (1 << 3),
+    NM_PLATFORM_LINK_CHANGE_NONE              = 0,
+    NM_PLATFORM_LINK_CHANGE_TX_QUEUE_LENGTH   = (1 << 0),
+    NM_PLATFORM_LINK_CHANGE_GSO_MAX_SIZE      = (1 << 1),
+    NM_PLATFORM_LINK_CHANGE_GSO_MAX_SEGMENTS  = (1 << 2),
+    NM_PLATFORM_LINK_CHANGE_GRO_MAX_SIZE      = (1 << 3),
+    NM_PLATFORM_LINK_CHANGE_GSO_IPV4_MAX_SIZE = (1 << 4),
+    NM_PLATFORM_LINK_CHANGE_GRO_IPV4_MAX_SIZE = (1 << 5),
 } NMPlatformLinkChangeFlags;
 
 struct _NMPlatformObjWithIfindex {
@@ -245,6 +249,9 @@ struct _NMPlatformLink {
     /* IFLA_INFO_PORT_KIND */
     NMPortKind port_kind;
 
+    /* IFLA_XDP_PROG_ID. The ID of the attached XDP program, or 0. */
+    guint32 xdp_prog_id;
+
     /* @connected is mostly identical to (@n_ifi_flags & IFF_UP). Except for bridge/bond controllers,
      * where we coerce the link as disconnect if it has no ports. */
     bool connected : 1;
@@ -422,8 +429,22 @@ typedef struct {
 struct _NMPlatformIP4Route {
     __NMPlatformIPRoute_COMMON;
 
+    /* The fields are ordered to avoid padding, as there might be many
+     * IPv4 routes in the platform cache. */
     in_addr_t network;
 
+    /* RTA_GATEWAY. The gateway is part of the primary key for a route.
+     * If n_nexthops is zero, this value is undefined (should be zero).
+     * If n_nexthops is greater or equal to one, this is the gateway of
+     * the first hop. */
+    in_addr_t gateway;
+
+    /* RTA_PREFSRC (called "src" by iproute2).
+     *
+     * pref_src is part of the ID of an IPv4 route. When deleting a route,
+     * pref_src must match, unless set to 0.0.0.0 to match any. */
+    in_addr_t pref_src;
+
     /* If n_nexthops is zero, the the address has no next hops. That applies
      *    to certain route types like blackhole.
      * If n_nexthops is 1, then the fields "ifindex", "gateway" and "weight"
@@ -436,25 +457,7 @@ struct _NMPlatformIP4Route {
      * For convenience, if ifindex > 0 and n_nexthops == 0, we assume that n_nexthops
      * is in fact 1. If ifindex is <= 0, n_nexthops must be zero.
      * See nm_platform_ip4_route_get_n_nexthops(). */
-    guint n_nexthops;
-
-    /* RTA_GATEWAY. The gateway is part of the primary key for a route.
-     * If n_nexthops is zero, this value is undefined (should be zero).
-     * If n_nexthops is greater or equal to one, this is the gateway of
-     * the first hop. */
-    in_addr_t gateway;
-
-    /* RTA_VIA. Part of the primary key for a route. Allows a gateway for a
-     * route to exist in a different address family.
-     * Only valid if: n_nexthops == 1, gateway == 0, via.family != AF_UNSPEC
-     */
-    NMIPAddrTyped via;
-
-    /* RTA_PREFSRC (called "src" by iproute2).
-     *
-     * pref_src is part of the ID of an IPv4 route. When deleting a route,
-     * pref_src must match, unless set to 0.0.0.0 to match any. */
-    in_addr_t pref_src;
+    guint16 n_nexthops;
 
     /* This is the weight of for the first next-hop.
      *
@@ -479,6 +482,15 @@ struct _NMPlatformIP4Route {
      */
     guint16 weight;
 
+    /* RTA_VIA. Part of the primary key for a route. Allows a gateway for a
+     * route to exist in a different address family.
+     * Only valid if: n_nexthops == 1, gateway == 0, via_addr_family != AF_UNSPEC
+     *
+     * This is not a NMIPAddrTyped, because its padding would not allow to
+     * place the following fields. */
+    NMIPAddr via_addr;
+    gint8    via_addr_family;
+
     /* rtm_tos (iproute2: tos)
      *
      * For IPv4, tos is part of the weak-id (like metric).
@@ -637,6 +649,32 @@ typedef struct {
     guint32 latency;
 } NMPlatformQdiscTbf;
 
+typedef struct {
+    guint32 limit;
+    guint32 flow_limit;
+    guint32 quantum;
+    guint32 initial_quantum;
+
+    /* In bytes per second. Zero means no limit. */
+    guint32 maxrate;
+
+    bool nopacing : 1;
+} NMPlatformQdiscFq;
+
+#define NM_PLATFORM_MQPRIO_MAX_TC 16
+
+typedef struct {
+    guint16 count[NM_PLATFORM_MQPRIO_MAX_TC];
+    guint16 offset[NM_PLATFORM_MQPRIO_MAX_TC];
+    guint8  prio_tc_map[NM_PLATFORM_MQPRIO_MAX_TC];
+    guint8  num_tc;
+    guint8  hw;
+
+    /* TC_MQPRIO_MODE_*, only sent when @has_mode is set. */
+    guint16 mode;
+    bool    has_mode : 1;
+} NMPlatformQdiscMqprio;
+
 typedef struct {
     __NMPlatformObjWithIfindex_COMMON;
 
@@ -652,6 +690,8 @@ typedef struct {
         NMPlatformQdiscFqCodel fq_codel;
         NMPlatformQdiscSfq     sfq;
         NMPlatformQdiscTbf     tbf;
+        NMPlatformQdiscFq      fq;
+        NMPlatformQdiscMqprio  mqprio;
     };
 } _nm_alignas(NMPlatformObject) NMPlatformQdisc;
 
@@ -925,6 +965,7 @@ typedef struct {
     guint8  icv_length;
     guint8  encoding_sa;
     guint8  validation;
+    guint8  offload; /* NMSettingMacsecOffload, without "default" */
     bool    encrypt : 1;
     bool    protect : 1;
     bool    include_sci : 1;
@@ -1050,6 +1091,69 @@ typedef struct {
     gint8    addr_family;
 } NMPlatformMptcpAddr;
 
+/**
+ * NMPlatformNeigh:
+ * @addr_family: AF_INET or AF_INET6 for a neighbor (ARP/ND) entry, or
+ *   AF_BRIDGE for a forwarding database (FDB) entry of a bridge port or
+ *   a VXLAN device.
+ * @dst: for neighbor entries, the IP address of the neighbor. For FDB
+ *   entries, the optional IP address of the remote VXLAN tunnel endpoint.
+ * @dst_family: the address family of @dst. For neighbor entries, that is
+ *   always @addr_family. For FDB entries, it is AF_UNSPEC if there
+ *   is no remote endpoint.
+ * @lladdr: the link layer address. For FDB entries, the all-zero address
+ *   together with a @dst are the default destinations of a VXLAN device.
+ * @state: the NUD_* state, for example NUD_PERMANENT.
+ * @flags: the NTF_* flags, for example NTF_SELF for FDB entries.
+ *
+ * Static neighbor and FDB entries, as configured with "ip neigh" and
+ * "bridge fdb". They are not kept in the platform cache.
+ */
+typedef struct {
+    __NMPlatformObjWithIfindex_COMMON;
+    NMIPAddr    dst;
+    NMEtherAddr lladdr;
+    guint16     state;
+    guint8      flags;
+    gint8       addr_family;
+    gint8       dst_family;
+} NMPlatformNeigh;
+
+static inline gboolean
+nm_platform_neigh_is_fdb_multi_dst(const NMPlatformNeigh *neigh)
+{
+    /* The all-zero and multicast FDB entries of a VXLAN device can have
+     * several remote endpoints. */
+    return neigh->addr_family == AF_BRIDGE
+           && ((neigh->lladdr.ether_addr_octet[0] & 0x01) != 0
+               || nm_ether_addr_is_zero(&neigh->lladdr));
+}
+
+typedef struct {
+    guint32 id;
+
+    /* The weight of the member, the valid range is 1-256. Zero
+     * is treated like 1. */
+    guint16 weight;
+} NMPlatformNexthopGroupMember;
+
+/* A kernel nexthop object (RTM_NEWNEXTHOP). Routes can refer to it
+ * by its ID (RTA_NH_ID), instead of specifying the next hops themselves.
+ *
+ * If @n_group is positive, this is a nexthop group of other nexthop
+ * objects and the other fields are ignored. Otherwise, it's a single
+ * nexthop via @ifindex and @gateway (which can be zero for device
+ * nexthops), or a blackhole. */
+typedef struct {
+    guint32                             id;
+    gint8                               addr_family;
+    bool                                blackhole : 1;
+    int                                 ifindex;
+    NMIPAddr                            gateway;
+    guint                               n_group;
+    const NMPlatformNexthopGroupMember *group;
+} NMPlatformNexthop;
+
 #undef __NMPlatformObjWithIfindex_COMMON
 
 /*****************************************************************************/
@@ -1118,6 +1222,10 @@ typedef enum {
 
 typedef struct {
     const char *name;
+
+    /* Whether the family is registered by a module that gets loaded on
+     * demand, for example when creating a link of that type. */
+    bool autoload : 1;
 } NMPGenlFamilyInfo;
 
 extern const NMPGenlFamilyInfo nmp_genl_family_infos[_NMP_GENL_FAMILY_TYPE_NUM];
@@ -1126,6 +1234,81 @@ NMPGenlFamilyType nmp_genl_family_type_from_name(const char *name);
 
 /*****************************************************************************/
 
+/**
+ * NMPlatformObjectBatchOp:
+ * @obj_stack: the object to add or delete. This is a stack-initialized
+ *   instance that stays alive for the duration of the batch. For additions
+ *   of routes, it was already normalized and the implementation may modify it.
+ *   For additions of addresses, the lifetime and preferred fields are relative
+ *   to now and n_ifa_flags are the flags to configure.
+ * @nlm_flags: the flags for additions of routes and routing rules.
+ * @is_delete: whether @obj_stack is to be deleted instead of added.
+ * @result: (out): zero on success or a negative nm-errno.
+ * @extack_msg: (out): the extended ACK message from kernel, if any.
+ *
+ * One operation of nm_platform_object_batch().
+ */
+typedef struct {
+    NMPObject  *obj_stack;
+    NMPNlmFlags nlm_flags;
+    bool        is_delete;
+
+    int   result;
+    char *extack_msg;
+} NMPlatformObjectBatchOp;
+
+/**
+ * NMPlatformLinkAddOp:
+ * @type: the link type.
+ * @name: the interface name.
+ * @parent: the IFLA_LINK parameter or 0.
+ * @address: the MAC address for the new link, if the length is not zero.
+ * @extra_data: depending on @type, additional data. It may point to @lnk.
+ * @lnk: storage for @extra_data.
+ * @result: (out): zero on success or a negative nm-errno.
+ *
+ * One link to create with nm_platform_link_add_batch().
+ */
+typedef struct {
+    NMLinkType     type;
+    const char    *name;
+    int            parent;
+    NMPLinkAddress address;
+    gconstpointer  extra_data;
+
+    union {
+        NMPlatformLnkGre        gre;
+        NMPlatformLnkInfiniband infiniband;
+        NMPlatformLnkIp6Tnl     ip6tnl;
+        NMPlatformLnkIpIp       ipip;
+        NMPlatformLnkMacvlan    macvlan;
+        NMPlatformLnkSit        sit;
+        NMPlatformLnkVlan       vlan;
+        NMPlatformLnkVrf        vrf;
+        NMPlatformLnkVti        vti;
+        NMPlatformLnkVti6       vti6;
+        NMPlatformLnkVxlan      vxlan;
+    } lnk;
+
+    int result;
+} NMPlatformLinkAddOp;
+
+/**
+ * NMPlatformLinkAttachPortOp:
+ * @controller: the ifindex of the controller.
+ * @port: the ifindex of the port.
+ * @result: (out): zero on success or a negative nm-errno.
+ *
+ * One port to attach with nm_platform_link_attach_port_batch().
+ */
+typedef struct {
+    int controller;
+    int port;
+    int result;
+} NMPlatformLinkAttachPortOp;
+
+/*****************************************************************************/
+
 struct _NMPlatformPrivate;
 
 struct _NMPlatform {
@@ -1176,6 +1359,7 @@ typedef struct {
                             NMPlatformLinkChangeFlags     flags);
     gboolean (*link_delete)(NMPlatform *self, int ifindex);
     gboolean (*link_refresh)(NMPlatform *self, int ifindex);
+    void (*link_refresh_all)(NMPlatform *self);
     gboolean (*link_set_netns)(NMPlatform *self, int ifindex, int netns_fd);
     int (*link_change_flags)(NMPlatform *platform,
                              int         ifindex,
@@ -1190,6 +1374,7 @@ typedef struct {
                                                    NMPLinkAddress *out_address);
     int (*link_set_address)(NMPlatform *self, int ifindex, gconstpointer address, size_t length);
     int (*link_set_mtu)(NMPlatform *self, int ifindex, guint32 mtu);
+    int (*link_set_xdp)(NMPlatform *self, int ifindex, int prog_fd, guint32 xdp_flags);
     gboolean (*link_set_name)(NMPlatform *self, int ifindex, const char *name);
     void (*link_set_sriov_params_async)(NMPlatform             *self,
                                         int                     ifindex,
@@ -1203,6 +1388,11 @@ typedef struct {
                                       gboolean                    on_controller,
                                       const NMPlatformBridgeVlan *vlans,
                                       guint                       num_vlans);
+    gboolean (*link_delete_bridge_vlans)(NMPlatform                 *self,
+                                         int                         ifindex,
+                                         gboolean                    on_controller,
+                                         const NMPlatformBridgeVlan *vlans,
+                                         guint                       num_vlans);
     gboolean (*link_get_bridge_vlans)(NMPlatform            *self,
                                       int                    ifindex,
                                       NMPlatformBridgeVlan **out_vlans,
@@ -1223,6 +1413,8 @@ typedef struct {
     gboolean (*link_supports_carrier_detect)(NMPlatform *self, int ifindex);
     gboolean (*link_supports_vlans)(NMPlatform *self, int ifindex);
     gboolean (*link_supports_sriov)(NMPlatform *self, int ifindex);
+    void (*link_prefetch_probes)(NMPlatform *self, const int *ifindexes, guint len);
+    void (*link_prefetch_clear)(NMPlatform *self);
 
     gboolean (*link_attach_port)(NMPlatform *self, int controller, int port);
     gboolean (*link_release_port)(NMPlatform *self, int controller, int port);
@@ -1332,6 +1524,29 @@ typedef struct {
                         NMPObject  *obj_stack,
                         char      **out_extack_msg);
 
+    /* Optional. Send many address and route operations pipelined and collect
+     * the per operation results afterwards. If unimplemented, nm_platform_object_batch()
+     * falls back to the ip*_address_add(), ip*_address_delete(), ip_route_add()
+     * and object_delete() functions. */
+    void (*object_batch)(NMPlatform *self, NMPlatformObjectBatchOp *ops, guint n_ops);
+
+    /* Optional. Create many links pipelined. Operations that already have a
+     * non-zero result are skipped. If unimplemented, nm_platform_link_add_batch()
+     * falls back to link_add(). */
+    void (*link_add_batch)(NMPlatform *self, NMPlatformLinkAddOp *ops, guint n_ops);
+
+    /* Optional. Attach many ports pipelined. Operations that already have a
+     * non-zero result are skipped. If unimplemented, nm_platform_link_attach_port_batch()
+     * falls back to link_attach_port(). */
+    void (*link_attach_port_batch)(NMPlatform                 *self,
+                                   NMPlatformLinkAttachPortOp *ops,
+                                   guint                       n_ops);
+
+    /* Optional. Restrict the routing tables from which routes are tracked. */
+    void (*ip_route_set_tracked_tables)(NMPlatform    *self,
+                                        const guint32 *tables,
+                                        guint          n_tables);
+
     int (*ip_route_get)(NMPlatform   *self,
                         int           addr_family,
                         gconstpointer address,
@@ -1339,10 +1554,17 @@ typedef struct {
                         int           oif_ifindex,
                         NMPObject   **out_route);
 
+    /* Optional. Set the maximum size up to which the netlink receive buffer
+     * grows after overruns. */
+    void (*netlink_set_rcvbuf_max)(NMPlatform *self, int rcvbuf_max);
+
     int (*routing_rule_add)(NMPlatform                  *self,
                             NMPNlmFlags                  flags,
                             const NMPlatformRoutingRule *routing_rule);
 
+    int (*ip_nexthop_add)(NMPlatform *self, NMPNlmFlags flags, const NMPlatformNexthop *nexthop);
+    int (*ip_nexthop_delete)(NMPlatform *self, guint32 id);
+
     int (*qdisc_add)(NMPlatform *self, NMPNlmFlags flags, const NMPlatformQdisc *qdisc);
     int (*qdisc_delete)(NMPlatform *self, int ifindex, guint32 parent, gboolean log_error);
 
@@ -1355,12 +1577,22 @@ typedef struct {
 
     GPtrArray *(*mptcp_addrs_dump)(NMPlatform *self);
 
+    GPtrArray *(*neigh_dump)(NMPlatform *self, int addr_family, int ifindex);
+
     gboolean (*ethtool_get_pause)(NMPlatform *self, int ifindex, NMEthtoolPauseState *pause);
     gboolean (*ethtool_set_pause)(NMPlatform *self, int ifindex, const NMEthtoolPauseState *pause);
     gboolean (*ethtool_get_eee)(NMPlatform *self, int ifindex, NMEthtoolEEEState *eee);
     gboolean (*ethtool_set_eee)(NMPlatform *self, int ifindex, const NMEthtoolEEEState *eee);
     gboolean (*ethtool_get_ring)(NMPlatform *self, int ifindex, NMEthtoolRingState *ring);
     gboolean (*ethtool_set_ring)(NMPlatform *self, int ifindex, const NMEthtoolRingState *ring);
+    gboolean (*ethtool_get_channels)(NMPlatform             *self,
+                                     int                     ifindex,
+                                     NMEthtoolChannelsState *channels);
+    gboolean (*ethtool_set_channels)(NMPlatform                   *self,
+                                     int                           ifindex,
+                                     const NMEthtoolChannelsState *channels);
+    NMEthtoolRssState *(*ethtool_get_rss)(NMPlatform *self, int ifindex);
+    gboolean (*ethtool_set_rss)(NMPlatform *self, int ifindex, const NMEthtoolRssState *rss);
 } NMPlatformClass;
 
 /* NMPlatform signals
@@ -1383,6 +1615,16 @@ typedef struct {
 #define NM_PLATFORM_SIGNAL_QDISC_CHANGED        "qdisc-changed"
 #define NM_PLATFORM_SIGNAL_TFILTER_CHANGED      "tfilter-changed"
 
+/* Emitted with the ifindex when nl80211 reports a scan or MLME event (like
+ * a roam, a disconnect or a connection quality notification) for a Wi-Fi
+ * interface. The link quality may have changed and can be queried again. */
+#define NM_PLATFORM_SIGNAL_WIFI_EVENT "wifi-event"
+
+/* Emitted after a full dump of the rtnetlink objects completed, that is
+ * after the initial fill of the cache and after a resync following an
+ * overrun of the netlink socket. */
+#define NM_PLATFORM_SIGNAL_RESYNC_DONE "resync-done"
+
 const char *nm_platform_signal_change_type_to_string(NMPlatformSignalChangeType change_type);
 
 /*****************************************************************************/
@@ -1698,6 +1940,8 @@ int nm_platform_link_add(NMPlatform            *self,
                          gconstpointer          extra_data,
                          const NMPlatformLink **out_link);
 
+void nm_platform_link_add_batch(NMPlatform *self, NMPlatformLinkAddOp *ops, guint n_ops);
+
 int nm_platform_link_change_extra(NMPlatform   *self,
                                   NMLinkType    type,
                                   int           ifindex,
@@ -2028,6 +2272,7 @@ gboolean     nm_platform_link_supports_ports(NMPlatform *self, int ifindex);
 const char  *nm_platform_link_get_type_name(NMPlatform *self, int ifindex);
 
 gboolean nm_platform_link_refresh(NMPlatform *self, int ifindex);
+void     nm_platform_link_refresh_all(NMPlatform *self);
 void     nm_platform_process_events(NMPlatform *self);
 
 const NMPlatformLink *
@@ -2084,6 +2329,7 @@ gboolean nm_platform_link_get_permanent_address(NMPlatform           *self,
                                                 NMPLinkAddress       *out_address);
 int nm_platform_link_set_address(NMPlatform *self, int ifindex, const void *address, size_t length);
 int nm_platform_link_set_mtu(NMPlatform *self, int ifindex, guint32 mtu);
+int nm_platform_link_set_xdp(NMPlatform *self, int ifindex, int prog_fd, guint32 xdp_flags);
 gboolean nm_platform_link_set_name(NMPlatform *self, int ifindex, const char *name);
 
 void nm_platform_link_set_sriov_params_async(NMPlatform             *self,
@@ -2100,6 +2346,11 @@ gboolean nm_platform_link_set_bridge_vlans(NMPlatform                 *self,
                                            gboolean                    on_controller,
                                            const NMPlatformBridgeVlan *vlans,
                                            guint                       num_vlans);
+gboolean nm_platform_link_delete_bridge_vlans(NMPlatform                 *self,
+                                              int                         ifindex,
+                                              gboolean                    on_controller,
+                                              const NMPlatformBridgeVlan *vlans,
+                                              guint                       num_vlans);
 gboolean nm_platform_link_get_bridge_vlans(NMPlatform            *self,
                                            int                    ifindex,
                                            NMPlatformBridgeVlan **out_vlans,
@@ -2121,7 +2372,13 @@ gboolean nm_platform_link_supports_carrier_detect(NMPlatform *self, int ifindex)
 gboolean nm_platform_link_supports_vlans(NMPlatform *self, int ifindex);
 gboolean nm_platform_link_supports_sriov(NMPlatform *self, int ifindex);
 
+void nm_platform_link_prefetch_probes(NMPlatform *self, const int *ifindexes, guint len);
+void nm_platform_link_prefetch_clear(NMPlatform *self);
+
 gboolean nm_platform_link_attach_port(NMPlatform *self, int controller, int port);
+void     nm_platform_link_attach_port_batch(NMPlatform                 *self,
+                                            NMPlatformLinkAttachPortOp *ops,
+                                            guint                       n_ops);
 gboolean nm_platform_link_release_port(NMPlatform *self, int controller, int port);
 
 gboolean nm_platform_sysctl_controller_set_option(NMPlatform *self,
@@ -2281,6 +2538,8 @@ int nm_platform_link_wireguard_change(NMPlatform                               *
 
 gboolean nm_platform_object_delete(NMPlatform *self, const NMPObject *route);
 
+void nm_platform_object_batch(NMPlatform *self, NMPlatformObjectBatchOp *ops, guint n_ops);
+
 gboolean nm_platform_ip4_address_add(NMPlatform *self,
                                      int         ifindex,
                                      in_addr_t   address,
@@ -2342,7 +2601,8 @@ gboolean nm_platform_ip_address_sync(NMPlatform           *self,
                                      int                   ifindex,
                                      GPtrArray            *known_addresses,
                                      GPtrArray            *addresses_prune,
-                                     NMPIPAddressSyncFlags flags);
+                                     NMPIPAddressSyncFlags flags,
+                                     GPtrArray           **out_addresses_failed);
 
 GPtrArray *
 nm_platform_ip_address_get_prune_list(NMPlatform            *self,
@@ -2413,14 +2673,6 @@ nm_platform_ip_route_get_gateway(int addr_family, const NMPlatformIPRoute *route
     return &((NMPlatformIP6Route *) route)->gateway;
 }
 
-static inline const NMIPAddrTyped *
-nm_platform_ip4_route_get_via(const NMPlatformIP4Route *route)
-{
-    nm_assert(route);
-
-    return &route->via;
-}
-
 static inline gconstpointer
 nm_platform_ip_route_get_pref_src(int addr_family, const NMPlatformIPRoute *route)
 {
@@ -2459,6 +2711,20 @@ gboolean nm_platform_ip_route_sync(NMPlatform *self,
 
 gboolean nm_platform_ip_route_flush(NMPlatform *self, int addr_family, int ifindex);
 
+void nm_platform_ip_route_set_tracked_tables(NMPlatform    *self,
+                                             const guint32 *tables,
+                                             guint          n_tables);
+
+void nm_platform_netlink_set_rcvbuf_max(NMPlatform *self, int rcvbuf_max);
+
+void nm_platform_trace_set_size(NMPlatform *self, guint size);
+void nm_platform_trace_record(NMPlatform                *self,
+                              const char                *what,
+                              NMPlatformSignalChangeType change_type,
+                              const NMPObject           *obj_old,
+                              const NMPObject           *obj_new);
+void nm_platform_trace_dump(NMPlatform *self);
+
 int nm_platform_ip_route_get(NMPlatform   *self,
                              int           addr_family,
                              gconstpointer address,
@@ -2470,6 +2736,11 @@ int nm_platform_routing_rule_add(NMPlatform                  *self,
                                  NMPNlmFlags                  flags,
                                  const NMPlatformRoutingRule *routing_rule);
 
+int nm_platform_ip_nexthop_add(NMPlatform              *self,
+                               NMPNlmFlags              flags,
+                               const NMPlatformNexthop *nexthop);
+int nm_platform_ip_nexthop_delete(NMPlatform *self, guint32 id);
+
 int nm_platform_qdisc_add(NMPlatform *self, NMPNlmFlags flags, const NMPlatformQdisc *qdisc);
 int nm_platform_qdisc_delete(NMPlatform *self, int ifindex, guint32 parent, gboolean log_error);
 int nm_platform_tfilter_add(NMPlatform *self, NMPNlmFlags flags, const NMPlatformTfilter *tfilter);
@@ -2534,6 +2805,8 @@ nm_platform_wireguard_peer_to_string(const struct _NMPWireGuardPeer *peer, char
 const char *
 nm_platform_mptcp_addr_to_string(const NMPlatformMptcpAddr *mptcp_addr, char *buf, gsize len);
 
+const char *nm_platform_neigh_to_string(const NMPlatformNeigh *neigh, char *buf, gsize len);
+
 int nm_platform_link_cmp(const NMPlatformLink *a, const NMPlatformLink *b);
 int nm_platform_lnk_bond_cmp(const NMPlatformLnkBond *a, const NMPlatformLnkBond *b);
 int nm_platform_lnk_bridge_cmp(const NMPlatformLnkBridge *a, const NMPlatformLnkBridge *b);
@@ -2580,6 +2853,8 @@ int nm_platform_tfilter_cmp(const NMPlatformTfilter *a, const NMPlatformTfilter
 
 int nm_platform_mptcp_addr_cmp(const NMPlatformMptcpAddr *a, const NMPlatformMptcpAddr *b);
 
+int nm_platform_neigh_cmp(const NMPlatformNeigh *a, const NMPlatformNeigh *b);
+
 void nm_platform_link_hash_update(const NMPlatformLink *obj, NMHashState *h);
 void nm_platform_link_bond_port_hash_update(const NMPlatformLinkBondPort *obj, NMHashState *h);
 void nm_platform_link_bridge_port_hash_update(const NMPlatformLinkBridgePort *obj, NMHashState *h);
@@ -2637,6 +2912,8 @@ void nm_platform_mptcp_addr_hash_update(const NMPlatformMptcpAddr *obj, NMHashSt
 guint    nm_platform_mptcp_addr_index_addr_cmp(gconstpointer data);
 gboolean nm_platform_mptcp_addr_index_addr_equal(gconstpointer data_a, gconstpointer data_b);
 
+void nm_platform_neigh_hash_update(const NMPlatformNeigh *obj, NMHashState *h);
+
 #define NM_PLATFORM_LINK_FLAGS2STR_MAX_LEN ((gsize) 165)
 
 gboolean nm_platform_ethtool_set_wake_on_lan(NMPlatform              *self,
@@ -2681,6 +2958,11 @@ gboolean nm_platform_ethtool_set_channels(NMPlatform                   *self,
                                           int                           ifindex,
                                           const NMEthtoolChannelsState *channels);
 
+NMEthtoolRssState *nm_platform_ethtool_get_rss(NMPlatform *self, int ifindex);
+
+gboolean
+nm_platform_ethtool_set_rss(NMPlatform *self, int ifindex, const NMEthtoolRssState *rss);
+
 gboolean nm_platform_ethtool_get_fec_mode(NMPlatform *self, int ifindex, uint32_t *fec_mode);
 
 gboolean nm_platform_ethtool_set_fec_mode(NMPlatform *self, int ifindex, uint32_t fec_mode);
@@ -2700,6 +2982,8 @@ void nm_platform_ip4_dev_route_blacklist_set(NMPlatform *self,
 
 struct _NMDedupMultiIndex *nm_platform_get_multi_idx(NMPlatform *self);
 
+guint nm_platform_cache_get_stats(NMPlatform *self, NMPObjectType obj_type, gsize *out_bytes);
+
 /*****************************************************************************/
 
 guint16 nm_platform_genl_get_family_id(NMPlatform *self, NMPGenlFamilyType family_type);
@@ -2709,6 +2993,13 @@ nm_platform_mptcp_addr_update(NMPlatform *self, NMOptionBool add, const NMPlatfo
 
 GPtrArray *nm_platform_mptcp_addrs_dump(NMPlatform *self);
 
+GPtrArray *nm_platform_neigh_dump(NMPlatform *self, int addr_family, int ifindex);
+
+gboolean nm_platform_neigh_sync(NMPlatform *self,
+                                int         ifindex,
+                                GPtrArray  *known_neighs,
+                                GPtrArray  *neighs_prune);
+
 gboolean nm_platform_ip6_dadfailed_check(NMPlatform *self, int ifindex, const struct in6_addr *ip6);
 void     nm_platform_ip6_dadfailed_set(NMPlatform            *self,
                                        int                    ifindex,
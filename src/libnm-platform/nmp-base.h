@@ -128,6 +128,15 @@ typedef struct {
     guint32 combined;
 } NMEthtoolChannelsState;
 
+typedef struct {
+    /* The ETH_RSS_HASH_* bit of the hash function, or 0 for "unchanged"
+     * when setting. */
+    guint32 hfunc;
+    /* The number of entries in @indir, or 0 for "unchanged" when setting. */
+    guint32 indir_size;
+    guint32 indir[];
+} NMEthtoolRssState;
+
 typedef struct {
     bool enabled : 1;
 } NMEthtoolEEEState;
@@ -190,6 +199,8 @@ typedef enum _nm_packed {
 
     NMP_OBJECT_TYPE_MPTCP_ADDR,
 
+    NMP_OBJECT_TYPE_NEIGH,
+
     __NMP_OBJECT_TYPE_LAST,
     NMP_OBJECT_TYPE_MAX = __NMP_OBJECT_TYPE_LAST - 1,
 } NMPObjectType;
@@ -197,10 +208,13 @@ typedef enum _nm_packed {
 static inline guint32
 nmp_object_type_to_flags(NMPObjectType obj_type)
 {
-    G_STATIC_ASSERT_EXPR(NMP_OBJECT_TYPE_MAX < 32);
+    /* The flags are only used for the types that can be in the platform
+     * cache. The other types (like NMP_OBJECT_TYPE_NEIGH) don't fit into
+     * 32 bits. */
+    G_STATIC_ASSERT_EXPR(NMP_OBJECT_TYPE_MPTCP_ADDR < 32);
 
     nm_assert(_NM_INT_NOT_NEGATIVE(obj_type));
-    nm_assert(obj_type < NMP_OBJECT_TYPE_MAX);
+    nm_assert(obj_type < NMP_OBJECT_TYPE_MPTCP_ADDR);
 
     return ((guint32) 1u) << obj_type;
 }
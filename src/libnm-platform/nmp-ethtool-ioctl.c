@@ -16,6 +16,12 @@
 #include <linux/version.h>
 #include <sys/ioctl.h>
 
+/* The ioctl helpers are also called from worker threads (see
+ * link_prefetch_probes() in nm-linux-platform.c). Hence, require locking
+ * from nm-logging. */
+#undef NM_THREAD_SAFE_ON_MAIN_THREAD
+#define NM_THREAD_SAFE_ON_MAIN_THREAD 0
+
 #define ONOFF(bool_val) ((bool_val) ? "on" : "off")
 
 /*****************************************************************************/
@@ -241,6 +247,7 @@ static NM_UTILS_ENUM2STR_DEFINE(_ethtool_cmd_to_string,
                                 NM_UTILS_ENUM2STR(ETHTOOL_GPERMADDR, "ETHTOOL_GPERMADDR"),
                                 NM_UTILS_ENUM2STR(ETHTOOL_GRINGPARAM, "ETHTOOL_GRINGPARAM"),
                                 NM_UTILS_ENUM2STR(ETHTOOL_GPAUSEPARAM, "ETHTOOL_GPAUSEPARAM"),
+                                NM_UTILS_ENUM2STR(ETHTOOL_GRSSH, "ETHTOOL_GRSSH"),
                                 NM_UTILS_ENUM2STR(ETHTOOL_GSET, "ETHTOOL_GSET"),
                                 NM_UTILS_ENUM2STR(ETHTOOL_GSSET_INFO, "ETHTOOL_GSSET_INFO"),
                                 NM_UTILS_ENUM2STR(ETHTOOL_GSTATS, "ETHTOOL_GSTATS"),
@@ -251,6 +258,7 @@ static NM_UTILS_ENUM2STR_DEFINE(_ethtool_cmd_to_string,
                                 NM_UTILS_ENUM2STR(ETHTOOL_SLINKSETTINGS, "ETHTOOL_SLINKSETTINGS"),
                                 NM_UTILS_ENUM2STR(ETHTOOL_SRINGPARAM, "ETHTOOL_SRINGPARAM"),
                                 NM_UTILS_ENUM2STR(ETHTOOL_SPAUSEPARAM, "ETHTOOL_SPAUSEPARAM"),
+                                NM_UTILS_ENUM2STR(ETHTOOL_SRSSH, "ETHTOOL_SRSSH"),
                                 NM_UTILS_ENUM2STR(ETHTOOL_SSET, "ETHTOOL_SSET"),
                                 NM_UTILS_ENUM2STR(ETHTOOL_SWOL, "ETHTOOL_SWOL"), );
 
@@ -1030,6 +1038,89 @@ nmp_ethtool_ioctl_set_channels(int ifindex, const NMEthtoolChannelsState *channe
     return TRUE;
 }
 
+NMEthtoolRssState *
+nmp_ethtool_ioctl_get_rss(int ifindex)
+{
+    nm_auto_socket_handle SocketHandle shandle = SOCKET_HANDLE_INIT(ifindex);
+    gs_free struct ethtool_rxfh       *rxfh    = NULL;
+    struct ethtool_rxfh                rxfh_size;
+    NMEthtoolRssState                 *rss;
+
+    g_return_val_if_fail(ifindex > 0, NULL);
+
+    /* With zero sizes, the kernel only returns the size of the table. */
+    rxfh_size = (struct ethtool_rxfh) {
+        .cmd = ETHTOOL_GRSSH,
+    };
+    if (_ethtool_call_handle(&shandle, &rxfh_size, sizeof(rxfh_size)) < 0) {
+        nm_log_trace(LOGD_PLATFORM,
+                     "ethtool[%d]: %s: failure getting RSS settings",
+                     ifindex,
+                     "get-rss");
+        return NULL;
+    }
+
+    rxfh  = g_malloc0(sizeof(*rxfh) + rxfh_size.indir_size * sizeof(guint32));
+    *rxfh = (struct ethtool_rxfh) {
+        .cmd        = ETHTOOL_GRSSH,
+        .indir_size = rxfh_size.indir_size,
+    };
+    if (rxfh_size.indir_size > 0
+        && _ethtool_call_handle(&shandle,
+                                rxfh,
+                                sizeof(*rxfh) + rxfh_size.indir_size * sizeof(guint32))
+               < 0) {
+        nm_log_trace(LOGD_PLATFORM,
+                     "ethtool[%d]: %s: failure getting RSS indirection table",
+                     ifindex,
+                     "get-rss");
+        return NULL;
+    }
+
+    rss             = g_malloc(sizeof(NMEthtoolRssState) + rxfh_size.indir_size * sizeof(guint32));
+    rss->hfunc      = rxfh_size.hfunc;
+    rss->indir_size = rxfh_size.indir_size;
+    if (rss->indir_size > 0)
+        memcpy(rss->indir, rxfh->rss_config, rss->indir_size * sizeof(guint32));
+
+    nm_log_trace(LOGD_PLATFORM,
+                 "ethtool[%d]: %s: retrieved kernel RSS settings",
+                 ifindex,
+                 "get-rss");
+    return rss;
+}
+
+gboolean
+nmp_ethtool_ioctl_set_rss(int ifindex, const NMEthtoolRssState *rss)
+{
+    gs_free struct ethtool_rxfh *rxfh = NULL;
+    gsize                        size;
+
+    g_return_val_if_fail(ifindex > 0, FALSE);
+    g_return_val_if_fail(rss, FALSE);
+
+    size  = sizeof(*rxfh) + rss->indir_size * sizeof(guint32);
+    rxfh  = g_malloc0(size);
+    *rxfh = (struct ethtool_rxfh) {
+        .cmd        = ETHTOOL_SRSSH,
+        .indir_size = rss->indir_size > 0 ? rss->indir_size : ETH_RXFH_INDIR_NO_CHANGE,
+        .hfunc      = rss->hfunc,
+    };
+    if (rss->indir_size > 0)
+        memcpy(rxfh->rss_config, rss->indir, rss->indir_size * sizeof(guint32));
+
+    if (_ethtool_call_once(ifindex, rxfh, size) < 0) {
+        nm_log_trace(LOGD_PLATFORM,
+                     "ethtool[%d]: %s: failure setting RSS settings",
+                     ifindex,
+                     "set-rss");
+        return FALSE;
+    }
+
+    nm_log_trace(LOGD_PLATFORM, "ethtool[%d]: %s: set kernel RSS settings", ifindex, "set-rss");
+    return TRUE;
+}
+
 gboolean
 nmp_ethtool_ioctl_get_fec_mode(int ifindex, uint32_t *fec_mode)
 {
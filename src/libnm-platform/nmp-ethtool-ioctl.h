@@ -46,6 +46,10 @@ gboolean nmp_ethtool_ioctl_get_channels(int ifindex, NMEthtoolChannelsState *cha
 
 gboolean nmp_ethtool_ioctl_set_channels(int ifindex, const NMEthtoolChannelsState *channels);
 
+NMEthtoolRssState *nmp_ethtool_ioctl_get_rss(int ifindex);
+
+gboolean nmp_ethtool_ioctl_set_rss(int ifindex, const NMEthtoolRssState *rss);
+
 gboolean nmp_ethtool_ioctl_get_fec_mode(int ifindex, uint32_t *fec_mode);
 
 gboolean nmp_ethtool_ioctl_set_fec_mode(int ifindex, uint32_t fec_mode);
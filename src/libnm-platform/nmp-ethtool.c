@@ -51,6 +51,24 @@ enum {
     ETHTOOL_MSG_TUNNEL_INFO_GET,
     ETHTOOL_MSG_FEC_GET,
     ETHTOOL_MSG_FEC_SET,
+    ETHTOOL_MSG_MODULE_EEPROM_GET,
+    ETHTOOL_MSG_STATS_GET,
+    ETHTOOL_MSG_PHC_VCLOCKS_GET,
+    ETHTOOL_MSG_MODULE_GET,
+    ETHTOOL_MSG_MODULE_SET,
+    ETHTOOL_MSG_PSE_GET,
+    ETHTOOL_MSG_PSE_SET,
+    ETHTOOL_MSG_RSS_GET,
+    ETHTOOL_MSG_PLCA_GET_CFG,
+    ETHTOOL_MSG_PLCA_SET_CFG,
+    ETHTOOL_MSG_PLCA_GET_STATUS,
+    ETHTOOL_MSG_MM_GET,
+    ETHTOOL_MSG_MM_SET,
+    ETHTOOL_MSG_MODULE_FW_FLASH_ACT,
+    ETHTOOL_MSG_PHY_GET,
+    ETHTOOL_MSG_TSCONFIG_GET,
+    ETHTOOL_MSG_TSCONFIG_SET,
+    ETHTOOL_MSG_RSS_SET,
 
     /* add new constants above here */
     __ETHTOOL_MSG_USER_CNT,
@@ -166,11 +184,12 @@ out:
 }
 
 static struct nl_msg *
-ethtool_create_msg(guint16     family_id,
-                   int         ifindex,
-                   guint8      cmd,
-                   int         header_attr,
-                   const char *log_prefix)
+ethtool_create_msg_full(guint16     family_id,
+                        int         ifindex,
+                        guint8      cmd,
+                        int         header_attr,
+                        gsize       payload_size,
+                        const char *log_prefix)
 {
     nm_auto_nlmsg struct nl_msg *msg = NULL;
     struct nlattr               *nest_header;
@@ -180,7 +199,7 @@ ethtool_create_msg(guint16     family_id,
         return NULL;
     }
 
-    msg = nlmsg_alloc(nlmsg_total_size(GENL_HDRLEN) + 200);
+    msg = nlmsg_alloc(nlmsg_total_size(GENL_HDRLEN) + 200 + payload_size);
 
     if (!genlmsg_put(msg,
                      NL_AUTO_PORT,
@@ -201,6 +220,16 @@ nla_put_failure:
     g_return_val_if_reached(NULL);
 }
 
+static struct nl_msg *
+ethtool_create_msg(guint16     family_id,
+                   int         ifindex,
+                   guint8      cmd,
+                   int         header_attr,
+                   const char *log_prefix)
+{
+    return ethtool_create_msg_full(family_id, ifindex, cmd, header_attr, 0, log_prefix);
+}
+
 /*****************************************************************************/
 /* PAUSE                                                                     */
 /*****************************************************************************/
@@ -557,3 +586,260 @@ nmp_ethtool_set_ring(struct nl_sock           *genl_sock,
 nla_put_failure:
     g_return_val_if_reached(FALSE);
 }
+
+/*****************************************************************************/
+/* CHANNELS                                                                  */
+/*****************************************************************************/
+
+enum {
+    ETHTOOL_A_CHANNELS_UNSPEC,
+    ETHTOOL_A_CHANNELS_HEADER,         /* nest - _A_HEADER_* */
+    ETHTOOL_A_CHANNELS_RX_MAX,         /* u32 */
+    ETHTOOL_A_CHANNELS_TX_MAX,         /* u32 */
+    ETHTOOL_A_CHANNELS_OTHER_MAX,      /* u32 */
+    ETHTOOL_A_CHANNELS_COMBINED_MAX,   /* u32 */
+    ETHTOOL_A_CHANNELS_RX_COUNT,       /* u32 */
+    ETHTOOL_A_CHANNELS_TX_COUNT,       /* u32 */
+    ETHTOOL_A_CHANNELS_OTHER_COUNT,    /* u32 */
+    ETHTOOL_A_CHANNELS_COMBINED_COUNT, /* u32 */
+
+    /* add new constants above here */
+    __ETHTOOL_A_CHANNELS_CNT,
+    ETHTOOL_A_CHANNELS_MAX = (__ETHTOOL_A_CHANNELS_CNT - 1)
+};
+
+static int
+ethtool_parse_channels(const struct nl_msg *msg, void *data)
+{
+    NMEthtoolChannelsState        *channels = data;
+    static const struct nla_policy policy[] = {
+        [ETHTOOL_A_CHANNELS_RX_COUNT]       = {.type = NLA_U32},
+        [ETHTOOL_A_CHANNELS_TX_COUNT]       = {.type = NLA_U32},
+        [ETHTOOL_A_CHANNELS_OTHER_COUNT]    = {.type = NLA_U32},
+        [ETHTOOL_A_CHANNELS_COMBINED_COUNT] = {.type = NLA_U32},
+    };
+    struct genlmsghdr *gnlh = nlmsg_data(nlmsg_hdr(msg));
+    struct nlattr     *tb[G_N_ELEMENTS(policy)];
+
+    *channels = (NMEthtoolChannelsState) {};
+
+    if (nla_parse_arr(tb, genlmsg_attrdata(gnlh, 0), genlmsg_attrlen(gnlh, 0), policy) < 0)
+        return NL_SKIP;
+
+    if (tb[ETHTOOL_A_CHANNELS_RX_COUNT])
+        channels->rx = nla_get_u32(tb[ETHTOOL_A_CHANNELS_RX_COUNT]);
+    if (tb[ETHTOOL_A_CHANNELS_TX_COUNT])
+        channels->tx = nla_get_u32(tb[ETHTOOL_A_CHANNELS_TX_COUNT]);
+    if (tb[ETHTOOL_A_CHANNELS_OTHER_COUNT])
+        channels->other = nla_get_u32(tb[ETHTOOL_A_CHANNELS_OTHER_COUNT]);
+    if (tb[ETHTOOL_A_CHANNELS_COMBINED_COUNT])
+        channels->combined = nla_get_u32(tb[ETHTOOL_A_CHANNELS_COMBINED_COUNT]);
+
+    return NL_OK;
+}
+
+gboolean
+nmp_ethtool_get_channels(struct nl_sock         *genl_sock,
+                         guint16                 family_id,
+                         int                     ifindex,
+                         NMEthtoolChannelsState *channels)
+{
+    nm_auto_nlmsg struct nl_msg *msg     = NULL;
+    gs_free char                *err_msg = NULL;
+    int                          r;
+
+    g_return_val_if_fail(channels, FALSE);
+
+    _LOGT("get-channels: start");
+    *channels = (NMEthtoolChannelsState) {};
+
+    msg = ethtool_create_msg(family_id,
+                             ifindex,
+                             ETHTOOL_MSG_CHANNELS_GET,
+                             ETHTOOL_A_CHANNELS_HEADER,
+                             "get-channels");
+    if (!msg)
+        return FALSE;
+
+    r = ethtool_send_and_recv(genl_sock,
+                              ifindex,
+                              msg,
+                              ethtool_parse_channels,
+                              channels,
+                              &err_msg,
+                              "get-channels");
+    if (r < 0)
+        return FALSE;
+
+    _LOGT("get-channels: rx %u tx %u other %u combined %u",
+          channels->rx,
+          channels->tx,
+          channels->other,
+          channels->combined);
+
+    return TRUE;
+}
+
+gboolean
+nmp_ethtool_set_channels(struct nl_sock               *genl_sock,
+                         guint16                       family_id,
+                         int                           ifindex,
+                         const NMEthtoolChannelsState *channels)
+{
+    nm_auto_nlmsg struct nl_msg *msg     = NULL;
+    gs_free char                *err_msg = NULL;
+    int                          r;
+
+    g_return_val_if_fail(channels, FALSE);
+
+    _LOGT("set-channels: rx %u tx %u other %u combined %u",
+          channels->rx,
+          channels->tx,
+          channels->other,
+          channels->combined);
+
+    msg = ethtool_create_msg(family_id,
+                             ifindex,
+                             ETHTOOL_MSG_CHANNELS_SET,
+                             ETHTOOL_A_CHANNELS_HEADER,
+                             "set-channels");
+    if (!msg)
+        return FALSE;
+
+    NLA_PUT_U32(msg, ETHTOOL_A_CHANNELS_RX_COUNT, channels->rx);
+    NLA_PUT_U32(msg, ETHTOOL_A_CHANNELS_TX_COUNT, channels->tx);
+    NLA_PUT_U32(msg, ETHTOOL_A_CHANNELS_OTHER_COUNT, channels->other);
+    NLA_PUT_U32(msg, ETHTOOL_A_CHANNELS_COMBINED_COUNT, channels->combined);
+
+    r = ethtool_send_and_recv(genl_sock, ifindex, msg, NULL, NULL, &err_msg, "set-channels");
+    if (r < 0)
+        return FALSE;
+
+    _LOGT("set-channels: succeeded");
+
+    return TRUE;
+nla_put_failure:
+    g_return_val_if_reached(FALSE);
+}
+
+/*****************************************************************************/
+/* RSS                                                                       */
+/*****************************************************************************/
+
+enum {
+    ETHTOOL_A_RSS_UNSPEC,
+    ETHTOOL_A_RSS_HEADER,        /* nest - _A_HEADER_* */
+    ETHTOOL_A_RSS_CONTEXT,       /* u32 */
+    ETHTOOL_A_RSS_HFUNC,         /* u32 */
+    ETHTOOL_A_RSS_INDIR,         /* binary, u32 array */
+    ETHTOOL_A_RSS_HKEY,          /* binary */
+    ETHTOOL_A_RSS_INPUT_XFRM,    /* u32 */
+    ETHTOOL_A_RSS_START_CONTEXT, /* u32 */
+
+    /* add new constants above here */
+    __ETHTOOL_A_RSS_CNT,
+    ETHTOOL_A_RSS_MAX = (__ETHTOOL_A_RSS_CNT - 1)
+};
+
+static int
+ethtool_parse_rss(const struct nl_msg *msg, void *data)
+{
+    NMEthtoolRssState            **p_rss    = data;
+    static const struct nla_policy policy[] = {
+        [ETHTOOL_A_RSS_HFUNC] = {.type = NLA_U32},
+        [ETHTOOL_A_RSS_INDIR] = {.type = NLA_UNSPEC},
+    };
+    struct genlmsghdr *gnlh = nlmsg_data(nlmsg_hdr(msg));
+    struct nlattr     *tb[G_N_ELEMENTS(policy)];
+    NMEthtoolRssState *rss;
+    guint32            indir_size = 0;
+
+    if (nla_parse_arr(tb, genlmsg_attrdata(gnlh, 0), genlmsg_attrlen(gnlh, 0), policy) < 0)
+        return NL_SKIP;
+
+    if (tb[ETHTOOL_A_RSS_INDIR])
+        indir_size = nla_len(tb[ETHTOOL_A_RSS_INDIR]) / sizeof(guint32);
+
+    rss             = g_malloc0(sizeof(NMEthtoolRssState) + indir_size * sizeof(guint32));
+    rss->indir_size = indir_size;
+    if (tb[ETHTOOL_A_RSS_HFUNC])
+        rss->hfunc = nla_get_u32(tb[ETHTOOL_A_RSS_HFUNC]);
+    if (indir_size > 0)
+        memcpy(rss->indir, nla_data(tb[ETHTOOL_A_RSS_INDIR]), indir_size * sizeof(guint32));
+
+    g_free(*p_rss);
+    *p_rss = rss;
+    return NL_OK;
+}
+
+NMEthtoolRssState *
+nmp_ethtool_get_rss(struct nl_sock *genl_sock, guint16 family_id, int ifindex)
+{
+    nm_auto_nlmsg struct nl_msg *msg     = NULL;
+    gs_free char                *err_msg = NULL;
+    gs_free NMEthtoolRssState   *rss     = NULL;
+    int                          r;
+
+    _LOGT("get-rss: start");
+
+    msg = ethtool_create_msg(family_id,
+                             ifindex,
+                             ETHTOOL_MSG_RSS_GET,
+                             ETHTOOL_A_RSS_HEADER,
+                             "get-rss");
+    if (!msg)
+        return NULL;
+
+    r = ethtool_send_and_recv(genl_sock,
+                              ifindex,
+                              msg,
+                              ethtool_parse_rss,
+                              &rss,
+                              &err_msg,
+                              "get-rss");
+    if (r < 0 || !rss)
+        return NULL;
+
+    _LOGT("get-rss: hfunc 0x%x, indirection table size %u", rss->hfunc, rss->indir_size);
+
+    return g_steal_pointer(&rss);
+}
+
+gboolean
+nmp_ethtool_set_rss(struct nl_sock          *genl_sock,
+                    guint16                  family_id,
+                    int                      ifindex,
+                    const NMEthtoolRssState *rss)
+{
+    nm_auto_nlmsg struct nl_msg *msg     = NULL;
+    gs_free char                *err_msg = NULL;
+    int                          r;
+
+    g_return_val_if_fail(rss, FALSE);
+
+    _LOGT("set-rss: hfunc 0x%x, indirection table size %u", rss->hfunc, rss->indir_size);
+
+    msg = ethtool_create_msg_full(family_id,
+                                  ifindex,
+                                  ETHTOOL_MSG_RSS_SET,
+                                  ETHTOOL_A_RSS_HEADER,
+                                  nla_total_size(rss->indir_size * sizeof(guint32)),
+                                  "set-rss");
+    if (!msg)
+        return FALSE;
+
+    if (rss->hfunc != 0)
+        NLA_PUT_U32(msg, ETHTOOL_A_RSS_HFUNC, rss->hfunc);
+    if (rss->indir_size > 0)
+        NLA_PUT(msg, ETHTOOL_A_RSS_INDIR, rss->indir_size * sizeof(guint32), rss->indir);
+
+    r = ethtool_send_and_recv(genl_sock, ifindex, msg, NULL, NULL, &err_msg, "set-rss");
+    if (r < 0)
+        return FALSE;
+
+    _LOGT("set-rss: succeeded");
+
+    return TRUE;
+nla_put_failure:
+    g_return_val_if_reached(FALSE);
+}
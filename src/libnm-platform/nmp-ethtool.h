@@ -32,4 +32,19 @@ gboolean nmp_ethtool_set_ring(struct nl_sock           *genl_sock,
                               int                       ifindex,
                               const NMEthtoolRingState *ring);
 
+gboolean nmp_ethtool_get_channels(struct nl_sock         *genl_sock,
+                                  guint16                 family_id,
+                                  int                     ifindex,
+                                  NMEthtoolChannelsState *channels);
+gboolean nmp_ethtool_set_channels(struct nl_sock               *genl_sock,
+                                  guint16                       family_id,
+                                  int                           ifindex,
+                                  const NMEthtoolChannelsState *channels);
+
+NMEthtoolRssState *nmp_ethtool_get_rss(struct nl_sock *genl_sock, guint16 family_id, int ifindex);
+gboolean           nmp_ethtool_set_rss(struct nl_sock          *genl_sock,
+                                       guint16                  family_id,
+                                       int                      ifindex,
+                                       const NMEthtoolRssState *rss);
+
 #endif /* __NMP_ETHTOOL_H__ */
@@ -959,17 +959,93 @@ keep_and_next:
     }
 }
 
+typedef struct {
+    const NMPObject *obj;
+    bool             is_delete;
+} SyncOp;
+
+static void
+_sync_ops_append(GArray **p_sync_ops, const NMPObject *obj, gboolean is_delete)
+{
+    SyncOp sync_op = {
+        .obj       = nmp_object_ref(obj),
+        .is_delete = is_delete,
+    };
+
+    if (!*p_sync_ops)
+        *p_sync_ops = g_array_new(FALSE, FALSE, sizeof(SyncOp));
+    g_array_append_val(*p_sync_ops, sync_op);
+}
+
+static void
+_sync_ops_commit(NMPGlobalTracker *self, GArray *sync_ops)
+{
+    gs_free NMPlatformObjectBatchOp *ops        = NULL;
+    gs_free NMPObject               *obj_stacks = NULL;
+    guint                            i;
+
+    if (!sync_ops)
+        return;
+
+    /* Pass all requests at once to the platform, which can pipeline them. On hosts
+     * with one routing rule per tenant, committing them one by one is slow. The
+     * platform processes the requests in order, so deleting a conflicting object
+     * before adding the tracked one still works. */
+
+    ops        = g_new0(NMPlatformObjectBatchOp, sync_ops->len);
+    obj_stacks = g_new(NMPObject, sync_ops->len);
+
+    for (i = 0; i < sync_ops->len; i++) {
+        const SyncOp    *sync_op   = &nm_g_array_index(sync_ops, SyncOp, i);
+        const NMPObject *obj       = sync_op->obj;
+        NMPObject       *obj_stack = &obj_stacks[i];
+        NMPNlmFlags      nlm_flags = 0;
+
+        nmp_object_stackinit(obj_stack, NMP_OBJECT_GET_TYPE(obj), &obj->object);
+        if (NMP_OBJECT_GET_TYPE(obj) == NMP_OBJECT_TYPE_IP4_ROUTE
+            && obj->ip4_route.n_nexthops > 1u) {
+            /* @sync_ops keeps @obj alive, so we can alias the extra_nexthops. */
+            nm_assert(obj->_ip4_route.extra_nexthops);
+            obj_stack->_ip4_route.extra_nexthops = obj->_ip4_route.extra_nexthops;
+        }
+
+        if (!sync_op->is_delete) {
+            if (NMP_OBJECT_GET_TYPE(obj) == NMP_OBJECT_TYPE_ROUTING_RULE)
+                nlm_flags = NMP_NLM_FLAG_ADD;
+            else {
+                nlm_flags = NMP_NLM_FLAG_APPEND;
+                nm_platform_ip_route_normalize(NMP_OBJECT_GET_ADDR_FAMILY(obj_stack),
+                                               NMP_OBJECT_CAST_IP_ROUTE(obj_stack));
+            }
+        }
+
+        ops[i] = (NMPlatformObjectBatchOp) {
+            .obj_stack = obj_stack,
+            .nlm_flags = nlm_flags,
+            .is_delete = sync_op->is_delete,
+        };
+    }
+
+    nm_platform_object_batch(self->platform, ops, sync_ops->len);
+
+    for (i = 0; i < sync_ops->len; i++) {
+        /* Failures were already logged by the platform. Like before, sync() does
+         * not handle them further. */
+        g_free(ops[i].extack_msg);
+        nmp_object_unref(nm_g_array_index(sync_ops, SyncOp, i).obj);
+    }
+}
+
 void
 nmp_global_tracker_sync(NMPGlobalTracker *self, NMPObjectType obj_type, gboolean keep_deleted)
 {
     char                         sbuf[NM_UTILS_TO_STRING_BUFFER_SIZE];
     const NMDedupMultiHeadEntry *pl_head_entry;
     const NMPObject             *plobj;
-    gs_unref_ptrarray GPtrArray *objs_to_delete = NULL;
+    gs_unref_array GArray       *sync_ops = NULL;
     TrackObjData                *obj_data;
     TrackObjData                *obj_data_safe;
     CList                       *by_obj_lst_head;
-    guint                        i;
     const TrackData             *td_best;
 
     g_return_if_fail(NMP_IS_GLOBAL_TRACKER(self));
@@ -1024,20 +1100,12 @@ nmp_global_tracker_sync(NMPGlobalTracker *self, NMPObjectType obj_type, gboolean
                 continue;
             }
 
-            if (!objs_to_delete)
-                objs_to_delete = g_ptr_array_new_with_free_func((GDestroyNotify) nmp_object_unref);
-
-            g_ptr_array_add(objs_to_delete, (gpointer) nmp_object_ref(plobj));
+            _sync_ops_append(&sync_ops, plobj, TRUE);
 
             obj_data->config_state = CONFIG_STATE_REMOVED_BY_US;
         }
     }
 
-    if (objs_to_delete) {
-        for (i = 0; i < objs_to_delete->len; i++)
-            nm_platform_object_delete(self->platform, objs_to_delete->pdata[i]);
-    }
-
     by_obj_lst_head = _by_obj_lst_head(self, obj_type);
 
     c_list_for_each_entry_safe (obj_data, obj_data_safe, by_obj_lst_head, by_obj_lst) {
@@ -1092,18 +1160,15 @@ nmp_global_tracker_sync(NMPGlobalTracker *self, NMPObjectType obj_type, gboolean
             }
             if (c == 0)
                 continue;
-            nm_platform_object_delete(self->platform, plobj);
+            _sync_ops_append(&sync_ops, plobj, TRUE);
         }
 
         obj_data->config_state = CONFIG_STATE_ADDED_BY_US;
 
-        if (obj_type == NMP_OBJECT_TYPE_ROUTING_RULE) {
-            nm_platform_routing_rule_add(self->platform,
-                                         NMP_NLM_FLAG_ADD,
-                                         NMP_OBJECT_CAST_ROUTING_RULE(obj_data->obj));
-        } else
-            nm_platform_ip_route_add(self->platform, NMP_NLM_FLAG_APPEND, obj_data->obj, NULL);
+        _sync_ops_append(&sync_ops, obj_data->obj, FALSE);
     }
+
+    _sync_ops_commit(self, sync_ops);
 }
 
 /*****************************************************************************/
@@ -7,6 +7,7 @@
 
 #include "nmp-object.h"
 
+#include <stdlib.h>
 #include <unistd.h>
 #include <linux/rtnetlink.h>
 #include <linux/if.h>
@@ -439,6 +440,74 @@ _idx_obj_part(const DedupMultiIdxType *idx_type,
         }
         return 1;
 
+    case NMP_CACHE_ID_TYPE_ROUTES_BY_DESTINATION:
+        obj_type = NMP_OBJECT_GET_TYPE(obj_a);
+        if (!NM_IN_SET(obj_type, NMP_OBJECT_TYPE_IP4_ROUTE, NMP_OBJECT_TYPE_IP6_ROUTE)
+            || NMP_OBJECT_CAST_IP_ROUTE(obj_a)->ifindex < 0) {
+            if (h)
+                nm_hash_update_val(h, obj_a);
+            return 0;
+        }
+        if (obj_b) {
+            if (obj_type != NMP_OBJECT_GET_TYPE(obj_b)
+                || NMP_OBJECT_CAST_IP_ROUTE(obj_b)->ifindex < 0
+                || obj_a->ip_route.plen != obj_b->ip_route.plen
+                || nm_platform_ip_route_get_effective_table(&obj_a->ip_route)
+                       != nm_platform_ip_route_get_effective_table(&obj_b->ip_route))
+                return 0;
+            if (obj_type == NMP_OBJECT_TYPE_IP4_ROUTE) {
+                return nm_ip4_addr_clear_host_address(obj_a->ip4_route.network,
+                                                      obj_a->ip4_route.plen)
+                       == nm_ip4_addr_clear_host_address(obj_b->ip4_route.network,
+                                                         obj_b->ip4_route.plen);
+            }
+            return nm_ip6_addr_same_prefix(&obj_a->ip6_route.network,
+                                           &obj_b->ip6_route.network,
+                                           obj_a->ip6_route.plen);
+        }
+        if (h) {
+            nm_hash_update_vals(h,
+                                idx_type->cache_id_type,
+                                obj_type,
+                                nm_platform_ip_route_get_effective_table(&obj_a->ip_route),
+                                obj_a->ip_route.plen);
+            if (obj_type == NMP_OBJECT_TYPE_IP4_ROUTE) {
+                nm_hash_update_val(h,
+                                   nm_ip4_addr_clear_host_address(obj_a->ip4_route.network,
+                                                                  obj_a->ip4_route.plen));
+            } else {
+                struct in6_addr a;
+
+                nm_hash_update_val(h,
+                                   *nm_ip6_addr_clear_host_address(&a,
+                                                                   &obj_a->ip6_route.network,
+                                                                   obj_a->ip6_route.plen));
+            }
+        }
+        return 1;
+
+    case NMP_CACHE_ID_TYPE_ROUTES_BY_TABLE:
+        obj_type = NMP_OBJECT_GET_TYPE(obj_a);
+        if (!NM_IN_SET(obj_type, NMP_OBJECT_TYPE_IP4_ROUTE, NMP_OBJECT_TYPE_IP6_ROUTE)
+            || NMP_OBJECT_CAST_IP_ROUTE(obj_a)->ifindex < 0) {
+            if (h)
+                nm_hash_update_val(h, obj_a);
+            return 0;
+        }
+        if (obj_b) {
+            return obj_type == NMP_OBJECT_GET_TYPE(obj_b)
+                   && NMP_OBJECT_CAST_IP_ROUTE(obj_b)->ifindex >= 0
+                   && nm_platform_ip_route_get_effective_table(&obj_a->ip_route)
+                          == nm_platform_ip_route_get_effective_table(&obj_b->ip_route);
+        }
+        if (h) {
+            nm_hash_update_vals(h,
+                                idx_type->cache_id_type,
+                                obj_type,
+                                nm_platform_ip_route_get_effective_table(&obj_a->ip_route));
+        }
+        return 1;
+
     case NMP_CACHE_ID_TYPE_OBJECT_BY_ADDR_FAMILY:
         obj_type = NMP_OBJECT_GET_TYPE(obj_a);
         /* currently, only routing rules are supported for this cache-id-type. */
@@ -779,17 +848,196 @@ _NMP_OBJECT_STRUCT_SIZE(const NMPClass *klass)
     return klass->sizeof_data + G_STRUCT_OFFSET(NMPObject, object);
 }
 
+/*****************************************************************************/
+
+/* Addresses and routes are by far the most numerous objects, with possibly
+ * hundreds of thousands of routes in the cache. Allocate them from a simple
+ * slab allocator, which packs the fixed-size objects densely into large chunks.
+ * That reduces the per-allocation overhead of malloc() and fragmentation.
+ *
+ * NMPObject instances are ref-counted and commonly outlive the NMPCache that
+ * created them, so the slabs are global (per object type) and not tied to a
+ * cache. A chunk gets released when none of its objects are in use anymore.
+ * Like the ref-counting of NMPObject, this is not thread-safe.
+ *
+ * Chunks are aligned to their size, so that the chunk of an object can
+ * be found by masking the object's pointer. */
+
+#define SLAB_CHUNK_SIZE ((gsize) (64 * 1024))
+
+typedef struct {
+    CList lst_chunks_avail;
+    guint n_chunks_avail;
+} NMPSlab;
+
+typedef struct {
+    NMPSlab *slab;
+    CList    lst_chunks_avail;
+
+    /* singly linked list of released slots. */
+    gpointer free_list;
+
+    guint32 obj_size;
+    guint32 n_slots;
+    guint32 n_used;
+
+    /* the number of slots that were ever handed out. Slots after that are
+     * not yet in @free_list. */
+    guint32 n_touched;
+
+    char slots[] _nm_alignas(NMPObject);
+} NMPSlabChunk;
+
+static NMPSlab _slabs[NMP_OBJECT_TYPE_MAX];
+
+static NMPSlab *
+_slab_get(const NMPClass *klass)
+{
+    if (!NM_IN_SET(klass->obj_type,
+                   NMP_OBJECT_TYPE_IP4_ADDRESS,
+                   NMP_OBJECT_TYPE_IP6_ADDRESS,
+                   NMP_OBJECT_TYPE_IP4_ROUTE,
+                   NMP_OBJECT_TYPE_IP6_ROUTE))
+        return NULL;
+
+    return &_slabs[klass->obj_type - 1];
+}
+
+static gpointer
+_slab_alloc0(NMPSlab *slab, gsize obj_size)
+{
+    NMPSlabChunk *chunk;
+    gpointer      ptr;
+
+    if (G_UNLIKELY(!slab->lst_chunks_avail.next))
+        c_list_init(&slab->lst_chunks_avail);
+
+    chunk = c_list_first_entry(&slab->lst_chunks_avail, NMPSlabChunk, lst_chunks_avail);
+    if (!chunk) {
+        if (posix_memalign((void **) &chunk, SLAB_CHUNK_SIZE, SLAB_CHUNK_SIZE) != 0)
+            g_error("%s: failed to allocate %zu bytes", G_STRLOC, SLAB_CHUNK_SIZE);
+
+        obj_size = (obj_size + (_nm_alignof(NMPObject) - 1)) & ~(_nm_alignof(NMPObject) - 1);
+
+        *chunk = (NMPSlabChunk) {
+            .slab      = slab,
+            .obj_size  = obj_size,
+            .n_slots   = (SLAB_CHUNK_SIZE - G_STRUCT_OFFSET(NMPSlabChunk, slots)) / obj_size,
+            .n_used    = 0,
+            .n_touched = 0,
+            .free_list = NULL,
+        };
+        c_list_link_front(&slab->lst_chunks_avail, &chunk->lst_chunks_avail);
+        slab->n_chunks_avail++;
+    }
+
+    nm_assert(chunk->n_used < chunk->n_slots);
+
+    if (chunk->free_list) {
+        ptr              = chunk->free_list;
+        chunk->free_list = *((gpointer *) ptr);
+    } else {
+        nm_assert(chunk->n_touched < chunk->n_slots);
+        ptr = &chunk->slots[((gsize) chunk->n_touched++) * chunk->obj_size];
+    }
+
+    if (++chunk->n_used == chunk->n_slots) {
+        c_list_unlink(&chunk->lst_chunks_avail);
+        slab->n_chunks_avail--;
+    }
+
+    return memset(ptr, 0, chunk->obj_size);
+}
+
+static void
+_slab_free(gpointer ptr)
+{
+    NMPSlabChunk *chunk;
+    NMPSlab      *slab;
+
+    chunk = (NMPSlabChunk *) (((uintptr_t) ptr) & ~((uintptr_t) (SLAB_CHUNK_SIZE - 1)));
+    slab  = chunk->slab;
+
+    nm_assert(chunk->n_used > 0);
+    nm_assert((char *) ptr >= chunk->slots);
+    nm_assert((((char *) ptr) - chunk->slots) % chunk->obj_size == 0);
+
+    if (chunk->n_used-- == chunk->n_slots) {
+        c_list_link_front(&slab->lst_chunks_avail, &chunk->lst_chunks_avail);
+        slab->n_chunks_avail++;
+    }
+
+    if (chunk->n_used == 0 && slab->n_chunks_avail > 1) {
+        /* Keep one available chunk around to avoid allocating and releasing
+         * a chunk over and over. */
+        c_list_unlink(&chunk->lst_chunks_avail);
+        slab->n_chunks_avail--;
+        free(chunk);
+        return;
+    }
+
+    *((gpointer *) ptr) = chunk->free_list;
+    chunk->free_list    = ptr;
+}
+
+/* Releases the empty chunks that _slab_free() keeps around for reuse.
+ * Call this after a burst of allocations (like a full dump of the routes)
+ * to return the memory. Returns the number of released bytes. */
+gsize
+nmp_object_slab_trim(void)
+{
+    gsize released = 0;
+    guint i;
+
+    for (i = 0; i < G_N_ELEMENTS(_slabs); i++) {
+        NMPSlab      *slab = &_slabs[i];
+        NMPSlabChunk *chunk;
+        NMPSlabChunk *chunk_safe;
+
+        if (!slab->lst_chunks_avail.next)
+            continue;
+
+        c_list_for_each_entry_safe (chunk, chunk_safe, &slab->lst_chunks_avail, lst_chunks_avail) {
+            if (chunk->n_used > 0)
+                continue;
+            c_list_unlink(&chunk->lst_chunks_avail);
+            slab->n_chunks_avail--;
+            free(chunk);
+            released += SLAB_CHUNK_SIZE;
+        }
+    }
+
+    return released;
+}
+
 static NMPObject *
 _nmp_object_new_from_class(const NMPClass *klass)
 {
+    NMPSlab   *slab = _slab_get(klass);
     NMPObject *obj;
 
-    obj                    = g_slice_alloc0(_NMP_OBJECT_STRUCT_SIZE(klass));
+    if (slab)
+        obj = _slab_alloc0(slab, _NMP_OBJECT_STRUCT_SIZE(klass));
+    else
+        obj = g_slice_alloc0(_NMP_OBJECT_STRUCT_SIZE(klass));
     obj->_class            = klass;
     obj->parent._ref_count = 1;
     return obj;
 }
 
+static void
+_nmp_object_free(NMPObject *obj)
+{
+    const NMPClass *klass = obj->_class;
+
+    if (_slab_get(klass))
+        _slab_free(obj);
+    else
+        g_slice_free1(_NMP_OBJECT_STRUCT_SIZE(klass), obj);
+}
+
+/*****************************************************************************/
+
 NMPObject *
 nmp_object_new(NMPObjectType obj_type, gconstpointer plobj)
 {
@@ -1725,6 +1973,29 @@ _vt_cmd_plobj_id_cmp(mptcp_addr, NMPlatformMptcpAddr, {
     NM_CMP_FIELD(obj1, obj2, port);
 });
 
+static gboolean
+_neigh_id_has_dst(const NMPlatformNeigh *obj)
+{
+    /* A bridge FDB entry for a unicast address has only one destination. For
+     * entries that can have several remote endpoints, the remote is part of
+     * the identity. */
+    return obj->addr_family != AF_BRIDGE || nm_platform_neigh_is_fdb_multi_dst(obj);
+}
+
+_vt_cmd_plobj_id_cmp(neigh, NMPlatformNeigh, {
+    NM_CMP_FIELD(obj1, obj2, ifindex);
+    NM_CMP_FIELD(obj1, obj2, addr_family);
+    if (obj1->addr_family == AF_BRIDGE)
+        NM_CMP_FIELD_MEMCMP(obj1, obj2, lladdr);
+    if (_neigh_id_has_dst(obj1)) {
+        NM_CMP_FIELD(obj1, obj2, dst_family);
+        NM_CMP_FIELD_MEMCMP_LEN(obj1,
+                                obj2,
+                                dst,
+                                nm_utils_addr_family_to_size_untrusted(obj1->dst_family));
+    }
+});
+
 guint
 nmp_object_id_hash(const NMPObject *obj)
 {
@@ -1788,6 +2059,17 @@ _vt_cmd_plobj_id_hash_update(mptcp_addr, NMPlatformMptcpAddr, {
     nm_hash_update(h, &obj->addr, nm_utils_addr_family_to_size_untrusted(obj->addr_family));
 });
 
+_vt_cmd_plobj_id_hash_update(neigh, NMPlatformNeigh, {
+    /* See the corresponding ID cmp function for details. */
+    nm_hash_update_vals(h, obj->ifindex, obj->addr_family);
+    if (obj->addr_family == AF_BRIDGE)
+        nm_hash_update(h, &obj->lladdr, sizeof(obj->lladdr));
+    if (_neigh_id_has_dst(obj)) {
+        nm_hash_update_val(h, obj->dst_family);
+        nm_hash_update(h, &obj->dst, nm_utils_addr_family_to_size_untrusted(obj->dst_family));
+    }
+});
+
 static void
 _vt_cmd_plobj_hash_update_ip6_route(const NMPlatformObject *obj, NMHashState *h)
 {
@@ -1920,6 +2202,13 @@ _vt_cmd_obj_is_alive_mptcp_addr(const NMPObject *obj)
     return NM_IN_SET(obj->mptcp_addr.addr_family, AF_INET, AF_INET6, AF_UNSPEC);
 }
 
+static gboolean
+_vt_cmd_obj_is_alive_neigh(const NMPObject *obj)
+{
+    return obj->neigh.ifindex > 0
+           && NM_IN_SET(obj->neigh.addr_family, AF_INET, AF_INET6, AF_BRIDGE);
+}
+
 gboolean
 nmp_object_is_visible(const NMPObject *obj)
 {
@@ -1969,6 +2258,8 @@ static const guint8 _supported_cache_ids_ipx_route[] = {
     NMP_CACHE_ID_TYPE_OBJECT_BY_IFINDEX,
     NMP_CACHE_ID_TYPE_DEFAULT_ROUTES,
     NMP_CACHE_ID_TYPE_ROUTES_BY_WEAK_ID,
+    NMP_CACHE_ID_TYPE_ROUTES_BY_DESTINATION,
+    NMP_CACHE_ID_TYPE_ROUTES_BY_TABLE,
     0,
 };
 
@@ -1992,7 +2283,7 @@ _vt_dedup_obj_destroy(NMDedupMultiObj *obj)
     klass = o->_class;
     if (klass->cmd_obj_dispose)
         klass->cmd_obj_dispose(o);
-    g_slice_free1(_NMP_OBJECT_STRUCT_SIZE(klass), o);
+    _nmp_object_free(o);
 }
 
 static const NMDedupMultiObj *
@@ -2412,6 +2703,63 @@ nmp_lookup_init_ip6_route_by_weak_id(NMPLookup             *lookup,
     return _L(lookup);
 }
 
+const NMPLookup *
+nmp_lookup_init_ip4_route_by_destination(NMPLookup *lookup,
+                                         guint32    route_table,
+                                         in_addr_t  network,
+                                         guint      plen)
+{
+    NMPObject *o;
+
+    nm_assert(lookup);
+    nm_assert(plen <= 32);
+
+    o = _nmp_object_stackinit_from_type(&lookup->selector_obj, NMP_OBJECT_TYPE_IP4_ROUTE);
+    o->ip4_route.ifindex       = 1;
+    o->ip4_route.plen          = plen;
+    o->ip4_route.table_coerced = nm_platform_route_table_coerce(route_table);
+    o->ip4_route.network       = network;
+    lookup->cache_id_type      = NMP_CACHE_ID_TYPE_ROUTES_BY_DESTINATION;
+    return _L(lookup);
+}
+
+const NMPLookup *
+nmp_lookup_init_ip6_route_by_destination(NMPLookup             *lookup,
+                                         guint32                route_table,
+                                         const struct in6_addr *network,
+                                         guint                  plen)
+{
+    NMPObject *o;
+
+    nm_assert(lookup);
+    nm_assert(plen <= 128);
+
+    o = _nmp_object_stackinit_from_type(&lookup->selector_obj, NMP_OBJECT_TYPE_IP6_ROUTE);
+    o->ip6_route.ifindex       = 1;
+    o->ip6_route.plen          = plen;
+    o->ip6_route.table_coerced = nm_platform_route_table_coerce(route_table);
+    if (network)
+        o->ip6_route.network = *network;
+    lookup->cache_id_type = NMP_CACHE_ID_TYPE_ROUTES_BY_DESTINATION;
+    return _L(lookup);
+}
+
+const NMPLookup *
+nmp_lookup_init_route_by_table(NMPLookup *lookup, NMPObjectType obj_type, guint32 route_table)
+{
+    NMPObject *o;
+
+    nm_assert(lookup);
+    nm_assert(NM_IN_SET(obj_type, NMP_OBJECT_TYPE_IP4_ROUTE, NMP_OBJECT_TYPE_IP6_ROUTE));
+
+    o = _nmp_object_stackinit_from_type(&lookup->selector_obj, obj_type);
+
+    o->ip_route.ifindex       = 1;
+    o->ip_route.table_coerced = nm_platform_route_table_coerce(route_table);
+    lookup->cache_id_type     = NMP_CACHE_ID_TYPE_ROUTES_BY_TABLE;
+    return _L(lookup);
+}
+
 const NMPLookup *
 nmp_lookup_init_object_by_addr_family(NMPLookup *lookup, NMPObjectType obj_type, int addr_family)
 {
@@ -3284,6 +3632,24 @@ nmp_cache_free(NMPCache *cache)
 
 /*****************************************************************************/
 
+guint
+nmp_cache_get_stats(const NMPCache *cache, NMPObjectType obj_type, gsize *out_bytes)
+{
+    const NMDedupMultiHeadEntry *head_entry;
+    NMPLookup                    lookup;
+    guint                        n;
+
+    head_entry = nmp_cache_lookup(cache, nmp_lookup_init_obj_type(&lookup, obj_type));
+    n          = head_entry ? head_entry->len : 0u;
+
+    /* This does not account for data referenced by the objects, like the udev
+     * device or the lnk object of a link. */
+    NM_SET_OUT(out_bytes, ((gsize) n) * _NMP_OBJECT_STRUCT_SIZE(nmp_class_from_type(obj_type)));
+    return n;
+}
+
+/*****************************************************************************/
+
 void
 nmtst_assert_nmp_cache_is_consistent(const NMPCache *cache)
 {}
@@ -3742,4 +4108,19 @@ const NMPClass _nmp_classes[NMP_OBJECT_TYPE_MAX] = {
             .cmd_plobj_hash_update    = (CmdPlobjHashUpdateFunc) nm_platform_mptcp_addr_hash_update,
             .cmd_plobj_cmp            = (CmdPlobjCmpFunc) nm_platform_mptcp_addr_cmp,
         },
+    [NMP_OBJECT_TYPE_NEIGH - 1] =
+        {
+            .parent                   = DEDUP_MULTI_OBJ_CLASS_INIT(),
+            .obj_type                 = NMP_OBJECT_TYPE_NEIGH,
+            .sizeof_data              = sizeof(NMPObjectNeigh),
+            .sizeof_public            = sizeof(NMPlatformNeigh),
+            .obj_type_name            = "neigh",
+            .cmd_obj_is_alive         = _vt_cmd_obj_is_alive_neigh,
+            .cmd_plobj_id_cmp         = _vt_cmd_plobj_id_cmp_neigh,
+            .cmd_plobj_id_hash_update = _vt_cmd_plobj_id_hash_update_neigh,
+            .cmd_plobj_to_string_id   = (CmdPlobjToStringIdFunc) nm_platform_neigh_to_string,
+            .cmd_plobj_to_string      = (CmdPlobjToStringFunc) nm_platform_neigh_to_string,
+            .cmd_plobj_hash_update    = (CmdPlobjHashUpdateFunc) nm_platform_neigh_hash_update,
+            .cmd_plobj_cmp            = (CmdPlobjCmpFunc) nm_platform_neigh_cmp,
+        },
 };
@@ -160,6 +160,16 @@ typedef enum {
      * cache-resync. */
     NMP_CACHE_ID_TYPE_ROUTES_BY_WEAK_ID,
 
+    /* index for the routes by route table and destination (network/plen), ignoring
+     * ifindex, metric and any other attributes. This allows to find all routes
+     * to a certain destination, without iterating over all routes of an ifindex. */
+    NMP_CACHE_ID_TYPE_ROUTES_BY_DESTINATION,
+
+    /* index for the routes by route table, ignoring all other attributes. This
+     * allows to find all routes of a table (for example, of a VRF), without
+     * iterating over all routes. */
+    NMP_CACHE_ID_TYPE_ROUTES_BY_TABLE,
+
     /* a filter for objects that track an explicit address family.
      *
      * Note that currently on NMPObjectRoutingRule is indexed by this filter. */
@@ -364,6 +374,10 @@ typedef struct {
     NMPlatformMptcpAddr _public;
 } NMPObjectMptcpAddr;
 
+typedef struct {
+    NMPlatformNeigh _public;
+} NMPObjectNeigh;
+
 struct _NMPObject {
     union {
         NMDedupMultiObj parent;
@@ -455,6 +469,9 @@ struct _NMPObject {
 
         NMPlatformMptcpAddr mptcp_addr;
         NMPObjectMptcpAddr  _mptcp_addr;
+
+        NMPlatformNeigh neigh;
+        NMPObjectNeigh  _neigh;
     };
 } _nm_alignas(NMDedupMultiObj);
 
@@ -565,6 +582,8 @@ _NMP_OBJECT_TYPE_IS_OBJ_WITH_IFINDEX(NMPObjectType obj_type)
     case NMP_OBJECT_TYPE_LNK_WIREGUARD:
 
     case NMP_OBJECT_TYPE_MPTCP_ADDR:
+
+    case NMP_OBJECT_TYPE_NEIGH:
         return TRUE;
 
     case NMP_OBJECT_TYPE_ROUTING_RULE:
@@ -630,6 +649,7 @@ _NMP_OBJECT_TYPE_IS_OBJ_WITH_IFINDEX(NMPObjectType obj_type)
     _NMP_OBJECT_CAST(obj, lnk_bridge, NMP_OBJECT_TYPE_LNK_BRIDGE)
 #define NMP_OBJECT_CAST_MPTCP_ADDR(obj) \
     _NMP_OBJECT_CAST(obj, mptcp_addr, NMP_OBJECT_TYPE_MPTCP_ADDR)
+#define NMP_OBJECT_CAST_NEIGH(obj) _NMP_OBJECT_CAST(obj, neigh, NMP_OBJECT_TYPE_NEIGH)
 
 static inline int
 NMP_OBJECT_TYPE_TO_ADDR_FAMILY(NMPObjectType obj_type)
@@ -837,6 +857,8 @@ gboolean nmp_object_indirect_id_equal(gconstpointer a, gconstpointer b);
 gboolean nmp_object_is_alive(const NMPObject *obj);
 gboolean nmp_object_is_visible(const NMPObject *obj);
 
+gsize nmp_object_slab_trim(void);
+
 void
 _nmp_object_fixup_link_udev_fields(NMPObject **obj_new, NMPObject *obj_orig, gboolean use_udev);
 
@@ -900,6 +922,16 @@ const NMPLookup *nmp_lookup_init_ip6_route_by_weak_id(NMPLookup             *loo
                                                       guint32                metric,
                                                       const struct in6_addr *src,
                                                       guint8                 src_plen);
+const NMPLookup *nmp_lookup_init_ip4_route_by_destination(NMPLookup *lookup,
+                                                          guint32    route_table,
+                                                          in_addr_t  network,
+                                                          guint      plen);
+const NMPLookup *nmp_lookup_init_ip6_route_by_destination(NMPLookup             *lookup,
+                                                          guint32                route_table,
+                                                          const struct in6_addr *network,
+                                                          guint                  plen);
+const NMPLookup *
+nmp_lookup_init_route_by_table(NMPLookup *lookup, NMPObjectType obj_type, guint32 route_table);
 const NMPLookup *
 nmp_lookup_init_object_by_addr_family(NMPLookup *lookup, NMPObjectType obj_type, int addr_family);
 
@@ -1038,6 +1070,8 @@ void nmp_cache_dirty_set_all_main(NMPCache *cache, const NMPLookup *lookup);
 NMPCache *nmp_cache_new(NMDedupMultiIndex *multi_idx, gboolean use_udev);
 void      nmp_cache_free(NMPCache *cache);
 
+guint nmp_cache_get_stats(const NMPCache *cache, NMPObjectType obj_type, gsize *out_bytes);
+
 static inline void
 ASSERT_nmp_cache_ops(const NMPCache  *cache,
                      NMPCacheOpsType  ops_type,
@@ -1187,6 +1221,39 @@ nm_platform_lookup_ip6_route_by_weak_id(NMPlatform            *platform,
     return nm_platform_lookup(platform, &lookup);
 }
 
+static inline const NMDedupMultiHeadEntry *
+nm_platform_lookup_ip4_route_by_destination(NMPlatform *platform,
+                                            guint32     route_table,
+                                            in_addr_t   network,
+                                            guint       plen)
+{
+    NMPLookup lookup;
+
+    nmp_lookup_init_ip4_route_by_destination(&lookup, route_table, network, plen);
+    return nm_platform_lookup(platform, &lookup);
+}
+
+static inline const NMDedupMultiHeadEntry *
+nm_platform_lookup_ip6_route_by_destination(NMPlatform            *platform,
+                                            guint32                route_table,
+                                            const struct in6_addr *network,
+                                            guint                  plen)
+{
+    NMPLookup lookup;
+
+    nmp_lookup_init_ip6_route_by_destination(&lookup, route_table, network, plen);
+    return nm_platform_lookup(platform, &lookup);
+}
+
+static inline const NMDedupMultiHeadEntry *
+nm_platform_lookup_route_by_table(NMPlatform *platform, NMPObjectType obj_type, guint32 route_table)
+{
+    NMPLookup lookup;
+
+    nmp_lookup_init_route_by_table(&lookup, obj_type, route_table);
+    return nm_platform_lookup(platform, &lookup);
+}
+
 static inline const NMDedupMultiHeadEntry *
 nm_platform_lookup_object_by_addr_family(NMPlatform   *platform,
                                          NMPObjectType obj_type,
@@ -1231,6 +1298,17 @@ nmp_object_ip6_address_is_not_link_local(const NMPObject *obj)
     return !IN6_IS_ADDR_LINKLOCAL(&NMP_OBJECT_CAST_IP6_ADDRESS(obj)->address);
 }
 
+static inline gboolean
+nmp_object_ip6_address_is_kernel_temporary(const NMPObject *obj)
+{
+    /* IPv6 privacy addresses (RFC 4941) are created and rotated by kernel, from
+     * an address with IFA_F_MANAGETEMPADDR. They have IFA_F_TEMPORARY set, which
+     * is the same flag as IFA_F_SECONDARY. NetworkManager never configures such
+     * addresses itself. */
+    return NMP_OBJECT_GET_TYPE(obj) == NMP_OBJECT_TYPE_IP6_ADDRESS
+           && NM_FLAGS_HAS(NMP_OBJECT_CAST_IP6_ADDRESS(obj)->n_ifa_flags, IFA_F_SECONDARY);
+}
+
 /*****************************************************************************/
 
 const char *nmp_object_link_udev_device_get_property_value(const NMPObject *obj, const char *key);
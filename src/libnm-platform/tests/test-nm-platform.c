@@ -2,12 +2,16 @@
 
 #include "libnm-glib-aux/nm-default-glib-i18n-prog.h"
 
+#include <sys/resource.h>
+
 #include "libnm-log-core/nm-logging.h"
 #include "libnm-platform/nm-netlink.h"
 #include "libnm-platform/nmp-netns.h"
 #include "libnm-platform/nm-platform-utils.h"
 #include "libnm-platform/nmp-object.h"
 
+#include "libnm-glib-aux/nm-time-utils.h"
+
 #include "libnm-glib-aux/nm-test-utils.h"
 
 /*****************************************************************************/
@@ -68,6 +72,9 @@ G_STATIC_ASSERT(_nm_alignof(NMPlatformObject) == _nm_alignof(NMPlatformQdisc));
 G_STATIC_ASSERT(_nm_alignof(NMPlatformObject) == _nm_alignof(NMPlatformRoutingRule));
 G_STATIC_ASSERT(_nm_alignof(NMPlatformObject) == _nm_alignof(NMPlatformTfilter));
 
+/* IPv4 routes can be very numerous. Don't grow the struct by accident. */
+G_STATIC_ASSERT(sizeof(NMPlatformIP4Route) <= 88);
+
 /*****************************************************************************/
 
 static void
@@ -421,6 +428,123 @@ test_nmp_utils_bridge_normalized_vlans_equal(void)
     g_assert(!nmp_utils_bridge_normalized_vlans_equal(b, 1, a, 1));
 }
 
+static void
+test_nmp_utils_bridge_vlan_diff(void)
+{
+    NMPlatformBridgeVlan          old[10];
+    NMPlatformBridgeVlan          new[10];
+    NMPlatformBridgeVlan          expect[10];
+    gs_free NMPlatformBridgeVlan *del_vlans = NULL;
+    gs_free NMPlatformBridgeVlan *add_vlans = NULL;
+    guint                         num_del_vlans;
+    guint                         num_add_vlans;
+
+    /* No change */
+    old[0] = (NMPlatformBridgeVlan) {
+        .vid_start = 1,
+        .vid_end   = 10,
+    };
+    new[0] = (NMPlatformBridgeVlan) {
+        .vid_start = 1,
+        .vid_end   = 5,
+    };
+    new[1] = (NMPlatformBridgeVlan) {
+        .vid_start = 6,
+        .vid_end   = 10,
+    };
+    nmp_utils_bridge_vlan_diff(old,
+                               1,
+                               new,
+                               2,
+                               &del_vlans,
+                               &num_del_vlans,
+                               &add_vlans,
+                               &num_add_vlans);
+    g_assert_cmpint(num_del_vlans, ==, 0);
+    g_assert_cmpint(num_add_vlans, ==, 0);
+    g_assert(!del_vlans);
+    g_assert(!add_vlans);
+
+    /* Removed, added and changed VLANs are compressed into ranges */
+    old[0] = (NMPlatformBridgeVlan) {
+        .vid_start = 1,
+        .vid_end   = 1,
+        .pvid      = TRUE,
+        .untagged  = TRUE,
+    };
+    old[1] = (NMPlatformBridgeVlan) {
+        .vid_start = 10,
+        .vid_end   = 20,
+    };
+    new[0] = (NMPlatformBridgeVlan) {
+        .vid_start = 1,
+        .vid_end   = 1,
+        .untagged  = TRUE,
+    };
+    new[1] = (NMPlatformBridgeVlan) {
+        .vid_start = 15,
+        .vid_end   = 30,
+    };
+    new[2] = (NMPlatformBridgeVlan) {
+        .vid_start = 100,
+        .vid_end   = 100,
+        .pvid      = TRUE,
+    };
+    nmp_utils_bridge_vlan_diff(old,
+                               2,
+                               new,
+                               3,
+                               &del_vlans,
+                               &num_del_vlans,
+                               &add_vlans,
+                               &num_add_vlans);
+    expect[0] = (NMPlatformBridgeVlan) {
+        .vid_start = 10,
+        .vid_end   = 14,
+    };
+    g_assert_cmpint(num_del_vlans, ==, 1);
+    g_assert(nmp_utils_bridge_normalized_vlans_equal(del_vlans, num_del_vlans, expect, 1));
+    expect[0] = (NMPlatformBridgeVlan) {
+        .vid_start = 1,
+        .vid_end   = 1,
+        .untagged  = TRUE,
+    };
+    expect[1] = (NMPlatformBridgeVlan) {
+        .vid_start = 21,
+        .vid_end   = 30,
+    };
+    expect[2] = (NMPlatformBridgeVlan) {
+        .vid_start = 100,
+        .vid_end   = 100,
+        .pvid      = TRUE,
+    };
+    g_assert_cmpint(num_add_vlans, ==, 3);
+    g_assert(nmp_utils_bridge_normalized_vlans_equal(add_vlans, num_add_vlans, expect, 3));
+    nm_clear_g_free(&del_vlans);
+    nm_clear_g_free(&add_vlans);
+
+    /* Everything removed */
+    nmp_utils_bridge_vlan_diff(old,
+                               2,
+                               NULL,
+                               0,
+                               &del_vlans,
+                               &num_del_vlans,
+                               &add_vlans,
+                               &num_add_vlans);
+    expect[0] = (NMPlatformBridgeVlan) {
+        .vid_start = 1,
+        .vid_end   = 1,
+    };
+    expect[1] = (NMPlatformBridgeVlan) {
+        .vid_start = 10,
+        .vid_end   = 20,
+    };
+    g_assert_cmpint(num_del_vlans, ==, 2);
+    g_assert(nmp_utils_bridge_normalized_vlans_equal(del_vlans, num_del_vlans, expect, 2));
+    g_assert_cmpint(num_add_vlans, ==, 0);
+}
+
 /*****************************************************************************/
 
 static void
@@ -474,6 +598,210 @@ test_nmpclass_consistency(void)
 
 /*****************************************************************************/
 
+static void
+test_nmp_object_alloc(void)
+{
+    const guint         N         = g_test_perf() ? 1000000u : 50000u;
+    gs_free NMPObject **objs      = g_new(NMPObject *, N);
+    gs_free gpointer   *ptrs      = g_new(gpointer, N);
+    gs_free NMPObject **objs_perm = g_new(NMPObject *, N);
+    gs_free gpointer   *ptrs_perm = g_new(gpointer, N);
+    const gsize         obj_size  = G_STRUCT_OFFSET(NMPObject, object) + sizeof(NMPObjectIP4Route);
+    gint64              ts;
+    gint64              t_malloc;
+    gint64              t_nmp;
+    guint               round;
+    guint               i;
+
+    for (round = 0; round < 3; round++) {
+        ts = nm_utils_get_monotonic_timestamp_nsec();
+        for (i = 0; i < N; i++)
+            ptrs[i] = g_malloc0(obj_size);
+        nmtst_rand_perm(NULL, ptrs_perm, ptrs, sizeof(gpointer), N);
+        for (i = 0; i < N; i++)
+            g_free(ptrs_perm[i]);
+        t_malloc = nm_utils_get_monotonic_timestamp_nsec() - ts;
+
+        ts = nm_utils_get_monotonic_timestamp_nsec();
+        for (i = 0; i < N; i++) {
+            NMPlatformIP4Route r = {
+                .ifindex = 1 + (i % 10),
+                .network = 0x0a000000u + i,
+                .plen    = 32,
+            };
+
+            objs[i] = nmp_object_new(NMP_OBJECT_TYPE_IP4_ROUTE, &r);
+            g_assert(NMP_OBJECT_GET_TYPE(objs[i]) == NMP_OBJECT_TYPE_IP4_ROUTE);
+        }
+        nmtst_rand_perm(NULL, objs_perm, objs, sizeof(NMPObject *), N);
+        for (i = 0; i < N; i++) {
+            g_assert_cmpint(objs_perm[i]->ip4_route.plen, ==, 32);
+            nmp_object_unref(objs_perm[i]);
+        }
+        t_nmp = nm_utils_get_monotonic_timestamp_nsec() - ts;
+
+        if (g_test_perf()) {
+            g_test_message("alloc/free of %u IPv4 routes: malloc %" G_GINT64_FORMAT
+                           " usec, nmp-object %" G_GINT64_FORMAT " usec",
+                           N,
+                           t_malloc / 1000,
+                           t_nmp / 1000);
+        }
+    }
+}
+
+/*****************************************************************************/
+
+static NMPObject *
+_cache_bench_obj_new(NMPObjectType obj_type, guint i, guint32 generation)
+{
+    switch (obj_type) {
+    case NMP_OBJECT_TYPE_IP4_ADDRESS:
+        return nmp_object_new(NMP_OBJECT_TYPE_IP4_ADDRESS,
+                              &((const NMPlatformIP4Address){
+                                  .ifindex      = 1 + (i % 100),
+                                  .address      = htonl(0x0a000000u + i),
+                                  .peer_address = htonl(0x0a000000u + i),
+                                  .plen         = 8,
+                                  .lifetime     = generation,
+                              }));
+    case NMP_OBJECT_TYPE_IP4_ROUTE:
+        return nmp_object_new(NMP_OBJECT_TYPE_IP4_ROUTE,
+                              &((const NMPlatformIP4Route){
+                                  .ifindex = 1 + (i % 100),
+                                  .network = htonl(0x0a000000u + i),
+                                  .plen    = 32,
+                                  .metric  = 100,
+                                  .mtu     = generation,
+                              }));
+    case NMP_OBJECT_TYPE_IP6_ROUTE:
+    {
+        NMPlatformIP6Route r = {
+            .ifindex = 1 + (i % 100),
+            .plen    = 128,
+            .metric  = 1024,
+            .mtu     = generation,
+        };
+
+        r.network.s6_addr32[0] = htonl(0x20010db8u);
+        r.network.s6_addr32[3] = htonl(i);
+        return nmp_object_new(NMP_OBJECT_TYPE_IP6_ROUTE, &r);
+    }
+    default:
+        nm_assert_not_reached();
+        return NULL;
+    }
+}
+
+static NMPCacheOpsType
+_cache_bench_update(NMPCache *cache, NMPObject *obj, gboolean is_dump)
+{
+    nm_auto_nmpobj const NMPObject *obj_old     = NULL;
+    nm_auto_nmpobj const NMPObject *obj_new     = NULL;
+    nm_auto_nmpobj const NMPObject *obj_replace = NULL;
+    gboolean                        resync_required;
+
+    if (NMP_OBJECT_GET_TYPE(obj) == NMP_OBJECT_TYPE_IP4_ADDRESS)
+        return nmp_cache_update_netlink(cache, obj, is_dump, &obj_old, &obj_new);
+
+    return nmp_cache_update_netlink_route(cache,
+                                          obj,
+                                          is_dump,
+                                          NLM_F_CREATE,
+                                          TRUE,
+                                          &obj_old,
+                                          &obj_new,
+                                          &obj_replace,
+                                          &resync_required);
+}
+
+static void
+_cache_bench_report(const char *what, NMPObjectType obj_type, guint n, gint64 ts)
+{
+    struct rusage ru = {};
+    gint64        t;
+
+    if (!g_test_perf())
+        return;
+
+    t = NM_MAX(nm_utils_get_monotonic_timestamp_nsec() - ts, 1);
+    getrusage(RUSAGE_SELF, &ru);
+    g_test_message("nmp-cache: %-8s %u %s: %" G_GINT64_FORMAT " usec, %" G_GINT64_FORMAT
+                   " ops/sec, peak rss %ld KiB",
+                   what,
+                   n,
+                   nmp_class_from_type(obj_type)->obj_type_name,
+                   t / 1000,
+                   (gint64) n * NM_UTILS_NSEC_PER_SEC / t,
+                   ru.ru_maxrss);
+}
+
+static void
+test_nmp_cache_update(gconstpointer test_data)
+{
+    nm_auto_unref_dedup_multi_index NMDedupMultiIndex *multi_idx = NULL;
+    const NMPObjectType                obj_type = GPOINTER_TO_INT(test_data);
+    const guint                        N        = g_test_perf() ? 100000u : 2000u;
+    NMPCache                          *cache;
+    const NMDedupMultiHeadEntry       *head_entry;
+    NMPLookup                          lookup;
+    gint64                             ts;
+    guint                              i;
+
+    multi_idx = nm_dedup_multi_index_new();
+    cache     = nmp_cache_new(multi_idx, FALSE);
+
+    /* Initial dump, all objects are new. */
+    ts = nm_utils_get_monotonic_timestamp_nsec();
+    for (i = 0; i < N; i++) {
+        nm_auto_nmpobj NMPObject *obj = _cache_bench_obj_new(obj_type, i, 0);
+
+        g_assert_cmpint(_cache_bench_update(cache, obj, TRUE), ==, NMP_CACHE_OPS_ADDED);
+    }
+    _cache_bench_report("add", obj_type, N, ts);
+
+    head_entry = nmp_cache_lookup(cache, nmp_lookup_init_obj_type(&lookup, obj_type));
+    g_assert(head_entry);
+    g_assert_cmpint(head_entry->len, ==, N);
+
+    /* A resync dump, nothing changes. */
+    ts = nm_utils_get_monotonic_timestamp_nsec();
+    for (i = 0; i < N; i++) {
+        nm_auto_nmpobj NMPObject *obj = _cache_bench_obj_new(obj_type, i, 0);
+
+        g_assert_cmpint(_cache_bench_update(cache, obj, TRUE), ==, NMP_CACHE_OPS_UNCHANGED);
+    }
+    _cache_bench_report("redump", obj_type, N, ts);
+
+    /* Change notifications for all objects. */
+    ts = nm_utils_get_monotonic_timestamp_nsec();
+    for (i = 0; i < N; i++) {
+        nm_auto_nmpobj NMPObject *obj = _cache_bench_obj_new(obj_type, i, 1400);
+
+        g_assert_cmpint(_cache_bench_update(cache, obj, FALSE), ==, NMP_CACHE_OPS_UPDATED);
+    }
+    _cache_bench_report("update", obj_type, N, ts);
+
+    /* Remove all objects again. */
+    ts = nm_utils_get_monotonic_timestamp_nsec();
+    for (i = 0; i < N; i++) {
+        nm_auto_nmpobj NMPObject       *obj     = _cache_bench_obj_new(obj_type, i, 1400);
+        nm_auto_nmpobj const NMPObject *obj_old = NULL;
+        nm_auto_nmpobj const NMPObject *obj_new = NULL;
+
+        g_assert_cmpint(nmp_cache_remove_netlink(cache, obj, &obj_old, &obj_new),
+                        ==,
+                        NMP_CACHE_OPS_REMOVED);
+    }
+    _cache_bench_report("remove", obj_type, N, ts);
+
+    g_assert(!nmp_cache_lookup(cache, nmp_lookup_init_obj_type(&lookup, obj_type)));
+
+    nmp_cache_free(cache);
+}
+
+/*****************************************************************************/
+
 NMTST_DEFINE();
 
 int
@@ -489,6 +817,17 @@ main(int argc, char **argv)
                     test_nmp_utils_bridge_vlans_normalize);
     g_test_add_func("/nm-platform/nmp-utils-bridge-vlans-equal",
                     test_nmp_utils_bridge_normalized_vlans_equal);
+    g_test_add_func("/nm-platform/nmp-utils-bridge-vlan-diff", test_nmp_utils_bridge_vlan_diff);
+    g_test_add_func("/nm-platform/nmp-object-alloc", test_nmp_object_alloc);
+    g_test_add_data_func("/nm-platform/nmp-cache-update/ip4-address",
+                         GINT_TO_POINTER(NMP_OBJECT_TYPE_IP4_ADDRESS),
+                         test_nmp_cache_update);
+    g_test_add_data_func("/nm-platform/nmp-cache-update/ip4-route",
+                         GINT_TO_POINTER(NMP_OBJECT_TYPE_IP4_ROUTE),
+                         test_nmp_cache_update);
+    g_test_add_data_func("/nm-platform/nmp-cache-update/ip6-route",
+                         GINT_TO_POINTER(NMP_OBJECT_TYPE_IP6_ROUTE),
+                         test_nmp_cache_update);
 
     return g_test_run();
 }
@@ -32,10 +32,44 @@ event_check(GSource *source)
     return sd_event_wait(((SDEventSource *) source)->event, 0) > 0;
 }
 
+/* The maximum number of pending sd_event sources to dispatch in one
+ * iteration of the main loop, before yielding to other GSources. */
+#define EVENT_DISPATCH_MAX 64
+
+static guint64 _n_wakeups;
+static guint64 _n_dispatched;
+
 static gboolean
 event_dispatch(GSource *source, GSourceFunc callback, gpointer user_data)
 {
-    return sd_event_dispatch(((SDEventSource *) source)->event) > 0;
+    sd_event *event = ((SDEventSource *) source)->event;
+    guint     n;
+    int       r;
+
+    _n_wakeups++;
+
+    /* sd_event coalesces timers within their accuracy, so with many clients
+     * (like hundreds of DHCPv6 clients) several sources are pending at the same
+     * time. Dispatch them together, instead of one per main loop iteration. */
+    for (n = 0;; n++) {
+        r = sd_event_dispatch(event);
+        if (r <= 0)
+            return FALSE;
+
+        _n_dispatched++;
+
+        if (n + 1 >= EVENT_DISPATCH_MAX)
+            return TRUE;
+
+        r = sd_event_prepare(event);
+        if (r == 0) {
+            /* Nothing is pending and the event is armed. Check it once more, which
+             * also brings it back to the initial state for the next prepare(). */
+            r = sd_event_wait(event, 0);
+        }
+        if (r <= 0)
+            return TRUE;
+    }
 }
 
 static void
@@ -103,6 +137,22 @@ nm_sd_event_attach_default(void)
     return event_attach(NULL, NULL);
 }
 
+/**
+ * nm_sd_event_get_stats:
+ * @out_n_wakeups: (out) (optional): the number of main loop iterations that
+ *   dispatched the sd_event.
+ * @out_n_dispatched: (out) (optional): the number of dispatched sd_event sources.
+ *
+ * Both are counted for all attached sd_event instances. The difference
+ * between the two shows how well timers get coalesced.
+ */
+void
+nm_sd_event_get_stats(guint64 *out_n_wakeups, guint64 *out_n_dispatched)
+{
+    NM_SET_OUT(out_n_wakeups, _n_wakeups);
+    NM_SET_OUT(out_n_dispatched, _n_dispatched);
+}
+
 /*****************************************************************************/
 
 /* ensure that defines in nm-sd.h correspond to the internal defines. */
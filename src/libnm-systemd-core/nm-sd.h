@@ -12,4 +12,6 @@
 
 guint nm_sd_event_attach_default(void);
 
+void nm_sd_event_get_stats(guint64 *out_n_wakeups, guint64 *out_n_dispatched);
+
 #endif /* __NM_SD_H__ */
@@ -4498,6 +4498,7 @@ _get_fcn_ethtool(ARGS_GET_FCN)
     case NM_ETHTOOL_TYPE_CHANNELS:
     case NM_ETHTOOL_TYPE_COALESCE:
     case NM_ETHTOOL_TYPE_RING:
+    case NM_ETHTOOL_TYPE_RSS:
         if (!nm_setting_option_get_uint32(setting, nm_ethtool_data[ethtool_id]->optname, &u32)) {
             NM_SET_OUT(out_is_default, TRUE);
             return NULL;
@@ -4554,6 +4555,7 @@ _set_fcn_ethtool(ARGS_SET_FCN)
     case NM_ETHTOOL_TYPE_CHANNELS:
     case NM_ETHTOOL_TYPE_COALESCE:
     case NM_ETHTOOL_TYPE_RING:
+    case NM_ETHTOOL_TYPE_RSS:
         i64 = _nm_utils_ascii_str_to_int64(value, 10, 0, G_MAXUINT32, -1);
         if (i64 == -1) {
             nm_utils_error_set(
@@ -6099,6 +6101,22 @@ static const NMMetaPropertyInfo *const property_infos_ETHTOOL[] = {
                    DEFINE_PROPERTY_TYP_DATA_SUBTYPE
                       (ethtool, .ethtool_id = NM_ETHTOOL_ID_FEC_MODE)
                    ),
+    PROPERTY_INFO (NM_ETHTOOL_OPTNAME_RSS_EQUAL,
+                   "Spread the RSS indirection table evenly over the first N "
+                   "receive queues.",
+                   .property_type = &_pt_ethtool,
+                   .property_typ_data =
+                   DEFINE_PROPERTY_TYP_DATA_SUBTYPE
+                      (ethtool, .ethtool_id = NM_ETHTOOL_ID_RSS_EQUAL)
+                   ),
+    PROPERTY_INFO (NM_ETHTOOL_OPTNAME_RSS_HFUNC,
+                   "The RSS hash function as ETH_RSS_HASH_* bit: "
+                   "1 (toeplitz), 2 (xor) or 4 (crc32).",
+                   .property_type = &_pt_ethtool,
+                   .property_typ_data =
+                   DEFINE_PROPERTY_TYP_DATA_SUBTYPE
+                      (ethtool, .ethtool_id = NM_ETHTOOL_ID_RSS_HFUNC)
+                   ),
     NULL,
 };
 
@@ -7135,6 +7153,110 @@ static const NMMetaPropertyInfo *const property_infos_LINK[] = {
             ),
         ),
     ),
+    PROPERTY_INFO_WITH_DESC (NM_SETTING_LINK_NEIGHBORS,
+        .property_type =                &_pt_multilist,
+        .property_typ_data = DEFINE_PROPERTY_TYP_DATA (
+            PROPERTY_TYP_DATA_SUBTYPE (multilist,
+                .add2_fcn =             MULTILIST_ADD2_FCN            (NMSettingLink, nm_setting_link_add_neighbor),
+                .remove_by_value_fcn =  MULTILIST_REMOVE_BY_VALUE_FCN (NMSettingLink, nm_setting_link_remove_neighbor_by_value),
+            ),
+            .list_items_doc_format =    NM_META_PROPERTY_TYPE_FORMAT_STRING,
+        ),
+    ),
+    PROPERTY_INFO_WITH_DESC (NM_SETTING_LINK_FDB_ENTRIES,
+        .property_type =                &_pt_multilist,
+        .property_typ_data = DEFINE_PROPERTY_TYP_DATA (
+            PROPERTY_TYP_DATA_SUBTYPE (multilist,
+                .add2_fcn =             MULTILIST_ADD2_FCN            (NMSettingLink, nm_setting_link_add_fdb_entry),
+                .remove_by_value_fcn =  MULTILIST_REMOVE_BY_VALUE_FCN (NMSettingLink, nm_setting_link_remove_fdb_entry_by_value),
+            ),
+            .list_items_doc_format =    NM_META_PROPERTY_TYPE_FORMAT_STRING,
+        ),
+    ),
+    PROPERTY_INFO_WITH_DESC (NM_SETTING_LINK_RPS_CPUS,
+        .property_type =                &_pt_gobject_string,
+    ),
+    PROPERTY_INFO_WITH_DESC (NM_SETTING_LINK_RPS_FLOW_COUNT,
+        .property_type =                &_pt_gobject_int,
+        .property_typ_data = DEFINE_PROPERTY_TYP_DATA_SUBTYPE (gobject_int,
+            .value_infos =              INT_VALUE_INFOS (
+                {
+                    .value.i64 = -1,
+                    .nick = "default",
+                },
+            ),
+        ),
+    ),
+    PROPERTY_INFO_WITH_DESC (NM_SETTING_LINK_XPS_CPUS,
+        .property_type =                &_pt_gobject_string,
+    ),
+    PROPERTY_INFO_WITH_DESC (NM_SETTING_LINK_IRQ_AFFINITY,
+        .property_type =                &_pt_gobject_string,
+    ),
+    PROPERTY_INFO_WITH_DESC (NM_SETTING_LINK_GSO_IPV4_MAX_SIZE,
+        .property_type =                &_pt_gobject_int,
+        .property_typ_data = DEFINE_PROPERTY_TYP_DATA_SUBTYPE (gobject_int,
+            .value_infos =              INT_VALUE_INFOS (
+                {
+                    .value.i64 = -1,
+                    .nick = "default",
+                },
+            ),
+        ),
+    ),
+    PROPERTY_INFO_WITH_DESC (NM_SETTING_LINK_GRO_IPV4_MAX_SIZE,
+        .property_type =                &_pt_gobject_int,
+        .property_typ_data = DEFINE_PROPERTY_TYP_DATA_SUBTYPE (gobject_int,
+            .value_infos =              INT_VALUE_INFOS (
+                {
+                    .value.i64 = -1,
+                    .nick = "default",
+                },
+            ),
+        ),
+    ),
+    PROPERTY_INFO_WITH_DESC (NM_SETTING_LINK_NAPI_THREADED,
+        .property_type =                &_pt_gobject_int,
+        .property_typ_data = DEFINE_PROPERTY_TYP_DATA_SUBTYPE (gobject_int,
+            .value_infos =              INT_VALUE_INFOS (
+                {
+                    .value.i64 = -1,
+                    .nick = "default",
+                },
+            ),
+        ),
+    ),
+    PROPERTY_INFO_WITH_DESC (NM_SETTING_LINK_NAPI_DEFER_HARD_IRQS,
+        .property_type =                &_pt_gobject_int,
+        .property_typ_data = DEFINE_PROPERTY_TYP_DATA_SUBTYPE (gobject_int,
+            .value_infos =              INT_VALUE_INFOS (
+                {
+                    .value.i64 = -1,
+                    .nick = "default",
+                },
+            ),
+        ),
+    ),
+    PROPERTY_INFO_WITH_DESC (NM_SETTING_LINK_GRO_FLUSH_TIMEOUT,
+        .property_type =                &_pt_gobject_int,
+        .property_typ_data = DEFINE_PROPERTY_TYP_DATA_SUBTYPE (gobject_int,
+            .value_infos =              INT_VALUE_INFOS (
+                {
+                    .value.i64 = -1,
+                    .nick = "default",
+                },
+            ),
+        ),
+    ),
+    PROPERTY_INFO_WITH_DESC (NM_SETTING_LINK_XDP_PROGRAM,
+        .property_type =                &_pt_gobject_string,
+    ),
+    PROPERTY_INFO_WITH_DESC (NM_SETTING_LINK_XDP_MODE,
+        .property_type =                &_pt_gobject_string,
+        .property_typ_data = DEFINE_PROPERTY_TYP_DATA (
+            .values_static =            NM_MAKE_STRV ("native", "generic", "offload"),
+        ),
+    ),
     NULL
 };
 
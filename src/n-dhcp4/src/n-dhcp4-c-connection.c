@@ -160,7 +160,16 @@ int n_dhcp4_c_connection_listen(NDhcp4CConnection *connection) {
                 connection->fd_udp = c_close(connection->fd_udp);
         }
 
-        r = n_dhcp4_c_socket_packet_new(&fd_packet, connection->client_config->ifindex);
+        if (connection->client_config->transport == N_DHCP4_TRANSPORT_ETHERNET)
+                r = n_dhcp4_c_socket_packet_new(&fd_packet,
+                                                connection->client_config->ifindex,
+                                                connection->client_config->mac,
+                                                connection->client_config->n_mac);
+        else
+                r = n_dhcp4_c_socket_packet_new(&fd_packet,
+                                                connection->client_config->ifindex,
+                                                NULL,
+                                                0);
         if (r)
                 return r;
 
@@ -486,6 +486,9 @@ struct NDhcp4ServerLease {
 
         NDhcp4Incoming *request;
         NDhcp4Incoming *reply;
+
+        uint8_t *options;               /* appended reply options */
+        size_t n_options;
 };
 
 #define N_DHCP4_SERVER_LEASE_NULL(_x) {                                         \
@@ -536,7 +539,7 @@ void n_dhcp4_incoming_get_yiaddr(NDhcp4Incoming *message, struct in_addr *yiaddr
 
 /* sockets */
 
-int n_dhcp4_c_socket_packet_new(int *sockfdp, int ifindex);
+int n_dhcp4_c_socket_packet_new(int *sockfdp, int ifindex, const uint8_t *mac, size_t n_mac);
 int n_dhcp4_c_socket_udp_new(int *sockfdp,
                              int ifindex,
                              const struct in_addr *client_addr,
@@ -716,6 +719,21 @@ void n_dhcp4_s_connection_ip_deinit(NDhcp4SConnectionIp *ip);
 void n_dhcp4_s_connection_ip_link(NDhcp4SConnectionIp *ip, NDhcp4SConnection *connection);
 void n_dhcp4_s_connection_ip_unlink(NDhcp4SConnectionIp *ip);
 
+/* server events */
+
+int n_dhcp4_s_event_node_new(NDhcp4SEventNode **nodep);
+NDhcp4SEventNode *n_dhcp4_s_event_node_free(NDhcp4SEventNode *node);
+
+/* servers */
+
+int n_dhcp4_server_raise(NDhcp4Server *server, NDhcp4SEventNode **nodep, unsigned int event);
+
+/* server leases */
+
+int n_dhcp4_server_lease_new(NDhcp4ServerLease **leasep, NDhcp4Incoming *message);
+void n_dhcp4_server_lease_link(NDhcp4ServerLease *lease, NDhcp4Server *server);
+void n_dhcp4_server_lease_unlink(NDhcp4ServerLease *lease);
+
 /* inline helpers */
 
 static inline void n_dhcp4_outgoing_freep(NDhcp4Outgoing **outgoing) {
@@ -33,11 +33,10 @@ int n_dhcp4_server_lease_new(NDhcp4ServerLease **leasep, NDhcp4Incoming *message
 }
 
 static void n_dhcp4_server_lease_free(NDhcp4ServerLease *lease) {
-        c_assert(!lease->server);
-
-        c_list_unlink(&lease->server_link);
+        n_dhcp4_server_lease_unlink(lease);
 
         n_dhcp4_incoming_free(lease->request);
+        free(lease->options);
         free(lease);
 }
 
@@ -60,9 +59,30 @@ _c_public_ NDhcp4ServerLease *n_dhcp4_server_lease_unref(NDhcp4ServerLease *leas
 }
 
 /**
- * n_dhcp4_server_lease_query() - XXX
+ * n_dhcp4_server_lease_link() - link lease into server
+ * @lease:                      the lease to operate on
+ * @server:                     the server to link into
+ *
+ * Only linked leases can be replied to. The server does not hold a
+ * reference to its leases.
  */
-_c_public_ int n_dhcp4_server_lease_query(NDhcp4ServerLease *lease, uint8_t option, uint8_t **datap, size_t *n_datap) {
+void n_dhcp4_server_lease_link(NDhcp4ServerLease *lease, NDhcp4Server *server) {
+        c_assert(!lease->server);
+
+        lease->server = server;
+        c_list_link_tail(&server->lease_list, &lease->server_link);
+}
+
+/**
+ * n_dhcp4_server_lease_unlink() - unlink lease from its server
+ * @lease:                      the lease to operate on
+ */
+void n_dhcp4_server_lease_unlink(NDhcp4ServerLease *lease) {
+        lease->server = NULL;
+        c_list_unlink(&lease->server_link);
+}
+
+static bool n_dhcp4_server_lease_option_is_internal(uint8_t option) {
         switch (option) {
         case N_DHCP4_OPTION_PAD:
         case N_DHCP4_OPTION_REQUESTED_IP_ADDRESS:
@@ -76,28 +96,172 @@ _c_public_ int n_dhcp4_server_lease_query(NDhcp4ServerLease *lease, uint8_t opti
         case N_DHCP4_OPTION_RENEWAL_T1_TIME:
         case N_DHCP4_OPTION_REBINDING_T2_TIME:
         case N_DHCP4_OPTION_END:
-                return N_DHCP4_E_INTERNAL;
+                return true;
         }
 
+        return false;
+}
+
+/**
+ * n_dhcp4_server_lease_get_chaddr() - get the client hardware address
+ * @lease:                      the lease to operate on
+ * @chaddrp:                    return argument for the hardware address
+ * @n_chaddrp:                  return argument for the length of the address
+ */
+_c_public_ void n_dhcp4_server_lease_get_chaddr(NDhcp4ServerLease *lease, const uint8_t **chaddrp, size_t *n_chaddrp) {
+        NDhcp4Header *header = n_dhcp4_incoming_get_header(lease->request);
+
+        *chaddrp = header->chaddr;
+        *n_chaddrp = c_min((size_t)header->hlen, sizeof(header->chaddr));
+}
+
+/**
+ * n_dhcp4_server_lease_get_requested_ip() - get the address the client asks for
+ * @lease:                      the lease to operate on
+ * @addrp:                      return argument for the address
+ *
+ * This is the requested IP address option, or the client address of clients
+ * that renew their lease. If the client did not ask for an address,
+ * INADDR_ANY is returned.
+ */
+_c_public_ void n_dhcp4_server_lease_get_requested_ip(NDhcp4ServerLease *lease, struct in_addr *addrp) {
+        NDhcp4Header *header = n_dhcp4_incoming_get_header(lease->request);
+        int r;
+
+        r = n_dhcp4_incoming_query_requested_ip(lease->request, addrp);
+        if (r)
+                addrp->s_addr = header->ciaddr;
+}
+
+/**
+ * n_dhcp4_server_lease_query() - XXX
+ */
+_c_public_ int n_dhcp4_server_lease_query(NDhcp4ServerLease *lease, uint8_t option, uint8_t **datap, size_t *n_datap) {
+        if (n_dhcp4_server_lease_option_is_internal(option))
+                return N_DHCP4_E_INTERNAL;
+
         return n_dhcp4_incoming_query(lease->request, option, datap, n_datap);
 }
 
+/**
+ * n_dhcp4_server_lease_append() - append an option to the reply
+ * @lease:                      the lease to operate on
+ * @option:                     the option to append
+ * @data:                       the option data
+ * @n_data:                     the length of @data
+ *
+ * The appended options are sent with the offer or acknowledgement for
+ * this lease. Options that the server sets itself cannot be appended.
+ *
+ * Return: 0 on success, or a negative error code on failure.
+ */
 _c_public_ int n_dhcp4_server_lease_append(NDhcp4ServerLease *lease, uint8_t option, uint8_t *data, size_t n_data) {
-        /* XXX */
-        return -ENOTRECOVERABLE;
+        uint8_t *options;
+
+        if (n_dhcp4_server_lease_option_is_internal(option) || n_data > UINT8_MAX)
+                return N_DHCP4_E_INTERNAL;
+
+        options = realloc(lease->options, lease->n_options + 2 + n_data);
+        if (!options)
+                return -ENOMEM;
+
+        options[lease->n_options] = option;
+        options[lease->n_options + 1] = n_data;
+        if (n_data)
+                memcpy(options + lease->n_options + 2, data, n_data);
+
+        lease->options = options;
+        lease->n_options += 2 + n_data;
+        return 0;
 }
 
-_c_public_ int n_dhcp4_server_lease_offer(NDhcp4ServerLease *lease) {
-        /* XXX */
-        return -ENOTRECOVERABLE;
+static int n_dhcp4_server_lease_send(NDhcp4ServerLease *lease,
+                                     uint8_t type,
+                                     struct in_addr yiaddr,
+                                     uint32_t lifetime) {
+        _c_cleanup_(n_dhcp4_outgoing_freep) NDhcp4Outgoing *reply = NULL;
+        NDhcp4SConnection *connection;
+        struct in_addr server_address;
+        size_t i;
+        int r;
+
+        if (!lease->server || !lease->server->connection.ip)
+                return N_DHCP4_E_INTERNAL;
+
+        connection = &lease->server->connection;
+        server_address = connection->ip->ip;
+
+        switch (type) {
+        case N_DHCP4_MESSAGE_OFFER:
+                r = n_dhcp4_s_connection_offer_new(connection,
+                                                   &reply,
+                                                   lease->request,
+                                                   &server_address,
+                                                   &yiaddr,
+                                                   lifetime);
+                break;
+        case N_DHCP4_MESSAGE_ACK:
+                r = n_dhcp4_s_connection_ack_new(connection,
+                                                 &reply,
+                                                 lease->request,
+                                                 &server_address,
+                                                 &yiaddr,
+                                                 lifetime);
+                break;
+        default:
+                r = n_dhcp4_s_connection_nak_new(connection,
+                                                 &reply,
+                                                 lease->request,
+                                                 &server_address);
+                break;
+        }
+        if (r)
+                return r;
+
+        if (type != N_DHCP4_MESSAGE_NAK) {
+                for (i = 0; i < lease->n_options; i += 2 + lease->options[i + 1]) {
+                        r = n_dhcp4_outgoing_append(reply,
+                                                    lease->options[i],
+                                                    lease->options + i + 2,
+                                                    lease->options[i + 1]);
+                        if (r)
+                                return r;
+                }
+        }
+
+        return n_dhcp4_s_connection_send_reply(connection, &server_address, reply);
+}
+
+/**
+ * n_dhcp4_server_lease_offer() - offer an address to the client
+ * @lease:                      the lease to operate on
+ * @yiaddr:                     the offered address
+ * @lifetime:                   the lifetime in seconds
+ *
+ * Return: 0 on success, or a non-zero error code on failure.
+ */
+_c_public_ int n_dhcp4_server_lease_offer(NDhcp4ServerLease *lease, struct in_addr yiaddr, uint32_t lifetime) {
+        return n_dhcp4_server_lease_send(lease, N_DHCP4_MESSAGE_OFFER, yiaddr, lifetime);
 }
 
-_c_public_ int n_dhcp4_server_lease_ack(NDhcp4ServerLease *lease) {
-        /* XXX */
-        return -ENOTRECOVERABLE;
+/**
+ * n_dhcp4_server_lease_ack() - acknowledge the request of the client
+ * @lease:                      the lease to operate on
+ * @yiaddr:                     the assigned address
+ * @lifetime:                   the lifetime in seconds
+ *
+ * Return: 0 on success, or a non-zero error code on failure.
+ */
+_c_public_ int n_dhcp4_server_lease_ack(NDhcp4ServerLease *lease, struct in_addr yiaddr, uint32_t lifetime) {
+        return n_dhcp4_server_lease_send(lease, N_DHCP4_MESSAGE_ACK, yiaddr, lifetime);
 }
 
+/**
+ * n_dhcp4_server_lease_nack() - reject the request of the client
+ * @lease:                      the lease to operate on
+ *
+ * Return: 0 on success, or a non-zero error code on failure.
+ */
 _c_public_ int n_dhcp4_server_lease_nack(NDhcp4ServerLease *lease) {
-        /* XXX */
-        return -ENOTRECOVERABLE;
+        return n_dhcp4_server_lease_send(lease, N_DHCP4_MESSAGE_NAK, (struct in_addr){}, 0);
 }
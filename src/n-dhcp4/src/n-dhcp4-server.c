@@ -78,6 +78,18 @@ NDhcp4SEventNode *n_dhcp4_s_event_node_free(NDhcp4SEventNode *node) {
         if (!node)
                 return NULL;
 
+        switch (node->event.event) {
+        case N_DHCP4_SERVER_EVENT_DISCOVER:
+        case N_DHCP4_SERVER_EVENT_REQUEST:
+        case N_DHCP4_SERVER_EVENT_RENEW:
+        case N_DHCP4_SERVER_EVENT_DECLINE:
+        case N_DHCP4_SERVER_EVENT_RELEASE:
+                n_dhcp4_server_lease_unref(node->event.request.lease);
+                break;
+        default:
+                break;
+        }
+
         c_list_unlink(&node->server_link);
         free(node);
 
@@ -110,10 +122,17 @@ _c_public_ int n_dhcp4_server_new(NDhcp4Server **serverp, NDhcp4ServerConfig *co
 
 static void n_dhcp4_server_free(NDhcp4Server *server) {
         NDhcp4SEventNode *node, *t_node;
+        NDhcp4ServerLease *lease, *t_lease;
 
         c_list_for_each_entry_safe(node, t_node, &server->event_list, server_link)
                 n_dhcp4_s_event_node_free(node);
 
+        /* leases may outlive the server, but can no longer be replied to */
+        c_list_for_each_entry_safe(lease, t_lease, &server->lease_list, server_link)
+                n_dhcp4_server_lease_unlink(lease);
+
+        n_dhcp4_s_connection_deinit(&server->connection);
+
         free(server);
 }
 
@@ -161,6 +180,51 @@ _c_public_ void n_dhcp4_server_get_fd(NDhcp4Server *server, int *fdp) {
         n_dhcp4_s_connection_get_fd(&server->connection, fdp);
 }
 
+static int n_dhcp4_server_dispatch_message(NDhcp4Server *server, NDhcp4Incoming **messagep) {
+        _c_cleanup_(n_dhcp4_server_lease_unrefp) NDhcp4ServerLease *lease = NULL;
+        NDhcp4SEventNode *node;
+        unsigned int event;
+        int r;
+
+        switch ((*messagep)->userdata.type) {
+        case N_DHCP4_C_MESSAGE_DISCOVER:
+                event = N_DHCP4_SERVER_EVENT_DISCOVER;
+                break;
+        case N_DHCP4_C_MESSAGE_SELECT:
+        case N_DHCP4_C_MESSAGE_REBOOT:
+                event = N_DHCP4_SERVER_EVENT_REQUEST;
+                break;
+        case N_DHCP4_C_MESSAGE_RENEW:
+        case N_DHCP4_C_MESSAGE_REBIND:
+                event = N_DHCP4_SERVER_EVENT_RENEW;
+                break;
+        case N_DHCP4_C_MESSAGE_DECLINE:
+                event = N_DHCP4_SERVER_EVENT_DECLINE;
+                break;
+        case N_DHCP4_C_MESSAGE_RELEASE:
+                event = N_DHCP4_SERVER_EVENT_RELEASE;
+                break;
+        default:
+                /* e.g., a request that selected another server */
+                return 0;
+        }
+
+        r = n_dhcp4_server_lease_new(&lease, *messagep);
+        if (r)
+                return r;
+
+        *messagep = NULL;
+
+        r = n_dhcp4_server_raise(server, &node, event);
+        if (r)
+                return r;
+
+        n_dhcp4_server_lease_link(lease, server);
+        node->event.request.lease = lease;
+        lease = NULL;
+        return 0;
+}
+
 /**
  * n_dhcp4_server_dispatch() - XXX
  */
@@ -176,6 +240,13 @@ _c_public_ int n_dhcp4_server_dispatch(NDhcp4Server *server) {
                                 return 0;
                         return r;
                 }
+
+                if (!message)
+                        continue;
+
+                r = n_dhcp4_server_dispatch_message(server, &message);
+                if (r)
+                        return r;
         }
 
         return N_DHCP4_E_PREEMPTED;
@@ -24,17 +24,26 @@
  * n_dhcp4_c_socket_packet_new() - create a new DHCP4 client packet socket
  * @sockfdp:            return argument for the new socket
  * @ifindex:            interface index to bind to
+ * @mac:                hardware address of the client, or NULL
+ * @n_mac:              length of @mac
  *
  * Create a new AF_PACKET/SOCK_DGRAM socket usable to listen to and send DHCP client
  * packets before an IP address has been configured.
  *
  * Only unfragmented DHCP packets from a server to a client destined for the given
- * ifindex is returned.
+ * ifindex is returned. If @mac is an ethernet address, only packets with that
+ * address in their 'chaddr' field are returned. DHCP replies are usually
+ * broadcast, so without this every client on the link is woken up for replies
+ * to all the other clients.
  *
  * Return: 0 on success, or a negative error code on failure.
  */
-int n_dhcp4_c_socket_packet_new(int *sockfdp, int ifindex) {
+int n_dhcp4_c_socket_packet_new(int *sockfdp, int ifindex, const uint8_t *mac, size_t n_mac) {
         _c_cleanup_(c_closep) int sockfd = -1;
+        bool filter_mac = mac && n_mac == ETH_ALEN;
+        uint32_t mac_hi = filter_mac ? ((uint32_t)mac[0] << 24 | (uint32_t)mac[1] << 16 |
+                                        (uint32_t)mac[2] << 8 | (uint32_t)mac[3]) : 0;
+        uint32_t mac_lo = filter_mac ? ((uint32_t)mac[4] << 8 | (uint32_t)mac[5]) : 0;
         struct sock_filter filter[] = {
                 /*
                  * IP
@@ -92,6 +101,28 @@ int n_dhcp4_c_socket_packet_new(int *sockfdp, int ifindex) {
                 BPF_JUMP(BPF_JMP + BPF_JEQ + BPF_K, N_DHCP4_MESSAGE_MAGIC, 1, 0),                               /* cookie == DHCP magic cookie ? */
                 BPF_STMT(BPF_RET + BPF_K, 0),                                                                   /* ignore */
 
+                /*
+                 * Client hardware address
+                 *
+                 * Check, if @mac was given,
+                 *  - hlen matches
+                 *  - chaddr matches
+                 */
+                BPF_STMT(BPF_LD + BPF_W + BPF_K, filter_mac),                                                   /* A <- filter by chaddr ? */
+                BPF_JUMP(BPF_JMP + BPF_JEQ + BPF_K, 0, 9, 0),                                                   /* no filter ? */
+
+                BPF_STMT(BPF_LD + BPF_B + BPF_IND, offsetof(NDhcp4Header, hlen)),                               /* A <- DHCP hlen */
+                BPF_JUMP(BPF_JMP + BPF_JEQ + BPF_K, ETH_ALEN, 1, 0),                                            /* hlen == ETH_ALEN ? */
+                BPF_STMT(BPF_RET + BPF_K, 0),                                                                   /* ignore */
+
+                BPF_STMT(BPF_LD + BPF_W + BPF_IND, offsetof(NDhcp4Header, chaddr)),                             /* A <- chaddr[0..3] */
+                BPF_JUMP(BPF_JMP + BPF_JEQ + BPF_K, mac_hi, 1, 0),                                              /* chaddr[0..3] == mac[0..3] ? */
+                BPF_STMT(BPF_RET + BPF_K, 0),                                                                   /* ignore */
+
+                BPF_STMT(BPF_LD + BPF_H + BPF_IND, offsetof(NDhcp4Header, chaddr) + 4),                         /* A <- chaddr[4..5] */
+                BPF_JUMP(BPF_JMP + BPF_JEQ + BPF_K, mac_lo, 1, 0),                                              /* chaddr[4..5] == mac[4..5] ? */
+                BPF_STMT(BPF_RET + BPF_K, 0),                                                                   /* ignore */
+
                 BPF_STMT(BPF_RET + BPF_K, 65535),                                                               /* return all */
         };
         struct sock_fprog fprog = {
@@ -208,11 +208,13 @@ NDhcp4ServerIp *n_dhcp4_server_ip_free(NDhcp4ServerIp *ip);
 NDhcp4ServerLease *n_dhcp4_server_lease_ref(NDhcp4ServerLease *lease);
 NDhcp4ServerLease *n_dhcp4_server_lease_unref(NDhcp4ServerLease *lease);
 
+void n_dhcp4_server_lease_get_chaddr(NDhcp4ServerLease *lease, const uint8_t **chaddrp, size_t *n_chaddrp);
+void n_dhcp4_server_lease_get_requested_ip(NDhcp4ServerLease *lease, struct in_addr *addrp);
 int n_dhcp4_server_lease_query(NDhcp4ServerLease *lease, uint8_t option, uint8_t **datap, size_t *n_datap);
 int n_dhcp4_server_lease_append(NDhcp4ServerLease *lease, uint8_t option, uint8_t *data, size_t n_data);
 
-int n_dhcp4_server_lease_offer(NDhcp4ServerLease *lease);
-int n_dhcp4_server_lease_ack(NDhcp4ServerLease *lease);
+int n_dhcp4_server_lease_offer(NDhcp4ServerLease *lease, struct in_addr yiaddr, uint32_t lifetime);
+int n_dhcp4_server_lease_ack(NDhcp4ServerLease *lease, struct in_addr yiaddr, uint32_t lifetime);
 int n_dhcp4_server_lease_nack(NDhcp4ServerLease *lease);
 
 /* inline helpers */
@@ -137,6 +137,8 @@ static void test_api_functions(void) {
                 (void *)n_dhcp4_server_lease_unref,
                 (void *)n_dhcp4_server_lease_unrefp,
                 (void *)n_dhcp4_server_lease_unrefv,
+                (void *)n_dhcp4_server_lease_get_chaddr,
+                (void *)n_dhcp4_server_lease_get_requested_ip,
                 (void *)n_dhcp4_server_lease_query,
                 (void *)n_dhcp4_server_lease_append,
                 (void *)n_dhcp4_server_lease_offer,
@@ -31,7 +31,7 @@ static void test_client_packet_socket_new(Link *link, int *skp) {
         netns_get(&oldns);
         netns_set(link->netns);
 
-        r = n_dhcp4_c_socket_packet_new(skp, link->ifindex);
+        r = n_dhcp4_c_socket_packet_new(skp, link->ifindex, NULL, 0);
         c_assert(r >= 0);
 
         netns_set(oldns);
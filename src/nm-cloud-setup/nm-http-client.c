@@ -11,6 +11,9 @@
 
 #define NM_CURL_DEBUG 0
 
+/* The maximum number of parallel connections to one host. */
+#define MAX_HOST_CONNECTIONS 8
+
 /*****************************************************************************/
 
 typedef struct {
@@ -776,6 +779,15 @@ constructed(GObject *object)
         curl_multi_setopt(priv->mhandle, CURLMOPT_SOCKETDATA, self);
         curl_multi_setopt(priv->mhandle, CURLMOPT_TIMERFUNCTION, _mhandle_timerfunction_cb);
         curl_multi_setopt(priv->mhandle, CURLMOPT_TIMERDATA, self);
+#if LIBCURL_VERSION_NUM >= 0x071e00 /* libcurl 7.30.0 */
+        /* The providers issue the requests for all interfaces at once, and they all
+         * go to the same metadata server. Instead of opening a new connection for
+         * each of them, keep a few connections to the host and let the remaining
+         * requests queue up and reuse them (keep-alive). */
+        curl_multi_setopt(priv->mhandle,
+                          CURLMOPT_MAX_HOST_CONNECTIONS,
+                          (long) MAX_HOST_CONNECTIONS);
+#endif
     }
 
     G_OBJECT_CLASS(nm_http_client_parent_class)->constructed(object);
@@ -30,6 +30,9 @@
  * the application. You can search for this macro, and find what options are supported. */
 #define _ENV(var) ("" var "")
 
+/* The maximum number of "no-wait" scripts that run in parallel. */
+#define NOWAIT_SCRIPTS_MAX 32
+
 /*****************************************************************************/
 
 typedef struct Request Request;
@@ -54,6 +57,11 @@ typedef struct {
     GQueue  *requests_waiting;
     int      num_requests_pending;
 
+    /* "no-wait" scripts that are not yet started, because already
+     * NOWAIT_SCRIPTS_MAX of them are running. */
+    GQueue nowait_scripts_queued;
+    guint  num_nowait_scripts_running;
+
     bool exit_with_failure;
 
     bool name_requested;
@@ -191,6 +199,7 @@ struct Request {
 /*****************************************************************************/
 
 static gboolean dispatch_one_script(Request *request);
+static gboolean script_dispatch(ScriptInfo *script);
 
 /*****************************************************************************/
 
@@ -433,20 +442,8 @@ complete_request(Request *request)
 }
 
 static void
-complete_script(ScriptInfo *script)
+request_continue(Request *request, gboolean wait)
 {
-    Request *request = script->request;
-    gboolean wait    = script->wait;
-
-    if (script->pid != -1 || script->stdout_fd != -1) {
-        /* Wait that process has terminated and stdout is closed */
-        return;
-    }
-
-    script->request->num_scripts_done++;
-    if (!script->wait)
-        script->request->num_scripts_nowait--;
-
     if (wait) {
         /* for "wait" scripts, try to schedule the next blocking script.
          * If that is successful, return (as we must wait for its completion). */
@@ -503,6 +500,70 @@ complete_script(ScriptInfo *script)
     }
 }
 
+/* Start "no-wait" scripts that were queued because too many were running. */
+static void
+nowait_scripts_start_queued(void)
+{
+    ScriptInfo *script;
+
+    while (gl.num_nowait_scripts_running < NOWAIT_SCRIPTS_MAX
+           && (script = g_queue_pop_head(&gl.nowait_scripts_queued))) {
+        Request *request = script->request;
+
+        /* While queued, the script was accounted as pending "no-wait"
+         * script. script_dispatch() accounts it again if it starts. */
+        request->num_scripts_nowait--;
+        if (script_dispatch(script)) {
+            gl.num_nowait_scripts_running++;
+            continue;
+        }
+
+        /* The script failed to start and was marked as done. That might
+         * complete the request or unblock its "wait" scripts. */
+        request_continue(request, FALSE);
+    }
+}
+
+static void
+nowait_script_dispatch(ScriptInfo *script)
+{
+    nm_assert(!script->wait);
+
+    if (gl.num_nowait_scripts_running >= NOWAIT_SCRIPTS_MAX) {
+        _LOG_S_T(script, "queue script (no-wait)");
+        script->request->num_scripts_nowait++;
+        g_queue_push_tail(&gl.nowait_scripts_queued, script);
+        return;
+    }
+
+    if (script_dispatch(script))
+        gl.num_nowait_scripts_running++;
+}
+
+static void
+complete_script(ScriptInfo *script)
+{
+    Request *request = script->request;
+    gboolean wait    = script->wait;
+
+    if (script->pid != -1 || script->stdout_fd != -1) {
+        /* Wait that process has terminated and stdout is closed */
+        return;
+    }
+
+    script->request->num_scripts_done++;
+    if (!script->wait) {
+        script->request->num_scripts_nowait--;
+        nm_assert(gl.num_nowait_scripts_running > 0);
+        gl.num_nowait_scripts_running--;
+    }
+
+    /* @script might be freed afterwards. */
+    request_continue(request, wait);
+
+    nowait_scripts_start_queued();
+}
+
 static void
 script_watch_cb(GPid pid, int status, gpointer user_data)
 {
@@ -1083,7 +1144,7 @@ _handle_action(GDBusMethodInvocation *invocation, GVariant *parameters, gboolean
         ScriptInfo *s = g_ptr_array_index(request->scripts, i);
 
         if (!s->wait) {
-            script_dispatch(s);
+            nowait_script_dispatch(s);
             num_nowait++;
         }
     }
@@ -1511,6 +1572,7 @@ main(int argc, char **argv)
     _LOG_X_D("dbus: unique name: %s", g_dbus_connection_get_unique_name(gl.dbus_connection));
 
     gl.requests_waiting = g_queue_new();
+    g_queue_init(&gl.nowait_scripts_queued);
 
     _idle_timeout_restart();
 
@@ -7,6 +7,9 @@
 
 #include "nm-initrd-generator.h"
 
+#include <sys/stat.h>
+#include <unistd.h>
+
 #include "libnm-base/nm-config-base.h"
 #include "libnm-core-intern/nm-core-internal.h"
 #include "libnm-core-intern/nm-keyfile-internal.h"
@@ -26,6 +29,70 @@
 
 /*****************************************************************************/
 
+/* The generated profiles are also written to a cache file in the format of
+ * the keyfile cache of NetworkManager (see nms-keyfile-cache.c), so that
+ * the daemon doesn't need to read and parse the keyfiles again. An entry
+ * is only used as long as the keyfile is unchanged (device, inode, size and
+ * modification time) and the cache is from the same NetworkManager version. */
+#define KEYFILE_CACHE_ENTRY_TYPE "(sttttiiiisa{sa{sv}})"
+#define KEYFILE_CACHE_BASENAME   "keyfile-cache"
+
+#if !defined(NM_DIST_VERSION)
+#define NM_DIST_VERSION VERSION
+#endif
+
+typedef struct {
+    const char *connections_dir;
+    GPtrArray  *cache_entries;
+} OutputData;
+
+static GVariant *
+keyfile_cache_entry_new(const char *full_filename, NMConnection *connection)
+{
+    struct stat st;
+
+    if (stat(full_filename, &st) != 0)
+        return NULL;
+
+    return g_variant_ref_sink(
+        g_variant_new("(sttttiiiis@a{sa{sv}})",
+                      full_filename,
+                      (guint64) st.st_dev,
+                      (guint64) st.st_ino,
+                      (guint64) st.st_size,
+                      (((guint64) st.st_mtim.tv_sec) * NM_UTILS_NSEC_PER_SEC) + st.st_mtim.tv_nsec,
+                      (gint32) NM_TERNARY_DEFAULT,
+                      (gint32) NM_TERNARY_DEFAULT,
+                      (gint32) NM_TERNARY_DEFAULT,
+                      (gint32) NM_TERNARY_DEFAULT,
+                      "",
+                      nm_connection_to_dbus(connection, NM_CONNECTION_SERIALIZE_ALL)));
+}
+
+static gboolean
+keyfile_cache_write(const char *filename, GPtrArray *entries, GError **error)
+{
+    gs_unref_variant GVariant *variant = NULL;
+
+    variant = g_variant_ref_sink(
+        g_variant_new("(s@a" KEYFILE_CACHE_ENTRY_TYPE ")",
+                      NM_DIST_VERSION,
+                      g_variant_new_array(G_VARIANT_TYPE(KEYFILE_CACHE_ENTRY_TYPE),
+                                          (GVariant *const *) entries->pdata,
+                                          entries->len)));
+
+    return nm_utils_file_set_contents(filename,
+                                      g_variant_get_data(variant),
+                                      g_variant_get_size(variant),
+                                      0600,
+                                      NULL,
+                                      NULL,
+                                      NULL,
+                                      error);
+}
+
+/*****************************************************************************/
+
 static void
 add_keyfile_comment(GKeyFile *keyfile, char *reason)
 {
@@ -43,7 +110,8 @@ output_conn(gpointer key, gpointer value, gpointer user_data)
 {
     const char                     *basename        = key;
     NMConnection                   *connection      = value;
-    char                           *connections_dir = user_data;
+    const OutputData               *output_data     = user_data;
+    const char                     *connections_dir = output_data->connections_dir;
     nm_auto_unref_keyfile GKeyFile *file            = NULL;
     gs_free char                   *data            = NULL;
     gs_free_error GError           *error           = NULL;
@@ -80,6 +148,14 @@ output_conn(gpointer key, gpointer value, gpointer user_data)
 
         if (!nm_utils_file_set_contents(full_filename, data, len, 0600, NULL, NULL, NULL, &error))
             goto err_out;
+
+        if (output_data->cache_entries) {
+            GVariant *entry;
+
+            entry = keyfile_cache_entry_new(full_filename, connection);
+            if (entry)
+                g_ptr_array_add(output_data->cache_entries, entry);
+        }
     } else
         g_print("\n*** Connection '%s' ***\n\n%s", basename, data);
 
@@ -158,6 +234,8 @@ main(int argc, char *argv[])
     gs_strfreev char                          **global_dns_servers = NULL;
     gs_free char                               *dns_backend        = NULL;
     gs_free char                               *dns_resolve_mode   = NULL;
+    gs_unref_ptrarray GPtrArray                *cache_entries      = NULL;
+    OutputData                                  output_data;
 
     option_context = g_option_context_new(
         "-- [ip=...] [rd.route=...] [bridge=...] [bond=...] [team=...] [vlan=...] "
@@ -348,8 +426,27 @@ main(int argc, char *argv[])
         }
     }
 
-    g_hash_table_foreach(connections, output_conn, connections_dir);
+    if (initrd_dir)
+        cache_entries = g_ptr_array_new_with_free_func((GDestroyNotify) g_variant_unref);
+
+    output_data = (OutputData) {
+        .connections_dir = connections_dir,
+        .cache_entries   = cache_entries,
+    };
+    g_hash_table_foreach(connections, output_conn, &output_data);
     g_hash_table_destroy(connections);
 
+    if (initrd_dir) {
+        gs_free char *cache_file = NULL;
+
+        cache_file = g_build_filename(initrd_dir, KEYFILE_CACHE_BASENAME, NULL);
+        if (cache_entries->len == 0)
+            (void) unlink(cache_file);
+        else if (!keyfile_cache_write(cache_file, cache_entries, &error)) {
+            _LOGW(LOGD_CORE, "%s: %s", cache_file, error->message);
+            g_clear_error(&error);
+        }
+    }
+
     return 0;
 }
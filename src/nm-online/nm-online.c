@@ -23,7 +23,7 @@
 #include <getopt.h>
 #include <locale.h>
 
-#include "libnm-client-aux-extern/nm-libnm-aux.h"
+#include "libnm-glib-aux/nm-dbus-aux.h"
 
 #define PROGRESS_STEPS 15
 
@@ -33,20 +33,31 @@
 #define EXIT_FAILURE_LIBNM_BUG   42
 #define EXIT_FAILURE_UNSPECIFIED 43
 
+/* nm-online only cares about the "State" and "Startup" properties of the
+ * manager. Instead of creating a NMClient (which fetches and caches all
+ * objects of NetworkManager), watch these properties directly on D-Bus. */
 typedef struct {
-    GMainLoop    *loop;
-    NMClient     *client;
-    GCancellable *client_new_cancellable;
-    guint         client_new_timeout_id;
-    guint         handle_timeout_id;
-    gulong        client_notify_id;
-    gboolean      exit_no_nm;
-    gboolean      wait_startup;
-    gboolean      quiet;
-    gint64        start_timestamp_ms;
-    gint64        end_timestamp_ms;
-    gint64        progress_step_duration;
-    int           retval;
+    GMainLoop       *loop;
+    GDBusConnection *dbus_connection;
+    GCancellable    *init_cancellable;
+    GCancellable    *get_all_cancellable;
+    char            *name_owner;
+    guint            init_timeout_id;
+    guint            handle_timeout_id;
+    guint            name_owner_changed_id;
+    guint            properties_changed_id;
+    NMState          state;
+    gboolean         startup;
+    gboolean         nm_running;
+    gboolean         name_owner_initialized;
+    gboolean         initialized;
+    gboolean         exit_no_nm;
+    gboolean         wait_startup;
+    gboolean         quiet;
+    gint64           start_timestamp_ms;
+    gint64           end_timestamp_ms;
+    gint64           progress_step_duration;
+    int              retval;
 } OnlineData;
 
 static gint64
@@ -62,7 +73,8 @@ _return(OnlineData *data, int retval)
     nm_assert(data->retval == EXIT_FAILURE_UNSPECIFIED);
 
     data->retval = retval;
-    nm_clear_g_signal_handler(data->client, &data->client_notify_id);
+    nm_clear_g_dbus_connection_signal(data->dbus_connection, &data->name_owner_changed_id);
+    nm_clear_g_dbus_connection_signal(data->dbus_connection, &data->properties_changed_id);
     g_main_loop_quit(data->loop);
 }
 
@@ -104,14 +116,14 @@ quit_if_connected(OnlineData *data)
 {
     NMState state;
 
-    state = nm_client_get_state(data->client);
-    if (!nm_client_get_nm_running(data->client)) {
+    state = data->state;
+    if (!data->nm_running) {
         if (data->exit_no_nm) {
             _return(data, EXIT_FAILURE_OFFLINE);
             return TRUE;
         }
     } else if (data->wait_startup) {
-        if (!nm_client_get_startup(data->client)) {
+        if (!data->startup) {
             _return(data, EXIT_SUCCESS);
             return TRUE;
         }
@@ -130,12 +142,6 @@ quit_if_connected(OnlineData *data)
     return FALSE;
 }
 
-static void
-client_properties_changed(GObject *object, GParamSpec *pspec, gpointer user_data)
-{
-    quit_if_connected(user_data);
-}
-
 static gboolean
 handle_timeout(gpointer user_data)
 {
@@ -179,48 +185,215 @@ handle_timeout(gpointer user_data)
     return G_SOURCE_REMOVE;
 }
 
-static gboolean
-got_client_timeout(gpointer user_data)
+/*****************************************************************************/
+
+static void
+_state_changed(OnlineData *data)
 {
-    OnlineData *data = user_data;
+    if (!data->initialized) {
+        /* This is the first time we know the state. */
+        data->initialized = TRUE;
+        nm_clear_g_source(&data->init_timeout_id);
+        g_clear_object(&data->init_cancellable);
 
-    data->client_new_timeout_id = 0;
-    data->quiet                 = TRUE;
-    g_printerr(_("Error: timeout creating NMClient object\n"));
-    _return(data, EXIT_FAILURE_LIBNM_BUG);
-    return G_SOURCE_REMOVE;
+        if (quit_if_connected(data))
+            return;
+
+        data->handle_timeout_id =
+            g_timeout_add(data->quiet ? NM_MAX(0, data->end_timestamp_ms - _now_ms()) : 0,
+                          handle_timeout,
+                          data);
+        return;
+    }
+
+    quit_if_connected(data);
 }
 
 static void
-got_client(GObject *source_object, GAsyncResult *res, gpointer user_data)
+_update_properties(OnlineData *data, GVariant *properties)
 {
-    OnlineData           *data  = user_data;
-    gs_free_error GError *error = NULL;
+    guint32  state;
+    gboolean startup;
+
+    if (g_variant_lookup(properties, "State", "u", &state))
+        data->state = state;
+    if (g_variant_lookup(properties, "Startup", "b", &startup))
+        data->startup = startup;
+}
+
+static void
+properties_changed_cb(GDBusConnection *connection,
+                      const char      *sender_name,
+                      const char      *object_path,
+                      const char      *signal_interface_name,
+                      const char      *signal_name,
+                      GVariant        *parameters,
+                      gpointer         user_data)
+{
+    OnlineData                *data       = user_data;
+    gs_unref_variant GVariant *properties = NULL;
+
+    if (!data->nm_running)
+        return;
+
+    if (!g_variant_is_of_type(parameters, G_VARIANT_TYPE("(sa{sv}as)")))
+        return;
+
+    g_variant_get(parameters, "(&s@a{sv}^a&s)", NULL, &properties, NULL);
+    _update_properties(data, properties);
+    _state_changed(data);
+}
+
+static void
+get_all_cb(GVariant *result, GError *error, gpointer user_data)
+{
+    OnlineData                *data;
+    gs_unref_variant GVariant *properties = NULL;
+
+    if (nm_utils_error_is_cancelled(error))
+        return;
+
+    data = user_data;
+    g_clear_object(&data->get_all_cancellable);
+
+    if (!result) {
+        /* NetworkManager probably just quit. Wait for the name owner to come back. */
+        return;
+    }
+
+    g_variant_get(result, "(@a{sv})", &properties);
+    _update_properties(data, properties);
+    data->nm_running = TRUE;
+    _state_changed(data);
+}
+
+static void
+name_owner_changed(OnlineData *data, const char *name_owner)
+{
+    name_owner = nm_str_not_empty(name_owner);
+
+    data->name_owner_initialized = TRUE;
+
+    if (nm_streq0(data->name_owner, name_owner))
+        return;
+
+    nm_clear_g_dbus_connection_signal(data->dbus_connection, &data->properties_changed_id);
+    nm_clear_g_cancellable(&data->get_all_cancellable);
+    nm_strdup_reset(&data->name_owner, name_owner);
+
+    data->nm_running = FALSE;
+    data->startup    = FALSE;
+    data->state      = NM_STATE_UNKNOWN;
+
+    if (!data->name_owner) {
+        _state_changed(data);
+        return;
+    }
 
-    nm_assert(NM_IS_CLIENT(source_object));
-    nm_assert(NM_CLIENT(source_object) == data->client);
+    /* Subscribe first, so that we don't miss changes that happen while
+     * GetAll is in progress. */
+    data->properties_changed_id =
+        nm_dbus_connection_signal_subscribe_properties_changed(data->dbus_connection,
+                                                               data->name_owner,
+                                                               NM_DBUS_PATH,
+                                                               NM_DBUS_INTERFACE,
+                                                               properties_changed_cb,
+                                                               data,
+                                                               NULL);
+
+    data->get_all_cancellable = g_cancellable_new();
+    nm_dbus_connection_call_get_all(data->dbus_connection,
+                                    data->name_owner,
+                                    NM_DBUS_PATH,
+                                    NM_DBUS_INTERFACE,
+                                    -1,
+                                    data->get_all_cancellable,
+                                    get_all_cb,
+                                    data);
+}
+
+static void
+name_owner_changed_cb(GDBusConnection *connection,
+                      const char      *sender_name,
+                      const char      *object_path,
+                      const char      *interface_name,
+                      const char      *signal_name,
+                      GVariant        *parameters,
+                      gpointer         user_data)
+{
+    const char *new_owner;
+
+    if (!g_variant_is_of_type(parameters, G_VARIANT_TYPE("(sss)")))
+        return;
+
+    g_variant_get(parameters, "(&s&s&s)", NULL, NULL, &new_owner);
+    name_owner_changed(user_data, new_owner);
+}
 
-    nm_clear_g_source(&data->client_new_timeout_id);
-    g_clear_object(&data->client_new_cancellable);
+static void
+get_name_owner_cb(const char *name_owner, GError *error, gpointer user_data)
+{
+    OnlineData *data;
 
-    if (!g_async_initable_init_finish(G_ASYNC_INITABLE(source_object), res, &error)) {
-        if (g_error_matches(error, G_IO_ERROR, G_IO_ERROR_CANCELLED))
+    if (nm_utils_error_is_cancelled(error))
+        return;
+
+    data = user_data;
+
+    /* A NameOwnerChanged signal that we received in the meantime is more
+     * recent than this reply. */
+    if (data->name_owner_initialized)
+        return;
+
+    name_owner_changed(data, name_owner);
+}
+
+static void
+got_bus(GObject *source_object, GAsyncResult *res, gpointer user_data)
+{
+    OnlineData           *data;
+    GDBusConnection      *dbus_connection;
+    gs_free_error GError *error = NULL;
+
+    dbus_connection = g_bus_get_finish(res, &error);
+    if (!dbus_connection) {
+        if (nm_utils_error_is_cancelled(error))
             return;
+        data        = user_data;
         data->quiet = TRUE;
-        g_printerr(_("Error: Could not create NMClient object: %s\n"), error->message);
+        g_printerr(_("Error: Could not connect to D-Bus: %s\n"), error->message);
         _return(data, EXIT_FAILURE_ERROR);
         return;
     }
 
-    if (quit_if_connected(data))
-        return;
+    data                  = user_data;
+    data->dbus_connection = dbus_connection;
+
+    data->name_owner_changed_id =
+        nm_dbus_connection_signal_subscribe_name_owner_changed(data->dbus_connection,
+                                                               NM_DBUS_SERVICE,
+                                                               name_owner_changed_cb,
+                                                               data,
+                                                               NULL);
+
+    nm_dbus_connection_call_get_name_owner(data->dbus_connection,
+                                           NM_DBUS_SERVICE,
+                                           -1,
+                                           data->init_cancellable,
+                                           get_name_owner_cb,
+                                           data);
+}
 
-    data->client_notify_id =
-        g_signal_connect(data->client, "notify", G_CALLBACK(client_properties_changed), data);
-    data->handle_timeout_id =
-        g_timeout_add(data->quiet ? NM_MAX(0, data->end_timestamp_ms - _now_ms()) : 0,
-                      handle_timeout,
-                      data);
+static gboolean
+init_timeout(gpointer user_data)
+{
+    OnlineData *data = user_data;
+
+    data->init_timeout_id = 0;
+    data->quiet           = TRUE;
+    g_printerr(_("Error: timeout getting the state of NetworkManager\n"));
+    _return(data, EXIT_FAILURE_LIBNM_BUG);
+    return G_SOURCE_REMOVE;
 }
 
 int
@@ -307,24 +480,25 @@ main(int argc, char *argv[])
         1,
         (data.end_timestamp_ms - data.start_timestamp_ms + PROGRESS_STEPS / 2) / PROGRESS_STEPS);
 
-    data.client_new_cancellable = g_cancellable_new();
+    data.init_cancellable = g_cancellable_new();
 
-    data.client_new_timeout_id = g_timeout_add_seconds(30, got_client_timeout, &data);
+    data.init_timeout_id = g_timeout_add_seconds(30, init_timeout, &data);
 
-    data.client = nmc_client_new_async(data.client_new_cancellable,
-                                       got_client,
-                                       &data,
-                                       NM_CLIENT_INSTANCE_FLAGS,
-                                       (guint) NM_CLIENT_INSTANCE_FLAGS_NO_AUTO_FETCH_PERMISSIONS,
-                                       NULL);
+    g_bus_get(g_getenv("LIBNM_USE_SESSION_BUS") ? G_BUS_TYPE_SESSION : G_BUS_TYPE_SYSTEM,
+              data.init_cancellable,
+              got_bus,
+              &data);
 
     g_main_loop_run(data.loop);
 
-    nm_clear_g_cancellable(&data.client_new_cancellable);
-    nm_clear_g_source(&data.client_new_timeout_id);
+    nm_clear_g_cancellable(&data.init_cancellable);
+    nm_clear_g_cancellable(&data.get_all_cancellable);
+    nm_clear_g_source(&data.init_timeout_id);
     nm_clear_g_source(&data.handle_timeout_id);
-    nm_clear_g_signal_handler(data.client, &data.client_notify_id);
-    g_clear_object(&data.client);
+    nm_clear_g_dbus_connection_signal(data.dbus_connection, &data.name_owner_changed_id);
+    nm_clear_g_dbus_connection_signal(data.dbus_connection, &data.properties_changed_id);
+    nm_clear_g_free(&data.name_owner);
+    g_clear_object(&data.dbus_connection);
 
     nm_clear_pointer(&data.loop, g_main_loop_unref);
 
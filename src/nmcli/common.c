@@ -1368,10 +1368,55 @@ dummy_offline_connection(void)
     return connection;
 }
 
+/**
+ * nmc_fields_need_ip_configs:
+ * @fields: the value of the --fields option or %NULL
+ *
+ * Returns: %TRUE if the selected fields might contain the IP4, IP6, DHCP4 or
+ *   DHCP6 groups, which are backed by IP and DHCP configuration objects.
+ */
+gboolean
+nmc_fields_need_ip_configs(const char *fields)
+{
+    gs_strfreev char **strv = NULL;
+    gsize              i;
+
+    if (!fields)
+        return TRUE;
+
+    strv = g_strsplit(fields, ",", -1);
+    for (i = 0; strv[i]; i++) {
+        char *field = g_strstrip(strv[i]);
+        char *dot;
+
+        dot = strchr(field, '.');
+        if (dot)
+            *dot = '\0';
+
+        if (NM_IN_STRSET_ASCII_CASE(field,
+                                    "all",
+                                    "common",
+                                    "active",
+                                    "IP4",
+                                    "IP6",
+                                    "DHCP4",
+                                    "DHCP6"))
+            return TRUE;
+    }
+    return FALSE;
+}
+
+gboolean
+nmc_command_no_ip_configs(NmCli *nmc, int argc, const char *const *argv)
+{
+    return FALSE;
+}
+
 static void
 call_cmd(NmCli *nmc, GTask *task, const NMCCommand *cmd, int argc, const char *const *argv)
 {
-    CmdCall *call;
+    NMClientInstanceFlags instance_flags;
+    CmdCall              *call;
 
     if (nmc->nmc_config.offline) {
         if (!cmd->supports_offline) {
@@ -1436,11 +1481,15 @@ call_cmd(NmCli *nmc, GTask *task, const NMCCommand *cmd, int argc, const char *c
             .argv = nm_strv_dup(argv, argc, TRUE),
             .task = task,
         };
+        instance_flags = NM_CLIENT_INSTANCE_FLAGS_NO_AUTO_FETCH_PERMISSIONS;
+        if (cmd->needs_ip_configs && !cmd->needs_ip_configs(nmc, argc, argv))
+            instance_flags |= NM_CLIENT_INSTANCE_FLAGS_NO_IP_CONFIGS;
+
         nmc_client_new_async(NULL,
                              got_client,
                              call,
                              NM_CLIENT_INSTANCE_FLAGS,
-                             (guint) NM_CLIENT_INSTANCE_FLAGS_NO_AUTO_FETCH_PERMISSIONS,
+                             (guint) instance_flags,
                              NULL);
     }
 }
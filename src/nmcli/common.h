@@ -59,6 +59,10 @@ char *nmc_parse_lldp_capabilities(guint value);
 void
 nmc_do_cmd(NmCli *nmc, const NMCCommand cmds[], const char *cmd, int argc, const char *const *argv);
 
+gboolean nmc_fields_need_ip_configs(const char *fields);
+
+gboolean nmc_command_no_ip_configs(NmCli *nmc, int argc, const char *const *argv);
+
 void nmc_complete_strv(const char *prefix, gssize nargs, const char *const *args);
 
 #define nmc_complete_strings(prefix, ...) \
@@ -1430,10 +1430,12 @@ usage_connection_import(void)
     nmc_printerr(
         _("Usage: nmcli connection import { ARGUMENTS | help }\n"
           "\n"
-          "ARGUMENTS := [--temporary] type <type> file <file to import>\n"
+          "ARGUMENTS := [--temporary] type <type> file <file to import> [file <file to "
+          "import>...]\n"
           "\n"
           "Import an external/foreign configuration as a NetworkManager connection profile.\n"
-          "The type of the input file is specified by type option.\n"
+          "The type of the input file is specified by type option. With several files,\n"
+          "all profiles are added with a few requests.\n"
           "Only VPN configurations are supported at the moment. The configuration\n"
           "is imported by NetworkManager VPN plugins.\n\n"));
 }
@@ -9872,6 +9874,180 @@ do_connection_load(const NMCCommand *cmd, NmCli *nmc, int argc, const char *cons
 
 #define PROMPT_IMPORT_FILE N_("File to import: ")
 
+/* Importing many files at once adds the profiles with AddConnections(), in
+ * batches of this size. */
+#define IMPORT_ADD_BATCH_SIZE 256u
+
+/* WireGuard files are parsed by libnm, which is thread-safe. VPN editor
+ * plugins make no such promise, so their files are parsed one by one. */
+#define IMPORT_MAX_THREADS 8u
+
+typedef struct {
+    const char   *filename;
+    NMConnection *connection;
+    GError       *error;
+} ImportFileData;
+
+typedef struct {
+    NmCli     *nmc;
+    GPtrArray *connections;
+    guint      n_total;
+    guint      n_added;
+    guint      n_sent;
+    guint      n_failed;
+    bool       temporary : 1;
+} ImportAddData;
+
+static NMConnection *
+_import_file(NMVpnEditorPlugin *plugin, const char *filename, GError **error)
+{
+    if (!plugin)
+        return nm_conn_wireguard_import(filename, error);
+    return nm_vpn_editor_plugin_import(plugin, filename, error);
+}
+
+static void
+_import_file_thread_cb(gpointer data, gpointer user_data)
+{
+    ImportFileData *d = data;
+
+    d->connection = _import_file(NULL, d->filename, &d->error);
+}
+
+static void _import_add_next(ImportAddData *add_data);
+
+static void
+_import_add_cb(GObject *source, GAsyncResult *result, gpointer user_data)
+{
+    ImportAddData             *add_data = user_data;
+    NmCli                     *nmc      = add_data->nmc;
+    gs_free_error GError      *error    = NULL;
+    gs_unref_variant GVariant *results  = NULL;
+    guint                      i;
+
+    results = nm_client_add_connections_finish(NM_CLIENT(source), result, &error);
+
+    for (i = 0; i < add_data->n_sent; i++) {
+        NMConnection              *connection = add_data->connections->pdata[add_data->n_added + i];
+        gs_unref_variant GVariant *item       = NULL;
+        const char                *item_error = NULL;
+
+        if (results && i < g_variant_n_children(results)) {
+            item = g_variant_get_child_value(results, i);
+            if (g_variant_lookup(item, "path", "&o", NULL)) {
+                /* keep the message the same as for a single profile. Scripts
+                 * might parse it. */
+                nmc_print(_("Connection '%s' (%s) successfully added.\n"),
+                          nm_connection_get_id(connection),
+                          nm_connection_get_uuid(connection));
+                continue;
+            }
+            g_variant_lookup(item, "error", "&s", &item_error);
+        }
+
+        nmc_printerr(_("Error: Failed to add '%s' connection: %s\n"),
+                     nm_connection_get_id(connection),
+                     item_error ?: (error ? error->message : _("unknown error")));
+        add_data->n_failed++;
+    }
+
+    add_data->n_added += add_data->n_sent;
+    _import_add_next(add_data);
+}
+
+static void
+_import_add_next(ImportAddData *add_data)
+{
+    NmCli                       *nmc   = add_data->nmc;
+    gs_unref_ptrarray GPtrArray *batch = NULL;
+    guint                        i;
+
+    if (add_data->n_added >= add_data->connections->len) {
+        if (add_data->n_failed > 0) {
+            g_string_printf(nmc->return_text,
+                            _("Error: failed to import %u of %u files."),
+                            add_data->n_failed,
+                            add_data->n_total);
+            nmc->return_value = NMC_RESULT_ERROR_UNKNOWN;
+        }
+        g_ptr_array_unref(add_data->connections);
+        nm_g_slice_free(add_data);
+        quit();
+        return;
+    }
+
+    add_data->n_sent =
+        NM_MIN(add_data->connections->len - add_data->n_added, IMPORT_ADD_BATCH_SIZE);
+    batch = g_ptr_array_sized_new(add_data->n_sent);
+    for (i = 0; i < add_data->n_sent; i++)
+        g_ptr_array_add(batch, add_data->connections->pdata[add_data->n_added + i]);
+
+    nm_client_add_connections_async(nmc->client,
+                                    batch,
+                                    add_data->temporary ? NM_SETTINGS_ADD_CONNECTION2_FLAG_IN_MEMORY
+                                                        : NM_SETTINGS_ADD_CONNECTION2_FLAG_TO_DISK,
+                                    NULL,
+                                    _import_add_cb,
+                                    add_data);
+}
+
+static void
+_import_files(NmCli *nmc, NMVpnEditorPlugin *plugin, GPtrArray *filenames, gboolean temporary)
+{
+    gs_free ImportFileData *datas    = NULL;
+    ImportAddData          *add_data;
+    GThreadPool            *pool     = NULL;
+    guint                   n_failed = 0;
+    guint                   n_threads;
+    guint                   i;
+
+    datas = g_new0(ImportFileData, filenames->len);
+    for (i = 0; i < filenames->len; i++)
+        datas[i].filename = filenames->pdata[i];
+
+    n_threads = NM_MIN(g_get_num_processors(), IMPORT_MAX_THREADS);
+    if (!plugin && n_threads > 1)
+        pool = g_thread_pool_new(_import_file_thread_cb, NULL, n_threads, TRUE, NULL);
+
+    for (i = 0; i < filenames->len; i++) {
+        if (pool)
+            g_thread_pool_push(pool, &datas[i], NULL);
+        else
+            datas[i].connection = _import_file(plugin, datas[i].filename, &datas[i].error);
+    }
+
+    if (pool) {
+        /* wait for all files to be parsed. */
+        g_thread_pool_free(pool, FALSE, TRUE);
+    }
+
+    add_data  = g_slice_new(ImportAddData);
+    *add_data = (ImportAddData) {
+        .nmc         = nmc,
+        .connections = g_ptr_array_new_full(filenames->len, g_object_unref),
+        .n_total     = filenames->len,
+        .temporary   = temporary,
+    };
+
+    for (i = 0; i < filenames->len; i++) {
+        if (!datas[i].connection) {
+            nmc_printerr(_("Error: failed to import '%s': %s.\n"),
+                         datas[i].filename,
+                         datas[i].error->message);
+            g_clear_error(&datas[i].error);
+            n_failed++;
+            continue;
+        }
+        g_ptr_array_add(add_data->connections, datas[i].connection);
+    }
+
+    /* the files that failed to import count as failures too. */
+    add_data->n_failed = n_failed;
+
+    nmc->should_wait++;
+    _import_add_next(add_data);
+}
+
 static void
 do_connection_import(const NMCCommand *cmd, NmCli *nmc, int argc, const char *const *argv)
 {
@@ -9879,11 +10055,14 @@ do_connection_import(const NMCCommand *cmd, NmCli *nmc, int argc, const char *co
     const char                   *type = NULL, *filename = NULL;
     gs_free char                 *type_ask     = NULL;
     gs_free char                 *filename_ask = NULL;
+    gs_unref_ptrarray GPtrArray  *filenames    = NULL;
     gs_unref_object NMConnection *connection   = NULL;
-    NMVpnEditorPlugin            *plugin;
+    NMVpnEditorPlugin            *plugin       = NULL;
     gs_free char                 *service_type = NULL;
     gboolean                      temporary    = FALSE;
 
+    filenames = g_ptr_array_new();
+
     /* Check --temporary */
     if (next_arg(nmc, &argc, &argv, "--temporary", NULL) > 0) {
         temporary = TRUE;
@@ -9900,6 +10079,7 @@ do_connection_import(const NMCCommand *cmd, NmCli *nmc, int argc, const char *co
             type         = nm_strstrip(type_ask);
             filename_ask = nmc_readline(&nmc->nmc_config, gettext(PROMPT_IMPORT_FILE));
             filename     = nm_strstrip(filename_ask);
+            g_ptr_array_add(filenames, (char *) filename);
         } else {
             g_string_printf(nmc->return_text, _("Error: No arguments provided."));
             nmc->return_value = NMC_RESULT_ERROR_USER_INPUT;
@@ -9909,7 +10089,7 @@ do_connection_import(const NMCCommand *cmd, NmCli *nmc, int argc, const char *co
 
     while (argc > 0) {
         if (argc == 1 && nmc->complete) {
-            nmc_complete_strings(*argv, type ? NULL : "type", filename ? NULL : "file");
+            nmc_complete_strings(*argv, type ? NULL : "type", "file");
         }
 
         if (nm_streq(*argv, "type")) {
@@ -9943,6 +10123,7 @@ do_connection_import(const NMCCommand *cmd, NmCli *nmc, int argc, const char *co
                 nmc->return_value = NMC_RESULT_COMPLETE_FILE;
 
             filename = *argv;
+            g_ptr_array_add(filenames, (char *) filename);
         } else {
             g_string_printf(nmc->return_text, _("Error: invalid extra argument '%s'."), *argv);
             nmc->return_value = NMC_RESULT_ERROR_USER_INPUT;
@@ -9966,9 +10147,7 @@ do_connection_import(const NMCCommand *cmd, NmCli *nmc, int argc, const char *co
         return;
     }
 
-    if (nm_streq(type, "wireguard"))
-        connection = nm_conn_wireguard_import(filename, &error);
-    else {
+    if (!nm_streq(type, "wireguard")) {
         service_type = nm_vpn_plugin_info_list_find_service_type(nm_vpn_get_plugin_infos(), type);
         if (!service_type) {
             g_string_printf(nmc->return_text, _("Error: failed to find VPN plugin for %s."), type);
@@ -9985,10 +10164,14 @@ do_connection_import(const NMCCommand *cmd, NmCli *nmc, int argc, const char *co
             nmc->return_value = NMC_RESULT_ERROR_UNKNOWN;
             return;
         }
+    }
 
-        connection = nm_vpn_editor_plugin_import(plugin, filename, &error);
+    if (filenames->len > 1) {
+        _import_files(nmc, plugin, filenames, temporary);
+        return;
     }
 
+    connection = _import_file(plugin, filename, &error);
     if (!connection) {
         g_string_printf(nmc->return_text,
                         _("Error: failed to import '%s': %s."),
@@ -10363,11 +10546,35 @@ nmcli_con_tab_completion(const char *text, int start, int end)
     return match_array;
 }
 
+static gboolean
+connections_show_needs_ip_configs(NmCli *nmc, int argc, const char *const *argv)
+{
+    int i;
+
+    /* Listing the profiles doesn't show IP configuration. Only the details of
+     * active connections do, that is, if any argument besides the options is
+     * given. */
+    for (i = 1; i < argc; i++) {
+        if (nmc_arg_is_option(argv[i], "order")) {
+            i++;
+            continue;
+        }
+        if (argv[i][0] != '-')
+            return nmc_fields_need_ip_configs(nmc->required_fields);
+    }
+    return FALSE;
+}
+
 void
 nmc_command_func_connection(const NMCCommand *cmd, NmCli *nmc, int argc, const char *const *argv)
 {
     static const NMCCommand cmds[] = {
-        {"show", do_connections_show, usage_connection_show, TRUE, TRUE},
+        {"show",
+         do_connections_show,
+         usage_connection_show,
+         TRUE,
+         TRUE,
+         .needs_ip_configs = connections_show_needs_ip_configs},
         {"up", do_connection_up, usage_connection_up, TRUE, TRUE},
         {"down", do_connection_down, usage_connection_down, TRUE, TRUE},
         {"add", do_connection_add, usage_connection_add, TRUE, TRUE, TRUE},
@@ -10381,7 +10588,12 @@ nmc_command_func_connection(const NMCCommand *cmd, NmCli *nmc, int argc, const c
         {"export", do_connection_export, usage_connection_export, TRUE, TRUE},
         {"migrate", do_connection_migrate, usage_connection_migrate, TRUE, TRUE},
         {"monitor", do_connection_monitor, usage_connection_monitor, TRUE, TRUE},
-        {NULL, do_connections_show, usage, TRUE, TRUE},
+        {NULL,
+         do_connections_show,
+         usage,
+         TRUE,
+         TRUE,
+         .needs_ip_configs = connections_show_needs_ip_configs},
     };
 
     next_arg(nmc, &argc, &argv, NULL);
@@ -2939,9 +2939,22 @@ device_unwatch(NmCli *nmc, NMDevice *device)
         quit();
 }
 
+static gboolean
+device_monitor_matches(NmCli *nmc, NMDevice *device)
+{
+    if (!nmc->monitor_ifnames)
+        return TRUE;
+
+    return g_strv_contains((const char *const *) nmc->monitor_ifnames,
+                           nm_device_get_iface(device) ?: "");
+}
+
 static void
 device_added(NMClient *client, NMDevice *device, NmCli *nmc)
 {
+    if (!device_monitor_matches(nmc, device))
+        return;
+
     nmc_print(_("%s: device created\n"), nm_device_get_iface(device));
     device_watch(nmc, NM_DEVICE(device));
 }
@@ -2949,6 +2962,9 @@ device_added(NMClient *client, NMDevice *device, NmCli *nmc)
 static void
 device_removed(NMClient *client, NMDevice *device, NmCli *nmc)
 {
+    if (!device_monitor_matches(nmc, device))
+        return;
+
     nmc_print(_("%s: device removed\n"), nm_device_get_iface(device));
     device_unwatch(nmc, device);
 }
@@ -2982,8 +2998,13 @@ do_devices_monitor(const NMCCommand *cmd, NmCli *nmc, int argc, const char *cons
         g_signal_connect(nmc->client, NM_CLIENT_DEVICE_ADDED, G_CALLBACK(device_added), nmc);
     }
 
-    for (i = 0; i < devices->len; i++)
-        device_watch(nmc, g_ptr_array_index(devices, i));
+    for (i = 0; i < devices->len; i++) {
+        NMDevice *device = g_ptr_array_index(devices, i);
+
+        if (!devices_free && !device_monitor_matches(nmc, device))
+            continue;
+        device_watch(nmc, device);
+    }
 
     g_signal_connect(nmc->client, NM_CLIENT_DEVICE_REMOVED, G_CALLBACK(device_removed), nmc);
 }
@@ -5310,6 +5331,12 @@ nmcli_device_tab_completion(const char *text, int start, int end)
     return match_array;
 }
 
+static gboolean
+device_show_needs_ip_configs(NmCli *nmc, int argc, const char *const *argv)
+{
+    return nmc_fields_need_ip_configs(nmc->required_fields);
+}
+
 void
 nmc_command_func_device(const NMCCommand *cmd, NmCli *nmc, int argc, const char *const *argv)
 {
@@ -5320,15 +5347,30 @@ nmc_command_func_device(const NMCCommand *cmd, NmCli *nmc, int argc, const char
         {"delete", do_devices_delete, usage_device_delete, TRUE, TRUE},
         {"down", do_devices_disconnect, usage_device_disconnect, TRUE, TRUE},
         {"lldp", do_device_lldp, usage_device_lldp, FALSE, FALSE},
-        {"monitor", do_devices_monitor, usage_device_monitor, TRUE, TRUE},
+        {"monitor",
+         do_devices_monitor,
+         usage_device_monitor,
+         TRUE,
+         TRUE,
+         .needs_ip_configs = nmc_command_no_ip_configs},
         {"modify", do_device_modify, usage_device_modify, TRUE, TRUE},
         {"reapply", do_device_reapply, usage_device_reapply, TRUE, TRUE},
-        {"status", do_devices_status, usage_device_status, TRUE, TRUE},
+        {"status",
+         do_devices_status,
+         usage_device_status,
+         TRUE,
+         TRUE,
+         .needs_ip_configs = nmc_command_no_ip_configs},
         {"set", do_device_set, usage_device_set, TRUE, TRUE},
-        {"show", do_device_show, usage_device_show, TRUE, TRUE},
+        {"show",
+         do_device_show,
+         usage_device_show,
+         TRUE,
+         TRUE,
+         .needs_ip_configs = device_show_needs_ip_configs},
         {"up", do_device_connect, usage_device_connect, TRUE, TRUE},
         {"wifi", do_device_wifi, usage_device_wifi, FALSE, FALSE},
-        {NULL, do_devices_status, usage, TRUE, TRUE},
+        {NULL, do_devices_status, usage, TRUE, TRUE, .needs_ip_configs = nmc_command_no_ip_configs},
     };
 
     next_arg(nmc, &argc, &argv, NULL);
@@ -119,6 +119,7 @@ get_ethtool_format(const NMMetaPropertyInfo *prop_info)
     case NM_ETHTOOL_TYPE_CHANNELS:
     case NM_ETHTOOL_TYPE_COALESCE:
     case NM_ETHTOOL_TYPE_RING:
+    case NM_ETHTOOL_TYPE_RSS:
         return g_strdup("integer");
     case NM_ETHTOOL_TYPE_FEATURE:
     case NM_ETHTOOL_TYPE_PAUSE:
@@ -329,6 +330,7 @@ append_ethtool_valid_values(const NMMetaPropertyInfo *prop_info, GPtrArray *vali
     case NM_ETHTOOL_TYPE_CHANNELS:
     case NM_ETHTOOL_TYPE_COALESCE:
     case NM_ETHTOOL_TYPE_RING:
+    case NM_ETHTOOL_TYPE_RSS:
         g_ptr_array_add(valid_values, g_strdup_printf("0 - %u", G_MAXUINT32));
         break;
     case NM_ETHTOOL_TYPE_FEATURE:
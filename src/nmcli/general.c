@@ -303,16 +303,55 @@ static const NmcMetaGenericInfo
 
 /*****************************************************************************/
 
+typedef struct {
+    const char *subsystem;
+    guint32     count;
+    guint64     bytes;
+} GeneralMemoryData;
+
+static gconstpointer
+_metagen_general_memory_get_fcn(NMC_META_GENERIC_INFO_GET_FCN_ARGS)
+{
+    const GeneralMemoryData *d = target;
+
+    NMC_HANDLE_COLOR(NM_META_COLOR_NONE);
+
+    switch (info->info_type) {
+    case NMC_GENERIC_INFO_TYPE_GENERAL_MEMORY_SUBSYSTEM:
+        return d->subsystem;
+    case NMC_GENERIC_INFO_TYPE_GENERAL_MEMORY_COUNT:
+        return (*out_to_free = g_strdup_printf("%u", (guint) d->count));
+    case NMC_GENERIC_INFO_TYPE_GENERAL_MEMORY_BYTES:
+        return (*out_to_free = g_strdup_printf("%" G_GUINT64_FORMAT, d->bytes));
+    default:
+        break;
+    }
+
+    g_return_val_if_reached(NULL);
+}
+
+static const NmcMetaGenericInfo
+    *const metagen_general_memory[_NMC_GENERIC_INFO_TYPE_GENERAL_MEMORY_NUM + 1] = {
+#define _METAGEN_GENERAL_MEMORY(type, name) \
+    [type] = NMC_META_GENERIC(name, .info_type = type, .get_fcn = _metagen_general_memory_get_fcn)
+        _METAGEN_GENERAL_MEMORY(NMC_GENERIC_INFO_TYPE_GENERAL_MEMORY_SUBSYSTEM, "SUBSYSTEM"),
+        _METAGEN_GENERAL_MEMORY(NMC_GENERIC_INFO_TYPE_GENERAL_MEMORY_COUNT, "COUNT"),
+        _METAGEN_GENERAL_MEMORY(NMC_GENERIC_INFO_TYPE_GENERAL_MEMORY_BYTES, "BYTES"),
+};
+
+/*****************************************************************************/
+
 static void
 usage_general(void)
 {
     nmc_printerr(_("Usage: nmcli general { COMMAND | help }\n\n"
-                   "COMMAND := { status | hostname | permissions | logging | reload }\n\n"
+                   "COMMAND := { status | hostname | permissions | logging | reload | memory }\n\n"
                    "  status\n\n"
                    "  hostname [<hostname>]\n\n"
                    "  permissions\n\n"
                    "  logging [level <log level>] [domains <log domains>]\n\n"
-                   "  reload [<flags>]\n\n"));
+                   "  reload [<flags>]\n\n"
+                   "  memory\n\n"));
 }
 
 static void
@@ -393,6 +432,16 @@ usage_general_logging(void)
           "for the list of possible logging domains.\n\n"));
 }
 
+static void
+usage_general_memory(void)
+{
+    nmc_printerr(_("Usage: nmcli general memory { help }\n"
+                   "\n"
+                   "Show the number of objects and their approximate memory usage in\n"
+                   "bytes for the internal subsystems of NetworkManager. This is meant\n"
+                   "for debugging.\n\n"));
+}
+
 static void
 usage_networking(void)
 {
@@ -472,10 +521,14 @@ usage_radio_wwan(void)
 static void
 usage_monitor(void)
 {
-    nmc_printerr(_("Usage: nmcli monitor\n"
+    nmc_printerr(_("Usage: nmcli monitor { ARGUMENTS | help }\n"
+                   "\n"
+                   "ARGUMENTS := [events general|device|connection[,...]] [ifname <ifname>] ...\n"
                    "\n"
                    "Monitor NetworkManager changes.\n"
-                   "Prints a line whenever a change occurs in NetworkManager\n\n"));
+                   "Prints a line whenever a change occurs in NetworkManager.\n"
+                   "'events' restricts the output to the given kinds of changes and 'ifname'\n"
+                   "(which can be repeated) restricts device events to the given interfaces.\n\n"));
 }
 
 static void
@@ -703,6 +756,95 @@ do_general_reload(const NMCCommand *cmd, NmCli *nmc, int argc, const char *const
                  nmc);
 }
 
+static void
+memory_cb(GObject *source, GAsyncResult *result, gpointer user_data)
+{
+    NmCli                     *nmc        = user_data;
+    gs_free_error GError      *error      = NULL;
+    gs_unref_variant GVariant *ret        = NULL;
+    gs_unref_variant GVariant *stats      = NULL;
+    gs_free GeneralMemoryData *data       = NULL;
+    gs_free gpointer          *targets    = NULL;
+    const char                *fields_str = NULL;
+    GVariantIter               iter;
+    gsize                      n;
+    gsize                      i;
+
+    ret = nm_dbus_call_finish(result, &error);
+    if (error) {
+        g_string_printf(nmc->return_text,
+                        _("Error: failed to get memory statistics: %s"),
+                        nmc_error_get_simple_message(error));
+        nmc->return_value = NMC_RESULT_ERROR_UNKNOWN;
+        quit();
+        return;
+    }
+
+    g_variant_get(ret, "(@a(sut))", &stats);
+
+    n       = g_variant_n_children(stats);
+    data    = g_new(GeneralMemoryData, n);
+    targets = g_new(gpointer, n + 1);
+    g_variant_iter_init(&iter, stats);
+    for (i = 0; i < n; i++) {
+        if (!g_variant_iter_next(&iter,
+                                 "(&sut)",
+                                 &data[i].subsystem,
+                                 &data[i].count,
+                                 &data[i].bytes))
+            nm_assert_not_reached();
+        targets[i] = &data[i];
+    }
+    targets[n] = NULL;
+
+    if (!nmc->required_fields || g_ascii_strcasecmp(nmc->required_fields, "common") == 0) {
+        /* pass */
+    } else if (g_ascii_strcasecmp(nmc->required_fields, "all") == 0) {
+        /* pass */
+    } else
+        fields_str = nmc->required_fields;
+
+    if (!nmc_print_table(&nmc->nmc_config,
+                         targets,
+                         NULL,
+                         _("NetworkManager memory"),
+                         (const NMMetaAbstractInfo *const *) metagen_general_memory,
+                         fields_str,
+                         &error)) {
+        g_string_printf(nmc->return_text, _("Error: 'general memory': %s"), error->message);
+        nmc->return_value = NMC_RESULT_ERROR_USER_INPUT;
+    }
+
+    quit();
+}
+
+static void
+do_general_memory(const NMCCommand *cmd, NmCli *nmc, int argc, const char *const *argv)
+{
+    next_arg(nmc, &argc, &argv, NULL);
+    if (nmc->complete)
+        return;
+
+    if (argc > 0) {
+        g_string_printf(nmc->return_text, _("Error: extra argument '%s'"), *argv);
+        nmc->return_value = NMC_RESULT_ERROR_USER_INPUT;
+        return;
+    }
+
+    nmc->should_wait++;
+    nm_dbus_call(G_BUS_TYPE_SYSTEM,
+                 NM_DBUS_SERVICE,
+                 NM_DBUS_PATH,
+                 NM_DBUS_INTERFACE,
+                 "GetMemoryStats",
+                 NULL,
+                 G_VARIANT_TYPE("(a(sut))"),
+                 NULL,
+                 (nmc->timeout == -1 ? 90 : nmc->timeout) * 1000,
+                 memory_cb,
+                 nmc);
+}
+
 static void
 do_general_permissions(const NMCCommand *cmd, NmCli *nmc, int argc, const char *const *argv)
 {
@@ -943,12 +1085,38 @@ void
 nmc_command_func_general(const NMCCommand *cmd, NmCli *nmc, int argc, const char *const *argv)
 {
     static const NMCCommand cmds[] = {
-        {"status", do_general_status, usage_general_status, TRUE, TRUE},
-        {"hostname", do_general_hostname, usage_general_hostname, TRUE, TRUE},
-        {"permissions", do_general_permissions, usage_general_permissions, TRUE, TRUE},
-        {"logging", do_general_logging, usage_general_logging, TRUE, TRUE},
+        {"status",
+         do_general_status,
+         usage_general_status,
+         TRUE,
+         TRUE,
+         .needs_ip_configs = nmc_command_no_ip_configs},
+        {"hostname",
+         do_general_hostname,
+         usage_general_hostname,
+         TRUE,
+         TRUE,
+         .needs_ip_configs = nmc_command_no_ip_configs},
+        {"permissions",
+         do_general_permissions,
+         usage_general_permissions,
+         TRUE,
+         TRUE,
+         .needs_ip_configs = nmc_command_no_ip_configs},
+        {"logging",
+         do_general_logging,
+         usage_general_logging,
+         TRUE,
+         TRUE,
+         .needs_ip_configs = nmc_command_no_ip_configs},
         {"reload", do_general_reload, usage_general_reload, FALSE, FALSE},
-        {NULL, do_general_status, usage_general, TRUE, TRUE},
+        {"memory", do_general_memory, usage_general_memory, FALSE, FALSE},
+        {NULL,
+         do_general_status,
+         usage_general,
+         TRUE,
+         TRUE,
+         .needs_ip_configs = nmc_command_no_ip_configs},
     };
 
     next_arg(nmc, &argc, &argv, NULL);
@@ -1604,26 +1772,129 @@ nmc_command_func_overview(const NMCCommand *cmd, NmCli *nmc, int argc, const cha
           "Consult nmcli(1) and nmcli-examples(7) manual pages for complete usage details.\n"));
 }
 
+typedef enum {
+    MONITOR_EVENT_GENERAL    = (1u << 0),
+    MONITOR_EVENT_DEVICE     = (1u << 1),
+    MONITOR_EVENT_CONNECTION = (1u << 2),
+    MONITOR_EVENT_ALL =
+        MONITOR_EVENT_GENERAL | MONITOR_EVENT_DEVICE | MONITOR_EVENT_CONNECTION,
+} MonitorEvents;
+
+static gboolean
+monitor_parse_events(const char *str, MonitorEvents *out_events, GError **error)
+{
+    gs_free const char **strv   = NULL;
+    MonitorEvents        events = 0;
+    gsize                i;
+
+    strv = nm_strsplit_set(str, ",");
+    for (i = 0; strv && strv[i]; i++) {
+        if (matches(strv[i], "general"))
+            events |= MONITOR_EVENT_GENERAL;
+        else if (matches(strv[i], "device"))
+            events |= MONITOR_EVENT_DEVICE;
+        else if (matches(strv[i], "connection"))
+            events |= MONITOR_EVENT_CONNECTION;
+        else {
+            g_set_error(error,
+                        NMCLI_ERROR,
+                        NMC_RESULT_ERROR_USER_INPUT,
+                        _("'%s' is not valid; use [%s]"),
+                        strv[i],
+                        "general, device, connection");
+            return FALSE;
+        }
+    }
+
+    if (!events) {
+        g_set_error(error, NMCLI_ERROR, NMC_RESULT_ERROR_USER_INPUT, _("no events given"));
+        return FALSE;
+    }
+
+    *out_events = events;
+    return TRUE;
+}
+
 void
 nmc_command_func_monitor(const NMCCommand *cmd, NmCli *nmc, int argc, const char *const *argv)
 {
+    gs_unref_ptrarray GPtrArray *ifnames = NULL;
+    MonitorEvents                events  = MONITOR_EVENT_ALL;
+
     next_arg(nmc, &argc, &argv, NULL);
 
-    if (nmc->complete)
-        return;
+    while (argc > 0) {
+        gs_free_error GError *error = NULL;
 
-    if (argc > 0) {
-        if (!nmc_arg_is_help(*argv)) {
-            g_string_printf(nmc->return_text,
-                            _("Error: 'monitor' command '%s' is not valid."),
-                            *argv);
-            nmc->return_value = NMC_RESULT_ERROR_USER_INPUT;
+        if (argc == 1 && nmc->complete)
+            nmc_complete_strings(*argv, "events", "ifname");
+
+        if (matches(*argv, "events")) {
+            argc--;
+            argv++;
+            if (!argc) {
+                g_string_printf(nmc->return_text,
+                                _("Error: '%s' argument is missing."),
+                                *(argv - 1));
+                nmc->return_value = NMC_RESULT_ERROR_USER_INPUT;
+                return;
+            }
+            if (argc == 1 && nmc->complete)
+                nmc_complete_strings(*argv, "general", "device", "connection");
+            if (!monitor_parse_events(*argv, &events, &error)) {
+                g_string_printf(nmc->return_text, _("Error: 'events': %s."), error->message);
+                nmc->return_value = NMC_RESULT_ERROR_USER_INPUT;
+                return;
+            }
+        } else if (matches(*argv, "ifname")) {
+            argc--;
+            argv++;
+            if (!argc) {
+                g_string_printf(nmc->return_text,
+                                _("Error: '%s' argument is missing."),
+                                *(argv - 1));
+                nmc->return_value = NMC_RESULT_ERROR_USER_INPUT;
+                return;
+            }
+            if (argc == 1 && nmc->complete)
+                nmc_complete_device(nmc->client, *argv, FALSE);
+            if (!ifnames)
+                ifnames = g_ptr_array_new_with_free_func(g_free);
+            g_ptr_array_add(ifnames, g_strdup(*argv));
+        } else {
+            if (!nmc_arg_is_help(*argv)) {
+                g_string_printf(nmc->return_text,
+                                _("Error: 'monitor' command '%s' is not valid."),
+                                *argv);
+                nmc->return_value = NMC_RESULT_ERROR_USER_INPUT;
+            }
+
+            if (!nmc->complete)
+                usage_monitor();
+            return;
         }
 
-        usage_monitor();
+        next_arg(nmc, &argc, &argv, NULL);
+    }
+
+    if (nmc->complete)
         return;
+
+    if (ifnames) {
+        g_ptr_array_add(ifnames, NULL);
+        nm_clear_pointer(&nmc->monitor_ifnames, g_strfreev);
+        nmc->monitor_ifnames = (char **) g_ptr_array_free(g_steal_pointer(&ifnames), FALSE);
     }
 
+    nmc->should_wait++;
+
+    if (NM_FLAGS_HAS(events, MONITOR_EVENT_DEVICE))
+        nmc_monitor_devices(nmc);
+    if (NM_FLAGS_HAS(events, MONITOR_EVENT_CONNECTION))
+        nmc_monitor_connections(nmc);
+    if (!NM_FLAGS_HAS(events, MONITOR_EVENT_GENERAL))
+        return;
+
     networkmanager_running(nmc->client, NULL, nmc);
 
     g_signal_connect(nmc->client,
@@ -1640,9 +1911,4 @@ nmc_command_func_monitor(const NMCCommand *cmd, NmCli *nmc, int argc, const char
                      G_CALLBACK(client_connectivity),
                      nmc);
     g_signal_connect(nmc->client, "notify::" NM_CLIENT_STATE, G_CALLBACK(client_state), nmc);
-
-    nmc->should_wait++;
-
-    nmc_monitor_devices(nmc);
-    nmc_monitor_connections(nmc);
 }
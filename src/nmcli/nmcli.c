@@ -250,6 +250,7 @@ usage(void)
         "  -c, --colors auto|yes|no                 whether to use colors in output\n"
         "  -e, --escape yes|no                      escape columns separators in values\n"
         "  -f, --fields <field,...>|all|common      specify fields to output\n"
+        "      --format text|json|ndjson            output format\n"
         "  -g, --get-values <field,...>|all|common  shortcut for -m tabular -t -f\n"
         "  -h, --help                               print this help\n"
         "  -m, --mode tabular|multiline             output mode\n"
@@ -729,7 +730,12 @@ process_command_line(NmCli *nmc, int argc, char **argv_orig)
 {
     static const NMCCommand nmcli_cmds[] = {
         {"general", nmc_command_func_general, NULL, FALSE, FALSE},
-        {"monitor", nmc_command_func_monitor, NULL, TRUE, FALSE},
+        {"monitor",
+         nmc_command_func_monitor,
+         NULL,
+         TRUE,
+         FALSE,
+         .needs_ip_configs = nmc_command_no_ip_configs},
         {"networking", nmc_command_func_networking, NULL, FALSE, FALSE},
         {"radio", nmc_command_func_radio, NULL, FALSE, FALSE},
         {"connection", nmc_command_func_connection, NULL, FALSE, FALSE, TRUE},
@@ -775,6 +781,7 @@ process_command_line(NmCli *nmc, int argc, char **argv_orig)
                                  "--colors",
                                  "--escape",
                                  "--fields",
+                                 "--format",
                                  "--get-values",
                                  "--nocheck",
                                  "--wait",
@@ -872,6 +879,23 @@ process_command_line(NmCli *nmc, int argc, char **argv_orig)
             if (argc == 1 && nmc->complete)
                 complete_fields(argv[0], value);
             nmc->required_fields = g_strdup(value);
+        } else if (matches_arg(nmc, &argc, &argv, "-format", &value)) {
+            if (argc == 1 && nmc->complete)
+                complete_option_with_value(argv[0], value, "text", "json", "ndjson", NULL);
+            if (matches(value, "text"))
+                nmc->nmc_config_mutable.json_output = NMC_JSON_OUTPUT_NONE;
+            else if (matches(value, "json"))
+                nmc->nmc_config_mutable.json_output = NMC_JSON_OUTPUT_JSON;
+            else if (matches(value, "ndjson"))
+                nmc->nmc_config_mutable.json_output = NMC_JSON_OUTPUT_NDJSON;
+            else {
+                g_string_printf(nmc->return_text,
+                                _("Error: '%s' is not valid argument for '%s' option."),
+                                value,
+                                argv[0]);
+                nmc->return_value = NMC_RESULT_ERROR_USER_INPUT;
+                return FALSE;
+            }
         } else if (matches_arg(nmc, &argc, &argv, "-get-values", &value)) {
             if (argc == 1 && nmc->complete)
                 complete_fields(argv[0], value);
@@ -1022,6 +1046,8 @@ nmc_cleanup(NmCli *nmc)
 
     nm_clear_pointer(&nmc->offline_connections, g_ptr_array_unref);
 
+    nm_clear_pointer(&nmc->monitor_ifnames, g_strfreev);
+
     nmc_polkit_agent_fini(nmc);
 }
 
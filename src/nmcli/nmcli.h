@@ -58,6 +58,16 @@ typedef enum {
     NMC_PRINT_PRETTY = 2,
 } NMCPrintOutput;
 
+typedef enum {
+    NMC_JSON_OUTPUT_NONE = 0,
+
+    /* Each table as a JSON array of objects. */
+    NMC_JSON_OUTPUT_JSON,
+
+    /* Each row as a JSON object on a line of its own. */
+    NMC_JSON_OUTPUT_NDJSON,
+} NMCJsonOutput;
+
 static inline NMMetaAccessorGetType
 nmc_print_output_to_accessor_get_type(NMCPrintOutput print_output)
 {
@@ -114,6 +124,9 @@ typedef struct _NmcConfig {
     /* Output mode */
     NMCPrintOutput print_output;
 
+    /* Print tables as JSON instead of text: option '--format' */
+    NMCJsonOutput json_output;
+
     /* Whether to use colors for output: option '--color' */
     bool use_colors;
 
@@ -205,6 +218,9 @@ typedef struct _NmCli {
     char *palette_buffer;
 
     GPtrArray *offline_connections;
+
+    /* Interface names 'nmcli monitor' restricts device events to ("ifname" argument). */
+    char **monitor_ifnames;
 } NmCli;
 
 extern const NmCli *const nm_cli_global_readline;
@@ -250,6 +266,10 @@ typedef struct _NMCCommand {
 
     /* With --online, read in a keyfile from standard input before dispatching the handler. */
     bool needs_offline_conn : 1;
+
+    /* If set and returning FALSE, the client instance is created without tracking IP and DHCP
+     * configuration objects. That makes the start faster for commands that don't need them. */
+    gboolean (*needs_ip_configs)(NmCli *nmc, int argc, const char *const *argv);
 } NMCCommand;
 
 void nmc_command_func_agent(const NMCCommand *cmd, NmCli *nmc, int argc, const char *const *argv);
@@ -16,6 +16,7 @@
 #include <sys/auxv.h>
 #include <sys/prctl.h>
 
+#include "libnm-glib-aux/nm-json-aux.h"
 #include "libnmc-base/nm-client-utils.h"
 #include "libnmc-setting/nm-meta-setting-access.h"
 
@@ -992,21 +993,11 @@ _print_data_cell_clear(gpointer cell_p)
     _print_data_cell_clear_text(cell);
 }
 
-static void
-_print_fill(const NmcConfig    *nmc_config,
-            gpointer const     *targets,
-            gpointer            targets_data,
-            const PrintDataCol *cols,
-            guint               cols_len,
-            GArray            **out_header_row,
-            GArray            **out_cells)
+static GArray *
+_print_fill_header(const NmcConfig *nmc_config, const PrintDataCol *cols, guint cols_len)
 {
-    GArray                *cells;
-    GArray                *header_row;
-    guint                  i_row, i_col;
-    guint                  targets_len;
-    NMMetaAccessorGetType  text_get_type;
-    NMMetaAccessorGetFlags text_get_flags;
+    GArray *header_row;
+    guint   i_col;
 
     header_row = g_array_sized_new(FALSE, TRUE, sizeof(PrintDataHeaderCell), cols_len);
     g_array_set_clear_func(header_row, _print_data_header_cell_clear);
@@ -1056,105 +1047,142 @@ _print_fill(const NmcConfig    *nmc_config,
         if (nmc_config->multiline_output && is_prop) {
             header_cell->title         = g_strdup_printf("%s.%s", setting_name, header_cell->title);
             header_cell->title_to_free = TRUE;
+        } else if (nmc_config->json_output != NMC_JSON_OUTPUT_NONE) {
+            /* JSON keys are the field names, like they are given to --fields. */
+            header_cell->title = nm_meta_abstract_info_get_name(info, FALSE);
         }
     }
 
-    targets_len = NM_PTRARRAY_LEN(targets);
+    return header_row;
+}
 
-    cells = g_array_sized_new(FALSE, TRUE, sizeof(PrintDataCell), targets_len * header_row->len);
-    g_array_set_clear_func(cells, _print_data_cell_clear);
-    g_array_set_size(cells, targets_len * header_row->len);
+static void
+_print_fill_cell(const NmcConfig     *nmc_config,
+                 gpointer             target,
+                 gpointer             targets_data,
+                 PrintDataHeaderCell *header_cell,
+                 PrintDataCell       *cell,
+                 gboolean             with_color)
+{
+    char                     *to_free = NULL;
+    const NMMetaAbstractInfo *info;
+    NMMetaAccessorGetType     text_get_type;
+    NMMetaAccessorGetFlags    text_get_flags;
+    NMMetaAccessorGetOutFlags text_out_flags, color_out_flags;
+    gconstpointer             value;
+    gboolean                  is_default;
+
+    info = header_cell->col->selection_item->info;
 
     text_get_type  = nmc_print_output_to_accessor_get_type(nmc_config->print_output);
     text_get_flags = NM_META_ACCESSOR_GET_FLAGS_ACCEPT_STRV;
     if (nmc_config->show_secrets)
         text_get_flags |= NM_META_ACCESSOR_GET_FLAGS_SHOW_SECRETS;
 
-    for (i_row = 0; i_row < targets_len; i_row++) {
-        gpointer       target = targets[i_row];
-        PrintDataCell *cells_line =
-            &nm_g_array_index(cells, PrintDataCell, i_row * header_row->len);
+    cell->header_cell = header_cell;
+
+    value = nm_meta_abstract_info_get(info,
+                                      nmc_meta_environment,
+                                      (gpointer) nmc_meta_environment_arg,
+                                      target,
+                                      targets_data,
+                                      text_get_type,
+                                      text_get_flags,
+                                      &text_out_flags,
+                                      &is_default,
+                                      (gpointer *) &to_free);
+
+    nm_assert(!to_free || value == to_free);
+
+    if ((is_default && nmc_config->overview)
+        || NM_FLAGS_HAS(text_out_flags, NM_META_ACCESSOR_GET_OUT_FLAGS_HIDE)) {
+        /* don't mark the entry for display. This is to shorten the output in case
+         * the property is the default value. But we only do that, if the user
+         * opts in to this behavior (-overview), or of the property marks itself
+         * eligible to be hidden.
+         *
+         * In general, only new API shall mark itself eligible to be hidden.
+         * Long established properties cannot, because it would be a change
+         * in behavior. */
+    } else
+        header_cell->to_print = TRUE;
 
-        for (i_col = 0; i_col < header_row->len; i_col++) {
-            char                     *to_free = NULL;
-            PrintDataCell            *cell    = &cells_line[i_col];
-            PrintDataHeaderCell      *header_cell;
-            const NMMetaAbstractInfo *info;
-            NMMetaAccessorGetOutFlags text_out_flags, color_out_flags;
-            gconstpointer             value;
-            gboolean                  is_default;
+    if (NM_FLAGS_HAS(text_out_flags, NM_META_ACCESSOR_GET_OUT_FLAGS_STRV)) {
+        if (nmc_config->multiline_output) {
+            cell->text_format  = PRINT_DATA_CELL_FORMAT_TYPE_STRV;
+            cell->text.strv    = value;
+            cell->text_to_free = !!to_free;
+        } else {
+            if (value && ((const char *const *) value)[0]) {
+                cell->text.plain   = g_strjoinv(" | ", (char **) value);
+                cell->text_to_free = TRUE;
+            }
+            if (to_free)
+                g_strfreev(NM_CAST_ALIGN(char *, to_free));
+        }
+    } else {
+        cell->text.plain   = value;
+        cell->text_to_free = !!to_free;
+    }
 
-            header_cell = &nm_g_array_index(header_row, PrintDataHeaderCell, i_col);
-            info        = header_cell->col->selection_item->info;
+    if (with_color) {
+        cell->color = GPOINTER_TO_INT(nm_meta_abstract_info_get(info,
+                                                                nmc_meta_environment,
+                                                                (gpointer) nmc_meta_environment_arg,
+                                                                target,
+                                                                targets_data,
+                                                                NM_META_ACCESSOR_GET_TYPE_COLOR,
+                                                                NM_META_ACCESSOR_GET_FLAGS_NONE,
+                                                                &color_out_flags,
+                                                                NULL,
+                                                                NULL));
+    }
 
-            cell->row_idx     = i_row;
-            cell->header_cell = header_cell;
+    if (cell->text_format == PRINT_DATA_CELL_FORMAT_TYPE_PLAIN) {
+        if (NM_IN_SET(nmc_config->print_output, NMC_PRINT_NORMAL, NMC_PRINT_PRETTY)
+            && (!cell->text.plain || !cell->text.plain[0])) {
+            _print_data_cell_clear_text(cell);
+            cell->text.plain = "--";
+        } else if (!cell->text.plain)
+            cell->text.plain = "";
+        nm_assert(cell->text_format == PRINT_DATA_CELL_FORMAT_TYPE_PLAIN);
+    }
+}
 
-            value = nm_meta_abstract_info_get(info,
-                                              nmc_meta_environment,
-                                              (gpointer) nmc_meta_environment_arg,
-                                              target,
-                                              targets_data,
-                                              text_get_type,
-                                              text_get_flags,
-                                              &text_out_flags,
-                                              &is_default,
-                                              (gpointer *) &to_free);
-
-            nm_assert(!to_free || value == to_free);
-
-            if ((is_default && nmc_config->overview)
-                || NM_FLAGS_HAS(text_out_flags, NM_META_ACCESSOR_GET_OUT_FLAGS_HIDE)) {
-                /* don't mark the entry for display. This is to shorten the output in case
-                 * the property is the default value. But we only do that, if the user
-                 * opts in to this behavior (-overview), or of the property marks itself
-                 * eligible to be hidden.
-                 *
-                 * In general, only new API shall mark itself eligible to be hidden.
-                 * Long established properties cannot, because it would be a change
-                 * in behavior. */
-            } else
-                header_cell->to_print = TRUE;
+static void
+_print_fill(const NmcConfig    *nmc_config,
+            gpointer const     *targets,
+            gpointer            targets_data,
+            const PrintDataCol *cols,
+            guint               cols_len,
+            GArray            **out_header_row,
+            GArray            **out_cells)
+{
+    GArray *cells;
+    GArray *header_row;
+    guint   i_row, i_col;
+    guint   targets_len;
 
-            if (NM_FLAGS_HAS(text_out_flags, NM_META_ACCESSOR_GET_OUT_FLAGS_STRV)) {
-                if (nmc_config->multiline_output) {
-                    cell->text_format  = PRINT_DATA_CELL_FORMAT_TYPE_STRV;
-                    cell->text.strv    = value;
-                    cell->text_to_free = !!to_free;
-                } else {
-                    if (value && ((const char *const *) value)[0]) {
-                        cell->text.plain   = g_strjoinv(" | ", (char **) value);
-                        cell->text_to_free = TRUE;
-                    }
-                    if (to_free)
-                        g_strfreev(NM_CAST_ALIGN(char *, to_free));
-                }
-            } else {
-                cell->text.plain   = value;
-                cell->text_to_free = !!to_free;
-            }
+    header_row = _print_fill_header(nmc_config, cols, cols_len);
 
-            cell->color =
-                GPOINTER_TO_INT(nm_meta_abstract_info_get(info,
-                                                          nmc_meta_environment,
-                                                          (gpointer) nmc_meta_environment_arg,
-                                                          target,
-                                                          targets_data,
-                                                          NM_META_ACCESSOR_GET_TYPE_COLOR,
-                                                          NM_META_ACCESSOR_GET_FLAGS_NONE,
-                                                          &color_out_flags,
-                                                          NULL,
-                                                          NULL));
-
-            if (cell->text_format == PRINT_DATA_CELL_FORMAT_TYPE_PLAIN) {
-                if (NM_IN_SET(nmc_config->print_output, NMC_PRINT_NORMAL, NMC_PRINT_PRETTY)
-                    && (!cell->text.plain || !cell->text.plain[0])) {
-                    _print_data_cell_clear_text(cell);
-                    cell->text.plain = "--";
-                } else if (!cell->text.plain)
-                    cell->text.plain = "";
-                nm_assert(cell->text_format == PRINT_DATA_CELL_FORMAT_TYPE_PLAIN);
-            }
+    targets_len = NM_PTRARRAY_LEN(targets);
+
+    cells = g_array_sized_new(FALSE, TRUE, sizeof(PrintDataCell), targets_len * header_row->len);
+    g_array_set_clear_func(cells, _print_data_cell_clear);
+    g_array_set_size(cells, targets_len * header_row->len);
+
+    for (i_row = 0; i_row < targets_len; i_row++) {
+        PrintDataCell *cells_line =
+            &nm_g_array_index(cells, PrintDataCell, i_row * header_row->len);
+
+        for (i_col = 0; i_col < header_row->len; i_col++) {
+            cells_line[i_col].row_idx = i_row;
+            _print_fill_cell(nmc_config,
+                             targets[i_row],
+                             targets_data,
+                             &nm_g_array_index(header_row, PrintDataHeaderCell, i_col),
+                             &cells_line[i_col],
+                             TRUE);
         }
     }
 
@@ -1397,6 +1425,151 @@ _print_do(const NmcConfig           *nmc_config,
     }
 }
 
+static void
+_print_json_row(const NmcConfig     *nmc_config,
+                GString             *str,
+                guint                row_idx,
+                guint                col_len,
+                const PrintDataCell *cells)
+{
+    gboolean is_first = TRUE;
+    guint    i_col;
+
+    if (nmc_config->json_output == NMC_JSON_OUTPUT_JSON)
+        g_string_append(str, row_idx == 0 ? "[\n  " : ",\n  ");
+
+    g_string_append_c(str, '{');
+
+    for (i_col = 0; i_col < col_len; i_col++) {
+        const PrintDataCell *cell = &cells[i_col];
+        const char *const   *i_strv;
+
+        if (_print_skip_column(nmc_config, cell->header_cell))
+            continue;
+
+        if (!is_first)
+            nm_json_gstr_append_delimiter(str);
+        is_first = FALSE;
+
+        nm_json_gstr_append_obj_name(str, cell->header_cell->title, '\0');
+
+        switch (cell->text_format) {
+        case PRINT_DATA_CELL_FORMAT_TYPE_PLAIN:
+            nm_json_gstr_append_string(str, cell->text.plain);
+            break;
+        case PRINT_DATA_CELL_FORMAT_TYPE_STRV:
+            g_string_append_c(str, '[');
+            for (i_strv = cell->text.strv; i_strv && *i_strv; i_strv++) {
+                if (i_strv != cell->text.strv)
+                    nm_json_gstr_append_delimiter(str);
+                nm_json_gstr_append_string(str, *i_strv);
+            }
+            g_string_append_c(str, ']');
+            break;
+        }
+    }
+
+    g_string_append_c(str, '}');
+
+    if (nmc_config->json_output == NMC_JSON_OUTPUT_NDJSON)
+        g_string_append_c(str, '\n');
+
+    nmc_print("%s", str->str);
+    g_string_truncate(str, 0);
+}
+
+/* In terse and JSON mode there are no column widths to compute. Format and print
+ * one row at a time, instead of first building the cells of the entire table. */
+static void
+_print_stream(const NmcConfig    *nmc_config,
+              gpointer const     *targets,
+              gpointer            targets_data,
+              const char         *header_name_no_l10n,
+              const PrintDataCol *cols,
+              guint               cols_len)
+{
+    nm_auto_free_gstring GString *json_str   = NULL;
+    gs_unref_array GArray        *header_row = NULL;
+    gs_unref_array GArray        *cells      = NULL;
+    guint                         i_row, i_col;
+    guint                         targets_len;
+    guint                         n_undecided;
+
+    header_row = _print_fill_header(nmc_config, cols, cols_len);
+    if (header_row->len == 0)
+        return;
+
+    if (nmc_config->json_output != NMC_JSON_OUTPUT_NONE)
+        json_str = g_string_sized_new(1024);
+
+    targets_len = NM_PTRARRAY_LEN(targets);
+
+    cells = g_array_sized_new(FALSE, TRUE, sizeof(PrintDataCell), header_row->len);
+    g_array_set_clear_func(cells, _print_data_cell_clear);
+    g_array_set_size(cells, header_row->len);
+
+    /* Whether a column gets printed depends on all rows. Find that out first.
+     * A column is decided by its first visible cell, so usually this only
+     * evaluates the first row. */
+    n_undecided = header_row->len;
+    for (i_row = 0; i_row < targets_len && n_undecided > 0; i_row++) {
+        for (i_col = 0; i_col < header_row->len; i_col++) {
+            PrintDataHeaderCell *header_cell =
+                &nm_g_array_index(header_row, PrintDataHeaderCell, i_col);
+            PrintDataCell *cell = &nm_g_array_index(cells, PrintDataCell, i_col);
+
+            if (header_cell->to_print)
+                continue;
+
+            _print_fill_cell(nmc_config, targets[i_row], targets_data, header_cell, cell, FALSE);
+            _print_data_cell_clear_text(cell);
+            if (header_cell->to_print)
+                n_undecided--;
+        }
+    }
+
+    for (i_row = 0; i_row < targets_len; i_row++) {
+        for (i_col = 0; i_col < header_row->len; i_col++) {
+            PrintDataHeaderCell *header_cell =
+                &nm_g_array_index(header_row, PrintDataHeaderCell, i_col);
+            PrintDataCell *cell = &nm_g_array_index(cells, PrintDataCell, i_col);
+
+            _print_data_cell_clear_text(cell);
+            cell->row_idx     = i_row;
+            cell->header_cell = header_cell;
+
+            /* Don't evaluate the cells that we won't print. */
+            if (_print_skip_column(nmc_config, header_cell))
+                continue;
+
+            _print_fill_cell(nmc_config,
+                             targets[i_row],
+                             targets_data,
+                             header_cell,
+                             cell,
+                             !json_str);
+        }
+
+        if (json_str) {
+            _print_json_row(nmc_config,
+                            json_str,
+                            i_row,
+                            header_row->len,
+                            nm_g_array_first_p(cells, PrintDataCell));
+        } else {
+            _print_do(nmc_config,
+                      header_name_no_l10n,
+                      header_row->len,
+                      1,
+                      nm_g_array_first_p(header_row, PrintDataHeaderCell),
+                      nm_g_array_first_p(cells, PrintDataCell));
+        }
+    }
+
+    if (nmc_config->json_output == NMC_JSON_OUTPUT_JSON)
+        nmc_print("%s\n", targets_len > 0 ? "\n]" : "[]");
+}
+
 gboolean
 nmc_print_table(const NmcConfig                 *nmc_config,
                 gpointer const                  *targets,
@@ -1415,6 +1588,34 @@ nmc_print_table(const NmcConfig                 *nmc_config,
     if (!_output_selection_parse(fields, fields_str, &cols_data, &cols_len, &gfree_keeper, error))
         return FALSE;
 
+    if (nmc_config->json_output != NMC_JSON_OUTPUT_NONE) {
+        NmcConfig json_config = *nmc_config;
+
+        /* Take the values from the property getters in their parsable form
+         * and keep lists as arrays. The multiline mode gives each property its
+         * full "setting.property" name and skips the rows for setting names. */
+        json_config.print_output     = NMC_PRINT_TERSE;
+        json_config.multiline_output = TRUE;
+        json_config.use_colors       = FALSE;
+        _print_stream(&json_config,
+                      targets,
+                      targets_data,
+                      header_name_no_l10n,
+                      cols_data,
+                      cols_len);
+        return TRUE;
+    }
+
+    if (nmc_config->print_output == NMC_PRINT_TERSE) {
+        _print_stream(nmc_config,
+                      targets,
+                      targets_data,
+                      header_name_no_l10n,
+                      cols_data,
+                      cols_len);
+        return TRUE;
+    }
+
     _print_fill(nmc_config, targets, targets_data, cols_data, cols_len, &header_row, &cells);
 
     _print_do(nmc_config,
@@ -1464,7 +1665,8 @@ nmc_terminal_spawn_pager(const NmcConfig *nmc_config)
     gs_strfreev char **ev = NULL;
 
     if (nmc_config->in_editor || nmc_config->print_output == NMC_PRINT_TERSE
-        || !nmc_config->use_colors || g_strcmp0(pager, "") == 0 || getauxval(AT_SECURE))
+        || nmc_config->json_output != NMC_JSON_OUTPUT_NONE || !nmc_config->use_colors
+        || g_strcmp0(pager, "") == 0 || getauxval(AT_SECURE))
         return 0;
 
     if (pipe(fd) == -1) {
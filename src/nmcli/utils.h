@@ -104,6 +104,11 @@ typedef enum {
     NMC_GENERIC_INFO_TYPE_GENERAL_LOGGING_DOMAINS,
     _NMC_GENERIC_INFO_TYPE_GENERAL_LOGGING_NUM,
 
+    NMC_GENERIC_INFO_TYPE_GENERAL_MEMORY_SUBSYSTEM = 0,
+    NMC_GENERIC_INFO_TYPE_GENERAL_MEMORY_COUNT,
+    NMC_GENERIC_INFO_TYPE_GENERAL_MEMORY_BYTES,
+    _NMC_GENERIC_INFO_TYPE_GENERAL_MEMORY_NUM,
+
     NMC_GENERIC_INFO_TYPE_IP4_CONFIG_ADDRESS = 0,
     NMC_GENERIC_INFO_TYPE_IP4_CONFIG_GATEWAY,
     NMC_GENERIC_INFO_TYPE_IP4_CONFIG_ROUTE,
@@ -0,0 +1,302 @@
+#!/usr/bin/env python
+# SPDX-License-Identifier: LGPL-2.1-or-later
+
+# Load generator for the D-Bus API of a running NetworkManager.
+#
+# It issues a configurable mix of D-Bus requests with a fixed number of
+# requests in flight, and reports the throughput and the latency
+# percentiles per method. The latency is measured at the client, from
+# sending the request until the reply arrives, so it covers the
+# dbus_vtable_method_call() handling in the daemon plus the bus round trip.
+#
+# libnm is only used to find the object paths to operate on, the requests
+# themselves are sent with plain GDBus.
+#
+# Examples:
+#
+#   tools/nm-dbus-load.py --duration 10 --parallel 16
+#   tools/nm-dbus-load.py --mix GetManagedObjects=1,GetSettings=10,Get=10
+#   tools/nm-dbus-load.py --mix ActivateConnection=1 --connection my-dummy-profile
+#
+# Activating a profile changes the system. Use a profile that is safe to
+# reactivate, like a dummy interface.
+
+import argparse
+import random
+import sys
+import time
+
+import gi
+
+gi.require_version("NM", "1.0")
+from gi.repository import GLib, Gio, NM
+
+NM_BUS_NAME = "org.freedesktop.NetworkManager"
+NM_PATH = "/org/freedesktop/NetworkManager"
+NM_IFACE = "org.freedesktop.NetworkManager"
+NM_SETTINGS_CONNECTION_IFACE = "org.freedesktop.NetworkManager.Settings.Connection"
+NM_DEVICE_IFACE = "org.freedesktop.NetworkManager.Device"
+
+DEFAULT_MIX = "GetManagedObjects=1,GetSettings=10,Get=10,GetAll=5"
+
+
+class Request:
+    def __init__(self, name, path, interface, method, parameters, reply_type):
+        self.name = name
+        self.path = path
+        self.interface = interface
+        self.method = method
+        self.parameters = parameters
+        self.reply_type = reply_type
+
+
+class RequestFactory:
+    def __init__(self, nmc, connection):
+        self.connections = [c.get_path() for c in nmc.get_connections()]
+        self.devices = [d.get_path() for d in nmc.get_devices()]
+        self.activate = None
+
+        if connection is not None:
+            for c in nmc.get_connections():
+                if connection in (c.get_id(), c.get_uuid(), c.get_path()):
+                    self.activate = c.get_path()
+                    break
+            else:
+                raise ValueError("no connection profile %s" % (connection,))
+
+    def supports(self, name):
+        if name in ("GetManagedObjects", "GetManagedObjectsFiltered"):
+            return True
+        if name == "GetSettings":
+            return bool(self.connections)
+        if name in ("Get", "GetAll"):
+            return True
+        if name == "ActivateConnection":
+            return self.activate is not None
+        raise ValueError("unknown request type %s" % (name,))
+
+    def create(self, name):
+        if name == "GetManagedObjects":
+            return Request(
+                name,
+                "/org/freedesktop",
+                "org.freedesktop.DBus.ObjectManager",
+                "GetManagedObjects",
+                None,
+                GLib.VariantType("(a{oa{sa{sv}}})"),
+            )
+        if name == "GetManagedObjectsFiltered":
+            return Request(
+                name,
+                NM_PATH,
+                NM_IFACE,
+                "GetManagedObjectsFiltered",
+                GLib.Variant(
+                    "(oa{sas})",
+                    (NM_PATH + "/Devices", {NM_DEVICE_IFACE: ["State", "Interface"]}),
+                ),
+                GLib.VariantType("(a{oa{sa{sv}}})"),
+            )
+        if name == "GetSettings":
+            return Request(
+                name,
+                random.choice(self.connections),
+                NM_SETTINGS_CONNECTION_IFACE,
+                "GetSettings",
+                None,
+                GLib.VariantType("(a{sa{sv}})"),
+            )
+        if name == "Get":
+            if self.devices and random.randint(0, 1):
+                path, iface, prop = random.choice(self.devices), NM_DEVICE_IFACE, "State"
+            else:
+                path, iface, prop = NM_PATH, NM_IFACE, "Version"
+            return Request(
+                name,
+                path,
+                "org.freedesktop.DBus.Properties",
+                "Get",
+                GLib.Variant("(ss)", (iface, prop)),
+                GLib.VariantType("(v)"),
+            )
+        if name == "GetAll":
+            if self.devices and random.randint(0, 1):
+                path, iface = random.choice(self.devices), NM_DEVICE_IFACE
+            else:
+                path, iface = NM_PATH, NM_IFACE
+            return Request(
+                name,
+                path,
+                "org.freedesktop.DBus.Properties",
+                "GetAll",
+                GLib.Variant("(s)", (iface,)),
+                GLib.VariantType("(a{sv})"),
+            )
+        if name == "ActivateConnection":
+            return Request(
+                name,
+                NM_PATH,
+                NM_IFACE,
+                "ActivateConnection",
+                GLib.Variant("(ooo)", (self.activate, "/", "/")),
+                GLib.VariantType("(o)"),
+            )
+        raise ValueError("unknown request type %s" % (name,))
+
+
+class Stats:
+    def __init__(self):
+        self.latencies = []
+        self.errors = 0
+
+    @staticmethod
+    def percentile(sorted_values, p):
+        if not sorted_values:
+            return 0.0
+        idx = int(round((p / 100.0) * (len(sorted_values) - 1)))
+        return sorted_values[idx]
+
+
+def parse_mix(mix):
+    result = []
+    for entry in mix.split(","):
+        entry = entry.strip()
+        if not entry:
+            continue
+        name, _, weight = entry.partition("=")
+        weight = int(weight) if weight else 1
+        if weight < 0:
+            raise ValueError("invalid weight in %s" % (entry,))
+        if weight > 0:
+            result.append((name, weight))
+    if not result:
+        raise ValueError("empty request mix")
+    return result
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Measure the D-Bus throughput and latency of NetworkManager."
+    )
+    parser.add_argument(
+        "--mix",
+        default=DEFAULT_MIX,
+        help="comma separated request types with weights (GetManagedObjects, "
+        "GetManagedObjectsFiltered, GetSettings, Get, GetAll, ActivateConnection). "
+        "Default: %s" % (DEFAULT_MIX,),
+    )
+    parser.add_argument(
+        "--duration", type=float, default=10.0, help="seconds to run (default: 10)"
+    )
+    parser.add_argument(
+        "--parallel",
+        type=int,
+        default=8,
+        help="number of requests in flight (default: 8)",
+    )
+    parser.add_argument(
+        "--connection",
+        help="id, UUID or D-Bus path of the profile for ActivateConnection",
+    )
+    parser.add_argument(
+        "--timeout", type=int, default=25000, help="D-Bus timeout in msec"
+    )
+    args = parser.parse_args()
+
+    mix = parse_mix(args.mix)
+
+    nmc = NM.Client.new(None)
+    factory = RequestFactory(nmc, args.connection)
+    for name, _ in mix:
+        if not factory.supports(name):
+            print("Cannot issue %s requests, skip them" % (name,), file=sys.stderr)
+    mix = [(name, weight) for name, weight in mix if factory.supports(name)]
+    if not mix:
+        print("Nothing to do", file=sys.stderr)
+        return 1
+
+    names = [name for name, _ in mix]
+    weights = [weight for _, weight in mix]
+    stats = {name: Stats() for name in names}
+
+    bus = Gio.bus_get_sync(Gio.BusType.SYSTEM, None)
+    mainloop = GLib.MainLoop()
+    state = {"in_flight": 0, "stop": False}
+
+    def issue():
+        req = factory.create(random.choices(names, weights)[0])
+        start = time.monotonic()
+
+        def cb(source, result):
+            st = stats[req.name]
+            try:
+                source.call_finish(result)
+            except GLib.Error as e:
+                st.errors += 1
+                if st.errors == 1:
+                    print("%s failed: %s" % (req.name, e.message), file=sys.stderr)
+            else:
+                st.latencies.append(time.monotonic() - start)
+            state["in_flight"] -= 1
+            if not state["stop"]:
+                issue()
+            elif state["in_flight"] == 0:
+                mainloop.quit()
+
+        state["in_flight"] += 1
+        bus.call(
+            NM_BUS_NAME,
+            req.path,
+            req.interface,
+            req.method,
+            req.parameters,
+            req.reply_type,
+            Gio.DBusCallFlags.NO_AUTO_START,
+            args.timeout,
+            None,
+            cb,
+        )
+
+    def stop():
+        state["stop"] = True
+        if state["in_flight"] == 0:
+            mainloop.quit()
+        return GLib.SOURCE_REMOVE
+
+    start_time = time.monotonic()
+    for _ in range(max(args.parallel, 1)):
+        issue()
+    GLib.timeout_add(int(args.duration * 1000), stop)
+    mainloop.run()
+    elapsed = time.monotonic() - start_time
+
+    total = sum(len(st.latencies) for st in stats.values())
+    print(
+        "%d requests in %.2f s (%.1f/s), %d in parallel"
+        % (total, elapsed, total / elapsed, args.parallel)
+    )
+    print(
+        "%-20s %8s %8s %9s %9s %9s %9s %9s"
+        % ("method", "count", "errors", "req/s", "p50 ms", "p90 ms", "p99 ms", "max ms")
+    )
+    for name in names:
+        st = stats[name]
+        lat = sorted(st.latencies)
+        print(
+            "%-20s %8d %8d %9.1f %9.3f %9.3f %9.3f %9.3f"
+            % (
+                name,
+                len(lat),
+                st.errors,
+                len(lat) / elapsed,
+                Stats.percentile(lat, 50) * 1000,
+                Stats.percentile(lat, 90) * 1000,
+                Stats.percentile(lat, 99) * 1000,
+                (lat[-1] if lat else 0.0) * 1000,
+            )
+        )
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())